@@ -8,12 +8,15 @@
 //! \file athena.hpp
 //  \brief contains Athena++ general purpose types, structures, enums, etc.
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_DualView.hpp>
 #include <Kokkos_Macros.hpp>
 #include "config.hpp"
+#include "driver/kernel_tuner.hpp"
 
 //----------------------------------------------------------------------------------------
 // type alias that allows code to run with either floats or doubles
@@ -34,6 +37,26 @@ using Real = double;
 
 #endif // SINGLE_PRECISION_ENABLED
 
+// type alias for values stored in (large) device arrays.  With mixed precision these are
+// floats, while all arithmetic (reconstruction, Riemann solvers, inversions) is still
+// performed in Real=double after values are loaded.  Otherwise identical to Real.
+
+#if MIXED_PRECISION_ENABLED
+
+using StoreReal = float;
+#if MPI_PARALLEL_ENABLED
+#define MPI_ATHENA_STORE_REAL MPI_FLOAT
+#endif
+
+#else
+
+using StoreReal = Real;
+#if MPI_PARALLEL_ENABLED
+#define MPI_ATHENA_STORE_REAL MPI_ATHENA_REAL
+#endif
+
+#endif // MIXED_PRECISION_ENABLED
+
 //----------------------------------------------------------------------------------------
 // general purpose macros (never modified)
 
@@ -55,15 +78,23 @@ enum BFieldIndex {IBX=0, IBY=1, IBZ=2, NMAG=3};
 // array indices for metric matrices in GR
 enum MetricIndex {I00=0, I01=1, I02=2, I03=3, I11=4, I12=5, I13=6, I22=7, I23=8, I33=9,
                   NMETRIC=10};
-// array indices for particle arrays
-enum ParticlesIndex {PGID=0, PTAG=1, IPX=0, IPVX=1, IPY=2, IPVY=3, IPZ=4, IPVZ=5};
+// array indices for particle arrays.  Positions are stored before velocities, so that
+// particles without velocities (see PrtclAttributes) only store IPX,IPY,IPZ.
+enum ParticlesIndex {PGID=0, PTAG=1, IPX=0, IPY=1, IPZ=2, IPVX=3, IPVY=4, IPVZ=5};
 
 // integer constants to specify spatial reconstruction methods
 enum ReconstructionMethod {dc, plm, ppm4, ppmx, wenoz};
 
+// constants that enumerate EOS for which flux kernels are specialized at compile time
+// (any = EOS chosen at runtime)
+enum class KernelEOS {any, ideal, isothermal};
+
 // constants that enumerate time evolution options
 enum TimeEvolution {tstatic, kinematic, dynamic};
 
+// constants that enumerate super-time-stepping (RKL) integrators for diffusion terms
+enum class STSIntegrator {none, rkl1, rkl2};
+
 // constants that enumerate Physics Modules implemented in code
 enum PhysicsModule {HydroDynamics, MagnetoHydroDynamics,
                     SpaceTimeDynamics, UserDefined}; //SpaceTimeDynamics = Z4c
@@ -87,9 +118,22 @@ struct MHDCons1D {
 // define default Kokkos execution and memory spaces
 
 using DevExeSpace = Kokkos::DefaultExecutionSpace;
+// With MANAGED_MEMORY_ENABLED, device arrays on GPUs are allocated in managed memory,
+// which may oversubscribe device memory; pages migrate between host and device on demand
+#if MANAGED_MEMORY_ENABLED && defined(KOKKOS_ENABLE_CUDA)
+using DevMemSpace = Kokkos::CudaUVMSpace;
+#elif MANAGED_MEMORY_ENABLED && defined(KOKKOS_ENABLE_HIP)
+using DevMemSpace = Kokkos::HIPManagedSpace;
+#else
 using DevMemSpace = Kokkos::DefaultExecutionSpace::memory_space;
+#endif
 using HostMemSpace = Kokkos::HostSpace;
 using ScratchMemSpace = DevExeSpace::scratch_memory_space;
+#if defined(KOKKOS_HAS_SHARED_HOST_PINNED_SPACE)
+using HostPinnedMemSpace = Kokkos::SharedHostPinnedSpace;  // page-locked host memory
+#else
+using HostPinnedMemSpace = Kokkos::HostSpace;
+#endif
 using LayoutWrapper = Kokkos::LayoutRight;                // increments last index fastest
 using TeamMember_t = Kokkos::TeamPolicy<>::member_type;   // for Kokkos thread teams
 
@@ -123,6 +167,14 @@ using HostArray4D = Kokkos::View<T ****, LayoutWrapper, HostMemSpace>;
 template <typename T>
 using HostArray5D = Kokkos::View<T *****, LayoutWrapper, HostMemSpace>;
 
+// template declarations for construction of Kokkos::View in pinned host memory
+template <typename T>
+using HostPinnedArray1D = Kokkos::View<T *, LayoutWrapper, HostPinnedMemSpace>;
+template <typename T>
+using HostPinnedArray2D = Kokkos::View<T **, LayoutWrapper, HostPinnedMemSpace>;
+template <typename T>
+using HostPinnedArray5D = Kokkos::View<T *****, LayoutWrapper, HostPinnedMemSpace>;
+
 // template declarations for construction of Kokkos::DualViews
 template <typename T>
 using DualArray1D = Kokkos::DualView<T *, LayoutWrapper, DevMemSpace>;
@@ -138,6 +190,34 @@ using ScrArray1D = Kokkos::View<T *, LayoutWrapper, ScratchMemSpace,
 template <typename T>
 using ScrArray2D = Kokkos::View<T **, LayoutWrapper, ScratchMemSpace,
                                      Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+template <typename T>
+using ScrArray4D = Kokkos::View<T ****, LayoutWrapper, ScratchMemSpace,
+                                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
+//----------------------------------------------------------------------------------------
+//! \fn SpecializedRecon()
+//! \brief Returns reconstruction method R of flux kernels specialized at compile time
+//! (so switch statements over the method are removed by the compiler), or runtime value
+//! r in generic kernels (R<0).
+
+template <int R>
+KOKKOS_INLINE_FUNCTION
+ReconstructionMethod SpecializedRecon(const ReconstructionMethod r) {
+  if constexpr (R < 0) {
+    return r;
+  } else {
+    return static_cast<ReconstructionMethod>(R);
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn IsSpecializedRecon()
+//! \brief True if specialized flux kernels are compiled for reconstruction method r.
+//! Selected with Athena_SPECIALIZED_RECON in CMakeLists.txt
+
+constexpr bool IsSpecializedRecon(const int r) {
+  return ((SPECIALIZED_RECON_MASK >> r) & 1) != 0;
+}
 
 //----------------------------------------------------------------------------------------
 // struct for storing face-centered (area-averaged) variables, e.g. magnetic field
@@ -332,24 +412,160 @@ inline void par_for(const std::string &name, DevExeSpace exec_space,
   });
 }
 
+// team size used by par_for_outer.  Host SIMD loops require teams of one thread, so
+// that the inner loops over i are vectorized rather than split between threads.
+#if HOST_SIMD_ENABLED
+#define OUTER_TEAM_SIZE 1
+#else
+#define OUTER_TEAM_SIZE Kokkos::AUTO
+#endif
+
+// Optional launch bounds (max threads per team, min teams per multiprocessor) passed as
+// template argument to par_for_outer for the register-heavy dynamical GRMHD kernels.  Set
+// with Athena_DYNGR_LAUNCH_BOUNDS, 0 means no bounds.  Ignored on CPUs.
+using DynGRLaunchBounds = Kokkos::LaunchBounds<DYNGR_MAX_THREADS, DYNGR_MIN_BLOCKS>;
+
+//----------------------------------------------------------------------------------------
+//! \fn TeamPolicy OuterTeamPolicy()
+//! \brief Returns TeamPolicy with launch parameters set by cfg (0 means Kokkos::AUTO)
+
+template <typename LB>
+inline Kokkos::TeamPolicy<LB> OuterTeamPolicy(DevExeSpace exec_space, const int nleague,
+                                              const kernel_tuner::TeamConfig &cfg) {
+  if (cfg.team_size > 0 && cfg.vector_length > 0) {
+    return Kokkos::TeamPolicy<LB>(exec_space, nleague, cfg.team_size, cfg.vector_length);
+  } else if (cfg.team_size > 0) {
+    return Kokkos::TeamPolicy<LB>(exec_space, nleague, cfg.team_size);
+  } else if (cfg.vector_length > 0) {
+    return Kokkos::TeamPolicy<LB>(exec_space, nleague, Kokkos::AUTO, cfg.vector_length);
+  }
+  return Kokkos::TeamPolicy<LB>(exec_space, nleague, Kokkos::AUTO);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool ValidTeamConfig()
+//! \brief Returns true if kernel can be launched with launch parameters cfg
+
+template <typename LB, typename Kernel>
+inline bool ValidTeamConfig(DevExeSpace exec_space, const int nleague, size_t scr_size,
+                            const kernel_tuner::TeamConfig &cfg, const Kernel &kernel) {
+  using Policy = Kokkos::TeamPolicy<LB>;
+  if (cfg.scr_level < 0 || cfg.scr_level > 1) return false;
+  if (scr_size > static_cast<size_t>(Policy::scratch_size_max(cfg.scr_level))) {
+    return false;
+  }
+  if (cfg.vector_length > Policy::vector_length_max()) return false;
+  if (cfg.team_size > 0) {
+    Policy policy(exec_space, nleague, 1, std::max(cfg.vector_length, 1));
+    policy.set_scratch_size(cfg.scr_level, Kokkos::PerTeam(scr_size));
+    if (cfg.team_size > policy.team_size_max(kernel, Kokkos::ParallelForTag())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void SetTuningCandidates()
+//! \brief Sets candidate launch parameters of kernel to be tried by auto-tuner.  The
+//! first candidate is the default (OUTER_TEAM_SIZE), followed on CPUs by all powers of
+//! two up to the maximum team size, and on GPUs by a range of vector lengths and total
+//! number of threads per team, and by the use of level 1 (rather than level 0) scratch.
+
+template <typename LB, typename Kernel>
+inline void SetTuningCandidates(kernel_tuner::KernelState &ks, DevExeSpace exec_space,
+                                const int nleague, size_t scr_size, const int scr_level,
+                                const Kernel &kernel) {
+  kernel_tuner::TeamConfig def = {((HOST_SIMD_ENABLED)? 1 : 0), 0, scr_level};
+  std::vector<kernel_tuner::TeamConfig> cands = {def};
+  if (Kokkos::SpaceAccessibility<DevExeSpace, Kokkos::HostSpace>::accessible) {
+    cands.push_back({0, 0, scr_level});
+    for (int nt=1; nt<=1024; nt*=2) {cands.push_back({nt, 0, scr_level});}
+  } else {
+    for (int vl : {1, 4, 8, 32}) {
+      cands.push_back({0, vl, scr_level});
+      for (int nt=64; nt<=512; nt*=2) {
+        if (nt >= vl) {cands.push_back({nt/vl, vl, scr_level});}
+      }
+    }
+    if (scr_level == 0 && scr_size > 0) {
+      for (int vl : {0, 1, 4, 8, 32}) {cands.push_back({0, vl, 1});}
+    }
+  }
+  // remove duplicates and candidates that cannot be launched
+  ks.candidates.clear();
+  for (auto &c : cands) {
+    bool dup = false;
+    for (auto &d : ks.candidates) {
+      dup = dup || (c.team_size == d.team_size && c.vector_length == d.vector_length &&
+                    c.scr_level == d.scr_level);
+    }
+    if (!dup && ValidTeamConfig<LB>(exec_space, nleague, scr_size, c, kernel)) {
+      ks.candidates.push_back(c);
+    }
+  }
+  if (ks.candidates.empty()) {ks.candidates.push_back(def);}
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void LaunchOuter()
+//! \brief Launches kernel over league of teams for par_for_outer().  Unless auto-tuning
+//! is enabled, teams are of size OUTER_TEAM_SIZE.  Otherwise, while each kernel is being
+//! tuned, every call is fenced and timed with the current candidate launch parameters,
+//! and afterwards the fastest are used.
+
+template <typename LB, typename Kernel>
+inline void LaunchOuter(const std::string &name, DevExeSpace exec_space,
+                        const int nleague, size_t scr_size, const int scr_level,
+                        const Kernel &kernel) {
+  if (!kernel_tuner::enabled) {
+    Kokkos::TeamPolicy<LB> policy(exec_space, nleague, OUTER_TEAM_SIZE);
+    Kokkos::parallel_for(name, policy.set_scratch_size(scr_level,
+                         Kokkos::PerTeam(scr_size)), kernel);
+    return;
+  }
+  kernel_tuner::KernelState &ks = kernel_tuner::State(name, scr_size);
+  if (ks.tuned && !ks.validated) {
+    // winner read from tuning file, re-tune if it cannot be used for this kernel
+    ks.validated = true;
+    if (!ValidTeamConfig<LB>(exec_space, nleague, scr_size, ks.best, kernel)) {
+      ks.tuned = false;
+    }
+  }
+  if (!ks.tuned && ks.candidates.empty()) {
+    SetTuningCandidates<LB>(ks, exec_space, nleague, scr_size, scr_level, kernel);
+  }
+  const kernel_tuner::TeamConfig &cfg = ks.Current();
+  Kokkos::TeamPolicy<LB> policy = OuterTeamPolicy<LB>(exec_space, nleague, cfg);
+  policy.set_scratch_size(cfg.scr_level, Kokkos::PerTeam(scr_size));
+  if (ks.tuned) {
+    Kokkos::parallel_for(name, policy, kernel);
+    return;
+  }
+  Kokkos::fence();
+  Kokkos::Timer timer;
+  Kokkos::parallel_for(name, policy, kernel);
+  Kokkos::fence();
+  ks.Record(timer.seconds());
+}
+
 //------------------------------------------
 // 1D outer parallel loop using Kokkos Teams
-template <typename Function>
+template <typename LB = Kokkos::LaunchBounds<>, typename Function>
 inline void par_for_outer(const std::string &name, DevExeSpace exec_space,
                           size_t scr_size, const int scr_level,
                           const int kl, const int ku, const Function &function) {
   const int nk = ku - kl + 1;
-  Kokkos::TeamPolicy<> policy(exec_space, nk, Kokkos::AUTO);
-  Kokkos::parallel_for(name, policy.set_scratch_size(scr_level,Kokkos::PerTeam(scr_size)),
-  KOKKOS_LAMBDA(TeamMember_t tmember) {
+  auto kernel = KOKKOS_LAMBDA(TeamMember_t tmember) {
     const int k = tmember.league_rank() + kl;
     function(tmember, k);
-  });
+  };
+  LaunchOuter<LB>(name, exec_space, nk, scr_size, scr_level, kernel);
 }
 
 //------------------------------------------
 // 2D outer parallel loop using Kokkos Teams
-template <typename Function>
+template <typename LB = Kokkos::LaunchBounds<>, typename Function>
 inline void par_for_outer(const std::string &name, DevExeSpace exec_space,
                           size_t scr_size, const int scr_level,
                           const int kl, const int ku, const int jl, const int ju,
@@ -357,18 +573,17 @@ inline void par_for_outer(const std::string &name, DevExeSpace exec_space,
   const int nk = ku - kl + 1;
   const int nj = ju - jl + 1;
   const int nkj = nk*nj;
-  Kokkos::TeamPolicy<> policy(exec_space, nkj, Kokkos::AUTO);
-  Kokkos::parallel_for(name, policy.set_scratch_size(scr_level,Kokkos::PerTeam(scr_size)),
-  KOKKOS_LAMBDA(TeamMember_t tmember) {
+  auto kernel = KOKKOS_LAMBDA(TeamMember_t tmember) {
     const int k = tmember.league_rank()/nj + kl;
     const int j = tmember.league_rank()%nj + jl;
     function(tmember, k, j);
-  });
+  };
+  LaunchOuter<LB>(name, exec_space, nkj, scr_size, scr_level, kernel);
 }
 
 //------------------------------------------
 // 3D outer parallel loop using Kokkos Teams
-template <typename Function>
+template <typename LB = Kokkos::LaunchBounds<>, typename Function>
 inline void par_for_outer(const std::string &name, DevExeSpace exec_space,
                           size_t scr_size, const int scr_level,
                           const int nl, const int nu, const int kl, const int ku,
@@ -378,21 +593,20 @@ inline void par_for_outer(const std::string &name, DevExeSpace exec_space,
   const int nj = ju - jl + 1;
   const int nkj  = nk*nj;
   const int nnkj = nn*nk*nj;
-  Kokkos::TeamPolicy<> policy(exec_space, nnkj, Kokkos::AUTO);
-  Kokkos::parallel_for(name, policy.set_scratch_size(scr_level,Kokkos::PerTeam(scr_size)),
-  KOKKOS_LAMBDA(TeamMember_t tmember) {
+  auto kernel = KOKKOS_LAMBDA(TeamMember_t tmember) {
     int n = (tmember.league_rank())/nkj;
     int k = (tmember.league_rank() - n*nkj)/nj;
     int j = (tmember.league_rank() - n*nkj - k*nj) + jl;
     n += nl;
     k += kl;
     function(tmember, n, k, j);
-  });
+  };
+  LaunchOuter<LB>(name, exec_space, nnkj, scr_size, scr_level, kernel);
 }
 
 //------------------------------------------
 // 4D outer parallel loop using Kokkos Teams
-template <typename Function>
+template <typename LB = Kokkos::LaunchBounds<>, typename Function>
 inline void par_for_outer(const std::string &name, DevExeSpace exec_space,
                           size_t scr_size, const int scr_level,
                           const int ml, const int mu,
@@ -405,9 +619,7 @@ inline void par_for_outer(const std::string &name, DevExeSpace exec_space,
   const int nkj   = nk*nj;
   const int nnkj  = nn*nk*nj;
   const int nmnkj = nm*nn*nk*nj;
-  Kokkos::TeamPolicy<> policy(exec_space, nmnkj, Kokkos::AUTO);
-  Kokkos::parallel_for(name, policy.set_scratch_size(scr_level,Kokkos::PerTeam(scr_size)),
-  KOKKOS_LAMBDA(TeamMember_t tmember) {
+  auto kernel = KOKKOS_LAMBDA(TeamMember_t tmember) {
     int m = (tmember.league_rank())/nnkj;
     int n = (tmember.league_rank() - m*nnkj)/nkj;
     int k = (tmember.league_rank() - m*nnkj - n*nkj)/nj;
@@ -416,18 +628,52 @@ inline void par_for_outer(const std::string &name, DevExeSpace exec_space,
     n += nl;
     k += kl;
     function(tmember, m, n, k, j);
-  });
+  };
+  LaunchOuter<LB>(name, exec_space, nmnkj, scr_size, scr_level, kernel);
 }
 
 //---------------------------------------------
 // 1D inner parallel loop using TeamVectorRange
+// With host SIMD loops enabled, teams of one thread instead run an explicitly vectorized
+// loop.  This is safe since iterations of inner loops must already be independent to run
+// correctly on GPUs, and avoids the compiler giving up due to possible aliasing of views.
 template <typename Function>
 KOKKOS_INLINE_FUNCTION void par_for_inner(TeamMember_t tmember, const int il,const int iu,
                                           const Function &function) {
+#if HOST_SIMD_ENABLED
+  if (tmember.team_size() == 1) {
+#pragma omp simd
+    for (int i=il; i<=iu; ++i) {
+      function(i);
+    }
+    return;
+  }
+#endif
   // Note Kokkos::TeamVectorRange only iterates from ibegin to iend-1, so must pass iu+1
   Kokkos::parallel_for(Kokkos::TeamVectorRange(tmember, il, iu+1), function);
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void ReallocFirstTouch()
+//! \brief Kokkos::realloc() of a device array that zeroes it with a parallel loop over
+//! all elements, instead of the serial memset used by Kokkos for host memory.  With
+//! OpenMP on multi-socket nodes, pages are then first touched by (and so placed in the
+//! NUMA domain of) the threads that later work on them, since par_for and par_for_outer
+//! loops over (m,n,k,j,i) statically divide arrays between threads into the same
+//! contiguous parts.
+
+template <typename View, typename... Dims>
+inline void ReallocFirstTouch(View &v, const Dims... dims) {
+  using T = typename View::value_type;
+  Kokkos::realloc(Kokkos::WithoutInitializing, v, dims...);
+  T *data = v.data();
+  std::size_t n = v.span();
+  Kokkos::parallel_for("first_touch", Kokkos::RangePolicy<>(DevExeSpace(), 0, n),
+  KOKKOS_LAMBDA(const std::size_t idx) {
+    data[idx] = T(0);
+  });
+}
+
 #define NREDUCTION_VARIABLES 20
 //----------------------------------------------------------------------------------------
 //! \struct summed_array_type
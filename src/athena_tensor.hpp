@@ -22,6 +22,57 @@ enum class TensorSymm {
   SYM22,    // symmetric in the last 2 pairs of indices
 };
 
+//----------------------------------------------------------------------------------------
+// Compile-time index maps from tensor indices to packed storage.  Symmetric index pairs
+// (a,b) are stored in upper-triangular order (00,01,02,11,12,22 for ndim=3).  Since the
+// symmetry and dimension are template parameters the maps reduce to constants once the
+// loops over tensor indices are unrolled, and no index tables are stored in (or copied
+// into) each tensor.
+namespace tensor_idx {
+
+KOKKOS_INLINE_FUNCTION
+constexpr int Sym(int const ndim, int const a, int const b) {
+  return (a <= b)? a*ndim - (a*(a-1))/2 + (b-a) : b*ndim - (b*(b-1))/2 + (a-b);
+}
+
+template<TensorSymm sym, int ndim>
+KOKKOS_INLINE_FUNCTION
+constexpr int Idx(int const a, int const b) {
+  return (sym == TensorSymm::NONE)? a*ndim + b : Sym(ndim, a, b);
+}
+
+template<TensorSymm sym, int ndim>
+KOKKOS_INLINE_FUNCTION
+constexpr int Idx(int const a, int const b, int const c) {
+  return (sym == TensorSymm::SYM2)?  a*(ndim*(ndim+1))/2 + Sym(ndim, b, c) :
+         (sym == TensorSymm::ISYM2)? Sym(ndim, a, b)*ndim + c :
+                                     (a*ndim + b)*ndim + c;
+}
+
+template<TensorSymm sym, int ndim>
+KOKKOS_INLINE_FUNCTION
+constexpr int Idx(int const a, int const b, int const c, int const d) {
+  return (sym == TensorSymm::SYM2)?  (a*ndim + b)*(ndim*(ndim+1))/2 + Sym(ndim, c, d) :
+         (sym == TensorSymm::ISYM2)? (Sym(ndim, a, b)*ndim + c)*ndim + d :
+         (sym == TensorSymm::SYM22)? Sym(ndim, a, b)*(ndim*(ndim+1))/2 + Sym(ndim, c, d) :
+                                     ((a*ndim + b)*ndim + c)*ndim + d;
+}
+
+// number of independent components of a tensor of given rank and symmetry
+template<TensorSymm sym, int ndim, int rank>
+KOKKOS_INLINE_FUNCTION
+constexpr int NDof() {
+  return (rank < 2 || sym == TensorSymm::NONE)? ((rank == 0)? 1 :
+                                                 (rank == 1)? ndim :
+                                                 (rank == 2)? ndim*ndim :
+                                                 (rank == 3)? ndim*ndim*ndim :
+                                                              ndim*ndim*ndim*ndim) :
+         (sym == TensorSymm::SYM22)? ((ndim*(ndim+1))/2)*((ndim*(ndim+1))/2) :
+         ((rank == 2)? 1 : (rank == 3)? ndim : ndim*ndim)*((ndim*(ndim+1))/2);
+}
+
+} // namespace tensor_idx
+
 
 using sub_DvceArray5D_2D = decltype(Kokkos::subview(
                            std::declval<DvceArray5D<Real>>(),
@@ -109,21 +160,22 @@ class AthenaHostTensor<T, sym, ndim, 1> {
 template<typename T, TensorSymm sym, int ndim>
 class AthenaHostTensor<T, sym, ndim, 2> {
  public:
-  AthenaHostTensor();
-  // the default destructor/copy operators are sufficient
+  // the default constructor/destructor/copy operators are sufficient
+  AthenaHostTensor() = default;
   ~AthenaHostTensor() = default;
   AthenaHostTensor(AthenaHostTensor<T, sym, ndim, 2> const &) = default;
   AthenaHostTensor<T, sym, ndim, 2> & operator=
   (AthenaHostTensor<T, sym, ndim, 2> const &) = default;
 
-  int idxmap(int const a, int const b) const {
-    return idxmap_[a][b];
+  KOKKOS_INLINE_FUNCTION
+  static constexpr int idxmap(int const a, int const b) {
+    return tensor_idx::Idx<sym, ndim>(a, b);
   }
   // operators to access the data
   KOKKOS_INLINE_FUNCTION
   decltype(auto) operator() (int const m, int const a, int const b,
                              int const k, int const j, int const i) const {
-    return data_(m,idxmap_[a][b],k,j,i);
+    return data_(m,idxmap(a,b),k,j,i);
   }
   //KOKKOS_INLINE_FUNCTION
   void InitWithShallowSlice(HostArray5D<Real> src, const int indx1, const int indx2) {
@@ -133,35 +185,8 @@ class AthenaHostTensor<T, sym, ndim, 2> {
 
  private:
   sub_HostArray5D_2D data_;
-  int idxmap_[3][3];
-  int ndof_;
 };
 
-//----------------------------------------------------------------------------------------
-// Implementation details
-// They are all duplicated to account for dim 0
-template<typename T, TensorSymm sym, int ndim>
-AthenaHostTensor<T, sym, ndim, 2>::AthenaHostTensor() {
-  switch(sym) {
-    case TensorSymm::NONE:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = 0; b < ndim; ++b) {
-        idxmap_[a][b] = ndof_++;
-      }
-      break;
-    case TensorSymm::SYM2:
-    case TensorSymm::ISYM2:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = a; b < ndim; ++b) {
-        idxmap_[a][b] = ndof_++;
-        idxmap_[b][a] = idxmap_[a][b];
-      }
-      break;
-  }
-}
-
 
 // this is the abstract base class
 // This now works only for spatially 3D data
@@ -225,21 +250,22 @@ class AthenaTensor<T, sym, ndim, 1> {
 template<typename T, TensorSymm sym, int ndim>
 class AthenaTensor<T, sym, ndim, 2> {
  public:
-  AthenaTensor();
-  // the default destructor/copy operators are sufficient
+  // the default constructor/destructor/copy operators are sufficient
+  AthenaTensor() = default;
   ~AthenaTensor() = default;
   AthenaTensor(AthenaTensor<T, sym, ndim, 2> const &) = default;
   AthenaTensor<T, sym, ndim, 2> & operator=
   (AthenaTensor<T, sym, ndim, 2> const &) = default;
 
-  int idxmap(int const a, int const b) const {
-    return idxmap_[a][b];
+  KOKKOS_INLINE_FUNCTION
+  static constexpr int idxmap(int const a, int const b) {
+    return tensor_idx::Idx<sym, ndim>(a, b);
   }
   // operators to access the data
   KOKKOS_INLINE_FUNCTION
   decltype(auto) operator() (int const m, int const a, int const b,
                              int const k, int const j, int const i) const {
-    return data_(m,idxmap_[a][b],k,j,i);
+    return data_(m,idxmap(a,b),k,j,i);
   }
   //KOKKOS_INLINE_FUNCTION
   void InitWithShallowSlice(DvceArray5D<Real> src, const int indx1, const int indx2) {
@@ -249,38 +275,11 @@ class AthenaTensor<T, sym, ndim, 2> {
 
  private:
   sub_DvceArray5D_2D data_;
-  int idxmap_[3][3];
-  int ndof_;
 };
 
-//----------------------------------------------------------------------------------------
-// Implementation details
-// They are all duplicated to account for dim 0
-template<typename T, TensorSymm sym, int ndim>
-AthenaTensor<T, sym, ndim, 2>::AthenaTensor() {
-  switch(sym) {
-    case TensorSymm::NONE:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = 0; b < ndim; ++b) {
-        idxmap_[a][b] = ndof_++;
-      }
-      break;
-    case TensorSymm::SYM2:
-    case TensorSymm::ISYM2:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = a; b < ndim; ++b) {
-        idxmap_[a][b] = ndof_++;
-        idxmap_[b][a] = idxmap_[a][b];
-      }
-      break;
-  }
-}
 
-
-// Here tensors are defined as static 1D arrays, with compile-time dimension calculated as
-// dim**rank
+// Here tensors are defined as static 1D arrays, with compile-time dimension equal to the
+// number of independent components
 // this is the abstract base class
 template<typename T, TensorSymm sym, int ndim, int rank>
 class AthenaScratchTensor;
@@ -314,7 +313,7 @@ class AthenaScratchTensor<T, sym, ndim, 1> {
   }
 
  private:
-  Real data_[3];
+  Real data_[ndim];
 };
 
 //----------------------------------------------------------------------------------------
@@ -323,224 +322,108 @@ class AthenaScratchTensor<T, sym, ndim, 1> {
 template<typename T, TensorSymm sym, int ndim>
 class AthenaScratchTensor<T, sym, ndim, 2> {
  public:
-  KOKKOS_INLINE_FUNCTION
-  AthenaScratchTensor();
-  // the default destructor/copy operators are sufficient
+  // the default constructor/destructor/copy operators are sufficient
+  AthenaScratchTensor() = default;
   ~AthenaScratchTensor() = default;
   AthenaScratchTensor(AthenaScratchTensor<T, sym, ndim, 2> const &) = default;
   AthenaScratchTensor<T, sym, ndim, 2> & operator=
   (AthenaScratchTensor<T, sym, ndim, 2> const &) = default;
   KOKKOS_INLINE_FUNCTION
-  int idxmap(int const a, int const b) const {
-    return idxmap_[a][b];
+  static constexpr int idxmap(int const a, int const b) {
+    return tensor_idx::Idx<sym, ndim>(a, b);
   }
   KOKKOS_INLINE_FUNCTION
   Real operator()(int const a, int const b) const {
-    return data_[idxmap_[a][b]];
+    return data_[idxmap(a, b)];
   }
   KOKKOS_INLINE_FUNCTION
   Real & operator()(int const a, int const b) {
-    return data_[idxmap_[a][b]];
+    return data_[idxmap(a, b)];
   }
   KOKKOS_INLINE_FUNCTION
   void ZeroClear() {
-    for (int i = 0; i < ndim*ndim; ++i) {
+    for (int i = 0; i < ndof_; ++i) {
       data_[i] = 0.0;
     }
   }
 
  private:
-  Real data_[9];
-  int idxmap_[3][3];
-  int ndof_;
+  static constexpr int ndof_ = tensor_idx::NDof<sym, ndim, 2>();
+  Real data_[ndof_];
 };
 
-//----------------------------------------------------------------------------------------
-// Implementation details
-template<typename T, TensorSymm sym, int ndim>
-KOKKOS_INLINE_FUNCTION
-AthenaScratchTensor<T, sym, ndim, 2>::AthenaScratchTensor() {
-switch(sym) {
-    case TensorSymm::NONE:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = 0; b < ndim; ++b) {
-        idxmap_[a][b] = ndof_++;
-      }
-      break;
-    case TensorSymm::SYM2:
-    case TensorSymm::ISYM2:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = a; b < ndim; ++b) {
-        idxmap_[a][b] = ndof_++;
-        idxmap_[b][a] = idxmap_[a][b];
-      }
-      break;
-  }
-}
-
 //----------------------------------------------------------------------------------------
 // rank 3 AthenaScratchTensor
 // This is a 0D AthenaScratchTensor
 template<typename T, TensorSymm sym, int ndim>
 class AthenaScratchTensor<T, sym, ndim, 3> {
  public:
-  KOKKOS_INLINE_FUNCTION
-  AthenaScratchTensor();
-  // the default destructor/copy operators are sufficient
+  // the default constructor/destructor/copy operators are sufficient
+  AthenaScratchTensor() = default;
   ~AthenaScratchTensor() = default;
   AthenaScratchTensor(AthenaScratchTensor<T, sym, ndim, 3> const &) = default;
   AthenaScratchTensor<T, sym, ndim, 3> & operator=
   (AthenaScratchTensor<T, sym, ndim, 3> const &) = default;
   KOKKOS_INLINE_FUNCTION
-  int idxmap(int const a, int const b, int const c) const {
-    return idxmap_[a][b][c];
+  static constexpr int idxmap(int const a, int const b, int const c) {
+    return tensor_idx::Idx<sym, ndim>(a, b, c);
   }
   KOKKOS_INLINE_FUNCTION
   Real operator()(int const a, int const b, int const c) const {
-    return data_[idxmap_[a][b][c]];
+    return data_[idxmap(a, b, c)];
   }
   KOKKOS_INLINE_FUNCTION
   Real & operator()(int const a, int const b, int const c) {
-    return data_[idxmap_[a][b][c]];
+    return data_[idxmap(a, b, c)];
   }
   KOKKOS_INLINE_FUNCTION
   void ZeroClear() {
-    for (int i = 0; i < ndim*ndim*ndim; ++i) {
+    for (int i = 0; i < ndof_; ++i) {
       data_[i] = 0.0;
     }
   }
 
  private:
-  Real data_[27];
-  int idxmap_[3][3][3];
-  int ndof_;
+  static constexpr int ndof_ = tensor_idx::NDof<sym, ndim, 3>();
+  Real data_[ndof_];
 };
 
-//----------------------------------------------------------------------------------------
-// Implementation details
-template<typename T, TensorSymm sym, int ndim>
-KOKKOS_INLINE_FUNCTION
-AthenaScratchTensor<T, sym, ndim, 3>::AthenaScratchTensor() {
-  switch(sym) {
-    case TensorSymm::NONE:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = 0; b < ndim; ++b)
-      for(int c = 0; c < ndim; ++c) {
-        idxmap_[a][b][c] = ndof_++;
-      }
-      break;
-    case TensorSymm::SYM2:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = 0; b < ndim; ++b)
-      for(int c = b; c < ndim; ++c) {
-        idxmap_[a][b][c] = ndof_++;
-        idxmap_[a][c][b] = idxmap_[a][b][c];
-      }
-      break;
-    case TensorSymm::ISYM2:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = a; b < ndim; ++b)
-      for(int c = 0; c < ndim; ++c) {
-        idxmap_[a][b][c] = ndof_++;
-        idxmap_[b][a][c] = idxmap_[a][b][c];
-      }
-      break;
-  }
-}
-
 //----------------------------------------------------------------------------------------
 // rank 4 AthenaScratchTensor
 // This is a 0D AthenaScratchTensor
 template<typename T, TensorSymm sym, int ndim>
 class AthenaScratchTensor<T, sym, ndim, 4> {
  public:
-  KOKKOS_INLINE_FUNCTION
-  AthenaScratchTensor();
-  // the default destructor/copy operators are sufficient
+  // the default constructor/destructor/copy operators are sufficient
+  AthenaScratchTensor() = default;
   ~AthenaScratchTensor() = default;
   AthenaScratchTensor(AthenaScratchTensor<T, sym, ndim, 4> const &) = default;
   AthenaScratchTensor<T, sym, ndim, 4> & operator=
   (AthenaScratchTensor<T, sym, ndim, 4> const &) = default;
   KOKKOS_INLINE_FUNCTION
-  int idxmap(int const a, int const b, int const c, int const d) const {
-    return idxmap_[a][b][c][d];
+  static constexpr int idxmap(int const a, int const b, int const c, int const d) {
+    return tensor_idx::Idx<sym, ndim>(a, b, c, d);
   }
   KOKKOS_INLINE_FUNCTION
   Real operator()(int const a, int const b,
                   int const c, int const d) const {
-    return data_[idxmap_[a][b][c][d]];
+    return data_[idxmap(a, b, c, d)];
   }
   KOKKOS_INLINE_FUNCTION
   Real & operator()(int const a, int const b,
                     int const c, int const d) {
-    return data_[idxmap_[a][b][c][d]];
+    return data_[idxmap(a, b, c, d)];
   }
   KOKKOS_INLINE_FUNCTION
   void ZeroClear() {
-    for (int i = 0; i < ndim*ndim*ndim*ndim; ++i) {
+    for (int i = 0; i < ndof_; ++i) {
       data_[i] = 0.0;
     }
   }
 
  private:
-  Real data_[81];
-  int idxmap_[3][3][3][3];
-  int ndof_;
+  static constexpr int ndof_ = tensor_idx::NDof<sym, ndim, 4>();
+  Real data_[ndof_];
 };
 
-//----------------------------------------------------------------------------------------
-// Implementation details
-template<typename T, TensorSymm sym, int ndim>
-KOKKOS_INLINE_FUNCTION
-AthenaScratchTensor<T, sym, ndim, 4>::AthenaScratchTensor() {
-  switch(sym) {
-    case TensorSymm::NONE:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = 0; b < ndim; ++b)
-      for(int c = 0; c < ndim; ++c)
-      for(int d = 0; d < ndim; ++d) {
-        idxmap_[a][b][c][d] = ndof_++;
-      }
-      break;
-    case TensorSymm::SYM2:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = 0; b < ndim; ++b)
-      for(int c = 0; c < ndim; ++c)
-      for(int d = c; d < ndim; ++d) {
-        idxmap_[a][b][c][d] = ndof_++;
-        idxmap_[a][b][d][c] = idxmap_[a][b][c][d];
-      }
-      break;
-    case TensorSymm::ISYM2:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = a; b < ndim; ++b)
-      for(int c = 0; c < ndim; ++c)
-      for(int d = 0; d < ndim; ++d) {
-        idxmap_[a][b][c][d] = ndof_++;
-        idxmap_[b][a][c][d] = idxmap_[a][b][c][d];
-      }
-      break;
-    case TensorSymm::SYM22:
-      ndof_ = 0;
-      for(int a = 0; a < ndim; ++a)
-      for(int b = a; b < ndim; ++b)
-      for(int c = 0; c < ndim; ++c)
-      for(int d = c; d < ndim; ++d) {
-        idxmap_[a][b][c][d] = ndof_++;
-        idxmap_[b][a][c][d] = idxmap_[a][b][c][d];
-        idxmap_[a][b][d][c] = idxmap_[a][b][c][d];
-        idxmap_[b][a][d][c] = idxmap_[a][b][c][d];
-      }
-      break;
-  }
-}
-
 #endif // ATHENA_TENSOR_HPP_
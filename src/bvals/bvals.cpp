@@ -11,15 +11,39 @@
 #include <iostream>
 #include <utility>
 #include <algorithm> // max
+#include <string>
+#include <vector>
 
 #include "athena.hpp"
 #include "globals.hpp"
 #include "parameter_input.hpp"
 #include "mesh/nghbr_index.hpp"
 #include "mesh/mesh.hpp"
+#include "driver/memory_tracker.hpp"
 #include "particles/particles.hpp"
 #include "bvals.hpp"
 
+#if MPI_PARALLEL_ENABLED && defined(OPEN_MPI) && OPEN_MPI
+#include <mpi-ext.h>  // OpenMPI extensions to query GPU-aware support
+#endif
+
+#if MPI_PARALLEL_ENABLED
+//----------------------------------------------------------------------------------------
+//! \fn int QueryGPUAwareMPI()
+//! \brief Returns 1 if MPI library reports it can access device buffers, 0 if it reports
+//! it cannot, and -1 if library provides no way to query support.
+
+static int QueryGPUAwareMPI() {
+#if defined(KOKKOS_ENABLE_CUDA) && defined(MPIX_CUDA_AWARE_SUPPORT)
+  return MPIX_Query_cuda_support();
+#elif defined(KOKKOS_ENABLE_HIP) && defined(MPIX_ROCM_AWARE_SUPPORT)
+  return MPIX_Query_rocm_support();
+#else
+  return -1;
+#endif
+}
+#endif
+
 //----------------------------------------------------------------------------------------
 // MeshBoundaryValues constructor:
 
@@ -39,6 +63,7 @@ MeshBoundaryValues::MeshBoundaryValues(MeshBlockPack *pp, ParameterInput *pin, b
 #if MPI_PARALLEL_ENABLED
     // allocate vector of MPI requests (if needed)
     int nmb = std::max((pmy_pack->nmb_thispack), (pmy_pack->pmesh->nmb_maxperrank));
+    nreq_ = nmb;
     sendbuf[n].vars_req = new MPI_Request[nmb];
     sendbuf[n].flux_req = new MPI_Request[nmb];
     recvbuf[n].vars_req = new MPI_Request[nmb];
@@ -65,10 +90,70 @@ MeshBoundaryValues::MeshBoundaryValues(MeshBlockPack *pp, ParameterInput *pin, b
     recvbuf[n].iflxc_ndat = 0;
   }
 
+  // all ghost zones are exchanged unless set otherwise by SetGhostDepth()
+  nghost_same = pp->pmesh->mb_indcs.ng;
+
+  // same-rank exchanges at the same level skip the buffers (not used for Z4c with
+  // SMR/AMR, which also sends coarse data between MeshBlocks at the same level)
+  direct_onrank_copy = pin->GetOrAddBoolean("mesh", "direct_onrank_copy", false);
+  if (is_z4c_ && pp->pmesh->multilevel) {direct_onrank_copy = false;}
+
+  // buffers of variables leased from a pool shared by all modules in this pack
+  pool_bufs = pin->GetOrAddBoolean("mesh", "shared_bvals_pool", false);
+  if (pool_bufs && pp->pbuf_pool == nullptr) {pp->pbuf_pool = new BoundaryBufferPool();}
+
 #if MPI_PARALLEL_ENABLED
   // create unique communicators for variables and fluxes in this BoundaryValues object
-  MPI_Comm_dup(MPI_COMM_WORLD, &comm_vars);
-  MPI_Comm_dup(MPI_COMM_WORLD, &comm_flux);
+  MPI_Comm_dup(global_variable::mpi_comm, &comm_vars);
+  MPI_Comm_dup(global_variable::mpi_comm, &comm_flux);
+
+  // persistent requests cut per-message overhead, rebuilt only when neighbors change
+  persistent_mpi = pin->GetOrAddBoolean("mesh", "persistent_mpi", false);
+  // send one message containing all buffers of variables between each pair of ranks
+  aggregate_mpi = pin->GetOrAddBoolean("mesh", "aggregate_mpi", false);
+  // write aggregated messages to ranks on same node directly into their device buffers
+  node_ipc = pin->GetOrAddBoolean("mesh", "node_ipc_halos", false);
+  if (node_ipc) {
+#if defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_HIP)
+    aggregate_mpi = true;
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(global_variable::mpi_comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+                        &node_comm);
+    int nlocal;
+    MPI_Comm_size(node_comm, &nlocal);
+    node_ranks.resize(nlocal);
+    MPI_Allgather(&global_variable::my_rank, 1, MPI_INT, node_ranks.data(), 1, MPI_INT,
+                  node_comm);
+    MPI_Comm_free(&node_comm);
+    std::sort(node_ranks.begin(), node_ranks.end());
+#else
+    if (global_variable::my_rank == 0) {
+      std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<mesh>/node_ipc_halos requires a CUDA or HIP build, "
+                << "and is ignored" << std::endl;
+    }
+    node_ipc = false;
+#endif
+  }
+
+  // Device buffers are passed directly to MPI only if the MPI library is GPU-aware.
+  // Otherwise messages are copied through pinned host buffers.  Not needed if device
+  // memory is accessible from host (e.g. CPU builds).
+  if (!(Kokkos::SpaceAccessibility<Kokkos::DefaultHostExecutionSpace,
+                                   DevMemSpace>::accessible)) {
+    bool gpu_aware = pin->GetOrAddBoolean("mesh", "gpu_aware_mpi",
+                                          static_cast<bool>(GPU_AWARE_MPI_ENABLED));
+    if (gpu_aware && (QueryGPUAwareMPI() == 0)) {
+      if (global_variable::my_rank == 0) {
+        std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<mesh>/gpu_aware_mpi=true but MPI library reports it "
+                  << "is not GPU-aware, MPI messages will be staged through host memory"
+                  << std::endl;
+      }
+      gpu_aware = false;
+    }
+    stage_mpi_bufs = !(gpu_aware);
+  }
 #endif
 }
 
@@ -79,11 +164,26 @@ MeshBoundaryValues::~MeshBoundaryValues() {
 #if MPI_PARALLEL_ENABLED
   int nnghbr = pmy_pack->pmb->nnghbr;
   for (int n=0; n<nnghbr; ++n) {
+    // free any persistent requests
+    for (int m=0; m<nreq_; ++m) {
+      MPI_Request *reqs[4] = {&(sendbuf[n].vars_req[m]), &(sendbuf[n].flux_req[m]),
+                              &(recvbuf[n].vars_req[m]), &(recvbuf[n].flux_req[m])};
+      for (auto req : reqs) {
+        if (*req != MPI_REQUEST_NULL) {MPI_Request_free(req);}
+      }
+    }
     delete [] sendbuf[n].vars_req;
     delete [] sendbuf[n].flux_req;
     delete [] recvbuf[n].vars_req;
     delete [] recvbuf[n].flux_req;
   }
+  for (auto &req : agg_vars.send_req) {
+    if (req != MPI_REQUEST_NULL) {MPI_Request_free(&req);}
+  }
+  for (auto &req : agg_vars.recv_req) {
+    if (req != MPI_REQUEST_NULL) {MPI_Request_free(&req);}
+  }
+  FreeNodeIPC();
 #endif
 }
 
@@ -97,6 +197,7 @@ MeshBoundaryValues::~MeshBoundaryValues() {
 //! virtual functions that only get instantiated when the derived classes are constructed
 
 void MeshBoundaryValues::InitializeBuffers(const int nvar) {
+  memory_tracker::Scope mem_scope("bvals");
   // allocate memory for inflow BCs (but only if domain not strictly periodic)
   if (!(pmy_pack->pmesh->strictly_periodic)) {
     Kokkos::realloc(u_in, nvar, 6);
@@ -112,18 +213,29 @@ void MeshBoundaryValues::InitializeBuffers(const int nvar) {
     if (pmy_pack->pmesh->three_d) nfz = 2;
   }
 
+#if MPI_PARALLEL_ENABLED
+  // leased buffers change address with every exchange
+  if (pool_bufs && (persistent_mpi || aggregate_mpi)) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "<mesh>/shared_bvals_pool cannot be used with persistent "
+              << "or aggregated MPI messages" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+#endif
+
   // initialize buffers used for uniform grid and SMR/AMR calculations
 
   // x1 faces; NeighborIndex = [0,...,7]
   int nmb = std::max((pmy_pack->nmb_thispack), (pmy_pack->pmesh->nmb_maxperrank));
+  nmb_bufs_ = nmb;
   for (int n=-1; n<=1; n+=2) {
     for (int fz=0; fz<nfz; fz++) {
       for (int fy = 0; fy<nfy; fy++) {
         int indx = NeighborIndex(n,0,0,fy,fz);
         InitSendIndices(sendbuf[indx],n, 0, 0, fy, fz);
         InitRecvIndices(recvbuf[indx],n, 0, 0, fy, fz);
-        sendbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_);
-        recvbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_);
+        sendbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_, pool_bufs);
+        recvbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_, pool_bufs);
         indx++;
       }
     }
@@ -138,8 +250,8 @@ void MeshBoundaryValues::InitializeBuffers(const int nvar) {
           int indx = NeighborIndex(0,m,0,fx,fz);
           InitSendIndices(sendbuf[indx],0, m, 0, fx, fz);
           InitRecvIndices(recvbuf[indx],0, m, 0, fx, fz);
-          sendbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_);
-          recvbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_);
+          sendbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_, pool_bufs);
+          recvbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_, pool_bufs);
           indx++;
         }
       }
@@ -152,8 +264,8 @@ void MeshBoundaryValues::InitializeBuffers(const int nvar) {
           int indx = NeighborIndex(n,m,0,fz,0);
           InitSendIndices(sendbuf[indx],n, m, 0, fz, 0);
           InitRecvIndices(recvbuf[indx],n, m, 0, fz, 0);
-          sendbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_);
-          recvbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_);
+          sendbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_, pool_bufs);
+          recvbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_, pool_bufs);
           indx++;
         }
       }
@@ -169,8 +281,8 @@ void MeshBoundaryValues::InitializeBuffers(const int nvar) {
           int indx = NeighborIndex(0,0,l,fx,fy);
           InitSendIndices(sendbuf[indx],0, 0, l, fx, fy);
           InitRecvIndices(recvbuf[indx],0, 0, l, fx, fy);
-          sendbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_);
-          recvbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_);
+          sendbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_, pool_bufs);
+          recvbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_, pool_bufs);
           indx++;
         }
       }
@@ -183,8 +295,8 @@ void MeshBoundaryValues::InitializeBuffers(const int nvar) {
           int indx = NeighborIndex(n,0,l,fy,0);
           InitSendIndices(sendbuf[indx],n, 0, l, fy, 0);
           InitRecvIndices(recvbuf[indx],n, 0, l, fy, 0);
-          sendbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_);
-          recvbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_);
+          sendbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_, pool_bufs);
+          recvbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_, pool_bufs);
           indx++;
         }
       }
@@ -197,8 +309,8 @@ void MeshBoundaryValues::InitializeBuffers(const int nvar) {
           int indx = NeighborIndex(0,m,l,fx,0);
           InitSendIndices(sendbuf[indx],0, m, l, fx, 0);
           InitRecvIndices(recvbuf[indx],0, m, l, fx, 0);
-          sendbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_);
-          recvbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_);
+          sendbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_, pool_bufs);
+          recvbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_, pool_bufs);
           indx++;
         }
       }
@@ -211,13 +323,208 @@ void MeshBoundaryValues::InitializeBuffers(const int nvar) {
           int indx = NeighborIndex(n,m,l,0,0);
           InitSendIndices(sendbuf[indx],n, m, l, 0, 0);
           InitRecvIndices(recvbuf[indx],n, m, l, 0, 0);
-          sendbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_);
-          recvbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_);
+          sendbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_, pool_bufs);
+          recvbuf[indx].AllocateBuffers(nmb, nvar, is_z4c_, pool_bufs);
+        }
+      }
+    }
+  }
+
+#if MPI_PARALLEL_ENABLED
+  // allocate pinned host copies of buffers when MPI messages are staged through host
+  if (stage_mpi_bufs) {
+    for (int n=0; n<pmy_pack->pmb->nnghbr; ++n) {
+      Kokkos::realloc(sendbuf[n].vars_h, nmb, sendbuf[n].vars_ndat);
+      Kokkos::realloc(sendbuf[n].flux_h, nmb, sendbuf[n].flux.extent_int(1));
+      Kokkos::realloc(recvbuf[n].vars_h, nmb, recvbuf[n].vars_ndat);
+      Kokkos::realloc(recvbuf[n].flux_h, nmb, recvbuf[n].flux.extent_int(1));
+    }
+  }
+#endif
+
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBoundaryValues::BuildNeighborLevelLists()
+//! \brief Stores packed indices (m*nnghbr + n) of all buffers whose neighbor is at a
+//! coarser, the same, or a finer level, and of buffers copied directly on this rank or
+//! through the buffers, into lists used to launch the pack/unpack, prolongation and
+//! flux-correction kernels over only those buffers.  Most buffers in a typical AMR
+//! calculation have a neighbor at the same level, so launching over every (m,n) wastes
+//! most teams.  Only rebuilt when neighbors change (e.g. after AMR).
+
+void MeshBoundaryValues::BuildNeighborLevelLists() {
+  auto &pl = nlev_lists;
+  int version = pmy_pack->pmb->nghbr_version;
+  if (pl.nghbr_version == version) return;
+
+  int nmb = pmy_pack->nmb_thispack;
+  int nnghbr = pmy_pack->pmb->nnghbr;
+  auto &nghbr = pmy_pack->pmb->nghbr;
+  auto &mblev = pmy_pack->pmb->mb_lev;
+  Kokkos::realloc(pl.coar, std::max(nmb*nnghbr, 1));
+  Kokkos::realloc(pl.same, std::max(nmb*nnghbr, 1));
+  Kokkos::realloc(pl.fine, std::max(nmb*nnghbr, 1));
+  Kokkos::realloc(pl.direct, std::max(nmb*nnghbr, 1));
+  Kokkos::realloc(pl.buffered, std::max(nmb*nnghbr, 1));
+  pl.ncoar = 0;
+  pl.nsame = 0;
+  pl.nfine = 0;
+  pl.ndirect = 0;
+  pl.nbuffered = 0;
+  for (int m=0; m<nmb; ++m) {
+    for (int n=0; n<nnghbr; ++n) {
+      if (nghbr.h_view(m,n).gid >= 0) {
+        if (direct_onrank_copy && (nghbr.h_view(m,n).rank == global_variable::my_rank) &&
+            (nghbr.h_view(m,n).lev == mblev.h_view(m))) {
+          pl.direct.h_view(pl.ndirect++) = m*nnghbr + n;
+        } else {
+          pl.buffered.h_view(pl.nbuffered++) = m*nnghbr + n;
         }
+        if (nghbr.h_view(m,n).lev < mblev.h_view(m)) {
+          pl.coar.h_view(pl.ncoar++) = m*nnghbr + n;
+        } else if (nghbr.h_view(m,n).lev == mblev.h_view(m)) {
+          pl.same.h_view(pl.nsame++) = m*nnghbr + n;
+        } else {
+          pl.fine.h_view(pl.nfine++) = m*nnghbr + n;
+        }
+      }
+    }
+  }
+  pl.coar.template modify<HostMemSpace>();
+  pl.coar.template sync<DevMemSpace>();
+  pl.same.template modify<HostMemSpace>();
+  pl.same.template sync<DevMemSpace>();
+  pl.fine.template modify<HostMemSpace>();
+  pl.fine.template sync<DevMemSpace>();
+  pl.direct.template modify<HostMemSpace>();
+  pl.direct.template sync<DevMemSpace>();
+  pl.buffered.template modify<HostMemSpace>();
+  pl.buffered.template sync<DevMemSpace>();
+
+  pl.nghbr_version = version;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBoundaryValues::SetVariableSubset()
+//! \brief Restricts subsequent InitRecv(), PackAndSendCC() and RecvAndUnpackCC() calls
+//! to the listed variables (second index of the input arrays), so that exchanges which
+//! only need some components (e.g. before an output or analysis step) send less data.
+//! All variables are again communicated after ClearVariableSubset().  The same subset
+//! must be set on all ranks for the sends and receives of an exchange.
+
+void MeshBoundaryValues::SetVariableSubset(const std::vector<int> &vars) {
+  nsub_vars = static_cast<int>(vars.size());
+  if (nsub_vars == 0) return;
+  Kokkos::realloc(sub_vars, nsub_vars);
+  for (int i=0; i<nsub_vars; ++i) {
+    if (vars[i] < 0) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Negative variable index " << vars[i]
+                << " in boundary exchange subset" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    sub_vars.h_view(i) = vars[i];
+  }
+  sub_vars.template modify<HostMemSpace>();
+  sub_vars.template sync<DevMemSpace>();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBoundaryValues::SetHaloPrecision()
+//! \brief Reads <block>/halo_single_precision for the physics module owning this object.
+//! If true, MPI messages of variables are sent in single precision, which requires (and
+//! so enables) aggregated messages.  Ghost zones then differ from the values on the
+//! sending rank by the float round-off, so should only be used when this is acceptable.
+
+void MeshBoundaryValues::SetHaloPrecision(ParameterInput *pin, const std::string &block) {
+#if MPI_PARALLEL_ENABLED
+  halo_single_precision = pin->GetOrAddBoolean(block, "halo_single_precision", false);
+  if (halo_single_precision) {aggregate_mpi = true;}
+#endif
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBoundaryValues::SetGhostDepth()
+//! \brief Reads <block>/nghost, the number of ghost zones of the physics module owning
+//! this object that are filled by neighbors (default <mesh>/nghost).  Arrays keep
+//! <mesh>/nghost ghost zones (the deepest requirement of all modules, e.g. Z4c), but
+//! only the inner nghost_same layers are exchanged, which reduces the size of buffers
+//! and messages of modules with narrower stencils.  Outer layers at MeshBlock
+//! boundaries are then not updated, and must not be read by the module.  Only possible
+//! on uniform grids, since prolongation and restriction at fine/coarse boundaries use
+//! all ghost zones.  Must be called before InitializeBuffers().
+
+void MeshBoundaryValues::SetGhostDepth(ParameterInput *pin, const std::string &block) {
+  int ng = pmy_pack->pmesh->mb_indcs.ng;
+  nghost_same = pin->GetOrAddInteger(block, "nghost", ng);
+  if ((nghost_same < 1) || (nghost_same > ng)) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "<" << block << ">/nghost=" << nghost_same << " must be "
+              << "in [1,<mesh>/nghost=" << ng << "]" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  if ((nghost_same < ng) && (pmy_pack->pmesh->multilevel || is_z4c_)) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "<" << block << ">/nghost < <mesh>/nghost can only be "
+              << "used on uniform grids" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBoundaryValues::CountSends()
+//! \brief Counts buffers of nvar variables sent to every neighbor (including those on
+//! this rank, copied without MPI) with <time>/comm_stats.  Called by PackAndSend.
+
+void MeshBoundaryValues::CountSends(int nvar) {
+  if (!(comm_stats::enabled)) return;
+  auto &nghbr = pmy_pack->pmb->nghbr;
+  auto &mblev = pmy_pack->pmb->mb_lev;
+  for (int m=0; m<pmy_pack->nmb_thispack; ++m) {
+    for (int n=0; n<pmy_pack->pmb->nnghbr; ++n) {
+      if (nghbr.h_view(m,n).gid < 0) continue;
+      int dlev = nghbr.h_view(m,n).lev - mblev.h_view(m);
+      int ndat = sendbuf[n].ifine_ndat;
+      if (dlev < 0) {
+        ndat = sendbuf[n].icoar_ndat;
+      } else if (dlev == 0) {
+        ndat = (is_z4c_)? sendbuf[n].isame_z4c_ndat : sendbuf[n].isame_ndat;
       }
+      comm_stats::AddMessage(comm_module, nghbr.h_view(m,n).rank, dlev,
+                             static_cast<double>(nvar*ndat)*sizeof(Real));
     }
   }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBoundaryValues::CountFluxSends()
+//! \brief Counts buffers of fluxes sent for flux correction with <time>/comm_stats, i.e.
+//! to neighbors at a coarser level (and at the same level for face-centered fields) on
+//! faces, and also on edges if edges=true.
 
+void MeshBoundaryValues::CountFluxSends(int nvar, bool edges) {
+  if (!(comm_stats::enabled)) return;
+  auto &nghbr = pmy_pack->pmb->nghbr;
+  auto &mblev = pmy_pack->pmb->mb_lev;
+  for (int m=0; m<pmy_pack->nmb_thispack; ++m) {
+    for (int n=0; n<pmy_pack->pmb->nnghbr; ++n) {
+      // buffers 16-23 and 32-47 are on edges in 3D, and 48-55 on corners
+      bool face = (n<16) || ((n>=24) && (n<32));
+      if ((nghbr.h_view(m,n).gid < 0) || (n>=48) || !(face || edges)) continue;
+      int dlev = nghbr.h_view(m,n).lev - mblev.h_view(m);
+      int ndat = (dlev < 0)? sendbuf[n].iflxc_ndat : sendbuf[n].iflxs_ndat;
+      if ((dlev > 0) || (ndat == 0)) continue;
+      comm_stats::AddMessage(comm_module, nghbr.h_view(m,n).rank, dlev,
+                             static_cast<double>(nvar*ndat)*sizeof(Real));
+    }
+  }
   return;
 }
 
@@ -235,14 +542,10 @@ particles::ParticlesBoundaryValues::ParticlesBoundaryValues(
 #endif
     pmy_part(pp) {
 #if MPI_PARALLEL_ENABLED
-  // Guess that no more than 10% of particles will be communicated to set size of buffer
-  int npart = pmy_part->nprtcl_thispack;
-
-  //resize vectors over number of ranks
-  nsends_eachrank.resize(global_variable::nranks);
-
   // create unique communicator for particles
-  MPI_Comm_dup(MPI_COMM_WORLD, &mpi_comm_part);
+  MPI_Comm_dup(global_variable::mpi_comm, &mpi_comm_part);
+  nghbr_version = -1;
+  mpi_comm_nghbr = MPI_COMM_NULL;
 #endif
 }
 
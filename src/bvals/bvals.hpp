@@ -20,14 +20,36 @@ enum class BoundaryFlag {undef=-1,block, reflect, inflow, outflow, diode, user,
                          shear_periodic, vacuum};
 
 #include <algorithm>
+#include <map>
+#include <string>
 #include <vector>
 
 #include "athena.hpp"
 #include "mesh/mesh.hpp"
 #include "coordinates/coordinates.hpp"
 #include "tasklist/task_list.hpp"
+#include "driver/comm_stats.hpp"
 //#include "particles/particles.hpp"
 
+//----------------------------------------------------------------------------------------
+//! \struct NeighborLevelLists
+//! \brief packed indices (m*nnghbr + n) of all buffers whose neighbor is at a coarser
+//! (coar), the same (same), or a finer (fine) level.  Buffers with a neighbor at any
+//! level are also split into those copied directly between MeshBlocks on this rank
+//! (direct, only with <mesh>/direct_onrank_copy) and all others (buffered).
+//! Pack/unpack, prolongation and flux-correction kernels are launched over only the
+//! buffers they act on, rather than over every (m,n).  Rebuilt only when neighbors
+//! change.
+
+struct NeighborLevelLists {
+  int nghbr_version = -1;               // neighbor version for which lists were built
+  int ncoar = 0, nsame = 0, nfine = 0;  // number of entries in each list
+  int ndirect = 0, nbuffered = 0;
+  DualArray1D<int> coar, same, fine, direct, buffered;
+  NeighborLevelLists() : coar("nlev_coar",1), same("nlev_same",1), fine("nlev_fine",1),
+                         direct("nlev_direct",1), buffered("nlev_buffered",1) {}
+};
+
 // Forward declarations
 class MeshBlockPack;
 namespace particles {
@@ -74,6 +96,8 @@ struct MeshBoundaryBuffer {
 
   // Maximum number of data elements (bie-bis+1) across 3 components of above
   int isame_ndat, isame_z4c_ndat, icoar_ndat, ifine_ndat, iflxs_ndat, iflxc_ndat;
+  // length of vars for each MeshBlock (set by AllocateBuffers)
+  int vars_ndat = 0;
 
   // 2D Views that store buffer data on device, dimensioned (nmb, ndata)
   DvceArray2D<Real> vars, flux;
@@ -82,24 +106,106 @@ struct MeshBoundaryBuffer {
   // vectors of length (number of MBs) to hold MPI requests
   // Using STL vector causes problems with some GPU compilers, so just use plain C array
   MPI_Request *vars_req, *flux_req;
+  // pinned host copies of buffer data, only allocated when MPI messages are staged
+  HostPinnedArray2D<Real> vars_h, flux_h;
 #endif
 
   // function to allocate memory for buffers for variables and their fluxes
-  // Must only be called after BufferIndcs above are initialized
-  void AllocateBuffers(int nmb, int nvars, bool is_z4c) {
+  // Must only be called after BufferIndcs above are initialized.  With pooled=true vars
+  // is not allocated, but leased from a BoundaryBufferPool during each exchange.
+  void AllocateBuffers(int nmb, int nvars, bool is_z4c, bool pooled) {
     // With Z4c, buffers may contain BOTH same and coarse data
     if (is_z4c) {
-      int nmax = std::max(isame_z4c_ndat, std::max(icoar_ndat, ifine_ndat) );
-      Kokkos::realloc(vars, nmb, (nvars*nmax));
+      vars_ndat = nvars*std::max(isame_z4c_ndat, std::max(icoar_ndat, ifine_ndat) );
     } else {
-      int nmax = std::max(isame_ndat, std::max(icoar_ndat, ifine_ndat) );
-      Kokkos::realloc(vars, nmb, (nvars*nmax));
+      vars_ndat = nvars*std::max(isame_ndat, std::max(icoar_ndat, ifine_ndat) );
     }
+    if (!(pooled)) {Kokkos::realloc(vars, nmb, vars_ndat);}
     int nmax = std::max(iflxs_ndat, iflxc_ndat);
     Kokkos::realloc(flux, nmb, (nvars*nmax));
   }
 };
 
+//----------------------------------------------------------------------------------------
+//! \class BoundaryBufferPool
+//! \brief device memory shared by the buffers of variables of all MeshBoundaryValues in a
+//! MeshBlockPack (<mesh>/shared_bvals_pool = true).  While an exchange is in flight each
+//! MeshBoundaryValues leases one contiguous block for all of its send and recv buffers
+//! (see AcquireBuffers() in bvals_pool.cpp).  Leases that do not fit are allocated
+//! separately, and once none are outstanding the pool grows by the peak total size of
+//! such leases, so after the first cycle it is sized to the peak concurrent exchanges
+//! rather than the sum over all modules.
+
+class BoundaryBufferPool {
+ public:
+  BoundaryBufferPool() : data("bvals_pool",1) {}
+  Real *Lease(size_t ndat);
+  void Release(Real *ptr);
+  size_t Size() const {return data.extent(0);}
+
+ private:
+  DvceArray1D<Real> data;
+  std::map<size_t, size_t> leases_;            // (offset, length) of leases in data
+  std::map<Real*, DvceArray1D<Real>> extra_;   // leases allocated outside of data
+  size_t extra_ndat_ = 0, extra_peak_ = 0;     // current and peak total length of extra_
+};
+
+#if MPI_PARALLEL_ENABLED
+//----------------------------------------------------------------------------------------
+//! \struct StagedMessage
+//! \brief data for an MPI message copied through pinned host memory, used when the MPI
+//! library cannot access device buffers directly
+
+struct StagedMessage {
+  DvceArray2D<Real> dbuf;        // device buffer
+  HostPinnedArray2D<Real> hbuf;  // pinned host copy of buffer
+  int m, ndat;                   // index of MeshBlock in buffer, and length of message
+  int rank, tag;                 // destination rank and tag (only used for sends)
+  MPI_Comm comm;
+  MPI_Request *req;
+};
+
+//----------------------------------------------------------------------------------------
+//! \struct PersistentRequestsInfo
+//! \brief neighbor version and number of variables for which a set of persistent MPI
+//! requests was created.  Requests are rebuilt when either changes.
+
+struct PersistentRequestsInfo {
+  int nghbr_version = -1;
+  int nvar = -1;
+};
+
+//----------------------------------------------------------------------------------------
+//! \struct AggregatedMessages
+//! \brief offset tables, contiguous buffers, and requests used to combine all boundary
+//! buffers sent between a pair of ranks into a single MPI message.  Within each message
+//! buffers are ordered by (MeshBlock index, buffer index) on the *receiving* rank.
+
+struct AggregatedMessages {
+  int nghbr_version = -1;            // neighbor version for which tables were built
+  int nvar = 0;                      // number of variables in each buffer
+  int nsend_bufs = 0, nrecv_bufs = 0;  // total number of buffers in all messages
+  std::vector<int> send_rank, recv_rank;  // ranks that messages are sent to/recv from
+  std::vector<int> send_offst, recv_offst;  // offset of each message (length nrank+1)
+  DualArray2D<int> send_list, recv_list;  // (n, m, offset, ndat) of each buffer
+  DvceArray1D<Real> send_data, recv_data;  // contiguous device buffers
+  HostPinnedArray1D<Real> send_data_h, recv_data_h;  // pinned host copies (if staged)
+  DvceArray1D<float> send_data32, recv_data32;  // single precision messages (if used)
+  HostPinnedArray1D<float> send_data32_h, recv_data32_h;
+  std::vector<MPI_Request> send_req, recv_req;
+  // messages to/from ranks on the same node written directly through CUDA/HIP IPC
+  std::vector<int> send_local, recv_local;    // 1 if rank is on this node
+  std::vector<Real*> send_peer;               // mapped recv buffer of each such rank
+  std::vector<int> send_peer_offst;           // offset of this rank's message within it
+  std::vector<MPI_Request> ready_req;         // "buffer free" signals to each sender
+  Real *ipc_recv = nullptr;                   // recv_data, if allocated for IPC
+  AggregatedMessages() :
+    send_list("agg_slist",1,4), recv_list("agg_rlist",1,4),
+    send_data("agg_sdata",1), recv_data("agg_rdata",1),
+    send_data32("agg_sdata32",1), recv_data32("agg_rdata32",1) {}
+};
+#endif
+
 // Forward declarations
 class MeshBlockPack;
 
@@ -120,15 +226,63 @@ class MeshBoundaryValues {
   // constant inflow states at each face, initialized in problem generator
   DualArray2D<Real> u_in, b_in, i_in;
 
+  // lists of buffers with coarser/same/finer level neighbors, used to launch kernels
+  NeighborLevelLists nlev_lists;
+
+  // indices of subset of CC variables communicated (all variables when nsub_vars=0)
+  int nsub_vars = 0;
+  DualArray1D<int> sub_vars;
+
+  // depth of ghost zones exchanged with neighbors at the same level, which may be less
+  // than <mesh>/nghost (the depth of the arrays) for modules with narrower stencils
+  int nghost_same;
+
+  // cell indices of the grid on which the variables live, if not that of the MeshBlocks
+  // (e.g. radiation evolved on a coarser grid).  Must be set before InitializeBuffers.
+  const RegionIndcs *pgrid_indcs = nullptr;
+
+  // copy CC variables between MeshBlocks at the same level on this rank directly from
+  // interior of source into ghost zones of destination, bypassing the buffers
+  bool direct_onrank_copy = false;
+
+  // lease buffers of variables from pool shared by all modules, rather than allocating
+  // them for the lifetime of this object (<mesh>/shared_bvals_pool)
+  bool pool_bufs = false;
+
+  // module to which bytes and messages sent are attributed with <time>/comm_stats
+  comm_stats::Module comm_module = comm_stats::Module::other;
+
 #if MPI_PARALLEL_ENABLED
   // unique MPI communicators for each case (variables/fluxes)
   MPI_Comm comm_vars, comm_flux;
+  // stage MPI messages through pinned host memory when MPI is not GPU-aware
+  bool stage_mpi_bufs = false;
+  std::vector<StagedMessage> staged_sends, staged_vars_recvs, staged_flux_recvs;
+  // use persistent MPI requests, rebuilt only when neighbors change
+  bool persistent_mpi = false;
+  PersistentRequestsInfo pers_vars_send, pers_vars_recv, pers_flux_send, pers_flux_recv;
+  // combine all buffers of variables sent between each pair of ranks into one message
+  bool aggregate_mpi = false;
+  AggregatedMessages agg_vars;
+  // convert aggregated messages of variables to single precision (lossy) before sending
+  bool halo_single_precision = false;
+  // copy aggregated messages of variables to ranks on the same node device-to-device
+  // through CUDA/HIP IPC, with only zero-byte MPI messages used to synchronize
+  bool node_ipc = false;
+  std::vector<int> node_ranks;  // sorted world ranks on this node (if node_ipc)
 #endif
 
   //functions
   virtual void InitSendIndices(MeshBoundaryBuffer &buf,int x,int y,int z,int a,int b)=0;
   virtual void InitRecvIndices(MeshBoundaryBuffer &buf,int x,int y,int z,int a,int b)=0;
   void InitializeBuffers(const int nvar);
+  void BuildNeighborLevelLists();
+  void SetVariableSubset(const std::vector<int> &vars);
+  void ClearVariableSubset() {nsub_vars = 0;}
+  void SetHaloPrecision(ParameterInput *pin, const std::string &block);
+  void SetGhostDepth(ParameterInput *pin, const std::string &block);
+  void AcquireBuffers();
+  void ReleaseBuffers();
 
   TaskStatus InitRecv(const int nvar);
   virtual TaskStatus InitFluxRecv(const int nvar)=0;
@@ -136,11 +290,35 @@ class MeshBoundaryValues {
   TaskStatus ClearSend();
   TaskStatus ClearFluxRecv();
   TaskStatus ClearFluxSend();
+#if MPI_PARALLEL_ENABLED
+  // collect pointers to all outstanding receives (used by event-driven task scheduler)
+  void GetPendingRecvs(std::vector<MPI_Request*> &reqs);
+  // post sends/receives of buffers, staged through pinned host memory if necessary
+  int PostSend(DvceArray2D<Real> &dbuf, HostPinnedArray2D<Real> &hbuf, int m, int ndat,
+               int rank, int tag, MPI_Comm comm, MPI_Request *req);
+  int FlushStagedSends();
+  int PostRecv(DvceArray2D<Real> &dbuf, HostPinnedArray2D<Real> &hbuf, int m, int ndat,
+               int rank, int tag, MPI_Comm comm, MPI_Request *req,
+               std::vector<StagedMessage> &staged);
+  void CopyStagedRecvs(std::vector<StagedMessage> &staged);
+  // free persistent requests if neighbors or number of variables have changed
+  void ResetPersistentRequests(PersistentRequestsInfo &info, bool send, bool flux,
+                               int nvar);
+  // functions to communicate aggregated messages of variables
+  void BuildAggregatedMessages(int nvar);
+  void SetupNodeIPC(int nrecv);
+  void FreeNodeIPC();
+  int InitRecvAggregated(int nvar);
+  int SendAggregated(int nvar);
+  TaskStatus RecvAggregated();
+  int ClearAggregated(bool send);
+#endif
 
   // BCs associated with various physics modules
   static void HydroBCs(MeshBlockPack *pp, DualArray2D<Real> uin, DvceArray5D<Real> u0);
   static void BFieldBCs(MeshBlockPack *pp, DualArray2D<Real> bin, DvceFaceFld4D<Real> b0);
-  static void RadiationBCs(MeshBlockPack *pp,DualArray2D<Real> iin,DvceArray5D<Real> i0);
+  static void RadiationBCs(MeshBlockPack *pp,DualArray2D<Real> iin,DvceArray5D<Real> i0,
+                           const RegionIndcs *pindcs=nullptr);
   static void Z4cBCs(MeshBlockPack *pp, DualArray2D<Real> uin, DvceArray5D<Real> u0,
                      DvceArray5D<Real> coarse_u0);
 
@@ -149,6 +327,24 @@ class MeshBoundaryValues {
   // many types (Hydro, MHD, Radiation, Z4c, etc.)
   MeshBlockPack* pmy_pack;
   bool is_z4c_;   // flag to denote if this BoundaryValues is for Z4c module
+  // with pool_bufs: leased block, first dimension of buffers, and state of exchange
+  Real *pool_lease_ = nullptr;
+  int nmb_bufs_ = 0;
+  bool bufs_unpacked_ = false;
+  bool recvs_deferred_ = false;
+  int recv_nvar_ = 0;
+
+  // count buffers of variables/fluxes sent to neighbors with <time>/comm_stats
+  void CountSends(int nvar);
+  void CountFluxSends(int nvar, bool edges);
+#if MPI_PARALLEL_ENABLED
+  int nreq_;      // length of arrays of MPI requests in each buffer
+  int MessageSize(MeshBoundaryBuffer &buf, int m, int n, int nvar);
+  int StartSend(void *ptr, int ndat, int rank, int tag, MPI_Comm comm, MPI_Request *req,
+                MPI_Datatype type=MPI_ATHENA_REAL);
+  int StartRecv(void *ptr, int ndat, int rank, int tag, MPI_Comm comm, MPI_Request *req,
+                MPI_Datatype type=MPI_ATHENA_REAL);
+#endif
 };
 
 //----------------------------------------------------------------------------------------
@@ -181,6 +377,15 @@ class MeshBoundaryValuesCC : public MeshBoundaryValues {
                              DvceArray5D<Real> &prim);
   void PrimToConsFineBndry(const DvceArray5D<Real> &prim, const DvceFaceFld4D<Real> &b,
                            DvceArray5D<Real> &cons);
+
+  // functions to add values deposited in ghost zones to the active zones they overlap on
+  // neighbors at the same level (e.g. particle deposits)
+  TaskStatus PackAndSendGhostSumCC(DvceArray5D<Real> &a);
+  TaskStatus RecvAndSumGhostCC(DvceArray5D<Real> &a);
+
+ protected:
+  TaskStatus SendBuffersCC(int nvar);
+  TaskStatus RecvBuffersCC();
 };
 
 //----------------------------------------------------------------------------------------
@@ -219,16 +424,6 @@ struct ParticleLocationData {
   int dest_rank;    // rank of target MeshBlock
 };
 
-// Custom operators to sort ParticleLocationData array by dest_rank or prtcl_indx
-struct {
-  bool operator()(ParticleLocationData a, ParticleLocationData b)
-    const { return a.dest_rank < b.dest_rank; }
-} SortByRank;
-struct {
-  bool operator()(ParticleLocationData a, ParticleLocationData b)
-    const { return a.prtcl_indx < b.prtcl_indx; }
-} SortByIndex;
-
 //----------------------------------------------------------------------------------------
 //! \struct ParticleMessageData
 //! \brief Data describing MPI messages containing particles
@@ -252,15 +447,13 @@ class ParticlesBoundaryValues {
   ~ParticlesBoundaryValues();
 
   int nprtcl_send, nprtcl_recv;
-  DualArray1D<ParticleLocationData> sendlist;
+  DualArray1D<ParticleLocationData> sendlist;   // particles sent, in order of prtcl_indx
 
   // Data needed to count number of messages and particles to send between ranks
   int nsends; // number of MPI sends to neighboring ranks on this rank
   int nrecvs; // number of MPI recvs from neighboring ranks on this rank
-  std::vector<int> nsends_eachrank;                // length nranks
   std::vector<ParticleMessageData> sends_thisrank; // length nsends
   std::vector<ParticleMessageData> recvs_thisrank; // length nrecvs
-  std::vector<ParticleMessageData> sends_allranks; // length ncounts summed over ranks
 
 #if MPI_PARALLEL_ENABLED
   DvceArray1D<Real> prtcl_rsendbuf, prtcl_rrecvbuf;
@@ -268,6 +461,17 @@ class ParticlesBoundaryValues {
   std::vector<MPI_Request> rrecv_req, rsend_req;  // vectors of requests for Reals
   std::vector<MPI_Request> irecv_req, isend_req;  // vectors of requests for ints
   MPI_Comm mpi_comm_part;                       // unique MPI communicators for particles
+
+  // Particles only move into neighboring MeshBlocks, so message counts are exchanged
+  // only with ranks owning MeshBlocks adjacent to this rank, using a distributed graph
+  // communicator that is rebuilt whenever the MeshBlock neighbors change.
+  int nghbr_version;
+  std::vector<int> nghbr_ranks;          // sorted list of neighboring ranks
+  DvceArray1D<int> d_nghbr_ranks;        // same list on device
+  MPI_Comm mpi_comm_nghbr;               // graph communicator over nghbr_ranks
+  DvceArray1D<int> prtcl_dest;           // destination rank of each particle (or -1)
+  DvceArray1D<int> send_order;           // entries of sendlist ordered by dest_rank
+  void SetNeighborRanks();
 #endif
 
   //functions
@@ -278,6 +482,10 @@ class ParticlesBoundaryValues {
   TaskStatus PackAndSendPrtcls();
   TaskStatus ClearPrtclSend();
   TaskStatus RecvAndUnpackPrtcls();
+#if MPI_PARALLEL_ENABLED
+  // collect pointers to all outstanding receives (used by event-driven task scheduler)
+  void GetPendingRecvs(std::vector<MPI_Request*> &reqs);
+#endif
 
  protected:
   particles::Particles* pmy_part;
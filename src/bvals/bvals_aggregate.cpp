@@ -0,0 +1,497 @@
+//========================================================================================
+// Athena++ astrophysical MHD code
+// Copyright(C) 2014 James M. Stone <jmstone@princeton.edu> and other code contributors
+// Licensed under the 3-clause BSD License, see LICENSE file for details
+//========================================================================================
+//! \file bvals_aggregate.cpp
+//! \brief functions to combine all boundary buffers of variables (CC or FC) sent between
+//! each pair of ranks into a single MPI message.  Enabled with <mesh>/aggregate_mpi.
+//!
+//! Buffers are still packed by the usual PackAndSendCC/FC() kernels.  Those destined for
+//! other ranks are then gathered into one contiguous device array (send_data) using an
+//! offset table built whenever the neighbors change, and one message is sent per rank.
+//! On the receiving side the message is scattered back into the individual receive
+//! buffers before the usual unpack kernels are called.  Buffers of fluxes used for flux
+//! correction are still sent individually.
+//!
+//! With <block>/halo_single_precision=true aggregated messages are converted to single
+//! precision in the gather/scatter kernels, halving the bytes sent in double precision
+//! builds.  This is lossy (relative error ~1e-7 in ghost zones only), and is intended
+//! for smooth fields (e.g. z4c) on bandwidth-limited networks.
+//!
+//! With <mesh>/node_ipc_halos=true (CUDA/HIP builds only) messages between ranks on the
+//! same node bypass MPI.  Each receiving rank then allocates recv_data with
+//! cudaMalloc/hipMalloc and exports it with an IPC handle, which every sending rank on
+//! the node maps into its own address space.  Every exchange the receiver signals that
+//! its buffer is free with a zero-byte "ready" message, the sender copies its gathered
+//! send buffer device-to-device into the matching segment of the receiver's recv_data,
+//! and then signals completion with a zero-byte message in place of the data.
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "mesh/mesh.hpp"
+#include "bvals.hpp"
+
+#if MPI_PARALLEL_ENABLED && defined(KOKKOS_ENABLE_CUDA)
+#include <cuda_runtime.h>
+#elif MPI_PARALLEL_ENABLED && defined(KOKKOS_ENABLE_HIP)
+#include <hip/hip_runtime.h>
+#endif
+
+#if MPI_PARALLEL_ENABLED
+namespace {
+// thin wrappers of CUDA/HIP IPC calls, which are never reached in other builds since
+// node_ipc is then disabled in the MeshBoundaryValues constructor
+#if defined(KOKKOS_ENABLE_CUDA)
+using IpcHandle = cudaIpcMemHandle_t;
+inline bool IpcAlloc(Real **p, size_t n) {
+  return (cudaMalloc(reinterpret_cast<void**>(p), n*sizeof(Real)) == cudaSuccess);
+}
+inline void IpcFree(Real *p) {cudaFree(p);}
+inline bool IpcGetHandle(IpcHandle *h, Real *p) {
+  return (cudaIpcGetMemHandle(h, p) == cudaSuccess);
+}
+inline bool IpcOpen(Real **p, IpcHandle h) {
+  return (cudaIpcOpenMemHandle(reinterpret_cast<void**>(p), h,
+                               cudaIpcMemLazyEnablePeerAccess) == cudaSuccess);
+}
+inline void IpcClose(Real *p) {cudaIpcCloseMemHandle(p);}
+#elif defined(KOKKOS_ENABLE_HIP)
+using IpcHandle = hipIpcMemHandle_t;
+inline bool IpcAlloc(Real **p, size_t n) {
+  return (hipMalloc(reinterpret_cast<void**>(p), n*sizeof(Real)) == hipSuccess);
+}
+inline void IpcFree(Real *p) {(void) hipFree(p);}
+inline bool IpcGetHandle(IpcHandle *h, Real *p) {
+  return (hipIpcGetMemHandle(h, p) == hipSuccess);
+}
+inline bool IpcOpen(Real **p, IpcHandle h) {
+  return (hipIpcOpenMemHandle(reinterpret_cast<void**>(p), h,
+                              hipIpcMemLazyEnablePeerAccess) == hipSuccess);
+}
+inline void IpcClose(Real *p) {(void) hipIpcCloseMemHandle(p);}
+#else
+struct IpcHandle {char reserved[64];};
+inline bool IpcAlloc(Real **p, size_t n) {return false;}
+inline void IpcFree(Real *p) {}
+inline bool IpcGetHandle(IpcHandle *h, Real *p) {return false;}
+inline bool IpcOpen(Real **p, IpcHandle h) {return false;}
+inline void IpcClose(Real *p) {}
+#endif
+
+// handle of receive buffer, and offset of message from the sender within it
+struct IpcMessage {
+  IpcHandle handle;
+  int offst;
+};
+
+// tags of messages on comm_vars (data and "done" signals use tag 0)
+constexpr int ipc_ready_tag = 1, ipc_handle_tag = 2;
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn  int MeshBoundaryValues::MessageSize
+//! \brief Returns number of elements of buffer n of MeshBlock m sent to/recv from its
+//! neighbor, which depends on whether the neighbor is at a coarser/same/finer level.
+
+int MeshBoundaryValues::MessageSize(MeshBoundaryBuffer &buf, int m, int n, int nvar) {
+  auto &nghbr = pmy_pack->pmb->nghbr;
+  auto &mblev = pmy_pack->pmb->mb_lev;
+  if (nghbr.h_view(m,n).lev < mblev.h_view(m)) {
+    return nvar*buf.icoar_ndat;
+  } else if (nghbr.h_view(m,n).lev == mblev.h_view(m)) {
+    return (is_z4c_)? nvar*buf.isame_z4c_ndat : nvar*buf.isame_ndat;
+  }
+  return nvar*buf.ifine_ndat;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void MeshBoundaryValues::BuildAggregatedMessages
+//! \brief Builds tables of offsets of every buffer within the aggregated message to/from
+//! each rank, and allocates contiguous send/recv arrays.  Only rebuilt when neighbors
+//! (or number of variables) change.  Sender and receiver must agree on order of buffers
+//! within each message, so sends are sorted by (local ID, buffer index) of *receiving*
+//! MeshBlock, which is exactly the order of receives sorted by (m,n) on receiving rank.
+
+void MeshBoundaryValues::BuildAggregatedMessages(int nvar) {
+  auto &ag = agg_vars;
+  int version = pmy_pack->pmb->nghbr_version;
+  if ((ag.nghbr_version == version) && (ag.nvar == nvar)) return;
+
+  // free persistent requests, since buffers they point to are reallocated below.
+  // Requests are inactive, since ClearSend/ClearRecv wait on them every stage.
+  for (auto &req : ag.send_req) {
+    if (req != MPI_REQUEST_NULL) {MPI_Request_free(&req);}
+  }
+  for (auto &req : ag.recv_req) {
+    if (req != MPI_REQUEST_NULL) {MPI_Request_free(&req);}
+  }
+
+  int my_rank = global_variable::my_rank;
+  int nmb = pmy_pack->nmb_thispack;
+  int nnghbr = pmy_pack->pmb->nnghbr;
+  auto &nghbr = pmy_pack->pmb->nghbr;
+
+  // (rank, receiving MB, receiving buffer, m, n, ndat) of every remote buffer
+  std::vector<std::tuple<int,int,int,int,int,int>> slist, rlist;
+  for (int m=0; m<nmb; ++m) {
+    for (int n=0; n<nnghbr; ++n) {
+      int drank = nghbr.h_view(m,n).rank;
+      if ((nghbr.h_view(m,n).gid >= 0) && (drank != my_rank)) {
+        int lid = nghbr.h_view(m,n).gid - pmy_pack->pmesh->gids_eachrank[drank];
+        int dn = nghbr.h_view(m,n).dest;
+        slist.emplace_back(drank, lid, dn, m, n, MessageSize(sendbuf[n], m, n, nvar));
+        rlist.emplace_back(drank, m, n, m, n, MessageSize(recvbuf[n], m, n, nvar));
+      }
+    }
+  }
+  std::sort(slist.begin(), slist.end());
+  std::sort(rlist.begin(), rlist.end());
+
+  // store offsets of each buffer, and offsets and ranks of each aggregated message
+  auto build = [](std::vector<std::tuple<int,int,int,int,int,int>> &list,
+                  DualArray2D<int> &tbl, std::vector<int> &ranks,
+                  std::vector<int> &offst) {
+    ranks.clear();
+    offst.clear();
+    Kokkos::realloc(tbl, std::max(static_cast<int>(list.size()), 1), 4);
+    int ndat = 0;
+    for (int i=0; i<static_cast<int>(list.size()); ++i) {
+      int rank = std::get<0>(list[i]);
+      if (ranks.empty() || ranks.back() != rank) {
+        ranks.push_back(rank);
+        offst.push_back(ndat);
+      }
+      tbl.h_view(i,0) = std::get<4>(list[i]);
+      tbl.h_view(i,1) = std::get<3>(list[i]);
+      tbl.h_view(i,2) = ndat;
+      tbl.h_view(i,3) = std::get<5>(list[i]);
+      ndat += std::get<5>(list[i]);
+    }
+    offst.push_back(ndat);
+    tbl.template modify<HostMemSpace>();
+    tbl.template sync<DevMemSpace>();
+    return ndat;
+  };
+  int nsend = build(slist, ag.send_list, ag.send_rank, ag.send_offst);
+  int nrecv = build(rlist, ag.recv_list, ag.recv_rank, ag.recv_offst);
+  ag.nsend_bufs = static_cast<int>(slist.size());
+  ag.nrecv_bufs = static_cast<int>(rlist.size());
+
+  if (halo_single_precision) {
+    Kokkos::realloc(ag.send_data32, std::max(nsend, 1));
+    Kokkos::realloc(ag.recv_data32, std::max(nrecv, 1));
+    if (stage_mpi_bufs) {
+      Kokkos::realloc(ag.send_data32_h, std::max(nsend, 1));
+      Kokkos::realloc(ag.recv_data32_h, std::max(nrecv, 1));
+    }
+  } else {
+    Kokkos::realloc(ag.send_data, std::max(nsend, 1));
+    Kokkos::realloc(ag.recv_data, std::max(nrecv, 1));
+    if (stage_mpi_bufs) {
+      Kokkos::realloc(ag.send_data_h, std::max(nsend, 1));
+      Kokkos::realloc(ag.recv_data_h, std::max(nrecv, 1));
+    }
+  }
+  ag.send_req.assign(ag.send_rank.size(), MPI_REQUEST_NULL);
+  ag.recv_req.assign(ag.recv_rank.size(), MPI_REQUEST_NULL);
+  SetupNodeIPC(nrecv);
+
+  ag.nghbr_version = version;
+  ag.nvar = nvar;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void MeshBoundaryValues::SetupNodeIPC
+//! \brief Marks which ranks messages are sent to/received from are on this node, and (if
+//! node_ipc) allocates recv_data so it can be shared and maps the recv_data of every
+//! node-local rank messages are sent to.  Called by BuildAggregatedMessages on all ranks
+//! with the same neighbors, so the blocking exchange of handles below cannot deadlock.
+
+void MeshBoundaryValues::SetupNodeIPC(int nrecv) {
+  auto &ag = agg_vars;
+  FreeNodeIPC();
+  ag.send_local.assign(ag.send_rank.size(), 0);
+  ag.recv_local.assign(ag.recv_rank.size(), 0);
+  ag.send_peer.assign(ag.send_rank.size(), nullptr);
+  ag.send_peer_offst.assign(ag.send_rank.size(), 0);
+  ag.ready_req.assign(ag.recv_rank.size(), MPI_REQUEST_NULL);
+  if (!(node_ipc) || halo_single_precision) return;
+
+  bool any_recv = false;
+  for (int r=0; r<static_cast<int>(ag.recv_rank.size()); ++r) {
+    ag.recv_local[r] = std::binary_search(node_ranks.begin(), node_ranks.end(),
+                                          ag.recv_rank[r]);
+    if (ag.recv_local[r]) {any_recv = true;}
+  }
+  for (int r=0; r<static_cast<int>(ag.send_rank.size()); ++r) {
+    ag.send_local[r] = std::binary_search(node_ranks.begin(), node_ranks.end(),
+                                          ag.send_rank[r]);
+  }
+
+  // Kokkos may use stream-ordered allocations, which cannot be exported, so recv_data is
+  // replaced by an unmanaged view of memory allocated directly
+  if (any_recv) {
+    Real *ptr;
+    if (!IpcAlloc(&ptr, std::max(nrecv, 1))) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Could not allocate IPC receive buffer" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    ag.ipc_recv = ptr;
+    ag.recv_data = DvceArray1D<Real>(ptr, std::max(nrecv, 1));
+  }
+
+  // send handle to each node-local sender, and map buffers of node-local receivers
+  std::vector<IpcMessage> smsg(ag.recv_rank.size()), rmsg(ag.send_rank.size());
+  std::vector<MPI_Request> reqs;
+  for (int r=0; r<static_cast<int>(ag.recv_rank.size()); ++r) {
+    if (!(ag.recv_local[r])) continue;
+    if (!IpcGetHandle(&(smsg[r].handle), ag.ipc_recv)) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Could not get IPC handle of receive buffer" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    smsg[r].offst = ag.recv_offst[r];
+    reqs.push_back(MPI_REQUEST_NULL);
+    MPI_Isend(&(smsg[r]), sizeof(IpcMessage), MPI_BYTE, ag.recv_rank[r], ipc_handle_tag,
+              comm_vars, &(reqs.back()));
+  }
+  for (int r=0; r<static_cast<int>(ag.send_rank.size()); ++r) {
+    if (!(ag.send_local[r])) continue;
+    MPI_Recv(&(rmsg[r]), sizeof(IpcMessage), MPI_BYTE, ag.send_rank[r], ipc_handle_tag,
+             comm_vars, MPI_STATUS_IGNORE);
+    if (!IpcOpen(&(ag.send_peer[r]), rmsg[r].handle)) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Could not open IPC handle from rank "
+                << ag.send_rank[r] << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    ag.send_peer_offst[r] = rmsg[r].offst;
+  }
+  if (!reqs.empty()) {
+    MPI_Waitall(static_cast<int>(reqs.size()), reqs.data(), MPI_STATUSES_IGNORE);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void MeshBoundaryValues::FreeNodeIPC
+//! \brief Unmaps buffers of other ranks, and frees recv_data if allocated for IPC.
+
+void MeshBoundaryValues::FreeNodeIPC() {
+  auto &ag = agg_vars;
+  for (auto &p : ag.send_peer) {
+    if (p != nullptr) {IpcClose(p);}
+    p = nullptr;
+  }
+  if (ag.ipc_recv != nullptr) {
+    if (ag.recv_data.data() == ag.ipc_recv) {ag.recv_data = DvceArray1D<Real>();}
+    IpcFree(ag.ipc_recv);
+    ag.ipc_recv = nullptr;
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  int MeshBoundaryValues::InitRecvAggregated
+//! \brief Posts one non-blocking receive for the aggregated message from each rank.
+//! For node-local ranks (with node_ipc) instead signals that recv_data may be written,
+//! and posts a zero-byte receive of the completion signal.  Returns MPI error code.
+
+int MeshBoundaryValues::InitRecvAggregated(int nvar) {
+  BuildAggregatedMessages(nvar);
+  auto &ag = agg_vars;
+  int ierr = MPI_SUCCESS;
+  // unpacking of the previous exchange must be finished before buffer is overwritten
+  if (ag.ipc_recv != nullptr) {pmy_pack->exe_space.fence();}
+  for (int r=0; r<static_cast<int>(ag.recv_rank.size()); ++r) {
+    int ndat = ag.recv_offst[r+1] - ag.recv_offst[r];
+    int jerr;
+    if (ag.recv_local[r]) {
+      jerr = MPI_Isend(nullptr, 0, MPI_BYTE, ag.recv_rank[r], ipc_ready_tag, comm_vars,
+                       &(ag.ready_req[r]));
+      if (jerr != MPI_SUCCESS) {ierr = jerr;}
+      jerr = StartRecv(ag.recv_data.data(), 0, ag.recv_rank[r], 0, comm_vars,
+                       &(ag.recv_req[r]));
+    } else if (halo_single_precision) {
+      float *ptr = (stage_mpi_bufs)? ag.recv_data32_h.data() : ag.recv_data32.data();
+      jerr = StartRecv(ptr + ag.recv_offst[r], ndat, ag.recv_rank[r], 0, comm_vars,
+                       &(ag.recv_req[r]), MPI_FLOAT);
+    } else {
+      Real *ptr = (stage_mpi_bufs)? ag.recv_data_h.data() : ag.recv_data.data();
+      jerr = StartRecv(ptr + ag.recv_offst[r], ndat, ag.recv_rank[r], 0, comm_vars,
+                       &(ag.recv_req[r]));
+    }
+    if (jerr != MPI_SUCCESS) {ierr = jerr;}
+  }
+  return ierr;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  int MeshBoundaryValues::SendAggregated
+//! \brief Gathers all packed send buffers destined for other ranks into contiguous array
+//! and posts one non-blocking send per rank.  Must be called after the pack kernels have
+//! completed.  Returns MPI error code.
+
+int MeshBoundaryValues::SendAggregated(int nvar) {
+  BuildAggregatedMessages(nvar);
+  auto &ag = agg_vars;
+  if (ag.send_rank.empty()) return MPI_SUCCESS;
+
+  // gather buffers into contiguous array, one team per buffer
+  auto &sbuf = sendbuf;
+  auto &list = ag.send_list;
+  auto &data = ag.send_data;
+  auto &data32 = ag.send_data32;
+  const bool sp = halo_single_precision;
+  Kokkos::TeamPolicy<> policy(pmy_pack->exe_space, ag.nsend_bufs, Kokkos::AUTO);
+  Kokkos::parallel_for("AggSend", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
+    const int i = tmember.league_rank();
+    const int n = list.d_view(i,0);
+    const int m = list.d_view(i,1);
+    const int offst = list.d_view(i,2);
+    Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember, list.d_view(i,3)),
+    [&](const int idx) {
+      if (sp) {
+        data32(offst + idx) = static_cast<float>(sbuf[n].vars(m,idx));
+      } else {
+        data(offst + idx) = sbuf[n].vars(m,idx);
+      }
+    });
+  });
+  if (stage_mpi_bufs) {
+    if (sp) {
+      Kokkos::deep_copy(pmy_pack->exe_space, ag.send_data32_h, ag.send_data32);
+    } else {
+      Kokkos::deep_copy(pmy_pack->exe_space, ag.send_data_h, ag.send_data);
+    }
+  }
+  pmy_pack->exe_space.fence();
+
+  int ierr = MPI_SUCCESS;
+  bool any_local = false;
+  for (int r=0; r<static_cast<int>(ag.send_rank.size()); ++r) {
+    int ndat = ag.send_offst[r+1] - ag.send_offst[r];
+    int jerr;
+    if (ag.send_local[r]) {
+      any_local = true;
+      continue;
+    } else if (sp) {
+      float *ptr = (stage_mpi_bufs)? ag.send_data32_h.data() : ag.send_data32.data();
+      jerr = StartSend(ptr + ag.send_offst[r], ndat, ag.send_rank[r], 0, comm_vars,
+                       &(ag.send_req[r]), MPI_FLOAT);
+    } else {
+      Real *ptr = (stage_mpi_bufs)? ag.send_data_h.data() : ag.send_data.data();
+      jerr = StartSend(ptr + ag.send_offst[r], ndat, ag.send_rank[r], 0, comm_vars,
+                       &(ag.send_req[r]));
+    }
+    if (jerr != MPI_SUCCESS) {ierr = jerr;}
+  }
+  if (!(any_local)) return ierr;
+
+  // copy messages to node-local ranks directly into their recv_data once each is free,
+  // after messages to other ranks have been posted
+  for (int r=0; r<static_cast<int>(ag.send_rank.size()); ++r) {
+    if (!(ag.send_local[r])) continue;
+    int jerr = MPI_Recv(nullptr, 0, MPI_BYTE, ag.send_rank[r], ipc_ready_tag, comm_vars,
+                        MPI_STATUS_IGNORE);
+    if (jerr != MPI_SUCCESS) {ierr = jerr;}
+    int ndat = ag.send_offst[r+1] - ag.send_offst[r];
+    DvceArray1D<Real> dest(ag.send_peer[r] + ag.send_peer_offst[r], ndat);
+    auto src = Kokkos::subview(ag.send_data,
+                               std::make_pair(ag.send_offst[r], ag.send_offst[r+1]));
+    Kokkos::deep_copy(pmy_pack->exe_space, dest, src);
+  }
+  pmy_pack->exe_space.fence();
+  for (int r=0; r<static_cast<int>(ag.send_rank.size()); ++r) {
+    if (!(ag.send_local[r])) continue;
+    int jerr = StartSend(ag.send_data.data(), 0, ag.send_rank[r], 0, comm_vars,
+                         &(ag.send_req[r]));
+    if (jerr != MPI_SUCCESS) {ierr = jerr;}
+  }
+  return ierr;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  TaskStatus MeshBoundaryValues::RecvAggregated
+//! \brief Checks whether aggregated messages from all ranks have arrived, and if so
+//! scatters them into individual receive buffers ready to be unpacked.
+
+TaskStatus MeshBoundaryValues::RecvAggregated() {
+  auto &ag = agg_vars;
+  if (ag.recv_rank.empty()) return TaskStatus::complete;
+
+  int test;
+  int ierr = MPI_Testall(static_cast<int>(ag.recv_req.size()), ag.recv_req.data(),
+                         &test, MPI_STATUSES_IGNORE);
+  if (ierr != MPI_SUCCESS) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "MPI error in testing aggregated receives" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  if (!(static_cast<bool>(test))) {return TaskStatus::incomplete;}
+
+  const bool sp = halo_single_precision;
+  if (stage_mpi_bufs) {
+    if (sp) {
+      Kokkos::deep_copy(pmy_pack->exe_space, ag.recv_data32, ag.recv_data32_h);
+    } else if (ag.ipc_recv != nullptr) {
+      // messages from node-local ranks were written directly to recv_data
+      for (int r=0; r<static_cast<int>(ag.recv_rank.size()); ++r) {
+        if (ag.recv_local[r]) continue;
+        auto rng = std::make_pair(ag.recv_offst[r], ag.recv_offst[r+1]);
+        Kokkos::deep_copy(pmy_pack->exe_space, Kokkos::subview(ag.recv_data, rng),
+                          Kokkos::subview(ag.recv_data_h, rng));
+      }
+    } else {
+      Kokkos::deep_copy(pmy_pack->exe_space, ag.recv_data, ag.recv_data_h);
+    }
+  }
+  // scatter contiguous array into recv buffers, one team per buffer
+  auto &rbuf = recvbuf;
+  auto &list = ag.recv_list;
+  auto &data = ag.recv_data;
+  auto &data32 = ag.recv_data32;
+  Kokkos::TeamPolicy<> policy(pmy_pack->exe_space, ag.nrecv_bufs, Kokkos::AUTO);
+  Kokkos::parallel_for("AggRecv", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
+    const int i = tmember.league_rank();
+    const int n = list.d_view(i,0);
+    const int m = list.d_view(i,1);
+    const int offst = list.d_view(i,2);
+    Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember, list.d_view(i,3)),
+    [&](const int idx) {
+      if (sp) {
+        rbuf[n].vars(m,idx) = static_cast<Real>(data32(offst + idx));
+      } else {
+        rbuf[n].vars(m,idx) = data(offst + idx);
+      }
+    });
+  });
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  int MeshBoundaryValues::ClearAggregated
+//! \brief Waits for all aggregated sends (or receives) to complete.  Returns MPI error
+//! code.
+
+int MeshBoundaryValues::ClearAggregated(bool send) {
+  auto &reqs = (send)? agg_vars.send_req : agg_vars.recv_req;
+  if (reqs.empty()) return MPI_SUCCESS;
+  if (!(send) && (agg_vars.ipc_recv != nullptr)) {
+    int ierr = MPI_Waitall(static_cast<int>(agg_vars.ready_req.size()),
+                           agg_vars.ready_req.data(), MPI_STATUSES_IGNORE);
+    if (ierr != MPI_SUCCESS) return ierr;
+  }
+  return MPI_Waitall(static_cast<int>(reqs.size()), reqs.data(), MPI_STATUSES_IGNORE);
+}
+#endif
@@ -41,10 +41,17 @@ MeshBoundaryValuesCC::MeshBoundaryValuesCC(MeshBlockPack *pp, ParameterInput *pi
 TaskStatus MeshBoundaryValuesCC::PackAndSendCC(DvceArray5D<Real> &a,
                                                DvceArray5D<Real> &ca) {
   // create local references for variables in kernel
-  int nmb = pmy_pack->nmb_thispack;
   int nnghbr = pmy_pack->pmb->nnghbr;
-  int nvar = a.extent_int(1);  // TODO(@user): 2nd index from L of in array must be NVAR
-
+  // number of variables communicated, and indices of subset in array (if any)
+  int nvar = (nsub_vars > 0)? nsub_vars : a.extent_int(1);
+  bool use_subset = (nsub_vars > 0);
+  auto &svar = sub_vars;
+  // lease buffers from pool (if used)
+  AcquireBuffers();
+  CountSends(nvar);
+
+  // teams are only launched for buffers with a neighbor, listed in nlev_lists
+  BuildNeighborLevelLists();
   {int my_rank = global_variable::my_rank;
   auto &nghbr = pmy_pack->pmb->nghbr;
   auto &mbgid = pmy_pack->pmb->mb_gid;
@@ -53,200 +60,347 @@ TaskStatus MeshBoundaryValuesCC::PackAndSendCC(DvceArray5D<Real> &a,
   auto &rbuf = recvbuf;
   auto &is_z4c = is_z4c_;
   auto &multilevel = pmy_pack->pmesh->multilevel;
-  // Outer loop over (# of MeshBlocks)*(# of buffers)*(# of variables)
-  int nmnv = nmb*nnghbr*nvar;
-  Kokkos::TeamPolicy<> policy(DevExeSpace(), nmnv, Kokkos::AUTO);
+  auto &list = nlev_lists.buffered;
+  // Outer loop over (# of buffers with a neighbor), each team packs all variables
+  if (nlev_lists.nbuffered > 0) {
+  Kokkos::TeamPolicy<> policy(pmy_pack->exe_space, nlev_lists.nbuffered, Kokkos::AUTO);
   Kokkos::parallel_for("SendBuff", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
-    const int m = (tmember.league_rank())/(nnghbr*nvar);
-    const int n = (tmember.league_rank() - m*(nnghbr*nvar))/nvar;
-    const int v = (tmember.league_rank() - m*(nnghbr*nvar) - n*nvar);
-
-    // only load buffers when neighbor exists
-    if (nghbr.d_view(m,n).gid >= 0) {
-      // if neighbor is at coarser level, use coar indices to pack buffer
-      int il, iu, jl, ju, kl, ku;
-      if (nghbr.d_view(m,n).lev < mblev.d_view(m)) {
-        il = sbuf[n].icoar[0].bis;
-        iu = sbuf[n].icoar[0].bie;
-        jl = sbuf[n].icoar[0].bjs;
-        ju = sbuf[n].icoar[0].bje;
-        kl = sbuf[n].icoar[0].bks;
-        ku = sbuf[n].icoar[0].bke;
-      // if neighbor is at same level, use same indices to pack buffer
-      } else if (nghbr.d_view(m,n).lev == mblev.d_view(m)) {
-        il = sbuf[n].isame[0].bis;
-        iu = sbuf[n].isame[0].bie;
-        jl = sbuf[n].isame[0].bjs;
-        ju = sbuf[n].isame[0].bje;
-        kl = sbuf[n].isame[0].bks;
-        ku = sbuf[n].isame[0].bke;
-      // if neighbor is at finer level, use fine indices to pack buffer
-      } else {
-        il = sbuf[n].ifine[0].bis;
-        iu = sbuf[n].ifine[0].bie;
-        jl = sbuf[n].ifine[0].bjs;
-        ju = sbuf[n].ifine[0].bje;
-        kl = sbuf[n].ifine[0].bks;
-        ku = sbuf[n].ifine[0].bke;
-      }
-      int ni = iu - il + 1;
-      int nj = ju - jl + 1;
-      int nk = ku - kl + 1;
-      int nkj  = nk*nj;
-
-      // indices of recv'ing (destination) MB and buffer: MB IDs are stored sequentially
-      // in MeshBlockPacks, so array index equals (target_id - first_id)
-      int dm = nghbr.d_view(m,n).gid - mbgid.d_view(0);
-      int dn = nghbr.d_view(m,n).dest;
-
-      // Middle loop over k,j
-      Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember, nkj), [&](const int idx) {
-        int k = idx / nj;
-        int j = (idx - k * nj) + jl;
-        k += kl;
-
-        // Inner (vector) loop over i
-        // copy directly into recv buffer if MeshBlocks on same rank
-
-        if (nghbr.d_view(m,n).rank == my_rank) {
-          // if neighbor is at same or finer level, load data from u0
-          if (nghbr.d_view(m,n).lev >= mblev.d_view(m)) {
-            Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
-            [&](const int i) {
-              rbuf[dn].vars(dm, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) ) = a(m,v,k,j,i);
-            });
-            tmember.team_barrier();
-          // if neighbor is at coarser level, load data from coarse_u0
-          } else {
-            Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
-            [&](const int i) {
-              rbuf[dn].vars(dm, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) ) = ca(m,v,k,j,i);
-            });
-            tmember.team_barrier();
-          }
+    const int m = (list.d_view(tmember.league_rank()))/nnghbr;
+    const int n = (list.d_view(tmember.league_rank()) - m*nnghbr);
+
+    // if neighbor is at coarser level, use coar indices to pack buffer
+    int il, iu, jl, ju, kl, ku;
+    if (nghbr.d_view(m,n).lev < mblev.d_view(m)) {
+      il = sbuf[n].icoar[0].bis;
+      iu = sbuf[n].icoar[0].bie;
+      jl = sbuf[n].icoar[0].bjs;
+      ju = sbuf[n].icoar[0].bje;
+      kl = sbuf[n].icoar[0].bks;
+      ku = sbuf[n].icoar[0].bke;
+    // if neighbor is at same level, use same indices to pack buffer
+    } else if (nghbr.d_view(m,n).lev == mblev.d_view(m)) {
+      il = sbuf[n].isame[0].bis;
+      iu = sbuf[n].isame[0].bie;
+      jl = sbuf[n].isame[0].bjs;
+      ju = sbuf[n].isame[0].bje;
+      kl = sbuf[n].isame[0].bks;
+      ku = sbuf[n].isame[0].bke;
+    // if neighbor is at finer level, use fine indices to pack buffer
+    } else {
+      il = sbuf[n].ifine[0].bis;
+      iu = sbuf[n].ifine[0].bie;
+      jl = sbuf[n].ifine[0].bjs;
+      ju = sbuf[n].ifine[0].bje;
+      kl = sbuf[n].ifine[0].bks;
+      ku = sbuf[n].ifine[0].bke;
+    }
+    int ni = iu - il + 1;
+    int nj = ju - jl + 1;
+    int nk = ku - kl + 1;
+    int nkj  = nk*nj;
+
+    // copy directly into recv buffer if MeshBlocks on same rank, else copy into send
+    // buffer for MPI communication below.  Indices of recv'ing (destination) MB and
+    // buffer: MB IDs are stored sequentially in MeshBlockPacks, so array index equals
+    // (target_id - first_id)
+    bool same_rank = (nghbr.d_view(m,n).rank == my_rank);
+    int dm = (same_rank)? (nghbr.d_view(m,n).gid - mbgid.d_view(0)) : m;
+    const DvceArray2D<Real> &dbuf = (same_rank)? rbuf[nghbr.d_view(m,n).dest].vars :
+                                                 sbuf[n].vars;
+    // if neighbor is at same or finer level, load data from u0, else from coarse_u0
+    const DvceArray5D<Real> &src = (nghbr.d_view(m,n).lev >= mblev.d_view(m))? a : ca;
+
+    // Middle loop over v,k,j
+    Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember, nvar*nkj),
+    [&](const int idx) {
+      int v = idx / nkj;
+      int k = (idx - v*nkj) / nj;
+      int j = (idx - v*nkj - k*nj) + jl;
+      k += kl;
+      const int va = (use_subset)? svar.d_view(v) : v;  // index of variable in array
+
+      // Inner (vector) loop over i
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
+      [&](const int i) {
+        dbuf(dm, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) ) = src(m,va,k,j,i);
+      });
+    });
+  }); // end par_for_outer
+  }
 
-        // else copy into send buffer for MPI communication below
-
-        } else {
-          // if neighbor is at same or finer level, load data from u0
-          if (nghbr.d_view(m,n).lev >= mblev.d_view(m)) {
-            Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
-            [&](const int i) {
-              sbuf[n].vars(m, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) ) = a(m,v,k,j,i);
-            });
-            tmember.team_barrier();
-          // if neighbor is at coarser level, load data from coarse_u0
-          } else {
-            Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
-            [&](const int i) {
-              sbuf[n].vars(m, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) ) = ca(m,v,k,j,i);
-            });
-            tmember.team_barrier();
-          }
-        }
+  // Copy directly from interior of this MeshBlock into ghost zones of neighbors at the
+  // same level on this rank.  Only interior cells are read and only ghost cells are
+  // written, so copies proceed in any order.
+  auto &list_direct = nlev_lists.direct;
+  if (nlev_lists.ndirect > 0) {
+  Kokkos::TeamPolicy<> policy(pmy_pack->exe_space, nlev_lists.ndirect, Kokkos::AUTO);
+  Kokkos::parallel_for("DirectCopy", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
+    const int m = (list_direct.d_view(tmember.league_rank()))/nnghbr;
+    const int n = (list_direct.d_view(tmember.league_rank()) - m*nnghbr);
+    // index of destination MB, and of buffer it would have been received into
+    int dm = nghbr.d_view(m,n).gid - mbgid.d_view(0);
+    int dn = nghbr.d_view(m,n).dest;
+    int il = sbuf[n].isame[0].bis;
+    int iu = sbuf[n].isame[0].bie;
+    int jl = sbuf[n].isame[0].bjs;
+    int kl = sbuf[n].isame[0].bks;
+    int nj = sbuf[n].isame[0].bje - jl + 1;
+    int nk = sbuf[n].isame[0].bke - kl + 1;
+    int nkj  = nk*nj;
+    // offsets from source to destination indices
+    int di = rbuf[dn].isame[0].bis - il;
+    int dj = rbuf[dn].isame[0].bjs - jl;
+    int dk = rbuf[dn].isame[0].bks - kl;
+
+    // Middle loop over v,k,j
+    Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember, nvar*nkj),
+    [&](const int idx) {
+      int v = idx / nkj;
+      int k = (idx - v*nkj) / nj;
+      int j = (idx - v*nkj - k*nj) + jl;
+      k += kl;
+      const int va = (use_subset)? svar.d_view(v) : v;  // index of variable in array
+
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
+      [&](const int i) {
+        a(dm,va,k+dk,j+dj,i+di) = a(m,va,k,j,i);
       });
-    } // end if-neighbor-exists block
+    });
   }); // end par_for_outer
+  }
 
+  // If neighbor is at same level and data is for Z4c module, append data from coarse
+  // array for higher-order prolongation
+  auto &list_same = nlev_lists.same;
+  if ((is_z4c) && (multilevel) && (nlev_lists.nsame > 0)) {
+  Kokkos::TeamPolicy<> policy(pmy_pack->exe_space, nlev_lists.nsame, Kokkos::AUTO);
   Kokkos::parallel_for("SendBuff", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
-    const int m = (tmember.league_rank())/(nnghbr*nvar);
-    const int n = (tmember.league_rank() - m*(nnghbr*nvar))/nvar;
-    const int v = (tmember.league_rank() - m*(nnghbr*nvar) - n*nvar);
-
-    // only load buffers when neighbor exists
-    if (nghbr.d_view(m,n).gid >= 0) {
-      int il, iu, jl, ju, kl, ku;
-      // If neighbor is at same level and data is for Z4c module, append data from coarse
-      // array for higher-order prolongation
-      if ((nghbr.d_view(m,n).lev == mblev.d_view(m)) && (is_z4c) && (multilevel)) {
-        il = sbuf[n].isame_z4c.bis;
-        iu = sbuf[n].isame_z4c.bie;
-        jl = sbuf[n].isame_z4c.bjs;
-        ju = sbuf[n].isame_z4c.bje;
-        kl = sbuf[n].isame_z4c.bks;
-        ku = sbuf[n].isame_z4c.bke;
-        int ni = iu - il + 1;
-        int nj = ju - jl + 1;
-        int nk = ku - kl + 1;
-        int nkj  = nk*nj;
-        int ndat = nvar*sbuf[n].isame_ndat; // size of same level data already in buff
-
-        // indices of recv'ing (destination) MB and buffer: MB IDs are stored sequentially
-        // in MeshBlockPacks, so array index equals (target_id - first_id)
-        int dm = nghbr.d_view(m,n).gid - mbgid.d_view(0);
-        int dn = nghbr.d_view(m,n).dest;
-
-        // Middle loop over k,j
-        Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember, nkj), [&](const int idx) {
-          int k = idx / nj;
-          int j = (idx - k * nj) + jl;
-          k += kl;
-
-          // Inner (vector) loop over i
-          // copy directly into recv buffer if MeshBlocks on same rank
-          if (nghbr.d_view(m,n).rank == my_rank) {
-            // load data from coarse_u0
-            Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
-            [&](const int i) {
-              rbuf[dn].vars(dm,ndat+ (i-il + ni*(j-jl + nj*(k-kl + nk*v))))=ca(m,v,k,j,i);
-            });
-            tmember.team_barrier();
-
-          // else copy into send buffer for MPI communication below
-          } else {
-            // load data from coarse_u0
-            Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
-            [&](const int i) {
-              sbuf[n].vars(m,ndat+ (i-il + ni*(j-jl + nj*(k-kl + nk*v))) )=ca(m,v,k,j,i);
-            });
-            tmember.team_barrier();
-          }
-        });
-      }
-    } // end if-neighbor-exists block
+    const int m = (list_same.d_view(tmember.league_rank()))/nnghbr;
+    const int n = (list_same.d_view(tmember.league_rank()) - m*nnghbr);
+    int il = sbuf[n].isame_z4c.bis;
+    int iu = sbuf[n].isame_z4c.bie;
+    int jl = sbuf[n].isame_z4c.bjs;
+    int ju = sbuf[n].isame_z4c.bje;
+    int kl = sbuf[n].isame_z4c.bks;
+    int ku = sbuf[n].isame_z4c.bke;
+    int ni = iu - il + 1;
+    int nj = ju - jl + 1;
+    int nk = ku - kl + 1;
+    int nkj  = nk*nj;
+    int ndat = nvar*sbuf[n].isame_ndat; // size of same level data already in buff
+
+    // copy directly into recv buffer if MeshBlocks on same rank, else into send buffer
+    bool same_rank = (nghbr.d_view(m,n).rank == my_rank);
+    int dm = (same_rank)? (nghbr.d_view(m,n).gid - mbgid.d_view(0)) : m;
+    const DvceArray2D<Real> &dbuf = (same_rank)? rbuf[nghbr.d_view(m,n).dest].vars :
+                                                 sbuf[n].vars;
+
+    // Middle loop over v,k,j
+    Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember, nvar*nkj),
+    [&](const int idx) {
+      int v = idx / nkj;
+      int k = (idx - v*nkj) / nj;
+      int j = (idx - v*nkj - k*nj) + jl;
+      k += kl;
+      const int va = (use_subset)? svar.d_view(v) : v;  // index of variable in array
+
+      // Inner (vector) loop over i, load data from coarse_u0
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
+      [&](const int i) {
+        dbuf(dm, ndat + (i-il + ni*(j-jl + nj*(k-kl + nk*v))) ) = ca(m,va,k,j,i);
+      });
+    });
   }); // end par_for_outer
   }
+  }
+
+  return SendBuffersCC(nvar);
+}
 
+//----------------------------------------------------------------------------------------
+// \!fn void RecvBuffers()
+// \brief Unpack boundary buffers
+
+TaskStatus MeshBoundaryValuesCC::RecvAndUnpackCC(DvceArray5D<Real> &a,
+                                                 DvceArray5D<Real> &ca) {
+  // create local references for variables in kernel
+  int nnghbr = pmy_pack->pmb->nnghbr;
+  auto &nghbr = pmy_pack->pmb->nghbr;
+  auto &rbuf = recvbuf;
+  auto &is_z4c = is_z4c_;
+  auto &multilevel = pmy_pack->pmesh->multilevel;
+  //----- STEP 1: check that recv boundary buffer communications have all completed
+  if (RecvBuffersCC() == TaskStatus::incomplete) {return TaskStatus::incomplete;}
+
+  //----- STEP 2: buffers have all completed, so unpack
+
+  // number of variables communicated, and indices of subset in array (if any)
+  int nvar = (nsub_vars > 0)? nsub_vars : a.extent_int(1);
+  bool use_subset = (nsub_vars > 0);
+  auto &svar = sub_vars;
+  auto &mblev = pmy_pack->pmb->mb_lev;
+
+  // teams are only launched for buffers with a neighbor, listed in nlev_lists
+  BuildNeighborLevelLists();
+  // buffers copied directly by PackAndSendCC() are not in this list
+  auto &list = nlev_lists.buffered;
+  // Outer loop over (# of buffers with a neighbor), each team unpacks all variables
+  if (nlev_lists.nbuffered > 0) {
+  Kokkos::TeamPolicy<> policy(pmy_pack->exe_space, nlev_lists.nbuffered, Kokkos::AUTO);
+  Kokkos::parallel_for("RecvBuff", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
+    const int m = (list.d_view(tmember.league_rank()))/nnghbr;
+    const int n = (list.d_view(tmember.league_rank()) - m*nnghbr);
+
+    int il, iu, jl, ju, kl, ku;
+    // if neighbor is at coarser level, use coar indices to unpack buffer
+    if (nghbr.d_view(m,n).lev < mblev.d_view(m)) {
+      il = rbuf[n].icoar[0].bis;
+      iu = rbuf[n].icoar[0].bie;
+      jl = rbuf[n].icoar[0].bjs;
+      ju = rbuf[n].icoar[0].bje;
+      kl = rbuf[n].icoar[0].bks;
+      ku = rbuf[n].icoar[0].bke;
+    // if neighbor is at same level, use same indices to unpack buffer
+    } else if (nghbr.d_view(m,n).lev == mblev.d_view(m)) {
+      il = rbuf[n].isame[0].bis;
+      iu = rbuf[n].isame[0].bie;
+      jl = rbuf[n].isame[0].bjs;
+      ju = rbuf[n].isame[0].bje;
+      kl = rbuf[n].isame[0].bks;
+      ku = rbuf[n].isame[0].bke;
+    // if neighbor is at finer level, use fine indices to unpack buffer
+    } else {
+      il = rbuf[n].ifine[0].bis;
+      iu = rbuf[n].ifine[0].bie;
+      jl = rbuf[n].ifine[0].bjs;
+      ju = rbuf[n].ifine[0].bje;
+      kl = rbuf[n].ifine[0].bks;
+      ku = rbuf[n].ifine[0].bke;
+    }
+    int ni = iu - il + 1;
+    int nj = ju - jl + 1;
+    int nk = ku - kl + 1;
+    int nkj  = nk*nj;
+
+    // if neighbor is at same or finer level, load data directly into u0, else into
+    // coarse_u0
+    const DvceArray5D<Real> &dst = (nghbr.d_view(m,n).lev >= mblev.d_view(m))? a : ca;
+
+    // Middle loop over v,k,j
+    Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember, nvar*nkj),
+    [&](const int idx) {
+      int v = idx / nkj;
+      int k = (idx - v*nkj) / nj;
+      int j = (idx - v*nkj - k*nj) + jl;
+      k += kl;
+      const int va = (use_subset)? svar.d_view(v) : v;  // index of variable in array
+
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
+      [&](const int i) {
+        dst(m,va,k,j,i) = rbuf[n].vars(m, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) );
+      });
+    });
+  });  // end par_for_outer
+  }
+
+  // If neighbor is at same level and data is for Z4c module, unpack data from coarse
+  // array for higher-order prolongation
+  auto &list_same = nlev_lists.same;
+  if ((is_z4c) && (multilevel) && (nlev_lists.nsame > 0)) {
+  Kokkos::TeamPolicy<> policy(pmy_pack->exe_space, nlev_lists.nsame, Kokkos::AUTO);
+  Kokkos::parallel_for("RecvBuff", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
+    const int m = (list_same.d_view(tmember.league_rank()))/nnghbr;
+    const int n = (list_same.d_view(tmember.league_rank()) - m*nnghbr);
+    int il = rbuf[n].isame_z4c.bis;
+    int iu = rbuf[n].isame_z4c.bie;
+    int jl = rbuf[n].isame_z4c.bjs;
+    int ju = rbuf[n].isame_z4c.bje;
+    int kl = rbuf[n].isame_z4c.bks;
+    int ku = rbuf[n].isame_z4c.bke;
+    int ni = iu - il + 1;
+    int nj = ju - jl + 1;
+    int nk = ku - kl + 1;
+    int nkj  = nk*nj;
+    int ndat = nvar*rbuf[n].isame_ndat; // size of same level data packed in buff
+
+    // Middle loop over v,k,j
+    Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember, nvar*nkj),
+    [&](const int idx) {
+      int v = idx / nkj;
+      int k = (idx - v*nkj) / nj;
+      int j = (idx - v*nkj - k*nj) + jl;
+      k += kl;
+      const int va = (use_subset)? svar.d_view(v) : v;  // index of variable in array
+
+      // load data into coarse_u0
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
+      [&](const int i) {
+        ca(m,va,k,j,i) = rbuf[n].vars(m,ndat + (i-il + ni*(j-jl + nj*(k-kl + nk*v))));
+      });
+    });
+  });  // end par_for_outer
+  }
+
+  // return buffers leased from pool (if used) once sends have also completed
+  bufs_unpacked_ = true;
+  ReleaseBuffers();
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus MeshBoundaryValuesCC::SendBuffersCC()
+//! \brief Sends packed boundary buffers of nvar variables to neighbors on other ranks
+//! using MPI (buffers of neighbors on this rank were already filled directly)
+
+TaskStatus MeshBoundaryValuesCC::SendBuffersCC(int nvar) {
 #if MPI_PARALLEL_ENABLED
   // Send boundary buffer to neighboring MeshBlocks using MPI
-  Kokkos::fence();
+  int nnghbr = pmy_pack->pmb->nnghbr;
+  int nmb = pmy_pack->nmb_thispack;
+  pmy_pack->exe_space.fence();
+  ResetPersistentRequests(pers_vars_send, true, false, nvar);
   auto &is_z4c = is_z4c_;
   int my_rank = global_variable::my_rank;
   auto &nghbr = pmy_pack->pmb->nghbr;
   bool no_errors=true;
-  for (int m=0; m<nmb; ++m) {
-    for (int n=0; n<nnghbr; ++n) {
-      if (nghbr.h_view(m,n).gid >= 0) {  // neighbor exists and not a physical boundary
-        // index and rank of destination Neighbor
-        int dn = nghbr.h_view(m,n).dest;
-        int drank = nghbr.h_view(m,n).rank;
-        if (drank != my_rank) {
-          // create tag using local ID and buffer index of *receiving* MeshBlock
-          int lid = nghbr.h_view(m,n).gid - pmy_pack->pmesh->gids_eachrank[drank];
-          int tag = CreateBvals_MPI_Tag(lid, dn);
-
-          // get ptr to send buffer when neighbor is at coarser/same/fine level
-          int data_size = nvar;
-          if ( nghbr.h_view(m,n).lev < pmy_pack->pmb->mb_lev.h_view(m) ) {
-            data_size *= sendbuf[n].icoar_ndat;
-          } else if ( nghbr.h_view(m,n).lev == pmy_pack->pmb->mb_lev.h_view(m) ) {
-            if (is_z4c) {
-              data_size *= sendbuf[n].isame_z4c_ndat;
+  if (aggregate_mpi) {
+    // gather buffers and post one send per rank for aggregated messages
+    if (SendAggregated(nvar) != MPI_SUCCESS) {no_errors=false;}
+  } else {
+    for (int m=0; m<nmb; ++m) {
+      for (int n=0; n<nnghbr; ++n) {
+        if (nghbr.h_view(m,n).gid >= 0) {  // neighbor exists and not a physical boundary
+          // index and rank of destination Neighbor
+          int dn = nghbr.h_view(m,n).dest;
+          int drank = nghbr.h_view(m,n).rank;
+          if (drank != my_rank) {
+            // create tag using local ID and buffer index of *receiving* MeshBlock
+            int lid = nghbr.h_view(m,n).gid - pmy_pack->pmesh->gids_eachrank[drank];
+            int tag = CreateBvals_MPI_Tag(lid, dn);
+
+            // get ptr to send buffer when neighbor is at coarser/same/fine level
+            int data_size = nvar;
+            if ( nghbr.h_view(m,n).lev < pmy_pack->pmb->mb_lev.h_view(m) ) {
+              data_size *= sendbuf[n].icoar_ndat;
+            } else if ( nghbr.h_view(m,n).lev == pmy_pack->pmb->mb_lev.h_view(m) ) {
+              if (is_z4c) {
+                data_size *= sendbuf[n].isame_z4c_ndat;
+              } else {
+                data_size *= sendbuf[n].isame_ndat;
+              }
             } else {
-              data_size *= sendbuf[n].isame_ndat;
+              data_size *= sendbuf[n].ifine_ndat;
             }
-          } else {
-            data_size *= sendbuf[n].ifine_ndat;
+            int ierr = PostSend(sendbuf[n].vars, sendbuf[n].vars_h, m, data_size, drank,
+                                tag, comm_vars, &(sendbuf[n].vars_req[m]));
+            if (ierr != MPI_SUCCESS) {no_errors=false;}
           }
-          auto send_ptr = Kokkos::subview(sendbuf[n].vars, m, Kokkos::ALL);
-
-          int ierr = MPI_Isend(send_ptr.data(), data_size, MPI_ATHENA_REAL, drank, tag,
-                               comm_vars, &(sendbuf[n].vars_req[m]));
-          if (ierr != MPI_SUCCESS) {no_errors=false;}
         }
       }
     }
   }
+  // post sends staged through host memory (if any)
+  if (FlushStagedSends() != MPI_SUCCESS) {no_errors=false;}
   // Quit if MPI error detected
   if (!(no_errors)) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
@@ -258,21 +412,16 @@ TaskStatus MeshBoundaryValuesCC::PackAndSendCC(DvceArray5D<Real> &a,
 }
 
 //----------------------------------------------------------------------------------------
-// \!fn void RecvBuffers()
-// \brief Unpack boundary buffers
+//! \fn TaskStatus MeshBoundaryValuesCC::RecvBuffersCC()
+//! \brief Checks that all MPI receives of boundary buffers have completed, and copies
+//! staged or aggregated messages into the recv buffers once they have
 
-TaskStatus MeshBoundaryValuesCC::RecvAndUnpackCC(DvceArray5D<Real> &a,
-                                                 DvceArray5D<Real> &ca) {
-  // create local references for variables in kernel
+TaskStatus MeshBoundaryValuesCC::RecvBuffersCC() {
+#if MPI_PARALLEL_ENABLED
   int nmb = pmy_pack->nmb_thispack;
   int nnghbr = pmy_pack->pmb->nnghbr;
   auto &nghbr = pmy_pack->pmb->nghbr;
   auto &rbuf = recvbuf;
-  auto &is_z4c = is_z4c_;
-  auto &multilevel = pmy_pack->pmesh->multilevel;
-#if MPI_PARALLEL_ENABLED
-  //----- STEP 1: check that recv boundary buffer communications have all completed
-
   bool bflag = false;
   bool no_errors=true;
   for (int m=0; m<nmb; ++m) {
@@ -298,118 +447,13 @@ TaskStatus MeshBoundaryValuesCC::RecvAndUnpackCC(DvceArray5D<Real> &a,
   }
   // exit if recv boundary buffer communications have not completed
   if (bflag) {return TaskStatus::incomplete;}
-#endif
-
-  //----- STEP 2: buffers have all completed, so unpack
-
-  int nvar = a.extent_int(1);  // TODO(@user): 2nd index from L of in array must be NVAR
-  auto &mblev = pmy_pack->pmb->mb_lev;
-
-  // Outer loop over (# of MeshBlocks)*(# of buffers)*(# of variables)
-  Kokkos::TeamPolicy<> policy(DevExeSpace(), (nmb*nnghbr*nvar), Kokkos::AUTO);
-  Kokkos::parallel_for("RecvBuff", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
-    const int m = (tmember.league_rank())/(nnghbr*nvar);
-    const int n = (tmember.league_rank() - m*(nnghbr*nvar))/nvar;
-    const int v = (tmember.league_rank() - m*(nnghbr*nvar) - n*nvar);
-
-    // only unpack buffers when neighbor exists
-    if (nghbr.d_view(m,n).gid >= 0) {
-      int il, iu, jl, ju, kl, ku;
-      // if neighbor is at coarser level, use coar indices to unpack buffer
-      if (nghbr.d_view(m,n).lev < mblev.d_view(m)) {
-        il = rbuf[n].icoar[0].bis;
-        iu = rbuf[n].icoar[0].bie;
-        jl = rbuf[n].icoar[0].bjs;
-        ju = rbuf[n].icoar[0].bje;
-        kl = rbuf[n].icoar[0].bks;
-        ku = rbuf[n].icoar[0].bke;
-      // if neighbor is at same level, use same indices to unpack buffer
-      } else if (nghbr.d_view(m,n).lev == mblev.d_view(m)) {
-        il = rbuf[n].isame[0].bis;
-        iu = rbuf[n].isame[0].bie;
-        jl = rbuf[n].isame[0].bjs;
-        ju = rbuf[n].isame[0].bje;
-        kl = rbuf[n].isame[0].bks;
-        ku = rbuf[n].isame[0].bke;
-      // if neighbor is at finer level, use fine indices to unpack buffer
-      } else {
-        il = rbuf[n].ifine[0].bis;
-        iu = rbuf[n].ifine[0].bie;
-        jl = rbuf[n].ifine[0].bjs;
-        ju = rbuf[n].ifine[0].bje;
-        kl = rbuf[n].ifine[0].bks;
-        ku = rbuf[n].ifine[0].bke;
-      }
-      int ni = iu - il + 1;
-      int nj = ju - jl + 1;
-      int nk = ku - kl + 1;
-      int nkj  = nk*nj;
-
-      // Middle loop over k,j
-      Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember, nkj), [&](const int idx) {
-        int k = idx / nj;
-        int j = (idx - k * nj) + jl;
-        k += kl;
-
-        // if neighbor is at same or finer level, load data directly into u0
-        if (nghbr.d_view(m,n).lev >= mblev.d_view(m)) {
-          Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
-          [&](const int i) {
-            a(m,v,k,j,i) = rbuf[n].vars(m, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) );
-          });
-          tmember.team_barrier();
-
-        // if neighbor is at coarser level, load data into coarse_u0
-        } else {
-          Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
-          [&](const int i) {
-            ca(m,v,k,j,i) = rbuf[n].vars(m, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) );
-          });
-          tmember.team_barrier();
-        }
-      });
-    }  // end if-neighbor-exists block
-  });  // end par_for_outer
-
-  // Outer loop over (# of MeshBlocks)*(# of buffers)*(# of variables)
-  Kokkos::parallel_for("RecvBuff", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
-    const int m = (tmember.league_rank())/(nnghbr*nvar);
-    const int n = (tmember.league_rank() - m*(nnghbr*nvar))/nvar;
-    const int v = (tmember.league_rank() - m*(nnghbr*nvar) - n*nvar);
-    // only unpack buffers when neighbor exists
-    if (nghbr.d_view(m,n).gid >= 0) {
-      int il, iu, jl, ju, kl, ku;
-      // If neighbor is at same level and data is for Z4c module, unpack data from coarse
-      // array for higher-order prolongation
-      if ((nghbr.d_view(m,n).lev == mblev.d_view(m)) && (is_z4c) && (multilevel)) {
-        il = rbuf[n].isame_z4c.bis;
-        iu = rbuf[n].isame_z4c.bie;
-        jl = rbuf[n].isame_z4c.bjs;
-        ju = rbuf[n].isame_z4c.bje;
-        kl = rbuf[n].isame_z4c.bks;
-        ku = rbuf[n].isame_z4c.bke;
-        int ni = iu - il + 1;
-        int nj = ju - jl + 1;
-        int nk = ku - kl + 1;
-        int nkj  = nk*nj;
-        int ndat = nvar*rbuf[n].isame_ndat; // size of same level data packed in buff
-
-        // Middle loop over k,j
-        Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember, nkj), [&](const int idx) {
-          int k = idx / nj;
-          int j = (idx - k * nj) + jl;
-          k += kl;
-
-          // load data into coarse_u0
-          Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
-          [&](const int i) {
-            ca(m,v,k,j,i) = rbuf[n].vars(m,ndat + (i-il + ni*(j-jl + nj*(k-kl + nk*v))) );
-          });
-          tmember.team_barrier();
-        });
-      }
-    }  // end if-neighbor-exists block
-  });  // end par_for_outer
 
+  // copy data received into pinned host buffers (if any) to device
+  CopyStagedRecvs(staged_vars_recvs);
+  // scatter aggregated messages (if any) into recv buffers
+  if (aggregate_mpi && (RecvAggregated() == TaskStatus::incomplete)) {
+    return TaskStatus::incomplete;
+  }
+#endif
   return TaskStatus::complete;
 }
@@ -42,6 +42,9 @@ TaskStatus MeshBoundaryValuesFC::PackAndSendFC(DvceFaceFld4D<Real> &b,
   // create local references for variables in kernel
   int nmb = pmy_pack->nmb_thispack;
   int nnghbr = pmy_pack->pmb->nnghbr;
+  // lease buffers from pool (if used)
+  AcquireBuffers();
+  CountSends(3);
 
   {int my_rank = global_variable::my_rank;
   auto &nghbr = pmy_pack->pmb->nghbr;
@@ -52,7 +55,7 @@ TaskStatus MeshBoundaryValuesFC::PackAndSendFC(DvceFaceFld4D<Real> &b,
 
   // Outer loop over (# of MeshBlocks)*(# of buffers)*(three field components)
   int nmnv = 3*nmb;
-  Kokkos::TeamPolicy<> policy(DevExeSpace(), nmnv, Kokkos::AUTO);
+  Kokkos::TeamPolicy<> policy(pmy_pack->exe_space, nmnv, Kokkos::AUTO);
   Kokkos::parallel_for("SendBuff", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
     const int m = tmember.league_rank()/3;
     const int v = tmember.league_rank()%3;
@@ -188,39 +191,45 @@ TaskStatus MeshBoundaryValuesFC::PackAndSendFC(DvceFaceFld4D<Real> &b,
 
 #if MPI_PARALLEL_ENABLED
   // Send boundary buffer to neighboring MeshBlocks using MPI
-  Kokkos::fence();
+  pmy_pack->exe_space.fence();
+  ResetPersistentRequests(pers_vars_send, true, false, 3);
   int my_rank = global_variable::my_rank;
   auto &nghbr = pmy_pack->pmb->nghbr;
   bool no_errors=true;
-  for (int m=0; m<nmb; ++m) {
-    for (int n=0; n<nnghbr; ++n) {
-      if (nghbr.h_view(m,n).gid >= 0) {  // neighbor exists and not a physical boundary
-        // index and rank of destination Neighbor
-        int dn = nghbr.h_view(m,n).dest;
-        int drank = nghbr.h_view(m,n).rank;
-        if (drank != my_rank) {
-          // create tag using local ID and buffer index of *receiving* MeshBlock
-          int lid = nghbr.h_view(m,n).gid - pmy_pack->pmesh->gids_eachrank[drank];
-          int tag = CreateBvals_MPI_Tag(lid, dn);
+  if (aggregate_mpi) {
+    // gather buffers and post one send per rank for aggregated messages
+    if (SendAggregated(3) != MPI_SUCCESS) {no_errors=false;}
+  } else {
+    for (int m=0; m<nmb; ++m) {
+      for (int n=0; n<nnghbr; ++n) {
+        if (nghbr.h_view(m,n).gid >= 0) {  // neighbor exists and not a physical boundary
+          // index and rank of destination Neighbor
+          int dn = nghbr.h_view(m,n).dest;
+          int drank = nghbr.h_view(m,n).rank;
+          if (drank != my_rank) {
+            // create tag using local ID and buffer index of *receiving* MeshBlock
+            int lid = nghbr.h_view(m,n).gid - pmy_pack->pmesh->gids_eachrank[drank];
+            int tag = CreateBvals_MPI_Tag(lid, dn);
 
-          // get ptr to send buffer when neighbor is at coarser/same/fine level
-          int data_size = 3;
-          if ( nghbr.h_view(m,n).lev < pmy_pack->pmb->mb_lev.h_view(m) ) {
-            data_size *= sendbuf[n].icoar_ndat;
-          } else if ( nghbr.h_view(m,n).lev == pmy_pack->pmb->mb_lev.h_view(m) ) {
-            data_size *= sendbuf[n].isame_ndat;
-          } else {
-            data_size *= sendbuf[n].ifine_ndat;
+            // get ptr to send buffer when neighbor is at coarser/same/fine level
+            int data_size = 3;
+            if ( nghbr.h_view(m,n).lev < pmy_pack->pmb->mb_lev.h_view(m) ) {
+              data_size *= sendbuf[n].icoar_ndat;
+            } else if ( nghbr.h_view(m,n).lev == pmy_pack->pmb->mb_lev.h_view(m) ) {
+              data_size *= sendbuf[n].isame_ndat;
+            } else {
+              data_size *= sendbuf[n].ifine_ndat;
+            }
+            int ierr = PostSend(sendbuf[n].vars, sendbuf[n].vars_h, m, data_size, drank,
+                                tag, comm_vars, &(sendbuf[n].vars_req[m]));
+            if (ierr != MPI_SUCCESS) {no_errors=false;}
           }
-          auto send_ptr = Kokkos::subview(sendbuf[n].vars, m, Kokkos::ALL);
-
-          int ierr = MPI_Isend(send_ptr.data(), data_size, MPI_ATHENA_REAL, drank, tag,
-                               comm_vars, &(sendbuf[n].vars_req[m]));
-          if (ierr != MPI_SUCCESS) {no_errors=false;}
         }
       }
     }
   }
+  // post sends staged through host memory (if any)
+  if (FlushStagedSends() != MPI_SUCCESS) {no_errors=false;}
   // Quit if MPI error detected
   if (!(no_errors)) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
@@ -270,13 +279,20 @@ TaskStatus MeshBoundaryValuesFC::RecvAndUnpackFC(DvceFaceFld4D<Real> &b,
   }
   // exit if recv boundary buffer communications have not completed
   if (bflag) {return TaskStatus::incomplete;}
+
+  // copy data received into pinned host buffers (if any) to device
+  CopyStagedRecvs(staged_vars_recvs);
+  // scatter aggregated messages (if any) into recv buffers
+  if (aggregate_mpi && (RecvAggregated() == TaskStatus::incomplete)) {
+    return TaskStatus::incomplete;
+  }
 #endif
 
   //----- STEP 2: buffers have all completed, so unpack 3-components of field
 
   auto &mblev = pmy_pack->pmb->mb_lev;
   // Outer loop over (# of MeshBlocks)*(# of buffers)*(three field components)
-  Kokkos::TeamPolicy<> policy(DevExeSpace(), (3*nmb), Kokkos::AUTO);
+  Kokkos::TeamPolicy<> policy(pmy_pack->exe_space, (3*nmb), Kokkos::AUTO);
   Kokkos::parallel_for("RecvBuff", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
     const int m = tmember.league_rank()/3;
     const int v = tmember.league_rank()%3;
@@ -361,5 +377,8 @@ TaskStatus MeshBoundaryValuesFC::RecvAndUnpackFC(DvceFaceFld4D<Real> &b,
     }
   });  // end par_for_outer
 
+  // return buffers leased from pool (if used) once sends have also completed
+  bufs_unpacked_ = true;
+  ReleaseBuffers();
   return TaskStatus::complete;
 }
@@ -12,7 +12,7 @@
 #include <vector>
 #include <algorithm>
 #include <Kokkos_Core.hpp>
-#include <Kokkos_StdAlgorithms.hpp>
+#include <Kokkos_Sort.hpp>
 
 #include "athena.hpp"
 #include "globals.hpp"
@@ -26,21 +26,12 @@ namespace particles {
 //----------------------------------------------------------------------------------------
 //! \fn void ParticlesBoundaryValues::UpdateGID()
 //! \brief Updates GID of particles that cross boundary of their parent MeshBlock.  If
-//! the new GID is on a different rank, then store in sendlist_buf DvceArray: (1) index of
-//! particle in prtcl array, (2) destination GID, and (3) destination rank.
+//! the new GID is on a different rank, then store destination rank in dest.
 
 KOKKOS_INLINE_FUNCTION
-void UpdateGID(int &newgid, NeighborBlock nghbr, int myrank, int *pcounter,
-               DualArray1D<ParticleLocationData> slist, int p) {
+void UpdateGID(int &newgid, NeighborBlock nghbr, int myrank, int &dest) {
   newgid = nghbr.gid;
-#if MPI_PARALLEL_ENABLED
-  if (nghbr.rank != myrank) {
-    int index = Kokkos::atomic_fetch_add(pcounter,1);
-    slist.d_view(index).prtcl_indx = p;
-    slist.d_view(index).dest_gid   = nghbr.gid;
-    slist.d_view(index).dest_rank  = nghbr.rank;
-  }
-#endif
+  if (nghbr.rank != myrank) {dest = nghbr.rank;}
   return;
 }
 
@@ -59,14 +50,21 @@ TaskStatus ParticlesBoundaryValues::SetNewPrtclGID() {
   auto &meshsize = pmy_part->pmy_pack->pmesh->mesh_size;
   auto myrank = global_variable::my_rank;
   auto &nghbr = pmy_part->pmy_pack->pmb->nghbr;
-  auto &psendl = sendlist;
-  int counter=0;
-  int *pcounter = &counter;
   bool &multi_d = pmy_part->pmy_pack->pmesh->multi_d;
   bool &three_d = pmy_part->pmy_pack->pmesh->three_d;
 
-  Kokkos::realloc(sendlist, static_cast<int>(0.1*npart));
+  // destination rank of each particle, or -1 if it stays on this rank
+#if MPI_PARALLEL_ENABLED
+  if (static_cast<int>(prtcl_dest.extent(0)) < npart) {
+    Kokkos::realloc(prtcl_dest, npart);
+  }
+  auto &dest = prtcl_dest;
+#else
+  DvceArray1D<int> dest("prtcl_dest", npart);
+#endif
   par_for("part_update",DevExeSpace(),0,(npart-1), KOKKOS_LAMBDA(const int p) {
+    dest(p) = -1;
+    if (pi(PGID,p) < 0) return;  // skip holes
     int m = pi(PGID,p) - gids;
     int mylevel = mblev.d_view(m);
     Real x1 = pr(IPX,p);
@@ -100,7 +98,7 @@ TaskStatus ParticlesBoundaryValues::SetNewPrtclGID() {
             indx = NeighborIndex(ix,0,0,fy,fz);
           }
           while (nghbr.d_view(m,indx).gid < 0) {indx++;}  // neighbor at coarser level
-          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, pcounter, psendl, p);
+          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, dest(p));
         } else if (ix == 0) {
           // x2 face
           int indx = NeighborIndex(0,iy,0,0,0);
@@ -108,7 +106,7 @@ TaskStatus ParticlesBoundaryValues::SetNewPrtclGID() {
             indx = NeighborIndex(0,iy,0,fx,fz);
           }
           while (nghbr.d_view(m,indx).gid < 0) {indx++;}
-          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, pcounter, psendl, p);
+          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, dest(p));
         } else {
           // x1x2 edge
           int indx = NeighborIndex(ix,iy,0,0,0);
@@ -116,7 +114,7 @@ TaskStatus ParticlesBoundaryValues::SetNewPrtclGID() {
             indx = NeighborIndex(ix,iy,0,fz,0);
           }
           while (nghbr.d_view(m,indx).gid < 0) {indx++;}
-          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, pcounter, psendl, p);
+          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, dest(p));
         }
       } else if (iy == 0) {
         if (ix == 0) {
@@ -126,7 +124,7 @@ TaskStatus ParticlesBoundaryValues::SetNewPrtclGID() {
             indx = NeighborIndex(0,0,iz,fx,fy);
           }
           while (nghbr.d_view(m,indx).gid < 0) {indx++;}
-          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, pcounter, psendl, p);
+          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, dest(p));
         } else {
           // x3x1 edge
           int indx = NeighborIndex(ix,0,iz,0,0);
@@ -134,7 +132,7 @@ TaskStatus ParticlesBoundaryValues::SetNewPrtclGID() {
             indx = NeighborIndex(ix,0,iz,fy,0);
           }
           while (nghbr.d_view(m,indx).gid < 0) {indx++;}
-          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, pcounter, psendl, p);
+          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, dest(p));
         }
       } else {
         if (ix == 0) {
@@ -144,11 +142,11 @@ TaskStatus ParticlesBoundaryValues::SetNewPrtclGID() {
             indx = NeighborIndex(0,iy,iz,fx,0);
           }
           while (nghbr.d_view(m,indx).gid < 0) {indx++;}
-          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, pcounter, psendl, p);
+          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, dest(p));
         } else {
           // corners
           int indx = NeighborIndex(ix,iy,iz,0,0);
-          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, pcounter, psendl, p);
+          UpdateGID(pi(PGID,p), nghbr.d_view(m,indx), myrank, dest(p));
         }
       }
 
@@ -170,75 +168,140 @@ TaskStatus ParticlesBoundaryValues::SetNewPrtclGID() {
       }
     }
   });
-  nprtcl_send = counter;
-  Kokkos::resize(sendlist, nprtcl_send);
-  // sync sendlist device array with host
+
+#if MPI_PARALLEL_ENABLED
+  // count particles leaving this rank, then load sendlist in order of particle index
+  // with a prefix sum, so that it is built (and sorted by prtcl_indx) on the device
+  nprtcl_send = 0;
+  Kokkos::parallel_reduce("part_nsend",Kokkos::RangePolicy<>(DevExeSpace(),0,npart),
+  KOKKOS_LAMBDA(const int p, int &nsend) {
+    if (dest(p) >= 0) {nsend++;}
+  }, Kokkos::Sum<int>(nprtcl_send));
+  Kokkos::realloc(sendlist, nprtcl_send);
+  auto &slist = sendlist;
+  Kokkos::parallel_scan("part_sendlist",Kokkos::RangePolicy<>(DevExeSpace(),0,npart),
+  KOKKOS_LAMBDA(const int p, int &index, const bool last_pass) {
+    if (dest(p) >= 0) {
+      if (last_pass) {
+        slist.d_view(index).prtcl_indx = p;
+        slist.d_view(index).dest_gid   = pi(PGID,p);
+        slist.d_view(index).dest_rank  = dest(p);
+      }
+      index++;
+    }
+  });
   sendlist.template modify<DevExeSpace>();
-  sendlist.template sync<HostMemSpace>();
+#else
+  nprtcl_send = 0;
+#endif
 
   return TaskStatus::complete;
 }
 
+#if MPI_PARALLEL_ENABLED
+//----------------------------------------------------------------------------------------
+//! \fn void ParticlesBoundaryValues::SetNeighborRanks()
+//! \brief Finds the ranks owning MeshBlocks adjacent to those on this rank, and creates
+//! a distributed graph communicator over them.  Since MeshBlock adjacency is symmetric
+//! sources and destinations of the graph are the same.  Only rebuilt when neighbors of
+//! MeshBlocks change, which happens on all ranks at the same time.
+
+void ParticlesBoundaryValues::SetNeighborRanks() {
+  auto pmb = pmy_part->pmy_pack->pmb;
+  if (nghbr_version == pmb->nghbr_version) return;
+  nghbr_version = pmb->nghbr_version;
+
+  int nmb = pmy_part->pmy_pack->nmb_thispack;
+  int nnghbr = pmb->nnghbr;
+  nghbr_ranks.clear();
+  for (int m=0; m<nmb; ++m) {
+    for (int n=0; n<nnghbr; ++n) {
+      int rank = pmb->nghbr.h_view(m,n).rank;
+      if (pmb->nghbr.h_view(m,n).gid >= 0 && rank != global_variable::my_rank) {
+        nghbr_ranks.push_back(rank);
+      }
+    }
+  }
+  std::sort(nghbr_ranks.begin(), nghbr_ranks.end());
+  nghbr_ranks.erase(std::unique(nghbr_ranks.begin(), nghbr_ranks.end()),
+                    nghbr_ranks.end());
+  int nnr = nghbr_ranks.size();
+
+  Kokkos::realloc(d_nghbr_ranks, std::max(nnr,1));
+  if (nnr > 0) {
+    HostArray1D<int> h_ranks("h_ranks", nnr);
+    for (int n=0; n<nnr; ++n) {h_ranks(n) = nghbr_ranks[n];}
+    Kokkos::deep_copy(Kokkos::subview(d_nghbr_ranks, std::make_pair(0,nnr)), h_ranks);
+  }
+
+  if (mpi_comm_nghbr != MPI_COMM_NULL) {MPI_Comm_free(&mpi_comm_nghbr);}
+  MPI_Dist_graph_create_adjacent(mpi_comm_part, nnr, nghbr_ranks.data(), MPI_UNWEIGHTED,
+                                 nnr, nghbr_ranks.data(), MPI_UNWEIGHTED, MPI_INFO_NULL,
+                                 0, &mpi_comm_nghbr);
+  return;
+}
+#endif
+
 //----------------------------------------------------------------------------------------
 //! \fn void ParticlesBoundaryValues::CountSendsAndRecvs()
 //! \brief
 
 TaskStatus ParticlesBoundaryValues::CountSendsAndRecvs() {
 #if MPI_PARALLEL_ENABLED
-  // Sort sendlist on host by destrank.
-  namespace KE = Kokkos::Experimental;
-  std::sort(KE::begin(sendlist.h_view), KE::end(sendlist.h_view), SortByRank);
-  // sync sendlist host array with device.  This results in sorted array on device
-  sendlist.template modify<HostMemSpace>();
-  sendlist.template sync<DevExeSpace>();
+  SetNeighborRanks();
+  int nnr = nghbr_ranks.size();
 
-  // load STL::vector of ParticleMessageData with <sendrank, recvrank, nprtcls> for sends
-  // from this rank. Length will be nsends; initially this length is unknown
-  sends_thisrank.clear();
+  // Sort sendlist on device by destination rank with a bin sort over neighboring ranks.
+  // Only the permutation is stored (in send_order), sendlist itself stays ordered by
+  // particle index.  Each bin count is the number of particles sent to that rank.
+  std::vector<int> nsend_nghbr(std::max(nnr,1), 0), nrecv_nghbr(std::max(nnr,1), 0);
   if (nprtcl_send > 0) {
-    int &myrank = global_variable::my_rank;
-    int rank = sendlist.h_view(0).dest_rank;
-    int nprtcl = 1;
-
-    for (int n=1; n<nprtcl_send; ++n) {
-      if (sendlist.h_view(n).dest_rank == rank) {
-        ++nprtcl;
-      } else {
-        sends_thisrank.emplace_back(ParticleMessageData(myrank,rank,nprtcl));
-        rank = sendlist.h_view(n).dest_rank;
-        nprtcl = 1;
+    DvceArray1D<int> keys("prtcl_keys", nprtcl_send);
+    auto &slist = sendlist;
+    auto &ranks = d_nghbr_ranks;
+    par_for("part_keys",DevExeSpace(),0,(nprtcl_send-1), KOKKOS_LAMBDA(const int n) {
+      // binary search for index of destination in sorted list of neighboring ranks
+      int rank = slist.d_view(n).dest_rank;
+      int lo = 0, hi = nnr-1;
+      while (lo < hi) {
+        int mid = (lo + hi)/2;
+        if (ranks(mid) < rank) {lo = mid+1;} else {hi = mid;}
       }
+      keys(n) = lo;
+    });
+    using BinOp = Kokkos::BinOp1D<DvceArray1D<int>>;
+    BinOp binner(nnr, 0, nnr);
+    Kokkos::BinSort<DvceArray1D<int>, BinOp> sorter(keys, binner, false);
+    sorter.create_permute_vector();
+    send_order = sorter.get_permute_vector();
+    auto h_count = Kokkos::create_mirror_view_and_copy(HostMemSpace(),
+                                                       sorter.get_bin_count());
+    for (int n=0; n<nnr; ++n) {nsend_nghbr[n] = h_count(n);}
+  }
+
+  // load STL::vector of ParticleMessageData with <sendrank, recvrank, nprtcls> for sends
+  // from this rank, in order of destination rank
+  int &myrank = global_variable::my_rank;
+  sends_thisrank.clear();
+  for (int n=0; n<nnr; ++n) {
+    if (nsend_nghbr[n] > 0) {
+      sends_thisrank.emplace_back(ParticleMessageData(myrank,nghbr_ranks[n],
+                                                      nsend_nghbr[n]));
     }
-    sends_thisrank.emplace_back(ParticleMessageData(myrank,rank,nprtcl));
   }
   nsends = sends_thisrank.size();
 
-  // Share number of ranks to send to amongst all ranks
-  nsends_eachrank[global_variable::my_rank] = nsends;
-  MPI_Allgather(&nsends, 1, MPI_INT, nsends_eachrank.data(), 1, MPI_INT, mpi_comm_part);
-
-  // Now share ParticleMessageData amongst all ranks
-  // First create vector of starting indices in full vector
-  std::vector<int> nsends_displ;
-  nsends_displ.resize(global_variable::nranks);
-  nsends_displ[0] = 0;
-  for (int n=1; n<(global_variable::nranks); ++n) {
-    nsends_displ[n] = nsends_displ[n-1] + nsends_eachrank[n-1];
-  }
-  int nsends_allranks = nsends_displ[global_variable::nranks - 1] +
-                        nsends_eachrank[global_variable::nranks - 1];
-  // Load ParticleMessageData on this rank into full vector
-  sends_allranks.resize(nsends_allranks, ParticleMessageData(0,0,0));
-  for (int n=0; n<nsends_eachrank[global_variable::my_rank]; ++n) {
-    sends_allranks[n + nsends_displ[global_variable::my_rank]] = sends_thisrank[n];
+  // Exchange number of particles sent with neighboring ranks only, and load vector of
+  // ParticleMessageData for receives on this rank.
+  MPI_Neighbor_alltoall(nsend_nghbr.data(), 1, MPI_INT, nrecv_nghbr.data(), 1, MPI_INT,
+                        mpi_comm_nghbr);
+  recvs_thisrank.clear();
+  for (int n=0; n<nnr; ++n) {
+    if (nrecv_nghbr[n] > 0) {
+      recvs_thisrank.emplace_back(ParticleMessageData(nghbr_ranks[n],myrank,
+                                                      nrecv_nghbr[n]));
+    }
   }
-
-  // Share tuples using MPI derived data type for tuple of 3*int
-  MPI_Datatype mpi_ituple;
-  MPI_Type_contiguous(3, MPI_INT, &mpi_ituple);
-  MPI_Allgatherv(MPI_IN_PLACE, nsends_eachrank[global_variable::my_rank],
-                   mpi_ituple, sends_allranks.data(), nsends_eachrank.data(),
-                   nsends_displ.data(), mpi_ituple, mpi_comm_part);
 #endif
   return TaskStatus::complete;
 }
@@ -249,16 +312,8 @@ TaskStatus ParticlesBoundaryValues::CountSendsAndRecvs() {
 
 TaskStatus ParticlesBoundaryValues::InitPrtclRecv() {
 #if MPI_PARALLEL_ENABLED
-  // load STL::vector of ParticleMessageData with <sendrank,recvrank,nprtcl_recv> for
-  // receives // on this rank. Length will be nrecvs, initially this length is unknown
-  recvs_thisrank.clear();
-
-  int nsends_allranks = sends_allranks.size();
-  for (int n=0; n<nsends_allranks; ++n) {
-    if (sends_allranks[n].recvrank == global_variable::my_rank) {
-      recvs_thisrank.emplace_back(sends_allranks[n]);
-    }
-  }
+  // vector of ParticleMessageData for receives on this rank is set in
+  // CountSendsAndRecvs()
   nrecvs = recvs_thisrank.size();
 
   // Figure out how many particles will be received from all ranks
@@ -341,16 +396,18 @@ TaskStatus ParticlesBoundaryValues::PackAndSendPrtcls() {
     Kokkos::realloc(prtcl_rsendbuf, (pmy_part->nrdata)*nprtcl_send);
     Kokkos::realloc(prtcl_isendbuf, (pmy_part->nidata)*nprtcl_send);
 
-    // sendlist on device is already sorted by destrank in CountSendAndRecvs()
-    // Use sendlist on device to load particles into send buffer ordered by dest_rank
+    // Use sendlist on device, in the order by dest_rank found in CountSendAndRecvs(),
+    // to load particles into send buffer ordered by dest_rank
     int nrdata = pmy_part->nrdata;
     int nidata = pmy_part->nidata;
     auto &pr = pmy_part->prtcl_rdata;
     auto &pi = pmy_part->prtcl_idata;
     auto &rsendbuf = prtcl_rsendbuf;
     auto &isendbuf = prtcl_isendbuf;
+    auto &slist = sendlist;
+    auto &order = send_order;
     par_for("ppack",DevExeSpace(),0,(nprtcl_send-1), KOKKOS_LAMBDA(const int n) {
-      int p = sendlist.d_view(n).prtcl_indx;
+      int p = slist.d_view(order(n)).prtcl_indx;
       for (int i=0; i<nidata; ++i) {
         isendbuf(nidata*n + i) = pi(i,p);
       }
@@ -379,6 +436,8 @@ TaskStatus ParticlesBoundaryValues::PackAndSendPrtcls() {
       int tag = 0; // 0 for Reals, 1 for ints
 
       // Post non-blocking sends
+      comm_stats::AddMessage(comm_stats::Module::particles, drank, 0,
+                             static_cast<double>(data_size)*sizeof(Real));
       int ierr = MPI_Isend(send_ptr.data(), data_size, MPI_ATHENA_REAL, drank, tag,
                            mpi_comm_part, &(rsend_req[n]));
       if (ierr != MPI_SUCCESS) {no_errors=false;}
@@ -395,6 +454,8 @@ TaskStatus ParticlesBoundaryValues::PackAndSendPrtcls() {
       int tag = 1; // 0 for Reals, 1 for ints
 
       // Post non-blocking sends
+      comm_stats::AddMessage(comm_stats::Module::particles, drank, 0,
+                             static_cast<double>(data_size)*sizeof(int));
       int ierr = MPI_Isend(send_ptr.data(), data_size, MPI_INT, drank, tag,
                            mpi_comm_part, &(isend_req[n]));
       if (ierr != MPI_SUCCESS) {no_errors=false;}
@@ -418,19 +479,12 @@ TaskStatus ParticlesBoundaryValues::PackAndSendPrtcls() {
 
 TaskStatus ParticlesBoundaryValues::RecvAndUnpackPrtcls() {
 #if MPI_PARALLEL_ENABLED
-  // Sort sendlist on host by index in particle array
-  namespace KE = Kokkos::Experimental;
-  std::sort(KE::begin(sendlist.h_view), KE::end(sendlist.h_view), SortByIndex);
-  // sync sendlist host array with device.  This results in sorted array on device
-  sendlist.template modify<HostMemSpace>();
-  sendlist.template sync<DevExeSpace>();
-
-  // increase size of particle arrays if needed
-  int new_npart = pmy_part->nprtcl_thispack + (nprtcl_recv - nprtcl_send);
-  if (nprtcl_recv > nprtcl_send) {
-    Kokkos::resize(pmy_part->prtcl_idata, pmy_part->nidata, new_npart);
-    Kokkos::resize(pmy_part->prtcl_rdata, pmy_part->nrdata, new_npart);
-  }
+  // sendlist is already sorted by index in particle array on the device, since it is
+  // built with a prefix sum over particles in SetNewPrtclGID()
+
+  // increase capacity of particle arrays if needed
+  int new_npart = pmy_part->nprtcl_thispack + std::max(nprtcl_recv - nprtcl_send, 0);
+  pmy_part->ReserveParticles(new_npart);
 
   // check that particle communications have all completed
   bool bflag = false;
@@ -484,41 +538,29 @@ TaskStatus ParticlesBoundaryValues::RecvAndUnpackPrtcls() {
   }
 
   // At this point have filled npart_recv holes in particle arrays from sends
-  // If (nprtcl_recv < nprtcl_send), have to move particles from end of arrays to fill
-  // remaining holes
+  // If (nprtcl_recv < nprtcl_send), the remaining slots of sent particles are marked as
+  // holes, and the arrays are only compacted once holes exceed compact_fraction
   int nremain = nprtcl_send - nprtcl_recv;
   if (nremain > 0) {
-    int &npart = pmy_part->nprtcl_thispack;
-    int i_last_hole = nprtcl_send-1;
-    int i_next_hole = nprtcl_recv;
-    for (int n=1; n<=nremain; ++n) {
-      int nend = npart-n;
-      if (nend > sendlist.h_view(i_last_hole).prtcl_indx) {
-        // copy particle from end into hole
-        int next_hole = sendlist.h_view(i_next_hole).prtcl_indx;
-        auto rdest = Kokkos::subview(pmy_part->prtcl_rdata, Kokkos::ALL, next_hole);
-        auto rsrc  = Kokkos::subview(pmy_part->prtcl_rdata, Kokkos::ALL, nend);
-        Kokkos::deep_copy(rdest, rsrc);
-        auto idest = Kokkos::subview(pmy_part->prtcl_idata, Kokkos::ALL, next_hole);
-        auto isrc  = Kokkos::subview(pmy_part->prtcl_idata, Kokkos::ALL, nend);
-        Kokkos::deep_copy(idest, isrc);
-        i_next_hole += 1;
-      } else {
-        // this index contains a hole, so do nothing except find new index of last hole
-        i_last_hole -= 1;
-      }
-    }
-
-    // shrink size of particle data arrays
-    Kokkos::resize(pmy_part->prtcl_idata, pmy_part->nidata, new_npart);
-    Kokkos::resize(pmy_part->prtcl_rdata, pmy_part->nrdata, new_npart);
+    auto &pi = pmy_part->prtcl_idata;
+    auto &slist = sendlist;
+    int nrecv = nprtcl_recv;
+    par_for("phole",DevExeSpace(),0,(nremain-1), KOKKOS_LAMBDA(const int n) {
+      pi(PGID,slist.d_view(nrecv + n).prtcl_indx) = -1;
+    });
+    pmy_part->nprtcl_holes += nremain;
   }
-
-  // Update nparticles_thisrank.  Update cost array (use npart_thismb[nmb]?)
   pmy_part->nprtcl_thispack = new_npart;
+  if (pmy_part->nprtcl_holes > (pmy_part->compact_fraction)*new_npart) {
+    pmy_part->CompactParticles();
+  }
+  new_npart = pmy_part->nprtcl_thispack - pmy_part->nprtcl_holes;
+
+  // Update nparticles_thisrank.  Particles in each MB are counted for load balancing
+  // by Particles::CountParticlesEachMB() only when needed.
   pmy_part->pmy_pack->pmesh->nprtcl_thisrank = new_npart;
   MPI_Allgather(&new_npart,1,MPI_INT,(pmy_part->pmy_pack->pmesh->nprtcl_eachrank),1,
-                MPI_INT,MPI_COMM_WORLD);
+                MPI_INT,global_variable::mpi_comm);
 #endif
   return TaskStatus::complete;
 }
@@ -577,4 +619,22 @@ TaskStatus ParticlesBoundaryValues::ClearPrtclRecv() {
   return TaskStatus::complete;
 }
 
+
+#if MPI_PARALLEL_ENABLED
+//----------------------------------------------------------------------------------------
+//! \fn void ParticlesBoundaryValues::GetPendingRecvs()
+//! \brief Appends pointers to all outstanding non-blocking receives of particles to
+//! input vector.  Used by the event-driven task scheduler.
+
+void ParticlesBoundaryValues::GetPendingRecvs(std::vector<MPI_Request*> &reqs) {
+  for (int n=0; n<static_cast<int>(rrecv_req.size()); ++n) {
+    if (rrecv_req[n] != MPI_REQUEST_NULL) {reqs.push_back(&(rrecv_req[n]));}
+  }
+  for (int n=0; n<static_cast<int>(irecv_req.size()); ++n) {
+    if (irecv_req[n] != MPI_REQUEST_NULL) {reqs.push_back(&(irecv_req[n]));}
+  }
+  return;
+}
+#endif
+
 } // namespace particles
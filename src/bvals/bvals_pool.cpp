@@ -0,0 +1,152 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file bvals_pool.cpp
+//! \brief Implements the device pool from which boundary buffers of variables are leased
+//! with <mesh>/shared_bvals_pool = true.  Instead of every MeshBoundaryValues (hydro,
+//! MHD CC and FC, radiation, Z4c, ...) owning buffers for its whole lifetime, buffers
+//! are leased when an exchange starts (first PackAndSend of a stage) and returned as
+//! soon as they have been unpacked and all MPI sends from them have completed, so that
+//! exchanges of different modules that do not overlap in time share the same memory.
+//! Receives posted by InitRecv() are deferred until the buffers are leased.  Only the
+//! buffers of variables (ng cells deep) are pooled, not the buffers of fluxes.
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "mesh/mesh.hpp"
+#include "driver/memory_tracker.hpp"
+#include "bvals.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \fn Real *BoundaryBufferPool::Lease()
+//! \brief Returns pointer to ndat elements of device memory, taken from the first gap
+//! between outstanding leases in the pool that is large enough, or else allocated
+//! separately.
+
+Real *BoundaryBufferPool::Lease(size_t ndat) {
+  size_t offset = 0;
+  for (auto &it : leases_) {
+    if (it.first - offset >= ndat) break;
+    offset = it.first + it.second;
+  }
+  if (offset + ndat <= data.extent(0)) {
+    leases_[offset] = ndat;
+    return data.data() + offset;
+  }
+
+  memory_tracker::Scope mem_scope("bvals");
+  DvceArray1D<Real> buf("bvals_pool_extra", ndat);
+  extra_[buf.data()] = buf;
+  extra_ndat_ += ndat;
+  extra_peak_ = std::max(extra_peak_, extra_ndat_);
+  return buf.data();
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BoundaryBufferPool::Release()
+//! \brief Returns lease starting at ptr to the pool.  Once no leases are outstanding,
+//! the pool grows by the peak total size of leases that did not fit.  All kernels and
+//! MPI messages using the lease must have completed.
+
+void BoundaryBufferPool::Release(Real *ptr) {
+  auto it = extra_.find(ptr);
+  if (it != extra_.end()) {
+    extra_ndat_ -= it->second.extent(0);
+    extra_.erase(it);
+  } else {
+    leases_.erase(static_cast<size_t>(ptr - data.data()));
+  }
+
+  if (leases_.empty() && extra_.empty() && extra_peak_ > 0) {
+    memory_tracker::Scope mem_scope("bvals");
+    Kokkos::realloc(data, data.extent(0) + extra_peak_);
+    extra_peak_ = 0;
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBoundaryValues::AcquireBuffers()
+//! \brief With pool_bufs, leases one block for the send and recv buffers of variables
+//! of all neighbors, and posts any receives deferred by InitRecv().  Called at the start
+//! of all PackAndSend functions.  Does nothing if buffers are already leased.
+
+void MeshBoundaryValues::AcquireBuffers() {
+  if (!(pool_bufs)) return;
+  bufs_unpacked_ = false;
+  if (pool_lease_ != nullptr) return;
+
+  int nnghbr = pmy_pack->pmb->nnghbr;
+  size_t ndat = 0;
+  for (int n=0; n<nnghbr; ++n) {
+    ndat += static_cast<size_t>(nmb_bufs_)*(sendbuf[n].vars_ndat + recvbuf[n].vars_ndat);
+  }
+  pool_lease_ = pmy_pack->pbuf_pool->Lease(ndat);
+
+  Real *ptr = pool_lease_;
+  for (int n=0; n<nnghbr; ++n) {
+    sendbuf[n].vars = DvceArray2D<Real>(ptr, nmb_bufs_, sendbuf[n].vars_ndat);
+    ptr += static_cast<size_t>(nmb_bufs_)*sendbuf[n].vars_ndat;
+    recvbuf[n].vars = DvceArray2D<Real>(ptr, nmb_bufs_, recvbuf[n].vars_ndat);
+    ptr += static_cast<size_t>(nmb_bufs_)*recvbuf[n].vars_ndat;
+  }
+
+  if (recvs_deferred_) {
+    recvs_deferred_ = false;
+    InitRecv(recv_nvar_);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBoundaryValues::ReleaseBuffers()
+//! \brief Returns leased buffers to the pool once they have been unpacked and all MPI
+//! sends from them have completed.  Called after buffers are unpacked, and by ClearSend()
+//! for sends that were still in flight then.
+
+void MeshBoundaryValues::ReleaseBuffers() {
+  if (pool_lease_ == nullptr || !(bufs_unpacked_)) return;
+  int nnghbr = pmy_pack->pmb->nnghbr;
+
+#if MPI_PARALLEL_ENABLED
+  int &nmb = pmy_pack->nmb_thispack;
+  auto &nghbr = pmy_pack->pmb->nghbr;
+  bool no_errors=true;
+  bool sends_done=true;
+  for (int m=0; m<nmb; ++m) {
+    for (int n=0; n<nnghbr; ++n) {
+      if ( (nghbr.h_view(m,n).gid >= 0) &&
+           (nghbr.h_view(m,n).rank != global_variable::my_rank) ) {
+        int test;
+        int ierr = MPI_Test(&(sendbuf[n].vars_req[m]), &test, MPI_STATUS_IGNORE);
+        if (ierr != MPI_SUCCESS) {no_errors=false;}
+        if (!(static_cast<bool>(test))) {sends_done=false;}
+      }
+    }
+  }
+  // Quit if MPI error detected
+  if (!(no_errors)) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "MPI error in testing non-blocking sends" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  if (!(sends_done)) return;
+#endif
+
+  // unpack kernels must finish before memory is reused by another module
+  pmy_pack->exe_space.fence();
+  pmy_pack->pbuf_pool->Release(pool_lease_);
+  pool_lease_ = nullptr;
+  for (int n=0; n<nnghbr; ++n) {
+    sendbuf[n].vars = DvceArray2D<Real>();
+    recvbuf[n].vars = DvceArray2D<Real>();
+  }
+  return;
+}
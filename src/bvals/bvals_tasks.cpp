@@ -17,6 +17,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <utility>
+#include <vector>
 
 #include "athena.hpp"
 #include "globals.hpp"
@@ -27,45 +28,63 @@
 //----------------------------------------------------------------------------------------
 //! \fn  void MeshBoundaryValues::InitRecv
 //! \brief Posts non-blocking receives (with MPI) for boundary communications of vars.
+//! Only the subset of variables set by SetVariableSubset() (if any) is received.  With
+//! pool_bufs, receives are posted by AcquireBuffers() once buffers have been leased.
 
-TaskStatus MeshBoundaryValues::InitRecv(const int nvars) {
+TaskStatus MeshBoundaryValues::InitRecv(const int nvar_all) {
 #if MPI_PARALLEL_ENABLED
+  if (pool_bufs) {
+    if (pool_lease_ == nullptr) {
+      recvs_deferred_ = true;
+      recv_nvar_ = nvar_all;
+      return TaskStatus::complete;
+    }
+    bufs_unpacked_ = false;
+  }
+  const int nvars = (nsub_vars > 0)? nsub_vars : nvar_all;
   int &nmb = pmy_pack->nmb_thispack;
   int &nnghbr = pmy_pack->pmb->nnghbr;
   auto &nghbr = pmy_pack->pmb->nghbr;
+  staged_vars_recvs.clear();
+  ResetPersistentRequests(pers_vars_recv, false, false, nvars);
 
   // Initialize communications of variables
   bool no_errors=true;
-  for (int m=0; m<nmb; ++m) {
-    for (int n=0; n<nnghbr; ++n) {
-      if (nghbr.h_view(m,n).gid >= 0) {
-        // rank of destination buffer
-        int drank = nghbr.h_view(m,n).rank;
-
-        // post non-blocking receive if neighboring MeshBlock on a different rank
-        if (drank != global_variable::my_rank) {
-          // create tag using local ID and buffer index of *receiving* MeshBlock
-          int tag = CreateBvals_MPI_Tag(m, n);
-
-          // calculate amount of data to be passed, get pointer to variables
-          int data_size = nvars;
-          if ( nghbr.h_view(m,n).lev < pmy_pack->pmb->mb_lev.h_view(m) ) {
-            data_size *= recvbuf[n].icoar_ndat;
-          } else if ( nghbr.h_view(m,n).lev == pmy_pack->pmb->mb_lev.h_view(m) ) {
-            if (is_z4c_) {
-              data_size *= recvbuf[n].isame_z4c_ndat;
+  if (aggregate_mpi) {
+    // post one receive per rank for aggregated messages
+    if (InitRecvAggregated(nvars) != MPI_SUCCESS) {no_errors=false;}
+  } else {
+    for (int m=0; m<nmb; ++m) {
+      for (int n=0; n<nnghbr; ++n) {
+        if (nghbr.h_view(m,n).gid >= 0) {
+          // rank of destination buffer
+          int drank = nghbr.h_view(m,n).rank;
+
+          // post non-blocking receive if neighboring MeshBlock on a different rank
+          if (drank != global_variable::my_rank) {
+            // create tag using local ID and buffer index of *receiving* MeshBlock
+            int tag = CreateBvals_MPI_Tag(m, n);
+
+            // calculate amount of data to be passed, get pointer to variables
+            int data_size = nvars;
+            if ( nghbr.h_view(m,n).lev < pmy_pack->pmb->mb_lev.h_view(m) ) {
+              data_size *= recvbuf[n].icoar_ndat;
+            } else if ( nghbr.h_view(m,n).lev == pmy_pack->pmb->mb_lev.h_view(m) ) {
+              if (is_z4c_) {
+                data_size *= recvbuf[n].isame_z4c_ndat;
+              } else {
+                data_size *= recvbuf[n].isame_ndat;
+              }
             } else {
-              data_size *= recvbuf[n].isame_ndat;
+              data_size *= recvbuf[n].ifine_ndat;
             }
-          } else {
-            data_size *= recvbuf[n].ifine_ndat;
-          }
-          auto recv_ptr = Kokkos::subview(recvbuf[n].vars, m, Kokkos::ALL);
 
-          // Post non-blocking receive for this buffer on this MeshBlock
-          int ierr = MPI_Irecv(recv_ptr.data(), data_size, MPI_ATHENA_REAL, drank, tag,
-                               comm_vars, &(recvbuf[n].vars_req[m]));
-          if (ierr != MPI_SUCCESS) {no_errors=false;}
+            // Post non-blocking receive for this buffer on this MeshBlock
+            int ierr = PostRecv(recvbuf[n].vars, recvbuf[n].vars_h, m, data_size, drank,
+                                tag, comm_vars, &(recvbuf[n].vars_req[m]),
+                                staged_vars_recvs);
+            if (ierr != MPI_SUCCESS) {no_errors=false;}
+          }
         }
       }
     }
@@ -102,6 +121,7 @@ TaskStatus MeshBoundaryValues::ClearRecv() {
       }
     }
   }
+  if (ClearAggregated(false) != MPI_SUCCESS) {no_errors=false;}
   // Quit if MPI error detected
   if (!(no_errors)) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
@@ -134,6 +154,7 @@ TaskStatus MeshBoundaryValues::ClearSend() {
       }
     }
   }
+  if (ClearAggregated(true) != MPI_SUCCESS) {no_errors=false;}
   // Quit if MPI error detected
   if (!(no_errors)) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
@@ -141,6 +162,8 @@ TaskStatus MeshBoundaryValues::ClearSend() {
     std::exit(EXIT_FAILURE);
   }
 #endif
+  // return leased buffers (if not already released after they were unpacked)
+  ReleaseBuffers();
   return TaskStatus::complete;
 }
 
@@ -201,3 +224,165 @@ TaskStatus MeshBoundaryValues::ClearFluxSend() {
 
   return TaskStatus::fail;
 }
+
+#if MPI_PARALLEL_ENABLED
+//----------------------------------------------------------------------------------------
+//! \fn  void MeshBoundaryValues::GetPendingRecvs
+//! \brief Appends pointers to all outstanding non-blocking receives (for both variables
+//! and fluxes) to input vector.  Completed (or never posted) receives are equal to
+//! MPI_REQUEST_NULL and are skipped.  Used by the event-driven task scheduler.
+
+void MeshBoundaryValues::GetPendingRecvs(std::vector<MPI_Request*> &reqs) {
+  int &nmb = pmy_pack->nmb_thispack;
+  int &nnghbr = pmy_pack->pmb->nnghbr;
+  for (int m=0; m<nmb; ++m) {
+    for (int n=0; n<nnghbr; ++n) {
+      if (recvbuf[n].vars_req[m] != MPI_REQUEST_NULL) {
+        reqs.push_back(&(recvbuf[n].vars_req[m]));
+      }
+      if (recvbuf[n].flux_req[m] != MPI_REQUEST_NULL) {
+        reqs.push_back(&(recvbuf[n].flux_req[m]));
+      }
+    }
+  }
+  for (auto &req : agg_vars.recv_req) {
+    if (req != MPI_REQUEST_NULL) {reqs.push_back(&req);}
+  }
+  return;
+}
+#endif
+
+#if MPI_PARALLEL_ENABLED
+//----------------------------------------------------------------------------------------
+//! \fn  int MeshBoundaryValues::PostSend
+//! \brief Posts non-blocking send of ndat elements of buffer for MeshBlock m.  When MPI
+//! messages are staged through host memory, the copy to the pinned host buffer is only
+//! started here, and the send is posted in FlushStagedSends().  Returns MPI error code.
+
+int MeshBoundaryValues::PostSend(DvceArray2D<Real> &dbuf, HostPinnedArray2D<Real> &hbuf,
+                                 int m, int ndat, int rank, int tag, MPI_Comm comm,
+                                 MPI_Request *req) {
+  if (stage_mpi_bufs) {
+    auto dsub = Kokkos::subview(dbuf, m, std::make_pair(0, ndat));
+    auto hsub = Kokkos::subview(hbuf, m, std::make_pair(0, ndat));
+    Kokkos::deep_copy(pmy_pack->exe_space, hsub, dsub);
+    staged_sends.push_back({dbuf, hbuf, m, ndat, rank, tag, comm, req});
+    return MPI_SUCCESS;
+  }
+  auto send_ptr = Kokkos::subview(dbuf, m, Kokkos::ALL);
+  return StartSend(send_ptr.data(), ndat, rank, tag, comm, req);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  int MeshBoundaryValues::FlushStagedSends
+//! \brief Waits for all copies to pinned host buffers started in PostSend() to finish,
+//! then posts the non-blocking sends from host memory.  Returns MPI error code.
+
+int MeshBoundaryValues::FlushStagedSends() {
+  int ierr = MPI_SUCCESS;
+  if (staged_sends.empty()) return ierr;
+  pmy_pack->exe_space.fence();
+  for (auto &msg : staged_sends) {
+    auto send_ptr = Kokkos::subview(msg.hbuf, msg.m, Kokkos::ALL);
+    int jerr = StartSend(send_ptr.data(), msg.ndat, msg.rank, msg.tag, msg.comm, msg.req);
+    if (jerr != MPI_SUCCESS) {ierr = jerr;}
+  }
+  staged_sends.clear();
+  return ierr;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  int MeshBoundaryValues::PostRecv
+//! \brief Posts non-blocking receive of ndat elements of buffer for MeshBlock m.  When
+//! MPI messages are staged through host memory, data is received into pinned host buffer
+//! and message is added to list that is copied to device by CopyStagedRecvs().
+
+int MeshBoundaryValues::PostRecv(DvceArray2D<Real> &dbuf, HostPinnedArray2D<Real> &hbuf,
+                                 int m, int ndat, int rank, int tag, MPI_Comm comm,
+                                 MPI_Request *req, std::vector<StagedMessage> &staged) {
+  if (stage_mpi_bufs) {
+    staged.push_back({dbuf, hbuf, m, ndat, rank, tag, comm, req});
+    auto recv_ptr = Kokkos::subview(hbuf, m, Kokkos::ALL);
+    return StartRecv(recv_ptr.data(), ndat, rank, tag, comm, req);
+  }
+  auto recv_ptr = Kokkos::subview(dbuf, m, Kokkos::ALL);
+  return StartRecv(recv_ptr.data(), ndat, rank, tag, comm, req);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void MeshBoundaryValues::CopyStagedRecvs
+//! \brief Copies data received into pinned host buffers to device.  Must only be called
+//! once all receives in list have completed.  Copies are asynchronous on the execution
+//! space of the MeshBlockPack, so are ordered before subsequent unpack kernels.
+
+void MeshBoundaryValues::CopyStagedRecvs(std::vector<StagedMessage> &staged) {
+  for (auto &msg : staged) {
+    auto dsub = Kokkos::subview(msg.dbuf, msg.m, std::make_pair(0, msg.ndat));
+    auto hsub = Kokkos::subview(msg.hbuf, msg.m, std::make_pair(0, msg.ndat));
+    Kokkos::deep_copy(pmy_pack->exe_space, dsub, hsub);
+  }
+  staged.clear();
+  return;
+}
+//----------------------------------------------------------------------------------------
+//! \fn  int MeshBoundaryValues::StartSend
+//! \brief Starts non-blocking send.  With persistent requests, the request is created by
+//! MPI_Send_init() the first time it is used (or after it was freed because neighbors
+//! changed), and afterwards only restarted.  Returns MPI error code.
+
+int MeshBoundaryValues::StartSend(void *ptr, int ndat, int rank, int tag, MPI_Comm comm,
+                                  MPI_Request *req, MPI_Datatype type) {
+  if (persistent_mpi) {
+    if (*req == MPI_REQUEST_NULL) {
+      int ierr = MPI_Send_init(ptr, ndat, type, rank, tag, comm, req);
+      if (ierr != MPI_SUCCESS) return ierr;
+    }
+    return MPI_Start(req);
+  }
+  return MPI_Isend(ptr, ndat, type, rank, tag, comm, req);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  int MeshBoundaryValues::StartRecv
+//! \brief Starts non-blocking receive, using persistent requests if enabled (see
+//! StartSend() above).  Returns MPI error code.
+
+int MeshBoundaryValues::StartRecv(void *ptr, int ndat, int rank, int tag, MPI_Comm comm,
+                                  MPI_Request *req, MPI_Datatype type) {
+  if (persistent_mpi) {
+    if (*req == MPI_REQUEST_NULL) {
+      int ierr = MPI_Recv_init(ptr, ndat, type, rank, tag, comm, req);
+      if (ierr != MPI_SUCCESS) return ierr;
+    }
+    return MPI_Start(req);
+  }
+  return MPI_Irecv(ptr, ndat, type, rank, tag, comm, req);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void MeshBoundaryValues::ResetPersistentRequests
+//! \brief Frees one set of persistent requests (sends or receives of variables or
+//! fluxes) if neighbors have changed since they were created (e.g. after AMR or load
+//! balancing), or if number of variables is different.  Requests are then re-created by
+//! StartSend/StartRecv.  All requests must be inactive, which is guaranteed since the
+//! ClearSend/ClearRecv tasks wait on all requests at the end of every stage.
+
+void MeshBoundaryValues::ResetPersistentRequests(PersistentRequestsInfo &info, bool send,
+                                                 bool flux, int nvar) {
+  if (!(persistent_mpi)) return;
+  int version = pmy_pack->pmb->nghbr_version;
+  if ((info.nghbr_version == version) && (info.nvar == nvar)) return;
+
+  int nnghbr = pmy_pack->pmb->nnghbr;
+  for (int n=0; n<nnghbr; ++n) {
+    MeshBoundaryBuffer &buf = (send)? sendbuf[n] : recvbuf[n];
+    MPI_Request *req = (flux)? buf.flux_req : buf.vars_req;
+    for (int m=0; m<nreq_; ++m) {
+      if (req[m] != MPI_REQUEST_NULL) {MPI_Request_free(&(req[m]));}
+    }
+  }
+  info.nghbr_version = version;
+  info.nvar = nvar;
+  return;
+}
+#endif
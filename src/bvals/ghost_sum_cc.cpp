@@ -0,0 +1,134 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file ghost_sum_cc.cpp
+//! \brief functions to add cell-centered values accumulated in the ghost zones of each
+//! MeshBlock (e.g. by particle deposition) to the active zones of the neighbors they
+//! overlap.  This is the reverse of the usual exchange: the ghost zones of a MB that are
+//! filled from neighbor n (recv "isame" indices) are packed and sent to n, which adds
+//! them to the active zones it would send to that MB (send "isame" indices).  Both cover
+//! the same cells in the same order, so the usual buffers and MPI messages are reused.
+//! Only neighbors at the same level are supported.
+
+#include <cstdlib>
+#include <iostream>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "mesh/mesh.hpp"
+#include "bvals.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBoundaryValuesCC::PackAndSendGhostSumCC()
+//! \brief Packs the ghost zones of all variables in a into boundary buffers and sends
+//! them to the neighbors whose active zones they overlap.
+
+TaskStatus MeshBoundaryValuesCC::PackAndSendGhostSumCC(DvceArray5D<Real> &a) {
+  int nnghbr = pmy_pack->pmb->nnghbr;
+  int nvar = a.extent_int(1);
+  int my_rank = global_variable::my_rank;
+  auto &nghbr = pmy_pack->pmb->nghbr;
+  auto &mbgid = pmy_pack->pmb->mb_gid;
+  auto &sbuf = sendbuf;
+  auto &rbuf = recvbuf;
+  // lease buffers from pool (if used)
+  AcquireBuffers();
+  CountSends(nvar);
+
+  BuildNeighborLevelLists();
+  auto &list = nlev_lists.same;
+  if (nlev_lists.nsame > 0) {
+  Kokkos::TeamPolicy<> policy(pmy_pack->exe_space, nlev_lists.nsame, Kokkos::AUTO);
+  Kokkos::parallel_for("SendGhostSum", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
+    const int m = (list.d_view(tmember.league_rank()))/nnghbr;
+    const int n = (list.d_view(tmember.league_rank()) - m*nnghbr);
+    // ghost zones of this MB filled by neighbor n
+    int il = rbuf[n].isame[0].bis;
+    int iu = rbuf[n].isame[0].bie;
+    int jl = rbuf[n].isame[0].bjs;
+    int ju = rbuf[n].isame[0].bje;
+    int kl = rbuf[n].isame[0].bks;
+    int ku = rbuf[n].isame[0].bke;
+    int ni = iu - il + 1;
+    int nj = ju - jl + 1;
+    int nk = ku - kl + 1;
+    int nkj  = nk*nj;
+
+    // copy directly into recv buffer if MeshBlocks on same rank, else into send buffer
+    bool same_rank = (nghbr.d_view(m,n).rank == my_rank);
+    int dm = (same_rank)? (nghbr.d_view(m,n).gid - mbgid.d_view(0)) : m;
+    const DvceArray2D<Real> &dbuf = (same_rank)? rbuf[nghbr.d_view(m,n).dest].vars :
+                                                 sbuf[n].vars;
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember, nvar*nkj),
+    [&](const int idx) {
+      int v = idx / nkj;
+      int k = (idx - v*nkj) / nj;
+      int j = (idx - v*nkj - k*nj) + jl;
+      k += kl;
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
+      [&](const int i) {
+        dbuf(dm, (i-il + ni*(j-jl + nj*(k-kl + nk*v))) ) = a(m,v,k,j,i);
+      });
+    });
+  });
+  }
+
+  return SendBuffersCC(nvar);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshBoundaryValuesCC::RecvAndSumGhostCC()
+//! \brief Adds the ghost-zone values received from each neighbor to the active zones
+//! of a that they overlap.  Regions of face, edge and corner buffers overlap in the
+//! active zones, so values are added atomically.
+
+TaskStatus MeshBoundaryValuesCC::RecvAndSumGhostCC(DvceArray5D<Real> &a) {
+  if (RecvBuffersCC() == TaskStatus::incomplete) {return TaskStatus::incomplete;}
+
+  int nnghbr = pmy_pack->pmb->nnghbr;
+  int nvar = a.extent_int(1);
+  auto &sbuf = sendbuf;
+  auto &rbuf = recvbuf;
+
+  BuildNeighborLevelLists();
+  auto &list = nlev_lists.same;
+  if (nlev_lists.nsame > 0) {
+  Kokkos::TeamPolicy<> policy(pmy_pack->exe_space, nlev_lists.nsame, Kokkos::AUTO);
+  Kokkos::parallel_for("RecvGhostSum", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
+    const int m = (list.d_view(tmember.league_rank()))/nnghbr;
+    const int n = (list.d_view(tmember.league_rank()) - m*nnghbr);
+    // active zones of this MB that overlap ghost zones of neighbor n
+    int il = sbuf[n].isame[0].bis;
+    int iu = sbuf[n].isame[0].bie;
+    int jl = sbuf[n].isame[0].bjs;
+    int ju = sbuf[n].isame[0].bje;
+    int kl = sbuf[n].isame[0].bks;
+    int ku = sbuf[n].isame[0].bke;
+    int ni = iu - il + 1;
+    int nj = ju - jl + 1;
+    int nk = ku - kl + 1;
+    int nkj  = nk*nj;
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember, nvar*nkj),
+    [&](const int idx) {
+      int v = idx / nkj;
+      int k = (idx - v*nkj) / nj;
+      int j = (idx - v*nkj - k*nj) + jl;
+      k += kl;
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(tmember,il,iu+1),
+      [&](const int i) {
+        Kokkos::atomic_add(&a(m,v,k,j,i),
+                           rbuf[n].vars(m, (i-il + ni*(j-jl + nj*(k-kl + nk*v)))));
+      });
+    });
+  });
+  }
+
+  // return buffers leased from pool (if used) once sends have also completed
+  bufs_unpacked_ = true;
+  ReleaseBuffers();
+  return TaskStatus::complete;
+}
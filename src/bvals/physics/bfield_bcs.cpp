@@ -28,14 +28,18 @@ void MeshBoundaryValues::BFieldBCs(MeshBlockPack *ppack, DualArray2D<Real> b_in,
   int n1 = indcs.nx1 + 2*ng;
   int n2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng) : 1;
   int n3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*ng) : 1;
-  int nmb = ppack->nmb_thispack;
+  // lists of MeshBlocks with physical BCs in each direction
+  auto &bc_mbs = ppack->pmb->bc_mbs;
+  auto &nbc_mbs = ppack->pmb->nbc_mbs;
 
   // only apply BCs if not periodic
-  if (pm->mesh_bcs[BoundaryFace::inner_x1] != BoundaryFlag::periodic) {
+  if (pm->mesh_bcs[BoundaryFace::inner_x1] != BoundaryFlag::periodic &&
+      ppack->pmb->physical_bcs[0]) {
     int &is = indcs.is;
     int &ie = indcs.ie;
-    par_for("bfield-bc_x1", DevExeSpace(), 0,(nmb-1),0,(n3-1),0,(n2-1),
-    KOKKOS_LAMBDA(int m, int k, int j) {
+    par_for("bfield-bc_x1", DevExeSpace(), 0,(nbc_mbs[0]-1),0,(n3-1),0,(n2-1),
+    KOKKOS_LAMBDA(int l, int k, int j) {
+      const int m = bc_mbs.d_view(0,l);
       // apply physical boundaries to inner_x1
       switch (mb_bcs.d_view(m,BoundaryFace::inner_x1)) {
         case BoundaryFlag::reflect:
@@ -118,11 +122,13 @@ void MeshBoundaryValues::BFieldBCs(MeshBlockPack *ppack, DualArray2D<Real> b_in,
   if (pm->one_d) return;
 
   // only apply BCs if not periodic
-  if (pm->mesh_bcs[BoundaryFace::inner_x2] != BoundaryFlag::periodic) {
+  if (pm->mesh_bcs[BoundaryFace::inner_x2] != BoundaryFlag::periodic &&
+      ppack->pmb->physical_bcs[1]) {
     int &js = indcs.js;
     int &je = indcs.je;
-    par_for("bfield-bc_x2", DevExeSpace(), 0,(nmb-1),0,(n3-1),0,(n1-1),
-    KOKKOS_LAMBDA(int m, int k, int i) {
+    par_for("bfield-bc_x2", DevExeSpace(), 0,(nbc_mbs[1]-1),0,(n3-1),0,(n1-1),
+    KOKKOS_LAMBDA(int l, int k, int i) {
+      const int m = bc_mbs.d_view(1,l);
       // apply physical boundaries to inner_x2
       switch (mb_bcs.d_view(m,BoundaryFace::inner_x2)) {
         case BoundaryFlag::reflect:
@@ -205,11 +211,13 @@ void MeshBoundaryValues::BFieldBCs(MeshBlockPack *ppack, DualArray2D<Real> b_in,
   if (pm->two_d) return;
 
   // only apply BCs if not periodic
-  if (pm->mesh_bcs[BoundaryFace::inner_x3] == BoundaryFlag::periodic) return;
+  if (pm->mesh_bcs[BoundaryFace::inner_x3] == BoundaryFlag::periodic ||
+      !(ppack->pmb->physical_bcs[2])) return;
   int &ks = indcs.ks;
   int &ke = indcs.ke;
-  par_for("bfield-bc_x3", DevExeSpace(), 0,(nmb-1),0,(n2-1),0,(n1-1),
-  KOKKOS_LAMBDA(int m, int j, int i) {
+  par_for("bfield-bc_x3", DevExeSpace(), 0,(nbc_mbs[2]-1),0,(n2-1),0,(n1-1),
+  KOKKOS_LAMBDA(int l, int j, int i) {
+    const int m = bc_mbs.d_view(2,l);
     // apply physical boundaries to inner_x3
     switch (mb_bcs.d_view(m,BoundaryFace::inner_x3)) {
       case BoundaryFlag::reflect:
@@ -15,13 +15,14 @@
 //----------------------------------------------------------------------------------------
 //! \!fn void BoundaryValues::RadiationBCs()
 //! \brief Apply physical boundary conditions for radiation at faces of MB which
-//! are at the edge of the computational domain
+//! are at the edge of the computational domain.  Cell indices of i0 are given by pindcs
+//! if it is not the grid of the MeshBlocks.
 
 void MeshBoundaryValues::RadiationBCs(MeshBlockPack *ppack, DualArray2D<Real> i_in,
-                                      DvceArray5D<Real> i0) {
+                                      DvceArray5D<Real> i0, const RegionIndcs *pindcs) {
   // loop over all MeshBlocks in this MeshBlockPack
   auto &pm = ppack->pmesh;
-  auto &indcs = ppack->pmesh->mb_indcs;
+  RegionIndcs indcs = (pindcs != nullptr)? *pindcs : ppack->pmesh->mb_indcs;
   int &ng = indcs.ng;
   auto &mb_bcs = ppack->pmb->mb_bcs;
 
@@ -29,14 +30,19 @@ void MeshBoundaryValues::RadiationBCs(MeshBlockPack *ppack, DualArray2D<Real> i_
   int n2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng) : 1;
   int n3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*ng) : 1;
   int nvar = i0.extent_int(1);  // TODO(@user): 2nd index from L of in array must be NVAR
-  int nmb = ppack->nmb_thispack;
+  // lists of MeshBlocks with physical BCs in each direction
+  auto &bc_mbs = ppack->pmb->bc_mbs;
+  auto &nbc_mbs = ppack->pmb->nbc_mbs;
 
   // only apply BCs if not periodic
-  if (pm->mesh_bcs[BoundaryFace::inner_x1] != BoundaryFlag::periodic) {
+  if (pm->mesh_bcs[BoundaryFace::inner_x1] != BoundaryFlag::periodic &&
+      ppack->pmb->physical_bcs[0]) {
     int &is = indcs.is;
     int &ie = indcs.ie;
-    par_for("radiationbc_x1", DevExeSpace(), 0,(nmb-1),0,(nvar-1),0,(n3-1),0,(n2-1),
-    KOKKOS_LAMBDA(int m, int n, int k, int j) {
+    par_for("radiationbc_x1", DevExeSpace(),
+            0,(nbc_mbs[0]-1),0,(nvar-1),0,(n3-1),0,(n2-1),
+    KOKKOS_LAMBDA(int l, int n, int k, int j) {
+      const int m = bc_mbs.d_view(0,l);
       // apply physical boundaries to inner_x1
       switch (mb_bcs.d_view(m,BoundaryFace::inner_x1)) {
         case BoundaryFlag::outflow:
@@ -73,11 +79,14 @@ void MeshBoundaryValues::RadiationBCs(MeshBlockPack *ppack, DualArray2D<Real> i_
   if (pm->one_d) return;
 
   // only apply BCs if not periodic
-  if (pm->mesh_bcs[BoundaryFace::inner_x2] != BoundaryFlag::periodic) {
+  if (pm->mesh_bcs[BoundaryFace::inner_x2] != BoundaryFlag::periodic &&
+      ppack->pmb->physical_bcs[1]) {
     int &js = indcs.js;
     int &je = indcs.je;
-    par_for("radiationbc_x2", DevExeSpace(), 0,(nmb-1),0,(nvar-1),0,(n3-1),0,(n1-1),
-    KOKKOS_LAMBDA(int m, int n, int k, int i) {
+    par_for("radiationbc_x2", DevExeSpace(),
+            0,(nbc_mbs[1]-1),0,(nvar-1),0,(n3-1),0,(n1-1),
+    KOKKOS_LAMBDA(int l, int n, int k, int i) {
+      const int m = bc_mbs.d_view(1,l);
       // apply physical boundaries to inner_x2
       switch (mb_bcs.d_view(m,BoundaryFace::inner_x2)) {
         case BoundaryFlag::outflow:
@@ -114,11 +123,13 @@ void MeshBoundaryValues::RadiationBCs(MeshBlockPack *ppack, DualArray2D<Real> i_
   if (pm->two_d) return;
 
   // only apply BCs if not periodic
-  if (pm->mesh_bcs[BoundaryFace::inner_x3] == BoundaryFlag::periodic) return;
+  if (pm->mesh_bcs[BoundaryFace::inner_x3] == BoundaryFlag::periodic ||
+      !(ppack->pmb->physical_bcs[2])) return;
   int &ks = indcs.ks;
   int &ke = indcs.ke;
-  par_for("radiationbc_x3", DevExeSpace(), 0,(nmb-1),0,(nvar-1),0,(n2-1),0,(n1-1),
-  KOKKOS_LAMBDA(int m, int n, int j, int i) {
+  par_for("radiationbc_x3", DevExeSpace(), 0,(nbc_mbs[2]-1),0,(nvar-1),0,(n2-1),0,(n1-1),
+  KOKKOS_LAMBDA(int l, int n, int j, int i) {
+    const int m = bc_mbs.d_view(2,l);
     // apply physical boundaries to inner_x3
     switch (mb_bcs.d_view(m,BoundaryFace::inner_x3)) {
       case BoundaryFlag::outflow:
@@ -101,7 +101,7 @@ void MeshBoundaryValues::Z4cBCs(MeshBlockPack *ppack, DualArray2D<Real> u_in,
       BCHelper<4>(ppack, u_in, u0, is, ie, js, je, ks, ke, n1, n2, n3);
       break;
   }
-  if (pm->multilevel) {
+  if (pm->multilevel && ppack->pmb->need_coarse) {
     int cn1 = indcs.cnx1 + 2*ng;
     int cn2 = (indcs.cnx2 > 1)? (indcs.cnx2 + 2*ng) : 1;
     int cn3 = (indcs.cnx3 > 1)? (indcs.cnx3 + 2*ng) : 1;
@@ -136,13 +136,17 @@ void BCHelper(MeshBlockPack *ppack, DualArray2D<Real> u_in, DvceArray5D<Real> u0
   auto &mb_bcs = ppack->pmb->mb_bcs;
 
   int nvar = u0.extent_int(1);  // TODO(@user): 2nd index from L of in array must be NVAR
-  int nmb = ppack->nmb_thispack;
+  // lists of MeshBlocks with physical BCs in each direction
+  auto &bc_mbs = ppack->pmb->bc_mbs;
+  auto &nbc_mbs = ppack->pmb->nbc_mbs;
 
   // only apply BCs unless periodic or shear_periodic
   if (pm->mesh_bcs[BoundaryFace::inner_x1] != BoundaryFlag::periodic
-      && pm->mesh_bcs[BoundaryFace::inner_x1] != BoundaryFlag::shear_periodic) {
-    par_for("z4cbc_x1", DevExeSpace(), 0,(nmb-1),0,(nvar-1),0,(n3-1),0,(n2-1),
-    KOKKOS_LAMBDA(int m, int n, int k, int j) {
+      && pm->mesh_bcs[BoundaryFace::inner_x1] != BoundaryFlag::shear_periodic
+      && ppack->pmb->physical_bcs[0]) {
+    par_for("z4cbc_x1", DevExeSpace(), 0,(nbc_mbs[0]-1),0,(nvar-1),0,(n3-1),0,(n2-1),
+    KOKKOS_LAMBDA(int l, int n, int k, int j) {
+      const int m = bc_mbs.d_view(0,l);
       // apply physical boundaries to inner_x1
       switch (mb_bcs.d_view(m,BoundaryFace::inner_x1)) {
         case BoundaryFlag::reflect:
@@ -208,9 +212,11 @@ void BCHelper(MeshBlockPack *ppack, DualArray2D<Real> u_in, DvceArray5D<Real> u0
   if (pm->one_d) return;
 
   // only apply BCs if not periodic
-  if (pm->mesh_bcs[BoundaryFace::inner_x2] != BoundaryFlag::periodic) {
-    par_for("z4cbc_x2", DevExeSpace(), 0,(nmb-1),0,(nvar-1),0,(n3-1),0,(n1-1),
-    KOKKOS_LAMBDA(int m, int n, int k, int i) {
+  if (pm->mesh_bcs[BoundaryFace::inner_x2] != BoundaryFlag::periodic &&
+      ppack->pmb->physical_bcs[1]) {
+    par_for("z4cbc_x2", DevExeSpace(), 0,(nbc_mbs[1]-1),0,(nvar-1),0,(n3-1),0,(n1-1),
+    KOKKOS_LAMBDA(int l, int n, int k, int i) {
+      const int m = bc_mbs.d_view(1,l);
       // apply physical boundaries to inner_x2
       switch (mb_bcs.d_view(m,BoundaryFace::inner_x2)) {
         case BoundaryFlag::reflect:
@@ -275,9 +281,11 @@ void BCHelper(MeshBlockPack *ppack, DualArray2D<Real> u_in, DvceArray5D<Real> u0
   if (pm->two_d) return;
 
   // only apply BCs if not periodic
-  if (pm->mesh_bcs[BoundaryFace::inner_x3] == BoundaryFlag::periodic) return;
-  par_for("z4cbc_x3", DevExeSpace(), 0,(nmb-1),0,(nvar-1),0,(n2-1),0,(n1-1),
-  KOKKOS_LAMBDA(int m, int n, int j, int i) {
+  if (pm->mesh_bcs[BoundaryFace::inner_x3] == BoundaryFlag::periodic ||
+      !(ppack->pmb->physical_bcs[2])) return;
+  par_for("z4cbc_x3", DevExeSpace(), 0,(nbc_mbs[2]-1),0,(nvar-1),0,(n2-1),0,(n1-1),
+  KOKKOS_LAMBDA(int l, int n, int j, int i) {
+    const int m = bc_mbs.d_view(2,l);
     // apply physical boundaries to inner_x3
     switch (mb_bcs.d_view(m,BoundaryFace::inner_x3)) {
       case BoundaryFlag::reflect:
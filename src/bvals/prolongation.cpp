@@ -20,6 +20,7 @@
 #include "mesh/restriction.hpp" // implements restriction operators
 
 #include "coordinates/cell_locations.hpp"
+
 //----------------------------------------------------------------------------------------
 //! \fn void FillCoarseInBndryCC()
 //! \brief To ensure that the coarse array is up-to-date in all neighboring cells touched
@@ -29,15 +30,17 @@
 void MeshBoundaryValuesCC::FillCoarseInBndryCC(DvceArray5D<Real> &a,
                                                DvceArray5D<Real> &ca,
                                                bool is_z4c) {
+  // only buffers with a neighbor at the same level are restricted
+  BuildNeighborLevelLists();
+  if (nlev_lists.nsame == 0) return;
+
   // create local references for variables in kernel
-  int nmb = pmy_pack->nmb_thispack;
   int nnghbr = pmy_pack->pmb->nnghbr;
   //bool not_z4c = (pmbp->pz4c == nullptr)? true : false;
 
   int nvar = a.extent_int(1);  // TODO(@user): 2nd index from L of in array must be NVAR
-  int nmnv = nmb*nnghbr*nvar;
-  auto &nghbr = pmy_pack->pmb->nghbr;
-  auto &mblev = pmy_pack->pmb->mb_lev;
+  int nlnv = nlev_lists.nsame*nvar;
+  auto &list = nlev_lists.same;
   auto &rbuf = recvbuf;
   auto &indcs  = pmy_pack->pmesh->mb_indcs;
   const bool multi_d = pmy_pack->pmesh->multi_d;
@@ -58,69 +61,67 @@ void MeshBoundaryValuesCC::FillCoarseInBndryCC(DvceArray5D<Real> &a,
     auto &cis = indcs.cis;
     auto &cjs = indcs.cjs;
     auto &cks = indcs.cks;
-    // Outer loop over (# of MeshBlocks)*(# of buffers)*(# of variables)
-    Kokkos::TeamPolicy<> policy(DevExeSpace(), nmnv, Kokkos::AUTO);
+    // Outer loop over (# of buffers with neighbor at SAME level)*(# of variables)
+    Kokkos::TeamPolicy<> policy(DevExeSpace(), nlnv, Kokkos::AUTO);
     Kokkos::parallel_for("ProlCCSame", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
-      const int m = (tmember.league_rank())/(nnghbr*nvar);
-      const int n = (tmember.league_rank() - m*(nnghbr*nvar))/nvar;
-      const int v = (tmember.league_rank() - m*(nnghbr*nvar) - n*nvar);
-
-      // only restrict when neighbor exists and is at SAME level
-      if ((nghbr.d_view(m,n).gid >= 0) && (nghbr.d_view(m,n).lev == mblev.d_view(m))) {
-        // loop over indices for receives at same level, but convert loop limits to
-        // coarse array
-        int il = (rbuf[n].isame[0].bis + cis)/2;
-        int iu = (rbuf[n].isame[0].bie + cis)/2;
-        int jl = (rbuf[n].isame[0].bjs + cjs)/2;
-        int ju = (rbuf[n].isame[0].bje + cjs)/2;
-        int kl = (rbuf[n].isame[0].bks + cks)/2;
-        int ku = (rbuf[n].isame[0].bke + cks)/2;
-
-        const int ni = iu - il + 1;
-        const int nj = ju - jl + 1;
-        const int nk = ku - kl + 1;
-        const int nkji = nk*nj*ni;
-        const int nji  = nj*ni;
-
-        // Middle loop over k,j,i
-        Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember, nkji),[&](const int idx) {
-          int k = idx/nji;
-          int j = (idx - k*nji)/ni;
-          int i = (idx - k*nji - j*ni) + il;
-          j += jl;
-          k += kl;
-
-          // indices refer to coarse array.  So must compute indices for fine array
-          int finei = (i - indcs.cis)*2 + indcs.is;
-          int finej = (j - indcs.cjs)*2 + indcs.js;
-          int finek = (k - indcs.cks)*2 + indcs.ks;
-
-          // restrict in 2D
-          if (!(three_d)) {
-            ca(m,v,kl,j,i) = 0.25*(a(m,v,kl,finej  ,finei) + a(m,v,kl,finej  ,finei+1)
-                                 + a(m,v,kl,finej+1,finei) + a(m,v,kl,finej+1,finei+1));
-          // restrict in 3D
+      const int l = (tmember.league_rank())/nvar;
+      const int v = (tmember.league_rank() - l*nvar);
+      const int m = (list.d_view(l))/nnghbr;
+      const int n = (list.d_view(l) - m*nnghbr);
+
+      // loop over indices for receives at same level, but convert loop limits to
+      // coarse array
+      int il = (rbuf[n].isame[0].bis + cis)/2;
+      int iu = (rbuf[n].isame[0].bie + cis)/2;
+      int jl = (rbuf[n].isame[0].bjs + cjs)/2;
+      int ju = (rbuf[n].isame[0].bje + cjs)/2;
+      int kl = (rbuf[n].isame[0].bks + cks)/2;
+      int ku = (rbuf[n].isame[0].bke + cks)/2;
+
+      const int ni = iu - il + 1;
+      const int nj = ju - jl + 1;
+      const int nk = ku - kl + 1;
+      const int nkji = nk*nj*ni;
+      const int nji  = nj*ni;
+
+      // Middle loop over k,j,i
+      Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember, nkji),[&](const int idx) {
+        int k = idx/nji;
+        int j = (idx - k*nji)/ni;
+        int i = (idx - k*nji - j*ni) + il;
+        j += jl;
+        k += kl;
+
+        // indices refer to coarse array.  So must compute indices for fine array
+        int finei = (i - indcs.cis)*2 + indcs.is;
+        int finej = (j - indcs.cjs)*2 + indcs.js;
+        int finek = (k - indcs.cks)*2 + indcs.ks;
+
+        // restrict in 2D
+        if (!(three_d)) {
+          ca(m,v,kl,j,i) = 0.25*(a(m,v,kl,finej  ,finei) + a(m,v,kl,finej  ,finei+1)
+                               + a(m,v,kl,finej+1,finei) + a(m,v,kl,finej+1,finei+1));
+        // restrict in 3D
+        } else {
+          if (!is_z4c) {
+            ca(m,v,k,j,i) = 0.125*(
+                a(m,v,finek  ,finej  ,finei) + a(m,v,finek  ,finej  ,finei+1)
+              + a(m,v,finek  ,finej+1,finei) + a(m,v,finek  ,finej+1,finei+1)
+              + a(m,v,finek+1,finej,  finei) + a(m,v,finek+1,finej,  finei+1)
+              + a(m,v,finek+1,finej+1,finei) + a(m,v,finek+1,finej+1,finei+1));
           } else {
-            if (!is_z4c) {
-              ca(m,v,k,j,i) = 0.125*(
-                  a(m,v,finek  ,finej  ,finei) + a(m,v,finek  ,finej  ,finei+1)
-                + a(m,v,finek  ,finej+1,finei) + a(m,v,finek  ,finej+1,finei+1)
-                + a(m,v,finek+1,finej,  finei) + a(m,v,finek+1,finej,  finei+1)
-                + a(m,v,finek+1,finej+1,finei) + a(m,v,finek+1,finej+1,finei+1));
-            } else {
-                switch (indcs.ng) {
-                  case 2: ca(m,v,k,j,i) = RestrictInterpolation<2>(m,v,finek,finej,finei,
-                              nx1,nx2,nx3,a,restrict_2nd,restrict_4th,restrict_4th_edge);
-                          break;
-                  case 4: ca(m,v,k,j,i) = RestrictInterpolation<4>(m,v,finek,finej,finei,
-                              nx1,nx2,nx3,a,restrict_2nd,restrict_4th,restrict_4th_edge);
-                          break;
-                }
-            }
+              switch (indcs.ng) {
+                case 2: ca(m,v,k,j,i) = RestrictInterpolation<2>(m,v,finek,finej,finei,
+                            nx1,nx2,nx3,a,restrict_2nd,restrict_4th,restrict_4th_edge);
+                        break;
+                case 4: ca(m,v,k,j,i) = RestrictInterpolation<4>(m,v,finek,finej,finei,
+                            nx1,nx2,nx3,a,restrict_2nd,restrict_4th,restrict_4th_edge);
+                        break;
+              }
           }
-        });
-        tmember.team_barrier();
-      }
+        }
+      });
+      tmember.team_barrier();
     });
   }
   return;
@@ -133,17 +134,19 @@ void MeshBoundaryValuesCC::FillCoarseInBndryCC(DvceArray5D<Real> &a,
 
 void MeshBoundaryValuesCC::ProlongateCC(DvceArray5D<Real> &a, DvceArray5D<Real> &ca,
     bool is_z4c) {
+  // only buffers with a neighbor at a coarser level are prolongated
+  BuildNeighborLevelLists();
+  if (nlev_lists.ncoar == 0) return;
+
   // create local references for variables in kernel
-  int nmb = pmy_pack->nmb_thispack;
   int nnghbr = pmy_pack->pmb->nnghbr;
 
   // ptr to z4c, which requires different prolongation/restriction scheme
   //bool not_z4c = (pmbp->pz4c == nullptr)? true : false;
 
   int nvar = a.extent_int(1);  // TODO(@user): 2nd index from L of in array must be NVAR
-  int nmnv = nmb*nnghbr*nvar;
-  auto &nghbr = pmy_pack->pmb->nghbr;
-  auto &mblev = pmy_pack->pmb->mb_lev;
+  int nlnv = nlev_lists.ncoar*nvar;
+  auto &list = nlev_lists.coar;
   auto &rbuf = recvbuf;
   auto &indcs  = pmy_pack->pmesh->mb_indcs;
   const bool multi_d = pmy_pack->pmesh->multi_d;
@@ -154,57 +157,55 @@ void MeshBoundaryValuesCC::ProlongateCC(DvceArray5D<Real> &a, DvceArray5D<Real>
   auto& prolong_2nd = pmy_pack->pmesh->pmr->weights.prolong_2nd;
   auto& prolong_4th = pmy_pack->pmesh->pmr->weights.prolong_4th;
 
-  // Outer loop over (# of MeshBlocks)*(# of buffers)*(# of variables)
-  Kokkos::TeamPolicy<> policy(DevExeSpace(), nmnv, Kokkos::AUTO);
+  // Outer loop over (# of buffers with neighbor at coarser level)*(# of variables)
+  Kokkos::TeamPolicy<> policy(DevExeSpace(), nlnv, Kokkos::AUTO);
   Kokkos::parallel_for("ProlCC", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
-    const int m = (tmember.league_rank())/(nnghbr*nvar);
-    const int n = (tmember.league_rank() - m*(nnghbr*nvar))/nvar;
-    const int v = (tmember.league_rank() - m*(nnghbr*nvar) - n*nvar);
-
-    // only prolongate when neighbor exists and is at coarser level
-    if ((nghbr.d_view(m,n).gid >= 0) && (nghbr.d_view(m,n).lev < mblev.d_view(m))) {
-      // loop over indices for prolongation on this buffer
-      int il = rbuf[n].iprol[0].bis;
-      int iu = rbuf[n].iprol[0].bie;
-      int jl = rbuf[n].iprol[0].bjs;
-      int ju = rbuf[n].iprol[0].bje;
-      int kl = rbuf[n].iprol[0].bks;
-      int ku = rbuf[n].iprol[0].bke;
-      const int ni = iu - il + 1;
-      const int nj = ju - jl + 1;
-      const int nk = ku - kl + 1;
-      const int nkji = nk*nj*ni;
-      const int nji  = nj*ni;
-
-      // Middle loop over k,j,i
-      Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember, nkji), [&](const int idx) {
-        int k = idx/nji;
-        int j = (idx - k*nji)/ni;
-        int i = (idx - k*nji - j*ni) + il;
-        j += jl;
-        k += kl;
-
-        // indices for prolongation refer to coarse array.  So must compute
-        // indices for fine array
-        int fi = (i - indcs.cis)*2 + indcs.is;
-        int fj = (j - indcs.cjs)*2 + indcs.js;
-        int fk = (k - indcs.cks)*2 + indcs.ks;
-        // call inlined prolongation operator for CC variables
-        if (!is_z4c) {
-          ProlongCC(m,v,k,j,i,fk,fj,fi,multi_d,three_d,ca,a);
-        } else {
-          switch (indcs.ng) {
-            case 2: HighOrderProlongCC<2>(m,v,k,j,i,fk,fj,fi,nx1,nx2,nx3,
-                                          ca,a,prolong_2nd);
-                    break;
-            case 4: HighOrderProlongCC<4>(m,v,k,j,i,fk,fj,fi,nx1,nx2,nx3,
-                                          ca,a,prolong_4th);
-                    break;
-          }
+    const int l = (tmember.league_rank())/nvar;
+    const int v = (tmember.league_rank() - l*nvar);
+    const int m = (list.d_view(l))/nnghbr;
+    const int n = (list.d_view(l) - m*nnghbr);
+
+    // loop over indices for prolongation on this buffer
+    int il = rbuf[n].iprol[0].bis;
+    int iu = rbuf[n].iprol[0].bie;
+    int jl = rbuf[n].iprol[0].bjs;
+    int ju = rbuf[n].iprol[0].bje;
+    int kl = rbuf[n].iprol[0].bks;
+    int ku = rbuf[n].iprol[0].bke;
+    const int ni = iu - il + 1;
+    const int nj = ju - jl + 1;
+    const int nk = ku - kl + 1;
+    const int nkji = nk*nj*ni;
+    const int nji  = nj*ni;
+
+    // Middle loop over k,j,i
+    Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember, nkji), [&](const int idx) {
+      int k = idx/nji;
+      int j = (idx - k*nji)/ni;
+      int i = (idx - k*nji - j*ni) + il;
+      j += jl;
+      k += kl;
+
+      // indices for prolongation refer to coarse array.  So must compute
+      // indices for fine array
+      int fi = (i - indcs.cis)*2 + indcs.is;
+      int fj = (j - indcs.cjs)*2 + indcs.js;
+      int fk = (k - indcs.cks)*2 + indcs.ks;
+      // call inlined prolongation operator for CC variables
+      if (!is_z4c) {
+        ProlongCC(m,v,k,j,i,fk,fj,fi,multi_d,three_d,ca,a);
+      } else {
+        switch (indcs.ng) {
+          case 2: HighOrderProlongCC<2>(m,v,k,j,i,fk,fj,fi,nx1,nx2,nx3,
+                                        ca,a,prolong_2nd);
+                  break;
+          case 4: HighOrderProlongCC<4>(m,v,k,j,i,fk,fj,fi,nx1,nx2,nx3,
+                                        ca,a,prolong_4th);
+                  break;
         }
-      });
-      tmember.team_barrier();
-    }
+      }
+    });
+    tmember.team_barrier();
   });
   return;
 }
@@ -218,13 +219,14 @@ void MeshBoundaryValuesCC::ProlongateCC(DvceArray5D<Real> &a, DvceArray5D<Real>
 
 void MeshBoundaryValuesFC::FillCoarseInBndryFC(DvceFaceFld4D<Real> &b,
                                            DvceFaceFld4D<Real> &cb) {
+  // only buffers with a neighbor at the same level are restricted
+  BuildNeighborLevelLists();
+  if (nlev_lists.nsame == 0) return;
+
   // create local references for variables in kernel
-  int nmb = pmy_pack->nmb_thispack;
   int nnghbr = pmy_pack->pmb->nnghbr;
 
-  auto &nghbr = pmy_pack->pmb->nghbr;
   auto &indcs  = pmy_pack->pmesh->mb_indcs;
-  auto &mblev = pmy_pack->pmb->mb_lev;
   bool &multi_d = pmy_pack->pmesh->multi_d;
   bool &three_d = pmy_pack->pmesh->three_d;
 
@@ -232,77 +234,76 @@ void MeshBoundaryValuesFC::FillCoarseInBndryFC(DvceFaceFld4D<Real> &b,
   // level. (Only needed in multidimensions)
 
   if (multi_d) {
-    int nmnv = 3*nmb*nnghbr;
+    int nlnv = 3*nlev_lists.nsame;
+    auto &list = nlev_lists.same;
     auto &rbuf = recvbuf;
     auto &cis = indcs.cis;
     auto &cjs = indcs.cjs;
     auto &cks = indcs.cks;
-    // Outer loop over (# of MeshBlocks)*(# of buffers)*(# of variables)
-    Kokkos::TeamPolicy<> policy(DevExeSpace(), nmnv, Kokkos::AUTO);
+    // Outer loop over (# of buffers with neighbor at SAME level)*(three field components)
+    Kokkos::TeamPolicy<> policy(DevExeSpace(), nlnv, Kokkos::AUTO);
     Kokkos::parallel_for("ProlFCSame", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
-      const int m = (tmember.league_rank())/(3*nnghbr);
-      const int n = (tmember.league_rank() - m*(3*nnghbr))/3;
-      const int v = (tmember.league_rank() - m*(3*nnghbr) - 3*n);
-
-      // only restrict when neighbor exists and is at SAME level
-      if ((nghbr.d_view(m,n).gid >= 0) && (nghbr.d_view(m,n).lev == mblev.d_view(m))) {
-        // loop over indices for receives at same level, but convert loop limits to
-        // coarse array
-        int il = (rbuf[n].isame[v].bis + cis)/2;
-        int iu = (rbuf[n].isame[v].bie + cis)/2;
-        int jl = (rbuf[n].isame[v].bjs + cjs)/2;
-        int ju = (rbuf[n].isame[v].bje + cjs)/2;
-        int kl = (rbuf[n].isame[v].bks + cks)/2;
-        int ku = (rbuf[n].isame[v].bke + cks)/2;
-
-        const int ni = iu - il + 1;
-        const int nj = ju - jl + 1;
-        const int nk = ku - kl + 1;
-        const int nkji = nk*nj*ni;
-        const int nji  = nj*ni;
-
-        // Middle loop over k,j,i
-        Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember, nkji),[&](const int idx) {
-          int k = idx/nji;
-          int j = (idx - k*nji)/ni;
-          int i = (idx - k*nji - j*ni) + il;
-          j += jl;
-          k += kl;
-
-          // indices refer to coarse array.  So must compute indices for fine array
-          int fk = (k - indcs.cks)*2 + indcs.ks;
-          int fj = (j - indcs.cjs)*2 + indcs.js;
-          int fi = (i - indcs.cis)*2 + indcs.is;
-
-          // restrict in 2D
-          if (!(three_d)) {
-            if (v==0) {
-              cb.x1f(m,kl,j,i) = 0.5*(b.x1f(m,kl,fj,fi) + b.x1f(m,kl,fj+1,fi));
-            } else if (v==1) {
-              cb.x2f(m,kl,j,i) = 0.5*(b.x2f(m,kl,fj,fi) + b.x2f(m,kl,fj,fi+1));
-            } else {
-              Real b3c = 0.25*(b.x3f(m,kl,fj  ,fi) + b.x3f(m,kl,fj  ,fi+1)
-                             + b.x3f(m,kl,fj+1,fi) + b.x3f(m,kl,fj+1,fi+1));
-              cb.x3f(m,kl  ,j,i) = b3c;
-              cb.x3f(m,kl+1,j,i) = b3c;
-            }
-
-          // restrict in 3D
+      const int l = (tmember.league_rank())/3;
+      const int v = (tmember.league_rank() - 3*l);
+      const int m = (list.d_view(l))/nnghbr;
+      const int n = (list.d_view(l) - m*nnghbr);
+
+      // loop over indices for receives at same level, but convert loop limits to
+      // coarse array
+      int il = (rbuf[n].isame[v].bis + cis)/2;
+      int iu = (rbuf[n].isame[v].bie + cis)/2;
+      int jl = (rbuf[n].isame[v].bjs + cjs)/2;
+      int ju = (rbuf[n].isame[v].bje + cjs)/2;
+      int kl = (rbuf[n].isame[v].bks + cks)/2;
+      int ku = (rbuf[n].isame[v].bke + cks)/2;
+
+      const int ni = iu - il + 1;
+      const int nj = ju - jl + 1;
+      const int nk = ku - kl + 1;
+      const int nkji = nk*nj*ni;
+      const int nji  = nj*ni;
+
+      // Middle loop over k,j,i
+      Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember, nkji),[&](const int idx) {
+        int k = idx/nji;
+        int j = (idx - k*nji)/ni;
+        int i = (idx - k*nji - j*ni) + il;
+        j += jl;
+        k += kl;
+
+        // indices refer to coarse array.  So must compute indices for fine array
+        int fk = (k - indcs.cks)*2 + indcs.ks;
+        int fj = (j - indcs.cjs)*2 + indcs.js;
+        int fi = (i - indcs.cis)*2 + indcs.is;
+
+        // restrict in 2D
+        if (!(three_d)) {
+          if (v==0) {
+            cb.x1f(m,kl,j,i) = 0.5*(b.x1f(m,kl,fj,fi) + b.x1f(m,kl,fj+1,fi));
+          } else if (v==1) {
+            cb.x2f(m,kl,j,i) = 0.5*(b.x2f(m,kl,fj,fi) + b.x2f(m,kl,fj,fi+1));
           } else {
-            if (v==0) {
-              cb.x1f(m,k,j,i) = 0.25*(b.x1f(m,fk  ,fj,fi) + b.x1f(m,fk  ,fj+1,fi)
-                                    + b.x1f(m,fk+1,fj,fi) + b.x1f(m,fk+1,fj+1,fi));
-            } else if (v==1) {
-              cb.x2f(m,k,j,i) = 0.25*(b.x2f(m,fk  ,fj,fi) + b.x2f(m,fk  ,fj,fi+1)
-                                    + b.x2f(m,fk+1,fj,fi) + b.x2f(m,fk+1,fj,fi+1));
-            } else {
-              cb.x3f(m,k,j,i) = 0.25*(b.x3f(m,fk,fj  ,fi) + b.x3f(m,fk,fj  ,fi+1)
-                                    + b.x3f(m,fk,fj+1,fi) + b.x3f(m,fk,fj+1,fi+1));
-            }
+            Real b3c = 0.25*(b.x3f(m,kl,fj  ,fi) + b.x3f(m,kl,fj  ,fi+1)
+                           + b.x3f(m,kl,fj+1,fi) + b.x3f(m,kl,fj+1,fi+1));
+            cb.x3f(m,kl  ,j,i) = b3c;
+            cb.x3f(m,kl+1,j,i) = b3c;
           }
-        });
-        tmember.team_barrier();
-      }
+
+        // restrict in 3D
+        } else {
+          if (v==0) {
+            cb.x1f(m,k,j,i) = 0.25*(b.x1f(m,fk  ,fj,fi) + b.x1f(m,fk  ,fj+1,fi)
+                                  + b.x1f(m,fk+1,fj,fi) + b.x1f(m,fk+1,fj+1,fi));
+          } else if (v==1) {
+            cb.x2f(m,k,j,i) = 0.25*(b.x2f(m,fk  ,fj,fi) + b.x2f(m,fk  ,fj,fi+1)
+                                  + b.x2f(m,fk+1,fj,fi) + b.x2f(m,fk+1,fj,fi+1));
+          } else {
+            cb.x3f(m,k,j,i) = 0.25*(b.x3f(m,fk,fj  ,fi) + b.x3f(m,fk,fj  ,fi+1)
+                                  + b.x3f(m,fk,fj+1,fi) + b.x3f(m,fk,fj+1,fi+1));
+          }
+        }
+      });
+      tmember.team_barrier();
     });
   }
   return;
@@ -313,13 +314,15 @@ void MeshBoundaryValuesFC::FillCoarseInBndryFC(DvceFaceFld4D<Real> &b,
 //! \brief Prolongate data at boundaries for face-centered data (e.g. magnetic fields).
 
 void MeshBoundaryValuesFC::ProlongateFC(DvceFaceFld4D<Real> &b, DvceFaceFld4D<Real> &cb) {
+  // only buffers with a neighbor at a coarser level are prolongated
+  BuildNeighborLevelLists();
+  if (nlev_lists.ncoar == 0) return;
+
   // create local references for variables in kernel
-  int nmb = pmy_pack->nmb_thispack;
   int nnghbr = pmy_pack->pmb->nnghbr;
+  auto &list = nlev_lists.coar;
 
-  auto &nghbr = pmy_pack->pmb->nghbr;
   auto &indcs  = pmy_pack->pmesh->mb_indcs;
-  auto &mblev = pmy_pack->pmb->mb_lev;
   bool &multi_d = pmy_pack->pmesh->multi_d;
   bool &three_d = pmy_pack->pmesh->three_d;
 
@@ -327,53 +330,51 @@ void MeshBoundaryValuesFC::ProlongateFC(DvceFaceFld4D<Real> &b, DvceFaceFld4D<Re
   // Code here is based on MeshRefinement::ProlongateSharedFieldX1/2/3() and
   // MeshRefinement::ProlongateInternalField() in C++ version
 
-  // Outer loop over (# of MeshBlocks)*(# of buffers)*(three field components)
-  {int nmnv = 3*nmb*nnghbr;
+  // Outer loop over (# of buffers with neighbor at coarser level)*(three components)
+  {int nlnv = 3*nlev_lists.ncoar;
   auto &rbuf = recvbuf;
-  Kokkos::TeamPolicy<> policy(DevExeSpace(), nmnv, Kokkos::AUTO);
+  Kokkos::TeamPolicy<> policy(DevExeSpace(), nlnv, Kokkos::AUTO);
   Kokkos::parallel_for("ProFC-2d-shared", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
-    const int m = (tmember.league_rank())/(3*nnghbr);
-    const int n = (tmember.league_rank() - m*(3*nnghbr))/3;
-    const int v = (tmember.league_rank() - m*(3*nnghbr) - 3*n);
-
-    // only prolongate when neighbor exists and is at coarser level
-    if ((nghbr.d_view(m,n).gid >= 0) && (nghbr.d_view(m,n).lev < mblev.d_view(m))) {
-      int il = rbuf[n].iprol[v].bis;
-      int iu = rbuf[n].iprol[v].bie;
-      int jl = rbuf[n].iprol[v].bjs;
-      int ju = rbuf[n].iprol[v].bje;
-      int kl = rbuf[n].iprol[v].bks;
-      int ku = rbuf[n].iprol[v].bke;
-      const int ni = iu - il + 1;
-      const int nj = ju - jl + 1;
-      const int nk = ku - kl + 1;
-      const int nkji = nk*nj*ni;
-      const int nji  = nj*ni;
-
-      // Middle loop over k,j,i
-      Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember,nkji),[&](const int idx) {
-        int k = idx/nji;
-        int j = (idx - k*nji)/ni;
-        int i = (idx - k*nji - j*ni) + il;
-        j += jl;
-        k += kl;
-
-        int fi = (i - indcs.cis)*2 + indcs.is;                   // fine i
-        int fj = (multi_d)? ((j - indcs.cjs)*2 + indcs.js) : j;  // fine j
-        int fk = (three_d)? ((k - indcs.cks)*2 + indcs.ks) : k;  // fine k
-
-        // Prolongate face-centered fields at shared faces betwen fine and coarse cells
-        // by calling inlined prolongation operator for FC variables
-        if (v==0) {
-          ProlongFCSharedX1Face(m,k,j,i,fk,fj,fi,multi_d,three_d,cb.x1f,b.x1f);
-        } else if (v==1) {
-          ProlongFCSharedX2Face(m,k,j,i,fk,fj,fi,three_d,cb.x2f,b.x2f);
-        } else {
-          ProlongFCSharedX3Face(m,k,j,i,fk,fj,fi,multi_d,cb.x3f,b.x3f);
-        }
-      });
-      tmember.team_barrier();
-    }
+    const int l = (tmember.league_rank())/3;
+    const int v = (tmember.league_rank() - 3*l);
+    const int m = (list.d_view(l))/nnghbr;
+    const int n = (list.d_view(l) - m*nnghbr);
+
+    int il = rbuf[n].iprol[v].bis;
+    int iu = rbuf[n].iprol[v].bie;
+    int jl = rbuf[n].iprol[v].bjs;
+    int ju = rbuf[n].iprol[v].bje;
+    int kl = rbuf[n].iprol[v].bks;
+    int ku = rbuf[n].iprol[v].bke;
+    const int ni = iu - il + 1;
+    const int nj = ju - jl + 1;
+    const int nk = ku - kl + 1;
+    const int nkji = nk*nj*ni;
+    const int nji  = nj*ni;
+
+    // Middle loop over k,j,i
+    Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember,nkji),[&](const int idx) {
+      int k = idx/nji;
+      int j = (idx - k*nji)/ni;
+      int i = (idx - k*nji - j*ni) + il;
+      j += jl;
+      k += kl;
+
+      int fi = (i - indcs.cis)*2 + indcs.is;                   // fine i
+      int fj = (multi_d)? ((j - indcs.cjs)*2 + indcs.js) : j;  // fine j
+      int fk = (three_d)? ((k - indcs.cks)*2 + indcs.ks) : k;  // fine k
+
+      // Prolongate face-centered fields at shared faces betwen fine and coarse cells
+      // by calling inlined prolongation operator for FC variables
+      if (v==0) {
+        ProlongFCSharedX1Face(m,k,j,i,fk,fj,fi,multi_d,three_d,cb.x1f,b.x1f);
+      } else if (v==1) {
+        ProlongFCSharedX2Face(m,k,j,i,fk,fj,fi,three_d,cb.x2f,b.x2f);
+      } else {
+        ProlongFCSharedX3Face(m,k,j,i,fk,fj,fi,multi_d,cb.x3f,b.x3f);
+      }
+    });
+    tmember.team_barrier();
   });}
 
   // Now prolongate b.x1f/b.x2f/b.x3f at interior fine cells using the 2nd-order
@@ -381,52 +382,49 @@ void MeshBoundaryValuesFC::ProlongateFC(DvceFaceFld4D<Real> &b, DvceFaceFld4D<Re
   // Note prolongation at shared coarse/fine cell edges must be completed first as
   // interpolation formulae use these values.
 
-  // Outer loop over (# of MeshBlocks)*(# of buffers)
-  {int nmn = nmb*nnghbr;
+  // Outer loop over (# of buffers with neighbor at coarser level)
+  {int nl = nlev_lists.ncoar;
   bool &one_d = pmy_pack->pmesh->one_d;
   auto &rbuf = recvbuf;
-  Kokkos::TeamPolicy<> policy(DevExeSpace(), nmn, Kokkos::AUTO);
+  Kokkos::TeamPolicy<> policy(DevExeSpace(), nl, Kokkos::AUTO);
   Kokkos::parallel_for("ProFC-2d-int", policy, KOKKOS_LAMBDA(TeamMember_t tmember) {
-    const int m = (tmember.league_rank())/(nnghbr);
-    const int n = (tmember.league_rank() - m*(nnghbr));
-
-    // only prolongate when neighbor exists and is at coarser level
-    if ((nghbr.d_view(m,n).gid >= 0) && (nghbr.d_view(m,n).lev < mblev.d_view(m))) {
-      // use prolongation indices of different field components for interior fine cells
-      int il = rbuf[n].iprol[2].bis;
-      int iu = rbuf[n].iprol[2].bie;
-      int jl = rbuf[n].iprol[0].bjs;
-      int ju = rbuf[n].iprol[0].bje;
-      int kl = rbuf[n].iprol[1].bks;
-      int ku = rbuf[n].iprol[1].bke;
-      const int ni = iu - il + 1;
-      const int nj = ju - jl + 1;
-      const int nk = ku - kl + 1;
-      const int nkji = nk*nj*ni;
-      const int nji  = nj*ni;
-
-      // Middle loop over k,j,i
-      Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember,nkji),[&](const int idx) {
-        int k = idx/nji;
-        int j = (idx - k*nji)/ni;
-        int i = (idx - k*nji - j*ni) + il;
-        j += jl;
-        k += kl;
-
-        int fi = (i - indcs.cis)*2 + indcs.is;   // fine i
-        int fj = (j - indcs.cjs)*2 + indcs.js;   // fine j
-        int fk = (k - indcs.cks)*2 + indcs.ks;   // fine k
-
-        if (one_d) {
-          // In 1D, interior face field is trivial
-          b.x1f(m,fk,fj,fi+1) = 0.5*(b.x1f(m,fk,fj,fi) + b.x1f(m,fk,fj,fi+2));
-        } else {
-          // in multi-D call inlined prolongation operator for FC fields at internal faces
-          ProlongFCInternal(m,fk,fj,fi,three_d,b);
-        }
-      });
-      tmember.team_barrier();
-    }
+    const int m = (list.d_view(tmember.league_rank()))/nnghbr;
+    const int n = (list.d_view(tmember.league_rank()) - m*nnghbr);
+
+    // use prolongation indices of different field components for interior fine cells
+    int il = rbuf[n].iprol[2].bis;
+    int iu = rbuf[n].iprol[2].bie;
+    int jl = rbuf[n].iprol[0].bjs;
+    int ju = rbuf[n].iprol[0].bje;
+    int kl = rbuf[n].iprol[1].bks;
+    int ku = rbuf[n].iprol[1].bke;
+    const int ni = iu - il + 1;
+    const int nj = ju - jl + 1;
+    const int nk = ku - kl + 1;
+    const int nkji = nk*nj*ni;
+    const int nji  = nj*ni;
+
+    // Middle loop over k,j,i
+    Kokkos::parallel_for(Kokkos::TeamThreadRange<>(tmember,nkji),[&](const int idx) {
+      int k = idx/nji;
+      int j = (idx - k*nji)/ni;
+      int i = (idx - k*nji - j*ni) + il;
+      j += jl;
+      k += kl;
+
+      int fi = (i - indcs.cis)*2 + indcs.is;   // fine i
+      int fj = (j - indcs.cjs)*2 + indcs.js;   // fine j
+      int fk = (k - indcs.cks)*2 + indcs.ks;   // fine k
+
+      if (one_d) {
+        // In 1D, interior face field is trivial
+        b.x1f(m,fk,fj,fi+1) = 0.5*(b.x1f(m,fk,fj,fi) + b.x1f(m,fk,fj,fi+2));
+      } else {
+        // in multi-D call inlined prolongation operator for FC fields at internal faces
+        ProlongFCInternal(m,fk,fj,fi,three_d,b);
+      }
+    });
+    tmember.team_barrier();
   });}
 
   return;
@@ -33,6 +33,21 @@ void ComputeMetricAndInverse(Real x, Real y, Real z, bool minkowski, Real a,
   // seemingly not necessary, however, if something goes awry for z ~ 0 in future
   // applications (even after flooring r_ks = 1.0), consider revisiting this z floor...
   // if (fabs(z) < (SMALL_NUMBER)) z = (SMALL_NUMBER);
+
+  // Minkowski metric is set directly.  Flag is the same in all cells, so this branch
+  // does not diverge on GPUs, and skips all of the (expensive) algebra below.
+  if (minkowski) {
+    for (int mu=0; mu<4; ++mu) {
+      for (int nu=0; nu<4; ++nu) {
+        glower[mu][nu] = (mu == nu)? 1.0 : 0.0;
+        gupper[mu][nu] = (mu == nu)? 1.0 : 0.0;
+      }
+    }
+    glower[0][0] = -1.0;
+    gupper[0][0] = -1.0;
+    return;
+  }
+
   Real rad = sqrt(SQR(x) + SQR(y) + SQR(z));
   Real r = sqrt((SQR(rad)-SQR(a)+sqrt(SQR(SQR(rad)-SQR(a))+4.0*SQR(a)*SQR(z)))/2.0);
   Real eps = 1e-6;
@@ -98,6 +113,38 @@ void ComputeMetricAndInverse(Real x, Real y, Real z, bool minkowski, Real a,
   return;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void StoreMetricAndInverse
+//! \brief stores 10 covariant followed by 10 contravariant components of metric (each in
+//!  order of MetricIndex) at (m,k,j,i) in table g of cached metric (see CoordData)
+
+KOKKOS_INLINE_FUNCTION
+void StoreMetricAndInverse(const DvceArray5D<StoreReal> &g, int m, int k, int j, int i,
+                           const Real glower[][4], const Real gupper[][4]) {
+  const int mu[NMETRIC] = {0, 0, 0, 0, 1, 1, 1, 2, 2, 3};
+  const int nu[NMETRIC] = {0, 1, 2, 3, 1, 2, 3, 2, 3, 3};
+  for (int n=0; n<NMETRIC; ++n) {
+    g(m,n,k,j,i) = glower[mu[n]][nu[n]];
+    g(m,NMETRIC+n,k,j,i) = gupper[mu[n]][nu[n]];
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void LoadMetricAndInverse
+//! \brief loads covariant and contravariant components of metric at (m,k,j,i) from table
+//!  g of cached metric, filled by StoreMetricAndInverse()
+
+KOKKOS_INLINE_FUNCTION
+void LoadMetricAndInverse(const DvceArray5D<StoreReal> &g, int m, int k, int j, int i,
+                          Real glower[][4], Real gupper[][4]) {
+  const int mu[NMETRIC] = {0, 0, 0, 0, 1, 1, 1, 2, 2, 3};
+  const int nu[NMETRIC] = {0, 1, 2, 3, 1, 2, 3, 2, 3, 3};
+  for (int n=0; n<NMETRIC; ++n) {
+    glower[mu[n]][nu[n]] = glower[nu[n]][mu[n]] = g(m,n,k,j,i);
+    gupper[mu[n]][nu[n]] = gupper[nu[n]][mu[n]] = g(m,NMETRIC+n,k,j,i);
+  }
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void ComputeADMDecomposition
 //! \brief computes ADM quantitiese in Cartesian Kerr-Schild coordinates
@@ -49,4 +49,61 @@ static int CellCenterIndex(Real x, int n, Real xmin, Real xmax) {
   return static_cast<int>(((x-xmin)/(xmax-xmin))*static_cast<Real>(n));
 }
 
+//----------------------------------------------------------------------------------------
+//! \struct CoordinateStretch
+//! \brief optional smooth stretching of the Cartesian coordinates, x = w*sinh(xi/w) in
+//! each direction with width w > 0 (uniform, x = xi, if w = 0).  The Mesh, MeshBlocks,
+//! and all functions above use the uniformly spaced logical coordinate xi; cells are
+//! then of nearly constant size for |x| < w and grow exponentially (log-spaced) beyond.
+//! Set with <mesh>/x1stretch etc.; see Mesh::Mesh() for the modules that support it.
+
+struct CoordinateStretch {
+  bool stretched = false;            // true if any direction is stretched
+  Real width[3] = {0.0, 0.0, 0.0};   // stretching widths w in each direction
+
+  // physical coordinate x of logical coordinate xi in direction dir
+  KOKKOS_INLINE_FUNCTION
+  Real X(const int dir, const Real xi) const {
+    const Real w = width[dir];
+    return (w > 0.0)? w*sinh(xi/w) : xi;
+  }
+  // logical coordinate xi of physical coordinate x in direction dir
+  KOKKOS_INLINE_FUNCTION
+  Real Xi(const int dir, const Real x) const {
+    const Real w = width[dir];
+    return (w > 0.0)? w*asinh(x/w) : x;
+  }
+  // multiplies the inverse (logical) spacings idx so that finite differences in xi
+  // become derivatives in x at the cell with logical coordinates xi, and sets the
+  // correction cdd of unmixed second derivatives: d2f/dx2 = D2(f) - cdd*D1(f), where D1
+  // and D2 are the first and second differences with the multiplied idx.
+  KOKKOS_INLINE_FUNCTION
+  void FDFactors(const Real xi[3], Real idx[3], Real cdd[3]) const {
+    for (int dir = 0; dir < 3; ++dir) {
+      const Real w = width[dir];
+      if (w > 0.0) {
+        const Real ch = cosh(xi[dir]/w);
+        idx[dir] /= ch;
+        cdd[dir] = tanh(xi[dir]/w)/(w*ch);
+      } else {
+        cdd[dir] = 0.0;
+      }
+    }
+  }
+  // as above at the center of cell (k,j,i) of a MeshBlock with size (a RegionSize) and
+  // indcs (a RegionIndcs); idx is not changed and cdd is zero if not stretched
+  template <typename TSize, typename TIndcs>
+  KOKKOS_INLINE_FUNCTION
+  void CellFDFactors(const TSize &size, const TIndcs &indcs, const int k, const int j,
+                     const int i, Real idx[3], Real cdd[3]) const {
+    cdd[0] = 0.0; cdd[1] = 0.0; cdd[2] = 0.0;
+    if (stretched) {
+      Real xi[3] = {CellCenterX(i-indcs.is, indcs.nx1, size.x1min, size.x1max),
+                    CellCenterX(j-indcs.js, indcs.nx2, size.x2min, size.x2max),
+                    CellCenterX(k-indcs.ks, indcs.nx3, size.x3min, size.x3max)};
+      FDFactors(xi, idx, cdd);
+    }
+  }
+};
+
 #endif // COORDINATES_CELL_LOCATIONS_HPP_
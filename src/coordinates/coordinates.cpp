@@ -23,7 +23,8 @@
 Coordinates::Coordinates(ParameterInput *pin, MeshBlockPack *ppack) :
     pmy_pack(ppack),
     excision_floor("excision_floor",1,1,1,1),
-    excision_flux("excision_flux",1,1,1,1) {
+    excision_flux("excision_flux",1,1,1,1),
+    excised_kplane("excised_kplane",1,1) {
   // Check for relativistic dynamics
   // WGC: idea for handling new EOS
   is_dynamical_relativistic = (pin->DoesBlockExist("adm") || pin->DoesBlockExist("z4c"))
@@ -86,11 +87,85 @@ Coordinates::Coordinates(ParameterInput *pin, MeshBlockPack *ppack) :
       int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
       Kokkos::realloc(excision_floor, nmb, ncells3, ncells2, ncells1);
       Kokkos::realloc(excision_flux, nmb, ncells3, ncells2, ncells1);
+      Kokkos::realloc(excised_kplane, nmb, ncells3);
       if (coord_data.excision_scheme == ExcisionScheme::fixed) {
         SetExcisionMasks(excision_floor, excision_flux);
+        SetExcisedPlanes();
       }
     }
   }
+
+  // tabulate metric at cells and faces, only possible for stationary metric.  Not
+  // needed in Minkowski spacetime, where loading the table is slower than setting the
+  // metric directly.
+  if (is_general_relativistic) {
+    coord_data.cache_metric = pin->GetOrAddBoolean("coord","cache_metric",false) &&
+                              !(coord_data.is_minkowski);
+    if (coord_data.cache_metric) {CacheMetric();}
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Coordinates::CacheMetric()
+//! \brief Allocates and fills tables of metric and inverse at cell centers and faces
+//! (including ghost zones) of all MeshBlocks in this pack.  Used by GR hydro, MHD, and
+//! radiation kernels instead of evaluating the metric at every cell in every stage.
+
+void Coordinates::CacheMetric() {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, js = indcs.js, ks = indcs.ks;
+  int nmb = pmy_pack->nmb_thispack;
+  int ncells1 = indcs.nx1 + 2*(indcs.ng);
+  int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
+  int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
+  Kokkos::realloc(coord_data.gcc,  nmb, 2*NMETRIC, ncells3, ncells2, ncells1);
+  Kokkos::realloc(coord_data.gx1f, nmb, 2*NMETRIC, ncells3, ncells2, ncells1+1);
+  Kokkos::realloc(coord_data.gx2f, nmb, 2*NMETRIC, ncells3, ncells2+1, ncells1);
+  Kokkos::realloc(coord_data.gx3f, nmb, 2*NMETRIC, ncells3+1, ncells2, ncells1);
+
+  auto &size = pmy_pack->pmb->mb_size;
+  auto &flat = coord_data.is_minkowski;
+  auto &spin = coord_data.bh_spin;
+  auto &gcc = coord_data.gcc;
+  auto &gx1f = coord_data.gx1f;
+  auto &gx2f = coord_data.gx2f;
+  auto &gx3f = coord_data.gx3f;
+  par_for("cache_metric", DevExeSpace(), 0, (nmb-1), 0, ncells3, 0, ncells2, 0, ncells1,
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    Real &x1min = size.d_view(m).x1min;
+    Real &x1max = size.d_view(m).x1max;
+    Real x1v = CellCenterX(i-is, indcs.nx1, x1min, x1max);
+    Real x1f = LeftEdgeX  (i-is, indcs.nx1, x1min, x1max);
+
+    Real &x2min = size.d_view(m).x2min;
+    Real &x2max = size.d_view(m).x2max;
+    Real x2v = CellCenterX(j-js, indcs.nx2, x2min, x2max);
+    Real x2f = LeftEdgeX  (j-js, indcs.nx2, x2min, x2max);
+
+    Real &x3min = size.d_view(m).x3min;
+    Real &x3max = size.d_view(m).x3max;
+    Real x3v = CellCenterX(k-ks, indcs.nx3, x3min, x3max);
+    Real x3f = LeftEdgeX  (k-ks, indcs.nx3, x3min, x3max);
+
+    Real glower[4][4], gupper[4][4];
+    bool in_k = (k < ncells3), in_j = (j < ncells2), in_i = (i < ncells1);
+    if (in_k && in_j && in_i) {
+      ComputeMetricAndInverse(x1v, x2v, x3v, flat, spin, glower, gupper);
+      StoreMetricAndInverse(gcc, m, k, j, i, glower, gupper);
+    }
+    if (in_k && in_j) {
+      ComputeMetricAndInverse(x1f, x2v, x3v, flat, spin, glower, gupper);
+      StoreMetricAndInverse(gx1f, m, k, j, i, glower, gupper);
+    }
+    if (in_k && in_i) {
+      ComputeMetricAndInverse(x1v, x2f, x3v, flat, spin, glower, gupper);
+      StoreMetricAndInverse(gx2f, m, k, j, i, glower, gupper);
+    }
+    if (in_j && in_i) {
+      ComputeMetricAndInverse(x1v, x2v, x3f, flat, spin, glower, gupper);
+      StoreMetricAndInverse(gx3f, m, k, j, i, glower, gupper);
+    }
+  });
 }
 
 //----------------------------------------------------------------------------------------
@@ -107,12 +182,20 @@ void Coordinates::CoordSrcTerms(const DvceArray5D<Real> &prim, const EOS_Data &e
   auto &size = pmy_pack->pmb->mb_size;
   auto &flat = coord_data.is_minkowski;
   auto &spin = coord_data.bh_spin;
+  auto &excise = coord_data.bh_excise;
+  auto &excised_kplane_ = excised_kplane;
+
+  // derivatives of the metric, and so all source terms, vanish in Minkowski spacetime
+  if (flat) return;
 
   Real gamma_prime = eos.gamma / (eos.gamma - 1.0);
 
   int nmb1 = pmy_pack->nmb_thispack - 1;
   par_for("coord_src", DevExeSpace(), 0, nmb1, ks, ke, js, je, is, ie,
   KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    // conserved variables are reset in excised cells by C2P
+    if (excise && excised_kplane_(m,k)) return;
+
     // Extract components of metric
     Real &x1min = size.d_view(m).x1min;
     Real &x1max = size.d_view(m).x1max;
@@ -230,12 +313,20 @@ void Coordinates::CoordSrcTerms(const DvceArray5D<Real> &prim,
   auto &size = pmy_pack->pmb->mb_size;
   auto &flat = coord_data.is_minkowski;
   auto &spin = coord_data.bh_spin;
+  auto &excise = coord_data.bh_excise;
+  auto &excised_kplane_ = excised_kplane;
+
+  // derivatives of the metric, and so all source terms, vanish in Minkowski spacetime
+  if (flat) return;
 
   Real gamma_prime = eos.gamma / (eos.gamma - 1.0);
 
   int nmb1 = pmy_pack->nmb_thispack - 1;
   par_for("coord_src", DevExeSpace(), 0, nmb1, ks, ke, js, je, is, ie,
   KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    // conserved variables are reset in excised cells by C2P
+    if (excise && excised_kplane_(m,k)) return;
+
     // Extract components of metric
     Real &x1min = size.d_view(m).x1min;
     Real &x1max = size.d_view(m).x1max;
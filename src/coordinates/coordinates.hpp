@@ -41,6 +41,12 @@ struct CoordData {
   Real flux_excise_r;              // reduce to first-order inside this radius
   ExcisionScheme excision_scheme;  // excision method
   Real excise_lapse;               // if excision_scheme = lapse, excise under this lapse
+
+  // With cache_metric, the (stationary) metric and its inverse are tabulated at cell
+  // centers (gcc) and faces (gx1f,gx2f,gx3f) of every MeshBlock when Coordinates are
+  // constructed (at start and after AMR), see StoreMetricAndInverse().
+  bool cache_metric = false;
+  DvceArray5D<StoreReal> gcc, gx1f, gx2f, gx3f;
 };
 
 //----------------------------------------------------------------------------------------
@@ -63,6 +69,7 @@ class Coordinates {
   // excision masks
   DvceArray4D<bool> excision_floor;  // cell-centered mask for C2P flooring about horizon
   DvceArray4D<bool> excision_flux;   // cell-centered mask for FOFC about horizon
+  DvceArray2D<bool> excised_kplane;  // true if all active cells in (m,k) plane floored
 
   // functions
   void CoordSrcTerms(const DvceArray5D<Real> &w0, const EOS_Data &eos, const Real dt,
@@ -70,8 +77,10 @@ class Coordinates {
   void CoordSrcTerms(const DvceArray5D<Real> &w0, const DvceArray5D<Real> &bcc,
                      const EOS_Data &eos, const Real dt, DvceArray5D<Real> &u0);
   void SetExcisionMasks(DvceArray4D<bool> &floor, DvceArray4D<bool> &flux);
+  void CacheMetric();
 
   void UpdateExcisionMasks();
+  void SetExcisedPlanes();
 
  private:
   MeshBlockPack* pmy_pack;
@@ -187,5 +187,38 @@ void Coordinates::UpdateExcisionMasks() {
       floor(m,k,j,i) = excise;
       flux(m,k,j,i) = excise;
     });
+    SetExcisedPlanes();
   }
 }
+
+//----------------------------------------------------------------------------------------
+//! \fn void Coordinates::SetExcisedPlanes()
+//! \brief Flags each (m,k) plane in which every active cell is floored by excision, so
+//! that work whose result is overwritten by the excision floor in C2P can be skipped for
+//! the whole plane.  Must be called whenever excision_floor changes.
+
+void Coordinates::SetExcisedPlanes() {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, js = indcs.js;
+  int ks = indcs.ks, ke = indcs.ke;
+  int nx1 = indcs.nx1, nx2 = indcs.nx2;
+  const int nji = nx1*nx2;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  auto &floor = excision_floor;
+  auto &kplane = excised_kplane;
+
+  Kokkos::deep_copy(DevExeSpace(), kplane, false);
+  par_for_outer("excised_planes", DevExeSpace(), 0, 0, 0, nmb1, ks, ke,
+  KOKKOS_LAMBDA(TeamMember_t tmember, const int m, const int k) {
+    int nfloor = 0;
+    Kokkos::parallel_reduce(Kokkos::TeamThreadRange(tmember, nji),
+    [=](const int idx, int &sum) {
+      int j = idx/nx1 + js;
+      int i = (idx - (j-js)*nx1) + is;
+      sum += (floor(m,k,j,i))? 1 : 0;
+    }, nfloor);
+    Kokkos::single(Kokkos::PerTeam(tmember), [&] () {
+      kplane(m,k) = (nfloor == nji);
+    });
+  });
+}
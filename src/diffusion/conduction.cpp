@@ -95,305 +95,161 @@ Conduction::~Conduction() {
 
 void Conduction::AddHeatFlux(const DvceArray5D<Real> &w0, const EOS_Data &eos,
   DvceFaceFld5D<Real> &flx) {
-  if (tdep_kappa) {
-    TempDependentHeatFlux(w0, eos, flx);
-  } else if (kappa > 0.0) {
-    IsotropicHeatFlux(w0, eos, flx);
-  } else {
-    return;
+  if (tdep_kappa || (kappa > 0.0)) {
+    HeatFlux(w0, eos, flx);
   }
   return;
 }
-//----------------------------------------------------------------------------------------
-//! \fn void IsotropicHeatFlux()
-//! \brief Adds isotropic heat flux to face-centered fluxes of conserved variables
-
-void Conduction::IsotropicHeatFlux(const DvceArray5D<Real> &w0, const EOS_Data &eos,
-  DvceFaceFld5D<Real> &flx) {
-  auto &indcs = pmy_pack->pmesh->mb_indcs;
-  int is = indcs.is, ie = indcs.ie;
-  int js = indcs.js, je = indcs.je;
-  int ks = indcs.ks, ke = indcs.ke;
-  int nmb1 = pmy_pack->nmb_thispack - 1;
-  auto size = pmy_pack->pmb->mb_size;
-  const bool &use_e = eos.use_e;
-  Real gm1 = eos.gamma-1.0;
-  Real kappa_ = kappa;
-
-  //--------------------------------------------------------------------------------------
-  // fluxes in x1-direction
-
-  auto &flx1 = flx.x1f;
-
-  par_for("conduct1", DevExeSpace(), 0, nmb1, ks, ke, js, je, is, ie+1,
-  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
-    // Add heat fluxes into fluxes of conserved variables: energy
-    Real dtempdx = 0.0;
-    if (use_e) {
-      dtempdx = (w0(m,IEN,k,j,i)/w0(m,IDN,k,j,i) - w0(m,IEN,k,j,i-1)/w0(m,IDN,k,j,i-1))
-                * gm1 / size.d_view(m).dx1;
-    } else {
-      dtempdx = (w0(m,ITM,k,j,i) - w0(m,ITM,k,j,i-1)) / size.d_view(m).dx1;
-    }
-    flx1(m,IEN,k,j,i) -= kappa_ * dtempdx;
-  });
-  if (pmy_pack->pmesh->one_d) {return;}
-
-  //--------------------------------------------------------------------------------------
-  // fluxes in x2-direction
-
-  auto &flx2 = flx.x2f;
-
-  par_for("conduct2",DevExeSpace(), 0, nmb1, ks, ke, js, je+1, is, ie,
-  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
-    // Add heat fluxes into fluxes of conserved variables: energy
-    Real dtempdx = 0.0;
-    if (use_e) {
-      dtempdx = (w0(m,IEN,k,j,i)/w0(m,IDN,k,j,i) - w0(m,IEN,k,j-1,i)/w0(m,IDN,k,j-1,i))
-                * gm1 / size.d_view(m).dx2;
-    } else {
-      dtempdx = (w0(m,ITM,k,j,i) - w0(m,ITM,k,j-1,i)) / size.d_view(m).dx2;
-    }
-    flx2(m,IEN,k,j,i) -= kappa_ * dtempdx;
-  });
-  if (pmy_pack->pmesh->two_d) {return;}
-
-  //--------------------------------------------------------------------------------------
-  // fluxes in x3-direction
-
-  auto &flx3 = flx.x3f;
-
-  par_for("conduct3",DevExeSpace(), 0, nmb1, ks, ke+1, js, je, is, ie,
-  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
-    // Add heat fluxes into fluxes of conserved variables: energy
-    Real dtempdx = 0.0;
-    if (use_e) {
-      dtempdx = (w0(m,IEN,k,j,i)/w0(m,IDN,k,j,i) - w0(m,IEN,k-1,j,i)/w0(m,IDN,k-1,j,i))
-                * gm1 / size.d_view(m).dx3;
-    } else {
-      dtempdx = (w0(m,ITM,k,j,i) - w0(m,ITM,k-1,j,i)) / size.d_view(m).dx3;
-    }
-    flx3(m,IEN,k,j,i) -= kappa_ * dtempdx;
-  });
-
-  return;
-}
 
 //----------------------------------------------------------------------------------------
-//! \fn void TempDependentHeatFlux()
-//! \brief Adds heat flux to face-centered fluxes of conserved variables with
-//! temperature-dependent conductivity
-
-void Conduction::TempDependentHeatFlux(const DvceArray5D<Real> &w0, const EOS_Data &eos,
+//! \fn void HeatFlux()
+//! \brief Adds heat flux to face-centered fluxes of conserved variables, with constant or
+//! temperature-dependent conductivity (and optional saturation).  A single hierarchical
+//! kernel over (m,k,j) stores temperature, conductivity and p*sqrt(T) for the 3x3 rows
+//! of cells around row (k,j) in scratch memory, from which the fluxes on all x1-, x2-
+//! and x3-faces at (k,j) and the limited transverse gradients used for saturation are
+//! computed.  So each temperature (and each conductivity, which is expensive when
+//! temperature-dependent) is computed once per row rather than once per face and
+//! direction.
+
+void Conduction::HeatFlux(const DvceArray5D<Real> &w0, const EOS_Data &eos,
   DvceFaceFld5D<Real> &flx) {
   auto &indcs = pmy_pack->pmesh->mb_indcs;
   int is = indcs.is, ie = indcs.ie;
   int js = indcs.js, je = indcs.je;
   int ks = indcs.ks, ke = indcs.ke;
+  int ncells1 = indcs.nx1 + 2*(indcs.ng);
   int nmb1 = pmy_pack->nmb_thispack - 1;
   auto size = pmy_pack->pmb->mb_size;
   const bool &use_e = eos.use_e;
-  const bool &sat_hflux_ = sat_hflux;
+  bool tdep = tdep_kappa;
+  bool sat = tdep_kappa && sat_hflux;
   bool &multi_d = pmy_pack->pmesh->multi_d;
   bool &three_d = pmy_pack->pmesh->three_d;
   Real gm1 = eos.gamma-1.0;
+  Real kappa_ = kappa;
   Real kappaceil = kappa_ceiling;
-  Real temp_unit = pmy_pack->punit->temperature_cgs();
-  Real kappa_unit = pmy_pack->punit->pressure_cgs()*pmy_pack->punit->velocity_cgs()*
-                    pmy_pack->punit->length_cgs()/pmy_pack->punit->temperature_cgs();
-
-  //--------------------------------------------------------------------------------------
-  // fluxes in x1-direction
-
+  Real temp_unit = 1.0, kappa_unit = 1.0;
+  if (tdep) {
+    temp_unit = pmy_pack->punit->temperature_cgs();
+    kappa_unit = pmy_pack->punit->pressure_cgs()*pmy_pack->punit->velocity_cgs()*
+                 pmy_pack->punit->length_cgs()/pmy_pack->punit->temperature_cgs();
+  }
   auto &flx1 = flx.x1f;
+  auto &flx2 = flx.x2f;
+  auto &flx3 = flx.x3f;
 
-  par_for("conduct1", DevExeSpace(), 0, nmb1, ks, ke, js, je, is, ie+1,
-  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
-    // Add heat fluxes into fluxes of conserved variables: energy
-    Real temp_l = 0.0, temp_r = 0.0, pres_l = 0.0, pres_r = 0.0;
-    Real temp_ll = 0.0, temp_lr = 0.0, temp_rl = 0.0, temp_rr = 0.0;
-    if (use_e) {
-      temp_l = w0(m,IEN,k,j,i-1)/w0(m,IDN,k,j,i-1)*gm1;
-      temp_r = w0(m,IEN,k,j,i)/w0(m,IDN,k,j,i)*gm1;
-      pres_l = w0(m,IEN,k,j,i-1)*gm1;
-      pres_r = w0(m,IEN,k,j,i)*gm1;
-    } else {
-      temp_l = w0(m,ITM,k,j,i-1);
-      temp_r = w0(m,ITM,k,j,i);
-      pres_l = w0(m,ITM,k,j,i-1)*w0(m,IDN,k,j,i-1);
-      pres_r = w0(m,ITM,k,j,i)*w0(m,IDN,k,j,i);
-    }
-    Real kappaf = 0.5*(KappaTemp(temp_unit*temp_l,kappaceil)+
-                  KappaTemp(temp_unit*temp_r,kappaceil))/kappa_unit;
-    Real dtempdx1 = (temp_r-temp_l)/size.d_view(m).dx1;
-    Real hflx = kappaf*dtempdx1;
-    // Saturation of thermal conduction by harmonic mean
-    if (sat_hflux_) {
-      Real dtempdx2 = 0.0, dtempdx3 = 0.0;
-      if (multi_d) {
-        if (use_e) {
-          temp_ll = w0(m,IEN,k,j-1,i-1)/w0(m,IDN,k,j-1,i-1)*gm1;
-          temp_lr = w0(m,IEN,k,j+1,i-1)/w0(m,IDN,k,j+1,i-1)*gm1;
-          temp_rl = w0(m,IEN,k,j-1,i)/w0(m,IDN,k,j-1,i)*gm1;
-          temp_rr = w0(m,IEN,k,j+1,i)/w0(m,IDN,k,j+1,i)*gm1;
-        } else {
-          temp_ll = w0(m,ITM,k,j-1,i-1);
-          temp_lr = w0(m,ITM,k,j+1,i-1);
-          temp_rl = w0(m,ITM,k,j-1,i);
-          temp_rr = w0(m,ITM,k,j+1,i);
-        }
-        dtempdx2 = VL4Limiter(temp_rr-temp_r,temp_r-temp_rl,
-                              temp_lr-temp_l,temp_l-temp_ll)/size.d_view(m).dx2;
+  // rows of cells in scratch are indexed by r = 3*(dk+1) + (dj+1), so row (k,j) is 4
+  int dkm = (three_d)? 1 : 0;
+  int djm = (multi_d)? 1 : 0;
+  int ke1 = (three_d)? ke+1 : ke;
+  int je1 = (multi_d)? je+1 : je;
+  int scr_level = 0;
+  size_t scr_size = ScrArray2D<Real>::shmem_size(9, ncells1) * 3;
+
+  par_for_outer("conduct",DevExeSpace(),scr_size,scr_level,0,nmb1,ks,ke1,js,je1,
+  KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+    ScrArray2D<Real> temp(member.team_scratch(scr_level), 9, ncells1);
+    ScrArray2D<Real> kap(member.team_scratch(scr_level), 9, ncells1);
+    ScrArray2D<Real> pcs(member.team_scratch(scr_level), 9, ncells1);
+
+    // temperature, conductivity and p*sqrt(T) in rows of cells around (k,j)
+    for (int dk=-dkm; dk<=dkm; ++dk) {
+      for (int dj=-djm; dj<=djm; ++dj) {
+        int r = 3*(dk+1) + (dj+1);
+        par_for_inner(member, is-1, ie+1, [&](const int i) {
+          Real t, p;
+          if (use_e) {
+            t = w0(m,IEN,k+dk,j+dj,i)/w0(m,IDN,k+dk,j+dj,i)*gm1;
+            p = w0(m,IEN,k+dk,j+dj,i)*gm1;
+          } else {
+            t = w0(m,ITM,k+dk,j+dj,i);
+            p = w0(m,ITM,k+dk,j+dj,i)*w0(m,IDN,k+dk,j+dj,i);
+          }
+          temp(r,i) = t;
+          kap(r,i) = (tdep)? KappaTemp(temp_unit*t,kappaceil)/kappa_unit : kappa_;
+          pcs(r,i) = (sat)? p*sqrt(t) : 0.0;
+        });
       }
-      if (three_d) {
-        if (use_e) {
-          temp_ll = w0(m,IEN,k-1,j,i-1)/w0(m,IDN,k-1,j,i-1)*gm1;
-          temp_lr = w0(m,IEN,k+1,j,i-1)/w0(m,IDN,k+1,j,i-1)*gm1;
-          temp_rl = w0(m,IEN,k-1,j,i)/w0(m,IDN,k-1,j,i)*gm1;
-          temp_rr = w0(m,IEN,k+1,j,i)/w0(m,IDN,k+1,j,i)*gm1;
-        } else {
-          temp_ll = w0(m,ITM,k-1,j,i-1);
-          temp_lr = w0(m,ITM,k+1,j,i-1);
-          temp_rl = w0(m,ITM,k-1,j,i);
-          temp_rr = w0(m,ITM,k+1,j,i);
+    }
+    member.team_barrier();
+
+    // fluxes in x1-direction
+    if (k <= ke && j <= je) {
+      par_for_inner(member, is, ie+1, [&](const int i) {
+        Real temp_l = temp(4,i-1), temp_r = temp(4,i);
+        Real kappaf = 0.5*(kap(4,i-1) + kap(4,i));
+        Real dtempdx1 = (temp_r-temp_l)/size.d_view(m).dx1;
+        Real hflx = kappaf*dtempdx1;
+        // Saturation of thermal conduction by harmonic mean
+        if (sat) {
+          Real dtempdx2 = 0.0, dtempdx3 = 0.0;
+          if (multi_d) {
+            dtempdx2 = VL4Limiter(temp(5,i)-temp_r, temp_r-temp(3,i),
+                                  temp(5,i-1)-temp_l, temp_l-temp(3,i-1))
+                       /size.d_view(m).dx2;
+          }
+          if (three_d) {
+            dtempdx3 = VL4Limiter(temp(7,i)-temp_r, temp_r-temp(1,i),
+                                  temp(7,i-1)-temp_l, temp_l-temp(1,i-1))
+                       /size.d_view(m).dx3;
+          }
+          Real tempgrad = sqrt(SQR(dtempdx1)+SQR(dtempdx2)+SQR(dtempdx3));
+          Real pres_cs = 0.5*(pcs(4,i-1) + pcs(4,i));
+          hflx *= 1.0/(1.0+kappaf*tempgrad/(1.5*pres_cs));
         }
-        dtempdx3 = VL4Limiter(temp_rr-temp_r,temp_r-temp_rl,
-                              temp_lr-temp_l,temp_l-temp_ll)/size.d_view(m).dx3;
-      }
-      Real tempgrad = sqrt(SQR(dtempdx1)+SQR(dtempdx2)+SQR(dtempdx3));
-      Real pres_cs = 0.5*(pres_l*sqrt(temp_l)+pres_r*sqrt(temp_r));
-      Real sat_fac = 1.0/(1.0+kappaf*tempgrad/(1.5*pres_cs));
-      hflx *= sat_fac;
+        flx1(m,IEN,k,j,i) -= hflx;
+      });
     }
-    flx1(m,IEN,k,j,i) -= hflx;
-  });
-  if (pmy_pack->pmesh->one_d) {return;}
-
-  //--------------------------------------------------------------------------------------
-  // fluxes in x2-direction
-
-  auto &flx2 = flx.x2f;
 
-  par_for("conduct2",DevExeSpace(), 0, nmb1, ks, ke, js, je+1, is, ie,
-  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
-    // Add heat fluxes into fluxes of conserved variables: energy
-    Real temp_l = 0.0, temp_r = 0.0, pres_l = 0.0, pres_r = 0.0;
-    Real temp_ll = 0.0, temp_lr = 0.0, temp_rl = 0.0, temp_rr = 0.0;
-    if (use_e) {
-      temp_l = w0(m,IEN,k,j-1,i)/w0(m,IDN,k,j-1,i)*gm1;
-      temp_r = w0(m,IEN,k,j,i)/w0(m,IDN,k,j,i)*gm1;
-      pres_l = w0(m,IEN,k,j-1,i)*gm1;
-      pres_r = w0(m,IEN,k,j,i)*gm1;
-    } else {
-      temp_l = w0(m,ITM,k,j-1,i);
-      temp_r = w0(m,ITM,k,j,i);
-      pres_l = w0(m,ITM,k,j-1,i)*w0(m,IDN,k,j-1,i);
-      pres_r = w0(m,ITM,k,j,i)*w0(m,IDN,k,j,i);
-    }
-    Real kappaf = 0.5*(KappaTemp(temp_unit*temp_l,kappaceil)+
-                  KappaTemp(temp_unit*temp_r,kappaceil))/kappa_unit;
-    Real dtempdx2 = (temp_r-temp_l)/size.d_view(m).dx2;
-    Real hflx = kappaf*dtempdx2;
-    // Saturation of thermal conduction
-    if (sat_hflux_) {
-      Real dtempdx1 = 0.0, dtempdx3 = 0.0;
-      if (use_e) {
-        temp_ll = w0(m,IEN,k,j-1,i-1)/w0(m,IDN,k,j-1,i-1)*gm1;
-        temp_lr = w0(m,IEN,k,j-1,i+1)/w0(m,IDN,k,j-1,i+1)*gm1;
-        temp_rl = w0(m,IEN,k,j,i-1)/w0(m,IDN,k,j,i-1)*gm1;
-        temp_rr = w0(m,IEN,k,j,i+1)/w0(m,IDN,k,j,i+1)*gm1;
-      } else {
-        temp_ll = w0(m,ITM,k,j-1,i-1);
-        temp_lr = w0(m,ITM,k,j-1,i+1);
-        temp_rl = w0(m,ITM,k,j,i-1);
-        temp_rr = w0(m,ITM,k,j,i+1);
-      }
-      dtempdx1 = VL4Limiter(temp_rr-temp_r,temp_r-temp_rl,
-                            temp_lr-temp_l,temp_l-temp_ll)/size.d_view(m).dx1;
-      if (three_d) {
-        if (use_e) {
-          temp_ll = w0(m,IEN,k-1,j-1,i)/w0(m,IDN,k-1,j-1,i)*gm1;
-          temp_lr = w0(m,IEN,k+1,j-1,i)/w0(m,IDN,k+1,j-1,i)*gm1;
-          temp_rl = w0(m,IEN,k-1,j,i)/w0(m,IDN,k-1,j,i)*gm1;
-          temp_rr = w0(m,IEN,k+1,j,i)/w0(m,IDN,k+1,j,i)*gm1;
-        } else {
-          temp_ll = w0(m,ITM,k-1,j-1,i);
-          temp_lr = w0(m,ITM,k+1,j-1,i);
-          temp_rl = w0(m,ITM,k-1,j,i);
-          temp_rr = w0(m,ITM,k+1,j,i);
+    // fluxes in x2-direction
+    if (multi_d && k <= ke) {
+      par_for_inner(member, is, ie, [&](const int i) {
+        Real temp_l = temp(3,i), temp_r = temp(4,i);
+        Real kappaf = 0.5*(kap(3,i) + kap(4,i));
+        Real dtempdx2 = (temp_r-temp_l)/size.d_view(m).dx2;
+        Real hflx = kappaf*dtempdx2;
+        // Saturation of thermal conduction
+        if (sat) {
+          Real dtempdx1 = 0.0, dtempdx3 = 0.0;
+          dtempdx1 = VL4Limiter(temp(4,i+1)-temp_r, temp_r-temp(4,i-1),
+                                temp(3,i+1)-temp_l, temp_l-temp(3,i-1))
+                     /size.d_view(m).dx1;
+          if (three_d) {
+            dtempdx3 = VL4Limiter(temp(7,i)-temp_r, temp_r-temp(1,i),
+                                  temp(6,i)-temp_l, temp_l-temp(0,i))
+                       /size.d_view(m).dx3;
+          }
+          Real tempgrad = sqrt(SQR(dtempdx1)+SQR(dtempdx2)+SQR(dtempdx3));
+          Real pres_cs = 0.5*(pcs(3,i) + pcs(4,i));
+          hflx *= 1.0/(1.0+kappaf*tempgrad/(1.5*pres_cs));
         }
-        dtempdx3 = VL4Limiter(temp_rr-temp_r,temp_r-temp_rl,
-                              temp_lr-temp_l,temp_l-temp_ll)/size.d_view(m).dx3;
-      }
-      Real tempgrad = sqrt(SQR(dtempdx1)+SQR(dtempdx2)+SQR(dtempdx3));
-      Real pres_cs = 0.5*(pres_l*sqrt(temp_l)+pres_r*sqrt(temp_r));
-      Real sat_fac = 1.0/(1.0+kappaf*tempgrad/(1.5*pres_cs));
-      hflx *= sat_fac;
+        flx2(m,IEN,k,j,i) -= hflx;
+      });
     }
-    flx2(m,IEN,k,j,i) -= hflx;
-  });
-  if (pmy_pack->pmesh->two_d) {return;}
-
-  //--------------------------------------------------------------------------------------
-  // fluxes in x3-direction
-
-  auto &flx3 = flx.x3f;
 
-  par_for("conduct3",DevExeSpace(), 0, nmb1, ks, ke+1, js, je, is, ie,
-  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
-    // Add heat fluxes into fluxes of conserved variables: energy
-    Real temp_l = 0.0, temp_r = 0.0, pres_l = 0.0, pres_r = 0.0;
-    Real temp_ll = 0.0, temp_lr = 0.0, temp_rl = 0.0, temp_rr = 0.0;
-    if (use_e) {
-      temp_l = w0(m,IEN,k-1,j,i)/w0(m,IDN,k-1,j,i)*gm1;
-      temp_r = w0(m,IEN,k,j,i)/w0(m,IDN,k,j,i)*gm1;
-      pres_l = w0(m,IEN,k-1,j,i)*gm1;
-      pres_r = w0(m,IEN,k,j,i)*gm1;
-    } else {
-      temp_l = w0(m,ITM,k-1,j,i);
-      temp_r = w0(m,ITM,k,j,i);
-      pres_l = w0(m,ITM,k-1,j,i)*w0(m,IDN,k-1,j,i);
-      pres_r = w0(m,ITM,k,j,i)*w0(m,IDN,k,j,i);
-    }
-    Real kappaf = 0.5*(KappaTemp(temp_unit*temp_l,kappaceil)+
-                  KappaTemp(temp_unit*temp_r,kappaceil))/kappa_unit;
-    Real dtempdx3 = (temp_r-temp_l)/size.d_view(m).dx3;
-    Real hflx = kappaf*dtempdx3;
-    // Saturation of thermal conduction
-    if (sat_hflux_) {
-      Real dtempdx1 = 0.0, dtempdx2 = 0.0;
-      if (use_e) {
-        temp_ll = w0(m,IEN,k-1,j,i-1)/w0(m,IDN,k-1,j,i-1)*gm1;
-        temp_lr = w0(m,IEN,k-1,j,i+1)/w0(m,IDN,k-1,j,i+1)*gm1;
-        temp_rl = w0(m,IEN,k,j,i-1)/w0(m,IDN,k,j,i-1)*gm1;
-        temp_rr = w0(m,IEN,k,j,i+1)/w0(m,IDN,k,j,i+1)*gm1;
-      } else {
-        temp_ll = w0(m,ITM,k-1,j,i-1);
-        temp_lr = w0(m,ITM,k-1,j,i+1);
-        temp_rl = w0(m,ITM,k,j,i-1);
-        temp_rr = w0(m,ITM,k,j,i+1);
-      }
-      dtempdx1 = VL4Limiter(temp_rr-temp_r,temp_r-temp_rl,
-                            temp_lr-temp_l,temp_l-temp_ll)/size.d_view(m).dx1;
-      if (use_e) {
-        temp_ll = w0(m,IEN,k-1,j-1,i)/w0(m,IDN,k-1,j-1,i)*gm1;
-        temp_lr = w0(m,IEN,k-1,j+1,i)/w0(m,IDN,k-1,j+1,i)*gm1;
-        temp_rl = w0(m,IEN,k,j-1,i)/w0(m,IDN,k,j-1,i)*gm1;
-        temp_rr = w0(m,IEN,k,j+1,i)/w0(m,IDN,k,j+1,i)*gm1;
-      } else {
-        temp_ll = w0(m,ITM,k-1,j-1,i);
-        temp_lr = w0(m,ITM,k-1,j+1,i);
-        temp_rl = w0(m,ITM,k,j-1,i);
-        temp_rr = w0(m,ITM,k,j+1,i);
-      }
-      dtempdx2 = VL4Limiter(temp_rr-temp_r,temp_r-temp_rl,
-                            temp_lr-temp_l,temp_l-temp_ll)/size.d_view(m).dx2;
-      Real tempgrad = sqrt(SQR(dtempdx1)+SQR(dtempdx2)+SQR(dtempdx3));
-      Real pres_cs = 0.5*(pres_l*sqrt(temp_l)+pres_r*sqrt(temp_r));
-      Real sat_fac = 1.0/(1.0+kappaf*tempgrad/(1.5*pres_cs));
-      hflx *= sat_fac;
+    // fluxes in x3-direction
+    if (three_d && j <= je) {
+      par_for_inner(member, is, ie, [&](const int i) {
+        Real temp_l = temp(1,i), temp_r = temp(4,i);
+        Real kappaf = 0.5*(kap(1,i) + kap(4,i));
+        Real dtempdx3 = (temp_r-temp_l)/size.d_view(m).dx3;
+        Real hflx = kappaf*dtempdx3;
+        // Saturation of thermal conduction
+        if (sat) {
+          Real dtempdx1 = VL4Limiter(temp(4,i+1)-temp_r, temp_r-temp(4,i-1),
+                                     temp(1,i+1)-temp_l, temp_l-temp(1,i-1))
+                          /size.d_view(m).dx1;
+          Real dtempdx2 = VL4Limiter(temp(5,i)-temp_r, temp_r-temp(3,i),
+                                     temp(2,i)-temp_l, temp_l-temp(0,i))
+                          /size.d_view(m).dx2;
+          Real tempgrad = sqrt(SQR(dtempdx1)+SQR(dtempdx2)+SQR(dtempdx3));
+          Real pres_cs = 0.5*(pcs(1,i) + pcs(4,i));
+          hflx *= 1.0/(1.0+kappaf*tempgrad/(1.5*pres_cs));
+        }
+        flx3(m,IEN,k,j,i) -= hflx;
+      });
     }
-    flx3(m,IEN,k,j,i) -= hflx;
   });
 
   return;
@@ -33,10 +33,7 @@ class Conduction {
   // function to add heat fluxes to Hydro and/or MHD fluxes
   void AddHeatFlux(const DvceArray5D<Real> &w, const EOS_Data &eos,
                    DvceFaceFld5D<Real> &f);
-  void IsotropicHeatFlux(const DvceArray5D<Real> &w, const EOS_Data &eos,
-                         DvceFaceFld5D<Real> &f);
-  void TempDependentHeatFlux(const DvceArray5D<Real> &w, const EOS_Data &eos,
-                             DvceFaceFld5D<Real> &f);
+  void HeatFlux(const DvceArray5D<Real> &w, const EOS_Data &eos, DvceFaceFld5D<Real> &f);
   void NewTimeStep(const DvceArray5D<Real> &w, const EOS_Data &eos_data);
 
  private:
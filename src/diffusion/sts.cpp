@@ -0,0 +1,94 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file sts.cpp
+//  \brief Implements functions for RKL1/RKL2 super-time-stepping of diffusion terms.
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "athena.hpp"
+#include "sts.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \fn STSIntegrator STSIntegratorFromString()
+//! \brief Converts <time>/sts_integrator input parameter into STSIntegrator
+
+STSIntegrator STSIntegratorFromString(const std::string &name) {
+  if (name.compare("none") == 0) {
+    return STSIntegrator::none;
+  } else if (name.compare("rkl1") == 0) {
+    return STSIntegrator::rkl1;
+  } else if (name.compare("rkl2") == 0) {
+    return STSIntegrator::rkl2;
+  }
+  std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+            << "<time>/sts_integrator = '" << name << "' not implemented, "
+            << "choose from 'none', 'rkl1', 'rkl2'" << std::endl;
+  std::exit(EXIT_FAILURE);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn int STSNumberOfStages()
+//! \brief Returns number of stages needed to integrate diffusion terms stably over a
+//! timestep dt_ratio times larger than the explicit (forward Euler) diffusion timestep.
+//! RKL1 with s stages is stable for dt_ratio <= (s^2+s)/2, and RKL2 for
+//! dt_ratio <= (s^2+s-2)/4.  One extra stage is added for safety as in Athena++, and the
+//! number of RKL2 stages is kept odd.
+
+int STSNumberOfStages(const STSIntegrator sts, const Real dt_ratio) {
+  int s = 0;
+  if (sts == STSIntegrator::rkl1) {
+    s = static_cast<int>(0.5*(std::sqrt(1.0 + 8.0*dt_ratio) - 1.0)) + 1;
+  } else if (sts == STSIntegrator::rkl2) {
+    s = static_cast<int>(0.5*(std::sqrt(9.0 + 16.0*dt_ratio) - 1.0)) + 1;
+    if (s % 2 == 0) {s++;}
+  }
+  return s;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void STSStageCoefficients()
+//! \brief Returns coefficients (mu, nu, mut, gam) of stage j (1 <= j <= nstages) of RKL1
+//! or RKL2 integrator with nstages stages.  See Meyer et al. (2014) eqs. 16 and 18-20.
+
+void STSStageCoefficients(const STSIntegrator sts, const int nstages, const int j,
+                          Real &mu, Real &nu, Real &mut, Real &gam) {
+  Real s = static_cast<Real>(nstages);
+  Real fj = static_cast<Real>(j);
+  if (sts == STSIntegrator::rkl1) {
+    Real w1 = 2.0/(s*s + s);
+    if (j == 1) {
+      mu = 1.0;
+      nu = 0.0;
+      mut = w1;
+    } else {
+      mu = (2.0*fj - 1.0)/fj;
+      nu = (1.0 - fj)/fj;
+      mut = w1*mu;
+    }
+    gam = 0.0;
+  } else {
+    // b_j = (j^2+j-2)/(2j(j+1)) for j>=2, and b_0=b_1=b_2=1/3
+    auto b = [](Real k) {
+      return (k < 2.0)? (1.0/3.0) : (k*k + k - 2.0)/(2.0*k*(k + 1.0));
+    };
+    Real w1 = 4.0/(s*s + s - 2.0);
+    if (j == 1) {
+      mu = 1.0;
+      nu = 0.0;
+      mut = b(1.0)*w1;
+      gam = 0.0;
+    } else {
+      mu = (2.0*fj - 1.0)/fj*b(fj)/b(fj - 1.0);
+      nu = -(fj - 1.0)/fj*b(fj)/b(fj - 2.0);
+      mut = w1*mu;
+      gam = -(1.0 - b(fj - 1.0))*mut;
+    }
+  }
+  return;
+}
@@ -0,0 +1,25 @@
+#ifndef DIFFUSION_STS_HPP_
+#define DIFFUSION_STS_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file sts.hpp
+//  \brief Functions returning the number of stages and the stage coefficients of the
+//  Runge-Kutta-Legendre super-time-stepping integrators (RKL1 and RKL2) of Meyer,
+//  Balsara & Aslam (2014, JCP 257, 594), used to integrate the (operator split)
+//  diffusion terms over the full hyperbolic timestep.  Stage j updates
+//     Y_j = mu*Y_{j-1} + nu*Y_{j-2} + (1-mu-nu)*Y_0 + mut*dt*L(Y_{j-1}) + gam*dt*L(Y_0)
+//  where L is the diffusion operator, Y_0 the state at start of step, and Y_s the result.
+
+#include <string>
+
+#include "athena.hpp"
+
+STSIntegrator STSIntegratorFromString(const std::string &name);
+int STSNumberOfStages(const STSIntegrator sts, const Real dt_ratio);
+void STSStageCoefficients(const STSIntegrator sts, const int nstages, const int j,
+                          Real &mu, Real &nu, Real &mut, Real &gam);
+
+#endif // DIFFUSION_STS_HPP_
@@ -0,0 +1,212 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file checkpoint_ring.cpp
+//  \brief implements functions in CheckpointRing class
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mesh/mesh.hpp"
+#include "hydro/hydro.hpp"
+#include "mhd/mhd.hpp"
+#include "radiation/radiation.hpp"
+#include "z4c/z4c.hpp"
+#include "outputs/outputs.hpp"
+#include "driver.hpp"
+#include "checkpoint_ring.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
+//----------------------------------------------------------------------------------------
+// CheckpointRing constructor
+
+CheckpointRing::CheckpointRing(ParameterInput *pin) {
+  ncycle_save = pin->GetOrAddInteger("time", "checkpoint_ncycles", 0);
+  int nslots = pin->GetOrAddInteger("time", "checkpoint_nslots", 2);
+  host_ = pin->GetOrAddBoolean("time", "checkpoint_host", false);
+  nan_check_ = pin->GetOrAddBoolean("time", "rollback_nan_check", true);
+  max_retries_ = pin->GetOrAddInteger("time", "rollback_max_retries", 3);
+  cfl_factor_ = pin->GetOrAddReal("time", "rollback_cfl_factor", 0.5);
+  if (nslots < 1 || max_retries_ < 1 || cfl_factor_ <= 0.0 || cfl_factor_ > 1.0) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "<time>/checkpoint_nslots and rollback_max_retries must be "
+              << ">= 1, and 0 < rollback_cfl_factor <= 1" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  slots_.resize(nslots);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void CheckpointRing::BeginCycle()
+//! \brief Records failure counters at the start of a cycle, and saves a checkpoint every
+//! ncycle_save cycles.  The state at the start of a cycle passed all checks at the end
+//! of the previous cycle.
+
+void CheckpointRing::BeginCycle(Mesh *pm) {
+  nfail_start_ = pm->ecounter.neos_fail;
+  // checkpoints are invalid once MeshBlocks have been created/destroyed by AMR
+  if (newest_ >= 0 &&
+      slots_[newest_].nghbr_version != pm->pmb_pack->pmb->nghbr_version) {
+    for (auto &slot : slots_) {slot.valid = false;}
+    newest_ = -1;
+  }
+  // after a rollback, the current cycle is that of the newest checkpoint
+  if (newest_ >= 0 && pm->ncycle <= slots_[newest_].ncycle) return;
+  if (newest_ < 0 || (pm->ncycle % ncycle_save) == 0) {Save(pm);}
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool CheckpointRing::CycleFailed()
+//! \brief Returns true (on all ranks) if the primitive solver failed in any cell during
+//! the cycle just completed, or (if nan_check_) any evolved variable is not finite.
+
+bool CheckpointRing::CycleFailed(Mesh *pm) {
+  int nbad = pm->ecounter.neos_fail - nfail_start_;
+  if (nan_check_ && nbad == 0) {
+    RestartOutput::StateArrays(pm->pmb_pack, arrays_);
+    int nmb = pm->pmb_pack->nmb_thispack;
+    for (auto &array : arrays_) {
+      Real *data = array.first;
+      int nbad_array = 0;
+      Kokkos::parallel_reduce("rollback_check",
+      Kokkos::RangePolicy<>(DevExeSpace(), 0, nmb*array.second),
+      KOKKOS_LAMBDA(const std::size_t n, int &sum) {
+        if (!(Kokkos::isfinite(data[n]))) {sum++;}
+      }, Kokkos::Sum<int>(nbad_array));
+      nbad += nbad_array;
+    }
+  }
+#if MPI_PARALLEL_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE, &nbad, 1, MPI_INT, MPI_SUM, global_variable::mpi_comm);
+#endif
+  return (nbad > 0);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void CheckpointRing::Save()
+//! \brief Copies state arrays into the oldest slot of the ring, which becomes the newest.
+//! The CFL number reduced by any earlier rollbacks is restored.
+
+void CheckpointRing::Save(Mesh *pm) {
+  if (nretry_ > 0) {
+    pm->cfl_no = cfl_save_;
+    nretry_ = 0;
+  }
+  newest_ = (newest_ + 1) % static_cast<int>(slots_.size());
+  Slot &slot = slots_[newest_];
+  slot.ncycle = pm->ncycle;
+  slot.time = pm->time;
+  slot.nmb = pm->pmb_pack->nmb_thispack;
+  slot.nghbr_version = pm->pmb_pack->pmb->nghbr_version;
+  RestartOutput::StateArrays(pm->pmb_pack, arrays_);
+  Copy(slot, slot.nmb, true);
+  slot.valid = true;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void CheckpointRing::Copy()
+//! \brief Copies the first nmb MeshBlocks of every state array to (save=true) or from
+//! (save=false) the slot.  Storage of slot is (re)allocated when saving as needed.
+
+void CheckpointRing::Copy(Slot &slot, int nmb, bool save) {
+  int narray = static_cast<int>(arrays_.size());
+  if (save) {
+    if (host_) {
+      slot.host.resize(narray);
+    } else {
+      slot.dvce.resize(narray);
+    }
+  }
+  for (int n=0; n<narray; ++n) {
+    std::size_t size = nmb*arrays_[n].second;
+    DvceArray1D<Real> state(arrays_[n].first, size);
+    if (host_) {
+      if (save && slot.host[n].extent(0) != size) {
+        Kokkos::realloc(slot.host[n], size);
+      }
+      if (save) {
+        Kokkos::deep_copy(DevExeSpace(), slot.host[n], state);
+      } else {
+        Kokkos::deep_copy(DevExeSpace(), state, slot.host[n]);
+      }
+    } else {
+      if (save && slot.dvce[n].extent(0) != size) {
+        Kokkos::realloc(slot.dvce[n], size);
+      }
+      if (save) {
+        Kokkos::deep_copy(DevExeSpace(), slot.dvce[n], state);
+      } else {
+        Kokkos::deep_copy(DevExeSpace(), state, slot.dvce[n]);
+      }
+    }
+  }
+  Kokkos::fence();
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void CheckpointRing::Rollback()
+//! \brief Restores state (and time, cycle) from the newest checkpoint, reduces the CFL
+//! number, and recomputes ghost zones, primitives, and the timestep, so that the driver
+//! can repeat the cycles since the checkpoint.
+
+void CheckpointRing::Rollback(Driver *pdriver, Mesh *pm) {
+  if (nretry_ == 0) {cfl_save_ = pm->cfl_no;}
+  nretry_++;
+  // fall back to the next older checkpoint if retries from newest all failed
+  if (newest_ >= 0 && nretry_ > max_retries_) {
+    slots_[newest_].valid = false;
+    int nslots = static_cast<int>(slots_.size());
+    newest_ = (newest_ + nslots - 1) % nslots;
+    if (!(slots_[newest_].valid)) {newest_ = -1;}
+    nretry_ = 1;
+  }
+  if (newest_ < 0 || slots_[newest_].nmb != pm->pmb_pack->nmb_thispack ||
+      slots_[newest_].nghbr_version != pm->pmb_pack->pmb->nghbr_version) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Cycle " << pm->ncycle << " failed, and no valid in-memory "
+              << "checkpoint is left to roll back to" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+
+  Slot &slot = slots_[newest_];
+  RestartOutput::StateArrays(pm->pmb_pack, arrays_);
+  Copy(slot, slot.nmb, false);
+  int ncycle_failed = pm->ncycle;
+  pm->time = slot.time;
+  pm->ncycle = slot.ncycle;
+  pm->cfl_no = cfl_save_*std::pow(cfl_factor_, nretry_);
+
+  // ghost zones and primitives of restored state, then new timestep, as in Initialize()
+  pdriver->InitBoundaryValuesAndPrimitives(pm);
+  int nstages = pdriver->nexp_stages;
+  if (pm->pmb_pack->phydro != nullptr) {
+    (void) pm->pmb_pack->phydro->NewTimeStep(pdriver, nstages);
+  }
+  if (pm->pmb_pack->pmhd != nullptr) {
+    (void) pm->pmb_pack->pmhd->NewTimeStep(pdriver, nstages);
+  }
+  if (pm->pmb_pack->prad != nullptr) {
+    (void) pm->pmb_pack->prad->NewTimeStep(pdriver, nstages);
+  }
+  if (pm->pmb_pack->pz4c != nullptr) {
+    (void) pm->pmb_pack->pz4c->NewTimeStep(pdriver, nstages);
+  }
+  pm->NewTimeStep(pdriver->tlim);
+
+  if (global_variable::my_rank == 0) {
+    std::cout << "### WARNING: cycle " << ncycle_failed << " failed, rolled back to "
+              << "checkpoint at cycle " << slot.ncycle << " (retry " << nretry_ << "/"
+              << max_retries_ << ", cfl_number=" << pm->cfl_no << ")" << std::endl;
+  }
+}
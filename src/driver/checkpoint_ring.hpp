@@ -0,0 +1,71 @@
+#ifndef DRIVER_CHECKPOINT_RING_HPP_
+#define DRIVER_CHECKPOINT_RING_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file checkpoint_ring.hpp
+//  \brief in-memory checkpoints of the evolved variables, used to roll back and retry
+//  with a smaller timestep when a cycle fails, instead of aborting the run.  Enabled with
+//  <time>/checkpoint_ncycles > 0, in which case a copy of every array stored in restart
+//  files (see RestartOutput::StateArrays()) is kept every checkpoint_ncycles cycles in a
+//  ring of <time>/checkpoint_nslots copies, on the device or (with
+//  <time>/checkpoint_host = true) in pinned host memory.
+//
+//  A cycle fails if the primitive solver reports failures (neos_fail counter), or if
+//  (with <time>/rollback_nan_check = true, the default) any evolved variable is
+//  not finite.  The state is then restored from the newest checkpoint and the CFL number
+//  is multiplied by <time>/rollback_cfl_factor for every retry, until the next checkpoint
+//  is reached.  After <time>/rollback_max_retries failed retries the newest checkpoint is
+//  discarded and the next older one used.  Checkpoints are discarded when the mesh
+//  changes (AMR), since the arrays they were copied from no longer exist.
+
+#include <utility>
+#include <vector>
+
+#include "athena.hpp"
+#include "parameter_input.hpp"
+
+// forward declarations
+class Driver;
+class Mesh;
+
+//----------------------------------------------------------------------------------------
+//! \class CheckpointRing
+
+class CheckpointRing {
+ public:
+  explicit CheckpointRing(ParameterInput *pin);
+
+  // data
+  int ncycle_save;    // number of cycles between checkpoints
+
+  // functions
+  void BeginCycle(Mesh *pm);
+  bool CycleFailed(Mesh *pm);
+  void Rollback(Driver *pdriver, Mesh *pm);
+
+ private:
+  struct Slot {
+    bool valid = false;
+    int ncycle, nmb, nghbr_version;
+    Real time;
+    std::vector<DvceArray1D<Real>> dvce;         // copies of state arrays (on device)
+    std::vector<HostPinnedArray1D<Real>> host;   // or in pinned host memory
+  };
+  std::vector<Slot> slots_;
+  int newest_ = -1;         // index of newest valid slot (-1 if none)
+  int nretry_ = 0;          // retries from newest slot since it was saved
+  bool host_;               // store checkpoints in pinned host memory
+  bool nan_check_;          // check evolved variables are finite every cycle
+  int max_retries_;
+  Real cfl_factor_;         // factor by which CFL number is reduced for each retry
+  Real cfl_save_;           // CFL number before first retry
+  int nfail_start_ = 0;     // value of neos_fail counter at start of cycle
+  std::vector<std::pair<Real*, std::size_t>> arrays_;  // state arrays of pack
+  void Save(Mesh *pm);
+  void Copy(Slot &slot, int nmb, bool save);
+};
+
+#endif // DRIVER_CHECKPOINT_RING_HPP_
@@ -0,0 +1,177 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file comm_stats.cpp
+//  \brief implements counters of the bytes and messages sent by each rank
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mesh/mesh.hpp"
+#include "comm_stats.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
+namespace comm_stats {
+
+bool enabled = false;
+Counts totals;
+std::vector<int> node_ranks;
+
+namespace {
+const char *module_names_[nmodules] = {"hydro", "mhd", "z4c", "radiation", "particles",
+                                       "amr", "other"};
+Counts last_report_;   // totals at last call of Report()
+int first_cycle_ = 0;  // first cycle since last call of Report()
+
+// writes one [locality][level] array of counts as nested JSON arrays
+void WriteArray(std::ostream &os, const double (&a)[nlocality][nlevel]) {
+  os << "[";
+  for (int l=0; l<nlocality; ++l) {
+    os << ((l > 0)? ",[" : "[") << a[l][0] << "," << a[l][1] << "," << a[l][2] << "]";
+  }
+  os << "]";
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn void Enable()
+//! \brief Starts counting messages if <time>/comm_stats = true, and finds the ranks on
+//! the same node as this one (which share memory).
+
+void Enable(ParameterInput *pin, Mesh *pm) {
+  enabled = pin->GetOrAddBoolean("time", "comm_stats", false);
+  if (!(enabled)) return;
+  first_cycle_ = pm->ncycle;
+  node_ranks.assign(1, global_variable::my_rank);
+#if MPI_PARALLEL_ENABLED
+  MPI_Comm node_comm;
+  MPI_Comm_split_type(global_variable::mpi_comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+                      &node_comm);
+  int nlocal;
+  MPI_Comm_size(node_comm, &nlocal);
+  node_ranks.resize(nlocal);
+  MPI_Allgather(&global_variable::my_rank, 1, MPI_INT, node_ranks.data(), 1, MPI_INT,
+                node_comm);
+  MPI_Comm_free(&node_comm);
+  std::sort(node_ranks.begin(), node_ranks.end());
+#endif
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Reduce()
+//! \brief Returns counts accumulated since last, summed over ranks (sum) and maximum over
+//! ranks of each class (max), then sets last to the current totals.  Each caller (Report
+//! or the Profiler) keeps its own last.  Must be called by all ranks.
+
+void Reduce(Counts &last, Counts &sum, Counts &max) {
+  for (int i=0; i<nmodules; ++i) {
+    for (int l=0; l<nlocality; ++l) {
+      for (int k=0; k<nlevel; ++k) {
+        sum.bytes[i][l][k] = totals.bytes[i][l][k] - last.bytes[i][l][k];
+        sum.nmsg[i][l][k] = totals.nmsg[i][l][k] - last.nmsg[i][l][k];
+      }
+    }
+  }
+  last = totals;
+  max = sum;
+#if MPI_PARALLEL_ENABLED
+  constexpr int n = nmodules*nlocality*nlevel;
+  MPI_Allreduce(MPI_IN_PLACE, &(sum.bytes[0][0][0]), n, MPI_DOUBLE, MPI_SUM,
+                global_variable::mpi_comm);
+  MPI_Allreduce(MPI_IN_PLACE, &(sum.nmsg[0][0][0]), n, MPI_DOUBLE, MPI_SUM,
+                global_variable::mpi_comm);
+  MPI_Allreduce(MPI_IN_PLACE, &(max.bytes[0][0][0]), n, MPI_DOUBLE, MPI_MAX,
+                global_variable::mpi_comm);
+  MPI_Allreduce(MPI_IN_PLACE, &(max.nmsg[0][0][0]), n, MPI_DOUBLE, MPI_MAX,
+                global_variable::mpi_comm);
+#endif
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Report()
+//! \brief Prints (by rank 0) the bytes and messages sent per cycle since the last report
+//! by each module, summed over ranks, split by locality and by level of the receiver.
+//! Called every <time>/ndiag cycles.  Must be called by all ranks.
+
+void Report(Mesh *pm) {
+  if (!(enabled)) return;
+  Counts sum, max;
+  Reduce(last_report_, sum, max);
+  int ncyc = pm->ncycle - first_cycle_;
+  first_cycle_ = pm->ncycle;
+  if (global_variable::my_rank != 0 || ncyc <= 0) return;
+
+  std::cout << "comm per cycle [MB] (cycles " << (pm->ncycle - ncyc) << "-"
+            << (pm->ncycle - 1) << "):" << std::endl << std::left << std::setw(12)
+            << "  module" << std::right << std::setw(11) << "same-rank" << std::setw(11)
+            << "same-node" << std::setw(11) << "remote" << std::setw(11) << "same-lev"
+            << std::setw(11) << "finer" << std::setw(11) << "coarser" << std::setw(11)
+            << "msgs" << std::setw(11) << "max-rank" << std::endl;
+  double scale = 1.0e-6/static_cast<double>(ncyc);
+  for (int i=0; i<nmodules; ++i) {
+    double loc[nlocality] = {}, lev[nlevel] = {};
+    double nmsg = 0.0, rmax = 0.0;
+    for (int l=0; l<nlocality; ++l) {
+      for (int k=0; k<nlevel; ++k) {
+        loc[l] += sum.bytes[i][l][k];
+        lev[k] += sum.bytes[i][l][k];
+        nmsg += sum.nmsg[i][l][k];
+        rmax += max.bytes[i][l][k];   // upper bound on bytes sent by any one rank
+      }
+    }
+    if (nmsg == 0.0) continue;
+    std::cout << "  " << std::left << std::setw(10) << module_names_[i] << std::right
+              << std::scientific << std::setprecision(3);
+    for (int l=0; l<nlocality; ++l) {std::cout << std::setw(11) << scale*loc[l];}
+    for (int k=0; k<nlevel; ++k) {std::cout << std::setw(11) << scale*lev[k];}
+    std::cout << std::setw(11) << nmsg/static_cast<double>(ncyc) << std::setw(11)
+              << scale*rmax << std::endl;
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void WriteJSON()
+//! \brief Writes counts returned by Reduce() as a JSON object, with arrays of each module
+//! indexed by [locality][level].  Called only by rank 0.
+
+void WriteJSON(std::ostream &os, const Counts &sum, const Counts &max) {
+  os << "{\"locality\":[\"same_rank\",\"same_node\",\"remote\"],"
+     << "\"level\":[\"same\",\"finer\",\"coarser\"],\"modules\":{";
+  bool first = true;
+  for (int i=0; i<nmodules; ++i) {
+    double nmsg = 0.0;
+    for (int l=0; l<nlocality; ++l) {
+      for (int k=0; k<nlevel; ++k) {nmsg += sum.nmsg[i][l][k];}
+    }
+    if (nmsg == 0.0) continue;
+    if (!first) {os << ",";}
+    first = false;
+    os << "\"" << module_names_[i] << "\":{\"bytes\":";
+    WriteArray(os, sum.bytes[i]);
+    os << ",\"msgs\":";
+    WriteArray(os, sum.nmsg[i]);
+    os << ",\"bytes_max_rank\":";
+    WriteArray(os, max.bytes[i]);
+    os << ",\"msgs_max_rank\":";
+    WriteArray(os, max.nmsg[i]);
+    os << "}";
+  }
+  os << "}}";
+  return;
+}
+
+} // namespace comm_stats
@@ -0,0 +1,76 @@
+#ifndef DRIVER_COMM_STATS_HPP_
+#define DRIVER_COMM_STATS_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file comm_stats.hpp
+//  \brief counters of the bytes and messages sent by each rank, split by module (hydro,
+//  MHD, Z4c, radiation, particles, AMR redistribution), by locality of the receiver
+//  (same rank, another rank on the same node, or another node), and by level of the
+//  receiving MeshBlock relative to the sender (same, finer, or coarser).  Enabled with
+//  <time>/comm_stats = true, in which case the totals per cycle are reported every
+//  <time>/ndiag cycles, and are added to each summary of the Profiler written to
+//  <time>/profile_file.
+//
+//  Boundary buffers are counted once per (MeshBlock, neighbor) pair, including those
+//  copied between MeshBlocks on the same rank without MPI.  With <mesh>/aggregate_mpi,
+//  the buffers to each rank are combined into fewer MPI messages than are counted.
+
+#include <algorithm>
+#include <ostream>
+#include <vector>
+
+#include "globals.hpp"
+
+// forward declarations
+class Mesh;
+class ParameterInput;
+
+namespace comm_stats {
+
+enum class Module {hydro, mhd, z4c, radiation, particles, amr, other};
+constexpr int nmodules = 7;
+constexpr int nlocality = 3;   // same rank, same node, remote node
+constexpr int nlevel = 3;      // same level, finer, coarser
+
+//----------------------------------------------------------------------------------------
+//! \struct Counts
+//  \brief bytes and number of messages sent in each class
+
+struct Counts {
+  double bytes[nmodules][nlocality][nlevel] = {};
+  double nmsg[nmodules][nlocality][nlevel] = {};
+};
+
+extern bool enabled;
+extern Counts totals;                // accumulated on this rank since Enable()
+extern std::vector<int> node_ranks;  // sorted world ranks on this node
+
+void Enable(ParameterInput *pin, Mesh *pm);
+void Reduce(Counts &last, Counts &sum, Counts &max);
+void Report(Mesh *pm);
+void WriteJSON(std::ostream &os, const Counts &sum, const Counts &max);
+
+//----------------------------------------------------------------------------------------
+//! \fn void AddMessage()
+//! \brief Counts one message of nbytes sent to rank, whose MeshBlock is dlev levels
+//! finer (dlev > 0) or coarser (dlev < 0) than that of the sender.  Does nothing unless
+//! enabled.
+
+inline void AddMessage(Module module, int rank, int dlev, double nbytes) {
+  if (!(enabled)) return;
+  int iloc = 0;
+  if (rank != global_variable::my_rank) {
+    iloc = std::binary_search(node_ranks.begin(), node_ranks.end(), rank)? 1 : 2;
+  }
+  int ilev = (dlev > 0)? 1 : ((dlev < 0)? 2 : 0);
+  int imod = static_cast<int>(module);
+  totals.bytes[imod][iloc][ilev] += nbytes;
+  totals.nmsg[imod][iloc][ilev] += 1.0;
+}
+
+} // namespace comm_stats
+
+#endif // DRIVER_COMM_STATS_HPP_
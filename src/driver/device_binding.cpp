@@ -0,0 +1,214 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file device_binding.cpp
+//  \brief implements selection of GPU and binding of host threads for each rank
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "device_binding.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
+#if defined(KOKKOS_ENABLE_CUDA)
+#include <cuda_runtime.h>
+#elif defined(KOKKOS_ENABLE_HIP)
+#include <hip/hip_runtime.h>
+#endif
+
+#if defined(__linux__)
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace device_binding {
+
+namespace {
+int local_rank_ = 0, local_size_ = 1;   // node-local rank, and number of ranks on node
+int device_id_ = -1;                    // GPU selected here (-1 if none)
+bool pinned_ = false;                   // host threads bound to CPUs local to GPU
+std::string pci_bus_;                   // PCI address of selected GPU
+std::vector<std::string> kokkos_args_;  // storage of arguments passed to Kokkos
+std::vector<char*> kokkos_argv_;
+
+// returns true if any argument or environment variable already chooses the device
+bool DeviceChosenByUser(int argc, char **argv) {
+  const char *flags[] = {"--kokkos-device-id", "--kokkos-map-device-id-by",
+                         "--kokkos-num-devices", "--kokkos-ndevices", "--device-id"};
+  for (int i=1; i<argc; ++i) {
+    for (const char *f : flags) {
+      if (std::strncmp(argv[i], f, std::strlen(f)) == 0) return true;
+    }
+  }
+  return (std::getenv("KOKKOS_DEVICE_ID") != nullptr ||
+          std::getenv("KOKKOS_MAP_DEVICE_ID_BY") != nullptr ||
+          std::getenv("KOKKOS_NUM_DEVICES") != nullptr);
+}
+
+// returns number of visible GPUs, and PCI address of GPU dev (if dev >= 0)
+int DeviceCount(int dev, std::string &pci) {
+  int ndev = 0;
+  char bus[64] = {0};
+#if defined(KOKKOS_ENABLE_CUDA)
+  if (cudaGetDeviceCount(&ndev) != cudaSuccess) {ndev = 0;}
+  if (dev >= 0 && dev < ndev &&
+      cudaDeviceGetPCIBusId(bus, sizeof(bus), dev) == cudaSuccess) {pci = bus;}
+#elif defined(KOKKOS_ENABLE_HIP)
+  if (hipGetDeviceCount(&ndev) != hipSuccess) {ndev = 0;}
+  if (dev >= 0 && dev < ndev &&
+      hipDeviceGetPCIBusId(bus, sizeof(bus), dev) == hipSuccess) {pci = bus;}
+#endif
+  // sysfs uses lower-case hexadecimal digits
+  std::transform(pci.begin(), pci.end(), pci.begin(),
+                 [](unsigned char c) {return std::tolower(c);});
+  return ndev;
+}
+
+#if defined(__linux__)
+// Parses list of CPUs of the form "0-15,32-47" into a cpu_set_t.  Returns false on error.
+bool ParseCPUList(const std::string &list, cpu_set_t &set) {
+  CPU_ZERO(&set);
+  std::istringstream ls(list);
+  std::string range;
+  int ncpu = 0;
+  while (std::getline(ls, range, ',')) {
+    int lo, hi;
+    char dash;
+    std::istringstream rs(range);
+    if (!(rs >> lo)) return false;
+    hi = lo;
+    if (rs >> dash && !(dash == '-' && rs >> hi)) return false;
+    for (int c=lo; c<=hi && c<CPU_SETSIZE; ++c) {
+      CPU_SET(c, &set);
+      ncpu++;
+    }
+  }
+  return (ncpu > 0);
+}
+
+// Returns CPUs this process may run on, in the same format as above.
+std::string AffinityList() {
+  cpu_set_t set;
+  if (sched_getaffinity(0, sizeof(set), &set) != 0) return "?";
+  std::ostringstream os;
+  for (int c=0; c<CPU_SETSIZE; ++c) {
+    if (!CPU_ISSET(c, &set)) continue;
+    int hi = c;
+    while (hi+1 < CPU_SETSIZE && CPU_ISSET(hi+1, &set)) {hi++;}
+    if (os.tellp() > 0) {os << ",";}
+    os << c;
+    if (hi > c) {os << "-" << hi;}
+    c = hi;
+  }
+  return os.str();
+}
+#endif
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn void SelectDevice()
+//! \brief Finds node-local rank, selects GPU by adding --kokkos-device-id to arguments
+//! (argc, argv are replaced by the extended list), and binds host threads to CPUs close
+//! to the GPU.  Must be called after MPI_Init and before Kokkos::initialize.
+
+void SelectDevice(int &argc, char **&argv) {
+#if MPI_PARALLEL_ENABLED
+  MPI_Comm node_comm;
+  MPI_Comm_split_type(global_variable::mpi_comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+                      &node_comm);
+  MPI_Comm_rank(node_comm, &local_rank_);
+  MPI_Comm_size(node_comm, &local_size_);
+  MPI_Comm_free(&node_comm);
+#endif
+  if (DeviceChosenByUser(argc, argv)) return;
+  std::string pci;
+  int ndev = DeviceCount(-1, pci);
+  if (ndev <= 0) return;
+  device_id_ = local_rank_ % ndev;
+  DeviceCount(device_id_, pci_bus_);
+
+  kokkos_args_.assign(argv, argv + argc);
+  kokkos_args_.push_back("--kokkos-device-id=" + std::to_string(device_id_));
+  kokkos_argv_.clear();
+  for (auto &arg : kokkos_args_) {kokkos_argv_.push_back(&arg[0]);}
+  kokkos_argv_.push_back(nullptr);
+  argc = static_cast<int>(kokkos_args_.size());
+  argv = kokkos_argv_.data();
+
+#if defined(__linux__)
+  // only bind if launcher has not already restricted this rank to a subset of CPUs
+  cpu_set_t current, local;
+  if (pci_bus_.empty() || sched_getaffinity(0, sizeof(current), &current) != 0) return;
+  if (CPU_COUNT(&current) < sysconf(_SC_NPROCESSORS_ONLN)) return;
+  std::ifstream is("/sys/bus/pci/devices/" + pci_bus_ + "/local_cpulist");
+  std::string list;
+  if (!std::getline(is, list) || !ParseCPUList(list, local)) return;
+  pinned_ = (sched_setaffinity(0, sizeof(local), &local) == 0);
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Report()
+//! \brief Prints (from rank 0) host, node-local rank, GPU and CPUs of every rank if
+//! <job>/binding_report = true.  Must be called by all ranks.
+
+void Report(ParameterInput *pin) {
+  if (!pin->GetOrAddBoolean("job", "binding_report", false)) return;
+  constexpr int len = 256;
+  char line[len];
+  std::string host = "localhost";
+#if MPI_PARALLEL_ENABLED
+  char name[MPI_MAX_PROCESSOR_NAME];
+  int nlen;
+  MPI_Get_processor_name(name, &nlen);
+  host.assign(name, nlen);
+#endif
+  std::string cpus = "-";
+#if defined(__linux__)
+  cpus = AffinityList();
+  if (pinned_) {cpus += " (bound to GPU)";}
+#endif
+  std::ostringstream os;
+  os << std::setw(6) << global_variable::my_rank << "  " << std::left << std::setw(20)
+     << host << std::right << std::setw(4) << local_rank_ << "/" << std::left
+     << std::setw(4) << local_size_ << std::right << std::setw(6)
+     << ((device_id_ >= 0)? std::to_string(device_id_) : std::string("-")) << "  "
+     << std::left << std::setw(14) << ((pci_bus_.empty())? "-" : pci_bus_) << cpus;
+  std::strncpy(line, os.str().c_str(), len-1);
+  line[len-1] = '\0';
+
+  std::vector<char> all(static_cast<size_t>(len)*global_variable::nranks);
+#if MPI_PARALLEL_ENABLED
+  MPI_Gather(line, len, MPI_CHAR, all.data(), len, MPI_CHAR, 0,
+             global_variable::mpi_comm);
+#else
+  std::memcpy(all.data(), line, len);
+#endif
+  if (global_variable::my_rank != 0) return;
+  std::cout << std::endl << "Placement of ranks:" << std::endl << std::setw(6) << "rank"
+            << "  " << std::left << std::setw(20) << "host" << std::setw(9) << "local"
+            << std::right << std::setw(6) << "GPU" << "  " << std::left << std::setw(14)
+            << "PCI address" << "CPUs" << std::right << std::endl;
+  for (int r=0; r<global_variable::nranks; ++r) {
+    std::cout << &all[static_cast<size_t>(len)*r] << std::endl;
+  }
+  std::cout << std::endl;
+}
+
+} // namespace device_binding
@@ -0,0 +1,35 @@
+#ifndef DRIVER_DEVICE_BINDING_HPP_
+#define DRIVER_DEVICE_BINDING_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file device_binding.hpp
+//  \brief selection of the GPU used by each rank, and binding of host threads to the
+//  cores closest to it, made between MPI_Init and Kokkos::initialize so that correct
+//  placement does not depend on settings of the job launcher.
+//
+//  Ranks on each shared-memory node are numbered from 0 (the node-local rank), and each
+//  is assigned GPU (node-local rank % number of visible GPUs) by adding
+//  --kokkos-device-id to the arguments passed to Kokkos.  Nothing is changed if a device
+//  is already chosen on the command line (--kokkos-device-id, --kokkos-map-device-id-by,
+//  --kokkos-num-devices) or the equivalent KOKKOS_* environment variables.
+//
+//  On Linux, if the launcher has not restricted the CPUs a rank may run on, the process
+//  (and so all host threads created afterwards) is then bound to the CPUs local to the
+//  NUMA domain of its GPU, as listed by the kernel for its PCI device.
+//
+//  The resulting placement of every rank is printed at startup with
+//  <job>/binding_report = true.
+
+class ParameterInput;
+
+namespace device_binding {
+
+void SelectDevice(int &argc, char **&argv);
+void Report(ParameterInput *pin);
+
+} // namespace device_binding
+
+#endif // DRIVER_DEVICE_BINDING_HPP_
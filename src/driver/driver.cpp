@@ -11,6 +11,7 @@
 #include <limits>
 #include <algorithm>
 #include <string> // string
+#include <vector>
 
 #include "athena.hpp"
 #include "globals.hpp"
@@ -23,6 +24,9 @@
 #include "dyn_grmhd/dyn_grmhd.hpp"
 #include "ion-neutral/ion-neutral.hpp"
 #include "radiation/radiation.hpp"
+#include "particles/particles.hpp"
+#include "shearing_box/shearing_box.hpp"
+#include "comm_stats.hpp"
 #include "driver.hpp"
 
 #if MPI_PARALLEL_ENABLED
@@ -50,6 +54,13 @@
 // The 2x RHS evaluations of Div(F) and source terms per stage is avoided by adding
 // another weighted average / caching of these terms each stage. The API and framework
 // is extensible to three register 3S* methods, although none are currently implemented.
+//
+// The 2N low-storage integrators (lsrk3, lsrk4) are only implemented for vacuum Z4c, and
+// use the RHS register itself as the second register, so no copy of U^n is kept:
+//
+//    dU^{l} = A_l*dU^{l-1} + RHS(U^{l-1}),    U^{l} = U^{l-1} + B_l*dt*dU^{l},
+//
+// with A_1 = 0.  Coefficients are stored in lsrk_a and lsrk_b.
 
 // Notation: exclusively using "stage", equivalent in lit. to "substage" or "substep"
 // (infrequently "step"), to refer to the intermediate values of U^{l} between each
@@ -88,6 +99,75 @@ Driver::Driver(ParameterInput *pin, Mesh *pmesh, Real wtlim, Kokkos::Timer* ptim
     nlim = pin->GetOrAddInteger("time", "nlim", -1);
     ndiag = pin->GetOrAddInteger("time", "ndiag", 1);
 
+    // select how ExecuteTaskList() waits on communications: "spin" repeatedly polls all
+    // task lists, "event" blocks until at least one outstanding receive completes
+    std::string scheduler = pin->GetOrAddString("time", "task_scheduler", "spin");
+    if (scheduler.compare("event") == 0) {
+      event_driven_tl = true;
+    } else if (scheduler.compare("spin") != 0) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+         << std::endl << "task_scheduler=" << scheduler << " not implemented. "
+         << "Valid choices are [spin,event]." << std::endl;
+      exit(EXIT_FAILURE);
+    }
+
+    // non-blocking global reduction of timestep, overlapped with start of next cycle.
+    // Not used with particles (pushed before first stage) or Z4c (whose task lists
+    // before first stage may depend on dt)
+    if (pin->GetOrAddBoolean("time", "nonblocking_dt", false)) {
+      MeshBlockPack *pmbp = pmesh->pmb_pack;
+      if (pmbp->ppart != nullptr || pmbp->pz4c != nullptr) {
+        if (global_variable::my_rank == 0) {
+          std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__
+                    << std::endl << "<time>/nonblocking_dt is ignored with particles "
+                    << "or Z4c" << std::endl;
+        }
+      } else {
+        nonblocking_dt = true;
+      }
+    }
+
+    // run available Tasks on critical path (and sends) first, see TaskList::BuildOrder
+    task_priority = pin->GetOrAddBoolean("time", "task_priority", false);
+
+    // counters of bytes and messages sent, reported every ndiag cycles
+    comm_stats::Enable(pin, pmesh);
+
+    // built-in profiler timing TaskLists, Tasks, and kernels
+    if (pin->GetOrAddInteger("time", "profile_ncycles", 0) > 0) {
+      pprof = std::make_unique<Profiler>(pin);
+    }
+
+    // in-memory checkpoints used to roll back and retry cycles that fail
+    if (pin->GetOrAddInteger("time", "checkpoint_ncycles", 0) > 0) {
+      pckpt = std::make_unique<CheckpointRing>(pin);
+      z4c::Z4c *pz4c = pmesh->pmb_pack->pz4c;
+      if (pz4c != nullptr && pz4c->multirate_ratio > 1) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<time>/checkpoint_ncycles cannot be used with "
+                  << "<z4c>/multirate_ratio > 1" << std::endl;
+        exit(EXIT_FAILURE);
+      }
+    }
+
+    // host thread that progresses MPI messages while kernels run
+    if (pin->GetOrAddInteger("time", "mpi_progress_usec", 0) > 0) {
+      pprogress = std::make_unique<MPIProgress>(pin);
+    }
+
+    // auto-tuning of launch parameters of par_for_outer() kernels, with tuning file
+    // specific to execution space (and its concurrency, i.e. the type of device)
+    if (pin->GetOrAddBoolean("time", "tune_kernels", false)) {
+      DevExeSpace exec;
+      kernel_tuner::Initialize(pin, std::string(exec.name()) + " concurrency=" +
+                               std::to_string(exec.concurrency()));
+    }
+
+    // matrix elements of implicit stages not set by an ImEx integrator are zero
+    for (int r=0; r<4; ++r) {
+      for (int s=0; s<4; ++s) {a_twid[r][s] = 0.0;}
+    }
+
     if (integrator == "rk1") {
       // RK1: first-order Runge-Kutta / the forward Euler (FE) method
       nimp_stages = 0;
@@ -254,13 +334,73 @@ Driver::Driver(ParameterInput *pin, Mesh *pmesh, Real wtlim, Kokkos::Timer* ptim
       a_twid[1][1] = 0.0;
 
       a_impl = gamma;
+    } else if (integrator == "lsrk3") {
+      // 2N low-storage RK3: Williamson (1980), J. Comput. Phys. 35, 48
+      low_storage = true;
+      nimp_stages = 0;
+      nexp_stages = 3;
+      cfl_limit = 1.0;
+      lsrk_a[0] = 0.0;
+      lsrk_a[1] = -5.0/9.0;
+      lsrk_a[2] = -153.0/128.0;
+
+      lsrk_b[0] = 1.0/3.0;
+      lsrk_b[1] = 15.0/16.0;
+      lsrk_b[2] = 8.0/15.0;
+    } else if (integrator == "lsrk4") {
+      // 2N low-storage RK4(3)5: Carpenter & Kennedy (1994), NASA TM-109112, solution 3
+      low_storage = true;
+      nimp_stages = 0;
+      nexp_stages = 5;
+      cfl_limit = 1.0;
+      lsrk_a[0] = 0.0;
+      lsrk_a[1] = -567301805773.0/1357537059087.0;
+      lsrk_a[2] = -2404267990393.0/2016746695238.0;
+      lsrk_a[3] = -3550918686646.0/2091501179385.0;
+      lsrk_a[4] = -1275806237668.0/842570457699.0;
+
+      lsrk_b[0] = 1432997174477.0/9575080441755.0;
+      lsrk_b[1] = 5161836677717.0/13612068292357.0;
+      lsrk_b[2] = 1720146321549.0/2090206949498.0;
+      lsrk_b[3] = 3134564353537.0/4481467310338.0;
+      lsrk_b[4] = 2277821191437.0/14882151754819.0;
     // Error, unrecognized integrator name.
     } else {
       std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
          << std::endl << "integrator=" << integrator << " not implemented. "
-         << "Valid choices are [rk1,rk2,rk3,imex2,imex3]." << std::endl;
+         << "Valid choices are [rk1,rk2,rk3,rk4,imex2,imex3,imex+,lsrk3,lsrk4]."
+         << std::endl;
       exit(EXIT_FAILURE);
     }
+
+    // Assign storage slots to the stiff source terms R(U^s) of each implicit stage of
+    // ImEx integrators.  R(U^s) is computed at implicit stage s+1, and is used in each
+    // later stage r+2 with a_twid[r][s] != 0.  Terms that are never used are not stored
+    // (imp_slot = -1), and slots are reused once the term they hold has been used for
+    // the last time, so that only nimp_slots <= nimp_stages terms are ever stored.
+    nimp_slots = 0;
+    for (int s=0; s<4; ++s) {imp_slot[s] = -1;}
+    if (nimp_stages > 0) {
+      int last_use[4];
+      for (int s=0; s<=nexp_stages; ++s) {
+        last_use[s] = -1;
+        for (int r=s; r<=nexp_stages; ++r) {
+          if (a_twid[r][s] != 0.0) {last_use[s] = r;}
+        }
+      }
+      for (int s=0; s<=nexp_stages; ++s) {
+        if (last_use[s] < 0) continue;
+        // find first slot not holding a term still to be used after stage s+1
+        bool busy[4] = {false, false, false, false};
+        for (int t=0; t<s; ++t) {
+          if (imp_slot[t] >= 0 && last_use[t] + 2 > s + 1) {busy[imp_slot[t]] = true;}
+        }
+        int l = 0;
+        while (busy[l]) {++l;}
+        imp_slot[s] = l;
+        nimp_slots = std::max(nimp_slots, l+1);
+      }
+    }
   }
 }
 
@@ -270,22 +410,145 @@ Driver::Driver(ParameterInput *pin, Mesh *pmesh, Real wtlim, Kokkos::Timer* ptim
 //! Integer argument "stage" can be used to indicate at which step in overall algorithm
 //! these tasks are to be performed, e.g. which stage of a multi-stage RK integrator.
 
+//!
+//! With the event-driven scheduler, if a full pass through the TaskList completes no
+//! tasks then every remaining task is waiting on an MPI receive. Rather than spinning
+//! on DoAvailable() (and MPI_Test), the rank then blocks in WaitForPendingRecvs() until
+//! at least one outstanding receive completes.
+
 void Driver::ExecuteTaskList(Mesh *pm, std::string tl, int stage) {
   MeshBlockPack* pmbp = pm->pmb_pack;
   for (int p=0; p<(pm->nmb_packs_thisrank); ++p) {
     if (!(pmbp->tl_map[tl]->Empty())) {pmbp->tl_map[tl]->Reset();}
   }
+  // with the profiler, passes in which no Task completes are counted as wait time
+  bool prof = (pprof != nullptr);
+  double t_start = (prof)? Profiler::Now() : 0.0, t_wait = 0.0;
   int npack_left = (pm->nmb_packs_thisrank);
   while (npack_left > 0) {
+    bool stuck = false;
+    double t_pass = (prof)? Profiler::Now() : 0.0;
     if (pmbp->tl_map[tl]->Empty()) {
       npack_left--;
     } else {
       if (!pmbp->tl_map[tl]->IsComplete()) {
         auto status = pmbp->tl_map[tl]->DoAvailable(this, stage);
         if (status == TaskListStatus::complete) { npack_left--; }
+        if (status == TaskListStatus::stuck) { stuck = true; }
       }
     }
+#if MPI_PARALLEL_ENABLED
+    if (event_driven_tl && stuck && (npack_left > 0)) {WaitForPendingRecvs(pm);}
+#endif
+    if (prof && stuck) {t_wait += Profiler::Now() - t_pass;}
+  }
+  if (prof && !(pmbp->tl_map[tl]->Empty())) {
+    pprof->AddTaskListTime(tl, t_start, Profiler::Now(), t_wait);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Driver::ExecuteSpacetimeStep()
+//! \brief With multirate integration, advances the spacetime (Z4c) over all stages of
+//! its step (of length st_dt, spanning one or more matter timesteps).  Called at the
+//! start of the first cycle of each spacetime step, before the matter stages.
+
+void Driver::ExecuteSpacetimeStep(Mesh *pm) {
+  z4c::Z4c *pz4c = pm->pmb_pack->pz4c;
+  pz4c->BeginSpacetimeStep();
+  Real dt = pm->dt;
+  pm->dt = pz4c->st_dt;
+  for (int stage=1; stage<=(nexp_stages); ++stage) {
+    ExecuteTaskList(pm, "z4c_before_stagen", stage);
+    ExecuteTaskList(pm, "z4c_stagen", stage);
+    ExecuteTaskList(pm, "z4c_after_stagen", stage);
   }
+  pm->dt = dt;
+  pz4c->EndSpacetimeStep();
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Driver::ExecuteRadiationSubcycles()
+//! \brief With <radiation>/nsubcycle = N > 1, advances radiation over the timestep of
+//! the fluid with N steps of length dt/N (each with all stages of the integrator), after
+//! the fluid stages.  The radiation source terms update the fluid in every step.
+
+void Driver::ExecuteRadiationSubcycles(Mesh *pm) {
+  radiation::Radiation *prad = pm->pmb_pack->prad;
+  Real time = pm->time, dt = pm->dt;
+  pm->dt = dt/static_cast<Real>(prad->nsubcycle);
+  for (int n=0; n<(prad->nsubcycle); ++n) {
+    pm->time = time + n*(pm->dt);
+    for (int stage=1; stage<=(nexp_stages); ++stage) {
+      ExecuteTaskList(pm, "rad_before_stagen", stage);
+      ExecuteTaskList(pm, "rad_stagen", stage);
+      ExecuteTaskList(pm, "rad_after_stagen", stage);
+    }
+  }
+  pm->time = time;
+  pm->dt = dt;
+  prad->ExchangeFluid(this);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Driver::WaitForPendingRecvs()
+//! \brief Blocks until at least one of the outstanding non-blocking receives posted by
+//! any physics module on this rank completes.  Completed requests are freed by MPI and
+//! set to MPI_REQUEST_NULL in the boundary buffers, so subsequent MPI_Test() calls in the
+//! RecvAndUnpack functions return immediately.  Returns without waiting if there are no
+//! outstanding receives (in which case the TaskList simply spins).
+
+void Driver::WaitForPendingRecvs(Mesh *pm) {
+#if MPI_PARALLEL_ENABLED
+  MeshBlockPack* pmbp = pm->pmb_pack;
+  std::vector<MPI_Request*> pending;
+  if (pmbp->phydro != nullptr) {
+    pmbp->phydro->pbval_u->GetPendingRecvs(pending);
+    if (pmbp->phydro->porb_u != nullptr) {pmbp->phydro->porb_u->GetPendingRecvs(pending);}
+    if (pmbp->phydro->psbox_u != nullptr) {
+      pmbp->phydro->psbox_u->GetPendingRecvs(pending);
+    }
+  }
+  if (pmbp->pmhd != nullptr) {
+    pmbp->pmhd->pbval_u->GetPendingRecvs(pending);
+    pmbp->pmhd->pbval_b->GetPendingRecvs(pending);
+    if (pmbp->pmhd->porb_u != nullptr) {pmbp->pmhd->porb_u->GetPendingRecvs(pending);}
+    if (pmbp->pmhd->porb_b != nullptr) {pmbp->pmhd->porb_b->GetPendingRecvs(pending);}
+    if (pmbp->pmhd->psbox_u != nullptr) {pmbp->pmhd->psbox_u->GetPendingRecvs(pending);}
+    if (pmbp->pmhd->psbox_b != nullptr) {pmbp->pmhd->psbox_b->GetPendingRecvs(pending);}
+  }
+  if (pmbp->prad != nullptr) {
+    pmbp->prad->pbval_i->GetPendingRecvs(pending);
+  }
+  if (pmbp->pz4c != nullptr) {
+    pmbp->pz4c->pbval_u->GetPendingRecvs(pending);
+    pmbp->pz4c->pbval_weyl->GetPendingRecvs(pending);
+  }
+  if (pmbp->ppart != nullptr) {
+    pmbp->ppart->pbval_part->GetPendingRecvs(pending);
+  }
+  int nreq = static_cast<int>(pending.size());
+  if (nreq == 0) return;
+
+  // MPI_Waitsome requires a contiguous array of requests.  Copy back afterwards, since
+  // completed requests are deallocated and set to MPI_REQUEST_NULL by MPI.
+  std::vector<MPI_Request> reqs(nreq);
+  std::vector<int> indices(nreq);
+  for (int n=0; n<nreq; ++n) {reqs[n] = *(pending[n]);}
+  int ncomplete;
+  int ierr = MPI_Waitsome(nreq, reqs.data(), &ncomplete, indices.data(),
+                          MPI_STATUSES_IGNORE);
+  if (ierr != MPI_SUCCESS) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "MPI error in waiting on non-blocking receives"
+              << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  for (int n=0; n<nreq; ++n) {*(pending[n]) = reqs[n];}
+#endif
   return;
 }
 
@@ -332,6 +595,25 @@ void Driver::Initialize(Mesh *pmesh, ParameterInput *pin, Outputs *pout, bool re
   run_time_.reset();
   nmb_updated_ = 0;
 
+  // low-storage integrators keep no copy of U^n, so are only implemented for vacuum Z4c
+  if (low_storage) {
+    MeshBlockPack *pmbp = pmesh->pmb_pack;
+    if (pmbp->pz4c == nullptr || pmbp->phydro != nullptr || pmbp->pmhd != nullptr ||
+        pmbp->prad != nullptr || pmbp->pionn != nullptr || pmbp->ppart != nullptr ||
+        pmbp->pturb != nullptr || pmbp->ptmunu != nullptr) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+          << std::endl << "integrator=" << integrator << " can only be used for "
+          << "vacuum Z4c" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    if (pmbp->pz4c->halo_interval > 1) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+          << std::endl << "integrator=" << integrator << " cannot be used with "
+          << "<z4c>/halo_exchange_interval > 1" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+  }
+
   // allocate memory for stiff source terms with ImEx integrators
   // only implemented for ion-neutral two fluid for now
   ion_neutral::IonNeutral *pionn = pmesh->pmb_pack->pionn;
@@ -347,7 +629,8 @@ void Driver::Initialize(Mesh *pmesh, ParameterInput *pin, Outputs *pout, bool re
     int ncells1 = indcs.nx1 + 2*(indcs.ng);
     int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
     int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
-    Kokkos::realloc(impl_src, nimp_stages, nmb, 8, ncells3, ncells2, ncells1);
+    ReallocFirstTouch(impl_src, std::max(nimp_slots,1), nmb, 4, ncells3, ncells2,
+                      ncells1);
   }
 
   return;
@@ -372,20 +655,75 @@ void Driver::Execute(Mesh *pmesh, ParameterInput *pin, Outputs *pout) {
     if (wall_time > 0.) {
       elapsed_time = UpdateWallClock();
     }
+
+    // with the profiler, time every Task by calling it through the TaskList wrapper
+    if (pprof != nullptr) {
+      Profiler *pp = pprof.get();
+      for (auto &it : pmesh->pmb_pack->tl_map) {
+        std::string name = it.first;
+        it.second->task_wrapper = [pp, name](int n, Task &task, Driver *d, int s) {
+          double t0 = Profiler::Now();
+          TaskStatus status = task(d,s);
+          pp->AddTaskTime(name, n, t0, Profiler::Now(), (status == TaskStatus::complete));
+          return status;
+        };
+      }
+    }
+    if (task_priority) {
+      for (auto &it : pmesh->pmb_pack->tl_map) {it.second->prioritize = true;}
+    }
+    if (pprogress != nullptr) {pprogress->Start();}
+
     while ((pmesh->time < tlim) && (pmesh->ncycle < nlim || nlim < 0) &&
            (elapsed_time < wall_time)) {
-      if (global_variable::my_rank == 0) {OutputCycleDiagnostics(pmesh);}
+      if (global_variable::my_rank == 0 && !(nonblocking_dt)) {
+        OutputCycleDiagnostics(pmesh);
+      }
+      if (pckpt != nullptr) {pckpt->BeginCycle(pmesh);}
 
       // Execute TaskLists
       // Work before time integrator indicated by "0" in stage
       ExecuteTaskList(pmesh, "before_timeintegrator", 0);
 
+      // with non-blocking timestep reduction, post receives of first stage before
+      // waiting for dt
+      if (nonblocking_dt) {
+        ExecuteTaskList(pmesh, "before_stagen", 1);
+        pmesh->FinishNewTimeStep();
+        if (global_variable::my_rank == 0) {OutputCycleDiagnostics(pmesh);}
+      }
+
       // time-integrator tasks for each stage of integrator
+      // With measured-cost load balancing, time spent in stagen tasks is recorded
+      bool lb_timing = (pmesh->adaptive &&
+                        (pmesh->pmr->measure_cost || pmesh->pmr->measure_weight));
+      z4c::Z4c *pz4c = pmesh->pmb_pack->pz4c;
+      if (pz4c != nullptr && pz4c->spacetime_step) {ExecuteSpacetimeStep(pmesh);}
       for (int stage=1; stage<=(nexp_stages); ++stage) {
-        ExecuteTaskList(pmesh, "before_stagen", stage);
+        if (stage > 1 || !(nonblocking_dt)) {
+          ExecuteTaskList(pmesh, "before_stagen", stage);
+        }
+        if (lb_timing) {
+          Kokkos::fence();
+          lb_timer_.reset();
+        }
         ExecuteTaskList(pmesh, "stagen", stage);
+        if (lb_timing) {
+          Kokkos::fence();
+          pmesh->pmr->lb_time += lb_timer_.seconds();
+        }
         ExecuteTaskList(pmesh, "after_stagen", stage);
       }
+      if (lb_timing) {pmesh->pmr->lb_ncycle++;}
+      radiation::Radiation *prad = pmesh->pmb_pack->prad;
+      if (prad != nullptr && prad->nsubcycle > 1) {ExecuteRadiationSubcycles(pmesh);}
+
+      // operator-split super-time-stepping of diffusion terms over full timestep
+      for (int stage=1; stage<=(pmesh->nsts_stages); ++stage) {
+        ExecuteTaskList(pmesh, "before_sts", stage);
+        ExecuteTaskList(pmesh, "sts", stage);
+        ExecuteTaskList(pmesh, "after_sts", stage);
+      }
 
       // Work after time integrator indicated by "1" in stage
       ExecuteTaskList(pmesh, "after_timeintegrator", 1);
@@ -394,8 +732,19 @@ void Driver::Execute(Mesh *pmesh, ParameterInput *pin, Outputs *pout) {
       // increment time, ncycle, etc.
       pmesh->time = pmesh->time + pmesh->dt;
       pmesh->ncycle++;
+      // repeat cycles since last checkpoint with smaller timestep if this one failed
+      if (pckpt != nullptr && pckpt->CycleFailed(pmesh)) {
+        pckpt->Rollback(this, pmesh);
+        continue;
+      }
       nmb_updated_ += pmesh->nmb_total;
       npart_updated_ += pmesh->nprtcl_total;
+      if (pprof != nullptr && (pmesh->ncycle % pprof->ncycle_out == 0)) {
+        pprof->Report(pmesh);
+      }
+      if (comm_stats::enabled && (pmesh->ncycle % ndiag == 0)) {
+        comm_stats::Report(pmesh);
+      }
       // load balancing efficiency
       if (global_variable::nranks > 1) {
         int minnmb = std::numeric_limits<int>::max();
@@ -414,23 +763,42 @@ void Driver::Execute(Mesh *pmesh, ParameterInput *pin, Outputs *pout) {
         float tlim_32 = static_cast<float>(tlim);
         int &dcycle_ = out->out_params.dcycle;
 
-        if (((out->out_params.dt > 0.0) && ((time_32 >= next_32) && (time_32<tlim_32))) ||
-            ((dcycle_ > 0) && ((pmesh->ncycle)%(dcycle_) == 0)) ) {
+        bool due =
+            ((out->out_params.dt > 0.0) && ((time_32 >= next_32) && (time_32<tlim_32))) ||
+            ((dcycle_ > 0) && ((pmesh->ncycle)%(dcycle_) == 0));
+        bool triggered = !due && out->Triggered(pmesh);
+        if (due || triggered) {
+          Real last_time = out->out_params.last_time;
           out->LoadOutputData(pmesh);
           out->WriteOutputFile(pmesh, pin);
+          // per-cell C2P statistics are accumulated between outputs
+          if (out->out_params.variable.compare("mhd_c2p") == 0) {
+            Kokkos::deep_copy(pmesh->pmb_pack->pmhd->c2p_count, 0.0);
+          }
+          // outputs triggered by events do not shift times of outputs at fixed intervals
+          if (triggered && out->out_params.dt > 0.0 && last_time >= 0.0) {
+            out->out_params.last_time = last_time;
+            pin->SetReal(out->out_params.block_name, "last_time", last_time);
+          }
+          if (out->out_params.trigger_dmax > 0.0 || out->out_params.trigger_new_level) {
+            out->ResetTriggers(pmesh);
+          }
         }
       }
 
       // AMR
       if (pmesh->adaptive) {pmesh->pmr->AdaptiveMeshRefinement(this, pin);}
       // compute new timestep AFTER all Meshblocks refined/derefined
-      pmesh->NewTimeStep(tlim);
+      pmesh->NewTimeStep(tlim, nonblocking_dt);
 
       // Update wall clock time if needed.
       if (wall_time > 0.) {
         elapsed_time = UpdateWallClock();
       }
     }  // end while
+    // complete reduction of timestep posted in last cycle
+    pmesh->FinishNewTimeStep();
+    if (pprogress != nullptr) {pprogress->Stop();}
   }    // end of (time_evolution != tstatic) clause
   return;
 }
@@ -441,18 +809,24 @@ void Driver::Execute(Mesh *pmesh, ParameterInput *pin, Outputs *pout) {
 //!  and printing diagnostic messages
 
 void Driver::Finalize(Mesh *pmesh, ParameterInput *pin, Outputs *pout) {
-  // cycle through output Types and load data / write files
-  //  This design allows for asynchronous outputs to implemented in the future.
+  // cycle through output Types and load data / write files, then complete any
+  // asynchronous writes still in flight
   for (auto &out : pout->pout_list) {
     out->LoadOutputData(pmesh);
     out->WriteOutputFile(pmesh, pin);
   }
+  for (auto &out : pout->pout_list) {
+    out->FinishOutputFile();
+  }
 
   // call any problem specific functions to do work after main loop
   if (pmesh->pgen->pgen_final_func != nullptr) {
     (pmesh->pgen->pgen_final_func)(pin, pmesh);
   }
 
+  // save launch parameters found by auto-tuner
+  kernel_tuner::Finalize();
+
   float exe_time = run_time_.seconds();
 
   if (time_evolution != TimeEvolution::tstatic) {
@@ -460,7 +834,7 @@ void Driver::Finalize(Mesh *pmesh, ParameterInput *pin, Outputs *pout) {
     // Collect number of MeshBlocks communicated during load balancing across all ranks
     if (pmesh->adaptive) {
       MPI_Allreduce(MPI_IN_PLACE, &(pmesh->pmr->nmb_sent_thisrank), 1, MPI_INT, MPI_SUM,
-                    MPI_COMM_WORLD);
+                    global_variable::mpi_comm);
     }
 #endif
     if (global_variable::my_rank == 0) {
@@ -498,6 +872,14 @@ void Driver::Finalize(Mesh *pmesh, ParameterInput *pin, Outputs *pout) {
       std::cout << "cpu time used  = " << exe_time << std::endl;
       std::cout << "zone-cycles/cpu_second = " << zcps << std::endl;
       std::cout << "particle-updates/cpu_second = " << pups << std::endl;
+
+      // Print estimated reduction in MeshBlock-updates from subcycling each level
+      if (pmesh->report_level_dt && pmesh->multilevel && pmesh->nmb_updated_sub > 0.0) {
+        std::cout << std::endl << "MeshBlock-updates with subcycling (estimated) = "
+                  << pmesh->nmb_updated_sub << std::endl << "estimated speed-up from "
+                  << "subcycling = " << (pmesh->nmb_updated_glob/pmesh->nmb_updated_sub)
+                  << std::endl;
+      }
     }
   }
   return;
@@ -533,7 +915,7 @@ Real Driver::UpdateWallClock() {
     tnow = pwall_clock_->seconds();
   }
 #if MPI_PARALLEL_ENABLED
-  MPI_Bcast(&tnow, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  MPI_Bcast(&tnow, 1, MPI_DOUBLE, 0, global_variable::mpi_comm);
 #endif
   return tnow;
 }
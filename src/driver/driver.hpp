@@ -19,6 +19,9 @@
 #include "parameter_input.hpp"
 #include "outputs/outputs.hpp"
 #include "pgen/pgen.hpp"
+#include "profiler.hpp"
+#include "checkpoint_ring.hpp"
+#include "mpi_progress.hpp"
 
 //----------------------------------------------------------------------------------------
 //! \class Driver
@@ -30,7 +33,7 @@ class Driver {
 
   // data
   TimeEvolution time_evolution;
-  DvceArray6D<Real> impl_src;  // stiff source terms used in ImEx integrators
+  DvceArray6D<Real> impl_src;  // stiff source terms used in ImEx integrators (by slot)
 
   // folowing data only relevant for runs involving time evolution
   Real tlim;      // stopping time
@@ -40,12 +43,30 @@ class Driver {
   std::string integrator;          // integrator name (rk1, rk2, rk3)
   int nimp_stages;                 // number of implicit stages (ImEx only)
   int nexp_stages;                 // number of explicit stages (both SSP-RK and ImEx)
+  int nimp_slots = 0;              // number of stiff source terms stored (ImEx only)
+  int imp_slot[4];                 // slot in impl_src of R(U^s) of each implicit stage
   Real gam0[4], gam1[4], beta[4];  // weights and fractional timestep per explicit stage
   Real delta[4];                   // weights for updating the intermediate stage (u1)
   Real a_twid[4][4], a_impl;       // matrix elements for implicit stages in ImEx
+  bool low_storage = false;        // true for 2N (Williamson) low-storage integrators
+  Real lsrk_a[5], lsrk_b[5];       // weights per stage of 2N low-storage integrators
   Real cfl_limit;                  // maximum CFL number for integrator
   Kokkos::Timer* pwall_clock_;     // timer for tracking the wall clock
   Real wall_time;
+  // when true, ExecuteTaskList blocks in MPI_Waitsome() whenever TaskLists are stuck
+  // waiting on communications, rather than spinning on DoAvailable()
+  bool event_driven_tl = false;
+  // when true, the global reduction of the timestep at the end of each cycle completes
+  // only after receives for the first stage of the next cycle are posted
+  bool nonblocking_dt = false;
+  // when true, TaskLists run available Tasks in order of priority (<time>/task_priority)
+  bool task_priority = false;
+  // times TaskLists, Tasks, and kernels when <time>/profile_ncycles > 0
+  std::unique_ptr<Profiler> pprof;
+  // in-memory checkpoints to roll back failed cycles when <time>/checkpoint_ncycles > 0
+  std::unique_ptr<CheckpointRing> pckpt;
+  // host thread progressing MPI messages when <time>/mpi_progress_usec > 0
+  std::unique_ptr<MPIProgress> pprogress;
 
   // functions
   void ExecuteTaskList(Mesh *pm, std::string tl, int stage);
@@ -56,10 +77,14 @@ class Driver {
 
  private:
   Kokkos::Timer run_time_;      // generalized timer for cpu/gpu/etc
+  Kokkos::Timer lb_timer_;      // timer for measured-cost load balancing
   std::uint64_t nmb_updated_;   // running total of MB updated during run
   std::uint64_t npart_updated_; // running total of particles updated during run
   float lb_efficiency_;         // measure of how efficient was load balancing
   void OutputCycleDiagnostics(Mesh *pm);
   Real UpdateWallClock();
+  void WaitForPendingRecvs(Mesh *pm);
+  void ExecuteSpacetimeStep(Mesh *pm);
+  void ExecuteRadiationSubcycles(Mesh *pm);
 };
 #endif // DRIVER_DRIVER_HPP_
@@ -0,0 +1,156 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file kernel_tuner.cpp
+//  \brief implements functions of the kernel auto-tuner
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "kernel_tuner.hpp"
+
+namespace kernel_tuner {
+
+bool enabled = false;
+int ntrials = 2;
+
+namespace {
+std::map<std::pair<std::string, size_t>, KernelState> states_;
+std::string file_;         // name of tuning file
+std::string exec_space_;   // name of execution space, written to header of tuning file
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn KernelState &State()
+//! \brief Returns state of tuning of kernel with given name and scratch size, which is
+//! created (with no candidates) on first call.
+
+KernelState &State(const std::string &name, size_t scr_size) {
+  return states_[std::make_pair(name, scr_size)];
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void KernelState::Record()
+//! \brief Records time of one call with the current candidate, and moves on to the next
+//! candidate after ntrials calls.  After the last candidate, the fastest is selected.
+
+void KernelState::Record(double time) {
+  if (times.size() != candidates.size()) {
+    times.assign(candidates.size(), std::numeric_limits<double>::max());
+  }
+  times[icand] = std::min(times[icand], time);
+  if (++itrial < ntrials) return;
+  itrial = 0;
+  if (++icand < static_cast<int>(candidates.size())) return;
+  int ibest = 0;
+  for (int n=1; n<static_cast<int>(candidates.size()); ++n) {
+    if (times[n] < times[ibest]) {ibest = n;}
+  }
+  best = candidates[ibest];
+  best_time = times[ibest];
+  tuned = true;
+  validated = true;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Initialize()
+//! \brief Enables tuner, and reads winners of previous runs from tuning file (if it
+//! exists and was written for the same execution space).  Each line of the file after
+//! the header contains the kernel name, scratch size, team size, vector length, scratch
+//! level and time.
+
+void Initialize(ParameterInput *pin, const std::string &exec_space_name) {
+  if (enabled) return;
+  enabled = true;
+  ntrials = pin->GetOrAddInteger("time", "tune_ntrials", 2);
+  file_ = pin->GetOrAddString("time", "tune_file", "kernel_tuning.txt");
+  exec_space_ = exec_space_name;
+  if (ntrials < 1) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "tune_ntrials=" << ntrials << " must be > 0" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+
+  std::ifstream is(file_);
+  if (!is.is_open()) return;
+  std::string line;
+  std::getline(is, line);
+  if (line.compare("# " + exec_space_) != 0) {
+    if (global_variable::my_rank == 0) {
+      std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+                << "Kernel tuning file " << file_ << " was written for different "
+                << "execution space, kernels will be re-tuned" << std::endl;
+    }
+    return;
+  }
+  int nread = 0;
+  while (std::getline(is, line)) {
+    std::istringstream ls(line);
+    std::string name;
+    size_t scr_size;
+    TeamConfig cfg;
+    double time;
+    if (ls >> name >> scr_size >> cfg.team_size >> cfg.vector_length >> cfg.scr_level
+           >> time) {
+      KernelState &ks = State(name, scr_size);
+      ks.best = cfg;
+      ks.best_time = time;
+      ks.tuned = true;
+      ks.validated = false;
+      nread++;
+    }
+  }
+  if (global_variable::my_rank == 0) {
+    std::cout << "Read tuned launch parameters of " << nread << " kernels from "
+              << file_ << std::endl;
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Finalize()
+//! \brief Writes winners to tuning file (rank 0 only).  Kernels still being tuned are
+//! not written, and so will be tuned again in the next run.
+
+void Finalize() {
+  if (!enabled || global_variable::my_rank != 0) return;
+  std::ofstream os(file_);
+  if (!os.is_open()) {
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Could not open kernel tuning file " << file_ << std::endl;
+    return;
+  }
+  os << "# " << exec_space_ << std::endl;
+  int nwrite = 0, nuntuned = 0;
+  for (auto &it : states_) {
+    const KernelState &ks = it.second;
+    // skip kernels whose names cannot be read back
+    if (it.first.first.find_first_of(" \t") != std::string::npos) continue;
+    if (!ks.tuned) {
+      nuntuned++;
+      continue;
+    }
+    os << it.first.first << " " << it.first.second << " " << ks.best.team_size << " "
+       << ks.best.vector_length << " " << ks.best.scr_level << " " << std::scientific
+       << std::setprecision(3) << ks.best_time << std::endl;
+    nwrite++;
+  }
+  std::cout << "Wrote tuned launch parameters of " << nwrite << " kernels to " << file_;
+  if (nuntuned > 0) {std::cout << " (" << nuntuned << " kernels not fully tuned)";}
+  std::cout << std::endl;
+}
+
+} // namespace kernel_tuner
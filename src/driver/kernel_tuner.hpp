@@ -0,0 +1,65 @@
+#ifndef DRIVER_KERNEL_TUNER_HPP_
+#define DRIVER_KERNEL_TUNER_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file kernel_tuner.hpp
+//  \brief auto-tuner for the launch parameters (team size, vector length, and scratch
+//  level) of kernels launched with par_for_outer().  Enabled with <time>/tune_kernels =
+//  true.  The first tune_ntrials calls of each named kernel (with a given scratch size)
+//  are then run with each candidate in turn, fenced and timed, after which the fastest
+//  candidate is used for all remaining calls.  Winners are written (by rank 0) at the
+//  end of the run to <time>/tune_file, and read back at the start of later runs, so
+//  that tuning is only done once per machine.  Entries in the file are ignored if it was
+//  written for a different execution space, or if they are not valid for the current
+//  kernel (e.g. if the scratch memory does not fit).
+//
+//  Declarations here are used by par_for_outer() in athena.hpp, so this file must not
+//  include any other headers from AthenaK.
+
+#include <map>
+#include <string>
+#include <vector>
+
+class ParameterInput;
+
+namespace kernel_tuner {
+
+//----------------------------------------------------------------------------------------
+//! \struct TeamConfig
+//  \brief launch parameters of one kernel.  Team size or vector length of 0 means
+//  Kokkos::AUTO.
+
+struct TeamConfig {
+  int team_size;
+  int vector_length;
+  int scr_level;
+};
+
+//----------------------------------------------------------------------------------------
+//! \struct KernelState
+//  \brief candidates, timings and winner for one kernel
+
+struct KernelState {
+  std::vector<TeamConfig> candidates;
+  std::vector<double> times;  // fastest time of each candidate
+  int icand = 0, itrial = 0;  // candidate and trial of next call
+  bool tuned = false;         // winner is known (and stored in best)
+  bool validated = false;     // winner read from file has been checked for this kernel
+  TeamConfig best;
+  double best_time = 0.0;
+  const TeamConfig &Current() const {return (tuned)? best : candidates[icand];}
+  void Record(double time);
+};
+
+extern bool enabled;
+extern int ntrials;
+KernelState &State(const std::string &name, size_t scr_size);
+void Initialize(ParameterInput *pin, const std::string &exec_space_name);
+void Finalize();
+
+} // namespace kernel_tuner
+
+#endif // DRIVER_KERNEL_TUNER_HPP_
@@ -0,0 +1,166 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file memory_tracker.cpp
+//  \brief implements accounting of device memory used by each module
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mesh/mesh.hpp"
+#include "memory_tracker.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
+namespace memory_tracker {
+
+namespace {
+// modules to which memory is attributed.  List is fixed so that usage can be reduced
+// over ranks.  Last entry collects all memory not allocated in any Scope.
+const char *module_names_[] = {"mesh", "coordinates", "hydro", "mhd", "ion-neutral",
+                               "radiation", "turbulence", "z4c", "adm", "dyngr", "tmunu",
+                               "particles", "bvals", "amr", "outputs", "other"};
+constexpr int nmodules_ = sizeof(module_names_)/sizeof(module_names_[0]);
+constexpr int iother_ = nmodules_ - 1;
+constexpr int iamr_ = nmodules_ - 3;
+
+bool enabled_ = false;
+int nmb_predict_ = 0;
+std::vector<int> scopes_;                                    // stack of active Scopes
+std::map<std::string, int> label_module_;                    // module of each label
+std::map<const void*, std::pair<int, uint64_t>> allocs_;     // module and size of each
+double current_[nmodules_ + 1], peak_[nmodules_ + 1];        // last entry is total
+
+int ModuleIndex(const char *module) {
+  for (int n=0; n<iother_; ++n) {
+    if (std::strcmp(module, module_names_[n]) == 0) return n;
+  }
+  return iother_;
+}
+
+void AllocateHook(const Kokkos::Profiling::SpaceHandle handle, const char *label,
+                  const void *ptr, const uint64_t size) {
+  if (std::strcmp(handle.name, DevMemSpace::name()) != 0) return;
+  // Scopes of modules are authoritative.  Arrays reallocated during AMR keep the module
+  // of their label, so only arrays created by AMR itself are attributed to "amr".
+  int m = iother_;
+  if (!scopes_.empty() && scopes_.back() != iamr_) {
+    m = scopes_.back();
+    label_module_[label] = m;
+  } else {
+    auto it = label_module_.find(label);
+    if (it != label_module_.end()) {
+      m = it->second;
+    } else if (!scopes_.empty()) {
+      m = iamr_;
+    }
+  }
+  allocs_[ptr] = std::make_pair(m, size);
+  current_[m] += static_cast<double>(size);
+  current_[nmodules_] += static_cast<double>(size);
+  peak_[m] = std::max(peak_[m], current_[m]);
+  peak_[nmodules_] = std::max(peak_[nmodules_], current_[nmodules_]);
+}
+
+void DeallocateHook(const Kokkos::Profiling::SpaceHandle handle, const char *label,
+                    const void *ptr, const uint64_t size) {
+  if (std::strcmp(handle.name, DevMemSpace::name()) != 0) return;
+  auto it = allocs_.find(ptr);
+  if (it == allocs_.end()) return;  // allocated before tracker was enabled
+  current_[it->second.first] -= static_cast<double>(it->second.second);
+  current_[nmodules_] -= static_cast<double>(it->second.second);
+  allocs_.erase(it);
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+// Scope constructor and destructor push/pop module onto stack of active Scopes
+
+Scope::Scope(const char *module) : active_(enabled_) {
+  if (active_) {scopes_.push_back(ModuleIndex(module));}
+}
+
+Scope::~Scope() {
+  if (active_) {scopes_.pop_back();}
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Enable()
+//! \brief Registers Kokkos hooks called at every allocation and deallocation.  Must be
+//! called before the Mesh is constructed so that all allocations are seen.
+
+void Enable(ParameterInput *pin) {
+  nmb_predict_ = pin->GetOrAddInteger("job", "memory_predict_nmb", 0);
+  for (int n=0; n<=nmodules_; ++n) {current_[n] = 0.0; peak_[n] = 0.0;}
+  namespace kte = Kokkos::Tools::Experimental;
+  kte::set_allocate_data_callback(AllocateHook);
+  kte::set_deallocate_data_callback(DeallocateHook);
+  enabled_ = true;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Disable()
+//! \brief Unregisters Kokkos hooks
+
+void Disable() {
+  if (!enabled_) return;
+  namespace kte = Kokkos::Tools::Experimental;
+  kte::set_allocate_data_callback(nullptr);
+  kte::set_deallocate_data_callback(nullptr);
+  enabled_ = false;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Report()
+//! \brief Prints (from rank 0) current, peak, and predicted peak device memory usage of
+//! each module, each the maximum over ranks.  Must be called by all ranks.
+
+void Report(const std::string &when, Mesh *pm) {
+  if (!enabled_) return;
+  // arrays of physics modules are allocated for the larger of the number of MeshBlocks
+  // on this rank and the maximum allowed per rank
+  int nmb_alloc = std::max(pm->pmb_pack->nmb_thispack, pm->nmb_maxperrank);
+  int nmb_predict = (nmb_predict_ > 0)? nmb_predict_ : nmb_alloc;
+  double usage[3*(nmodules_ + 1)];
+  for (int n=0; n<=nmodules_; ++n) {
+    usage[3*n] = current_[n];
+    usage[3*n + 1] = peak_[n];
+    usage[3*n + 2] = peak_[n]*static_cast<double>(nmb_predict)/nmb_alloc;
+  }
+#if MPI_PARALLEL_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE, usage, 3*(nmodules_ + 1), MPI_DOUBLE, MPI_MAX,
+                global_variable::mpi_comm);
+#endif
+  if (global_variable::my_rank != 0) return;
+
+  const double mb = 1.0/(1024.0*1024.0);
+  std::cout << std::endl << "Device memory usage [MB] (max over ranks) " << when
+            << ", predicted peak for " << nmb_predict << " MeshBlocks/rank:"
+            << std::endl << std::left << std::setw(16) << "  module" << std::right
+            << std::setw(14) << "current" << std::setw(14) << "peak" << std::setw(14)
+            << "predicted" << std::endl << std::fixed << std::setprecision(1);
+  for (int n=0; n<=nmodules_; ++n) {
+    if (n < nmodules_ && usage[3*n + 1] == 0.0) continue;  // skip unused modules
+    std::cout << "  " << std::left << std::setw(14)
+              << ((n < nmodules_)? module_names_[n] : "total") << std::right
+              << std::setw(14) << mb*usage[3*n] << std::setw(14) << mb*usage[3*n + 1]
+              << std::setw(14) << mb*usage[3*n + 2] << std::endl;
+  }
+  std::cout << std::defaultfloat << std::endl;
+}
+
+} // namespace memory_tracker
@@ -0,0 +1,51 @@
+#ifndef DRIVER_MEMORY_TRACKER_HPP_
+#define DRIVER_MEMORY_TRACKER_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file memory_tracker.hpp
+//  \brief accounting of device memory used by each module (Hydro, MHD, Z4c, boundary
+//  buffers, etc.).  Enabled with <job>/memory_report = true.  Every allocation of
+//  device memory is then seen through the Kokkos profiling hooks, and attributed to the
+//  module whose Scope is innermost when it is made.  Allocations outside any Scope, or
+//  inside the Scope of AMR (e.g. by Kokkos::realloc of evolved variables), are
+//  attributed to the module that first allocated an array with the same label, or else
+//  to "amr" or "other".
+//
+//  Current and peak usage of each module (maximum over ranks) is reported at startup and
+//  after every change of the mesh by AMR, together with the peak predicted for
+//  <job>/memory_predict_nmb MeshBlocks per rank (by scaling the peak usage with the
+//  number of MeshBlocks for which arrays are allocated), which can be used to choose the
+//  resolution or <mesh_refinement>/max_nmb_per_rank that fits on a device.
+
+#include <string>
+
+// forward declarations
+class Mesh;
+class ParameterInput;
+
+namespace memory_tracker {
+
+//----------------------------------------------------------------------------------------
+//! \class Scope
+//  \brief attributes device memory allocated during its lifetime to the named module
+
+class Scope {
+ public:
+  explicit Scope(const char *module);
+  ~Scope();
+  Scope(const Scope&) = delete;
+  Scope &operator=(const Scope&) = delete;
+ private:
+  bool active_;
+};
+
+void Enable(ParameterInput *pin);
+void Disable();
+void Report(const std::string &when, Mesh *pm);
+
+} // namespace memory_tracker
+
+#endif // DRIVER_MEMORY_TRACKER_HPP_
@@ -0,0 +1,86 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file mpi_progress.cpp
+//  \brief implements functions in MPIProgress class
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mpi_progress.hpp"
+
+//----------------------------------------------------------------------------------------
+// MPIProgress constructor, must be called by all ranks
+
+MPIProgress::MPIProgress(ParameterInput *pin) :
+  running_(false) {
+  interval_usec_ = pin->GetOrAddInteger("time", "mpi_progress_usec", 0);
+#if MPI_PARALLEL_ENABLED
+  int provided;
+  MPI_Query_thread(&provided);
+  if (provided != MPI_THREAD_MULTIPLE) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "<time>/mpi_progress_usec requires MPI_THREAD_MULTIPLE, "
+              << "build with Athena_ENABLE_MPI_PROGRESS=ON" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  MPI_Comm_dup(global_variable::mpi_comm, &comm_);
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+// MPIProgress destructor
+
+MPIProgress::~MPIProgress() {
+  Stop();
+#if MPI_PARALLEL_ENABLED
+  MPI_Comm_free(&comm_);
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MPIProgress::Start()
+//! \brief Starts the progress thread.  Does nothing without MPI, or with one rank.
+
+void MPIProgress::Start() {
+#if MPI_PARALLEL_ENABLED
+  if (running_ || global_variable::nranks == 1) return;
+  running_ = true;
+  thread_ = std::thread(&MPIProgress::Poll, this);
+#endif
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MPIProgress::Stop()
+//! \brief Stops the progress thread and waits for it to exit.
+
+void MPIProgress::Stop() {
+  running_ = false;
+  if (thread_.joinable()) {thread_.join();}
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MPIProgress::Poll()
+//! \brief Function run by the progress thread.  No messages are ever sent on comm_, so
+//! MPI_Iprobe() only serves to enter the library and progress outstanding requests.
+//! Sleeping between polls limits contention for the lock that most MPI libraries hold
+//! while in MPI with MPI_THREAD_MULTIPLE.
+
+void MPIProgress::Poll() {
+#if MPI_PARALLEL_ENABLED
+  while (running_) {
+    int flag;
+    MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, comm_, &flag, MPI_STATUS_IGNORE);
+    std::this_thread::sleep_for(std::chrono::microseconds(interval_usec_));
+  }
+#endif
+  return;
+}
@@ -0,0 +1,56 @@
+#ifndef DRIVER_MPI_PROGRESS_HPP_
+#define DRIVER_MPI_PROGRESS_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file mpi_progress.hpp
+//  \brief definitions for MPIProgress class, which runs a host thread that repeatedly
+//  calls into the MPI library while the main thread launches kernels.  Many MPI
+//  libraries only progress large (rendezvous) messages, such as those sent in
+//  PackAndSendCC(), by the AMR load balancing, or by the particle exchange, when the
+//  application calls MPI, so without such a thread messages may not move while long
+//  kernels (e.g. the interior part of split flux kernels) run.  Enabled with
+//  <time>/mpi_progress_usec > 0, the interval in microseconds between polls.
+//
+//  The thread polls with MPI_Iprobe() on a private duplicate of the communicator, rather
+//  than testing the requests of the boundary and AMR modules, which are owned (and
+//  freed on completion) by the main thread.  Any call into MPI drives the progress
+//  engine for all outstanding requests.  Requires MPI_THREAD_MULTIPLE, which is
+//  requested in main.cpp when the code is built with Athena_ENABLE_MPI_PROGRESS (or
+//  with OpenMP).
+
+#include <atomic>
+#include <thread>
+
+#include "athena.hpp"
+#include "parameter_input.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
+//----------------------------------------------------------------------------------------
+//! \class MPIProgress
+
+class MPIProgress {
+ public:
+  explicit MPIProgress(ParameterInput *pin);
+  ~MPIProgress();
+
+  // functions
+  void Start();
+  void Stop();
+
+ private:
+  int interval_usec_;              // microseconds between polls
+  std::atomic<bool> running_;      // cleared to stop thread
+  std::thread thread_;
+#if MPI_PARALLEL_ENABLED
+  MPI_Comm comm_;                  // private communicator polled by thread
+#endif
+  void Poll();
+};
+
+#endif // DRIVER_MPI_PROGRESS_HPP_
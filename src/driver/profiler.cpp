@@ -0,0 +1,366 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file profiler.cpp
+//  \brief implements functions in Profiler class
+
+#include <algorithm>
+#include <chrono> // NOLINT [build/c++11]
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mesh/mesh.hpp"
+#include "profiler.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
+namespace {
+// Kokkos profiling hooks are plain functions, so store pointer to the (only) Profiler
+Profiler *pprof_ = nullptr;
+
+void BeginKernelHook(const char *name, const uint32_t devid, uint64_t *kid) {
+  if (pprof_ != nullptr) {pprof_->BeginKernel(name, kid);}
+}
+
+void EndKernelHook(const uint64_t kid) {
+  if (pprof_ != nullptr) {pprof_->EndKernel(kid);}
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn void AddKernelWork()
+//! \brief Forwards estimated work of one kernel launch to the Profiler (if any)
+
+void AddKernelWork(const std::string &name, double bytes, double flops) {
+  if (pprof_ != nullptr) {pprof_->AddKernelWork(name, bytes, flops);}
+}
+
+//----------------------------------------------------------------------------------------
+// Profiler constructor, registers Kokkos profiling hooks
+
+Profiler::Profiler(ParameterInput *pin) {
+  ncycle_out = pin->GetInteger("time", "profile_ncycles");
+  trace = pin->GetOrAddBoolean("time", "profile_trace", false);
+  file = pin->GetOrAddString("time", "profile_file", "none");
+  if (pprof_ != nullptr) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Only one Profiler can be constructed" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  pprof_ = this;
+  t_start_ = Now();
+  t_report_ = t_start_;
+
+  namespace kte = Kokkos::Tools::Experimental;
+  kte::set_begin_parallel_for_callback(BeginKernelHook);
+  kte::set_end_parallel_for_callback(EndKernelHook);
+  kte::set_begin_parallel_reduce_callback(BeginKernelHook);
+  kte::set_end_parallel_reduce_callback(EndKernelHook);
+  kte::set_begin_parallel_scan_callback(BeginKernelHook);
+  kte::set_end_parallel_scan_callback(EndKernelHook);
+
+  if (trace) {
+    std::string fname = "profile." + std::to_string(global_variable::my_rank) + ".json";
+    trace_file_.open(fname);
+    if (!trace_file_.is_open()) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Could not open profile trace file " << fname
+                << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    trace_file_ << "[" << std::endl;
+  }
+}
+
+//----------------------------------------------------------------------------------------
+// Profiler destructor, unregisters Kokkos profiling hooks and closes trace file
+
+Profiler::~Profiler() {
+  namespace kte = Kokkos::Tools::Experimental;
+  kte::set_begin_parallel_for_callback(nullptr);
+  kte::set_end_parallel_for_callback(nullptr);
+  kte::set_begin_parallel_reduce_callback(nullptr);
+  kte::set_end_parallel_reduce_callback(nullptr);
+  kte::set_begin_parallel_scan_callback(nullptr);
+  kte::set_end_parallel_scan_callback(nullptr);
+  pprof_ = nullptr;
+  if (trace_file_.is_open()) {
+    trace_file_ << std::endl << "]" << std::endl;
+    trace_file_.close();
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn double Profiler::Now()
+//! \brief Returns wall-clock time in seconds (from a monotonic clock).
+
+double Profiler::Now() {
+  using clock = std::chrono::steady_clock;
+  return std::chrono::duration<double>(clock::now().time_since_epoch()).count();
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Profiler::AddTaskListTime()
+//! \brief Records execution of TaskList tl from t0 to t1, of which t_wait was spent
+//! waiting on communications.  Called by Driver::ExecuteTaskList().
+
+void Profiler::AddTaskListTime(const std::string &tl, double t0, double t1,
+                               double t_wait) {
+  Timing &t = tlist_[tl];
+  t.time += (t1 - t0);
+  t.wait += t_wait;
+  t.ncall++;
+  if (trace) {AddTraceEvent(tl, "tasklist", t0, t1);}
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Profiler::AddTaskTime()
+//! \brief Records one call (from t0 to t1) of Task number n in TaskList tl.  Calls that
+//! return incomplete (i.e. tests of MPI receives) are counted as wait time.  Called from
+//! TaskList::DoAvailable() through the hook set in Driver::Execute().
+
+void Profiler::AddTaskTime(const std::string &tl, int n, double t0, double t1,
+                           bool complete) {
+  Timing &t = task_[std::make_pair(tl, n)];
+  t.time += (t1 - t0);
+  if (!complete) {t.wait += (t1 - t0);}
+  t.ncall++;
+  if (trace && complete) {AddTraceEvent(tl + ":" + std::to_string(n), "task", t0, t1);}
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Profiler::BeginKernel()
+//! \brief Called by Kokkos before each named parallel_for/reduce/scan is launched
+
+void Profiler::BeginKernel(const char *name, uint64_t *kid) {
+  *kid = next_kid_++;
+  running_[*kid] = std::make_pair(std::string(name), Now());
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Profiler::EndKernel()
+//! \brief Called by Kokkos after each named parallel_for/reduce/scan has completed
+
+void Profiler::EndKernel(uint64_t kid) {
+  double t1 = Now();
+  auto it = running_.find(kid);
+  if (it == running_.end()) return;
+  Timing &t = kernel_[it->second.first];
+  t.time += (t1 - it->second.second);
+  t.ncall++;
+  if (trace) {AddTraceEvent(it->second.first, "kernel", it->second.second, t1);}
+  running_.erase(it);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Profiler::AddKernelWork()
+//! \brief Accumulates estimated memory traffic and floating-point operations of kernel
+
+void Profiler::AddKernelWork(const std::string &name, double bytes, double flops) {
+  Timing &t = kernel_[name];
+  t.bytes += bytes;
+  t.flops += flops;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Profiler::AddTraceEvent()
+//! \brief Writes one complete ("X") event to the trace file.  Times are in microseconds
+//! since construction of the Profiler.
+
+void Profiler::AddTraceEvent(const std::string &name, const char *cat, double t0,
+                             double t1) {
+  if (!first_event_) {trace_file_ << "," << std::endl;}
+  first_event_ = false;
+  trace_file_ << std::fixed << std::setprecision(3)
+              << "{\"name\":\"" << name << "\",\"cat\":\"" << cat
+              << "\",\"ph\":\"X\",\"pid\":" << global_variable::my_rank
+              << ",\"tid\":0,\"ts\":" << 1.0e6*(t0 - t_start_)
+              << ",\"dur\":" << 1.0e6*(t1 - t0) << "}";
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Profiler::Report()
+//! \brief Prints summary of times accumulated since last report (by rank 0), and the
+//! imbalance of times between ranks, then resets all timers.  Must be called by all
+//! ranks.
+
+void Profiler::Report(Mesh *pm) {
+  double t_now = Now();
+  double t_tl = 0.0, t_wait = 0.0;
+  for (auto &it : tlist_) {
+    t_tl += it.second.time;
+    t_wait += it.second.wait;
+  }
+
+  // imbalance of work (time in TaskLists excluding waits) and of waits between ranks
+  double work = t_tl - t_wait;
+  double work_min = work, work_max = work, work_sum = work;
+  double wait_min = t_wait, wait_max = t_wait, wait_sum = t_wait;
+#if MPI_PARALLEL_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE, &work_min, 1, MPI_DOUBLE, MPI_MIN,
+                global_variable::mpi_comm);
+  MPI_Allreduce(MPI_IN_PLACE, &work_max, 1, MPI_DOUBLE, MPI_MAX,
+                global_variable::mpi_comm);
+  MPI_Allreduce(MPI_IN_PLACE, &work_sum, 1, MPI_DOUBLE, MPI_SUM,
+                global_variable::mpi_comm);
+  MPI_Allreduce(MPI_IN_PLACE, &wait_min, 1, MPI_DOUBLE, MPI_MIN,
+                global_variable::mpi_comm);
+  MPI_Allreduce(MPI_IN_PLACE, &wait_max, 1, MPI_DOUBLE, MPI_MAX,
+                global_variable::mpi_comm);
+  MPI_Allreduce(MPI_IN_PLACE, &wait_sum, 1, MPI_DOUBLE, MPI_SUM,
+                global_variable::mpi_comm);
+#endif
+  int nranks = global_variable::nranks;
+  if (comm_stats::enabled) {comm_stats::Reduce(comm_last_, comm_sum_, comm_max_);}
+
+  if (global_variable::my_rank == 0) {
+    double t_cyc = t_now - t_report_;
+    std::cout << std::endl << "Profile of cycles " << first_cycle_ << "-"
+              << (pm->ncycle - 1) << " on rank 0, wall time = " << std::scientific
+              << std::setprecision(3) << t_cyc << " s" << std::endl;
+
+    // TaskLists
+    std::cout << std::left << std::setw(32) << "  TaskList" << std::right
+              << std::setw(12) << "time[s]" << std::setw(12) << "wait[s]"
+              << std::setw(8) << "%" << std::endl;
+    for (auto &it : tlist_) {
+      std::cout << "  " << std::left << std::setw(30) << it.first << std::right
+                << std::setw(12) << it.second.time << std::setw(12) << it.second.wait
+                << std::fixed << std::setprecision(1) << std::setw(8)
+                << 100.0*it.second.time/t_cyc << std::scientific << std::setprecision(3)
+                << std::endl;
+    }
+
+    // Tasks, sorted by time.  Tasks are identified by TaskList and position in list
+    std::vector<std::pair<std::string, Timing>> tasks;
+    for (auto &it : task_) {
+      std::string name = it.first.first + ":" + std::to_string(it.first.second);
+      tasks.push_back(std::make_pair(name, it.second));
+    }
+    std::sort(tasks.begin(), tasks.end(), [](const std::pair<std::string, Timing> &a,
+        const std::pair<std::string, Timing> &b) {return a.second.time > b.second.time;});
+    std::cout << std::left << std::setw(32) << "  Task (TaskList:number)" << std::right
+              << std::setw(12) << "time[s]" << std::setw(12) << "wait[s]"
+              << std::setw(12) << "calls" << std::endl;
+    for (auto &it : tasks) {
+      if (it.second.time < 1.0e-3*t_cyc) break;  // only tasks taking > 0.1% of time
+      std::cout << "  " << std::left << std::setw(30) << it.first << std::right
+                << std::setw(12) << it.second.time << std::setw(12) << it.second.wait
+                << std::setw(12) << it.second.ncall << std::endl;
+    }
+
+    // Kernels, sorted by time
+    std::vector<std::pair<std::string, Timing>> kernels(kernel_.begin(), kernel_.end());
+    std::sort(kernels.begin(), kernels.end(), [](const std::pair<std::string, Timing> &a,
+        const std::pair<std::string, Timing> &b) {return a.second.time > b.second.time;});
+    std::cout << std::left << std::setw(32) << "  Kernel" << std::right
+              << std::setw(12) << "time[s]" << std::setw(12) << "avg[s]"
+              << std::setw(12) << "calls" << std::setw(12) << "GB/s"
+              << std::setw(12) << "GFlop/s" << std::setw(12) << "Flop/B" << std::endl;
+    for (auto &it : kernels) {
+      if (it.second.time < 1.0e-3*t_cyc) break;  // only kernels taking > 0.1% of time
+      std::cout << "  " << std::left << std::setw(30) << it.first << std::right
+                << std::setw(12) << it.second.time << std::setw(12)
+                << it.second.time/static_cast<double>(it.second.ncall)
+                << std::setw(12) << it.second.ncall;
+      // roofline data for kernels with declared work
+      if (it.second.bytes > 0.0) {
+        std::cout << std::setw(12) << 1.0e-9*it.second.bytes/it.second.time
+                  << std::setw(12) << 1.0e-9*it.second.flops/it.second.time
+                  << std::setw(12) << it.second.flops/it.second.bytes;
+      }
+      std::cout << std::endl;
+    }
+
+    // imbalance between ranks
+    std::cout << "  Ranks: work[s] min/avg/max = " << work_min << "/" << work_sum/nranks
+              << "/" << work_max << ", wait[s] min/avg/max = " << wait_min << "/"
+              << wait_sum/nranks << "/" << wait_max << std::endl << std::endl;
+    if (file.compare("none") != 0) {
+      WriteJSON(pm, t_cyc, work_min, work_sum/nranks, work_max, wait_min,
+                wait_sum/nranks, wait_max);
+    }
+  }
+
+  // reset timers
+  tlist_.clear();
+  task_.clear();
+  kernel_.clear();
+  first_cycle_ = pm->ncycle;
+  t_report_ = t_now;
+  if (trace) {trace_file_.flush();}
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Profiler::WriteJSON()
+//! \brief Appends summary of times accumulated since last report to profile_file, as a
+//! single line of JSON.  Performance is reported as zone-cycles per second of wall time
+//! over the profiled cycles only (so excluding the time for initialization).
+//! Called only by rank 0.
+
+void Profiler::WriteJSON(Mesh *pm, double t_cyc, double work_min, double work_avg,
+                         double work_max, double wait_min, double wait_avg,
+                         double wait_max) {
+  std::ofstream os(file, std::ios::app);
+  if (!os.is_open()) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Could not open profile file " << file << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  auto &indcs = pm->mb_indcs;
+  int ncyc = pm->ncycle - first_cycle_;
+  double ncells = static_cast<double>(pm->nmb_total)*indcs.nx1*indcs.nx2*indcs.nx3;
+  os << std::scientific << std::setprecision(6)
+     << "{\"first_cycle\":" << first_cycle_ << ",\"ncycles\":" << ncyc
+     << ",\"wall_time\":" << t_cyc << ",\"nranks\":" << global_variable::nranks
+     << ",\"nmb_total\":" << pm->nmb_total << ",\"mb_cells\":[" << indcs.nx1 << ","
+     << indcs.nx2 << "," << indcs.nx3 << "],\"cells\":" << ncells
+     << ",\"zone_cycles_per_sec\":" << ncells*ncyc/t_cyc;
+
+  os << ",\"tasklists\":{";
+  bool first = true;
+  for (auto &it : tlist_) {
+    if (!first) {os << ",";}
+    first = false;
+    os << "\"" << it.first << "\":{\"time\":" << it.second.time << ",\"wait\":"
+       << it.second.wait << ",\"calls\":" << it.second.ncall << "}";
+  }
+  os << "},\"tasks\":{";
+  first = true;
+  for (auto &it : task_) {
+    if (!first) {os << ",";}
+    first = false;
+    os << "\"" << it.first.first << ":" << it.first.second << "\":{\"time\":"
+       << it.second.time << ",\"wait\":" << it.second.wait << ",\"calls\":"
+       << it.second.ncall << "}";
+  }
+  os << "},\"kernels\":{";
+  first = true;
+  for (auto &it : kernel_) {
+    if (!first) {os << ",";}
+    first = false;
+    os << "\"" << it.first << "\":{\"time\":" << it.second.time << ",\"calls\":"
+       << it.second.ncall << ",\"bytes\":" << it.second.bytes << ",\"flops\":"
+       << it.second.flops << "}";
+  }
+  os << "},\"ranks\":{\"work\":[" << work_min << "," << work_avg << "," << work_max
+     << "],\"wait\":[" << wait_min << "," << wait_avg << "," << wait_max << "]}";
+  if (comm_stats::enabled) {
+    os << ",\"comm\":";
+    comm_stats::WriteJSON(os, comm_sum_, comm_max_);
+  }
+  os << "}" << std::endl;
+  os.close();
+  return;
+}
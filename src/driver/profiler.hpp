@@ -0,0 +1,114 @@
+#ifndef DRIVER_PROFILER_HPP_
+#define DRIVER_PROFILER_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file profiler.hpp
+//  \brief definitions for Profiler class, which times every TaskList, every Task, and
+//  every named Kokkos kernel (par_for, par_reduce, etc.) while the code runs, without the
+//  need to load an external Kokkos tool.  Enabled with <time>/profile_ncycles > 0, in
+//  which case a summary table is printed every profile_ncycles cycles.  With
+//  <time>/profile_trace = true, a timeline of all events is also written by each rank to
+//  the file "profile.<rank>.json" in the Chrome trace-event format (which can be viewed
+//  with chrome://tracing or https://ui.perfetto.dev).  With <time>/profile_file set, rank
+//  0 also appends each summary to that file as one line of JSON, for use by scripts (such
+//  as tst/scaling.py) that collect timings from many runs.
+//
+//  Kernels are timed with the Kokkos profiling hooks, which also fence the device after
+//  each kernel, so that the time of kernels (and of the Tasks that launch them) on GPUs
+//  is measured correctly, at the price of some loss of asynchrony.
+//
+//  Estimates of the memory traffic and floating-point operations of kernels can be
+//  declared before each launch with AddKernelWork(), in which case the achieved
+//  bandwidth, flop rate, and arithmetic intensity of those kernels are also reported, so
+//  that it can be seen how close each is to the roofline of the machine.  Traffic is
+//  estimated as the compulsory traffic (every array read or written once), so the
+//  bandwidth is a lower bound.  Hardware counters can be read by external tools (e.g.
+//  Nsight Compute or rocprof, to which Kokkos passes the same kernel names), with the
+//  profiler disabled.
+//
+//  Time spent in passes through a TaskList in which no Task could be completed (i.e. when
+//  all remaining Tasks are waiting on MPI receives), including time blocked in
+//  Driver::WaitForPendingRecvs(), is reported as MPI wait time.  Imbalance between ranks
+//  is reported as the min/avg/max over ranks of the time spent in TaskLists.  With
+//  <time>/comm_stats = true, the bytes and messages sent (see comm_stats.hpp) are added
+//  to each summary in profile_file.
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "athena.hpp"
+#include "parameter_input.hpp"
+#include "comm_stats.hpp"
+
+// forward declarations
+class Mesh;
+
+//----------------------------------------------------------------------------------------
+//! \class Profiler
+
+class Profiler {
+ public:
+  explicit Profiler(ParameterInput *pin);
+  ~Profiler();
+
+  // data
+  int ncycle_out;     // number of cycles between summary reports
+  bool trace;         // write timeline in Chrome trace-event format
+  std::string file;   // name of file to which summaries are appended as JSON (if any)
+
+  // functions
+  static double Now();  // seconds since arbitrary (but fixed) time
+  void AddTaskListTime(const std::string &tl, double t0, double t1, double t_wait);
+  void AddTaskTime(const std::string &tl, int n, double t0, double t1, bool complete);
+  void BeginKernel(const char *name, uint64_t *kid);
+  void EndKernel(uint64_t kid);
+  void AddKernelWork(const std::string &name, double bytes, double flops);
+  void Report(Mesh *pm);
+
+ private:
+  // accumulated time and number of calls
+  struct Timing {
+    double time = 0.0;
+    double wait = 0.0;
+    int64_t ncall = 0;
+    double bytes = 0.0;   // estimated memory traffic (kernels only)
+    double flops = 0.0;   // estimated floating-point operations (kernels only)
+  };
+  std::map<std::string, Timing> tlist_;                 // per TaskList
+  std::map<std::pair<std::string, int>, Timing> task_;  // per Task of each TaskList
+  std::map<std::string, Timing> kernel_;                // per kernel name
+  std::map<uint64_t, std::pair<std::string, double>> running_;  // kernels not yet ended
+  uint64_t next_kid_ = 0;
+  int first_cycle_ = 0;
+  double t_start_, t_report_;
+  std::ofstream trace_file_;
+  bool first_event_ = true;
+  comm_stats::Counts comm_last_, comm_sum_, comm_max_;  // messages sent (comm_stats)
+  void AddTraceEvent(const std::string &name, const char *cat, double t0, double t1);
+  void WriteJSON(Mesh *pm, double t_cyc, double work_min, double work_avg,
+                 double work_max, double wait_min, double wait_avg, double wait_max);
+};
+
+// Declares estimated memory traffic [bytes] and floating-point operations of one launch
+// of the named kernel.  Does nothing unless profiler is enabled.
+void AddKernelWork(const std::string &name, double bytes, double flops);
+
+//----------------------------------------------------------------------------------------
+//! \fn ReconFlops()
+//! \brief Rough estimate of floating-point operations to reconstruct one variable on
+//! both sides of one face, for use with AddKernelWork().
+
+constexpr double ReconFlops(const ReconstructionMethod r) {
+  return (r == ReconstructionMethod::dc)? 0.0 :
+         (r == ReconstructionMethod::plm)? 20.0 :
+         (r == ReconstructionMethod::wenoz)? 120.0 : 60.0;
+}
+
+#endif // DRIVER_PROFILER_HPP_
@@ -25,6 +25,7 @@
 #include "coordinates/adm.hpp"
 #include "z4c/tmunu.hpp"
 #include "dyn_grmhd.hpp"
+#include "dyn_grmhd/rsolvers/flux_dyn_grmhd.hpp"
 #include "tasklist/numerical_relativity.hpp"
 
 #include "eos/primitive_solver_hyd.hpp"
@@ -94,7 +95,9 @@ DynGRMHD* BuildDynGRMHD(MeshBlockPack *ppack, ParameterInput *pin) {
   return dyn_gr;
 }
 
-DynGRMHD::DynGRMHD(MeshBlockPack *pp, ParameterInput *pin) : pmy_pack(pp) {
+DynGRMHD::DynGRMHD(MeshBlockPack *pp, ParameterInput *pin) :
+    pmy_pack(pp),
+    face_metric("face_metric",1,1,1,1,1) {
   std::string rsolver = pin->GetString("mhd", "rsolver");
   if (rsolver.compare("llf") == 0) {
     rsolver_method = DynGRMHD_RSolver::llf_dyngr;
@@ -122,11 +125,70 @@ DynGRMHD::DynGRMHD(MeshBlockPack *pp, ParameterInput *pin) : pmy_pack(pp) {
   dmp_M = pin->GetOrAddReal("mhd", "dmp_M", 1.2);
 
   fixed_evolution = pin->GetOrAddBoolean("mhd", "fixed", false);
+  split_metric = pin->GetOrAddBoolean("mhd", "dyn_split_metric", false);
+  cache_face_metric = pin->GetOrAddBoolean("mhd", "dyn_cache_face_metric", false);
+  report_occupancy = pin->GetOrAddBoolean("mhd", "dyn_report_occupancy", false);
 }
 
 DynGRMHD::~DynGRMHD() {
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void DynGRMHD::StoreFaceMetricCache()
+//! \brief Interpolates the metric to all faces in each direction and stores it in
+//! face_metric.  The metric is fixed during a stage, so this is called once at the start
+//! of CalcFluxes, and the flux kernels and FOFC load the stored values instead of
+//! interpolating the metric again.
+
+void DynGRMHD::StoreFaceMetricCache() {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int nmb = pmy_pack->nmb_thispack;
+  int n1 = indcs.nx1 + 2*indcs.ng;
+  int n2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*indcs.ng) : 1;
+  int n3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*indcs.ng) : 1;
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+  auto &adm = pmy_pack->padm->adm;
+
+  if (face_metric.x1f.extent_int(0) != nmb) {
+    Kokkos::realloc(face_metric.x1f, nmb, NFACEMETRIC, n3, n2, n1+1);
+    Kokkos::realloc(face_metric.x2f, nmb, NFACEMETRIC, n3, n2+1, n1);
+    Kokkos::realloc(face_metric.x3f, nmb, NFACEMETRIC, n3+1, n2, n1);
+  }
+
+  auto fmet1 = face_metric.x1f;
+  par_for("fmet_x1", DevExeSpace(), 0, nmb-1, 0, n3-1, 0, n2-1, 1, n1-1,
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    Real g3d[NSPMETRIC], beta_u[3], alpha;
+    FaceMetric<IVX>(m, k, j, i, adm, g3d, beta_u, alpha);
+    for (int n = 0; n < NSPMETRIC; ++n) {fmet1(m, n, k, j, i) = g3d[n];}
+    for (int a = 0; a < 3; ++a) {fmet1(m, NSPMETRIC + a, k, j, i) = beta_u[a];}
+    fmet1(m, NSPMETRIC + 3, k, j, i) = alpha;
+  });
+  if (multi_d) {
+    auto fmet2 = face_metric.x2f;
+    par_for("fmet_x2", DevExeSpace(), 0, nmb-1, 0, n3-1, 1, n2-1, 0, n1-1,
+    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+      Real g3d[NSPMETRIC], beta_u[3], alpha;
+      FaceMetric<IVY>(m, k, j, i, adm, g3d, beta_u, alpha);
+      for (int n = 0; n < NSPMETRIC; ++n) {fmet2(m, n, k, j, i) = g3d[n];}
+      for (int a = 0; a < 3; ++a) {fmet2(m, NSPMETRIC + a, k, j, i) = beta_u[a];}
+      fmet2(m, NSPMETRIC + 3, k, j, i) = alpha;
+    });
+  }
+  if (three_d) {
+    auto fmet3 = face_metric.x3f;
+    par_for("fmet_x3", DevExeSpace(), 0, nmb-1, 1, n3-1, 0, n2-1, 0, n1-1,
+    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+      Real g3d[NSPMETRIC], beta_u[3], alpha;
+      FaceMetric<IVZ>(m, k, j, i, adm, g3d, beta_u, alpha);
+      for (int n = 0; n < NSPMETRIC; ++n) {fmet3(m, n, k, j, i) = g3d[n];}
+      for (int a = 0; a < 3; ++a) {fmet3(m, NSPMETRIC + a, k, j, i) = beta_u[a];}
+      fmet3(m, NSPMETRIC + 3, k, j, i) = alpha;
+    });
+  }
+}
+
 template<class EOSPolicy, class ErrorPolicy>
 void DynGRMHDPS<EOSPolicy, ErrorPolicy>::QueueDynGRMHDTasks() {
   using namespace mhd;  // NOLINT(build/namespaces)
@@ -144,34 +206,39 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::QueueDynGRMHDTasks() {
 
   // Select which CalculateFlux function to add based on rsolver_method.
   // CalcFlux requires metric in flux - must happen before z4ctoadm updates the metric
-  if (rsolver_method == DynGRMHD_RSolver::llf_dyngr) {
-    pnr->QueueTask(
-           &DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes<DynGRMHD_RSolver::llf_dyngr>,
-           this, MHD_Flux, "MHD_Flux", Task_Run, {MHD_CopyU});
+  // Face metric is interpolated in a separate pass if split_metric, or copied from the
+  // face metric stored at the start of the stage if cache_face_metric.
+  // With multirate integration the metric is first interpolated in time (Z4c_InterpADM).
+  using DynGR = DynGRMHDPS<EOSPolicy, ErrorPolicy>;
+  bool face_pass = split_metric || cache_face_metric;
+  if (rsolver_method == DynGRMHD_RSolver::llf_dyngr && face_pass) {
+    pnr->QueueTask(&DynGR::template CalcFluxes<DynGRMHD_RSolver::llf_dyngr, true>,
+                   this, MHD_Flux, "MHD_Flux", Task_Run, {MHD_CopyU},
+                   {Z4c_InterpADM});
+  } else if (rsolver_method == DynGRMHD_RSolver::llf_dyngr) {
+    pnr->QueueTask(&DynGR::template CalcFluxes<DynGRMHD_RSolver::llf_dyngr, false>,
+                   this, MHD_Flux, "MHD_Flux", Task_Run, {MHD_CopyU},
+                   {Z4c_InterpADM});
+  } else if (rsolver_method == DynGRMHD_RSolver::hlle_dyngr && face_pass) {
+    pnr->QueueTask(&DynGR::template CalcFluxes<DynGRMHD_RSolver::hlle_dyngr, true>,
+                   this, MHD_Flux, "MHD_Flux", Task_Run, {MHD_CopyU},
+                   {Z4c_InterpADM});
   } else if (rsolver_method == DynGRMHD_RSolver::hlle_dyngr) {
-    pnr->QueueTask(
-           &DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes<DynGRMHD_RSolver::hlle_dyngr>,
-           this, MHD_Flux, "MHD_Flux", Task_Run, {MHD_CopyU});
+    pnr->QueueTask(&DynGR::template CalcFluxes<DynGRMHD_RSolver::hlle_dyngr, false>,
+                   this, MHD_Flux, "MHD_Flux", Task_Run, {MHD_CopyU},
+                   {Z4c_InterpADM});
   } else { // put more rsolvers here
     abort();
   }
 
-  // Now the rest of the MHD run tasks
-  if (pz4c != nullptr) {
-    pnr->QueueTask(&DynGRMHD::SetTmunu, this, MHD_SetTmunu, "MHD_SetTmunu",
-                   Task_Run, {MHD_CopyU});
-  }
+  // Now the rest of the MHD run tasks.  Tmunu needed by the Z4c RHS is stored by C2P at
+  // the end of the previous stage (or during initialization), so no separate task.
   pnr->QueueTask(&MHD::SendFlux, pmhd, MHD_SendFlux, "MHD_SendFlux",
                  Task_Run, {MHD_Flux});
   pnr->QueueTask(&MHD::RecvFlux, pmhd, MHD_RecvFlux, "MHD_RecvFlux",
                  Task_Run, {MHD_SendFlux});
-  if (pz4c != nullptr) {
-    pnr->QueueTask(&MHD::RKUpdate, pmhd, MHD_ExplRK, "MHD_ExplRK", Task_Run,
-                   {MHD_RecvFlux, MHD_SetTmunu});
-  } else {
-    pnr->QueueTask(&MHD::RKUpdate, pmhd, MHD_ExplRK, "MHD_ExplRK", Task_Run,
-                   {MHD_RecvFlux});
-  }
+  pnr->QueueTask(&MHD::RKUpdate, pmhd, MHD_ExplRK, "MHD_ExplRK", Task_Run,
+                 {MHD_RecvFlux});
   pnr->QueueTask(&MHD::MHDSrcTerms, pmhd, MHD_AddSrc, "MHD_AddSrc", Task_Run,
                  {MHD_ExplRK});
   pnr->QueueTask(&MHD::RestrictU, pmhd, MHD_RestU, "MHD_RestU", Task_Run, {MHD_AddSrc});
@@ -256,7 +323,8 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::ConToPrim(Driver *pdrive, int sta
   int n2m1 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng - 1) : 0;
   int n3m1 = (indcs.nx3 > 1)? (indcs.nx3 + 2*ng - 1) : 0;
   eos.ConsToPrim(pmy_pack->pmhd->u0, pmy_pack->pmhd->b0, pmy_pack->pmhd->bcc0,
-                 pmy_pack->pmhd->w0, 0, n1m1, 0, n2m1, 0, n3m1, false);
+                 pmy_pack->pmhd->w0, 0, n1m1, 0, n2m1, 0, n3m1, false,
+                 (pmy_pack->pz4c != nullptr));
   return TaskStatus::complete;
 }
 
@@ -353,7 +421,9 @@ TaskStatus DynGRMHD::ApplyPhysicalBCs(Driver *pdrive, int stage) {
 //----------------------------------------------------------------------------------------
 //! \fn  TaskStatus DynGRMHD::SetTmunu(Driver *pdrive, int stage)
 //! \brief Add the perfect fluid contribution to the stress-energy tensor. This is assumed
-//!  to be the first contribution, so it sets the values rather than adding.
+//!  to be the first contribution, so it sets the values rather than adding.  During the
+//!  evolution the same values are stored directly by ConToPrim, so this is only called
+//!  after the conserved variables are initialized from the primitives.
 TaskStatus DynGRMHD::SetTmunu(Driver *pdrive, int stage) {
   if (fixed_evolution) {
     return TaskStatus::complete;
@@ -456,9 +526,14 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::AddCoordTermsEOS(const DvceArray5D<Real
   } else {
     ndim = 3;
   }
+  auto &excise = pmy_pack->pcoord->coord_data.bh_excise;
+  auto &excised_kplane_ = pmy_pack->pcoord->excised_kplane;
 
   par_for("coord_src", DevExeSpace(), 0, nmb-1, ks, ke, js, je, is, ie,
   KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    // conserved variables are reset in excised cells by C2P
+    if (excise && excised_kplane_(m,k)) return;
+
     // Extract the metric and coordinate quantities.
     Real g3d[NSPMETRIC] = {adm.g_dd(m,0,0,k,j,i), adm.g_dd(m,0,1,k,j,i),
                            adm.g_dd(m,0,2,k,j,i), adm.g_dd(m,1,1,k,j,i),
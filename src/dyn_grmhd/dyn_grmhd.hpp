@@ -77,6 +77,7 @@ class DynGRMHD {
   DynGRMHDTaskIDs id;
 
   TaskStatus SetTmunu(Driver *d, int stage);
+  void StoreFaceMetricCache();
   TaskStatus ApplyPhysicalBCs(Driver *d, int stage);
 
   // functions
@@ -104,6 +105,10 @@ class DynGRMHD {
   bool enforce_maximum;     // enforce local maximum principle during FOFC
   Real dmp_M;               // threshold multiplier for discrete maximum principle.
   bool fixed_evolution;     // Disable mhd evolution
+  bool split_metric;        // interpolate face metric in separate pass in flux kernels
+  bool cache_face_metric;   // store face metric once per stage for fluxes and FOFC
+  DvceFaceFld5D<Real> face_metric;  // face metric (3-metric, shift, lapse) if cached
+  bool report_occupancy;    // print team sizes of flux kernels on first call
 };
 
 template<class EOSPolicy, class ErrorPolicy>
@@ -116,8 +121,8 @@ class DynGRMHDPS : public DynGRMHD {
   // Dynamical EOS
   PrimitiveSolverHydro<EOSPolicy, ErrorPolicy> eos;
 
-  // CalculateFluxes function templated over Riemann Solvers
-  template<DynGRMHD_RSolver T>
+  // CalculateFluxes function templated over Riemann Solvers and face metric pass
+  template<DynGRMHD_RSolver T, bool split_metric>
   TaskStatus CalcFluxes(Driver *d, int stage);
 
   template<DynGRMHD_RSolver T>
@@ -33,9 +33,15 @@ namespace dyngr {
 //----------------------------------------------------------------------------------------
 //! \fn  void Hydro::CalcFluxes
 //! \brief Calls reconstruction and Riemann solver functions to compute hydro fluxes
-//! Note this function is templated over RS for better performance on GPUs.
-
-template<class EOSPolicy, class ErrorPolicy> template <DynGRMHD_RSolver rsolver_method_>
+//! Note this function is templated over RS for better performance on GPUs.  If
+//! split_metric_, the face metric is interpolated into scratch memory in a separate pass
+//! before the Riemann solver is called, which reduces register pressure in the solver.
+//! With cache_face_metric, the face metric is stored once per stage for all directions,
+//! and copied into scratch memory (and loaded by FOFC) instead of being interpolated.
+//! Kernels are launched with DynGRLaunchBounds.
+
+template<class EOSPolicy, class ErrorPolicy>
+template <DynGRMHD_RSolver rsolver_method_, bool split_metric_>
 TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int stage) {
   RegionIndcs indcs_ = pmy_pack->pmesh->mb_indcs;
   int is = indcs_.is, ie = indcs_.ie;
@@ -63,12 +69,19 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
   if (fixed_evolution) {
     return TaskStatus::complete;
   }
+  // number of rows of scratch array for face metric (only used if split_metric_)
+  const int nfmet = (split_metric_)? NFACEMETRIC : 0;
+  // store face metric for all directions once per stage if cached (implies split_metric_)
+  const bool cache_fmet = cache_face_metric;
+  if (cache_fmet) {StoreFaceMetricCache();}
+  auto &fmet = face_metric;
 
   //--------------------------------------------------------------------------------------
   // i-direction
 
   size_t scr_size = ScrArray2D<Real>::shmem_size(nvars, ncells1) * 2 +
-                    ScrArray2D<Real>::shmem_size(3, ncells1) * 2;
+                    ScrArray2D<Real>::shmem_size(3, ncells1) * 2 +
+                    ScrArray2D<Real>::shmem_size(nfmet, ncells1);
   int scr_level = scratch_level;
   auto flx1_ = pmy_pack->pmhd->uflx.x1f;
   auto &e31_ = pmy_pack->pmhd->e3x1;
@@ -87,13 +100,13 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
   int il = is, iu = ie+1;
   if (use_fofc) { il = is-1, iu = ie+2; }
 
-  par_for_outer("dyngrflux_x1",DevExeSpace(), scr_size, scr_level,
-      0, nmb1, kl, ku, jl, ju,
-  KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+  auto flux_x1 = KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k,
+                               const int j) {
     ScrArray2D<Real> wl(member.team_scratch(scr_level), nvars, ncells1);
     ScrArray2D<Real> wr(member.team_scratch(scr_level), nvars, ncells1);
     ScrArray2D<Real> bl(member.team_scratch(scr_level), 3, ncells1);
     ScrArray2D<Real> br(member.team_scratch(scr_level), 3, ncells1);
+    ScrArray2D<Real> gface(member.team_scratch(scr_level), nfmet, ncells1);
 
     // Reconstruct qR[i] and qL[i+1]
     switch (recon_method_) {
@@ -119,6 +132,14 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
       default:
         break;
     }
+    // Interpolate face metric in a separate pass (or copy stored face metric)
+    if constexpr (split_metric_) {
+      if (cache_fmet) {
+        CopyFaceMetric(member, m, k, j, il, iu, fmet.x1f, gface);
+      } else {
+        StoreFaceMetric<IVX>(member, m, k, j, il, iu, adm, gface);
+      }
+    }
     // Sync all threads in the team so that scratch memory is consistent
     member.team_barrier();
 
@@ -136,12 +157,12 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
     auto &adm_ = adm;
     //int il = is; int iu = ie+1;
     if constexpr (rsolver_method_ == DynGRMHD_RSolver::llf_dyngr) {
-      LLF_DYNGR<IVX>(member, dyn_eos, indcs, size, coord, m, k, j, il, iu,
-                wl, wr, bl, br, bx, nhyd_, nscal_, adm_,
+      LLF_DYNGR<IVX, split_metric_>(member, dyn_eos, indcs, size, coord, m, k, j, il, iu,
+                wl, wr, bl, br, bx, nhyd_, nscal_, adm_, gface,
                 flx1, e31, e21);
     } else if constexpr (rsolver_method_ == DynGRMHD_RSolver::hlle_dyngr) {
-      HLLE_DYNGR<IVX>(member, dyn_eos, indcs, size, coord, m, k, j, il, iu,
-                wl, wr, bl, br, bx, nhyd_, nscal_, adm_,
+      HLLE_DYNGR<IVX, split_metric_>(member, dyn_eos, indcs, size, coord, m, k, j, il, iu,
+                wl, wr, bl, br, bx, nhyd_, nscal_, adm_, gface,
                 flx1, e31, e21);
     }
     member.team_barrier();
@@ -159,14 +180,21 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
       }
     }
     member.team_barrier();
-  });
+  };
+  if (report_occupancy) {
+    ReportTeamOccupancy<DynGRLaunchBounds>("dyngrflux_x1", scr_size, scr_level, flux_x1,
+                                           0, kl, jl);
+  }
+  par_for_outer<DynGRLaunchBounds>("dyngrflux_x1", DevExeSpace(), scr_size, scr_level,
+                                   0, nmb1, kl, ku, jl, ju, flux_x1);
 
   //--------------------------------------------------------------------------------------
   // j-direction
 
   if (pmy_pack->pmesh->multi_d) {
     scr_size = ScrArray2D<Real>::shmem_size(nvars, ncells1) * 3
-             + ScrArray2D<Real>::shmem_size(3, ncells1) * 3;
+             + ScrArray2D<Real>::shmem_size(3, ncells1) * 3
+             + ScrArray2D<Real>::shmem_size(nfmet, ncells1);
     auto flx2_ = pmy_pack->pmhd->uflx.x2f;
     auto &by_ = pmy_pack->pmhd->b0.x2f;
     auto &e12_ = pmy_pack->pmhd->e1x2;
@@ -181,14 +209,14 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
     jl = js-1, ju = je+1;
     if (use_fofc) { jl = js-2, ju = je+2; }
 
-    par_for_outer("dyngrflux_x2",DevExeSpace(), scr_size, scr_level, 0, nmb1, kl, ku,
-    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k) {
+    auto flux_x2 = KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k) {
       ScrArray2D<Real> scr1(member.team_scratch(scr_level), nvars, ncells1);
       ScrArray2D<Real> scr2(member.team_scratch(scr_level), nvars, ncells1);
       ScrArray2D<Real> scr3(member.team_scratch(scr_level), nvars, ncells1);
       ScrArray2D<Real> scr4(member.team_scratch(scr_level), 3, ncells1);
       ScrArray2D<Real> scr5(member.team_scratch(scr_level), 3, ncells1);
       ScrArray2D<Real> scr6(member.team_scratch(scr_level), 3, ncells1);
+      ScrArray2D<Real> gface(member.team_scratch(scr_level), nfmet, ncells1);
 
       for (int j=jl; j<=ju; ++j) {
         // Permute scratch arrays.
@@ -231,6 +259,14 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
           default:
             break;
         }
+        // Interpolate face metric in a separate pass (or copy stored face metric)
+        if constexpr (split_metric_) {
+          if ((j>(jl)) && cache_fmet) {
+            CopyFaceMetric(member, m, k, j, is-1, ie+1, fmet.x2f, gface);
+          } else if (j>(jl)) {
+            StoreFaceMetric<IVY>(member, m, k, j, is-1, ie+1, adm, gface);
+          }
+        }
         // Sync all threads in the team so that scratch memory is consistent
         member.team_barrier();
 
@@ -249,11 +285,13 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
         //int il = is; int iu = ie;
         if (j>(jl)) {
           if constexpr (rsolver_method_ == DynGRMHD_RSolver::llf_dyngr) {
-            LLF_DYNGR<IVY>(member, dyn_eos, indcs, size, coord, m, k, j, is-1, ie+1,
-                      wl, wr, bl, br, by, nhyd_, nscal_, adm_, flx2, e12, e32);
+            LLF_DYNGR<IVY, split_metric_>(member, dyn_eos, indcs, size, coord,
+                      m, k, j, is-1, ie+1, wl, wr, bl, br, by, nhyd_, nscal_, adm_,
+                      gface, flx2, e12, e32);
           } else if constexpr (rsolver_method_ == DynGRMHD_RSolver::hlle_dyngr) {
-            HLLE_DYNGR<IVY>(member, dyn_eos, indcs, size, coord, m, k, j, is-1, ie+1,
-                      wl, wr, bl, br, by, nhyd_, nscal_, adm_, flx2, e12, e32);
+            HLLE_DYNGR<IVY, split_metric_>(member, dyn_eos, indcs, size, coord,
+                      m, k, j, is-1, ie+1, wl, wr, bl, br, by, nhyd_, nscal_, adm_,
+                      gface, flx2, e12, e32);
           }
         }
         member.team_barrier();
@@ -272,7 +310,13 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
         }
       } // end of loop over j
       member.team_barrier();
-    });
+    };
+    if (report_occupancy) {
+      ReportTeamOccupancy<DynGRLaunchBounds>("dyngrflux_x2", scr_size, scr_level,
+                                             flux_x2, 0, kl);
+    }
+    par_for_outer<DynGRLaunchBounds>("dyngrflux_x2", DevExeSpace(), scr_size, scr_level,
+                                     0, nmb1, kl, ku, flux_x2);
   }
 
   //--------------------------------------------------------------------------------------
@@ -280,7 +324,8 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
 
   if (pmy_pack->pmesh->three_d) {
     scr_size = ScrArray2D<Real>::shmem_size(nvars, ncells1) * 3
-             + ScrArray2D<Real>::shmem_size(3, ncells1) * 3;
+             + ScrArray2D<Real>::shmem_size(3, ncells1) * 3
+             + ScrArray2D<Real>::shmem_size(nfmet, ncells1);
     auto &flx3_ = pmy_pack->pmhd->uflx.x3f;
     auto &bz_   = pmy_pack->pmhd->b0.x3f;
     auto &e23_  = pmy_pack->pmhd->e2x3;
@@ -289,14 +334,14 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
     kl = ks-1, ku = ke+1;
     if (use_fofc) { kl = ks-2, ku = ke+2; }
 
-    par_for_outer("dyngrflux_x3",DevExeSpace(), scr_size, scr_level, 0, nmb1, js-1, je+1,
-    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int j) {
+    auto flux_x3 = KOKKOS_LAMBDA(TeamMember_t member, const int m, const int j) {
       ScrArray2D<Real> scr1(member.team_scratch(scr_level), nvars, ncells1);
       ScrArray2D<Real> scr2(member.team_scratch(scr_level), nvars, ncells1);
       ScrArray2D<Real> scr3(member.team_scratch(scr_level), nvars, ncells1);
       ScrArray2D<Real> scr4(member.team_scratch(scr_level), 3, ncells1);
       ScrArray2D<Real> scr5(member.team_scratch(scr_level), 3, ncells1);
       ScrArray2D<Real> scr6(member.team_scratch(scr_level), 3, ncells1);
+      ScrArray2D<Real> gface(member.team_scratch(scr_level), nfmet, ncells1);
 
       for (int k=kl; k<=ku; ++k) {
         // Permute scratch arrays.
@@ -339,6 +384,14 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
           default:
             break;
         }
+        // Interpolate face metric in a separate pass (or copy stored face metric)
+        if constexpr (split_metric_) {
+          if ((k>(kl)) && cache_fmet) {
+            CopyFaceMetric(member, m, k, j, is-1, ie+1, fmet.x3f, gface);
+          } else if (k>(kl)) {
+            StoreFaceMetric<IVZ>(member, m, k, j, is-1, ie+1, adm, gface);
+          }
+        }
         // Sync all threads in the team so that scratch memory is consistent
         member.team_barrier();
 
@@ -357,11 +410,13 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
         //int il = is; int iu = ie;
         if (k>(kl)) {
           if constexpr (rsolver_method_ == DynGRMHD_RSolver::llf_dyngr) {
-            LLF_DYNGR<IVZ>(member, dyn_eos, indcs, size, coord, m, k, j, is-1, ie+1,
-                      wl, wr, bl, br, bz, nhyd_, nscal_, adm_, flx3, e23, e13);
+            LLF_DYNGR<IVZ, split_metric_>(member, dyn_eos, indcs, size, coord,
+                      m, k, j, is-1, ie+1, wl, wr, bl, br, bz, nhyd_, nscal_, adm_,
+                      gface, flx3, e23, e13);
           } else if constexpr (rsolver_method_ == DynGRMHD_RSolver::hlle_dyngr) {
-            HLLE_DYNGR<IVZ>(member, dyn_eos, indcs, size, coord, m, k, j, is-1, ie+1,
-                      wl, wr, bl, br, bz, nhyd_, nscal_, adm_, flx3, e23, e13);
+            HLLE_DYNGR<IVZ, split_metric_>(member, dyn_eos, indcs, size, coord,
+                      m, k, j, is-1, ie+1, wl, wr, bl, br, bz, nhyd_, nscal_, adm_,
+                      gface, flx3, e23, e13);
           }
         }
         member.team_barrier();
@@ -380,13 +435,21 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
         }
       } // end of loop over j
       member.team_barrier();
-    });
+    };
+    if (report_occupancy) {
+      ReportTeamOccupancy<DynGRLaunchBounds>("dyngrflux_x3", scr_size, scr_level,
+                                             flux_x3, 0, js);
+    }
+    par_for_outer<DynGRLaunchBounds>("dyngrflux_x3", DevExeSpace(), scr_size, scr_level,
+                                     0, nmb1, js-1, je+1, flux_x3);
   }
 
   // Call FOFC if necessary
   if (pmy_pack->pmhd->use_fofc || pmy_pack->pcoord->coord_data.bh_excise) {
     FOFC<rsolver_method_>(pdriver, stage);
   }
+  // only report occupancy of flux kernels on first call
+  report_occupancy = false;
 
   return TaskStatus::complete;
 }
@@ -396,10 +459,16 @@ TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::CalcFluxes(Driver *pdriver, int s
 #define INSTANTIATE_CALC_FLUXES(EOSPolicy, ErrorPolicy) \
 template \
 TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::\
-            CalcFluxes<DynGRMHD_RSolver::llf_dyngr>(Driver *pdriver, int stage); \
+            CalcFluxes<DynGRMHD_RSolver::llf_dyngr, false>(Driver *pdriver, int stage); \
+template \
+TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::\
+            CalcFluxes<DynGRMHD_RSolver::hlle_dyngr, false>(Driver *pdriver, int stage); \
+template \
+TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::\
+            CalcFluxes<DynGRMHD_RSolver::llf_dyngr, true>(Driver *pdriver, int stage); \
 template \
 TaskStatus DynGRMHDPS<EOSPolicy, ErrorPolicy>::\
-            CalcFluxes<DynGRMHD_RSolver::hlle_dyngr>(Driver *pdriver, int stage);
+            CalcFluxes<DynGRMHD_RSolver::hlle_dyngr, true>(Driver *pdriver, int stage);
 
 INSTANTIATE_CALC_FLUXES(Primitive::IdealGas, Primitive::ResetFloor)
 INSTANTIATE_CALC_FLUXES(Primitive::PiecewisePolytrope, Primitive::ResetFloor)
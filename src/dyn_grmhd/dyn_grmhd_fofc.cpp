@@ -15,6 +15,7 @@
 #include "coordinates/cartesian_ks.hpp"
 #include "coordinates/cell_locations.hpp"
 #include "eos/eos.hpp"
+#include "utils/cell_list.hpp"
 #include "dyn_grmhd/dyn_grmhd.hpp"
 #include "dyn_grmhd/rsolvers/llf_dyn_grmhd.hpp"
 #include "dyn_grmhd/rsolvers/hlle_dyn_grmhd.hpp"
@@ -158,16 +159,32 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::FOFC(Driver *pdriver, int stage) {
   auto &w0_ = pmy_pack->pmhd->w0;
   auto &b0_ = pmy_pack->pmhd->b0;
   auto &adm = pmy_pack->padm->adm;
+  // face metric stored at the start of the stage by CalcFluxes, if cached
+  const bool cache_fmet = cache_face_metric;
+  auto fmet1 = face_metric.x1f;
+  auto fmet2 = face_metric.x2f;
+  auto fmet3 = face_metric.x3f;
 
   // Index bounds
   int il = is-1, iu = ie+1, jl = js, ju = je, kl = ks, ku = ke;
   if (multi_d) { jl = js-1, ju = je+1; }
   if (three_d) { kl = ks-1, ku = ke+1; }
 
+  // Compact indices of cells flagged for FOFC and/or about the excision into a list, so
+  // that the kernels below are only launched over flagged cells
+  CellRange range{nmb, kl, ku, jl, ju, il, iu};
+  int nflag = FlaggedCellList(range, use_fofc_, fofc_, use_excise_, excision_flux_,
+                              pmy_pack->pmhd->fofc_list);
+  if (nflag == 0) return;
+  auto &fofc_list_ = pmy_pack->pmhd->fofc_list;
+
   // Replace fluxes with first-order LLF fluxes at i,j,k faces for any cell where FOFC
   // and/or excision is used (if GR+excising)
-  par_for("FOFC-flx", DevExeSpace(), 0, nmb-1, kl, ku, jl, ju, il, iu,
-  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+  par_for("FOFC-flx", DevExeSpace(), 0, nflag-1,
+  KOKKOS_LAMBDA(const int idx) {
+    int m, k, j, i;
+    range.Unpack(fofc_list_(idx), m, k, j, i);
+
     // Check for FOFC flag
     bool fofc_flag = false;
     if (use_fofc_) { fofc_flag = fofc_(m,k,j,i); }
@@ -189,7 +206,11 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::FOFC(Driver *pdriver, int stage) {
 
       // Compute the metric terms at i-1/2
       Real g3d[NSPMETRIC], beta_u[3], alpha;
-      adm::Face1Metric(m, k, j, i, adm.g_dd, adm.beta_u, adm.alpha, g3d, beta_u, alpha);
+      if (cache_fmet) {
+        LoadCachedFaceMetric(m, k, j, i, fmet1, g3d, beta_u, alpha);
+      } else {
+        adm::Face1Metric(m, k, j, i, adm.g_dd, adm.beta_u, adm.alpha, g3d, beta_u, alpha);
+      }
 
       // compute new 1st-order LLF flux at i-face
       Real flux[NCONS], bflux[NMAG];
@@ -226,7 +247,12 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::FOFC(Driver *pdriver, int stage) {
         blj[IBY] = brj[IBY] = b0_.x2f(m, k, j, i);
 
         // Compute the metric terms at j-1/2
-        adm::Face2Metric(m, k, j, i, adm.g_dd, adm.beta_u, adm.alpha, g3d, beta_u, alpha);
+        if (cache_fmet) {
+          LoadCachedFaceMetric(m, k, j, i, fmet2, g3d, beta_u, alpha);
+        } else {
+          adm::Face2Metric(m, k, j, i, adm.g_dd, adm.beta_u, adm.alpha,
+                           g3d, beta_u, alpha);
+        }
 
         // Compute new 1st-order LLF flux at j-face
         if constexpr (rsolver_method_ == DynGRMHD_RSolver::llf_dyngr) {
@@ -263,7 +289,12 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::FOFC(Driver *pdriver, int stage) {
         bmk[IBZ] = bpk[IBZ] = b0_.x3f(m, k, j, i);
 
         // Compute the metric terms at k-1/2
-        adm::Face3Metric(m, k, j, i, adm.g_dd, adm.beta_u, adm.alpha, g3d, beta_u, alpha);
+        if (cache_fmet) {
+          LoadCachedFaceMetric(m, k, j, i, fmet3, g3d, beta_u, alpha);
+        } else {
+          adm::Face3Metric(m, k, j, i, adm.g_dd, adm.beta_u, adm.alpha,
+                           g3d, beta_u, alpha);
+        }
 
         // Compute new 1st-order LLF flux at k-face
         if constexpr (rsolver_method_ == DynGRMHD_RSolver::llf_dyngr) {
@@ -293,8 +324,11 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::FOFC(Driver *pdriver, int stage) {
 
   // Replace fluxes with first-order LLF fluxes at i+1,j+1,k+1 faces for any cell where
   // FOFC and/or excision is used (if GR+excising)
-  par_for("FOFC-flx", DevExeSpace(), 0, nmb-1, kl, ku, jl, ju, il, iu,
-  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+  par_for("FOFC-flx", DevExeSpace(), 0, nflag-1,
+  KOKKOS_LAMBDA(const int idx) {
+    int m, k, j, i;
+    range.Unpack(fofc_list_(idx), m, k, j, i);
+
     // Check for FOFC flag
     bool fofc_flag = false;
     if (use_fofc_) { fofc_flag = fofc_(m,k,j,i); }
@@ -316,7 +350,12 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::FOFC(Driver *pdriver, int stage) {
 
       // Compute the metric terms at i+1/2
       Real g3d[NSPMETRIC], beta_u[3], alpha;
-      adm::Face1Metric(m, k, j, i+1, adm.g_dd, adm.beta_u, adm.alpha, g3d, beta_u, alpha);
+      if (cache_fmet) {
+        LoadCachedFaceMetric(m, k, j, i+1, fmet1, g3d, beta_u, alpha);
+      } else {
+        adm::Face1Metric(m, k, j, i+1, adm.g_dd, adm.beta_u, adm.alpha,
+                         g3d, beta_u, alpha);
+      }
 
       // compute new 1st-order LLF flux at (i+1)-face
       Real flux[NCONS], bflux[NMAG];
@@ -353,8 +392,12 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::FOFC(Driver *pdriver, int stage) {
         blj[IBY] = brj[IBY] = b0_.x2f(m, k, j+1, i);
 
         // Compute the metric terms at j+1/2
-        adm::Face2Metric(m, k, j+1, i, adm.g_dd, adm.beta_u, adm.alpha,
-                         g3d, beta_u, alpha);
+        if (cache_fmet) {
+          LoadCachedFaceMetric(m, k, j+1, i, fmet2, g3d, beta_u, alpha);
+        } else {
+          adm::Face2Metric(m, k, j+1, i, adm.g_dd, adm.beta_u, adm.alpha,
+                           g3d, beta_u, alpha);
+        }
 
         // Compute new 1st-order LLF flux at j-face
         if constexpr (rsolver_method_ == DynGRMHD_RSolver::llf_dyngr) {
@@ -391,8 +434,12 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::FOFC(Driver *pdriver, int stage) {
         bmk[IBZ] = bpk[IBZ] = b0_.x3f(m, k+1, j, i);
 
         // Compute the metric terms at k+1/2
-        adm::Face3Metric(m, k+1, j, i, adm.g_dd, adm.beta_u, adm.alpha,
-                         g3d, beta_u, alpha);
+        if (cache_fmet) {
+          LoadCachedFaceMetric(m, k+1, j, i, fmet3, g3d, beta_u, alpha);
+        } else {
+          adm::Face3Metric(m, k+1, j, i, adm.g_dd, adm.beta_u, adm.alpha,
+                           g3d, beta_u, alpha);
+        }
 
         // Compute new 1st-order LLF flux at k-face
         if constexpr (rsolver_method_ == DynGRMHD_RSolver::llf_dyngr) {
@@ -421,9 +468,14 @@ void DynGRMHDPS<EOSPolicy, ErrorPolicy>::FOFC(Driver *pdriver, int stage) {
   });
 
 
-  // reset FOFC flag (do not reset excision flag)
+  // reset FOFC flag of cells in list (do not reset excision flag)
   if (use_fofc_) {
-    Kokkos::deep_copy(fofc_, false);
+    par_for("FOFC-reset", DevExeSpace(), 0, nflag-1,
+    KOKKOS_LAMBDA(const int idx) {
+      int m, k, j, i;
+      range.Unpack(fofc_list_(idx), m, k, j, i);
+      fofc_(m,k,j,i) = false;
+    });
   }
 
   return;
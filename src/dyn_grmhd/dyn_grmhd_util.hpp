@@ -8,7 +8,11 @@
 //! \file dyngr_util.hpp
 //  \brief Utility functions for use with dynamic hydro
 
+#include <iostream>
+#include <string>
+
 #include "athena.hpp"
+#include "globals.hpp"
 #include "coordinates/adm.hpp"
 #include "dyn_grmhd.hpp"
 #include "eos/primitive_solver_hyd.hpp"
@@ -53,6 +57,29 @@ void InsertFluxes(const Real flux_pt[NCONS], const DvceArray5D<Real>& flx,
   flx(m, IEN, k, j, i) = flux_pt[CTA];
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void ReportTeamOccupancy
+//! \brief prints the maximum and recommended team sizes Kokkos selects for the team
+//! kernel that par_for_outer<LB> launches with function and scratch size scr_size.  On
+//! GPUs these are limited by the registers used per thread, so they measure occupancy.
+//! Indices idx are only used to instantiate the kernel, which is never launched.
+
+template <typename LB, typename Function, typename... Indices>
+void ReportTeamOccupancy(const std::string &name, size_t scr_size, const int scr_level,
+                         const Function &function, Indices... idx) {
+  if (global_variable::my_rank != 0) return;
+  auto kernel = KOKKOS_LAMBDA(TeamMember_t tmember) {
+    function(tmember, idx...);
+  };
+  Kokkos::TeamPolicy<LB> policy(DevExeSpace(), 1, Kokkos::AUTO);
+  policy = policy.set_scratch_size(scr_level, Kokkos::PerTeam(scr_size));
+  int tmax = policy.team_size_max(kernel, Kokkos::ParallelForTag());
+  int trec = policy.team_size_recommended(kernel, Kokkos::ParallelForTag());
+  std::cout << "Kernel " << name << ": max team size = " << tmax
+            << ", recommended team size = " << trec
+            << ", scratch per team = " << scr_size << " bytes" << std::endl;
+}
+
 } // namespace dyngr
 
 #endif  // DYN_GRMHD_DYN_GRMHD_UTIL_HPP_
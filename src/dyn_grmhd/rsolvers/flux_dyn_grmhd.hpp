@@ -10,6 +10,7 @@
 #include <stdio.h>
 #include <math.h>
 
+#include "coordinates/adm.hpp"
 #include "eos/primitive_solver_hyd.hpp"
 #include "eos/primitive-solver/geom_math.hpp"
 
@@ -17,7 +18,9 @@ namespace dyngr {
 
 //----------------------------------------------------------------------------------------
 //! \fn void SingleStateFlux
-//! \brief inline function for calculating GRMHD fluxes
+//! \brief inline function for calculating GRMHD fluxes.  Also returns the sound speeds
+//! cs and enthalpy densities H of both states, evaluated together with a single call
+//! to the EOS per state, for use in the signal speeds.
 
 template<int ivx, class EOSPolicy, class ErrorPolicy>
 KOKKOS_INLINE_FUNCTION
@@ -27,7 +30,7 @@ void SingleStateFlux(const PrimitiveSolverHydro<EOSPolicy, ErrorPolicy>& eos,
     Real g3d[NSPMETRIC], Real beta_u[3], Real alpha,
     Real cons_l[NCONS], Real cons_r[NCONS],
     Real flux_l[NCONS], Real flux_r[NCONS], Real bflux_l[NMAG], Real bflux_r[NMAG],
-    Real& bsql, Real& bsqr) {
+    Real& bsql, Real& bsqr, Real& csl, Real& csr, Real& Hl, Real& Hr) {
   constexpr int pvx = PVX + (ivx - IVX);
   constexpr int pvy = PVX + ((ivx - IVX) + 1)%3;
   constexpr int pvz = PVX + ((ivx - IVX) + 2)%3;
@@ -40,9 +43,18 @@ void SingleStateFlux(const PrimitiveSolverHydro<EOSPolicy, ErrorPolicy>& eos,
 
   const Real ialpha = 1.0/alpha;
 
+  // Evaluate the EOS once per state
+  const auto &ps_eos = eos.ps.GetEOS();
+  const Real mb = ps_eos.GetBaryonMass();
+  Real P, e, hl, hr;
+  ps_eos.GetThermodynamics(prim_l[PRH], prim_l[PTM], &prim_l[PYF], P, e, hl, csl);
+  ps_eos.GetThermodynamics(prim_r[PRH], prim_r[PTM], &prim_r[PYF], P, e, hr, csr);
+  Hl = mb*prim_l[PRH]*hl;
+  Hr = mb*prim_r[PRH]*hr;
+
   // Calculate conserved variables
-  eos.ps.PrimToCon(prim_l, cons_l, Bu_l, g3d);
-  eos.ps.PrimToCon(prim_r, cons_r, Bu_r, g3d);
+  eos.ps.PrimToCon(prim_l, cons_l, Bu_l, g3d, hl);
+  eos.ps.PrimToCon(prim_r, cons_r, Bu_r, g3d, hr);
 
   // Calculate W for the left state.
   Real uul[3] = {prim_l[IVX], prim_l[IVY], prim_l[IVZ]};
@@ -109,6 +121,106 @@ void SingleStateFlux(const PrimitiveSolverHydro<EOSPolicy, ErrorPolicy>& eos,
                     Bu_r[ibx]*(prim_r[pvz]*iWr - beta_u[pvz - PVX]*ialpha));
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void FaceMetric
+//! \brief interpolates 3-metric, shift and lapse to face i in direction ivx
+
+template<int ivx>
+KOKKOS_INLINE_FUNCTION
+void FaceMetric(const int m, const int k, const int j, const int i,
+     const adm::ADM::ADM_vars& adm, Real g3d[NSPMETRIC], Real beta_u[3], Real &alpha) {
+  if constexpr (ivx == IVX) {
+    adm::Face1Metric(m, k, j, i, adm.g_dd, adm.beta_u, adm.alpha, g3d, beta_u, alpha);
+  } else if constexpr (ivx == IVY) {
+    adm::Face2Metric(m, k, j, i, adm.g_dd, adm.beta_u, adm.alpha, g3d, beta_u, alpha);
+  } else if constexpr (ivx == IVZ) {
+    adm::Face3Metric(m, k, j, i, adm.g_dd, adm.beta_u, adm.alpha, g3d, beta_u, alpha);
+  }
+}
+
+// number of face metric values (3-metric, shift, lapse) stored by StoreFaceMetric
+constexpr int NFACEMETRIC = NSPMETRIC + 4;
+
+//----------------------------------------------------------------------------------------
+//! \fn void StoreFaceMetric
+//! \brief interpolates face metric over [il,iu] into scratch array gface in a separate
+//! pass, so that the Riemann solvers only need to load it (with split_metric=true).  This
+//! reduces the number of registers live during the Riemann solve.
+
+template<int ivx>
+KOKKOS_INLINE_FUNCTION
+void StoreFaceMetric(TeamMember_t const &member,
+     const int m, const int k, const int j, const int il, const int iu,
+     const adm::ADM::ADM_vars& adm, const ScrArray2D<Real> &gface) {
+  par_for_inner(member, il, iu, [&](const int i) {
+    Real g3d[NSPMETRIC], beta_u[3], alpha;
+    FaceMetric<ivx>(m, k, j, i, adm, g3d, beta_u, alpha);
+    for (int n = 0; n < NSPMETRIC; ++n) {
+      gface(n, i) = g3d[n];
+    }
+    for (int a = 0; a < 3; ++a) {
+      gface(NSPMETRIC + a, i) = beta_u[a];
+    }
+    gface(NSPMETRIC + 3, i) = alpha;
+  });
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void LoadFaceMetric
+//! \brief returns face metric at face i, either loaded from gface (if split_metric) or
+//! interpolated directly from the cell-centered metric.
+
+template<int ivx, bool split_metric>
+KOKKOS_INLINE_FUNCTION
+void LoadFaceMetric(const int m, const int k, const int j, const int i,
+     const adm::ADM::ADM_vars& adm, const ScrArray2D<Real> &gface,
+     Real g3d[NSPMETRIC], Real beta_u[3], Real &alpha) {
+  if constexpr (split_metric) {
+    for (int n = 0; n < NSPMETRIC; ++n) {
+      g3d[n] = gface(n, i);
+    }
+    for (int a = 0; a < 3; ++a) {
+      beta_u[a] = gface(NSPMETRIC + a, i);
+    }
+    alpha = gface(NSPMETRIC + 3, i);
+  } else {
+    FaceMetric<ivx>(m, k, j, i, adm, g3d, beta_u, alpha);
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void LoadCachedFaceMetric
+//! \brief returns face metric at face (k,j,i) from the array fmet of the face metric
+//! stored once per stage by DynGRMHD::StoreFaceMetricCache() (with cache_face_metric).
+
+KOKKOS_INLINE_FUNCTION
+void LoadCachedFaceMetric(const int m, const int k, const int j, const int i,
+     const DvceArray5D<Real> &fmet, Real g3d[NSPMETRIC], Real beta_u[3], Real &alpha) {
+  for (int n = 0; n < NSPMETRIC; ++n) {
+    g3d[n] = fmet(m, n, k, j, i);
+  }
+  for (int a = 0; a < 3; ++a) {
+    beta_u[a] = fmet(m, NSPMETRIC + a, k, j, i);
+  }
+  alpha = fmet(m, NSPMETRIC + 3, k, j, i);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void CopyFaceMetric
+//! \brief copies face metric over faces [il,iu] of row (k,j) from the cached array fmet
+//! into scratch array gface, in place of StoreFaceMetric (with cache_face_metric).
+
+KOKKOS_INLINE_FUNCTION
+void CopyFaceMetric(TeamMember_t const &member,
+     const int m, const int k, const int j, const int il, const int iu,
+     const DvceArray5D<Real> &fmet, const ScrArray2D<Real> &gface) {
+  for (int n = 0; n < NFACEMETRIC; ++n) {
+    par_for_inner(member, il, iu, [&](const int i) {
+      gface(n, i) = fmet(m, n, k, j, i);
+    });
+  }
+}
+
 } // namespace dyngr
 
 #endif  // DYN_GRMHD_RSOLVERS_FLUX_DYN_GRMHD_HPP_
@@ -56,17 +56,18 @@ void SingleStateLLF_DYNGR(const PrimitiveSolverHydro<EOSPolicy, ErrorPolicy>& eo
   // Calculate the left and right fluxes
   Real cons_l[NCONS], cons_r[NCONS];
   Real fl[NCONS], fr[NCONS], bfl[NMAG], bfr[NMAG];
-  Real bsql, bsqr;
+  Real bsql, bsqr, csl, csr, Hl, Hr;
   SingleStateFlux<ivx>(eos, prim_l, prim_r, Bu_lund, Bu_rund, nmhd, nscal, g3d, beta_u,
-                       alpha, cons_l, cons_r, fl, fr, bfl, bfr, bsql, bsqr);
+                       alpha, cons_l, cons_r, fl, fr, bfl, bfr, bsql, bsqr,
+                       csl, csr, Hl, Hr);
 
 
   // Calculate the magnetosonic speeds for both states
   Real lambda_pl, lambda_pr, lambda_ml, lambda_mr;
   Real gii = (g3d[idxy]*g3d[idxz] - g3d[offidx]*g3d[offidx])*(isdetg*isdetg);
-  eos.GetGRFastMagnetosonicSpeeds(lambda_pl, lambda_ml, prim_l, bsql,
+  eos.GetGRFastMagnetosonicSpeeds(lambda_pl, lambda_ml, prim_l, bsql, csl, Hl,
                                   g3d, beta_u, alpha, gii, pvx);
-  eos.GetGRFastMagnetosonicSpeeds(lambda_pr, lambda_mr, prim_r, bsqr,
+  eos.GetGRFastMagnetosonicSpeeds(lambda_pr, lambda_mr, prim_r, bsqr, csr, Hr,
                                   g3d, beta_u, alpha, gii, pvx);
 
   // Get the extremal wavespeeds
@@ -95,7 +96,7 @@ void SingleStateLLF_DYNGR(const PrimitiveSolverHydro<EOSPolicy, ErrorPolicy>& eo
 //! TODO: This could potentially be sped up by calculating the conserved variables without
 //  the help of PrimitiveSolver; there are redundant calculations with B^i v_i and W that
 //  may not be needed.
-template<int ivx, class EOSPolicy, class ErrorPolicy>
+template<int ivx, bool split_metric, class EOSPolicy, class ErrorPolicy>
 KOKKOS_INLINE_FUNCTION
 void LLF_DYNGR(TeamMember_t const &member,
      const PrimitiveSolverHydro<EOSPolicy, ErrorPolicy>& eos,
@@ -105,7 +106,7 @@ void LLF_DYNGR(TeamMember_t const &member,
      const ScrArray2D<Real> &wl, const ScrArray2D<Real> &wr,
      const ScrArray2D<Real> &bl, const ScrArray2D<Real> &br, const DvceArray4D<Real> &bx,
      const int& nhyd, const int& nscal,
-     const adm::ADM::ADM_vars& adm,
+     const adm::ADM::ADM_vars& adm, const ScrArray2D<Real> &gface,
      DvceArray5D<Real> flx, DvceArray4D<Real> ey, DvceArray4D<Real> ez) {
   par_for_inner(member, il, iu, [&](const int i) {
     constexpr int ibx = ivx - IVX;
@@ -123,13 +124,7 @@ void LLF_DYNGR(TeamMember_t const &member,
     Real g3d[NSPMETRIC];
     Real beta_u[3];
     Real alpha;
-    if constexpr (ivx == IVX) {
-      adm::Face1Metric(m, k, j, i, adm.g_dd, adm.beta_u, adm.alpha, g3d, beta_u, alpha);
-    } else if (ivx == IVY) {
-      adm::Face2Metric(m, k, j, i, adm.g_dd, adm.beta_u, adm.alpha, g3d, beta_u, alpha);
-    } else if (ivx == IVZ) {
-      adm::Face3Metric(m, k, j, i, adm.g_dd, adm.beta_u, adm.alpha, g3d, beta_u, alpha);
-    }
+    LoadFaceMetric<ivx, split_metric>(m, k, j, i, adm, gface, g3d, beta_u, alpha);
 
     Real sdetg = sqrt(Primitive::GetDeterminant(g3d));
     Real isdetg = 1.0/sdetg;
@@ -180,16 +175,17 @@ void LLF_DYNGR(TeamMember_t const &member,
     // Calculate the left and right fluxes
     Real cons_l[NCONS], cons_r[NCONS];
     Real fl[NCONS], fr[NCONS], bfl[NMAG], bfr[NMAG];
-    Real bsql, bsqr;
+    Real bsql, bsqr, csl, csr, Hl, Hr;
     SingleStateFlux<ivx>(eos, prim_l, prim_r, Bu_l, Bu_r, nhyd, nscal, g3d, beta_u, alpha,
-                         cons_l, cons_r, fl, fr, bfl, bfr, bsql, bsqr);
+                         cons_l, cons_r, fl, fr, bfl, bfr, bsql, bsqr,
+                         csl, csr, Hl, Hr);
 
     // Calculate the magnetosonic speeds for both states
     Real lambda_pl, lambda_pr, lambda_ml, lambda_mr;
     Real gii = (g3d[idxy]*g3d[idxz] - g3d[offidx]*g3d[offidx])*(isdetg*isdetg);
-    eos.GetGRFastMagnetosonicSpeeds(lambda_pl, lambda_ml, prim_l, bsql,
+    eos.GetGRFastMagnetosonicSpeeds(lambda_pl, lambda_ml, prim_l, bsql, csl, Hl,
                                     g3d, beta_u, alpha, gii, pvx);
-    eos.GetGRFastMagnetosonicSpeeds(lambda_pr, lambda_mr, prim_r, bsqr,
+    eos.GetGRFastMagnetosonicSpeeds(lambda_pr, lambda_mr, prim_r, bsqr, csr, Hr,
                                     g3d, beta_u, alpha, gii, pvx);
 
     // Get the extremal wavespeeds
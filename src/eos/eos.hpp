@@ -191,6 +191,23 @@ struct EOS_Data {
   }
 };
 
+//----------------------------------------------------------------------------------------
+//! \fn SpecializeEOS()
+//! \brief Returns copy of EOS_Data with EOS fixed at compile time in flux kernels
+//! specialized for one EOS, so that branches on is_ideal are removed by the compiler.
+
+template <KernelEOS E>
+KOKKOS_INLINE_FUNCTION
+EOS_Data SpecializeEOS(const EOS_Data &eos_in) {
+  EOS_Data eos = eos_in;
+  if constexpr (E == KernelEOS::ideal) {
+    eos.is_ideal = true;
+  } else if constexpr (E == KernelEOS::isothermal) {
+    eos.is_ideal = false;
+  }
+  return eos;
+}
+
 //----------------------------------------------------------------------------------------
 //! \class EquationOfState
 //! \brief Abstract base class for EOS.
@@ -203,6 +220,18 @@ class EquationOfState {
   MeshBlockPack* pmy_pack;
   EOS_Data eos_data;
 
+  // following used to compute minimum dx/(|v|+c) over active cells in each direction as
+  // a by-product of ConsToPrim(), see <hydro>/fused_newdt.  Only supported by the
+  // non-relativistic EOS, which set c2p_dt_done when the minima have been stored.
+  bool c2p_newdt = false;       // compute timestep in next call to ConsToPrim()
+  bool c2p_dt_done = false;     // true when c2p_dt1/2/3 are valid
+  Real c2p_dt1, c2p_dt2, c2p_dt3;
+
+  // following used to start the root find in ConsToPrim() from the primitives stored at
+  // the previous call, see <mhd>/c2p_warm_start.  Only supported by ideal gas GRMHD.
+  bool c2p_warm_start = false;  // seed root find with solution of previous call
+  Real c2p_warm_tol = 0.0;      // keep previous prims if cons changed by less than this
+
   // virtual functions to convert cons to prim in either Hydro or MHD (depending on
   // arguments), overwritten in derived eos classes
   virtual void ConsToPrim(DvceArray5D<Real> &cons, DvceArray5D<Real> &prim,
@@ -122,14 +122,18 @@ Real Equation44(const Real mu, const Real b2, const Real rpar, const Real r, con
 //! \brief Converts single state of conserved variables into primitive variables for
 //! special relativistic MHD with an ideal gas EOS. Note input CONSERVED state contains
 //! cell-centered magnetic fields, but PRIMITIVE state returned via arguments does not.
+//! If mu_guess > 0 (e.g. 1/(hW) of the previous solution), the root is first bracketed
+//! within a narrow interval about it, which skips the search for the upper bracket when
+//! the interval contains the root.
 
 KOKKOS_INLINE_FUNCTION
 void SingleC2P_IdealSRMHD(MHDCons1D &u, const EOS_Data &eos, Real s2, Real b2, Real rpar,
                           HydPrim1D &w, bool &dfloor_used, bool &efloor_used,
-                          bool &c2p_failure, int &max_iter) {
+                          bool &c2p_failure, int &max_iter, const Real mu_guess = 0.0) {
   // Parameters
   const int max_iterations = 25;
   const Real tol = 1.0e-12;
+  const Real seed_width = 1.0e-2;  // relative half-width of bracket about mu_guess
   const Real gm1 = eos.gamma - 1.0;
 
   // apply density floor, without changing momentum or energy
@@ -156,53 +160,66 @@ void SingleC2P_IdealSRMHD(MHDCons1D &u, const EOS_Data &eos, Real s2, Real b2, R
   b2 /= u.d;
   rpar *= isqrtd;
 
-  // Need to find initial bracket. Requires separate solve
-  Real zm=0.;
-  Real zp=1.; // This is the lowest specific enthalpy admitted by the EOS
+  // Try narrow bracket about guess (comparisons are false if guess is NaN)
+  Real zm=0., zp=1., fm=0., fp=0., z=0.;
+  int iterations, iter;
+  bool seeded = false;
+  if (mu_guess > 0.0) {
+    zm = (1.0 - seed_width)*mu_guess;
+    zp = fmin((1.0 + seed_width)*mu_guess, 1.0);
+    fm = Equation44(zm, b2, rpar, r, q, u.d, eos);
+    fp = Equation44(zp, b2, rpar, r, q, u.d, eos);
+    seeded = (fm*fp < 0.0);
+  }
 
-  // Evaluate master function (eq 49) at bracket values
-  Real fm = Equation49(zm, b2, rpar, r, q);
-  Real fp = Equation49(zp, b2, rpar, r, q);
+  if (!(seeded)) {
+    // Need to find initial bracket. Requires separate solve
+    zm=0.;
+    zp=1.; // This is the lowest specific enthalpy admitted by the EOS
 
-  // For simplicity on the GPU, find roots using the false position method
-  int iterations = max_iterations;
-  // If bracket within tolerances, don't bother doing any iterations
-  if ((fabs(zm-zp) < tol) || ((fabs(fm) + fabs(fp)) < 2.0*tol)) {
-    iterations = -1;
-  }
-  Real z = 0.5*(zm + zp);
+    // Evaluate master function (eq 49) at bracket values
+    fm = Equation49(zm, b2, rpar, r, q);
+    fp = Equation49(zp, b2, rpar, r, q);
 
-  int iter;
-  for (iter=0; iter<iterations; ++iter) {
-    z =  (zm*fp - zp*fm)/(fp-fm);  // linear interpolation to point f(z)=0
-    Real f = Equation49(z, b2, rpar, r, q);
-    // Quit if convergence reached
-    // NOTE(@ermost): both z and f are of order unity
-    if ((fabs(zm-zp) < tol) || (fabs(f) < tol)) {
-      break;
+    // For simplicity on the GPU, find roots using the false position method
+    iterations = max_iterations;
+    // If bracket within tolerances, don't bother doing any iterations
+    if ((fabs(zm-zp) < tol) || ((fabs(fm) + fabs(fp)) < 2.0*tol)) {
+      iterations = -1;
     }
-    // assign zm-->zp if root bracketed by [z,zp]
-    if (f*fp < 0.0) {
-      zm = zp;
-      fm = fp;
-      zp = z;
-      fp = f;
-    } else {  // assign zp-->z if root bracketed by [zm,z]
-      fm = 0.5*fm; // 1/2 comes from "Illinois algorithm" to accelerate convergence
-      zp = z;
-      fp = f;
+    z = 0.5*(zm + zp);
+
+    for (iter=0; iter<iterations; ++iter) {
+      z =  (zm*fp - zp*fm)/(fp-fm);  // linear interpolation to point f(z)=0
+      Real f = Equation49(z, b2, rpar, r, q);
+      // Quit if convergence reached
+      // NOTE(@ermost): both z and f are of order unity
+      if ((fabs(zm-zp) < tol) || (fabs(f) < tol)) {
+        break;
+      }
+      // assign zm-->zp if root bracketed by [z,zp]
+      if (f*fp < 0.0) {
+        zm = zp;
+        fm = fp;
+        zp = z;
+        fp = f;
+      } else {  // assign zp-->z if root bracketed by [zm,z]
+        fm = 0.5*fm; // 1/2 comes from "Illinois algorithm" to accelerate convergence
+        zp = z;
+        fp = f;
+      }
     }
-  }
-  max_iter = (iter > max_iter) ? iter : max_iter;
+    max_iter = (iter > max_iter) ? iter : max_iter;
 
-  // Found brackets. Now find solution in bounded interval, again using the
-  // false position method
-  zm= 0.;
-  zp= z;
+    // Found brackets. Now find solution in bounded interval, again using the
+    // false position method
+    zm= 0.;
+    zp= z;
 
-  // Evaluate master function (eq 44) at bracket values
-  fm = Equation44(zm, b2, rpar, r, q, u.d, eos);
-  fp = Equation44(zp, b2, rpar, r, q, u.d, eos);
+    // Evaluate master function (eq 44) at bracket values
+    fm = Equation44(zm, b2, rpar, r, q, u.d, eos);
+    fp = Equation44(zp, b2, rpar, r, q, u.d, eos);
+  }
 
   iterations = max_iterations;
   if ((fabs(zm-zp) < tol) || ((fabs(fm) + fabs(fp)) < 2.0*tol)) {
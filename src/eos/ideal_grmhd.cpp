@@ -28,12 +28,19 @@ IdealGRMHD::IdealGRMHD(MeshBlockPack *pp, ParameterInput *pin) :
   eos_data.use_e = true;  // ideal gas EOS always uses internal energy
   eos_data.use_t = false;
   eos_data.gamma_max = pin->GetOrAddReal("mhd","gamma_max",(FLT_MAX));  // gamma ceiling
+  c2p_warm_start = pin->GetOrAddBoolean("mhd","c2p_warm_start",false);
+  if (c2p_warm_start) {
+    c2p_warm_tol = pin->GetOrAddReal("mhd","c2p_warm_tol",1.0e-10);
+  }
 }
 
 //----------------------------------------------------------------------------------------
 //! \fn void ConsToPrim()
 //! \brief Converts conserved into primitive variables.
 //! Operates over range of cells given in argument list.
+//! With <mhd>/c2p_warm_start, the primitives stored in prim by the previous call are
+//! reused unchanged in cells where the conserved variables they imply differ from cons
+//! by less than <mhd>/c2p_warm_tol (relative), and otherwise used to seed the root find.
 
 void IdealGRMHD::ConsToPrim(DvceArray5D<Real> &cons, const DvceFaceFld4D<Real> &b,
                             DvceArray5D<Real> &prim, DvceArray5D<Real> &bcc,
@@ -52,11 +59,17 @@ void IdealGRMHD::ConsToPrim(DvceArray5D<Real> &cons, const DvceFaceFld4D<Real> &
 
   auto &flat = pmy_pack->pcoord->coord_data.is_minkowski;
   auto &spin = pmy_pack->pcoord->coord_data.bh_spin;
+  auto &cache_metric = pmy_pack->pcoord->coord_data.cache_metric;
+  auto &gcc = pmy_pack->pcoord->coord_data.gcc;
   auto &use_excise = pmy_pack->pcoord->coord_data.bh_excise;
   auto &excision_floor_ = pmy_pack->pcoord->excision_floor;
   auto &excision_flux_ = pmy_pack->pcoord->excision_flux;
   auto &dexcise_ = pmy_pack->pcoord->coord_data.dexcise;
   auto &pexcise_ = pmy_pack->pcoord->coord_data.pexcise;
+  const bool warm_start = c2p_warm_start;
+  const bool c2p_stats = pmy_pack->pmhd->c2p_stats;
+  auto &c2p_count_ = pmy_pack->pmhd->c2p_count;
+  const Real warm_tol = c2p_warm_tol;
 
   const int ni   = (iu - il + 1);
   const int nji  = (ju - jl + 1)*ni;
@@ -108,7 +121,11 @@ void IdealGRMHD::ConsToPrim(DvceArray5D<Real> &cons, const DvceFaceFld4D<Real> &
     Real x3v = CellCenterX(k-ks, indcs.nx3, x3min, x3max);
 
     Real glower[4][4], gupper[4][4];
-    ComputeMetricAndInverse(x1v, x2v, x3v, flat, spin, glower, gupper);
+    if (cache_metric) {
+      LoadMetricAndInverse(gcc, m, k, j, i, glower, gupper);
+    } else {
+      ComputeMetricAndInverse(x1v, x2v, x3v, flat, spin, glower, gupper);
+    }
 
     HydPrim1D w;
     bool dfloor_used=false, efloor_used=false;
@@ -133,7 +150,43 @@ void IdealGRMHD::ConsToPrim(DvceArray5D<Real> &cons, const DvceFaceFld4D<Real> &
       }
     }
 
-    if (!(excised)) {
+    // With warm start, keep previous primitives if they still reproduce the conserved
+    // variables to within tolerance, else use them to compute guess for mu = 1/(hW).
+    bool reused = false;
+    Real mu_guess = 0.0;
+    if (warm_start && !(excised)) {
+      MHDPrim1D w_old;
+      w_old.d  = prim(m,IDN,k,j,i);
+      w_old.vx = prim(m,IVX,k,j,i);
+      w_old.vy = prim(m,IVY,k,j,i);
+      w_old.vz = prim(m,IVZ,k,j,i);
+      w_old.e  = prim(m,IEN,k,j,i);
+      w_old.bx = u.bx;
+      w_old.by = u.by;
+      w_old.bz = u.bz;
+      HydCons1D u_old;
+      SingleP2C_IdealGRMHD(glower, gupper, w_old, eos.gamma, u_old);
+      Real du = fabs(u.d - u_old.d) + fabs(u.e - u_old.e) + fabs(u.mx - u_old.mx)
+              + fabs(u.my - u_old.my) + fabs(u.mz - u_old.mz);
+      // comparisons are false (no reuse, no guess) if previous prims are not finite
+      if (du <= warm_tol*(fabs(u.d) + fabs(u.e))) {
+        w.d  = w_old.d;
+        w.vx = w_old.vx;
+        w.vy = w_old.vy;
+        w.vz = w_old.vz;
+        w.e  = w_old.e;
+        reused = true;
+      } else if (w_old.d > 0.0 && w_old.e > 0.0) {
+        Real usq = glower[1][1]*SQR(w_old.vx) + glower[2][2]*SQR(w_old.vy)
+                 + glower[3][3]*SQR(w_old.vz) + 2.0*glower[1][2]*w_old.vx*w_old.vy
+                 + 2.0*glower[1][3]*w_old.vx*w_old.vz
+                 + 2.0*glower[2][3]*w_old.vy*w_old.vz;
+        Real h = 1.0 + eos.gamma*w_old.e/w_old.d;
+        mu_guess = 1.0/(h*sqrt(1.0 + usq));
+      }
+    }
+
+    if (!(excised) && !(reused)) {
       // calculate SR conserved quantities
       MHDCons1D u_sr;
       Real s2, b2, rpar;
@@ -142,7 +195,7 @@ void IdealGRMHD::ConsToPrim(DvceArray5D<Real> &cons, const DvceFaceFld4D<Real> &
       // call c2p function
       // (inline function in ideal_c2p_mhd.hpp file)
       SingleC2P_IdealSRMHD(u_sr, eos, s2, b2, rpar, w,
-                           dfloor_used, efloor_used, c2p_failure, iter_used);
+                           dfloor_used, efloor_used, c2p_failure, iter_used, mu_guess);
 
       // apply velocity ceiling if necessary
       Real tmp = glower[1][1]*SQR(w.vx)
@@ -172,6 +225,12 @@ void IdealGRMHD::ConsToPrim(DvceArray5D<Real> &cons, const DvceFaceFld4D<Real> &
       if (vceiling_used) {sumv++;}
       if (c2p_failure) {sumf++;}
       max_it = (iter_used > max_it) ? iter_used : max_it;
+      if (c2p_stats) {
+        c2p_count_(m,0,k,j,i) += iter_used;
+        if (dfloor_used || efloor_used || vceiling_used || c2p_failure) {
+          c2p_count_(m,1,k,j,i) += 1.0;
+        }
+      }
 
       // store primitive state in 3D array
       prim(m,IDN,k,j,i) = w.d;
@@ -242,6 +301,8 @@ void IdealGRMHD::PrimToCons(const DvceArray5D<Real> &prim, const DvceArray5D<Rea
   auto &size = pmy_pack->pmb->mb_size;
   auto &flat = pmy_pack->pcoord->coord_data.is_minkowski;
   auto &spin = pmy_pack->pcoord->coord_data.bh_spin;
+  auto &cache_metric = pmy_pack->pcoord->coord_data.cache_metric;
+  auto &gcc = pmy_pack->pcoord->coord_data.gcc;
   int &nmhd  = pmy_pack->pmhd->nmhd;
   int &nscal = pmy_pack->pmhd->nscalars;
   int &nmb = pmy_pack->nmb_thispack;
@@ -263,7 +324,11 @@ void IdealGRMHD::PrimToCons(const DvceArray5D<Real> &prim, const DvceArray5D<Rea
     Real x3v = CellCenterX(k-ks, indcs.nx3, x3min, x3max);
 
     Real glower[4][4], gupper[4][4];
-    ComputeMetricAndInverse(x1v, x2v, x3v, flat, spin, glower, gupper);
+    if (cache_metric) {
+      LoadMetricAndInverse(gcc, m, k, j, i, glower, gupper);
+    } else {
+      ComputeMetricAndInverse(x1v, x2v, x3v, flat, spin, glower, gupper);
+    }
 
     // Load single state of primitive variables
     MHDPrim1D w;
@@ -6,7 +6,10 @@
 //! \file ideal_mhd.cpp
 //! \brief derived class that implements ideal gas EOS in nonrelativistic mhd
 
+#include <limits>
+
 #include "athena.hpp"
+#include "mesh/mesh.hpp"
 #include "mhd/mhd.hpp"
 #include "eos.hpp"
 #include "eos/ideal_c2p_mhd.hpp"
@@ -27,6 +30,7 @@ IdealMHD::IdealMHD(MeshBlockPack *pp, ParameterInput *pin) :
 //! \!fn void ConsToPrim()
 //! \brief Converts conserved into primitive variables.  Operates over range of cells
 //! given in argument list.
+//! If c2p_newdt is set, also computes minimum dx/(|v|+cf) over active cells.
 
 void IdealMHD::ConsToPrim(DvceArray5D<Real> &cons, const DvceFaceFld4D<Real> &b,
                           DvceArray5D<Real> &prim, DvceArray5D<Real> &bcc,
@@ -38,6 +42,12 @@ void IdealMHD::ConsToPrim(DvceArray5D<Real> &cons, const DvceFaceFld4D<Real> &b,
   int &nmb = pmy_pack->nmb_thispack;
   auto &eos = eos_data;
   auto &fofc_ = pmy_pack->pmhd->fofc;
+  auto &mbsize = pmy_pack->pmb->mb_size;
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, ie = indcs.ie;
+  int js = indcs.js, je = indcs.je;
+  int ks = indcs.ks, ke = indcs.ke;
+  const bool newdt = c2p_newdt && !(only_testfloors);
 
   const int ni   = (iu - il + 1);
   const int nji  = (ju - jl + 1)*ni;
@@ -45,8 +55,12 @@ void IdealMHD::ConsToPrim(DvceArray5D<Real> &cons, const DvceFaceFld4D<Real> &b,
   const int nmkji = nmb*nkji;
 
   int nfloord_=0, nfloore_=0, nfloort_=0;
+  Real dt1 = std::numeric_limits<float>::max();
+  Real dt2 = std::numeric_limits<float>::max();
+  Real dt3 = std::numeric_limits<float>::max();
   Kokkos::parallel_reduce("mhd_c2p",Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
-  KOKKOS_LAMBDA(const int &idx, int &sumd, int &sume, int &sumt) {
+  KOKKOS_LAMBDA(const int &idx, int &sumd, int &sume, int &sumt,
+                Real &min_dt1, Real &min_dt2, Real &min_dt3) {
     int m = (idx)/nkji;
     int k = (idx - m*nkji)/nji;
     int j = (idx - m*nkji - k*nji)/ni;
@@ -119,8 +133,19 @@ void IdealMHD::ConsToPrim(DvceArray5D<Real> &cons, const DvceFaceFld4D<Real> &b,
         }
         prim(m,n,k,j,i) = cons(m,n,k,j,i)/u.d;
       }
+      // find smallest dx/(v +/- Cf) in each direction over active cells
+      if (newdt && (k >= ks && k <= ke && j >= js && j <= je && i >= is && i <= ie)) {
+        Real p = eos.IdealGasPressure(w.e);
+        Real cf = eos.IdealMHDFastSpeed(w.d, p, u.bx, u.by, u.bz);
+        min_dt1 = fmin((mbsize.d_view(m).dx1/(fabs(w.vx) + cf)), min_dt1);
+        cf = eos.IdealMHDFastSpeed(w.d, p, u.by, u.bz, u.bx);
+        min_dt2 = fmin((mbsize.d_view(m).dx2/(fabs(w.vy) + cf)), min_dt2);
+        cf = eos.IdealMHDFastSpeed(w.d, p, u.bz, u.bx, u.by);
+        min_dt3 = fmin((mbsize.d_view(m).dx3/(fabs(w.vz) + cf)), min_dt3);
+      }
     }
-  }, Kokkos::Sum<int>(nfloord_), Kokkos::Sum<int>(nfloore_), Kokkos::Sum<int>(nfloort_));
+  }, Kokkos::Sum<int>(nfloord_), Kokkos::Sum<int>(nfloore_), Kokkos::Sum<int>(nfloort_),
+     Kokkos::Min<Real>(dt1), Kokkos::Min<Real>(dt2), Kokkos::Min<Real>(dt3));
 
   // store appropriate counters
   if (only_testfloors) {
@@ -130,6 +155,12 @@ void IdealMHD::ConsToPrim(DvceArray5D<Real> &cons, const DvceFaceFld4D<Real> &b,
     pmy_pack->pmesh->ecounter.neos_efloor += nfloore_;
     pmy_pack->pmesh->ecounter.neos_tfloor += nfloort_;
   }
+  if (newdt) {
+    c2p_dt1 = dt1;
+    c2p_dt2 = dt2;
+    c2p_dt3 = dt3;
+    c2p_dt_done = true;
+  }
 
   return;
 }
@@ -60,6 +60,8 @@ void IdealSRHydro::ConsToPrim(DvceArray5D<Real> &cons, DvceArray5D<Real> &prim,
   int &nscal = pmy_pack->phydro->nscalars;
   int &nmb = pmy_pack->nmb_thispack;
   auto &fofc_ = pmy_pack->phydro->fofc;
+  const bool skip_dormant = pmy_pack->phydro->DormantMBs();
+  auto &dormant_ = pmy_pack->phydro->dormant;
   auto eos = eos_data;
 
   const int ni   = (iu - il + 1);
@@ -76,6 +78,8 @@ void IdealSRHydro::ConsToPrim(DvceArray5D<Real> &cons, DvceArray5D<Real> &prim,
     int i = (idx - m*nkji - k*nji - j*ni) + il;
     j += jl;
     k += kl;
+    // MBs in dormant-block mode keep their primitives
+    if (skip_dormant && dormant_(m)) return;
 
     // load single state conserved variables
     HydCons1D u;
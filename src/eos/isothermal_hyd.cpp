@@ -6,6 +6,8 @@
 //! \file isothermal_hyd.cpp
 //! \brief derived class that implements isothermal EOS for nonrelativistic hydro
 
+#include <limits>
+
 #include "athena.hpp"
 #include "parameter_input.hpp"
 #include "mesh/mesh.hpp"
@@ -63,7 +65,8 @@ void SingleP2C_IsothermalHyd(const HydPrim1D &w, HydCons1D &u) {
 //----------------------------------------------------------------------------------------
 //! \fn void ConsToPrim()
 //! \brief Converts conserved into primitive variables. Operates over range of cells given
-//! in argument list.
+//! in argument list.  If c2p_newdt is set, also computes minimum dx/(|v|+cs) over active
+//! cells.
 
 void IsothermalHydro::ConsToPrim(DvceArray5D<Real> &cons, DvceArray5D<Real> &prim,
                                  const bool only_testfloors,
@@ -73,7 +76,16 @@ void IsothermalHydro::ConsToPrim(DvceArray5D<Real> &cons, DvceArray5D<Real> &pri
   int &nscal = pmy_pack->phydro->nscalars;
   int &nmb = pmy_pack->nmb_thispack;
   auto &fofc_ = pmy_pack->phydro->fofc;
+  const bool skip_dormant = pmy_pack->phydro->DormantMBs();
+  auto &dormant_ = pmy_pack->phydro->dormant;
   Real dfloor = eos_data.dfloor;
+  Real cs = eos_data.iso_cs;
+  auto &mbsize = pmy_pack->pmb->mb_size;
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, ie = indcs.ie;
+  int js = indcs.js, je = indcs.je;
+  int ks = indcs.ks, ke = indcs.ke;
+  const bool newdt = c2p_newdt && !(only_testfloors);
 
   const int ni   = (iu - il + 1);
   const int nji  = (ju - jl + 1)*ni;
@@ -81,14 +93,19 @@ void IsothermalHydro::ConsToPrim(DvceArray5D<Real> &cons, DvceArray5D<Real> &pri
   const int nmkji = nmb*nkji;
 
   int nfloord_=0;
+  Real dt1 = std::numeric_limits<float>::max();
+  Real dt2 = std::numeric_limits<float>::max();
+  Real dt3 = std::numeric_limits<float>::max();
   Kokkos::parallel_reduce("isohyd_c2p",Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
-  KOKKOS_LAMBDA(const int &idx, int &sumd) {
+  KOKKOS_LAMBDA(const int &idx, int &sumd, Real &min_dt1, Real &min_dt2, Real &min_dt3) {
     int m = (idx)/nkji;
     int k = (idx - m*nkji)/nji;
     int j = (idx - m*nkji - k*nji)/ni;
     int i = (idx - m*nkji - k*nji - j*ni) + il;
     j += jl;
     k += kl;
+    // MBs in dormant-block mode keep their primitives
+    if (skip_dormant && dormant_(m)) return;
 
     // load single state conserved variables
     HydCons1D u;
@@ -120,8 +137,15 @@ void IsothermalHydro::ConsToPrim(DvceArray5D<Real> &cons, DvceArray5D<Real> &pri
       for (int n=nhyd; n<(nhyd+nscal); ++n) {
         prim(m,n,k,j,i) = cons(m,n,k,j,i)/u.d;
       }
+      // find smallest dx/(v +/- Cs) in each direction over active cells
+      if (newdt && (k >= ks && k <= ke && j >= js && j <= je && i >= is && i <= ie)) {
+        min_dt1 = fmin((mbsize.d_view(m).dx1/(fabs(w.vx) + cs)), min_dt1);
+        min_dt2 = fmin((mbsize.d_view(m).dx2/(fabs(w.vy) + cs)), min_dt2);
+        min_dt3 = fmin((mbsize.d_view(m).dx3/(fabs(w.vz) + cs)), min_dt3);
+      }
     }
-  }, Kokkos::Sum<int>(nfloord_));
+  }, Kokkos::Sum<int>(nfloord_), Kokkos::Min<Real>(dt1), Kokkos::Min<Real>(dt2),
+     Kokkos::Min<Real>(dt3));
 
   // store appropriate counters
   if (only_testfloors) {
@@ -129,6 +153,12 @@ void IsothermalHydro::ConsToPrim(DvceArray5D<Real> &cons, DvceArray5D<Real> &pri
   } else {
     pmy_pack->pmesh->ecounter.neos_dfloor += nfloord_;
   }
+  if (newdt) {
+    c2p_dt1 = dt1;
+    c2p_dt2 = dt2;
+    c2p_dt3 = dt3;
+    c2p_dt_done = true;
+  }
 
   return;
 }
@@ -6,6 +6,8 @@
 //! \file isothermal_mhd.cpp
 //! \brief derived class that implements isothermal EOS for nonrelativistic mhd
 
+#include <limits>
+
 #include "athena.hpp"
 #include "parameter_input.hpp"
 #include "mesh/mesh.hpp"
@@ -66,6 +68,7 @@ void SingleP2C_IsothermalMHD(const HydPrim1D &w, HydCons1D &u) {
 //! in argument list.
 //! Note that the primitive variables contain the cell-centered magnetic fields, so that
 //! W contains (nmhd+3+nscalars) elements, while U contains (nmhd+nscalars)
+//! If c2p_newdt is set, also computes minimum dx/(|v|+cf) over active cells.
 
 void IsothermalMHD::ConsToPrim(DvceArray5D<Real> &cons, const DvceFaceFld4D<Real> &b,
                                DvceArray5D<Real> &prim, DvceArray5D<Real> &bcc,
@@ -76,7 +79,14 @@ void IsothermalMHD::ConsToPrim(DvceArray5D<Real> &cons, const DvceFaceFld4D<Real
   int &nscal = pmy_pack->pmhd->nscalars;
   int &nmb = pmy_pack->nmb_thispack;
   auto &fofc_ = pmy_pack->pmhd->fofc;
+  auto &eos = eos_data;
   Real dfloor = eos_data.dfloor;
+  auto &mbsize = pmy_pack->pmb->mb_size;
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, ie = indcs.ie;
+  int js = indcs.js, je = indcs.je;
+  int ks = indcs.ks, ke = indcs.ke;
+  const bool newdt = c2p_newdt && !(only_testfloors);
 
   const int ni   = (iu - il + 1);
   const int nji  = (ju - jl + 1)*ni;
@@ -84,8 +94,11 @@ void IsothermalMHD::ConsToPrim(DvceArray5D<Real> &cons, const DvceFaceFld4D<Real
   const int nmkji = nmb*nkji;
 
   int nfloord_=0;
+  Real dt1 = std::numeric_limits<float>::max();
+  Real dt2 = std::numeric_limits<float>::max();
+  Real dt3 = std::numeric_limits<float>::max();
   Kokkos::parallel_reduce("isomhd_c2p",Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
-  KOKKOS_LAMBDA(const int &idx, int &sumd) {
+  KOKKOS_LAMBDA(const int &idx, int &sumd, Real &min_dt1, Real &min_dt2, Real &min_dt3) {
     int m = (idx)/nkji;
     int k = (idx - m*nkji)/nji;
     int j = (idx - m*nkji - k*nji)/ni;
@@ -133,8 +146,18 @@ void IsothermalMHD::ConsToPrim(DvceArray5D<Real> &cons, const DvceFaceFld4D<Real
       for (int n=nmhd; n<(nmhd+nscal); ++n) {
         prim(m,n,k,j,i) = cons(m,n,k,j,i)/u.d;
       }
+      // find smallest dx/(v +/- Cf) in each direction over active cells
+      if (newdt && (k >= ks && k <= ke && j >= js && j <= je && i >= is && i <= ie)) {
+        Real cf = eos.IdealMHDFastSpeed(w.d, u.bx, u.by, u.bz);
+        min_dt1 = fmin((mbsize.d_view(m).dx1/(fabs(w.vx) + cf)), min_dt1);
+        cf = eos.IdealMHDFastSpeed(w.d, u.by, u.bz, u.bx);
+        min_dt2 = fmin((mbsize.d_view(m).dx2/(fabs(w.vy) + cf)), min_dt2);
+        cf = eos.IdealMHDFastSpeed(w.d, u.bz, u.bx, u.by);
+        min_dt3 = fmin((mbsize.d_view(m).dx3/(fabs(w.vz) + cf)), min_dt3);
+      }
     }
-  }, Kokkos::Sum<int>(nfloord_));
+  }, Kokkos::Sum<int>(nfloord_), Kokkos::Min<Real>(dt1), Kokkos::Min<Real>(dt2),
+     Kokkos::Min<Real>(dt3));
 
   // store appropriate counters
   if (only_testfloors) {
@@ -142,6 +165,12 @@ void IsothermalMHD::ConsToPrim(DvceArray5D<Real> &cons, const DvceFaceFld4D<Real
   } else {
     pmy_pack->pmesh->ecounter.neos_dfloor += nfloord_;
   }
+  if (newdt) {
+    c2p_dt1 = dt1;
+    c2p_dt2 = dt2;
+    c2p_dt3 = dt3;
+    c2p_dt_done = true;
+  }
 
   return;
 }
@@ -20,6 +20,7 @@
 //    Real MinimumEnthalpy()
 //    Real SoundSpeed(Real n, Real T, Real *Y)
 //    Real SpecificInternalEnergy(Real n, Real T, Real *Y)
+//    void Thermodynamics(Real n, Real T, Real *Y, Real &P, Real &e, Real &h, Real &cs)
 //    Real MinimumPressure(Real n, Real *Y)
 //    Real MaximumPressure(Real n, Real *Y)
 //    Real MinimumEnergy(Real n, Real *Y)
@@ -75,6 +76,7 @@ class EOS : public EOSPolicy, public ErrorPolicy {
   using EOSPolicy::Enthalpy;
   using EOSPolicy::SoundSpeed;
   using EOSPolicy::SpecificInternalEnergy;
+  using EOSPolicy::Thermodynamics;
   using EOSPolicy::MinimumEnthalpy;
   using EOSPolicy::MinimumPressure;
   using EOSPolicy::MaximumPressure;
@@ -255,6 +257,30 @@ class EOS : public EOSPolicy, public ErrorPolicy {
            eos_units.EnergyConversion(code_units)/eos_units.MassConversion(code_units);
   }
 
+  //! \fn void GetThermodynamics(Real n, Real T, Real *Y, Real &P, Real &e, Real &h,
+  //                             Real &cs)
+  //  \brief Get the pressure, energy density, enthalpy per mass, and sound speed
+  //         together from the number density, temperature, and particle fractions.
+  //         Equivalent to calling GetPressure, GetEnergy, GetEnthalpy, and
+  //         GetSoundSpeed, but the EOS lookup (e.g., table interpolation weights) is
+  //         only done once.
+  //
+  //  \param[in]  n   The number density
+  //  \param[in]  T   The temperature
+  //  \param[in]  Y   An array of size n_species of the particle fractions.
+  //  \param[out] P   The pressure
+  //  \param[out] e   The energy density
+  //  \param[out] h   The enthalpy per mass
+  //  \param[out] cs  The sound speed
+  KOKKOS_INLINE_FUNCTION void GetThermodynamics(Real n, Real T, Real *Y, Real &P,
+                                                Real &e, Real &h, Real &cs) const {
+    Thermodynamics(n, T*code_units.TemperatureConversion(eos_units), Y, P, e, h, cs);
+    P *= eos_units.PressureConversion(code_units);
+    e *= eos_units.PressureConversion(code_units);
+    h *= eos_units.EnergyConversion(code_units)/(mb*eos_units.MassConversion(code_units));
+    cs *= eos_units.VelocityConversion(code_units);
+  }
+
   //! \fn int GetNSpecies() const
   //  \brief Get the number of particle species in this EOS.
   KOKKOS_INLINE_FUNCTION int GetNSpecies() const {
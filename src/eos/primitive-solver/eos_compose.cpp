@@ -46,13 +46,19 @@ void EOSCompOSE::ReadTableFromFile(std::string fname) {
     Kokkos::realloc(m_log_nb, m_nn);
     Kokkos::realloc(m_yq,     m_ny);
     Kokkos::realloc(m_log_t,  m_nt);
-    Kokkos::realloc(m_table, ECNVARS, m_nn, m_ny, m_nt);
 
-    // Create host storage to read into
+    // Create host storage to read into.  A double-precision table is only allocated on
+    // the device if it is used there.
     HostArray1D<Real>::HostMirror host_log_nb = create_mirror_view(m_log_nb);
     HostArray1D<Real>::HostMirror host_yq =     create_mirror_view(m_yq);
     HostArray1D<Real>::HostMirror host_log_t =  create_mirror_view(m_log_t);
-    HostArray4D<Real>::HostMirror host_table =  create_mirror_view(m_table);
+    HostArray4D<Real>::HostMirror host_table;
+    if (m_float) {
+      host_table = HostArray4D<Real>("EoS table (host)", m_nn, m_ny, m_nt, ECNVARS);
+    } else {
+      Kokkos::realloc(m_table, m_nn, m_ny, m_nt, ECNVARS);
+      host_table = create_mirror_view(m_table);
+    }
 
     { // read nb
       Real * table_nb = table["nb"];
@@ -90,7 +96,7 @@ void EOSCompOSE::ReadTableFromFile(std::string fname) {
         for (size_t iy=0; iy<m_ny; ++iy) {
           for (size_t it=0; it<m_nt; ++it) {
             size_t iflat = it + m_nt*(iy + m_ny*in);
-            host_table(ECLOGP,in,iy,it) = log(table_Q1[iflat]) + host_log_nb(in);
+            host_table(in,iy,it,ECLOGP) = log(table_Q1[iflat]) + host_log_nb(in);
           }
         }
       }
@@ -102,7 +108,7 @@ void EOSCompOSE::ReadTableFromFile(std::string fname) {
         for (size_t iy=0; iy<m_ny; ++iy) {
           for (size_t it=0; it<m_nt; ++it) {
             size_t iflat = it + m_nt*(iy + m_ny*in);
-            host_table(ECENT,in,iy,it) = table_Q2[iflat];
+            host_table(in,iy,it,ECENT) = table_Q2[iflat];
           }
         }
       }
@@ -114,7 +120,7 @@ void EOSCompOSE::ReadTableFromFile(std::string fname) {
         for (size_t iy=0; iy<m_ny; ++iy) {
           for (size_t it=0; it<m_nt; ++it) {
             size_t iflat = it + m_nt*(iy + m_ny*in);
-            host_table(ECMUB,in,iy,it) = (table_Q3[iflat]+1)*mb;
+            host_table(in,iy,it,ECMUB) = (table_Q3[iflat]+1)*mb;
           }
         }
       }
@@ -126,7 +132,7 @@ void EOSCompOSE::ReadTableFromFile(std::string fname) {
         for (size_t iy=0; iy<m_ny; ++iy) {
           for (size_t it=0; it<m_nt; ++it) {
             size_t iflat = it + m_nt*(iy + m_ny*in);
-            host_table(ECMUB,in,iy,it) = table_Q4[iflat]*mb;
+            host_table(in,iy,it,ECMUB) = table_Q4[iflat]*mb;
           }
         }
       }
@@ -138,7 +144,7 @@ void EOSCompOSE::ReadTableFromFile(std::string fname) {
         for (size_t iy=0; iy<m_ny; ++iy) {
           for (size_t it=0; it<m_nt; ++it) {
             size_t iflat = it + m_nt*(iy + m_ny*in);
-            host_table(ECMUL,in,iy,it) = table_Q5[iflat]*mb;
+            host_table(in,iy,it,ECMUL) = table_Q5[iflat]*mb;
           }
         }
       }
@@ -150,7 +156,7 @@ void EOSCompOSE::ReadTableFromFile(std::string fname) {
         for (size_t iy=0; iy<m_ny; ++iy) {
           for (size_t it=0; it<m_nt; ++it) {
             size_t iflat = it + m_nt*(iy + m_ny*in);
-            host_table(ECLOGE,in,iy,it) = log(mb*(table_Q7[iflat] + 1)) + host_log_nb(in);
+            host_table(in,iy,it,ECLOGE) = log(mb*(table_Q7[iflat] + 1)) + host_log_nb(in);
           }
         }
       }
@@ -162,7 +168,7 @@ void EOSCompOSE::ReadTableFromFile(std::string fname) {
         for (size_t iy=0; iy<m_ny; ++iy) {
           for (size_t it=0; it<m_nt; ++it) {
             size_t iflat = it + m_nt*(iy + m_ny*in);
-            host_table(ECCS,in,iy,it) = sqrt(table_cs2[iflat]);
+            host_table(in,iy,it,ECCS) = sqrt(table_cs2[iflat]);
           }
         }
       }
@@ -172,10 +178,29 @@ void EOSCompOSE::ReadTableFromFile(std::string fname) {
     Kokkos::deep_copy(m_log_nb, host_log_nb);
     Kokkos::deep_copy(m_yq,     host_yq);
     Kokkos::deep_copy(m_log_t,  host_log_t);
-    Kokkos::deep_copy(m_table,  host_table);
+    if (m_float) {
+      StoreFloatTable(host_table);
+    } else {
+      Kokkos::deep_copy(m_table,  host_table);
+    }
 
     m_initialized = true;
 
+    // Check which variables increase monotonically with temperature at every (nb, yq),
+    // for which temperature_from_var can use a faster search.
+    for (int iv = 0; iv < ECNVARS; ++iv) {
+      m_monotonic_t[iv] = true;
+      for (int in = 0; in < m_nn; ++in) {
+        for (int iy = 0; iy < m_ny; ++iy) {
+          for (int it = 1; it < m_nt; ++it) {
+            if (!(host_table(in,iy,it,iv) > host_table(in,iy,it-1,iv))) {
+              m_monotonic_t[iv] = false;
+            }
+          }
+        }
+      }
+    }
+
     m_min_h = std::numeric_limits<Real>::max();
     // Compute minimum enthalpy
     for (int in = 0; in < m_nn; ++in) {
@@ -184,8 +209,8 @@ void EOSCompOSE::ReadTableFromFile(std::string fname) {
         for (int iy = 0; iy < m_ny; ++iy) {
           // This would use GPU memory, and we are currently on the CPU, so Enthalpy is
           // hardcoded
-          Real e = exp(host_table(ECLOGE,in,iy,it));
-          Real p = exp(host_table(ECLOGP,in,iy,it));
+          Real e = exp(host_table(in,iy,it,ECLOGE));
+          Real p = exp(host_table(in,iy,it,ECLOGP));
           Real h = (e + p) / nb;
           m_min_h = fmin(m_min_h, h);
         }
@@ -193,3 +218,53 @@ void EOSCompOSE::ReadTableFromFile(std::string fname) {
     }
   } // if (m_initialized==false)
 }
+
+//----------------------------------------------------------------------------------------
+//! \fn void EOSCompOSE::StoreFloatTable()
+//! \brief Copies table to device in single precision, and measures maximum relative
+//! error of trilinear interpolation at the centre of every table cell against the
+//! double-precision values (for log P and log e, the error of P and e).
+
+void EOSCompOSE::StoreFloatTable(const HostArray4D<Real> &host_table) {
+  Kokkos::realloc(m_table_f, m_nn, m_ny, m_nt, ECNVARS);
+  auto host_table_f = create_mirror_view(m_table_f);
+  for (int in = 0; in < m_nn; ++in) {
+    for (int iy = 0; iy < m_ny; ++iy) {
+      for (int it = 0; it < m_nt; ++it) {
+        for (int iv = 0; iv < ECNVARS; ++iv) {
+          host_table_f(in,iy,it,iv) = static_cast<float>(host_table(in,iy,it,iv));
+        }
+      }
+    }
+  }
+  Kokkos::deep_copy(m_table_f, host_table_f);
+
+  // Chemical potentials pass through zero, so only the quantities used by the C2P and
+  // Riemann solvers are checked.
+  const int check_vars[] = {ECLOGP, ECLOGE, ECENT, ECCS};
+  m_float_err = 0.0;
+  for (int in = 0; in < m_nn-1; ++in) {
+    for (int iy = 0; iy < m_ny-1; ++iy) {
+      for (int it = 0; it < m_nt-1; ++it) {
+        for (int iv : check_vars) {
+          Real vd = 0.0, vf = 0.0;
+          for (int dn = 0; dn < 2; ++dn) {
+            for (int dy = 0; dy < 2; ++dy) {
+              for (int dt = 0; dt < 2; ++dt) {
+                vd += 0.125*host_table(in+dn,iy+dy,it+dt,iv);
+                vf += 0.125*static_cast<Real>(host_table_f(in+dn,iy+dy,it+dt,iv));
+              }
+            }
+          }
+          Real err;
+          if (iv == ECLOGP || iv == ECLOGE) {
+            err = fabs(expm1(vf - vd));
+          } else {
+            err = fabs(vf - vd)/fmax(fabs(vd), std::numeric_limits<Real>::min());
+          }
+          m_float_err = fmax(m_float_err, err);
+        }
+      }
+    }
+  }
+}
@@ -14,6 +14,15 @@
 
 ///  \warning This code assumes the table to be uniformly spaced in
 ///           log nb, log t, and yq
+///
+///  The table is stored with all variables at a given (nb, yq, T) point contiguous in
+///  memory, so that evaluating several variables at the same point (e.g. the enthalpy)
+///  loads each of the 8 surrounding table points only once.
+///
+///  With SetFloatTable(true) before the table is read, the table is stored in single
+///  precision (halving its size) while all interpolation is still done in Real.  The
+///  maximum relative interpolation error against the double-precision table is then
+///  measured once on the host, and returned by GetFloatTableError().
 
 #include <string>
 #include <limits>
@@ -44,10 +53,16 @@ class EOSCompOSE : public EOSPolicyInterface {
       m_log_nb("log nb",1),
       m_log_t("log T",1),
       m_yq("yq",1),
-      m_table("EoS table",1,1,1,1) {
+      m_table("EoS table",1,1,1,1),
+      m_table_f("EoS table (float)",1,1,1,1) {
     n_species = 1;
     eos_units = MakeNuclear();
     m_initialized = false;
+    m_float = false;
+    m_float_err = 0.0;
+    for (int iv = 0; iv < ECNVARS; iv++) {
+      m_monotonic_t[iv] = false;
+    }
 
     // These will be set properly when the table is read
     m_id_log_nb = std::numeric_limits<Real>::quiet_NaN();
@@ -111,9 +126,10 @@ class EOSCompOSE : public EOSPolicyInterface {
 
   /// Calculate the enthalpy per baryon using.
   KOKKOS_INLINE_FUNCTION Real Enthalpy(Real n, Real T, Real *Y) const {
-    Real const P = Pressure(n, T, Y);
-    Real const e = Energy(n, T, Y);
-    return (P + e)/n;
+    assert (m_initialized);
+    Real log_p, log_e;
+    eval_pair_at_lnty(ECLOGP, ECLOGE, log(n), log(T), Y[0], log_p, log_e);
+    return (exp(log_p) + exp(log_e))/n;
   }
 
   /// Calculate the sound speed.
@@ -127,6 +143,20 @@ class EOSCompOSE : public EOSPolicyInterface {
     return Energy(n, T, Y)/(mb*n) - 1;
   }
 
+  /// Calculate the pressure, energy density, enthalpy per baryon, and sound speed from
+  /// a single set of interpolation weights.
+  KOKKOS_INLINE_FUNCTION void Thermodynamics(Real n, Real T, Real *Y, Real &P, Real &e,
+                                             Real &h, Real &cs) const {
+    assert (m_initialized);
+    const int iv[3] = {ECLOGP, ECLOGE, ECCS};
+    Real var[3];
+    eval_vars_at_lnty<3>(iv, log(n), log(T), Y[0], var);
+    P = exp(var[0]);
+    e = exp(var[1]);
+    h = (P + e)/n;
+    cs = var[2];
+  }
+
 /* Not needed until neutrinos are added
   /// Calculate the baryon chemical potential
   KOKKOS_INLINE_FUNCTION Real BaryonChemicalPotential(Real n, Real T, Real *Y) const {
@@ -190,14 +220,31 @@ class EOSCompOSE : public EOSPolicyInterface {
   KOKKOS_INLINE_FUNCTION DvceArray1D<Real> const GetRawLogTemperature() const {
     return m_log_t;
   }
-  /// Get the raw table data
+  /// Get the raw table data (empty if the table is stored in single precision)
   KOKKOS_INLINE_FUNCTION DvceArray4D<Real> const GetRawTable() const {
     return m_table;
   }
 
+  /// Store the table in single precision.  Must be called before ReadTableFromFile.
+  void SetFloatTable(bool use_float) {
+    assert (!m_initialized);
+    m_float = use_float;
+  }
+
+  /// Maximum relative interpolation error of the single-precision table (0 if unused)
+  Real GetFloatTableError() const {
+    return m_float_err;
+  }
+
   // Indexing used to access the data
   KOKKOS_INLINE_FUNCTION ptrdiff_t index(int iv, int in, int iy, int it) const {
-    return it + m_nt*(iy + m_ny*(in + m_nn*iv));
+    return iv + ECNVARS*(it + m_nt*(iy + m_ny*in));
+  }
+
+  // Value stored in either table, converted to Real (branch is uniform across threads)
+  KOKKOS_INLINE_FUNCTION Real table(int in, int iy, int it, int iv) const {
+    return (m_float)? static_cast<Real>(m_table_f(in, iy, it, iv)) :
+                      m_table(in, iy, it, iv);
   }
 
   /// Check if the EOS has been initialized properly.
@@ -239,14 +286,52 @@ class EOSCompOSE : public EOSPolicyInterface {
     weight_idx_lt(&wt0, &wt1, &it, log_t);
 
     return
-      wn0 * (wy0 * (wt0 * m_table(iv, in+0, iy+0, it+0)   +
-                    wt1 * m_table(iv, in+0, iy+0, it+1))  +
-             wy1 * (wt0 * m_table(iv, in+0, iy+1, it+0)   +
-                    wt1 * m_table(iv, in+0, iy+1, it+1))) +
-      wn1 * (wy0 * (wt0 * m_table(iv, in+1, iy+0, it+0)   +
-                    wt1 * m_table(iv, in+1, iy+0, it+1))  +
-             wy1 * (wt0 * m_table(iv, in+1, iy+1, it+0)   +
-                    wt1 * m_table(iv, in+1, iy+1, it+1)));
+      wn0 * (wy0 * (wt0 * table(in+0, iy+0, it+0, iv)   +
+                    wt1 * table(in+0, iy+0, it+1, iv))  +
+             wy1 * (wt0 * table(in+0, iy+1, it+0, iv)   +
+                    wt1 * table(in+0, iy+1, it+1, iv))) +
+      wn1 * (wy0 * (wt0 * table(in+1, iy+0, it+0, iv)   +
+                    wt1 * table(in+1, iy+0, it+1, iv))  +
+             wy1 * (wt0 * table(in+1, iy+1, it+0, iv)   +
+                    wt1 * table(in+1, iy+1, it+1, iv)));
+  }
+
+  /// Low level evaluation of NV variables at the same point, not intended for outside
+  /// use.  Weights are only computed once, and all variables share cache lines.
+  template<int NV>
+  KOKKOS_INLINE_FUNCTION void eval_vars_at_lnty(const int iv[NV], Real log_n,
+      Real log_t, Real yq, Real var[NV]) const {
+    int in, iy, it;
+    Real wn0, wn1, wy0, wy1, wt0, wt1;
+
+    weight_idx_ln(&wn0, &wn1, &in, log_n);
+    weight_idx_yq(&wy0, &wy1, &iy, yq);
+    weight_idx_lt(&wt0, &wt1, &it, log_t);
+
+    for (int v = 0; v < NV; ++v) {
+      var[v] = 0.0;
+    }
+    for (int dn = 0; dn < 2; ++dn) {
+      for (int dy = 0; dy < 2; ++dy) {
+        for (int dt = 0; dt < 2; ++dt) {
+          Real w = ((dn == 0)? wn0 : wn1)*((dy == 0)? wy0 : wy1)*((dt == 0)? wt0 : wt1);
+          for (int v = 0; v < NV; ++v) {
+            var[v] += w*table(in+dn, iy+dy, it+dt, iv[v]);
+          }
+        }
+      }
+    }
+  }
+
+  /// Low level evaluation of two variables at the same point, not intended for outside
+  /// use.
+  KOKKOS_INLINE_FUNCTION void eval_pair_at_lnty(int iv0, int iv1, Real log_n,
+      Real log_t, Real yq, Real &var0, Real &var1) const {
+    const int iv[2] = {iv0, iv1};
+    Real var[2];
+    eval_vars_at_lnty<2>(iv, log_n, log_t, yq, var);
+    var0 = var[0];
+    var1 = var[1];
   }
 
   /// Evaluate interpolation weight for density
@@ -274,6 +359,9 @@ class EOSCompOSE : public EOSPolicyInterface {
     return;
   }
 
+  /// Copies table to device in single precision, and measures interpolation error
+  void StoreFloatTable(const HostArray4D<Real> &host_table);
+
   // TODO(PH)
   /// Low level function, not intended for outside use
   KOKKOS_INLINE_FUNCTION Real temperature_from_var(int iv, Real var, Real n, Real Yq)
@@ -285,10 +373,10 @@ class EOSCompOSE : public EOSPolicyInterface {
 
     auto f = [=](int it){
       Real var_pt =
-        wn0 * (wy0 * m_table(iv, in+0, iy+0, it)  +
-               wy1 * m_table(iv, in+0, iy+1, it)) +
-        wn1 * (wy0 * m_table(iv, in+1, iy+0, it)  +
-               wy1 * m_table(iv, in+1, iy+1, it));
+        wn0 * (wy0 * table(in+0, iy+0, it, iv)  +
+               wy1 * table(in+0, iy+1, it, iv)) +
+        wn1 * (wy0 * table(in+1, iy+0, it, iv)  +
+               wy1 * table(in+1, iy+1, it, iv));
 
       return var - var_pt;
     };
@@ -322,8 +410,18 @@ class EOSCompOSE : public EOSPolicyInterface {
     }
     */
     assert(flo*fhi <= 0);
+    // If var increases monotonically with T, f is nearly linear in the index, so guess
+    // the index of the root by linear interpolation.  Steps that do not halve the bracket
+    // are followed by a bisection step, so at most twice as many steps as bisection are
+    // taken.
+    bool bisect = !m_monotonic_t[iv];
     while (ihi - ilo > 1) {
       int ip = ilo + (ihi - ilo)/2;
+      if (!bisect && flo != fhi) {
+        ip = ilo + static_cast<int>((ihi - ilo)*(flo/(flo - fhi)));
+        ip = (ip <= ilo)? (ilo + 1) : ((ip >= ihi)? (ihi - 1) : ip);
+      }
+      int nold = ihi - ilo;
       Real fp = f(ip);
       if (fp*flo <= 0) {
         ihi = ip;
@@ -332,6 +430,7 @@ class EOSCompOSE : public EOSPolicyInterface {
         ilo = ip;
         flo = fp;
       }
+      bisect = !m_monotonic_t[iv] || (2*(ihi - ilo) > nold);
     }
     assert(ihi - ilo == 1);
     Real lthi = m_log_t[ihi];
@@ -360,12 +459,17 @@ class EOSCompOSE : public EOSPolicyInterface {
   // bool to protect against access of uninitialised table and prevent repeated reading
   // of table
   bool m_initialized;
+  // whether each variable increases monotonically with T at every (nb, yq)
+  bool m_monotonic_t[ECNVARS];
 
-  // Table storage on DEVICE.
+  // Table storage on DEVICE, indexed (in, iy, it, iv).
   DvceArray1D<Real> m_log_nb;
   DvceArray1D<Real> m_yq;
   DvceArray1D<Real> m_log_t;
   DvceArray4D<Real> m_table;
+  DvceArray4D<float> m_table_f;   // used instead of m_table if m_float
+  bool m_float;                   // table stored in single precision
+  Real m_float_err;               // max relative interpolation error of m_table_f
 };
 
 }; // namespace Primitive
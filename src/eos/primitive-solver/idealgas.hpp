@@ -94,6 +94,15 @@ class IdealGas : public EOSPolicyInterface {
     return T/(mb*gammam1);
   }
 
+  /// Calculate the pressure, energy density, enthalpy per baryon, and sound speed.
+  KOKKOS_INLINE_FUNCTION void Thermodynamics(Real n, Real T, Real *Y, Real &P, Real &e,
+                                             Real &h, Real &cs) const {
+    P = n*T;
+    e = n*(mb + T/gammam1);
+    h = mb + gamma/gammam1*T;
+    cs = sqrt(gamma*T/h);
+  }
+
   /// Calculate the minimum pressure at a given density and composition
   KOKKOS_INLINE_FUNCTION Real MinimumPressure(Real n, Real *Y) const {
     return 0.0;
@@ -36,16 +36,17 @@ class Root {
   // \param[in,out]  lb  The lower bound for the root.
   // \param[in,out]  ub  The upper bound for the root.
   // \param[out]  x  The location of the root.
+  // \param[in]  tol  The tolerance for the root.
+  // \param[out]  count  The number of iterations performed.
   // \param[in]  args  Additional arguments required by f.
 
   template<class Functor, class ... Types>
   KOKKOS_INLINE_FUNCTION
   bool FalsePosition(Functor&& f, Real &lb, Real &ub, Real& x, Real tol,
-                     Types ... args) const {
+                     unsigned int &count, Types ... args) const {
     int side = 0;
     Real ftest;
-    unsigned int count = 0;
-    //last_count = 0;
+    count = 0;
     // Get our initial bracket.
     Real flb = f(lb, args...);
     Real fub = f(ub, args...);
@@ -93,7 +94,6 @@ class Root {
         side = -1;
       }
     } while (count < iterations);
-    //last_count = count;
 
     // Return success if we're below the tolerance, otherwise report failure.
     return fabs((x-xold)/x) <= tol;
@@ -101,6 +101,81 @@ class Root {
 
   // }}}
 
+  // FalsePositionLockstep {{{
+
+  //! \brief Find the root of a functor f using false position with a fixed number of
+  //         iterations.
+  //
+  // Same as FalsePosition, but always performs exactly niter iterations, so that the
+  // number of function evaluations does not depend on the data. Once the root has
+  // converged, further iterations are still evaluated but no longer change x or the
+  // bracket. When many roots are found in parallel (e.g. on a GPU warp) this avoids
+  // divergence between threads; roots that have not converged after niter iterations
+  // should be retried with FalsePosition.
+  //
+  // \param[in]  f  The functor to find a root for. Its root function must take at
+  //                least one argument.
+  // \param[in,out]  lb  The lower bound for the root.
+  // \param[in,out]  ub  The upper bound for the root.
+  // \param[out]  x  The location of the root.
+  // \param[in]  niter  The number of iterations to perform.
+  // \param[in]  args  Additional arguments required by f.
+
+  template<class Functor, class ... Types>
+  KOKKOS_INLINE_FUNCTION
+  bool FalsePositionLockstep(Functor&& f, Real &lb, Real &ub, Real& x, Real tol,
+                             const unsigned int niter, Types ... args) const {
+    int side = 0;
+    // Get our initial bracket.
+    Real flb = f(lb, args...);
+    Real fub = f(ub, args...);
+    x = lb;
+    // If one of the bounds is already within tolerance of the root, we have the root.
+    if (fabs(flb) <= tol) {
+      x = lb;
+      return true;
+    } else if (fabs(fub) <= tol) {
+      x = ub;
+      return true;
+    }
+    if (flb*fub > 0) {
+      return false;
+    }
+    bool converged = false;
+    for (unsigned int count = 0; count < niter; ++count) {
+      // Calculate the new root position and f there. Once converged, the bracket is
+      // fixed, so this repeats the evaluation at the root.
+      Real xnew = (fub*lb - flb*ub)/(fub - flb);
+      Real ftest = f(xnew, args...);
+      if (!converged) {
+        Real xold = x;
+        x = xnew;
+        converged = (fabs((x-xold)/x) <= tol);
+      }
+      // Update the bracket (Illinois variant) as in FalsePosition.
+      if (!converged) {
+        if (ftest*flb >= 0) {
+          flb = ftest;
+          lb = x;
+          if (side == 1) {
+            fub /= 2.0;
+          }
+          side = 1;
+        } else {
+          fub = ftest;
+          ub = x;
+          if (side == -1) {
+            flb /= 2.0;
+          }
+          side = -1;
+        }
+      }
+    }
+    return converged;
+  }
+
+  // }}}
+
   // Chandrupatla {{{
 
   //! \brief Find the root of a functor f using Chandrupatla's method
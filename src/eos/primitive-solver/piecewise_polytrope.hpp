@@ -14,6 +14,11 @@
 //  finite-temperature portion added on top using the ideal gas
 //  law:
 //  \f$P_\textrm{therm} = nk_B T\f$
+//
+//  Unused pieces (up to MAX_PIECES) are padded with infinite dividing densities and
+//  pressures, so that the piece is found without branches by counting the dividing
+//  values that are exceeded, in a loop of fixed length that the compiler unrolls.
+//  Each function evaluates the polytropic pressure (a pow) only once.
 
 #include <math.h>
 #include <stdio.h>
@@ -41,6 +46,8 @@ class PiecewisePolytrope : public EOSPolicyInterface {
   Real gamma_pieces[MAX_PIECES];
   Real pressure_pieces[MAX_PIECES];
   Real eps_pieces[MAX_PIECES];
+  Real inv_gamma_m1_pieces[MAX_PIECES];  // 1/(gamma_i - 1)
+  Real inv_gamma_pieces[MAX_PIECES];     // 1/gamma_i
   Real gamma_thermal;
   bool initialized;
 
@@ -64,7 +71,7 @@ class PiecewisePolytrope : public EOSPolicyInterface {
   /// Calculate the temperature using the ideal gas law.
   KOKKOS_INLINE_FUNCTION Real TemperatureFromE(Real n, Real e, Real *Y) const {
     int p = FindPiece(n);
-    Real e_cold = GetColdEnergy(n, p);
+    Real e_cold = ColdEnergy(n, p, GetColdPressure(n, p));
     return (e - e_cold)*(gamma_thermal - 1.0)/n;
   }
 
@@ -79,7 +86,7 @@ class PiecewisePolytrope : public EOSPolicyInterface {
   KOKKOS_INLINE_FUNCTION Real Energy(Real n, Real T, const Real *Y) const {
     int p = FindPiece(n);
 
-    return GetColdEnergy(n, p) + n*T/(gamma_thermal - 1.0);
+    return ColdEnergy(n, p, GetColdPressure(n, p)) + n*T/(gamma_thermal - 1.0);
   }
 
   /// Calculate the pressure using the ideal gas law.
@@ -98,7 +105,8 @@ class PiecewisePolytrope : public EOSPolicyInterface {
   /// Calculate the enthalpy per baryon using the ideal gas law.
   KOKKOS_INLINE_FUNCTION Real Enthalpy(Real n, Real T, Real *Y) const {
     int p = FindPiece(n);
-    return (GetColdEnergy(n, p) + GetColdPressure(n, p))/n +
+    Real P_cold = GetColdPressure(n, p);
+    return (ColdEnergy(n, p, P_cold) + P_cold)/n +
            gamma_thermal/(gamma_thermal - 1.0)*T;
   }
 
@@ -112,10 +120,9 @@ class PiecewisePolytrope : public EOSPolicyInterface {
     int p = FindPiece(n);
     Real rho = n*mb;
 
-    Real h_cold = (GetColdEnergy(n, p) + GetColdPressure(n, p))/rho;
-    Real h_th = gamma_thermal/(gamma_thermal - 1.0)*T/mb;
-
     Real P_cold = GetColdPressure(n, p);
+    Real h_cold = (ColdEnergy(n, p, P_cold) + P_cold)/rho;
+    Real h_th = gamma_thermal/(gamma_thermal - 1.0)*T/mb;
 
     Real csq_cold_w = gamma_pieces[p]*P_cold/rho;
     Real csq_th_w = (gamma_thermal - 1.0)*h_th;
@@ -123,10 +130,23 @@ class PiecewisePolytrope : public EOSPolicyInterface {
     return sqrt((csq_cold_w + csq_th_w)/(h_th + h_cold));
   }
 
+  /// Calculate the pressure, energy density, enthalpy per baryon, and sound speed with
+  /// a single search for the piece and a single evaluation of the cold pressure.
+  KOKKOS_INLINE_FUNCTION void Thermodynamics(Real n, Real T, Real *Y, Real &P, Real &e,
+                                             Real &h, Real &cs) const {
+    int p = FindPiece(n);
+    Real P_cold = GetColdPressure(n, p);
+
+    P = P_cold + n*T;
+    e = ColdEnergy(n, p, P_cold) + n*T/(gamma_thermal - 1.0);
+    h = (P + e)/n;
+    cs = sqrt((gamma_pieces[p]*P_cold + gamma_thermal*n*T)/(n*h));
+  }
+
   /// Calculate the internal energy per mass.
   KOKKOS_INLINE_FUNCTION Real SpecificInternalEnergy(Real n, Real T, Real *Y) const {
     int p = FindPiece(n);
-    Real eps_cold = GetColdEnergy(n, p)/(n*mb) - 1.0;
+    Real eps_cold = ColdEnergy(n, p, GetColdPressure(n, p))/(n*mb) - 1.0;
     return eps_cold + T/(mb*(gamma_thermal - 1.0));
   }
 
@@ -211,6 +231,7 @@ class PiecewisePolytrope : public EOSPolicyInterface {
     density_pieces[0] = densities[1]/mb;
     gamma_pieces[0] = gammas[0];
     pressure_pieces[0] = P0;
+    eps_pieces[0] = 0.0;
 
     for (int i = 1; i < n; i++) {
       density_pieces[i] = densities[i]/mb;
@@ -224,6 +245,19 @@ class PiecewisePolytrope : public EOSPolicyInterface {
                       (density_pieces[i-1] * mb) *
                       (1.0/(gammas[i-1] - 1.0) - 1.0/(gammas[i] - 1.0));
     }
+    for (int i = 0; i < n; i++) {
+      inv_gamma_m1_pieces[i] = 1.0/(gamma_pieces[i] - 1.0);
+      inv_gamma_pieces[i] = 1.0/gamma_pieces[i];
+    }
+    // Pad unused pieces so that they are never selected by FindPiece()
+    for (int i = n; i < MAX_PIECES; i++) {
+      density_pieces[i] = DBL_MAX;
+      pressure_pieces[i] = DBL_MAX;
+      gamma_pieces[i] = gamma_pieces[n-1];
+      eps_pieces[i] = eps_pieces[n-1];
+      inv_gamma_m1_pieces[i] = inv_gamma_m1_pieces[n-1];
+      inv_gamma_pieces[i] = inv_gamma_pieces[n-1];
+    }
 
     // Because we're adding in a finite-temperature component via the ideal gas,
     // the only restriction on our temperature is that it needs to be nonnegative.
@@ -263,17 +297,21 @@ class PiecewisePolytrope : public EOSPolicyInterface {
   /// Find the index of the piece that the density aligns with.
   KOKKOS_INLINE_FUNCTION int FindPiece(Real n) const {
     // WARNING: assumes the EOS is initialized!
-    for (int i = 0; i < n_pieces-1; ++i) {
-      if (n < density_pieces[i+1]) {
-        return i;
-      }
+    int p = 0;
+    for (int i = 1; i < MAX_PIECES; ++i) {
+      p += (n >= density_pieces[i]);
     }
-    return n_pieces - 1;
+    return p;
   }
 
   /// Polytropic Energy Density
   KOKKOS_INLINE_FUNCTION Real GetColdEnergy(Real n, int p) const {
-    return mb*n*(1.0 + eps_pieces[p]) + GetColdPressure(n, p)/(gamma_pieces[p] - 1.0);
+    return ColdEnergy(n, p, GetColdPressure(n, p));
+  }
+
+  /// Polytropic Energy Density, given the polytropic pressure P_cold at n
+  KOKKOS_INLINE_FUNCTION Real ColdEnergy(Real n, int p, Real P_cold) const {
+    return mb*n*(1.0 + eps_pieces[p]) + P_cold*inv_gamma_m1_pieces[p];
   }
 
   /// Polytropic Pressure
@@ -283,14 +321,11 @@ class PiecewisePolytrope : public EOSPolicyInterface {
 
   /// Inverse of GetColdPressure
   KOKKOS_INLINE_FUNCTION Real GetDensityFromColdPressure(Real p) const {
-    int ip = n_pieces - 1;
-    for (int i = 0; i < n_pieces-1; ++i) {
-      if (p < pressure_pieces[i+1]) {
-        ip = i;
-        break;
-      }
+    int ip = 0;
+    for (int i = 1; i < MAX_PIECES; ++i) {
+      ip += (p >= pressure_pieces[i]);
     }
-    return density_pieces[ip]*pow((p/pressure_pieces[ip]), 1.0/gamma_pieces[ip]);
+    return density_pieces[ip]*pow((p/pressure_pieces[ip]), inv_gamma_pieces[ip]);
   }
 
   /// Set the number of species. Throw an exception if
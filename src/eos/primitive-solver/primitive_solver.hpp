@@ -220,11 +220,16 @@ class PrimitiveSolver {
   //  \param[in,out] bu    The magnetic field
   //  \param[in]     g3d   The 3x3 spatial metric
   //  \param[in]     g3u   The 3x3 inverse spatial metric
+  //  \param[in]     lockstep  If nonzero, the number of lock-step iterations of the
+  //                           root solve (see FalsePositionLockstep). If the root does
+  //                           not converge in this many iterations, prim and cons are
+  //                           left unchanged and NOT_CONVERGED is returned.
   //
   //  \return information about the solve
   KOKKOS_INLINE_FUNCTION
   SolverResult ConToPrim(Real prim[NPRIM], Real cons[NCONS], Real b[NMAG],
-                         Real g3d[NSPMETRIC], Real g3u[NSPMETRIC]) const;
+                         Real g3d[NSPMETRIC], Real g3u[NSPMETRIC],
+                         const unsigned int lockstep = 0) const;
 
   //! \brief Get the conserved variables from the primitive variables.
   //
@@ -238,6 +243,21 @@ class PrimitiveSolver {
   Error PrimToCon(Real prim[NPRIM], Real cons[NCONS], Real b[NMAG],
                  Real g3d[NSPMETRIC]) const;
 
+  //! \brief Get the conserved variables from the primitive variables, given the
+  //         enthalpy per mass h already evaluated from the EOS (e.g., by
+  //         GetThermodynamics) at the same point.
+  //
+  //  \param[in]    prim  The array of primitive variables
+  //  \param[out]   cons  The array of conserved variables
+  //  \param[in]    bu    The magnetic field
+  //  \param[in]    g3d   The 3x3 spatial metric
+  //  \param[in]    h     The enthalpy per mass
+  //
+  //  \return an error code
+  KOKKOS_INLINE_FUNCTION
+  Error PrimToCon(Real prim[NPRIM], Real cons[NCONS], Real b[NMAG],
+                 Real g3d[NSPMETRIC], Real h) const;
+
   /// Get the EOS used by this PrimitiveSolver.
   /*KOKKOS_INLINE_FUNCTION EOS<EOSPolicy, ErrorPolicy> *const GetEOS() const {
     return peos;
@@ -364,7 +384,8 @@ Error PrimitiveSolver<EOSPolicy, ErrorPolicy>::CheckDensityValid(Real& mul, Real
 template<typename EOSPolicy, typename ErrorPolicy>
 KOKKOS_INLINE_FUNCTION
 SolverResult PrimitiveSolver<EOSPolicy, ErrorPolicy>::ConToPrim(Real prim[NPRIM],
-      Real cons[NCONS], Real b[NMAG], Real g3d[NSPMETRIC], Real g3u[NSPMETRIC]) const {
+      Real cons[NCONS], Real b[NMAG], Real g3d[NSPMETRIC], Real g3u[NSPMETRIC],
+      const unsigned int lockstep) const {
   SolverResult solver_result{Error::SUCCESS, 0, false, false, false};
 
   // Extract the undensitized conserved variables.
@@ -514,15 +535,24 @@ SolverResult PrimitiveSolver<EOSPolicy, ErrorPolicy>::ConToPrim(Real prim[NPRIM]
 
   // Do the root solve.
   Real n, P, T, mu;
-  bool result = root.FalsePosition(RootFunction, mul, muh, mu, tol,
-                                   D, q, bsqr, rsqr, rbsqr, Y, &eos, &n, &T, &P);
-  // WARNING: the reported number of iterations is not thread-safe and should only be
-  // trusted on single-thread benchmarks.
-  solver_result.iterations = root.iterations;
-  if (!result) {
-    HandleFailure(prim, cons, b, g3d);
-    solver_result.error = Error::NO_SOLUTION;
-    return solver_result;
+  if (lockstep > 0) {
+    bool result = root.FalsePositionLockstep(RootFunction, mul, muh, mu, tol, lockstep,
+                                     D, q, bsqr, rsqr, rbsqr, Y, &eos, &n, &T, &P);
+    solver_result.iterations = lockstep;
+    if (!result) {
+      solver_result.error = Error::NOT_CONVERGED;
+      return solver_result;
+    }
+  } else {
+    unsigned int count;
+    bool result = root.FalsePosition(RootFunction, mul, muh, mu, tol, count,
+                                     D, q, bsqr, rsqr, rbsqr, Y, &eos, &n, &T, &P);
+    solver_result.iterations = count;
+    if (!result) {
+      HandleFailure(prim, cons, b, g3d);
+      solver_result.error = Error::NO_SOLUTION;
+      return solver_result;
+    }
   }
 
   // Retrieve the primitive variables.
@@ -578,11 +608,18 @@ template<typename EOSPolicy, typename ErrorPolicy>
 KOKKOS_INLINE_FUNCTION
 Error PrimitiveSolver<EOSPolicy, ErrorPolicy>::PrimToCon(Real prim[NPRIM],
       Real cons[NCONS], Real bu[NMAG], Real g3d[NMETRIC]) const {
+  Real h = eos.GetEnthalpy(prim[PRH], prim[PTM], &prim[PYF]);
+  return PrimToCon(prim, cons, bu, g3d, h);
+}
+
+template<typename EOSPolicy, typename ErrorPolicy>
+KOKKOS_INLINE_FUNCTION
+Error PrimitiveSolver<EOSPolicy, ErrorPolicy>::PrimToCon(Real prim[NPRIM],
+      Real cons[NCONS], Real bu[NMAG], Real g3d[NMETRIC], Real h) const {
   // Extract the primitive variables
   const Real &n = prim[PRH]; // number density
   const Real Wv_u[3] = {prim[PVX], prim[PVY], prim[PVZ]};
   const Real &p   = prim[PPR]; // pressure
-  const Real &t   = prim[PTM]; // temperature
   const Real B_u[3] = {bu[IBX], bu[IBY], bu[IBZ]};
   const int n_species = eos.GetNSpecies();
   Real Y[MAX_SPECIES] = {0.0};
@@ -620,7 +657,7 @@ Error PrimitiveSolver<EOSPolicy, ErrorPolicy>::PrimToCon(Real prim[NPRIM],
 
   // Set the conserved quantities.
   // Total enthalpy density
-  Real H = n*eos.GetEnthalpy(n, t, Y)*mb;
+  Real H = n*h*mb;
   Real HWsq = H*Wsq;
   D = n*mb*W;
   for (int s = 0; s < n_species; s++) {
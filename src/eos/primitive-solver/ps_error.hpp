@@ -20,6 +20,7 @@ enum struct Error {
   CONS_FLOOR,
   PRIM_FLOOR,
   CONS_ADJUSTED,
+  NOT_CONVERGED,  // lock-step root solve did not converge, retry with full solve
 };
 
 struct SolverResult {
@@ -37,6 +37,8 @@
 #include "mhd/mhd.hpp"
 #include "coordinates/coordinates.hpp"
 #include "coordinates/cell_locations.hpp"
+#include "utils/cell_list.hpp"
+#include "z4c/tmunu.hpp"
 
 template<class EOSPolicy, class ErrorPolicy>
 class PrimitiveSolverHydro {
@@ -77,12 +79,19 @@ class PrimitiveSolverHydro {
         std::exit(EXIT_FAILURE);
       }
 
-      // Get table filename, then read the table,
+      // Get table filename, then read the table, optionally in single precision
       std::string fname = pin->GetString(block, "table");
+      bool table_float = pin->GetOrAddBoolean(block, "table_float", false);
+      ps.GetEOSMutable().SetFloatTable(table_float);
       ps.GetEOSMutable().ReadTableFromFile(fname);
 
       // Ensure table was read properly
       assert(ps.GetEOSMutable().IsInitialized());
+      if (table_float && global_variable::my_rank == 0) {
+        std::cout << "EOS table '" << fname << "' stored in single precision, max "
+                  << "relative interpolation error = "
+                  << ps.GetEOS().GetFloatTableError() << std::endl;
+      }
     }
   }
 
@@ -91,6 +100,9 @@ class PrimitiveSolverHydro {
   MeshBlockPack* pmy_pack;
   unsigned int nerrs;
   unsigned int errcap;
+  unsigned int c2p_lockstep;     // iterations of lock-step C2P solve (0 = disabled)
+  DvceArray4D<bool> c2p_retry;   // cells to retry after lock-step C2P solve
+  DvceArray1D<int> c2p_list;     // packed indices of cells to retry
 
   PrimitiveSolverHydro(std::string block, MeshBlockPack *pp, ParameterInput *pin) :
 //        pmy_pack(pp), ps{&eos} {
@@ -103,6 +115,7 @@ class PrimitiveSolverHydro {
     ps.tol = pin->GetOrAddReal(block, "c2p_tol", 1e-15);
     ps.GetRootSolverMutable().iterations = pin->GetOrAddInteger(block, "c2p_iter", 50);
     errcap = pin->GetOrAddInteger(block, "c2perrs", 1000);
+    c2p_lockstep = pin->GetOrAddInteger(block, "c2p_lockstep_iter", 0);
 
     // Calculate maximum allowed velocity
     Real Wmax = pin->GetOrAddReal(block, "gamma_max", 50.0);
@@ -272,11 +285,14 @@ class PrimitiveSolverHydro {
   void ConsToPrim(DvceArray5D<Real> &cons, const DvceFaceFld4D<Real> &bfc,
                   DvceArray5D<Real> &bcc0, DvceArray5D<Real> &prim,
                   const int il, const int iu, const int jl, const int ju,
-                  const int kl, const int ku, bool floors_only=false) {
+                  const int kl, const int ku, bool floors_only=false,
+                  bool set_tmunu=false) {
     int &nhyd = pmy_pack->pmhd->nmhd;
     int &nscal = pmy_pack->pmhd->nscalars;
     int &nmb = pmy_pack->nmb_thispack;
     auto &fofc_ = pmy_pack->pmhd->fofc;
+    const bool c2p_stats = pmy_pack->pmhd->c2p_stats && !floors_only;
+    auto &c2p_count_ = pmy_pack->pmhd->c2p_count;
 
     // Some problem-specific parameters
     auto &excise = pmy_pack->pcoord->coord_data.bh_excise;
@@ -289,6 +305,12 @@ class PrimitiveSolverHydro {
     auto &eos_ = ps.GetEOS();
     auto &ps_  = ps;
 
+    // With set_tmunu, the perfect fluid stress-energy tensor is also stored from the
+    // final primitives and conserved variables, which are already in registers.
+    const bool tmunu_ = set_tmunu && !floors_only && (pmy_pack->ptmunu != nullptr);
+    Tmunu::Tmunu_vars tmunu;
+    if (tmunu_) {tmunu = pmy_pack->ptmunu->tmunu;}
+
     const int ni = (iu - il + 1);
     const int nji = (ju - jl + 1)*ni;
     const int nkji = (ku - kl + 1)*nji;
@@ -309,17 +331,34 @@ class PrimitiveSolverHydro {
       ps.GetEOSMutable().SetConservedFloorFailure(true);
     }
 
+    // With c2p_lockstep > 0, the root solve in all cells first performs a fixed number
+    // of iterations in lock-step (avoiding divergence between GPU threads).  Cells that
+    // have not converged are left unchanged and flagged in c2p_retry, and are then
+    // solved again with the full (iterative) solve over a compacted list of cells.
+    const unsigned int lockstep_ = c2p_lockstep;
+    if (lockstep_ > 0 && c2p_retry.extent_int(0) != nmb) {
+      auto &indcs = pmy_pack->pmesh->mb_indcs;
+      int ncells1 = indcs.nx1 + 2*(indcs.ng);
+      int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
+      int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
+      Kokkos::realloc(c2p_retry, nmb, ncells3, ncells2, ncells1);
+    }
+    auto &retry_ = c2p_retry;
+
     // FIXME(JMF): We can short-circuit the primitive solve if FOFC is already enabled
     // due to a maximum principle violation.
-    int count_errs=0;
-    Kokkos::parallel_reduce("pshyd_c2p",Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
-    KOKKOS_LAMBDA(const int &idx, int &sumerrs) {
+    // c2p solves cell idx, nprev is number of errors already counted in earlier passes.
+    auto c2p = KOKKOS_LAMBDA(const int idx, const unsigned int lockstep, const int nprev,
+                             int &sumerrs) {
       int m = (idx)/nkji;
       int k = (idx - m*nkji)/nji;
       int j = (idx - m*nkji - k*nji)/ni;
       int i = (idx - m*nkji - k*nji - j*ni) + il;
       j += jl;
       k += kl;
+      if (lockstep > 0) {
+        retry_(m,k,j,i) = false;
+      }
 
       // Add in a short circuit where FOFC is guaranteed.
       if (floors_only && fofc_(m, k, j, i)) {
@@ -396,16 +435,33 @@ class PrimitiveSolverHydro {
           result.cons_adjusted = true;
           ps_.PrimToCon(prim_pt, cons_pt, b3u, g3d);
         } else {
-          result = ps_.ConToPrim(prim_pt, cons_pt, b3u, g3d, g3u);
+          result = ps_.ConToPrim(prim_pt, cons_pt, b3u, g3d, g3u, lockstep);
         }
       } else {
-        result = ps_.ConToPrim(prim_pt, cons_pt, b3u, g3d, g3u);
+        result = ps_.ConToPrim(prim_pt, cons_pt, b3u, g3d, g3u, lockstep);
+      }
+      // Iterations of the lock-step solve are counted even if the cell is retried.
+      if (c2p_stats) {
+        c2p_count_(m,0,k,j,i) += result.iterations;
+        if (result.error == Primitive::Error::SUCCESS &&
+            (result.cons_floor || result.prim_floor)) {
+          c2p_count_(m,1,k,j,i) += 1.0;
+        } else if (result.error != Primitive::Error::SUCCESS &&
+                   result.error != Primitive::Error::NOT_CONVERGED) {
+          c2p_count_(m,1,k,j,i) += 1.0;
+        }
+      }
+      // Defer cells that did not converge in lock-step solve to the retry pass.
+      if (result.error == Primitive::Error::NOT_CONVERGED) {
+        retry_(m,k,j,i) = true;
+        return;
       }
 
       if (result.error != Primitive::Error::SUCCESS && floors_only) {
         fofc_(m,k,j,i) = true;
       } else if (!floors_only) {
-        if (result.error != Primitive::Error::SUCCESS && (nerrs_ + sumerrs < errcap_)) {
+        if (result.error != Primitive::Error::SUCCESS &&
+            (nerrs_ + nprev + sumerrs < errcap_)) {
           // TODO(JF): put in a proper error response here.
           sumerrs++;
           printf("An error occurred during the primitive solve: %s\n"
@@ -440,10 +496,10 @@ class PrimitiveSolverHydro {
                  adm.vK_dd(m, 0, 2, k, j, i),
                  adm.vK_dd(m, 1, 1, k, j, i), adm.vK_dd(m, 1, 2, k, j, i),
                  adm.vK_dd(m, 2, 2, k, j, i));
-          if (nerrs_ + sumerrs == errcap_) {
+          if (nerrs_ + nprev + sumerrs == errcap_) {
             printf("%d C2P errors have been detected on rank %d. All future C2P errors\n"
                    "on this rank will be suppressed. Fix your code!\n",
-                   nerrs_ + sumerrs,rank);
+                   nerrs_ + nprev + sumerrs,rank);
           }
         }
         // Regardless of failure, we need to copy the primitives.
@@ -494,9 +550,67 @@ class PrimitiveSolverHydro {
             cons(m, nhyd + n, k, j, i) = cons_pt[CYD + n]*sdetg;
           }
         }
+
+        if (tmunu_) {
+          const Real g[3][3] = {
+            {g3d[S11], g3d[S12], g3d[S13]},
+            {g3d[S12], g3d[S22], g3d[S23]},
+            {g3d[S13], g3d[S23], g3d[S33]}
+          };
+          // lower components of u^i = W v^i and B^i
+          Real u_d[3] = {0.0}, B_d[3] = {0.0};
+          for (int a = 0; a < 3; ++a) {
+            for (int b = 0; b < 3; ++b) {
+              u_d[a] += g[a][b]*prim_pt[PVX + b];
+              B_d[a] += g[a][b]*b3u[b];
+            }
+          }
+          Real usq = 0.0, Bu = 0.0, Bsq = 0.0;
+          for (int a = 0; a < 3; ++a) {
+            usq += prim_pt[PVX + a]*u_d[a];
+            Bu += b3u[a]*u_d[a];
+            Bsq += b3u[a]*B_d[a];
+          }
+          Real iW = 1.0/sqrt(1.0 + usq);
+          Real bsq = (Bsq + Bu*Bu)*SQR(iW);
+
+          tmunu.E(m, k, j, i) = cons_pt[CTA] + cons_pt[CDN];
+          for (int a = 0; a < 3; ++a) {
+            tmunu.S_d(m, a, k, j, i) = cons_pt[CSX + a];
+            for (int b = a; b < 3; ++b) {
+              tmunu.S_dd(m, a, b, k, j, i) = cons_pt[CSX + a]*u_d[b]*iW
+                  - (B_d[a] + Bu*u_d[a])*SQR(iW)*B_d[b]
+                  + (prim_pt[PPR] + 0.5*bsq)*g[a][b];
+            }
+          }
+        }
       }
+    };
+
+    int count_errs=0;
+    Kokkos::RangePolicy<DynGRLaunchBounds> c2p_policy(DevExeSpace(), 0, nmkji);
+    Kokkos::parallel_reduce("pshyd_c2p", c2p_policy,
+    KOKKOS_LAMBDA(const int &idx, int &sumerrs) {
+      c2p(idx, lockstep_, 0, sumerrs);
     }, Kokkos::Sum<int>(count_errs));
 
+    // Retry cells that did not converge in lock-step solve, using the full solve.
+    if (lockstep_ > 0) {
+      CellRange range{nmb, kl, ku, jl, ju, il, iu};
+      int nretry = FlaggedCellList(range, true, c2p_retry, false, c2p_retry, c2p_list);
+      if (nretry > 0) {
+        auto &list_ = c2p_list;
+        const int nprev = count_errs;
+        int count_retry_errs = 0;
+        Kokkos::RangePolicy<DynGRLaunchBounds> retry_policy(DevExeSpace(), 0, nretry);
+        Kokkos::parallel_reduce("pshyd_c2p_retry", retry_policy,
+        KOKKOS_LAMBDA(const int &n, int &sumerrs) {
+          c2p(list_(n), 0, nprev, sumerrs);
+        }, Kokkos::Sum<int>(count_retry_errs));
+        count_errs += count_retry_errs;
+      }
+    }
+
     if (floors_only) {
       ps.GetEOSMutable().SetPrimitiveFloorFailure(prim_failure);
       ps.GetEOSMutable().SetConservedFloorFailure(cons_failure);
@@ -511,6 +625,20 @@ class PrimitiveSolverHydro {
                                    Real prim[NPRIM], Real bsq, Real g3d[NSPMETRIC],
                                    Real beta_u[3], Real alpha, Real gii,
                                    int pvx) const {
+    Real P, e, h, cs;
+    ps.GetEOS().GetThermodynamics(prim[PRH], prim[PTM], &prim[PYF], P, e, h, cs);
+    Real H = ps.GetEOS().GetBaryonMass()*prim[PRH]*h;
+    GetGRFastMagnetosonicSpeeds(lambda_p, lambda_m, prim, bsq, cs, H, g3d, beta_u,
+                                alpha, gii, pvx);
+  }
+
+  // As above, but with the sound speed cs and enthalpy density H already evaluated
+  // from the EOS, e.g. when computing the conserved variables at the same state.
+  KOKKOS_INLINE_FUNCTION
+  void GetGRFastMagnetosonicSpeeds(Real& lambda_p, Real& lambda_m,
+                                   Real prim[NPRIM], Real bsq, Real cs, Real H,
+                                   Real g3d[NSPMETRIC], Real beta_u[3], Real alpha,
+                                   Real gii, int pvx) const {
     Real uu[3] = {prim[PVX], prim[PVY], prim[PVZ]};
     Real usq = Primitive::SquareVector(uu, g3d);
     int index = pvx - PVX;
@@ -525,11 +653,8 @@ class PrimitiveSolverHydro {
     Real g01 = -g00*beta_u[index];
     Real g11 = gii - g01*beta_u[index];
 
-    // Calculate the sound speed and the Alfven speed
-    Real cs = ps.GetEOS().GetSoundSpeed(prim[PRH], prim[PTM], &prim[PYF]);
+    // Calculate the Alfven speed
     Real csq = cs*cs;
-    Real H = ps.GetEOS().GetBaryonMass()*prim[PRH]*
-             ps.GetEOS().GetEnthalpy(prim[PRH], prim[PTM], &prim[PYF]);
     Real vasq = bsq/(bsq + H);
     Real cmsq = csq + vasq - csq*vasq;
 
@@ -570,6 +695,9 @@ class PrimitiveSolverHydro {
       case Primitive::Error::NO_SOLUTION:
         return "NO_SOLUTION";
         break;
+      case Primitive::Error::NOT_CONVERGED:
+        return "NOT_CONVERGED";
+        break;
       default:
         return "OTHER";
         break;
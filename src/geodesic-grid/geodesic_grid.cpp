@@ -8,16 +8,33 @@
 
 // C/C++ headers
 #include <float.h>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <string>
 
 // AthenaK headers
 #include "athena.hpp"
+#include "globals.hpp"
 #include "geodesic_grid.hpp"
 
+namespace {
+// header of cache files, identifying the grid and floating-point precision
+constexpr int cache_hdr_size = 5;
+void CacheHeader(int nlevel, bool rotate, bool fluxes, int hdr[cache_hdr_size]) {
+  hdr[0] = 0x67656f64;  // "geod"
+  hdr[1] = nlevel;
+  hdr[2] = static_cast<int>(rotate);
+  hdr[3] = static_cast<int>(fluxes);
+  hdr[4] = static_cast<int>(sizeof(Real));
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------
 // constructor, initializes data structures and parameters
 
-GeodesicGrid::GeodesicGrid(int nlev, bool rotate, bool fluxes) :
+GeodesicGrid::GeodesicGrid(int nlev, bool rotate, bool fluxes,
+                           const std::string &cache_file) :
     nlevel(nlev),
     rotate_geo(rotate),
     geo_fluxes(fluxes),
@@ -53,264 +70,16 @@ GeodesicGrid::GeodesicGrid(int nlev, bool rotate, bool fluxes) :
     Kokkos::realloc(cart_pos_mid,nangles,6,3);
     Kokkos::realloc(polar_pos,nangles,2);
     Kokkos::realloc(polar_pos_mid,nangles,6,2);
-
-    // construction parameters
-    Real sin_ang = 2.0/sqrt(5.0);
-    Real cos_ang = 1.0/sqrt(5.0);
-    Real p1[3] = {0.0, 0.0, 1.0};
-    Real p2[3] = {sin_ang, 0.0, cos_ang};
-    Real p3[3] = {sin_ang*cos( 0.2*M_PI), sin_ang*sin( 0.2*M_PI), -cos_ang};
-    Real p4[3] = {sin_ang*cos(-0.4*M_PI), sin_ang*sin(-0.4*M_PI),  cos_ang};
-    Real p5[3] = {sin_ang*cos(-0.2*M_PI), sin_ang*sin(-0.2*M_PI), -cos_ang};
-    Real p6[3] = {0.0, 0.0, -1.0};
-
-    // set pole normal components explicitly
-    auto &apnorm = ameshp_normals;
-    apnorm(0,0) = 0.0;
-    apnorm(0,1) = 0.0;
-    apnorm(0,2) = 1.0;
-    apnorm(1,0) = 0.0;
-    apnorm(1,1) = 0.0;
-    apnorm(1,2) = -1.0;
-
-    // get normal components of all other angle centers
-    // start by filling in one of the five blocks
-    auto &anorm = amesh_normals;
-    int row_index = 1;
-    for (int l=0; l<nlevel; ++l) {
-      int col_index = 1;
-      for (int m=l; m<nlevel; ++m) {
-        Real x = ((m-l+1)*p2[0] + (nlevel-m-1)*p1[0] + l*p4[0])/(Real)(nlevel);
-        Real y = ((m-l+1)*p2[1] + (nlevel-m-1)*p1[1] + l*p4[1])/(Real)(nlevel);
-        Real z = ((m-l+1)*p2[2] + (nlevel-m-1)*p1[2] + l*p4[2])/(Real)(nlevel);
-        Real norm = sqrt(SQR(x) + SQR(y) + SQR(z));
-        anorm(0,row_index,col_index,0) = x/norm;
-        anorm(0,row_index,col_index,1) = y/norm;
-        anorm(0,row_index,col_index,2) = z/norm;
-        col_index += 1;
-      }
-      for (int m=nlevel-l; m<nlevel; ++m) {
-        Real x =((nlevel-l)*p2[0]+(m-nlevel+l+1)*p5[0]+(nlevel-m-1)*p4[0])/(Real)(nlevel);
-        Real y =((nlevel-l)*p2[1]+(m-nlevel+l+1)*p5[1]+(nlevel-m-1)*p4[1])/(Real)(nlevel);
-        Real z =((nlevel-l)*p2[2]+(m-nlevel+l+1)*p5[2]+(nlevel-m-1)*p4[2])/(Real)(nlevel);
-        Real norm = sqrt(SQR(x) + SQR(y) + SQR(z));
-        anorm(0,row_index,col_index,0) = x/norm;
-        anorm(0,row_index,col_index,1) = y/norm;
-        anorm(0,row_index,col_index,2) = z/norm;
-        col_index += 1;
-      }
-      for (int m=l; m<nlevel; ++m) {
-        Real x = ((m-l+1)*p3[0] + (nlevel-m-1)*p2[0] + l*p5[0])/(Real)(nlevel);
-        Real y = ((m-l+1)*p3[1] + (nlevel-m-1)*p2[1] + l*p5[1])/(Real)(nlevel);
-        Real z = ((m-l+1)*p3[2] + (nlevel-m-1)*p2[2] + l*p5[2])/(Real)(nlevel);
-        Real norm = sqrt(SQR(x) + SQR(y) + SQR(z));
-        anorm(0,row_index,col_index,0) = x/norm;
-        anorm(0,row_index,col_index,1) = y/norm;
-        anorm(0,row_index,col_index,2) = z/norm;
-        col_index += 1;
-      }
-      for (int m=nlevel-l; m<nlevel; ++m) {
-        Real x =((nlevel-l)*p3[0]+(m-nlevel+l+1)*p6[0]+(nlevel-m-1)*p5[0])/(Real)(nlevel);
-        Real y =((nlevel-l)*p3[1]+(m-nlevel+l+1)*p6[1]+(nlevel-m-1)*p5[1])/(Real)(nlevel);
-        Real z =((nlevel-l)*p3[2]+(m-nlevel+l+1)*p6[2]+(nlevel-m-1)*p5[2])/(Real)(nlevel);
-        Real norm = sqrt(SQR(x) + SQR(y) + SQR(z));
-        anorm(0,row_index,col_index,0) = x/norm;
-        anorm(0,row_index,col_index,1) = y/norm;
-        anorm(0,row_index,col_index,2) = z/norm;
-        col_index += 1;
-      }
-      row_index += 1;
-    }
-
-    // fill the other four patches by rotating the first one
-    for (int ptch=1; ptch<5; ++ptch) {
-      for (int l=1; l<1+nlevel; ++l) {
-        for (int m=1; m<1+2*nlevel; ++m) {
-          Real x0 = anorm(0,l,m,0);
-          Real y0 = anorm(0,l,m,1);
-          Real z0 = anorm(0,l,m,2);
-          anorm(ptch,l,m,0) = (x0*cos(ptch*0.4*M_PI)+y0*sin(ptch*0.4*M_PI));
-          anorm(ptch,l,m,1) = (y0*cos(ptch*0.4*M_PI)-x0*sin(ptch*0.4*M_PI));
-          anorm(ptch,l,m,2) = z0;
-        }
-      }
-    }
-
-    // fill in the ghost cells of all blocks
-    for (int i=0; i<3; ++i) {
-      for (int bl=0; bl<5; ++bl) {
-        for (int k=0; k<nlevel; ++k) {
-          anorm(bl,0,k+1,i)          = anorm((bl+4)%5,k+1,1,i);
-          anorm(bl,0,k+nlevel+1,i)   = anorm((bl+4)%5,nlevel,k+1,i);
-          anorm(bl,k+1,2*nlevel+1,i) = anorm((bl+4)%5,nlevel,k+nlevel+1,i);
-          anorm(bl,k+2,0,i)          = anorm((bl+1)%5,1,k+1,i);
-          anorm(bl,nlevel+1,k+1,i)   = anorm((bl+1)%5,1,k+nlevel+1,i);
-          anorm(bl,nlevel+1,k+nlevel+1,i) = anorm((bl+1)%5,k+2,2*nlevel,i);
-        }
-        anorm(bl,1,0,i) = apnorm(0,i);
-        anorm(bl,nlevel+1,2*nlevel,i) = apnorm(1,i);
-        anorm(bl,0,2*nlevel+1,i) = anorm(bl,0,2*nlevel,i);
-      }
-    }
-
-    // generate 2d to 1d map
-    auto &apind = ameshp_indices;
-    auto &aind = amesh_indices;
-    apind(0) = 5*2*SQR(nlevel);
-    apind(1) = 5*2*SQR(nlevel) + 1;
-    for (int ptch=0; ptch<5; ++ptch) {
-      for (int l=0; l<nlevel; ++l) {
-        for (int m=0; m<2*nlevel; ++m) {
-          aind(ptch,l+1,m+1) = ptch*2*SQR(nlevel) + l*2*nlevel + m;
-        }
-      }
-    }
-
-    // fill ghost cells
-    for (int bl=0; bl<5; ++bl) {
-      for (int k=0; k<nlevel; ++k) {
-        aind(bl,0,k+1)               = aind((bl+4)%5,k+1,1);
-        aind(bl,0,k+nlevel+1)        = aind((bl+4)%5,nlevel,k+1);
-        aind(bl,k+1,2*nlevel+1)      = aind((bl+4)%5,nlevel,k+nlevel+1);
-        aind(bl,k+2,0)               = aind((bl+1)%5,1,k+1);
-        aind(bl,nlevel+1,k+1)        = aind((bl+1)%5,1,k+nlevel+1);
-        aind(bl,nlevel+1,k+nlevel+1) = aind((bl+1)%5,k+2,2*nlevel);
-      }
-      aind(bl,1,0) = apind(0);
-      aind(bl,nlevel+1,2*nlevel) = apind(1);
-      aind(bl,0,2*nlevel+1) = aind(bl,0,2*nlevel);
-    }
-
-    // set up arrays for neighbors/neighbor indexing, solid angles, and arc lengths
-    auto &numn = num_neighbors;
-    auto &indn = ind_neighbors;
-    auto &arcl = arc_lengths;
-    for (int n=0; n<nangles; ++n) {
-      // find the number of neighbors and indices of neighbors
-      int num_nghbr; int neighbors[6];
-      Neighbors(n,num_nghbr,neighbors);
-
-      // find the solid angle and arc (edge) lengths
-      Real omega; Real arcs[6];
-      SolidAngleAndArcLengths(n,omega,arcs);
-
-      // store in corresponding arrays
-      numn.h_view(n) = num_nghbr;
-      solid_angles.h_view(n) = omega;
-      for (int nb=0; nb<6; ++nb) {
-        indn.h_view(n,nb) = neighbors[nb];
-        arcl.h_view(n,nb) = arcs[nb];
-      }
-    }
-
-    // set up arrays for neighbor edge indexing
-    auto &indne = ind_neighbors_edges;
-    for (int n=0; n<nangles; ++n) {
-      int nn = numn.h_view(n);
-      for (int nb=0; nb<nn; ++nb) {
-        for (int nnb=0; nnb<numn.h_view(indn.h_view(n,nb)); ++nnb) {
-          if (n==indn.h_view(indn.h_view(n,nb),nnb)) {
-            indne.h_view(n,nb) = nnb;
-          }
-        }
-      }
-      if (nn==5) {
-        indne.h_view(n,5) = (INT_MAX);
-      }
-    }
-
-    // correct for round-off error level diff in arc lengths among shared edges
-    for (int n=0; n<nangles; ++n) {
-      for (int nb=0; nb<numn.h_view(n); ++nb) {
-        Real arc_avg = 0.5*(arcl.h_view(n,nb) +
-                            arcl.h_view(indn.h_view(n,nb),indne.h_view(n,nb)));
-        arcl.h_view(n,nb) = arc_avg;
-        arcl.h_view(indn.h_view(n,nb),indne.h_view(n,nb)) = arc_avg;
-      }
-    }
-
-    // rotate geodesic mesh
-    if (rotate_geo) {
-      Real rotangles[2];
-      OptimalAngles(rotangles);
-      RotateGrid(rotangles[0],rotangles[1]);
-    }
-
-    // set grid positions
-    for (int n=0; n<nangles; ++n) {
-      Real x, y, z;
-      GridCartPosition(n,x,y,z);
-      cart_pos.h_view(n,0) = x;
-      cart_pos.h_view(n,1) = y;
-      cart_pos.h_view(n,2) = z;
-      int nn = num_neighbors.h_view(n);
-      for (int nb=0; nb<nn; ++nb) {
-        Real xm, ym, zm;
-        GridCartPositionMid(n,ind_neighbors.h_view(n,nb),xm,ym,zm);
-        cart_pos_mid.h_view(n,nb,0) = xm;
-        cart_pos_mid.h_view(n,nb,1) = ym;
-        cart_pos_mid.h_view(n,nb,2) = zm;
-      }
-      if (nn==5) {
-        cart_pos_mid.h_view(n,5,0) = (FLT_MAX);
-        cart_pos_mid.h_view(n,5,1) = (FLT_MAX);
-        cart_pos_mid.h_view(n,5,2) = (FLT_MAX);
-      }
-    }
-
-    // set polar coordinate positions
-    for (int n=0; n<nangles; ++n) {
-      polar_pos.h_view(n,0) = acos(cart_pos.h_view(n,2));
-      polar_pos.h_view(n,1) = atan2(cart_pos.h_view(n,1), cart_pos.h_view(n,0));
-      int nn = num_neighbors.h_view(n);
-      for (int nb=0; nb<nn; ++nb) {
-        polar_pos_mid.h_view(n,nb,0) = acos(cart_pos_mid.h_view(n,nb,2));
-        polar_pos_mid.h_view(n,nb,1) = atan2(cart_pos_mid.h_view(n,nb,1),
-                                             cart_pos_mid.h_view(n,nb,0));
-      }
-      if (nn==5) {
-        polar_pos_mid.h_view(n,5,0) = (FLT_MAX);
-        polar_pos_mid.h_view(n,5,1) = (FLT_MAX);
-      }
+    if (geo_fluxes) {
+      Kokkos::realloc(unit_flux,nangles,6,2);
     }
 
-    // set angular unit vectors along edges of angle faces
-    if (geo_fluxes) {
-      // reallocate unit flux array
-      Kokkos::realloc(unit_flux, nangles, 6, 2);
-      // set unit flux
-      for (int n=0; n<nangles; ++n) {
-        Real x, y, z;
-        GridCartPosition(n,x,y,z);
-        Real zetav = acos(z);
-        Real psiv  = atan2(y,x);
-        for (int nb=0; nb<num_neighbors.h_view(n); ++nb) {
-          Real xm, ym, zm;
-          GridCartPositionMid(n,ind_neighbors.h_view(n,nb),xm,ym,zm);
-          Real zetaf = acos(zm);
-          Real psif  = atan2(ym,xm);
-          Real unit_zeta, unit_psi;
-          UnitFluxDir(zetav,psiv,zetaf,psif,unit_zeta,unit_psi);
-          unit_flux.h_view(n,nb,0) = unit_zeta;
-          unit_flux.h_view(n,nb,1) = unit_psi;
-        }
-      }
-      // correct for round-off error level diff in unit vectors among shared edges
-      for (int n=0; n<nangles; ++n) {
-        for (int nb=0; nb<numn.h_view(n); ++nb) {
-          Real tuzeta = unit_flux.h_view(n,nb,0);
-          Real tupsi  = unit_flux.h_view(n,nb,1);
-          Real nuzeta = unit_flux.h_view(indn.h_view(n,nb),indne.h_view(n,nb),0);
-          Real nupsi  = unit_flux.h_view(indn.h_view(n,nb),indne.h_view(n,nb),1);
-          Real uzeta_avg = 0.5*(fabs(tuzeta) + fabs(nuzeta));
-          Real upsi_avg  = 0.5*(fabs(tupsi ) + fabs(nupsi ));
-          unit_flux.h_view(n,nb,0) = copysign(uzeta_avg, tuzeta);
-          unit_flux.h_view(n,nb,1) = copysign(upsi_avg, tupsi);
-          unit_flux.h_view(indn.h_view(n,nb),indne.h_view(n,nb),0) = copysign(uzeta_avg,
-                                                                              nuzeta);
-          unit_flux.h_view(indn.h_view(n,nb),indne.h_view(n,nb),1) = copysign(upsi_avg,
-                                                                              nupsi);
-        }
+    // read geometry from the cache file if it exists and matches this grid, otherwise
+    // compute it (and write the cache file from rank 0)
+    if (cache_file.empty() || !(ReadCache(cache_file))) {
+      ComputeGeometry();
+      if (!(cache_file.empty()) && global_variable::my_rank == 0) {
+        WriteCache(cache_file);
       }
     }
 
@@ -382,6 +151,320 @@ GeodesicGrid::GeodesicGrid(int nlev, bool rotate, bool fluxes) :
   }
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void GeodesicGrid::ComputeGeometry()
+//! \brief computes normals, indexing, neighbors, solid angles, arc lengths, and positions
+//! of the geodesic mesh (rotated if requested) on the host
+
+void GeodesicGrid::ComputeGeometry() {
+  // construction parameters
+  Real sin_ang = 2.0/sqrt(5.0);
+  Real cos_ang = 1.0/sqrt(5.0);
+  Real p1[3] = {0.0, 0.0, 1.0};
+  Real p2[3] = {sin_ang, 0.0, cos_ang};
+  Real p3[3] = {sin_ang*cos( 0.2*M_PI), sin_ang*sin( 0.2*M_PI), -cos_ang};
+  Real p4[3] = {sin_ang*cos(-0.4*M_PI), sin_ang*sin(-0.4*M_PI),  cos_ang};
+  Real p5[3] = {sin_ang*cos(-0.2*M_PI), sin_ang*sin(-0.2*M_PI), -cos_ang};
+  Real p6[3] = {0.0, 0.0, -1.0};
+
+  // set pole normal components explicitly
+  auto &apnorm = ameshp_normals;
+  apnorm(0,0) = 0.0;
+  apnorm(0,1) = 0.0;
+  apnorm(0,2) = 1.0;
+  apnorm(1,0) = 0.0;
+  apnorm(1,1) = 0.0;
+  apnorm(1,2) = -1.0;
+
+  // get normal components of all other angle centers
+  // start by filling in one of the five blocks
+  auto &anorm = amesh_normals;
+  int row_index = 1;
+  for (int l=0; l<nlevel; ++l) {
+    int col_index = 1;
+    for (int m=l; m<nlevel; ++m) {
+      Real x = ((m-l+1)*p2[0] + (nlevel-m-1)*p1[0] + l*p4[0])/(Real)(nlevel);
+      Real y = ((m-l+1)*p2[1] + (nlevel-m-1)*p1[1] + l*p4[1])/(Real)(nlevel);
+      Real z = ((m-l+1)*p2[2] + (nlevel-m-1)*p1[2] + l*p4[2])/(Real)(nlevel);
+      Real norm = sqrt(SQR(x) + SQR(y) + SQR(z));
+      anorm(0,row_index,col_index,0) = x/norm;
+      anorm(0,row_index,col_index,1) = y/norm;
+      anorm(0,row_index,col_index,2) = z/norm;
+      col_index += 1;
+    }
+    for (int m=nlevel-l; m<nlevel; ++m) {
+      Real x =((nlevel-l)*p2[0]+(m-nlevel+l+1)*p5[0]+(nlevel-m-1)*p4[0])/(Real)(nlevel);
+      Real y =((nlevel-l)*p2[1]+(m-nlevel+l+1)*p5[1]+(nlevel-m-1)*p4[1])/(Real)(nlevel);
+      Real z =((nlevel-l)*p2[2]+(m-nlevel+l+1)*p5[2]+(nlevel-m-1)*p4[2])/(Real)(nlevel);
+      Real norm = sqrt(SQR(x) + SQR(y) + SQR(z));
+      anorm(0,row_index,col_index,0) = x/norm;
+      anorm(0,row_index,col_index,1) = y/norm;
+      anorm(0,row_index,col_index,2) = z/norm;
+      col_index += 1;
+    }
+    for (int m=l; m<nlevel; ++m) {
+      Real x = ((m-l+1)*p3[0] + (nlevel-m-1)*p2[0] + l*p5[0])/(Real)(nlevel);
+      Real y = ((m-l+1)*p3[1] + (nlevel-m-1)*p2[1] + l*p5[1])/(Real)(nlevel);
+      Real z = ((m-l+1)*p3[2] + (nlevel-m-1)*p2[2] + l*p5[2])/(Real)(nlevel);
+      Real norm = sqrt(SQR(x) + SQR(y) + SQR(z));
+      anorm(0,row_index,col_index,0) = x/norm;
+      anorm(0,row_index,col_index,1) = y/norm;
+      anorm(0,row_index,col_index,2) = z/norm;
+      col_index += 1;
+    }
+    for (int m=nlevel-l; m<nlevel; ++m) {
+      Real x =((nlevel-l)*p3[0]+(m-nlevel+l+1)*p6[0]+(nlevel-m-1)*p5[0])/(Real)(nlevel);
+      Real y =((nlevel-l)*p3[1]+(m-nlevel+l+1)*p6[1]+(nlevel-m-1)*p5[1])/(Real)(nlevel);
+      Real z =((nlevel-l)*p3[2]+(m-nlevel+l+1)*p6[2]+(nlevel-m-1)*p5[2])/(Real)(nlevel);
+      Real norm = sqrt(SQR(x) + SQR(y) + SQR(z));
+      anorm(0,row_index,col_index,0) = x/norm;
+      anorm(0,row_index,col_index,1) = y/norm;
+      anorm(0,row_index,col_index,2) = z/norm;
+      col_index += 1;
+    }
+    row_index += 1;
+  }
+
+  // fill the other four patches by rotating the first one
+  for (int ptch=1; ptch<5; ++ptch) {
+    for (int l=1; l<1+nlevel; ++l) {
+      for (int m=1; m<1+2*nlevel; ++m) {
+        Real x0 = anorm(0,l,m,0);
+        Real y0 = anorm(0,l,m,1);
+        Real z0 = anorm(0,l,m,2);
+        anorm(ptch,l,m,0) = (x0*cos(ptch*0.4*M_PI)+y0*sin(ptch*0.4*M_PI));
+        anorm(ptch,l,m,1) = (y0*cos(ptch*0.4*M_PI)-x0*sin(ptch*0.4*M_PI));
+        anorm(ptch,l,m,2) = z0;
+      }
+    }
+  }
+
+  // fill in the ghost cells of all blocks
+  for (int i=0; i<3; ++i) {
+    for (int bl=0; bl<5; ++bl) {
+      for (int k=0; k<nlevel; ++k) {
+        anorm(bl,0,k+1,i)          = anorm((bl+4)%5,k+1,1,i);
+        anorm(bl,0,k+nlevel+1,i)   = anorm((bl+4)%5,nlevel,k+1,i);
+        anorm(bl,k+1,2*nlevel+1,i) = anorm((bl+4)%5,nlevel,k+nlevel+1,i);
+        anorm(bl,k+2,0,i)          = anorm((bl+1)%5,1,k+1,i);
+        anorm(bl,nlevel+1,k+1,i)   = anorm((bl+1)%5,1,k+nlevel+1,i);
+        anorm(bl,nlevel+1,k+nlevel+1,i) = anorm((bl+1)%5,k+2,2*nlevel,i);
+      }
+      anorm(bl,1,0,i) = apnorm(0,i);
+      anorm(bl,nlevel+1,2*nlevel,i) = apnorm(1,i);
+      anorm(bl,0,2*nlevel+1,i) = anorm(bl,0,2*nlevel,i);
+    }
+  }
+
+  // generate 2d to 1d map
+  auto &apind = ameshp_indices;
+  auto &aind = amesh_indices;
+  apind(0) = 5*2*SQR(nlevel);
+  apind(1) = 5*2*SQR(nlevel) + 1;
+  for (int ptch=0; ptch<5; ++ptch) {
+    for (int l=0; l<nlevel; ++l) {
+      for (int m=0; m<2*nlevel; ++m) {
+        aind(ptch,l+1,m+1) = ptch*2*SQR(nlevel) + l*2*nlevel + m;
+      }
+    }
+  }
+
+  // fill ghost cells
+  for (int bl=0; bl<5; ++bl) {
+    for (int k=0; k<nlevel; ++k) {
+      aind(bl,0,k+1)               = aind((bl+4)%5,k+1,1);
+      aind(bl,0,k+nlevel+1)        = aind((bl+4)%5,nlevel,k+1);
+      aind(bl,k+1,2*nlevel+1)      = aind((bl+4)%5,nlevel,k+nlevel+1);
+      aind(bl,k+2,0)               = aind((bl+1)%5,1,k+1);
+      aind(bl,nlevel+1,k+1)        = aind((bl+1)%5,1,k+nlevel+1);
+      aind(bl,nlevel+1,k+nlevel+1) = aind((bl+1)%5,k+2,2*nlevel);
+    }
+    aind(bl,1,0) = apind(0);
+    aind(bl,nlevel+1,2*nlevel) = apind(1);
+    aind(bl,0,2*nlevel+1) = aind(bl,0,2*nlevel);
+  }
+
+  // set up arrays for neighbors/neighbor indexing, solid angles, and arc lengths
+  auto &numn = num_neighbors;
+  auto &indn = ind_neighbors;
+  auto &arcl = arc_lengths;
+  for (int n=0; n<nangles; ++n) {
+    // find the number of neighbors and indices of neighbors
+    int num_nghbr; int neighbors[6];
+    Neighbors(n,num_nghbr,neighbors);
+
+    // find the solid angle and arc (edge) lengths
+    Real omega; Real arcs[6];
+    SolidAngleAndArcLengths(n,omega,arcs);
+
+    // store in corresponding arrays
+    numn.h_view(n) = num_nghbr;
+    solid_angles.h_view(n) = omega;
+    for (int nb=0; nb<6; ++nb) {
+      indn.h_view(n,nb) = neighbors[nb];
+      arcl.h_view(n,nb) = arcs[nb];
+    }
+  }
+
+  // set up arrays for neighbor edge indexing
+  auto &indne = ind_neighbors_edges;
+  for (int n=0; n<nangles; ++n) {
+    int nn = numn.h_view(n);
+    for (int nb=0; nb<nn; ++nb) {
+      for (int nnb=0; nnb<numn.h_view(indn.h_view(n,nb)); ++nnb) {
+        if (n==indn.h_view(indn.h_view(n,nb),nnb)) {
+          indne.h_view(n,nb) = nnb;
+        }
+      }
+    }
+    if (nn==5) {
+      indne.h_view(n,5) = (INT_MAX);
+    }
+  }
+
+  // correct for round-off error level diff in arc lengths among shared edges
+  for (int n=0; n<nangles; ++n) {
+    for (int nb=0; nb<numn.h_view(n); ++nb) {
+      Real arc_avg = 0.5*(arcl.h_view(n,nb) +
+                          arcl.h_view(indn.h_view(n,nb),indne.h_view(n,nb)));
+      arcl.h_view(n,nb) = arc_avg;
+      arcl.h_view(indn.h_view(n,nb),indne.h_view(n,nb)) = arc_avg;
+    }
+  }
+
+  // rotate geodesic mesh
+  if (rotate_geo) {
+    Real rotangles[2];
+    OptimalAngles(rotangles);
+    RotateGrid(rotangles[0],rotangles[1]);
+  }
+
+  // set grid positions
+  for (int n=0; n<nangles; ++n) {
+    Real x, y, z;
+    GridCartPosition(n,x,y,z);
+    cart_pos.h_view(n,0) = x;
+    cart_pos.h_view(n,1) = y;
+    cart_pos.h_view(n,2) = z;
+    int nn = num_neighbors.h_view(n);
+    for (int nb=0; nb<nn; ++nb) {
+      Real xm, ym, zm;
+      GridCartPositionMid(n,ind_neighbors.h_view(n,nb),xm,ym,zm);
+      cart_pos_mid.h_view(n,nb,0) = xm;
+      cart_pos_mid.h_view(n,nb,1) = ym;
+      cart_pos_mid.h_view(n,nb,2) = zm;
+    }
+    if (nn==5) {
+      cart_pos_mid.h_view(n,5,0) = (FLT_MAX);
+      cart_pos_mid.h_view(n,5,1) = (FLT_MAX);
+      cart_pos_mid.h_view(n,5,2) = (FLT_MAX);
+    }
+  }
+
+  // set polar coordinate positions
+  for (int n=0; n<nangles; ++n) {
+    polar_pos.h_view(n,0) = acos(cart_pos.h_view(n,2));
+    polar_pos.h_view(n,1) = atan2(cart_pos.h_view(n,1), cart_pos.h_view(n,0));
+    int nn = num_neighbors.h_view(n);
+    for (int nb=0; nb<nn; ++nb) {
+      polar_pos_mid.h_view(n,nb,0) = acos(cart_pos_mid.h_view(n,nb,2));
+      polar_pos_mid.h_view(n,nb,1) = atan2(cart_pos_mid.h_view(n,nb,1),
+                                           cart_pos_mid.h_view(n,nb,0));
+    }
+    if (nn==5) {
+      polar_pos_mid.h_view(n,5,0) = (FLT_MAX);
+      polar_pos_mid.h_view(n,5,1) = (FLT_MAX);
+    }
+  }
+
+  // set angular unit vectors along edges of angle faces
+  if (geo_fluxes) {
+    // set unit flux
+    for (int n=0; n<nangles; ++n) {
+      Real x, y, z;
+      GridCartPosition(n,x,y,z);
+      Real zetav = acos(z);
+      Real psiv  = atan2(y,x);
+      for (int nb=0; nb<num_neighbors.h_view(n); ++nb) {
+        Real xm, ym, zm;
+        GridCartPositionMid(n,ind_neighbors.h_view(n,nb),xm,ym,zm);
+        Real zetaf = acos(zm);
+        Real psif  = atan2(ym,xm);
+        Real unit_zeta, unit_psi;
+        UnitFluxDir(zetav,psiv,zetaf,psif,unit_zeta,unit_psi);
+        unit_flux.h_view(n,nb,0) = unit_zeta;
+        unit_flux.h_view(n,nb,1) = unit_psi;
+      }
+    }
+    // correct for round-off error level diff in unit vectors among shared edges
+    for (int n=0; n<nangles; ++n) {
+      for (int nb=0; nb<numn.h_view(n); ++nb) {
+        Real tuzeta = unit_flux.h_view(n,nb,0);
+        Real tupsi  = unit_flux.h_view(n,nb,1);
+        Real nuzeta = unit_flux.h_view(indn.h_view(n,nb),indne.h_view(n,nb),0);
+        Real nupsi  = unit_flux.h_view(indn.h_view(n,nb),indne.h_view(n,nb),1);
+        Real uzeta_avg = 0.5*(fabs(tuzeta) + fabs(nuzeta));
+        Real upsi_avg  = 0.5*(fabs(tupsi ) + fabs(nupsi ));
+        unit_flux.h_view(n,nb,0) = copysign(uzeta_avg, tuzeta);
+        unit_flux.h_view(n,nb,1) = copysign(upsi_avg, tupsi);
+        unit_flux.h_view(indn.h_view(n,nb),indne.h_view(n,nb),0) = copysign(uzeta_avg,
+                                                                            nuzeta);
+        unit_flux.h_view(indn.h_view(n,nb),indne.h_view(n,nb),1) = copysign(upsi_avg,
+                                                                            nupsi);
+      }
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool GeodesicGrid::ReadCache()
+//! \brief reads all host arrays of the geodesic mesh from the binary file written by
+//! WriteCache().  Returns false if the file is missing, incomplete, or was written for a
+//! different grid.
+
+bool GeodesicGrid::ReadCache(const std::string &fname) {
+  std::ifstream is(fname, std::ios::binary);
+  if (!is) {return false;}
+  int hdr[cache_hdr_size], expect[cache_hdr_size];
+  CacheHeader(nlevel, rotate_geo, geo_fluxes, expect);
+  is.read(reinterpret_cast<char*>(hdr), sizeof(hdr));
+  for (int n=0; n<cache_hdr_size; ++n) {
+    if (!is || hdr[n] != expect[n]) {return false;}
+  }
+  auto read = [&](auto &a) {
+    is.read(reinterpret_cast<char*>(a.data()), a.span()*sizeof(*a.data()));
+  };
+  ForEachCachedArray(read);
+  return static_cast<bool>(is);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void GeodesicGrid::WriteCache()
+//! \brief writes all host arrays of the geodesic mesh to a binary file.  The file is
+//! written under a temporary name and then renamed, so other ranks never read a partial
+//! cache file.
+
+void GeodesicGrid::WriteCache(const std::string &fname) {
+  std::string tmpname = fname + ".tmp";
+  std::ofstream os(tmpname, std::ios::binary | std::ios::trunc);
+  int hdr[cache_hdr_size];
+  CacheHeader(nlevel, rotate_geo, geo_fluxes, hdr);
+  os.write(reinterpret_cast<const char*>(hdr), sizeof(hdr));
+  auto write = [&](auto &a) {
+    os.write(reinterpret_cast<const char*>(a.data()), a.span()*sizeof(*a.data()));
+  };
+  ForEachCachedArray(write);
+  os.close();
+  if (os.fail() || std::rename(tmpname.c_str(), fname.c_str()) != 0) {
+    std::remove(tmpname.c_str());
+    std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Could not write geodesic grid cache file '" << fname << "'"
+              << std::endl;
+  }
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 //! \brief GeodesicGrid destructor
 
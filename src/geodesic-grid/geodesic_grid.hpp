@@ -8,6 +8,8 @@
 //! \file geodesic_grid.hpp
 //  \brief definitions for GeodesicGrid class
 
+#include <string>
+
 #include "athena.hpp"
 
 //----------------------------------------------------------------------------------------
@@ -15,7 +17,9 @@
 
 class GeodesicGrid {
  public:
-  GeodesicGrid(int nlev, bool rotate, bool fluxes);
+  // geometry is read from cache_file if it exists and matches, and otherwise computed
+  // and written to cache_file by rank 0 (no caching if cache_file is empty)
+  GeodesicGrid(int nlev, bool rotate, bool fluxes, const std::string &cache_file = "");
   ~GeodesicGrid();
 
   int nangles;  // number of angles (derived from nlevel, 5*(2*nlevel^2) + 2)
@@ -51,6 +55,28 @@ class GeodesicGrid {
   HostArray2D<Real> ameshp_normals;  // normal components (at poles)
   HostArray3D<Real> amesh_indices;   // indexing (regular faces)
   HostArray1D<Real> ameshp_indices;  // indexing (at poles)
+
+  void ComputeGeometry();
+  bool ReadCache(const std::string &fname);
+  void WriteCache(const std::string &fname);
+  // applies f to the host view of every array set by ComputeGeometry()
+  template <typename F>
+  void ForEachCachedArray(F &f) {
+    f(amesh_normals);
+    f(ameshp_normals);
+    f(amesh_indices);
+    f(ameshp_indices);
+    f(num_neighbors.h_view);
+    f(ind_neighbors.h_view);
+    f(ind_neighbors_edges.h_view);
+    f(solid_angles.h_view);
+    f(arc_lengths.h_view);
+    f(cart_pos.h_view);
+    f(cart_pos_mid.h_view);
+    f(polar_pos.h_view);
+    f(polar_pos_mid.h_view);
+    if (geo_fluxes) {f(unit_flux.h_view);}
+  }
 };
 
 #endif // GEODESIC_GRID_GEODESIC_GRID_HPP_
@@ -99,20 +99,23 @@ void SphericalGrid::SetInterpolationIndices() {
 
   auto &rcoord = interp_coord;
   auto &iindcs = interp_indcs;
+  auto &stretch = pmy_pack->pmesh->stretch;
   for (int n=0; n<=nang1; ++n) {
+    // MeshBlocks are uniform in the logical coordinates (see CoordinateStretch)
+    Real xi[3] = {stretch.Xi(0, rcoord.h_view(n,0)), stretch.Xi(1, rcoord.h_view(n,1)),
+                  stretch.Xi(2, rcoord.h_view(n,2))};
     // indices default to -1 if angle does not reside in this MeshBlockPack
     iindcs.h_view(n,0) = -1;
     iindcs.h_view(n,1) = -1;
     iindcs.h_view(n,2) = -1;
     iindcs.h_view(n,3) = -1;
-    for (int m=0; m<=nmb1; ++m) {
+    // locate MeshBlock containing this angle position with a MeshBlockTree descent
+    int m = pmy_pack->pmesh->FindMeshBlockGID(xi[0], xi[1], xi[2]) - pmy_pack->gids;
+    if (m >= 0 && m <= nmb1) {
       // extract MeshBlock bounds
       Real &x1min = size.h_view(m).x1min;
-      Real &x1max = size.h_view(m).x1max;
       Real &x2min = size.h_view(m).x2min;
-      Real &x2max = size.h_view(m).x2max;
       Real &x3min = size.h_view(m).x3min;
-      Real &x3max = size.h_view(m).x3max;
 
       // extract MeshBlock grid cell spacings
       Real &dx1 = size.h_view(m).dx1;
@@ -120,18 +123,10 @@ void SphericalGrid::SetInterpolationIndices() {
       Real &dx3 = size.h_view(m).dx3;
 
       // save MeshBlock and zone indicies for nearest position to spherical patch center
-      // if this angle position resides in this MeshBlock
-      if ((rcoord.h_view(n,0) >= x1min && rcoord.h_view(n,0) <= x1max) &&
-          (rcoord.h_view(n,1) >= x2min && rcoord.h_view(n,1) <= x2max) &&
-          (rcoord.h_view(n,2) >= x3min && rcoord.h_view(n,2) <= x3max)) {
-        iindcs.h_view(n,0) = m;
-        iindcs.h_view(n,1) = static_cast<int>(std::floor((rcoord.h_view(n,0)-
-                                                          (x1min+dx1/2.0))/dx1));
-        iindcs.h_view(n,2) = static_cast<int>(std::floor((rcoord.h_view(n,1)-
-                                                          (x2min+dx2/2.0))/dx2));
-        iindcs.h_view(n,3) = static_cast<int>(std::floor((rcoord.h_view(n,2)-
-                                                          (x3min+dx3/2.0))/dx3));
-      }
+      iindcs.h_view(n,0) = m;
+      iindcs.h_view(n,1) = static_cast<int>(std::floor((xi[0]-(x1min+dx1/2.0))/dx1));
+      iindcs.h_view(n,2) = static_cast<int>(std::floor((xi[1]-(x2min+dx2/2.0))/dx2));
+      iindcs.h_view(n,3) = static_cast<int>(std::floor((xi[2]-(x3min+dx3/2.0))/dx3));
     }
   }
 
@@ -168,9 +163,10 @@ void SphericalGrid::SetInterpolationWeights() {
       }
     } else {
       // extract spherical grid positions
-      Real &x0 = interp_coord.h_view(n,0);
-      Real &y0 = interp_coord.h_view(n,1);
-      Real &z0 = interp_coord.h_view(n,2);
+      auto &stretch = pmy_pack->pmesh->stretch;
+      Real x0 = stretch.Xi(0, interp_coord.h_view(n,0));
+      Real y0 = stretch.Xi(1, interp_coord.h_view(n,1));
+      Real z0 = stretch.Xi(2, interp_coord.h_view(n,2));
 
       // extract MeshBlock bounds
       Real &x1min = size.h_view(ii0).x1min;
@@ -213,7 +209,8 @@ void SphericalGrid::SetInterpolationWeights() {
 //! \fn void SphericalGrid::InterpolateToSphere
 //! \brief interpolate Cartesian data to surface of sphere
 
-void SphericalGrid::InterpolateToSphere(int nvars, DvceArray5D<Real> &val) {
+void SphericalGrid::InterpolateToSphere(int nvars, DvceArray5D<Real> &val,
+                                        bool sync_host) {
   // reinitialize interpolation indices and weights if AMR
   if (pmy_pack->pmesh->adaptive) {
     SetInterpolationIndices();
@@ -227,8 +224,10 @@ void SphericalGrid::InterpolateToSphere(int nvars, DvceArray5D<Real> &val) {
   int nang1 = nangles - 1;
   int nvar1 = nvars - 1;
 
-  // reallocate container
-  Kokkos::realloc(interp_vals,nangles,nvars);
+  // reallocate container (only if its size changed)
+  if (interp_vals.extent_int(0) != nangles || interp_vals.extent_int(1) != nvars) {
+    Kokkos::realloc(interp_vals,nangles,nvars);
+  }
 
   auto &iindcs = interp_indcs;
   auto &iwghts = interp_wghts;
@@ -258,7 +257,9 @@ void SphericalGrid::InterpolateToSphere(int nvars, DvceArray5D<Real> &val) {
 
   // sync dual arrays
   interp_vals.template modify<DevExeSpace>();
-  interp_vals.template sync<HostMemSpace>();
+  if (sync_host) {
+    interp_vals.template sync<HostMemSpace>();
+  }
 
   return;
 }
@@ -27,7 +27,9 @@ class SphericalGrid: public GeodesicGrid {
     Real radius;  // const radius for SphericalGrid
     DualArray2D<Real> interp_coord;  // Cartesian coordinates for grid points
     DualArray2D<Real> interp_vals;   // container for data interpolated to sphere
-    void InterpolateToSphere(int nvars, DvceArray5D<Real> &val);  // interpolate to sphere
+    // interpolate to sphere; the copy of interp_vals to host can be deferred so that the
+    // kernels for several spheres are launched before waiting on any of them
+    void InterpolateToSphere(int nvars, DvceArray5D<Real> &val, bool sync_host=true);
 
  private:
     MeshBlockPack* pmy_pack;  // ptr to MeshBlockPack containing this Hydro
@@ -14,6 +14,11 @@
 #include "globals.hpp"
 
 namespace global_variable {
-int my_rank;   // MPI rank of this process; set at start of main();
-int nranks;    // total number of MPI ranks; set at start of main();
+int my_rank;   // MPI rank of this process in mpi_comm; set at start of main();
+int nranks;    // total number of MPI ranks in mpi_comm; set at start of main();
+int my_member = 0;  // ensemble member run by this rank (see main() option -e)
+int nmembers = 1;   // number of ensemble members (independent Meshes) in this job
+#if MPI_PARALLEL_ENABLED
+MPI_Comm mpi_comm;  // communicator of ranks sharing Mesh of my_member; set in main()
+#endif
 }
@@ -8,8 +8,18 @@
 //! \file globals.hpp
 //  \brief namespace containing external global variables
 
+#include "config.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
 namespace global_variable {
 extern int my_rank, nranks;
+extern int my_member, nmembers;
+#if MPI_PARALLEL_ENABLED
+extern MPI_Comm mpi_comm;
+#endif
 }
 
 #endif // GLOBALS_HPP_
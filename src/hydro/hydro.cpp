@@ -34,7 +34,12 @@ Hydro::Hydro(MeshBlockPack *ppack, ParameterInput *pin) :
     u1("cons1",1,1,1,1,1),
     uflx("uflx",1,1,1,1,1),
     utest("utest",1,1,1,1,1),
-    fofc("fofc",1,1,1,1) {
+    fofc("fofc",1,1,1,1),
+    wl4("wl4",1,1,1,1,1),
+    wr4("wr4",1,1,1,1,1),
+    flx4("flx4",1,1,1,1,1),
+    u2_sts("cons2_sts",1,1,1,1,1),
+    dudt0_sts("dudt0_sts",1,1,1,1,1) {
   // Total number of MeshBlocks on this rank to be used in array dimensioning
   int nmb = std::max((ppack->nmb_thispack), (ppack->pmesh->nmb_maxperrank));
 
@@ -101,22 +106,25 @@ Hydro::Hydro(MeshBlockPack *ppack, ParameterInput *pin) :
     int ncells1 = indcs.nx1 + 2*(indcs.ng);
     int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
     int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
-    Kokkos::realloc(u0, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
-    Kokkos::realloc(w0, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
+    ReallocFirstTouch(u0, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
+    ReallocFirstTouch(w0, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
   }
 
-  // allocate memory for conserved variables on coarse mesh
-  if (ppack->pmesh->multilevel) {
+  // allocate memory for conserved variables on coarse mesh (only if used on this rank)
+  if (ppack->pmesh->multilevel && ppack->pmb->need_coarse) {
     auto &indcs = pmy_pack->pmesh->mb_indcs;
     int n_ccells1 = indcs.cnx1 + 2*(indcs.ng);
     int n_ccells2 = (indcs.cnx2 > 1)? (indcs.cnx2 + 2*(indcs.ng)) : 1;
     int n_ccells3 = (indcs.cnx3 > 1)? (indcs.cnx3 + 2*(indcs.ng)) : 1;
-    Kokkos::realloc(coarse_u0, nmb, (nhydro+nscalars), n_ccells3, n_ccells2, n_ccells1);
-    Kokkos::realloc(coarse_w0, nmb, (nhydro+nscalars), n_ccells3, n_ccells2, n_ccells1);
+    ReallocFirstTouch(coarse_u0, nmb, (nhydro+nscalars), n_ccells3, n_ccells2, n_ccells1);
+    ReallocFirstTouch(coarse_w0, nmb, (nhydro+nscalars), n_ccells3, n_ccells2, n_ccells1);
   }
 
   // allocate boundary buffers for conserved (cell-centered) variables
   pbval_u = new MeshBoundaryValuesCC(ppack, pin, false);
+  pbval_u->comm_module = comm_stats::Module::hydro;
+  pbval_u->SetHaloPrecision(pin, "hydro");
+  pbval_u->SetGhostDepth(pin, "hydro");
   pbval_u->InitializeBuffers((nhydro+nscalars));
 
   // Orbital advection and shearing box BCs (if requested in input file)
@@ -133,6 +141,19 @@ Hydro::Hydro(MeshBlockPack *ppack, ParameterInput *pin) :
     // determine if FOFC is enabled
     use_fofc = pin->GetOrAddBoolean("hydro","fofc",false);
 
+    // determine if new timestep is computed in C2P kernel of last stage, rather than in
+    // a separate sweep over primitives.  Only implemented for non-relativistic EOS.
+    fused_newdt = pin->GetOrAddBoolean("hydro","fused_newdt",false);
+    if (fused_newdt && ((evolution_t.compare("dynamic") != 0) ||
+        pmy_pack->pcoord->is_special_relativistic ||
+        pmy_pack->pcoord->is_general_relativistic ||
+        pmy_pack->pcoord->is_dynamical_relativistic)) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<hydro>/fused_newdt can only be used for dynamic, "
+                << "non-relativistic problems" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+
     // select reconstruction method (default PLM)
     std::string xorder = pin->GetOrAddString("hydro","reconstruct","plm");
     if (xorder.compare("dc") == 0) {
@@ -140,29 +161,29 @@ Hydro::Hydro(MeshBlockPack *ppack, ParameterInput *pin) :
     } else if (xorder.compare("plm") == 0) {
       recon_method = ReconstructionMethod::plm;
       // check that nghost > 2 with PLM+FOFC
-      auto &indcs = pmy_pack->pmesh->mb_indcs;
-      if (use_fofc && indcs.ng < 3) {
+      int ng = pbval_u->nghost_same;
+      if (use_fofc && ng < 3) {
         std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
           << std::endl << "FOFC and " << xorder << " reconstruction requires at "
-          << "least 3 ghost zones, but <mesh>/nghost=" << indcs.ng << std::endl;
+          << "least 3 ghost zones, but <hydro>/nghost=" << ng << std::endl;
         std::exit(EXIT_FAILURE);
       }
     } else if (xorder.compare("ppm4") == 0 ||
                xorder.compare("ppmx") == 0 ||
                xorder.compare("wenoz") == 0) {
       // check that nghost > 2
-      auto &indcs = pmy_pack->pmesh->mb_indcs;
-      if (indcs.ng < 3) {
+      int ng = pbval_u->nghost_same;
+      if (ng < 3) {
         std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
           << std::endl << xorder << " reconstruction requires at least 3 ghost zones, "
-          << "but <mesh>/nghost=" << indcs.ng << std::endl;
+          << "but <hydro>/nghost=" << ng << std::endl;
         std::exit(EXIT_FAILURE);
       }
       // check that nghost > 3 with PPM4(or PPMX or WENOZ)+FOFC
-      if (use_fofc && indcs.ng < 4) {
+      if (use_fofc && ng < 4) {
         std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
           << std::endl << "FOFC and " << xorder << " reconstruction requires at "
-          << "least 4 ghost zones, but <mesh>/nghost=" << indcs.ng << std::endl;
+          << "least 4 ghost zones, but <hydro>/nghost=" << ng << std::endl;
         std::exit(EXIT_FAILURE);
       }
       if (xorder.compare("ppm4") == 0) {
@@ -265,6 +286,139 @@ Hydro::Hydro(MeshBlockPack *ppack, ParameterInput *pin) :
       }
     }
 
+    // determine if interior fluxes are computed while boundary communications are in
+    // flight.  Requires fluxes only depend on active zones, so cannot be used with FOFC.
+    split_fluxes = pin->GetOrAddBoolean("hydro","split_fluxes",false);
+    if (split_fluxes) {
+      auto &indcs = pmy_pack->pmesh->mb_indcs;
+      if (use_fofc || pmy_pack->pcoord->coord_data.bh_excise ||
+          pin->DoesBlockExist("radiation")) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<hydro>/split_fluxes cannot be used with FOFC, "
+                  << "excision, or radiation" << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+      if ((indcs.nx1 < 2*indcs.ng) || (ppack->pmesh->multi_d && indcs.nx2 < 2*indcs.ng)
+          || (ppack->pmesh->three_d && indcs.nx3 < 2*indcs.ng)) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<hydro>/split_fluxes requires MeshBlocks with at "
+                  << "least 2*nghost cells in each direction" << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+    }
+
+    // determine if fluxes are computed from 3D tiles of primitives in scratch memory
+    tiled_fluxes = pin->GetOrAddBoolean("hydro","tiled_fluxes",false);
+    if (tiled_fluxes) {
+      flux_tile_nx2 = pin->GetOrAddInteger("hydro","flux_tile_nx2",4);
+      flux_tile_nx3 = pin->GetOrAddInteger("hydro","flux_tile_nx3",4);
+      if (use_fofc || split_fluxes) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<hydro>/tiled_fluxes cannot be used with FOFC or "
+                  << "split_fluxes" << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+      if (flux_tile_nx2 < 1 || flux_tile_nx3 < 1) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<hydro>/flux_tile_nx2 and flux_tile_nx3 must be "
+                  << "positive" << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+    }
+
+    // determine if fluxes of passive scalars are computed in their own kernels from the
+    // mass flux, reducing scratch memory of the Riemann solver kernels
+    if (nscalars > 0) {
+      separate_scalar_fluxes = pin->GetOrAddBoolean("hydro","separate_scalar_fluxes",
+                                                    false);
+      if (separate_scalar_fluxes && tiled_fluxes) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<hydro>/separate_scalar_fluxes cannot be used with "
+                  << "tiled_fluxes" << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+    }
+
+    // determine if fluxes are computed in the RK update kernels, so they are never
+    // stored in global memory.  Only possible when nothing else needs the face fluxes.
+    fused_update = pin->GetOrAddBoolean("hydro","fused_update",false);
+    if (fused_update) {
+      if (ppack->pmesh->multilevel || use_fofc || split_fluxes || tiled_fluxes ||
+          pmy_pack->pcoord->coord_data.bh_excise || (pvisc != nullptr) ||
+          (pcond != nullptr) || pin->DoesBlockExist("ion-neutral")) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<hydro>/fused_update cannot be used with SMR/AMR, "
+                  << "FOFC, split_fluxes, tiled_fluxes, excision, viscosity, "
+                  << "conduction, or ion-neutral" << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+      // fused kernels do not add source terms, so they are all left to HydroSrcTerms
+      psrc->fsrc = FusedSrcTerms();
+    }
+
+    // determine if the fourth-order finite-volume method is used.  Only implemented for
+    // non-relativistic hydro on uniform meshes with the fourth-order reconstructions.
+    fourth_order = pin->GetOrAddBoolean("hydro","fourth_order",false);
+    if (fourth_order) {
+      if ((recon_method != ReconstructionMethod::ppm4 &&
+           recon_method != ReconstructionMethod::ppmx &&
+           recon_method != ReconstructionMethod::wenoz) || pbval_u->nghost_same < 4) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<hydro>/fourth_order requires ppm4, ppmx, or wenoz "
+                  << "reconstruction and at least 4 ghost zones" << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+      if (ppack->pmesh->multilevel || pmy_pack->pcoord->is_special_relativistic ||
+          pmy_pack->pcoord->is_general_relativistic || use_fofc || split_fluxes ||
+          tiled_fluxes || separate_scalar_fluxes || fused_update ||
+          pin->DoesBlockExist("shearing_box")) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<hydro>/fourth_order cannot be used with SMR/AMR, "
+                  << "SR/GR, FOFC, split_fluxes, tiled_fluxes, separate_scalar_fluxes, "
+                  << "fused_update, or shearing box" << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+    }
+
+    // integrate viscosity and conduction with operator-split super-time-stepping
+    if ((ppack->pmesh->sts_integrator != STSIntegrator::none) &&
+        ((pvisc != nullptr) || (pcond != nullptr))) {
+      sts_diffusion = true;
+      if (pin->DoesBlockExist("shearing_box")) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<time>/sts_integrator cannot be used with shearing "
+                  << "box" << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+    }
+
+    // skip evolution of quiescent MeshBlocks (see hydro_dormant.cpp).  Requires u1 to
+    // hold u0 at the start of the cycle, and no other physics that updates u0.
+    dormant_blocks = pin->GetOrAddBoolean("hydro","dormant_blocks",false);
+    if (dormant_blocks) {
+      dormant_thresh = pin->GetOrAddReal("hydro","dormant_threshold",1.0e-8);
+      dormant_recheck = pin->GetOrAddInteger("hydro","dormant_recheck",16);
+      std::string integrator = pin->GetOrAddString("time","integrator","rk2");
+      if (integrator.compare("rk1") != 0 && integrator.compare("rk2") != 0 &&
+          integrator.compare("rk3") != 0) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<hydro>/dormant_blocks requires integrator = rk1, "
+                  << "rk2, or rk3" << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+      if (split_fluxes || tiled_fluxes || fused_update || fourth_order || fused_newdt ||
+          sts_diffusion || pin->DoesBlockExist("shearing_box") ||
+          pin->DoesBlockExist("mhd") || pin->DoesBlockExist("radiation") ||
+          pin->DoesBlockExist("z4c")) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<hydro>/dormant_blocks cannot be used with "
+                  << "split_fluxes, tiled_fluxes, fused_update, fourth_order, "
+                  << "fused_newdt, STS, shearing box, MHD, radiation, or z4c"
+                  << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+    }
+
     // Final memory allocations
     {
       // allocate second registers, fluxes
@@ -272,17 +426,41 @@ Hydro::Hydro(MeshBlockPack *ppack, ParameterInput *pin) :
       int ncells1 = indcs.nx1 + 2*(indcs.ng);
       int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
       int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
-      Kokkos::realloc(u1,       nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
-      Kokkos::realloc(uflx.x1f, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
-      Kokkos::realloc(uflx.x2f, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
-      Kokkos::realloc(uflx.x3f, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
+      ReallocFirstTouch(u1,       nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
+      if (!(fused_update)) {
+        ReallocFirstTouch(uflx.x1f, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
+        ReallocFirstTouch(uflx.x2f, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
+        ReallocFirstTouch(uflx.x3f, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
+      }
+
+      // allocate flags of dormant MBs
+      if (dormant_blocks) {
+        Kokkos::realloc(dormant, nmb);
+        dormant_age.assign(nmb, 0);
+      }
 
       // allocate array of flags used with FOFC
       if (use_fofc) {
         Kokkos::realloc(fofc,  nmb, ncells3, ncells2, ncells1);
         Kokkos::realloc(utest, nmb, nhydro, ncells3, ncells2, ncells1);
       }
+
+      // allocate face states and fluxes used by the fourth-order method
+      if (fourth_order) {
+        Kokkos::realloc(wl4,  nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
+        Kokkos::realloc(wr4,  nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
+        Kokkos::realloc(flx4, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
+      }
+
+      // allocate registers used with super-time-stepping
+      if (sts_diffusion) {
+        Kokkos::realloc(u2_sts,    nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
+        Kokkos::realloc(dudt0_sts, nmb, (nhydro+nscalars), ncells3, ncells2, ncells1);
+      }
     }
+
+    // choose flux kernel for this combination of Riemann solver, reconstruction, EOS
+    SelectFluxKernel();
   }
 }
 
@@ -32,6 +32,40 @@ enum class Hydro_RSolver {advect, llf, hlle, hllc, roe,    // non-relativistic
                           llf_sr, hlle_sr, hllc_sr,        // SR
                           llf_gr, hlle_gr};                // GR
 
+// constants that enumerate regions of MeshBlocks over which fluxes are computed
+// interior = faces whose stencil only contains active cells, boundary = the rest
+enum class FluxRegion {all, interior, boundary};
+
+//----------------------------------------------------------------------------------------
+//! \struct ScrFluxRow
+//  \brief Wraps a row of fluxes stored in team scratch memory with the same (m,n,k,j,i)
+//  indexing as DvceArray5D, so Riemann solvers can write fluxes directly into scratch
+
+struct ScrFluxRow {
+  ScrArray2D<Real> flx;
+  KOKKOS_INLINE_FUNCTION
+  Real &operator()(const int, const int n, const int, const int, const int i) const {
+    return flx(n,i);
+  }
+};
+
+//----------------------------------------------------------------------------------------
+//! \struct ScrTile
+//  \brief Wraps a 3D tile of cell-centered variables stored in team scratch memory, with
+//  first cell at (ks,js,0), using the same (m,n,k,j,i) indexing as DvceArray5D so it can
+//  be passed to the reconstruction functions
+
+struct ScrTile {
+  ScrArray4D<Real> q;
+  int ks, js;
+  KOKKOS_INLINE_FUNCTION
+  Real &operator()(const int, const int n, const int k, const int j, const int i) const {
+    return q(n,k-ks,j-js,i);
+  }
+  KOKKOS_INLINE_FUNCTION
+  int extent_int(const int r) const {return (r == 0)? 1 : q.extent_int(r-1);}
+};
+
 //----------------------------------------------------------------------------------------
 //! \struct HydroTaskIDs
 //  \brief container to hold TaskIDs of all hydro tasks
@@ -40,6 +74,7 @@ struct HydroTaskIDs {
   TaskID irecv;
   TaskID copyu;
   TaskID flux;
+  TaskID fluxi;
   TaskID sendf;
   TaskID recvf;
   TaskID rkupdt;
@@ -57,6 +92,20 @@ struct HydroTaskIDs {
   TaskID newdt;
   TaskID csend;
   TaskID crecv;
+  TaskID dormant;
+  TaskID sts_irecv;
+  TaskID sts_flux;
+  TaskID sts_sendf;
+  TaskID sts_recvf;
+  TaskID sts_updt;
+  TaskID sts_restu;
+  TaskID sts_sendu;
+  TaskID sts_recvu;
+  TaskID sts_bcs;
+  TaskID sts_prol;
+  TaskID sts_c2p;
+  TaskID sts_csend;
+  TaskID sts_crecv;
 };
 
 namespace hydro {
@@ -98,16 +147,56 @@ class Hydro {
   DvceArray5D<Real> u1;       // conserved variables at intermediate step
   DvceFaceFld5D<Real> uflx;   // fluxes of conserved quantities on cell faces
   Real dtnew;
+  bool fused_newdt = false;   // flag to compute dtnew in C2P kernel of last stage
+  DvceArray1D<Real> dtnew_mb;  // dtnew in each MeshBlock, see <time>/report_level_dt
 
   // following used for FOFC
   DvceArray4D<bool> fofc;  // flag for each cell to indicate if FOFC is needed
   bool use_fofc = false;   // flag to enable FOFC
   DvceArray5D<Real> utest;  // scratch array for FOFC
+  DvceArray1D<int> fofc_list;  // packed indices of cells flagged for FOFC
+
+  // following used to overlap interior fluxes with boundary communications
+  bool split_fluxes = false;          // flag to enable split of flux calculation
+  bool interior_fluxes_done = false;  // true when interior fluxes for next stage ready
+
+  // following used to compute fluxes from 3D tiles of w0 loaded into scratch memory
+  bool tiled_fluxes = false;          // flag to enable tiled flux kernels
+  int flux_tile_nx2, flux_tile_nx3;   // number of active cells in each tile in x2/x3
+
+  // following used to compute fluxes of passive scalars in kernels separate from the
+  // Riemann solver, which then only reconstructs the nhydro fluid variables
+  bool separate_scalar_fluxes = false;
+
+  // following used to compute fluxes and RK update in the same kernels
+  bool fused_update = false;          // flag to enable fused flux-divergence update
+
+  // following used for the fourth-order finite-volume discretization
+  bool fourth_order = false;          // flag to enable fourth-order FV method
+  DvceArray5D<Real> wl4, wr4;         // face-averaged L/R states (C2P scratch)
+  DvceArray5D<Real> flx4;             // fluxes of face-averaged states
+
+  // following used to skip evolution of quiescent MeshBlocks (dormant-block mode)
+  bool dormant_blocks = false;   // flag to enable dormant-block mode
+  Real dormant_thresh;           // max relative change per cycle of quiescent MBs
+  int dormant_recheck;           // max number of cycles a MB stays dormant
+  int ndormant = 0;              // number of dormant MBs in this pack
+  int dormant_version = -1;      // MB neighbor version when dormant flags were set
+  DvceArray1D<int> dormant;      // 1 if MB is not evolved in the current cycle
+  std::vector<int> dormant_age;  // number of consecutive cycles each MB was dormant
+
+  // following used for operator-split super-time-stepping of diffusion terms
+  bool sts_diffusion = false;    // flag to integrate viscosity/conduction with STS
+  DvceArray5D<Real> u2_sts;      // conserved variables at stage j-2 of STS
+  DvceArray5D<Real> dudt0_sts;   // diffusion operator applied to u at start of STS
 
   // container to hold names of TaskIDs
   HydroTaskIDs id;
 
   // functions...
+  // reset reconstruction method and Riemann solver after construction (used by the
+  // kernel_bench test problem generator)
+  void SetFluxMethods(ReconstructionMethod rm, Hydro_RSolver rs);
   void AssembleHydroTasks(std::map<std::string, std::shared_ptr<TaskList>> tl);
   // ...in "before_stagen_tl" list
   TaskStatus InitRecv(Driver *d, int stage);
@@ -122,6 +211,7 @@ class Hydro {
   TaskStatus RecvU_OA(Driver *d, int stage);
   TaskStatus RestrictU(Driver *d, int stage);
   TaskStatus SendU(Driver *d, int stage);
+  TaskStatus InteriorFluxes(Driver *d, int stage);
   TaskStatus RecvU(Driver *d, int stage);
   TaskStatus SendU_Shr(Driver *d, int stage);
   TaskStatus RecvU_Shr(Driver *d, int stage);
@@ -132,16 +222,54 @@ class Hydro {
   // ...in "after_stagen_tl" list
   TaskStatus ClearSend(Driver *d, int stage);
   TaskStatus ClearRecv(Driver *d, int stage);  // also in Driver::Initialize
+  TaskStatus UpdateDormantMBs(Driver *d, int stage);
+  // ...in "before_sts", "sts" and "after_sts" task lists
+  void AssembleSTSTasks(std::map<std::string, std::shared_ptr<TaskList>> tl);
+  TaskStatus InitRecvSTS(Driver *d, int stage);
+  TaskStatus STSFluxes(Driver *d, int stage);
+  TaskStatus STSUpdate(Driver *d, int stage);
+  TaskStatus STSConToPrim(Driver *d, int stage);
+
+  // CalculateFluxes function templated over Riemann Solvers, and (optionally) over
+  // reconstruction method and EOS in specialized kernels
+  template <Hydro_RSolver T, int R=-1, KernelEOS E=KernelEOS::any>
+  void CalculateFluxes(Driver *d, int stage, FluxRegion region=FluxRegion::all);
+  void DispatchFluxes(Driver *d, int stage, FluxRegion region);
+
+  // functions used with dormant-block mode
+  bool DormantMBs();
+  void FreezeDormantMBs();
 
-  // CalculateFluxes function templated over Riemann Solvers
+  // tiled flux calculation, also templated over Riemann Solvers
   template <Hydro_RSolver T>
-  void CalculateFluxes(Driver *d, int stage);
+  void CalculateFluxesTiled(Driver *d, int stage);
+  void DispatchTiledFluxes(Driver *d, int stage);
+
+  // fused flux calculation and RK update, also templated over Riemann Solvers
+  template <Hydro_RSolver T>
+  void FusedFluxesAndUpdate(Driver *d, int stage);
+  void DispatchFusedUpdate(Driver *d, int stage);
+
+  // fourth-order flux calculation, also templated over Riemann Solvers
+  template <Hydro_RSolver T>
+  void CalculateFluxesFourthOrder(Driver *d, int stage);
+  void DispatchFourthOrderFluxes(Driver *d, int stage);
+  void CellAveragedPrimitives();
 
   // first-order flux correction
   void FOFC(Driver *d, int stage);
 
  private:
   MeshBlockPack* pmy_pack;  // ptr to MeshBlockPack containing this Hydro
+
+  // flux kernel chosen once at construction for Riemann solver, reconstruction, and EOS
+  using FluxKernel = void (Hydro::*)(Driver *d, int stage, FluxRegion region);
+  FluxKernel calc_fluxes_ = nullptr;
+  void SelectFluxKernel();
+  template <Hydro_RSolver T>
+  FluxKernel SpecializedFluxKernel();
+  template <Hydro_RSolver T, int R>
+  FluxKernel SpecializedEOSKernel();
 };
 
 } // namespace hydro
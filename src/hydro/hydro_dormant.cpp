@@ -0,0 +1,145 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file hydro_dormant.cpp
+//! \brief Implements dormant-block mode (<hydro>/dormant_blocks = true), in which
+//! quiescent MeshBlocks (e.g. ambient or atmosphere MBs sitting at floor values) are not
+//! evolved.  A MB is quiescent if the maximum relative change of density (and energy)
+//! over the last cycle is below <hydro>/dormant_threshold.  It is dormant in the next
+//! cycle if it and all its neighbors are quiescent, so it wakes up one cycle after any
+//! neighbor becomes active.  Dormant MBs are also evolved every <hydro>/dormant_recheck
+//! cycles to measure their change.  Fluxes, the RK update, and C2P are skipped for
+//! dormant MBs, and u0 is kept at its value at the start of the cycle (u1).
+
+#include <cmath>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "mesh/mesh.hpp"
+#include "driver/driver.hpp"
+#include "eos/eos.hpp"
+#include "hydro.hpp"
+
+namespace hydro {
+//----------------------------------------------------------------------------------------
+//! \fn bool Hydro::DormantMBs()
+//! \brief Returns true if any MB in this pack is dormant in the current cycle.  Flags
+//! are discarded once neighbors are reset (e.g. by AMR), since MBs may have moved.
+
+bool Hydro::DormantMBs() {
+  if (ndormant > 0 && dormant_version != pmy_pack->pmb->nghbr_version) {
+    ndormant = 0;
+  }
+  return (ndormant > 0);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Hydro::FreezeDormantMBs()
+//! \brief Resets u0 in the active cells of dormant MBs to its value at the start of the
+//! cycle (u1), undoing any source terms added to them in this stage.
+
+void Hydro::FreezeDormantMBs() {
+  if (!(DormantMBs())) return;
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, ie = indcs.ie;
+  int js = indcs.js, je = indcs.je;
+  int ks = indcs.ks, ke = indcs.ke;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  int nvar = nhydro + nscalars;
+  auto &dormant_ = dormant;
+  auto &u0_ = u0;
+  auto &u1_ = u1;
+  par_for("h_freeze_dormant",DevExeSpace(),0,nmb1,0,nvar-1,ks,ke,js,je,is,ie,
+  KOKKOS_LAMBDA(const int m, const int n, const int k, const int j, const int i) {
+    if (dormant_(m)) {u0_(m,n,k,j,i) = u1_(m,n,k,j,i);}
+  });
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus Hydro::UpdateDormantMBs()
+//! \brief Task in "after_stagen" list that sets the dormant flags of all MBs for the
+//! next cycle after the last stage, from the change of u0 relative to u1 in each MB.
+//! Quiescent flags of all MBs are gathered on every rank to test neighbors.
+
+TaskStatus Hydro::UpdateDormantMBs(Driver *pdrive, int stage) {
+  if (!(dormant_blocks) || stage != pdrive->nexp_stages) {return TaskStatus::complete;}
+
+  Mesh *pm = pmy_pack->pmesh;
+  auto *pmb = pmy_pack->pmb;
+  int nmb = pmy_pack->nmb_thispack;
+  if (dormant_version != pmb->nghbr_version) {
+    if (dormant.extent_int(0) < nmb) {Kokkos::realloc(dormant, nmb);}
+    Kokkos::deep_copy(dormant, 0);
+    dormant_age.assign(nmb, 0);
+    ndormant = 0;
+    dormant_version = pmb->nghbr_version;
+  }
+
+  // maximum relative change of density (and energy) in each MB over this cycle
+  auto &indcs = pm->mb_indcs;
+  int is = indcs.is, nx1 = indcs.nx1;
+  int js = indcs.js, nx2 = indcs.nx2;
+  int ks = indcs.ks, nx3 = indcs.nx3;
+  const int nkji = nx3*nx2*nx1;
+  const int nji  = nx2*nx1;
+  bool use_e = peos->eos_data.is_ideal;
+  auto &u0_ = u0;
+  auto &u1_ = u1;
+  DvceArray1D<Real> dchange("dchange", nmb);
+  par_for_outer("h_dormant_change",DevExeSpace(),0,0,0,(nmb-1),
+  KOKKOS_LAMBDA(TeamMember_t tmember, const int m) {
+    Real team_max = 0.0;
+    Kokkos::parallel_reduce(Kokkos::TeamThreadRange(tmember, nkji),
+    [=](const int idx, Real &dmax) {
+      int k = (idx)/nji;
+      int j = (idx - k*nji)/nx1;
+      int i = (idx - k*nji - j*nx1) + is;
+      j += js;
+      k += ks;
+      Real dd = fabs(u0_(m,IDN,k,j,i) - u1_(m,IDN,k,j,i))/fabs(u1_(m,IDN,k,j,i));
+      dmax = fmax(dmax, dd);
+      if (use_e) {
+        Real de = fabs(u0_(m,IEN,k,j,i) - u1_(m,IEN,k,j,i));
+        dmax = fmax(dmax, de/fmax(fabs(u1_(m,IEN,k,j,i)), 1.0e-300));
+      }
+    }, Kokkos::Max<Real>(team_max));
+    Kokkos::single(Kokkos::PerTeam(tmember), [&]() {dchange(m) = team_max;});
+  });
+  auto h_dchange = Kokkos::create_mirror_view_and_copy(HostMemSpace(), dchange);
+
+  // quiescent flags of all MBs
+  int gids = pmy_pack->gids;
+  std::vector<int> quiet(pm->nmb_total, 0);
+  for (int m=0; m<nmb; ++m) {
+    quiet[gids + m] = (h_dchange(m) < dormant_thresh)? 1 : 0;
+  }
+#if MPI_PARALLEL_ENABLED
+  MPI_Allgatherv(MPI_IN_PLACE, nmb, MPI_INT, quiet.data(), pm->nmb_eachrank,
+                 pm->gids_eachrank, MPI_INT, global_variable::mpi_comm);
+#endif
+
+  // MBs are dormant in the next cycle if they and all their neighbors are quiescent,
+  // unless they have been dormant for dormant_recheck cycles
+  auto h_dormant = Kokkos::create_mirror_view(dormant);
+  auto &nghbr = pmb->nghbr;
+  ndormant = 0;
+  for (int m=0; m<nmb; ++m) {
+    bool sleep = (quiet[gids + m] == 1);
+    for (int n=0; n<pmb->nnghbr && sleep; ++n) {
+      int gid = nghbr.h_view(m,n).gid;
+      if (gid >= 0 && quiet[gid] == 0) {sleep = false;}
+    }
+    if (sleep && dormant_age[m] >= dormant_recheck) {sleep = false;}
+    dormant_age[m] = (sleep)? (dormant_age[m] + 1) : 0;
+    h_dormant(m) = (sleep)? 1 : 0;
+    if (sleep) {ndormant++;}
+  }
+  Kokkos::deep_copy(dormant, h_dormant);
+  return TaskStatus::complete;
+}
+
+} // namespace hydro
@@ -10,6 +10,7 @@
 
 #include "athena.hpp"
 #include "mesh/mesh.hpp"
+#include "driver/profiler.hpp"
 #include "coordinates/coordinates.hpp"
 #include "hydro.hpp"
 #include "eos/eos.hpp"
@@ -17,6 +18,7 @@
 #include "reconstruct/plm.hpp"
 #include "reconstruct/ppm.hpp"
 #include "reconstruct/wenoz.hpp"
+#include "reconstruct/var_range.hpp"
 #include "hydro/rsolvers/advect_hyd.hpp"
 #include "hydro/rsolvers/llf_hyd.hpp"
 #include "hydro/rsolvers/hlle_hyd.hpp"
@@ -29,37 +31,93 @@
 #include "hydro/rsolvers/hlle_grhyd.hpp"
 
 namespace hydro {
+//----------------------------------------------------------------------------------------
+//! \fn void FluxSegments
+//! \brief Sets segments of loop limits along one direction [segl,segu] that cover the
+//! faces in the requested region.  Faces with FluxRegion::all are [f0,f1], computed with
+//! loop limits [l,u].  The offset is 1 if the lower loop limit only reconstructs (x2/x3).
+
+inline void FluxSegments(FluxRegion region, int l, int u, int f0, int f1, int ng,
+                         int off, int &nseg, int segl[2], int segu[2]) {
+  if (region == FluxRegion::interior) {
+    nseg = 1;
+    segl[0] = f0 + ng - off, segu[0] = f1 - ng;
+  } else if (region == FluxRegion::boundary) {
+    nseg = 2;
+    segl[0] = f0 - off,          segu[0] = f0 + ng - 1;
+    segl[1] = f1 - ng + 1 - off, segu[1] = f1;
+  } else {
+    nseg = 1;
+    segl[0] = l, segu[0] = u;
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn RSolverFlops()
+//! \brief Rough estimate of floating-point operations of Riemann solver per face, used to
+//! declare work of flux kernels to the profiler
+
+constexpr double RSolverFlops(const Hydro_RSolver rs) {
+  return (rs == Hydro_RSolver::advect)? 10.0 :
+         (rs == Hydro_RSolver::llf)? 50.0 :
+         (rs == Hydro_RSolver::hlle)? 70.0 :
+         (rs == Hydro_RSolver::hllc)? 100.0 :
+         (rs == Hydro_RSolver::roe)? 200.0 : 300.0;  // relativistic solvers
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void Hydro::CalculateFluxes
 //! \brief Calls reconstruction and Riemann solver functions to compute hydro fluxes
 //! Note this function is templated over RS for better performance on GPUs.
 
-template <Hydro_RSolver rsolver_method_>
-void Hydro::CalculateFluxes(Driver *pdriver, int stage) {
+template <Hydro_RSolver rsolver_method_, int recon_, KernelEOS eos_kind_>
+void Hydro::CalculateFluxes(Driver *pdriver, int stage, FluxRegion region) {
   RegionIndcs &indcs_ = pmy_pack->pmesh->mb_indcs;
   int is = indcs_.is, ie = indcs_.ie;
   int js = indcs_.js, je = indcs_.je;
   int ks = indcs_.ks, ke = indcs_.ke;
-  int ncells1 = indcs_.nx1 + 2*(indcs_.ng);
+  int ng = indcs_.ng;
+  int ncells1 = indcs_.nx1 + 2*ng;
 
   int &nhyd_  = nhydro;
   int nvars = nhydro + nscalars;
   int nmb1 = pmy_pack->nmb_thispack - 1;
   const auto recon_method_ = recon_method;
-  bool extrema = false;
-  if (recon_method == ReconstructionMethod::ppmx) {
-    extrema = true;
-  }
+
+  // With separate_scalar_fluxes the Riemann solver kernels only reconstruct (and hold in
+  // scratch) the nhydro fluid variables, and the nscal scalars are reconstructed and
+  // upwinded with the mass flux in separate, lighter kernels launched after them.
+  int nrecon = (separate_scalar_fluxes)? nhydro : nvars;
+  int nscal = nvars - nrecon;
 
   auto &eos_ = peos->eos_data;
   auto &size_ = pmy_pack->pmb->mb_size;
   auto &coord_ = pmy_pack->pcoord->coord_data;
-  auto &w0_ = w0;
+  VarRange<DvceArray5D<Real>> w0_(w0, 0, nrecon);
+  VarRange<DvceArray5D<Real>> s0_(w0, nhydro, nscal);
+  // no fluxes are computed in dormant MBs
+  const bool skip_dormant = DormantMBs();
+  auto &dormant_ = dormant;
+
+  // estimated work per face for profiler: w0 read and flux written once
+  const double face_bytes = 2.0*nrecon*sizeof(Real);
+  const double face_flops = nrecon*ReconFlops(recon_method) +
+                            RSolverFlops(rsolver_method_);
+  auto add_work = [&](const char *name, int n3, int n2, int n1) {
+    double nface = static_cast<double>(nmb1 + 1)*n3*n2*n1;
+    AddKernelWork(name, nface*face_bytes, nface*face_flops);
+  };
+  auto add_scalar_work = [&](const char *name, int n3, int n2, int n1) {
+    double nface = static_cast<double>(nmb1 + 1)*n3*n2*n1;
+    AddKernelWork(name, nface*(2.0*nscal + 1.0)*sizeof(Real),
+                  nface*nscal*(ReconFlops(recon_method) + 1.0));
+  };
 
   //--------------------------------------------------------------------------------------
   // i-direction
 
-  size_t scr_size = ScrArray2D<Real>::shmem_size(nvars, ncells1) * 2;
+  size_t scr_size = ScrArray2D<Real>::shmem_size(nrecon, ncells1) * 2;
   int scr_level = 0;
   auto &flx1_ = uflx.x1f;
 
@@ -74,81 +132,138 @@ void Hydro::CalculateFluxes(Driver *pdriver, int stage) {
     }
   }
 
-  par_for_outer("hflux_x1",DevExeSpace(), scr_size, scr_level, 0, nmb1, kl, ku, jl, ju,
-  KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
-    ScrArray2D<Real> wl(member.team_scratch(scr_level), nvars, ncells1);
-    ScrArray2D<Real> wr(member.team_scratch(scr_level), nvars, ncells1);
-
-    // Reconstruct qR[i] and qL[i+1]
-    switch (recon_method_) {
-      case ReconstructionMethod::dc:
-        DonorCellX1(member, m, k, j, il-1, iu, w0_, wl, wr);
-        break;
-      case ReconstructionMethod::plm:
-        PiecewiseLinearX1(member, m, k, j, il-1, iu, w0_, wl, wr);
-        break;
-      case ReconstructionMethod::ppm4:
-      case ReconstructionMethod::ppmx:
-        PiecewiseParabolicX1(member,eos_,extrema,true, m, k, j, il-1, iu, w0_, wl, wr);
-        break;
-      case ReconstructionMethod::wenoz:
-        WENOZX1(member, eos_, true, m, k, j, il-1, iu, w0_, wl, wr);
-        break;
-      default:
-        break;
-    }
-    // Sync all threads in the team so that scratch memory is consistent
-    member.team_barrier();
-
-    // compute fluxes over [is,ie+1]
-    // NOTE(@pdmullen): Capture variables prior to if constexpr.  Required for cuda 11.6+.
-    auto eos = eos_;
-    auto indcs = indcs_;
-    auto size = size_;
-    auto coord = coord_;
-    auto flx1 = flx1_;
-    if constexpr (rsolver_method_ == Hydro_RSolver::advect) {
-      Advect(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
-    } else if constexpr (rsolver_method_ == Hydro_RSolver::llf) {
-      LLF(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
-    } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle) {
-      HLLE(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
-    } else if constexpr (rsolver_method_ == Hydro_RSolver::hllc) {
-      HLLC(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
-    } else if constexpr (rsolver_method_ == Hydro_RSolver::roe) {
-      Roe(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
-    } else if constexpr (rsolver_method_ == Hydro_RSolver::llf_sr) {
-      LLF_SR(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
-    } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle_sr) {
-      HLLE_SR(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
-    } else if constexpr (rsolver_method_ == Hydro_RSolver::hllc_sr) {
-      HLLC_SR(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
-    } else if constexpr (rsolver_method_ == Hydro_RSolver::llf_gr) {
-      LLF_GR(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
-    } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle_gr) {
-      HLLE_GR(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
-    }
-    member.team_barrier();
-
-    // calculate fluxes of scalars (if any)
-    if (nvars > nhyd_) {
-      for (int n=nhyd_; n<nvars; ++n) {
-        par_for_inner(member, is, ie+1, [&](const int i) {
-          if (flx1_(m,IDN,k,j,i) >= 0.0) {
-            flx1_(m,n,k,j,i) = flx1_(m,IDN,k,j,i)*wl(n,i);
-          } else {
-            flx1_(m,n,k,j,i) = flx1_(m,IDN,k,j,i)*wr(n,i);
-          }
-        });
+  // loop over segments of x1-faces in requested region
+  int nseg, segl[2], segu[2];
+  FluxSegments(region, il, iu, is, ie+1, ng, 0, nseg, segl, segu);
+  for (int s=0; s<nseg; ++s) {
+    il = segl[s], iu = segu[s];
+    int fl = (il > is)? il : is, fu = (iu < ie+1)? iu : ie+1;
+    add_work("hflux_x1", (ku - kl + 1), (ju - jl + 1), (fu - fl + 1));
+    par_for_outer("hflux_x1",DevExeSpace(),scr_size,scr_level, 0, nmb1, kl, ku, jl, ju,
+    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+      if (skip_dormant && dormant_(m)) return;
+      // reconstruction method and EOS fixed at compile time in specialized kernels
+      const auto recon = SpecializedRecon<recon_>(recon_method_);
+      const bool extrema = (recon == ReconstructionMethod::ppmx);
+      ScrArray2D<Real> wl(member.team_scratch(scr_level), nrecon, ncells1);
+      ScrArray2D<Real> wr(member.team_scratch(scr_level), nrecon, ncells1);
+
+      // Reconstruct qR[i] and qL[i+1]
+      switch (recon) {
+        case ReconstructionMethod::dc:
+          DonorCellX1(member, m, k, j, il-1, iu, w0_, wl, wr);
+          break;
+        case ReconstructionMethod::plm:
+          PiecewiseLinearX1(member, m, k, j, il-1, iu, w0_, wl, wr);
+          break;
+        case ReconstructionMethod::ppm4:
+        case ReconstructionMethod::ppmx:
+          PiecewiseParabolicX1(member,eos_,extrema,true, m, k, j, il-1, iu, w0_, wl, wr);
+          break;
+        case ReconstructionMethod::wenoz:
+          WENOZX1(member, eos_, true, m, k, j, il-1, iu, w0_, wl, wr);
+          break;
+        default:
+          break;
       }
+      // Sync all threads in the team so that scratch memory is consistent
+      member.team_barrier();
+
+      // compute fluxes over [is,ie+1]
+      // NOTE(@pdmullen): Capture variables prior to if constexpr.
+      // Required for cuda 11.6+.
+      auto eos = SpecializeEOS<eos_kind_>(eos_);
+      auto indcs = indcs_;
+      auto size = size_;
+      auto coord = coord_;
+      auto flx1 = flx1_;
+      if constexpr (rsolver_method_ == Hydro_RSolver::advect) {
+        Advect(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
+      } else if constexpr (rsolver_method_ == Hydro_RSolver::llf) {
+        LLF(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
+      } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle) {
+        HLLE(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
+      } else if constexpr (rsolver_method_ == Hydro_RSolver::hllc) {
+        HLLC(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
+      } else if constexpr (rsolver_method_ == Hydro_RSolver::roe) {
+        Roe(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
+      } else if constexpr (rsolver_method_ == Hydro_RSolver::llf_sr) {
+        LLF_SR(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
+      } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle_sr) {
+        HLLE_SR(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
+      } else if constexpr (rsolver_method_ == Hydro_RSolver::hllc_sr) {
+        HLLC_SR(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
+      } else if constexpr (rsolver_method_ == Hydro_RSolver::llf_gr) {
+        LLF_GR(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
+      } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle_gr) {
+        HLLE_GR(member, eos, indcs, size, coord, m, k, j, il, iu, IVX, wl, wr, flx1);
+      }
+      member.team_barrier();
+
+      // calculate fluxes of scalars (if any)
+      if (nrecon > nhyd_) {
+        for (int n=nhyd_; n<nrecon; ++n) {
+          par_for_inner(member, fl, fu, [&](const int i) {
+            if (flx1_(m,IDN,k,j,i) >= 0.0) {
+              flx1_(m,n,k,j,i) = flx1_(m,IDN,k,j,i)*wl(n,i);
+            } else {
+              flx1_(m,n,k,j,i) = flx1_(m,IDN,k,j,i)*wr(n,i);
+            }
+          });
+        }
+      }
+    });
+    // fluxes of scalars over [fl,fu] computed separately from mass flux
+    if (nscal > 0) {
+      size_t scr_ssize = ScrArray2D<Real>::shmem_size(nscal, ncells1) * 2;
+      add_scalar_work("hflux_x1_scalars", (ku - kl + 1), (ju - jl + 1), (fu - fl + 1));
+      par_for_outer("hflux_x1_scalars", DevExeSpace(), scr_ssize, scr_level, 0, nmb1,
+                    kl, ku, jl, ju,
+      KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+        if (skip_dormant && dormant_(m)) return;
+        const auto recon = SpecializedRecon<recon_>(recon_method_);
+        const bool extrema = (recon == ReconstructionMethod::ppmx);
+        ScrArray2D<Real> sl(member.team_scratch(scr_level), nscal, ncells1);
+        ScrArray2D<Real> sr(member.team_scratch(scr_level), nscal, ncells1);
+
+        // Reconstruct scalars (without floors) in qR[i] and qL[i+1]
+        switch (recon) {
+          case ReconstructionMethod::dc:
+            DonorCellX1(member, m, k, j, il-1, iu, s0_, sl, sr);
+            break;
+          case ReconstructionMethod::plm:
+            PiecewiseLinearX1(member, m, k, j, il-1, iu, s0_, sl, sr);
+            break;
+          case ReconstructionMethod::ppm4:
+          case ReconstructionMethod::ppmx:
+            PiecewiseParabolicX1(member,eos_,extrema,false,m,k,j, il-1, iu, s0_, sl, sr);
+            break;
+          case ReconstructionMethod::wenoz:
+            WENOZX1(member, eos_, false, m, k, j, il-1, iu, s0_, sl, sr);
+            break;
+          default:
+            break;
+        }
+        member.team_barrier();
+
+        for (int n=0; n<nscal; ++n) {
+          par_for_inner(member, fl, fu, [&](const int i) {
+            if (flx1_(m,IDN,k,j,i) >= 0.0) {
+              flx1_(m,nhyd_+n,k,j,i) = flx1_(m,IDN,k,j,i)*sl(n,i);
+            } else {
+              flx1_(m,nhyd_+n,k,j,i) = flx1_(m,IDN,k,j,i)*sr(n,i);
+            }
+          });
+        }
+      });
     }
-  });
+  }
 
   //--------------------------------------------------------------------------------------
   // j-direction
 
   if (pmy_pack->pmesh->multi_d) {
-    scr_size = ScrArray2D<Real>::shmem_size(nvars, ncells1) * 3;
+    scr_size = ScrArray2D<Real>::shmem_size(nrecon, ncells1) * 3;
     auto &flx2_ = uflx.x2f;
 
     // set the loop limits for 1D/2D/3D problems
@@ -162,198 +277,437 @@ void Hydro::CalculateFluxes(Driver *pdriver, int stage) {
       }
     }
 
-    par_for_outer("hflux_x2",DevExeSpace(), scr_size, scr_level, 0, nmb1, kl, ku,
-    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k) {
-      ScrArray2D<Real> scr1(member.team_scratch(scr_level), nvars, ncells1);
-      ScrArray2D<Real> scr2(member.team_scratch(scr_level), nvars, ncells1);
-      ScrArray2D<Real> scr3(member.team_scratch(scr_level), nvars, ncells1);
-
-      for (int j=jl; j<=ju; ++j) {
-        // Permute scratch arrays.
-        auto wl     = scr1;
-        auto wl_jp1 = scr2;
-        auto wr     = scr3;
-        if ((j%2) == 0) {
-          wl     = scr2;
-          wl_jp1 = scr1;
-        }
-
-        // Reconstruct qR[j] and qL[j+1]
-        switch (recon_method_) {
-          case ReconstructionMethod::dc:
-            DonorCellX2(member, m, k, j, il, iu, w0_, wl_jp1, wr);
-            break;
-          case ReconstructionMethod::plm:
-            PiecewiseLinearX2(member, m, k, j, il, iu, w0_, wl_jp1, wr);
-            break;
-          case ReconstructionMethod::ppm4:
-          case ReconstructionMethod::ppmx:
-            PiecewiseParabolicX2(member,eos_,extrema,true,m,k,j,il,iu, w0_, wl_jp1, wr);
-            break;
-          case ReconstructionMethod::wenoz:
-            WENOZX2(member, eos_, true, m, k, j, il, iu, w0_, wl_jp1, wr);
-            break;
-          default:
-            break;
-        }
-        member.team_barrier();
+    // loop over segments of x2-faces in requested region
+    FluxSegments(region, jl, ju, js, je+1, ng, 1, nseg, segl, segu);
+    for (int s=0; s<nseg; ++s) {
+      jl = segl[s], ju = segu[s];
+      add_work("hflux_x2", (ku - kl + 1), (ju - jl), (iu - il + 1));
+      par_for_outer("hflux_x2",DevExeSpace(), scr_size, scr_level, 0, nmb1, kl, ku,
+      KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k) {
+        if (skip_dormant && dormant_(m)) return;
+        // reconstruction method and EOS fixed at compile time in specialized kernels
+        const auto recon = SpecializedRecon<recon_>(recon_method_);
+        const bool extrema = (recon == ReconstructionMethod::ppmx);
+        ScrArray2D<Real> scr1(member.team_scratch(scr_level), nrecon, ncells1);
+        ScrArray2D<Real> scr2(member.team_scratch(scr_level), nrecon, ncells1);
+        ScrArray2D<Real> scr3(member.team_scratch(scr_level), nrecon, ncells1);
+
+        for (int j=jl; j<=ju; ++j) {
+          // Permute scratch arrays.
+          auto wl     = scr1;
+          auto wl_jp1 = scr2;
+          auto wr     = scr3;
+          if ((j%2) == 0) {
+            wl     = scr2;
+            wl_jp1 = scr1;
+          }
 
-        // compute fluxes over [js,je+1].  RS returns flux in input wr array
-        if (j>jl) {
-          // NOTE(@pdmullen): Capture variables prior to if constexpr.
-          auto eos = eos_;
-          auto indcs = indcs_;
-          auto size = size_;
-          auto coord = coord_;
-          auto flx2 = flx2_;
-          if constexpr (rsolver_method_ == Hydro_RSolver::advect) {
-            Advect(member, eos, indcs, size, coord, m, k, j, il, iu, IVY, wl, wr, flx2);
-          } else if constexpr (rsolver_method_ == Hydro_RSolver::llf) {
-            LLF(member, eos, indcs, size, coord, m, k, j, il, iu, IVY, wl, wr, flx2);
-          } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle) {
-            HLLE(member, eos, indcs, size, coord, m, k, j, il, iu, IVY, wl, wr, flx2);
-          } else if constexpr (rsolver_method_ == Hydro_RSolver::hllc) {
-            HLLC(member, eos, indcs, size, coord, m, k, j, il, iu, IVY, wl, wr, flx2);
-          } else if constexpr (rsolver_method_ == Hydro_RSolver::roe) {
-            Roe(member, eos, indcs, size, coord, m, k, j, il, iu, IVY, wl, wr, flx2);
-          } else if constexpr (rsolver_method_ == Hydro_RSolver::llf_sr) {
-            LLF_SR(member, eos, indcs, size, coord, m, k, j, il, iu, IVY, wl, wr, flx2);
-          } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle_sr) {
-            HLLE_SR(member, eos, indcs, size, coord, m, k, j, il, iu, IVY, wl, wr, flx2);
-          } else if constexpr (rsolver_method_ == Hydro_RSolver::hllc_sr) {
-            HLLC_SR(member, eos, indcs, size, coord, m, k, j, il, iu, IVY, wl, wr, flx2);
-          } else if constexpr (rsolver_method_ == Hydro_RSolver::llf_gr) {
-            LLF_GR(member, eos, indcs, size, coord, m, k, j, il, iu, IVY, wl, wr, flx2);
-          } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle_gr) {
-            HLLE_GR(member, eos, indcs, size, coord, m, k, j, il, iu, IVY, wl, wr, flx2);
+          // Reconstruct qR[j] and qL[j+1]
+          switch (recon) {
+            case ReconstructionMethod::dc:
+              DonorCellX2(member, m, k, j, il, iu, w0_, wl_jp1, wr);
+              break;
+            case ReconstructionMethod::plm:
+              PiecewiseLinearX2(member, m, k, j, il, iu, w0_, wl_jp1, wr);
+              break;
+            case ReconstructionMethod::ppm4:
+            case ReconstructionMethod::ppmx:
+              PiecewiseParabolicX2(member,eos_,extrema,true,m,k,j,il,iu, w0_, wl_jp1, wr);
+              break;
+            case ReconstructionMethod::wenoz:
+              WENOZX2(member, eos_, true, m, k, j, il, iu, w0_, wl_jp1, wr);
+              break;
+            default:
+              break;
           }
           member.team_barrier();
-        }
 
-        // calculate fluxes of scalars (if any)
-        if (nvars > nhyd_) {
-          for (int n=nhyd_; n<nvars; ++n) {
-            par_for_inner(member, is, ie, [&](const int i) {
-              if (flx2_(m,IDN,k,j,i) >= 0.0) {
-                flx2_(m,n,k,j,i) = flx2_(m,IDN,k,j,i)*wl(n,i);
-              } else {
-                flx2_(m,n,k,j,i) = flx2_(m,IDN,k,j,i)*wr(n,i);
-              }
-            });
+          // compute fluxes over [js,je+1].  RS returns flux in input wr array
+          if (j>jl) {
+            // NOTE(@pdmullen): Capture variables prior to if constexpr.
+            auto eos = SpecializeEOS<eos_kind_>(eos_);
+            auto indcs = indcs_;
+            auto size = size_;
+            auto coord = coord_;
+            auto flx2 = flx2_;
+            if constexpr (rsolver_method_ == Hydro_RSolver::advect) {
+              Advect(member, eos, indcs, size, coord, m, k, j, il,iu, IVY, wl, wr, flx2);
+            } else if constexpr (rsolver_method_ == Hydro_RSolver::llf) {
+              LLF(member, eos, indcs, size, coord, m, k, j, il,iu, IVY, wl, wr, flx2);
+            } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle) {
+              HLLE(member, eos, indcs, size, coord, m, k, j, il,iu, IVY, wl, wr, flx2);
+            } else if constexpr (rsolver_method_ == Hydro_RSolver::hllc) {
+              HLLC(member, eos, indcs, size, coord, m, k, j, il,iu, IVY, wl, wr, flx2);
+            } else if constexpr (rsolver_method_ == Hydro_RSolver::roe) {
+              Roe(member, eos, indcs, size, coord, m, k, j, il,iu, IVY, wl, wr, flx2);
+            } else if constexpr (rsolver_method_ == Hydro_RSolver::llf_sr) {
+              LLF_SR(member, eos, indcs, size, coord, m, k, j, il,iu, IVY, wl, wr, flx2);
+            } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle_sr) {
+              HLLE_SR(member, eos, indcs, size, coord, m, k, j, il,iu, IVY, wl, wr, flx2);
+            } else if constexpr (rsolver_method_ == Hydro_RSolver::hllc_sr) {
+              HLLC_SR(member, eos, indcs, size, coord, m, k, j, il,iu, IVY, wl, wr, flx2);
+            } else if constexpr (rsolver_method_ == Hydro_RSolver::llf_gr) {
+              LLF_GR(member, eos, indcs, size, coord, m, k, j, il,iu, IVY, wl, wr, flx2);
+            } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle_gr) {
+              HLLE_GR(member, eos, indcs, size, coord, m, k, j, il,iu, IVY, wl, wr, flx2);
+            }
+            member.team_barrier();
           }
-        }
-      } // end of loop over j
-    });
+
+          // calculate fluxes of scalars (if any) over [js,je+1]
+          if ((nrecon > nhyd_) && (j>jl)) {
+            for (int n=nhyd_; n<nrecon; ++n) {
+              par_for_inner(member, is, ie, [&](const int i) {
+                if (flx2_(m,IDN,k,j,i) >= 0.0) {
+                  flx2_(m,n,k,j,i) = flx2_(m,IDN,k,j,i)*wl(n,i);
+                } else {
+                  flx2_(m,n,k,j,i) = flx2_(m,IDN,k,j,i)*wr(n,i);
+                }
+              });
+            }
+          }
+        } // end of loop over j
+      });
+
+      // fluxes of scalars over [js,je+1] computed separately from mass flux
+      if (nscal > 0) {
+        size_t scr_ssize = ScrArray2D<Real>::shmem_size(nscal, ncells1) * 3;
+        add_scalar_work("hflux_x2_scalars", (ku - kl + 1), (ju - jl), (ie - is + 1));
+        par_for_outer("hflux_x2_scalars",DevExeSpace(), scr_ssize, scr_level, 0, nmb1, kl,
+        ku, KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k) {
+          if (skip_dormant && dormant_(m)) return;
+          const auto recon = SpecializedRecon<recon_>(recon_method_);
+          const bool extrema = (recon == ReconstructionMethod::ppmx);
+          ScrArray2D<Real> scr1(member.team_scratch(scr_level), nscal, ncells1);
+          ScrArray2D<Real> scr2(member.team_scratch(scr_level), nscal, ncells1);
+          ScrArray2D<Real> scr3(member.team_scratch(scr_level), nscal, ncells1);
+
+          for (int j=jl; j<=ju; ++j) {
+            // Permute scratch arrays.
+            auto sl     = scr1;
+            auto sl_jp1 = scr2;
+            auto sr     = scr3;
+            if ((j%2) == 0) {
+              sl     = scr2;
+              sl_jp1 = scr1;
+            }
+
+            // Reconstruct scalars (without floors) in qR[j] and qL[j+1]
+            switch (recon) {
+              case ReconstructionMethod::dc:
+                DonorCellX2(member, m, k, j, il, iu, s0_, sl_jp1, sr);
+                break;
+              case ReconstructionMethod::plm:
+                PiecewiseLinearX2(member, m, k, j, il, iu, s0_, sl_jp1, sr);
+                break;
+              case ReconstructionMethod::ppm4:
+              case ReconstructionMethod::ppmx:
+                PiecewiseParabolicX2(member,eos_,extrema,false,m,k,j,il,iu,s0_,sl_jp1,sr);
+                break;
+              case ReconstructionMethod::wenoz:
+                WENOZX2(member, eos_, false, m, k, j, il, iu, s0_, sl_jp1, sr);
+                break;
+              default:
+                break;
+            }
+            member.team_barrier();
+
+            if (j>jl) {
+              for (int n=0; n<nscal; ++n) {
+                par_for_inner(member, is, ie, [&](const int i) {
+                  if (flx2_(m,IDN,k,j,i) >= 0.0) {
+                    flx2_(m,nhyd_+n,k,j,i) = flx2_(m,IDN,k,j,i)*sl(n,i);
+                  } else {
+                    flx2_(m,nhyd_+n,k,j,i) = flx2_(m,IDN,k,j,i)*sr(n,i);
+                  }
+                });
+              }
+            }
+            member.team_barrier();
+          } // end of loop over j
+        });
+      }
+    }
   }
 
   //--------------------------------------------------------------------------------------
   // k-direction. Note order of k,j loops switched
 
   if (pmy_pack->pmesh->three_d) {
-    scr_size = ScrArray2D<Real>::shmem_size(nvars, ncells1) * 3;
+    scr_size = ScrArray2D<Real>::shmem_size(nrecon, ncells1) * 3;
     auto &flx3_ = uflx.x3f;
 
     // set the loop limits
     il = is, iu = ie, jl = js, ju = je, kl = ks-1, ku = ke+1;
     if (use_fofc) { il = is-1, iu = ie+1, jl = js-1, ju = je+1, kl = ks-2, ku = ke+2; }
 
-    par_for_outer("hflux_x3",DevExeSpace(), scr_size, scr_level, 0, nmb1, jl, ju,
-    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int j) {
-      ScrArray2D<Real> scr1(member.team_scratch(scr_level), nvars, ncells1);
-      ScrArray2D<Real> scr2(member.team_scratch(scr_level), nvars, ncells1);
-      ScrArray2D<Real> scr3(member.team_scratch(scr_level), nvars, ncells1);
-
-      for (int k=kl; k<=ku; ++k) {
-        // Permute scratch arrays.
-        auto wl     = scr1;
-        auto wl_kp1 = scr2;
-        auto wr     = scr3;
-        if ((k%2) == 0) {
-          wl     = scr2;
-          wl_kp1 = scr1;
-        }
-
-        // Reconstruct qR[k] and qL[k+1]
-        switch (recon_method_) {
-          case ReconstructionMethod::dc:
-            DonorCellX3(member, m, k, j, il, iu, w0_, wl_kp1, wr);
-            break;
-          case ReconstructionMethod::plm:
-            PiecewiseLinearX3(member, m, k, j, il, iu, w0_, wl_kp1, wr);
-            break;
-          case ReconstructionMethod::ppm4:
-          case ReconstructionMethod::ppmx:
-            PiecewiseParabolicX3(member,eos_,extrema,true,m,k,j,il,iu, w0_, wl_kp1, wr);
-            break;
-          case ReconstructionMethod::wenoz:
-            WENOZX3(member, eos_, true, m, k, j, il, iu, w0_, wl_kp1, wr);
-            break;
-          default:
-            break;
-        }
-        member.team_barrier();
+    // loop over segments of x3-faces in requested region
+    FluxSegments(region, kl, ku, ks, ke+1, ng, 1, nseg, segl, segu);
+    for (int s=0; s<nseg; ++s) {
+      kl = segl[s], ku = segu[s];
+      add_work("hflux_x3", (ku - kl), (ju - jl + 1), (iu - il + 1));
+      par_for_outer("hflux_x3",DevExeSpace(), scr_size, scr_level, 0, nmb1, jl, ju,
+      KOKKOS_LAMBDA(TeamMember_t member, const int m, const int j) {
+        if (skip_dormant && dormant_(m)) return;
+        // reconstruction method and EOS fixed at compile time in specialized kernels
+        const auto recon = SpecializedRecon<recon_>(recon_method_);
+        const bool extrema = (recon == ReconstructionMethod::ppmx);
+        ScrArray2D<Real> scr1(member.team_scratch(scr_level), nrecon, ncells1);
+        ScrArray2D<Real> scr2(member.team_scratch(scr_level), nrecon, ncells1);
+        ScrArray2D<Real> scr3(member.team_scratch(scr_level), nrecon, ncells1);
+
+        for (int k=kl; k<=ku; ++k) {
+          // Permute scratch arrays.
+          auto wl     = scr1;
+          auto wl_kp1 = scr2;
+          auto wr     = scr3;
+          if ((k%2) == 0) {
+            wl     = scr2;
+            wl_kp1 = scr1;
+          }
 
-        // compute fluxes over [ks,ke+1].  RS returns flux in input wr array
-        if (k>kl) {
-          // NOTE(@pdmullen): Capture variables prior to if constexpr.
-          auto eos = eos_;
-          auto indcs = indcs_;
-          auto size = size_;
-          auto coord = coord_;
-          auto flx3 = flx3_;
-          if constexpr (rsolver_method_ == Hydro_RSolver::advect) {
-            Advect(member, eos, indcs, size, coord, m, k, j, il, iu, IVZ, wl, wr, flx3);
-          } else if constexpr (rsolver_method_ == Hydro_RSolver::llf) {
-            LLF(member, eos, indcs, size, coord, m, k, j, il, iu, IVZ, wl, wr, flx3);
-          } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle) {
-            HLLE(member, eos, indcs, size, coord, m, k, j, il, iu, IVZ, wl, wr, flx3);
-          } else if constexpr (rsolver_method_ == Hydro_RSolver::hllc) {
-            HLLC(member, eos, indcs, size, coord, m, k, j, il, iu, IVZ, wl, wr, flx3);
-          } else if constexpr (rsolver_method_ == Hydro_RSolver::roe) {
-            Roe(member, eos, indcs, size, coord, m, k, j, il, iu, IVZ, wl, wr, flx3);
-          } else if constexpr (rsolver_method_ == Hydro_RSolver::llf_sr) {
-            LLF_SR(member, eos, indcs, size, coord, m, k, j, il, iu, IVZ, wl, wr, flx3);
-          } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle_sr) {
-            HLLE_SR(member, eos, indcs, size, coord, m, k, j, il, iu, IVZ, wl, wr, flx3);
-          } else if constexpr (rsolver_method_ == Hydro_RSolver::hllc_sr) {
-            HLLC_SR(member, eos, indcs, size, coord, m, k, j, il, iu, IVZ, wl, wr, flx3);
-          } else if constexpr (rsolver_method_ == Hydro_RSolver::llf_gr) {
-            LLF_GR(member, eos, indcs, size, coord, m, k, j, il, iu, IVZ, wl, wr, flx3);
-          } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle_gr) {
-            HLLE_GR(member, eos, indcs, size, coord, m, k, j, il, iu, IVZ, wl, wr, flx3);
+          // Reconstruct qR[k] and qL[k+1]
+          switch (recon) {
+            case ReconstructionMethod::dc:
+              DonorCellX3(member, m, k, j, il, iu, w0_, wl_kp1, wr);
+              break;
+            case ReconstructionMethod::plm:
+              PiecewiseLinearX3(member, m, k, j, il, iu, w0_, wl_kp1, wr);
+              break;
+            case ReconstructionMethod::ppm4:
+            case ReconstructionMethod::ppmx:
+              PiecewiseParabolicX3(member,eos_,extrema,true,m,k,j,il,iu, w0_, wl_kp1, wr);
+              break;
+            case ReconstructionMethod::wenoz:
+              WENOZX3(member, eos_, true, m, k, j, il, iu, w0_, wl_kp1, wr);
+              break;
+            default:
+              break;
           }
           member.team_barrier();
-        }
 
-        // calculate fluxes of scalars (if any)
-        if (nvars > nhyd_) {
-          for (int n=nhyd_; n<nvars; ++n) {
-            par_for_inner(member, is, ie, [&](const int i) {
-              if (flx3_(m,IDN,k,j,i) >= 0.0) {
-                flx3_(m,n,k,j,i) = flx3_(m,IDN,k,j,i)*wl(n,i);
-              } else {
-                flx3_(m,n,k,j,i) = flx3_(m,IDN,k,j,i)*wr(n,i);
-              }
-            });
+          // compute fluxes over [ks,ke+1].  RS returns flux in input wr array
+          if (k>kl) {
+            // NOTE(@pdmullen): Capture variables prior to if constexpr.
+            auto eos = SpecializeEOS<eos_kind_>(eos_);
+            auto indcs = indcs_;
+            auto size = size_;
+            auto coord = coord_;
+            auto flx3 = flx3_;
+            if constexpr (rsolver_method_ == Hydro_RSolver::advect) {
+              Advect(member, eos, indcs, size, coord, m, k, j, il,iu, IVZ, wl, wr, flx3);
+            } else if constexpr (rsolver_method_ == Hydro_RSolver::llf) {
+              LLF(member, eos, indcs, size, coord, m, k, j, il,iu, IVZ, wl, wr, flx3);
+            } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle) {
+              HLLE(member, eos, indcs, size, coord, m, k, j, il,iu, IVZ, wl, wr, flx3);
+            } else if constexpr (rsolver_method_ == Hydro_RSolver::hllc) {
+              HLLC(member, eos, indcs, size, coord, m, k, j, il,iu, IVZ, wl, wr, flx3);
+            } else if constexpr (rsolver_method_ == Hydro_RSolver::roe) {
+              Roe(member, eos, indcs, size, coord, m, k, j, il,iu, IVZ, wl, wr, flx3);
+            } else if constexpr (rsolver_method_ == Hydro_RSolver::llf_sr) {
+              LLF_SR(member, eos, indcs, size, coord, m, k, j, il,iu, IVZ, wl, wr, flx3);
+            } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle_sr) {
+              HLLE_SR(member, eos, indcs, size, coord, m, k, j, il,iu, IVZ, wl, wr, flx3);
+            } else if constexpr (rsolver_method_ == Hydro_RSolver::hllc_sr) {
+              HLLC_SR(member, eos, indcs, size, coord, m, k, j, il,iu, IVZ, wl, wr, flx3);
+            } else if constexpr (rsolver_method_ == Hydro_RSolver::llf_gr) {
+              LLF_GR(member, eos, indcs, size, coord, m, k, j, il,iu, IVZ, wl, wr, flx3);
+            } else if constexpr (rsolver_method_ == Hydro_RSolver::hlle_gr) {
+              HLLE_GR(member, eos, indcs, size, coord, m, k, j, il,iu, IVZ, wl, wr, flx3);
+            }
+            member.team_barrier();
           }
-        }
-      } // end loop over k
-    });
+
+          // calculate fluxes of scalars (if any) over [ks,ke+1]
+          if ((nrecon > nhyd_) && (k>kl)) {
+            for (int n=nhyd_; n<nrecon; ++n) {
+              par_for_inner(member, is, ie, [&](const int i) {
+                if (flx3_(m,IDN,k,j,i) >= 0.0) {
+                  flx3_(m,n,k,j,i) = flx3_(m,IDN,k,j,i)*wl(n,i);
+                } else {
+                  flx3_(m,n,k,j,i) = flx3_(m,IDN,k,j,i)*wr(n,i);
+                }
+              });
+            }
+          }
+        } // end loop over k
+      });
+
+      // fluxes of scalars over [ks,ke+1] computed separately from mass flux
+      if (nscal > 0) {
+        size_t scr_ssize = ScrArray2D<Real>::shmem_size(nscal, ncells1) * 3;
+        add_scalar_work("hflux_x3_scalars", (ku - kl), (ju - jl + 1), (ie - is + 1));
+        par_for_outer("hflux_x3_scalars",DevExeSpace(), scr_ssize, scr_level, 0, nmb1, jl,
+        ju, KOKKOS_LAMBDA(TeamMember_t member, const int m, const int j) {
+          if (skip_dormant && dormant_(m)) return;
+          const auto recon = SpecializedRecon<recon_>(recon_method_);
+          const bool extrema = (recon == ReconstructionMethod::ppmx);
+          ScrArray2D<Real> scr1(member.team_scratch(scr_level), nscal, ncells1);
+          ScrArray2D<Real> scr2(member.team_scratch(scr_level), nscal, ncells1);
+          ScrArray2D<Real> scr3(member.team_scratch(scr_level), nscal, ncells1);
+
+          for (int k=kl; k<=ku; ++k) {
+            // Permute scratch arrays.
+            auto sl     = scr1;
+            auto sl_kp1 = scr2;
+            auto sr     = scr3;
+            if ((k%2) == 0) {
+              sl     = scr2;
+              sl_kp1 = scr1;
+            }
+
+            // Reconstruct scalars (without floors) in qR[k] and qL[k+1]
+            switch (recon) {
+              case ReconstructionMethod::dc:
+                DonorCellX3(member, m, k, j, il, iu, s0_, sl_kp1, sr);
+                break;
+              case ReconstructionMethod::plm:
+                PiecewiseLinearX3(member, m, k, j, il, iu, s0_, sl_kp1, sr);
+                break;
+              case ReconstructionMethod::ppm4:
+              case ReconstructionMethod::ppmx:
+                PiecewiseParabolicX3(member,eos_,extrema,false,m,k,j,il,iu,s0_,sl_kp1,sr);
+                break;
+              case ReconstructionMethod::wenoz:
+                WENOZX3(member, eos_, false, m, k, j, il, iu, s0_, sl_kp1, sr);
+                break;
+              default:
+                break;
+            }
+            member.team_barrier();
+
+            if (k>kl) {
+              for (int n=0; n<nscal; ++n) {
+                par_for_inner(member, is, ie, [&](const int i) {
+                  if (flx3_(m,IDN,k,j,i) >= 0.0) {
+                    flx3_(m,nhyd_+n,k,j,i) = flx3_(m,IDN,k,j,i)*sl(n,i);
+                  } else {
+                    flx3_(m,nhyd_+n,k,j,i) = flx3_(m,IDN,k,j,i)*sr(n,i);
+                  }
+                });
+              }
+            }
+            member.team_barrier();
+          } // end of loop over k
+        });
+      }
+    }
   }
 
   return;
 }
 
 // function definitions for each template parameter
-template void Hydro::CalculateFluxes<Hydro_RSolver::advect>(Driver *pdriver, int stage);
-template void Hydro::CalculateFluxes<Hydro_RSolver::llf>(Driver *pdriver, int stage);
-template void Hydro::CalculateFluxes<Hydro_RSolver::hlle>(Driver *pdriver, int stage);
-template void Hydro::CalculateFluxes<Hydro_RSolver::hllc>(Driver *pdriver, int stage);
-template void Hydro::CalculateFluxes<Hydro_RSolver::roe>(Driver *pdriver, int stage);
-template void Hydro::CalculateFluxes<Hydro_RSolver::llf_sr>(Driver *pdriver, int stage);
-template void Hydro::CalculateFluxes<Hydro_RSolver::hlle_sr>(Driver *pdriver, int stage);
-template void Hydro::CalculateFluxes<Hydro_RSolver::hllc_sr>(Driver *pdriver, int stage);
-template void Hydro::CalculateFluxes<Hydro_RSolver::llf_gr>(Driver *pdriver, int stage);
-template void Hydro::CalculateFluxes<Hydro_RSolver::hlle_gr>(Driver *pdriver, int stage);
+template void Hydro::CalculateFluxes<Hydro_RSolver::advect>(Driver *pdriver, int stage,
+                                                 FluxRegion region);
+template void Hydro::CalculateFluxes<Hydro_RSolver::llf>(Driver *pdriver, int stage,
+                                                 FluxRegion region);
+template void Hydro::CalculateFluxes<Hydro_RSolver::hlle>(Driver *pdriver, int stage,
+                                                 FluxRegion region);
+template void Hydro::CalculateFluxes<Hydro_RSolver::hllc>(Driver *pdriver, int stage,
+                                                 FluxRegion region);
+template void Hydro::CalculateFluxes<Hydro_RSolver::roe>(Driver *pdriver, int stage,
+                                                 FluxRegion region);
+template void Hydro::CalculateFluxes<Hydro_RSolver::llf_sr>(Driver *pdriver, int stage,
+                                                 FluxRegion region);
+template void Hydro::CalculateFluxes<Hydro_RSolver::hlle_sr>(Driver *pdriver, int stage,
+                                                 FluxRegion region);
+template void Hydro::CalculateFluxes<Hydro_RSolver::hllc_sr>(Driver *pdriver, int stage,
+                                                 FluxRegion region);
+template void Hydro::CalculateFluxes<Hydro_RSolver::llf_gr>(Driver *pdriver, int stage,
+                                                 FluxRegion region);
+template void Hydro::CalculateFluxes<Hydro_RSolver::hlle_gr>(Driver *pdriver, int stage,
+                                                 FluxRegion region);
+
+//----------------------------------------------------------------------------------------
+//! \fn Hydro::FluxKernel Hydro::SpecializedEOSKernel
+//! \brief Returns CalculateFluxes function specialized for reconstruction method R and
+//! the EOS in use if such kernels are compiled (see Athena_SPECIALIZED_RECON), otherwise
+//! the generic function that selects both at runtime.
+
+template <Hydro_RSolver T, int R>
+Hydro::FluxKernel Hydro::SpecializedEOSKernel() {
+  if constexpr (IsSpecializedRecon(R)) {
+    if (peos->eos_data.is_ideal) {
+      return &Hydro::CalculateFluxes<T, R, KernelEOS::ideal>;
+    }
+    // relativistic Riemann solvers are only implemented for an ideal gas
+    if constexpr ((T == Hydro_RSolver::advect) ||
+                  (T == Hydro_RSolver::llf) ||
+                  (T == Hydro_RSolver::hlle) ||
+                  (T == Hydro_RSolver::hllc) ||
+                  (T == Hydro_RSolver::roe)) {
+      return &Hydro::CalculateFluxes<T, R, KernelEOS::isothermal>;
+    }
+  }
+  return &Hydro::CalculateFluxes<T>;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn Hydro::FluxKernel Hydro::SpecializedFluxKernel
+//! \brief Returns CalculateFluxes function for Riemann solver T and the reconstruction
+//! method in use
+
+template <Hydro_RSolver T>
+Hydro::FluxKernel Hydro::SpecializedFluxKernel() {
+  switch (recon_method) {
+    case ReconstructionMethod::dc:
+      return SpecializedEOSKernel<T, ReconstructionMethod::dc>();
+    case ReconstructionMethod::plm:
+      return SpecializedEOSKernel<T, ReconstructionMethod::plm>();
+    case ReconstructionMethod::ppm4:
+      return SpecializedEOSKernel<T, ReconstructionMethod::ppm4>();
+    case ReconstructionMethod::ppmx:
+      return SpecializedEOSKernel<T, ReconstructionMethod::ppmx>();
+    case ReconstructionMethod::wenoz:
+      return SpecializedEOSKernel<T, ReconstructionMethod::wenoz>();
+    default:
+      break;
+  }
+  return &Hydro::CalculateFluxes<T>;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Hydro::SelectFluxKernel
+//! \brief Chooses CalculateFluxes function once at construction, based on rsolver_method,
+//! recon_method, and EOS, so no branches on these are needed when fluxes are computed.
+
+void Hydro::SelectFluxKernel() {
+  if (rsolver_method == Hydro_RSolver::advect) {
+    calc_fluxes_ = SpecializedFluxKernel<Hydro_RSolver::advect>();
+  } else if (rsolver_method == Hydro_RSolver::llf) {
+    calc_fluxes_ = SpecializedFluxKernel<Hydro_RSolver::llf>();
+  } else if (rsolver_method == Hydro_RSolver::hlle) {
+    calc_fluxes_ = SpecializedFluxKernel<Hydro_RSolver::hlle>();
+  } else if (rsolver_method == Hydro_RSolver::hllc) {
+    calc_fluxes_ = SpecializedFluxKernel<Hydro_RSolver::hllc>();
+  } else if (rsolver_method == Hydro_RSolver::roe) {
+    calc_fluxes_ = SpecializedFluxKernel<Hydro_RSolver::roe>();
+  } else if (rsolver_method == Hydro_RSolver::llf_sr) {
+    calc_fluxes_ = SpecializedFluxKernel<Hydro_RSolver::llf_sr>();
+  } else if (rsolver_method == Hydro_RSolver::hlle_sr) {
+    calc_fluxes_ = SpecializedFluxKernel<Hydro_RSolver::hlle_sr>();
+  } else if (rsolver_method == Hydro_RSolver::hllc_sr) {
+    calc_fluxes_ = SpecializedFluxKernel<Hydro_RSolver::hllc_sr>();
+  } else if (rsolver_method == Hydro_RSolver::llf_gr) {
+    calc_fluxes_ = SpecializedFluxKernel<Hydro_RSolver::llf_gr>();
+  } else if (rsolver_method == Hydro_RSolver::hlle_gr) {
+    calc_fluxes_ = SpecializedFluxKernel<Hydro_RSolver::hlle_gr>();
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Hydro::SetFluxMethods
+//! \brief Changes reconstruction method and Riemann solver, and selects the matching
+//! CalculateFluxes function.  No checks are made that the combination is valid for the
+//! EOS and number of ghost zones; these are only made in the constructor.
+
+void Hydro::SetFluxMethods(ReconstructionMethod rm, Hydro_RSolver rs) {
+  recon_method = rm;
+  rsolver_method = rs;
+  SelectFluxKernel();
+  return;
+}
 
 } // namespace hydro
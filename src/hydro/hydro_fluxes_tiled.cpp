@@ -0,0 +1,307 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file hydro_fluxes_tiled.cpp
+//! \brief Calculate 3D fluxes for hydro using tiles of primitive variables held in team
+//! scratch memory.  Enabled with <hydro>/tiled_fluxes = true.
+//!
+//! Each team loads a tile of w0 of size [flux_tile_nx3+2ng, flux_tile_nx2+2ng, ncells1]
+//! (including ghost cells) from global memory once, and then computes the fluxes on all
+//! x1-, x2-, and x3-faces of the active cells in the tile from scratch memory.  This
+//! avoids reloading the same primitives for each pencil in the x2/x3 sweeps, which
+//! matters most for wide reconstruction stencils (ppm4, ppmx, wenoz).  Tile sizes must be
+//! chosen so the tile fits in (level 0) scratch memory of the target device.
+
+#include <iostream>
+
+#include "athena.hpp"
+#include "mesh/mesh.hpp"
+#include "coordinates/coordinates.hpp"
+#include "hydro.hpp"
+#include "eos/eos.hpp"
+#include "reconstruct/dc.hpp"
+#include "reconstruct/plm.hpp"
+#include "reconstruct/ppm.hpp"
+#include "reconstruct/wenoz.hpp"
+#include "hydro/rsolvers/hydro_rsolver.hpp"
+
+namespace hydro {
+//----------------------------------------------------------------------------------------
+//! \fn void Hydro::CalculateFluxesTiled
+//! \brief Calls reconstruction and Riemann solver functions to compute hydro fluxes from
+//! tiles of primitives in scratch memory.  Fluxes are stored in uflx, exactly as with
+//! CalculateFluxes().  Templated over RS for better performance on GPUs.
+
+template <Hydro_RSolver rsolver_method_>
+void Hydro::CalculateFluxesTiled(Driver *pdriver, int stage) {
+  RegionIndcs &indcs_ = pmy_pack->pmesh->mb_indcs;
+  int is = indcs_.is, ie = indcs_.ie;
+  int js = indcs_.js, je = indcs_.je;
+  int ks = indcs_.ks, ke = indcs_.ke;
+  int ng = indcs_.ng;
+  int ncells1 = indcs_.nx1 + 2*ng;
+  bool multi_d = pmy_pack->pmesh->multi_d;
+  bool three_d = pmy_pack->pmesh->three_d;
+
+  int &nhyd_  = nhydro;
+  int nvars = nhydro + nscalars;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  const auto recon_method_ = recon_method;
+  bool extrema = false;
+  if (recon_method == ReconstructionMethod::ppmx) {
+    extrema = true;
+  }
+
+  // number of active cells in each tile, and number of ghost cells stored in tile
+  int ntj = (multi_d)? flux_tile_nx2 : 1;
+  int ntk = (three_d)? flux_tile_nx3 : 1;
+  int ngj = (multi_d)? ng : 0;
+  int ngk = (three_d)? ng : 0;
+  int nt2 = (indcs_.nx2 + ntj - 1)/ntj;
+  int nt3 = (indcs_.nx3 + ntk - 1)/ntk;
+  int ntile2 = ntj + 2*ngj;
+  int ntile3 = ntk + 2*ngk;
+
+  auto &eos_ = peos->eos_data;
+  auto &size_ = pmy_pack->pmb->mb_size;
+  auto &coord_ = pmy_pack->pcoord->coord_data;
+  auto &w0_ = w0;
+  auto &flx1_ = uflx.x1f;
+  auto &flx2_ = uflx.x2f;
+  auto &flx3_ = uflx.x3f;
+
+  size_t scr_size = ScrArray4D<Real>::shmem_size(nvars, ntile3, ntile2, ncells1) +
+                    ScrArray2D<Real>::shmem_size(nvars, ncells1) * 3;
+  int scr_level = 0;
+  par_for_outer("hflux_tiled",DevExeSpace(),scr_size,scr_level,0,nmb1,0,nt3-1,0,nt2-1,
+  KOKKOS_LAMBDA(TeamMember_t member, const int m, const int tk, const int tj) {
+    // active cells in this tile, and faces in x2/x3 owned by this tile
+    const int k0 = ks + tk*ntk, k1 = (k0 + ntk - 1 < ke)? k0 + ntk - 1 : ke;
+    const int j0 = js + tj*ntj, j1 = (j0 + ntj - 1 < je)? j0 + ntj - 1 : je;
+    const int kfu = (k1 == ke)? ke+1 : k1;
+    const int jfu = (j1 == je)? je+1 : j1;
+
+    ScrTile q{ScrArray4D<Real>(member.team_scratch(scr_level), nvars, ntile3, ntile2,
+                               ncells1), k0-ngk, j0-ngj};
+    ScrArray2D<Real> scr1(member.team_scratch(scr_level), nvars, ncells1);
+    ScrArray2D<Real> scr2(member.team_scratch(scr_level), nvars, ncells1);
+    ScrArray2D<Real> scr3(member.team_scratch(scr_level), nvars, ncells1);
+
+    // load tile of primitives (including ghost cells) into scratch memory
+    const int nk = (k1 - k0 + 1) + 2*ngk, nj = (j1 - j0 + 1) + 2*ngj;
+    const int nkji = nk*nj*ncells1;
+    for (int n=0; n<nvars; ++n) {
+      par_for_inner(member, 0, nkji-1, [&](const int idx) {
+        int kk = idx/(nj*ncells1);
+        int jj = (idx - kk*nj*ncells1)/ncells1;
+        int i  = idx - kk*nj*ncells1 - jj*ncells1;
+        q.q(n,kk,jj,i) = w0_(m,n,q.ks+kk,q.js+jj,i);
+      });
+    }
+    member.team_barrier();
+
+    // NOTE(@pdmullen): Capture variables prior to if constexpr.
+    auto eos = eos_;
+    auto indcs = indcs_;
+    auto size = size_;
+    auto coord = coord_;
+
+    //------------------------------------------------------------------------------------
+    // i-direction
+
+    for (int k=k0; k<=k1; ++k) {
+      for (int j=j0; j<=j1; ++j) {
+        auto &wl = scr1;
+        auto &wr = scr2;
+        // Reconstruct qR[i] and qL[i+1]
+        switch (recon_method_) {
+          case ReconstructionMethod::dc:
+            DonorCellX1(member, m, k, j, is-1, ie+1, q, wl, wr);
+            break;
+          case ReconstructionMethod::plm:
+            PiecewiseLinearX1(member, m, k, j, is-1, ie+1, q, wl, wr);
+            break;
+          case ReconstructionMethod::ppm4:
+          case ReconstructionMethod::ppmx:
+            PiecewiseParabolicX1(member,eos_,extrema,true, m, k, j, is-1, ie+1, q, wl,wr);
+            break;
+          case ReconstructionMethod::wenoz:
+            WENOZX1(member, eos_, true, m, k, j, is-1, ie+1, q, wl, wr);
+            break;
+          default:
+            break;
+        }
+        member.team_barrier();
+
+        // compute fluxes over [is,ie+1]
+        auto flx1 = flx1_;
+        RiemannSolver<rsolver_method_>(member, eos, indcs, size, coord, m, k, j, is, ie+1,
+                                       IVX, wl, wr, flx1);
+        member.team_barrier();
+
+        // calculate fluxes of scalars (if any)
+        for (int n=nhyd_; n<nvars; ++n) {
+          par_for_inner(member, is, ie+1, [&](const int i) {
+            if (flx1_(m,IDN,k,j,i) >= 0.0) {
+              flx1_(m,n,k,j,i) = flx1_(m,IDN,k,j,i)*wl(n,i);
+            } else {
+              flx1_(m,n,k,j,i) = flx1_(m,IDN,k,j,i)*wr(n,i);
+            }
+          });
+        }
+        member.team_barrier();
+      }
+    }
+
+    //------------------------------------------------------------------------------------
+    // j-direction
+
+    if (multi_d) {
+      for (int k=k0; k<=k1; ++k) {
+        for (int j=j0-1; j<=jfu; ++j) {
+          // Permute scratch arrays.
+          auto wl     = scr1;
+          auto wl_jp1 = scr2;
+          auto wr     = scr3;
+          if ((j%2) == 0) {
+            wl     = scr2;
+            wl_jp1 = scr1;
+          }
+
+          // Reconstruct qR[j] and qL[j+1]
+          switch (recon_method_) {
+            case ReconstructionMethod::dc:
+              DonorCellX2(member, m, k, j, is, ie, q, wl_jp1, wr);
+              break;
+            case ReconstructionMethod::plm:
+              PiecewiseLinearX2(member, m, k, j, is, ie, q, wl_jp1, wr);
+              break;
+            case ReconstructionMethod::ppm4:
+            case ReconstructionMethod::ppmx:
+              PiecewiseParabolicX2(member,eos_,extrema,true,m,k,j,is,ie, q, wl_jp1, wr);
+              break;
+            case ReconstructionMethod::wenoz:
+              WENOZX2(member, eos_, true, m, k, j, is, ie, q, wl_jp1, wr);
+              break;
+            default:
+              break;
+          }
+          member.team_barrier();
+
+          // compute fluxes over [j0,jfu]
+          if (j>=j0) {
+            auto flx2 = flx2_;
+            RiemannSolver<rsolver_method_>(member, eos, indcs, size, coord, m, k, j,
+                                           is, ie, IVY, wl, wr, flx2);
+            member.team_barrier();
+
+            // calculate fluxes of scalars (if any)
+            for (int n=nhyd_; n<nvars; ++n) {
+              par_for_inner(member, is, ie, [&](const int i) {
+                if (flx2_(m,IDN,k,j,i) >= 0.0) {
+                  flx2_(m,n,k,j,i) = flx2_(m,IDN,k,j,i)*wl(n,i);
+                } else {
+                  flx2_(m,n,k,j,i) = flx2_(m,IDN,k,j,i)*wr(n,i);
+                }
+              });
+            }
+            member.team_barrier();
+          }
+        } // end of loop over j
+      }
+    }
+
+    //------------------------------------------------------------------------------------
+    // k-direction. Note order of k,j loops switched
+
+    if (three_d) {
+      for (int j=j0; j<=j1; ++j) {
+        for (int k=k0-1; k<=kfu; ++k) {
+          // Permute scratch arrays.
+          auto wl     = scr1;
+          auto wl_kp1 = scr2;
+          auto wr     = scr3;
+          if ((k%2) == 0) {
+            wl     = scr2;
+            wl_kp1 = scr1;
+          }
+
+          // Reconstruct qR[k] and qL[k+1]
+          switch (recon_method_) {
+            case ReconstructionMethod::dc:
+              DonorCellX3(member, m, k, j, is, ie, q, wl_kp1, wr);
+              break;
+            case ReconstructionMethod::plm:
+              PiecewiseLinearX3(member, m, k, j, is, ie, q, wl_kp1, wr);
+              break;
+            case ReconstructionMethod::ppm4:
+            case ReconstructionMethod::ppmx:
+              PiecewiseParabolicX3(member,eos_,extrema,true,m,k,j,is,ie, q, wl_kp1, wr);
+              break;
+            case ReconstructionMethod::wenoz:
+              WENOZX3(member, eos_, true, m, k, j, is, ie, q, wl_kp1, wr);
+              break;
+            default:
+              break;
+          }
+          member.team_barrier();
+
+          // compute fluxes over [k0,kfu]
+          if (k>=k0) {
+            auto flx3 = flx3_;
+            RiemannSolver<rsolver_method_>(member, eos, indcs, size, coord, m, k, j,
+                                           is, ie, IVZ, wl, wr, flx3);
+            member.team_barrier();
+
+            // calculate fluxes of scalars (if any)
+            for (int n=nhyd_; n<nvars; ++n) {
+              par_for_inner(member, is, ie, [&](const int i) {
+                if (flx3_(m,IDN,k,j,i) >= 0.0) {
+                  flx3_(m,n,k,j,i) = flx3_(m,IDN,k,j,i)*wl(n,i);
+                } else {
+                  flx3_(m,n,k,j,i) = flx3_(m,IDN,k,j,i)*wr(n,i);
+                }
+              });
+            }
+            member.team_barrier();
+          }
+        } // end of loop over k
+      }
+    }
+  });
+
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Hydro::DispatchTiledFluxes
+//! \brief Selects which CalculateFluxesTiled function to call based on rsolver_method
+
+void Hydro::DispatchTiledFluxes(Driver *pdrive, int stage) {
+  if (rsolver_method == Hydro_RSolver::advect) {
+    CalculateFluxesTiled<Hydro_RSolver::advect>(pdrive, stage);
+  } else if (rsolver_method == Hydro_RSolver::llf) {
+    CalculateFluxesTiled<Hydro_RSolver::llf>(pdrive, stage);
+  } else if (rsolver_method == Hydro_RSolver::hlle) {
+    CalculateFluxesTiled<Hydro_RSolver::hlle>(pdrive, stage);
+  } else if (rsolver_method == Hydro_RSolver::hllc) {
+    CalculateFluxesTiled<Hydro_RSolver::hllc>(pdrive, stage);
+  } else if (rsolver_method == Hydro_RSolver::roe) {
+    CalculateFluxesTiled<Hydro_RSolver::roe>(pdrive, stage);
+  } else if (rsolver_method == Hydro_RSolver::llf_sr) {
+    CalculateFluxesTiled<Hydro_RSolver::llf_sr>(pdrive, stage);
+  } else if (rsolver_method == Hydro_RSolver::hlle_sr) {
+    CalculateFluxesTiled<Hydro_RSolver::hlle_sr>(pdrive, stage);
+  } else if (rsolver_method == Hydro_RSolver::hllc_sr) {
+    CalculateFluxesTiled<Hydro_RSolver::hllc_sr>(pdrive, stage);
+  } else if (rsolver_method == Hydro_RSolver::llf_gr) {
+    CalculateFluxesTiled<Hydro_RSolver::llf_gr>(pdrive, stage);
+  } else if (rsolver_method == Hydro_RSolver::hlle_gr) {
+    CalculateFluxesTiled<Hydro_RSolver::hlle_gr>(pdrive, stage);
+  }
+  return;
+}
+
+} // namespace hydro
@@ -13,6 +13,7 @@
 #include "coordinates/cartesian_ks.hpp"
 #include "coordinates/cell_locations.hpp"
 #include "eos/eos.hpp"
+#include "utils/cell_list.hpp"
 #include "hydro/rsolvers/llf_hyd_singlestate.hpp"
 #include "hydro.hpp"
 
@@ -97,10 +98,21 @@ void Hydro::FOFC(Driver *pdriver, int stage) {
   if (multi_d) { jl = js-1, ju = je+1; }
   if (three_d) { kl = ks-1, ku = ke+1; }
 
+  // Compact indices of cells flagged for FOFC and/or about the excision into a list, so
+  // that the kernel below is only launched over flagged cells
+  CellRange range{nmb, kl, ku, jl, ju, il, iu};
+  int nflag = FlaggedCellList(range, use_fofc, fofc, (is_gr && use_excise),
+                              excision_flux_, fofc_list);
+  if (nflag == 0) return;
+  auto &fofc_list_ = fofc_list;
+
   // Now replace fluxes with first-order LLF fluxes for any cell where floors needed (if
   // using FOFC) and/or for any cell about the excision (if GR+excising)
-  par_for("FOFC-flx", DevExeSpace(), 0, nmb-1, kl, ku, jl, ju, il, iu,
-  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+  par_for("FOFC-flx", DevExeSpace(), 0, nflag-1,
+  KOKKOS_LAMBDA(const int idx) {
+    int m, k, j, i;
+    range.Unpack(fofc_list_(idx), m, k, j, i);
+
     // Check for FOFC flag
     bool fofc_flag = false;
     if (use_fofc_) { fofc_flag = fofc_(m,k,j,i); }
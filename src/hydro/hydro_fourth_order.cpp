@@ -0,0 +1,316 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file hydro_fourth_order.cpp
+//! \brief Fourth-order finite-volume discretization of non-relativistic hydrodynamics,
+//! following McCorquodale & Colella (2011) and Felker & Stone (2018).  Enabled with
+//! <hydro>/fourth_order = true.
+//!
+//! Cell-averaged primitives are computed from cell-averaged conserved variables by
+//! converting to and from cell-centered point values with Laplacian corrections.  The
+//! face-averaged L/R states from ppm4/ppmx/wenoz reconstruction are converted to
+//! face-centered point values with transverse Laplacians, and the face-averaged flux is
+//! the flux of those point values plus the transverse Laplacian of the flux of the face-
+//! averaged states (one extra Riemann solve per face).  Where a correction would make the
+//! density or internal energy non-positive, the second-order value is kept.
+//!
+//! Face states and the fluxes of the face-averaged states are stored in global arrays
+//! (wl4, wr4, flx4), since the transverse Laplacians need them on neighboring rows.
+
+#include <iostream>
+
+#include "athena.hpp"
+#include "mesh/mesh.hpp"
+#include "coordinates/coordinates.hpp"
+#include "hydro.hpp"
+#include "eos/eos.hpp"
+#include "reconstruct/ppm.hpp"
+#include "reconstruct/wenoz.hpp"
+#include "hydro/rsolvers/hydro_rsolver.hpp"
+
+namespace hydro {
+namespace {
+//----------------------------------------------------------------------------------------
+//! \fn Real Laplacian4()
+//! \brief Undivided Laplacian of a(m,n,k,j,i) in all directions of the mesh except dir
+//! (dir=0 for the full Laplacian of a cell-centered array, dir=1,2,3 for the transverse
+//! Laplacian of an array on faces normal to x1,x2,x3).
+
+KOKKOS_INLINE_FUNCTION
+Real Laplacian4(const DvceArray5D<Real> &a, const int m, const int n, const int k,
+                const int j, const int i, const int dir, const bool multi_d,
+                const bool three_d) {
+  Real lap = 0.0;
+  if (dir != 1) {
+    lap += a(m,n,k,j,i+1) - 2.0*a(m,n,k,j,i) + a(m,n,k,j,i-1);
+  }
+  if (dir != 2 && multi_d) {
+    lap += a(m,n,k,j+1,i) - 2.0*a(m,n,k,j,i) + a(m,n,k,j-1,i);
+  }
+  if (dir != 3 && three_d) {
+    lap += a(m,n,k+1,j,i) - 2.0*a(m,n,k,j,i) + a(m,n,k-1,j,i);
+  }
+  return lap;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool Admissible4()
+//! \brief True if density of state w(n) is above the floor, and internal energy (or
+//! temperature) is positive for an ideal gas
+
+template <typename State>
+KOKKOS_INLINE_FUNCTION
+bool Admissible4(const EOS_Data &eos, const State &w) {
+  return (w(IDN) > eos.dfloor) && (!(eos.is_ideal) || (w(IEN) > 0.0));
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn void Hydro::CellAveragedPrimitives
+//! \brief Replaces the (second-order) primitives w0 = W(<U>) computed from cell-averaged
+//! conserved variables with fourth-order cell averages <W> = W(U_cc) + Lap(W(<U>))/24,
+//! where U_cc = <U> - Lap(<U>)/24 are cell-centered conserved variables.  Results are
+//! valid in all but the outermost layer of ghost cells.
+
+void Hydro::CellAveragedPrimitives() {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int &ng = indcs.ng;
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+  int il = 1, iu = indcs.nx1 + 2*ng - 2;
+  int jl = (multi_d)? 1 : 0, ju = (multi_d)? (indcs.nx2 + 2*ng - 2) : 0;
+  int kl = (three_d)? 1 : 0, ku = (three_d)? (indcs.nx3 + 2*ng - 2) : 0;
+  int nvars = nhydro + nscalars;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  auto &eos = peos->eos_data;
+  auto &u0_ = u0;
+  auto &w0_ = w0;
+  // face state arrays are not in use during C2P, and hold U_cc and W(U_cc)
+  auto &ucc = wl4;
+  auto &wcc = wr4;
+  const Real c24 = 1.0/24.0;
+
+  par_for("hc2p4_ucc", DevExeSpace(), 0, nmb1, 0, nvars-1, kl, ku, jl, ju, il, iu,
+  KOKKOS_LAMBDA(const int m, const int n, const int k, const int j, const int i) {
+    ucc(m,n,k,j,i) = u0_(m,n,k,j,i) - c24*Laplacian4(u0_,m,n,k,j,i,0,multi_d,three_d);
+  });
+
+  peos->ConsToPrim(ucc, wcc, false, il, iu, jl, ju, kl, ku);
+
+  par_for("hc2p4_wavg", DevExeSpace(), 0, nmb1, 0, nvars-1, kl, ku, jl, ju, il, iu,
+  KOKKOS_LAMBDA(const int m, const int n, const int k, const int j, const int i) {
+    wcc(m,n,k,j,i) += c24*Laplacian4(w0_,m,n,k,j,i,0,multi_d,three_d);
+  });
+
+  par_for("hc2p4_copy", DevExeSpace(), 0, nmb1, kl, ku, jl, ju, il, iu,
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    if (Admissible4(eos, [&](const int n) {return wcc(m,n,k,j,i);})) {
+      for (int n=0; n<nvars; ++n) {
+        w0_(m,n,k,j,i) = wcc(m,n,k,j,i);
+      }
+    }
+  });
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Hydro::CalculateFluxesFourthOrder
+//! \brief Computes fourth-order face-averaged fluxes of conserved variables, stored in
+//! uflx.  Templated over RS for better performance on GPUs.
+
+template <Hydro_RSolver rsolver_method_>
+void Hydro::CalculateFluxesFourthOrder(Driver *pdriver, int stage) {
+  RegionIndcs &indcs_ = pmy_pack->pmesh->mb_indcs;
+  int is = indcs_.is, ie = indcs_.ie;
+  int js = indcs_.js, je = indcs_.je;
+  int ks = indcs_.ks, ke = indcs_.ke;
+  int ncells1 = indcs_.nx1 + 2*(indcs_.ng);
+  bool multi_d = pmy_pack->pmesh->multi_d;
+  bool three_d = pmy_pack->pmesh->three_d;
+
+  int &nhyd_  = nhydro;
+  int nvars = nhydro + nscalars;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  const auto recon_method_ = recon_method;
+
+  auto &eos_ = peos->eos_data;
+  auto &size_ = pmy_pack->pmb->mb_size;
+  auto &coord_ = pmy_pack->pcoord->coord_data;
+  auto &w0_ = w0;
+  auto &wl4_ = wl4;
+  auto &wr4_ = wr4;
+  auto &flx4_ = flx4;
+  const Real c24 = 1.0/24.0;
+  const Real efloor = (eos_.is_ideal)? eos_.pfloor/(eos_.gamma - 1.0) : 0.0;
+
+  size_t scr_size = ScrArray2D<Real>::shmem_size(nvars, ncells1) * 2;
+  int scr_level = 0;
+
+  for (int dir=1; dir<=3; ++dir) {
+    if ((dir == 2 && !(multi_d)) || (dir == 3 && !(three_d))) break;
+    const int di = (dir == 1)? 1 : 0;
+    const int dj = (dir == 2)? 1 : 0;
+    const int dk = (dir == 3)? 1 : 0;
+    const int ivx = (dir == 1)? IVX : ((dir == 2)? IVY : IVZ);
+    DvceArray5D<Real> flx_ = (dir == 1)? uflx.x1f : ((dir == 2)? uflx.x2f : uflx.x3f);
+
+    // active faces normal to dir
+    const int il = is, iu = ie + di;
+    const int jl = js, ju = je + dj;
+    const int kl = ks, ku = ke + dk;
+    // active faces plus one layer in each transverse direction
+    const int ilt = il - (1 - di);
+    const int iut = iu + (1 - di);
+    const int jlt = (multi_d)? jl - (1 - dj) : jl;
+    const int jut = (multi_d)? ju + (1 - dj) : ju;
+    const int klt = (three_d)? kl - (1 - dk) : kl;
+    const int kut = (three_d)? ku + (1 - dk) : ku;
+
+    // reconstruct face-averaged L/R states; cell c gives L state on face c+1 and R state
+    // on face c in direction dir
+    par_for("hflux4_recon", DevExeSpace(), 0, nmb1, 0, nvars-1, klt-dk, kut, jlt-dj, jut,
+            ilt-di, iut,
+    KOKKOS_LAMBDA(const int m, const int n, const int k, const int j, const int i) {
+      const Real &qim2 = w0_(m,n,k-2*dk,j-2*dj,i-2*di);
+      const Real &qim1 = w0_(m,n,k-dk,j-dj,i-di);
+      const Real &qi   = w0_(m,n,k,j,i);
+      const Real &qip1 = w0_(m,n,k+dk,j+dj,i+di);
+      const Real &qip2 = w0_(m,n,k+2*dk,j+2*dj,i+2*di);
+      Real &ql = wl4_(m,n,k+dk,j+dj,i+di);
+      Real &qr = wr4_(m,n,k,j,i);
+      switch (recon_method_) {
+        case ReconstructionMethod::ppm4:
+          PPM4(qim2, qim1, qi, qip1, qip2, ql, qr);
+          break;
+        case ReconstructionMethod::ppmx:
+          PPMX(qim2, qim1, qi, qip1, qip2, ql, qr);
+          break;
+        case ReconstructionMethod::wenoz:
+          WENOZ(qim2, qim1, qi, qip1, qip2, ql, qr);
+          break;
+        default:
+          break;
+      }
+      if (n == IDN) {
+        ql = fmax(ql, eos_.dfloor);
+        qr = fmax(qr, eos_.dfloor);
+      }
+      if (n == IEN && eos_.is_ideal) {
+        ql = fmax(ql, efloor);
+        qr = fmax(qr, efloor);
+      }
+    });
+
+    // fluxes of face-averaged states, only needed for transverse Laplacian (multi-D)
+    if (multi_d) {
+      par_for_outer("hflux4_avg", DevExeSpace(), scr_size, scr_level, 0, nmb1, klt, kut,
+                    jlt, jut,
+      KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+        ScrArray2D<Real> wl(member.team_scratch(scr_level), nvars, ncells1);
+        ScrArray2D<Real> wr(member.team_scratch(scr_level), nvars, ncells1);
+        for (int n=0; n<nvars; ++n) {
+          par_for_inner(member, ilt, iut, [&](const int i) {
+            wl(n,i) = wl4_(m,n,k,j,i);
+            wr(n,i) = wr4_(m,n,k,j,i);
+          });
+        }
+        member.team_barrier();
+
+        // NOTE(@pdmullen): Capture variables prior to if constexpr.
+        auto eos = eos_;
+        auto indcs = indcs_;
+        auto size = size_;
+        auto coord = coord_;
+        auto flx = flx4_;
+        RiemannSolver<rsolver_method_>(member, eos, indcs, size, coord, m, k, j, ilt, iut,
+                                       ivx, wl, wr, flx);
+        member.team_barrier();
+
+        for (int n=nhyd_; n<nvars; ++n) {
+          par_for_inner(member, ilt, iut, [&](const int i) {
+            if (flx4_(m,IDN,k,j,i) >= 0.0) {
+              flx4_(m,n,k,j,i) = flx4_(m,IDN,k,j,i)*wl(n,i);
+            } else {
+              flx4_(m,n,k,j,i) = flx4_(m,IDN,k,j,i)*wr(n,i);
+            }
+          });
+        }
+      });
+    }
+
+    // fluxes of face-centered states, plus transverse Laplacian of fluxes above
+    par_for_outer("hflux4_pnt", DevExeSpace(), scr_size, scr_level, 0, nmb1, kl, ku,
+                  jl, ju,
+    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+      ScrArray2D<Real> wl(member.team_scratch(scr_level), nvars, ncells1);
+      ScrArray2D<Real> wr(member.team_scratch(scr_level), nvars, ncells1);
+      par_for_inner(member, il, iu, [&](const int i) {
+        for (int n=0; n<nvars; ++n) {
+          wl(n,i) = wl4_(m,n,k,j,i) - c24*Laplacian4(wl4_,m,n,k,j,i,dir,multi_d,three_d);
+          wr(n,i) = wr4_(m,n,k,j,i) - c24*Laplacian4(wr4_,m,n,k,j,i,dir,multi_d,three_d);
+        }
+        if (!(Admissible4(eos_, [&](const int n) {return wl(n,i);}))) {
+          for (int n=0; n<nvars; ++n) {wl(n,i) = wl4_(m,n,k,j,i);}
+        }
+        if (!(Admissible4(eos_, [&](const int n) {return wr(n,i);}))) {
+          for (int n=0; n<nvars; ++n) {wr(n,i) = wr4_(m,n,k,j,i);}
+        }
+      });
+      member.team_barrier();
+
+      // NOTE(@pdmullen): Capture variables prior to if constexpr.
+      auto eos = eos_;
+      auto indcs = indcs_;
+      auto size = size_;
+      auto coord = coord_;
+      auto flx = flx_;
+      RiemannSolver<rsolver_method_>(member, eos, indcs, size, coord, m, k, j, il, iu,
+                                     ivx, wl, wr, flx);
+      member.team_barrier();
+
+      for (int n=nhyd_; n<nvars; ++n) {
+        par_for_inner(member, il, iu, [&](const int i) {
+          if (flx_(m,IDN,k,j,i) >= 0.0) {
+            flx_(m,n,k,j,i) = flx_(m,IDN,k,j,i)*wl(n,i);
+          } else {
+            flx_(m,n,k,j,i) = flx_(m,IDN,k,j,i)*wr(n,i);
+          }
+        });
+      }
+      member.team_barrier();
+
+      if (multi_d) {
+        for (int n=0; n<nvars; ++n) {
+          par_for_inner(member, il, iu, [&](const int i) {
+            flx_(m,n,k,j,i) += c24*Laplacian4(flx4_,m,n,k,j,i,dir,multi_d,three_d);
+          });
+        }
+      }
+    });
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Hydro::DispatchFourthOrderFluxes
+//! \brief Selects which CalculateFluxesFourthOrder function to call based on
+//! rsolver_method (only non-relativistic solvers are allowed)
+
+void Hydro::DispatchFourthOrderFluxes(Driver *pdrive, int stage) {
+  if (rsolver_method == Hydro_RSolver::advect) {
+    CalculateFluxesFourthOrder<Hydro_RSolver::advect>(pdrive, stage);
+  } else if (rsolver_method == Hydro_RSolver::llf) {
+    CalculateFluxesFourthOrder<Hydro_RSolver::llf>(pdrive, stage);
+  } else if (rsolver_method == Hydro_RSolver::hlle) {
+    CalculateFluxesFourthOrder<Hydro_RSolver::hlle>(pdrive, stage);
+  } else if (rsolver_method == Hydro_RSolver::hllc) {
+    CalculateFluxesFourthOrder<Hydro_RSolver::hllc>(pdrive, stage);
+  } else if (rsolver_method == Hydro_RSolver::roe) {
+    CalculateFluxesFourthOrder<Hydro_RSolver::roe>(pdrive, stage);
+  }
+  return;
+}
+
+} // namespace hydro
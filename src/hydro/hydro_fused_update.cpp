@@ -0,0 +1,316 @@
+//========================================================================================
+// AthenaK astrophysical fluid dynamics and numerical relativity code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file hydro_fused_update.cpp
+//! \brief Computes hydro fluxes and applies the RK update of the conserved variables in
+//! the same kernels, so that face fluxes are only ever stored in team scratch memory and
+//! the 5D flux arrays are never written to (or read back from) global memory.  Enabled
+//! with <hydro>/fused_update = true.
+//!
+//! The update is split into one kernel per direction.  The x1-kernel applies the weighted
+//! average of the RK stage plus dF1/dx1, the x2- and x3-kernels then subtract dF2/dx2 and
+//! dF3/dx3.  The fluxes only depend on w0, so updating u0 between kernels is safe.  Since
+//! the divergence is no longer summed before it is applied, results agree with those of
+//! the unfused Fluxes()+RKUpdate() tasks only to round-off.
+
+#include <iostream>
+
+#include "athena.hpp"
+#include "mesh/mesh.hpp"
+#include "coordinates/coordinates.hpp"
+#include "driver/driver.hpp"
+#include "hydro.hpp"
+#include "eos/eos.hpp"
+#include "reconstruct/dc.hpp"
+#include "reconstruct/plm.hpp"
+#include "reconstruct/ppm.hpp"
+#include "reconstruct/wenoz.hpp"
+#include "hydro/rsolvers/hydro_rsolver.hpp"
+
+namespace hydro {
+//----------------------------------------------------------------------------------------
+//! \fn void Hydro::FusedFluxesAndUpdate
+//! \brief Calls reconstruction and Riemann solver functions to compute hydro fluxes along
+//! each direction, and immediately applies the divergence of those fluxes to u0.
+//! Templated over RS for better performance on GPUs.
+
+template <Hydro_RSolver rsolver_method_>
+void Hydro::FusedFluxesAndUpdate(Driver *pdriver, int stage) {
+  RegionIndcs &indcs_ = pmy_pack->pmesh->mb_indcs;
+  int is = indcs_.is, ie = indcs_.ie;
+  int js = indcs_.js, je = indcs_.je;
+  int ks = indcs_.ks, ke = indcs_.ke;
+  int ncells1 = indcs_.nx1 + 2*(indcs_.ng);
+
+  int &nhyd_  = nhydro;
+  int nvars = nhydro + nscalars;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  const auto recon_method_ = recon_method;
+  bool extrema = false;
+  if (recon_method == ReconstructionMethod::ppmx) {
+    extrema = true;
+  }
+
+  Real &gam0 = pdriver->gam0[stage-1];
+  Real &gam1 = pdriver->gam1[stage-1];
+  Real beta_dt = (pdriver->beta[stage-1])*(pmy_pack->pmesh->dt);
+
+  auto &eos_ = peos->eos_data;
+  auto &size_ = pmy_pack->pmb->mb_size;
+  auto &coord_ = pmy_pack->pcoord->coord_data;
+  auto &w0_ = w0;
+  auto u0_ = u0;
+  auto u1_ = u1;
+  int scr_level = 0;
+
+  //--------------------------------------------------------------------------------------
+  // i-direction: weighted average of RK stage plus dF1/dx1
+
+  size_t scr_size = ScrArray2D<Real>::shmem_size(nvars, ncells1) * 3;
+  par_for_outer("hfused_x1",DevExeSpace(),scr_size,scr_level, 0, nmb1, ks, ke, js, je,
+  KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+    ScrArray2D<Real> wl(member.team_scratch(scr_level), nvars, ncells1);
+    ScrArray2D<Real> wr(member.team_scratch(scr_level), nvars, ncells1);
+    ScrArray2D<Real> flx(member.team_scratch(scr_level), nvars, ncells1);
+
+    // Reconstruct qR[i] and qL[i+1]
+    switch (recon_method_) {
+      case ReconstructionMethod::dc:
+        DonorCellX1(member, m, k, j, is-1, ie+1, w0_, wl, wr);
+        break;
+      case ReconstructionMethod::plm:
+        PiecewiseLinearX1(member, m, k, j, is-1, ie+1, w0_, wl, wr);
+        break;
+      case ReconstructionMethod::ppm4:
+      case ReconstructionMethod::ppmx:
+        PiecewiseParabolicX1(member,eos_,extrema,true, m, k, j, is-1, ie+1, w0_, wl, wr);
+        break;
+      case ReconstructionMethod::wenoz:
+        WENOZX1(member, eos_, true, m, k, j, is-1, ie+1, w0_, wl, wr);
+        break;
+      default:
+        break;
+    }
+    member.team_barrier();
+
+    // compute fluxes over [is,ie+1] into scratch
+    // NOTE(@pdmullen): Capture variables prior to if constexpr.
+    auto eos = eos_;
+    auto indcs = indcs_;
+    auto size = size_;
+    auto coord = coord_;
+    RiemannSolver<rsolver_method_>(member, eos, indcs, size, coord, m, k, j, is, ie+1,
+                                   IVX, wl, wr, ScrFluxRow{flx});
+    member.team_barrier();
+
+    // calculate fluxes of scalars (if any)
+    for (int n=nhyd_; n<nvars; ++n) {
+      par_for_inner(member, is, ie+1, [&](const int i) {
+        flx(n,i) = (flx(IDN,i) >= 0.0)? flx(IDN,i)*wl(n,i) : flx(IDN,i)*wr(n,i);
+      });
+    }
+    member.team_barrier();
+
+    Real dx1 = size.d_view(m).dx1;
+    for (int n=0; n<nvars; ++n) {
+      par_for_inner(member, is, ie, [&](const int i) {
+        u0_(m,n,k,j,i) = gam0*u0_(m,n,k,j,i) + gam1*u1_(m,n,k,j,i)
+                       - beta_dt*(flx(n,i+1) - flx(n,i))/dx1;
+      });
+    }
+  });
+
+  //--------------------------------------------------------------------------------------
+  // j-direction: subtract dF2/dx2.  Fluxes on previous face stored in second scratch row
+
+  if (pmy_pack->pmesh->multi_d) {
+    scr_size = ScrArray2D<Real>::shmem_size(nvars, ncells1) * 5;
+    int jl = js-1, ju = je+1;
+    par_for_outer("hfused_x2",DevExeSpace(), scr_size, scr_level, 0, nmb1, ks, ke,
+    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k) {
+      ScrArray2D<Real> scr1(member.team_scratch(scr_level), nvars, ncells1);
+      ScrArray2D<Real> scr2(member.team_scratch(scr_level), nvars, ncells1);
+      ScrArray2D<Real> scr3(member.team_scratch(scr_level), nvars, ncells1);
+      ScrArray2D<Real> flxa(member.team_scratch(scr_level), nvars, ncells1);
+      ScrArray2D<Real> flxb(member.team_scratch(scr_level), nvars, ncells1);
+      Real dx2 = size_.d_view(m).dx2;
+
+      for (int j=jl; j<=ju; ++j) {
+        // Permute scratch arrays.
+        auto wl     = scr1;
+        auto wl_jp1 = scr2;
+        auto wr     = scr3;
+        auto flx    = flxa;
+        auto flx_jm1 = flxb;
+        if ((j%2) == 0) {
+          wl     = scr2;
+          wl_jp1 = scr1;
+          flx    = flxb;
+          flx_jm1 = flxa;
+        }
+
+        // Reconstruct qR[j] and qL[j+1]
+        switch (recon_method_) {
+          case ReconstructionMethod::dc:
+            DonorCellX2(member, m, k, j, is, ie, w0_, wl_jp1, wr);
+            break;
+          case ReconstructionMethod::plm:
+            PiecewiseLinearX2(member, m, k, j, is, ie, w0_, wl_jp1, wr);
+            break;
+          case ReconstructionMethod::ppm4:
+          case ReconstructionMethod::ppmx:
+            PiecewiseParabolicX2(member,eos_,extrema,true,m,k,j,is,ie, w0_, wl_jp1, wr);
+            break;
+          case ReconstructionMethod::wenoz:
+            WENOZX2(member, eos_, true, m, k, j, is, ie, w0_, wl_jp1, wr);
+            break;
+          default:
+            break;
+        }
+        member.team_barrier();
+
+        // compute fluxes on face j, then update cell j-1 using fluxes on faces j-1 and j
+        if (j>jl) {
+          // NOTE(@pdmullen): Capture variables prior to if constexpr.
+          auto eos = eos_;
+          auto indcs = indcs_;
+          auto size = size_;
+          auto coord = coord_;
+          RiemannSolver<rsolver_method_>(member, eos, indcs, size, coord, m, k, j,
+                                         is, ie, IVY, wl, wr, ScrFluxRow{flx});
+          member.team_barrier();
+
+          for (int n=nhyd_; n<nvars; ++n) {
+            par_for_inner(member, is, ie, [&](const int i) {
+              flx(n,i) = (flx(IDN,i) >= 0.0)? flx(IDN,i)*wl(n,i) : flx(IDN,i)*wr(n,i);
+            });
+          }
+          member.team_barrier();
+
+          if (j>js) {
+            for (int n=0; n<nvars; ++n) {
+              par_for_inner(member, is, ie, [&](const int i) {
+                u0_(m,n,k,j-1,i) -= beta_dt*(flx(n,i) - flx_jm1(n,i))/dx2;
+              });
+            }
+            member.team_barrier();
+          }
+        }
+      } // end of loop over j
+    });
+  }
+
+  //--------------------------------------------------------------------------------------
+  // k-direction: subtract dF3/dx3.  Note order of k,j loops switched
+
+  if (pmy_pack->pmesh->three_d) {
+    scr_size = ScrArray2D<Real>::shmem_size(nvars, ncells1) * 5;
+    int kl = ks-1, ku = ke+1;
+    par_for_outer("hfused_x3",DevExeSpace(), scr_size, scr_level, 0, nmb1, js, je,
+    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int j) {
+      ScrArray2D<Real> scr1(member.team_scratch(scr_level), nvars, ncells1);
+      ScrArray2D<Real> scr2(member.team_scratch(scr_level), nvars, ncells1);
+      ScrArray2D<Real> scr3(member.team_scratch(scr_level), nvars, ncells1);
+      ScrArray2D<Real> flxa(member.team_scratch(scr_level), nvars, ncells1);
+      ScrArray2D<Real> flxb(member.team_scratch(scr_level), nvars, ncells1);
+      Real dx3 = size_.d_view(m).dx3;
+
+      for (int k=kl; k<=ku; ++k) {
+        // Permute scratch arrays.
+        auto wl     = scr1;
+        auto wl_kp1 = scr2;
+        auto wr     = scr3;
+        auto flx    = flxa;
+        auto flx_km1 = flxb;
+        if ((k%2) == 0) {
+          wl     = scr2;
+          wl_kp1 = scr1;
+          flx    = flxb;
+          flx_km1 = flxa;
+        }
+
+        // Reconstruct qR[k] and qL[k+1]
+        switch (recon_method_) {
+          case ReconstructionMethod::dc:
+            DonorCellX3(member, m, k, j, is, ie, w0_, wl_kp1, wr);
+            break;
+          case ReconstructionMethod::plm:
+            PiecewiseLinearX3(member, m, k, j, is, ie, w0_, wl_kp1, wr);
+            break;
+          case ReconstructionMethod::ppm4:
+          case ReconstructionMethod::ppmx:
+            PiecewiseParabolicX3(member,eos_,extrema,true,m,k,j,is,ie, w0_, wl_kp1, wr);
+            break;
+          case ReconstructionMethod::wenoz:
+            WENOZX3(member, eos_, true, m, k, j, is, ie, w0_, wl_kp1, wr);
+            break;
+          default:
+            break;
+        }
+        member.team_barrier();
+
+        // compute fluxes on face k, then update cell k-1 using fluxes on faces k-1 and k
+        if (k>kl) {
+          // NOTE(@pdmullen): Capture variables prior to if constexpr.
+          auto eos = eos_;
+          auto indcs = indcs_;
+          auto size = size_;
+          auto coord = coord_;
+          RiemannSolver<rsolver_method_>(member, eos, indcs, size, coord, m, k, j,
+                                         is, ie, IVZ, wl, wr, ScrFluxRow{flx});
+          member.team_barrier();
+
+          for (int n=nhyd_; n<nvars; ++n) {
+            par_for_inner(member, is, ie, [&](const int i) {
+              flx(n,i) = (flx(IDN,i) >= 0.0)? flx(IDN,i)*wl(n,i) : flx(IDN,i)*wr(n,i);
+            });
+          }
+          member.team_barrier();
+
+          if (k>ks) {
+            for (int n=0; n<nvars; ++n) {
+              par_for_inner(member, is, ie, [&](const int i) {
+                u0_(m,n,k-1,j,i) -= beta_dt*(flx(n,i) - flx_km1(n,i))/dx3;
+              });
+            }
+            member.team_barrier();
+          }
+        }
+      } // end loop over k
+    });
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Hydro::DispatchFusedUpdate
+//! \brief Selects which FusedFluxesAndUpdate function to call based on rsolver_method
+
+void Hydro::DispatchFusedUpdate(Driver *pdrive, int stage) {
+  if (rsolver_method == Hydro_RSolver::advect) {
+    FusedFluxesAndUpdate<Hydro_RSolver::advect>(pdrive, stage);
+  } else if (rsolver_method == Hydro_RSolver::llf) {
+    FusedFluxesAndUpdate<Hydro_RSolver::llf>(pdrive, stage);
+  } else if (rsolver_method == Hydro_RSolver::hlle) {
+    FusedFluxesAndUpdate<Hydro_RSolver::hlle>(pdrive, stage);
+  } else if (rsolver_method == Hydro_RSolver::hllc) {
+    FusedFluxesAndUpdate<Hydro_RSolver::hllc>(pdrive, stage);
+  } else if (rsolver_method == Hydro_RSolver::roe) {
+    FusedFluxesAndUpdate<Hydro_RSolver::roe>(pdrive, stage);
+  } else if (rsolver_method == Hydro_RSolver::llf_sr) {
+    FusedFluxesAndUpdate<Hydro_RSolver::llf_sr>(pdrive, stage);
+  } else if (rsolver_method == Hydro_RSolver::hlle_sr) {
+    FusedFluxesAndUpdate<Hydro_RSolver::hlle_sr>(pdrive, stage);
+  } else if (rsolver_method == Hydro_RSolver::hllc_sr) {
+    FusedFluxesAndUpdate<Hydro_RSolver::hllc_sr>(pdrive, stage);
+  } else if (rsolver_method == Hydro_RSolver::llf_gr) {
+    FusedFluxesAndUpdate<Hydro_RSolver::llf_gr>(pdrive, stage);
+  } else if (rsolver_method == Hydro_RSolver::hlle_gr) {
+    FusedFluxesAndUpdate<Hydro_RSolver::hlle_gr>(pdrive, stage);
+  }
+  return;
+}
+
+} // namespace hydro
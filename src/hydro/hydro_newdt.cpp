@@ -44,6 +44,8 @@ TaskStatus Hydro::NewTimeStep(Driver *pdrive, int stage) {
   auto &w0_ = w0;
   auto &eos = pmy_pack->phydro->peos->eos_data;
   auto &mbsize = pmy_pack->pmb->mb_size;
+  auto &multi_d = pmy_pack->pmesh->multi_d;
+  auto &three_d = pmy_pack->pmesh->three_d;
   auto &is_special_relativistic_ = pmy_pack->pcoord->is_special_relativistic;
   auto &is_general_relativistic_ = pmy_pack->pcoord->is_general_relativistic;
   auto &is_dynamical_relativistic_ = pmy_pack->pcoord->is_dynamical_relativistic;
@@ -51,7 +53,22 @@ TaskStatus Hydro::NewTimeStep(Driver *pdrive, int stage) {
   const int nkji = nx3*nx2*nx1;
   const int nji  = nx2*nx1;
 
-  if (pdrive->time_evolution == TimeEvolution::kinematic) {
+  // also store minimum in each MeshBlock if timesteps on each level are reported
+  const bool level_dt = pmy_pack->pmesh->report_level_dt;
+  if (level_dt) {
+    if (static_cast<int>(dtnew_mb.extent(0)) != pmy_pack->nmb_thispack) {
+      Kokkos::realloc(dtnew_mb, pmy_pack->nmb_thispack);
+    }
+    Kokkos::deep_copy(dtnew_mb, std::numeric_limits<float>::max());
+  }
+  auto &dtnew_mb_ = dtnew_mb;
+
+  if (peos->c2p_dt_done && !(level_dt)) {
+    // minimum dx/(v +/- C) in each direction already found in ConsToPrim() this stage
+    dt1 = peos->c2p_dt1;
+    dt2 = peos->c2p_dt2;
+    dt3 = peos->c2p_dt3;
+  } else if (pdrive->time_evolution == TimeEvolution::kinematic) {
     // find smallest (dx/v) in each direction for advection problems
     Kokkos::parallel_reduce("HydroNudt1",Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
     KOKKOS_LAMBDA(const int &idx, Real &min_dt1, Real &min_dt2, Real &min_dt3) {
@@ -66,6 +83,12 @@ TaskStatus Hydro::NewTimeStep(Driver *pdrive, int stage) {
       min_dt1 = fmin((mbsize.d_view(m).dx1/fabs(w0_(m,IVX,k,j,i))), min_dt1);
       min_dt2 = fmin((mbsize.d_view(m).dx2/fabs(w0_(m,IVY,k,j,i))), min_dt2);
       min_dt3 = fmin((mbsize.d_view(m).dx3/fabs(w0_(m,IVZ,k,j,i))), min_dt3);
+      if (level_dt) {
+        Real dtc = mbsize.d_view(m).dx1/fabs(w0_(m,IVX,k,j,i));
+        if (multi_d) {dtc = fmin(dtc, mbsize.d_view(m).dx2/fabs(w0_(m,IVY,k,j,i)));}
+        if (three_d) {dtc = fmin(dtc, mbsize.d_view(m).dx3/fabs(w0_(m,IVZ,k,j,i)));}
+        Kokkos::atomic_min(&dtnew_mb_(m), dtc);
+      }
     }, Kokkos::Min<Real>(dt1), Kokkos::Min<Real>(dt2),Kokkos::Min<Real>(dt3));
   } else {
     // find smallest dx/(v +/- Cs) in each direction for hydrodynamic problems
@@ -115,9 +138,17 @@ TaskStatus Hydro::NewTimeStep(Driver *pdrive, int stage) {
       min_dt1 = fmin((mbsize.d_view(m).dx1/max_dv1), min_dt1);
       min_dt2 = fmin((mbsize.d_view(m).dx2/max_dv2), min_dt2);
       min_dt3 = fmin((mbsize.d_view(m).dx3/max_dv3), min_dt3);
+      if (level_dt) {
+        Real dtc = mbsize.d_view(m).dx1/max_dv1;
+        if (multi_d) {dtc = fmin(dtc, mbsize.d_view(m).dx2/max_dv2);}
+        if (three_d) {dtc = fmin(dtc, mbsize.d_view(m).dx3/max_dv3);}
+        Kokkos::atomic_min(&dtnew_mb_(m), dtc);
+      }
     }, Kokkos::Min<Real>(dt1), Kokkos::Min<Real>(dt2),Kokkos::Min<Real>(dt3));
   }
 
+  peos->c2p_dt_done = false;
+
   // compute minimum of dt1/dt2/dt3 for 1D/2D/3D problems
   dtnew = dt1;
   if (pmy_pack->pmesh->multi_d) { dtnew = std::min(dtnew, dt2); }
@@ -0,0 +1,187 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file hydro_sts.cpp
+//! \brief Operator-split super-time-stepping (RKL1/RKL2) of the Hydro diffusion terms
+//! (viscosity and thermal conduction).  When <time>/sts_integrator is set, diffusive
+//! fluxes are not added in Fluxes(), their timesteps do not limit dt, and instead they
+//! are integrated over the full timestep after the (hyperbolic) time integrator with the
+//! number of stages set in Mesh::NewTimeStep().  Each STS stage runs its own
+//! "before_sts", "sts" and "after_sts" task lists, which only compute diffusive fluxes,
+//! update u0, and communicate boundary values.
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "athena.hpp"
+#include "mesh/mesh.hpp"
+#include "driver/driver.hpp"
+#include "tasklist/task_list.hpp"
+#include "eos/eos.hpp"
+#include "diffusion/viscosity.hpp"
+#include "diffusion/conduction.hpp"
+#include "diffusion/sts.hpp"
+#include "bvals/bvals.hpp"
+#include "hydro.hpp"
+
+namespace hydro {
+//----------------------------------------------------------------------------------------
+//! \fn  void Hydro::AssembleSTSTasks
+//! \brief Adds tasks for each stage of super-time-stepping of diffusion terms to the
+//! "before_sts", "sts" and "after_sts" task lists.  Called by AssembleHydroTasks().
+
+void Hydro::AssembleSTSTasks(std::map<std::string, std::shared_ptr<TaskList>> tl) {
+  TaskID none(0);
+
+  // assemble "before_sts" task list
+  id.sts_irecv = tl["before_sts"]->AddTask(&Hydro::InitRecvSTS, this, none);
+
+  // assemble "sts" task list
+  id.sts_flux  = tl["sts"]->AddTask(&Hydro::STSFluxes, this, none);
+  id.sts_sendf = tl["sts"]->AddTask(&Hydro::SendFlux, this, id.sts_flux);
+  id.sts_recvf = tl["sts"]->AddTask(&Hydro::RecvFlux, this, id.sts_sendf);
+  id.sts_updt  = tl["sts"]->AddTask(&Hydro::STSUpdate, this, id.sts_recvf);
+  id.sts_restu = tl["sts"]->AddTask(&Hydro::RestrictU, this, id.sts_updt);
+  id.sts_sendu = tl["sts"]->AddTask(&Hydro::SendU, this, id.sts_restu);
+  id.sts_recvu = tl["sts"]->AddTask(&Hydro::RecvU, this, id.sts_sendu);
+  id.sts_bcs   = tl["sts"]->AddTask(&Hydro::ApplyPhysicalBCs, this, id.sts_recvu);
+  id.sts_prol  = tl["sts"]->AddTask(&Hydro::Prolongate, this, id.sts_bcs);
+  id.sts_c2p   = tl["sts"]->AddTask(&Hydro::STSConToPrim, this, id.sts_prol);
+
+  // assemble "after_sts" task list
+  id.sts_csend = tl["after_sts"]->AddTask(&Hydro::ClearSend, this, none);
+  id.sts_crecv = tl["after_sts"]->AddTask(&Hydro::ClearRecv, this, id.sts_csend);
+
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskList Hydro::InitRecvSTS
+//! \brief Wrapper task list function to post non-blocking receives (with MPI) for U, and
+//! with SMR/AMR fluxes of U, in each STS stage.
+
+TaskStatus Hydro::InitRecvSTS(Driver *pdrive, int stage) {
+  TaskStatus tstat = pbval_u->InitRecv(nhydro+nscalars);
+  if (tstat != TaskStatus::complete) return tstat;
+  if (pmy_pack->pmesh->multilevel) {
+    tstat = pbval_u->InitFluxRecv(nhydro+nscalars);
+  }
+  return tstat;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus Hydro::STSFluxes
+//! \brief Computes fluxes of conserved variables from diffusion terms only
+
+TaskStatus Hydro::STSFluxes(Driver *pdrive, int stage) {
+  Kokkos::deep_copy(DevExeSpace(), uflx.x1f, 0.0);
+  Kokkos::deep_copy(DevExeSpace(), uflx.x2f, 0.0);
+  Kokkos::deep_copy(DevExeSpace(), uflx.x3f, 0.0);
+  if (pvisc != nullptr) {
+    pvisc->IsotropicViscousFlux(w0, pvisc->nu_iso, peos->eos_data, uflx);
+  }
+  if (pcond != nullptr) {
+    pcond->AddHeatFlux(w0, peos->eos_data, uflx);
+  }
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void Hydro::STSUpdate
+//  \brief Update of conserved variables for one stage of RKL1/RKL2 integrator.  u1 stores
+//  the state at the start of the step, u2_sts the state at stage j-2, and dudt0_sts the
+//  diffusion operator applied to the state at the start of the step.
+
+TaskStatus Hydro::STSUpdate(Driver *pdriver, int stage) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, ie = indcs.ie;
+  int js = indcs.js, je = indcs.je;
+  int ks = indcs.ks, ke = indcs.ke;
+  int ncells1 = indcs.nx1 + 2*(indcs.ng);
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+
+  // coefficients of this stage
+  Mesh *pm = pmy_pack->pmesh;
+  Real mu, nu, mut, gam;
+  STSStageCoefficients(pm->sts_integrator, pm->nsts_stages, stage, mu, nu, mut, gam);
+  Real c0 = 1.0 - mu - nu;
+  Real mut_dt = mut*(pm->dt);
+  Real gam_dt = gam*(pm->dt);
+  bool first = (stage == 1);
+
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  auto u0_ = u0;
+  auto u1_ = u1;
+  auto u2_ = u2_sts;
+  auto dudt0_ = dudt0_sts;
+  auto flx1 = uflx.x1f;
+  auto flx2 = uflx.x2f;
+  auto flx3 = uflx.x3f;
+  auto &mbsize = pmy_pack->pmb->mb_size;
+
+  // passive scalars are not diffused, so only hydro variables are updated
+  int scr_level = 0;
+  size_t scr_size = ScrArray1D<Real>::shmem_size(ncells1);
+
+  par_for_outer("h_sts",DevExeSpace(),scr_size,scr_level,0,nmb1,0,nhydro-1,ks,ke,js,je,
+  KOKKOS_LAMBDA(TeamMember_t member, const int m, const int n, const int k, const int j) {
+    ScrArray1D<Real> divf(member.team_scratch(scr_level), ncells1);
+
+    // compute dF1/dx1
+    par_for_inner(member, is, ie, [&](const int i) {
+      divf(i) = (flx1(m,n,k,j,i+1) - flx1(m,n,k,j,i))/mbsize.d_view(m).dx1;
+    });
+    member.team_barrier();
+
+    // Add dF2/dx2
+    if (multi_d) {
+      par_for_inner(member, is, ie, [&](const int i) {
+        divf(i) += (flx2(m,n,k,j+1,i) - flx2(m,n,k,j,i))/mbsize.d_view(m).dx2;
+      });
+      member.team_barrier();
+    }
+
+    // Add dF3/dx3
+    if (three_d) {
+      par_for_inner(member, is, ie, [&](const int i) {
+        divf(i) += (flx3(m,n,k+1,j,i) - flx3(m,n,k,j,i))/mbsize.d_view(m).dx3;
+      });
+      member.team_barrier();
+    }
+
+    par_for_inner(member, is, ie, [&](const int i) {
+      // save state and diffusion operator at start of step in first stage
+      if (first) {
+        u1_(m,n,k,j,i) = u0_(m,n,k,j,i);
+        u2_(m,n,k,j,i) = u0_(m,n,k,j,i);
+        dudt0_(m,n,k,j,i) = -divf(i);
+      }
+      Real ujm1 = u0_(m,n,k,j,i);
+      u0_(m,n,k,j,i) = mu*ujm1 + nu*u2_(m,n,k,j,i) + c0*u1_(m,n,k,j,i)
+                     - mut_dt*divf(i) + gam_dt*dudt0_(m,n,k,j,i);
+      u2_(m,n,k,j,i) = ujm1;
+    });
+  });
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskList Hydro::STSConToPrim
+//! \brief Wrapper task list function to call ConsToPrim over entire mesh (including gz)
+//! at the end of each STS stage.  Unlike ConToPrim() never computes new timestep.
+
+TaskStatus Hydro::STSConToPrim(Driver *pdrive, int stage) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int &ng = indcs.ng;
+  int n1m1 = indcs.nx1 + 2*ng - 1;
+  int n2m1 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng - 1) : 0;
+  int n3m1 = (indcs.nx3 > 1)? (indcs.nx3 + 2*ng - 1) : 0;
+  peos->ConsToPrim(u0, w0, false, 0, n1m1, 0, n2m1, 0, n3m1);
+  return TaskStatus::complete;
+}
+
+} // namespace hydro
@@ -61,6 +61,7 @@ void Hydro::AssembleHydroTasks(std::map<std::string, std::shared_ptr<TaskList>>
   id.recvu_oa  = tl["stagen"]->AddTask(&Hydro::RecvU_OA, this, id.sendu_oa);
   id.restu     = tl["stagen"]->AddTask(&Hydro::RestrictU, this, id.recvu_oa);
   id.sendu     = tl["stagen"]->AddTask(&Hydro::SendU, this, id.restu);
+  id.fluxi     = tl["stagen"]->AddTask(&Hydro::InteriorFluxes, this, id.sendu);
   id.recvu     = tl["stagen"]->AddTask(&Hydro::RecvU, this, id.sendu);
   id.sendu_shr = tl["stagen"]->AddTask(&Hydro::SendU_Shr, this, id.recvu);
   id.recvu_shr = tl["stagen"]->AddTask(&Hydro::RecvU_Shr, this, id.sendu_shr);
@@ -68,12 +69,21 @@ void Hydro::AssembleHydroTasks(std::map<std::string, std::shared_ptr<TaskList>>
   id.prol      = tl["stagen"]->AddTask(&Hydro::Prolongate, this, id.bcs);
   id.c2p       = tl["stagen"]->AddTask(&Hydro::ConToPrim, this, id.prol);
   id.newdt     = tl["stagen"]->AddTask(&Hydro::NewTimeStep, this, id.c2p);
+  // start communications as early as possible with <time>/task_priority
+  tl["stagen"]->SetPriority(id.sendf, 1);
+  tl["stagen"]->SetPriority(id.sendu, 1);
 
   // assemble "after_stagen" task list
   id.csend = tl["after_stagen"]->AddTask(&Hydro::ClearSend, this, none);
   // although RecvFlux/U functions check that all recvs complete, add ClearRecv to
   // task list anyways to catch potential bugs in MPI communication logic
   id.crecv = tl["after_stagen"]->AddTask(&Hydro::ClearRecv, this, id.csend);
+  if (dormant_blocks) {
+    id.dormant = tl["after_stagen"]->AddTask(&Hydro::UpdateDormantMBs, this, id.crecv);
+  }
+
+  // tasks for super-time-stepping of diffusion terms
+  if (sts_diffusion) {AssembleSTSTasks(tl);}
 
   return;
 }
@@ -153,34 +163,23 @@ TaskStatus Hydro::CopyCons(Driver *pdrive, int stage) {
 //! of conserved variables
 
 TaskStatus Hydro::Fluxes(Driver *pdrive, int stage) {
-  // select which calculate_flux function to call based on rsolver_method
-  if (rsolver_method == Hydro_RSolver::advect) {
-    CalculateFluxes<Hydro_RSolver::advect>(pdrive, stage);
-  } else if (rsolver_method == Hydro_RSolver::llf) {
-    CalculateFluxes<Hydro_RSolver::llf>(pdrive, stage);
-  } else if (rsolver_method == Hydro_RSolver::hlle) {
-    CalculateFluxes<Hydro_RSolver::hlle>(pdrive, stage);
-  } else if (rsolver_method == Hydro_RSolver::hllc) {
-    CalculateFluxes<Hydro_RSolver::hllc>(pdrive, stage);
-  } else if (rsolver_method == Hydro_RSolver::roe) {
-    CalculateFluxes<Hydro_RSolver::roe>(pdrive, stage);
-  } else if (rsolver_method == Hydro_RSolver::llf_sr) {
-    CalculateFluxes<Hydro_RSolver::llf_sr>(pdrive, stage);
-  } else if (rsolver_method == Hydro_RSolver::hlle_sr) {
-    CalculateFluxes<Hydro_RSolver::hlle_sr>(pdrive, stage);
-  } else if (rsolver_method == Hydro_RSolver::hllc_sr) {
-    CalculateFluxes<Hydro_RSolver::hllc_sr>(pdrive, stage);
-  } else if (rsolver_method == Hydro_RSolver::llf_gr) {
-    CalculateFluxes<Hydro_RSolver::llf_gr>(pdrive, stage);
-  } else if (rsolver_method == Hydro_RSolver::hlle_gr) {
-    CalculateFluxes<Hydro_RSolver::hlle_gr>(pdrive, stage);
-  }
-
-  // Add viscous, heat-flux, etc fluxes
-  if (pvisc != nullptr) {
+  // with fused updates fluxes are computed in RKUpdate()
+  if (fused_update) return TaskStatus::complete;
+
+  // only fluxes in the boundary region remain if interior fluxes were computed while
+  // boundary communications of the previous stage were in flight
+  if (interior_fluxes_done) {
+    DispatchFluxes(pdrive, stage, FluxRegion::boundary);
+    interior_fluxes_done = false;
+  } else {
+    DispatchFluxes(pdrive, stage, FluxRegion::all);
+  }
+
+  // Add viscous, heat-flux, etc fluxes (unless integrated with super-time-stepping)
+  if ((pvisc != nullptr) && !(sts_diffusion)) {
     pvisc->IsotropicViscousFlux(w0, pvisc->nu_iso, peos->eos_data, uflx);
   }
-  if (pcond != nullptr) {
+  if ((pcond != nullptr) && !(sts_diffusion)) {
     pcond->AddHeatFlux(w0, peos->eos_data, uflx);
   }
 
@@ -196,6 +195,25 @@ TaskStatus Hydro::Fluxes(Driver *pdrive, int stage) {
   return TaskStatus::complete;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void Hydro::DispatchFluxes
+//! \brief Calls CalculateFluxes function chosen by SelectFluxKernel() at construction
+
+void Hydro::DispatchFluxes(Driver *pdrive, int stage, FluxRegion region) {
+  // region is always FluxRegion::all with tiled or fourth-order fluxes, since
+  // split_fluxes is not allowed with either
+  if (tiled_fluxes) {
+    DispatchTiledFluxes(pdrive, stage);
+    return;
+  }
+  if (fourth_order) {
+    DispatchFourthOrderFluxes(pdrive, stage);
+    return;
+  }
+  (this->*calc_fluxes_)(pdrive, stage, region);
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn TaskList Hydro::SendFlux
 //! \brief Wrapper task list function to pack/send restricted values of fluxes of
@@ -234,10 +252,20 @@ TaskStatus Hydro::HydroSrcTerms(Driver *pdrive, int stage) {
   Real beta_dt = (pdrive->beta[stage-1])*(pmy_pack->pmesh->dt);
 
   // Add source terms for various physics.  Must be computed from primitives.
-  if (psrc->const_accel)  psrc->ConstantAccel(w0, peos->eos_data,  beta_dt, u0);
-  if (psrc->ism_cooling)  psrc->ISMCooling(w0, peos->eos_data, beta_dt, u0);
-  if (psrc->rel_cooling)  psrc->RelCooling(w0, peos->eos_data, beta_dt, u0);
-  if (psrc->shearing_box) psrc->ShearingBox(w0, peos->eos_data, beta_dt, u0);
+  // Terms fused into RKUpdate (<block>/fused_srcterms = true) have already been added.
+  auto &fsrc = psrc->fsrc;
+  if (psrc->const_accel && !(fsrc.const_accel)) {
+    psrc->ConstantAccel(w0, peos->eos_data, beta_dt, u0);
+  }
+  if (psrc->ism_cooling && !(fsrc.ism_cooling)) {
+    psrc->ISMCooling(w0, peos->eos_data, beta_dt, u0);
+  }
+  if (psrc->rel_cooling && !(fsrc.rel_cooling)) {
+    psrc->RelCooling(w0, peos->eos_data, beta_dt, u0);
+  }
+  if (psrc->shearing_box && !(fsrc.sbox)) {
+    psrc->ShearingBox(w0, peos->eos_data, beta_dt, u0);
+  }
 
   // Add coordinate source terms in GR.  Again, must be computed with only primitives.
   if (pmy_pack->pcoord->is_general_relativistic) {
@@ -249,6 +277,9 @@ TaskStatus Hydro::HydroSrcTerms(Driver *pdrive, int stage) {
     (pmy_pack->pmesh->pgen->user_srcs_func)(pmy_pack->pmesh, beta_dt);
   }
 
+  // dormant MBs keep u0 from the start of the cycle
+  if (dormant_blocks) {FreezeDormantMBs();}
+
   return TaskStatus::complete;
 }
 
@@ -287,8 +318,8 @@ TaskStatus Hydro::RecvU_OA(Driver *pdrive, int stage) {
 //! \brief Wrapper task list function to restrict conserved vars
 
 TaskStatus Hydro::RestrictU(Driver *pdrive, int stage) {
-  // Only execute Mesh function with SMR/SMR
-  if (pmy_pack->pmesh->multilevel) {
+  // Only execute Mesh function with SMR/SMR, on ranks with coarse arrays
+  if (pmy_pack->pmesh->multilevel && pmy_pack->pmb->need_coarse) {
     pmy_pack->pmesh->pmr->RestrictCC(u0, coarse_u0);
   }
   return TaskStatus::complete;
@@ -303,6 +334,25 @@ TaskStatus Hydro::SendU(Driver *pdrive, int stage) {
   return tstat;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn TaskList Hydro::InteriorFluxes
+//! \brief Wrapper task list function that computes fluxes for the next stage in the
+//! interior of each MeshBlock while the boundary communications of U are in flight.
+//! Primitives in active zones are final once U has been sent, and fluxes in the interior
+//! only depend on active zones.  Remaining fluxes computed in Fluxes() at next stage.
+
+TaskStatus Hydro::InteriorFluxes(Driver *pdrive, int stage) {
+  // only execute when (split fluxes enabled) AND (not last stage)
+  if (split_fluxes && (stage < pdrive->nexp_stages)) {
+    auto &indcs = pmy_pack->pmesh->mb_indcs;
+    peos->ConsToPrim(u0, w0, false, indcs.is, indcs.ie, indcs.js, indcs.je,
+                     indcs.ks, indcs.ke);
+    DispatchFluxes(pdrive, stage, FluxRegion::interior);
+    interior_fluxes_done = true;
+  }
+  return TaskStatus::complete;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn TaskList Hydro::RecvU
 //! \brief Wrapper task list function to receive/unpack cell-centered conserved variables
@@ -363,7 +413,8 @@ TaskStatus Hydro::ApplyPhysicalBCs(Driver *pdrive, int stage) {
 //! at fine/coarse boundaries with SMR/AMR
 
 TaskStatus Hydro::Prolongate(Driver *pdrive, int stage) {
-  if (pmy_pack->pmesh->multilevel) {  // only prolongate with SMR/AMR
+  // only prolongate with SMR/AMR, on ranks with coarse arrays
+  if (pmy_pack->pmesh->multilevel && pmy_pack->pmb->need_coarse) {
     pbval_u->FillCoarseInBndryCC(u0, coarse_u0);
     if (pmy_pack->pmesh->pmr->prolong_prims) {
       pbval_u->ConsToPrimCoarseBndry(coarse_u0, coarse_w0);
@@ -386,7 +437,11 @@ TaskStatus Hydro::ConToPrim(Driver *pdrive, int stage) {
   int n1m1 = indcs.nx1 + 2*ng - 1;
   int n2m1 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng - 1) : 0;
   int n3m1 = (indcs.nx3 > 1)? (indcs.nx3 + 2*ng - 1) : 0;
+  // new timestep is computed over active cells in C2P kernel of last stage if requested
+  peos->c2p_newdt = (fused_newdt && (stage == pdrive->nexp_stages));
   peos->ConsToPrim(u0, w0, false, 0, n1m1, 0, n2m1, 0, n3m1);
+  peos->c2p_newdt = false;
+  if (fourth_order) {CellAveragedPrimitives();}
   return TaskStatus::complete;
 }
 
@@ -7,12 +7,15 @@
 //! \brief Performs explicit update of Hydro conserved variables (u0) for each stage of
 //! the SSP RK integrators (e.g. RK1, RK2, RK3) implemented in AthenaK, using weighted
 //! average and partial time step update of flux divergence. Source terms are added in
-//! the HydroSrcTerms() function.
+//! the HydroSrcTerms() function, except those fused into this kernel when
+//! <hydro>/fused_srcterms = true.
 
 #include "athena.hpp"
 #include "mesh/mesh.hpp"
 #include "driver/driver.hpp"
+#include "driver/profiler.hpp"
 #include "eos/eos.hpp"
+#include "srcterms/srcterms.hpp"
 #include "hydro.hpp"
 
 namespace hydro {
@@ -21,6 +24,12 @@ namespace hydro {
 //  \brief Explicit RK update including flux divergence terms
 
 TaskStatus Hydro::RKUpdate(Driver *pdriver, int stage) {
+  // compute fluxes and update u0 in same kernels if requested
+  if (fused_update) {
+    DispatchFusedUpdate(pdriver, stage);
+    return TaskStatus::complete;
+  }
+
   auto &indcs = pmy_pack->pmesh->mb_indcs;
   int is = indcs.is, ie = indcs.ie;
   int js = indcs.js, je = indcs.je;
@@ -40,6 +49,13 @@ TaskStatus Hydro::RKUpdate(Driver *pdriver, int stage) {
   auto flx2 = uflx.x2f;
   auto flx3 = uflx.x3f;
   auto &mbsize = pmy_pack->pmb->mb_size;
+  // source terms added in this kernel if <block>/fused_srcterms = true
+  auto fsrc = psrc->fsrc;
+  auto eos = peos->eos_data;
+  auto w0_ = w0;
+  // dormant MBs are not updated
+  const bool skip_dormant = DormantMBs();
+  auto &dormant_ = dormant;
 
   // hierarchical parallel loop that updates conserved variables to intermediate step
   // using weights and fractional time step appropriate to stages of time-integrator.
@@ -47,8 +63,14 @@ TaskStatus Hydro::RKUpdate(Driver *pdriver, int stage) {
   int scr_level = 0;
   size_t scr_size = ScrArray1D<Real>::shmem_size(ncells1);
 
+  // estimated work for profiler: u0, u1 and fluxes read, and u0 written once
+  int ndim = (three_d)? 3 : ((multi_d)? 2 : 1);
+  double ncell = static_cast<double>(nmb1 + 1)*nvar*indcs.nx1*indcs.nx2*indcs.nx3;
+  AddKernelWork("h_update", ncell*(3 + ndim)*sizeof(Real), ncell*(3*ndim + 3));
+
   par_for_outer("h_update",DevExeSpace(),scr_size,scr_level,0,nmb1,0,nvar-1,ks,ke,js,je,
   KOKKOS_LAMBDA(TeamMember_t member, const int m, const int n, const int k, const int j) {
+    if (skip_dormant && dormant_(m)) return;
     ScrArray1D<Real> divf(member.team_scratch(scr_level), ncells1);
 
     // compute dF1/dx1
@@ -76,7 +98,11 @@ TaskStatus Hydro::RKUpdate(Driver *pdriver, int stage) {
     }
 
     par_for_inner(member, is, ie, [&](const int i) {
-      u0_(m,n,k,j,i) = gam0*u0_(m,n,k,j,i) + gam1*u1_(m,n,k,j,i) - beta_dt*divf(i);
+      Real src = 0.0;
+      if (fsrc.enabled) {
+        src = fsrc.Increment(w0_, w0_, false, eos, beta_dt, m, n, k, j, i);
+      }
+      u0_(m,n,k,j,i) = gam0*u0_(m,n,k,j,i) + gam1*u1_(m,n,k,j,i) - beta_dt*divf(i) + src;
     });
   });
   return TaskStatus::complete;
@@ -24,11 +24,12 @@ namespace hydro {
 //! \fn void HLLC
 //! \brief The HLLC Riemann solver for ideal gas hydrodynamics (use HLLE for isothermal)
 
+template <typename FluxArray>
 KOKKOS_INLINE_FUNCTION
 void HLLC(TeamMember_t const &member, const EOS_Data &eos,
      const RegionIndcs &indcs,const DualArray1D<RegionSize> &size,const CoordData &coord,
      const int m, const int k, const int j, const int il, const int iu, const int ivx,
-     const ScrArray2D<Real> &wl, const ScrArray2D<Real> &wr, DvceArray5D<Real> flx) {
+     const ScrArray2D<Real> &wl, const ScrArray2D<Real> &wr, FluxArray flx) {
   int ivy = IVX + ((ivx-IVX)+1)%3;
   int ivz = IVX + ((ivx-IVX)+2)%3;
 
@@ -117,16 +118,12 @@ void HLLC(TeamMember_t const &member, const EOS_Data &eos,
     fr.e  = er*(wr_ivx - qa) + wr_ipr*wr_ivx;
 
     //--- Step 8. Compute flux weights or scales
+    // Written as selects rather than if/else so loop over i vectorizes on CPUs
 
-    if (am >= 0.0) {
-      qc =  am/(am - qb);
-      qd = 0.0;
-      qe = -qb/(am - qb);
-    } else {
-      qc =  0.0;
-      qd = -am/(qa - am);
-      qe =  qa/(qa - am);
-    }
+    bool upwind = (am >= 0.0);
+    qc = upwind ?  am/(am - qb) : 0.0;
+    qd = upwind ?  0.0 : -am/(qa - am);
+    qe = upwind ? -qb/(am - qb) : qa/(qa - am);
 
     //--- Step 9. Compute the HLLC flux at interface, including weighted contribution
     // of the flux along the contact
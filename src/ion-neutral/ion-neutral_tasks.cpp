@@ -132,11 +132,12 @@ TaskStatus IonNeutral::FirstTwoImpRK(Driver *pdrive, int stage) {
 //  conserved variables (u0), as primitives (w0) are not updated until end of TaskList.
 //
 //  Note indices of source term array correspond to:
-//     ru(0) -> ui(IM1)     ru(3) -> un(IM1)
-//     ru(1) -> ui(IM2)     ru(4) -> un(IM2)
-//     ru(2) -> ui(IM3)     ru(5) -> un(IM3)
-//     ru(6) -> ui(IDN)     ru(7) -> un(IDN)
-//  where ui=pmhd->u0 and un=phydro->u0
+//     ru(0) -> ui(IM1)     ru(2) -> ui(IM3)
+//     ru(1) -> ui(IM2)     ru(3) -> ui(IDN)
+//  where ui=pmhd->u0.  Drag, ionization and recombination conserve total mass and
+//  momentum, so the source terms for un=phydro->u0 are -ru and are not stored.  Source
+//  terms of each stage are stored in slot pdriver->imp_slot[s] of the array, so that
+//  only terms still needed by later stages are kept.
 
 
 TaskStatus IonNeutral::ImpRKUpdate(Driver *pdriver, int estage) {
@@ -161,21 +162,24 @@ TaskStatus IonNeutral::ImpRKUpdate(Driver *pdriver, int estage) {
     auto ui = pmhd->u0;
     auto un = phyd->u0;
     auto &a_twid = pdriver->a_twid;
+    auto &slot = pdriver->imp_slot;
     Real dt = pmy_pack->pmesh->dt;
     auto ru_ = pdriver->impl_src;
     par_for_outer("imex_exp",DevExeSpace(),scr_size,scr_level,0,nmb1,0,(n3-1),0,(n2-1),
     KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
       for (int s=0; s<=(istage-2); ++s) {
+        if (a_twid[istage-2][s] == 0.0) continue;  // term not used (and maybe not stored)
         Real adt = a_twid[istage-2][s]*dt;
+        int l = slot[s];
         par_for_inner(member, 0, (n1-1), [&](const int i) {
-          ui(m,IM1,k,j,i) += adt*ru_(s,m,0,k,j,i);
-          ui(m,IM2,k,j,i) += adt*ru_(s,m,1,k,j,i);
-          ui(m,IM3,k,j,i) += adt*ru_(s,m,2,k,j,i);
-          un(m,IM1,k,j,i) += adt*ru_(s,m,3,k,j,i);
-          un(m,IM2,k,j,i) += adt*ru_(s,m,4,k,j,i);
-          un(m,IM3,k,j,i) += adt*ru_(s,m,5,k,j,i);
-          ui(m,IDN,k,j,i) += adt*ru_(s,m,6,k,j,i);
-          un(m,IDN,k,j,i) += adt*ru_(s,m,7,k,j,i);
+          ui(m,IM1,k,j,i) += adt*ru_(l,m,0,k,j,i);
+          ui(m,IM2,k,j,i) += adt*ru_(l,m,1,k,j,i);
+          ui(m,IM3,k,j,i) += adt*ru_(l,m,2,k,j,i);
+          un(m,IM1,k,j,i) -= adt*ru_(l,m,0,k,j,i);
+          un(m,IM2,k,j,i) -= adt*ru_(l,m,1,k,j,i);
+          un(m,IM3,k,j,i) -= adt*ru_(l,m,2,k,j,i);
+          ui(m,IDN,k,j,i) += adt*ru_(l,m,3,k,j,i);
+          un(m,IDN,k,j,i) -= adt*ru_(l,m,3,k,j,i);
         });
       }
     });
@@ -229,9 +233,10 @@ TaskStatus IonNeutral::ImpRKUpdate(Driver *pdriver, int estage) {
   }
 
   // Compute stiff source term (ion-neutral drag) using variables updated in this stage,
-  // i.e R(U^n), for use in later stages.  Only required for istage = (1,2,3,[4])
-  if (estage < pdriver->nexp_stages) {
-    int s = istage-1;
+  // i.e R(U^n), for use in later stages.  Only required for istage = (1,2,3,[4]), and
+  // only if the term is used by a later stage.
+  if (estage < pdriver->nexp_stages && pdriver->imp_slot[istage-1] >= 0) {
+    int l = pdriver->imp_slot[istage-1];
     auto ui = pmhd->u0;
     auto un = phyd->u0;
     auto drag = drag_coeff;
@@ -241,33 +246,19 @@ TaskStatus IonNeutral::ImpRKUpdate(Driver *pdriver, int estage) {
     par_for("imex_rup",DevExeSpace(),0,nmb1,0,(n3-1),0,(n2-1),0,(n1-1),
     KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
       // drag term in IM1 component of ion momentum
-      ru_(s,m,0,k,j,i) = drag*(ui(m,IDN,k,j,i)*un(m,IM1,k,j,i) -
+      ru_(l,m,0,k,j,i) = drag*(ui(m,IDN,k,j,i)*un(m,IM1,k,j,i) -
                               un(m,IDN,k,j,i)*ui(m,IM1,k,j,i)) +
                               xi*un(m,IM1,k,j,i) - alpha*ui(m,IDN,k,j,i)*ui(m,IM1,k,j,i);
       // drag term in IM2 component of ion momentum
-      ru_(s,m,1,k,j,i) = drag*(ui(m,IDN,k,j,i)*un(m,IM2,k,j,i) -
+      ru_(l,m,1,k,j,i) = drag*(ui(m,IDN,k,j,i)*un(m,IM2,k,j,i) -
                               un(m,IDN,k,j,i)*ui(m,IM2,k,j,i)) +
                               xi*un(m,IM2,k,j,i) - alpha*ui(m,IDN,k,j,i)*ui(m,IM2,k,j,i);
       // drag term in IM3 component of ion momentum
-      ru_(s,m,2,k,j,i) = drag*(ui(m,IDN,k,j,i)*un(m,IM3,k,j,i) -
+      ru_(l,m,2,k,j,i) = drag*(ui(m,IDN,k,j,i)*un(m,IM3,k,j,i) -
                               un(m,IDN,k,j,i)*ui(m,IM3,k,j,i)) +
                               xi*un(m,IM3,k,j,i) - alpha*ui(m,IDN,k,j,i)*ui(m,IM3,k,j,i);
-      // drag term in IM1 component of neutral momentum
-      ru_(s,m,3,k,j,i) = drag*(un(m,IDN,k,j,i)*ui(m,IM1,k,j,i) -
-                              ui(m,IDN,k,j,i)*un(m,IM1,k,j,i)) -
-                              xi*un(m,IM1,k,j,i) + alpha*ui(m,IDN,k,j,i)*ui(m,IM1,k,j,i);
-      // drag term in IM2 component of neutral momentum
-      ru_(s,m,4,k,j,i) = drag*(un(m,IDN,k,j,i)*ui(m,IM2,k,j,i) -
-                              ui(m,IDN,k,j,i)*un(m,IM2,k,j,i)) -
-                              xi*un(m,IM2,k,j,i) + alpha*ui(m,IDN,k,j,i)*ui(m,IM2,k,j,i);
-      // drag term in IM3 component of neutral momentum
-      ru_(s,m,5,k,j,i) = drag*(un(m,IDN,k,j,i)*ui(m,IM3,k,j,i) -
-                              ui(m,IDN,k,j,i)*un(m,IM3,k,j,i)) -
-                              xi*un(m,IM3,k,j,i) + alpha*ui(m,IDN,k,j,i)*ui(m,IM3,k,j,i);
       // drag term in IDN component of ion momentum
-      ru_(s,m,6,k,j,i) = xi*un(m,IDN,k,j,i) - alpha*ui(m,IDN,k,j,i)*ui(m,IDN,k,j,i);
-      // drag term in IDN component of neutral momentum
-      ru_(s,m,7,k,j,i) =-xi*un(m,IDN,k,j,i) + alpha*ui(m,IDN,k,j,i)*ui(m,IDN,k,j,i);
+      ru_(l,m,3,k,j,i) = xi*un(m,IDN,k,j,i) - alpha*ui(m,IDN,k,j,i)*ui(m,IDN,k,j,i);
     });
   }
 
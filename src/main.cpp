@@ -29,6 +29,8 @@
 #include <string>
 #include <memory>
 #include <cstdio> // sscanf
+#include <sstream>
+#include <vector>
 
 // Athena headers
 #include "athena.hpp"
@@ -37,7 +39,10 @@
 #include "parameter_input.hpp"
 #include "mesh/mesh.hpp"
 #include "outputs/outputs.hpp"
+#include "outputs/ic_cache.hpp"
 #include "driver/driver.hpp"
+#include "driver/device_binding.hpp"
+#include "driver/memory_tracker.hpp"
 
 // MPI/OpenMP headers
 #if MPI_PARALLEL_ENABLED
@@ -74,7 +79,7 @@ int main(int argc, char *argv[]) {
   // documentation.
   (void) hipInit(0);
 #endif
-#if OPENMP_PARALLEL_ENABLED
+#if OPENMP_PARALLEL_ENABLED || MPI_PROGRESS_ENABLED
   int mpiprv;
   if (MPI_SUCCESS != MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &mpiprv)) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
@@ -83,7 +88,8 @@ int main(int argc, char *argv[]) {
   }
   if (mpiprv != MPI_THREAD_MULTIPLE) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
-              << "MPI_THREAD_MULTIPLE must be supported for hybrid parallelzation. "
+              << "MPI_THREAD_MULTIPLE must be supported for hybrid parallelzation "
+              << "or MPI progress thread. "
               << MPI_THREAD_MULTIPLE << " : " << mpiprv
               << std::endl;
     MPI_Finalize();
@@ -95,8 +101,10 @@ int main(int argc, char *argv[]) {
               << "MPI Initialization failed." << std::endl;
     return(0);
   }
-#endif  // OPENMP_PARALLEL_ENABLED
-  // Get process id (rank) in MPI_COMM_WORLD
+#endif  // OPENMP_PARALLEL_ENABLED || MPI_PROGRESS_ENABLED
+  // Get process id (rank) in MPI_COMM_WORLD.  All ranks share one Mesh unless they are
+  // split into ensemble members below
+  global_variable::mpi_comm = MPI_COMM_WORLD;
   if (MPI_SUCCESS != MPI_Comm_rank(MPI_COMM_WORLD, &(global_variable::my_rank))) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
               << "MPI_Comm_rank failed." << std::endl;
@@ -116,6 +124,9 @@ int main(int argc, char *argv[]) {
   global_variable::nranks  = 1;
 #endif  // MPI_PARALLEL_ENABLED
 
+  // Select GPU and bind host threads of this rank, which must be done before Kokkos is
+  // initialized
+  device_binding::SelectDevice(argc, argv);
   Kokkos::initialize(argc, argv);
 
   //--- Step 2. --------------------------------------------------------------------------
@@ -167,6 +178,9 @@ int main(int argc, char *argv[]) {
         case 'm':
           marg_flag = true;
           break;
+        case 'e':                      // -e <nmembers>
+          global_variable::nmembers = std::atoi(argv[++i]);
+          break;
         case 't':                      // -t <hh:mm:ss>
           int wth, wtm, wts;
           std::sscanf(argv[++i], "%d:%d:%d", &wth, &wtm, &wts);
@@ -194,6 +208,7 @@ int main(int argc, char *argv[]) {
             std::cout << "  -c              show configuration and quit\n";
             std::cout << "  -m              output mesh structure and quit\n";
             std::cout << "  -t hh:mm:ss     wall time limit for final output\n";
+            std::cout << "  -e <n>          run n independent ensemble members\n";
             std::cout << "  -h              this help\n";
             ShowConfig();
           }
@@ -207,6 +222,39 @@ int main(int argc, char *argv[]) {
     } // else if argv[i] not of form "-?" ignore it here (tested in ModifyFromCmdline)
   }
 
+  // Split ranks into nmembers groups of equal size, each of which runs an independent
+  // Mesh (an ensemble member) in its own subdirectory member<m> of the run directory,
+  // with the input parameters modified by <ensemble>/member<m> (see below)
+  if (global_variable::nmembers != 1) {
+    int nmem = global_variable::nmembers;
+#if MPI_PARALLEL_ENABLED
+    if (nmem < 1 || (global_variable::nranks % nmem) != 0) {
+      if (global_variable::my_rank == 0) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "Number of ranks (" << global_variable::nranks
+                  << ") is not a multiple of number of ensemble members -e " << nmem
+                  << std::endl;
+      }
+      Kokkos::finalize();
+      MPI_Finalize();
+      return(0);
+    }
+    global_variable::my_member = global_variable::my_rank/(global_variable::nranks/nmem);
+    MPI_Comm_split(MPI_COMM_WORLD, global_variable::my_member, global_variable::my_rank,
+                   &global_variable::mpi_comm);
+    MPI_Comm_rank(global_variable::mpi_comm, &global_variable::my_rank);
+    MPI_Comm_size(global_variable::mpi_comm, &global_variable::nranks);
+    run_dir = (run_dir.empty()? "" : run_dir + "/") + "member"
+              + std::to_string(global_variable::my_member);
+#else
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Ensemble runs (-e " << nmem << ") require MPI, with at "
+              << "least one rank per member" << std::endl;
+    Kokkos::finalize();
+    return(0);
+#endif
+  }
+
   // print error if input or restart file not given
   if (restart_file.empty() && input_file.empty()) {
     // no input file is given
@@ -244,6 +292,21 @@ int main(int argc, char *argv[]) {
   }
   pinput->ModifyFromCmdline(argc, argv);
 
+  // Apply changes to input parameters of this ensemble member, given in the same form as
+  // on the command line, e.g. <ensemble>/member1 = "hydro/gamma=1.4 problem/amp=1.0e-4"
+  if (global_variable::nmembers > 1) {
+    std::string member = "member" + std::to_string(global_variable::my_member);
+    if (pinput->DoesParameterExist("ensemble", member)) {
+      std::istringstream changes(pinput->GetString("ensemble", member));
+      std::vector<std::string> args(1);
+      std::string arg;
+      while (changes >> arg) {args.push_back(arg);}
+      std::vector<char*> argp;
+      for (auto &a : args) {argp.push_back(&a[0]);}
+      pinput->ModifyFromCmdline(static_cast<int>(argp.size()), argp.data());
+    }
+  }
+
   // Dump input parameters and quit if code was run with -n option.
   if (narg_flag) {
     if (global_variable::my_rank == 0) pinput->ParameterDump(std::cout);
@@ -256,22 +319,43 @@ int main(int argc, char *argv[]) {
     return(0);
   }
 
+  // With <problem>/ic_cache, new runs read the initial data from the cache file written
+  // by an earlier run with the same parameters, as from a restart file, if it exists.
+  std::string ic_file;
+  bool ic_found = false;
+  if (!res_flag) {
+    ic_file = ic_cache::FileName(pinput);
+    ic_found = ic_cache::Open(ic_file, restartfile);
+  }
+
+  // Report placement of ranks on nodes, GPUs and CPUs, if requested.
+  device_binding::Report(pinput);
+
+  // Start accounting of device memory before any arrays are allocated, if requested.
+  if (pinput->GetOrAddBoolean("job", "memory_report", false)) {
+    memory_tracker::Enable(pinput);
+  }
+
   //--- Step 4. --------------------------------------------------------------------------
   // Construct Mesh.  Then build MeshBlockTree and add MeshBlockPack containing MeshBlocks
   // on this rank.  Latter cannot be performed in Mesh constructor since it requires
   // pointer to Mesh.
 
-  Mesh* pmesh = new Mesh(pinput);
-  if (!res_flag) {
-    pmesh->BuildTreeFromScratch(pinput);
-  } else {
-    pmesh->BuildTreeFromRestart(pinput, restartfile);
+  Mesh* pmesh;
+  {
+    memory_tracker::Scope mem_scope("mesh");
+    pmesh = new Mesh(pinput);
+    if (!res_flag && !ic_found) {
+      pmesh->BuildTreeFromScratch(pinput);
+    } else {
+      pmesh->BuildTreeFromRestart(pinput, restartfile);
+    }
   }
 
   //  If code was run with -m option, write mesh structure to file and quit.
   if (marg_flag) {
     if (global_variable::my_rank == 0) {pmesh->WriteMeshStructure();}
-    if (res_flag) {restartfile.Close();}
+    if (res_flag || ic_found) {restartfile.Close();}
     delete pmesh;
     delete pinput;
     Kokkos::finalize();
@@ -287,9 +371,10 @@ int main(int argc, char *argv[]) {
   // is fully constructed.
 
   pmesh->AddCoordinatesAndPhysics(pinput);
-  if (!res_flag) {
+  if (!res_flag && !ic_found) {
     // set ICs using ProblemGenerator constructor for new runs
     pmesh->pgen = std::make_unique<ProblemGenerator>(pinput, pmesh);
+    if (!ic_file.empty()) {ic_cache::Write(pinput, pmesh, ic_file);}
   } else {
     // read ICs from restart file using ProblemGenerator constructor for restarts
     pmesh->pgen = std::make_unique<ProblemGenerator>(pinput, pmesh, restartfile);
@@ -302,7 +387,11 @@ int main(int argc, char *argv[]) {
 
   ChangeRunDir(run_dir);
   Driver* pdriver = new Driver(pinput, pmesh, wtlim, &timer);
-  Outputs* pout = new Outputs(pinput, pmesh);
+  Outputs* pout;
+  {
+    memory_tracker::Scope mem_scope("outputs");
+    pout = new Outputs(pinput, pmesh);
+  }
 
   //--- Step 7. --------------------------------------------------------------------------
   // Execute Driver.
@@ -311,6 +400,7 @@ int main(int argc, char *argv[]) {
   //    3. Any final analysis or diagnostics run in Driver::Finalize()
 
   pdriver->Initialize(pmesh, pinput, pout, res_flag);
+  memory_tracker::Report("at startup", pmesh);
   pdriver->Execute(pmesh, pinput, pout);
   pdriver->Finalize(pmesh, pinput, pout);
 
@@ -322,6 +412,7 @@ int main(int argc, char *argv[]) {
   delete pdriver;
   delete pmesh;
   delete pinput;
+  memory_tracker::Disable();
   Kokkos::finalize();
 #if MPI_PARALLEL_ENABLED
   MPI_Finalize();
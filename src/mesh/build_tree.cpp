@@ -16,6 +16,7 @@
 #include "parameter_input.hpp"
 #include "mesh.hpp"
 #include "coordinates/cell_locations.hpp"
+#include "diffusion/sts.hpp"
 #include "hydro/hydro.hpp"
 #include "mhd/mhd.hpp"
 
@@ -23,6 +24,27 @@
 #include <mpi.h>
 #endif
 
+//----------------------------------------------------------------------------------------
+//! \fn std::int32_t FirstLocationAbove()
+//! \brief Returns smallest l in [lmin,nlx) such that left edge of MeshBlock l+1 of nlx
+//! MeshBlocks spanning [xmin,xmax] is > x (or >= x if inclusive), or nlx if there is
+//! none.  Uses bisection, since nlx can be as large as 2^31 with many levels.
+
+static std::int32_t FirstLocationAbove(std::int32_t lmin, std::int32_t nlx, Real xmin,
+                                       Real xmax, Real x, bool inclusive) {
+  std::int32_t lo = lmin, hi = nlx;
+  while (lo < hi) {
+    std::int32_t mid = lo + (hi - lo)/2;
+    Real xl = LeftEdgeX(mid+1, nlx, xmin, xmax);
+    if (xl > x || (inclusive && xl == x)) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  return lo;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void Mesh::BuildTreeFromScratch():
 //! Constructs MeshBlockTree, creates MeshBlockPack (containing the physics modules), and
@@ -78,19 +100,20 @@ void Mesh::BuildTreeFromScratch(ParameterInput *pin) {
     // Expand MeshBlockTree to include "refinement" regions specified in input file:
     for (auto it = pin->block.begin(); it != pin->block.end(); ++it) {
       if (it->block_name.compare(0, 10, "refinement") == 0) {
+        // (refinement regions are given in physical coordinates)
         RegionSize ref_size;
-        ref_size.x1min = pin->GetReal(it->block_name, "x1min");
-        ref_size.x1max = pin->GetReal(it->block_name, "x1max");
+        ref_size.x1min = stretch.Xi(0, pin->GetReal(it->block_name, "x1min"));
+        ref_size.x1max = stretch.Xi(0, pin->GetReal(it->block_name, "x1max"));
         if (multi_d) {
-          ref_size.x2min = pin->GetReal(it->block_name, "x2min");
-          ref_size.x2max = pin->GetReal(it->block_name, "x2max");
+          ref_size.x2min = stretch.Xi(1, pin->GetReal(it->block_name, "x2min"));
+          ref_size.x2max = stretch.Xi(1, pin->GetReal(it->block_name, "x2max"));
         } else {
           ref_size.x2min = mesh_size.x2min;
           ref_size.x2max = mesh_size.x2max;
         }
         if (three_d) {
-          ref_size.x3min = pin->GetReal(it->block_name, "x3min");
-          ref_size.x3max = pin->GetReal(it->block_name, "x3max");
+          ref_size.x3min = stretch.Xi(2, pin->GetReal(it->block_name, "x3min"));
+          ref_size.x3max = stretch.Xi(2, pin->GetReal(it->block_name, "x3max"));
         } else {
           ref_size.x3min = mesh_size.x3min;
           ref_size.x3max = mesh_size.x3max;
@@ -130,7 +153,6 @@ void Mesh::BuildTreeFromScratch(ParameterInput *pin) {
           std::exit(EXIT_FAILURE);
         }
 
-        // note: if following is too slow, it could be replaced with bi-section search.
         // Suppose entire root domain is tiled with MeshBlocks at the desired refinement
         // level. Find range of x1-integer indices of such MeshBlocks that cover the
         // refinement region
@@ -138,30 +160,20 @@ void Mesh::BuildTreeFromScratch(ParameterInput *pin) {
         std::int32_t lx2min = 0, lx2max = 0;
         std::int32_t lx3min = 0, lx3max = 0;
         std::int32_t lxmax = nmb_rootx1*(1<<phy_ref_lev);
-        for (lx1min=0; lx1min<lxmax; lx1min++) {
-          if (LeftEdgeX(lx1min+1,lxmax,mesh_size.x1min,mesh_size.x1max) > ref_size.x1min)
-            break;
-        }
-        for (lx1max=lx1min; lx1max<lxmax; lx1max++) {
-          if (LeftEdgeX(lx1max+1,lxmax,mesh_size.x1min,mesh_size.x1max) >= ref_size.x1max)
-            break;
-        }
+        lx1min = FirstLocationAbove(0, lxmax, mesh_size.x1min, mesh_size.x1max,
+                                    ref_size.x1min, false);
+        lx1max = FirstLocationAbove(lx1min, lxmax, mesh_size.x1min, mesh_size.x1max,
+                                    ref_size.x1max, true);
         if (lx1min % 2 == 1) lx1min--;
         if (lx1max % 2 == 0) lx1max++;
 
         // Find range of x2-indices of such MeshBlocks that cover the refinement region
         if (multi_d) { // 2D or 3D
           lxmax = nmb_rootx2*(1<<phy_ref_lev);
-          for (lx2min=0; lx2min<lxmax; lx2min++) {
-            if (LeftEdgeX(lx2min+1, lxmax, mesh_size.x2min, mesh_size.x2max) >
-                ref_size.x2min)
-            break;
-          }
-          for (lx2max=lx2min; lx2max<lxmax; lx2max++) {
-            if (LeftEdgeX(lx2max+1, lxmax, mesh_size.x2min, mesh_size.x2max) >=
-                ref_size.x2max)
-            break;
-          }
+          lx2min = FirstLocationAbove(0, lxmax, mesh_size.x2min, mesh_size.x2max,
+                                      ref_size.x2min, false);
+          lx2max = FirstLocationAbove(lx2min, lxmax, mesh_size.x2min, mesh_size.x2max,
+                                      ref_size.x2max, true);
           if (lx2min % 2 == 1) lx2min--;
           if (lx2max % 2 == 0) lx2max++;
         }
@@ -169,16 +181,10 @@ void Mesh::BuildTreeFromScratch(ParameterInput *pin) {
         // Find range of x3-indices of such MeshBlocks that cover the refinement region
         if (three_d) { // 3D
           lxmax = nmb_rootx3*(1<<phy_ref_lev);
-          for (lx3min=0; lx3min<lxmax; lx3min++) {
-            if (LeftEdgeX(lx3min+1, lxmax, mesh_size.x3min, mesh_size.x3max) >
-                ref_size.x3min)
-            break;
-          }
-          for (lx3max=lx3min; lx3max<lxmax; lx3max++) {
-            if (LeftEdgeX(lx3max+1, lxmax, mesh_size.x3min, mesh_size.x3max) >=
-                ref_size.x3max)
-            break;
-          }
+          lx3min = FirstLocationAbove(0, lxmax, mesh_size.x3min, mesh_size.x3max,
+                                      ref_size.x3min, false);
+          lx3max = FirstLocationAbove(lx3min, lxmax, mesh_size.x3min, mesh_size.x3max,
+                                      ref_size.x3max, true);
           if (lx3min % 2 == 1) lx3min--;
           if (lx3max % 2 == 0) lx3max++;
         }
@@ -304,6 +310,9 @@ void Mesh::BuildTreeFromScratch(ParameterInput *pin) {
   time = pin->GetOrAddReal("time", "start_time", 0.0);
   dt   = std::numeric_limits<float>::max();
   cfl_no = pin->GetReal("time", "cfl_number");
+  sts_integrator = STSIntegratorFromString(pin->GetOrAddString("time", "sts_integrator",
+                                                               "none"));
+  report_level_dt = pin->GetOrAddBoolean("time", "report_level_dt", false);
   ncycle = 0;
   if (global_variable::my_rank == 0) {PrintMeshDiagnostics();}
 
@@ -338,7 +347,7 @@ void Mesh::BuildTreeFromRestart(ParameterInput *pin, IOWrapper &resfile) {
 
 #if MPI_PARALLEL_ENABLED
   // then broadcast the header data
-  MPI_Bcast(headerdata, headersize, MPI_CHAR, 0, MPI_COMM_WORLD);
+  MPI_Bcast(headerdata, headersize, MPI_CHAR, 0, global_variable::mpi_comm);
 #endif
 
   // Now copy mesh data read from restart file into Mesh variables. Order of variables
@@ -402,7 +411,7 @@ void Mesh::BuildTreeFromRestart(ParameterInput *pin, IOWrapper &resfile) {
   }
 #if MPI_PARALLEL_ENABLED
   // then broadcast the ID list
-  MPI_Bcast(idlist, listsize*nmb_total, MPI_CHAR, 0, MPI_COMM_WORLD);
+  MPI_Bcast(idlist, listsize*nmb_total, MPI_CHAR, 0, global_variable::mpi_comm);
 #endif
 
   // everyone sets the logical location and cost lists based on bradcasted data
@@ -419,6 +428,36 @@ void Mesh::BuildTreeFromRestart(ParameterInput *pin, IOWrapper &resfile) {
   delete [] idlist;
   if (!adaptive) max_level = current_level;
 
+  // Newer restart files also store the partition of MeshBlocks over ranks (gid of first
+  // MeshBlock on each rank) used by the run that wrote them.  On the same number of ranks
+  // it is reused, so each rank reads the same contiguous range of MeshBlocks as was
+  // written, and a distribution set by (incremental) load balancing with AMR is kept.
+  // On a different number of ranks, or with <mesh>/restart_rebalance=true, the
+  // MeshBlocks are redistributed by LoadBalance() from the stored costs.
+  int nranks_file = 0;
+  if (global_variable::my_rank == 0) {
+    IOWrapperSizeT pos = resfile.GetPosition();
+    std::uint64_t tag = 0;
+    if (resfile.Read_bytes(&tag, sizeof(std::uint64_t), 1) == 1 &&
+        tag == restart_partition_tag &&
+        resfile.Read_bytes(&nranks_file, sizeof(int), 1) == 1) {
+      if (nranks_file == global_variable::nranks) {
+        resfile.Read_bytes(gids_eachrank, sizeof(int), nranks_file);
+      } else {
+        resfile.Seek(resfile.GetPosition() + nranks_file*sizeof(int));
+      }
+    } else {
+      // older file without partition
+      nranks_file = 0;
+      resfile.Seek(pos);
+    }
+  }
+#if MPI_PARALLEL_ENABLED
+  MPI_Bcast(&nranks_file, 1, MPI_INT, 0, global_variable::mpi_comm);
+#endif
+  bool reuse_partition = (nranks_file == global_variable::nranks) &&
+                         !(pin->GetOrAddBoolean("mesh", "restart_rebalance", false));
+
   // rebuild the MeshBlockTree
   ptree = std::make_unique<MeshBlockTree>(this);
   ptree->CreateRootGrid();
@@ -447,7 +486,19 @@ void Mesh::BuildTreeFromRestart(ParameterInput *pin, IOWrapper &resfile) {
   }
 #endif
 
-  LoadBalance(cost_eachmb, rank_eachmb, gids_eachrank, nmb_eachrank, nmb_total);
+  if (reuse_partition) {
+#if MPI_PARALLEL_ENABLED
+    MPI_Bcast(gids_eachrank, global_variable::nranks, MPI_INT, 0,
+              global_variable::mpi_comm);
+#endif
+    for (int n=0; n<global_variable::nranks; ++n) {
+      int gide = (n < global_variable::nranks - 1)? gids_eachrank[n+1] : nmb_total;
+      nmb_eachrank[n] = gide - gids_eachrank[n];
+      for (int m=gids_eachrank[n]; m<gide; ++m) {rank_eachmb[m] = n;}
+    }
+  } else {
+    LoadBalance(cost_eachmb, rank_eachmb, gids_eachrank, nmb_eachrank, nmb_total);
+  }
 
   // create MeshBlockPack for this rank
   int mbp_gids = gids_eachrank[global_variable::my_rank];
@@ -486,5 +537,8 @@ void Mesh::BuildTreeFromRestart(ParameterInput *pin, IOWrapper &resfile) {
 
   // set remaining parameters, output diagnostics
   cfl_no = pin->GetReal("time", "cfl_number");
+  sts_integrator = STSIntegratorFromString(pin->GetOrAddString("time", "sts_integrator",
+                                                               "none"));
+  report_level_dt = pin->GetOrAddBoolean("time", "report_level_dt", false);
   if (global_variable::my_rank == 0) {PrintMeshDiagnostics();}
 }
@@ -7,24 +7,239 @@
 //! \brief Contains various Mesh and MeshRefinement functions associated with
 //! load balancing when MPI is used, both for uniform grids and with SMR/AMR.
 
+#include <cstdlib>
 #include <iostream>
 #include <limits> // numeric_limits<>
 #include <algorithm> // max
+#include <sstream>
+#include <string>
 #include <utility> // make_pair
+#include <vector>
 
 #include "athena.hpp"
 #include "globals.hpp"
+#include "parameter_input.hpp"
 #include "mesh.hpp"
 #include "hydro/hydro.hpp"
 #include "mhd/mhd.hpp"
 #include "z4c/z4c.hpp"
+#include "particles/particles.hpp"
+#include "driver/comm_stats.hpp"
 
 #if MPI_PARALLEL_ENABLED
 #include <mpi.h>
 #endif
 
 //----------------------------------------------------------------------------------------
-//! \fn void Mesh::LoadBalance(double *clist, int *rlist, int *slist, int *nlist, int nb)
+//! \fn void PartitionCostList()
+//! \brief Splits elements [is,ie) of cost list into np=wght.size() contiguous parts
+//! that minimize the maximum over parts p of (cost of part)/wght[p], with each part
+//! containing at least nmin[p] elements.  Stores index of part (0,...,np-1) of each
+//! element in plist[is,...,ie-1].  Uses bisection on the maximum cost, with parts
+//! filled from the end of the list (as in greedy algorithm) so master rank has less load.
+
+static void PartitionCostList(const float *clist, int is, int ie,
+                              const std::vector<int> &nmin,
+                              const std::vector<double> &wght, int *plist) {
+  int np = static_cast<int>(wght.size());
+  std::vector<int> minrem(np+1, 0);  // minimum # of elements needed by parts [0,p)
+  for (int p=0; p<np; ++p) {minrem[p+1] = minrem[p] + nmin[p];}
+
+  // fill parts from the end with maximum cost per unit weight cmax, returns the
+  // actual maximum cost per unit weight of resulting partition
+  auto fill = [&](double cmax) {
+    int p = np - 1, cnt = 0;
+    double sum = 0.0, worst = 0.0;
+    for (int i=ie-1; i>=is; --i) {
+      int nleft = i - is + 1;
+      if ((p > 0) && (cnt >= nmin[p]) &&
+          ((sum + clist[i] > cmax*wght[p]) || (nleft == minrem[p]))) {
+        worst = std::max(worst, sum/wght[p]);
+        p--;
+        cnt = 0;
+        sum = 0.0;
+      }
+      plist[i] = p;
+      sum += clist[i];
+      cnt++;
+    }
+    return std::max(worst, sum/wght[p]);
+  };
+
+  double lo = 0.0, hi = 0.0, wtot = 0.0, wmin = wght[0];
+  for (int i=is; i<ie; ++i) {hi += clist[i];}
+  for (int p=0; p<np; ++p) {
+    wtot += wght[p];
+    wmin = std::min(wmin, wght[p]);
+  }
+  lo = hi/wtot;
+  for (int i=is; i<ie; ++i) {lo = std::max(lo, static_cast<double>(clist[i])/wtot);}
+  hi /= wmin;
+  double best = hi;
+  for (int iter=0; iter<50 && (hi - lo) > 1.0e-6*hi; ++iter) {
+    double mid = 0.5*(lo + hi);
+    double c = fill(mid);
+    best = std::min(best, c);
+    if (c <= mid) {
+      hi = mid;
+    } else {
+      lo = mid;
+    }
+  }
+  // recompute partition for the smallest bound shown to be feasible
+  (void) fill(std::max(hi, best));
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void IncrementalPartition()
+//! \brief Starting from current (contiguous, ordered) rank of each of the nb elements of
+//! cost list, moves each boundary between ranks r-1 and r by the smallest number of
+//! elements needed for the cost of elements before the boundary to lie within
+//! +/- (tol/2)*mean of the target, so that the cost of every rank is within tol*mean of
+//! its share (up to the granularity of the list).  Boundaries already within this band
+//! are not moved, so no MBs migrate if the load is already balanced within tolerance.
+//! The target of boundary r is the total cost times the fraction of the summed weights
+//! wght of ranks [0,r), which is r*mean for equal weights.
+
+static void IncrementalPartition(const float *clist, int nb, const int *curr_rank,
+                                 float tol, const std::vector<double> &wght,
+                                 int *rlist) {
+  int nranks = global_variable::nranks;
+  std::vector<double> csum(nb+1, 0.0);  // csum[i] = cost of elements [0,i)
+  for (int i=0; i<nb; ++i) {csum[i+1] = csum[i] + clist[i];}
+  std::vector<double> wsum(nranks+1, 0.0);  // wsum[r] = weight of ranks [0,r)
+  for (int r=0; r<nranks; ++r) {wsum[r+1] = wsum[r] + wght[r];}
+  double mean = csum[nb]/nranks;
+  double band = 0.5*tol*mean;
+
+  // bnd[r] = index of first element on rank r
+  std::vector<int> bnd(nranks+1);
+  bnd[0] = 0;
+  bnd[nranks] = nb;
+  for (int r=1; r<nranks; ++r) {
+    int b = static_cast<int>(std::lower_bound(curr_rank, curr_rank+nb, r) - curr_rank);
+    double target = csum[nb]*wsum[r]/wsum[nranks];
+    if (csum[b] < target - band) {
+      // move boundary forward to first position inside band
+      b = static_cast<int>(std::lower_bound(csum.begin(), csum.end(), target - band)
+                           - csum.begin());
+      if ((b > 0) && (csum[b] > target + band) &&
+          (target - csum[b-1] <= csum[b] - target)) {b--;}
+    } else if (csum[b] > target + band) {
+      // move boundary backward to last position inside band
+      b = static_cast<int>(std::upper_bound(csum.begin(), csum.end(), target + band)
+                           - csum.begin()) - 1;
+      if ((b < nb) && (csum[b] < target - band) &&
+          (csum[b+1] - target < target - csum[b])) {b++;}
+    }
+    // every rank must keep at least one element
+    b = std::max(b, bnd[r-1] + 1);
+    b = std::min(b, nb - (nranks - r));
+    bnd[r] = b;
+  }
+  for (int r=0; r<nranks; ++r) {
+    for (int i=bnd[r]; i<bnd[r+1]; ++i) {rlist[i] = r;}
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::InitLoadBalance(ParameterInput *pin)
+//! \brief Reads algorithm used to partition MeshBlocks between ranks.  For node-aware
+//! partitioning, finds the number of ranks on each shared-memory node, which requires
+//! ranks on each node to be numbered contiguously (the default placement of most MPI
+//! launchers).  Otherwise falls back to partitioning between ranks.
+//! Also reads <mesh>/lb_rank_weights, the relative capacity of each rank used with any
+//! partition, as a comma-separated list with one value per rank (e.g. for ranks on
+//! different kinds of nodes), or "measured" to find them from the time spent by each
+//! rank with AMR (see MeshRefinement::UpdateRankWeights()).
+
+void Mesh::InitLoadBalance(ParameterInput *pin) {
+  std::string lb_wght = pin->GetOrAddString("mesh", "lb_rank_weights", "uniform");
+  if (lb_wght.compare("measured") == 0) {
+    if (!(adaptive)) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+         << std::endl << "<mesh>/lb_rank_weights=measured requires adaptive mesh "
+         << "refinement" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+  } else if (lb_wght.compare("uniform") != 0) {
+    std::stringstream str(lb_wght);
+    std::string token;
+    double wtot = 0.0;
+    while (std::getline(str, token, ',')) {
+      double w = std::atof(token.c_str());
+      if (!(w > 0.0)) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+           << std::endl << "<mesh>/lb_rank_weights must be positive" << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+      lb_rank_weight_.push_back(w);
+      wtot += w;
+    }
+    if (static_cast<int>(lb_rank_weight_.size()) != global_variable::nranks) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+         << std::endl << "<mesh>/lb_rank_weights has " << lb_rank_weight_.size()
+         << " entries but there are " << global_variable::nranks << " ranks. Valid "
+         << "choices are [uniform,measured] or one value per rank." << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    for (auto &w : lb_rank_weight_) {w *= global_variable::nranks/wtot;}
+  }
+
+  std::string lb_part = pin->GetOrAddString("mesh", "lb_partition", "greedy");
+  if (lb_part.compare("greedy") == 0) {
+    return;
+  } else if (lb_part.compare("incremental") == 0) {
+    lb_incremental_ = true;
+    lb_tolerance_ = pin->GetOrAddReal("mesh_refinement", "lb_tolerance", 0.1);
+  } else if ((lb_part.compare("optimal") != 0) && (lb_part.compare("node") != 0)) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+       << std::endl << "lb_partition=" << lb_part << " not implemented. "
+       << "Valid choices are [greedy,optimal,node,incremental]." << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  lb_optimal_ = true;
+
+#if MPI_PARALLEL_ENABLED
+  if (lb_part.compare("node") == 0) {
+    // label each node by smallest rank it contains
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(global_variable::mpi_comm, MPI_COMM_TYPE_SHARED,
+                        global_variable::my_rank, MPI_INFO_NULL, &node_comm);
+    int node_id;
+    MPI_Allreduce(&(global_variable::my_rank), &node_id, 1, MPI_INT, MPI_MIN, node_comm);
+    MPI_Comm_free(&node_comm);
+    std::vector<int> node_eachrank(global_variable::nranks);
+    MPI_Allgather(&node_id, 1, MPI_INT, node_eachrank.data(), 1, MPI_INT,
+                  global_variable::mpi_comm);
+
+    // count ranks on each node, checking that they are contiguous
+    bool contiguous = true;
+    for (int n=0; n<global_variable::nranks; ++n) {
+      if (n == 0 || node_eachrank[n] != node_eachrank[n-1]) {
+        if (node_eachrank[n] != n) {contiguous = false;}
+        lb_nranks_eachnode_.push_back(1);
+      } else {
+        lb_nranks_eachnode_.back()++;
+      }
+    }
+    if (!(contiguous)) {
+      lb_nranks_eachnode_.clear();
+      if (global_variable::my_rank == 0) {
+        std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "Ranks are not numbered contiguously on each node, "
+                  << "using lb_partition=optimal" << std::endl;
+      }
+    }
+  }
+#endif
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Mesh::LoadBalance()
 //! \brief Calculate distribution of MeshBlocks across ranks based on input cost list
 //! input: clist = cost of each MB (array of length nmbtotal)
 //!        nb = number of MeshBlocks
@@ -33,8 +248,19 @@
 //!         nlist = number of MBs on each rank (array of length nrank)
 //! With multiple ranks in MPI, this function is needed even on a uniform mesh and not
 //! just for SMR/AMR, which is why it is part of the Mesh and not MeshRefinement class.
+//! By default the Z-ordered list is split greedily.  With <mesh>/lb_partition=optimal
+//! the split minimizes the maximum cost on any rank, and with lb_partition=node the list
+//! is first split between nodes and then between ranks on each node, so that each node
+//! holds one contiguous (and therefore compact) section of the space-filling curve.
+//! With lb_partition=incremental and the current rank of each MB provided in curr_rank
+//! (after AMR), boundaries between ranks are only moved when needed to keep the cost
+//! of each rank within lb_tolerance of the mean, which limits the number of MBs that
+//! migrate.  Without curr_rank (initial mesh), the optimal partition is used.
+//! With <mesh>/lb_rank_weights, each rank (and node) receives a share of the total cost
+//! proportional to its weight (capacity) rather than an equal share.
 
-void Mesh::LoadBalance(float *clist, int *rlist, int *slist, int *nlist, int nb) {
+void Mesh::LoadBalance(float *clist, int *rlist, int *slist, int *nlist, int nb,
+                       const int *curr_rank) {
   float min_cost = std::numeric_limits<float>::max();
   float max_cost = 0.0, totalcost = 0.0;
   // find min/max and total cost in clist
@@ -44,29 +270,73 @@ void Mesh::LoadBalance(float *clist, int *rlist, int *slist, int *nlist, int nb)
     max_cost = std::max(max_cost,clist[i]);
   }
 
-  int j = (global_variable::nranks) - 1;
-  float targetcost = totalcost/global_variable::nranks;
-  float mycost = 0.0;
-  // create rank list from the end: the master MPI rank should have less load
-  for (int i=nb-1; i>=0; i--) {
-    if (targetcost == 0.0) {
+  int nranks = global_variable::nranks;
+  std::vector<double> wght(nranks);
+  for (int r=0; r<nranks; ++r) {wght[r] = RankWeight(r);}
+
+  if (lb_optimal_) {
+    if (nb < global_variable::nranks) {
       std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
                 << std::endl << "There is at least one process which has no MeshBlock"
                 << std::endl << "Decrease the number of processes or use smaller "
                 << "MeshBlocks." << std::endl;
       std::exit(EXIT_FAILURE);
     }
-    mycost += clist[i];
-    rlist[i] = j;
-    if (mycost >= targetcost && j>0) {
-      j--;
-      totalcost -= mycost;
-      mycost = 0.0;
-      targetcost = totalcost/(j+1);
+    if (lb_incremental_ && (curr_rank != nullptr)) {
+      IncrementalPartition(clist, nb, curr_rank, lb_tolerance_, wght, rlist);
+    } else if (lb_nranks_eachnode_.empty()) {
+      std::vector<int> nmin(nranks, 1);
+      PartitionCostList(clist, 0, nb, nmin, wght, rlist);
+    } else {
+      // first split list between nodes in proportion to the summed weights of their
+      // ranks, then split each chunk between ranks on that node
+      int nnode = static_cast<int>(lb_nranks_eachnode_.size());
+      std::vector<double> wnode(nnode, 0.0);
+      for (int k=0, r=0; k<nnode; ++k) {
+        for (int n=0; n<lb_nranks_eachnode_[k]; ++n, ++r) {wnode[k] += wght[r];}
+      }
+      PartitionCostList(clist, 0, nb, lb_nranks_eachnode_, wnode, rlist);
+      int is = 0, rank0 = 0;
+      for (int k=0; k<nnode; ++k) {
+        int ie = is;
+        while (ie < nb && rlist[ie] == k) {ie++;}
+        std::vector<int> nmin(lb_nranks_eachnode_[k], 1);
+        std::vector<double> w(wght.begin() + rank0,
+                              wght.begin() + rank0 + lb_nranks_eachnode_[k]);
+        PartitionCostList(clist, is, ie, nmin, w, rlist);
+        for (int i=is; i<ie; ++i) {rlist[i] += rank0;}
+        rank0 += lb_nranks_eachnode_[k];
+        is = ie;
+      }
+    }
+  } else {
+    int j = (global_variable::nranks) - 1;
+    double wrem = 0.0;  // summed weights of ranks [0,j]
+    for (int r=0; r<nranks; ++r) {wrem += wght[r];}
+    float targetcost = totalcost*wght[j]/wrem;
+    float mycost = 0.0;
+    // create rank list from the end: the master MPI rank should have less load
+    for (int i=nb-1; i>=0; i--) {
+      if (targetcost == 0.0) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "There is at least one process which has no MeshBlock"
+                  << std::endl << "Decrease the number of processes or use smaller "
+                  << "MeshBlocks." << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+      mycost += clist[i];
+      rlist[i] = j;
+      if (mycost >= targetcost && j>0) {
+        wrem -= wght[j];
+        j--;
+        totalcost -= mycost;
+        mycost = 0.0;
+        targetcost = totalcost*wght[j]/wrem;
+      }
     }
   }
   slist[0] = 0;
-  j = 0;
+  int j = 0;
   for (int i=1; i<nb; i++) { // make the list of nbstart and nblocks
     if (rlist[i] != rlist[i-1]) {
       nlist[j] = i-slist[j];
@@ -86,6 +356,176 @@ void Mesh::LoadBalance(float *clist, int *rlist, int *slist, int *nlist, int nb)
   return;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void MeshRefinement::UpdateMeasuredCosts()
+//! \brief Updates cost of each MeshBlock using time spent in the "stagen" TaskLists on
+//! this rank (lb_time) since the last update.  All MeshBlocks in a pack are updated by
+//! the same kernels, so time cannot be measured per MeshBlock.  Instead the mean time per
+//! cycle on each rank is divided equally between its MBs, and an exponentially-weighted
+//! running mean (with weight lb_smoothing) is stored in cost_eachmb.  Since the cost
+//! travels with each MB when it is moved, repeated rebalancing also separates expensive
+//! and cheap MBs.  Only entries of MBs on this rank are updated; they are shared with
+//! all ranks by ShareMeasuredCosts() only when the whole list is needed, which avoids an
+//! O(nmb_total) collective every time the mesh is checked.
+
+void MeshRefinement::UpdateMeasuredCosts() {
+  Mesh *pm = pmy_mesh;
+  if (lb_ncycle == 0) return;
+  int my_rank = global_variable::my_rank;
+  int nmb = pm->nmb_eachrank[my_rank];
+  int gids = pm->gids_eachrank[my_rank];
+  float cost = static_cast<float>(lb_time/(lb_ncycle*nmb));
+  for (int m=gids; m<(gids+nmb); ++m) {
+    if (cost_measured_) {
+      pm->cost_eachmb[m] = lb_smoothing*cost + (1.0 - lb_smoothing)*pm->cost_eachmb[m];
+    } else {
+      pm->cost_eachmb[m] = cost;
+    }
+  }
+  cost_measured_ = true;
+  costs_shared_ = false;
+  lb_time = 0.0;
+  lb_ncycle = 0;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshRefinement::ShareMeasuredCosts()
+//! \brief Copies measured cost of MBs on each rank into cost_eachmb on all ranks, so that
+//! every rank can compute the same load balance.  Does nothing if costs have not changed
+//! since they were last shared.  Must be called by all ranks.
+
+void MeshRefinement::ShareMeasuredCosts() {
+  if (costs_shared_) return;
+#if MPI_PARALLEL_ENABLED
+  Mesh *pm = pmy_mesh;
+  MPI_Allgatherv(MPI_IN_PLACE, pm->nmb_eachrank[global_variable::my_rank], MPI_FLOAT,
+                 pm->cost_eachmb, pm->nmb_eachrank, pm->gids_eachrank, MPI_FLOAT,
+                 global_variable::mpi_comm);
+#endif
+  costs_shared_ = true;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshRefinement::UpdateRankWeights()
+//! \brief Updates the capacity (weight) of each rank used by Mesh::LoadBalance() with
+//! <mesh>/lb_rank_weights=measured.  The throughput of each rank is the cost of its
+//! MeshBlocks processed per unit of time spent in the "stagen" TaskLists (lb_time) since
+//! the last update.  Throughputs are gathered from all ranks, normalized to a mean of
+//! one, and an exponentially-weighted running mean (with weight lb_smoothing) is stored.
+//! Must be called by all ranks.
+
+void MeshRefinement::UpdateRankWeights() {
+  Mesh *pm = pmy_mesh;
+  int nranks = global_variable::nranks;
+  if ((nranks == 1) || (lb_ncycle == 0)) return;
+  double rate = (lb_time > 0.0)? RankCost()*lb_ncycle/lb_time : 0.0;
+  std::vector<double> rate_eachrank(nranks, rate);
+#if MPI_PARALLEL_ENABLED
+  MPI_Allgather(&rate, 1, MPI_DOUBLE, rate_eachrank.data(), 1, MPI_DOUBLE,
+                global_variable::mpi_comm);
+#endif
+  lb_time = 0.0;
+  lb_ncycle = 0;
+  // skip update if time was not measured on every rank
+  double rtot = 0.0;
+  for (int r=0; r<nranks; ++r) {
+    if (!(rate_eachrank[r] > 0.0)) return;
+    rtot += rate_eachrank[r];
+  }
+
+  bool first = pm->lb_rank_weight_.empty();
+  if (first) {pm->lb_rank_weight_.assign(nranks, 1.0);}
+  for (int r=0; r<nranks; ++r) {
+    double w = rate_eachrank[r]*nranks/rtot;
+    pm->lb_rank_weight_[r] = (first)? w :
+                             lb_smoothing*w + (1.0 - lb_smoothing)*pm->lb_rank_weight_[r];
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn float MeshRefinement::RankCost()
+//! \brief Returns the total cost of the MeshBlocks on this rank.  With particles, the
+//! cost of the particles in each MeshBlock is included.
+
+float MeshRefinement::RankCost() {
+  Mesh *pm = pmy_mesh;
+  int nmb = pm->nmb_eachrank[global_variable::my_rank];
+  int gids = pm->gids_eachrank[global_variable::my_rank];
+  std::vector<float> cost(pm->cost_eachmb + gids, pm->cost_eachmb + gids + nmb);
+  if (pm->pmb_pack->ppart != nullptr) {
+    std::vector<int> nprtcl;
+    pm->pmb_pack->ppart->CountParticlesEachMB(nprtcl);
+    std::vector<int> nprtcl_rank(nprtcl.begin() + gids, nprtcl.begin() + gids + nmb);
+    AddParticleCosts(pm->cost_eachmb + gids, nprtcl_rank, nmb, cost.data());
+  }
+  float rank_cost = 0.0;
+  for (int m=0; m<nmb; ++m) {rank_cost += cost[m];}
+  return rank_cost;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool MeshRefinement::CheckForRebalance()
+//! \brief Returns true if total cost of MeshBlocks on the most expensive rank exceeds the
+//! mean cost per rank by more than lb_tolerance.  Each rank sums the cost of its own
+//! MeshBlocks, and the maximum and total are found with reductions, so the same result
+//! is returned on all ranks without sharing the cost of every MeshBlock.  With
+//! particles, the cost of the particles in each MeshBlock is included.  With rank
+//! weights, the cost of each rank is divided by its weight (which has a mean of one).
+
+bool MeshRefinement::CheckForRebalance() {
+  Mesh *pm = pmy_mesh;
+  if ((global_variable::nranks == 1) || (lb_tolerance <= 0.0)) return false;
+
+  float rank_cost = RankCost();
+  float total_cost = rank_cost;
+  float max_cost = rank_cost;
+  if (!(pm->lb_rank_weight_.empty())) {
+    max_cost /= static_cast<float>(pm->lb_rank_weight_[global_variable::my_rank]);
+  }
+#if MPI_PARALLEL_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE, &max_cost, 1, MPI_FLOAT, MPI_MAX,
+                global_variable::mpi_comm);
+  MPI_Allreduce(MPI_IN_PLACE, &total_cost, 1, MPI_FLOAT, MPI_SUM,
+                global_variable::mpi_comm);
+#endif
+  float mean_cost = total_cost/static_cast<float>(global_variable::nranks);
+  return (max_cost > (1.0 + lb_tolerance)*mean_cost);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshRefinement::AddParticleCosts()
+//! \brief Stores in clist the cost of each of the nmb MeshBlocks including the particles
+//! they contain: cost*(1 + lb_prtcl_cost*nprtcl/ncells), where cost is the (uniform or
+//! measured) cost of the cells and nprtcl the number of particles in each MB.
+
+void MeshRefinement::AddParticleCosts(const float *cost, const std::vector<int> &nprtcl,
+                                      int nmb, float *clist) {
+  auto &indcs = pmy_mesh->mb_indcs;
+  float weight = static_cast<float>(lb_prtcl_cost/(indcs.nx1*indcs.nx2*indcs.nx3));
+  for (int m=0; m<nmb; ++m) {
+    clist[m] = cost[m]*(1.0 + weight*static_cast<float>(nprtcl[m]));
+  }
+  return;
+}
+
+#if MPI_PARALLEL_ENABLED
+//----------------------------------------------------------------------------------------
+//! \fn void GrowAMRBuffer()
+//! \brief Reallocates an array used to communicate MeshBlocks during load balancing only
+//! when it holds fewer than n elements, and then with capacity headroom*n.  Avoids
+//! freeing and allocating (possibly large) device memory at every AMR step.
+
+template <typename ViewType>
+static void GrowAMRBuffer(ViewType &a, int n, Real headroom) {
+  if (static_cast<int>(a.extent(0)) < n) {
+    Kokkos::realloc(a, std::max(n, static_cast<int>(headroom*static_cast<Real>(n))));
+  }
+}
+#endif
+
 //----------------------------------------------------------------------------------------
 //! \fn void MeshRefinement::InitRecvAMR()
 //! \brief Allocates and initializes receive buffers, and posts non-blocking receives,
@@ -127,7 +567,7 @@ void MeshRefinement::InitRecvAMR(int nleaf) {
   if (nmb_recv == 0) return;  // nothing to do
 
   // allocate array of recv buffers
-  Kokkos::realloc(recvbuf, nmb_recv);
+  GrowAMRBuffer(recvbuf, nmb_recv, amr_buf_headroom);
   recv_req = new MPI_Request[nmb_recv];
   for (int n=0; n<nmb_recv; ++n) {
     recv_req[n] = MPI_REQUEST_NULL;
@@ -253,12 +693,12 @@ void MeshRefinement::InitRecvAMR(int nleaf) {
       }
     }
   }
-  // Sync dual array, reallocate receive data array
+  // Sync dual array, grow receive data array if needed
   recvbuf.template modify<HostMemSpace>();
   recvbuf.template sync<DevExeSpace>();
   {
     int ndata = recvbuf.h_view((nmb_recv-1)).offset + recvbuf.h_view((nmb_recv-1)).cnt;
-    Kokkos::realloc(recv_data, ndata);
+    GrowAMRBuffer(recv_data, ndata, amr_buf_headroom);
   }
 
   // Step 3. (InitRecvAMR)
@@ -377,7 +817,7 @@ void MeshRefinement::PackAndSendAMR(int nleaf) {
   if (nmb_send == 0) return;  // nothing to do
 
   // allocate array of send buffers
-  Kokkos::realloc(sendbuf, nmb_send);
+  GrowAMRBuffer(sendbuf, nmb_send, amr_buf_headroom);
   send_req = new MPI_Request[nmb_send];
   for (int n=0; n<nmb_send; ++n) {
     send_req[n] = MPI_REQUEST_NULL;
@@ -505,12 +945,12 @@ void MeshRefinement::PackAndSendAMR(int nleaf) {
       }
     }
   }
-  // Sync dual array, reallocate send data array
+  // Sync dual array, grow send data array if needed
   sendbuf.template modify<HostMemSpace>();
   sendbuf.template sync<DevExeSpace>();
   {
     int ndata = sendbuf.h_view((nmb_send-1)).offset + sendbuf.h_view((nmb_send-1)).cnt;
-    Kokkos::realloc(send_data, ndata);
+    GrowAMRBuffer(send_data, ndata, amr_buf_headroom);
   }
 
   // Step 3. (PackAndSendAMR)
@@ -557,6 +997,8 @@ void MeshRefinement::PackAndSendAMR(int nleaf) {
           int lid = (newm + l) - new_gids_eachrank[new_rank_eachmb[newm+l]];
           int tag = CreateAMR_MPI_Tag(lid, 0, 0, 0);
           // post non-blocking send
+          comm_stats::AddMessage(comm_stats::Module::amr, new_rank_eachmb[newm+l], 1,
+              static_cast<double>(sendbuf.h_view(sb_idx).cnt)*sizeof(Real));
           int ierr = MPI_Isend(pdata.data(), sendbuf.h_view(sb_idx).cnt, MPI_ATHENA_REAL,
                      new_rank_eachmb[newm+l], tag, amr_comm,
                      &(send_req[sb_idx]));
@@ -574,6 +1016,8 @@ void MeshRefinement::PackAndSendAMR(int nleaf) {
           int lid = newm - new_gids_eachrank[new_rank_eachmb[newm]];
           int tag = CreateAMR_MPI_Tag(lid, 0, 0, 0);
           // post non-blocking send
+          comm_stats::AddMessage(comm_stats::Module::amr, new_rank_eachmb[newm], 0,
+              static_cast<double>(sendbuf.h_view(sb_idx).cnt)*sizeof(Real));
           int ierr = MPI_Isend(pdata.data(), sendbuf.h_view(sb_idx).cnt, MPI_ATHENA_REAL,
                      new_rank_eachmb[newm], tag, amr_comm,
                      &(send_req[sb_idx]));
@@ -594,6 +1038,8 @@ void MeshRefinement::PackAndSendAMR(int nleaf) {
           int lid = newm - new_gids_eachrank[new_rank_eachmb[newm]];
           int tag = CreateAMR_MPI_Tag(lid, ox1, ox2, ox3);
           // post non-blocking send
+          comm_stats::AddMessage(comm_stats::Module::amr, new_rank_eachmb[newm], -1,
+              static_cast<double>(sendbuf.h_view(sb_idx).cnt)*sizeof(Real));
           int ierr = MPI_Isend(pdata.data(), sendbuf.h_view(sb_idx).cnt, MPI_ATHENA_REAL,
                      new_rank_eachmb[newm], tag, amr_comm,
                      &(send_req[sb_idx]));
@@ -12,6 +12,7 @@
 #include <limits>
 #include <cstdio> // fclose
 #include <string> // string
+#include <vector>
 
 #include "athena.hpp"
 #include "globals.hpp"
@@ -24,6 +25,7 @@
 #include "diffusion/viscosity.hpp"
 #include "diffusion/resistivity.hpp"
 #include "diffusion/conduction.hpp"
+#include "diffusion/sts.hpp"
 #include "radiation/radiation.hpp"
 #include "particles/particles.hpp"
 #include "srcterms/srcterms.hpp"
@@ -175,6 +177,9 @@ Mesh::Mesh(ParameterInput *pin) :
   multilevel = (adaptive || pin->GetString("mesh_refinement","refinement") == "static")
     ?  true : false;
 
+  // select algorithm used to partition MeshBlocks between ranks
+  InitLoadBalance(pin);
+
   // FIXME: The shearing box is not currently compatible with SMR/AMR
   if (multilevel && pin->DoesBlockExist("shearing_box")) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
@@ -236,6 +241,38 @@ Mesh::Mesh(ParameterInput *pin) :
     std::exit(EXIT_FAILURE);
   }
 
+  // Optional stretching of coordinates, x = w*sinh(xi/w).  The mesh (and all MeshBlocks)
+  // are then uniform in the logical coordinate xi, so mesh_size is converted to xi.
+  // Only the Z4c/ADM modules (and outputs, interpolation) use the physical coordinates.
+  for (int dir=0; dir<3; ++dir) {
+    std::string name = "x" + std::to_string(dir+1) + "stretch";
+    stretch.width[dir] = pin->GetOrAddReal("mesh", name, 0.0);
+    if (stretch.width[dir] < 0.0) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<mesh>/" << name << " must be >= 0" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    if (stretch.width[dir] > 0.0) {stretch.stretched = true;}
+  }
+  if (stretch.stretched) {
+    if (pin->DoesBlockExist("hydro") || pin->DoesBlockExist("mhd") ||
+        pin->DoesBlockExist("radiation") || pin->DoesBlockExist("particles") ||
+        pin->DoesBlockExist("shearing_box") ||
+        (pin->DoesBlockExist("z4c") && pin->GetOrAddInteger("z4c", "nhorizons", 0) > 0)) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Stretched coordinates (<mesh>/x1stretch etc.) are only "
+                << "supported for Z4c/ADM without matter, particles, or horizon finders"
+                << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    mesh_size.x1min = stretch.Xi(0, mesh_size.x1min);
+    mesh_size.x1max = stretch.Xi(0, mesh_size.x1max);
+    mesh_size.x2min = stretch.Xi(1, mesh_size.x2min);
+    mesh_size.x2max = stretch.Xi(1, mesh_size.x2max);
+    mesh_size.x3min = stretch.Xi(2, mesh_size.x3min);
+    mesh_size.x3max = stretch.Xi(2, mesh_size.x3max);
+  }
+
   // passed error checks, compute grid spacing in (virtual) mesh grid
   mesh_size.dx1 = (mesh_size.x1max-mesh_size.x1min)/static_cast<Real>(mesh_indcs.nx1);
   mesh_size.dx2 = (mesh_size.x2max-mesh_size.x2min)/static_cast<Real>(mesh_indcs.nx2);
@@ -361,6 +398,22 @@ void Mesh::PrintMeshDiagnostics() {
   std::cout <<"Number of physical levels of refinement = "<< (max_level - root_level)
             <<" (" << (max_level - root_level + 1) << " levels total)" << std::endl;
 
+  // storage (and work in ghost-zone kernels) of ghost cells relative to active cells,
+  // which is the same on all levels since all MeshBlocks have the same size
+  {
+    int nx1 = mb_indcs.nx1, nx2 = mb_indcs.nx2, nx3 = mb_indcs.nx3, ng = mb_indcs.ng;
+    double nactive = static_cast<double>(nx1)*nx2*nx3;
+    double ntotal = static_cast<double>(nx1 + 2*ng)*((multi_d)? nx2 + 2*ng : 1)*
+                    ((three_d)? nx3 + 2*ng : 1);
+    std::cout <<"MeshBlock size = "<< nx1 <<" x "<< nx2 <<" x "<< nx3 <<" cells, ghost "
+              <<"cells = "<< static_cast<int>(100.0*(ntotal - nactive)/nactive + 0.5)
+              <<"% of active cells" << std::endl;
+    if (ntotal > 2.0*nactive && multilevel) {
+      std::cout <<"  (use larger <meshblock>/nx1,nx2,nx3 to reduce ghost-cell overhead; "
+                <<"the MeshBlock size is the same on all levels)" << std::endl;
+    }
+  }
+
   // if more than one physical level: compute/output # of blocks and cost per level
   if ((max_level - root_level) > 1) {
     int nb_per_plevel[max_level];      // NOLINT(runtime/arrays)
@@ -494,6 +547,40 @@ void Mesh::WriteMeshStructure() {
   return;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn int Mesh::FindMeshBlockGID(Real x1, Real x2, Real x3)
+//! \brief returns global ID of the MeshBlock containing the point (x1,x2,x3), or -1 if
+//! the point is outside the Mesh.  Uses a descent of the MeshBlockTree by the logical
+//! location of the point at max_level, rather than a search over all MeshBlocks.  Points
+//! on faces shared by two MeshBlocks are assigned to the MeshBlock at larger x.  With
+//! stretched coordinates (x1,x2,x3) are the logical coordinates xi.
+
+int Mesh::FindMeshBlockGID(Real x1, Real x2, Real x3) {
+  if (x1 < mesh_size.x1min || x1 > mesh_size.x1max ||
+      x2 < mesh_size.x2min || x2 > mesh_size.x2max ||
+      x3 < mesh_size.x3min || x3 > mesh_size.x3max) {
+    return -1;
+  }
+  // number of blocks at max_level across Mesh in each direction
+  std::int32_t nlev = 1<<(max_level - root_level);
+  std::int32_t n1 = nmb_rootx1*nlev;
+  std::int32_t n2 = (multi_d)? nmb_rootx2*nlev : 1;
+  std::int32_t n3 = (three_d)? nmb_rootx3*nlev : 1;
+  LogicalLocation loc;
+  loc.level = max_level;
+  loc.lx1 = static_cast<std::int32_t>((x1 - mesh_size.x1min)/
+                                      (mesh_size.x1max - mesh_size.x1min)*n1);
+  loc.lx2 = static_cast<std::int32_t>((x2 - mesh_size.x2min)/
+                                      (mesh_size.x2max - mesh_size.x2min)*n2);
+  loc.lx3 = static_cast<std::int32_t>((x3 - mesh_size.x3min)/
+                                      (mesh_size.x3max - mesh_size.x3min)*n3);
+  loc.lx1 = std::min(std::max(loc.lx1, 0), n1-1);
+  loc.lx2 = std::min(std::max(loc.lx2, 0), n2-1);
+  loc.lx3 = std::min(std::max(loc.lx3, 0), n3-1);
+  MeshBlockTree *pleaf = ptree->FindLeaf(loc);
+  return (pleaf == nullptr)? -1 : pleaf->GetGID();
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn GetBoundaryFlag(std::string input_string)
 //  \brief Parses input string to return scoped enumerator flag specifying boundary
@@ -563,8 +650,11 @@ std::string Mesh::GetBoundaryString(BoundaryFlag input_flag) {
 
 //----------------------------------------------------------------------------------------
 // \fn Mesh::NewTimeStep()
+// \brief Finds the minimum timestep over all physics modules and MPI ranks.  With
+// nonblocking=true, the global reduction is only started, and dt holds the minimum on
+// this rank until FinishNewTimeStep() is called.
 
-void Mesh::NewTimeStep(const Real tlim) {
+void Mesh::NewTimeStep(const Real tlim, bool nonblocking) {
   // save old timestep
   dtold = dt;
   if (dt == std::numeric_limits<float>::max()) {
@@ -576,16 +666,27 @@ void Mesh::NewTimeStep(const Real tlim) {
   // limit increase in timestep to 2x old value
   dt = 2.0*dt;
 
+  // With super-time-stepping, diffusion timesteps instead set the number of STS stages
+  bool sts = (sts_integrator != STSIntegrator::none);
+  Real dt_diff = std::numeric_limits<float>::max();
+  auto diffusion_dt = [&](Real dtnew_diff) {
+    if (sts) {
+      dt_diff = std::min(dt_diff, (cfl_no)*dtnew_diff);
+    } else {
+      dt = std::min(dt, (cfl_no)*dtnew_diff);
+    }
+  };
+
   // Hydro timestep
   if (pmb_pack->phydro != nullptr) {
     dt = std::min(dt, (cfl_no)*(pmb_pack->phydro->dtnew) );
     // viscosity timestep
     if (pmb_pack->phydro->pvisc != nullptr) {
-      dt = std::min(dt, (cfl_no)*(pmb_pack->phydro->pvisc->dtnew) );
+      diffusion_dt(pmb_pack->phydro->pvisc->dtnew);
     }
     // thermal conduction timestep
     if (pmb_pack->phydro->pcond != nullptr) {
-      dt = std::min(dt, (cfl_no)*(pmb_pack->phydro->pcond->dtnew) );
+      diffusion_dt(pmb_pack->phydro->pcond->dtnew);
     }
     // source terms timestep
     dt = std::min(dt, (cfl_no)*(pmb_pack->phydro->psrc->dtnew) );
@@ -595,43 +696,134 @@ void Mesh::NewTimeStep(const Real tlim) {
     dt = std::min(dt, (cfl_no)*(pmb_pack->pmhd->dtnew) );
     // viscosity timestep
     if (pmb_pack->pmhd->pvisc != nullptr) {
-      dt = std::min(dt, (cfl_no)*(pmb_pack->pmhd->pvisc->dtnew) );
+      diffusion_dt(pmb_pack->pmhd->pvisc->dtnew);
     }
     // resistivity timestep
     if (pmb_pack->pmhd->presist != nullptr) {
-      dt = std::min(dt, (cfl_no)*(pmb_pack->pmhd->presist->dtnew) );
+      diffusion_dt(pmb_pack->pmhd->presist->dtnew);
     }
     // thermal conduction timestep
     if (pmb_pack->pmhd->pcond != nullptr) {
-      dt = std::min(dt, (cfl_no)*(pmb_pack->pmhd->pcond->dtnew) );
+      diffusion_dt(pmb_pack->pmhd->pcond->dtnew);
     }
     // source terms timestep
     dt = std::min(dt, (cfl_no)*(pmb_pack->pmhd->psrc->dtnew) );
   }
-  // z4c timestep
-  if (pmb_pack->pz4c != nullptr) {
+  // z4c timestep (with multirate integration it only limits the spacetime step, below)
+  bool multirate = (pmb_pack->pz4c != nullptr && pmb_pack->pz4c->multirate_ratio > 1);
+  if (pmb_pack->pz4c != nullptr && !(multirate)) {
     dt = std::min(dt, (cfl_no)*(pmb_pack->pz4c->dtnew) );
   }
-  // Radiation timestep
+  // Radiation timestep (with subcycling it limits nsubcycle radiation steps)
   if (pmb_pack->prad != nullptr) {
-    dt = std::min(dt, (cfl_no)*(pmb_pack->prad->dtnew) );
+    dt = std::min(dt, (pmb_pack->prad->nsubcycle)*(cfl_no)*(pmb_pack->prad->dtnew) );
   }
   // Particles timestep
   if (pmb_pack->ppart != nullptr) {
     dt = std::min(dt, (pmb_pack->ppart->dtnew) );
   }
 
+  // get minimum dt (and diffusion dt) over all MPI ranks
+  dt_tlim_ = tlim;
+  dt_reduce_[0] = dt;
+  dt_reduce_[1] = dt_diff;
+  dt_pending_ = true;
 #if MPI_PARALLEL_ENABLED
-  // get minimum dt over all MPI ranks
-  MPI_Allreduce(MPI_IN_PLACE, &dt, 1, MPI_ATHENA_REAL, MPI_MIN, MPI_COMM_WORLD);
+  if (nonblocking) {
+    MPI_Iallreduce(MPI_IN_PLACE, dt_reduce_, 2, MPI_ATHENA_REAL, MPI_MIN,
+                   global_variable::mpi_comm, &dt_req_);
+    return;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, dt_reduce_, 2, MPI_ATHENA_REAL, MPI_MIN,
+                global_variable::mpi_comm);
 #endif
+  FinishNewTimeStep();
+
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+// \fn Mesh::FinishNewTimeStep()
+// \brief Completes the global reduction of the timestep started by NewTimeStep(), and
+// sets dt and the number of STS stages.  Does nothing if no reduction is pending.
+
+void Mesh::FinishNewTimeStep() {
+  if (!(dt_pending_)) return;
+#if MPI_PARALLEL_ENABLED
+  MPI_Wait(&dt_req_, MPI_STATUS_IGNORE);
+#endif
+  dt_pending_ = false;
+  dt = dt_reduce_[0];
+  Real dt_diff = dt_reduce_[1];
 
   // limit last time step to stop at tlim *exactly*
-  if ( (time < tlim) && ((time + dt) > tlim) ) {dt = tlim - time;}
+  if ( (time < dt_tlim_) && ((time + dt) > dt_tlim_) ) {dt = dt_tlim_ - time;}
+  if (pmb_pack->pz4c != nullptr && pmb_pack->pz4c->multirate_ratio > 1) {
+    pmb_pack->pz4c->SpacetimeTimeStep(time, dt, dt_tlim_);
+  }
+
+  // number of STS stages needed to integrate diffusion terms stably over dt
+  nsts_stages = 0;
+  if (sts_integrator != STSIntegrator::none) {
+    if (dt_diff < std::numeric_limits<float>::max()) {
+      nsts_stages = STSNumberOfStages(sts_integrator, dt/dt_diff);
+    }
+  }
+
+  if (report_level_dt && multilevel) {LevelTimeSteps();}
 
   return;
 }
 
+//----------------------------------------------------------------------------------------
+// \fn Mesh::LevelTimeSteps()
+// \brief Finds the hydro/MHD timestep allowed on each level from the minimum in each
+// MeshBlock, and accumulates the number of MeshBlock-updates this cycle would need if
+// each level were subcycled by factors of two (Berger-Oliger) rather than advanced with
+// the global dt.  Other timestep limits (diffusion, source terms, etc.) are assumed to
+// apply equally on every level.  Used to estimate potential speed-up from subcycling.
+
+void Mesh::LevelTimeSteps() {
+  int nlev = max_level - root_level + 1;
+  std::vector<Real> dt_lev(nlev, std::numeric_limits<float>::max());
+  std::vector<int> nmb_lev(nlev, 0);
+  for (int m=0; m<nmb_total; ++m) {
+    nmb_lev[lloc_eachmb[m].level - root_level]++;
+  }
+
+  // minimum over MeshBlocks on each level from hydro and/or MHD
+  auto &mblev = pmb_pack->pmb->mb_lev;
+  auto find_min = [&](const DvceArray1D<Real> &dtnew_mb) {
+    auto dtmb = Kokkos::create_mirror_view_and_copy(HostMemSpace(), dtnew_mb);
+    for (int m=0; m<static_cast<int>(dtmb.extent(0)); ++m) {
+      int l = mblev.h_view(m) - root_level;
+      dt_lev[l] = std::min(dt_lev[l], cfl_no*dtmb(m));
+    }
+  };
+  if (pmb_pack->phydro != nullptr) {find_min(pmb_pack->phydro->dtnew_mb);}
+  if (pmb_pack->pmhd != nullptr) {find_min(pmb_pack->pmhd->dtnew_mb);}
+#if MPI_PARALLEL_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE, dt_lev.data(), nlev, MPI_ATHENA_REAL, MPI_MIN,
+                global_variable::mpi_comm);
+#endif
+
+  // with subcycling the coarsest level takes the largest step consistent with the
+  // timestep on every level l being dt_root/2^l
+  Real dt_root = std::numeric_limits<float>::max();
+  for (int l=0; l<nlev; ++l) {
+    if (nmb_lev[l] > 0) {
+      dt_root = std::min(dt_root, static_cast<Real>(1 << l)*dt_lev[l]);
+    }
+  }
+  double nsub = 0.0;
+  for (int l=0; l<nlev; ++l) {
+    nsub += static_cast<double>(nmb_lev[l])*static_cast<double>(1 << l);
+  }
+  nmb_updated_sub += nsub*static_cast<double>(dt/dt_root);
+  nmb_updated_glob += static_cast<double>(nmb_total);
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 // \fn Mesh::AddCoordinatesAndPhysics
 
@@ -653,7 +845,8 @@ void Mesh::AddCoordinatesAndPhysics(ParameterInput *pinput) {
     nprtcl_eachrank[global_variable::my_rank] = nprtcl_thisrank;
 #if MPI_PARALLEL_ENABLED
     // Share number of particles on each rank with all ranks
-    MPI_Allgather(&nprtcl_thisrank,1,MPI_INT,nprtcl_eachrank,1,MPI_INT,MPI_COMM_WORLD);
+    MPI_Allgather(&nprtcl_thisrank, 1, MPI_INT, nprtcl_eachrank, 1, MPI_INT,
+                  global_variable::mpi_comm);
 #endif
     for (int n=0; n<global_variable::nranks; ++n) {
       nprtcl_total += nprtcl_eachrank[n];
@@ -14,8 +14,14 @@
 #include <cstdint>  // int32_t
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "athena.hpp"
+#include "coordinates/cell_locations.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
 
 // Define following structure before other "include" files to resolve declarations
 //----------------------------------------------------------------------------------------
@@ -41,6 +47,9 @@ struct RegionIndcs {
   int cis,cie,cjs,cje,cks,cke;  // indices of ACTIVE coarse cells
 };
 
+// tag preceding partition of MeshBlocks over ranks stored in restart files ("ATHKPART")
+constexpr std::uint64_t restart_partition_tag = 0x4154484B50415254ULL;
+
 //----------------------------------------------------------------------------------------
 //! \struct NeighborBlock
 //! \brief Information about neighboring MeshBlocks stored as 2D DualArray in MeshBlock
@@ -70,8 +79,10 @@ struct LogicalLocation {
 
 struct EventCounters {
   int nfofc, neos_dfloor, neos_efloor, neos_tfloor, neos_vceil, neos_fail, maxit_c2p;
+  int nrad_fallback, maxit_rad;
   EventCounters() : nfofc(0), neos_dfloor(0), neos_efloor(0), neos_tfloor(0),
-                    neos_vceil(0), neos_fail(0), maxit_c2p(0) {}
+                    neos_vceil(0), neos_fail(0), maxit_c2p(0), nrad_fallback(0),
+                    maxit_rad(0) {}
 };
 
 // Forward declarations required due to recursive definitions amongst mesh classes
@@ -106,6 +117,7 @@ class Mesh {
 
   // data
   RegionSize  mesh_size;      // (physical) size of mesh (physical root level)
+  CoordinateStretch stretch;  // optional stretching of coordinates (cell_locations.hpp)
   RegionIndcs mesh_indcs;     // indices of cells in mesh (physical root level)
   RegionIndcs mb_indcs;       // indices of cells in MeshBlocks (same for all MeshBlocks)
   BoundaryFlag mesh_bcs[6];   // physical boundary conditions at 6 faces of mesh
@@ -140,8 +152,17 @@ class Mesh {
 
   Real time, dt, dtold, cfl_no;
   int ncycle;
+
+  // operator-split super-time-stepping of diffusion terms, see <time>/sts_integrator
+  STSIntegrator sts_integrator = STSIntegrator::none;
+  int nsts_stages = 0;             // number of STS stages needed in this cycle
   EventCounters ecounter;
 
+  // following used to estimate speed-up from subcycling each level with its own timestep
+  bool report_level_dt = false;    // compute timestep on each level every cycle
+  double nmb_updated_sub = 0.0;    // MeshBlock-updates needed with subcycling
+  double nmb_updated_glob = 0.0;   // MeshBlock-updates needed with global timestep
+
   int nmb_packs_thisrank;                  // number of MBPacks on this rank
   MeshBlockPack* pmb_pack;                 // container for MeshBlocks on this rank
   std::unique_ptr<ProblemGenerator> pgen;  // class containing functions to set ICs
@@ -152,8 +173,11 @@ class Mesh {
   void BuildTreeFromRestart(ParameterInput *pin, IOWrapper &resfile);
   void PrintMeshDiagnostics();
   void WriteMeshStructure();
-  void NewTimeStep(const Real tlim);
+  void NewTimeStep(const Real tlim, bool nonblocking=false);
+  void FinishNewTimeStep();
+  void LevelTimeSteps();
   void AddCoordinatesAndPhysics(ParameterInput *pinput);
+  int FindMeshBlockGID(Real x1, Real x2, Real x3);
   BoundaryFlag GetBoundaryFlag(const std::string& input_string);
   std::string GetBoundaryString(BoundaryFlag input_flag);
 
@@ -163,11 +187,10 @@ class Mesh {
   }
 
   // accessors
+  // MeshBlocks on this rank have contiguous gids, so index is found without a search
   int FindMeshBlockIndex(int tgid) {
-    for (int m=0; m<pmb_pack->nmb_thispack; ++m) {
-      if (pmb_pack->pmb->mb_gid.h_view(m) == tgid) return m;
-    }
-    return -1;
+    int m = tgid - pmb_pack->gids;
+    return (m >= 0 && m < pmb_pack->nmb_thispack) ? m : -1;
   }
   int NumberOfMeshBlockCells() const {
     return (mb_indcs.nx1)*(mb_indcs.nx2)*(mb_indcs.nx3);
@@ -175,6 +198,27 @@ class Mesh {
 
  private:
   std::unique_ptr<MeshBlockTree> ptree;  // pointer to root node in binary/quad/oct-tree
-  void LoadBalance(float *clist, int *rlist, int *slist, int *nlist, int nb);
+  // partitioning of MeshBlocks between ranks (see load_balance.cpp)
+  bool lb_optimal_ = false;              // minimize max cost/rank rather than greedy
+  bool lb_incremental_ = false;          // only move MBs needed to meet lb_tolerance_
+  float lb_tolerance_ = 0.1;             // allowed imbalance with incremental rebalance
+  std::vector<int> lb_nranks_eachnode_;  // # of ranks on each node (node-aware only)
+  // relative throughput (capacity) of each rank, normalized to a mean of one, so that
+  // each rank receives a share of the total cost proportional to its weight.  Empty if
+  // all ranks are equal.  Given in input, or measured during the run (with AMR)
+  std::vector<double> lb_rank_weight_;
+  double RankWeight(int r) const {
+    return (lb_rank_weight_.empty())? 1.0 : lb_rank_weight_[r];
+  }
+  void InitLoadBalance(ParameterInput *pin);
+  // global reduction of timestep, possibly still in progress (see NewTimeStep())
+  bool dt_pending_ = false;
+  Real dt_tlim_;
+  Real dt_reduce_[2];                    // timestep and diffusion timestep
+#if MPI_PARALLEL_ENABLED
+  MPI_Request dt_req_ = MPI_REQUEST_NULL;
+#endif
+  void LoadBalance(float *clist, int *rlist, int *slist, int *nlist, int nb,
+                   const int *curr_rank=nullptr);
 };
 #endif  // MESH_MESH_HPP_
@@ -13,19 +13,23 @@
 #include <iostream>
 #include <cmath>     // abs
 #include <algorithm> // sort
+#include <string>
 #include <utility>   // pair
+#include <vector>
 
 #include "athena.hpp"
 #include "globals.hpp"
 #include "parameter_input.hpp"
 #include "mesh.hpp"
 #include "mesh_refinement.hpp"
+#include "driver/memory_tracker.hpp"
 
 #include "hydro/hydro.hpp"
 #include "mhd/mhd.hpp"
 #include "radiation/radiation.hpp"
 #include "z4c/z4c.hpp"
 #include "z4c/z4c_amr.hpp"
+#include "particles/particles.hpp"
 #include "prolongation.hpp"
 #include "restriction.hpp"
 
@@ -47,11 +51,27 @@ MeshRefinement::MeshRefinement(Mesh *pm, ParameterInput *pin) :
   ncyc_check_amr(1),
   refinement_interval(5),
   prolong_prims(false),
+  overlap_amr_comm(false),
+  amr_buf_headroom(1.25),
+  level_restrict(false),
+  restrict_slabs(false),
+  excision_aware(false),
+  excision_level(-1),
+  measure_cost(false),
+  measure_weight(false),
+  lb_tolerance(0.0),
+  lb_smoothing(0.5),
+  lb_time(0.0),
+  lb_ncycle(0),
+  lb_prtcl_cost(0.0),
   d_threshold_(0.0),
   dd_threshold_(0.0),
   dp_threshold_(0.0),
   dv_threshold_(0.0),
-  check_cons_(false) {
+  check_cons_(false),
+  cons_criteria_added_(false),
+  cost_measured_(false),
+  costs_shared_(true) {
   if (pin->DoesBlockExist("mesh_refinement")) {
     // read interval (in cycles) between check of AMR and derefinement
     ncyc_check_amr = pin->GetOrAddReal("mesh_refinement", "ncycle_check", 1);
@@ -60,6 +80,25 @@ MeshRefinement::MeshRefinement(Mesh *pm, ParameterInput *pin) :
     if (pin->DoesParameterExist("mesh_refinement", "prolong_primitives")) {
       prolong_prims = pin->GetBoolean("mesh_refinement", "prolong_primitives");
     }
+    // overlap communication of MBs during load balancing with rebuild of mesh data
+    overlap_amr_comm = pin->GetOrAddBoolean("mesh_refinement", "overlap_amr_comm", false);
+    // load balancing buffers are only reallocated when too small, and then with headroom
+    amr_buf_headroom = pin->GetOrAddReal("mesh_refinement", "amr_buffer_headroom", 1.25);
+    if (amr_buf_headroom < 1.0) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+         << std::endl << "<mesh_refinement>/amr_buffer_headroom must be >= 1"
+         << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    // restrict only MBs with coarser neighbors (MeshBlock::restrict_mbs), level by level
+    level_restrict = pin->GetOrAddBoolean("mesh_refinement", "level_restrict", false);
+    // also skip coarse cells that are neither sent to coarser neighbors nor used for
+    // prolongation (MeshBlock::coarse_mask).  No effect with AMR.
+    restrict_slabs = pin->GetOrAddBoolean("mesh_refinement", "restrict_slabs", false);
+    // with black hole excision, refinement criteria ignore excised cells, and MBs whose
+    // active cells are all excised are derefined to excision_level (above root level)
+    excision_aware = pin->GetOrAddBoolean("mesh_refinement", "excision_aware", false);
+    excision_level = pin->GetOrAddInteger("mesh_refinement", "excision_level", -1);
     // read refinement criteria thresholds
     if (pin->DoesParameterExist("mesh_refinement", "dens_max")) {
       d_threshold_ = pin->GetReal("mesh_refinement", "dens_max");
@@ -77,6 +116,42 @@ MeshRefinement::MeshRefinement(Mesh *pm, ParameterInput *pin) :
       dd_threshold_ = pin->GetReal("mesh_refinement", "dvel_max");
       check_cons_ = true;
     }
+    // read parameters controlling measured-cost load balancing
+    std::string lb_cost = pin->GetOrAddString("mesh_refinement", "lb_cost", "uniform");
+    if (lb_cost.compare("measured") == 0) {
+      measure_cost = true;
+    } else if (lb_cost.compare("uniform") != 0) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+         << std::endl << "lb_cost=" << lb_cost << " not implemented. "
+         << "Valid choices are [uniform,measured]." << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    // capacity of each rank measured from its throughput (see Mesh::InitLoadBalance)
+    std::string lb_wght = pin->GetOrAddString("mesh", "lb_rank_weights", "uniform");
+    if (lb_wght.compare("measured") == 0) {
+      if (measure_cost) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+           << std::endl << "<mesh>/lb_rank_weights=measured cannot be used with "
+           << "<mesh_refinement>/lb_cost=measured" << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+      measure_weight = true;
+    }
+    if (measure_cost || measure_weight) {
+      lb_tolerance = pin->GetOrAddReal("mesh_refinement", "lb_tolerance", 0.1);
+      lb_smoothing = pin->GetOrAddReal("mesh_refinement", "lb_smoothing", 0.5);
+      if ((lb_smoothing <= 0.0) || (lb_smoothing > 1.0)) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+           << std::endl << "<mesh_refinement>/lb_smoothing must be in (0,1]"
+           << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+    }
+    // with particles, include their cost and rebalance when their load is imbalanced
+    if (pin->DoesBlockExist("particles")) {
+      lb_prtcl_cost = pin->GetOrAddReal("mesh_refinement", "lb_prtcl_cost", 1.0);
+      lb_tolerance = pin->GetOrAddReal("mesh_refinement", "lb_tolerance", 0.1);
+    }
   }
 
   if (pm->adaptive) {  // allocate arrays for AMR
@@ -99,7 +174,7 @@ MeshRefinement::MeshRefinement(Mesh *pm, ParameterInput *pin) :
 
 #if MPI_PARALLEL_ENABLED
   // create unique communicators for AMR
-  MPI_Comm_dup(MPI_COMM_WORLD, &amr_comm);
+  MPI_Comm_dup(global_variable::mpi_comm, &amr_comm);
 #endif
 }
 
@@ -120,15 +195,27 @@ MeshRefinement::~MeshRefinement() {
 //! \brief Simple driver function for adaptive mesh refinement
 
 void MeshRefinement::AdaptiveMeshRefinement(Driver *pdriver, ParameterInput *pin) {
-  // first check refinement criteria
-  CheckForRefinement(pmy_mesh->pmb_pack);
+  // update measured cost of MeshBlocks on cycles at which mesh is checked
+  bool rebalance = false;
+  bool prtcl_cost = (pmy_mesh->pmb_pack->ppart != nullptr) && (lb_prtcl_cost > 0.0);
+  if ((measure_cost || measure_weight || prtcl_cost) &&
+      ((pmy_mesh->ncycle)%(ncyc_check_amr) == 0)) {
+    if (measure_cost) {UpdateMeasuredCosts();}
+    if (measure_weight) {UpdateRankWeights();}
+    rebalance = CheckForRebalance();
+  }
 
-  // then update mesh tree if MeshBlock anywhere (on any rank) is flagged for refinement
+  // first check refinement criteria, then update mesh tree if MeshBlock anywhere (on
+  // any rank) is flagged for refinement
   int nnew = 0, ndel = 0;
-  UpdateMeshBlockTree(nnew, ndel);
+  if (CheckForRefinement(pmy_mesh->pmb_pack)) {
+    UpdateMeshBlockTree(nnew, ndel);
+  }
 
-  // Refine/derefine mesh and evolved data, set boundary conditions/timestep on new mesh
-  if (nnew != 0 || ndel != 0) { // at least one (de)refinement flagged
+  // Refine/derefine mesh and evolved data, set boundary conditions/timestep on new mesh.
+  // With measured costs, MeshBlocks are also redistributed (without any refinement) if
+  // load imbalance exceeds tolerance.
+  if (nnew != 0 || ndel != 0 || rebalance) { // at least one (de)refinement flagged
     RedistAndRefineMeshBlocks(pin, nnew, ndel);
     pdriver->InitBoundaryValuesAndPrimitives(pmy_mesh);
 
@@ -138,6 +225,8 @@ void MeshRefinement::AdaptiveMeshRefinement(Driver *pdriver, ParameterInput *pin
     }
     if (pmbp->pmhd != nullptr) {
       (void) pmbp->pmhd->NewTimeStep(pdriver, pdriver->nexp_stages);
+      // per-cell C2P statistics no longer correspond to MeshBlocks on this rank
+      if (pmbp->pmhd->c2p_stats) {Kokkos::deep_copy(pmbp->pmhd->c2p_count, 0.0);}
     }
     if (pmbp->prad != nullptr) {
       (void) pmbp->prad->NewTimeStep(pdriver, pdriver->nexp_stages);
@@ -148,10 +237,155 @@ void MeshRefinement::AdaptiveMeshRefinement(Driver *pdriver, ParameterInput *pin
 
     nmb_created += nnew;
     nmb_deleted += ndel;
+    memory_tracker::Report("after AMR", pmy_mesh);
   }
   return;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void MeshRefinement::AddRefinementCriterion()
+//! \brief Registers a refinement criterion computed from variable ivar of the array
+//! pointed to by pvar, which must be a member of a physics module (so that it remains
+//! valid when the array is reallocated by AMR).  Called by physics modules on setup.
+
+void MeshRefinement::AddRefinementCriterion(RefinementCriterionType type,
+                                            DvceArray5D<Real> *pvar, int ivar,
+                                            Real refine_thresh, Real derefine_thresh) {
+  int n = criteria_.ncrit;
+  if (n >= NREFINEMENT_CRITERIA) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Number of refinement criteria exceeds "
+              << "NREFINEMENT_CRITERIA=" << NREFINEMENT_CRITERIA << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  criteria_.type[n] = type;
+  criteria_.pvar[n] = pvar;
+  criteria_.ivar[n] = ivar;
+  criteria_.refine_thresh[n] = refine_thresh;
+  criteria_.derefine_thresh[n] = derefine_thresh;
+  criteria_.ncrit++;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshRefinement::EvaluateRefinementCriteria()
+//! \brief Evaluates all registered refinement criteria over active cells in a single
+//! pass through each MeshBlock, and sets refine_flag.d_view for MBs in the pack.
+
+void MeshRefinement::EvaluateRefinementCriteria(MeshBlockPack* pmbp) {
+  if (criteria_.ncrit == 0) {return;}
+
+  // capture variables for kernels
+  auto &multi_d = pmy_mesh->multi_d;
+  auto &three_d = pmy_mesh->three_d;
+  auto &indcs = pmy_mesh->mb_indcs;
+  int &is = indcs.is, nx1 = indcs.nx1;
+  int &js = indcs.js, nx2 = indcs.nx2;
+  int &ks = indcs.ks, nx3 = indcs.nx3;
+  const int nkji = nx3*nx2*nx1;
+  const int nji  = nx2*nx1;
+  int nmb = pmbp->nmb_thispack;
+  int mbs = pmy_mesh->gids_eachrank[global_variable::my_rank];
+  auto refine_flag_ = refine_flag;
+
+  // arrays may have been reallocated since criteria were added
+  for (int n=0; n<criteria_.ncrit; ++n) {
+    criteria_.var[n] = *(criteria_.pvar[n]);
+  }
+  auto crit = criteria_;
+
+  // cells excised inside horizons (Coordinates::excision_floor) are skipped
+  bool excise = excision_aware && (pmbp->pcoord != nullptr) &&
+                pmbp->pcoord->coord_data.bh_excise;
+  DvceArray4D<bool> excised;
+  if (excise) {excised = pmbp->pcoord->excision_floor;}
+
+  par_for_outer("RefineCriteria",DevExeSpace(), 0, 0, 0, (nmb-1),
+  KOKKOS_LAMBDA(TeamMember_t tmember, const int m) {
+    array_max::CriteriaMax team_max;
+    Kokkos::parallel_reduce(Kokkos::TeamThreadRange(tmember, nkji),
+    [=](const int idx, array_max::CriteriaMax &cmax) {
+      int k = (idx)/nji;
+      int j = (idx - k*nji)/nx1;
+      int i = (idx - k*nji - j*nx1) + is;
+      j += js;
+      k += ks;
+      if (excise && excised(m,k,j,i)) return;
+      for (int n=0; n<crit.ncrit; ++n) {
+        auto &q = crit.var[n];
+        const int iv = crit.ivar[n];
+        Real val;
+        if (crit.type[n] == RefinementCriterionType::max_value) {
+          val = q(m,iv,k,j,i);
+        } else if (crit.type[n] == RefinementCriterionType::min_value) {
+          val = -q(m,iv,k,j,i);  // minimum computed as max of negative
+        } else {
+          Real d2 = SQR(q(m,iv,k,j,i+1) - q(m,iv,k,j,i-1));
+          if (multi_d) {d2 += SQR(q(m,iv,k,j+1,i) - q(m,iv,k,j-1,i));}
+          if (three_d) {d2 += SQR(q(m,iv,k+1,j,i) - q(m,iv,k-1,j,i));}
+          val = sqrt(d2);
+          if (crit.type[n] == RefinementCriterionType::max_rel_gradient) {
+            val /= q(m,iv,k,j,i);
+          }
+        }
+        cmax.the_array[n] = fmax(val, cmax.the_array[n]);
+      }
+    },Kokkos::Sum<array_max::CriteriaMax>(team_max));
+
+    // refine if any criterion requests it, derefine only if all allow it
+    int flag = -1;
+    for (int n=0; n<crit.ncrit; ++n) {
+      bool refine, derefine;
+      if (crit.type[n] == RefinementCriterionType::min_value) {
+        Real vmin = -team_max.the_array[n];
+        refine = (vmin < crit.refine_thresh[n]);
+        derefine = (vmin > crit.derefine_thresh[n]);
+      } else {
+        refine = (team_max.the_array[n] > crit.refine_thresh[n]);
+        derefine = (team_max.the_array[n] < crit.derefine_thresh[n]);
+      }
+      if (refine) {
+        flag = 1;
+      } else if (!(derefine) && flag < 0) {
+        flag = 0;
+      }
+    }
+    refine_flag_.d_view(m+mbs) = flag;
+  });
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshRefinement::SetExcisedFlags()
+//! \brief With excision_level >= 0, overrides the flags of MBs in which every active cell
+//! is excised inside a horizon (all Coordinates::excised_kplane set), so that they are
+//! derefined until they reach excision_level above the root level, and never refined.
+
+void MeshRefinement::SetExcisedFlags(MeshBlockPack* pmbp) {
+  if (excision_level < 0 || pmbp->pcoord == nullptr ||
+      !(pmbp->pcoord->coord_data.bh_excise)) {return;}
+
+  auto &indcs = pmy_mesh->mb_indcs;
+  int ks = indcs.ks, ke = indcs.ke;
+  int nmb = pmbp->nmb_thispack;
+  int mbs = pmy_mesh->gids_eachrank[global_variable::my_rank];
+  int lev_excise = pmy_mesh->root_level + excision_level;
+  auto &mb_lev = pmbp->pmb->mb_lev;
+  auto &kplane = pmbp->pcoord->excised_kplane;
+  auto refine_flag_ = refine_flag;
+  par_for("ExcisedFlags", DevExeSpace(), 0, (nmb-1),
+  KOKKOS_LAMBDA(const int m) {
+    bool inside = true;
+    for (int k=ks; k<=ke; ++k) {
+      if (!(kplane(m,k))) {inside = false;}
+    }
+    if (inside) {
+      refine_flag_.d_view(m+mbs) = (mb_lev.d_view(m) > lev_excise)? -1 : 0;
+    }
+  });
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn bool MeshRefinement::CheckForRefinement()
 //! \brief Checks for refinement/de-refinement and sets refine_flag(m) for all
@@ -165,137 +399,133 @@ void MeshRefinement::AdaptiveMeshRefinement(Driver *pdriver, ParameterInput *pin
 //! These are controlled by input parameters in the <mesh_refinement> block.
 //! User-defined refinement conditions can also be enrolled by setting the *usr_ref_func
 //! pointer in the problem generator.
+//! Flags are evaluated on the device, and only the (gid,flag) pairs of flagged MBs are
+//! compacted with a parallel scan, copied to the host, and exchanged between ranks.  The
+//! host view of refine_flag is then exact, while the device view is left stale (it is
+//! marked modified on the host, so it is updated by the next sync<DevExeSpace>).
 
-void MeshRefinement::CheckForRefinement(MeshBlockPack* pmbp) {
-  // reallocate and zero refine_flag in host space and sync with device
-  Kokkos::realloc(refine_flag, pmy_mesh->nmb_total);
-  for (int m=0; m<(pmy_mesh->nmb_total); ++m) {
-    refine_flag.h_view(m) = 0;
-  }
-  refine_flag.template modify<HostMemSpace>();
-  refine_flag.template sync<DevExeSpace>();
-
+bool MeshRefinement::CheckForRefinement(MeshBlockPack* pmbp) {
   // increment cycle counter for each MB
   for (int m=0; m<(pmy_mesh->nmb_total); ++m) {
     ncyc_since_ref(m) += 1;
   }
-  if ((pmbp->pmesh->ncycle)%(ncyc_check_amr) != 0) {return;}  // not cycle to check
+  if ((pmbp->pmesh->ncycle)%(ncyc_check_amr) != 0) {return false;}  // not cycle to check
 
-  // capture variables for kernels
-  auto &multi_d = pmy_mesh->multi_d;
-  auto &three_d = pmy_mesh->three_d;
-  auto &indcs = pmy_mesh->mb_indcs;
-  int &is = indcs.is, nx1 = indcs.nx1;
-  int &js = indcs.js, nx2 = indcs.nx2;
-  int &ks = indcs.ks, nx3 = indcs.nx3;
-  const int nkji = nx3*nx2*nx1;
-  const int nji  = nx2*nx1;
-
-  // check (on device) Hydro/MHD refinement conditions for cons vars over all MeshBlocks
-  auto refine_flag_ = refine_flag;
-  auto &dens_thresh  = d_threshold_;
-  auto &ddens_thresh = dd_threshold_;
-  auto &dpres_thresh = dp_threshold_;
-  int nmb = pmbp->nmb_thispack;
-  int mbs = pmy_mesh->gids_eachrank[global_variable::my_rank];
-  if (((pmbp->phydro != nullptr) || (pmbp->pmhd != nullptr)) && check_cons_) {
-    auto &u0 = (pmbp->phydro != nullptr)? pmbp->phydro->u0 : pmbp->pmhd->u0;
-    auto &w0 = (pmbp->phydro != nullptr)? pmbp->phydro->w0 : pmbp->pmhd->w0;
-
-    par_for_outer("ConsRefineCond",DevExeSpace(), 0, 0, 0, (nmb-1),
-    KOKKOS_LAMBDA(TeamMember_t tmember, const int m) {
-      // density threshold
-      if (dens_thresh!= 0.0) {
-        Real team_dmax=0.0;
-        Kokkos::parallel_reduce(Kokkos::TeamThreadRange(tmember, nkji),
-        [=](const int idx, Real& dmax) {
-          int k = (idx)/nji;
-          int j = (idx - k*nji)/nx1;
-          int i = (idx - k*nji - j*nx1) + is;
-          j += js;
-          k += ks;
-          dmax = fmax(u0(m,IDN,k,j,i), dmax);
-        },Kokkos::Max<Real>(team_dmax));
-
-        if (team_dmax > dens_thresh) {refine_flag_.d_view(m+mbs) = 1;}
-        if (team_dmax < dens_thresh) {refine_flag_.d_view(m+mbs) = -1;}
+  // zero refine_flag, only reallocating when the number of MBs has changed
+  if (static_cast<int>(refine_flag.extent(0)) != pmy_mesh->nmb_total) {
+    Kokkos::realloc(refine_flag, pmy_mesh->nmb_total);
+  }
+  Kokkos::deep_copy(refine_flag.d_view, 0);
+  Kokkos::deep_copy(refine_flag.h_view, 0);
+  refine_flag.clear_sync_state();
+
+  // add Hydro/MHD criteria (set by thresholds in <mesh_refinement> block) on first call,
+  // once physics modules exist
+  if (!(cons_criteria_added_)) {
+    if (((pmbp->phydro != nullptr) || (pmbp->pmhd != nullptr)) && check_cons_) {
+      auto *pu0 = (pmbp->phydro != nullptr)? &(pmbp->phydro->u0) : &(pmbp->pmhd->u0);
+      auto *pw0 = (pmbp->phydro != nullptr)? &(pmbp->phydro->w0) : &(pmbp->pmhd->w0);
+      if (d_threshold_ != 0.0) {
+        AddRefinementCriterion(RefinementCriterionType::max_value, pu0, IDN,
+                               d_threshold_, d_threshold_);
       }
-
-      // density gradient threshold
-      if (ddens_thresh != 0.0) {
-        Real team_ddmax;
-        Kokkos::parallel_reduce(Kokkos::TeamThreadRange(tmember, nkji),
-        [=](const int idx, Real& ddmax) {
-          int k = (idx)/nji;
-          int j = (idx - k*nji)/nx1;
-          int i = (idx - k*nji - j*nx1) + is;
-          j += js;
-          k += ks;
-          Real d2 = SQR(u0(m,IDN,k,j,i+1) - u0(m,IDN,k,j,i-1));
-          if (multi_d) {d2 += SQR(u0(m,IDN,k,j+1,i) - u0(m,IDN,k,j-1,i));}
-          if (three_d) {d2 += SQR(u0(m,IDN,k+1,j,i) - u0(m,IDN,k-1,j,i));}
-          ddmax = fmax((sqrt(d2)/u0(m,IDN,k,j,i)), ddmax);
-        },Kokkos::Max<Real>(team_ddmax));
-
-        if (team_ddmax > ddens_thresh) {refine_flag_.d_view(m+mbs) = 1;}
-        if (team_ddmax < 0.25*ddens_thresh) {refine_flag_.d_view(m+mbs) = -1;}
+      if (dd_threshold_ != 0.0) {
+        AddRefinementCriterion(RefinementCriterionType::max_rel_gradient, pu0, IDN,
+                               dd_threshold_, 0.25*dd_threshold_);
       }
-
-      // pressure gradient threshold
-      if (dpres_thresh != 0.0) {
-        Real team_dpmax;
-        Kokkos::parallel_reduce(Kokkos::TeamThreadRange(tmember, nkji),
-        [=](const int idx, Real& dpmax) {
-          int k = (idx)/nji;
-          int j = (idx - k*nji)/nx1;
-          int i = (idx - k*nji - j*nx1) + is;
-          j += js;
-          k += ks;
-          Real d2 = SQR(w0(m,IEN,k,j,i+1) - w0(m,IEN,k,j,i-1));
-          if (multi_d) {d2 += SQR(w0(m,IEN,k,j+1,i) - w0(m,IEN,k,j-1,i));}
-          if (three_d) {d2 += SQR(w0(m,IEN,k+1,j,i) - w0(m,IEN,k-1,j,i));}
-          dpmax = fmax((sqrt(d2)/w0(m,IEN,k,j,i)), dpmax);
-        },Kokkos::Max<Real>(team_dpmax));
-
-        if (team_dpmax > dpres_thresh) {refine_flag_.d_view(m+mbs) = 1;}
-        if (team_dpmax < 0.25*dpres_thresh) {refine_flag_.d_view(m+mbs) = -1;}
+      if (dp_threshold_ != 0.0) {
+        AddRefinementCriterion(RefinementCriterionType::max_rel_gradient, pw0, IEN,
+                               dp_threshold_, 0.25*dp_threshold_);
       }
-    });
+    }
+    cons_criteria_added_ = true;
   }
 
-  // Check (on device) user-defined refinement condition(s), if any
+  // check (on device) all registered refinement criteria in one kernel
+  EvaluateRefinementCriteria(pmbp);
+
+  // Check (on device) user-defined refinement condition(s), if any.  These may read the
+  // flags on the host, so sync any set by the criteria above first.
   if (pmy_mesh->pgen->user_ref_func != nullptr) {
+    if (criteria_.ncrit > 0) {
+      refine_flag.template modify<DevExeSpace>();
+      refine_flag.template sync<HostMemSpace>();
+    }
     pmy_mesh->pgen->user_ref_func(pmbp);
   }
-  // sync device array with host
-  refine_flag.template modify<DevExeSpace>();
-  refine_flag.template sync<HostMemSpace>();
+  // user functions may have set flags on the host
+  refine_flag.template sync<DevExeSpace>();
 
-  // Check (on host) for MeshBlocks at max/root level flagged for refine/derefine
-  for (int m=0; m<nmb; ++m) {
-    if (pmy_mesh->lloc_eachmb[m+mbs].level == pmy_mesh->max_level) {
-      if (refine_flag.h_view(m+mbs) > 0) {refine_flag.h_view(m+mbs) = 0;}
+  // MBs inside horizons are derefined regardless of the criteria above
+  SetExcisedFlags(pmbp);
+
+  // compact (gid,flag) of all flagged MBs on this rank into list on device
+  int nmb = pmbp->nmb_thispack;
+  int mbs = pmy_mesh->gids_eachrank[global_variable::my_rank];
+  auto refine_flag_ = refine_flag;
+  if (static_cast<int>(flag_list.extent(0)) < 2*nmb) {
+    Kokkos::realloc(flag_list, 2*nmb);
+  }
+  auto flag_list_ = flag_list;
+  int nflag = 0;
+  Kokkos::parallel_scan("RefineFlagList", Kokkos::RangePolicy<>(DevExeSpace(), 0, nmb),
+  KOKKOS_LAMBDA(const int m, int &offset, const bool final) {
+    int flag = refine_flag_.d_view(m+mbs);
+    if (flag != 0) {
+      if (final) {
+        flag_list_(2*offset) = m + mbs;
+        flag_list_(2*offset + 1) = flag;
+      }
+      offset += 1;
     }
-    if (pmy_mesh->lloc_eachmb[m+mbs].level == pmy_mesh->root_level) {
-      if (refine_flag.h_view(m+mbs) < 0) {refine_flag.h_view(m+mbs) = 0;}
+  }, nflag);
+
+  // copy list to host, and remove (on host) MBs at max/root level flagged for
+  // refine/derefine, or that have been recently refined
+  std::vector<int> changes;
+  if (nflag > 0) {
+    auto list_h = Kokkos::create_mirror_view_and_copy(HostMemSpace(),
+                  Kokkos::subview(flag_list, std::make_pair(0, 2*nflag)));
+    for (int n=0; n<nflag; ++n) {
+      int gid = list_h(2*n), flag = list_h(2*n + 1);
+      int level = pmy_mesh->lloc_eachmb[gid].level;
+      if ((level == pmy_mesh->max_level) && (flag > 0)) {continue;}
+      if ((level == pmy_mesh->root_level) && (flag < 0)) {continue;}
+      if (ncyc_since_ref(gid) < refinement_interval) {continue;}
+      changes.push_back(gid);
+      changes.push_back(flag);
     }
   }
 
-  // Check (on host) that MB has not been recently refined
-  for (int m=0; m<nmb; ++m) {
-    if (ncyc_since_ref(m+mbs) < refinement_interval) {refine_flag.h_view(m+mbs) = 0;}
-  }
 #if MPI_PARALLEL_ENABLED
-  // Pass refine_flag between all ranks
-    MPI_Allgatherv(MPI_IN_PLACE, pmy_mesh->nmb_eachrank[global_variable::my_rank],
-                   MPI_INT, refine_flag.h_view.data(), pmy_mesh->nmb_eachrank,
-                   pmy_mesh->gids_eachrank, MPI_INT, MPI_COMM_WORLD);
+  // Pass list of flagged MBs between all ranks
+  std::vector<int> nchange(global_variable::nranks), displ(global_variable::nranks);
+  int nsend = static_cast<int>(changes.size());
+  MPI_Allgather(&nsend, 1, MPI_INT, nchange.data(), 1, MPI_INT,
+                global_variable::mpi_comm);
+  int ntotal = 0;
+  for (int n=0; n<global_variable::nranks; ++n) {
+    displ[n] = ntotal;
+    ntotal += nchange[n];
+  }
+  if (ntotal > 0) {
+    std::vector<int> all_changes(ntotal);
+    MPI_Allgatherv(changes.data(), nsend, MPI_INT, all_changes.data(), nchange.data(),
+                   displ.data(), MPI_INT, global_variable::mpi_comm);
+    changes.swap(all_changes);
+  }
 #endif
-  // sync host array with device
+
+  // store final flags in host array (device flags on this rank may have been removed)
+  for (int m=0; m<nmb; ++m) {
+    refine_flag.h_view(m+mbs) = 0;
+  }
+  for (int n=0; n<static_cast<int>(changes.size()); n+=2) {
+    refine_flag.h_view(changes[n]) = changes[n+1];
+  }
   refine_flag.template modify<HostMemSpace>();
-  refine_flag.template sync<DevExeSpace>();
 
-  return;
+  return (!changes.empty());
 }
 
 //----------------------------------------------------------------------------------------
@@ -318,8 +548,10 @@ void MeshRefinement::UpdateMeshBlockTree(int &nnew, int &ndel) {
     if (refine_flag.h_view(i+mbs) == -1) nderef_eachrank[global_variable::my_rank]++;
   }
 #if MPI_PARALLEL_ENABLED
-  MPI_Allgather(MPI_IN_PLACE, 1, MPI_INT, nref_eachrank,   1, MPI_INT, MPI_COMM_WORLD);
-  MPI_Allgather(MPI_IN_PLACE, 1, MPI_INT, nderef_eachrank, 1, MPI_INT, MPI_COMM_WORLD);
+  MPI_Allgather(MPI_IN_PLACE, 1, MPI_INT, nref_eachrank,   1, MPI_INT,
+                global_variable::mpi_comm);
+  MPI_Allgather(MPI_IN_PLACE, 1, MPI_INT, nderef_eachrank, 1, MPI_INT,
+                global_variable::mpi_comm);
 #endif
 
   // count the number of the blocks to be (de)refined over all ranks
@@ -371,11 +603,12 @@ void MeshRefinement::UpdateMeshBlockTree(int &nnew, int &ndel) {
   MPI_Type_commit(&lloc_type);
   if (tnref > 0) {
     MPI_Allgatherv(MPI_IN_PLACE, nref_eachrank[global_variable::my_rank], lloc_type,
-                   llref, nref_eachrank, nref_rsum, lloc_type, MPI_COMM_WORLD);
+                   llref, nref_eachrank, nref_rsum, lloc_type, global_variable::mpi_comm);
   }
   if (tnderef >= nleaf) {
     MPI_Allgatherv(MPI_IN_PLACE, nderef_eachrank[global_variable::my_rank], lloc_type,
-                   llderef, nderef_eachrank, nderef_rsum, lloc_type, MPI_COMM_WORLD);
+                   llderef, nderef_eachrank, nderef_rsum, lloc_type,
+                   global_variable::mpi_comm);
   }
   MPI_Type_free(&lloc_type);
 #endif
@@ -461,6 +694,7 @@ void MeshRefinement::UpdateMeshBlockTree(int &nnew, int &ndel) {
 //! Boundary values and primitives are set in calling function: AdaptiveMeshRefinement()
 
 void MeshRefinement::RedistAndRefineMeshBlocks(ParameterInput *pin, int nnew, int ndel) {
+  memory_tracker::Scope mem_scope("amr");
   Mesh* pm = pmy_mesh;
   int old_nmb = pm->nmb_total;
   int new_nmb = old_nmb + nnew - ndel;
@@ -468,6 +702,8 @@ void MeshRefinement::RedistAndRefineMeshBlocks(ParameterInput *pin, int nnew, in
   int nleaf = 2;
   if (pm->two_d) nleaf = 4;
   if (pm->three_d) nleaf = 8;
+  // costs of all MBs are needed to compute the new load balance
+  ShareMeasuredCosts();
 
   // Step 1. Create Z-ordered list of logical locations for new MBs, and newtoold list
   // mapping (new MB gid [n])-->(old gid) for all MBs. Index of array [n] is new gid,
@@ -504,18 +740,49 @@ void MeshRefinement::RedistAndRefineMeshBlocks(ParameterInput *pin, int nnew, in
     mb_idx++;
   }
 
+  // Set gids of particles in new MBs and count particles in each new MB
+  particles::Particles* ppart = pm->pmb_pack->ppart;
+  std::vector<int> new_nprtcl;
+  if (ppart != nullptr) {
+    ppart->SetGIDsForNewMesh(oldtonew, new_lloc_eachmb, new_nmb, new_nprtcl);
+  }
+
   // Step 3.
-  // Calculate new load balance. Initialize new cost array with the simplest estimate
-  // possible: all the blocks are equal
-  // TODO(@user): implement variable cost per MeshBlock as needed
+  // Calculate new load balance. Without measured costs, initialize new cost array with
+  // the simplest estimate possible: all the blocks are equal.  With measured costs,
+  // refined MBs inherit cost of their parent (same number of cells), and derefined MBs
+  // are assigned mean cost of their children.  The cost of particles in each new MB is
+  // added to the cost list used for load balancing (but not stored in cost_eachmb).
   new_cost_eachmb = new float[new_nmb];
   new_rank_eachmb = new int[new_nmb];
   new_gids_eachrank = new int[global_variable::nranks];
   new_nmb_eachrank = new int[global_variable::nranks];
 
   for (int i=0; i<new_nmb; i++) {new_cost_eachmb[i] = 1.0;}
-  pm->LoadBalance(new_cost_eachmb, new_rank_eachmb, new_gids_eachrank, new_nmb_eachrank,
-                  new_nmb_total);
+  if (measure_cost) {
+    for (int newm=0; newm<new_nmb; newm++) {
+      int oldm = newtoold[newm];
+      if (pm->lloc_eachmb[oldm].level > new_lloc_eachmb[newm].level) {
+        float cost = 0.0;
+        for (int l=0; l<nleaf; l++) {cost += pm->cost_eachmb[oldm+l];}
+        new_cost_eachmb[newm] = cost/static_cast<float>(nleaf);
+      } else {
+        new_cost_eachmb[newm] = pm->cost_eachmb[oldm];
+      }
+    }
+  }
+  // current rank of each new MB (refined MBs start on rank of their parent, and
+  // derefined MBs on rank of their first child), used by incremental rebalancing
+  std::vector<int> curr_rank(new_nmb);
+  for (int newm=0; newm<new_nmb; newm++) {
+    curr_rank[newm] = pm->rank_eachmb[newtoold[newm]];
+  }
+  std::vector<float> lb_cost(new_cost_eachmb, new_cost_eachmb + new_nmb);
+  if (ppart != nullptr) {
+    AddParticleCosts(new_cost_eachmb, new_nprtcl, new_nmb, lb_cost.data());
+  }
+  pm->LoadBalance(lb_cost.data(), new_rank_eachmb, new_gids_eachrank, new_nmb_eachrank,
+                  new_nmb_total, curr_rank.data());
   if (new_nmb_eachrank[global_variable::my_rank] > pm->nmb_maxperrank) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
         << "Number of MeshBlocks in this rank on new tree = "
@@ -603,37 +870,12 @@ void MeshRefinement::RedistAndRefineMeshBlocks(ParameterInput *pin, int nnew, in
     }
   }
 
-  // Step 8.
-  // Wait for all MPI load balancing communications to finish.  Unpack data.
-#if MPI_PARALLEL_ENABLED
-  if (nmb_send > 0) {ClearSendAMR();}
-  if (nmb_recv > 0) {ClearRecvAndUnpackAMR();}
-#endif
-
-  // copy newtoold array to DualView so that it can be accessed in kernel
-  DualArray1D<int> new_to_old("newtoold",new_nmb_total);
-  for (int m=0; m<new_nmb_total; ++m) {
-    new_to_old.h_view(m) = newtoold[m];
-  }
-  new_to_old.template modify<HostMemSpace>();
-  new_to_old.template sync<DevExeSpace>();
-
-  // Step 9.
-  // Coarse arrays are now up-to-date, either through copies on same rank or MPI calls
-  // So prolongate (refine) evolved physics variables for all MBs flagged for refinement.
-
-  if (nnew > 0) {
-    if (phydro != nullptr) {
-      RefineCC(new_to_old, phydro->u0, phydro->coarse_u0);
-    }
-    if (pmhd != nullptr) {
-      RefineCC(new_to_old, pmhd->u0, pmhd->coarse_u0);
-      RefineFC(new_to_old, pmhd->b0, pmhd->coarse_b0);
-    }
-    if (pz4c != nullptr) {
-      RefineCC(new_to_old, pz4c->u0, pz4c->coarse_u0, true);
-    }
-  }
+  // Step 8 and 9.
+  // Wait for MPI load balancing communications, unpack data, and prolongate MBs flagged
+  // for refinement.  With overlap_amr_comm this is deferred until after the new
+  // MeshBlocks, coordinates, and neighbors are built in Step 10 below, so that this
+  // (host) work overlaps with the transfer of MBs between ranks.
+  if (!(overlap_amr_comm)) {FinishRedistAndRefine(nnew, new_nmb_total);}
 
   // Update new number of cycles since refinement
   HostArray1D<int> new_ncyc_since_ref("nnref",new_nmb_total);
@@ -649,8 +891,16 @@ void MeshRefinement::RedistAndRefineMeshBlocks(ParameterInput *pin, int nnew, in
   Kokkos::deep_copy(ncyc_since_ref, new_ncyc_since_ref);
 
   // Step 10.
-  // Update data in Mesh/MeshBlockPack/MeshBlock classes with new grid properties
-  delete [] pm->lloc_eachmb;
+  // Update data in Mesh/MeshBlockPack/MeshBlock classes with new grid properties.  Old
+  // logical locations and neighbors are kept until new neighbors are set, so that they
+  // can be reused for MeshBlocks not affected by refinement.
+  OldNeighbors old_nghbr;
+  old_nghbr.nghbr = pm->pmb_pack->pmb->nghbr;
+  old_nghbr.gids = pm->pmb_pack->gids;
+  old_nghbr.nmb = pm->pmb_pack->nmb_thispack;
+  old_nghbr.lloc_eachmb = pm->lloc_eachmb;
+  old_nghbr.oldtonew = oldtonew;
+  old_nghbr.newtoold = newtoold;
   delete [] pm->rank_eachmb;
   delete [] pm->cost_eachmb;
   delete [] pm->gids_eachrank;
@@ -671,7 +921,13 @@ void MeshRefinement::RedistAndRefineMeshBlocks(ParameterInput *pin, int nnew, in
   delete (pm->pmb_pack->pcoord);
   pm->pmb_pack->AddMeshBlocks(pin);
   pm->pmb_pack->AddCoordinates(pin);
-  pm->pmb_pack->pmb->SetNeighbors(pm->ptree, pm->rank_eachmb);
+  pm->pmb_pack->pmb->SetNeighbors(pm->ptree, pm->rank_eachmb, &old_nghbr);
+  delete [] old_nghbr.lloc_eachmb;
+  if (overlap_amr_comm) {FinishRedistAndRefine(nnew, new_nmb_total);}
+
+  // Step 11.
+  // Move particles to the ranks owning their new MBs
+  if (ppart != nullptr) {ppart->RedistributeParticles(pm->rank_eachmb);}
 
   // clean-up and return
   delete [] newtoold;
@@ -679,6 +935,52 @@ void MeshRefinement::RedistAndRefineMeshBlocks(ParameterInput *pin, int nnew, in
   return;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void MeshRefinement::FinishRedistAndRefine()
+//! \brief Steps 8 and 9 of RedistAndRefineMeshBlocks(): waits for MPI communication of
+//! MeshBlocks, unpacks data, and prolongates evolved variables for all refined MBs.
+//! Only uses the arrays of the new MB hierarchy (new_nmb_eachrank, newtoold, etc.), so
+//! can be called either before or after the Mesh data has been updated in Step 10.
+
+void MeshRefinement::FinishRedistAndRefine(int nnew, int new_nmb_total) {
+  hydro::Hydro* phydro = pmy_mesh->pmb_pack->phydro;
+  mhd::MHD* pmhd = pmy_mesh->pmb_pack->pmhd;
+  z4c::Z4c* pz4c = pmy_mesh->pmb_pack->pz4c;
+
+  // Step 8.
+  // Wait for all MPI load balancing communications to finish.  Unpack data.
+#if MPI_PARALLEL_ENABLED
+  if (nmb_send > 0) {ClearSendAMR();}
+  if (nmb_recv > 0) {ClearRecvAndUnpackAMR();}
+#endif
+
+  // copy newtoold array to DualView so that it can be accessed in kernel
+  DualArray1D<int> new_to_old("newtoold",new_nmb_total);
+  for (int m=0; m<new_nmb_total; ++m) {
+    new_to_old.h_view(m) = newtoold[m];
+  }
+  new_to_old.template modify<HostMemSpace>();
+  new_to_old.template sync<DevExeSpace>();
+
+  // Step 9.
+  // Coarse arrays are now up-to-date, either through copies on same rank or MPI calls
+  // So prolongate (refine) evolved physics variables for all MBs flagged for refinement.
+
+  if (nnew > 0) {
+    if (phydro != nullptr) {
+      RefineCC(new_to_old, phydro->u0, phydro->coarse_u0);
+    }
+    if (pmhd != nullptr) {
+      RefineCC(new_to_old, pmhd->u0, pmhd->coarse_u0);
+      RefineFC(new_to_old, pmhd->b0, pmhd->coarse_b0);
+    }
+    if (pz4c != nullptr) {
+      RefineCC(new_to_old, pz4c->u0, pz4c->coarse_u0, true);
+    }
+  }
+  return;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void MeshRefinement::DerefineCCSameRank
 //! \brief For any MeshBlock m flagged for derefinment (refine_flag = -nleaf), copies
@@ -1180,8 +1482,17 @@ void MeshRefinement::RestrictCC(DvceArray5D<Real> &u, DvceArray5D<Real> &cu,
     bool is_z4c) {
   int nmb  = u.extent_int(0);  // TODO(@user): 1st index from L of in array must be NMB
   int nvar = u.extent_int(1);  // TODO(@user): 2nd index from L of in array must be NVAR
+  // with level_restrict, loop over l-th MB in restrict_mbs rather than all MBs
+  auto *pmb = pmy_mesh->pmb_pack->pmb;
+  bool use_list = level_restrict || restrict_slabs;
+  if (use_list) {nmb = pmb->nrestrict_mbs;}
+  auto rmbs = pmb->restrict_mbs.d_view;
+  // with restrict_slabs, skip cells deeper than the ng coarse cells sent to neighbors
+  bool use_mask = restrict_slabs;
+  auto cmask = pmb->coarse_mask.d_view;
 
   auto &indcs = pmy_mesh->mb_indcs;
+  int ng = indcs.ng;
   auto &cis = indcs.cis, &cie = indcs.cie;
   auto &cjs = indcs.cjs, &cje = indcs.cje;
   auto &cks = indcs.cks, &cke = indcs.cke;
@@ -1194,14 +1505,18 @@ void MeshRefinement::RestrictCC(DvceArray5D<Real> &u, DvceArray5D<Real> &cu,
   // restrict in 1D
   if (pmy_mesh->one_d) {
     par_for("restrictCC-1D",DevExeSpace(), 0,nmb-1, 0,nvar-1, cis,cie,
-    KOKKOS_LAMBDA(const int m, const int n, const int i) {
+    KOKKOS_LAMBDA(const int l, const int n, const int i) {
+      const int m = (use_list)? rmbs(l) : l;
+      if (use_mask && !CoarseCellUsed(cmask(m), indcs, ng, cks, cjs, i)) return;
       int finei = 2*i - cis;  // correct when cis=is
       cu(m,n,cks,cjs,i) = 0.5*(u(m,n,cks,cjs,finei) + u(m,n,cks,cjs,finei+1));
     });
   // restrict in 2D
   } else if (pmy_mesh->two_d) {
     par_for("restrictCC-2D",DevExeSpace(), 0,nmb-1, 0,nvar-1, cjs,cje, cis,cie,
-    KOKKOS_LAMBDA(const int m, const int n, const int j, const int i) {
+    KOKKOS_LAMBDA(const int l, const int n, const int j, const int i) {
+      const int m = (use_list)? rmbs(l) : l;
+      if (use_mask && !CoarseCellUsed(cmask(m), indcs, ng, cks, j, i)) return;
       int finei = 2*i - cis;  // correct when cis=is
       int finej = 2*j - cjs;  // correct when cjs=js
       cu(m,n,cks,j,i) = 0.25*(u(m,n,cks,finej  ,finei) + u(m,n,cks,finej  ,finei+1)
@@ -1211,7 +1526,9 @@ void MeshRefinement::RestrictCC(DvceArray5D<Real> &u, DvceArray5D<Real> &cu,
   // restrict in 3D
   } else {
     par_for("restrictCC-3D",DevExeSpace(), 0,nmb-1, 0,nvar-1, cks,cke, cjs,cje, cis,cie,
-    KOKKOS_LAMBDA(const int m, const int n, const int k, const int j, const int i) {
+    KOKKOS_LAMBDA(const int l, const int n, const int k, const int j, const int i) {
+      const int m = (use_list)? rmbs(l) : l;
+      if (use_mask && !CoarseCellUsed(cmask(m), indcs, ng, k, j, i)) return;
       int finei = 2*i - cis;  // correct when cis=is
       int finej = 2*j - cjs;  // correct when cjs=js
       int finek = 2*k - cks;  // correct when cks=ks
@@ -1242,6 +1559,15 @@ void MeshRefinement::RestrictCC(DvceArray5D<Real> &u, DvceArray5D<Real> &cu,
 
 void MeshRefinement::RestrictFC(DvceFaceFld4D<Real> &b, DvceFaceFld4D<Real> &cb) {
   int nmb  = b.x1f.extent_int(0);  // TODO(@user): 1st idx from L of in array must be NMB
+  auto *pmb = pmy_mesh->pmb_pack->pmb;
+  bool use_list = level_restrict || restrict_slabs;
+  if (use_list) {nmb = pmb->nrestrict_mbs;}
+  auto rmbs = pmb->restrict_mbs.d_view;
+  // with restrict_slabs, skip cells deeper than the ng+1 faces sent to neighbors
+  bool use_mask = restrict_slabs;
+  auto cmask = pmb->coarse_mask.d_view;
+  auto &indcs = pmy_mesh->mb_indcs;
+  int ng1 = indcs.ng + 1;
 
   auto &cis = pmy_mesh->mb_indcs.cis;
   auto &cie = pmy_mesh->mb_indcs.cie;
@@ -1253,7 +1579,9 @@ void MeshRefinement::RestrictFC(DvceFaceFld4D<Real> &b, DvceFaceFld4D<Real> &cb)
   // restrict in 1D
   if (pmy_mesh->one_d) {
     par_for("restrictFC-1D",DevExeSpace(), 0,nmb-1, cis,cie,
-    KOKKOS_LAMBDA(const int m, const int i) {
+    KOKKOS_LAMBDA(const int l, const int i) {
+      const int m = (use_list)? rmbs(l) : l;
+      if (use_mask && !CoarseCellUsed(cmask(m), indcs, ng1, cks, cjs, i)) return;
       int finei = 2*i - cis;  // correct when cis=is
       // restrict B1
       cb.x1f(m,cks,cjs,i) = b.x1f(m,cks,cjs,finei);
@@ -1273,7 +1601,9 @@ void MeshRefinement::RestrictFC(DvceFaceFld4D<Real> &b, DvceFaceFld4D<Real> &cb)
   // restrict in 2D
   } else if (pmy_mesh->two_d) {
     par_for("restrictFC-2D",DevExeSpace(), 0,nmb-1, cjs,cje, cis,cie,
-    KOKKOS_LAMBDA(const int m, const int j, const int i) {
+    KOKKOS_LAMBDA(const int l, const int j, const int i) {
+      const int m = (use_list)? rmbs(l) : l;
+      if (use_mask && !CoarseCellUsed(cmask(m), indcs, ng1, cks, j, i)) return;
       int finei = 2*i - cis;  // correct when cis=is
       int finej = 2*j - cjs;  // correct when cjs=js
       // restrict B1
@@ -1298,7 +1628,9 @@ void MeshRefinement::RestrictFC(DvceFaceFld4D<Real> &b, DvceFaceFld4D<Real> &cb)
   // restrict in 3D
   } else {
     par_for("restrictFC-3D",DevExeSpace(), 0,nmb-1, cks,cke, cjs,cje, cis,cie,
-    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    KOKKOS_LAMBDA(const int l, const int k, const int j, const int i) {
+      const int m = (use_list)? rmbs(l) : l;
+      if (use_mask && !CoarseCellUsed(cmask(m), indcs, ng1, k, j, i)) return;
       int finei = 2*i - cis;  // correct when cis=is
       int finej = 2*j - cjs;  // correct when cjs=js
       int finek = 2*k - cks;  // correct when cks=ks
@@ -8,6 +8,8 @@
 //! \file mesh_refinement.hpp
 //! \brief defines MeshRefinement class containing data and functions controlling SMR/AMR
 
+#include <limits>
+
 //----------------------------------------------------------------------------------------
 //! \fn int CreateAMR_MPI_Tag(int lid, int ox1, int ox2, int ox3)
 //! \brief calculate an MPI tag for AMR communications.  Note maximum size of
@@ -18,6 +20,21 @@ static int CreateAMR_MPI_Tag(int lid, int ox1, int ox2, int ox3) {
   return (ox1<<(NUM_BITS_LID+2)) | (ox2<<(NUM_BITS_LID+1))| (ox3<<(NUM_BITS_LID)) | lid;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn bool CoarseCellUsed(uint64_t mask, RegionIndcs &indcs, int w, int k, int j, int i)
+//! \brief true if restricted data in coarse cell (k,j,i) of a MB may be sent to a coarser
+//! neighbor or used for prolongation, given MeshBlock::coarse_mask of the MB.  Only
+//! cells within w of a face touching a coarser neighbor are used.
+
+KOKKOS_INLINE_FUNCTION
+bool CoarseCellUsed(const uint64_t mask, const RegionIndcs &indcs, const int w,
+                    const int k, const int j, const int i) {
+  int s = ((i < indcs.cis + w)? 1 : 0) | ((i > indcs.cie - w)? 2 : 0);
+  s |= (((j < indcs.cjs + w)? 1 : 0) | ((j > indcs.cje - w)? 2 : 0)) << 2;
+  s |= (((k < indcs.cks + w)? 1 : 0) | ((k > indcs.cke - w)? 2 : 0)) << 4;
+  return ((mask >> s) & 1);
+}
+
 //----------------------------------------------------------------------------------------
 //! \struct AMRBuffer
 //! \brief container for index ranges, storage, and flags for AMR buffers used with load
@@ -34,6 +51,75 @@ struct AMRBuffer {
 };
 #endif
 
+//----------------------------------------------------------------------------------------
+//! \struct RefinementCriteria
+//! \brief refinement criteria registered by physics modules with
+//! AddRefinementCriterion().  All are evaluated together in a single kernel over the
+//! MeshBlockPack.  Each criterion is computed from variable ivar of a cell-centered
+//! array, and flags a MB for refinement if the maximum (or minimum) of the quantity over
+//! active cells crosses refine_thresh, and for derefinement if it crosses
+//! derefine_thresh.  A MB is refined if any criterion requests it, and derefined only if
+//! every criterion allows it.
+
+// maximum number of refinement criteria evaluated in the fused kernel
+#define NREFINEMENT_CRITERIA 4
+
+enum class RefinementCriterionType {max_value, min_value, max_gradient, max_rel_gradient};
+
+struct RefinementCriteria {
+  int ncrit = 0;
+  RefinementCriterionType type[NREFINEMENT_CRITERIA];
+  DvceArray5D<Real> *pvar[NREFINEMENT_CRITERIA];  // pointer to member array of module
+  DvceArray5D<Real> var[NREFINEMENT_CRITERIA];    // copy of array, set before kernel
+  int ivar[NREFINEMENT_CRITERIA];
+  Real refine_thresh[NREFINEMENT_CRITERIA], derefine_thresh[NREFINEMENT_CRITERIA];
+};
+
+//----------------------------------------------------------------------------------------
+//! \struct CriteriaMax
+//! \brief Reduction type used to compute maximum of all refinement criteria over a MB
+//! at once, following the summed_array_type in athena.hpp (with += computing max).
+
+namespace array_max {  // namespace helps with name resolution in reduction identity
+struct CriteriaMax {
+  Real the_array[NREFINEMENT_CRITERIA];
+  KOKKOS_INLINE_FUNCTION   // Default constructor - Initialize to smallest value
+  CriteriaMax() {
+    for (int i = 0; i < NREFINEMENT_CRITERIA; i++ ) {
+      the_array[i] = -std::numeric_limits<float>::max();
+    }
+  }
+  KOKKOS_INLINE_FUNCTION   // Copy Constructor
+  CriteriaMax(const CriteriaMax & rhs) {
+    for (int i = 0; i < NREFINEMENT_CRITERIA; i++ ) {
+      the_array[i] = rhs.the_array[i];
+    }
+  }
+  KOKKOS_INLINE_FUNCTION   // max operator
+  CriteriaMax& operator += (const CriteriaMax& src) {
+    for (int i = 0; i < NREFINEMENT_CRITERIA; i++ ) {
+      the_array[i] = fmax(the_array[i], src.the_array[i]);
+    }
+    return *this;
+  }
+  KOKKOS_INLINE_FUNCTION   // volatile max operator
+  void operator += (const volatile CriteriaMax& src) volatile {
+    for (int i = 0; i < NREFINEMENT_CRITERIA; i++ ) {
+      the_array[i] = fmax(the_array[i], src.the_array[i]);
+    }
+  }
+};
+} // namespace array_max
+
+namespace Kokkos { //reduction identity must be defined in Kokkos namespace
+template<>
+struct reduction_identity< array_max::CriteriaMax > {
+  KOKKOS_FORCEINLINE_FUNCTION static array_max::CriteriaMax sum() {
+    return array_max::CriteriaMax();
+  }
+};
+}
+
 //----------------------------------------------------------------------------------------
 //! \class MeshRefinement
 //! \brief data/functions associated with SMR/AMR
@@ -50,10 +136,29 @@ class MeshRefinement {
   int ncyc_check_amr;        // # of cycles between checking mesh for ref/derefinement
   int refinement_interval;   // # of cycles between allowing successive ref/derefinement
   bool prolong_prims;        // flag to enable prolongation of primitive vars
+  bool overlap_amr_comm;     // overlap MB transfers with rebuild of mesh data
+  Real amr_buf_headroom;     // factor by which load balancing buffers grow when too small
+  bool level_restrict;       // restrict only MBs whose coarse data is used, by level
+  bool restrict_slabs;       // restrict only coarse cells next to coarser neighbors
+  bool excision_aware;       // refinement criteria ignore cells excised in horizons
+  int excision_level;        // level to which excised MBs are derefined (-1 = none)
+
+  // data for load balancing using measured cost of each MeshBlock
+  bool measure_cost;         // use measured (rather than uniform) cost of MeshBlocks
+  bool measure_weight;       // use measured throughput of each rank as its capacity
+  Real lb_tolerance;         // rebalance when max cost/rank exceeds mean by this fraction
+  Real lb_smoothing;         // weight of newest measurement in running mean of cost
+  double lb_time;            // time spent in "stagen" TaskLists since last measurement
+  int lb_ncycle;             // number of cycles included in lb_time
+  // With particles, cost of each MeshBlock is multiplied by (1 + lb_prtcl_cost*n/ncells)
+  // for n particles in the MB, where lb_prtcl_cost is the cost of updating one particle
+  // relative to one cell.  Particles are moved with their MeshBlocks.
+  Real lb_prtcl_cost;
 
   // following 2x Views are dimensioned [nmb_total]
   DualArray1D<int> refine_flag;    // refinement flag for each MeshBlock
   HostArray1D<int> ncyc_since_ref; // # of cycles since MB last refined/derefined
+  DvceArray1D<int> flag_list;      // compacted (gid,flag) of flagged MBs on this rank
 
   // following 4x arrays allocated with length [nranks] only with AMR
   int *nref_eachrank;     // number of MBs refined per rank
@@ -93,10 +198,15 @@ class MeshRefinement {
 #endif
 
   // functions
-  void CheckForRefinement(MeshBlockPack* pmbp);
+  void AddRefinementCriterion(RefinementCriterionType type, DvceArray5D<Real> *pvar,
+                              int ivar, Real refine_thresh, Real derefine_thresh);
+  void EvaluateRefinementCriteria(MeshBlockPack* pmbp);
+  void SetExcisedFlags(MeshBlockPack* pmbp);
+  bool CheckForRefinement(MeshBlockPack* pmbp);
   void AdaptiveMeshRefinement(Driver *pdrive, ParameterInput *pin);
   void UpdateMeshBlockTree(int &nnew, int &ndel);
   void RedistAndRefineMeshBlocks(ParameterInput *pin, int nnew, int ndel);
+  void FinishRedistAndRefine(int nnew, int new_nmb_total);
 
   void DerefineCCSameRank(DvceArray5D<Real> &a, DvceArray5D<Real> &ca);
   void DerefineFCSameRank(DvceFaceFld4D<Real> &b, DvceFaceFld4D<Real> &cb);
@@ -116,6 +226,13 @@ class MeshRefinement {
   void HighOrderRestrictCC(DvceArray5D<Real> &a, DvceArray5D<Real> &ca);
 
   // functions for load balancing (in file load_balance.cpp)
+  void UpdateMeasuredCosts();
+  void UpdateRankWeights();
+  float RankCost();
+  bool CheckForRebalance();
+  void ShareMeasuredCosts();
+  void AddParticleCosts(const float *cost, const std::vector<int> &nprtcl, int nmb,
+                        float *clist);
   void InitRecvAMR(int nleaf);
   void PackAndSendAMR(int nleaf);
   void PackAMRBuffersCC(DvceArray5D<Real> &a, DvceArray5D<Real> &ca, int ncc, int nfc);
@@ -133,5 +250,9 @@ class MeshRefinement {
   Mesh *pmy_mesh;
   Real d_threshold_, dd_threshold_, dp_threshold_, dv_threshold_, chi_threshold_;
   bool check_cons_;
+  bool cons_criteria_added_;  // true once hydro/MHD criteria added to criteria_
+  RefinementCriteria criteria_;
+  bool cost_measured_;       // true once cost_eachmb contains a measured value
+  bool costs_shared_;        // true if cost_eachmb on all ranks holds latest costs
 };
 #endif // MESH_MESH_REFINEMENT_HPP_
@@ -9,6 +9,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 #include "athena.hpp"
 #include "parameter_input.hpp"
@@ -27,7 +28,11 @@ MeshBlock::MeshBlock(MeshBlockPack* ppack, int igids, int nmb) :
   mb_gid("mb_gid",nmb),
   mb_lev("mb_lev",nmb),
   mb_size("mbsize",nmb),
-  mb_bcs("mbbcs",nmb,6) {
+  mb_bcs("mbbcs",nmb,6),
+  bc_mbs("bcmbs",3,nmb),
+  lev_mbs("levmbs",nmb),
+  restrict_mbs("restrictmbs",nmb),
+  coarse_mask("coarsemask",nmb) {
   Mesh* pm = pmy_pack->pmesh;
   auto &ms = pm->mesh_size;
 
@@ -121,16 +126,60 @@ MeshBlock::MeshBlock(MeshBlockPack* ppack, int igids, int nmb) :
     mb_size.h_view(m).idx3 = 1./mb_size.h_view(m).dx3;
   }
 
+  // Kernels that apply physical BCs in each direction are only launched if at least one
+  // MeshBlock in this pack has a face with such BCs, which is not the case on most ranks,
+  // and then only over the list of those MeshBlocks
+  for (int d=0; d<3; ++d) {
+    nbc_mbs[d] = 0;
+    for (int m=0; m<nmb; ++m) {
+      bool has_bc = false;
+      for (int f=2*d; f<=2*d+1; ++f) {
+        BoundaryFlag bc = mb_bcs.h_view(m,f);
+        if (bc != BoundaryFlag::block && bc != BoundaryFlag::periodic &&
+            bc != BoundaryFlag::shear_periodic && bc != BoundaryFlag::user) {
+          has_bc = true;
+        }
+      }
+      if (has_bc) {bc_mbs.h_view(d,nbc_mbs[d]++) = m;}
+    }
+    physical_bcs[d] = (nbc_mbs[d] > 0);
+  }
+
+  // Order MeshBlocks by level, so that work on each level of the pack can be done over a
+  // contiguous range of lev_mbs.  MBs on the same level stay in order of their gids.
+  lev_start.clear();
+  int nlevmbs = 0;
+  for (int lev=pm->root_level; nlevmbs < nmb; ++lev) {
+    int first = nlevmbs;
+    for (int m=0; m<nmb; ++m) {
+      if (mb_lev.h_view(m) == lev) {lev_mbs.h_view(nlevmbs++) = m;}
+    }
+    if (nlevmbs > first) {lev_start.push_back(first);}
+  }
+  lev_start.push_back(nlevmbs);
+  // until set by SetNeighbors(), all MBs are restricted
+  nrestrict_mbs = nmb;
+  for (int l=0; l<nmb; ++l) {restrict_mbs.h_view(l) = lev_mbs.h_view(nmb-1-l);}
+  for (int m=0; m<nmb; ++m) {coarse_mask.h_view(m) = ~static_cast<uint64_t>(0);}
+
   // For each DualArray: mark host views as modified, and then sync to device array
   mb_gid.template modify<HostMemSpace>();
   mb_lev.template modify<HostMemSpace>();
   mb_size.template modify<HostMemSpace>();
   mb_bcs.template modify<HostMemSpace>();
+  bc_mbs.template modify<HostMemSpace>();
+  lev_mbs.template modify<HostMemSpace>();
+  restrict_mbs.template modify<HostMemSpace>();
+  coarse_mask.template modify<HostMemSpace>();
 
   mb_gid.template sync<DevExeSpace>();
   mb_lev.template sync<DevExeSpace>();
   mb_size.template sync<DevExeSpace>();
   mb_bcs.template sync<DevExeSpace>();
+  bc_mbs.template sync<DevExeSpace>();
+  lev_mbs.template sync<DevExeSpace>();
+  restrict_mbs.template sync<DevExeSpace>();
+  coarse_mask.template sync<DevExeSpace>();
 }
 
 //----------------------------------------------------------------------------------------
@@ -141,8 +190,11 @@ MeshBlock::MeshBlock(MeshBlockPack* ppack, int igids, int nmb) :
 // Information about Neighbors are stored in a 2D Dual view of NeighborBlock structs
 // Indices of the view are (m,n) = (no. of MBs, no. of neighbors)
 // Based on SearchAndSetNeighbors() function in /src/bvals/bvals_base.cpp in C++ version
+// After AMR, neighbors of MeshBlocks not affected by the refinement are copied from the
+// old neighbors in pold (if provided) rather than searched for in the tree again.
 
-void MeshBlock::SetNeighbors(std::unique_ptr<MeshBlockTree> &ptree, int *ranklist) {
+void MeshBlock::SetNeighbors(std::unique_ptr<MeshBlockTree> &ptree, int *ranklist,
+                             const OldNeighbors *pold) {
   // min number of array elements needed to store MeshBlock neighbors withe SMR/AMR
   // Note not all buffers will be allocated for all nghbrs
   if (pmy_pack->pmesh->one_d) {nnghbr = 8;}
@@ -152,6 +204,9 @@ void MeshBlock::SetNeighbors(std::unique_ptr<MeshBlockTree> &ptree, int *ranklis
   // allocate size of DualArrays
   int nmb = pmy_pack->nmb_thispack;
   Kokkos::realloc(nghbr, nmb, nnghbr);
+  // MeshBlocks are deleted and rebuilt by AMR, so version must be counted globally
+  static int nghbr_version_count = 0;
+  nghbr_version = ++nghbr_version_count;
 
   // Initialize host view elements of DualViews
   for (int n=0; n<nnghbr; ++n) {
@@ -173,6 +228,7 @@ void MeshBlock::SetNeighbors(std::unique_ptr<MeshBlockTree> &ptree, int *ranklis
 
   // Search MeshBlock tree and find neighbors
   for (int b=0; b<nmb; ++b) {
+    if (pold != nullptr && ReuseOldNeighbors(b, *pold, ranklist)) continue;
     LogicalLocation lloc = pmy_pack->pmesh->lloc_eachmb[mb_gid.h_view(b)];
 
     // find location of this MeshBlock relative to XXXX
@@ -425,9 +481,114 @@ void MeshBlock::SetNeighbors(std::unique_ptr<MeshBlockTree> &ptree, int *ranklis
     }  // end loop over three_d
   }    // end loop over all MeshBlocks
 
+  // Coarse arrays of physics modules are only used by MBs with a neighbor at a coarser
+  // level, except with AMR where they are also used to refine/derefine MBs.  So they
+  // need not be allocated on ranks without any such MB (e.g. with nested-box SMR).
+  need_coarse = pmy_pack->pmesh->adaptive;
+  for (int b=0; b<nmb && !(need_coarse); ++b) {
+    for (int n=0; n<nnghbr; ++n) {
+      if (nghbr.h_view(b,n).gid >= 0 && nghbr.h_view(b,n).lev < mb_lev.h_view(b)) {
+        need_coarse = true;
+      }
+    }
+  }
+
+  // Restricted data of a MB is only used if it has a coarser neighbor (for sends to it,
+  // and to fill its coarse ghost zones for prolongation), except with AMR where it is
+  // also used to derefine MBs.  List these MBs level by level, finest first.
+  nrestrict_mbs = 0;
+  for (int l=nmb-1; l>=0; --l) {
+    int b = lev_mbs.h_view(l);
+    bool coarser = pmy_pack->pmesh->adaptive;
+    for (int n=0; n<nnghbr && !(coarser); ++n) {
+      if (nghbr.h_view(b,n).gid >= 0 && nghbr.h_view(b,n).lev < mb_lev.h_view(b)) {
+        coarser = true;
+      }
+    }
+    if (coarser) {restrict_mbs.h_view(nrestrict_mbs++) = b;}
+  }
+  restrict_mbs.template modify<HostMemSpace>();
+  restrict_mbs.template sync<DevExeSpace>();
+
+  // Within these MBs, restricted data is only sent to (or used to prolongate from) the
+  // regions of the coarse array next to coarser neighbors.  Bit s of coarse_mask is set
+  // if the coarse cells with (2-bit per direction) position s given by CoarseCellUsed()
+  // touch the face, edge or corner of such a neighbor.  With AMR all cells are used.
+  for (int b=0; b<nmb; ++b) {
+    // offsets of coarser neighbors, bit (ox1+1) + 3*(ox2+1) + 9*(ox3+1)
+    int dirs = 0;
+    for (int ox3=-1; ox3<=1; ++ox3) {
+      for (int ox2=-1; ox2<=1; ++ox2) {
+        for (int ox1=-1; ox1<=1; ++ox1) {
+          for (int f=0; f<4; ++f) {
+            int n = NeighborIndex(ox1, ox2, ox3, f & 1, f >> 1);
+            if (n >= 0 && n < nnghbr && nghbr.h_view(b,n).gid >= 0 &&
+                nghbr.h_view(b,n).lev < mb_lev.h_view(b)) {
+              dirs |= 1 << ((ox1+1) + 3*(ox2+1) + 9*(ox3+1));
+            }
+          }
+        }
+      }
+    }
+    uint64_t mask = 0;
+    for (int s=0; s<64; ++s) {
+      // position of cells in each direction: bit 0 = near lower, bit 1 = near upper face
+      int p[3] = {s & 3, (s >> 2) & 3, (s >> 4) & 3};
+      for (int d=0; d<27; ++d) {
+        if (!((dirs >> d) & 1)) continue;
+        int o[3] = {(d % 3) - 1, ((d/3) % 3) - 1, (d/9) - 1};
+        bool touch = true;
+        for (int a=0; a<3; ++a) {
+          if ((o[a] < 0 && !(p[a] & 1)) || (o[a] > 0 && !(p[a] & 2))) {touch = false;}
+        }
+        if (touch) {mask |= static_cast<uint64_t>(1) << s;}
+      }
+    }
+    if (pmy_pack->pmesh->adaptive) {mask = ~static_cast<uint64_t>(0);}
+    coarse_mask.h_view(b) = mask;
+  }
+  coarse_mask.template modify<HostMemSpace>();
+  coarse_mask.template sync<DevExeSpace>();
+
   // For each DualArray: mark host views as modified, and then sync to device array
   nghbr.template modify<HostMemSpace>();
   nghbr.template sync<DevExeSpace>();
 
   return;
 }
+
+//----------------------------------------------------------------------------------------
+// \!fn bool MeshBlock::ReuseOldNeighbors()
+// \brief sets neighbors of MeshBlock b from the neighbors it had before AMR, if it was on
+// this rank and neither it nor any of its neighbors was refined or derefined (so each
+// keeps its logical location).  Neighbors of a MeshBlock are the only leaves of the
+// tree that overlap its 3x3x3 neighborhood, so in that case only their gids and ranks
+// can have changed.  Returns false (and sets nothing) otherwise.
+
+bool MeshBlock::ReuseOldNeighbors(int b, const OldNeighbors &old, int *ranklist) {
+  auto same = [](const LogicalLocation &a, const LogicalLocation &c) {
+    return (a.level == c.level && a.lx1 == c.lx1 && a.lx2 == c.lx2 && a.lx3 == c.lx3);
+  };
+  const LogicalLocation *new_lloc = pmy_pack->pmesh->lloc_eachmb;
+  int gid = mb_gid.h_view(b);
+  int oldgid = old.newtoold[gid];
+  int ob = oldgid - old.gids;
+  if (ob < 0 || ob >= old.nmb || !same(old.lloc_eachmb[oldgid], new_lloc[gid])) {
+    return false;
+  }
+  for (int n=0; n<nnghbr; ++n) {
+    int ogid = old.nghbr.h_view(ob,n).gid;
+    if (ogid >= 0 && !same(old.lloc_eachmb[ogid], new_lloc[old.oldtonew[ogid]])) {
+      return false;
+    }
+  }
+  for (int n=0; n<nnghbr; ++n) {
+    nghbr.h_view(b,n) = old.nghbr.h_view(ob,n);
+    int ogid = old.nghbr.h_view(ob,n).gid;
+    if (ogid >= 0) {
+      nghbr.h_view(b,n).gid = old.oldtonew[ogid];
+      nghbr.h_view(b,n).rank = ranklist[old.oldtonew[ogid]];
+    }
+  }
+  return true;
+}
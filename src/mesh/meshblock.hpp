@@ -13,10 +13,23 @@
 //! containers called MashBlockPack.
 
 #include <memory>
+#include <vector>
 
 #include "bvals/bvals.hpp"
 #include "meshblock_pack.hpp"
 
+//----------------------------------------------------------------------------------------
+//! \struct OldNeighbors
+//! \brief neighbors of MeshBlocks on this rank before AMR, used by SetNeighbors() to
+//! reuse them (with updated gids and ranks) for MeshBlocks whose neighbors did not change
+
+struct OldNeighbors {
+  DualArray2D<NeighborBlock> nghbr;     // neighbors of old MBs on this rank
+  int gids, nmb;                        // first gid and number of old MBs on this rank
+  const LogicalLocation *lloc_eachmb;   // logical locations of all old MBs
+  const int *oldtonew, *newtoold;       // maps between old and new gids
+};
+
 //----------------------------------------------------------------------------------------
 //! \class MeshBlock
 //! \brief data/functions associated with each MeshBlock
@@ -33,6 +46,13 @@ class MeshBlock {
 
   // data
   int nnghbr;           // maximum number of neighbors for each MeshBlock
+  int nghbr_version=0;  // unique value set each time neighbors are reset (e.g. by AMR)
+  bool need_coarse=true;  // coarse arrays needed (MB with coarser neighbor, or AMR)
+  bool physical_bcs[3];   // any MB in pack has reflect/outflow/etc BCs in x1/x2/x3
+  int nbc_mbs[3];         // number of MBs with such BCs in x1/x2/x3
+  int nrestrict_mbs;      // number of MBs whose restricted (coarse) data is used
+  // lev_mbs[lev_start[l]..lev_start[l+1]-1] are the MBs on the l-th level in this pack
+  std::vector<int> lev_start;
 
   // DualArrays are used to store data used on both device and host
   // First dimension of each array will be [# of MeshBlocks in this MeshBlockPack]
@@ -40,13 +60,20 @@ class MeshBlock {
   DualArray1D<int> mb_lev;           // logical level of each MeshBlock
   DualArray1D<RegionSize> mb_size;   // physical size of each MeshBlock
   DualArray2D<BoundaryFlag> mb_bcs;  // boundary conditions at 6 faces of each MeshBlock
+  DualArray2D<int> bc_mbs;           // (d,l): index of l-th MB with physical BCs in x_d
+  DualArray1D<int> lev_mbs;          // indices of MBs ordered by level (coarsest first)
+  DualArray1D<int> restrict_mbs;     // MBs whose coarse data is used (finest first)
+  DualArray1D<uint64_t> coarse_mask; // regions of coarse array used (see CoarseCellUsed)
   DualArray2D<NeighborBlock> nghbr;  // data on all (up to 56) neighbors for each MB
 
   // function to set data describing neighbors
-  void SetNeighbors(std::unique_ptr<MeshBlockTree> &ptree, int *ranklist);
+  void SetNeighbors(std::unique_ptr<MeshBlockTree> &ptree, int *ranklist,
+                    const OldNeighbors *pold=nullptr);
 
  private:
   // data
   MeshBlockPack* pmy_pack;
+
+  bool ReuseOldNeighbors(int b, const OldNeighbors &old, int *ranklist);
 };
 #endif // MESH_MESHBLOCK_HPP_
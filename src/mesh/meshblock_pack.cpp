@@ -15,6 +15,8 @@
 #include "parameter_input.hpp"
 #include "mesh.hpp"
 #include "driver/driver.hpp"
+#include "driver/memory_tracker.hpp"
+#include "bvals/bvals.hpp"
 #include "hydro/hydro.hpp"
 #include "mhd/mhd.hpp"
 #include "ion-neutral/ion-neutral.hpp"
@@ -45,6 +47,15 @@ MeshBlockPack::MeshBlockPack(Mesh *pm, int igids, int igide) :
   tl_map.insert(std::make_pair("before_stagen",std::make_shared<TaskList>()));
   tl_map.insert(std::make_pair("stagen",std::make_shared<TaskList>()));
   tl_map.insert(std::make_pair("after_stagen",std::make_shared<TaskList>()));
+  tl_map.insert(std::make_pair("z4c_before_stagen",std::make_shared<TaskList>()));
+  tl_map.insert(std::make_pair("z4c_stagen",std::make_shared<TaskList>()));
+  tl_map.insert(std::make_pair("z4c_after_stagen",std::make_shared<TaskList>()));
+  tl_map.insert(std::make_pair("rad_before_stagen",std::make_shared<TaskList>()));
+  tl_map.insert(std::make_pair("rad_stagen",std::make_shared<TaskList>()));
+  tl_map.insert(std::make_pair("rad_after_stagen",std::make_shared<TaskList>()));
+  tl_map.insert(std::make_pair("before_sts",std::make_shared<TaskList>()));
+  tl_map.insert(std::make_pair("sts",std::make_shared<TaskList>()));
+  tl_map.insert(std::make_pair("after_sts",std::make_shared<TaskList>()));
 }
 
 //----------------------------------------------------------------------------------------
@@ -65,6 +76,8 @@ MeshBlockPack::~MeshBlockPack() {
   if (ppart  != nullptr) {delete ppart;}
   // must be last, since it calls ~BoundaryValues() which (MPI) uses pmy_pack->pmb->nnghbr
   delete pmb;
+  // buffers leased from pool by BoundaryValues of physics modules are unmanaged Views
+  if (pbuf_pool != nullptr) {delete pbuf_pool;}
 }
 
 //----------------------------------------------------------------------------------------
@@ -73,6 +86,7 @@ MeshBlockPack::~MeshBlockPack() {
 //! Allows for passing of pointer to 'this' pack.
 
 void MeshBlockPack::AddMeshBlocks(ParameterInput *pin) {
+  memory_tracker::Scope mem_scope("mesh");
   pmb = new MeshBlock(this, gids, nmb_thispack);
 }
 
@@ -83,6 +97,7 @@ void MeshBlockPack::AddMeshBlocks(ParameterInput *pin) {
 //! function, since latter uses data inside Coordinates class.
 
 void MeshBlockPack::AddCoordinates(ParameterInput *pin) {
+  memory_tracker::Scope mem_scope("coordinates");
   pcoord = new Coordinates(pin, this);
 }
 
@@ -107,6 +122,7 @@ void MeshBlockPack::AddPhysics(ParameterInput *pin) {
   // Create Hydro physics module.  Create TaskLists only for single-fluid hydro
   // (Note TaskLists stored in MeshBlockPack)
   if (pin->DoesBlockExist("hydro")) {
+    memory_tracker::Scope mem_scope("hydro");
     phydro = new hydro::Hydro(this, pin);
     nphysics++;
     if (!(pin->DoesBlockExist("mhd")) && !(pin->DoesBlockExist("radiation")) &&
@@ -120,6 +136,7 @@ void MeshBlockPack::AddPhysics(ParameterInput *pin) {
   // (3) MHD
   // Create MHD physics module.  Create TaskLists only for single-fluid MHD
   if (pin->DoesBlockExist("mhd")) {
+    memory_tracker::Scope mem_scope("mhd");
     pmhd = new mhd::MHD(this, pin);
     nphysics++;
     if (!(pin->DoesBlockExist("hydro")) && !(pin->DoesBlockExist("radiation")) &&
@@ -134,6 +151,7 @@ void MeshBlockPack::AddPhysics(ParameterInput *pin) {
   // Create Ion-Neutral physics module and TaskLists. Error if <hydro> and <mhd> are not
   // both defined as well.
   if (pin->DoesBlockExist("ion-neutral")) {
+    memory_tracker::Scope mem_scope("ion-neutral");
     pionn = new ion_neutral::IonNeutral(this, pin);   // construct new MHD object
     if (pin->DoesBlockExist("hydro") && pin->DoesBlockExist("mhd") &&
         !(pin->DoesBlockExist("adm")) && !(pin->DoesBlockExist("z4c")) ) {
@@ -159,6 +177,7 @@ void MeshBlockPack::AddPhysics(ParameterInput *pin) {
   // (5) RADIATION
   // Create radiation physics module.  Create tasklist.
   if (pin->DoesBlockExist("radiation")) {
+    memory_tracker::Scope mem_scope("radiation");
     prad = new radiation::Radiation(this, pin);
     nphysics++;
     prad->AssembleRadTasks(tl_map);
@@ -173,6 +192,7 @@ void MeshBlockPack::AddPhysics(ParameterInput *pin) {
   // force and adding force to fluid are included in operator_split and stage_run
   // task lists respectively.
   if (pin->DoesBlockExist("turb_driving")) {
+    memory_tracker::Scope mem_scope("turbulence");
     pturb = new TurbulenceDriver(this, pin);
     pturb->IncludeInitializeModesTask(tl_map["before_timeintegrator"], none);
     pturb->IncludeAddForcingTask(tl_map["stagen"], none);
@@ -183,13 +203,14 @@ void MeshBlockPack::AddPhysics(ParameterInput *pin) {
   // (7) Z4c and ADM
   // Create Z4c and ADM physics module.
   if (pin->DoesBlockExist("z4c")) {
-    pz4c = new z4c::Z4c(this, pin);
-    padm = new adm::ADM(this, pin);
+    {memory_tracker::Scope mem_scope("z4c"); pz4c = new z4c::Z4c(this, pin);}
+    {memory_tracker::Scope mem_scope("adm"); padm = new adm::ADM(this, pin);}
     ptmunu = nullptr;
     nphysics++;
   } else {
     pz4c = nullptr;
     if (pin->DoesBlockExist("adm")) {
+      memory_tracker::Scope mem_scope("adm");
       padm = new adm::ADM(this, pin);
     } else {
       padm = nullptr;
@@ -205,8 +226,8 @@ void MeshBlockPack::AddPhysics(ParameterInput *pin) {
   }
   if ((pin->DoesBlockExist("z4c") || pin->DoesBlockExist("adm")) &&
       (pin->DoesBlockExist("mhd")) ) {
-    pdyngr = dyngr::BuildDynGRMHD(this, pin);
-    ptmunu = new Tmunu(this, pin);
+    {memory_tracker::Scope mem_scope("dyngr"); pdyngr = dyngr::BuildDynGRMHD(this, pin);}
+    {memory_tracker::Scope mem_scope("tmunu"); ptmunu = new Tmunu(this, pin);}
   }
 
   if (pz4c != nullptr || padm != nullptr) {
@@ -217,6 +238,7 @@ void MeshBlockPack::AddPhysics(ParameterInput *pin) {
   // (8) PARTICLES
   // Create particles module.  Create tasklist.
   if (pin->DoesBlockExist("particles")) {
+    memory_tracker::Scope mem_scope("particles");
     ppart = new particles::Particles(this, pin);
     ppart->AssembleTasks(tl_map);
     nphysics++;
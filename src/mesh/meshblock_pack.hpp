@@ -20,6 +20,7 @@
 
 // Forward declarations
 class MeshBlock;
+class BoundaryBufferPool;
 class ADM;
 class Tmunu;
 namespace hydro {class Hydro;}
@@ -54,6 +55,13 @@ class MeshBlockPack {
   int gids, gide;         // start/end of global IDs in this MeshBlockPack
   int nmb_thispack;       // number of MBs in this pack
 
+  // Kokkos execution space instance on which kernels for this pack are launched.  The
+  // default-constructed instance is the shared default instance (e.g. CUDA stream 0), so
+  // with one pack per rank behavior is unchanged.  Storing the instance here allows
+  // kernels and fences (e.g. before posting MPI sends of boundary buffers) to be scoped
+  // to this pack, so that packs owning separate instances can overlap execution.
+  DevExeSpace exe_space;
+
   // following Grid/Physics objects are all pointers so they can be allocated after
   // MeshBlockPack is constructed with pointer to my_pack.
 
@@ -76,6 +84,9 @@ class MeshBlockPack {
   // units (needed to convert code units to cgs for, e.g., cooling or radiation)
   units::Units *punit=nullptr;
 
+  // device memory shared by boundary buffers of all physics (<mesh>/shared_bvals_pool)
+  BoundaryBufferPool *pbuf_pool=nullptr;
+
   // map for task lists which operate over all MeshBlocks in this MeshBlockPack
   std::map<std::string, std::shared_ptr<TaskList>> tl_map;
 
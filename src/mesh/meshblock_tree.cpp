@@ -477,3 +477,23 @@ MeshBlockTree* MeshBlockTree::FindMeshBlock(LogicalLocation tloc) {
   }
   return pleaf_[n]->FindMeshBlock(tloc);
 }
+
+//----------------------------------------------------------------------------------------
+//! \fn MeshBlockTree* MeshBlockTree::FindLeaf(LogicalLocation tloc)
+//! \brief find the leaf (MeshBlock) that contains LogicalLocation tloc, where tloc may
+//! be at the same or any finer level than the leaf.  Returns nullptr if no leaf exists.
+
+MeshBlockTree* MeshBlockTree::FindLeaf(LogicalLocation tloc) {
+  if (pleaf_ == nullptr) return this;
+  if (tloc.level == lloc_.level) return nullptr;
+  // get leaf index
+  int sh = tloc.level - lloc_.level - 1;
+  int mx = (((tloc.lx1>>sh) & 1) == 1);
+  int my = (((tloc.lx2>>sh) & 1) == 1);
+  int mz = (((tloc.lx3>>sh) & 1) == 1);
+  int n = mx + (my<<1) + (mz<<2);
+  if (pleaf_[n] == nullptr) {
+    return nullptr;
+  }
+  return pleaf_[n]->FindLeaf(tloc);
+}
@@ -52,7 +52,13 @@ MHD::MHD(MeshBlockPack *ppack, ParameterInput *pin) :
     e3_cc("e3_cc",1,1,1,1),
     utest("utest",1,1,1,1,1),
     bcctest("bcctest",1,1,1,1,1),
-    fofc("fofc",1,1,1,1) {
+    fofc("fofc",1,1,1,1),
+    c2p_count("c2p_count",1,1,1,1,1),
+    kin_vface("kin_vface",1,1,1,1,1),
+    u2_sts("cons2_sts",1,1,1,1,1),
+    dudt0_sts("dudt0_sts",1,1,1,1,1),
+    b2_sts("B_fc2_sts",1,1,1,1),
+    dbdt0_sts("dBdt0_sts",1,1,1,1) {
   // Total number of MeshBlocks on this rank to be used in array dimensioning
   int nmb = std::max((ppack->nmb_thispack), (ppack->pmesh->nmb_maxperrank));
 
@@ -128,33 +134,38 @@ MHD::MHD(MeshBlockPack *ppack, ParameterInput *pin) :
     int ncells1 = indcs.nx1 + 2*(indcs.ng);
     int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
     int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
-    Kokkos::realloc(u0,   nmb, (nmhd+nscalars), ncells3, ncells2, ncells1);
-    Kokkos::realloc(w0,   nmb, (nmhd+nscalars), ncells3, ncells2, ncells1);
+    ReallocFirstTouch(u0,   nmb, (nmhd+nscalars), ncells3, ncells2, ncells1);
+    ReallocFirstTouch(w0,   nmb, (nmhd+nscalars), ncells3, ncells2, ncells1);
 
     // allocate memory for face-centered and cell-centered magnetic fields
-    Kokkos::realloc(bcc0,   nmb, 3, ncells3, ncells2, ncells1);
-    Kokkos::realloc(b0.x1f, nmb, ncells3, ncells2, ncells1+1);
-    Kokkos::realloc(b0.x2f, nmb, ncells3, ncells2+1, ncells1);
-    Kokkos::realloc(b0.x3f, nmb, ncells3+1, ncells2, ncells1);
+    ReallocFirstTouch(bcc0,   nmb, 3, ncells3, ncells2, ncells1);
+    ReallocFirstTouch(b0.x1f, nmb, ncells3, ncells2, ncells1+1);
+    ReallocFirstTouch(b0.x2f, nmb, ncells3, ncells2+1, ncells1);
+    ReallocFirstTouch(b0.x3f, nmb, ncells3+1, ncells2, ncells1);
   }
 
-  // allocate memory for conserved variables on coarse mesh
-  if (ppack->pmesh->multilevel) {
+  // allocate memory for conserved variables on coarse mesh (only if used on this rank)
+  if (ppack->pmesh->multilevel && ppack->pmb->need_coarse) {
     auto &indcs = pmy_pack->pmesh->mb_indcs;
     int n_ccells1 = indcs.cnx1 + 2*(indcs.ng);
     int n_ccells2 = (indcs.cnx2 > 1)? (indcs.cnx2 + 2*(indcs.ng)) : 1;
     int n_ccells3 = (indcs.cnx3 > 1)? (indcs.cnx3 + 2*(indcs.ng)) : 1;
-    Kokkos::realloc(coarse_u0, nmb, (nmhd+nscalars), n_ccells3, n_ccells2, n_ccells1);
-    Kokkos::realloc(coarse_w0, nmb, (nmhd+nscalars), n_ccells3, n_ccells2, n_ccells1);
-    Kokkos::realloc(coarse_b0.x1f, nmb, n_ccells3, n_ccells2, n_ccells1+1);
-    Kokkos::realloc(coarse_b0.x2f, nmb, n_ccells3, n_ccells2+1, n_ccells1);
-    Kokkos::realloc(coarse_b0.x3f, nmb, n_ccells3+1, n_ccells2, n_ccells1);
+    ReallocFirstTouch(coarse_u0, nmb, (nmhd+nscalars), n_ccells3, n_ccells2, n_ccells1);
+    ReallocFirstTouch(coarse_w0, nmb, (nmhd+nscalars), n_ccells3, n_ccells2, n_ccells1);
+    ReallocFirstTouch(coarse_b0.x1f, nmb, n_ccells3, n_ccells2, n_ccells1+1);
+    ReallocFirstTouch(coarse_b0.x2f, nmb, n_ccells3, n_ccells2+1, n_ccells1);
+    ReallocFirstTouch(coarse_b0.x3f, nmb, n_ccells3+1, n_ccells2, n_ccells1);
   }
 
   // allocate boundary buffers for conserved (cell-centered) and face-centered variables
   pbval_u = new MeshBoundaryValuesCC(ppack, pin, false);
+  pbval_u->comm_module = comm_stats::Module::mhd;
+  pbval_u->SetHaloPrecision(pin, "mhd");
+  pbval_u->SetGhostDepth(pin, "mhd");
   pbval_u->InitializeBuffers((nmhd+nscalars));
   pbval_b = new MeshBoundaryValuesFC(ppack, pin);
+  pbval_b->comm_module = comm_stats::Module::mhd;
+  pbval_b->SetGhostDepth(pin, "mhd");
   pbval_b->InitializeBuffers(3);
 
   // Orbital advection and shearing box BCs (if requested in input file)
@@ -175,6 +186,26 @@ MHD::MHD(MeshBlockPack *ppack, ParameterInput *pin) :
     // determine if FOFC is enabled
     use_fofc = pin->GetOrAddBoolean("mhd","fofc",false);
 
+    // determine if iterations and floors of relativistic C2P are counted in each cell,
+    // accumulated on the device between outputs of the mhd_c2p variable
+    c2p_stats = pin->GetOrAddBoolean("mhd","c2p_stats",false);
+
+    // determine if all components of face-centered B are updated by CT in one kernel
+    fused_ct = pin->GetOrAddBoolean("mhd","fused_ct",false);
+
+    // determine if new timestep is computed in C2P kernel of last stage, rather than in
+    // a separate sweep over primitives.  Only implemented for non-relativistic EOS.
+    fused_newdt = pin->GetOrAddBoolean("mhd","fused_newdt",false);
+    if (fused_newdt && ((evolution_t.compare("dynamic") != 0) ||
+        pmy_pack->pcoord->is_special_relativistic ||
+        pmy_pack->pcoord->is_general_relativistic ||
+        pmy_pack->pcoord->is_dynamical_relativistic)) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<mhd>/fused_newdt can only be used for dynamic, "
+                << "non-relativistic problems" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+
     // select reconstruction method (default PLM)
     std::string xorder = pin->GetOrAddString("mhd","reconstruct","plm");
     if (xorder.compare("dc") == 0) {
@@ -182,29 +213,29 @@ MHD::MHD(MeshBlockPack *ppack, ParameterInput *pin) :
     } else if (xorder.compare("plm") == 0) {
       recon_method = ReconstructionMethod::plm;
       // check that nghost > 2 with PLM+FOFC
-      auto &indcs = pmy_pack->pmesh->mb_indcs;
-      if (use_fofc && indcs.ng < 3) {
+      int ng = pbval_u->nghost_same;
+      if (use_fofc && ng < 3) {
         std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
           << std::endl << "FOFC and " << xorder << " reconstruction requires at "
-          << "least 3 ghost zones, but <mesh>/nghost=" << indcs.ng << std::endl;
+          << "least 3 ghost zones, but <mhd>/nghost=" << ng << std::endl;
         std::exit(EXIT_FAILURE);
       }
     } else if (xorder.compare("ppm4") == 0 ||
                xorder.compare("ppmx") == 0 ||
                xorder.compare("wenoz") == 0) {
       // check that nghost > 2
-      auto &indcs = pmy_pack->pmesh->mb_indcs;
-      if (indcs.ng < 3) {
+      int ng = pbval_u->nghost_same;
+      if (ng < 3) {
         std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
           << std::endl << xorder << " reconstruction requires at least 3 ghost zones, "
-          << "but <mesh>/nghost=" << indcs.ng << std::endl;
+          << "but <mhd>/nghost=" << ng << std::endl;
         std::exit(EXIT_FAILURE);
       }
       // check that nghost > 3 with PPM4(or PPMX or WENOZ)+FOFC
-      if (use_fofc && indcs.ng < 4) {
+      if (use_fofc && ng < 4) {
         std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
           << std::endl << "FOFC and " << xorder << " reconstruction requires at "
-          << "least 4 ghost zones, but <mesh>/nghost=" << indcs.ng << std::endl;
+          << "least 4 ghost zones, but <mhd>/nghost=" << ng << std::endl;
         std::exit(EXIT_FAILURE);
       }
       if (xorder.compare("ppm4") == 0) {
@@ -297,6 +328,32 @@ MHD::MHD(MeshBlockPack *ppack, ParameterInput *pin) :
       }
     }
 
+    // integrate viscosity, resistivity and conduction with operator-split STS
+    if ((ppack->pmesh->sts_integrator != STSIntegrator::none) &&
+        ((pvisc != nullptr) || (presist != nullptr) || (pcond != nullptr))) {
+      sts_diffusion = true;
+      sts_bfield = (presist != nullptr) && (presist->eta_ohm > 0.0);
+      if (pin->DoesBlockExist("shearing_box")) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<time>/sts_integrator cannot be used with shearing "
+                  << "box" << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+    }
+
+    // determine if velocities are frozen in kinematic problems, in which case only the
+    // induction equation is integrated, with face velocities computed once
+    frozen_velocity = pin->GetOrAddBoolean("mhd","frozen_velocity",false);
+    if (frozen_velocity && ((evolution_t.compare("kinematic") != 0) || (nscalars > 0) ||
+        use_fofc || sts_diffusion || (pvisc != nullptr) || (pcond != nullptr) ||
+        pin->DoesBlockExist("shearing_box") || ppack->pmesh->adaptive)) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<mhd>/frozen_velocity can only be used for kinematic "
+                << "problems without passive scalars, FOFC, STS, viscosity, conduction, "
+                << "shearing box, or AMR" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+
     // Final memory allocations
     {
       // allocate second registers
@@ -304,18 +361,18 @@ MHD::MHD(MeshBlockPack *ppack, ParameterInput *pin) :
       int ncells1 = indcs.nx1 + 2*(indcs.ng);
       int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
       int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
-      Kokkos::realloc(u1,     nmb, (nmhd+nscalars), ncells3, ncells2, ncells1);
-      Kokkos::realloc(b1.x1f, nmb, ncells3, ncells2, ncells1+1);
-      Kokkos::realloc(b1.x2f, nmb, ncells3, ncells2+1, ncells1);
-      Kokkos::realloc(b1.x3f, nmb, ncells3+1, ncells2, ncells1);
+      ReallocFirstTouch(u1,     nmb, (nmhd+nscalars), ncells3, ncells2, ncells1);
+      ReallocFirstTouch(b1.x1f, nmb, ncells3, ncells2, ncells1+1);
+      ReallocFirstTouch(b1.x2f, nmb, ncells3, ncells2+1, ncells1);
+      ReallocFirstTouch(b1.x3f, nmb, ncells3+1, ncells2, ncells1);
 
       // allocate fluxes, electric fields
-      Kokkos::realloc(uflx.x1f, nmb, (nmhd+nscalars), ncells3, ncells2, ncells1+1);
-      Kokkos::realloc(uflx.x2f, nmb, (nmhd+nscalars), ncells3, ncells2+1, ncells1);
-      Kokkos::realloc(uflx.x3f, nmb, (nmhd+nscalars), ncells3+1, ncells2, ncells1);
-      Kokkos::realloc(efld.x1e, nmb, ncells3+1, ncells2+1, ncells1);
-      Kokkos::realloc(efld.x2e, nmb, ncells3+1, ncells2, ncells1+1);
-      Kokkos::realloc(efld.x3e, nmb, ncells3, ncells2+1, ncells1+1);
+      ReallocFirstTouch(uflx.x1f, nmb, (nmhd+nscalars), ncells3, ncells2, ncells1+1);
+      ReallocFirstTouch(uflx.x2f, nmb, (nmhd+nscalars), ncells3, ncells2+1, ncells1);
+      ReallocFirstTouch(uflx.x3f, nmb, (nmhd+nscalars), ncells3+1, ncells2, ncells1);
+      ReallocFirstTouch(efld.x1e, nmb, ncells3+1, ncells2+1, ncells1);
+      ReallocFirstTouch(efld.x2e, nmb, ncells3+1, ncells2, ncells1+1);
+      ReallocFirstTouch(efld.x3e, nmb, ncells3, ncells2+1, ncells1+1);
 
       // allocate scratch arrays for face- and cell-centered E used in CornerE
       Kokkos::realloc(e3x1, nmb, ncells3, ncells2, ncells1);
@@ -336,7 +393,30 @@ MHD::MHD(MeshBlockPack *ppack, ParameterInput *pin) :
         Kokkos::realloc(bcctest, nmb, 3,    ncells3, ncells2, ncells1);
         Kokkos::deep_copy(fofc, false);
       }
+
+      // allocate counters of C2P statistics
+      if (c2p_stats) {
+        Kokkos::realloc(c2p_count, nmb, 2, ncells3, ncells2, ncells1);
+        Kokkos::deep_copy(c2p_count, 0.0);
+      }
+
+      // allocate registers used with super-time-stepping
+      if (sts_diffusion) {
+        Kokkos::realloc(u2_sts,    nmb, (nmhd+nscalars), ncells3, ncells2, ncells1);
+        Kokkos::realloc(dudt0_sts, nmb, (nmhd+nscalars), ncells3, ncells2, ncells1);
+      }
+      if (sts_bfield) {
+        Kokkos::realloc(b2_sts.x1f,    nmb, ncells3, ncells2, ncells1+1);
+        Kokkos::realloc(b2_sts.x2f,    nmb, ncells3, ncells2+1, ncells1);
+        Kokkos::realloc(b2_sts.x3f,    nmb, ncells3+1, ncells2, ncells1);
+        Kokkos::realloc(dbdt0_sts.x1f, nmb, ncells3, ncells2, ncells1+1);
+        Kokkos::realloc(dbdt0_sts.x2f, nmb, ncells3, ncells2+1, ncells1);
+        Kokkos::realloc(dbdt0_sts.x3f, nmb, ncells3+1, ncells2, ncells1);
+      }
     }
+
+    // choose flux kernel for this combination of Riemann solver, reconstruction, EOS
+    SelectFluxKernel();
   }
 }
 
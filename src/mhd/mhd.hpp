@@ -78,6 +78,25 @@ struct MHDTaskIDs {
   TaskID newdt;
   TaskID csend;
   TaskID crecv;
+  TaskID sts_irecv;
+  TaskID sts_flux;
+  TaskID sts_sendf;
+  TaskID sts_recvf;
+  TaskID sts_updt;
+  TaskID sts_restu;
+  TaskID sts_sendu;
+  TaskID sts_recvu;
+  TaskID sts_sende;
+  TaskID sts_recve;
+  TaskID sts_ct;
+  TaskID sts_restb;
+  TaskID sts_sendb;
+  TaskID sts_recvb;
+  TaskID sts_bcs;
+  TaskID sts_prol;
+  TaskID sts_c2p;
+  TaskID sts_csend;
+  TaskID sts_crecv;
 };
 
 namespace mhd {
@@ -142,12 +161,36 @@ class MHD {
   // following used for FOFC algorithm
   DvceArray4D<bool> fofc;  // flag for each cell to indicate if FOFC is needed
   bool use_fofc = false;   // flag to enable FOFC
+  DvceArray1D<int> fofc_list;  // packed indices of cells flagged for FOFC
+
+  // following used for per-cell statistics of relativistic C2P (output as mhd_c2p)
+  bool c2p_stats = false;       // flag to accumulate C2P statistics in each cell
+  DvceArray5D<Real> c2p_count;  // C2P iterations (0), floors/failures (1) in each cell
+
+  bool fused_newdt = false;   // flag to compute dtnew in C2P kernel of last stage
+  bool fused_ct = false;      // flag to update all three face fields in one CT kernel
+  // following used to integrate only the induction equation in kinematic problems
+  bool frozen_velocity = false;  // flag to keep u0, w0 fixed (see mhd_kinematic.cpp)
+  DvceFaceFld5D<Real> kin_vface; // upwind face velocities cached with frozen_velocity
+  int kin_vface_version = -1;    // MeshBlock neighbor version when kin_vface was cached
+  DvceArray1D<Real> dtnew_mb;  // dtnew in each MeshBlock, see <time>/report_level_dt
+
+  // following used for operator-split super-time-stepping of diffusion terms
+  bool sts_diffusion = false;    // flag to integrate viscosity/resistivity/conduction
+  bool sts_bfield = false;       // flag to include B in STS (with resistivity)
+  DvceArray5D<Real> u2_sts;      // conserved variables at stage j-2 of STS
+  DvceArray5D<Real> dudt0_sts;   // diffusion operator applied to u at start of STS
+  DvceFaceFld4D<Real> b2_sts;    // face-centered fields at stage j-2 of STS
+  DvceFaceFld4D<Real> dbdt0_sts; // resistive dB/dt at start of STS
 
   // container to hold names of TaskIDs
   MHDTaskIDs id;
 
   // functions...
   void SetSaveWBcc();
+  // reset reconstruction method and Riemann solver after construction (used by the
+  // kernel_bench test problem generator)
+  void SetFluxMethods(ReconstructionMethod rm, MHD_RSolver rs);
   void AssembleMHDTasks(std::map<std::string, std::shared_ptr<TaskList>> tl);
   // ...in "before_timeintegrator" task list
   TaskStatus SaveMHDState(Driver *d, int stage);
@@ -183,12 +226,26 @@ class MHD {
   TaskStatus Prolongate(Driver* pdrive, int stage);
   TaskStatus ConToPrim(Driver *d, int stage);
   TaskStatus NewTimeStep(Driver *d, int stage);
+  // ...in "stagen_tl" task list with frozen_velocity, instead of Fluxes and ConToPrim
+  TaskStatus KinematicEMF(Driver *d, int stage);
+  TaskStatus KinematicBcc(Driver *d, int stage);
+  void CacheFaceVelocities();
   // ...in "after_stagen_tl" task list
   TaskStatus ClearSend(Driver *d, int stage);
   TaskStatus ClearRecv(Driver *d, int stage);  // also in Driver::Initialize
+  // ...in "before_sts", "sts" and "after_sts" task lists
+  void AssembleSTSTasks(std::map<std::string, std::shared_ptr<TaskList>> tl);
+  TaskStatus InitRecvSTS(Driver *d, int stage);
+  TaskStatus STSFluxes(Driver *d, int stage);
+  TaskStatus STSUpdate(Driver *d, int stage);
+  TaskStatus STSCT(Driver *d, int stage);
+  TaskStatus STSConToPrim(Driver *d, int stage);
+  TaskStatus STSClearSend(Driver *d, int stage);
+  TaskStatus STSClearRecv(Driver *d, int stage);
 
-  // CalculateFluxes function templated over Riemann Solvers
-  template <MHD_RSolver T>
+  // CalculateFluxes function templated over Riemann Solvers, and (optionally) over
+  // reconstruction method and EOS in specialized kernels
+  template <MHD_RSolver T, int R=-1, KernelEOS E=KernelEOS::any>
   void CalculateFluxes(Driver *d, int stage);
 
   // first-order flux correction
@@ -200,6 +257,15 @@ class MHD {
   MeshBlockPack* pmy_pack;   // ptr to MeshBlockPack containing this MHD
   // temporary variables used to store face-centered electric fields returned by RS
   DvceArray4D<Real> e1_cc, e2_cc, e3_cc;
+
+  // flux kernel chosen once at construction for Riemann solver, reconstruction, and EOS
+  using FluxKernel = void (MHD::*)(Driver *d, int stage);
+  FluxKernel calc_fluxes_ = nullptr;
+  void SelectFluxKernel();
+  template <MHD_RSolver T>
+  FluxKernel SpecializedFluxKernel();
+  template <MHD_RSolver T, int R>
+  FluxKernel SpecializedEOSKernel();
 };
 
 } // namespace mhd
@@ -414,8 +414,8 @@ TaskStatus MHD::CornerE(Driver *pdriver, int stage) {
     });
   }
 
-  // Add resistive electric field (if needed)
-  if (presist != nullptr) {
+  // Add resistive electric field (if needed, and not integrated with STS)
+  if ((presist != nullptr) && !(sts_diffusion)) {
     if (presist->eta_ohm > 0.0) {
       presist->OhmicEField(b0, efld);
     }
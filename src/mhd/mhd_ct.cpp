@@ -38,6 +38,45 @@ TaskStatus MHD::CT(Driver *pdriver, int stage) {
   auto e3 = efld.x3e;
   auto &mbsize = pmy_pack->pmb->mb_size;
 
+  //---- update all three components in one kernel over the union of the face ranges, so
+  // that each edge is read from memory once for the (up to) four faces that share it
+  if (fused_ct) {
+    auto bx1f = b0.x1f;
+    auto bx2f = b0.x2f;
+    auto bx3f = b0.x3f;
+    auto bx1f_old = b1.x1f;
+    auto bx2f_old = b1.x2f;
+    auto bx3f_old = b1.x3f;
+    par_for("CT-b", DevExeSpace(), 0, nmb1, ks, ke+1, js, je+1, is, ie+1,
+    KOKKOS_LAMBDA(int m, int k, int j, int i) {
+      Real &dx1 = mbsize.d_view(m).dx1;
+      Real &dx2 = mbsize.d_view(m).dx2;
+      Real &dx3 = mbsize.d_view(m).dx3;
+      if (multi_d && k <= ke && j <= je) {
+        bx1f(m,k,j,i) = gam0*bx1f(m,k,j,i) + gam1*bx1f_old(m,k,j,i);
+        bx1f(m,k,j,i) -= beta_dt*(e3(m,k,j+1,i) - e3(m,k,j,i))/dx2;
+        if (three_d) {
+          bx1f(m,k,j,i) += beta_dt*(e2(m,k+1,j,i) - e2(m,k,j,i))/dx3;
+        }
+      }
+      if (k <= ke && i <= ie) {
+        bx2f(m,k,j,i) = gam0*bx2f(m,k,j,i) + gam1*bx2f_old(m,k,j,i);
+        bx2f(m,k,j,i) += beta_dt*(e3(m,k,j,i+1) - e3(m,k,j,i))/dx1;
+        if (three_d) {
+          bx2f(m,k,j,i) -= beta_dt*(e1(m,k+1,j,i) - e1(m,k,j,i))/dx3;
+        }
+      }
+      if (j <= je && i <= ie) {
+        bx3f(m,k,j,i) = gam0*bx3f(m,k,j,i) + gam1*bx3f_old(m,k,j,i);
+        bx3f(m,k,j,i) -= beta_dt*(e2(m,k,j,i+1) - e2(m,k,j,i))/dx1;
+        if (multi_d) {
+          bx3f(m,k,j,i) += beta_dt*(e1(m,k,j+1,i) - e1(m,k,j,i))/dx2;
+        }
+      }
+    });
+    return TaskStatus::complete;
+  }
+
   //---- update B1 (only for 2D/3D problems)
   if (multi_d) {
     auto bx1f = b0.x1f;
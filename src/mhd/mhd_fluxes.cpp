@@ -13,6 +13,7 @@
 
 #include "athena.hpp"
 #include "mesh/mesh.hpp"
+#include "driver/profiler.hpp"
 #include "mhd.hpp"
 #include "eos/eos.hpp"
 #include "reconstruct/dc.hpp"
@@ -30,13 +31,25 @@
 // #include "mhd/rsolvers/roe_mhd.hpp"
 
 namespace mhd {
+//----------------------------------------------------------------------------------------
+//! \fn RSolverFlops()
+//! \brief Rough estimate of floating-point operations of Riemann solver per face, used to
+//! declare work of flux kernels to the profiler
+
+constexpr double RSolverFlops(const MHD_RSolver rs) {
+  return (rs == MHD_RSolver::advect)? 20.0 :
+         (rs == MHD_RSolver::llf)? 100.0 :
+         (rs == MHD_RSolver::hlle)? 130.0 :
+         (rs == MHD_RSolver::hlld)? 300.0 : 500.0;  // relativistic solvers
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void MHD::CalculateFlux
 //! \brief Calculate fluxes of conserved variables, and face-centered area-averaged EMFs
 //! for evolution of magnetic field
 //! Note this function is templated over RS for better performance on GPUs.
 
-template <MHD_RSolver rsolver_method_>
+template <MHD_RSolver rsolver_method_, int recon_, KernelEOS eos_kind_>
 void MHD::CalculateFluxes(Driver *pdriver, int stage) {
   RegionIndcs &indcs_ = pmy_pack->pmesh->mb_indcs;
   int is = indcs_.is, ie = indcs_.ie;
@@ -48,10 +61,6 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
   int nvars = nmhd + nscalars;
   int nmb1 = pmy_pack->nmb_thispack - 1;
   const auto recon_method_ = recon_method;
-  bool extrema = false;
-  if (recon_method == ReconstructionMethod::ppmx) {
-    extrema = true;
-  }
 
   auto &eos_ = peos->eos_data;
   auto &size_ = pmy_pack->pmb->mb_size;
@@ -59,6 +68,16 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
   auto &w0_ = w0;
   auto &b0_ = bcc0;
 
+  // estimated work per face for profiler: w0, bcc0 and face field read, and flux and two
+  // EMFs written once
+  const double face_bytes = (2.0*nvars + 6.0)*sizeof(Real);
+  const double face_flops = (nvars + 3)*ReconFlops(recon_method) +
+                            RSolverFlops(rsolver_method_);
+  auto add_work = [&](const char *name, int n3, int n2, int n1) {
+    double nface = static_cast<double>(nmb1 + 1)*n3*n2*n1;
+    AddKernelWork(name, nface*face_bytes, nface*face_flops);
+  };
+
   //--------------------------------------------------------------------------------------
   // i-direction
 
@@ -82,15 +101,19 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
   int il = is, iu = ie+1;
   if (use_fofc) { il = is-1, iu = ie+2; }
 
+  add_work("mhd_flux1", (ku - kl + 1), (ju - jl + 1), (iu - il + 1));
   par_for_outer("mhd_flux1",DevExeSpace(), scr_size, scr_level, 0, nmb1, kl, ku, jl, ju,
   KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+    // reconstruction method and EOS fixed at compile time in specialized kernels
+    const auto recon = SpecializedRecon<recon_>(recon_method_);
+    const bool extrema = (recon == ReconstructionMethod::ppmx);
     ScrArray2D<Real> wl(member.team_scratch(scr_level), nvars, ncells1);
     ScrArray2D<Real> wr(member.team_scratch(scr_level), nvars, ncells1);
     ScrArray2D<Real> bl(member.team_scratch(scr_level), 3, ncells1);
     ScrArray2D<Real> br(member.team_scratch(scr_level), 3, ncells1);
 
     // Reconstruct qR[i] and qL[i+1], for both W and Bcc
-    switch (recon_method_) {
+    switch (recon) {
       case ReconstructionMethod::dc:
         DonorCellX1(member, m, k, j, il-1, iu, w0_, wl, wr);
         DonorCellX1(member, m, k, j, il-1, iu, b0_, bl, br);
@@ -118,7 +141,7 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
     // (IBY) component of flx = E_{z} = -(v x B)_{z} = -(v1*b2 - v2*b1)
     // (IBZ) component of flx = E_{y} = -(v x B)_{y} =  (v1*b3 - v3*b1)
     // NOTE(@pdmullen): Capture variables prior to if constexpr.  Required for cuda 11.6+.
-    auto eos = eos_;
+    auto eos = SpecializeEOS<eos_kind_>(eos_);
     auto indcs = indcs_;
     auto size = size_;
     auto coord = coord_;
@@ -179,8 +202,12 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
     jl = js-1, ju = je+1;
     if (use_fofc) { jl = js-2, ju = je+2; }
 
+    add_work("mhd_flux2", (ku - kl + 1), (ju - jl), (ie - is + 1));
     par_for_outer("mhd_flux2",DevExeSpace(),scr_size,scr_level,0,nmb1, kl, ku,
     KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k) {
+      // reconstruction method and EOS fixed at compile time in specialized kernels
+      const auto recon = SpecializedRecon<recon_>(recon_method_);
+      const bool extrema = (recon == ReconstructionMethod::ppmx);
       ScrArray2D<Real> scr1(member.team_scratch(scr_level), nvars, ncells1);
       ScrArray2D<Real> scr2(member.team_scratch(scr_level), nvars, ncells1);
       ScrArray2D<Real> scr3(member.team_scratch(scr_level), nvars, ncells1);
@@ -204,7 +231,7 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
         }
 
         // Reconstruct qR[j] and qL[j+1], for both W and Bcc
-        switch (recon_method_) {
+        switch (recon) {
           case ReconstructionMethod::dc:
             DonorCellX2(member, m, k, j, is-1, ie+1, w0_, wl_jp1, wr);
             DonorCellX2(member, m, k, j, is-1, ie+1, b0_, bl_jp1, br);
@@ -232,7 +259,7 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
         // (IBZ) component of flx = E_{z} = -(v x B)_{z} =  (v2*b1 - v1*b2)
         if (j>jl) {
           // NOTE(@pdmullen): Capture variables prior to if constexpr.
-          auto eos = eos_;
+          auto eos = SpecializeEOS<eos_kind_>(eos_);
           auto indcs = indcs_;
           auto size = size_;
           auto coord = coord_;
@@ -299,8 +326,12 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
     kl = ks-1, ku = ke+1;
     if (use_fofc) { kl = ks-2, ku = ke+2; }
 
+    add_work("mhd_flux3", (ku - kl), (je - js + 3), (ie - is + 1));
     par_for_outer("mhd_flux3",DevExeSpace(), scr_size, scr_level, 0, nmb1, js-1, je+1,
     KOKKOS_LAMBDA(TeamMember_t member, const int m, const int j) {
+      // reconstruction method and EOS fixed at compile time in specialized kernels
+      const auto recon = SpecializedRecon<recon_>(recon_method_);
+      const bool extrema = (recon == ReconstructionMethod::ppmx);
       ScrArray2D<Real> scr1(member.team_scratch(scr_level), nvars, ncells1);
       ScrArray2D<Real> scr2(member.team_scratch(scr_level), nvars, ncells1);
       ScrArray2D<Real> scr3(member.team_scratch(scr_level), nvars, ncells1);
@@ -324,7 +355,7 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
         }
 
         // Reconstruct qR[k] and qL[k+1], for both W and Bcc
-        switch (recon_method_) {
+        switch (recon) {
           case ReconstructionMethod::dc:
             DonorCellX3(member, m, k, j, is-1, ie+1, w0_, wl_kp1, wr);
             DonorCellX3(member, m, k, j, is-1, ie+1, b0_, bl_kp1, br);
@@ -352,7 +383,7 @@ void MHD::CalculateFluxes(Driver *pdriver, int stage) {
         // (IBZ) component of flx = E_{x} = -(v x B)_{x} =  (v3*b2 - v2*b3)
         if (k>kl) {
           // NOTE(@pdmullen): Capture variables prior to if constexpr.
-          auto eos = eos_;
+          auto eos = SpecializeEOS<eos_kind_>(eos_);
           auto indcs = indcs_;
           auto size = size_;
           auto coord = coord_;
@@ -417,4 +448,90 @@ template void MHD::CalculateFluxes<MHD_RSolver::hlle_sr>(Driver *pdriver, int st
 template void MHD::CalculateFluxes<MHD_RSolver::llf_gr>(Driver *pdriver, int stage);
 template void MHD::CalculateFluxes<MHD_RSolver::hlle_gr>(Driver *pdriver, int stage);
 
+//----------------------------------------------------------------------------------------
+//! \fn MHD::FluxKernel MHD::SpecializedEOSKernel
+//! \brief Returns CalculateFluxes function specialized for reconstruction method R and
+//! the EOS in use if such kernels are compiled (see Athena_SPECIALIZED_RECON), otherwise
+//! the generic function that selects both at runtime.
+
+template <MHD_RSolver T, int R>
+MHD::FluxKernel MHD::SpecializedEOSKernel() {
+  if constexpr (IsSpecializedRecon(R)) {
+    if (peos->eos_data.is_ideal) {
+      return &MHD::CalculateFluxes<T, R, KernelEOS::ideal>;
+    }
+    // relativistic Riemann solvers are only implemented for an ideal gas
+    if constexpr ((T == MHD_RSolver::advect) ||
+                  (T == MHD_RSolver::llf) ||
+                  (T == MHD_RSolver::hlle) ||
+                  (T == MHD_RSolver::hlld)) {
+      return &MHD::CalculateFluxes<T, R, KernelEOS::isothermal>;
+    }
+  }
+  return &MHD::CalculateFluxes<T>;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn MHD::FluxKernel MHD::SpecializedFluxKernel
+//! \brief Returns CalculateFluxes function for Riemann solver T and the reconstruction
+//! method in use
+
+template <MHD_RSolver T>
+MHD::FluxKernel MHD::SpecializedFluxKernel() {
+  switch (recon_method) {
+    case ReconstructionMethod::dc:
+      return SpecializedEOSKernel<T, ReconstructionMethod::dc>();
+    case ReconstructionMethod::plm:
+      return SpecializedEOSKernel<T, ReconstructionMethod::plm>();
+    case ReconstructionMethod::ppm4:
+      return SpecializedEOSKernel<T, ReconstructionMethod::ppm4>();
+    case ReconstructionMethod::ppmx:
+      return SpecializedEOSKernel<T, ReconstructionMethod::ppmx>();
+    case ReconstructionMethod::wenoz:
+      return SpecializedEOSKernel<T, ReconstructionMethod::wenoz>();
+    default:
+      break;
+  }
+  return &MHD::CalculateFluxes<T>;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MHD::SelectFluxKernel
+//! \brief Chooses CalculateFluxes function once at construction, based on rsolver_method,
+//! recon_method, and EOS, so no branches on these are needed when fluxes are computed.
+
+void MHD::SelectFluxKernel() {
+  if (rsolver_method == MHD_RSolver::advect) {
+    calc_fluxes_ = SpecializedFluxKernel<MHD_RSolver::advect>();
+  } else if (rsolver_method == MHD_RSolver::llf) {
+    calc_fluxes_ = SpecializedFluxKernel<MHD_RSolver::llf>();
+  } else if (rsolver_method == MHD_RSolver::hlle) {
+    calc_fluxes_ = SpecializedFluxKernel<MHD_RSolver::hlle>();
+  } else if (rsolver_method == MHD_RSolver::hlld) {
+    calc_fluxes_ = SpecializedFluxKernel<MHD_RSolver::hlld>();
+  } else if (rsolver_method == MHD_RSolver::llf_sr) {
+    calc_fluxes_ = SpecializedFluxKernel<MHD_RSolver::llf_sr>();
+  } else if (rsolver_method == MHD_RSolver::hlle_sr) {
+    calc_fluxes_ = SpecializedFluxKernel<MHD_RSolver::hlle_sr>();
+  } else if (rsolver_method == MHD_RSolver::llf_gr) {
+    calc_fluxes_ = SpecializedFluxKernel<MHD_RSolver::llf_gr>();
+  } else if (rsolver_method == MHD_RSolver::hlle_gr) {
+    calc_fluxes_ = SpecializedFluxKernel<MHD_RSolver::hlle_gr>();
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MHD::SetFluxMethods
+//! \brief Changes reconstruction method and Riemann solver, and selects the matching
+//! CalculateFluxes function.  No checks are made that the combination is valid for the
+//! EOS and number of ghost zones; these are only made in the constructor.
+
+void MHD::SetFluxMethods(ReconstructionMethod rm, MHD_RSolver rs) {
+  recon_method = rm;
+  rsolver_method = rs;
+  SelectFluxKernel();
+  return;
+}
+
 } // namespace mhd
@@ -13,6 +13,7 @@
 #include "coordinates/cartesian_ks.hpp"
 #include "coordinates/cell_locations.hpp"
 #include "eos/eos.hpp"
+#include "utils/cell_list.hpp"
 #include "mhd/rsolvers/llf_mhd_singlestate.hpp"
 #include "mhd.hpp"
 
@@ -128,10 +129,21 @@ void MHD::FOFC(Driver *pdriver, int stage) {
   if (multi_d) { jl = js-1, ju = je+1; }
   if (three_d) { kl = ks-1, ku = ke+1; }
 
+  // Compact indices of cells flagged for FOFC and/or about the excision into a list, so
+  // that the kernels below are only launched over flagged cells
+  CellRange range{nmb, kl, ku, jl, ju, il, iu};
+  int nflag = FlaggedCellList(range, use_fofc, fofc, (is_gr && use_excise_),
+                              excision_flux_, fofc_list);
+  if (nflag == 0) return;
+  auto &fofc_list_ = fofc_list;
+
   // Replace fluxes with first-order LLF fluxes at i,j,k faces for any cell where FOFC
   // and/or excision is used (if GR+excising)
-  par_for("FOFC-flx", DevExeSpace(), 0, nmb-1, kl, ku, jl, ju, il, iu,
-  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+  par_for("FOFC-flx", DevExeSpace(), 0, nflag-1,
+  KOKKOS_LAMBDA(const int idx) {
+    int m, k, j, i;
+    range.Unpack(fofc_list_(idx), m, k, j, i);
+
     // Check for FOFC flag
     bool fofc_flag = false;
     if (use_fofc_) { fofc_flag = fofc_(m,k,j,i); }
@@ -307,8 +319,11 @@ void MHD::FOFC(Driver *pdriver, int stage) {
 
   // Replace fluxes with first-order LLF fluxes at i+1,j+1,k+1 faces for any cell where
   // FOFC and/or excision is used (if GR+excising)
-  par_for("FOFC-flx", DevExeSpace(), 0, nmb-1, kl, ku, jl, ju, il, iu,
-  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+  par_for("FOFC-flx", DevExeSpace(), 0, nflag-1,
+  KOKKOS_LAMBDA(const int idx) {
+    int m, k, j, i;
+    range.Unpack(fofc_list_(idx), m, k, j, i);
+
     // Check for FOFC flag
     bool fofc_flag = false;
     if (use_fofc_) { fofc_flag = fofc_(m,k,j,i); }
@@ -482,9 +497,14 @@ void MHD::FOFC(Driver *pdriver, int stage) {
     }
   });
 
-  // reset FOFC flag (do not reset excision flag)
+  // reset FOFC flag of cells in list (do not reset excision flag)
   if (use_fofc_) {
-    Kokkos::deep_copy(fofc, false);
+    par_for("FOFC-reset", DevExeSpace(), 0, nflag-1,
+    KOKKOS_LAMBDA(const int idx) {
+      int m, k, j, i;
+      range.Unpack(fofc_list_(idx), m, k, j, i);
+      fofc_(m,k,j,i) = false;
+    });
   }
 
   return;
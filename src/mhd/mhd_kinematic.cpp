@@ -0,0 +1,425 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file mhd_kinematic.cpp
+//! \brief Integration of the induction equation alone in kinematic problems with
+//! <mhd>/frozen_velocity = true.  The conserved and primitive variables are never
+//! updated, so the upwind velocities on cell faces (and the mass fluxes used to upwind
+//! the corner EMFs in CornerE) computed by the advect Riemann solver are the same in
+//! every stage.  They are computed once and cached, and each stage only reconstructs
+//! the cell-centered field to compute face-centered EMFs E = -(v X B), followed by
+//! CornerE, CT, and communication of B.
+
+#include "athena.hpp"
+#include "mesh/mesh.hpp"
+#include "driver/driver.hpp"
+#include "mhd.hpp"
+#include "eos/eos.hpp"
+#include "reconstruct/dc.hpp"
+#include "reconstruct/plm.hpp"
+#include "reconstruct/ppm.hpp"
+#include "reconstruct/wenoz.hpp"
+
+namespace mhd {
+//----------------------------------------------------------------------------------------
+//! \fn void MHD::CacheFaceVelocities
+//! \brief Stores upwind velocities on faces in kin_vface, in the order (normal, first
+//! transverse, second transverse) component used by the advect Riemann solver followed
+//! by 1 (0) if the left (right) state is upwind, and the upwind mass fluxes in uflx.
+//! Face ranges are those of CalculateFluxes().
+
+void MHD::CacheFaceVelocities() {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, ie = indcs.ie;
+  int js = indcs.js, je = indcs.je;
+  int ks = indcs.ks, ke = indcs.ke;
+  int ncells1 = indcs.nx1 + 2*(indcs.ng);
+  int nvars = nmhd;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  const auto recon = recon_method;
+  const bool extrema = (recon == ReconstructionMethod::ppmx);
+  auto &eos_ = peos->eos_data;
+  auto &w0_ = w0;
+
+  auto &u1f = uflx.x1f;
+  int n0 = static_cast<int>(u1f.extent(0));
+  int n3 = static_cast<int>(u1f.extent(2));
+  int n2 = static_cast<int>(u1f.extent(3));
+  int n1 = static_cast<int>(u1f.extent(4)) - 1;
+  Kokkos::realloc(kin_vface.x1f, n0, 4, n3, n2, n1+1);
+  Kokkos::realloc(kin_vface.x2f, n0, 4, n3, n2+1, n1);
+  Kokkos::realloc(kin_vface.x3f, n0, 4, n3+1, n2, n1);
+
+  //--------------------------------------------------------------------------------------
+  // i-direction
+
+  size_t scr_size = ScrArray2D<Real>::shmem_size(nvars, ncells1) * 2;
+  int scr_level = 0;
+  auto &flx1 = uflx.x1f;
+  auto &vf1 = kin_vface.x1f;
+  int jl,ju,kl,ku;
+  if (pmy_pack->pmesh->one_d) {
+    jl = js, ju = je, kl = ks, ku = ke;
+  } else if (pmy_pack->pmesh->two_d) {
+    jl = js-1, ju = je+1, kl = ks, ku = ke;
+  } else {
+    jl = js-1, ju = je+1, kl = ks-1, ku = ke+1;
+  }
+
+  par_for_outer("kin_vf1",DevExeSpace(), scr_size, scr_level, 0, nmb1, kl, ku, jl, ju,
+  KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+    ScrArray2D<Real> wl(member.team_scratch(scr_level), nvars, ncells1);
+    ScrArray2D<Real> wr(member.team_scratch(scr_level), nvars, ncells1);
+    switch (recon) {
+      case ReconstructionMethod::dc:
+        DonorCellX1(member, m, k, j, is-1, ie+1, w0_, wl, wr);
+        break;
+      case ReconstructionMethod::plm:
+        PiecewiseLinearX1(member, m, k, j, is-1, ie+1, w0_, wl, wr);
+        break;
+      case ReconstructionMethod::ppm4:
+      case ReconstructionMethod::ppmx:
+        PiecewiseParabolicX1(member, eos_, extrema, true, m, k, j, is-1, ie+1, w0_, wl,
+                             wr);
+        break;
+      case ReconstructionMethod::wenoz:
+        WENOZX1(member, eos_, true, m, k, j, is-1, ie+1, w0_, wl, wr);
+        break;
+      default:
+        break;
+    }
+    member.team_barrier();
+
+    par_for_inner(member, is, ie+1, [&](const int i) {
+      bool left = (wl(IVX,i) >= 0.0);
+      auto &w = (left)? wl : wr;
+      vf1(m,0,k,j,i) = w(IVX,i);
+      vf1(m,1,k,j,i) = w(IVY,i);
+      vf1(m,2,k,j,i) = w(IVZ,i);
+      vf1(m,3,k,j,i) = (left)? 1.0 : 0.0;
+      flx1(m,IDN,k,j,i) = w(IDN,i)*w(IVX,i);
+    });
+  });
+
+  //--------------------------------------------------------------------------------------
+  // j-direction
+
+  if (pmy_pack->pmesh->multi_d) {
+    scr_size = ScrArray2D<Real>::shmem_size(nvars, ncells1) * 3;
+    auto &flx2 = uflx.x2f;
+    auto &vf2 = kin_vface.x2f;
+    if (pmy_pack->pmesh->two_d) {
+      kl = ks, ku = ke;
+    } else {
+      kl = ks-1, ku = ke+1;
+    }
+
+    par_for_outer("kin_vf2",DevExeSpace(), scr_size, scr_level, 0, nmb1, kl, ku,
+    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k) {
+      ScrArray2D<Real> scr1(member.team_scratch(scr_level), nvars, ncells1);
+      ScrArray2D<Real> scr2(member.team_scratch(scr_level), nvars, ncells1);
+      ScrArray2D<Real> wr(member.team_scratch(scr_level), nvars, ncells1);
+
+      for (int j=js-1; j<=je+1; ++j) {
+        // Permute scratch arrays.
+        auto wl     = ((j%2) == 0)? scr2 : scr1;
+        auto wl_jp1 = ((j%2) == 0)? scr1 : scr2;
+        switch (recon) {
+          case ReconstructionMethod::dc:
+            DonorCellX2(member, m, k, j, is-1, ie+1, w0_, wl_jp1, wr);
+            break;
+          case ReconstructionMethod::plm:
+            PiecewiseLinearX2(member, m, k, j, is-1, ie+1, w0_, wl_jp1, wr);
+            break;
+          case ReconstructionMethod::ppm4:
+          case ReconstructionMethod::ppmx:
+            PiecewiseParabolicX2(member,eos_,extrema,true,m,k,j,is-1,ie+1,w0_,wl_jp1,wr);
+            break;
+          case ReconstructionMethod::wenoz:
+            WENOZX2(member, eos_, true, m, k, j, is-1, ie+1, w0_, wl_jp1, wr);
+            break;
+          default:
+            break;
+        }
+        member.team_barrier();
+
+        if (j > js-1) {
+          par_for_inner(member, is-1, ie+1, [&](const int i) {
+            bool left = (wl(IVY,i) >= 0.0);
+            auto &w = (left)? wl : wr;
+            vf2(m,0,k,j,i) = w(IVY,i);
+            vf2(m,1,k,j,i) = w(IVZ,i);
+            vf2(m,2,k,j,i) = w(IVX,i);
+            vf2(m,3,k,j,i) = (left)? 1.0 : 0.0;
+            flx2(m,IDN,k,j,i) = w(IDN,i)*w(IVY,i);
+          });
+          member.team_barrier();
+        }
+      }
+    });
+  }
+
+  //--------------------------------------------------------------------------------------
+  // k-direction. Note order of k,j loops switched
+
+  if (pmy_pack->pmesh->three_d) {
+    scr_size = ScrArray2D<Real>::shmem_size(nvars, ncells1) * 3;
+    auto &flx3 = uflx.x3f;
+    auto &vf3 = kin_vface.x3f;
+
+    par_for_outer("kin_vf3",DevExeSpace(), scr_size, scr_level, 0, nmb1, js-1, je+1,
+    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int j) {
+      ScrArray2D<Real> scr1(member.team_scratch(scr_level), nvars, ncells1);
+      ScrArray2D<Real> scr2(member.team_scratch(scr_level), nvars, ncells1);
+      ScrArray2D<Real> wr(member.team_scratch(scr_level), nvars, ncells1);
+
+      for (int k=ks-1; k<=ke+1; ++k) {
+        // Permute scratch arrays.
+        auto wl     = ((k%2) == 0)? scr2 : scr1;
+        auto wl_kp1 = ((k%2) == 0)? scr1 : scr2;
+        switch (recon) {
+          case ReconstructionMethod::dc:
+            DonorCellX3(member, m, k, j, is-1, ie+1, w0_, wl_kp1, wr);
+            break;
+          case ReconstructionMethod::plm:
+            PiecewiseLinearX3(member, m, k, j, is-1, ie+1, w0_, wl_kp1, wr);
+            break;
+          case ReconstructionMethod::ppm4:
+          case ReconstructionMethod::ppmx:
+            PiecewiseParabolicX3(member,eos_,extrema,true,m,k,j,is-1,ie+1,w0_,wl_kp1,wr);
+            break;
+          case ReconstructionMethod::wenoz:
+            WENOZX3(member, eos_, true, m, k, j, is-1, ie+1, w0_, wl_kp1, wr);
+            break;
+          default:
+            break;
+        }
+        member.team_barrier();
+
+        if (k > ks-1) {
+          par_for_inner(member, is-1, ie+1, [&](const int i) {
+            bool left = (wl(IVZ,i) >= 0.0);
+            auto &w = (left)? wl : wr;
+            vf3(m,0,k,j,i) = w(IVZ,i);
+            vf3(m,1,k,j,i) = w(IVX,i);
+            vf3(m,2,k,j,i) = w(IVY,i);
+            vf3(m,3,k,j,i) = (left)? 1.0 : 0.0;
+            flx3(m,IDN,k,j,i) = w(IDN,i)*w(IVZ,i);
+          });
+          member.team_barrier();
+        }
+      }
+    });
+  }
+
+  kin_vface_version = pmy_pack->pmb->nghbr_version;
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus MHD::KinematicEMF
+//! \brief Computes face-centered EMFs from the reconstructed cell-centered field and the
+//! cached upwind face velocities, giving the same EMFs as the advect Riemann solver
+
+TaskStatus MHD::KinematicEMF(Driver *pdriver, int stage) {
+  if (kin_vface_version != pmy_pack->pmb->nghbr_version ||
+      kin_vface.x1f.extent(0) != uflx.x1f.extent(0)) {
+    CacheFaceVelocities();
+  }
+
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, ie = indcs.ie;
+  int js = indcs.js, je = indcs.je;
+  int ks = indcs.ks, ke = indcs.ke;
+  int ncells1 = indcs.nx1 + 2*(indcs.ng);
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  const auto recon = recon_method;
+  const bool extrema = (recon == ReconstructionMethod::ppmx);
+  auto &eos_ = peos->eos_data;
+  auto &b0_ = bcc0;
+
+  //--------------------------------------------------------------------------------------
+  // i-direction: E_{z} = -(v1*b2 - v2*b1) and E_{y} = (v1*b3 - v3*b1)
+
+  size_t scr_size = ScrArray2D<Real>::shmem_size(3, ncells1) * 2;
+  int scr_level = 0;
+  auto &vf1 = kin_vface.x1f;
+  auto &bx = b0.x1f;
+  auto &e31 = e3x1;
+  auto &e21 = e2x1;
+  int jl,ju,kl,ku;
+  if (pmy_pack->pmesh->one_d) {
+    jl = js, ju = je, kl = ks, ku = ke;
+  } else if (pmy_pack->pmesh->two_d) {
+    jl = js-1, ju = je+1, kl = ks, ku = ke;
+  } else {
+    jl = js-1, ju = je+1, kl = ks-1, ku = ke+1;
+  }
+
+  par_for_outer("kin_emf1",DevExeSpace(), scr_size, scr_level, 0, nmb1, kl, ku, jl, ju,
+  KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+    ScrArray2D<Real> bl(member.team_scratch(scr_level), 3, ncells1);
+    ScrArray2D<Real> br(member.team_scratch(scr_level), 3, ncells1);
+    switch (recon) {
+      case ReconstructionMethod::dc:
+        DonorCellX1(member, m, k, j, is-1, ie+1, b0_, bl, br);
+        break;
+      case ReconstructionMethod::plm:
+        PiecewiseLinearX1(member, m, k, j, is-1, ie+1, b0_, bl, br);
+        break;
+      case ReconstructionMethod::ppm4:
+      case ReconstructionMethod::ppmx:
+        PiecewiseParabolicX1(member, eos_, extrema, false, m, k, j, is-1, ie+1, b0_, bl,
+                             br);
+        break;
+      case ReconstructionMethod::wenoz:
+        WENOZX1(member, eos_, false, m, k, j, is-1, ie+1, b0_, bl, br);
+        break;
+      default:
+        break;
+    }
+    member.team_barrier();
+
+    par_for_inner(member, is, ie+1, [&](const int i) {
+      auto &b = (vf1(m,3,k,j,i) > 0.0)? bl : br;
+      e31(m,k,j,i) = -b(IBY,i)*vf1(m,0,k,j,i) + bx(m,k,j,i)*vf1(m,1,k,j,i);
+      e21(m,k,j,i) =  b(IBZ,i)*vf1(m,0,k,j,i) - bx(m,k,j,i)*vf1(m,2,k,j,i);
+    });
+  });
+
+  //--------------------------------------------------------------------------------------
+  // j-direction: E_{x} = -(v2*b3 - v3*b2) and E_{z} = (v2*b1 - v1*b2)
+
+  if (pmy_pack->pmesh->multi_d) {
+    scr_size = ScrArray2D<Real>::shmem_size(3, ncells1) * 3;
+    auto &vf2 = kin_vface.x2f;
+    auto &by = b0.x2f;
+    auto &e12 = e1x2;
+    auto &e32 = e3x2;
+    if (pmy_pack->pmesh->two_d) {
+      kl = ks, ku = ke;
+    } else {
+      kl = ks-1, ku = ke+1;
+    }
+
+    par_for_outer("kin_emf2",DevExeSpace(), scr_size, scr_level, 0, nmb1, kl, ku,
+    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k) {
+      ScrArray2D<Real> scr1(member.team_scratch(scr_level), 3, ncells1);
+      ScrArray2D<Real> scr2(member.team_scratch(scr_level), 3, ncells1);
+      ScrArray2D<Real> br(member.team_scratch(scr_level), 3, ncells1);
+
+      for (int j=js-1; j<=je+1; ++j) {
+        // Permute scratch arrays.
+        auto bl     = ((j%2) == 0)? scr2 : scr1;
+        auto bl_jp1 = ((j%2) == 0)? scr1 : scr2;
+        switch (recon) {
+          case ReconstructionMethod::dc:
+            DonorCellX2(member, m, k, j, is-1, ie+1, b0_, bl_jp1, br);
+            break;
+          case ReconstructionMethod::plm:
+            PiecewiseLinearX2(member, m, k, j, is-1, ie+1, b0_, bl_jp1, br);
+            break;
+          case ReconstructionMethod::ppm4:
+          case ReconstructionMethod::ppmx:
+            PiecewiseParabolicX2(member,eos_,extrema,false,m,k,j,is-1,ie+1,b0_,bl_jp1,br);
+            break;
+          case ReconstructionMethod::wenoz:
+            WENOZX2(member, eos_, false, m, k, j, is-1, ie+1, b0_, bl_jp1, br);
+            break;
+          default:
+            break;
+        }
+        member.team_barrier();
+
+        if (j > js-1) {
+          par_for_inner(member, is-1, ie+1, [&](const int i) {
+            auto &b = (vf2(m,3,k,j,i) > 0.0)? bl : br;
+            e12(m,k,j,i) = -b(IBZ,i)*vf2(m,0,k,j,i) + by(m,k,j,i)*vf2(m,1,k,j,i);
+            e32(m,k,j,i) =  b(IBX,i)*vf2(m,0,k,j,i) - by(m,k,j,i)*vf2(m,2,k,j,i);
+          });
+          member.team_barrier();
+        }
+      }
+    });
+  }
+
+  //--------------------------------------------------------------------------------------
+  // k-direction: E_{y} = -(v3*b1 - v1*b3) and E_{x} = (v3*b2 - v2*b3)
+
+  if (pmy_pack->pmesh->three_d) {
+    scr_size = ScrArray2D<Real>::shmem_size(3, ncells1) * 3;
+    auto &vf3 = kin_vface.x3f;
+    auto &bz = b0.x3f;
+    auto &e23 = e2x3;
+    auto &e13 = e1x3;
+
+    par_for_outer("kin_emf3",DevExeSpace(), scr_size, scr_level, 0, nmb1, js-1, je+1,
+    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int j) {
+      ScrArray2D<Real> scr1(member.team_scratch(scr_level), 3, ncells1);
+      ScrArray2D<Real> scr2(member.team_scratch(scr_level), 3, ncells1);
+      ScrArray2D<Real> br(member.team_scratch(scr_level), 3, ncells1);
+
+      for (int k=ks-1; k<=ke+1; ++k) {
+        // Permute scratch arrays.
+        auto bl     = ((k%2) == 0)? scr2 : scr1;
+        auto bl_kp1 = ((k%2) == 0)? scr1 : scr2;
+        switch (recon) {
+          case ReconstructionMethod::dc:
+            DonorCellX3(member, m, k, j, is-1, ie+1, b0_, bl_kp1, br);
+            break;
+          case ReconstructionMethod::plm:
+            PiecewiseLinearX3(member, m, k, j, is-1, ie+1, b0_, bl_kp1, br);
+            break;
+          case ReconstructionMethod::ppm4:
+          case ReconstructionMethod::ppmx:
+            PiecewiseParabolicX3(member,eos_,extrema,false,m,k,j,is-1,ie+1,b0_,bl_kp1,br);
+            break;
+          case ReconstructionMethod::wenoz:
+            WENOZX3(member, eos_, false, m, k, j, is-1, ie+1, b0_, bl_kp1, br);
+            break;
+          default:
+            break;
+        }
+        member.team_barrier();
+
+        if (k > ks-1) {
+          par_for_inner(member, is-1, ie+1, [&](const int i) {
+            auto &b = (vf3(m,3,k,j,i) > 0.0)? bl : br;
+            e23(m,k,j,i) = -b(IBX,i)*vf3(m,0,k,j,i) + bz(m,k,j,i)*vf3(m,1,k,j,i);
+            e13(m,k,j,i) =  b(IBY,i)*vf3(m,0,k,j,i) - bz(m,k,j,i)*vf3(m,2,k,j,i);
+          });
+          member.team_barrier();
+        }
+      }
+    });
+  }
+
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus MHD::KinematicBcc
+//! \brief Computes cell-centered field from face-centered field over entire mesh
+//! (including gz), the only part of ConToPrim needed with frozen velocities
+
+TaskStatus MHD::KinematicBcc(Driver *pdriver, int stage) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int &ng = indcs.ng;
+  int n1m1 = indcs.nx1 + 2*ng - 1;
+  int n2m1 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng - 1) : 0;
+  int n3m1 = (indcs.nx3 > 1)? (indcs.nx3 + 2*ng - 1) : 0;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  auto &b = b0;
+  auto &bcc = bcc0;
+  par_for("kin_bcc", DevExeSpace(), 0, nmb1, 0, n3m1, 0, n2m1, 0, n1m1,
+  KOKKOS_LAMBDA(int m, int k, int j, int i) {
+    bcc(m,IBX,k,j,i) = 0.5*(b.x1f(m,k,j,i) + b.x1f(m,k,j,i+1));
+    bcc(m,IBY,k,j,i) = 0.5*(b.x2f(m,k,j,i) + b.x2f(m,k,j+1,i));
+    bcc(m,IBZ,k,j,i) = 0.5*(b.x3f(m,k,j,i) + b.x3f(m,k+1,j,i));
+  });
+  return TaskStatus::complete;
+}
+
+} // namespace mhd
@@ -0,0 +1,351 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file mhd_sts.cpp
+//! \brief Operator-split super-time-stepping (RKL1/RKL2) of the MHD diffusion terms
+//! (viscosity, Ohmic resistivity and thermal conduction).  See comments in hydro_sts.cpp.
+//! Face-centered fields, their electric fields, and their boundary communications are
+//! only included in the STS task lists with resistivity.
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "athena.hpp"
+#include "mesh/mesh.hpp"
+#include "driver/driver.hpp"
+#include "tasklist/task_list.hpp"
+#include "eos/eos.hpp"
+#include "diffusion/viscosity.hpp"
+#include "diffusion/resistivity.hpp"
+#include "diffusion/conduction.hpp"
+#include "diffusion/sts.hpp"
+#include "bvals/bvals.hpp"
+#include "mhd.hpp"
+
+namespace mhd {
+//----------------------------------------------------------------------------------------
+//! \fn  void MHD::AssembleSTSTasks
+//! \brief Adds tasks for each stage of super-time-stepping of diffusion terms to the
+//! "before_sts", "sts" and "after_sts" task lists.  Called by AssembleMHDTasks().
+
+void MHD::AssembleSTSTasks(std::map<std::string, std::shared_ptr<TaskList>> tl) {
+  TaskID none(0);
+
+  // assemble "before_sts" task list
+  id.sts_irecv = tl["before_sts"]->AddTask(&MHD::InitRecvSTS, this, none);
+
+  // assemble "sts" task list
+  id.sts_flux  = tl["sts"]->AddTask(&MHD::STSFluxes, this, none);
+  id.sts_sendf = tl["sts"]->AddTask(&MHD::SendFlux, this, id.sts_flux);
+  id.sts_recvf = tl["sts"]->AddTask(&MHD::RecvFlux, this, id.sts_sendf);
+  id.sts_updt  = tl["sts"]->AddTask(&MHD::STSUpdate, this, id.sts_recvf);
+  id.sts_restu = tl["sts"]->AddTask(&MHD::RestrictU, this, id.sts_updt);
+  id.sts_sendu = tl["sts"]->AddTask(&MHD::SendU, this, id.sts_restu);
+  id.sts_recvu = tl["sts"]->AddTask(&MHD::RecvU, this, id.sts_sendu);
+  if (sts_bfield) {
+    id.sts_sende = tl["sts"]->AddTask(&MHD::SendE, this, id.sts_recvu);
+    id.sts_recve = tl["sts"]->AddTask(&MHD::RecvE, this, id.sts_sende);
+    id.sts_ct    = tl["sts"]->AddTask(&MHD::STSCT, this, id.sts_recve);
+    id.sts_restb = tl["sts"]->AddTask(&MHD::RestrictB, this, id.sts_ct);
+    id.sts_sendb = tl["sts"]->AddTask(&MHD::SendB, this, id.sts_restb);
+    id.sts_recvb = tl["sts"]->AddTask(&MHD::RecvB, this, id.sts_sendb);
+    id.sts_bcs   = tl["sts"]->AddTask(&MHD::ApplyPhysicalBCs, this, id.sts_recvb);
+  } else {
+    id.sts_bcs   = tl["sts"]->AddTask(&MHD::ApplyPhysicalBCs, this, id.sts_recvu);
+  }
+  id.sts_prol  = tl["sts"]->AddTask(&MHD::Prolongate, this, id.sts_bcs);
+  id.sts_c2p   = tl["sts"]->AddTask(&MHD::STSConToPrim, this, id.sts_prol);
+
+  // assemble "after_sts" task list
+  id.sts_csend = tl["after_sts"]->AddTask(&MHD::STSClearSend, this, none);
+  id.sts_crecv = tl["after_sts"]->AddTask(&MHD::STSClearRecv, this, id.sts_csend);
+
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus MHD::InitRecvSTS
+//! \brief Wrapper task list function to post non-blocking receives (with MPI) for U (and
+//! with SMR/AMR fluxes of U), and with resistivity for B and E, in each STS stage.
+
+TaskStatus MHD::InitRecvSTS(Driver *pdrive, int stage) {
+  TaskStatus tstat = pbval_u->InitRecv(nmhd+nscalars);
+  if (tstat != TaskStatus::complete) return tstat;
+  if (pmy_pack->pmesh->multilevel) {
+    tstat = pbval_u->InitFluxRecv(nmhd+nscalars);
+    if (tstat != TaskStatus::complete) return tstat;
+  }
+  if (sts_bfield) {
+    tstat = pbval_b->InitRecv(3);
+    if (tstat != TaskStatus::complete) return tstat;
+    tstat = pbval_b->InitFluxRecv(3);
+  }
+  return tstat;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus MHD::STSFluxes
+//! \brief Computes fluxes of conserved variables, and with resistivity electric fields,
+//! from diffusion terms only
+
+TaskStatus MHD::STSFluxes(Driver *pdrive, int stage) {
+  Kokkos::deep_copy(DevExeSpace(), uflx.x1f, 0.0);
+  Kokkos::deep_copy(DevExeSpace(), uflx.x2f, 0.0);
+  Kokkos::deep_copy(DevExeSpace(), uflx.x3f, 0.0);
+  if (pvisc != nullptr) {
+    pvisc->IsotropicViscousFlux(w0, pvisc->nu_iso, peos->eos_data, uflx);
+  }
+  if ((presist != nullptr) && (peos->eos_data.is_ideal)) {
+    presist->OhmicEnergyFlux(b0, uflx);
+  }
+  if (pcond != nullptr) {
+    pcond->AddHeatFlux(w0, peos->eos_data, uflx);
+  }
+  if (sts_bfield) {
+    Kokkos::deep_copy(DevExeSpace(), efld.x1e, 0.0);
+    Kokkos::deep_copy(DevExeSpace(), efld.x2e, 0.0);
+    Kokkos::deep_copy(DevExeSpace(), efld.x3e, 0.0);
+    presist->OhmicEField(b0, efld);
+  }
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void MHD::STSUpdate
+//  \brief Update of conserved variables for one stage of RKL1/RKL2 integrator.  u1 stores
+//  the state at the start of the step, u2_sts the state at stage j-2, and dudt0_sts the
+//  diffusion operator applied to the state at the start of the step.
+
+TaskStatus MHD::STSUpdate(Driver *pdriver, int stage) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, ie = indcs.ie;
+  int js = indcs.js, je = indcs.je;
+  int ks = indcs.ks, ke = indcs.ke;
+  int ncells1 = indcs.nx1 + 2*(indcs.ng);
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+
+  // coefficients of this stage
+  Mesh *pm = pmy_pack->pmesh;
+  Real mu, nu, mut, gam;
+  STSStageCoefficients(pm->sts_integrator, pm->nsts_stages, stage, mu, nu, mut, gam);
+  Real c0 = 1.0 - mu - nu;
+  Real mut_dt = mut*(pm->dt);
+  Real gam_dt = gam*(pm->dt);
+  bool first = (stage == 1);
+
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  auto u0_ = u0;
+  auto u1_ = u1;
+  auto u2_ = u2_sts;
+  auto dudt0_ = dudt0_sts;
+  auto flx1 = uflx.x1f;
+  auto flx2 = uflx.x2f;
+  auto flx3 = uflx.x3f;
+  auto &mbsize = pmy_pack->pmb->mb_size;
+
+  // passive scalars are not diffused, so only MHD variables are updated
+  int scr_level = 0;
+  size_t scr_size = ScrArray1D<Real>::shmem_size(ncells1);
+
+  par_for_outer("mhd_sts",DevExeSpace(),scr_size,scr_level,0,nmb1,0,nmhd-1,ks,ke,js,je,
+  KOKKOS_LAMBDA(TeamMember_t member, const int m, const int n, const int k, const int j) {
+    ScrArray1D<Real> divf(member.team_scratch(scr_level), ncells1);
+
+    // compute dF1/dx1
+    par_for_inner(member, is, ie, [&](const int i) {
+      divf(i) = (flx1(m,n,k,j,i+1) - flx1(m,n,k,j,i))/mbsize.d_view(m).dx1;
+    });
+    member.team_barrier();
+
+    // Add dF2/dx2
+    if (multi_d) {
+      par_for_inner(member, is, ie, [&](const int i) {
+        divf(i) += (flx2(m,n,k,j+1,i) - flx2(m,n,k,j,i))/mbsize.d_view(m).dx2;
+      });
+      member.team_barrier();
+    }
+
+    // Add dF3/dx3
+    if (three_d) {
+      par_for_inner(member, is, ie, [&](const int i) {
+        divf(i) += (flx3(m,n,k+1,j,i) - flx3(m,n,k,j,i))/mbsize.d_view(m).dx3;
+      });
+      member.team_barrier();
+    }
+
+    par_for_inner(member, is, ie, [&](const int i) {
+      // save state and diffusion operator at start of step in first stage
+      if (first) {
+        u1_(m,n,k,j,i) = u0_(m,n,k,j,i);
+        u2_(m,n,k,j,i) = u0_(m,n,k,j,i);
+        dudt0_(m,n,k,j,i) = -divf(i);
+      }
+      Real ujm1 = u0_(m,n,k,j,i);
+      u0_(m,n,k,j,i) = mu*ujm1 + nu*u2_(m,n,k,j,i) + c0*u1_(m,n,k,j,i)
+                     - mut_dt*divf(i) + gam_dt*dudt0_(m,n,k,j,i);
+      u2_(m,n,k,j,i) = ujm1;
+    });
+  });
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void MHD::STSCT
+//  \brief Constrained Transport update of face-centered fields for one stage of RKL1/RKL2
+//  integrator, using resistive electric fields.  b1, b2_sts and dbdt0_sts are used in the
+//  same way as u1, u2_sts and dudt0_sts in STSUpdate().
+
+TaskStatus MHD::STSCT(Driver *pdriver, int stage) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, ie = indcs.ie;
+  int js = indcs.js, je = indcs.je;
+  int ks = indcs.ks, ke = indcs.ke;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+
+  // coefficients of this stage
+  Mesh *pm = pmy_pack->pmesh;
+  Real mu, nu, mut, gam;
+  STSStageCoefficients(pm->sts_integrator, pm->nsts_stages, stage, mu, nu, mut, gam);
+  Real c0 = 1.0 - mu - nu;
+  Real mut_dt = mut*(pm->dt);
+  Real gam_dt = gam*(pm->dt);
+  bool first = (stage == 1);
+
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+  auto e1 = efld.x1e;
+  auto e2 = efld.x2e;
+  auto e3 = efld.x3e;
+  auto &mbsize = pmy_pack->pmb->mb_size;
+
+  //---- update B1 (only for 2D/3D problems)
+  if (multi_d) {
+    auto bx1f = b0.x1f;
+    auto bx1f_0 = b1.x1f;
+    auto bx1f_2 = b2_sts.x1f;
+    auto dbdt0 = dbdt0_sts.x1f;
+    par_for("sts_ct-b1", DevExeSpace(), 0, nmb1, ks, ke, js, je, is, ie+1,
+    KOKKOS_LAMBDA(int m, int k, int j, int i) {
+      Real dbdt = -(e3(m,k,j+1,i) - e3(m,k,j,i))/mbsize.d_view(m).dx2;
+      if (three_d) {
+        dbdt += (e2(m,k+1,j,i) - e2(m,k,j,i))/mbsize.d_view(m).dx3;
+      }
+      if (first) {
+        bx1f_0(m,k,j,i) = bx1f(m,k,j,i);
+        bx1f_2(m,k,j,i) = bx1f(m,k,j,i);
+        dbdt0(m,k,j,i) = dbdt;
+      }
+      Real bjm1 = bx1f(m,k,j,i);
+      bx1f(m,k,j,i) = mu*bjm1 + nu*bx1f_2(m,k,j,i) + c0*bx1f_0(m,k,j,i)
+                    + mut_dt*dbdt + gam_dt*dbdt0(m,k,j,i);
+      bx1f_2(m,k,j,i) = bjm1;
+    });
+  }
+
+  //---- update B2 (curl terms in 1D and 3D problems)
+  auto bx2f = b0.x2f;
+  auto bx2f_0 = b1.x2f;
+  auto bx2f_2 = b2_sts.x2f;
+  auto dbdt0_2 = dbdt0_sts.x2f;
+  par_for("sts_ct-b2", DevExeSpace(), 0, nmb1, ks, ke, js, je+1, is, ie,
+  KOKKOS_LAMBDA(int m, int k, int j, int i) {
+    Real dbdt = (e3(m,k,j,i+1) - e3(m,k,j,i))/mbsize.d_view(m).dx1;
+    if (three_d) {
+      dbdt -= (e1(m,k+1,j,i) - e1(m,k,j,i))/mbsize.d_view(m).dx3;
+    }
+    if (first) {
+      bx2f_0(m,k,j,i) = bx2f(m,k,j,i);
+      bx2f_2(m,k,j,i) = bx2f(m,k,j,i);
+      dbdt0_2(m,k,j,i) = dbdt;
+    }
+    Real bjm1 = bx2f(m,k,j,i);
+    bx2f(m,k,j,i) = mu*bjm1 + nu*bx2f_2(m,k,j,i) + c0*bx2f_0(m,k,j,i)
+                  + mut_dt*dbdt + gam_dt*dbdt0_2(m,k,j,i);
+    bx2f_2(m,k,j,i) = bjm1;
+  });
+
+  //---- update B3 (curl terms in 1D and 2D/3D problems)
+  auto bx3f = b0.x3f;
+  auto bx3f_0 = b1.x3f;
+  auto bx3f_2 = b2_sts.x3f;
+  auto dbdt0_3 = dbdt0_sts.x3f;
+  par_for("sts_ct-b3", DevExeSpace(), 0, nmb1, ks, ke+1, js, je, is, ie,
+  KOKKOS_LAMBDA(int m, int k, int j, int i) {
+    Real dbdt = -(e2(m,k,j,i+1) - e2(m,k,j,i))/mbsize.d_view(m).dx1;
+    if (multi_d) {
+      dbdt += (e1(m,k,j+1,i) - e1(m,k,j,i))/mbsize.d_view(m).dx2;
+    }
+    if (first) {
+      bx3f_0(m,k,j,i) = bx3f(m,k,j,i);
+      bx3f_2(m,k,j,i) = bx3f(m,k,j,i);
+      dbdt0_3(m,k,j,i) = dbdt;
+    }
+    Real bjm1 = bx3f(m,k,j,i);
+    bx3f(m,k,j,i) = mu*bjm1 + nu*bx3f_2(m,k,j,i) + c0*bx3f_0(m,k,j,i)
+                  + mut_dt*dbdt + gam_dt*dbdt0_3(m,k,j,i);
+    bx3f_2(m,k,j,i) = bjm1;
+  });
+
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus MHD::STSConToPrim
+//! \brief Wrapper task list function to call ConsToPrim over entire mesh (including gz)
+//! at the end of each STS stage.  Unlike ConToPrim() never computes new timestep.
+
+TaskStatus MHD::STSConToPrim(Driver *pdrive, int stage) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int &ng = indcs.ng;
+  int n1m1 = indcs.nx1 + 2*ng - 1;
+  int n2m1 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng - 1) : 0;
+  int n3m1 = (indcs.nx3 > 1)? (indcs.nx3 + 2*ng - 1) : 0;
+  peos->ConsToPrim(u0, b0, w0, bcc0, false, 0, n1m1, 0, n2m1, 0, n3m1);
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus MHD::STSClearSend
+//! \brief Wrapper task list function that checks all MPI sends posted in each STS stage
+//! have completed.
+
+TaskStatus MHD::STSClearSend(Driver *pdrive, int stage) {
+  TaskStatus tstat = pbval_u->ClearSend();
+  if (tstat != TaskStatus::complete) return tstat;
+  if (pmy_pack->pmesh->multilevel) {
+    tstat = pbval_u->ClearFluxSend();
+    if (tstat != TaskStatus::complete) return tstat;
+  }
+  if (sts_bfield) {
+    tstat = pbval_b->ClearSend();
+    if (tstat != TaskStatus::complete) return tstat;
+    tstat = pbval_b->ClearFluxSend();
+  }
+  return tstat;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus MHD::STSClearRecv
+//! \brief Wrapper task list function that checks all MPI receives posted in each STS
+//! stage have completed.
+
+TaskStatus MHD::STSClearRecv(Driver *pdrive, int stage) {
+  TaskStatus tstat = pbval_u->ClearRecv();
+  if (tstat != TaskStatus::complete) return tstat;
+  if (pmy_pack->pmesh->multilevel) {
+    tstat = pbval_u->ClearFluxRecv();
+    if (tstat != TaskStatus::complete) return tstat;
+  }
+  if (sts_bfield) {
+    tstat = pbval_b->ClearRecv();
+    if (tstat != TaskStatus::complete) return tstat;
+    tstat = pbval_b->ClearFluxRecv();
+  }
+  return tstat;
+}
+
+} // namespace mhd
@@ -37,6 +37,29 @@ namespace mhd {
 void MHD::AssembleMHDTasks(std::map<std::string, std::shared_ptr<TaskList>> tl) {
   TaskID none(0);
 
+  // with frozen velocities only the induction equation is integrated: EMFs from cached
+  // face velocities, CT, and communication of B.  The timestep is computed only once.
+  if (frozen_velocity) {
+    id.irecv = tl["before_stagen"]->AddTask(&MHD::InitRecv, this, none);
+
+    id.copyu = tl["stagen"]->AddTask(&MHD::CopyCons, this, none);
+    id.flux  = tl["stagen"]->AddTask(&MHD::KinematicEMF, this, id.copyu);
+    id.efld  = tl["stagen"]->AddTask(&MHD::CornerE, this, id.flux);
+    id.sende = tl["stagen"]->AddTask(&MHD::SendE, this, id.efld);
+    id.recve = tl["stagen"]->AddTask(&MHD::RecvE, this, id.sende);
+    id.ct    = tl["stagen"]->AddTask(&MHD::CT, this, id.recve);
+    id.restb = tl["stagen"]->AddTask(&MHD::RestrictB, this, id.ct);
+    id.sendb = tl["stagen"]->AddTask(&MHD::SendB, this, id.restb);
+    id.recvb = tl["stagen"]->AddTask(&MHD::RecvB, this, id.sendb);
+    id.bcs   = tl["stagen"]->AddTask(&MHD::ApplyPhysicalBCs, this, id.recvb);
+    id.prol  = tl["stagen"]->AddTask(&MHD::Prolongate, this, id.bcs);
+    id.c2p   = tl["stagen"]->AddTask(&MHD::KinematicBcc, this, id.prol);
+
+    id.csend = tl["after_stagen"]->AddTask(&MHD::ClearSend, this, none);
+    id.crecv = tl["after_stagen"]->AddTask(&MHD::ClearRecv, this, id.csend);
+    return;
+  }
+
   // assemble "before_timeintegrator" task list
   id.savest = tl["before_timeintegrator"]->AddTask(&MHD::SaveMHDState, this, none);
 
@@ -73,6 +96,11 @@ void MHD::AssembleMHDTasks(std::map<std::string, std::shared_ptr<TaskList>> tl)
   id.prol      = tl["stagen"]->AddTask(&MHD::Prolongate, this, id.bcs);
   id.c2p       = tl["stagen"]->AddTask(&MHD::ConToPrim, this, id.prol);
   id.newdt     = tl["stagen"]->AddTask(&MHD::NewTimeStep, this, id.c2p);
+  // start communications as early as possible with <time>/task_priority
+  tl["stagen"]->SetPriority(id.sendf, 1);
+  tl["stagen"]->SetPriority(id.sendu, 1);
+  tl["stagen"]->SetPriority(id.sende, 1);
+  tl["stagen"]->SetPriority(id.sendb, 1);
 
   // assemble "after_stagen" task list
   id.csend = tl["after_stagen"]->AddTask(&MHD::ClearSend, this, none);
@@ -80,6 +108,9 @@ void MHD::AssembleMHDTasks(std::map<std::string, std::shared_ptr<TaskList>> tl)
   // task list anyways to catch potential bugs in MPI communication logic
   id.crecv = tl["after_stagen"]->AddTask(&MHD::ClearRecv, this, id.csend);
 
+  // tasks for super-time-stepping of diffusion terms
+  if (sts_diffusion) {AssembleSTSTasks(tl);}
+
   return;
 }
 
@@ -104,9 +135,13 @@ TaskStatus MHD::SaveMHDState(Driver *pdrive, int stage) {
 //! face-centered fields AND their fluxes (with SMR/AMR).
 
 TaskStatus MHD::InitRecv(Driver *pdrive, int stage) {
-  // post receives for U
-  TaskStatus tstat = pbval_u->InitRecv(nmhd+nscalars);
-  if (tstat != TaskStatus::complete) return tstat;
+  TaskStatus tstat;
+  // post receives for U (which is not communicated during stages with frozen_velocity)
+  bool comm_u = !(frozen_velocity) || (stage < 0);
+  if (comm_u) {
+    tstat = pbval_u->InitRecv(nmhd+nscalars);
+    if (tstat != TaskStatus::complete) return tstat;
+  }
   // post receives for B
   tstat = pbval_b->InitRecv(3);
   if (tstat != TaskStatus::complete) return tstat;
@@ -115,7 +150,7 @@ TaskStatus MHD::InitRecv(Driver *pdrive, int stage) {
   // do not post receives for fluxes when stage < 0 (i.e. ICs)
   if (stage >= 0) {
     // with SMR/AMR, post receives for fluxes of U
-    if (pmy_pack->pmesh->multilevel) {
+    if (pmy_pack->pmesh->multilevel && comm_u) {
       tstat = pbval_u->InitFluxRecv(nmhd+nscalars);
       if (tstat != TaskStatus::complete) return tstat;
     }
@@ -158,7 +193,7 @@ TaskStatus MHD::InitRecv(Driver *pdrive, int stage) {
 
 TaskStatus MHD::CopyCons(Driver *pdrive, int stage) {
   if (stage == 1) {
-    Kokkos::deep_copy(DevExeSpace(), u1, u0);
+    if (!(frozen_velocity)) {Kokkos::deep_copy(DevExeSpace(), u1, u0);}
     Kokkos::deep_copy(DevExeSpace(), b1.x1f, b0.x1f);
     Kokkos::deep_copy(DevExeSpace(), b1.x2f, b0.x2f);
     Kokkos::deep_copy(DevExeSpace(), b1.x3f, b0.x3f);
@@ -172,33 +207,17 @@ TaskStatus MHD::CopyCons(Driver *pdrive, int stage) {
 //! of conserved variables
 
 TaskStatus MHD::Fluxes(Driver *pdrive, int stage) {
-  // select which calculate_flux function to call based on rsolver_method
-  if (rsolver_method == MHD_RSolver::advect) {
-    CalculateFluxes<MHD_RSolver::advect>(pdrive, stage);
-  } else if (rsolver_method == MHD_RSolver::llf) {
-    CalculateFluxes<MHD_RSolver::llf>(pdrive, stage);
-  } else if (rsolver_method == MHD_RSolver::hlle) {
-    CalculateFluxes<MHD_RSolver::hlle>(pdrive, stage);
-  } else if (rsolver_method == MHD_RSolver::hlld) {
-    CalculateFluxes<MHD_RSolver::hlld>(pdrive, stage);
-  } else if (rsolver_method == MHD_RSolver::llf_sr) {
-    CalculateFluxes<MHD_RSolver::llf_sr>(pdrive, stage);
-  } else if (rsolver_method == MHD_RSolver::hlle_sr) {
-    CalculateFluxes<MHD_RSolver::hlle_sr>(pdrive, stage);
-  } else if (rsolver_method == MHD_RSolver::llf_gr) {
-    CalculateFluxes<MHD_RSolver::llf_gr>(pdrive, stage);
-  } else if (rsolver_method == MHD_RSolver::hlle_gr) {
-    CalculateFluxes<MHD_RSolver::hlle_gr>(pdrive, stage);
-  }
-
-  // Add viscous, resistive, heat-flux, etc fluxes
-  if (pvisc != nullptr) {
+  // call CalculateFluxes function chosen by SelectFluxKernel() at construction
+  (this->*calc_fluxes_)(pdrive, stage);
+
+  // Add viscous, resistive, heat-flux, etc fluxes (unless integrated with STS)
+  if ((pvisc != nullptr) && !(sts_diffusion)) {
     pvisc->IsotropicViscousFlux(w0, pvisc->nu_iso, peos->eos_data, uflx);
   }
-  if ((presist != nullptr) && (peos->eos_data.is_ideal)) {
+  if ((presist != nullptr) && (peos->eos_data.is_ideal) && !(sts_diffusion)) {
     presist->OhmicEnergyFlux(b0, uflx);
   }
-  if (pcond != nullptr) {
+  if ((pcond != nullptr) && !(sts_diffusion)) {
     pcond->AddHeatFlux(w0, peos->eos_data, uflx);
   }
 
@@ -252,10 +271,20 @@ TaskStatus MHD::MHDSrcTerms(Driver *pdrive, int stage) {
   Real beta_dt = (pdrive->beta[stage-1])*(pmy_pack->pmesh->dt);
 
   // Add source terms for various physics
-  if (psrc->const_accel)  psrc->ConstantAccel(w0, peos->eos_data, beta_dt, u0);
-  if (psrc->ism_cooling)  psrc->ISMCooling(w0, peos->eos_data, beta_dt, u0);
-  if (psrc->rel_cooling)  psrc->RelCooling(w0, peos->eos_data, beta_dt, u0);
-  if (psrc->shearing_box) psrc->ShearingBox(w0, bcc0, peos->eos_data, beta_dt, u0);
+  // Terms fused into RKUpdate (<block>/fused_srcterms = true) have already been added.
+  auto &fsrc = psrc->fsrc;
+  if (psrc->const_accel && !(fsrc.const_accel)) {
+    psrc->ConstantAccel(w0, peos->eos_data, beta_dt, u0);
+  }
+  if (psrc->ism_cooling && !(fsrc.ism_cooling)) {
+    psrc->ISMCooling(w0, peos->eos_data, beta_dt, u0);
+  }
+  if (psrc->rel_cooling && !(fsrc.rel_cooling)) {
+    psrc->RelCooling(w0, peos->eos_data, beta_dt, u0);
+  }
+  if (psrc->shearing_box && !(fsrc.sbox)) {
+    psrc->ShearingBox(w0, bcc0, peos->eos_data, beta_dt, u0);
+  }
 
   // Add coordinate source terms in GR.  Again, must be computed with only primitives.
   if (pmy_pack->pcoord->is_general_relativistic &&
@@ -307,8 +336,8 @@ TaskStatus MHD::RecvU_OA(Driver *pdrive, int stage) {
 //! \brief Wrapper task list function to restrict conserved vars
 
 TaskStatus MHD::RestrictU(Driver *pdrive, int stage) {
-  // Only execute Mesh function with SMR/AMR
-  if (pmy_pack->pmesh->multilevel) {
+  // Only execute Mesh function with SMR/AMR, on ranks with coarse arrays
+  if (pmy_pack->pmesh->multilevel && pmy_pack->pmb->need_coarse) {
     pmy_pack->pmesh->pmr->RestrictCC(u0, coarse_u0);
   }
   return TaskStatus::complete;
@@ -495,7 +524,14 @@ TaskStatus MHD::ApplyPhysicalBCs(Driver *pdrive, int stage) {
 //! at fine/coarse bundaries with SMR/AMR
 
 TaskStatus MHD::Prolongate(Driver *pdrive, int stage) {
-  if (pmy_pack->pmesh->multilevel) {  // only prolongate with SMR/AMR
+  // only prolongate with SMR/AMR, on ranks with coarse arrays
+  if (pmy_pack->pmesh->multilevel && pmy_pack->pmb->need_coarse) {
+    // U (and W) are fixed during stages with frozen_velocity
+    if (frozen_velocity && stage > 0) {
+      pbval_b->FillCoarseInBndryFC(b0, coarse_b0);
+      pbval_b->ProlongateFC(b0, coarse_b0);
+      return TaskStatus::complete;
+    }
     pbval_u->FillCoarseInBndryCC(u0, coarse_u0);
     pbval_b->FillCoarseInBndryFC(b0, coarse_b0);
     if (pmy_pack->pmesh->pmr->prolong_prims) {
@@ -521,7 +557,10 @@ TaskStatus MHD::ConToPrim(Driver *pdrive, int stage) {
   int n1m1 = indcs.nx1 + 2*ng - 1;
   int n2m1 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng - 1) : 0;
   int n3m1 = (indcs.nx3 > 1)? (indcs.nx3 + 2*ng - 1) : 0;
+  // new timestep is computed over active cells in C2P kernel of last stage if requested
+  peos->c2p_newdt = (fused_newdt && (stage == pdrive->nexp_stages));
   peos->ConsToPrim(u0, b0, w0, bcc0, false, 0, n1m1, 0, n2m1, 0, n3m1);
+  peos->c2p_newdt = false;
   return TaskStatus::complete;
 }
 
@@ -536,10 +575,13 @@ TaskStatus MHD::ConToPrim(Driver *pdrive, int stage) {
 
 TaskStatus MHD::ClearSend(Driver *pdrive, int stage) {
   TaskStatus tstat;
+  bool comm_u = !(frozen_velocity) || (stage < 0);
   if ((stage >= 0) || (stage == -1)) {
     // check sends of U complete
-    TaskStatus tstat = pbval_u->ClearSend();
-    if (tstat != TaskStatus::complete) return tstat;
+    if (comm_u) {
+      TaskStatus tstat = pbval_u->ClearSend();
+      if (tstat != TaskStatus::complete) return tstat;
+    }
     // check sends of B complete
     tstat = pbval_b->ClearSend();
     if (tstat != TaskStatus::complete) return tstat;
@@ -549,7 +591,7 @@ TaskStatus MHD::ClearSend(Driver *pdrive, int stage) {
   // do not check flux send for ICs (stage < 0)
   if (stage >= 0) {
     // with SMR/AMR check sends of restricted fluxes of U complete
-    if (pmy_pack->pmesh->multilevel) {
+    if (pmy_pack->pmesh->multilevel && comm_u) {
       tstat = pbval_u->ClearFluxSend();
       if (tstat != TaskStatus::complete) return tstat;
     }
@@ -592,10 +634,13 @@ TaskStatus MHD::ClearSend(Driver *pdrive, int stage) {
 
 TaskStatus MHD::ClearRecv(Driver *pdrive, int stage) {
   TaskStatus tstat;
+  bool comm_u = !(frozen_velocity) || (stage < 0);
   if ((stage >= 0) || (stage == -1)) {
     // check receives of U complete
-    tstat = pbval_u->ClearRecv();
-    if (tstat != TaskStatus::complete) return tstat;
+    if (comm_u) {
+      tstat = pbval_u->ClearRecv();
+      if (tstat != TaskStatus::complete) return tstat;
+    }
     // check receives of B complete
     tstat = pbval_b->ClearRecv();
     if (tstat != TaskStatus::complete) return tstat;
@@ -605,7 +650,7 @@ TaskStatus MHD::ClearRecv(Driver *pdrive, int stage) {
   // do not check flux receives when stage < 0 (i.e. ICs)
   if (stage >= 0) {
     // with SMR/AMR check receives of restricted fluxes of U complete
-    if (pmy_pack->pmesh->multilevel) {
+    if (pmy_pack->pmesh->multilevel && comm_u) {
       tstat = pbval_u->ClearFluxRecv();
       if (tstat != TaskStatus::complete) return tstat;
     }
@@ -642,8 +687,8 @@ TaskStatus MHD::ClearRecv(Driver *pdrive, int stage) {
 //! \brief Wrapper function that restricts face-centered variables (magnetic field)
 
 TaskStatus MHD::RestrictB(Driver *pdrive, int stage) {
-  // Only execute Mesh function with SMR/AMR
-  if (pmy_pack->pmesh->multilevel) {
+  // Only execute Mesh function with SMR/AMR, on ranks with coarse arrays
+  if (pmy_pack->pmesh->multilevel && pmy_pack->pmb->need_coarse) {
     pmy_pack->pmesh->pmr->RestrictFC(b0, coarse_b0);
   }
   return TaskStatus::complete;
@@ -7,12 +7,15 @@
 //! \brief Performs explicit update of MHD conserved variables (u0) for each stage of the
 //! SSP RK integrators (e.g. RK1, RK2, RK3) implemented in AthenaK, using weighted average
 //! and partial time update of flux divergence. Source terms are added in the
-//! MHDSrcTerms() function.
+//! MHDSrcTerms() function, except those fused into this kernel when
+//! <mhd>/fused_srcterms = true.
 
 #include "athena.hpp"
 #include "mesh/mesh.hpp"
 #include "driver/driver.hpp"
+#include "driver/profiler.hpp"
 #include "eos/eos.hpp"
+#include "srcterms/srcterms.hpp"
 #include "mhd.hpp"
 #include "dyn_grmhd/dyn_grmhd.hpp"
 
@@ -41,6 +44,11 @@ TaskStatus MHD::RKUpdate(Driver *pdriver, int stage) {
   auto flx2 = uflx.x2f;
   auto flx3 = uflx.x3f;
   auto &mbsize = pmy_pack->pmb->mb_size;
+  // source terms added in this kernel if <block>/fused_srcterms = true
+  auto fsrc = psrc->fsrc;
+  auto eos = peos->eos_data;
+  auto w0_ = w0;
+  auto bcc0_ = bcc0;
 
   // hierarchical parallel loop that updates conserved variables to intermediate step
   // using weights and fractional time step appropriate to stages of time-integrator used
@@ -48,6 +56,11 @@ TaskStatus MHD::RKUpdate(Driver *pdriver, int stage) {
   int scr_level = 0;
   size_t scr_size = ScrArray1D<Real>::shmem_size(ncells1);
 
+  // estimated work for profiler: u0, u1 and fluxes read, and u0 written once
+  int ndim = (three_d)? 3 : ((multi_d)? 2 : 1);
+  double ncell = static_cast<double>(nmb1 + 1)*(nv1 + 1)*indcs.nx1*indcs.nx2*indcs.nx3;
+  AddKernelWork("mhd_update", ncell*(3 + ndim)*sizeof(Real), ncell*(3*ndim + 3));
+
   par_for_outer("mhd_update",DevExeSpace(),scr_size,scr_level,0,nmb1,0,nv1,ks,ke,js,je,
   KOKKOS_LAMBDA(TeamMember_t member, const int m, const int n, const int k, const int j) {
     ScrArray1D<Real> divf(member.team_scratch(scr_level), ncells1);
@@ -77,7 +90,11 @@ TaskStatus MHD::RKUpdate(Driver *pdriver, int stage) {
     }
 
     par_for_inner(member, is, ie, [&](const int i) {
-      u0_(m,n,k,j,i) = gam0*u0_(m,n,k,j,i) + gam1*u1_(m,n,k,j,i) - beta_dt*divf(i);
+      Real src = 0.0;
+      if (fsrc.enabled) {
+        src = fsrc.Increment(w0_, bcc0_, true, eos, beta_dt, m, n, k, j, i);
+      }
+      u0_(m,n,k,j,i) = gam0*u0_(m,n,k,j,i) + gam1*u1_(m,n,k,j,i) - beta_dt*divf(i) + src;
     });
   });
   return TaskStatus::complete;
@@ -0,0 +1,203 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file ascent_output.cpp
+//! \brief in-situ visualization and analysis with Ascent.  Enabled by compiling with
+//! -D Athena_ENABLE_ASCENT=ON, and adding an <output[n]> block with file_type = ascent.
+//!
+//! At each output time, every MeshBlock on this rank is published to Ascent as one
+//! domain of a multi-domain Conduit Blueprint mesh (uniform coordinates, including ghost
+//! zones), and the output variables are passed as element-centered fields pointing
+//! directly into the device arrays (u0, w0, bcc0, derived variables, ...), so no data are
+//! copied to the host.  Ghost zones are flagged by the "ascent_ghosts" field, which
+//! Ascent removes before rendering.  The renders, extracts or queries to be made are
+//! read by Ascent from <output[n]>/actions_file (default "ascent_actions.yaml"), which
+//! can be edited while the calculation runs.
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mesh/mesh.hpp"
+#include "outputs.hpp"
+
+#if ASCENT_OUTPUT_ENABLED
+#include <ascent.hpp>
+#include <conduit.hpp>
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+#endif
+
+//----------------------------------------------------------------------------------------
+//! \struct AscentOutput::AscentState
+//  \brief Ascent instance and ghost zone flags, hidden here so that outputs.hpp does not
+//  depend on Ascent headers
+
+struct AscentOutput::AscentState {
+#if ASCENT_OUTPUT_ENABLED
+  ascent::Ascent ascent;
+#endif
+  DvceArray3D<int> ghosts;   // 1 in ghost zones, 0 in active zones (same on all MBs)
+  AscentState() : ghosts("ascent_ghosts",1,1,1) {}
+};
+
+//----------------------------------------------------------------------------------------
+// Constructor: also calls BaseTypeOutput base class constructor
+
+AscentOutput::AscentOutput(ParameterInput *pin, Mesh *pm, OutputParameters op) :
+  BaseTypeOutput(pin, pm, op),
+  pstate(new AscentState) {
+#if !(ASCENT_OUTPUT_ENABLED)
+  std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+            << "Output block '" << out_params.block_name << "' requests Ascent output, "
+            << "but code was not compiled with -D Athena_ENABLE_ASCENT=ON" << std::endl;
+  std::exit(EXIT_FAILURE);
+#else
+  if (out_params.slice1 || out_params.slice2 || out_params.slice3 ||
+      out_params.gid >= 0) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Ascent output in block '" << out_params.block_name
+              << "' does not support slices or single MeshBlocks (use slice filters "
+              << "in the Ascent actions instead)" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+
+  // flag ghost zones, which are the same for all MeshBlocks
+  auto &indcs = pm->mb_indcs;
+  int n1 = indcs.nx1 + 2*indcs.ng;
+  int n2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*indcs.ng) : 1;
+  int n3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*indcs.ng) : 1;
+  int is = indcs.is, ie = indcs.ie;
+  int js = indcs.js, je = indcs.je;
+  int ks = indcs.ks, ke = indcs.ke;
+  Kokkos::realloc(pstate->ghosts, n3, n2, n1);
+  auto ghosts = pstate->ghosts;
+  par_for("ascent_ghosts", DevExeSpace(), 0, n3-1, 0, n2-1, 0, n1-1,
+  KOKKOS_LAMBDA(const int k, const int j, const int i) {
+    ghosts(k,j,i) = (i < is || i > ie || j < js || j > je || k < ks || k > ke)? 1 : 0;
+  });
+
+  conduit::Node opts;
+#if MPI_PARALLEL_ENABLED
+  opts["mpi_comm"] = MPI_Comm_c2f(global_variable::mpi_comm);
+#endif
+  opts["actions_file"] =
+      pin->GetOrAddString(op.block_name, "actions_file", "ascent_actions.yaml");
+  opts["exceptions"] = "forward";
+  pstate->ascent.open(opts);
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+// Destructor: closes Ascent (defined here, where AscentState is complete)
+
+AscentOutput::~AscentOutput() {
+#if ASCENT_OUTPUT_ENABLED
+  pstate->ascent.close();
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void AscentOutput::LoadOutputData(Mesh *pm)
+//  \brief Only computes derived variables (if any) on the device.  Unlike other outputs,
+//  nothing is copied to the host.
+
+void AscentOutput::LoadOutputData(Mesh *pm) {
+  UpdateZ4cOutputVariables(pm);
+  if (out_params.contains_derived) {
+    ComputeDerivedVariable(out_params.variable, pm);
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void AscentOutput:::WriteOutputFile(Mesh *pm)
+//  \brief Publishes all MeshBlocks on this rank to Ascent, and executes actions
+
+void AscentOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
+#if ASCENT_OUTPUT_ENABLED
+  auto &indcs = pm->mb_indcs;
+  int &ng = indcs.ng;
+  int n1 = indcs.nx1 + 2*ng;
+  int n2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng) : 1;
+  int n3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*ng) : 1;
+  std::size_t ncells = static_cast<std::size_t>(n1)*n2*n3;
+  auto &size = pm->pmb_pack->pmb->mb_size;
+  int nmb = pm->pmb_pack->nmb_thispack;
+
+  // device arrays must be up to date before Ascent reads them
+  Kokkos::fence();
+
+  conduit::Node mesh;
+  for (int m=0; m<nmb; ++m) {
+    int gid = pm->pmb_pack->gids + m;
+    conduit::Node &dom = mesh["domain_" + std::to_string(gid)];
+    dom["state/domain_id"] = gid;
+    dom["state/cycle"] = pm->ncycle;
+    dom["state/time"] = static_cast<double>(pm->time);
+
+    // uniform coordinates of cell corners, including ghost zones
+    auto &mbs = size.h_view(m);
+    dom["coordsets/coords/type"] = "uniform";
+    dom["coordsets/coords/dims/i"] = n1 + 1;
+    dom["coordsets/coords/origin/x"] = static_cast<double>(mbs.x1min - ng*mbs.dx1);
+    dom["coordsets/coords/spacing/dx"] = static_cast<double>(mbs.dx1);
+    if (n2 > 1) {
+      dom["coordsets/coords/dims/j"] = n2 + 1;
+      dom["coordsets/coords/origin/y"] = static_cast<double>(mbs.x2min - ng*mbs.dx2);
+      dom["coordsets/coords/spacing/dy"] = static_cast<double>(mbs.dx2);
+    }
+    if (n3 > 1) {
+      dom["coordsets/coords/dims/k"] = n3 + 1;
+      dom["coordsets/coords/origin/z"] = static_cast<double>(mbs.x3min - ng*mbs.dx3);
+      dom["coordsets/coords/spacing/dz"] = static_cast<double>(mbs.dx3);
+    }
+    dom["topologies/mesh/type"] = "uniform";
+    dom["topologies/mesh/coordset"] = "coords";
+
+    // fields point directly into device arrays with layout (m,n,k,j,i)
+    dom["fields/ascent_ghosts/association"] = "element";
+    dom["fields/ascent_ghosts/topology"] = "mesh";
+    dom["fields/ascent_ghosts/values"].set_external(pstate->ghosts.data(), ncells);
+    for (auto &var : outvars) {
+      DvceArray5D<Real> &arr = *(var.data_ptr);
+      std::size_t nvar = arr.extent(1);
+      Real *ptr = arr.data() + (m*nvar + var.data_index)*ncells;
+      conduit::Node &fld = dom["fields/" + var.label];
+      fld["association"] = "element";
+      fld["topology"] = "mesh";
+      fld["values"].set_external(ptr, ncells);
+    }
+  }
+
+  try {
+    pstate->ascent.publish(mesh);
+    conduit::Node actions;  // actions are read from actions_file
+    pstate->ascent.execute(actions);
+  } catch (conduit::Error &e) {
+    if (global_variable::my_rank == 0) {
+      std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+                << "Ascent failed in output block '" << out_params.block_name << "': "
+                << e.message() << std::endl;
+    }
+  }
+#endif
+
+  // increment counters
+  out_params.file_number++;
+  if (out_params.last_time < 0.0) {
+    out_params.last_time = pm->time;
+  } else {
+    out_params.last_time += out_params.dt;
+  }
+  pin->SetInteger(out_params.block_name, "file_number", out_params.file_number);
+  pin->SetReal(out_params.block_name, "last_time", out_params.last_time);
+  return;
+}
@@ -6,7 +6,10 @@
 //  \brief implements BaseTypeOutput constructor, and LoadOutputData functions
 //
 
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <list>
 #include <sstream>
 #include <string>   // std::string, to_string()
 #include <cstdio> // snprintf
@@ -25,6 +28,7 @@
 #include "coordinates/adm.hpp"
 #include "z4c/tmunu.hpp"
 #include "z4c/z4c.hpp"
+#include "z4c/compact_object_tracker.hpp"
 #include "srcterms/srcterms.hpp"
 #include "srcterms/turb_driver.hpp"
 #include "outputs.hpp"
@@ -159,6 +163,14 @@ BaseTypeOutput::BaseTypeOutput(ParameterInput *pin, Mesh *pm, OutputParameters o
        << std::endl << "Input file is likely missing corresponding block" << std::endl;
     exit(EXIT_FAILURE);
   }
+  if ((ivar==152) &&
+      (pm->pmb_pack->pmhd == nullptr || !(pm->pmb_pack->pmhd->c2p_stats))) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+       << "Output of C2P statistics requested in <output> block '"
+       << out_params.block_name << "' but they are not accumulated."
+       << std::endl << "Input file is likely missing <mhd>/c2p_stats = true" << std::endl;
+    exit(EXIT_FAILURE);
+  }
 
   // Now load STL vector of output variables
   outvars.clear();
@@ -578,6 +590,12 @@ BaseTypeOutput::BaseTypeOutput(ParameterInput *pin, Mesh *pm, OutputParameters o
       out_params.n_derived += 8;
     }
 
+    // C2P iterations and floors/failures in each cell since the last output
+    if (variable.compare("mhd_c2p") == 0) {
+      outvars.emplace_back("c2p_iter",0,&(pm->pmb_pack->pmhd->c2p_count));
+      outvars.emplace_back("c2p_floor",1,&(pm->pmb_pack->pmhd->c2p_count));
+    }
+
     // turbulent forcing
     if (variable.compare("turb_force") == 0) {
       outvars.emplace_back("force1",0,&(pm->pmb_pack->pturb->force));
@@ -683,12 +701,64 @@ BaseTypeOutput::BaseTypeOutput(ParameterInput *pin, Mesh *pm, OutputParameters o
   noutmbs.assign(global_variable::nranks, 0);
 }
 
+//----------------------------------------------------------------------------------------
+// BaseTypeOutput::UpdateZ4cOutputVariables()
+// With Z4c the ADM variables and constraints may only be computed when needed, so make
+// sure those included in this output are up to date
+
+void BaseTypeOutput::UpdateZ4cOutputVariables(Mesh *pm) {
+  z4c::Z4c *pz4c = pm->pmb_pack->pz4c;
+  adm::ADM *padm = pm->pmb_pack->padm;
+  if (pz4c == nullptr) return;
+  for (auto &ov : outvars) {
+    if (ov.data_ptr == &(pz4c->u_con)) {
+      pz4c->UpdateConstraints();
+    } else if (padm != nullptr && ov.data_ptr == &(padm->u_adm)) {
+      pz4c->UpdateADM();
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------
+// BaseTypeOutput::InOutputRegion()
+// returns true if MeshBlock m intersects the box and sphere of the region of interest,
+// and its level is within [min_level,max_level]
+
+bool BaseTypeOutput::InOutputRegion(Mesh *pm, int m) {
+  auto &size = pm->pmb_pack->pmb->mb_size.h_view(m);
+  int lev = pm->pmb_pack->pmb->mb_lev.h_view(m) - pm->root_level;
+  if (out_params.min_level >= 0 && lev < out_params.min_level) {return false;}
+  if (out_params.max_level >= 0 && lev > out_params.max_level) {return false;}
+
+  Real mb_min[3] = {size.x1min, size.x2min, size.x3min};
+  Real mb_max[3] = {size.x1max, size.x2max, size.x3max};
+  if (out_params.region_box) {
+    for (int d=0; d<3; ++d) {
+      if (mb_max[d] <= out_params.region_min[d] ||
+          mb_min[d] >= out_params.region_max[d]) {return false;}
+    }
+  }
+  // distance from center of sphere to nearest point of MB (in physical coordinates)
+  if (out_params.region_radius > 0.0) {
+    Real rsq = 0.0;
+    for (int d=0; d<3; ++d) {
+      Real x = out_params.region_center[d];
+      Real xn = fmin(fmax(x, pm->stretch.X(d, mb_min[d])), pm->stretch.X(d, mb_max[d]));
+      rsq += SQR(x - xn);
+    }
+    if (rsq > SQR(out_params.region_radius)) {return false;}
+  }
+  return true;
+}
+
 //----------------------------------------------------------------------------------------
 // BaseTypeOutput::LoadOutputData()
 // create std::vector of HostArray3Ds containing data specified in <output> block for
 // this output type
 
 void BaseTypeOutput::LoadOutputData(Mesh *pm) {
+  UpdateZ4cOutputVariables(pm);
+
   // out_data_ vector (indexed over # of output MBs) stores 4D array of variables
   // so start iteration over number of MeshBlocks
   // TODO(@user): get this working for multiple physics, which may be either defined/undef
@@ -706,6 +776,10 @@ void BaseTypeOutput::LoadOutputData(Mesh *pm) {
     // skip if MeshBlock ID is specified and not equal to this ID
     if (out_params.gid >= 0 && (m+gids) != out_params.gid) { continue; }
 
+    // skip if MeshBlock is outside region of interest or range of levels.  Whole MBs
+    // are output, since all output MBs must have the same number of cells
+    if (!(InOutputRegion(pm, m))) { continue; }
+
     int ois,oie,ojs,oje,oks,oke;
 
     if (out_params.include_gzs) {
@@ -771,7 +845,7 @@ void BaseTypeOutput::LoadOutputData(Mesh *pm) {
   noutmbs[global_variable::my_rank] = outmbs.size();
 #if MPI_PARALLEL_ENABLED
   MPI_Allreduce(MPI_IN_PLACE, noutmbs.data(), global_variable::nranks,
-                MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+                MPI_INT, MPI_SUM, global_variable::mpi_comm);
 #endif
   noutmbs_min = *std::min_element(noutmbs.begin(), noutmbs.end());
   noutmbs_max = *std::max_element(noutmbs.begin(), noutmbs.end());
@@ -786,39 +860,149 @@ void BaseTypeOutput::LoadOutputData(Mesh *pm) {
     int nout1 = (outmbs[0].oie - outmbs[0].ois + 1);
     int nout2 = (outmbs[0].oje - outmbs[0].ojs + 1);
     int nout3 = (outmbs[0].oke - outmbs[0].oks + 1);
-    // NB: outarray stores all output data on Host
-    Kokkos::realloc(outarray, nout_vars, nout_mbs, nout3, nout2, nout1);
+    // NB: outarray stores all output data on Host, and the device staging buffer and
+    // index map persist between outputs (they are only reallocated if sizes change)
+    if (static_cast<int>(outarray.extent(0)) != nout_vars ||
+        static_cast<int>(outarray.extent(1)) != nout_mbs ||
+        static_cast<int>(outarray.extent(2)) != nout3 ||
+        static_cast<int>(outarray.extent(3)) != nout2 ||
+        static_cast<int>(outarray.extent(4)) != nout1) {
+      Kokkos::realloc(outarray, nout_vars, nout_mbs, nout3, nout2, nout1);
+      Kokkos::realloc(d_outarray, nout_vars, nout_mbs, nout3, nout2, nout1);
+    }
+    if (static_cast<int>(outmb_indcs.extent(0)) != nout_mbs) {
+      Kokkos::realloc(outmb_indcs, nout_mbs, 4);
+    }
+    for (int m=0; m<nout_mbs; ++m) {
+      outmb_indcs.h_view(m,0) = pm->FindMeshBlockIndex(outmbs[m].mb_gid);
+      outmb_indcs.h_view(m,1) = outmbs[m].ois;
+      outmb_indcs.h_view(m,2) = outmbs[m].ojs;
+      outmb_indcs.h_view(m,3) = outmbs[m].oks;
+    }
+    outmb_indcs.template modify<HostMemSpace>();
+    outmb_indcs.template sync<DevExeSpace>();
   }
 
-  // Calculate derived variables, if required
+  // Calculate derived variables, if required.  For slices, single MeshBlocks, and
+  // regions only a fraction of all cells is output, so they are only computed there.
   if (out_params.contains_derived) {
-    ComputeDerivedVariable(out_params.variable, pm);
+    bool region = out_params.region_box || out_params.region_radius > 0.0 ||
+                  out_params.min_level >= 0 || out_params.max_level >= 0;
+    bool output_cells_only = !(out_params.include_gzs) && (out_params.gid >= 0 ||
+        out_params.slice1 || out_params.slice2 || out_params.slice3 || region);
+    ComputeDerivedVariable(out_params.variable, pm, output_cells_only);
   }
-
-  // Now copy data to host (outarray) over all variables and MeshBlocks
+  if (nout_mbs == 0) return;
+
+  // Gather all output variables and MeshBlocks into the device staging buffer, with one
+  // kernel per variable, and then copy the whole buffer to host in a single transfer
+  int nout1 = (outmbs[0].oie - outmbs[0].ois + 1);
+  int nout2 = (outmbs[0].oje - outmbs[0].ojs + 1);
+  int nout3 = (outmbs[0].oke - outmbs[0].oks + 1);
+  auto &d_out = d_outarray;
+  auto &mbi = outmb_indcs;
   for (int n=0; n<nout_vars; ++n) {
-    for (int m=0; m<nout_mbs; ++m) {
-      int mbi = pm->FindMeshBlockIndex(outmbs[m].mb_gid);
-      std::pair<int,int> irange = std::make_pair(outmbs[m].ois, outmbs[m].oie+1);
-      std::pair<int,int> jrange = std::make_pair(outmbs[m].ojs, outmbs[m].oje+1);
-      std::pair<int,int> krange = std::make_pair(outmbs[m].oks, outmbs[m].oke+1);
-      int nout1 = (outmbs[0].oie - outmbs[0].ois + 1);
-      int nout2 = (outmbs[0].oje - outmbs[0].ojs + 1);
-      int nout3 = (outmbs[0].oke - outmbs[0].oks + 1);
-
-      // copy output variable to new device View
-      DvceArray3D<Real> d_output_var("d_out_var",nout3,nout2,nout1);
-      auto d_slice = Kokkos::subview(*(outvars[n].data_ptr), mbi, outvars[n].data_index,
-                                     krange,jrange,irange);
-      Kokkos::deep_copy(d_output_var,d_slice);
-
-      // copy new device View to host mirror View
-      DvceArray3D<Real>::HostMirror h_output_var = Kokkos::create_mirror(d_output_var);
-      Kokkos::deep_copy(h_output_var,d_output_var);
-
-      // copy host mirror to 5D host View containing all output variables
-      auto h_slice = Kokkos::subview(outarray,n,m,Kokkos::ALL,Kokkos::ALL,Kokkos::ALL);
-      Kokkos::deep_copy(h_slice,h_output_var);
+    auto &src = *(outvars[n].data_ptr);
+    int v = outvars[n].data_index;
+    par_for("load_output",DevExeSpace(),0,nout_mbs-1,0,nout3-1,0,nout2-1,0,nout1-1,
+    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+      d_out(n,m,k,j,i) = src(mbi.d_view(m,0),v,k + mbi.d_view(m,3),
+                             j + mbi.d_view(m,2),i + mbi.d_view(m,1));
+    });
+  }
+  Kokkos::deep_copy(outarray, d_outarray);
+}
+
+//----------------------------------------------------------------------------------------
+// Returns maximum density over all active cells of Hydro or MHD (or -1 if neither exist).
+// Must be called by all ranks.
+
+namespace {
+Real MaxDensity(Mesh *pm) {
+  DvceArray5D<Real> u0;
+  if (pm->pmb_pack->pmhd != nullptr) {
+    u0 = pm->pmb_pack->pmhd->u0;
+  } else if (pm->pmb_pack->phydro != nullptr) {
+    u0 = pm->pmb_pack->phydro->u0;
+  } else {
+    return -1.0;
+  }
+  auto &indcs = pm->mb_indcs;
+  int is = indcs.is; int nx1 = indcs.nx1;
+  int js = indcs.js; int nx2 = indcs.nx2;
+  int ks = indcs.ks; int nx3 = indcs.nx3;
+  const int nmkji = (pm->pmb_pack->nmb_thispack)*nx3*nx2*nx1;
+  const int nkji = nx3*nx2*nx1;
+  const int nji = nx2*nx1;
+  Real dmax = -std::numeric_limits<Real>::max();
+  Kokkos::parallel_reduce("TriggerDmax",Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
+  KOKKOS_LAMBDA(const int &idx, Real &mb_max) {
+    int m = (idx)/nkji;
+    int k = (idx - m*nkji)/nji;
+    int j = (idx - m*nkji - k*nji)/nx1;
+    int i = (idx - m*nkji - k*nji - j*nx1) + is;
+    k += ks;
+    j += js;
+    mb_max = fmax(mb_max, u0(m,IDN,k,j,i));
+  }, Kokkos::Max<Real>(dmax));
+#if MPI_PARALLEL_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE, &dmax, 1, MPI_ATHENA_REAL, MPI_MAX,
+                global_variable::mpi_comm);
+#endif
+  return dmax;
+}
+
+// Returns finest level of any MeshBlock in Mesh
+int FinestLevel(Mesh *pm) {
+  int lev = 0;
+  for (int m=0; m<pm->nmb_total; ++m) {lev = std::max(lev, pm->lloc_eachmb[m].level);}
+  return lev;
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn bool BaseTypeOutput::Triggered()
+//! \brief Returns true if any trigger of this output has fired since the last output.
+//! Triggers are only checked every trigger_dcycle cycles.  Must be called by all ranks.
+
+bool BaseTypeOutput::Triggered(Mesh *pm) {
+  auto &op = out_params;
+  if (op.trigger_dmax <= 0.0 && !(op.trigger_new_level) && op.trigger_separation <= 0.0) {
+    return false;
+  }
+  if ((pm->ncycle % op.trigger_dcycle) != 0) return false;
+  // state at time of last output is recorded on first call
+  if (trigger_level_ < 0) {ResetTriggers(pm);}
+
+  bool fire = false;
+  if (op.trigger_dmax > 0.0 && trigger_dens_ > 0.0) {
+    Real dmax = MaxDensity(pm);
+    if (std::abs(dmax - trigger_dens_) > op.trigger_dmax*trigger_dens_) {fire = true;}
+  }
+  if (op.trigger_new_level && FinestLevel(pm) > trigger_level_) {fire = true;}
+  // tracker positions are known on every rank
+  if (op.trigger_separation > 0.0 && !(trigger_merged_) &&
+      pm->pmb_pack->pz4c != nullptr && pm->pmb_pack->pz4c->ptracker.size() > 1) {
+    auto it = pm->pmb_pack->pz4c->ptracker.begin();
+    const CompactObjectTracker &co1 = *it;
+    const CompactObjectTracker &co2 = *(++it);
+    Real sep2 = 0.0;
+    for (int a=0; a<3; ++a) {sep2 += SQR(co1.GetPos(a) - co2.GetPos(a));}
+    if (std::sqrt(sep2) < op.trigger_separation) {
+      trigger_merged_ = true;
+      fire = true;
     }
   }
+  return fire;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BaseTypeOutput::ResetTriggers()
+//! \brief Records maximum density and finest level at time of output, against which
+//! triggers are compared.  Must be called by all ranks.
+
+void BaseTypeOutput::ResetTriggers(Mesh *pm) {
+  auto &op = out_params;
+  if (op.trigger_dmax > 0.0) {trigger_dens_ = MaxDensity(pm);}
+  trigger_level_ = FinestLevel(pm);
 }
@@ -9,8 +9,11 @@
 
 #include <sys/stat.h>  // mkdir
 
+#include <cmath>
+#include <cstdint>
 #include <cstdio>      // fwrite(), fclose(), fopen(), fnprintf(), snprintf()
 #include <cstdlib>
+#include <cstring>     // memcpy()
 #include <iomanip>
 #include <iostream>
 #include <numeric>
@@ -62,6 +65,7 @@ void MeshBinaryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
 
   IOWrapper binfile;
   std::size_t header_offset=0;
+  binfile.SetAggregation(out_params.io_aggregators, out_params.io_stripe_size);
   binfile.Open(fname.c_str(), IOWrapper::FileMode::write);
 
   // Basic parts of the format:
@@ -71,14 +75,19 @@ void MeshBinaryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
   // 4. Header (input file information)
   {
     std::stringstream msg;
-    msg << "Athena binary output version=1.1" << std::endl
+    bool compress = (out_params.compress_error > 0.0);
+    msg << "Athena binary output version=" << ((compress)? "1.2" : "1.1") << std::endl
         // preheader size includes "size of preheader" line up to "number of variables"
-        << "  size of preheader=5" << std::endl
+        << "  size of preheader=" << ((compress)? 6 : 5) << std::endl
         << "  time=" << pm->time << std::endl
         << "  cycle=" << pm->ncycle << std::endl
         << "  size of location=" << sizeof(Real) << std::endl
-        << "  size of variable=" << sizeof(float) << std::endl
-        << "  number of variables=" << outvars.size() << std::endl
+        << "  size of variable=" << sizeof(float) << std::endl;
+    if (compress) {
+      msg << "  compression error=" << std::setprecision(17) << out_params.compress_error
+          << std::endl;
+    }
+    msg << "  number of variables=" << outvars.size() << std::endl
         << "  variables:  ";
     for (int n=0; n<outvars.size(); n++) {
       msg << outvars[n].label.c_str() << "  ";
@@ -215,7 +224,13 @@ void MeshBinaryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
   }
 
   // now write binary data
-  if (bin_slice) {
+  std::vector<char> cdata;
+  if (out_params.compress_error > 0.0) {
+    std::size_t hdr_size = data_size - cells*nout_vars*sizeof(float);
+    CompressBinaryData(data, nout_mbs, data_size, hdr_size, nout_vars, cells,
+                       out_params.compress_error, cdata);
+    WriteCompressedData(binfile, header_offset, cdata);
+  } else if (bin_slice) {
     std::vector<int> rank_offset(global_variable::nranks, 0);
     std::partial_sum(noutmbs.begin(),std::prev(noutmbs.end()),
                      std::next(rank_offset.begin()));
@@ -283,3 +298,86 @@ void MeshBinaryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
 
   return;
 }
+
+//----------------------------------------------------------------------------------------
+//! \fn void CompressBinaryData()
+//  \brief Compresses nmbs MeshBlocks of data of size data_size each, consisting of
+//  hdr_size bytes of indices and locations followed by nvars*cells floats, into cdata.
+//  Each MeshBlock is stored as its hdr_size bytes, the number of compressed bytes that
+//  follow (uint64), and the compressed data.  Each value x is quantized to the integer
+//  s = round(x/(2*abs_err)), so the decoded value s*2*abs_err differs from x by at most
+//  abs_err, and the differences of consecutive s of each variable are stored as zigzag
+//  LEB128 variable-length integers (one byte for differences within [-64,63]).  Values
+//  with |x| > 2^61*abs_err are clipped, and non-finite values are stored as zero.
+
+void CompressBinaryData(const char *data, int nmbs, std::size_t data_size,
+                        std::size_t hdr_size, int nvars, int cells, Real abs_err,
+                        std::vector<char> &cdata) {
+  const double qinv = 0.5/static_cast<double>(abs_err);
+  const double smax = 2305843009213693952.0;  // 2^61
+  cdata.clear();
+  cdata.reserve(nmbs*(hdr_size + sizeof(std::uint64_t) + nvars*cells));
+  for (int m=0; m<nmbs; ++m) {
+    const char *pdata = &(data[m*data_size]);
+    cdata.insert(cdata.end(), pdata, pdata + hdr_size);
+    std::size_t nbytes_pos = cdata.size();
+    cdata.resize(nbytes_pos + sizeof(std::uint64_t));
+    pdata += hdr_size;
+    for (int n=0; n<nvars; ++n) {
+      std::int64_t sprev = 0;
+      for (int c=0; c<cells; ++c) {
+        float x;
+        memcpy(&x, pdata, sizeof(float));
+        pdata += sizeof(float);
+        double s = (std::isfinite(x))? std::nearbyint(x*qinv) : 0.0;
+        s = std::min(std::max(s, -smax), smax);
+        std::int64_t si = static_cast<std::int64_t>(s);
+        std::int64_t d = si - sprev;
+        sprev = si;
+        std::uint64_t z = (static_cast<std::uint64_t>(d) << 1) ^
+                          static_cast<std::uint64_t>(d >> 63);
+        while (z >= 0x80) {
+          cdata.push_back(static_cast<char>((z & 0x7f) | 0x80));
+          z >>= 7;
+        }
+        cdata.push_back(static_cast<char>(z));
+      }
+    }
+    std::uint64_t nbytes = cdata.size() - nbytes_pos - sizeof(std::uint64_t);
+    memcpy(&(cdata[nbytes_pos]), &nbytes, sizeof(nbytes));
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void WriteCompressedData()
+//  \brief Writes compressed data of all ranks contiguously in order of rank (and so of
+//  gid) after header_offset bytes.  Blocks larger than 2^31 bytes are written in chunks
+//  with non-collective writes.
+
+void WriteCompressedData(IOWrapper &file, std::size_t header_offset,
+                         const std::vector<char> &cdata) {
+  std::uint64_t mysize = cdata.size(), myoffset = 0, maxsize = mysize;
+#if MPI_PARALLEL_ENABLED
+  MPI_Exscan(&mysize, &myoffset, 1, MPI_UINT64_T, MPI_SUM, global_variable::mpi_comm);
+  if (global_variable::my_rank == 0) {myoffset = 0;}  // undefined on rank 0
+  MPI_Allreduce(MPI_IN_PLACE, &maxsize, 1, MPI_UINT64_T, MPI_MAX,
+                global_variable::mpi_comm);
+#endif
+  myoffset += header_offset;
+  const std::uint64_t max_chunk = 2147483648;
+  if (maxsize <= max_chunk) {
+    file.Write_any_type_at_all(cdata.data(), mysize, myoffset, "byte");
+  } else {
+    for (std::uint64_t start=0; start<mysize; start+=max_chunk) {
+      std::uint64_t cnt = std::min(max_chunk, mysize - start);
+      if (file.Write_any_type_at(&(cdata[start]), cnt, myoffset+start, "byte") != cnt) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+            << std::endl << "binary data not written correctly to binary file, "
+            << "binary file is broken." << std::endl;
+        exit(EXIT_FAILURE);
+      }
+    }
+  }
+  return;
+}
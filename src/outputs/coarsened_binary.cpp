@@ -24,6 +24,8 @@
 #include "globals.hpp"
 #include "coordinates/cell_locations.hpp"
 #include "mesh/mesh.hpp"
+#include "hydro/hydro.hpp"
+#include "mhd/mhd.hpp"
 #include "outputs.hpp"
 
 //----------------------------------------------------------------------------------------
@@ -50,6 +52,8 @@ CoarsenedBinaryOutput::CoarsenedBinaryOutput(ParameterInput *pin, Mesh *pm,
 // this output type
 
 void CoarsenedBinaryOutput::LoadOutputData(Mesh *pm) {
+  UpdateZ4cOutputVariables(pm);
+
   // out_data_ vector (indexed over # of output MBs) stores 4D array of variables
   // so start iteration over number of MeshBlocks
   // TODO(@user): get this working for multiple physics, which may be either defined/undef
@@ -131,154 +135,125 @@ void CoarsenedBinaryOutput::LoadOutputData(Mesh *pm) {
   noutmbs[global_variable::my_rank] = outmbs.size();
 #if MPI_PARALLEL_ENABLED
   MPI_Allreduce(MPI_IN_PLACE, noutmbs.data(), global_variable::nranks,
-                MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+                MPI_INT, MPI_SUM, global_variable::mpi_comm);
 #endif
   noutmbs_min = *std::min_element(noutmbs.begin(), noutmbs.end());
   noutmbs_max = *std::max_element(noutmbs.begin(), noutmbs.end());
 
-  // get number of output vars and MBs, then realloc outarray (HostArray)
-  int nout_vars_with_moments;
-  if (out_params.compute_moments) {
-    nout_vars_with_moments = outvars.size() * 4;
-  } else {
-    nout_vars_with_moments = outvars.size();
-  }
+  // get number of output vars and MBs, then realloc outarray (HostArray).  For each
+  // variable the 1 (or 4) moments are stored, followed by the minimum and maximum over
+  // each coarse cell if requested.
+  int nmoments = (out_params.compute_moments)? 4 : 1;
+  int nper_var = nmoments + ((out_params.compute_minmax)? 2 : 0);
   int nout_vars = outvars.size();
   int nout_mbs = outmbs.size();
+  int cf = out_params.coarsen_factor;
   // note that while ois,oie,etc. can be different on each MB, the number of cells output
   // on each MeshBlock, i.e. (ois-ois+1), etc. is the same.
   if (nout_mbs > 0) {
-    int nout1 = ((outmbs[0].oie - outmbs[0].ois + 1)/out_params.coarsen_factor);
-    int nout2 = ((outmbs[0].oje - outmbs[0].ojs + 1)/out_params.coarsen_factor);
-    int nout3 = ((outmbs[0].oke - outmbs[0].oks + 1)/out_params.coarsen_factor);
-    // NB: outarray stores all output data on Host
-    // DBF: outarray is smaller by a factor of coarsen_factor in each dimension
-    Kokkos::realloc(outarray, nout_vars_with_moments, nout_mbs, nout3, nout2, nout1);
+    int nout1 = (outmbs[0].oie - outmbs[0].ois + 1);
+    int nout2 = (outmbs[0].oje - outmbs[0].ojs + 1);
+    int nout3 = (outmbs[0].oke - outmbs[0].oks + 1);
+    if (nout1 % cf != 0 || nout2 % cf != 0 || nout3 % cf != 0) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Output data dimensions are not divisible by "
+                << "coarsen_factor=" << cf << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    // NB: outarray and its device staging buffer are smaller by a factor of
+    // coarsen_factor in each dimension, and persist between outputs
+    if (static_cast<int>(outarray.extent(0)) != nper_var*nout_vars ||
+        static_cast<int>(outarray.extent(1)) != nout_mbs ||
+        static_cast<int>(outarray.extent(2)) != nout3/cf ||
+        static_cast<int>(outarray.extent(3)) != nout2/cf ||
+        static_cast<int>(outarray.extent(4)) != nout1/cf) {
+      Kokkos::realloc(outarray, nper_var*nout_vars, nout_mbs, nout3/cf, nout2/cf,
+                      nout1/cf);
+      Kokkos::realloc(d_outarray, nper_var*nout_vars, nout_mbs, nout3/cf, nout2/cf,
+                      nout1/cf);
+    }
+    if (static_cast<int>(outmb_indcs.extent(0)) != nout_mbs) {
+      Kokkos::realloc(outmb_indcs, nout_mbs, 4);
+    }
+    for (int m=0; m<nout_mbs; ++m) {
+      outmb_indcs.h_view(m,0) = pm->FindMeshBlockIndex(outmbs[m].mb_gid);
+      outmb_indcs.h_view(m,1) = outmbs[m].ois;
+      outmb_indcs.h_view(m,2) = outmbs[m].ojs;
+      outmb_indcs.h_view(m,3) = outmbs[m].oks;
+    }
+    outmb_indcs.template modify<HostMemSpace>();
+    outmb_indcs.template sync<DevExeSpace>();
   }
 
   // Calculate derived variables, if required
   if (out_params.contains_derived) {
     ComputeDerivedVariable(out_params.variable, pm);
   }
+  if (nout_mbs == 0) return;
+
+  // density used to weight averages in mass-weighted outputs
+  bool mass_weighted = out_params.mass_weighted;
+  DvceArray5D<Real> dens;
+  if (mass_weighted) {
+    if (pm->pmb_pack->phydro != nullptr) {
+      dens = pm->pmb_pack->phydro->u0;
+    } else if (pm->pmb_pack->pmhd != nullptr) {
+      dens = pm->pmb_pack->pmhd->u0;
+    } else {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Mass-weighted coarsened output requires a <hydro> or "
+                << "<mhd> block" << std::endl;
+      exit(EXIT_FAILURE);
+    }
+  }
 
-  // Now copy data to host (outarray) over all variables and MeshBlocks
+  // Coarsen all output variables and MeshBlocks directly into the device staging buffer,
+  // with one kernel per variable in which each thread reduces the cf^3 fine cells of one
+  // coarse cell, so only the coarsened data are copied to host.
+  int cnout1 = (outmbs[0].oie - outmbs[0].ois + 1)/cf;
+  int cnout2 = (outmbs[0].oje - outmbs[0].ojs + 1)/cf;
+  int cnout3 = (outmbs[0].oke - outmbs[0].oks + 1)/cf;
+  bool compute_minmax = out_params.compute_minmax;
+  auto &d_out = d_outarray;
+  auto &mbi = outmb_indcs;
   for (int n=0; n<nout_vars; ++n) {
-    for (int m=0; m<nout_mbs; ++m) {
-      int mbi = pm->FindMeshBlockIndex(outmbs[m].mb_gid);
-      std::pair<int,int> irange = std::make_pair(outmbs[m].ois, outmbs[m].oie+1);
-      std::pair<int,int> jrange = std::make_pair(outmbs[m].ojs, outmbs[m].oje+1);
-      std::pair<int,int> krange = std::make_pair(outmbs[m].oks, outmbs[m].oke+1);
-      std::pair<int,int> moment_range;
-      if (out_params.compute_moments) {
-        moment_range = std::make_pair(n*4, n*4+4);
-      } else {
-        moment_range = std::make_pair(n, n+1);
+    auto &src = *(outvars[n].data_ptr);
+    int v = outvars[n].data_index;
+    int nout = n*nper_var;
+    par_for("coarsen_output",DevExeSpace(),0,nout_mbs-1,0,cnout3-1,0,cnout2-1,0,cnout1-1,
+    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+      int mb = mbi.d_view(m,0);
+      int ks = mbi.d_view(m,3) + k*cf;
+      int js = mbi.d_view(m,2) + j*cf;
+      int is = mbi.d_view(m,1) + i*cf;
+      Real sum_w = 0.0, sum_q[4] = {0.0, 0.0, 0.0, 0.0};
+      Real qmin = src(mb,v,ks,js,is), qmax = qmin;
+      for (int kk=ks; kk<ks+cf; ++kk) {
+        for (int jj=js; jj<js+cf; ++jj) {
+          for (int ii=is; ii<is+cf; ++ii) {
+            Real q = src(mb,v,kk,jj,ii);
+            Real w = (mass_weighted)? dens(mb,IDN,kk,jj,ii) : 1.0;
+            Real wq = w;
+            sum_w += w;
+            for (int p=0; p<nmoments; ++p) {
+              wq *= q;
+              sum_q[p] += wq;
+            }
+            qmin = fmin(qmin, q);
+            qmax = fmax(qmax, q);
+          }
+        }
       }
-      int nout1 = (outmbs[0].oie - outmbs[0].ois + 1);
-      int nout2 = (outmbs[0].oje - outmbs[0].ojs + 1);
-      int nout3 = (outmbs[0].oke - outmbs[0].oks + 1);
-      int coarsened_nout1 = nout1/out_params.coarsen_factor;
-      int coarsened_nout2 = nout2/out_params.coarsen_factor;
-      int coarsened_nout3 = nout3/out_params.coarsen_factor;
-
-      // copy output variable to new device View
-      DvceArray3D<Real> d_output_var("d_out_var",nout3,nout2,nout1);
-      auto d_slice = Kokkos::subview(*(outvars[n].data_ptr), mbi, outvars[n].data_index,
-                                     krange,jrange,irange);
-      Kokkos::deep_copy(d_output_var,d_slice);
-      Kokkos::fence(); // Ensure complete copy
-
-
-      int number_of_moments = 1;
-      if (out_params.compute_moments) {
-        number_of_moments = 4;
+      for (int p=0; p<nmoments; ++p) {
+        d_out(nout+p,m,k,j,i) = sum_q[p]/sum_w;
       }
-      DvceArray4D<Real> d_output_var_coarsened("d_output_var_coarsened",
-        number_of_moments, coarsened_nout3, coarsened_nout2, coarsened_nout1);
-
-      // Coarsen the d_slice and store the result in d_output_var
-      // CoarsenVariable(d_output_var, d_output_var_coarsened, out_params.coarsen_factor);
-      int coarsen_factor = out_params.coarsen_factor;
-      int coarsen_factor_cubed = coarsen_factor * coarsen_factor * coarsen_factor;
-
-      if (nout1 % coarsen_factor != 0 || nout2 % coarsen_factor != 0
-                                      || nout3 % coarsen_factor != 0) {
-          std::cout << "Error: Full data dimensions are not divisible by coarsen_factor"
-          << std::endl;
-          exit(EXIT_FAILURE);
+      if (compute_minmax) {
+        d_out(nout+nmoments,  m,k,j,i) = qmin;
+        d_out(nout+nmoments+1,m,k,j,i) = qmax;
       }
-
-      int total_iterations = coarsened_nout3
-        * coarsened_nout2 * coarsened_nout1 * coarsen_factor_cubed;
-
-      bool compute_moments = out_params.compute_moments;
-      Kokkos::parallel_for("coarsen_variable",
-       Kokkos::RangePolicy<DevExeSpace>(0, total_iterations),
-      KOKKOS_LAMBDA(const int idx) {
-        // Calculate the 3D indices for the coarsened data
-        int total_coarsened_elements = coarsened_nout1*coarsened_nout2*coarsened_nout3;
-        int k_c = (idx / (coarsened_nout2 * coarsened_nout1)) % coarsened_nout3;
-        int j_c = (idx / coarsened_nout1) % coarsened_nout2;
-        int i_c = idx % coarsened_nout1;
-
-        // Calculate the offset within the coarsen_factor_cubed cube
-        int offset = idx / total_coarsened_elements;
-        int kk = offset / (coarsen_factor * coarsen_factor);
-        int jj = (offset / coarsen_factor) % coarsen_factor;
-        int ii = offset % coarsen_factor;
-
-        // Calculate the corresponding indices in the full data
-        int k = k_c * coarsen_factor + kk;
-        int j = j_c * coarsen_factor + jj;
-        int i = i_c * coarsen_factor + ii;
-
-        // Perform the coarsening operation
-        if(k < nout3 && j < nout2 && i < nout1) {
-          Kokkos::atomic_add(&d_output_var_coarsened(0, k_c, j_c, i_c),
-            d_output_var(k, j, i));
-          if (compute_moments) {
-            Kokkos::atomic_add(&d_output_var_coarsened(1, k_c, j_c, i_c),
-              d_output_var(k, j, i)*d_output_var(k, j, i));
-            Kokkos::atomic_add(&d_output_var_coarsened(2, k_c, j_c, i_c),
-              d_output_var(k, j, i)*d_output_var(k, j, i)*d_output_var(k, j, i));
-            Kokkos::atomic_add(&d_output_var_coarsened(3, k_c, j_c, i_c),
-               d_output_var(k, j, i)*d_output_var(k, j, i)
-              *d_output_var(k, j, i)*d_output_var(k, j, i));
-          }
-        }
-      });
-      // Normalize the coarsened data
-      int normalize_iterations = number_of_moments * coarsened_nout3
-                                * coarsened_nout2 * coarsened_nout1;
-      Kokkos::parallel_for("normalize_coarsened_variable",
-        Kokkos::RangePolicy<DevExeSpace>(0, normalize_iterations),
-      KOKKOS_LAMBDA(const int idx) {
-        int moment_idx = idx / (coarsened_nout3 * coarsened_nout2 * coarsened_nout1);
-        int k = (idx / (coarsened_nout2 * coarsened_nout1)) % coarsened_nout3;
-        int j = (idx / coarsened_nout1) % coarsened_nout2;
-        int i = idx % coarsened_nout1;
-
-        d_output_var_coarsened(moment_idx, k, j, i) /= coarsen_factor_cubed;
-      });
-
-
-      // Now, create a host mirror for the coarsened data.
-      DvceArray4D<Real>::HostMirror h_output_var = Kokkos::create_mirror(
-        d_output_var_coarsened
-      );
-
-      // Copy the coarsened data to the host mirror.
-      Kokkos::deep_copy(h_output_var, d_output_var_coarsened);
-      Kokkos::fence(); // Ensure complete copy before using h_output_var on the host
-
-      // copy host mirror to 5D host View containing all output variables
-      // if (out_params.compute_moments) {
-      auto h_slice = Kokkos::subview(outarray,
-        moment_range,m,Kokkos::ALL,Kokkos::ALL,Kokkos::ALL
-      );
-      Kokkos::deep_copy(h_slice,h_output_var);
-    }
+    });
   }
+  Kokkos::deep_copy(outarray, d_outarray);
 }
 
 //----------------------------------------------------------------------------------------
@@ -310,12 +285,14 @@ void CoarsenedBinaryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
 
   IOWrapper cbinfile;
   std::size_t header_offset=0;
+  cbinfile.SetAggregation(out_params.io_aggregators, out_params.io_stripe_size);
   cbinfile.Open(fname.c_str(), IOWrapper::FileMode::write);
 
   int number_of_moments = 1;
   if (out_params.compute_moments) {
     number_of_moments = 4;
   }
+  int nper_var = number_of_moments + ((out_params.compute_minmax)? 2 : 0);
 
   // Basic parts of the format:
   // 1. Size of the header
@@ -323,29 +300,36 @@ void CoarsenedBinaryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
   // 3. List of variables in the file
   // 4. Header (input file information)
   {std::stringstream msg;
-  msg << "Athena binary output version=1.1" << std::endl
+  bool compress = (out_params.compress_error > 0.0);
+  msg << "Athena binary output version=" << ((compress)? "1.2" : "1.1") << std::endl
       // preheader size includes "size of preheader" line up to "number of variables"
-      << "  size of preheader=7" << std::endl
+      << "  size of preheader=" << ((compress)? 8 : 7) << std::endl
       << "  time=" << pm->time << std::endl
       << "  cycle=" << pm->ncycle << std::endl
       << "  number of moments=" << number_of_moments << std::endl
       << "  coarsening factor=" << out_params.coarsen_factor << std::endl
       << "  size of location=" << sizeof(Real) << std::endl
-      << "  size of variable=" << sizeof(float) << std::endl
-      << "  number of variables=" << outvars.size()*number_of_moments << std::endl
+      << "  size of variable=" << sizeof(float) << std::endl;
+  if (compress) {
+    msg << "  compression error=" << std::setprecision(17) << out_params.compress_error
+        << std::endl;
+  }
+  msg << "  number of variables=" << outvars.size()*nper_var << std::endl
       << "  variables:  ";
-  if (out_params.compute_moments) {
-    // need to write the label for each of the 4 moments
-    for (int n=0; n<outvars.size(); n++) {
+  for (int n=0; n<outvars.size(); n++) {
+    if (out_params.compute_moments) {
+      // need to write the label for each of the 4 moments
       msg << outvars[n].label.c_str() << "_1st  ";
       msg << outvars[n].label.c_str() << "_2nd  ";
       msg << outvars[n].label.c_str() << "_3rd  ";
       msg << outvars[n].label.c_str() << "_4th  ";
-    }
-  } else {
-    for (int n=0; n<outvars.size(); n++) {
+    } else {
       msg << outvars[n].label.c_str() << "  ";
     }
+    if (out_params.compute_minmax) {
+      msg << outvars[n].label.c_str() << "_min  ";
+      msg << outvars[n].label.c_str() << "_max  ";
+    }
   }
   msg << std::endl;
   if (global_variable::my_rank == 0) {
@@ -368,10 +352,7 @@ void CoarsenedBinaryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
   //  5. Data.  An arbitrary number of scalars and vectors can be written (every node
   //  in the OutputData doubly linked lists), all in binary floats format
 
-  int nout_vars = outvars.size();
-  if (out_params.compute_moments) {
-    nout_vars *= 4;
-  }
+  int nout_vars = outvars.size()*nper_var;
   int nout_mbs = outmbs.size();
   int nout1 = ((outmbs[0].oie - outmbs[0].ois + 1)/out_params.coarsen_factor);
   int nout2 = ((outmbs[0].oje - outmbs[0].ojs + 1)/out_params.coarsen_factor);
@@ -482,8 +463,14 @@ void CoarsenedBinaryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
   }
 
   // now write Coarsenedbinary data
+  std::vector<char> cdata;
+  if (out_params.compress_error > 0.0) {
+    std::size_t hdr_size = data_size - cells*nout_vars*sizeof(float);
+    CompressBinaryData(data, nout_mbs, data_size, hdr_size, nout_vars, cells,
+                       out_params.compress_error, cdata);
+    WriteCompressedData(cbinfile, header_offset, cdata);
   // check if elements larger than 2^31
-  if (data_size*nb_mbs<=2147483648) {
+  } else if (data_size*nb_mbs<=2147483648) {
     // now write Coarsenedbinary data in parallel
     std::size_t myoffset=header_offset+data_size*ns_mbs;
     cbinfile.Write_any_type_at_all(data,(data_size*nb_mbs),myoffset,"byte");
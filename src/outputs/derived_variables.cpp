@@ -26,15 +26,50 @@
 #include "hydro/hydro.hpp"
 #include "mhd/mhd.hpp"
 #include "radiation/radiation.hpp"
+#include "radiation/radiation_m1.hpp"
 #include "radiation/radiation_tetrad.hpp"
 #include "particles/particles.hpp"
 #include "outputs.hpp"
 #include "utils/current.hpp"
 
+//----------------------------------------------------------------------------------------
+//! \fn void DerivedVariableLoop()
+//! \brief launches kernel computing a derived variable, either over all active cells of
+//! all MeshBlocks, or (if nout_mbs >= 0) only over the nout3*nout2*nout1 cells that are
+//! actually output on each output MeshBlock, whose index in the MeshBlockPack and
+//! starting (i,j,k) indices are stored in mbi.  The latter saves the cost of computing
+//! e.g. curvature or SGS terms over the whole volume when only a slice is written.
+
+namespace {
+struct DerivedVariableRange {
+  int nmb, is, ie, js, je, ks, ke;           // all active cells
+  int nout_mbs, nout1, nout2, nout3;         // output cells (if nout_mbs >= 0)
+  DualArray2D<int> mbi;
+};
+
+template <typename Function>
+void DerivedVariableLoop(const std::string &name, const DerivedVariableRange &r,
+                         const Function &function) {
+  if (r.nout_mbs < 0) {
+    par_for(name, DevExeSpace(), 0, (r.nmb-1), r.ks, r.ke, r.js, r.je, r.is, r.ie,
+            function);
+  } else if (r.nout_mbs > 0) {
+    auto mbi = r.mbi;
+    par_for(name, DevExeSpace(), 0, (r.nout_mbs-1), 0, (r.nout3-1), 0, (r.nout2-1),
+            0, (r.nout1-1),
+    KOKKOS_LAMBDA(int mo, int ko, int jo, int io) {
+      function(mbi.d_view(mo,0), ko + mbi.d_view(mo,3), jo + mbi.d_view(mo,2),
+               io + mbi.d_view(mo,1));
+    });
+  }
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------
 // BaseTypeOutput::ComputeDerivedVariable()
 
-void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
+void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm,
+                                            bool output_cells_only) {
   int nmb = pm->pmb_pack->nmb_thispack;
   auto &indcs = pm->mb_indcs;
   int &ng = indcs.ng;
@@ -53,6 +88,29 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
   int &i_dv = out_params.i_derived;
   int &n_dv = out_params.n_derived;
 
+  // use the array of this variable shared with other outputs, if it fills all of
+  // derived_var (e.g. not the first variable of a 2D PDF), and return if it already holds
+  // the values in all cells computed in this cycle
+  DerivedVarCacheEntry *pcache = nullptr;
+  if (pdv_cache != nullptr && i_dv == 0) {
+    pcache = &((*pdv_cache)[name + "." + std::to_string(n_dv)]);
+    if (pcache->var.extent_int(0) == nmb && pcache->var.extent_int(1) == n_dv) {
+      derived_var = pcache->var;
+      if (pcache->ncycle == pm->ncycle && pcache->all_cells) {return;}
+    }
+  }
+
+  // cells over which most derived variables are computed
+  DerivedVariableRange rng{nmb, is, ie, js, je, ks, ke, -1, 1, 1, 1, outmb_indcs};
+  if (output_cells_only) {
+    rng.nout_mbs = outmbs.size();
+    if (rng.nout_mbs > 0) {
+      rng.nout1 = outmbs[0].oie - outmbs[0].ois + 1;
+      rng.nout2 = outmbs[0].oje - outmbs[0].ojs + 1;
+      rng.nout3 = outmbs[0].oke - outmbs[0].oks + 1;
+    }
+  }
+
   // temperature = pressure / density
   if (name.compare("temperature") == 0) {
     if (derived_var.extent(4) <= 1)
@@ -60,7 +118,7 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
     auto dv = derived_var;
     auto &w0_ = (name.compare("hydro_wz") == 0)?
       pm->pmb_pack->phydro->w0 : pm->pmb_pack->pmhd->w0;
-    par_for("temperature", DevExeSpace(), 0, (nmb-1), ks, ke, js, je, is, ie,
+    DerivedVariableLoop("temperature", rng,
     KOKKOS_LAMBDA(int m, int k, int j, int i) {
       dv(m,i_dv,k,j,i) = (w0_(m,IEN,k,j,i+1) / w0_(m,IDN,k,j,i-1));
     });
@@ -76,7 +134,7 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
     auto dv = derived_var;
     auto &w0_ = (name.compare("hydro_wz") == 0)?
       pm->pmb_pack->phydro->w0 : pm->pmb_pack->pmhd->w0;
-    par_for("vorz", DevExeSpace(), 0, (nmb-1), ks, ke, js, je, is, ie,
+    DerivedVariableLoop("vorz", rng,
     KOKKOS_LAMBDA(int m, int k, int j, int i) {
       dv(m,i_dv,k,j,i) = (w0_(m,IVY,k,j,i+1) - w0_(m,IVY,k,j,i-1))/size.d_view(m).dx1;
       if (multi_d) {
@@ -95,7 +153,7 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
     auto dv = derived_var;
     auto &w0_ = (name.compare("hydro_w2") == 0)?
       pm->pmb_pack->phydro->w0 : pm->pmb_pack->pmhd->w0;
-    par_for("vor2", DevExeSpace(), 0, (nmb-1), ks, ke, js, je, is, ie,
+    DerivedVariableLoop("vor2", rng,
     KOKKOS_LAMBDA(int m, int k, int j, int i) {
       Real w1 = 0.0;
       Real w2 = -(w0_(m,IVZ,k,j,i+1) - w0_(m,IVZ,k,j,i-1))/size.d_view(m).dx1;
@@ -121,7 +179,7 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
       Kokkos::realloc(derived_var, nmb, n_dv, n3, n2, n1);
     auto dv = derived_var;
     auto &bcc = pm->pmb_pack->pmhd->bcc0;
-    par_for("jz", DevExeSpace(), 0, (nmb-1), ks, ke, js, je, is, ie,
+    DerivedVariableLoop("jz", rng,
     KOKKOS_LAMBDA(int m, int k, int j, int i) {
       dv(m,i_dv,k,j,i) = (bcc(m,IBY,k,j,i+1) - bcc(m,IBY,k,j,i-1))/size.d_view(m).dx1;
       if (multi_d) {
@@ -138,7 +196,7 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
       Kokkos::realloc(derived_var, nmb, n_dv, n3, n2, n1);
     auto dv = derived_var;
     auto &bcc = pm->pmb_pack->pmhd->bcc0;
-    par_for("j2", DevExeSpace(), 0, (nmb-1), ks, ke, js, je, is, ie,
+    DerivedVariableLoop("j2", rng,
     KOKKOS_LAMBDA(int m, int k, int j, int i) {
       Real j1 = 0.0;
       Real j2 = -(bcc(m,IBZ,k,j,i+1) - bcc(m,IBZ,k,j,i-1))/size.d_view(m).dx1;
@@ -165,7 +223,7 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
       Kokkos::realloc(derived_var, nmb, n_dv, n3, n2, n1);
     auto dv = derived_var;
     auto &bcc = pm->pmb_pack->pmhd->bcc0;
-    par_for("curv", DevExeSpace(), 0, (nmb-1), ks, ke, js, je, is, ie,
+    DerivedVariableLoop("curv", rng,
     KOKKOS_LAMBDA(int m, int k, int j, int i) {
       // Calculate |B|
       Real &Bx = bcc(m,IBX,k,j,i);
@@ -233,7 +291,7 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
       Kokkos::realloc(derived_var, nmb, n_dv, n3, n2, n1);
     auto dv = derived_var;
     auto &bcc = pm->pmb_pack->pmhd->bcc0;
-    par_for("curv_alt", DevExeSpace(), 0, (nmb-1), ks, ke, js, je, is, ie,
+    DerivedVariableLoop("curv_alt", rng,
     KOKKOS_LAMBDA(int m, int k, int j, int i) {
       // Calculate |B|
       Real B_mag = sqrt( bcc(m,IBX,k,j,i)*bcc(m,IBX,k,j,i)
@@ -335,7 +393,7 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
       std::exit(EXIT_FAILURE);
     }
 
-    par_for("jcon", DevExeSpace(), 0, (nmb-1), ks, ke, js, je, is, ie,
+    DerivedVariableLoop("jcon", rng,
     KOKKOS_LAMBDA(int m, int k, int j, int i) {
       Real &x1min = size.d_view(m).x1min;
       Real &x1max = size.d_view(m).x1max;
@@ -462,7 +520,7 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
     auto dv = derived_var;
     auto u0_ = pm->pmb_pack->pmhd->u0;
     auto &bcc = pm->pmb_pack->pmhd->bcc0;
-    par_for("mhd_sgs", DevExeSpace(), 0, (nmb-1), ks, ke, js, je, is, ie,
+    DerivedVariableLoop("mhd_sgs", rng,
     KOKKOS_LAMBDA(int m, int k, int j, int i) {
       Real rho = u0_(m,IDN,k,j,i);
       Real mx = u0_(m,IVX,k,j,i);
@@ -548,7 +606,7 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
     Kokkos::realloc(derived_var, nmb, n_sgs, n3, n2, n1);
     auto dv = derived_var;
     auto u0_ = pm->pmb_pack->phydro->u0;
-    par_for("hydro_sgs", DevExeSpace(), 0, (nmb-1), ks, ke, js, je, is, ie,
+    DerivedVariableLoop("hydro_sgs", rng,
     KOKKOS_LAMBDA(int m, int k, int j, int i) {
       Real rho = u0_(m,IDN,k,j,i);
       Real mx = u0_(m,IVX,k,j,i);
@@ -592,7 +650,7 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
     auto dv = derived_var;
     auto &w0_ = pm->pmb_pack->pmhd->w0;
     auto &bcc = pm->pmb_pack->pmhd->bcc0;
-    par_for("mhd_v_B_moments", DevExeSpace(), 0, (nmb-1), ks, ke, js, je, is, ie,
+    DerivedVariableLoop("mhd_v_B_moments", rng,
     KOKKOS_LAMBDA(int m, int k, int j, int i) {
       Real v = sqrt(w0_(m,IVX,k,j,i)*w0_(m,IVX,k,j,i)
                   + w0_(m,IVY,k,j,i)*w0_(m,IVY,k,j,i)
@@ -620,7 +678,7 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
     auto dv = derived_var;
     auto &w0_ = pm->pmb_pack->pmhd->w0;
     auto &bcc = pm->pmb_pack->pmhd->bcc0;
-    par_for("mhd_vi_Bi_moments", DevExeSpace(), 0, (nmb-1), ks, ke, js, je, is, ie,
+    DerivedVariableLoop("mhd_vi_Bi_moments", rng,
     KOKKOS_LAMBDA(int m, int k, int j, int i) {
       Real vx = w0_(m,IVX,k,j,i);
       Real vy = w0_(m,IVY,k,j,i);
@@ -663,7 +721,7 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
     Kokkos::realloc(derived_var, n_moments, 1, n3, n2, n1);
     auto dv = derived_var;
     auto &w0_ = pm->pmb_pack->phydro->w0;
-    par_for("hydro_v_moments", DevExeSpace(), 0, (nmb-1), ks, ke, js, je, is, ie,
+    DerivedVariableLoop("hydro_v_moments", rng,
     KOKKOS_LAMBDA(int m, int k, int j, int i) {
       Real v = sqrt(w0_(m,IVX,k,j,i)*w0_(m,IVX,k,j,i)
                   + w0_(m,IVY,k,j,i)*w0_(m,IVY,k,j,i)
@@ -682,7 +740,7 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
     Kokkos::realloc(derived_var, n_moments, 1, n3, n2, n1);
     auto dv = derived_var;
     auto &w0_ = pm->pmb_pack->phydro->w0;
-    par_for("hydro_moments", DevExeSpace(), 0, (nmb-1), ks, ke, js, je, is, ie,
+    DerivedVariableLoop("hydro_moments", rng,
     KOKKOS_LAMBDA(int m, int k, int j, int i) {
       Real vx = w0_(m,IVX,k,j,i);
       Real vy = w0_(m,IVY,k,j,i);
@@ -713,7 +771,7 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
       Kokkos::realloc(derived_var, nmb, n_dv, n3, n2, n1);
     auto dv = derived_var;
     auto &bcc = pm->pmb_pack->pmhd->bcc0;
-    par_for("mhd_k_jxb", DevExeSpace(), 0, (nmb-1), ks, ke, js, je, is, ie,
+    DerivedVariableLoop("mhd_k_jxb", rng,
     KOKKOS_LAMBDA(int m, int k, int j, int i) {
       // calculate j
       Real j1 = 0.0;
@@ -750,7 +808,7 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
       Kokkos::realloc(derived_var, nmb, n_dv, n3, n2, n1);
     auto dv = derived_var;
     auto &bcc = pm->pmb_pack->pmhd->bcc0;
-    par_for("curv_perp", DevExeSpace(), 0, (nmb-1), ks, ke, js, je, is, ie,
+    DerivedVariableLoop("curv_perp", rng,
     KOKKOS_LAMBDA(int m, int k, int j, int i) {
       // calculate j
       Real j1 = 0.0;
@@ -860,7 +918,7 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
       Kokkos::realloc(derived_var, nmb, n_dv, n3, n2, n1);
     auto dv = derived_var;
     auto &bcc = pm->pmb_pack->pmhd->bcc0;
-    par_for("bmag", DevExeSpace(), 0, (nmb-1), ks, ke, js, je, is, ie,
+    DerivedVariableLoop("bmag", rng,
     KOKKOS_LAMBDA(int m, int k, int j, int i) {
       dv(m,i_dv,k,j,i) = sqrt( bcc(m,IBX,k,j,i)*bcc(m,IBX,k,j,i)
                           + bcc(m,IBY,k,j,i)*bcc(m,IBY,k,j,i)
@@ -885,7 +943,7 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
     auto &bcc = pm->pmb_pack->pmhd->bcc0;
     auto &b = pm->pmb_pack->pmhd->b0;
     auto &w0_ = pm->pmb_pack->pmhd->w0;
-    par_for("bmag", DevExeSpace(), 0, (nmb-1), ks, ke, js, je, is, ie,
+    DerivedVariableLoop("bmag", rng,
     KOKKOS_LAMBDA(int m, int k, int j, int i) {
       Real dx_squared = size.d_view(m).dx1 * size.d_view(m).dx1;
       // 0 = < B^4 >
@@ -1017,11 +1075,13 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
     Real &spin = coord.bh_spin;
 
     // Radiation
-    int nang1 = pm->pmb_pack->prad->prgeo->nangles - 1;
+    bool m1 = pm->pmb_pack->prad->m1_closure;
+    int nang1 = (m1)? -1 : (pm->pmb_pack->prad->prgeo->nangles - 1);
     auto nh_c_ = pm->pmb_pack->prad->nh_c;
     auto tet_c_ = pm->pmb_pack->prad->tet_c;
     auto tetcov_c_ = pm->pmb_pack->prad->tetcov_c;
-    auto solid_angles_ = pm->pmb_pack->prad->prgeo->solid_angles;
+    DualArray1D<Real> solid_angles_;
+    if (!(m1)) {solid_angles_ = pm->pmb_pack->prad->prgeo->solid_angles;}
     auto i0_ = pm->pmb_pack->prad->i0;
     auto norm_to_tet_ = pm->pmb_pack->prad->norm_to_tet;
 
@@ -1054,10 +1114,24 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
       // coordinate component n^0
       Real n0 = tet_c_(m,0,0,k,j,i);
 
-      // set coordinate frame components
+      // set coordinate frame components, with M1 from the tetrad frame moments and
+      // closure as R^{mu nu} = e_(a)^mu e_(b)^nu R^(ab)
+      Real r_tet[4][4];
+      if (m1) {
+        Real f_tet[3] = {i0_(m,IRF1,k,j,i), i0_(m,IRF2,k,j,i), i0_(m,IRF3,k,j,i)};
+        M1Tensor(i0_(m,IRE,k,j,i), f_tet, r_tet);
+      }
       for (int n1=0, n12=0; n1<4; ++n1) {
         for (int n2=n1; n2<4; ++n2, ++n12) {
           dv(m,n12,k,j,i) = 0.0;
+          if (m1) {
+            for (int a=0; a<4; ++a) {
+              for (int b=0; b<4; ++b) {
+                dv(m,n12,k,j,i) += (tet_c_(m,a,n1,k,j,i)*tet_c_(m,b,n2,k,j,i)*
+                                    r_tet[a][b]);
+              }
+            }
+          }
           for (int n=0; n<=nang1; ++n) {
             Real nmun1 = 0.0; Real nmun2 = 0.0; Real n_0 = 0.0;
             for (int d=0; d<4; ++d) {
@@ -1187,7 +1261,7 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
     auto pdens = derived_var;
     auto pr = pm->pmb_pack->ppart->prtcl_rdata;
     auto pi = pm->pmb_pack->ppart->prtcl_idata;
-    int &npart = pm->nprtcl_thisrank;
+    int npart = pm->pmb_pack->ppart->nprtcl_thispack;
     int gids = pm->pmb_pack->gids;
 
     par_for("pdens0", DevExeSpace(), 0, (nmb-1), ks, ke, js, je, is, ie,
@@ -1197,6 +1271,7 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
 
     par_for("pdens", DevExeSpace(), 0, (npart-1),
     KOKKOS_LAMBDA(const int p) {
+      if (pi(PGID,p) < 0) return;  // skip holes
       int m = pi(PGID,p) - gids;
       int ip = (pr(IPX,p) - size.d_view(m).x1min)/size.d_view(m).dx1 + is;
       int jp = (pr(IPY,p) - size.d_view(m).x2min)/size.d_view(m).dx2 + js;
@@ -1207,5 +1282,10 @@ void BaseTypeOutput::ComputeDerivedVariable(std::string name, Mesh *pm) {
       pdens(m,0,kp,jp,ip) += 1.0;
     });
   }
+  if (pcache != nullptr && i_dv == n_dv) {
+    pcache->var = derived_var;
+    pcache->ncycle = pm->ncycle;
+    pcache->all_cells = !(output_cells_only);
+  }
   i_dv = i_dv % n_dv; // reset derived variable index
 }
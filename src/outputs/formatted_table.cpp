@@ -99,7 +99,7 @@ void FormattedTableOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
     std::fclose(pfile);   // don't forget to close the output file
   }
 #if MPI_PARALLEL_ENABLED
-  int ierr = MPI_Barrier(MPI_COMM_WORLD);
+  int ierr = MPI_Barrier(global_variable::mpi_comm);
 #endif
 
   // now all ranks open file and append data
@@ -140,6 +140,7 @@ void FormattedTableOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
         int &nx1 = indcs.nx1;
         int &nx2 = indcs.nx2;
         int &nx3 = indcs.nx3;
+        auto &st = pm->stretch;
         for (int k=oks; k<=oke; ++k) {
           for (int j=ojs; j<=oje; ++j) {
             for (int i=ois; i<=oie; ++i) {
@@ -147,17 +148,17 @@ void FormattedTableOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
               // write x1, x2, x3 indices and coordinates
               if (oie != ois) {
                 std::fprintf(pfile, " %04d", i);  // note extra space for formatting
-                Real x1cc = CellCenterX(i-is,nx1,x1min,x1max);
+                Real x1cc = st.X(0, CellCenterX(i-is,nx1,x1min,x1max));
                 std::fprintf(pfile, out_params.data_format.c_str(), x1cc);
               }
               if (oje != ojs) {
                 std::fprintf(pfile, " %04d", j);  // note extra space for formatting
-                Real x2cc = CellCenterX(j-js,nx2,x2min,x2max);
+                Real x2cc = st.X(1, CellCenterX(j-js,nx2,x2min,x2max));
                 std::fprintf(pfile, out_params.data_format.c_str(), x2cc);
               }
               if (oke != oks) {
                 std::fprintf(pfile, " %04d", k);  // note extra space for formatting
-                Real x3cc = CellCenterX(k-ks,nx3,x3min,x3max);
+                Real x3cc = st.X(2, CellCenterX(k-ks,nx3,x3min,x3max));
                 std::fprintf(pfile, out_params.data_format.c_str(), x3cc);
               }
 
@@ -174,7 +175,7 @@ void FormattedTableOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
     }
     std::fflush(pfile);
 #if MPI_PARALLEL_ENABLED
-    int ierr = MPI_Barrier(MPI_COMM_WORLD);
+    int ierr = MPI_Barrier(global_variable::mpi_comm);
 #endif
   }
 
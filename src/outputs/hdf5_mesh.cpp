@@ -0,0 +1,325 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file hdf5_mesh.cpp
+//! \brief writes mesh output data directly in the Athena++ "athdf" HDF5 format, so files
+//! can be read by athena_read.py/yt without post-processing with make_athdf.py.
+//!
+//! All output variables are stored in a single dataset "data" with dimensions
+//! (nvar, nmb, nx3, nx2, nx1), chunked by MeshBlock and optionally compressed with the
+//! deflate filter (<output>/compression_level = 1-9).  With MPI, parallel HDF5 is used
+//! and all ranks write their own MeshBlocks collectively.
+
+#include <sys/stat.h>  // mkdir
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "coordinates/cell_locations.hpp"
+#include "mesh/mesh.hpp"
+#include "outputs.hpp"
+
+#if HDF5_OUTPUT_ENABLED
+#include <hdf5.h>
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
+namespace {
+//----------------------------------------------------------------------------------------
+//! \fn void WriteAttribute
+//! \brief writes a 1D attribute of given HDF5 type to a file or dataset
+
+void WriteAttribute(hid_t loc, const char *name, hid_t type, hsize_t n,
+                    const void *data) {
+  hid_t space = H5Screate_simple(1, &n, nullptr);
+  hid_t attr = H5Acreate2(loc, name, type, space, H5P_DEFAULT, H5P_DEFAULT);
+  H5Awrite(attr, type, data);
+  H5Aclose(attr);
+  H5Sclose(space);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void WriteStringAttribute
+//! \brief writes a 1D attribute of fixed-length strings
+
+void WriteStringAttribute(hid_t loc, const char *name,
+                          const std::vector<std::string> &strs) {
+  std::size_t len = 1;
+  for (auto &s : strs) {len = std::max(len, s.size());}
+  std::vector<char> buf(strs.size()*len, '\0');
+  for (std::size_t n=0; n<strs.size(); ++n) {
+    std::memcpy(&(buf[n*len]), strs[n].c_str(), strs[n].size());
+  }
+  hid_t type = H5Tcopy(H5T_C_S1);
+  H5Tset_size(type, len);
+  H5Tset_strpad(type, H5T_STR_NULLPAD);
+  WriteAttribute(loc, name, type, strs.size(), buf.data());
+  H5Tclose(type);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void WriteBlockData
+//! \brief writes the (nmb_thisrank x n) slab of a (nmb_total x n) dataset starting at
+//! row "start", collectively with MPI
+
+void WriteBlockData(hid_t file, hid_t dxpl, const char *name, hid_t ftype, hid_t mtype,
+                    int nmb_total, int start, int nmb, int n, const void *data) {
+  hsize_t fdims[2] = {static_cast<hsize_t>(nmb_total), static_cast<hsize_t>(n)};
+  hsize_t mdims[2] = {static_cast<hsize_t>(nmb), static_cast<hsize_t>(n)};
+  int rank = (n > 1)? 2 : 1;
+  hid_t fspace = H5Screate_simple(rank, fdims, nullptr);
+  hid_t dset = H5Dcreate2(file, name, ftype, fspace, H5P_DEFAULT, H5P_DEFAULT,
+                          H5P_DEFAULT);
+  hid_t mspace = H5Screate_simple(rank, mdims, nullptr);
+  if (nmb > 0) {
+    hsize_t offset[2] = {static_cast<hsize_t>(start), 0};
+    H5Sselect_hyperslab(fspace, H5S_SELECT_SET, offset, nullptr, mdims, nullptr);
+  } else {
+    H5Sselect_none(fspace);
+    H5Sselect_none(mspace);
+  }
+  H5Dwrite(dset, mtype, mspace, fspace, dxpl, data);
+  H5Sclose(mspace);
+  H5Dclose(dset);
+  H5Sclose(fspace);
+}
+} // namespace
+#endif // HDF5_OUTPUT_ENABLED
+
+//----------------------------------------------------------------------------------------
+// Constructor: also calls BaseTypeOutput base class constructor
+
+MeshHDF5Output::MeshHDF5Output(ParameterInput *pin, Mesh *pm, OutputParameters op) :
+  BaseTypeOutput(pin, pm, op) {
+#if !(HDF5_OUTPUT_ENABLED)
+  std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+            << "Output block '" << out_params.block_name << "' requests HDF5 output, "
+            << "but code was not compiled with -D Athena_ENABLE_HDF5=ON" << std::endl;
+  std::exit(EXIT_FAILURE);
+#endif
+  if (out_params.slice1 || out_params.slice2 || out_params.slice3 ||
+      out_params.gid >= 0 || out_params.include_gzs) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "HDF5 output in block '" << out_params.block_name
+              << "' does not support slices, single MeshBlocks or ghost zones"
+              << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  compression_level = pin->GetOrAddInteger(op.block_name, "compression_level", 0);
+  if (compression_level < 0 || compression_level > 9) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "compression_level must be between 0 and 9" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  // create directories for outputs. Comments in binary.cpp constructor explain why
+  mkdir("athdf",0775);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void MeshHDF5Output:::WriteOutputFile(Mesh *pm)
+//  \brief Cycles over all MeshBlocks and writes OutputData in athdf format.  All
+//   MeshBlocks are written to the same file, in order of "gid".
+
+void MeshHDF5Output::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
+#if HDF5_OUTPUT_ENABLED
+  // create filename: "athdf/file_basename" + "." + "file_id" + "." + XXXXX + ".athdf"
+  // where XXXXX = 5-digit file_number
+  std::string fname;
+  char number[6];
+  std::snprintf(number, sizeof(number), "%05d", out_params.file_number);
+  fname.assign("athdf/");
+  fname.append(out_params.file_basename);
+  fname.append(".");
+  fname.append(out_params.file_id);
+  fname.append(".");
+  fname.append(number);
+  fname.append(".athdf");
+
+  auto &indcs = pm->mb_indcs;
+  int nout1 = indcs.nx1, nout2 = indcs.nx2, nout3 = indcs.nx3;
+  int nout_vars = outvars.size();
+  int nout_mbs = outmbs.size();
+  int nmb_total = pm->nmb_total;
+  int gids = pm->gids_eachrank[global_variable::my_rank];
+
+  // create file (with MPI-IO driver for parallel HDF5)
+  hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+  hid_t dxpl = H5Pcreate(H5P_DATASET_XFER);
+#if MPI_PARALLEL_ENABLED
+  H5Pset_fapl_mpio(fapl, global_variable::mpi_comm, MPI_INFO_NULL);
+  H5Pset_dxpl_mpio(dxpl, H5FD_MPIO_COLLECTIVE);
+#endif
+  hid_t file = H5Fcreate(fname.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+  H5Pclose(fapl);
+  if (file < 0) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "HDF5 output file '" << fname << "' could not be opened"
+              << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+
+  // file attributes (identical on all ranks)
+  int max_level = 0;
+  for (int m=0; m<nmb_total; ++m) {
+    max_level = std::max(max_level, pm->lloc_eachmb[m].level - pm->root_level);
+  }
+  double time = pm->time;
+  // coordinates are written in physical coordinates (see CoordinateStretch)
+  auto &st = pm->stretch;
+  auto &ms = pm->mesh_size;
+  double rootx1[3] = {st.X(0, ms.x1min), st.X(0, ms.x1max), 1.0};
+  double rootx2[3] = {st.X(1, ms.x2min), st.X(1, ms.x2max), 1.0};
+  double rootx3[3] = {st.X(2, ms.x3min), st.X(2, ms.x3max), 1.0};
+  int rootsize[3] = {pm->mesh_indcs.nx1, pm->mesh_indcs.nx2, pm->mesh_indcs.nx3};
+  int mbsize[3] = {nout1, nout2, nout3};
+  std::vector<std::string> dset_names = {"data"};
+  std::vector<std::string> var_names;
+  for (auto &ov : outvars) {var_names.push_back(ov.label);}
+  WriteAttribute(file, "NumCycles", H5T_NATIVE_INT, 1, &(pm->ncycle));
+  WriteAttribute(file, "Time", H5T_NATIVE_DOUBLE, 1, &time);
+  WriteStringAttribute(file, "Coordinates", {"cartesian"});
+  WriteAttribute(file, "RootGridX1", H5T_NATIVE_DOUBLE, 3, rootx1);
+  WriteAttribute(file, "RootGridX2", H5T_NATIVE_DOUBLE, 3, rootx2);
+  WriteAttribute(file, "RootGridX3", H5T_NATIVE_DOUBLE, 3, rootx3);
+  WriteAttribute(file, "RootGridSize", H5T_NATIVE_INT, 3, rootsize);
+  WriteAttribute(file, "NumMeshBlocks", H5T_NATIVE_INT, 1, &nmb_total);
+  WriteAttribute(file, "MeshBlockSize", H5T_NATIVE_INT, 3, mbsize);
+  WriteAttribute(file, "MaxLevel", H5T_NATIVE_INT, 1, &max_level);
+  WriteAttribute(file, "NumVariables", H5T_NATIVE_INT, 1, &nout_vars);
+  WriteStringAttribute(file, "DatasetNames", dset_names);
+  WriteStringAttribute(file, "VariableNames", var_names);
+
+  // levels, logical locations and cell coordinates of MeshBlocks on this rank
+  std::vector<int> levels(nout_mbs);
+  std::vector<std::int64_t> llocs(3*nout_mbs);
+  std::vector<float> x1f(nout_mbs*(nout1+1)), x1v(nout_mbs*nout1);
+  std::vector<float> x2f(nout_mbs*(nout2+1)), x2v(nout_mbs*nout2);
+  std::vector<float> x3f(nout_mbs*(nout3+1)), x3v(nout_mbs*nout3);
+  for (int m=0; m<nout_mbs; ++m) {
+    LogicalLocation &loc = pm->lloc_eachmb[outmbs[m].mb_gid];
+    levels[m] = loc.level - pm->root_level;
+    llocs[3*m] = loc.lx1;
+    llocs[3*m+1] = loc.lx2;
+    llocs[3*m+2] = loc.lx3;
+    auto &mb = outmbs[m];
+    for (int i=0; i<=nout1; ++i) {
+      x1f[m*(nout1+1)+i] =
+          static_cast<float>(st.X(0, LeftEdgeX(i, nout1, mb.x1min, mb.x1max)));
+    }
+    for (int i=0; i<nout1; ++i) {
+      x1v[m*nout1+i] =
+          static_cast<float>(st.X(0, CellCenterX(i, nout1, mb.x1min, mb.x1max)));
+    }
+    for (int j=0; j<=nout2; ++j) {
+      x2f[m*(nout2+1)+j] =
+          static_cast<float>(st.X(1, LeftEdgeX(j, nout2, mb.x2min, mb.x2max)));
+    }
+    for (int j=0; j<nout2; ++j) {
+      x2v[m*nout2+j] =
+          static_cast<float>(st.X(1, CellCenterX(j, nout2, mb.x2min, mb.x2max)));
+    }
+    for (int k=0; k<=nout3; ++k) {
+      x3f[m*(nout3+1)+k] =
+          static_cast<float>(st.X(2, LeftEdgeX(k, nout3, mb.x3min, mb.x3max)));
+    }
+    for (int k=0; k<nout3; ++k) {
+      x3v[m*nout3+k] =
+          static_cast<float>(st.X(2, CellCenterX(k, nout3, mb.x3min, mb.x3max)));
+    }
+  }
+  WriteBlockData(file, dxpl, "Levels", H5T_STD_I32BE, H5T_NATIVE_INT, nmb_total, gids,
+                 nout_mbs, 1, levels.data());
+  WriteBlockData(file, dxpl, "LogicalLocations", H5T_STD_I64BE, H5T_NATIVE_INT64,
+                 nmb_total, gids, nout_mbs, 3, llocs.data());
+  WriteBlockData(file, dxpl, "x1f", H5T_IEEE_F32BE, H5T_NATIVE_FLOAT, nmb_total, gids,
+                 nout_mbs, nout1+1, x1f.data());
+  WriteBlockData(file, dxpl, "x2f", H5T_IEEE_F32BE, H5T_NATIVE_FLOAT, nmb_total, gids,
+                 nout_mbs, nout2+1, x2f.data());
+  WriteBlockData(file, dxpl, "x3f", H5T_IEEE_F32BE, H5T_NATIVE_FLOAT, nmb_total, gids,
+                 nout_mbs, nout3+1, x3f.data());
+  WriteBlockData(file, dxpl, "x1v", H5T_IEEE_F32BE, H5T_NATIVE_FLOAT, nmb_total, gids,
+                 nout_mbs, nout1, x1v.data());
+  WriteBlockData(file, dxpl, "x2v", H5T_IEEE_F32BE, H5T_NATIVE_FLOAT, nmb_total, gids,
+                 nout_mbs, nout2, x2v.data());
+  WriteBlockData(file, dxpl, "x3v", H5T_IEEE_F32BE, H5T_NATIVE_FLOAT, nmb_total, gids,
+                 nout_mbs, nout3, x3v.data());
+
+  // cell data, chunked by MeshBlock and optionally compressed
+  hsize_t fdims[5] = {static_cast<hsize_t>(nout_vars), static_cast<hsize_t>(nmb_total),
+                      static_cast<hsize_t>(nout3), static_cast<hsize_t>(nout2),
+                      static_cast<hsize_t>(nout1)};
+  hsize_t chunk[5] = {1, 1, fdims[2], fdims[3], fdims[4]};
+  hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+  H5Pset_chunk(dcpl, 5, chunk);
+  if (compression_level > 0) {
+    H5Pset_shuffle(dcpl);
+    H5Pset_deflate(dcpl, compression_level);
+  }
+  hid_t fspace = H5Screate_simple(5, fdims, nullptr);
+  hid_t dset = H5Dcreate2(file, "data", H5T_IEEE_F32BE, fspace, H5P_DEFAULT, dcpl,
+                          H5P_DEFAULT);
+  H5Pclose(dcpl);
+
+  // convert data to single precision, and select this rank's MeshBlocks
+  std::size_t cells = static_cast<std::size_t>(nout1)*nout2*nout3;
+  std::vector<float> single_data(nout_vars*nout_mbs*cells);
+  for (int n=0; n<nout_vars; ++n) {
+    for (int m=0; m<nout_mbs; ++m) {
+      float *pdata = &(single_data[(n*nout_mbs + m)*cells]);
+      for (int k=0; k<nout3; ++k) {
+        for (int j=0; j<nout2; ++j) {
+          for (int i=0; i<nout1; ++i) {
+            *pdata++ = static_cast<float>(outarray(n,m,k,j,i));
+          }
+        }
+      }
+    }
+  }
+  hsize_t mdims[5] = {fdims[0], static_cast<hsize_t>(nout_mbs), fdims[2], fdims[3],
+                      fdims[4]};
+  hid_t mspace = H5Screate_simple(5, mdims, nullptr);
+  if (nout_mbs > 0) {
+    hsize_t offset[5] = {0, static_cast<hsize_t>(gids), 0, 0, 0};
+    H5Sselect_hyperslab(fspace, H5S_SELECT_SET, offset, nullptr, mdims, nullptr);
+  } else {
+    H5Sselect_none(fspace);
+    H5Sselect_none(mspace);
+  }
+  if (H5Dwrite(dset, H5T_NATIVE_FLOAT, mspace, fspace, dxpl, single_data.data()) < 0) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "data not written correctly to HDF5 file, "
+              << "HDF5 file is broken." << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  H5Sclose(mspace);
+  H5Sclose(fspace);
+  H5Dclose(dset);
+  H5Pclose(dxpl);
+  H5Fclose(file);
+#endif // HDF5_OUTPUT_ENABLED
+
+  // increment counters
+  out_params.file_number++;
+  if (out_params.last_time < 0.0) {
+    out_params.last_time = pm->time;
+  } else {
+    out_params.last_time += out_params.dt;
+  }
+  pin->SetInteger(out_params.block_name, "file_number", out_params.file_number);
+  pin->SetReal(out_params.block_name, "last_time", out_params.last_time);
+
+  return;
+}
@@ -23,11 +23,26 @@
 #include "z4c/z4c.hpp"
 #include "outputs.hpp"
 
+namespace array_sum {
+// reduction array large enough for history variables of hydro, mhd, and z4c together
+typedef array_type<Real,(3*NHISTORY_VARIABLES)> HistorySum;
+} // namespace array_sum
+
+namespace Kokkos { //reduction identity must be defined in Kokkos namespace
+template<>
+struct reduction_identity< array_sum::HistorySum > {
+  KOKKOS_FORCEINLINE_FUNCTION static array_sum::HistorySum sum() {
+    return array_sum::HistorySum();
+  }
+};
+} // namespace Kokkos
+
 //----------------------------------------------------------------------------------------
 // Constructor: also calls BaseTypeOutput base class constructor
 
 HistoryOutput::HistoryOutput(ParameterInput *pin, Mesh *pm, OutputParameters op) :
-  BaseTypeOutput(pin, pm, op) {
+  BaseTypeOutput(pin, pm, op),
+  hist_pending(false) {
   // cycle through physics modules and add HistoryData struct for each
   hist_data.clear();
 
@@ -52,217 +67,112 @@ HistoryOutput::HistoryOutput(ParameterInput *pin, Mesh *pm, OutputParameters op)
 
 //----------------------------------------------------------------------------------------
 //! \fn void HistoryOutput::LoadOutputData()
-//  \brief Wrapper function that cycles through hist_data vector and calls
-//  appropriate LoadXXXData() function for that physics
+//  \brief Wrapper function that computes history data of all physics modules in a single
+//  fused reduction, and then calls user history function (if any)
 
 void HistoryOutput::LoadOutputData(Mesh *pm) {
+  LoadPhysicsHistoryData(pm);
   for (auto &data : hist_data) {
-    if (data.physics == PhysicsModule::HydroDynamics) {
-      LoadHydroHistoryData(&data, pm);
-    } else if (data.physics == PhysicsModule::MagnetoHydroDynamics) {
-      LoadMHDHistoryData(&data, pm);
-    } else if (data.physics == PhysicsModule::SpaceTimeDynamics) {
-      LoadZ4cHistoryData(&data, pm);
-    } else if (data.physics == PhysicsModule::UserDefined) {
+    if (data.physics == PhysicsModule::UserDefined) {
       (pm->pgen->user_hist_func)(&data, pm);
     }
   }
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn void HistoryOutput::LoadHydroHistoryData()
-//  \brief Compute and store history data over all MeshBlocks on this rank
-//  Data is stored in a Real array defined in derived class.
-
-void HistoryOutput::LoadHydroHistoryData(HistoryData *pdata, Mesh *pm) {
-  auto &eos_data = pm->pmb_pack->phydro->peos->eos_data;
-  int &nhydro_ = pm->pmb_pack->phydro->nhydro;
-
-  // set number of and names of history variables for hydro
-  if (eos_data.is_ideal) {
-    pdata->nhist = 8;
-  } else {
-    pdata->nhist = 7;
-  }
-  pdata->label[IDN] = "mass";
-  pdata->label[IM1] = "1-mom";
-  pdata->label[IM2] = "2-mom";
-  pdata->label[IM3] = "3-mom";
-  if (eos_data.is_ideal) {
-    pdata->label[IEN] = "tot-E";
-  }
-  pdata->label[nhydro_  ] = "1-KE";
-  pdata->label[nhydro_+1] = "2-KE";
-  pdata->label[nhydro_+2] = "3-KE";
-
-  // capture class variables for kernel
-  auto &u0_ = pm->pmb_pack->phydro->u0;
-  auto &size = pm->pmb_pack->pmb->mb_size;
-  int &nhist_ = pdata->nhist;
-
-  // loop over all MeshBlocks in this pack
-  auto &indcs = pm->pmb_pack->pmesh->mb_indcs;
-  int is = indcs.is; int nx1 = indcs.nx1;
-  int js = indcs.js; int nx2 = indcs.nx2;
-  int ks = indcs.ks; int nx3 = indcs.nx3;
-  const int nmkji = (pm->pmb_pack->nmb_thispack)*nx3*nx2*nx1;
-  const int nkji = nx3*nx2*nx1;
-  const int nji  = nx2*nx1;
-  array_sum::GlobalSum sum_this_mb;
-  Kokkos::parallel_reduce("HistSums",Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
-  KOKKOS_LAMBDA(const int &idx, array_sum::GlobalSum &mb_sum) {
-    // compute n,k,j,i indices of thread
-    int m = (idx)/nkji;
-    int k = (idx - m*nkji)/nji;
-    int j = (idx - m*nkji - k*nji)/nx1;
-    int i = (idx - m*nkji - k*nji - j*nx1) + is;
-    k += ks;
-    j += js;
-
-    Real vol = size.d_view(m).dx1*size.d_view(m).dx2*size.d_view(m).dx3;
-
-    // Hydro conserved variables:
-    array_sum::GlobalSum hvars;
-    hvars.the_array[IDN] = vol*u0_(m,IDN,k,j,i);
-    hvars.the_array[IM1] = vol*u0_(m,IM1,k,j,i);
-    hvars.the_array[IM2] = vol*u0_(m,IM2,k,j,i);
-    hvars.the_array[IM3] = vol*u0_(m,IM3,k,j,i);
+//! \fn void HistoryOutput::SetHistoryLabels()
+//  \brief Sets number of and names of history variables for hydro, mhd, and z4c
+
+void HistoryOutput::SetHistoryLabels(HistoryData *pdata, Mesh *pm) {
+  if (pdata->physics == PhysicsModule::HydroDynamics ||
+      pdata->physics == PhysicsModule::MagnetoHydroDynamics) {
+    bool is_mhd = (pdata->physics == PhysicsModule::MagnetoHydroDynamics);
+    auto &eos_data = (is_mhd)? pm->pmb_pack->pmhd->peos->eos_data :
+                               pm->pmb_pack->phydro->peos->eos_data;
+    int nvar = (is_mhd)? pm->pmb_pack->pmhd->nmhd : pm->pmb_pack->phydro->nhydro;
+    pdata->nhist = (is_mhd)? 10 : 7;
+    if (eos_data.is_ideal) {pdata->nhist++;}
+    pdata->label[IDN] = "mass";
+    pdata->label[IM1] = "1-mom";
+    pdata->label[IM2] = "2-mom";
+    pdata->label[IM3] = "3-mom";
     if (eos_data.is_ideal) {
-      hvars.the_array[IEN] = vol*u0_(m,IEN,k,j,i);
+      pdata->label[IEN] = "tot-E";
     }
-
-    // Hydro KE
-    hvars.the_array[nhydro_  ] = vol*0.5*SQR(u0_(m,IM1,k,j,i))/u0_(m,IDN,k,j,i);
-    hvars.the_array[nhydro_+1] = vol*0.5*SQR(u0_(m,IM2,k,j,i))/u0_(m,IDN,k,j,i);
-    hvars.the_array[nhydro_+2] = vol*0.5*SQR(u0_(m,IM3,k,j,i))/u0_(m,IDN,k,j,i);
-
-    // fill rest of the_array with zeros, if nhist < NHISTORY_VARIABLES
-    for (int n=nhist_; n<NHISTORY_VARIABLES; ++n) {
-      hvars.the_array[n] = 0.0;
+    pdata->label[nvar  ] = "1-KE";
+    pdata->label[nvar+1] = "2-KE";
+    pdata->label[nvar+2] = "3-KE";
+    if (is_mhd) {
+      pdata->label[nvar+3] = "1-ME";
+      pdata->label[nvar+4] = "2-ME";
+      pdata->label[nvar+5] = "3-ME";
     }
-
-    // sum into parallel reduce
-    mb_sum += hvars;
-  }, Kokkos::Sum<array_sum::GlobalSum>(sum_this_mb));
-
-  // store data into hdata array
-  for (int n=0; n<pdata->nhist; ++n) {
-    pdata->hdata[n] = sum_this_mb.the_array[n];
+  } else if (pdata->physics == PhysicsModule::SpaceTimeDynamics) {
+    pdata->nhist = 8;
+    pdata->label[0] = "H-norm2";
+    pdata->label[1] = "M-norm2";
+    pdata->label[2] = "Mx-norm2";
+    pdata->label[3] = "My-norm2";
+    pdata->label[4] = "Mz-norm2";
+    pdata->label[5] = "Z-norm2";
+    pdata->label[6] = "Theta-norm2";
+    pdata->label[7] = "C-norm2";
   }
-
-  return;
 }
 
 //----------------------------------------------------------------------------------------
-//! \fn void HistoryOutput::LoadZ4cHistoryData()
-//  \brief Compute and store history data over all MeshBlocks on this rank
-//  Data is stored in a Real array defined in derived class.
-
-void HistoryOutput::LoadZ4cHistoryData(HistoryData *pdata, Mesh *pm) {
-  // set number of and names of history variables for z4c
-  pdata->nhist = 8;
-  pdata->label[0] = "H-norm2";
-  pdata->label[1] = "M-norm2";
-  pdata->label[2] = "Mx-norm2";
-  pdata->label[3] = "My-norm2";
-  pdata->label[4] = "Mz-norm2";
-  pdata->label[5] = "Z-norm2";
-  pdata->label[6] = "Theta-norm2";
-  pdata->label[7] = "C-norm2";
-
-  // capture class variabels for kernel
-  auto &u0_ = pm->pmb_pack->pz4c->u0;
-  auto &u_con_ = pm->pmb_pack->pz4c->u_con;
-  const int &I_Z4c_Theta_ =  pm->pmb_pack->pz4c->I_Z4C_THETA;
-
-  auto &size = pm->pmb_pack->pmb->mb_size;
-  int &nhist_ = pdata->nhist;
-
-  // loop over all MeshBlocks in this pack
-  auto &indcs = pm->pmb_pack->pmesh->mb_indcs;
-  int is = indcs.is; int nx1 = indcs.nx1;
-  int js = indcs.js; int nx2 = indcs.nx2;
-  int ks = indcs.ks; int nx3 = indcs.nx3;
-  const int nmkji = (pm->pmb_pack->nmb_thispack)*nx3*nx2*nx1;
-  const int nkji = nx3*nx2*nx1;
-  const int nji  = nx2*nx1;
-  array_sum::GlobalSum sum_this_mb;
-  Kokkos::parallel_reduce("HistSums",Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
-  KOKKOS_LAMBDA(const int &idx, array_sum::GlobalSum &mb_sum) {
-    // compute n,k,j,i indices of thread
-    int m = (idx)/nkji;
-    int k = (idx - m*nkji)/nji;
-    int j = (idx - m*nkji - k*nji)/nx1;
-    int i = (idx - m*nkji - k*nji - j*nx1) + is;
-    k += ks;
-    j += js;
-
-    Real vol = size.d_view(m).dx1*size.d_view(m).dx2*size.d_view(m).dx3;
-
-    // Hydro conserved variables:
-    array_sum::GlobalSum hvars;
-    hvars.the_array[0] = vol*SQR(u_con_(m,0,k,j,i)); // ||H||^2
-    hvars.the_array[1] = vol*u_con_(m,1,k,j,i);      // ||M||^2 (comes already squared)
-    hvars.the_array[2] = vol*SQR(u_con_(m,2,k,j,i)); // ||Mx||^2
-    hvars.the_array[3] = vol*SQR(u_con_(m,3,k,j,i)); // ||My||^2
-    hvars.the_array[4] = vol*u_con_(m,4,k,j,i);      // ||Mz||^2
-    hvars.the_array[5] = vol*u_con_(m,5,k,j,i);      // ||Z||^2 (comes already squared)
-    hvars.the_array[6] = vol*SQR(u0_(m,I_Z4c_Theta_,k,j,i)); // ||Theta||^2
-    hvars.the_array[7] = vol*u_con_(m,6,k,j,i);      // ||C||^2 (comes already squared)
-
-    // fill rest of the_array with zeros, if nhist < NHISTORY_VARIABLES
-    for (int n=nhist_; n<NHISTORY_VARIABLES; ++n) {
-      hvars.the_array[n] = 0.0;
-    }
-
-    // sum into parallel reduce
-    mb_sum += hvars;
-  }, Kokkos::Sum<array_sum::GlobalSum>(sum_this_mb));
-
-  // store data into hdata array
-  for (int n=0; n<pdata->nhist; ++n) {
-    pdata->hdata[n] = sum_this_mb.the_array[n];
+//! \fn void HistoryOutput::LoadPhysicsHistoryData()
+//  \brief Compute and store history data of hydro, mhd, and z4c over all MeshBlocks on
+//  this rank with one parallel_reduce over an array large enough for all of them, so
+//  that the cells are only traversed once.  Data is stored in hdata arrays of hist_data.
+
+void HistoryOutput::LoadPhysicsHistoryData(Mesh *pm) {
+  // offset of variables of each physics in reduction array (or -1 if not output)
+  int oh = -1, om = -1, oz = -1, ntot = 0;
+  for (auto &data : hist_data) {
+    if (data.physics == PhysicsModule::UserDefined) continue;
+    SetHistoryLabels(&data, pm);
+    if (data.physics == PhysicsModule::HydroDynamics) {oh = ntot;}
+    if (data.physics == PhysicsModule::MagnetoHydroDynamics) {om = ntot;}
+    if (data.physics == PhysicsModule::SpaceTimeDynamics) {oz = ntot;}
+    ntot += data.nhist;
   }
+  if (ntot == 0) return;
 
-  return;
-}
-
-//----------------------------------------------------------------------------------------
-//! \fn void HistoryOutput::LoadMHDHistoryData()
-//  \brief Compute and store history data over all MeshBlocks on this rank
-//  Data is stored in a Real array defined in derived class.
-
-void HistoryOutput::LoadMHDHistoryData(HistoryData *pdata, Mesh *pm) {
-  auto &eos_data = pm->pmb_pack->pmhd->peos->eos_data;
-  int &nmhd_ = pm->pmb_pack->pmhd->nmhd;
-
-  // set number of and names of history variables for mhd
-  if (eos_data.is_ideal) {
-    pdata->nhist = 11;
-  } else {
-    pdata->nhist = 10;
+  // capture class variables for kernel
+  DvceArray5D<Real> u0h, u0m, u0z, ucon;
+  DvceArray4D<Real> bx1f, bx2f, bx3f;
+  bool hydro_ideal = false, mhd_ideal = false;
+  int nhydro_ = 0, nmhd_ = 0, I_Z4c_Theta_ = 0;
+  if (oh >= 0) {
+    u0h = pm->pmb_pack->phydro->u0;
+    hydro_ideal = pm->pmb_pack->phydro->peos->eos_data.is_ideal;
+    nhydro_ = pm->pmb_pack->phydro->nhydro;
   }
-  pdata->label[IDN] = "mass";
-  pdata->label[IM1] = "1-mom";
-  pdata->label[IM2] = "2-mom";
-  pdata->label[IM3] = "3-mom";
-  if (eos_data.is_ideal) {
-    pdata->label[IEN] = "tot-E";
+  if (om >= 0) {
+    u0m = pm->pmb_pack->pmhd->u0;
+    bx1f = pm->pmb_pack->pmhd->b0.x1f;
+    bx2f = pm->pmb_pack->pmhd->b0.x2f;
+    bx3f = pm->pmb_pack->pmhd->b0.x3f;
+    mhd_ideal = pm->pmb_pack->pmhd->peos->eos_data.is_ideal;
+    nmhd_ = pm->pmb_pack->pmhd->nmhd;
+  }
+  // with <z4c>/con_norms_only the constraint norms are reduced without storing u_con
+  bool con_norms = false;
+  Real znorms[8];
+  if (oz >= 0) {
+    if (pm->pmb_pack->pz4c->con_norms_only) {
+      con_norms = true;
+      pm->pmb_pack->pz4c->ConstraintNorms(znorms);
+    } else {
+      // constraints may only be computed when needed
+      pm->pmb_pack->pz4c->UpdateConstraints();
+    }
+    u0z = pm->pmb_pack->pz4c->u0;
+    ucon = pm->pmb_pack->pz4c->u_con;
+    I_Z4c_Theta_ = pm->pmb_pack->pz4c->I_Z4C_THETA;
   }
-  pdata->label[nmhd_  ] = "1-KE";
-  pdata->label[nmhd_+1] = "2-KE";
-  pdata->label[nmhd_+2] = "3-KE";
-  pdata->label[nmhd_+3] = "1-ME";
-  pdata->label[nmhd_+4] = "2-ME";
-  pdata->label[nmhd_+5] = "3-ME";
-
-  // capture class variabels for kernel
-  auto &u0_ = pm->pmb_pack->pmhd->u0;
-  auto &bx1f = pm->pmb_pack->pmhd->b0.x1f;
-  auto &bx2f = pm->pmb_pack->pmhd->b0.x2f;
-  auto &bx3f = pm->pmb_pack->pmhd->b0.x3f;
   auto &size = pm->pmb_pack->pmb->mb_size;
-  int &nhist_ = pdata->nhist;
 
   // loop over all MeshBlocks in this pack
   auto &indcs = pm->pmb_pack->pmesh->mb_indcs;
@@ -272,9 +182,9 @@ void HistoryOutput::LoadMHDHistoryData(HistoryData *pdata, Mesh *pm) {
   const int nmkji = (pm->pmb_pack->nmb_thispack)*nx3*nx2*nx1;
   const int nkji = nx3*nx2*nx1;
   const int nji  = nx2*nx1;
-  array_sum::GlobalSum sum_this_mb;
+  array_sum::HistorySum sum_this_mb;
   Kokkos::parallel_reduce("HistSums",Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
-  KOKKOS_LAMBDA(const int &idx, array_sum::GlobalSum &mb_sum) {
+  KOKKOS_LAMBDA(const int &idx, array_sum::HistorySum &mb_sum) {
     // compute n,k,j,i indices of thread
     int m = (idx)/nkji;
     int k = (idx - m*nkji)/nji;
@@ -285,41 +195,70 @@ void HistoryOutput::LoadMHDHistoryData(HistoryData *pdata, Mesh *pm) {
 
     Real vol = size.d_view(m).dx1*size.d_view(m).dx2*size.d_view(m).dx3;
 
-    // MHD conserved variables:
-    array_sum::GlobalSum hvars;
-    hvars.the_array[IDN] = vol*u0_(m,IDN,k,j,i);
-    hvars.the_array[IM1] = vol*u0_(m,IM1,k,j,i);
-    hvars.the_array[IM2] = vol*u0_(m,IM2,k,j,i);
-    hvars.the_array[IM3] = vol*u0_(m,IM3,k,j,i);
-    if (eos_data.is_ideal) {
-      hvars.the_array[IEN] = vol*u0_(m,IEN,k,j,i);
+    // rest of the_array is initialized to zero by constructor
+    array_sum::HistorySum hvars;
+    if (oh >= 0) {
+      // Hydro conserved variables:
+      hvars.the_array[oh+IDN] = vol*u0h(m,IDN,k,j,i);
+      hvars.the_array[oh+IM1] = vol*u0h(m,IM1,k,j,i);
+      hvars.the_array[oh+IM2] = vol*u0h(m,IM2,k,j,i);
+      hvars.the_array[oh+IM3] = vol*u0h(m,IM3,k,j,i);
+      if (hydro_ideal) {
+        hvars.the_array[oh+IEN] = vol*u0h(m,IEN,k,j,i);
+      }
+      // Hydro KE
+      hvars.the_array[oh+nhydro_  ] = vol*0.5*SQR(u0h(m,IM1,k,j,i))/u0h(m,IDN,k,j,i);
+      hvars.the_array[oh+nhydro_+1] = vol*0.5*SQR(u0h(m,IM2,k,j,i))/u0h(m,IDN,k,j,i);
+      hvars.the_array[oh+nhydro_+2] = vol*0.5*SQR(u0h(m,IM3,k,j,i))/u0h(m,IDN,k,j,i);
     }
 
-    // MHD KE
-    hvars.the_array[nmhd_  ] = vol*0.5*SQR(u0_(m,IM1,k,j,i))/u0_(m,IDN,k,j,i);
-    hvars.the_array[nmhd_+1] = vol*0.5*SQR(u0_(m,IM2,k,j,i))/u0_(m,IDN,k,j,i);
-    hvars.the_array[nmhd_+2] = vol*0.5*SQR(u0_(m,IM3,k,j,i))/u0_(m,IDN,k,j,i);
-
-    // MHD ME
-    hvars.the_array[nmhd_+3] = vol*0.25*(SQR(bx1f(m,k,j,i+1)) + SQR(bx1f(m,k,j,i)));
-    hvars.the_array[nmhd_+4] = vol*0.25*(SQR(bx2f(m,k,j+1,i)) + SQR(bx2f(m,k,j,i)));
-    hvars.the_array[nmhd_+5] = vol*0.25*(SQR(bx3f(m,k+1,j,i)) + SQR(bx3f(m,k,j,i)));
+    if (om >= 0) {
+      // MHD conserved variables:
+      hvars.the_array[om+IDN] = vol*u0m(m,IDN,k,j,i);
+      hvars.the_array[om+IM1] = vol*u0m(m,IM1,k,j,i);
+      hvars.the_array[om+IM2] = vol*u0m(m,IM2,k,j,i);
+      hvars.the_array[om+IM3] = vol*u0m(m,IM3,k,j,i);
+      if (mhd_ideal) {
+        hvars.the_array[om+IEN] = vol*u0m(m,IEN,k,j,i);
+      }
+      // MHD KE
+      hvars.the_array[om+nmhd_  ] = vol*0.5*SQR(u0m(m,IM1,k,j,i))/u0m(m,IDN,k,j,i);
+      hvars.the_array[om+nmhd_+1] = vol*0.5*SQR(u0m(m,IM2,k,j,i))/u0m(m,IDN,k,j,i);
+      hvars.the_array[om+nmhd_+2] = vol*0.5*SQR(u0m(m,IM3,k,j,i))/u0m(m,IDN,k,j,i);
+      // MHD ME
+      hvars.the_array[om+nmhd_+3] = vol*0.25*(SQR(bx1f(m,k,j,i+1)) + SQR(bx1f(m,k,j,i)));
+      hvars.the_array[om+nmhd_+4] = vol*0.25*(SQR(bx2f(m,k,j+1,i)) + SQR(bx2f(m,k,j,i)));
+      hvars.the_array[om+nmhd_+5] = vol*0.25*(SQR(bx3f(m,k+1,j,i)) + SQR(bx3f(m,k,j,i)));
+    }
 
-    // fill rest of the_array with zeros, if nhist < NHISTORY_VARIABLES
-    for (int n=nhist_; n<NHISTORY_VARIABLES; ++n) {
-      hvars.the_array[n] = 0.0;
+    if (oz >= 0 && !(con_norms)) {
+      // Z4c constraints:
+      using z4c::Z4c;
+      hvars.the_array[oz  ] = vol*SQR(ucon(m,Z4c::I_CON_H,k,j,i));  // ||H||^2
+      hvars.the_array[oz+1] = vol*ucon(m,Z4c::I_CON_M,k,j,i);       // ||M||^2 (squared)
+      hvars.the_array[oz+2] = vol*SQR(ucon(m,Z4c::I_CON_MX,k,j,i)); // ||Mx||^2
+      hvars.the_array[oz+3] = vol*SQR(ucon(m,Z4c::I_CON_MY,k,j,i)); // ||My||^2
+      hvars.the_array[oz+4] = vol*SQR(ucon(m,Z4c::I_CON_MZ,k,j,i)); // ||Mz||^2
+      hvars.the_array[oz+5] = vol*ucon(m,Z4c::I_CON_Z,k,j,i);       // ||Z||^2 (squared)
+      hvars.the_array[oz+6] = vol*SQR(u0z(m,I_Z4c_Theta_,k,j,i));   // ||Theta||^2
+      hvars.the_array[oz+7] = vol*ucon(m,Z4c::I_CON_C,k,j,i);       // ||C||^2 (squared)
     }
 
     // sum into parallel reduce
     mb_sum += hvars;
-  }, Kokkos::Sum<array_sum::GlobalSum>(sum_this_mb));
-  Kokkos::fence();
+  }, Kokkos::Sum<array_sum::HistorySum>(sum_this_mb));
 
-  // store data into hdata array
-  for (int n=0; n<pdata->nhist; ++n) {
-    pdata->hdata[n] = sum_this_mb.the_array[n];
+  // store data into hdata arrays
+  for (auto &data : hist_data) {
+    int off = -1;
+    if (data.physics == PhysicsModule::HydroDynamics) {off = oh;}
+    if (data.physics == PhysicsModule::MagnetoHydroDynamics) {off = om;}
+    if (data.physics == PhysicsModule::SpaceTimeDynamics) {off = oz;}
+    if (off < 0) continue;
+    for (int n=0; n<data.nhist; ++n) {
+      data.hdata[n] = (off == oz && con_norms)? znorms[n] : sum_this_mb.the_array[off+n];
+    }
   }
-
   return;
 }
 
@@ -328,18 +267,59 @@ void HistoryOutput::LoadMHDHistoryData(HistoryData *pdata, Mesh *pm) {
 //  \brief Cycles through hist_data vector and writes history file for each component
 
 void HistoryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
+  // complete previous history output, if its reduction is still in flight
+  FinishOutputFile();
+
+  // pack data of all physics modules into one buffer, and sum over all MPI ranks with a
+  // single non-blocking reduction, so ranks do not wait for each other here.  The file
+  // is written when the reduction completes at the next history output (or at the end
+  // of the run).
+  int ntot = 0;
+  for (auto &data : hist_data) {ntot += data.nhist;}
+  hist_sendbuf.resize(ntot);
+  hist_recvbuf.resize(ntot);
+  int n0 = 0;
   for (auto &data : hist_data) {
-    // first, perform in-place sum over all MPI ranks
+    for (int n=0; n<data.nhist; ++n) {hist_sendbuf[n0+n] = data.hdata[n];}
+    n0 += data.nhist;
+  }
+  hist_time = pm->time;
+  hist_dt = pm->dt;
+  hist_pending = true;
 #if MPI_PARALLEL_ENABLED
-    if (global_variable::my_rank == 0) {
-      MPI_Reduce(MPI_IN_PLACE, &(data.hdata[0]), data.nhist, MPI_ATHENA_REAL,
-         MPI_SUM, 0, MPI_COMM_WORLD);
-    } else {
-      MPI_Reduce(&(data.hdata[0]), &(data.hdata[0]), data.nhist,
-         MPI_ATHENA_REAL, MPI_SUM, 0, MPI_COMM_WORLD);
-    }
+  MPI_Ireduce(hist_sendbuf.data(), hist_recvbuf.data(), ntot, MPI_ATHENA_REAL, MPI_SUM,
+              0, global_variable::mpi_comm, &hist_req);
+#else
+  hist_recvbuf = hist_sendbuf;
+  FinishOutputFile();
+#endif
+
+  // increment counters, clean up
+  if (out_params.last_time < 0.0) {
+    out_params.last_time = pm->time;
+  } else {
+    out_params.last_time += out_params.dt;
+  }
+  pin->SetReal(out_params.block_name, "last_time", out_params.last_time);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void HistoryOutput::FinishOutputFile()
+//  \brief Completes reduction of pending history data over MPI ranks, then cycles
+//  through hist_data vector and writes history file for each component
+
+void HistoryOutput::FinishOutputFile() {
+  if (!(hist_pending)) return;
+#if MPI_PARALLEL_ENABLED
+  MPI_Wait(&hist_req, MPI_STATUS_IGNORE);
 #endif
+  hist_pending = false;
 
+  int n0 = 0;
+  for (auto &data : hist_data) {
+    const Real *hdata = hist_recvbuf.data() + n0;
+    n0 += data.nhist;
     // only the master rank writes the file
     if (global_variable::my_rank == 0) {
       // create filename: "file_basename" + ".physics" + ".hst"
@@ -385,21 +365,13 @@ void HistoryOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
       }
 
       // write history variables
-      std::fprintf(pfile, out_params.data_format.c_str(), pm->time);
-      std::fprintf(pfile, out_params.data_format.c_str(), pm->dt);
+      std::fprintf(pfile, out_params.data_format.c_str(), hist_time);
+      std::fprintf(pfile, out_params.data_format.c_str(), hist_dt);
       for (int n=0; n<data.nhist; ++n)
-        std::fprintf(pfile, out_params.data_format.c_str(), data.hdata[n]);
+        std::fprintf(pfile, out_params.data_format.c_str(), hdata[n]);
       std::fprintf(pfile,"\n"); // terminate line
       std::fclose(pfile);
     }
   } // End loop over hist_data vector
-
-  // increment counters, clean up
-  if (out_params.last_time < 0.0) {
-    out_params.last_time = pm->time;
-  } else {
-    out_params.last_time += out_params.dt;
-  }
-  pin->SetReal(out_params.block_name, "last_time", out_params.last_time);
   return;
 }
@@ -0,0 +1,134 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file ic_cache.cpp
+//! \brief implements functions used to write and read the cache of initial data
+
+#include <sys/stat.h>  // mkdir, stat
+
+#include <cstdint>
+#include <cstdio>      // snprintf()
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mesh/mesh.hpp"
+#include "outputs.hpp"
+#include "ic_cache.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
+namespace ic_cache {
+//----------------------------------------------------------------------------------------
+//! \fn std::string FileName()
+//! \brief Returns name of the cache file of the initial data of a run with the input
+//! parameters in pin, or an empty string if <problem>/ic_cache is not set.  Must be
+//! called before parameters are added with default values.
+
+std::string FileName(ParameterInput *pin) {
+  if (!(pin->DoesParameterExist("problem", "ic_cache"))) {return std::string();}
+  std::string dir = pin->GetString("problem", "ic_cache");
+  std::string blocks = pin->GetOrAddString("problem", "ic_cache_blocks", "all");
+
+  // names of the blocks included in the hash
+  std::vector<std::string> names;
+  if (blocks.compare("all") != 0) {
+    std::stringstream list(blocks);
+    std::string name;
+    while (std::getline(list, name, ',')) {names.push_back(name);}
+  }
+
+  // hash of "<block>name=value" of all parameters in these blocks (in the order of the
+  // list, or of the input file), except those of the cache itself
+  std::string pars;
+  auto add_block = [&pars](const InputBlock &ib) {
+    for (auto &il : ib.line) {
+      if (il.param_name.compare(0, 8, "ic_cache") == 0) continue;
+      pars += "<" + ib.block_name + ">" + il.param_name + "=" + il.param_value + "\n";
+    }
+  };
+  if (names.empty()) {
+    for (auto &ib : pin->block) {
+      if (ib.block_name.compare("time") == 0 || ib.block_name.compare("job") == 0 ||
+          ib.block_name.compare(0, 6, "output") == 0) continue;
+      add_block(ib);
+    }
+  } else {
+    for (auto &name : names) {
+      for (auto &ib : pin->block) {
+        if (ib.block_name.compare(name) == 0) {add_block(ib);}
+      }
+    }
+  }
+  char hash[17];
+  std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(
+                restart_delta::Hash(pars.data(), pars.size())));
+  return dir + "/ic." + hash + ".rst";
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool Open()
+//! \brief Opens the cache file fname if it exists, and skips the input parameters stored
+//! in it, so that the mesh and initial data can be read as from a restart file.  Returns
+//! false if there is no cache file.
+
+bool Open(const std::string &fname, IOWrapper &cachefile) {
+  if (fname.empty()) {return false;}
+  int found = 0;
+  if (global_variable::my_rank == 0) {
+    struct stat sb;
+    found = (stat(fname.c_str(), &sb) == 0)? 1 : 0;
+  }
+#if MPI_PARALLEL_ENABLED
+  MPI_Bcast(&found, 1, MPI_INT, 0, global_variable::mpi_comm);
+#endif
+  if (found == 0) {return false;}
+
+  if (global_variable::my_rank == 0) {
+    std::cout << "Reading initial data from cache file " << fname << std::endl;
+  }
+  cachefile.Open(fname.c_str(), IOWrapper::FileMode::read);
+  ParameterInput cached_pars;
+  cached_pars.LoadFromFile(cachefile);
+  return true;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Write()
+//! \brief Writes the initial data set by the problem generator to the cache file fname,
+//! as a restart file
+
+void Write(ParameterInput *pin, Mesh *pm, const std::string &fname) {
+  std::string dir = fname.substr(0, fname.find_last_of('/'));
+  if (global_variable::my_rank == 0) {mkdir(dir.c_str(), 0775);}
+#if MPI_PARALLEL_ENABLED
+  MPI_Barrier(global_variable::mpi_comm);
+#endif
+
+  OutputParameters opar;
+  opar.block_name = "ic_cache";
+  opar.file_type = "rst";
+  opar.file_basename = "ic";
+  opar.file_number = 0;
+  opar.file_path = fname;
+  opar.last_time = -1.0;
+  opar.dt = 0.0;
+  opar.dcycle = 0;
+  RestartOutput rst(pin, pm, opar);
+  rst.LoadOutputData(pm);
+  rst.WriteOutputFile(pm, pin);
+  if (global_variable::my_rank == 0) {
+    std::cout << "Initial data written to cache file " << fname << std::endl;
+  }
+  return;
+}
+
+} // namespace ic_cache
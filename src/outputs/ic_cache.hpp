@@ -0,0 +1,36 @@
+#ifndef OUTPUTS_IC_CACHE_HPP_
+#define OUTPUTS_IC_CACHE_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file ic_cache.hpp
+//  \brief functions used to cache initial data.  With <problem>/ic_cache = <directory>,
+//  the state set by the problem generator in a new run is written (in the restart
+//  format) to <directory>/ic.<hash>.rst, where the hash is computed from the input
+//  parameters in the blocks listed in <problem>/ic_cache_blocks (by default all blocks
+//  except <time>, <job>, and <output*>).  Later new runs whose parameters in these
+//  blocks are the same read the initial data from this file instead of calling the
+//  problem generator, as in a restart (so possibly on a different number of ranks), but
+//  all other parameters are taken from the input file.  Parameters that do not change
+//  the initial data (e.g. floors) can be left out of the hash by listing only the blocks
+//  that do, e.g. ic_cache_blocks = problem,mesh,meshblock,mesh_refinement,coord,mhd.
+
+#include <string>
+
+#include "athena.hpp"
+#include "io_wrapper.hpp"
+
+// Forward declarations
+class Mesh;
+class ParameterInput;
+
+namespace ic_cache {
+
+std::string FileName(ParameterInput *pin);
+bool Open(const std::string &fname, IOWrapper &cachefile);
+void Write(ParameterInput *pin, Mesh *pm, const std::string &fname);
+
+} // namespace ic_cache
+#endif // OUTPUTS_IC_CACHE_HPP_
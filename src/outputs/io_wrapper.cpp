@@ -6,6 +6,8 @@
 //! \file io_wrapper.cpp
 //! \brief functions that provide wrapper for MPI-IO versus serial input/output
 
+#include <algorithm>
+#include <climits>
 #include <cstdio>
 #include <cstdlib>
 #include <iomanip>
@@ -13,8 +15,11 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "athena.hpp"
+#include "globals.hpp"
 #include "io_wrapper.hpp"
 
 //----------------------------------------------------------------------------------------
@@ -32,7 +37,7 @@ int IOWrapper::Open(const char* fname, FileMode rw) {
       int resultlen;
       MPI_Error_string(errcode, msg, &resultlen);
       printf("%.*s\n", resultlen, msg);
-      MPI_Abort(MPI_COMM_WORLD, 1);
+      MPI_Abort(global_variable::mpi_comm, 1);
       std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
                 << std::endl << "Input file '" << fname << "' could not be opened"
                 << std::endl;
@@ -51,19 +56,35 @@ int IOWrapper::Open(const char* fname, FileMode rw) {
   } else if (rw == FileMode::write) {
 #if MPI_PARALLEL_ENABLED
     MPI_File_delete(fname, MPI_INFO_NULL); // truncation
+    MPI_Info info = Hints();
     int errcode = MPI_File_open(comm_, fname, MPI_MODE_WRONLY | MPI_MODE_CREATE,
-                                MPI_INFO_NULL, &fh_);
+                                info, &fh_);
+    if (info != MPI_INFO_NULL) {MPI_Info_free(&info);}
     if (errcode != MPI_SUCCESS) {
       char msg[MPI_MAX_ERROR_STRING];
       int resultlen;
       MPI_Error_string(errcode, msg, &resultlen);
       printf("%.*s\n", resultlen, msg);
-      MPI_Abort(MPI_COMM_WORLD, 1);
+      MPI_Abort(global_variable::mpi_comm, 1);
       std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
                 << std::endl << "Input file '" << fname << "' could not be opened"
                 << std::endl;
       std::exit(EXIT_FAILURE);
     }
+    // split ranks on each node (sharing memory) into naggr_ groups of consecutive ranks,
+    // the first rank of each group is its aggregator
+    if (naggr_ > 0) {
+      int rank, node_rank, node_size;
+      MPI_Comm node_comm;
+      MPI_Comm_rank(comm_, &rank);
+      MPI_Comm_split_type(comm_, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL,
+                          &node_comm);
+      MPI_Comm_rank(node_comm, &node_rank);
+      MPI_Comm_size(node_comm, &node_size);
+      int ngroup = std::min(naggr_, node_size);
+      MPI_Comm_split(node_comm, (node_rank*ngroup)/node_size, node_rank, &aggr_comm_);
+      MPI_Comm_free(&node_comm);
+    }
 #else
     if ((fh_ = std::fopen(fname,"wb")) == nullptr) {
       std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
@@ -83,7 +104,7 @@ int IOWrapper::Open(const char* fname, FileMode rw) {
       int resultlen;
       MPI_Error_string(errcode, msg, &resultlen);
       printf("%.*s\n", resultlen, msg);
-      MPI_Abort(MPI_COMM_WORLD, 1);
+      MPI_Abort(global_variable::mpi_comm, 1);
       std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
                 << std::endl << "Input file '" << fname << "' could not be appended"
                 << std::endl;
@@ -281,7 +302,7 @@ std::size_t IOWrapper::Write_any_type(const void *buf, IOWrapperSizeT cnt,
   } else if (datatype.compare("Real") == 0) {
     mpitype = MPI_ATHENA_REAL;
   } else {
-    MPI_Abort(MPI_COMM_WORLD, 1);
+    MPI_Abort(global_variable::mpi_comm, 1);
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
               << std::endl << "Unrecognized datatype '" << datatype << "'" << std::endl;
     std::exit(EXIT_FAILURE);
@@ -344,12 +365,27 @@ std::size_t IOWrapper::Write_any_type_at(const void *buf, IOWrapperSizeT cnt,
   } else if (datatype.compare("Real") == 0) {
     mpitype = MPI_ATHENA_REAL;
   } else {
-    MPI_Abort(MPI_COMM_WORLD, 1);
+    MPI_Abort(global_variable::mpi_comm, 1);
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
               << std::endl << "Unrecognized datatype '" << datatype << "'" << std::endl;
     std::exit(EXIT_FAILURE);
   }
   // Now write data using MPI-IO
+  if (nonblocking_) {
+    MPI_Request req;
+    int errcode = MPI_File_iwrite_at(fh_, offset, buf, cnt, mpitype, &req);
+    if (errcode != MPI_SUCCESS) {
+      char msg[MPI_MAX_ERROR_STRING];
+      int resultlen;
+      MPI_Error_string(errcode, msg, &resultlen);
+      printf("%.*s\n", resultlen, msg);
+      return 0;
+    }
+    reqs_.push_back(req);
+    req_cnt_.push_back(cnt);
+    req_type_.push_back(mpitype);
+    return cnt;
+  }
   MPI_Status status;
   int errcode = MPI_File_write_at(fh_, offset, buf, cnt, mpitype, &status);
   if (errcode != MPI_SUCCESS) {
@@ -408,12 +444,32 @@ std::size_t IOWrapper::Write_any_type_at_all(const void *buf, IOWrapperSizeT cnt
   } else if (datatype.compare("Real") == 0) {
     mpitype = MPI_ATHENA_REAL;
   } else {
-    MPI_Abort(MPI_COMM_WORLD, 1);
+    MPI_Abort(global_variable::mpi_comm, 1);
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
               << std::endl << "Unrecognized datatype '" << datatype << "'" << std::endl;
     std::exit(EXIT_FAILURE);
   }
+  // gather data onto node aggregators if requested (and possible)
+  if (aggr_comm_ != MPI_COMM_NULL) {
+    std::size_t nwrite;
+    if (AggregatedWrite(buf, cnt, offset, mpitype, nwrite)) {return nwrite;}
+  }
   // Now write data using MPI-IO
+  if (nonblocking_) {
+    MPI_Request req;
+    int errcode = MPI_File_iwrite_at_all(fh_, offset, buf, cnt, mpitype, &req);
+    if (errcode != MPI_SUCCESS) {
+      char msg[MPI_MAX_ERROR_STRING];
+      int resultlen;
+      MPI_Error_string(errcode, msg, &resultlen);
+      printf("%.*s\n", resultlen, msg);
+      return 0;
+    }
+    reqs_.push_back(req);
+    req_cnt_.push_back(cnt);
+    req_type_.push_back(mpitype);
+    return cnt;
+  }
   MPI_Status status;
   int errcode = MPI_File_write_at_all(fh_, offset, buf, cnt, mpitype, &status);
   if (errcode != MPI_SUCCESS) {
@@ -452,10 +508,31 @@ std::size_t IOWrapper::Write_any_type_at_all(const void *buf, IOWrapperSizeT cnt
 
 //----------------------------------------------------------------------------------------
 //! \fn void IOWrapper::Close()
-//  \brief wrapper for {MPI_File_close} versus {std::fclose}
+//  \brief wrapper for {MPI_File_close} versus {std::fclose}. With MPI, first waits for
+//  any non-blocking writes posted to the file
 
 int IOWrapper::Close() {
 #if MPI_PARALLEL_ENABLED
+  // complete any non-blocking writes, and check all data was written
+  if (!(reqs_.empty())) {
+    std::vector<MPI_Status> stats(reqs_.size());
+    MPI_Waitall(reqs_.size(), reqs_.data(), stats.data());
+    for (std::size_t n=0; n<reqs_.size(); ++n) {
+      int nwrite;
+      if (MPI_Get_count(&(stats[n]), req_type_[n], &nwrite) == MPI_UNDEFINED ||
+          nwrite != req_cnt_[n]) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "non-blocking write did not complete correctly, "
+                  << "output file is broken." << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+    }
+    reqs_.clear();
+    req_cnt_.clear();
+    req_type_.clear();
+  }
+  aggr_bufs_.clear();
+  if (aggr_comm_ != MPI_COMM_NULL) {MPI_Comm_free(&aggr_comm_);}
   return MPI_File_close(&fh_);
 #else
   return std::fclose(fh_);
@@ -487,3 +564,132 @@ IOWrapperSizeT IOWrapper::GetPosition() {
   return ftell(fh_);
 #endif
 }
+
+#if MPI_PARALLEL_ENABLED
+//----------------------------------------------------------------------------------------
+//! \fn MPI_Info IOWrapper::Hints()
+//  \brief returns MPI-IO hints matching collective buffering to the file system stripe
+//  size and number of aggregators per node (MPI_INFO_NULL if neither is set).  Hints not
+//  understood by the MPI-IO implementation are ignored.
+
+MPI_Info IOWrapper::Hints() {
+  MPI_Info info = MPI_INFO_NULL;
+  if (naggr_ <= 0 && stripe_ == 0) {return info;}
+  MPI_Info_create(&info);
+  if (stripe_ > 0) {
+    std::string stripe = std::to_string(stripe_);
+    MPI_Info_set(info, "striping_unit", stripe.c_str());
+    MPI_Info_set(info, "cb_buffer_size", stripe.c_str());
+  }
+  if (naggr_ > 0) {
+    std::string cb_list = "*:" + std::to_string(naggr_);
+    MPI_Info_set(info, "cb_config_list", cb_list.c_str());
+  }
+  return info;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool IOWrapper::AggregatedWrite()
+//  \brief two-level collective write.  Data of all ranks in aggr_comm_ are gathered by
+//  the aggregator, which then writes them with one large call to MPI_File_write_at_all
+//  (other ranks take part with zero-length writes).  This is only possible when the data
+//  of each group form one contiguous region of the file (always true for MeshBlocks
+//  stored in gid order), and fit in an int count; if this fails on any rank, false is
+//  returned on all ranks and the caller must write the data directly.
+//  On success, nwrite is set to the number of elements written by this rank.
+
+bool IOWrapper::AggregatedWrite(const void *buf, IOWrapperSizeT cnt,
+                                IOWrapperSizeT offset, MPI_Datatype mpitype,
+                                std::size_t &nwrite) {
+  int tsize, grank, gsize;
+  MPI_Type_size(mpitype, &tsize);
+  MPI_Comm_rank(aggr_comm_, &grank);
+  MPI_Comm_size(aggr_comm_, &gsize);
+
+  // collect (offset, size) of all segments in group on aggregator
+  IOWrapperSizeT myseg[2] = {offset, cnt*static_cast<IOWrapperSizeT>(tsize)};
+  std::vector<IOWrapperSizeT> segs(2*gsize);
+  MPI_Gather(myseg, 2, MPI_UINT64_T, segs.data(), 2, MPI_UINT64_T, 0, aggr_comm_);
+
+  // check segments are contiguous (ignoring empty segments) and total fits in an int
+  int ok = 1;
+  IOWrapperSizeT start = 0, end = 0, total = 0;
+  if (grank == 0) {
+    bool first = true;
+    for (int n=0; n<gsize; ++n) {
+      IOWrapperSizeT nbytes = segs[2*n+1];
+      if (nbytes == 0) continue;
+      if (first) {
+        start = segs[2*n];
+        end = start;
+        first = false;
+      }
+      if (segs[2*n] != end) {ok = 0;}
+      end += nbytes;
+      total += nbytes;
+    }
+    if (total > static_cast<IOWrapperSizeT>(INT_MAX)) {ok = 0;}
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, comm_);
+  if (ok == 0) {return false;}
+
+  // gather data into buffer on aggregator
+  std::vector<int> counts, displs;
+  std::vector<char> abuf;
+  if (grank == 0) {
+    counts.resize(gsize);
+    displs.resize(gsize);
+    int disp = 0;
+    for (int n=0; n<gsize; ++n) {
+      counts[n] = static_cast<int>(segs[2*n+1]);
+      displs[n] = disp;
+      disp += counts[n];
+    }
+    abuf.resize(total);
+  }
+  MPI_Gatherv(buf, static_cast<int>(myseg[1]), MPI_BYTE, abuf.data(), counts.data(),
+              displs.data(), MPI_BYTE, 0, aggr_comm_);
+
+  // aggregators write data, other ranks join collective write with zero bytes
+  int nbytes = (grank == 0)? static_cast<int>(total) : 0;
+  MPI_Offset woffset = (grank == 0)? start : offset;
+  if (nonblocking_) {
+    MPI_Request req;
+    int errcode = MPI_File_iwrite_at_all(fh_, woffset, abuf.data(), nbytes, MPI_BYTE,
+                                         &req);
+    if (errcode != MPI_SUCCESS) {
+      char msg[MPI_MAX_ERROR_STRING];
+      int resultlen;
+      MPI_Error_string(errcode, msg, &resultlen);
+      printf("%.*s\n", resultlen, msg);
+      nwrite = 0;
+      return true;
+    }
+    reqs_.push_back(req);
+    req_cnt_.push_back(nbytes);
+    req_type_.push_back(MPI_BYTE);
+    // buffer must be kept until write completes in Close()
+    aggr_bufs_.push_back(std::move(abuf));
+    nwrite = cnt;
+    return true;
+  }
+  MPI_Status status;
+  int wok = 1;
+  int errcode = MPI_File_write_at_all(fh_, woffset, abuf.data(), nbytes, MPI_BYTE,
+                                      &status);
+  if (errcode != MPI_SUCCESS) {
+    char msg[MPI_MAX_ERROR_STRING];
+    int resultlen;
+    MPI_Error_string(errcode, msg, &resultlen);
+    printf("%.*s\n", resultlen, msg);
+    wok = 0;
+  } else if (grank == 0) {
+    int nw;
+    if (MPI_Get_count(&status, MPI_BYTE, &nw) == MPI_UNDEFINED || nw != nbytes) {wok = 0;}
+  }
+  // result of write by aggregator applies to all ranks in group
+  MPI_Bcast(&wok, 1, MPI_INT, 0, aggr_comm_);
+  nwrite = (wok == 1)? cnt : 0;
+  return true;
+}
+#endif
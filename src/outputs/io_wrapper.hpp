@@ -10,7 +10,9 @@
 
 #include <string>
 #include <cstdio>
+#include <vector>
 #include "athena.hpp"
+#include "globals.hpp"
 
 #if MPI_PARALLEL_ENABLED
 #include <mpi.h>
@@ -24,10 +26,11 @@ using IOWrapperSizeT = std::uint64_t;
 class IOWrapper {
  public:
 #if MPI_PARALLEL_ENABLED
-  IOWrapper() : fh_(nullptr), comm_(MPI_COMM_WORLD) {}
+  IOWrapper() : fh_(nullptr), nonblocking_(false), naggr_(0), stripe_(0),
+                comm_(global_variable::mpi_comm), aggr_comm_(MPI_COMM_NULL) {}
   void SetCommunicator(MPI_Comm scomm) { comm_=scomm;}
 #else
-  IOWrapper() {fh_=nullptr;}
+  IOWrapper() {fh_=nullptr; nonblocking_=false; naggr_=0; stripe_=0;}
 #endif
   ~IOWrapper() {}
   // nested type definition of strongly typed/scoped enum in class definition
@@ -51,11 +54,29 @@ class IOWrapper {
   int Close();
   int Seek(IOWrapperSizeT offset);
   IOWrapperSizeT GetPosition();
+  // With MPI, Write_any_type_at[_all] can instead post non-blocking writes, which are
+  // completed (and checked) by Close(). Buffers must not be modified until then.
+  void SetNonBlocking(bool flag) {nonblocking_ = flag;}
+  // With MPI, data written by Write_any_type_at_all can be gathered within each node onto
+  // naggr aggregator ranks, which then issue one large write each.  The stripe size (in
+  // bytes) of the file system is passed to MPI-IO as a hint.  Must be set before Open().
+  void SetAggregation(int naggr, IOWrapperSizeT stripe) {naggr_=naggr; stripe_=stripe;}
 
  private:
   IOWrapperFile fh_;
+  bool nonblocking_;
+  int naggr_;                         // number of aggregator ranks per node (0 = none)
+  IOWrapperSizeT stripe_;             // file system stripe size in bytes (0 = default)
 #if MPI_PARALLEL_ENABLED
   MPI_Comm comm_;
+  MPI_Comm aggr_comm_;                // ranks sharing one aggregator (root = aggregator)
+  std::vector<std::vector<char>> aggr_bufs_;  // aggregated data of non-blocking writes
+  std::vector<MPI_Request> reqs_;     // non-blocking writes in flight
+  std::vector<int> req_cnt_;          // number of elements posted by each write
+  std::vector<MPI_Datatype> req_type_;
+  MPI_Info Hints();
+  bool AggregatedWrite(const void *buf, IOWrapperSizeT cnt, IOWrapperSizeT offset,
+                       MPI_Datatype mpitype, std::size_t &nwrite);
 #endif
 };
 #endif // OUTPUTS_IO_WRAPPER_HPP_
@@ -18,9 +18,25 @@
 //! Required parameters that must be specified in an <output[n]> block are:
 //!   - variable  = [list of currently implemented strings for specifing output variables
 //!                  is defined at start of outputs.hpp file]
-//!   - file_type = tab,vtk,hst,bin,rst
+//!   - file_type = tab,vtk,hst,bin,hdf5,ascent,rst,ugrid
 //!   - dt        = problem time between outputs
 //!
+//! Outputs can also (or, if neither dt nor dcycle is given, only) be triggered by events,
+//! checked every trigger_dcycle cycles (default 1).  Each is disabled by default:
+//!   - trigger_dmax       = relative change of maximum density since last output
+//!   - trigger_new_level  = true: when AMR creates a level finer than at last output
+//!   - trigger_separation = distance between first two compact object trackers (z4c)
+//!                          below which output is made once, e.g. at merger
+//! Cheap outputs (e.g. slices or coarsened binaries) can then be made at fixed intervals
+//! by other <output[n]> blocks, and full 3D dumps only when something happens.
+//!
+//! ugrid outputs interpolate the variables to a uniform Cartesian grid of nx1*nx2*nx3
+//! cells spanning x1min..x3max (default: cells of the given level over the whole Mesh);
+//! see uniform_grid.cpp.
+//!
+//! Data of bin and cbin outputs are compressed with an absolute error bound if
+//! compress_error > 0 (see CompressBinaryData() in binary.cpp).
+//!
 //! EXAMPLE of an <output[n]> block for a TAB dump:
 //!   <output3>
 //!   file_type   = tab       # Tabular data dump
@@ -72,15 +88,33 @@ Outputs::Outputs(ParameterInput *pin, Mesh *pm) {
       // set time of last output, time or cycles between outputs
       // when last_time < 0, then outputs will always be made
       opar.last_time = pin->GetOrAddReal(opar.block_name,"last_time", -1.0);
+      opar.trigger_dmax = pin->GetOrAddReal(opar.block_name,"trigger_dmax",0.0);
+      opar.trigger_new_level =
+          pin->GetOrAddBoolean(opar.block_name,"trigger_new_level",false);
+      opar.trigger_separation =
+          pin->GetOrAddReal(opar.block_name,"trigger_separation",0.0);
+      opar.trigger_dcycle = pin->GetOrAddInteger(opar.block_name,"trigger_dcycle",1);
+      bool triggered = (opar.trigger_dmax > 0.0 || opar.trigger_new_level ||
+                        opar.trigger_separation > 0.0);
+      if (triggered && opar.trigger_dcycle < 1) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+            << std::endl << "trigger_dcycle=" << opar.trigger_dcycle
+            << " in output block '" << opar.block_name << "' must be > 0" << std::endl;
+        exit(EXIT_FAILURE);
+      }
       if (pin->DoesParameterExist(opar.block_name,"dcycle")) {
         opar.dcycle = pin->GetInteger(opar.block_name,"dcycle");
         opar.dt = 0.0;
+      } else if (triggered && !pin->DoesParameterExist(opar.block_name,"dt")) {
+        opar.dt = 0.0;
+        opar.dcycle = 0;
       } else {
         opar.dt = pin->GetReal(opar.block_name,"dt");
         opar.dcycle = 0;
       }
 
-      if (opar.dcycle == 0 && opar.dt <= 0.0) continue;  // only add output if dt>0
+      // only add output if dt>0, or if it is triggered by events
+      if (opar.dcycle == 0 && opar.dt <= 0.0 && !triggered) continue;
 
       // set file number, basename, and format
       opar.file_number = pin->GetOrAddInteger(opar.block_name,"file_number",0);
@@ -115,9 +149,10 @@ Outputs::Outputs(ParameterInput *pin, Mesh *pm) {
         exit(EXIT_FAILURE);
       }
 
-      // read slicing options.  Check that slice is within mesh
+      // read slicing options (in physical coordinates, stored as logical coordinates of
+      // the mesh; see CoordinateStretch).  Check that slice is within mesh
       if (pin->DoesParameterExist(opar.block_name,"slice_x1")) {
-        Real x1 = pin->GetReal(opar.block_name,"slice_x1");
+        Real x1 = pm->stretch.Xi(0, pin->GetReal(opar.block_name,"slice_x1"));
         if (x1 >= pm->mesh_size.x1min && x1 < pm->mesh_size.x1max) {
           opar.slice_x1 = x1;
           opar.slice1 = true;
@@ -132,7 +167,7 @@ Outputs::Outputs(ParameterInput *pin, Mesh *pm) {
       }
 
       if (pin->DoesParameterExist(opar.block_name,"slice_x2")) {
-        Real x2 = pin->GetReal(opar.block_name,"slice_x2");
+        Real x2 = pm->stretch.Xi(1, pin->GetReal(opar.block_name,"slice_x2"));
         if (x2 >= pm->mesh_size.x2min && x2 < pm->mesh_size.x2max) {
           opar.slice_x2 = x2;
           opar.slice2 = true;
@@ -147,7 +182,7 @@ Outputs::Outputs(ParameterInput *pin, Mesh *pm) {
       }
 
       if (pin->DoesParameterExist(opar.block_name,"slice_x3")) {
-        Real x3 = pin->GetReal(opar.block_name,"slice_x3");
+        Real x3 = pm->stretch.Xi(2, pin->GetReal(opar.block_name,"slice_x3"));
         if (x3 >= pm->mesh_size.x3min && x3 < pm->mesh_size.x3max) {
           opar.slice_x3 = x3;
           opar.slice3 = true;
@@ -179,6 +214,38 @@ Outputs::Outputs(ParameterInput *pin, Mesh *pm) {
         exit(EXIT_FAILURE);
       }
 
+      // read region of interest (in physical coordinates).  Bounds of the box that are
+      // not specified are those of the Mesh; box is stored in logical coordinates
+      Real mesh_min[3] = {pm->mesh_size.x1min, pm->mesh_size.x2min, pm->mesh_size.x3min};
+      Real mesh_max[3] = {pm->mesh_size.x1max, pm->mesh_size.x2max, pm->mesh_size.x3max};
+      opar.region_box = false;
+      for (int d=0; d<3; ++d) {
+        std::string xmin = "region_x" + std::to_string(d+1) + "min";
+        std::string xmax = "region_x" + std::to_string(d+1) + "max";
+        opar.region_min[d] = mesh_min[d];
+        opar.region_max[d] = mesh_max[d];
+        if (pin->DoesParameterExist(opar.block_name, xmin)) {
+          opar.region_min[d] = pm->stretch.Xi(d, pin->GetReal(opar.block_name, xmin));
+          opar.region_box = true;
+        }
+        if (pin->DoesParameterExist(opar.block_name, xmax)) {
+          opar.region_max[d] = pm->stretch.Xi(d, pin->GetReal(opar.block_name, xmax));
+          opar.region_box = true;
+        }
+        if (opar.region_min[d] >= opar.region_max[d]) {
+          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "Region in output block '" << opar.block_name
+              << "' has " << xmin << " >= " << xmax << std::endl;
+          exit(EXIT_FAILURE);
+        }
+      }
+      opar.region_radius = pin->GetOrAddReal(opar.block_name, "region_radius", 0.0);
+      opar.region_center[0] = pin->GetOrAddReal(opar.block_name, "region_x1", 0.0);
+      opar.region_center[1] = pin->GetOrAddReal(opar.block_name, "region_x2", 0.0);
+      opar.region_center[2] = pin->GetOrAddReal(opar.block_name, "region_x3", 0.0);
+      opar.min_level = pin->GetOrAddInteger(opar.block_name, "min_level", -1);
+      opar.max_level = pin->GetOrAddInteger(opar.block_name, "max_level", -1);
+
       // set output variable and optional file id (default is output variable name)
       if (opar.file_type.compare("hst") != 0 &&
           opar.file_type.compare("rst") != 0 &&
@@ -219,6 +286,24 @@ Outputs::Outputs(ParameterInput *pin, Mesh *pm) {
       opar.data_format.insert(0, " "); // prepend with blank to separate columns
 
       // Construct new BaseTypeOutput according to file format
+      // with MPI, parallel binary and restart files can be written by io_aggregators
+      // ranks per node, which gather the data of the other ranks on the node
+      if (opar.file_type.compare("bin") == 0 || opar.file_type.compare("cbin") == 0 ||
+          opar.file_type.compare("rst") == 0) {
+        opar.io_aggregators = pin->GetOrAddInteger(opar.block_name,"io_aggregators",0);
+        opar.io_stripe_size = pin->GetOrAddInteger(opar.block_name,"io_stripe_size",0);
+      }
+      // optional error-bounded lossy compression of binary data
+      if (opar.file_type.compare("bin") == 0 || opar.file_type.compare("cbin") == 0) {
+        opar.compress_error = pin->GetOrAddReal(opar.block_name,"compress_error",0.0);
+        if (opar.compress_error < 0.0) {
+          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "compress_error=" << opar.compress_error << " in output "
+              << "block '" << opar.block_name << "' must be non-negative" << std::endl;
+          exit(EXIT_FAILURE);
+        }
+      }
+
       // NEW_OUTPUT_TYPES: Add block to construct new types here
       BaseTypeOutput *pnode;
       if (opar.file_type.compare("tab") == 0) {
@@ -236,6 +321,14 @@ Outputs::Outputs(ParameterInput *pin, Mesh *pm) {
         pnode = new MeshVTKOutput(pin,pm,opar);
         pout_list.insert(pout_list.begin(),pnode);
       } else if (opar.file_type.compare("pvtk") == 0) {
+        // sub-sample particles by tag, so the same particles are output every time
+        opar.prtcl_stride = pin->GetOrAddInteger(opar.block_name,"prtcl_stride",1);
+        if (opar.prtcl_stride < 1) {
+          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "prtcl_stride=" << opar.prtcl_stride << " in output block '"
+              << opar.block_name << "' must be >= 1" << std::endl;
+          exit(EXIT_FAILURE);
+        }
         pnode = new ParticleVTKOutput(pin,pm,opar);
         pout_list.insert(pout_list.begin(),pnode);
       } else if (opar.file_type.compare("trk") == 0) {
@@ -245,6 +338,9 @@ Outputs::Outputs(ParameterInput *pin, Mesh *pm) {
         opar.coarsen_factor = pin->GetInteger(opar.block_name,"coarsen_factor");
         opar.compute_moments = pin->GetOrAddBoolean(opar.block_name,
           "compute_moments", false);
+        opar.compute_minmax = pin->GetOrAddBoolean(opar.block_name,
+          "compute_minmax", false);
+        opar.mass_weighted = pin->GetOrAddBoolean(opar.block_name,"mass_weighted",false);
         pnode = new CoarsenedBinaryOutput(pin,pm,opar);
         pout_list.insert(pout_list.begin(),pnode);
       } else if (opar.file_type.compare("pdf") == 0) {
@@ -269,12 +365,41 @@ Outputs::Outputs(ParameterInput *pin, Mesh *pm) {
         }
         pnode = new PDFOutput(pin,pm,opar);
         pout_list.insert(pout_list.begin(),pnode);
+      } else if (opar.file_type.compare("ugrid") == 0) {
+        pnode = new UniformGridOutput(pin,pm,opar);
+        pout_list.insert(pout_list.begin(),pnode);
       } else if (opar.file_type.compare("bin") == 0) {
         pnode = new MeshBinaryOutput(pin,pm,opar);
         pout_list.insert(pout_list.begin(),pnode);
+      } else if (opar.file_type.compare("hdf5") == 0) {
+        pnode = new MeshHDF5Output(pin,pm,opar);
+        pout_list.insert(pout_list.begin(),pnode);
+      } else if (opar.file_type.compare("ascent") == 0) {
+        pnode = new AscentOutput(pin,pm,opar);
+        pout_list.insert(pout_list.begin(),pnode);
       } else if (opar.file_type.compare("rst") == 0) {
       // Add restarts to the tail end of BaseTypeOutput list, so file counters for other
       // output types are up-to-date in restart file
+        // with async_write=true the data are written with non-blocking MPI-IO while the
+        // calculation continues; the next restart waits for the previous one to finish
+        opar.async_write = pin->GetOrAddBoolean(opar.block_name, "async_write", false);
+        // with delta_every > 1, only every delta_every-th restart file contains the full
+        // data, the others store differences to it (see restart_delta.hpp)
+        opar.delta_every = pin->GetOrAddInteger(opar.block_name, "delta_every", 0);
+        // with fs_every > 1, only every fs_every-th restart file contains the data, the
+        // others keep it in node-local storage (see restart_local.hpp)
+        opar.fs_every = pin->GetOrAddInteger(opar.block_name, "fs_every", 0);
+        if (opar.fs_every > 1) {
+          opar.local_dir = pin->GetString(opar.block_name, "local_dir");
+        }
+        // with skip_derived=true, arrays that are regenerated after a restart are not
+        // stored, and the arrays listed in float_fields (rad, force) are stored in
+        // single precision (see RestartOutput constructor)
+        opar.skip_derived = pin->GetOrAddBoolean(opar.block_name, "skip_derived", false);
+        opar.float_fields = pin->GetOrAddString(opar.block_name, "float_fields", "none");
+        // with device_io = staged or direct, MeshBlock data are written from device
+        // arrays without host copies of all arrays (see RestartOutput::WriteDeviceData)
+        opar.device_io = pin->GetOrAddString(opar.block_name, "device_io", "none");
         pnode = new RestartOutput(pin,pm,opar);
         pout_list.push_back(pnode);
         num_rst++;
@@ -294,6 +419,14 @@ Outputs::Outputs(ParameterInput *pin, Mesh *pm) {
               << "input file" << std::endl;
     exit(EXIT_FAILURE);
   }
+
+  // optionally share derived variables between outputs, so each is stored only once and
+  // computed only once per cycle when several outputs of it are made in the same cycle
+  if (pin->GetOrAddBoolean("job", "share_derived_outputs", false)) {
+    for (BaseTypeOutput* pnode : pout_list) {
+      pnode->pdv_cache = &dv_cache;
+    }
+  }
 }
 
 //----------------------------------------------------------------------------------------
@@ -8,20 +8,25 @@
 //! \file outputs.hpp
 //  \brief provides classes to handle ALL types of data output
 
+#include <map>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Kokkos_ScatterView.hpp"
 
 #include "athena.hpp"
 #include "io_wrapper.hpp"
+#include "restart_delta.hpp"
+#include "restart_local.hpp"
 
 #define NHISTORY_VARIABLES 12
 #if NHISTORY_VARIABLES > NREDUCTION_VARIABLES
     #error NHISTORY > NREDUCTION in outputs.hpp
 #endif
 
-#define NOUTPUT_CHOICES 152
+#define NOUTPUT_CHOICES 153
 // choices for output variables used in <ouput> blocks in input file
 // TO ADD MORE CHOICES:
 //   - add more strings to array below, change NOUTPUT_CHOICES above appropriately
@@ -96,12 +101,16 @@ static const char *var_choice[NOUTPUT_CHOICES] = {
   "tmunu",
 
   // Particles (150-151)
-  "prtcl_all", "prtcl_d"
+  "prtcl_all", "prtcl_d",
+
+  // per-cell C2P statistics, with <mhd>/c2p_stats = true (152)
+  "mhd_c2p"
 };
 
 
 // forward declarations
 class Mesh;
+class MeshBlockPack;
 class ParameterInput;
 
 //----------------------------------------------------------------------------------------
@@ -118,11 +127,19 @@ struct OutputParameters {
   std::string file_basename;
   std::string file_type;
   std::string file_id;
+  std::string file_path;      // if set, full name of a single file (e.g. IC cache)
   std::string variable;
   bool include_gzs;
   int gid;
   bool slice1, slice2, slice3;
   Real slice_x1, slice_x2, slice_x3;
+  // region of interest: only MBs intersecting box and/or sphere, and with level (above
+  // root level) in [min_level,max_level] are output (-1 = no limit)
+  bool region_box=false;
+  Real region_min[3], region_max[3];   // box (logical coordinates)
+  Real region_radius=0.0;              // sphere (physical coordinates), off if zero
+  Real region_center[3];
+  int min_level=-1, max_level=-1;
   bool user_hist_only;
   std::string data_format;
   bool contains_derived=false;
@@ -132,6 +149,7 @@ struct OutputParameters {
   int coarsen_factor;
   bool compute_moments; // if true then will compute
   // <q>, <q^2>, <q^3>, <q^4> for each variable q
+  bool compute_minmax=false; // if true also output min/max of q over each coarse cell
   // DBF parameters for PDF:
   // number of derived variables, index of current derived variable
   int n_derived=0, i_derived=0;
@@ -141,6 +159,22 @@ struct OutputParameters {
   int nbin=0, nbin2=0;
   bool logscale=true, logscale2=true;
   bool mass_weighted=false;
+  bool async_write=false;       // if true, data are written with non-blocking MPI-IO
+  int delta_every=0;            // restarts per full restart (others are delta files)
+  int fs_every=0;               // restarts per restart with data on filesystem
+  std::string local_dir;        // node-local directory for data of other restarts
+  bool skip_derived=false;      // omit arrays of restarts that can be regenerated
+  std::string float_fields;     // arrays of restarts stored in single precision
+  std::string device_io="none"; // restart data written from device (staged, direct)
+  int io_aggregators=0;         // ranks per node that write data gathered on node
+  int io_stripe_size=0;         // file system stripe size (bytes) passed to MPI-IO
+  Real compress_error=0.0;      // abs. error bound of lossy bin/cbin data (0 = none)
+  int prtcl_stride=1;           // only particles with tag%prtcl_stride==0 are output
+  // triggers of outputs by events (disabled if zero/false)
+  Real trigger_dmax=0.0;        // relative change of maximum density since last output
+  bool trigger_new_level=false; // creation of a finer AMR level than at last output
+  Real trigger_separation=0.0;  // separation of first two compact object trackers
+  int trigger_dcycle=1;         // cycles between checks of triggers
 };
 
 //----------------------------------------------------------------------------------------
@@ -197,6 +231,18 @@ struct TrackedParticleData {
   Real vx,vy,vz;
 };
 
+//----------------------------------------------------------------------------------------
+//! \struct DerivedVarCacheEntry
+//! \brief array of a derived variable shared by all outputs of it (enabled with
+//! <job>/share_derived_outputs), and whether it holds values in all cells in ncycle
+
+struct DerivedVarCacheEntry {
+  DvceArray5D<Real> var;
+  int ncycle = -1;
+  bool all_cells = false;
+};
+using DerivedVarCache = std::map<std::string, DerivedVarCacheEntry>;
+
 //----------------------------------------------------------------------------------------
 // \brief abstract base class for different output types (modes/formats); node in
 //        std::list of BaseTypeOutput created & stored in the Outputs class
@@ -215,13 +261,25 @@ class BaseTypeOutput {
   // data
   OutputParameters out_params;   // params read from <output> block for this type
   DvceArray5D<Real> derived_var; // array to store output variables computed from u0/b0
+  DerivedVarCache *pdv_cache = nullptr;  // derived variables shared with other outputs
 
-  // function which computes derived output variables like vorticity and current density
-  void ComputeDerivedVariable(std::string name, Mesh *pm);
+  // function which computes derived output variables like vorticity and current density,
+  // optionally only in the cells given by outmbs/outmb_indcs (e.g. for slices)
+  void ComputeDerivedVariable(std::string name, Mesh *pm,
+                              bool output_cells_only=false);
+  // function which computes ADM variables/constraints in output (if not up to date)
+  void UpdateZ4cOutputVariables(Mesh *pm);
 
   // virtual functions may be over-ridden in derived classes
   virtual void LoadOutputData(Mesh *pm);
   virtual void WriteOutputFile(Mesh *pm, ParameterInput *pin) = 0;
+  // completes writes still in flight (for outputs written asynchronously)
+  virtual void FinishOutputFile() {}
+  // functions to check triggers of output by events, and to record state at output
+  bool Triggered(Mesh *pm);
+  void ResetTriggers(Mesh *pm);
+  // returns true if MeshBlock m is within region of interest and range of levels
+  bool InOutputRegion(Mesh *pm, int m);
 
   // Functions to detect big endian machine, and to byte-swap 32-bit words.  The vtk
   // legacy format requires data to be stored as big-endian.
@@ -239,11 +297,16 @@ class BaseTypeOutput {
  protected:
   // CC output data on host with dims (n,m,k,j,i) except
   // for restarts, where dims are (m,n,k,j,i)
-  HostArray5D<Real> outarray;
+  HostPinnedArray5D<Real> outarray;
+  DvceArray5D<Real> d_outarray;   // device staging buffer, same dims as outarray
+  DualArray2D<int> outmb_indcs;   // (mbi, ois, ojs, oks) of each output MB
   HostArray5D<Real> outarray_hyd, outarray_mhd, outarray_rad,
                     outarray_force, outarray_z4c, outarray_adm;
   HostFaceFld4D<Real> outfield;  // FC output field on host
   std::vector<int> noutmbs;   // with MPI, number of output MBs across all ranks
+  Real trigger_dens_=-1.0;    // maximum density at last output (<0 if not yet known)
+  int trigger_level_=-1;      // finest level of Mesh at last output
+  bool trigger_merged_=false; // output triggered by separation of trackers already made
   int noutmbs_min;            // with MPI, minimum number of output MBs across all ranks
   int noutmbs_max;            // with MPI, maximum number of output MBs across all ranks
 
@@ -278,12 +341,31 @@ class HistoryOutput : public BaseTypeOutput {
   std::vector<HistoryData> hist_data;
 
   void LoadOutputData(Mesh *pm) override;
-  void LoadHydroHistoryData(HistoryData *pdata, Mesh *pm);
-  void LoadMHDHistoryData(HistoryData *pdata, Mesh *pm);
-  void LoadZ4cHistoryData(HistoryData *pdata, Mesh *pm);
+  void SetHistoryLabels(HistoryData *pdata, Mesh *pm);
+  void LoadPhysicsHistoryData(Mesh *pm);
   void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
+  void FinishOutputFile() override;
+ private:
+  // history data of all physics are summed over ranks with one non-blocking reduction,
+  // which is completed (and the data written) at the next history output
+  bool hist_pending;
+  Real hist_time, hist_dt;                  // time, dt of data being reduced
+  std::vector<Real> hist_sendbuf, hist_recvbuf;
+#if MPI_PARALLEL_ENABLED
+  MPI_Request hist_req;
+#endif
 };
 
+//----------------------------------------------------------------------------------------
+// error-bounded lossy compression of the MeshBlock data of (coarsened) binary outputs,
+// and parallel write of the resulting variable-size blocks (implemented in binary.cpp)
+
+void CompressBinaryData(const char *data, int nmbs, std::size_t data_size,
+                        std::size_t hdr_size, int nvars, int cells, Real abs_err,
+                        std::vector<char> &cdata);
+void WriteCompressedData(IOWrapper &file, std::size_t header_offset,
+                         const std::vector<char> &cdata);
+
 //----------------------------------------------------------------------------------------
 //! \class CoarsenedBinaryOutput
 //  \brief derived BaseTypeOutput class for coarsened binary grid data
@@ -292,9 +374,6 @@ class CoarsenedBinaryOutput : public BaseTypeOutput {
  public:
   CoarsenedBinaryOutput(ParameterInput *pin, Mesh *pm, OutputParameters oparams);
 
-  // void CoarsenVariable(const DvceArray3D<Real>& full_data,
-  //                            DvceArray3D<Real>& coarsen_data,
-  //                            const int coarsen_factor);
   void LoadOutputData(Mesh *pm) override;
   void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
 };
@@ -316,6 +395,9 @@ struct PDFData {
 
   DvceArray2D<Real> result_; // resulting histogram
   Kokkos::Experimental::ScatterView<Real **, LayoutWrapper> scatter_result;
+#if MPI_PARALLEL_ENABLED
+  MPI_Request reduce_req = MPI_REQUEST_NULL;  // reduction over ranks, waited on in Write
+#endif
 
   PDFData(int dim, int nbinVal, int nbin2Val)
     : pdf_dimension(dim), nbin(nbinVal), nbin2(nbin2Val),
@@ -359,9 +441,28 @@ class ParticleVTKOutput : public BaseTypeOutput {
   void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
  protected:
   int npout_thisrank;
+  int npout_offset;                // # of particles output on lower ranks
   int npout_total;
-  HostArray2D<Real> outpart_rdata;
-  HostArray2D<int>  outpart_idata;
+  HostArray1D<float> outpart_data; // positions, then integer data, of output particles
+};
+
+//----------------------------------------------------------------------------------------
+//! \class UniformGridOutput
+//  \brief derived BaseTypeOutput class for data interpolated (on the device) to a uniform
+//  Cartesian grid and written in VTK (legacy) format
+
+class UniformGridOutput : public BaseTypeOutput {
+ public:
+  UniformGridOutput(ParameterInput *pin, Mesh *pm, OutputParameters oparams);
+  void LoadOutputData(Mesh *pm) override;
+  void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
+ private:
+  int nx[3];                // number of cells of uniform grid in each direction
+  Real xmin[3], dx[3];      // minimum (physical) coordinates and spacing of grid
+  DualArray2D<int> boxes;   // (mbi,is,js,ks,ni,nj,nk,offset) of grid cells in each MB
+  int nboxes=0, nboxes_min=0, nboxes_max=0;
+  DvceArray2D<Real> d_vals; // interpolated values (n,cell) in all boxes on this rank
+  HostArray2D<Real> vals;
 };
 
 //----------------------------------------------------------------------------------------
@@ -373,6 +474,43 @@ class MeshBinaryOutput : public BaseTypeOutput {
   void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
 };
 
+//----------------------------------------------------------------------------------------
+//! \class MeshHDF5Output
+//  \brief derived BaseTypeOutput class for mesh data in (parallel) HDF5 athdf format
+class MeshHDF5Output : public BaseTypeOutput {
+ public:
+  MeshHDF5Output(ParameterInput *pin, Mesh *pm, OutputParameters oparams);
+  void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
+ private:
+  int compression_level;    // deflate level (0 for no compression)
+};
+
+//----------------------------------------------------------------------------------------
+//! \class AscentOutput
+//  \brief derived BaseTypeOutput class for in-situ visualization with Ascent, which is
+//  passed device arrays directly
+class AscentOutput : public BaseTypeOutput {
+ public:
+  AscentOutput(ParameterInput *pin, Mesh *pm, OutputParameters oparams);
+  ~AscentOutput() override;
+  void LoadOutputData(Mesh *pm) override;
+  void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
+ private:
+  struct AscentState;
+  std::unique_ptr<AscentState> pstate;
+};
+
+//----------------------------------------------------------------------------------------
+//! \struct RestartLayout
+//  \brief arrays omitted from, or stored in single precision in, restart files.  Stored
+//  in <restart_layout> of the input parameters in each restart file, read on restart.
+
+struct RestartLayout {
+  bool skip_force=false;    // turbulent force omitted (regenerated if tcorr=0)
+  bool float_rad=false;     // radiation intensities stored as float
+  bool float_force=false;   // turbulent force stored as float
+};
+
 //----------------------------------------------------------------------------------------
 //! \class RestartOutput
 //  \brief derived BaseTypeOutput class for restarts
@@ -382,6 +520,42 @@ class RestartOutput : public BaseTypeOutput {
   RestartOutput(ParameterInput *pin, Mesh *pm, OutputParameters oparams);
   void LoadOutputData(Mesh *pm) override;
   void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
+  void FinishOutputFile() override;
+  // (pointer, size per MeshBlock) of device arrays of evolved variables in restarts
+  static void StateArrays(MeshBlockPack *pmbp,
+                          std::vector<std::pair<Real*, std::size_t>> &arrays);
+  // layout of restart file whose input parameters are in pin
+  static RestartLayout ReadLayout(ParameterInput *pin);
+  // bytes per MeshBlock of an array of n elements, padded to a multiple of sizeof(Real)
+  static IOWrapperSizeT ArrayBytes(IOWrapperSizeT n, bool single) {
+    IOWrapperSizeT nbytes = n*((single)? sizeof(float) : sizeof(Real));
+    return ((nbytes + sizeof(Real) - 1)/sizeof(Real))*sizeof(Real);
+  }
+ private:
+  IOWrapper resfile;        // kept open while non-blocking writes are in flight
+  bool write_pending;
+  RestartLayout layout;
+  HostArray5D<float> outarray_rad32, outarray_force32;  // arrays stored as float
+  // data for delta restart files (written instead of delta_every-1 of every delta_every
+  // restart files), which store differences to the last full (base) restart file
+  int ndelta;                             // delta files written since base file
+  std::string base_fname;                 // name of base file
+  IOWrapperSizeT base_offset;             // offset of MeshBlock data in base file
+  std::vector<char> base_data;            // MeshBlock data of this rank in base file
+  std::vector<std::uint64_t> base_hash;   // hash of each MeshBlock in base file
+  std::vector<char> base_lloc;            // LogicalLocations of MeshBlocks in base file
+  std::vector<int> base_gids;             // starting gid of each rank in base file
+  std::vector<char> delta_buf;            // data written to delta file by this rank
+  std::vector<restart_delta::IndexEntry> delta_index;
+  // data for restart files with data in node-local storage (written instead of
+  // fs_every-1 of every fs_every restart files)
+  int nlocal;                             // local restarts written since last full one
+  std::string fs_fname;                   // name of last full restart file
+  std::vector<std::string> local_stems;   // names of local data still kept
+  std::vector<int> partner;               // rank storing copy of data of each rank
+  void PackData(Mesh *pm, IOWrapperSizeT data_size, std::vector<char> &data);
+  void WriteDeltaData(Mesh *pm, IOWrapperSizeT offset, IOWrapperSizeT data_size);
+  void WriteDeviceData(Mesh *pm, IOWrapperSizeT offset, IOWrapperSizeT data_size);
 };
 
 //----------------------------------------------------------------------------------------
@@ -411,11 +585,9 @@ class TrackedParticleOutput : public BaseTypeOutput {
   void WriteOutputFile(Mesh *pm, ParameterInput *pin) override;
  protected:
   int ntrack;           // total number of tracked particles across all ranks
-  int ntrack_thisrank;  // number of tracked particles this rank (guess)
   int npout;            // number of tracked particles to be written this rank
   bool header_written;
-  std::vector<int> npout_eachrank;
-  HostArray1D<TrackedParticleData> outpart;
+  HostArray1D<TrackedParticleData> outpart;  // sorted by tag
 };
 
 //----------------------------------------------------------------------------------------
@@ -430,6 +602,7 @@ class Outputs {
 
   // use vector of pointers to BaseTypeOutputs since it is an abstract base class
   std::vector<BaseTypeOutput*> pout_list;
+  DerivedVarCache dv_cache;  // derived variables shared by outputs in pout_list
 };
 
 #endif // OUTPUTS_OUTPUTS_HPP_
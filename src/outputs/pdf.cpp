@@ -39,6 +39,25 @@
 // ScatterView is not part of Kokkos core interface
 #include "Kokkos_ScatterView.hpp"
 
+namespace {
+// histograms with at most this many bytes are accumulated in team scratch memory
+constexpr std::size_t pdf_scratch_bytes = 16384;
+
+//----------------------------------------------------------------------------------------
+//! \fn int PDFBin()
+//  \brief index of bin containing x, with 0 and nbin+1 used for values below/above the
+//  range of the bins
+
+KOKKOS_INLINE_FUNCTION
+int PDFBin(const Real x, const Real bin0, const Real binn, const int nbin,
+           const Real step, const bool logscale) {
+  if (x < bin0) return 0;
+  if (x >= binn) return nbin + 1;
+  if (logscale) return static_cast<int>(std::log10(x / bin0) / step) + 1;
+  return static_cast<int>((x - bin0) / step) + 1;
+}
+} // namespace
+
 
 //----------------------------------------------------------------------------------------
 // Constructor: also calls BaseTypeOutput base class constructor
@@ -168,6 +187,7 @@ void PDFOutput::LoadOutputData(Mesh *pm) {
     ComputeDerivedVariable(out_params.variable, pm);
     ComputeDerivedVariable(out_params.variable_2, pm);
   }
+  UpdateZ4cOutputVariables(pm);
 
   // Pointer for initial determination
   DvceArray5D<Real> *u0_ptr = nullptr;
@@ -203,102 +223,106 @@ void PDFOutput::LoadOutputData(Mesh *pm) {
   auto scatter = pdf_data.scatter_result;
 
   int nmb = pm->pmb_pack->nmb_thispack;
-  int nx1 = indcs.nx1 + 2*indcs.ng;
-  int nx2 = indcs.nx2 + 2*indcs.ng;
-  int nx3 = indcs.nx3 + 2*indcs.ng;
-
-  // Copy MeshBlock data from host to device
-  DvceArray5D<Real> outvars_device("outvars_device", outvars.size(), nmb, nx3, nx2, nx1);
-  for (std::size_t i = 0; i < outvars.size(); ++i) {
-      auto d_slice = Kokkos::subview(*(outvars[i].data_ptr),
-      Kokkos::ALL(), outvars[i].data_index, Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL());
-      auto d_target_slice = Kokkos::subview(outvars_device, i,
-      Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL());
-      Kokkos::deep_copy(d_target_slice, d_slice);
-  }
-  Kokkos::fence();
 
-  //
-
-  // Reset ScatterView from previous output
-  scatter.reset();
-  // Also reset the histogram from previous call.
-  // Currently still required for consistent results between host and device backends, see
-  // https://github.com/kokkos/kokkos/issues/6363
-  Kokkos::deep_copy(result, 0);
-  Kokkos::fence();
+  // variables are read directly from the arrays in which they are stored
+  auto var1 = *(outvars[0].data_ptr);
+  int n_var1 = outvars[0].data_index;
+  auto var2 = *(outvars[(outvars.size() > 1)? 1 : 0].data_ptr);
+  int n_var2 = (outvars.size() > 1)? outvars[1].data_index : n_var1;
 
   // Capture the necessary data from pdf_data
-  auto bins = pdf_data.bins;
-  auto bins2 = pdf_data.bins2;
-  auto step_size = pdf_data.step_size;
-  auto step_size2 = pdf_data.step_size2;
   auto nbin_ = pdf_data.nbin;
   auto nbin2_ = pdf_data.nbin2;
   int pdf_dimension = pdf_data.pdf_dimension;
   bool logscale = pdf_data.logscale;
   bool logscale2 = pdf_data.logscale2;
   bool mass_weighted = pdf_data.mass_weighted;
+  Real step_size = pdf_data.step_size;
+  Real step_size2 = pdf_data.step_size2;
+  // edges of bins are needed in kernels, copy once to host to pass by value
+  auto bins_h = Kokkos::create_mirror_view_and_copy(HostMemSpace(), pdf_data.bins);
+  Real bin0 = bins_h(0), binn = bins_h(nbin_);
+  Real bin20 = 0.0, bin2n = 0.0;
+  if (pdf_dimension == 2) {
+    auto bins2_h = Kokkos::create_mirror_view_and_copy(HostMemSpace(), pdf_data.bins2);
+    bin20 = bins2_h(0);
+    bin2n = bins2_h(nbin2_);
+  }
 
-  par_for("pdf", DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
-  KOKKOS_LAMBDA(int m, int k, int j, int i) {
-    auto &x_val = outvars_device(0, m, k, j, i);
-    int x_bin = -1;
-    // First handle edge cases explicitly
-    if (x_val < bins(0)) {
-      x_bin = 0;
-    } else if (x_val >= bins(nbin_)) {
-      x_bin = nbin_ + 1;
-    } else {
-      if (logscale == false) {
-        x_bin = static_cast<int>((x_val - bins(0)) / step_size) + 1;
-      } else if (logscale == true) {
-        x_bin = static_cast<int>(std::log10(x_val / bins(0)) / step_size) + 1;
-      }
-    }
-    // needs to be zero as for the 1D histogram we need 0 as first index of the 2D
-    // result array
-    int y_bin = 0;
-    if (pdf_dimension == 2) {
-      auto &y_val = outvars_device(1, m, k, j, i);
-
-      y_bin = -1; // reset to impossible value
-      // First handle edge cases explicitly
-      if (y_val < bins2(0)) {
-        y_bin = 0;
-      } else if (y_val >= bins2(nbin2_)) {
-        y_bin = nbin2_ + 1;
-      } else {
-        // for lin and log directly pick index
-        if (logscale2 == false) {
-          y_bin = static_cast<int>((y_val - bins2(0)) / step_size2) + 1;
-        } else if (logscale2 == true) {
-          y_bin = static_cast<int>(std::log10(y_val/bins2(0)) / step_size2) + 1;
+#if MPI_PARALLEL_ENABLED
+  // result of previous output must have been reduced before it is overwritten
+  MPI_Wait(&(pdf_data.reduce_req), MPI_STATUS_IGNORE);
+#endif
+  Kokkos::deep_copy(result, 0);
+  const int ncol = result.extent_int(1);
+  const int nhist = result.extent_int(0)*ncol;
+  std::size_t scr_size = ScrArray1D<Real>::shmem_size(nhist);
+
+  if (scr_size <= pdf_scratch_bytes) {
+    // Accumulate histogram of each (m,k) plane in team scratch memory, so atomics are
+    // made in fast memory, then merge non-empty bins into result once per team
+    int nj = je - js + 1, ni = ie - is + 1;
+    par_for_outer("pdf_team", DevExeSpace(), scr_size, 0, 0, (nmb-1), ks, ke,
+    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k) {
+      ScrArray1D<Real> hist(member.team_scratch(0), nhist);
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(member, nhist), [&](const int n) {
+        hist(n) = 0.0;
+      });
+      member.team_barrier();
+      Real vol = size.d_view(m).dx1*size.d_view(m).dx2*size.d_view(m).dx3;
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(member, nj*ni), [&](const int idx) {
+        int j = js + idx/ni;
+        int i = is + idx%ni;
+        int x_bin = PDFBin(var1(m,n_var1,k,j,i), bin0, binn, nbin_, step_size,
+                           logscale);
+        int y_bin = 0;
+        if (pdf_dimension == 2) {
+          y_bin = PDFBin(var2(m,n_var2,k,j,i), bin20, bin2n, nbin2_, step_size2,
+                         logscale2);
         }
+        Real weight = (mass_weighted)? vol*u0_(m,IDN,k,j,i) : vol;
+        Kokkos::atomic_add(&hist(y_bin*ncol + x_bin), weight);
+      });
+      member.team_barrier();
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(member, nhist), [&](const int n) {
+        if (hist(n) != 0.0) {Kokkos::atomic_add(&result(n/ncol, n%ncol), hist(n));}
+      });
+    });
+  } else {
+    // histograms too large for scratch memory use a ScatterView
+    scatter.reset();
+    par_for("pdf", DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
+    KOKKOS_LAMBDA(int m, int k, int j, int i) {
+      int x_bin = PDFBin(var1(m,n_var1,k,j,i), bin0, binn, nbin_, step_size, logscale);
+      // needs to be zero as for the 1D histogram we need 0 as first index of the 2D
+      // result array
+      int y_bin = 0;
+      if (pdf_dimension == 2) {
+        y_bin = PDFBin(var2(m,n_var2,k,j,i), bin20, bin2n, nbin2_, step_size2,
+                       logscale2);
       }
-    }
-    auto res = scatter.access();
-    Real weight = size.d_view(m).dx1*size.d_view(m).dx2*size.d_view(m).dx3;
-    weight *= mass_weighted == false
-              ? 1.0
-              : u0_(m, IDN, k, j, i);
-    res(y_bin, x_bin) += weight;
-  });
-
-  // "reduce" results from scatter view to original view.
-  // May be a no-op depending on backend.
-  Kokkos::Experimental::contribute(result, scatter); //.KokkosView()
-  // Kokkos::Experimental::contribute(result.KokkosView(), scatter);
-  Kokkos::fence(); // May not be required
-
-  // Now reduce over ranks
+      auto res = scatter.access();
+      Real weight = size.d_view(m).dx1*size.d_view(m).dx2*size.d_view(m).dx3;
+      weight *= mass_weighted == false
+                ? 1.0
+                : u0_(m, IDN, k, j, i);
+      res(y_bin, x_bin) += weight;
+    });
+
+    // "reduce" results from scatter view to original view.
+    // May be a no-op depending on backend.
+    Kokkos::Experimental::contribute(result, scatter);
+  }
+  Kokkos::fence();
+
+  // Now start reduction over ranks, which is completed in WriteOutputFile()
 #if MPI_PARALLEL_ENABLED
   if (global_variable::my_rank == 0) {
-    MPI_Reduce(MPI_IN_PLACE, result.data(), result.size(),
-                                   MPI_ATHENA_REAL, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Ireduce(MPI_IN_PLACE, result.data(), result.size(), MPI_ATHENA_REAL, MPI_SUM, 0,
+                global_variable::mpi_comm, &(pdf_data.reduce_req));
   } else {
-    MPI_Reduce(result.data(), result.data(), result.size(),
-                                   MPI_ATHENA_REAL, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Ireduce(result.data(), result.data(), result.size(), MPI_ATHENA_REAL, MPI_SUM, 0,
+                global_variable::mpi_comm, &(pdf_data.reduce_req));
   }
 #endif
 }
@@ -387,6 +411,10 @@ void PDFOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
       exit(EXIT_FAILURE);
     }
 
+#if MPI_PARALLEL_ENABLED
+    // complete reduction over ranks started in LoadOutputData()
+    MPI_Wait(&(pdf_data.reduce_req), MPI_STATUS_IGNORE);
+#endif
     // Create a host mirror of the pdf_data.result_ array
     auto result_host = Kokkos::create_mirror_view(pdf_data.result_);
 
@@ -407,6 +435,9 @@ void PDFOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
     std::fprintf(pfile,"\n"); // terminate line
     std::fclose(pfile);
   }
+#if MPI_PARALLEL_ENABLED
+  MPI_Wait(&(pdf_data.reduce_req), MPI_STATUS_IGNORE);
+#endif
 
   // increment counters
   out_params.file_number++; // By doing this I make a new file for each time.
@@ -11,11 +11,13 @@
 #include <algorithm>
 #include <cstdio>      // fwrite(), fclose(), fopen(), fnprintf(), snprintf()
 #include <cstdlib>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <string>
 #include <utility> // make_pair
+#include <vector>
 
 #include "athena.hpp"
 #include "coordinates/cell_locations.hpp"
@@ -35,9 +37,122 @@
 // ctor: also calls BaseTypeOutput base class constructor
 
 RestartOutput::RestartOutput(ParameterInput *pin, Mesh *pm, OutputParameters op) :
-  BaseTypeOutput(pin, pm, op) {
+  BaseTypeOutput(pin, pm, op),
+  write_pending(false),
+  ndelta(0),
+  base_offset(0),
+  nlocal(0) {
   // create directories for outputs. Comments in binary.cpp constructor explain why
-  mkdir("rst",0775);
+  if (out_params.file_path.empty()) {mkdir("rst",0775);}
+  if (out_params.fs_every > 1) {
+    if (out_params.delta_every > 1) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "delta_every and fs_every cannot both be used in block '"
+                << out_params.block_name << "'" << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    mkdir(out_params.local_dir.c_str(),0775);
+    restart_local::Partners(partner);
+  }
+
+  // With skip_derived, the turbulent force is omitted for white-noise driving (tcorr=0),
+  // since it is then regenerated from the random state in every cycle.  Arrays listed in
+  // float_fields are stored in single precision (lossy).
+  TurbulenceDriver *pturb = pm->pmb_pack->pturb;
+  layout.skip_force = out_params.skip_derived && (pturb != nullptr) &&
+                      (pturb->tcorr <= 1e-6);
+  if (out_params.float_fields.compare("none") != 0) {
+    std::stringstream fields(out_params.float_fields);
+    std::string field;
+    while (std::getline(fields, field, ',')) {
+      if (field.compare("rad") == 0) {
+        layout.float_rad = true;
+      } else if (field.compare("force") == 0) {
+        layout.float_force = true;
+      } else {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "float_fields in block '" << out_params.block_name
+                  << "' can only contain rad and force" << std::endl;
+        exit(EXIT_FAILURE);
+      }
+    }
+  }
+
+  // with device_io, data are copied from device arrays one MeshBlock at a time, so they
+  // cannot be kept on the host for non-blocking writes or differences to a base file
+  if (out_params.device_io.compare("none") != 0) {
+    bool direct = (out_params.device_io.compare("direct") == 0);
+    if (!(direct) && out_params.device_io.compare("staged") != 0) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "device_io = '" << out_params.device_io << "' in block '"
+                << out_params.block_name << "' must be none, staged, or direct"
+                << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    if (out_params.async_write || out_params.delta_every > 1 ||
+        out_params.fs_every > 1) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "device_io in block '" << out_params.block_name
+                << "' cannot be used with async_write, delta_every, or fs_every"
+                << std::endl;
+      exit(EXIT_FAILURE);
+    }
+#if MPI_PARALLEL_ENABLED
+    bool mpiio = true;
+#else
+    bool mpiio = false;
+#endif
+    if (direct && (!(mpiio) || out_params.io_aggregators > 0)) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "device_io = direct in block '" << out_params.block_name
+                << "' requires MPI-IO without io_aggregators" << std::endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn RestartLayout RestartOutput::ReadLayout()
+//! \brief Returns the layout of the restart file whose input parameters are in pin.
+//! Files without <restart_layout> store all arrays in full precision.
+
+RestartLayout RestartOutput::ReadLayout(ParameterInput *pin) {
+  RestartLayout rst_layout;
+  if (pin->DoesBlockExist("restart_layout")) {
+    rst_layout.skip_force = pin->GetBoolean("restart_layout", "skip_force");
+    rst_layout.float_rad = pin->GetBoolean("restart_layout", "float_rad");
+    rst_layout.float_force = pin->GetBoolean("restart_layout", "float_force");
+  }
+  return rst_layout;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void RestartOutput::StateArrays()
+//! \brief Returns (pointer, number of elements per MeshBlock, including ghost zones) of
+//! every device array of evolved variables of the MeshBlockPack that is stored in restart
+//! files, so that other copies of the state (e.g. the in-memory checkpoints used to roll
+//! back after failures) contain the same fields.  Must be kept consistent with
+//! LoadOutputData().
+
+void RestartOutput::StateArrays(MeshBlockPack *pmbp,
+                                std::vector<std::pair<Real*, std::size_t>> &arrays) {
+  arrays.clear();
+  auto add = [&arrays](auto &a) {arrays.emplace_back(a.data(), a.size()/a.extent(0));};
+  if (pmbp->phydro != nullptr) {add(pmbp->phydro->u0);}
+  if (pmbp->pmhd != nullptr) {
+    add(pmbp->pmhd->u0);
+    add(pmbp->pmhd->b0.x1f);
+    add(pmbp->pmhd->b0.x2f);
+    add(pmbp->pmhd->b0.x3f);
+  }
+  if (pmbp->prad != nullptr) {add(pmbp->prad->i0);}
+  if (pmbp->pturb != nullptr) {add(pmbp->pturb->force);}
+  if (pmbp->pz4c != nullptr) {
+    add(pmbp->pz4c->u0);
+  } else if (pmbp->padm != nullptr) {
+    add(pmbp->padm->u_adm);
+  }
+  return;
 }
 
 //----------------------------------------------------------------------------------------
@@ -46,6 +161,9 @@ RestartOutput::RestartOutput(ParameterInput *pin, Mesh *pm, OutputParameters op)
 // variables, including ghost zones.
 
 void RestartOutput::LoadOutputData(Mesh *pm) {
+  // the previous restart file must be complete before its buffers are overwritten
+  FinishOutputFile();
+
   // get spatial dimensions of arrays, including ghost zones
   auto &indcs = pm->pmb_pack->pmesh->mb_indcs;
   int nout1 = indcs.nx1 + 2*(indcs.ng);
@@ -74,9 +192,20 @@ void RestartOutput::LoadOutputData(Mesh *pm) {
   }
   // if the spacetime is evolved, we do not need to checkpoint/recover the ADM variables
   if (prad != nullptr) {
-    nrad = prad->prgeo->nangles;
+    nrad = prad->nrad;
+  }
+
+  // calculate max/min number of MeshBlocks across all ranks
+  noutmbs_max = pm->nmb_eachrank[0];
+  noutmbs_min = pm->nmb_eachrank[0];
+  for (int i=0; i<(global_variable::nranks); ++i) {
+    noutmbs_max = std::max(noutmbs_max,pm->nmb_eachrank[i]);
+    noutmbs_min = std::min(noutmbs_min,pm->nmb_eachrank[i]);
   }
 
+  // with device_io, data are copied from the device arrays in WriteDeviceData()
+  if (out_params.device_io.compare("none") != 0) return;
+
   // Note for restarts, outarrays are dimensioned (m,n,k,j,i)
   if (phydro != nullptr) {
     Kokkos::realloc(outarray_hyd, nmb, nhydro, nout3, nout2, nout1);
@@ -97,15 +226,25 @@ void RestartOutput::LoadOutputData(Mesh *pm) {
     Kokkos::deep_copy(outfield.x3f, Kokkos::subview(pmhd->b0.x3f, std::make_pair(0,nmb),
                       Kokkos::ALL, Kokkos::ALL, Kokkos::ALL));
   }
+  // copies of arrays stored in single precision
+  auto to_float = [](HostArray5D<Real> &array, HostArray5D<float> &array32) {
+    Kokkos::realloc(array32, array.extent(0), array.extent(1), array.extent(2),
+                    array.extent(3), array.extent(4));
+    for (std::size_t n=0; n<array.size(); ++n) {
+      array32.data()[n] = static_cast<float>(array.data()[n]);
+    }
+  };
   if (prad != nullptr) {
     Kokkos::realloc(outarray_rad, nmb, nrad, nout3, nout2, nout1);
     Kokkos::deep_copy(outarray_rad, Kokkos::subview(prad->i0, std::make_pair(0,nmb),
                       Kokkos::ALL, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL));
+    if (layout.float_rad) {to_float(outarray_rad, outarray_rad32);}
   }
-  if (pturb != nullptr) {
+  if (pturb != nullptr && !(layout.skip_force)) {
     Kokkos::realloc(outarray_force, nmb, nforce, nout3, nout2, nout1);
     Kokkos::deep_copy(outarray_force, Kokkos::subview(pturb->force, std::make_pair(0,nmb),
                       Kokkos::ALL, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL));
+    if (layout.float_force) {to_float(outarray_force, outarray_force32);}
   }
   if (pz4c != nullptr) {
     Kokkos::realloc(outarray_z4c, nmb, nz4c, nout3, nout2, nout1);
@@ -116,14 +255,6 @@ void RestartOutput::LoadOutputData(Mesh *pm) {
     Kokkos::deep_copy(outarray_adm, Kokkos::subview(padm->u_adm, std::make_pair(0,nmb),
                       Kokkos::ALL, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL));
   }
-
-  // calculate max/min number of MeshBlocks across all ranks
-  noutmbs_max = pm->nmb_eachrank[0];
-  noutmbs_min = pm->nmb_eachrank[0];
-  for (int i=0; i<(global_variable::nranks); ++i) {
-    noutmbs_max = std::max(noutmbs_max,pm->nmb_eachrank[i]);
-    noutmbs_min = std::min(noutmbs_min,pm->nmb_eachrank[i]);
-  }
 }
 
 //----------------------------------------------------------------------------------------
@@ -150,7 +281,7 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
     nmhd = pmhd->nmhd + pmhd->nscalars;
   }
   if (prad != nullptr) {
-    nrad = prad->prgeo->nangles;
+    nrad = prad->nrad;
   }
   if (pz4c != nullptr) {
     nz4c = pz4c->nz4c;
@@ -177,8 +308,60 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
   } else {
     out_params.last_time += out_params.dt;
   }
-  pin->SetInteger(out_params.block_name, "file_number", out_params.file_number);
-  pin->SetReal(out_params.block_name, "last_time", out_params.last_time);
+  if (out_params.file_path.empty()) {
+    pin->SetInteger(out_params.block_name, "file_number", out_params.file_number);
+    pin->SetReal(out_params.block_name, "last_time", out_params.last_time);
+  } else {
+    fname = out_params.file_path;   // single file, not part of a series of restarts
+  }
+
+  // With delta_every > 1, only one of every delta_every restart files (the base file)
+  // contains the full data, the others store the differences to the last base file.  A
+  // new base file is written early if the mesh (or its distribution over ranks) changed.
+  // The name of the base file is stored in the input parameters of delta files.
+  bool write_delta = false;
+  if (out_params.delta_every > 1) {
+    const char *lloc = reinterpret_cast<const char*>(pm->lloc_eachmb);
+    std::size_t lloc_size = (pm->nmb_total)*sizeof(LogicalLocation);
+    write_delta = (ndelta < out_params.delta_every - 1) && !(base_fname.empty()) &&
+                  (base_lloc.size() == lloc_size) &&
+                  (std::memcmp(base_lloc.data(), lloc, lloc_size) == 0) &&
+                  std::equal(base_gids.begin(), base_gids.end(), pm->gids_eachrank);
+    if (write_delta) {
+      ndelta++;
+      pin->SetString(out_params.block_name, "delta_base", base_fname);
+      pin->SetString(out_params.block_name, "delta_offset", std::to_string(base_offset));
+    } else {
+      ndelta = 0;
+      pin->SetString(out_params.block_name, "delta_base", "none");
+      pin->SetString(out_params.block_name, "delta_offset", "0");
+    }
+  }
+
+  // With fs_every > 1, only one of every fs_every restart files contains the data.  The
+  // others contain only the header, and the data of each rank are written to local_dir
+  // (node-local storage) on its node and on the node of its partner rank.  The name of
+  // the last full restart file is stored, to restart from when local data are lost.
+  bool write_local = false;
+  std::string stem = out_params.file_basename + "." + number;
+  if (out_params.fs_every > 1) {
+    write_local = (nlocal < out_params.fs_every - 1) && !(fs_fname.empty());
+    if (write_local) {
+      nlocal++;
+      pin->SetString(out_params.block_name, "local_data", stem);
+      pin->SetString(out_params.block_name, "local_fallback", fs_fname);
+    } else {
+      nlocal = 0;
+      fs_fname = fname;
+      pin->SetString(out_params.block_name, "local_data", "none");
+      pin->SetString(out_params.block_name, "local_fallback", "none");
+    }
+  }
+
+  // layout of MeshBlock data in this file, read in the ProblemGenerator constructor
+  pin->SetBoolean("restart_layout", "skip_force", layout.skip_force);
+  pin->SetBoolean("restart_layout", "float_rad", layout.float_rad);
+  pin->SetBoolean("restart_layout", "float_force", layout.float_force);
 
   // create string holding input parameters (copy of input file)
   std::stringstream ost;
@@ -190,7 +373,7 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
   // variables are read in Mesh::BuildTreeFromRestart()
 
   // open file and  write the header; this part is serial
-  IOWrapper resfile;
+  resfile.SetAggregation(out_params.io_aggregators, out_params.io_stripe_size);
   resfile.Open(fname.c_str(), IOWrapper::FileMode::write);
   if (global_variable::my_rank == 0) {
     // output the input parameters (input file)
@@ -210,10 +393,19 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
   //--- STEP 2.  Root process writes list of logical locations and cost of MeshBlocks
   // This data read in Mesh::BuildTreeFromRestart()
 
+  // measured costs are only shared between ranks when needed
+  if (pm->pmr != nullptr) {pm->pmr->ShareMeasuredCosts();}
   if (global_variable::my_rank == 0) {
     resfile.Write_any_type(&(pm->lloc_eachmb[0]),(pm->nmb_total)*sizeof(LogicalLocation),
                            "byte");
     resfile.Write_any_type(&(pm->cost_eachmb[0]), (pm->nmb_total)*sizeof(float),"byte");
+    // partition of MeshBlocks over ranks, tagged so files without it can still be read.
+    // A restart on the same number of ranks reuses it (see BuildTreeFromRestart())
+    std::uint64_t tag = restart_partition_tag;
+    resfile.Write_any_type(&tag, sizeof(std::uint64_t), "byte");
+    resfile.Write_any_type(&(global_variable::nranks), sizeof(int), "byte");
+    resfile.Write_any_type(&(pm->gids_eachrank[0]), global_variable::nranks*sizeof(int),
+                           "byte");
   }
 
   //--- STEP 3.  Root process writes internal state of objects that require it
@@ -235,7 +427,10 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
   }
 
   //--- STEP 4.  All ranks write data over all MeshBlocks (5D arrays) in parallel
-  // This data read in ProblemGenerator constructor for restarts
+  // This data read in ProblemGenerator constructor for restarts.  With async_write the
+  // writes are non-blocking, and the file is only closed by the next restart output
+  // (or at the end of the run), so the time loop continues while data are written.
+  resfile.SetNonBlocking(out_params.async_write);
 
   // total size of all cell-centered variables and face-centered fields to be written by
   // this rank
@@ -250,10 +445,10 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
     data_size += nout1*nout2*(nout3+1)*sizeof(Real);    // mhd b0.x3f
   }
   if (prad != nullptr) {
-    data_size += nout1*nout2*nout3*nrad*sizeof(Real);   // radiation i0
+    data_size += ArrayBytes(nout1*nout2*nout3*nrad, layout.float_rad);     // rad i0
   }
-  if (pturb != nullptr) {
-    data_size += nout1*nout2*nout3*nforce*sizeof(Real); // forcing
+  if (pturb != nullptr && !(layout.skip_force)) {
+    data_size += ArrayBytes(nout1*nout2*nout3*nforce, layout.float_force); // forcing
   }
   if (pz4c != nullptr) {
     data_size += nout1*nout2*nout3*nz4c*sizeof(Real);   // z4c u0
@@ -268,10 +463,59 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
   IOWrapperSizeT step1size = sbuf.size()*sizeof(char) + 3*sizeof(int) + 2*sizeof(Real) +
                              sizeof(RegionSize) + 2*sizeof(RegionIndcs);
   IOWrapperSizeT step2size = (pm->nmb_total)*(sizeof(LogicalLocation) + sizeof(float));
+  step2size += sizeof(std::uint64_t) + (1 + global_variable::nranks)*sizeof(int);
 
   IOWrapperSizeT step3size = 3*nco*sizeof(Real);
   if (pz4c != nullptr) step3size += sizeof(Real);
   if (pturb != nullptr) step3size += sizeof(RNG_State);
+  IOWrapperSizeT data_offset = step1size + step2size + step3size + sizeof(IOWrapperSizeT);
+
+  // delta files store differences to the last base file, then are closed as below
+  if (write_delta) {
+    WriteDeltaData(pm, data_offset, data_size);
+    write_pending = true;
+    if (!(out_params.async_write)) {
+      FinishOutputFile();
+    }
+    return;
+  }
+  // data of local restarts are written to node-local files; those of the two newest
+  // local restarts are kept, in case a node is lost while writing the newer one
+  if (write_local) {
+    std::vector<char> data;
+    PackData(pm, data_size, data);
+    restart_local::WriteData(out_params.local_dir, stem, pm, data_size, data, partner);
+    local_stems.push_back(stem);
+    if (local_stems.size() > 2) {
+      restart_local::RemoveData(out_params.local_dir, local_stems.front(), partner);
+      local_stems.erase(local_stems.begin());
+    }
+    write_pending = true;
+    if (!(out_params.async_write)) {
+      FinishOutputFile();
+    }
+    return;
+  }
+  // keep copy of the data in a base file, to compute differences in later delta files
+  if (out_params.delta_every > 1) {
+    PackData(pm, data_size, base_data);
+    base_hash.resize(pm->nmb_thisrank);
+    for (int m=0; m<(pm->nmb_thisrank); ++m) {
+      base_hash[m] = restart_delta::Hash(&(base_data[m*data_size]), data_size);
+    }
+    const char *lloc = reinterpret_cast<const char*>(pm->lloc_eachmb);
+    base_lloc.assign(lloc, lloc + (pm->nmb_total)*sizeof(LogicalLocation));
+    base_gids.assign(pm->gids_eachrank, pm->gids_eachrank + global_variable::nranks);
+    base_fname = fname;
+    base_offset = data_offset;
+  }
+
+  if (out_params.device_io.compare("none") != 0) {
+    WriteDeviceData(pm, data_offset, data_size);
+    write_pending = true;
+    FinishOutputFile();
+    return;
+  }
 
   // write cell-centered variables in parallel
   IOWrapperSizeT offset_myrank  = step1size + step2size + step3size +
@@ -431,73 +675,44 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
     myoffset = offset_myrank;
   }
 
-  if (prad != nullptr) {
+  // writes one cell-centered array of all MeshBlocks of this rank with elements of type
+  // ("Real" or "float"), collectively while every rank has a MB to write
+  auto write_cc = [&](auto &array, const char *type, const char *name) {
     for (int m=0;  m<noutmbs_max; ++m) {
-      // every rank has a MB to write, so write collectively
-      if (m < noutmbs_min) {
-        // get ptr to cell-centered MeshBlock data
-        auto mbptr = Kokkos::subview(outarray_rad, m, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL, Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Write_any_type_at_all(mbptr.data(),mbcnt,myoffset,"Real") != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-          << std::endl << "cell-centered rad data not written correctly to rst file, "
-          << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-
-      // some ranks are finished writing, so use non-collective write
-      } else if (m < pm->nmb_thisrank) {
-        // get ptr to MeshBlock data
-        auto mbptr = Kokkos::subview(outarray_rad, m, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL, Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Write_any_type_at(mbptr.data(),mbcnt,myoffset,"Real") != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-          << std::endl << "cell-centered rad data not written correctly to rst file, "
-          << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
+      if (m >= noutmbs_min && m >= pm->nmb_thisrank) continue;
+      auto mbptr = Kokkos::subview(array, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
+                                   Kokkos::ALL);
+      int mbcnt = mbptr.size();
+      int nwrite = (m < noutmbs_min)?
+                   resfile.Write_any_type_at_all(mbptr.data(),mbcnt,myoffset,type) :
+                   resfile.Write_any_type_at(mbptr.data(),mbcnt,myoffset,type);
+      if (nwrite != mbcnt) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+        << std::endl << "cell-centered " << name << " data not written correctly to "
+        << "rst file, restart file is broken." << std::endl;
+        exit(EXIT_FAILURE);
       }
+      myoffset += data_size;
     }
-    offset_myrank += nout1*nout2*nout3*nrad*sizeof(Real);   // radiation i0
+  };
+
+  if (prad != nullptr) {
+    if (layout.float_rad) {
+      write_cc(outarray_rad32, "float", "rad");
+    } else {
+      write_cc(outarray_rad, "Real", "rad");
+    }
+    offset_myrank += ArrayBytes(nout1*nout2*nout3*nrad, layout.float_rad);     // rad i0
     myoffset = offset_myrank;
   }
 
-  if (pturb != nullptr) {
-    for (int m=0;  m<noutmbs_max; ++m) {
-      // every rank has a MB to write, so write collectively
-      if (m < noutmbs_min) {
-        // get ptr to cell-centered MeshBlock data
-        auto mbptr = Kokkos::subview(outarray_force, m, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL, Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Write_any_type_at_all(mbptr.data(),mbcnt,myoffset,"Real") != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-          << std::endl << "cell-centered turb data not written correctly to rst file, "
-          << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-
-      // some ranks are finished writing, so use non-collective write
-      } else if (m < pm->nmb_thisrank) {
-        // get ptr to MeshBlock data
-        auto mbptr = Kokkos::subview(outarray_force, m, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL, Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Write_any_type_at(mbptr.data(), mbcnt, myoffset,"Real") != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-          << std::endl << "cell-centered turb data not written correctly to rst file, "
-          << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-      }
+  if (pturb != nullptr && !(layout.skip_force)) {
+    if (layout.float_force) {
+      write_cc(outarray_force32, "float", "turb");
+    } else {
+      write_cc(outarray_force, "Real", "turb");
     }
-    offset_myrank += nout1*nout2*nout3*nforce*sizeof(Real); // forcing
+    offset_myrank += ArrayBytes(nout1*nout2*nout3*nforce, layout.float_force); // forcing
     myoffset = offset_myrank;
   }
 
@@ -570,7 +785,218 @@ void RestartOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
   }
 
   // close file, clean up
-  resfile.Close();
+  write_pending = true;
+  if (!(out_params.async_write)) {
+    FinishOutputFile();
+  }
 
   return;
 }
+
+//----------------------------------------------------------------------------------------
+//! \fn void RestartOutput:::FinishOutputFile()
+//  \brief Waits for any data still being written and closes the last restart file
+
+void RestartOutput::FinishOutputFile() {
+  if (write_pending) {
+    resfile.Close();
+    resfile.SetNonBlocking(false);
+    write_pending = false;
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void RestartOutput:::PackData()
+//  \brief Copies data of all MeshBlocks on this rank into a contiguous buffer, with the
+//  same layout (data_size bytes per MeshBlock) as in a restart file
+
+void RestartOutput::PackData(Mesh *pm, IOWrapperSizeT data_size,
+                             std::vector<char> &data) {
+  int nmb = pm->nmb_thisrank;
+  data.resize(nmb*data_size);
+  std::size_t pos = 0;
+  // copies one (host) array, dimensioned with the MeshBlock as first index
+  auto pack = [&](auto &array) {
+    std::size_t mbsize = (array.size()/nmb)*sizeof(*(array.data()));
+    for (int m=0; m<nmb; ++m) {
+      std::memcpy(&(data[m*data_size + pos]), array.data() + m*(array.size()/nmb),
+                  mbsize);
+    }
+    pos += ArrayBytes(array.size()/nmb, (sizeof(*(array.data())) < sizeof(Real)));
+  };
+  if (pm->pmb_pack->phydro != nullptr) {
+    pack(outarray_hyd);
+  }
+  if (pm->pmb_pack->pmhd != nullptr) {
+    pack(outarray_mhd);
+    pack(outfield.x1f);
+    pack(outfield.x2f);
+    pack(outfield.x3f);
+  }
+  if (pm->pmb_pack->prad != nullptr) {
+    if (layout.float_rad) {
+      pack(outarray_rad32);
+    } else {
+      pack(outarray_rad);
+    }
+  }
+  if (pm->pmb_pack->pturb != nullptr && !(layout.skip_force)) {
+    if (layout.float_force) {
+      pack(outarray_force32);
+    } else {
+      pack(outarray_force);
+    }
+  }
+  if (pm->pmb_pack->pz4c != nullptr) {
+    pack(outarray_z4c);
+  } else if (pm->pmb_pack->padm != nullptr) {
+    pack(outarray_adm);
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void RestartOutput:::WriteDeviceData()
+//  \brief With device_io, writes the data of each MeshBlock as one record (with the same
+//  layout as PackData()) assembled in a device buffer, so no host copies of all arrays
+//  are made.  With device_io=staged, each record is copied through one pinned host
+//  buffer.  With device_io=direct, the device buffer itself is passed to MPI-IO, which
+//  requires an MPI library that writes from device memory (e.g. with GPUDirect Storage).
+
+void RestartOutput::WriteDeviceData(Mesh *pm, IOWrapperSizeT offset,
+                                    IOWrapperSizeT data_size) {
+  std::vector<std::pair<Real*, std::size_t>> arrays;
+  StateArrays(pm->pmb_pack, arrays);
+  Real *prad_data = (pm->pmb_pack->prad != nullptr)? pm->pmb_pack->prad->i0.data() :
+                                                     nullptr;
+  Real *pturb_data = (pm->pmb_pack->pturb != nullptr)?
+                     pm->pmb_pack->pturb->force.data() : nullptr;
+
+  bool direct = (out_params.device_io.compare("direct") == 0);
+  std::size_t rsize = data_size/sizeof(Real);
+  const int nf = sizeof(Real)/sizeof(float);
+  DvceArray1D<Real> drec("rst-drec", rsize);
+  DvceArray1D<float> frec(reinterpret_cast<float*>(drec.data()), nf*rsize);
+  HostPinnedArray1D<Real> hrec;
+  if (!(direct)) {hrec = HostPinnedArray1D<Real>("rst-hrec", rsize);}
+
+  int &mygids = pm->gids_eachrank[global_variable::my_rank];
+  IOWrapperSizeT myoffset = offset + data_size*mygids;
+  for (int m=0; m<(pm->nmb_thisrank); ++m) {
+    // copy (or convert to float) the array(s) of this MeshBlock into the record
+    std::size_t pos = 0;
+    for (auto &a : arrays) {
+      if (a.first == pturb_data && layout.skip_force) continue;
+      bool single = (a.first == prad_data && layout.float_rad) ||
+                    (a.first == pturb_data && layout.float_force);
+      Real *src = a.first + m*a.second;
+      if (single) {
+        int fpos = nf*pos;
+        par_for("rst-float", DevExeSpace(), 0, static_cast<int>(a.second)-1,
+        KOKKOS_LAMBDA(const int i) {
+          frec(fpos + i) = static_cast<float>(src[i]);
+        });
+      } else {
+        Kokkos::deep_copy(DevExeSpace(), Kokkos::subview(drec,
+                          std::make_pair(pos, pos + a.second)),
+                          DvceArray1D<Real>(src, a.second));
+      }
+      pos += ArrayBytes(a.second, single)/sizeof(Real);
+    }
+    const void *buf = drec.data();
+    if (direct) {
+      Kokkos::fence();
+    } else {
+      Kokkos::deep_copy(hrec, drec);
+      buf = hrec.data();
+    }
+
+    // every rank has a MB to write, so write collectively
+    std::size_t nwrite = (m < noutmbs_min)?
+                         resfile.Write_any_type_at_all(buf, data_size, myoffset, "byte") :
+                         resfile.Write_any_type_at(buf, data_size, myoffset, "byte");
+    if (nwrite != data_size) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "MeshBlock data not written correctly to rst file, "
+                << "restart file is broken." << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    myoffset += data_size;
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void RestartOutput:::WriteDeltaData()
+//  \brief Writes data of all MeshBlocks as differences to the data in the base file.
+//  Starting at offset, the file contains a table of restart_delta::IndexEntry (one per
+//  MeshBlock, in gid order), followed by the (encoded) data of each rank.
+
+void RestartOutput::WriteDeltaData(Mesh *pm, IOWrapperSizeT offset,
+                                   IOWrapperSizeT data_size) {
+  int nmb = pm->nmb_thisrank;
+  int mygids = pm->gids_eachrank[global_variable::my_rank];
+  std::vector<char> data;
+  PackData(pm, data_size, data);
+
+  // encode each MeshBlock, or store it unchanged if encoding does not reduce its size
+  delta_buf.clear();
+  delta_index.resize(nmb);
+  for (int m=0; m<nmb; ++m) {
+    const char *mbdata = &(data[m*data_size]);
+    const char *mbbase = &(base_data[m*data_size]);
+    auto &entry = delta_index[m];
+    entry.hash = restart_delta::Hash(mbdata, data_size);
+    entry.offset = delta_buf.size();
+    if (entry.hash == base_hash[m] && std::memcmp(mbdata, mbbase, data_size) == 0) {
+      entry.mode = restart_delta::DeltaMode::unchanged;
+    } else {
+      restart_delta::Encode(mbdata, mbbase, data_size, delta_buf);
+      entry.mode = restart_delta::DeltaMode::xor_encoded;
+      if (delta_buf.size() - entry.offset >= data_size) {
+        delta_buf.resize(entry.offset);
+        delta_buf.insert(delta_buf.end(), mbdata, mbdata + data_size);
+        entry.mode = restart_delta::DeltaMode::raw;
+      }
+    }
+    entry.length = delta_buf.size() - entry.offset;
+  }
+
+  // offset of data of this rank in file
+  IOWrapperSizeT mysize = delta_buf.size(), rank_offset = 0;
+#if MPI_PARALLEL_ENABLED
+  MPI_Exscan(&mysize, &rank_offset, 1, MPI_UINT64_T, MPI_SUM, global_variable::mpi_comm);
+  if (global_variable::my_rank == 0) {rank_offset = 0;}
+#endif
+  IOWrapperSizeT myoffset = offset + (pm->nmb_total)*sizeof(restart_delta::IndexEntry) +
+                            rank_offset;
+  for (auto &entry : delta_index) {
+    entry.offset += myoffset;
+  }
+
+  // write index and data.  Data are written in chunks, to avoid exceeding the 2^31
+  // limit of data elements per write call
+  IOWrapperSizeT idxcnt = nmb*sizeof(restart_delta::IndexEntry);
+  if (resfile.Write_any_type_at_all(delta_index.data(), idxcnt,
+         offset + mygids*sizeof(restart_delta::IndexEntry), "byte") != idxcnt) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "index not written correctly to delta rst file, "
+              << "restart file is broken." << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  const IOWrapperSizeT chunk = 1073741824;
+  int nchunk = (mysize + chunk - 1)/chunk;
+#if MPI_PARALLEL_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE, &nchunk, 1, MPI_INT, MPI_MAX, global_variable::mpi_comm);
+#endif
+  for (int n=0; n<nchunk; ++n) {
+    IOWrapperSizeT start = std::min(n*chunk, mysize);
+    IOWrapperSizeT cnt = std::min(chunk, mysize - start);
+    if (resfile.Write_any_type_at_all(delta_buf.data() + start, cnt, myoffset + start,
+                                      "byte") != cnt) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "data not written correctly to delta rst file, "
+                << "restart file is broken." << std::endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+}
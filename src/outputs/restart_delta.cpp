@@ -0,0 +1,214 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file restart_delta.cpp
+//! \brief implements functions used to write and read delta restart files.
+//!
+//! The encoding works on 64-bit words of (data XOR base).  Each token starts with a byte
+//! c: if (c & 0x80) it is a run of (c & 0x7f)+1 words equal to the base; otherwise c (in
+//! [1,8]) is the number of significant (low-order) bytes of the XOR, which follow.  Since
+//! the sign, exponent and leading bits of the mantissa of slowly varying data rarely
+//! change, the XOR of most words fits in fewer than 8 bytes.
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mesh/mesh.hpp"
+#include "restart_delta.hpp"
+
+namespace restart_delta {
+//----------------------------------------------------------------------------------------
+//! \fn std::uint64_t Hash(const char *data, std::size_t size)
+//! \brief 64-bit FNV-1a hash of data
+
+std::uint64_t Hash(const char *data, std::size_t size) {
+  std::uint64_t h = 14695981039346656037ULL;
+  for (std::size_t n=0; n<size; ++n) {
+    h ^= static_cast<unsigned char>(data[n]);
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Encode()
+//! \brief appends the encoded difference between data and base (both of length size
+//! bytes) to out
+
+void Encode(const char *data, const char *base, std::size_t size,
+            std::vector<char> &out) {
+  std::size_t nword = (size + 7)/8;
+  std::size_t nsame = 0;
+  for (std::size_t w=0; w<nword; ++w) {
+    std::size_t nb = std::min(static_cast<std::size_t>(8), size - 8*w);
+    std::uint64_t a = 0, b = 0;
+    std::memcpy(&a, data + 8*w, nb);
+    std::memcpy(&b, base + 8*w, nb);
+    std::uint64_t x = a^b;
+    if (x == 0) {
+      if (++nsame == 128) {
+        out.push_back(static_cast<char>(0xff));
+        nsame = 0;
+      }
+      continue;
+    }
+    if (nsame > 0) {
+      out.push_back(static_cast<char>(0x80 | (nsame - 1)));
+      nsame = 0;
+    }
+    int nbyte = 8;
+    while (nbyte > 1 && (x >> (8*(nbyte-1))) == 0) {nbyte--;}
+    out.push_back(static_cast<char>(nbyte));
+    for (int i=0; i<nbyte; ++i) {
+      out.push_back(static_cast<char>((x >> (8*i)) & 0xff));
+    }
+  }
+  if (nsame > 0) {
+    out.push_back(static_cast<char>(0x80 | (nsame - 1)));
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool Decode()
+//! \brief reconstructs data (of length size bytes) from base and encoded difference.
+//! Returns false if the encoded data are inconsistent with size.
+
+bool Decode(const char *enc, std::size_t enc_size, const char *base, std::size_t size,
+            char *data) {
+  std::size_t nword = (size + 7)/8;
+  std::size_t w = 0, p = 0;
+  while (p < enc_size) {
+    unsigned char c = static_cast<unsigned char>(enc[p++]);
+    if (c & 0x80) {
+      std::size_t nsame = (c & 0x7f) + 1;
+      if (w + nsame > nword) {return false;}
+      std::size_t nb = std::min(8*nsame, size - 8*w);
+      std::memcpy(data + 8*w, base + 8*w, nb);
+      w += nsame;
+    } else {
+      int nbyte = c;
+      if (nbyte < 1 || nbyte > 8 || p + nbyte > enc_size || w >= nword) {return false;}
+      std::uint64_t x = 0, b = 0;
+      for (int i=0; i<nbyte; ++i) {
+        x |= static_cast<std::uint64_t>(static_cast<unsigned char>(enc[p+i])) << (8*i);
+      }
+      p += nbyte;
+      std::size_t nb = std::min(static_cast<std::size_t>(8), size - 8*w);
+      std::memcpy(&b, base + 8*w, nb);
+      x ^= b;
+      std::memcpy(data + 8*w, &x, nb);
+      w++;
+    }
+  }
+  return (w == nword);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool FindBase()
+//! \brief returns true if the restart file (whose input parameters are stored in pin) is
+//! a delta restart file, and sets name of the base restart file and the offset of the
+//! MeshBlock data within it
+
+bool FindBase(ParameterInput *pin, std::string &base_fname,
+              IOWrapperSizeT &base_offset) {
+  for (auto &blk : pin->block) {
+    std::string name = blk.block_name;
+    if (name.compare(0, 6, "output") != 0) continue;
+    if (!(pin->DoesParameterExist(name, "file_type")) ||
+        pin->GetString(name, "file_type").compare("rst") != 0) continue;
+    if (!(pin->DoesParameterExist(name, "delta_base"))) continue;
+    base_fname = pin->GetString(name, "delta_base");
+    if (base_fname.compare("none") == 0) continue;
+    base_offset = std::stoull(pin->GetString(name, "delta_offset"));
+    return true;
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool ReadData()
+//! \brief If the restart file is a delta restart file, reconstructs the data of all
+//! MeshBlocks on this rank (in the same layout as in a full restart file) from the base
+//! file and the differences stored in resfile, starting at offset, and returns true.
+//! Returns false (and does nothing) for full restart files.
+
+bool ReadData(ParameterInput *pin, Mesh *pm, IOWrapper &resfile, IOWrapperSizeT offset,
+              IOWrapperSizeT data_size, std::vector<char> &data) {
+  std::string base_fname;
+  IOWrapperSizeT base_offset;
+  if (!(FindBase(pin, base_fname, base_offset))) {return false;}
+
+  int nmb = pm->nmb_thisrank;
+  int mygids = pm->gids_eachrank[global_variable::my_rank];
+
+  // read index entries of MeshBlocks on this rank
+  std::vector<IndexEntry> index(nmb);
+  if (resfile.Read_bytes_at_all(index.data(), sizeof(IndexEntry), nmb,
+                                offset + mygids*sizeof(IndexEntry)) != nmb) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "index of delta restart file not read correctly, "
+              << "restart file is broken." << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // check base file contains MeshBlocks of the same size
+  IOWrapper basefile;
+  basefile.Open(base_fname.c_str(), IOWrapper::FileMode::read);
+  IOWrapperSizeT base_data_size = 0;
+  basefile.Read_bytes_at(&base_data_size, sizeof(IOWrapperSizeT), 1,
+                         base_offset - sizeof(IOWrapperSizeT));
+  if (base_data_size != data_size) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "base restart file '" << base_fname << "' of delta restart "
+              << "file is missing or does not match." << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // reconstruct data of each MeshBlock from base and differences
+  data.resize(nmb*data_size);
+  std::vector<char> base(data_size), enc;
+  for (int m=0; m<nmb; ++m) {
+    char *mbdata = &(data[m*data_size]);
+    if (basefile.Read_bytes_at(base.data(), 1, data_size,
+                               base_offset + data_size*(mygids + m)) != data_size) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "data not read correctly from base restart file '"
+                << base_fname << "'." << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    bool ok = true;
+    if (index[m].mode == DeltaMode::unchanged) {
+      std::memcpy(mbdata, base.data(), data_size);
+    } else if (index[m].mode == DeltaMode::raw) {
+      ok = (index[m].length == data_size) &&
+           (resfile.Read_bytes_at(mbdata, 1, data_size, index[m].offset) == data_size);
+    } else if (index[m].mode == DeltaMode::xor_encoded) {
+      enc.resize(index[m].length);
+      ok = (resfile.Read_bytes_at(enc.data(), 1, index[m].length, index[m].offset)
+            == index[m].length) &&
+           Decode(enc.data(), enc.size(), base.data(), data_size, mbdata);
+    } else {
+      ok = false;
+    }
+    if (!(ok) || Hash(mbdata, data_size) != index[m].hash) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "data of MeshBlock " << (mygids + m) << " could not be "
+                << "reconstructed from base restart file '" << base_fname << "'."
+                << std::endl;
+      exit(EXIT_FAILURE);
+    }
+  }
+  basefile.Close();
+  return true;
+}
+
+} // namespace restart_delta
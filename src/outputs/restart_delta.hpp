@@ -0,0 +1,50 @@
+#ifndef OUTPUTS_RESTART_DELTA_HPP_
+#define OUTPUTS_RESTART_DELTA_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file restart_delta.hpp
+//  \brief functions used to write and read delta restart files.  Instead of the data in
+//  each MeshBlock, these files store the difference to the data in an earlier (base)
+//  restart file, as the XOR of both encoded with run-lengths of zero bytes.  Each
+//  MeshBlock is keyed by its gid and a hash of its content, which is used to check the
+//  data are reconstructed correctly from the base file.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "io_wrapper.hpp"
+
+// Forward declarations
+class Mesh;
+class ParameterInput;
+
+namespace restart_delta {
+
+// how data of a MeshBlock are stored in delta restart file
+enum DeltaMode : std::uint64_t {unchanged=0, xor_encoded=1, raw=2};
+
+//! \struct IndexEntry
+//  \brief entry in table (one per MeshBlock, in gid order) at the start of the data in a
+//  delta restart file
+struct IndexEntry {
+  std::uint64_t hash;      // hash of MeshBlock data
+  std::uint64_t offset;    // offset of (encoded) data in file
+  std::uint64_t length;    // length of (encoded) data in bytes
+  std::uint64_t mode;      // DeltaMode
+};
+
+std::uint64_t Hash(const char *data, std::size_t size);
+void Encode(const char *data, const char *base, std::size_t size, std::vector<char> &out);
+bool Decode(const char *enc, std::size_t enc_size, const char *base, std::size_t size,
+            char *data);
+bool FindBase(ParameterInput *pin, std::string &base_fname, IOWrapperSizeT &base_offset);
+bool ReadData(ParameterInput *pin, Mesh *pm, IOWrapper &resfile, IOWrapperSizeT offset,
+              IOWrapperSizeT data_size, std::vector<char> &data);
+
+} // namespace restart_delta
+#endif // OUTPUTS_RESTART_DELTA_HPP_
@@ -0,0 +1,284 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file restart_local.cpp
+//! \brief implements functions used to write and read the data of restart files kept in
+//! node-local storage.
+//!
+//! The file of each rank starts with a FileHeader identifying the MeshBlocks it contains,
+//! followed by their data (data_size bytes per MeshBlock, in the same layout as in a full
+//! restart file), and ends with the tag of the header, so truncated files are detected.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>      // remove(), snprintf()
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mesh/mesh.hpp"
+#include "restart_local.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
+namespace restart_local {
+namespace {
+constexpr std::uint64_t file_tag = 0x617468656e6b6c63ULL;  // "athenklc"
+constexpr IOWrapperSizeT msg_chunk = 1073741824;            // max bytes per message
+
+//! \struct FileHeader
+//  \brief identifies the data in the file of one rank
+struct FileHeader {
+  std::uint64_t tag;
+  std::uint64_t data_size;     // bytes per MeshBlock
+  std::int64_t ncycle;         // cycle at which data were written
+  std::int32_t rank, gids, nmb, nranks;
+};
+
+// name of file holding data of rank (or its copy, on the partner rank)
+std::string FileName(const std::string &dir, const std::string &stem, int rank,
+                     bool copy) {
+  char number[8];
+  std::snprintf(number, sizeof(number), "%06d", rank);
+  return dir + "/" + stem + "." + number + ((copy)? ".copy" : ".rst");
+}
+
+// writes data of rank to file, returns false on error
+bool WriteFile(const std::string &name, Mesh *pm, int rank, IOWrapperSizeT data_size,
+               const char *data) {
+  FileHeader hdr = {file_tag, data_size, pm->ncycle, rank, pm->gids_eachrank[rank],
+                    pm->nmb_eachrank[rank], global_variable::nranks};
+  std::ofstream os(name, std::ios::binary | std::ios::trunc);
+  os.write(reinterpret_cast<const char*>(&hdr), sizeof(FileHeader));
+  os.write(data, hdr.nmb*data_size);
+  os.write(reinterpret_cast<const char*>(&file_tag), sizeof(std::uint64_t));
+  os.close();
+  return !(os.fail());
+}
+
+// reads data of rank from file, returns false if the file is missing, incomplete, or
+// does not contain the MeshBlocks of rank in the current mesh
+bool ReadFile(const std::string &name, Mesh *pm, int rank, IOWrapperSizeT data_size,
+              std::vector<char> &data) {
+  std::ifstream is(name, std::ios::binary);
+  if (!is) {return false;}
+  FileHeader hdr;
+  is.read(reinterpret_cast<char*>(&hdr), sizeof(FileHeader));
+  if (!is || hdr.tag != file_tag || hdr.data_size != data_size ||
+      hdr.ncycle != pm->ncycle || hdr.rank != rank ||
+      hdr.gids != pm->gids_eachrank[rank] || hdr.nmb != pm->nmb_eachrank[rank] ||
+      hdr.nranks != global_variable::nranks) {return false;}
+  data.resize(hdr.nmb*data_size);
+  std::uint64_t tag = 0;
+  is.read(data.data(), data.size());
+  is.read(reinterpret_cast<char*>(&tag), sizeof(std::uint64_t));
+  return (is && tag == file_tag);
+}
+
+#if MPI_PARALLEL_ENABLED
+// posts non-blocking sends (or receives) of nbytes of data, in chunks
+void PostMessages(char *data, IOWrapperSizeT nbytes, int rank, bool send,
+                  std::vector<MPI_Request> &req) {
+  for (IOWrapperSizeT start=0; start<nbytes; start+=msg_chunk) {
+    int cnt = static_cast<int>(std::min(msg_chunk, nbytes - start));
+    req.emplace_back();
+    if (send) {
+      MPI_Isend(data + start, cnt, MPI_BYTE, rank, 0, global_variable::mpi_comm,
+                &req.back());
+    } else {
+      MPI_Irecv(data + start, cnt, MPI_BYTE, rank, 0, global_variable::mpi_comm,
+                &req.back());
+    }
+  }
+}
+#endif
+
+// ranks whose copy is stored by this rank
+std::vector<int> Senders(const std::vector<int> &partner) {
+  std::vector<int> senders;
+  for (int r=0; r<static_cast<int>(partner.size()); ++r) {
+    if (partner[r] == global_variable::my_rank && r != global_variable::my_rank) {
+      senders.push_back(r);
+    }
+  }
+  return senders;
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn void Partners()
+//! \brief Sets partner[r] to the rank that stores the copy of the data of rank r: the
+//! rank with the same node-local rank (modulo number of ranks on that node) on the next
+//! node.  Without MPI, or on a single node, every rank is its own partner (no copies).
+
+void Partners(std::vector<int> &partner) {
+  int nranks = global_variable::nranks;
+  partner.resize(nranks);
+  for (int r=0; r<nranks; ++r) {partner[r] = r;}
+#if MPI_PARALLEL_ENABLED
+  // every node is identified by lowest rank on it
+  MPI_Comm node_comm;
+  MPI_Comm_split_type(global_variable::mpi_comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+                      &node_comm);
+  int leader = global_variable::my_rank;
+  MPI_Bcast(&leader, 1, MPI_INT, 0, node_comm);
+  MPI_Comm_free(&node_comm);
+  std::vector<int> node(nranks);
+  MPI_Allgather(&leader, 1, MPI_INT, node.data(), 1, MPI_INT, global_variable::mpi_comm);
+
+  // ranks on each node, in order of node-local rank
+  std::vector<int> leaders(node);
+  std::sort(leaders.begin(), leaders.end());
+  leaders.erase(std::unique(leaders.begin(), leaders.end()), leaders.end());
+  int nnode = static_cast<int>(leaders.size());
+  if (nnode < 2) return;
+  std::vector<int> inode(nranks), lrank(nranks);
+  std::vector<std::vector<int>> members(nnode);
+  for (int r=0; r<nranks; ++r) {
+    inode[r] = static_cast<int>(std::lower_bound(leaders.begin(), leaders.end(), node[r])
+                                - leaders.begin());
+    lrank[r] = static_cast<int>(members[inode[r]].size());
+    members[inode[r]].push_back(r);
+  }
+  for (int r=0; r<nranks; ++r) {
+    auto &next = members[(inode[r] + 1) % nnode];
+    partner[r] = next[lrank[r] % static_cast<int>(next.size())];
+  }
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void WriteData()
+//! \brief Writes data of all MeshBlocks on this rank (packed as in a restart file) to
+//! its file in dir, and the copies of the data received from other ranks.
+
+void WriteData(const std::string &dir, const std::string &stem, Mesh *pm,
+               IOWrapperSizeT data_size, const std::vector<char> &data,
+               const std::vector<int> &partner) {
+  int myrank = global_variable::my_rank;
+  int nerr = 0;
+  if (!WriteFile(FileName(dir, stem, myrank, false), pm, myrank, data_size,
+                 data.data())) {nerr++;}
+#if MPI_PARALLEL_ENABLED
+  // exchange copies with partners, then write received copies
+  std::vector<int> senders = Senders(partner);
+  std::vector<std::vector<char>> copies(senders.size());
+  std::vector<MPI_Request> req;
+  for (std::size_t n=0; n<senders.size(); ++n) {
+    copies[n].resize(pm->nmb_eachrank[senders[n]]*data_size);
+    PostMessages(copies[n].data(), copies[n].size(), senders[n], false, req);
+  }
+  if (partner[myrank] != myrank) {
+    PostMessages(const_cast<char*>(data.data()), data.size(), partner[myrank], true,
+                 req);
+  }
+  MPI_Waitall(static_cast<int>(req.size()), req.data(), MPI_STATUSES_IGNORE);
+  for (std::size_t n=0; n<senders.size(); ++n) {
+    if (!WriteFile(FileName(dir, stem, senders[n], true), pm, senders[n], data_size,
+                   copies[n].data())) {nerr++;}
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &nerr, 1, MPI_INT, MPI_SUM, global_variable::mpi_comm);
+#endif
+  if (nerr > 0) {
+    if (global_variable::my_rank == 0) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "restart data not written correctly to '" << dir
+                << "' on " << nerr << " rank(s), restart file is broken." << std::endl;
+    }
+    exit(EXIT_FAILURE);
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void RemoveData()
+//! \brief Removes file of this rank, and copies of data of other ranks, written by
+//! WriteData() with the same stem
+
+void RemoveData(const std::string &dir, const std::string &stem,
+                const std::vector<int> &partner) {
+  std::remove(FileName(dir, stem, global_variable::my_rank, false).c_str());
+  for (int r : Senders(partner)) {
+    std::remove(FileName(dir, stem, r, true).c_str());
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool ReadData()
+//! \brief If the restart file (whose input parameters are stored in pin) keeps its data
+//! in node-local storage, collects the data of all MeshBlocks on this rank from its own
+//! file, or from the copy found by any other rank, and returns true.  Returns false (and
+//! does nothing) for restart files containing the data.
+
+bool ReadData(ParameterInput *pin, Mesh *pm, IOWrapperSizeT data_size,
+              std::vector<char> &data) {
+  std::string dir, stem, fallback;
+  for (auto &blk : pin->block) {
+    std::string name = blk.block_name;
+    if (name.compare(0, 6, "output") != 0) continue;
+    if (!(pin->DoesParameterExist(name, "file_type")) ||
+        pin->GetString(name, "file_type").compare("rst") != 0) continue;
+    if (!(pin->DoesParameterExist(name, "local_data"))) continue;
+    stem = pin->GetString(name, "local_data");
+    if (stem.compare("none") == 0) continue;
+    dir = pin->GetString(name, "local_dir");
+    fallback = pin->GetString(name, "local_fallback");
+    break;
+  }
+  if (dir.empty()) {return false;}
+
+  int myrank = global_variable::my_rank;
+  int nranks = global_variable::nranks;
+  int found = ReadFile(FileName(dir, stem, myrank, false), pm, myrank, data_size, data);
+  std::vector<int> have(nranks, found);
+#if MPI_PARALLEL_ENABLED
+  MPI_Allgather(&found, 1, MPI_INT, have.data(), 1, MPI_INT, global_variable::mpi_comm);
+#endif
+
+  // data of ranks whose own file is lost are sent by lowest rank holding a copy
+  int nlost = 0;
+  for (int r=0; r<nranks; ++r) {
+    if (have[r]) continue;
+    std::vector<char> copy;
+    int holder = nranks;
+    if (r != myrank &&
+        ReadFile(FileName(dir, stem, r, true), pm, r, data_size, copy)) {holder = myrank;}
+#if MPI_PARALLEL_ENABLED
+    MPI_Allreduce(MPI_IN_PLACE, &holder, 1, MPI_INT, MPI_MIN, global_variable::mpi_comm);
+#endif
+    if (holder == nranks) {
+      nlost++;
+      continue;
+    }
+#if MPI_PARALLEL_ENABLED
+    std::vector<MPI_Request> req;
+    if (holder == myrank) {
+      PostMessages(copy.data(), copy.size(), r, true, req);
+    } else if (r == myrank) {
+      data.resize(pm->nmb_thisrank*data_size);
+      PostMessages(data.data(), data.size(), holder, false, req);
+    }
+    MPI_Waitall(static_cast<int>(req.size()), req.data(), MPI_STATUSES_IGNORE);
+#endif
+  }
+  if (nlost > 0) {
+    if (global_variable::my_rank == 0) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "data of " << nlost << " rank(s) of restart file '"
+                << stem << "' not found in '" << dir << "' on any node.  Restart from '"
+                << fallback << "' (written to the filesystem) instead." << std::endl;
+    }
+    exit(EXIT_FAILURE);
+  }
+  return true;
+}
+
+} // namespace restart_local
@@ -0,0 +1,45 @@
+#ifndef OUTPUTS_RESTART_LOCAL_HPP_
+#define OUTPUTS_RESTART_LOCAL_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file restart_local.hpp
+//  \brief functions used to write and read restart files whose MeshBlock data are kept
+//  in node-local storage.  With <output[n]>/fs_every > 1, only one of every fs_every
+//  restart files contains the data; the others contain only the header (input
+//  parameters, mesh structure, time), and every rank writes its data to its own file in
+//  <output[n]>/local_dir (e.g. a node-local NVMe disk), and sends a copy to a partner
+//  rank on the next node, which writes it to its own local_dir.  The data of a rank thus
+//  survive the loss of any one node.
+//
+//  On restart every rank reads its own file if it is still present, and the data of the
+//  other ranks are sent by whichever rank finds their copy.  This requires restarting on
+//  the same number of ranks, and (for the copies) on nodes whose local_dir still holds
+//  them.  If the data of a rank are found nowhere, the run must be restarted from the
+//  last restart file written to the filesystem, whose name is stored in the header.
+
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "io_wrapper.hpp"
+
+// Forward declarations
+class Mesh;
+class ParameterInput;
+
+namespace restart_local {
+
+void Partners(std::vector<int> &partner);
+void WriteData(const std::string &dir, const std::string &stem, Mesh *pm,
+               IOWrapperSizeT data_size, const std::vector<char> &data,
+               const std::vector<int> &partner);
+void RemoveData(const std::string &dir, const std::string &stem,
+                const std::vector<int> &partner);
+bool ReadData(ParameterInput *pin, Mesh *pm, IOWrapperSizeT data_size,
+              std::vector<char> &data);
+
+} // namespace restart_local
+#endif // OUTPUTS_RESTART_LOCAL_HPP_
@@ -31,51 +31,54 @@ TrackedParticleOutput::TrackedParticleOutput(ParameterInput *pin, Mesh *pm,
   BaseTypeOutput(pin, pm, op) {
   // create new directory for this output. Comments in binary.cpp constructor explain why
   mkdir("trk",0775);
-  // allocate arrays
-  npout_eachrank.resize(global_variable::nranks);
   ntrack = pin->GetInteger(op.block_name,"nparticles");
-  // TODO(@user) improve guess below?
-  ntrack_thisrank = ntrack;
 }
 
 //----------------------------------------------------------------------------------------
 // TrackedParticleOutput::LoadOutputData()
-// Copies data for tracked particles on this rank to host outpart array
+// Selects tracked particles (tag < ntrack) on this rank on the device, and copies only
+// their data to host outpart array, sorted by tag.
 
 void TrackedParticleOutput::LoadOutputData(Mesh *pm) {
-  // Load data for tracked particles on this rank into new device array
-  DualArray1D<TrackedParticleData> tracked_prtcl("d_trked",ntrack_thisrank);
-  int npart = pm->nprtcl_thisrank;
+  int npart = pm->pmb_pack->ppart->nprtcl_thispack;
   auto &pr = pm->pmb_pack->ppart->prtcl_rdata;
   auto &pi = pm->pmb_pack->ppart->prtcl_idata;
-  int counter=0;
-  int *pcounter = &counter;
-  par_for("part_update",DevExeSpace(),0,(npart-1), KOKKOS_LAMBDA(const int p) {
-    if (pi(PTAG,p) < ntrack) {
-      int index = Kokkos::atomic_fetch_add(pcounter,1);
-      tracked_prtcl.d_view(index).tag = pi(PTAG,p);
-      tracked_prtcl.d_view(index).x   = pr(IPX,p);
-      tracked_prtcl.d_view(index).y   = pr(IPY,p);
-      tracked_prtcl.d_view(index).z   = pr(IPZ,p);
-      tracked_prtcl.d_view(index).vx  = pr(IPVX,p);
-      tracked_prtcl.d_view(index).vy  = pr(IPVY,p);
-      tracked_prtcl.d_view(index).vz  = pr(IPVZ,p);
+  bool has_vel = pm->pmb_pack->ppart->has_velocity;
+  int ntrack_ = ntrack;
+
+  // list indices of tracked particles on this rank
+  npout = 0;
+  DvceArray1D<int> index("trk_index", std::max(npart,1));
+  Kokkos::parallel_scan("trk_index",Kokkos::RangePolicy<>(DevExeSpace(),0,npart),
+  KOKKOS_LAMBDA(const int p, int &n, const bool last_pass) {
+    if (pi(PTAG,p) < ntrack_ && pi(PGID,p) >= 0) {
+      if (last_pass) {index(n) = p;}
+      n++;
     }
+  }, npout);
+
+  // Load data for tracked particles on this rank into new device array
+  DualArray1D<TrackedParticleData> tracked_prtcl("d_trked",npout);
+  par_for("trk_load",DevExeSpace(),0,(npout-1), KOKKOS_LAMBDA(const int n) {
+    int p = index(n);
+    tracked_prtcl.d_view(n).tag = pi(PTAG,p);
+    tracked_prtcl.d_view(n).x   = pr(IPX,p);
+    tracked_prtcl.d_view(n).y   = pr(IPY,p);
+    tracked_prtcl.d_view(n).z   = pr(IPZ,p);
+    tracked_prtcl.d_view(n).vx  = (has_vel)? pr(IPVX,p) : 0.0;
+    tracked_prtcl.d_view(n).vy  = (has_vel)? pr(IPVY,p) : 0.0;
+    tracked_prtcl.d_view(n).vz  = (has_vel)? pr(IPVZ,p) : 0.0;
   });
-  npout = counter;
-  // share number of tracked particles to be output across all ranks
-  npout_eachrank[global_variable::my_rank] = npout;
-#if MPI_PARALLEL_ENABLED
-  MPI_Allgather(&npout, 1, MPI_INT, npout_eachrank.data(), 1, MPI_INT, MPI_COMM_WORLD);
-#endif
-  tracked_prtcl.resize(npout);
   // sync tracked particle device array with host
   tracked_prtcl.template modify<DevExeSpace>();
   tracked_prtcl.template sync<HostMemSpace>();
 
-  // copy host view into host outpart array
+  // copy host view into host outpart array, and sort by tag
   Kokkos::realloc(outpart, npout);
   Kokkos::deep_copy(outpart, tracked_prtcl.h_view);
+  std::sort(outpart.data(), outpart.data() + npout,
+            [](const TrackedParticleData &a, const TrackedParticleData &b) {
+              return a.tag < b.tag;});
 }
 
 //----------------------------------------------------------------------------------------
@@ -126,37 +129,21 @@ void TrackedParticleOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
     data[(6*p)+4] = static_cast<float>(outpart(p).vy);
     data[(6*p)+5] = static_cast<float>(outpart(p).vz);
   }
-  // calculate local data offset
-  std::vector<int> rank_offset(global_variable::nranks, 0);
-  int npout_min = pm->nprtcl_eachrank[0];
-  for (int n=1; n<global_variable::nranks; ++n) {
-    rank_offset[n] = rank_offset[n-1] + npout_eachrank[n-1];
-    npout_min = std::min(npout_min, npout_eachrank[n]);
-  }
-
-  // Write tracked particle data collectively over minimum shared number of prtcls
-  for (int p=0; p<npout_min; ++p) {
-    // offset computed assuming tags run 0...(ntrack-1) sequentially
-    std::size_t myoffset = header_offset + 6*outpart(p).tag;
-    // Write particle positions collectively for minimum number of particles across ranks
-    if (partfile.Write_any_type_at_all(&(data[0]),6,myoffset,"float") != 6) {
-      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-          << std::endl << "particle data not written correctly to tracked particle file"
-          << std::endl;
-      exit(EXIT_FAILURE);
-    }
-  }
-  // Write particle positions individually for remaining particles on each rank
-  for (int p=npout_min; p<npout; ++p) {
-    // offset computed assuming tags run 0...(ntrack-1) sequentially
-    std::size_t myoffset = header_offset + 6*outpart(p).tag;
-    // Write particle positions collectively for minimum number of particles across ranks
-    if (partfile.Write_any_type_at(&(data[0]),6,myoffset,"float") != 6) {
+  // Data of each particle are stored at the position given by its tag (tags run
+  // 0...(ntrack-1)), so no offsets between ranks are needed.  Particles with consecutive
+  // tags (sorted in LoadOutputData()) are written with a single write.
+  int p = 0;
+  while (p < npout) {
+    int q = p + 1;
+    while (q < npout && outpart(q).tag == outpart(q-1).tag + 1) {q++;}
+    std::size_t myoffset = header_offset + 6*sizeof(float)*outpart(p).tag;
+    if (partfile.Write_any_type_at(&(data[6*p]),6*(q-p),myoffset,"float") != 6*(q-p)) {
       std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
           << std::endl << "particle data not written correctly to tracked particle file"
           << std::endl;
       exit(EXIT_FAILURE);
     }
+    p = q;
   }
 
   // close the output file and clean up
@@ -0,0 +1,381 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file uniform_grid.cpp
+//! \brief writes output variables interpolated to a uniform Cartesian grid, in (legacy)
+//! vtk format as in vtk_mesh.cpp.  The grid has nx1*nx2*nx3 cells spanning the physical
+//! coordinates x1min..x3max given in the <output> block.  By default it covers the whole
+//! Mesh with the cells of <output>/level (0 = root level), so that an AMR calculation can
+//! be analyzed on a uniform grid without post-processing.
+//!
+//! The cell centers of the grid within each MeshBlock form a box of cells of the grid, so
+//! MeshBlocks are located from mb_size without searching for each point.  Variables are
+//! trilinearly interpolated (in logical coordinates) on the device from the active cells
+//! of the MeshBlock, and each box is written with MPI-IO through a subarray datatype.
+//! Options gid, slice_x1/2/3, ghost_zones, and region_* are ignored.
+
+#include <sys/stat.h>  // mkdir
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>      // fwrite(), fclose(), fopen(), fnprintf(), snprintf()
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "coordinates/cell_locations.hpp"
+#include "mesh/mesh.hpp"
+#include "outputs.hpp"
+
+//----------------------------------------------------------------------------------------
+// ctor: also calls BaseTypeOutput base class constructor
+// Reads and checks extent and number of cells of uniform grid
+
+UniformGridOutput::UniformGridOutput(ParameterInput *pin, Mesh *pm, OutputParameters op) :
+  BaseTypeOutput(pin, pm, op) {
+  // create new directory for this output. Comments in binary.cpp constructor explain why
+  mkdir("ugrid",0775);
+
+  std::string &blk = out_params.block_name;
+  auto &indcs = pm->mb_indcs;
+  int level = pin->GetOrAddInteger(blk, "level", 0);
+  int mesh_nx[3] = {pm->nmb_rootx1*indcs.nx1, pm->nmb_rootx2*indcs.nx2,
+                    pm->nmb_rootx3*indcs.nx3};
+  Real mesh_min[3] = {pm->mesh_size.x1min, pm->mesh_size.x2min, pm->mesh_size.x3min};
+  Real mesh_max[3] = {pm->mesh_size.x1max, pm->mesh_size.x2max, pm->mesh_size.x3max};
+  for (int d=0; d<3; ++d) {
+    std::string dir = "x" + std::to_string(d+1);
+    Real mmin = pm->stretch.X(d, mesh_min[d]);
+    Real mmax = pm->stretch.X(d, mesh_max[d]);
+    xmin[d] = pin->GetOrAddReal(blk, dir + "min", mmin);
+    Real xmax = pin->GetOrAddReal(blk, dir + "max", mmax);
+    if (xmin[d] < mmin || xmax > mmax || xmin[d] >= xmax) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+          << std::endl << "Uniform grid " << dir << "min=" << xmin[d] << ", " << dir
+          << "max=" << xmax << " in output block '" << blk << "' must be within Mesh"
+          << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    // default is number of cells at level over extent of grid
+    int nlev = (mesh_nx[d] > 1)? (mesh_nx[d] << level) : 1;
+    int ndef = std::max(1, static_cast<int>(std::lround(nlev*(xmax - xmin[d])/
+                                                        (mmax - mmin))));
+    nx[d] = pin->GetOrAddInteger(blk, "n" + dir, ndef);
+    if (nx[d] < 1 || (mesh_nx[d] == 1 && nx[d] > 1)) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+          << std::endl << "Uniform grid n" << dir << "=" << nx[d] << " in output block '"
+          << blk << "' must be >= 1, and 1 in unused dimensions" << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    dx[d] = (xmax - xmin[d])/static_cast<Real>(nx[d]);
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void UniformGridOutput::LoadOutputData()
+//! \brief Finds the box of cells of the uniform grid whose centers lie in each MeshBlock,
+//! and interpolates the output variables to them on the device.
+
+void UniformGridOutput::LoadOutputData(Mesh *pm) {
+  UpdateZ4cOutputVariables(pm);
+  if (out_params.contains_derived) {
+    ComputeDerivedVariable(out_params.variable, pm);
+  }
+
+  // logical coordinates of cell centers of uniform grid in each direction
+  std::vector<Real> xi[3];
+  for (int d=0; d<3; ++d) {
+    xi[d].resize(nx[d]);
+    for (int i=0; i<nx[d]; ++i) {
+      xi[d][i] = pm->stretch.Xi(d, xmin[d] + (static_cast<Real>(i) + 0.5)*dx[d]);
+    }
+  }
+
+  // box of grid cells in each MB, limits are [xmin,xmax) except at upper Mesh boundary
+  Real mesh_max[3] = {pm->mesh_size.x1max, pm->mesh_size.x2max, pm->mesh_size.x3max};
+  auto &size = pm->pmb_pack->pmb->mb_size;
+  int nmb = pm->pmb_pack->nmb_thispack;
+  if (boxes.extent_int(0) < nmb) {Kokkos::realloc(boxes, nmb, 8);}
+  nboxes = 0;
+  int npts = 0;
+  int nmax[3] = {0, 0, 0};
+  for (int m=0; m<nmb; ++m) {
+    Real mb_min[3] = {size.h_view(m).x1min, size.h_view(m).x2min, size.h_view(m).x3min};
+    Real mb_max[3] = {size.h_view(m).x1max, size.h_view(m).x2max, size.h_view(m).x3max};
+    int ib[3], nb[3];
+    for (int d=0; d<3; ++d) {
+      auto b = std::lower_bound(xi[d].begin(), xi[d].end(), mb_min[d]);
+      auto e = (mb_max[d] < mesh_max[d])?
+               std::lower_bound(xi[d].begin(), xi[d].end(), mb_max[d]) :
+               std::upper_bound(xi[d].begin(), xi[d].end(), mb_max[d]);
+      ib[d] = static_cast<int>(b - xi[d].begin());
+      nb[d] = std::max(0, static_cast<int>(e - b));
+    }
+    if (nb[0]*nb[1]*nb[2] == 0) continue;
+    boxes.h_view(nboxes,0) = m;
+    for (int d=0; d<3; ++d) {
+      boxes.h_view(nboxes,1+d) = ib[d];
+      boxes.h_view(nboxes,4+d) = nb[d];
+      nmax[d] = std::max(nmax[d], nb[d]);
+    }
+    boxes.h_view(nboxes,7) = npts;
+    npts += nb[0]*nb[1]*nb[2];
+    nboxes++;
+  }
+  boxes.template modify<HostMemSpace>();
+  boxes.template sync<DevExeSpace>();
+
+  nboxes_min = nboxes;
+  nboxes_max = nboxes;
+#if MPI_PARALLEL_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE, &nboxes_min, 1, MPI_INT, MPI_MIN,
+                global_variable::mpi_comm);
+  MPI_Allreduce(MPI_IN_PLACE, &nboxes_max, 1, MPI_INT, MPI_MAX,
+                global_variable::mpi_comm);
+#endif
+
+  int nout_vars = outvars.size();
+  if (d_vals.extent_int(0) != nout_vars || d_vals.extent_int(1) != npts) {
+    Kokkos::realloc(d_vals, nout_vars, npts);
+    vals = Kokkos::create_mirror_view(d_vals);
+  }
+  if (nboxes == 0) return;
+
+  // trilinear interpolation from the active cells of the MB, extrapolating linearly to
+  // grid cells within half a cell of MB faces (ghost cells of derived variables are not
+  // valid, and MB neighbors may be at different levels)
+  auto &indcs = pm->mb_indcs;
+  int is = indcs.is, js = indcs.js, ks = indcs.ks;
+  int nc1 = indcs.nx1, nc2 = indcs.nx2, nc3 = indcs.nx3;
+  auto stretch = pm->stretch;
+  Real x1g = xmin[0], x2g = xmin[1], x3g = xmin[2];
+  Real dx1g = dx[0], dx2g = dx[1], dx3g = dx[2];
+  auto &bx = boxes;
+  auto &dv = d_vals;
+  for (int n=0; n<nout_vars; ++n) {
+    auto &src = *(outvars[n].data_ptr);
+    int v = outvars[n].data_index;
+    par_for("ugrid_interp",DevExeSpace(),0,nboxes-1,0,nmax[2]-1,0,nmax[1]-1,0,nmax[0]-1,
+    KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+      int ni = bx.d_view(b,4), nj = bx.d_view(b,5), nk = bx.d_view(b,6);
+      if (i >= ni || j >= nj || k >= nk) return;
+      int m = bx.d_view(b,0);
+      const Real x[3] = {x1g + (bx.d_view(b,1) + i + 0.5)*dx1g,
+                         x2g + (bx.d_view(b,2) + j + 0.5)*dx2g,
+                         x3g + (bx.d_view(b,3) + k + 0.5)*dx3g};
+      const Real mb_min[3] = {size.d_view(m).x1min, size.d_view(m).x2min,
+                              size.d_view(m).x3min};
+      const Real mb_dx[3] = {size.d_view(m).dx1, size.d_view(m).dx2,
+                             size.d_view(m).dx3};
+      const int nc[3] = {nc1, nc2, nc3};
+      int i0[3], i1[3];
+      Real w[3];
+      for (int d=0; d<3; ++d) {
+        if (nc[d] > 1) {
+          Real s = (stretch.Xi(d, x[d]) - mb_min[d])/mb_dx[d] - 0.5;
+          i0[d] = static_cast<int>(fmin(fmax(floor(s), 0.0), nc[d] - 2.0));
+          i1[d] = i0[d] + 1;
+          w[d] = s - static_cast<Real>(i0[d]);
+        } else {
+          i0[d] = 0;
+          i1[d] = 0;
+          w[d] = 0.0;
+        }
+      }
+      Real val = 0.0;
+      for (int c=0; c<8; ++c) {
+        int ii = (c & 1)? i1[0] : i0[0];
+        int jj = (c & 2)? i1[1] : i0[1];
+        int kk = (c & 4)? i1[2] : i0[2];
+        Real wt = ((c & 1)? w[0] : 1.0 - w[0])*((c & 2)? w[1] : 1.0 - w[1])*
+                  ((c & 4)? w[2] : 1.0 - w[2]);
+        val += wt*src(m,v,ks+kk,js+jj,is+ii);
+      }
+      dv(n,bx.d_view(b,7) + i + ni*(j + nj*k)) = val;
+    });
+  }
+  Kokkos::deep_copy(vals, d_vals);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void UniformGridOutput:::WriteOutputFile(Mesh *pm)
+//! \brief Writes interpolated data in (legacy) vtk format, with the same header and data
+//! layout as MeshVTKOutput.  With MPI, the box of each MB is written to its place in the
+//! file through a subarray datatype.
+
+void UniformGridOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
+  int big_end = IsBigEndian(); // =1 on big endian machine
+  // create filename: "ugrid/file_basename"."file_id"."XXXXX".vtk
+  // where XXXXX = 5-digit file_number
+  std::string fname;
+  char number[6];
+  std::snprintf(number, sizeof(number), "%05d", out_params.file_number);
+  fname.assign("ugrid/");
+  fname.append(out_params.file_basename);
+  fname.append(".");
+  fname.append(out_params.file_id);
+  fname.append(".");
+  fname.append(number);
+  fname.append(".vtk");
+
+  int ncoord1 = (nx[0] > 1)? nx[0]+1 : nx[0];
+  int ncoord2 = (nx[1] > 1)? nx[1]+1 : nx[1];
+  int ncoord3 = (nx[2] > 1)? nx[2]+1 : nx[2];
+  std::size_t ncells = static_cast<std::size_t>(nx[0])*nx[1]*nx[2];
+
+  // Write parts 1-4 of header, as in vtk_mesh.cpp
+  std::stringstream msg;
+  msg << "# vtk DataFile Version 2.0" << std::endl
+      << "# Athena++ data at time= " << pm->time
+      << "  level= 0"
+      << "  nranks= " << global_variable::nranks
+      << "  cycle=" << pm->ncycle
+      << "  variables=" << out_params.variable
+      << std::endl << "BINARY" << std::endl
+      << "DATASET STRUCTURED_POINTS" << std::endl
+      << "DIMENSIONS " << ncoord1 << " " << ncoord2 << " " << ncoord3 << std::endl;
+  msg.seekp(0, std::ios_base::end);
+  msg << std::scientific << std::setprecision(std::numeric_limits<Real>::max_digits10 - 1)
+      << "ORIGIN " << xmin[0] << " " << xmin[1] << " " << xmin[2] << " " <<  std::endl
+      << "SPACING " << dx[0]  << " " << dx[1]   << " " << dx[2]   << " " <<  std::endl;
+  msg.seekp(0, std::ios_base::end);
+  msg << std::endl << "CELL_DATA " << ncells << std::endl;
+
+  int nout_vars = outvars.size();
+  bool parallel_write=false;
+#if MPI_PARALLEL_ENABLED
+  //----- WRITE IN PARALLEL WITH MPI: -----
+  if (global_variable::nranks > 1) {
+    MPI_File fh;
+    if (MPI_File_open(global_variable::mpi_comm, fname.c_str(),
+                      MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh)
+        != MPI_SUCCESS) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+        << std::endl << "Output file '" << fname << "' could not be opened" <<std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (global_variable::my_rank == 0) {
+      MPI_File_write(fh, msg.str().c_str(), msg.str().size(), MPI_BYTE,MPI_STATUS_IGNORE);
+    }
+    MPI_Offset header_size = msg.str().size();
+
+    // buffer of floats for data of largest box
+    int npts_max = 0;
+    for (int b=0; b<nboxes; ++b) {
+      npts_max = std::max(npts_max,
+          boxes.h_view(b,4)*boxes.h_view(b,5)*boxes.h_view(b,6));
+    }
+    std::vector<float> data(std::max(npts_max, 1));
+    int gridsize[3] = {nx[2], nx[1], nx[0]};
+
+    for (int n=0; n<nout_vars; ++n) {
+      std::stringstream data_msg;
+      data_msg << std::endl << "SCALARS " << outvars[n].label.c_str()
+               << " float" << std::endl
+               << "LOOKUP_TABLE default" << std::endl;
+      if (global_variable::my_rank == 0) {
+        MPI_File_write(fh, data_msg.str().c_str(), data_msg.str().size(),
+                          MPI_BYTE, MPI_STATUS_IGNORE);
+      }
+      header_size += data_msg.str().size();
+
+      // Loop over max number of boxes on any rank, so collective functions are called
+      // by all ranks
+      for (int b=0; b<nboxes_max; ++b) {
+        int npts = 0;
+        if (b < nboxes) {
+          int bsize[3] = {boxes.h_view(b,6), boxes.h_view(b,5), boxes.h_view(b,4)};
+          int bstrt[3] = {boxes.h_view(b,3), boxes.h_view(b,2), boxes.h_view(b,1)};
+          npts = bsize[0]*bsize[1]*bsize[2];
+          int off = boxes.h_view(b,7);
+          for (int p=0; p<npts; ++p) {
+            data[p] = static_cast<float>(vals(n,off + p));
+            if (!big_end) {Swap4Bytes(&data[p]);}
+          }
+          MPI_Datatype mygrid;
+          MPI_Type_create_subarray(3,gridsize,bsize,bstrt,MPI_ORDER_C,MPI_FLOAT,&mygrid);
+          MPI_Type_commit(&mygrid);
+          MPI_File_set_view(fh, header_size, MPI_FLOAT, mygrid, "native", MPI_INFO_NULL);
+          MPI_Type_free(&mygrid);
+        } else {
+          // file view function is a collective operation, so must be called by all ranks
+          MPI_File_set_view(fh, header_size, MPI_FLOAT, MPI_FLOAT, "native",
+                            MPI_INFO_NULL);
+        }
+        if (b < nboxes_min) {
+          MPI_File_write_all(fh, data.data(), npts, MPI_FLOAT, MPI_STATUS_IGNORE);
+        } else if (b < nboxes) {
+          MPI_File_write(fh, data.data(), npts, MPI_FLOAT, MPI_STATUS_IGNORE);
+        }
+      }
+
+      // reset view to stream of bytes in preparation for adding next data header
+      header_size += ncells*sizeof(float);
+      MPI_File_set_view(fh, header_size, MPI_BYTE, MPI_BYTE, "native", MPI_INFO_NULL);
+    }
+    MPI_File_close(&fh);
+    parallel_write=true;
+  }
+#endif
+  if (!(parallel_write)) {
+    //----- WRITE SERIAL FILES: -----
+    FILE *pfile;
+    if ((pfile = std::fopen(fname.c_str(),"w")) == nullptr) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+        << std::endl << "Output file '" << fname << "' could not be opened" <<std::endl;
+        exit(EXIT_FAILURE);
+    }
+    std::fprintf(pfile,"%s",msg.str().c_str());
+
+    std::vector<float> data(ncells);
+    for (int n=0; n<nout_vars; ++n) {
+      std::stringstream data_msg;
+      data_msg << std::endl << "SCALARS " << outvars[n].label.c_str()
+               << " float" << std::endl
+               << "LOOKUP_TABLE default" << std::endl;
+      std::fprintf(pfile,"%s",data_msg.str().c_str());
+
+      // insert boxes of all MeshBlocks into 3D array
+      for (int b=0; b<nboxes; ++b) {
+        int ni = boxes.h_view(b,4), nj = boxes.h_view(b,5), nk = boxes.h_view(b,6);
+        int off = boxes.h_view(b,7);
+        for (int k=0; k<nk; ++k) {
+          for (int j=0; j<nj; ++j) {
+            for (int i=0; i<ni; ++i) {
+              std::size_t indx = (boxes.h_view(b,1) + i) +
+                  nx[0]*((boxes.h_view(b,2) + j) +
+                  static_cast<std::size_t>(nx[1])*(boxes.h_view(b,3) + k));
+              data[indx] = static_cast<float>(vals(n,off + i + ni*(j + nj*k)));
+            }
+          }
+        }
+      }
+      if (!big_end) {
+        for (std::size_t i=0; i<ncells; ++i) { Swap4Bytes(&data[i]); }
+      }
+      std::fwrite(data.data(), sizeof(float), ncells, pfile);
+    }
+    std::fclose(pfile);
+  }
+
+  // increment counters
+  out_params.file_number++;
+  if (out_params.last_time < 0.0) {
+    out_params.last_time = pm->time;
+  } else {
+    out_params.last_time += out_params.dt;
+  }
+  pin->SetInteger(out_params.block_name, "file_number", out_params.file_number);
+  pin->SetReal(out_params.block_name, "last_time", out_params.last_time);
+
+  return;
+}
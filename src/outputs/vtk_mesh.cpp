@@ -145,8 +145,9 @@ void MeshVTKOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
   // open file and write file header
   if ((pm->nmb_total > 1) && (out_params.gid < 0)) {
     MPI_File fh;
-    if (MPI_File_open(MPI_COMM_WORLD, fname.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY,
-                      MPI_INFO_NULL, &fh) != MPI_SUCCESS) {
+    if (MPI_File_open(global_variable::mpi_comm, fname.c_str(),
+                      MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh)
+        != MPI_SUCCESS) {
       std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
         << std::endl << "Output file '" << fname << "' could not be opened" <<std::endl;
         exit(EXIT_FAILURE);
@@ -38,26 +38,58 @@ ParticleVTKOutput::ParticleVTKOutput(ParameterInput *pin, Mesh *pm, OutputParame
 
 //----------------------------------------------------------------------------------------
 // ParticleVTKOutput::LoadOutputData()
-// Copies real and integer particle data to host for outputs
+// Selects particles to be output on the device (skipping holes and, with prtcl_stride>1,
+// all particles whose tag is not a multiple of prtcl_stride), converts their positions
+// and integer data to floats in the order they are written to file, and copies only
+// these data to the host.  Offset of particles on this rank within file is computed with
+// MPI_Exscan of the number of particles output on each rank.
 
 void ParticleVTKOutput::LoadOutputData(Mesh *pm) {
   particles::Particles *pp = pm->pmb_pack->ppart;
-  npout_thisrank = pm->nprtcl_thisrank;
-  npout_total = pm->nprtcl_total;
-  Kokkos::realloc(outpart_rdata, pp->nrdata, npout_thisrank);
-  Kokkos::realloc(outpart_idata, pp->nidata, npout_thisrank);
-
-  // Create mirror view on device of host view of output particle real/int data
-  auto d_outpart_rdata = Kokkos::create_mirror_view(Kokkos::DefaultHostExecutionSpace(),
-                                                    outpart_rdata);
-  auto d_outpart_idata = Kokkos::create_mirror_view(Kokkos::DefaultHostExecutionSpace(),
-                                                    outpart_idata);
-  // Copy particle positions into device mirrors
-  Kokkos::deep_copy(d_outpart_rdata, pp->prtcl_rdata);
-  Kokkos::deep_copy(d_outpart_idata, pp->prtcl_idata);
-  // Copy particle positions from device mirror to host output array
-  Kokkos::deep_copy(outpart_rdata, d_outpart_rdata);
-  Kokkos::deep_copy(outpart_idata, d_outpart_idata);
+  int npart = pp->nprtcl_thispack;
+  int nidata = pp->nidata;
+  int stride = out_params.prtcl_stride;
+  bool &multi_d = pm->multi_d;
+  bool &three_d = pm->three_d;
+  float x2min = static_cast<float>(pm->mesh_size.x2min);
+  float x3min = static_cast<float>(pm->mesh_size.x3min);
+  auto &pr = pp->prtcl_rdata;
+  auto &pi = pp->prtcl_idata;
+
+  // list indices of particles to be output
+  int nout = 0;
+  DvceArray1D<int> index("out_index", std::max(npart,1));
+  Kokkos::parallel_scan("pout_index",Kokkos::RangePolicy<>(DevExeSpace(),0,npart),
+  KOKKOS_LAMBDA(const int p, int &n, const bool last_pass) {
+    if (pi(PGID,p) >= 0 && (pi(PTAG,p) % stride) == 0) {
+      if (last_pass) {index(n) = p;}
+      n++;
+    }
+  }, nout);
+
+  // load (x,y,z) of each particle, followed by each integer property of all particles
+  DvceArray1D<float> d_data("out_pdata", std::max((3 + nidata)*nout,1));
+  par_for("pout_load",DevExeSpace(),0,(nout-1),
+  KOKKOS_LAMBDA(const int n) {
+    int p = index(n);
+    d_data(3*n    ) = static_cast<float>(pr(IPX,p));
+    d_data(3*n + 1) = (multi_d)? static_cast<float>(pr(IPY,p)) : x2min;
+    d_data(3*n + 2) = (three_d)? static_cast<float>(pr(IPZ,p)) : x3min;
+    for (int i=0; i<nidata; ++i) {
+      d_data((3 + i)*nout + n) = static_cast<float>(pi(i,p));
+    }
+  });
+  Kokkos::realloc(outpart_data, d_data.extent(0));
+  Kokkos::deep_copy(outpart_data, d_data);
+
+  npout_thisrank = nout;
+  npout_offset = 0;
+  npout_total = nout;
+#if MPI_PARALLEL_ENABLED
+  MPI_Exscan(&nout, &npout_offset, 1, MPI_INT, MPI_SUM, global_variable::mpi_comm);
+  if (global_variable::my_rank == 0) {npout_offset = 0;}  // undefined on rank 0
+  MPI_Allreduce(&nout, &npout_total, 1, MPI_INT, MPI_SUM, global_variable::mpi_comm);
+#endif
 }
 
 //----------------------------------------------------------------------------------------
@@ -77,6 +109,7 @@ void ParticleVTKOutput::LoadOutputData(Mesh *pm) {
 
 void ParticleVTKOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
   int big_end = IsBigEndian(); // =1 on big endian machine
+  int nidata = pm->pmb_pack->ppart->nidata;
 
   // create filename: "vtk/file_basename"."file_id"."XXXXX".part.vtk
   // where XXXXX = 5-digit file_number
@@ -126,66 +159,32 @@ void ParticleVTKOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
     }
     header_offset += msg.str().size();
   }
-  // allocate 1D vector of floats used to convert and output particle data
-  float *data = new float[3*npout_thisrank];
-  // Loop over particles, load positions into data[]
-  for (int p=0; p<npout_thisrank; ++p) {
-    data[3*p] = static_cast<float>(outpart_rdata(IPX,p));
-    if (pm->multi_d) {
-      data[(3*p)+1] = static_cast<float>(outpart_rdata(IPY,p));
-    } else {
-      data[(3*p)+1] = static_cast<float>(pm->mesh_size.x2min);
-    }
-    if (pm->three_d) {
-      data[(3*p)+2] = static_cast<float>(outpart_rdata(IPZ,p));
-    } else {
-      data[(3*p)+2] = static_cast<float>(pm->mesh_size.x3min);
-    }
-  }
-  // swap data for this variable into big endian order
+  // swap data into big endian order
+  float *data = outpart_data.data();
   if (!big_end) {
-    for (int i=0; i<(3*npout_thisrank); ++i) { Swap4Bytes(&data[i]); }
-  }
-  // calculate local data offset
-  std::vector<int> rank_offset(global_variable::nranks, 0);
-  int npout_min = pm->nprtcl_eachrank[0];
-  for (int n=1; n<global_variable::nranks; ++n) {
-    rank_offset[n] = rank_offset[n-1] + pm->nprtcl_eachrank[n-1];
-    npout_min = std::min(npout_min, pm->nprtcl_eachrank[n]);
+    for (int i=0; i<((3 + nidata)*npout_thisrank); ++i) { Swap4Bytes(&data[i]); }
   }
 
-  // Write particle positions
+  // Write particle positions.  All ranks write their (contiguous) particles in a single
+  // collective write at the offset computed in LoadOutputData().
   {
     std::size_t datasize = sizeof(float);
-    std::size_t myoffset=header_offset + 3*rank_offset[global_variable::my_rank]*datasize;
-    // collective writes for minimum number of particles across ranks
-    if (partfile.Write_any_type_at_all(&(data[0]),3*npout_min,myoffset,"float")
-          != 3*npout_min) {
+    std::size_t myoffset = header_offset + 3*datasize*npout_offset;
+    if (partfile.Write_any_type_at_all(&(data[0]),3*npout_thisrank,myoffset,"float")
+          != 3*npout_thisrank) {
       std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
           << std::endl << "particle data not written correctly to vtk particle file, "
           << "vtk file is broken." << std::endl;
       exit(EXIT_FAILURE);
     }
-    // individual writes for remaining particles on each rank
-    myoffset += datasize*3*npout_min;
-    int nremain = pm->nprtcl_thisrank - npout_min;
-    if (nremain > 0) {
-      if (partfile.Write_any_type_at(&(data[3*npout_min]),3*nremain,myoffset,"float")
-            != 3*nremain) {
-        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-            << std::endl << "particle data not written correctly to vtk particle file, "
-            << "vtk file is broken." << std::endl;
-        exit(EXIT_FAILURE);
-      }
-    }
-    header_offset += 3*pm->nprtcl_total*datasize;
+    header_offset += 3*datasize*npout_total;
   }
 
   // Write Part 6: scalar particle data
   bool have_written_pointdata_header = false;
 
   // Write gid of points
-  for (int n=0; n<(pm->pmb_pack->ppart->nidata); ++n) {
+  for (int n=0; n<nidata; ++n) {
     std::stringstream msg;
 
     if (!have_written_pointdata_header) {
@@ -207,39 +206,17 @@ void ParticleVTKOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
 
     header_offset += msg.str().size();
 
-    // Loop over particles, load gid into data[]
-    for (int p=0; p<npout_thisrank; ++p) {
-      data[p] = static_cast<float>(outpart_idata(n,p));
-    }
-    // swap data for this variable into big endian order
-    if (!big_end) {
-      for (int i=0; i<npout_thisrank; ++i) { Swap4Bytes(&data[i]); }
-    }
-
-    // calculate local data offset and write gid
+    // write integer data of particles
     std::size_t datasize = sizeof(float);
-    std::size_t myoffset=header_offset + rank_offset[global_variable::my_rank]*datasize;
-    // collective writes for minimum number of particles across ranks
-    if (partfile.Write_any_type_at_all(&(data[0]),npout_min,myoffset,"float")
-          != npout_min) {
+    std::size_t myoffset = header_offset + datasize*npout_offset;
+    if (partfile.Write_any_type_at_all(&(data[(3 + n)*npout_thisrank]),npout_thisrank,
+                                       myoffset,"float") != npout_thisrank) {
       std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
           << std::endl << "particle data not written correctly to vtk particle file, "
           << "vtk file is broken." << std::endl;
       exit(EXIT_FAILURE);
     }
-    // individual writes for remaining particles on each rank
-    myoffset += datasize*npout_min;
-    int nremain = pm->nprtcl_thisrank - npout_min;
-    if (nremain > 0) {
-      if (partfile.Write_any_type_at(&(data[npout_min]),nremain,myoffset,"float")
-            != nremain) {
-        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-            << std::endl << "particle data not written correctly to vtk particle file, "
-            << "vtk file is broken." << std::endl;
-        exit(EXIT_FAILURE);
-      }
-    }
-    header_offset += pm->nprtcl_total*datasize;
+    header_offset += datasize*npout_total;
   }
 
   // Add output of vectors here with header:
@@ -248,7 +225,6 @@ void ParticleVTKOutput::WriteOutputFile(Mesh *pm, ParameterInput *pin) {
 
   // close the output file and clean up
   partfile.Close();
-  delete[] data;
 
   // increment counters
   out_params.file_number++;
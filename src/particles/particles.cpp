@@ -7,9 +7,12 @@
 //! \brief implementation of Particles class constructor and assorted other functions
 
 #include <iostream>
+#include <limits>
 #include <string>
 #include <algorithm>
 
+#include <Kokkos_Sort.hpp>
+
 #include "athena.hpp"
 #include "globals.hpp"
 #include "parameter_input.hpp"
@@ -58,6 +61,29 @@ Particles::Particles(MeshBlockPack *ppack, ParameterInput *pin) :
     std::string ppush = pin->GetString("particles","pusher");
     if (ppush.compare("drift") == 0) {
       pusher = ParticlesPusher::drift;
+    } else if (ppush.compare("leap_frog") == 0) {
+      pusher = ParticlesPusher::leap_frog;
+      if (pmy_pack->pmhd == nullptr) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "leap_frog particle pusher requires <mhd> block"
+                  << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+      // charge-to-mass ratio of particles, in code units
+      q_over_m = pin->GetOrAddReal("particles","q_over_m",1.0);
+    } else if (ppush.compare("lagrangian_tracer") == 0) {
+      pusher = ParticlesPusher::lagrangian_tracer;
+      if (pmy_pack->phydro == nullptr && pmy_pack->pmhd == nullptr) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "lagrangian_tracer particle pusher requires <hydro> "
+                  << "or <mhd> block" << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+    } else if (ppush.compare("lagrangian_mc") == 0) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "lagrangian_mc particle pusher is not implemented"
+                << std::endl;
+      std::exit(EXIT_FAILURE);
     } else {
       std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
                 << std::endl << "Particle pusher must be specified in <particles> block"
@@ -74,27 +100,83 @@ Particles::Particles(MeshBlockPack *ppack, ParameterInput *pin) :
   }
   switch (particle_type) {
     case ParticleType::cosmic_ray:
-      {
-        int ndim=4;
-        if (pmy_pack->pmesh->three_d) {ndim+=2;}
-        nrdata = ndim;
-        nidata = 2;
-        break;
+      if (pusher == ParticlesPusher::lagrangian_tracer) {
+        nrdata = PrtclAttributes<ParticlesPusher::lagrangian_tracer>::nrdata;
+        has_velocity = PrtclAttributes<ParticlesPusher::lagrangian_tracer>::velocity;
+      } else {
+        // drift and leap_frog pushers always evolve all three components of velocity
+        nrdata = PrtclAttributes<ParticlesPusher::drift>::nrdata;
+        has_velocity = PrtclAttributes<ParticlesPusher::drift>::velocity;
       }
+      nidata = 2;
+      break;
     default:
       break;
   }
   Kokkos::realloc(prtcl_rdata, nrdata, nprtcl_thispack);
   Kokkos::realloc(prtcl_idata, nidata, nprtcl_thispack);
 
+  // number of cycles between sorts of particles by cell (0 = never sort)
+  sort_interval = pin->GetOrAddInteger("particles","sort_interval",0);
+  // fraction of holes left by particles sent to other ranks that triggers compaction
+  nprtcl_holes = 0;
+  compact_fraction = pin->GetOrAddReal("particles","compact_fraction",0.1);
+
+  // sub-cycling of particle push with per-particle timesteps
+  subcycle = pin->GetOrAddBoolean("particles","subcycle",false);
+  if (subcycle) {
+    if (pusher != ParticlesPusher::leap_frog &&
+        pusher != ParticlesPusher::lagrangian_tracer) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<particles>/subcycle requires leap_frog or "
+                << "lagrangian_tracer pusher" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    max_substeps = pin->GetOrAddInteger("particles","max_substeps",32);
+    cfl_sub = pin->GetOrAddReal("particles","cfl_sub",0.2);
+    if (max_substeps < 1 || cfl_sub <= 0.0) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<particles>/max_substeps must be >= 1 and cfl_sub > 0"
+                << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    // velocity (and magnetic field with leap_frog) of fluid at start of step
+    int nfld = (pusher == ParticlesPusher::leap_frog)? 6 : 3;
+    int ncells1 = indcs.nx1 + 2*(indcs.ng);
+    int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
+    int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
+    Kokkos::realloc(fld_old, pmy_pack->nmb_thispack, nfld, ncells3, ncells2, ncells1);
+    // set from particle velocities by first push (may be overwritten by pgen)
+    dtnew = static_cast<Real>(std::numeric_limits<float>::max());
+  }
+
   // allocate boundary object
   pbval_part = new ParticlesBoundaryValues(this, pin);
+
+  // deposition of particle density and flux onto cells
+  deposit = pin->GetOrAddBoolean("particles","deposit",false);
+  pbval_dep = nullptr;
+  if (deposit) {
+    if (ppack->pmesh->multilevel) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Particle deposition is not supported with SMR/AMR"
+                << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    int nvd = (has_velocity)? 4 : 1;
+    pbval_dep = new MeshBoundaryValuesCC(ppack, pin, false);
+    pbval_dep->comm_module = comm_stats::Module::particles;
+    pbval_dep->InitializeBuffers(nvd);
+    // ghost zones are summed into neighbors through buffers, never copied directly
+    pbval_dep->direct_onrank_copy = false;
+  }
 }
 
 //----------------------------------------------------------------------------------------
 // destructor
 
 Particles::~Particles() {
+  if (pbval_dep != nullptr) {delete pbval_dep;}
 }
 
 //----------------------------------------------------------------------------------------
@@ -137,4 +219,144 @@ void Particles::CreateParticleTags(ParameterInput *pin) {
   }
 }
 
+//----------------------------------------------------------------------------------------
+// SortParticles()
+// Sorts particles on device, using Kokkos::BinSort keyed on MeshBlock and active cell
+// containing each particle, so particles in the same cell are contiguous in memory.
+// Also stores offset of first particle in each cell in prtcl_cell_offset.
+
+void Particles::SortParticles() {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int nx1 = indcs.nx1, nx2 = indcs.nx2, nx3 = indcs.nx3;
+  int nmb = pmy_pack->nmb_thispack;
+  int ncells = nmb*nx1*nx2*nx3;
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+  auto &mbsize = pmy_pack->pmb->mb_size;
+  auto &pi = prtcl_idata;
+  auto &pr = prtcl_rdata;
+  auto gids = pmy_pack->gids;
+  int npart = nprtcl_thispack;
+
+  if (static_cast<int>(prtcl_cell_offset.extent(0)) != ncells+1) {
+    Kokkos::realloc(prtcl_cell_offset, ncells+1);
+  }
+  auto &offset = prtcl_cell_offset;
+  if (npart == 0) {
+    Kokkos::deep_copy(offset, 0);
+    return;
+  }
+
+  // compute key = index of cell containing each particle.  Holes are put in an extra
+  // bin after all cells, so they are removed from the end of the sorted arrays.
+  DvceArray1D<int> keys("prtcl_keys", npart);
+  par_for("prtcl_keys",DevExeSpace(),0,(npart-1),
+  KOKKOS_LAMBDA(const int p) {
+    if (pi(PGID,p) < 0) {
+      keys(p) = ncells;
+      return;
+    }
+    int m = pi(PGID,p) - gids;
+    int ip = (pr(IPX,p) - mbsize.d_view(m).x1min)/mbsize.d_view(m).dx1;
+    ip = fmin(fmax(ip, 0), nx1-1);
+    int jp = 0, kp = 0;
+    if (multi_d) {
+      jp = (pr(IPY,p) - mbsize.d_view(m).x2min)/mbsize.d_view(m).dx2;
+      jp = fmin(fmax(jp, 0), nx2-1);
+    }
+    if (three_d) {
+      kp = (pr(IPZ,p) - mbsize.d_view(m).x3min)/mbsize.d_view(m).dx3;
+      kp = fmin(fmax(kp, 0), nx3-1);
+    }
+    keys(p) = ((m*nx3 + kp)*nx2 + jp)*nx1 + ip;
+  });
+
+  // bin particles by cell
+  using BinOp = Kokkos::BinOp1D<DvceArray1D<int>>;
+  BinOp binner(ncells+1, 0, ncells+1);
+  Kokkos::BinSort<DvceArray1D<int>, BinOp> sorter(keys, binner, false);
+  sorter.create_permute_vector();
+  auto perm = sorter.get_permute_vector();
+  auto bin_offsets = sorter.get_bin_offsets();
+
+  // permute particle data into new arrays (of the same capacity)
+  int capacity = prtcl_rdata.extent_int(1);
+  DvceArray2D<Real> new_rdata("prtcl_rdata", nrdata, capacity);
+  DvceArray2D<int>  new_idata("prtcl_idata", nidata, capacity);
+  int nrdata_ = nrdata, nidata_ = nidata;
+  par_for("prtcl_permute",DevExeSpace(),0,(npart-1),
+  KOKKOS_LAMBDA(const int p) {
+    int q = perm(p);
+    for (int n=0; n<nrdata_; ++n) {new_rdata(n,p) = pr(n,q);}
+    for (int n=0; n<nidata_; ++n) {new_idata(n,p) = pi(n,q);}
+  });
+  // offset of bin of holes (c=ncells) is number of particles
+  par_for("prtcl_offsets",DevExeSpace(),0,ncells,
+  KOKKOS_LAMBDA(const int c) {
+    offset(c) = bin_offsets(c);
+  });
+  prtcl_rdata = new_rdata;
+  prtcl_idata = new_idata;
+  nprtcl_thispack -= nprtcl_holes;
+  nprtcl_holes = 0;
+}
+
+//----------------------------------------------------------------------------------------
+// ReserveParticles()
+// Ensures particle arrays can hold at least npart particles.  Capacity grows by at least
+// a factor 1.5, so the cost of copying the data when arrays are resized is amortized.
+
+void Particles::ReserveParticles(int npart) {
+  int capacity = prtcl_rdata.extent_int(1);
+  if (npart <= capacity) return;
+  capacity = std::max(npart, capacity + capacity/2);
+  Kokkos::resize(prtcl_rdata, nrdata, capacity);
+  Kokkos::resize(prtcl_idata, nidata, capacity);
+}
+
+//----------------------------------------------------------------------------------------
+// CompactParticles()
+// Removes holes (PGID<0) from particle arrays in place.  The n holes in the first nlive
+// slots are filled with the n particles in the remaining slots, which are found with
+// prefix sums, so only O(nholes) data are moved and no arrays are reallocated.
+
+void Particles::CompactParticles() {
+  if (nprtcl_holes == 0) return;
+  int npart = nprtcl_thispack;
+  int nlive = npart - nprtcl_holes;
+  auto &pi = prtcl_idata;
+  auto &pr = prtcl_rdata;
+
+  // list holes in [0,nlive) and particles in [nlive,npart); their number (nmove) is
+  // equal, and at most the number of holes
+  int nmove = 0;
+  DvceArray1D<int> holes("prtcl_holes", nprtcl_holes);
+  DvceArray1D<int> moved("prtcl_moved", nprtcl_holes);
+  Kokkos::parallel_scan("prtcl_holes",Kokkos::RangePolicy<>(DevExeSpace(),0,nlive),
+  KOKKOS_LAMBDA(const int p, int &index, const bool last_pass) {
+    if (pi(PGID,p) < 0) {
+      if (last_pass) {holes(index) = p;}
+      index++;
+    }
+  }, nmove);
+  Kokkos::parallel_scan("prtcl_moved",Kokkos::RangePolicy<>(DevExeSpace(),nlive,npart),
+  KOKKOS_LAMBDA(const int p, int &index, const bool last_pass) {
+    if (pi(PGID,p) >= 0) {
+      if (last_pass) {moved(index) = p;}
+      index++;
+    }
+  });
+
+  // move particles into holes
+  int nrdata_ = nrdata, nidata_ = nidata;
+  par_for("prtcl_compact",DevExeSpace(),0,(nmove-1),
+  KOKKOS_LAMBDA(const int n) {
+    int dst = holes(n), src = moved(n);
+    for (int i=0; i<nrdata_; ++i) {pr(i,dst) = pr(i,src);}
+    for (int i=0; i<nidata_; ++i) {pi(i,dst) = pi(i,src);}
+  });
+  nprtcl_thispack = nlive;
+  nprtcl_holes = 0;
+}
+
 } // namespace particles
@@ -11,6 +11,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "athena.hpp"
 #include "parameter_input.hpp"
@@ -18,6 +19,7 @@
 #include "bvals/bvals.hpp"
 
 // forward declarations
+struct LogicalLocation;
 
 // constants that enumerate ParticlesPusher options
 enum class ParticlesPusher {drift, leap_frog, lagrangian_tracer, lagrangian_mc};
@@ -25,6 +27,24 @@ enum class ParticlesPusher {drift, leap_frog, lagrangian_tracer, lagrangian_mc};
 // constants that enumerate ParticleTypes
 enum class ParticleType {cosmic_ray};
 
+//----------------------------------------------------------------------------------------
+//! \struct PrtclAttributes
+//  \brief compile-time schema of the real attributes in prtcl_rdata moved by each pusher.
+//  All three components of position are always stored (also in 2D), velocities only by
+//  pushers that evolve them.  Lagrangian tracers move with the fluid velocity, so they
+//  store (and communicate) only their positions.
+
+template <ParticlesPusher P>
+struct PrtclAttributes {
+  static constexpr bool velocity = true;
+  static constexpr int nrdata = 6;
+};
+template <>
+struct PrtclAttributes<ParticlesPusher::lagrangian_tracer> {
+  static constexpr bool velocity = false;
+  static constexpr int nrdata = 3;
+};
+
 //----------------------------------------------------------------------------------------
 //! \struct ParticlesTaskIDs
 //  \brief container to hold TaskIDs of all particles tasks
@@ -38,6 +58,13 @@ struct ParticlesTaskIDs {
   TaskID recvp;
   TaskID csend;
   TaskID crecv;
+  TaskID sort;
+  TaskID irecvd;
+  TaskID dep;
+  TaskID sumd;
+  TaskID csendd;
+  TaskID crecvd;
+  TaskID savef;
 };
 
 namespace particles {
@@ -53,8 +80,15 @@ class Particles {
 
   // data
   ParticleType particle_type;
-  int nprtcl_thispack;             // number of particles this MeshBlockPack
+  int nprtcl_thispack;             // number of particle slots in use this MeshBlockPack
+  // Particle arrays have a capacity (their extent) that grows geometrically, and are not
+  // shrunk when particles leave.  Slots of particles sent to other ranks that are not
+  // refilled become holes (PGID<0) within [0,nprtcl_thispack), which are removed by
+  // CompactParticles() once they exceed compact_fraction of all slots.
+  int nprtcl_holes;
+  Real compact_fraction;
   int nrdata, nidata;
+  bool has_velocity;               // velocities (IPVX,IPVY,IPVZ) stored in prtcl_rdata
 //  DvceArray1D<int>  prtcl_gid;     // GID of MeshBlock containing each par
 //  DvceArray2D<Real> prtcl_pos;     // positions
 //  DvceArray2D<Real> prtcl_vel;     // velocities
@@ -62,7 +96,34 @@ class Particles {
   DvceArray2D<int>  prtcl_idata;   // integer properties each particle (gid, tag, etc.)
   Real dtnew;
 
+  // particles are sorted by MeshBlock and cell every sort_interval cycles (if > 0).
+  // After a sort the particles in active cell (m,k,j,i) are those with indices in
+  // [prtcl_cell_offset(c), prtcl_cell_offset(c+1)), with c=((m*nx3 + k)*nx2 + j)*nx1 + i
+  // and (k,j,i) counted from the first active cell.  Valid until particles next move.
+  int sort_interval;
+  DvceArray1D<int> prtcl_cell_offset;
+
+  // With deposit=true, the number density n (and flux density n*v of particles with
+  // velocities) of particles is deposited every cycle after they are sorted into
+  // dep(m,n,k,j,i), with n = 0 (density) and 1,2,3 (flux) and cells including ghosts.
+  // Deposits into ghost zones are added to the neighbors with boundary buffers pbval_dep.
+  bool deposit;
+  DvceArray5D<Real> dep;
+  MeshBoundaryValuesCC *pbval_dep;
+
   ParticlesPusher pusher;
+  Real q_over_m;                   // charge-to-mass ratio (leap_frog pusher)
+
+  // With subcycle=true, particles are pushed after the fluid step with up to
+  // max_substeps substeps of their own dt (limited by cfl_sub times the cell crossing
+  // time, and gyration period with leap_frog), using fields interpolated in time between
+  // those at the start of the step (saved in fld_old) and the end of the step.  dtnew
+  // then only limits the distance particles travel beyond their MeshBlock in one step to
+  // the ghost zones of the fluid, so particles are communicated once per step.
+  bool subcycle;
+  int max_substeps;
+  Real cfl_sub;
+  DvceArray5D<Real> fld_old;
 
   // Boundary communication buffers and functions for particles
   ParticlesBoundaryValues *pbval_part;
@@ -72,8 +133,19 @@ class Particles {
 
   // functions...
   void CreateParticleTags(ParameterInput *pin);
+  void SortParticles();
+  void ReserveParticles(int npart);
+  void CompactParticles();
+  void DepositParticles();
+  // functions used to move particles with their MeshBlocks during AMR/load balancing
+  void CountParticlesEachMB(std::vector<int> &count);
+  void SetGIDsForNewMesh(const int *oldtonew, const LogicalLocation *new_lloc,
+                         int new_nmb, std::vector<int> &count);
+  void RedistributeParticles(const int *rank_eachmb);
   void AssembleTasks(std::map<std::string, std::shared_ptr<TaskList>> tl);
   TaskStatus Push(Driver *pdriver, int stage);
+  TaskStatus PushSubcycled(Driver *pdriver, int stage);
+  TaskStatus SaveFields(Driver *pdriver, int stage);
   TaskStatus NewGID(Driver *pdriver, int stage);
   TaskStatus SendCnt(Driver *pdriver, int stage);
   TaskStatus InitRecv(Driver *pdriver, int stage);
@@ -81,6 +153,12 @@ class Particles {
   TaskStatus RecvP(Driver *pdriver, int stage);
   TaskStatus ClearSend(Driver *pdriver, int stage);
   TaskStatus ClearRecv(Driver *pdriver, int stage);
+  TaskStatus SortP(Driver *pdriver, int stage);
+  TaskStatus InitRecvDep(Driver *pdriver, int stage);
+  TaskStatus Deposit(Driver *pdriver, int stage);
+  TaskStatus SumDep(Driver *pdriver, int stage);
+  TaskStatus ClearSendDep(Driver *pdriver, int stage);
+  TaskStatus ClearRecvDep(Driver *pdriver, int stage);
 
  private:
   MeshBlockPack* pmy_pack;  // ptr to MeshBlockPack containing this Particles
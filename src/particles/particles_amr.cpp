@@ -0,0 +1,215 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file particles_amr.cpp
+//! \brief functions used to include particles in load balancing, and to move particles
+//! with their MeshBlocks when the mesh is refined and/or redistributed across ranks.
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <Kokkos_Sort.hpp>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "mesh/mesh.hpp"
+#include "bvals/bvals.hpp"
+#include "particles.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
+namespace particles {
+//----------------------------------------------------------------------------------------
+//! \fn void Particles::CountParticlesEachMB()
+//! \brief Counts particles in every MeshBlock.  On return count[gid] is the number of
+//! particles in MeshBlock gid, for all MeshBlocks on all ranks.
+
+void Particles::CountParticlesEachMB(std::vector<int> &count) {
+  Mesh *pm = pmy_pack->pmesh;
+  int nmb = pmy_pack->nmb_thispack;
+  int gids = pmy_pack->gids;
+  auto &pi = prtcl_idata;
+
+  DvceArray1D<int> d_count("nprtcl_mb", nmb);
+  par_for("prtcl_count",DevExeSpace(),0,(nprtcl_thispack-1),
+  KOKKOS_LAMBDA(const int p) {
+    if (pi(PGID,p) < 0) return;  // skip holes
+    Kokkos::atomic_add(&d_count(pi(PGID,p) - gids), 1);
+  });
+  auto h_count = Kokkos::create_mirror_view_and_copy(HostMemSpace(), d_count);
+
+  count.assign(pm->nmb_total, 0);
+  for (int m=0; m<nmb; ++m) {count[gids + m] = h_count(m);}
+#if MPI_PARALLEL_ENABLED
+  MPI_Allgatherv(MPI_IN_PLACE, nmb, MPI_INT, count.data(), pm->nmb_eachrank,
+                 pm->gids_eachrank, MPI_INT, global_variable::mpi_comm);
+#endif
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Particles::SetGIDsForNewMesh()
+//! \brief Sets PGID of every particle to the gid of the MeshBlock containing it in the
+//! new (refined/derefined) Mesh, given the map oldtonew from old to new gids and the
+//! logical locations new_lloc of all new_nmb new MeshBlocks.  Particles in a refined
+//! MeshBlock are assigned to its child in the octant containing them.  Must be called
+//! while the MeshBlocks (and their sizes) of the old Mesh still exist.  On return
+//! count[gid] is the number of particles in new MeshBlock gid, for all new MeshBlocks.
+
+void Particles::SetGIDsForNewMesh(const int *oldtonew, const LogicalLocation *new_lloc,
+                                  int new_nmb, std::vector<int> &count) {
+  Mesh *pm = pmy_pack->pmesh;
+  int nmb = pmy_pack->nmb_thispack;
+  int gids = pmy_pack->gids;
+  int nleaf = 2;
+  if (pm->two_d) nleaf = 4;
+  if (pm->three_d) nleaf = 8;
+
+  // new gid of MeshBlock containing particles in each octant of old MBs on this rank
+  DualArray2D<int> newgid("prtcl_newgid", nmb, 8);
+  for (int m=0; m<nmb; ++m) {
+    int oldm = gids + m;
+    int newm = oldtonew[oldm];
+    for (int l=0; l<8; ++l) {newgid.h_view(m,l) = newm;}
+    if (new_lloc[newm].level > pm->lloc_eachmb[oldm].level) {  // old MB was refined
+      for (int l=0; l<nleaf; ++l) {
+        const LogicalLocation &lloc = new_lloc[newm + l];
+        int oct = (lloc.lx1 & 1) + 2*(lloc.lx2 & 1) + 4*(lloc.lx3 & 1);
+        newgid.h_view(m,oct) = newm + l;
+      }
+    }
+  }
+  newgid.template modify<HostMemSpace>();
+  newgid.template sync<DevExeSpace>();
+
+  bool &multi_d = pm->multi_d;
+  bool &three_d = pm->three_d;
+  auto &mbsize = pmy_pack->pmb->mb_size;
+  auto &pi = prtcl_idata;
+  auto &pr = prtcl_rdata;
+  DvceArray1D<int> d_count("nprtcl_newmb", new_nmb);
+  par_for("prtcl_newgid",DevExeSpace(),0,(nprtcl_thispack-1),
+  KOKKOS_LAMBDA(const int p) {
+    if (pi(PGID,p) < 0) return;  // skip holes
+    int m = pi(PGID,p) - gids;
+    int oct = 0;
+    if (pr(IPX,p) >= 0.5*(mbsize.d_view(m).x1min + mbsize.d_view(m).x1max)) {oct += 1;}
+    if (multi_d &&
+        pr(IPY,p) >= 0.5*(mbsize.d_view(m).x2min + mbsize.d_view(m).x2max)) {oct += 2;}
+    if (three_d &&
+        pr(IPZ,p) >= 0.5*(mbsize.d_view(m).x3min + mbsize.d_view(m).x3max)) {oct += 4;}
+    int gid = newgid.d_view(m,oct);
+    pi(PGID,p) = gid;
+    Kokkos::atomic_add(&d_count(gid), 1);
+  });
+  auto h_count = Kokkos::create_mirror_view_and_copy(HostMemSpace(), d_count);
+
+  count.resize(new_nmb);
+  for (int m=0; m<new_nmb; ++m) {count[m] = h_count(m);}
+#if MPI_PARALLEL_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE, count.data(), new_nmb, MPI_INT, MPI_SUM,
+                global_variable::mpi_comm);
+#endif
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Particles::RedistributeParticles()
+//! \brief Moves particles to the rank owning their MeshBlock after the Mesh has been
+//! redistributed, given the rank of each MeshBlock.  PGID must already be set to gids in
+//! the new Mesh by SetGIDsForNewMesh().  Particles are binned by destination rank on the
+//! device and exchanged with a single MPI_Alltoallv (which also copies particles staying
+//! on this rank), so the particle arrays on return contain no holes.
+
+void Particles::RedistributeParticles(const int *rank_eachmb) {
+#if MPI_PARALLEL_ENABLED
+  Mesh *pm = pmy_pack->pmesh;
+  int nranks = global_variable::nranks;
+  int npart = nprtcl_thispack;
+  auto &pi = prtcl_idata;
+  auto &pr = prtcl_rdata;
+
+  // destination rank of each particle.  Holes are put in an extra bin after all ranks.
+  DualArray1D<int> rank_mb("rank_eachmb", pm->nmb_total);
+  for (int m=0; m<pm->nmb_total; ++m) {rank_mb.h_view(m) = rank_eachmb[m];}
+  rank_mb.template modify<HostMemSpace>();
+  rank_mb.template sync<DevExeSpace>();
+  DvceArray1D<int> keys("prtcl_dest", std::max(npart,1));
+  Kokkos::deep_copy(keys, nranks);
+  par_for("prtcl_dest",DevExeSpace(),0,(npart-1),
+  KOKKOS_LAMBDA(const int p) {
+    keys(p) = (pi(PGID,p) < 0)? nranks : rank_mb.d_view(pi(PGID,p));
+  });
+
+  // bin particles by destination rank, and pack send buffers in order of rank
+  using BinOp = Kokkos::BinOp1D<DvceArray1D<int>>;
+  BinOp binner(nranks+1, 0, nranks+1);
+  Kokkos::BinSort<DvceArray1D<int>, BinOp> sorter(keys, binner, false);
+  sorter.create_permute_vector();
+  auto perm = sorter.get_permute_vector();
+  auto h_nsend = Kokkos::create_mirror_view_and_copy(HostMemSpace(),
+                                                     sorter.get_bin_count());
+  int nsend = keys.extent_int(0) - h_nsend(nranks);
+  int nrdata_ = nrdata, nidata_ = nidata;
+  DvceArray1D<Real> rsendbuf("prtcl_rsend", std::max(nrdata_*nsend,1));
+  DvceArray1D<int>  isendbuf("prtcl_isend", std::max(nidata_*nsend,1));
+  par_for("prtcl_pack",DevExeSpace(),0,(nsend-1),
+  KOKKOS_LAMBDA(const int n) {
+    int p = perm(n);
+    for (int i=0; i<nrdata_; ++i) {rsendbuf(nrdata_*n + i) = pr(i,p);}
+    for (int i=0; i<nidata_; ++i) {isendbuf(nidata_*n + i) = pi(i,p);}
+  });
+
+  // exchange number of particles sent to each rank
+  std::vector<int> nsend_eachrank(nranks), nrecv_eachrank(nranks);
+  for (int n=0; n<nranks; ++n) {nsend_eachrank[n] = h_nsend(n);}
+  MPI_Alltoall(nsend_eachrank.data(), 1, MPI_INT, nrecv_eachrank.data(), 1, MPI_INT,
+               pbval_part->mpi_comm_part);
+  int nrecv = 0;
+  for (int n=0; n<nranks; ++n) {nrecv += nrecv_eachrank[n];}
+
+  // exchange particle data, first Reals and then ints
+  DvceArray1D<Real> rrecvbuf("prtcl_rrecv", std::max(nrdata_*nrecv,1));
+  DvceArray1D<int>  irecvbuf("prtcl_irecv", std::max(nidata_*nrecv,1));
+  std::vector<int> scnt(nranks), sdsp(nranks), rcnt(nranks), rdsp(nranks);
+  auto set_counts = [&](int ndata) {
+    for (int n=0; n<nranks; ++n) {
+      scnt[n] = ndata*nsend_eachrank[n];
+      rcnt[n] = ndata*nrecv_eachrank[n];
+      sdsp[n] = (n == 0)? 0 : sdsp[n-1] + scnt[n-1];
+      rdsp[n] = (n == 0)? 0 : rdsp[n-1] + rcnt[n-1];
+    }
+  };
+  Kokkos::fence();
+  set_counts(nrdata_);
+  MPI_Alltoallv(rsendbuf.data(), scnt.data(), sdsp.data(), MPI_ATHENA_REAL,
+                rrecvbuf.data(), rcnt.data(), rdsp.data(), MPI_ATHENA_REAL,
+                pbval_part->mpi_comm_part);
+  set_counts(nidata_);
+  MPI_Alltoallv(isendbuf.data(), scnt.data(), sdsp.data(), MPI_INT,
+                irecvbuf.data(), rcnt.data(), rdsp.data(), MPI_INT,
+                pbval_part->mpi_comm_part);
+
+  // unpack received particles into particle arrays, which are overwritten
+  ReserveParticles(nrecv);
+  par_for("prtcl_unpack",DevExeSpace(),0,(nrecv-1),
+  KOKKOS_LAMBDA(const int n) {
+    for (int i=0; i<nrdata_; ++i) {pr(i,n) = rrecvbuf(nrdata_*n + i);}
+    for (int i=0; i<nidata_; ++i) {pi(i,n) = irecvbuf(nidata_*n + i);}
+  });
+  nprtcl_thispack = nrecv;
+  nprtcl_holes = 0;
+
+  pm->nprtcl_thisrank = nrecv;
+  MPI_Allgather(&nrecv, 1, MPI_INT, pm->nprtcl_eachrank, 1, MPI_INT,
+                global_variable::mpi_comm);
+#endif
+  return;
+}
+
+} // namespace particles
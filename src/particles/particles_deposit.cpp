@@ -0,0 +1,129 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file particles_deposit.cpp
+//! \brief deposition of the number density and number flux density of particles onto
+//! cells, used to couple particles (e.g. cosmic rays) back to the fluid
+
+#include <algorithm>
+#include <iostream>
+
+#include "athena.hpp"
+#include "mesh/mesh.hpp"
+#include "bvals/bvals.hpp"
+#include "particles.hpp"
+
+namespace particles {
+//----------------------------------------------------------------------------------------
+//! \fn void Particles::DepositParticles()
+//! \brief Deposits n (and n*v for particles with velocities) of all particles in each
+//! cell with cloud-in-cell (linear) weights into dep, including the first layer of ghost
+//! zones.  Particles must be sorted by cell.  One team handles the particles in a row of
+//! cells (m,k,j), accumulating the rows they touch in a tile in team scratch memory with
+//! fast scratch atomics, and then flushes the non-zero tile entries to dep, so that
+//! global atomics only resolve overlaps between neighboring rows.  Contributions to
+//! ghost zones are added to neighbors by PackAndSendGhostSumCC()/RecvAndSumGhostCC().
+
+void Particles::DepositParticles() {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, js = indcs.js, ks = indcs.ks;
+  int nx1 = indcs.nx1, nx2 = indcs.nx2, nx3 = indcs.nx3;
+  int nmb = pmy_pack->nmb_thispack;
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+  auto &mbsize = pmy_pack->pmb->mb_size;
+  auto &pr = prtcl_rdata;
+  auto &offset = prtcl_cell_offset;
+  int nvd = (has_velocity)? 4 : 1;
+
+  if (dep.extent_int(0) != nmb) {
+    int n1 = nx1 + 2*indcs.ng;
+    int n2 = (multi_d)? (nx2 + 2*indcs.ng) : 1;
+    int n3 = (three_d)? (nx3 + 2*indcs.ng) : 1;
+    Kokkos::realloc(dep, nmb, nvd, n3, n2, n1);
+  }
+  Kokkos::deep_copy(DevExeSpace(), dep, 0.0);
+  if (nprtcl_thispack == 0) return;
+
+  // tile of (nvd, dk, dj, i) covers rows j-1..j+1 (and planes k-1..k+1 in 3D) of the
+  // cells [is-1,ie+1] touched by particles in row (k,j)
+  int nt3 = (three_d)? 3 : 1;
+  int nt1 = nx1 + 2;
+  int ntile = nvd*nt3*3*nt1;
+  size_t scr_size = ScrArray1D<Real>::shmem_size(ntile);
+  auto d = dep;
+  par_for_outer("prtcl_deposit", DevExeSpace(), scr_size, 0, 0, (nmb-1), 0, (nx3-1),
+                0, (nx2-1),
+  KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+    ScrArray1D<Real> tile(member.team_scratch(0), ntile);
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(member, ntile), [&](const int n) {
+      tile(n) = 0.0;
+    });
+    member.team_barrier();
+
+    Real dx1 = mbsize.d_view(m).dx1, dx2 = mbsize.d_view(m).dx2;
+    Real dx3 = mbsize.d_view(m).dx3;
+    Real wgt = 1.0/(dx1*dx2*dx3);
+    int c0 = ((m*nx3 + k)*nx2 + j)*nx1;
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(member, offset(c0), offset(c0+nx1)),
+    [&](const int p) {
+      // lower cell of the CIC stencil (relative to the first active cell) and weights
+      Real xi = (pr(IPX,p) - mbsize.d_view(m).x1min)/dx1 - 0.5;
+      int i0 = static_cast<int>(Kokkos::floor(xi));
+      i0 = Kokkos::min(Kokkos::max(i0, -1), nx1-1);
+      Real fx = Kokkos::min(Kokkos::max(xi - i0, 0.0), 1.0);
+      int j0 = 0, k0 = 0;
+      Real fy = 0.0, fz = 0.0;
+      if (multi_d) {
+        Real xj = (pr(IPY,p) - mbsize.d_view(m).x2min)/dx2 - 0.5;
+        j0 = Kokkos::min(Kokkos::max(static_cast<int>(Kokkos::floor(xj)), j-1), j);
+        fy = Kokkos::min(Kokkos::max(xj - j0, 0.0), 1.0);
+        j0 -= j - 1;
+      }
+      if (three_d) {
+        Real xk = (pr(IPZ,p) - mbsize.d_view(m).x3min)/dx3 - 0.5;
+        k0 = Kokkos::min(Kokkos::max(static_cast<int>(Kokkos::floor(xk)), k-1), k);
+        fz = Kokkos::min(Kokkos::max(xk - k0, 0.0), 1.0);
+        k0 -= k - 1;
+      }
+      Real q[4] = {wgt, 0.0, 0.0, 0.0};
+      if (nvd > 1) {
+        q[1] = wgt*pr(IPVX,p);
+        q[2] = wgt*pr(IPVY,p);
+        q[3] = wgt*pr(IPVZ,p);
+      }
+      for (int dk=0; dk<=((three_d)? 1 : 0); ++dk) {
+        Real wz = (three_d)? ((dk == 0)? (1.0 - fz) : fz) : 1.0;
+        for (int dj=0; dj<=((multi_d)? 1 : 0); ++dj) {
+          Real wy = (multi_d)? ((dj == 0)? (1.0 - fy) : fy) : 1.0;
+          for (int di=0; di<=1; ++di) {
+            Real w = wz*wy*((di == 0)? (1.0 - fx) : fx);
+            int t = ((k0 + dk)*3 + (j0 + dj))*nt1 + (i0 + di + 1);
+            for (int v=0; v<nvd; ++v) {
+              Kokkos::atomic_add(&tile(v*nt3*3*nt1 + t), w*q[v]);
+            }
+          }
+        }
+      }
+    });
+    member.team_barrier();
+
+    // flush tile to dep
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(member, ntile), [&](const int n) {
+      if (tile(n) != 0.0) {
+        int v = n/(nt3*3*nt1);
+        int t = n - v*(nt3*3*nt1);
+        int tk = t/(3*nt1);
+        int tj = (t - tk*3*nt1)/nt1;
+        int ti = t - (tk*3 + tj)*nt1;
+        int kk = (three_d)? (ks + k - 1 + tk) : ks;
+        int jj = (multi_d)? (js + j - 1 + tj) : js;
+        Kokkos::atomic_add(&d(m,v,kk,jj,is - 1 + ti), tile(n));
+      }
+    });
+  });
+}
+
+} // namespace particles
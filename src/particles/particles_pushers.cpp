@@ -4,19 +4,64 @@
 // Licensed under the 3-clause BSD License (the "LICENSE")
 //========================================================================================
 //! \file particle_pushers.cpp
-//  \brief
+//  \brief functions that update particle positions (and velocities) each cycle.  Fields
+//  needed by the pushers are interpolated to the particle positions inside the same
+//  kernel as the push, so each pusher is a single kernel over particles.  When particles
+//  are sorted by cell (see Particles::SortParticles()) neighboring threads load the same
+//  stencil of cells.
+
+#include <algorithm>
+#include <limits>
 
 #include "athena.hpp"
 #include "mesh/mesh.hpp"
+#include "bvals/bvals.hpp"
 #include "driver/driver.hpp"
+#include "hydro/hydro.hpp"
+#include "mhd/mhd.hpp"
 #include "particles.hpp"
 
 namespace particles {
+//----------------------------------------------------------------------------------------
+//! \fn Real InterpolateCC()
+//  \brief Trilinear (bilinear in 2D) interpolation of cell-centered variable n in array
+//  a of MeshBlock m to the position with fractional cell-center index (fx,fy,fz),
+//  measured from the first active cell.  Uses one layer of ghost zones.
+
+KOKKOS_INLINE_FUNCTION
+Real InterpolateCC(const DvceArray5D<Real> &a, int m, int n, Real fx, Real fy, Real fz,
+                   int is, int js, int ks, bool three_d) {
+  int i0 = static_cast<int>(Kokkos::floor(fx));
+  int j0 = static_cast<int>(Kokkos::floor(fy));
+  Real wx = fx - i0, wy = fy - j0;
+  i0 += is;
+  j0 += js;
+  Real val = (1.0-wy)*((1.0-wx)*a(m,n,ks,j0  ,i0) + wx*a(m,n,ks,j0  ,i0+1)) +
+                  wy *((1.0-wx)*a(m,n,ks,j0+1,i0) + wx*a(m,n,ks,j0+1,i0+1));
+  if (three_d) {
+    int k0 = static_cast<int>(Kokkos::floor(fz));
+    Real wz = fz - k0;
+    k0 += ks;
+    Real v0 = (1.0-wy)*((1.0-wx)*a(m,n,k0  ,j0  ,i0) + wx*a(m,n,k0  ,j0  ,i0+1)) +
+                  wy *((1.0-wx)*a(m,n,k0  ,j0+1,i0) + wx*a(m,n,k0  ,j0+1,i0+1));
+    Real v1 = (1.0-wy)*((1.0-wx)*a(m,n,k0+1,j0  ,i0) + wx*a(m,n,k0+1,j0  ,i0+1)) +
+                  wy *((1.0-wx)*a(m,n,k0+1,j0+1,i0) + wx*a(m,n,k0+1,j0+1,i0+1));
+    val = (1.0-wz)*v0 + wz*v1;
+  }
+  return val;
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn  void Particles::ParticlesPush
-//  \brief
+//  \brief Updates particles with the selected pusher:
+//   drift:             x += 0.5*dt*v with constant v
+//   lagrangian_tracer: x moves with fluid velocity (interpolated from w0) using a
+//                      second-order midpoint step.  Tracers store only positions.
+//   leap_frog:         Boris push of charged particles in ideal MHD fields, with
+//                      E = -u x B interpolated at the half-step position.
 
 TaskStatus Particles::Push(Driver *pdriver, int stage) {
+  if (subcycle) {return PushSubcycled(pdriver, stage);}
   auto &indcs = pmy_pack->pmesh->mb_indcs;
   int is = indcs.is;
   int js = indcs.js;
@@ -34,6 +79,7 @@ TaskStatus Particles::Push(Driver *pdriver, int stage) {
 
       par_for("part_update",DevExeSpace(),0,(nprtcl_thispack-1),
       KOKKOS_LAMBDA(const int p) {
+        if (pi(PGID,p) < 0) return;  // skip holes
         int m = pi(PGID,p) - gids;
         int ip = (pr(IPX,p) - mbsize.d_view(m).x1min)/mbsize.d_view(m).dx1 + is;
         pr(IPX,p) += 0.5*dt_*pr(IPVX,p);
@@ -50,10 +96,274 @@ TaskStatus Particles::Push(Driver *pdriver, int stage) {
       });
 
     break;
+    case ParticlesPusher::lagrangian_tracer:
+      {
+      auto &w0 = (pmy_pack->phydro != nullptr)? pmy_pack->phydro->w0 :
+                                                 pmy_pack->pmhd->w0;
+      par_for("part_tracer",DevExeSpace(),0,(nprtcl_thispack-1),
+      KOKKOS_LAMBDA(const int p) {
+        if (pi(PGID,p) < 0) return;  // skip holes
+        int m = pi(PGID,p) - gids;
+        Real &dx1 = mbsize.d_view(m).dx1;
+        Real &dx2 = mbsize.d_view(m).dx2;
+        Real &dx3 = mbsize.d_view(m).dx3;
+        Real x = pr(IPX,p), y = pr(IPY,p), z = (three_d)? pr(IPZ,p) : 0.0;
+
+        // velocity at start of step
+        Real fx = (x - mbsize.d_view(m).x1min)/dx1 - 0.5;
+        Real fy = (y - mbsize.d_view(m).x2min)/dx2 - 0.5;
+        Real fz = (z - mbsize.d_view(m).x3min)/dx3 - 0.5;
+        Real vx = InterpolateCC(w0, m, IVX, fx, fy, fz, is, js, ks, three_d);
+        Real vy = InterpolateCC(w0, m, IVY, fx, fy, fz, is, js, ks, three_d);
+        Real vz = InterpolateCC(w0, m, IVZ, fx, fy, fz, is, js, ks, three_d);
+
+        // velocity at midpoint
+        fx += 0.5*dt_*vx/dx1;
+        fy += 0.5*dt_*vy/dx2;
+        fz += 0.5*dt_*vz/dx3;
+        vx = InterpolateCC(w0, m, IVX, fx, fy, fz, is, js, ks, three_d);
+        vy = InterpolateCC(w0, m, IVY, fx, fy, fz, is, js, ks, three_d);
+        vz = InterpolateCC(w0, m, IVZ, fx, fy, fz, is, js, ks, three_d);
+
+        pr(IPX,p) = x + dt_*vx;
+        pr(IPY,p) = y + dt_*vy;
+        if (three_d) {
+          pr(IPZ,p) = z + dt_*vz;
+        }
+      });
+      }
+    break;
+    case ParticlesPusher::leap_frog:
+      {
+      auto &w0 = pmy_pack->pmhd->w0;
+      auto &bcc0 = pmy_pack->pmhd->bcc0;
+      Real qom = q_over_m;
+      par_for("part_leapfrog",DevExeSpace(),0,(nprtcl_thispack-1),
+      KOKKOS_LAMBDA(const int p) {
+        if (pi(PGID,p) < 0) return;  // skip holes
+        int m = pi(PGID,p) - gids;
+        Real &dx1 = mbsize.d_view(m).dx1;
+        Real &dx2 = mbsize.d_view(m).dx2;
+        Real &dx3 = mbsize.d_view(m).dx3;
+
+        // drift to half step
+        Real vx = pr(IPVX,p), vy = pr(IPVY,p), vz = pr(IPVZ,p);
+        Real x = pr(IPX,p) + 0.5*dt_*vx;
+        Real y = pr(IPY,p) + 0.5*dt_*vy;
+        Real z = (three_d)? (pr(IPZ,p) + 0.5*dt_*vz) : 0.0;
+
+        // interpolate fluid velocity and magnetic field, and compute E = -u x B
+        Real fx = (x - mbsize.d_view(m).x1min)/dx1 - 0.5;
+        Real fy = (y - mbsize.d_view(m).x2min)/dx2 - 0.5;
+        Real fz = (z - mbsize.d_view(m).x3min)/dx3 - 0.5;
+        Real ux = InterpolateCC(w0, m, IVX, fx, fy, fz, is, js, ks, three_d);
+        Real uy = InterpolateCC(w0, m, IVY, fx, fy, fz, is, js, ks, three_d);
+        Real uz = InterpolateCC(w0, m, IVZ, fx, fy, fz, is, js, ks, three_d);
+        Real bx = InterpolateCC(bcc0, m, IBX, fx, fy, fz, is, js, ks, three_d);
+        Real by = InterpolateCC(bcc0, m, IBY, fx, fy, fz, is, js, ks, three_d);
+        Real bz = InterpolateCC(bcc0, m, IBZ, fx, fy, fz, is, js, ks, three_d);
+        Real ex = -(uy*bz - uz*by);
+        Real ey = -(uz*bx - ux*bz);
+        Real ez = -(ux*by - uy*bx);
+
+        // Boris rotation: half electric kick, magnetic rotation, half electric kick
+        Real h = 0.5*qom*dt_;
+        vx += h*ex;  vy += h*ey;  vz += h*ez;
+        Real tx = h*bx, ty = h*by, tz = h*bz;
+        Real vpx = vx + (vy*tz - vz*ty);
+        Real vpy = vy + (vz*tx - vx*tz);
+        Real vpz = vz + (vx*ty - vy*tx);
+        Real s = 2.0/(1.0 + tx*tx + ty*ty + tz*tz);
+        vx += s*(vpy*tz - vpz*ty);
+        vy += s*(vpz*tx - vpx*tz);
+        vz += s*(vpx*ty - vpy*tx);
+        vx += h*ex;  vy += h*ey;  vz += h*ez;
+
+        // drift to end of step
+        pr(IPVX,p) = vx;
+        pr(IPVY,p) = vy;
+        pr(IPVZ,p) = vz;
+        pr(IPX,p) = x + 0.5*dt_*vx;
+        pr(IPY,p) = y + 0.5*dt_*vy;
+        if (three_d) {
+          pr(IPZ,p) = z + 0.5*dt_*vz;
+        }
+      });
+      }
+    break;
   default:
     break;
   }
 
   return TaskStatus::complete;
 }
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus Particles::SaveFields()
+//! \brief Task in "before_timeintegrator" list (with sub-cycling) that stores the fluid
+//! velocity (and magnetic field with leap_frog) at the start of the step in fld_old
+
+TaskStatus Particles::SaveFields(Driver *pdriver, int stage) {
+  auto &w0 = (pmy_pack->phydro != nullptr)? pmy_pack->phydro->w0 : pmy_pack->pmhd->w0;
+  auto all = Kokkos::ALL;
+  Kokkos::deep_copy(DevExeSpace(),
+                    Kokkos::subview(fld_old,all,std::make_pair(0,3),all,all,all),
+                    Kokkos::subview(w0,all,std::make_pair(IVX,IVZ+1),all,all,all));
+  if (pusher == ParticlesPusher::leap_frog) {
+    auto &bcc0 = pmy_pack->pmhd->bcc0;
+    Kokkos::deep_copy(DevExeSpace(),
+                      Kokkos::subview(fld_old,all,std::make_pair(3,6),all,all,all),
+                      Kokkos::subview(bcc0,all,std::make_pair(IBX,IBZ+1),all,all,all));
+  }
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void InterpolateInTime()
+//  \brief Interpolates the three components starting at n0 of a0 (at the start of the
+//  step) and n1 of a1 (at the end) to position (x,y,z) in MeshBlock m and fraction s of
+//  the step.  Fractional cell indices are limited to [flo,fhi] so that the stencil stays
+//  within the ghost zones.
+
+KOKKOS_INLINE_FUNCTION
+void InterpolateInTime(const DvceArray5D<Real> &a0, int n0, const DvceArray5D<Real> &a1,
+                       int n1, int m, const RegionSize &size, Real x, Real y, Real z,
+                       Real s, Real flo, Real fhi1, Real fhi2, Real fhi3,
+                       int is, int js, int ks, bool three_d, Real val[3]) {
+  Real fx = fmin(fmax((x - size.x1min)/size.dx1 - 0.5, flo), fhi1);
+  Real fy = fmin(fmax((y - size.x2min)/size.dx2 - 0.5, flo), fhi2);
+  Real fz = fmin(fmax((z - size.x3min)/size.dx3 - 0.5, flo), fhi3);
+  for (int n=0; n<3; ++n) {
+    val[n] = (1.0 - s)*InterpolateCC(a0, m, n0+n, fx, fy, fz, is, js, ks, three_d) +
+             s*InterpolateCC(a1, m, n1+n, fx, fy, fz, is, js, ks, three_d);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus Particles::PushSubcycled()
+//! \brief Pushes particles over the step just taken by the fluid (in
+//! "after_timeintegrator" list) with substeps of their own dt.  The number of substeps
+//! of each particle is set at the start of the step so that it moves at most cfl_sub
+//! cells (and, with leap_frog, rotates by at most cfl_sub radians) per substep, up to
+//! max_substeps.  Fields are interpolated linearly in time between fld_old and the fluid
+//! at the end of the step.  The new dtnew limits the distance a particle travels in one
+//! step to the depth of ghost zones exchanged by the fluid (less one), so particles only
+//! move between MeshBlocks once per step.
+
+TaskStatus Particles::PushSubcycled(Driver *pdriver, int stage) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, js = indcs.js, ks = indcs.ks;
+  Real flo = 0.5 - indcs.ng;
+  Real fhi1 = indcs.nx1 + indcs.ng - 1.5;
+  Real fhi2 = indcs.nx2 + indcs.ng - 1.5;
+  Real fhi3 = indcs.nx3 + indcs.ng - 1.5;
+  bool &three_d = pmy_pack->pmesh->three_d;
+  auto &mbsize = pmy_pack->pmb->mb_size;
+  auto &pi = prtcl_idata;
+  auto &pr = prtcl_rdata;
+  Real dt_ = pmy_pack->pmesh->dt;
+  int gids = pmy_pack->gids;
+  int nsubmax = max_substeps;
+  Real cfl = cfl_sub;
+  bool leap_frog = (pusher == ParticlesPusher::leap_frog);
+  Real qom = (leap_frog)? q_over_m : 0.0;
+  auto &fo = fld_old;
+  auto &w0 = (pmy_pack->phydro != nullptr)? pmy_pack->phydro->w0 : pmy_pack->pmhd->w0;
+  DvceArray5D<Real> bcc0;
+  if (leap_frog) {bcc0 = pmy_pack->pmhd->bcc0;}
+  auto *pbval_u = (pmy_pack->phydro != nullptr)? pmy_pack->phydro->pbval_u :
+                                                  pmy_pack->pmhd->pbval_u;
+  Real ncell_lim = static_cast<Real>(std::max(pbval_u->nghost_same - 1, 1));
+
+  Real dtnew_ = static_cast<Real>(std::numeric_limits<float>::max());
+  Kokkos::parallel_reduce("part_subcycle",
+                          Kokkos::RangePolicy<>(DevExeSpace(),0,nprtcl_thispack),
+  KOKKOS_LAMBDA(const int p, Real &dtmin) {
+    if (pi(PGID,p) < 0) return;  // skip holes
+    int m = pi(PGID,p) - gids;
+    const RegionSize &size = mbsize.d_view(m);
+    Real dxmin = fmin(size.dx1, size.dx2);
+    if (three_d) {dxmin = fmin(dxmin, size.dx3);}
+
+    // fluid velocity u (and magnetic field b) at start of step
+    Real x = pr(IPX,p), y = pr(IPY,p), z = (three_d)? pr(IPZ,p) : 0.0;
+    Real v[3] = {0.0, 0.0, 0.0};
+    Real u[3], b[3] = {0.0, 0.0, 0.0};
+    InterpolateInTime(fo,0,w0,IVX,m,size,x,y,z,0.0,flo,fhi1,fhi2,fhi3,is,js,ks,three_d,u);
+    Real rate;
+    if (leap_frog) {
+      InterpolateInTime(fo,3,bcc0,IBX,m,size,x,y,z,0.0,flo,fhi1,fhi2,fhi3,is,js,ks,
+                        three_d,b);
+      v[0] = pr(IPVX,p);  v[1] = pr(IPVY,p);  v[2] = pr(IPVZ,p);
+      rate = sqrt(SQR(v[0]) + SQR(v[1]) + SQR(v[2]))/dxmin +
+             fabs(qom)*sqrt(SQR(b[0]) + SQR(b[1]) + SQR(b[2]));
+    } else {
+      rate = sqrt(SQR(u[0]) + SQR(u[1]) + SQR(u[2]))/dxmin;
+    }
+    int nsub = static_cast<int>(Kokkos::ceil(rate*dt_/cfl));
+    nsub = Kokkos::min(Kokkos::max(nsub, 1), nsubmax);
+    Real h = dt_/static_cast<Real>(nsub);
+    Real ds = 1.0/static_cast<Real>(nsub);
+
+    for (int s=0; s<nsub; ++s) {
+      Real sm = (s + 0.5)*ds;
+      if (leap_frog) {
+        // drift to half substep, Boris push with E = -u x B, drift to end of substep
+        x += 0.5*h*v[0];
+        y += 0.5*h*v[1];
+        if (three_d) {z += 0.5*h*v[2];}
+        InterpolateInTime(fo,0,w0,IVX,m,size,x,y,z,sm,flo,fhi1,fhi2,fhi3,is,js,ks,
+                          three_d,u);
+        InterpolateInTime(fo,3,bcc0,IBX,m,size,x,y,z,sm,flo,fhi1,fhi2,fhi3,is,js,ks,
+                          three_d,b);
+        Real ex = -(u[1]*b[2] - u[2]*b[1]);
+        Real ey = -(u[2]*b[0] - u[0]*b[2]);
+        Real ez = -(u[0]*b[1] - u[1]*b[0]);
+        Real hq = 0.5*qom*h;
+        v[0] += hq*ex;  v[1] += hq*ey;  v[2] += hq*ez;
+        Real tx = hq*b[0], ty = hq*b[1], tz = hq*b[2];
+        Real vpx = v[0] + (v[1]*tz - v[2]*ty);
+        Real vpy = v[1] + (v[2]*tx - v[0]*tz);
+        Real vpz = v[2] + (v[0]*ty - v[1]*tx);
+        Real sb = 2.0/(1.0 + tx*tx + ty*ty + tz*tz);
+        v[0] += sb*(vpy*tz - vpz*ty);
+        v[1] += sb*(vpz*tx - vpx*tz);
+        v[2] += sb*(vpx*ty - vpy*tx);
+        v[0] += hq*ex;  v[1] += hq*ey;  v[2] += hq*ez;
+        x += 0.5*h*v[0];
+        y += 0.5*h*v[1];
+        if (three_d) {z += 0.5*h*v[2];}
+      } else {
+        // second-order midpoint step with the fluid velocity
+        if (s > 0) {
+          InterpolateInTime(fo,0,w0,IVX,m,size,x,y,z,s*ds,flo,fhi1,fhi2,fhi3,is,js,ks,
+                            three_d,u);
+        }
+        Real xm = x + 0.5*h*u[0];
+        Real ym = y + 0.5*h*u[1];
+        Real zm = z + 0.5*h*u[2];
+        InterpolateInTime(fo,0,w0,IVX,m,size,xm,ym,zm,sm,flo,fhi1,fhi2,fhi3,is,js,ks,
+                          three_d,v);
+        x += h*v[0];
+        y += h*v[1];
+        if (three_d) {z += h*v[2];}
+      }
+    }
+
+    pr(IPX,p) = x;
+    pr(IPY,p) = y;
+    if (three_d) {pr(IPZ,p) = z;}
+    if (leap_frog) {
+      pr(IPVX,p) = v[0];
+      pr(IPVY,p) = v[1];
+      pr(IPVZ,p) = v[2];
+    }
+    Real vmag = sqrt(SQR(v[0]) + SQR(v[1]) + ((three_d)? SQR(v[2]) : 0.0));
+    if (vmag > 0.0) {dtmin = fmin(dtmin, ncell_lim*dxmin/vmag);}
+  }, Kokkos::Min<Real>(dtnew_));
+  dtnew = dtnew_;
+
+  return TaskStatus::complete;
+}
 } // namespace particles
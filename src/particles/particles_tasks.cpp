@@ -28,15 +28,32 @@ namespace particles {
 void Particles::AssembleTasks(std::map<std::string, std::shared_ptr<TaskList>> tl) {
   TaskID none(0);
 
-  // particle integration done in "before_timeintegrator" task list
-  id.push   = tl["before_timeintegrator"]->AddTask(&Particles::Push, this, none);
-  id.newgid = tl["before_timeintegrator"]->AddTask(&Particles::NewGID, this, id.push);
-  id.count  = tl["before_timeintegrator"]->AddTask(&Particles::SendCnt, this, id.newgid);
-  id.irecv  = tl["before_timeintegrator"]->AddTask(&Particles::InitRecv, this, id.count);
-  id.sendp  = tl["before_timeintegrator"]->AddTask(&Particles::SendP, this, id.irecv);
-  id.recvp  = tl["before_timeintegrator"]->AddTask(&Particles::RecvP, this, id.sendp);
-  id.crecv  = tl["before_timeintegrator"]->AddTask(&Particles::ClearRecv, this, id.recvp);
-  id.csend  = tl["before_timeintegrator"]->AddTask(&Particles::ClearSend, this, id.crecv);
+  // particle integration done in "before_timeintegrator" task list, or with sub-cycling
+  // in "after_timeintegrator" list once fields at the end of the step are known
+  std::string tlp = "before_timeintegrator";
+  if (subcycle) {
+    id.savef = tl["before_timeintegrator"]->AddTask(&Particles::SaveFields, this, none);
+    tlp = "after_timeintegrator";
+  }
+  id.push   = tl[tlp]->AddTask(&Particles::Push, this, none);
+  id.newgid = tl[tlp]->AddTask(&Particles::NewGID, this, id.push);
+  id.count  = tl[tlp]->AddTask(&Particles::SendCnt, this, id.newgid);
+  id.irecv  = tl[tlp]->AddTask(&Particles::InitRecv, this, id.count);
+  id.sendp  = tl[tlp]->AddTask(&Particles::SendP, this, id.irecv);
+  id.recvp  = tl[tlp]->AddTask(&Particles::RecvP, this, id.sendp);
+  id.crecv  = tl[tlp]->AddTask(&Particles::ClearRecv, this, id.recvp);
+  id.csend  = tl[tlp]->AddTask(&Particles::ClearSend, this, id.crecv);
+  id.sort   = tl[tlp]->AddTask(&Particles::SortP, this, id.csend);
+  // deposition of particles onto cells after they are sorted
+  if (deposit) {
+    auto &tlb = tl[tlp];
+    id.irecvd = tlb->AddTask(&Particles::InitRecvDep, this, none);
+    TaskID sorted = id.sort | id.irecvd;
+    id.dep    = tlb->AddTask(&Particles::Deposit, this, sorted);
+    id.sumd   = tlb->AddTask(&Particles::SumDep, this, id.dep);
+    id.crecvd = tlb->AddTask(&Particles::ClearRecvDep, this, id.sumd);
+    id.csendd = tlb->AddTask(&Particles::ClearSendDep, this, id.crecvd);
+  }
 
   return;
 }
@@ -110,4 +127,63 @@ TaskStatus Particles::ClearRecv(Driver *pdrive, int stage) {
   return tstat;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn TaskList Particles::SortP
+//! \brief Wrapper task list function that sorts particles by MeshBlock and cell every
+//! sort_interval cycles, once all particles have arrived in their new MeshBlocks.
+
+TaskStatus Particles::SortP(Driver *pdrive, int stage) {
+  // deposition requires particles sorted by cell every cycle
+  if (deposit ||
+      (sort_interval > 0 && (pmy_pack->pmesh->ncycle)%sort_interval == 0)) {
+    SortParticles();
+  }
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskList Particles::InitRecvDep
+//! \brief Wrapper task list function to post non-blocking receives (with MPI) of the
+//! deposits in ghost zones of neighbors.
+
+TaskStatus Particles::InitRecvDep(Driver *pdrive, int stage) {
+  int nvd = (has_velocity)? 4 : 1;
+  return pbval_dep->InitRecv(nvd);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskList Particles::Deposit
+//! \brief Wrapper task list function that deposits particles onto cells, and sends
+//! the deposits in ghost zones to the neighbors they overlap.
+
+TaskStatus Particles::Deposit(Driver *pdrive, int stage) {
+  DepositParticles();
+  return pbval_dep->PackAndSendGhostSumCC(dep);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskList Particles::SumDep
+//! \brief Wrapper task list function that adds deposits received from neighbors.
+
+TaskStatus Particles::SumDep(Driver *pdrive, int stage) {
+  return pbval_dep->RecvAndSumGhostCC(dep);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskList Particles::ClearSendDep
+//! \brief Wrapper task list function that checks all MPI sends of deposits completed.
+
+TaskStatus Particles::ClearSendDep(Driver *pdrive, int stage) {
+  return pbval_dep->ClearSend();
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskList Particles::ClearRecvDep
+//! \brief Wrapper task list function that checks all MPI receives of deposits
+//! completed.
+
+TaskStatus Particles::ClearRecvDep(Driver *pdrive, int stage) {
+  return pbval_dep->ClearRecv();
+}
+
 } // namespace particles
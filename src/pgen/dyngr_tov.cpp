@@ -61,6 +61,8 @@ struct tov_pgen {
   Real R_edge_iso; // Radius of star in isotropic coordinates
   Real M_edge; // Mass of star
   int n_r; // Point where pressure goes to zero.
+  DualArray1D<int> iso_index; // Last point of R_iso below each bin of uniform table
+  Real dr_iso_table; // Bin width of table, in isotropic radius
 
   bool isotropic; // Whether or not the TOV uses isotropic coordinates.
 };
@@ -170,8 +172,10 @@ class TabulatedEOS {
   DualArray1D<Real> m_log_p;
   DualArray1D<Real> m_log_e;
   DualArray1D<Real> m_ye;
+  DualArray1D<int> m_p_index; // Last point of m_log_p below each bin of uniform table
 
   Real dlrho;
+  Real dlP_table; // Bin width of table, in log pressure
   Real lrho_min;
   Real lrho_max;
   Real lP_min;
@@ -226,6 +230,20 @@ class TabulatedEOS {
     lP_min = m_log_p.h_view(0);
     lP_max = m_log_p.h_view(m_nn-1);
 
+    // The table is uniform in log density, not log pressure.  Tabulate the last point
+    // below each bin of a table uniform in log pressure, so that the pressure can be
+    // located in O(1) rather than by bisection.
+    Kokkos::realloc(m_p_index, m_nn);
+    dlP_table = (lP_max - lP_min)/static_cast<Real>(m_nn - 1);
+    {
+      int lb = 0;
+      for (size_t in = 0; in < m_nn; in++) {
+        Real lP_bin = lP_min + in*dlP_table;
+        while (lb < static_cast<int>(m_nn) - 2 && m_log_p.h_view(lb+1) <= lP_bin) lb++;
+        m_p_index.h_view(in) = lb;
+      }
+    }
+
     // Read energy
     Real * table_Q7 = table["Q7"];
     for (size_t in = 0; in < m_nn; in++) {
@@ -247,11 +265,13 @@ class TabulatedEOS {
     m_log_p.template modify<HostMemSpace>();
     m_log_e.template modify<HostMemSpace>();
     m_ye.template modify<HostMemSpace>();
+    m_p_index.template modify<HostMemSpace>();
 
     m_log_rho.template sync<DevExeSpace>();
     m_log_p.template sync<DevExeSpace>();
     m_log_e.template sync<DevExeSpace>();
     m_ye.template sync<DevExeSpace>();
+    m_p_index.template sync<DevExeSpace>();
   }
 
   template<LocationTag loc>
@@ -309,35 +329,25 @@ class TabulatedEOS {
   KOKKOS_INLINE_FUNCTION
   Real GetRhoFromP(Real P) const {
     Real lP = log(P);
-    int lb = 0;
-    int ub = m_nn-1;
     // If the pressure is below the minimum of the table, we return zero density.
     if (lP < lP_min) {
       return 0.0;
     }
-    // Do a binary search for the lower and upper indices of the pressure
+    // Start from the last point below the bin of the uniform table that contains the
+    // pressure, and step forward to the lower index of the pressure.
+    int nmax = static_cast<int>(m_nn) - 2;
+    int ib = static_cast<int>((lP - lP_min)/dlP_table);
+    ib = (ib > nmax + 1) ? nmax + 1 : ib;
     if constexpr (loc == LocationTag::Host) {
-      while (ub - lb > 1) {
-        int idx = (lb + ub)/2;
-        if (m_log_p.h_view(idx) > lP) {
-          ub = idx;
-        } else {
-          lb = idx;
-        }
-      }
-      return exp(Interpolate(lP, m_log_p.h_view(lb), m_log_p.h_view(ub),
-                              m_log_rho.h_view(lb), m_log_rho.h_view(ub)));
+      int lb = m_p_index.h_view(ib);
+      while (lb < nmax && m_log_p.h_view(lb+1) <= lP) lb++;
+      return exp(Interpolate(lP, m_log_p.h_view(lb), m_log_p.h_view(lb+1),
+                              m_log_rho.h_view(lb), m_log_rho.h_view(lb+1)));
     } else {
-      while (ub - lb > 1) {
-        int idx = (lb + ub)/2;
-        if (m_log_p.d_view(idx) > lP) {
-          ub = idx;
-        } else {
-          lb = idx;
-        }
-      }
-      return exp(Interpolate(lP, m_log_p.d_view(lb), m_log_p.d_view(ub),
-                              m_log_rho.d_view(lb), m_log_rho.d_view(ub)));
+      int lb = m_p_index.d_view(ib);
+      while (lb < nmax && m_log_p.d_view(lb+1) <= lP) lb++;
+      return exp(Interpolate(lP, m_log_p.d_view(lb), m_log_p.d_view(lb+1),
+                              m_log_rho.d_view(lb), m_log_rho.d_view(lb+1)));
     }
   }
 };
@@ -746,7 +756,7 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
   }
 
   if (pmbp->pz4c != nullptr) {
-    switch (indcs.ng) {
+    switch (pmbp->pz4c->fd_ng) {
       case 2: pmbp->pz4c->ADMToZ4c<2>(pmbp, pin);
               pmbp->pz4c->ADMConstraints<2>(pmbp);
               break;
@@ -902,6 +912,20 @@ static void ConstructTOV(tov_pgen& tov, TOVEOS& eos) {
     R_iso(i) = R_iso(i)*iso_scale;
   }
 
+  // Isotropic radii are not evenly spaced.  Tabulate the last point below each bin of a
+  // table uniform in isotropic radius, so that points can be located in O(1) rather than
+  // by bisection.
+  Kokkos::realloc(tov.iso_index, n_r+1);
+  tov.dr_iso_table = tov.R_edge_iso/static_cast<Real>(n_r);
+  {
+    int lb = 0;
+    for (int ib = 0; ib <= n_r; ib++) {
+      Real r_bin = ib*tov.dr_iso_table;
+      while (lb < n_r - 1 && R_iso(lb+1) < r_bin) lb++;
+      tov.iso_index.h_view(ib) = lb;
+    }
+  }
+
   // Print out details of the calculation
   if (global_variable::my_rank == 0) {
     std::cout << "\nTOV INITIAL DATA\n"
@@ -919,12 +943,14 @@ static void ConstructTOV(tov_pgen& tov, TOVEOS& eos) {
   tov.M.template modify<HostMemSpace>();
   tov.alp.template modify<HostMemSpace>();
   tov.P.template modify<HostMemSpace>();
+  tov.iso_index.template modify<HostMemSpace>();
 
   tov.R.template sync<DevExeSpace>();
   tov.R_iso.template sync<DevExeSpace>();
   tov.M.template sync<DevExeSpace>();
   tov.alp.template sync<DevExeSpace>();
   tov.P.template sync<DevExeSpace>();
+  tov.iso_index.template sync<DevExeSpace>();
 }
 
 template<class TOVEOS>
@@ -957,20 +983,13 @@ static void GetPrimitivesAtPoint(const tov_pgen& tov, const TOVEOS& eos, Real r,
 
 KOKKOS_INLINE_FUNCTION
 static int FindIsotropicIndex(const tov_pgen& tov, Real r_iso) {
-  // Perform a bisection search to find the closest index to the requested isotropic
-  // point.
+  // Start from the last point below the bin of the uniform table that contains the
+  // requested isotropic point, and step forward to the closest index below it.
   const auto &R_iso = tov.R_iso.d_view;
-  int lb = 0;
-  int ub = tov.n_r;
-  int idx = lb;
-  while (R_iso(lb+1) < r_iso) {
-    idx = (lb + ub)/2;
-    if (R_iso(idx) < r_iso) {
-      lb = idx;
-    } else {
-      ub = idx;
-    }
-  }
+  int ib = static_cast<int>(r_iso/tov.dr_iso_table);
+  ib = (ib < 0) ? 0 : ((ib > tov.n_r) ? tov.n_r : ib);
+  int lb = tov.iso_index.d_view(ib);
+  while (lb < tov.n_r - 1 && R_iso(lb+1) < r_iso) lb++;
   return lb;
 }
 
@@ -1311,11 +1330,15 @@ void TOVHistory(HistoryData *pdata, Mesh *pm) {
   // and MPI_MIN operations instead. This is a cheap hack to make it work as intended.
 #if MPI_PARALLEL_ENABLED
   if (global_variable::my_rank == 0) {
-    MPI_Reduce(MPI_IN_PLACE, &rho_max, 1, MPI_ATHENA_REAL, MPI_MAX, 0, MPI_COMM_WORLD);
-    MPI_Reduce(MPI_IN_PLACE, &alpha_min, 1, MPI_ATHENA_REAL, MPI_MIN, 0, MPI_COMM_WORLD);
+    MPI_Reduce(MPI_IN_PLACE, &rho_max, 1, MPI_ATHENA_REAL, MPI_MAX, 0,
+               global_variable::mpi_comm);
+    MPI_Reduce(MPI_IN_PLACE, &alpha_min, 1, MPI_ATHENA_REAL, MPI_MIN, 0,
+               global_variable::mpi_comm);
   } else {
-    MPI_Reduce(&rho_max, &rho_max, 1, MPI_ATHENA_REAL, MPI_MAX, 0, MPI_COMM_WORLD);
-    MPI_Reduce(&alpha_min, &alpha_min, 1, MPI_ATHENA_REAL, MPI_MIN, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&rho_max, &rho_max, 1, MPI_ATHENA_REAL, MPI_MAX, 0,
+               global_variable::mpi_comm);
+    MPI_Reduce(&alpha_min, &alpha_min, 1, MPI_ATHENA_REAL, MPI_MIN, 0,
+               global_variable::mpi_comm);
     rho_max = 0.;
     alpha_min = 0.;
   }
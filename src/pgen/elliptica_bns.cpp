@@ -78,40 +78,22 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
 
   std::cout << "Allocated coordinates of size " << width << std::endl;
 
-  // Populate coordinates for Elliptica
-  // TODO(JMF): Replace with a Kokkos loop on Kokkos::DefaultHostExecutionSpace() to
-  // improve performance.
-  int idx = 0;
-  for (int m = 0; m < nmb; m++) {
-    Real &x1min = size.h_view(m).x1min;
-    Real &x1max = size.h_view(m).x1max;
-    int nx1 = indcs.nx1;
-
-    Real &x2min = size.h_view(m).x2min;
-    Real &x2max = size.h_view(m).x2max;
-    int nx2 = indcs.nx2;
-
-    Real &x3min = size.h_view(m).x3min;
-    Real &x3max = size.h_view(m).x3max;
-    int nx3 = indcs.nx3;
-
-    for (int k = 0; k < ncells3; k++) {
-      Real z = CellCenterX(k - ks, nx3, x3min, x3max);
-      for (int j = 0; j < ncells2; j++) {
-        Real y = CellCenterX(j - js, nx2, x2min, x2max);
-        for (int i = 0; i < ncells1; i++) {
-          Real x = CellCenterX(i - is, nx1, x1min, x1max);
-
-          x_coords[idx] = x;
-          y_coords[idx] = y;
-          z_coords[idx] = z;
-
-          // Increment flat index
-          idx++;
-        }
-      }
-    }
-  }
+  // Populate coordinates for Elliptica, with the same flat index (m,k,j,i) used below
+  // to extract the data.  Loops over all points on the host are run in parallel.
+  const int nkji = ncells3*ncells2*ncells1;
+  const int nji  = ncells2*ncells1;
+  int nx1 = indcs.nx1, nx2 = indcs.nx2, nx3 = indcs.nx3;
+  Kokkos::parallel_for("pgen_elliptica_coords",
+  Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, width),
+  KOKKOS_LAMBDA(const int idx) {
+    int m = (idx)/nkji;
+    int k = (idx - m*nkji)/nji;
+    int j = (idx - m*nkji - k*nji)/ncells1;
+    int i = (idx - m*nkji - k*nji - j*ncells1);
+    x_coords[idx] = CellCenterX(i-is, nx1, size.h_view(m).x1min, size.h_view(m).x1max);
+    y_coords[idx] = CellCenterX(j-js, nx2, size.h_view(m).x2min, size.h_view(m).x2max);
+    z_coords[idx] = CellCenterX(k-ks, nx3, size.h_view(m).x3min, size.h_view(m).x3max);
+  });
 
   idr->set_param("ADM_B1I_form","zero",idr);
 
@@ -184,65 +166,66 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
 
   std::cout << "Label indices saved." << std::endl;
 
-  // TODO(JMF): Replace with a Kokkos loop on Kokkos::DefaultHostExecutionSpace() to
-  // improve performance.
-  idx = 0;
-  for (int m = 0; m < nmb; m++) {
-    for (int k = 0; k < ncells3; k++) {
-      for (int j = 0; j < ncells2; j++) {
-        for (int i = 0; i < ncells1; i++) {
-          // Extract metric quantities
-          host_adm.alpha(m, k, j, i) = idr->field[i_alpha][idx];
-          host_adm.beta_u(m, 0, k, j, i) = idr->field[i_betax][idx];
-          host_adm.beta_u(m, 1, k, j, i) = idr->field[i_betay][idx];
-          host_adm.beta_u(m, 2, k, j, i) = idr->field[i_betaz][idx];
-
-          Real g3d[NSPMETRIC];
-          host_adm.g_dd(m, 0, 0, k, j, i) = g3d[S11] = idr->field[i_gxx][idx];
-          host_adm.g_dd(m, 0, 1, k, j, i) = g3d[S12] = idr->field[i_gxy][idx];
-          host_adm.g_dd(m, 0, 2, k, j, i) = g3d[S13] = idr->field[i_gxz][idx];
-          host_adm.g_dd(m, 1, 1, k, j, i) = g3d[S22] = idr->field[i_gyy][idx];
-          host_adm.g_dd(m, 1, 2, k, j, i) = g3d[S23] = idr->field[i_gyz][idx];
-          host_adm.g_dd(m, 2, 2, k, j, i) = g3d[S33] = idr->field[i_gzz][idx];
-
-          host_adm.vK_dd(m, 0, 0, k, j, i) = idr->field[i_Kxx][idx];
-          host_adm.vK_dd(m, 0, 1, k, j, i) = idr->field[i_Kxy][idx];
-          host_adm.vK_dd(m, 0, 2, k, j, i) = idr->field[i_Kxz][idx];
-          host_adm.vK_dd(m, 1, 1, k, j, i) = idr->field[i_Kyy][idx];
-          host_adm.vK_dd(m, 1, 2, k, j, i) = idr->field[i_Kyz][idx];
-          host_adm.vK_dd(m, 2, 2, k, j, i) = idr->field[i_Kzz][idx];
-
-          // Extract hydro quantities
-          host_w0(m, IDN, k, j, i) = idr->field[i_rho][idx];
-          host_w0(m, IPR, k, j, i) = idr->field[i_p][idx];
-          Real vu[3] = {idr->field[i_vx][idx],
-                        idr->field[i_vy][idx],
-                        idr->field[i_vz][idx]};
-
-          // Before we store the velocity, we need to make sure it's physical and
-          // calculate the Lorentz factor. If the velocity is superluminal, we make a
-          // last-ditch attempt to salvage the solution by rescaling it to
-          // vsq = 1.0 - 1e-15
-          Real vsq = Primitive::SquareVector(vu, g3d);
-          if (1.0 - vsq <= 0) {
-            std::cout << "The velocity is superluminal!" << std::endl
-                      << "Attempting to adjust..." << std::endl;
-            Real fac = sqrt((1.0 - 1e-15)/vsq);
-            vu[0] *= fac;
-            vu[1] *= fac;
-            vu[2] *= fac;
-            vsq = 1.0 - 1.0e-15;
-          }
-          Real W = sqrt(1.0 / (1.0 - vsq));
-
-          host_w0(m, IVX, k, j, i) = W*vu[0];
-          host_w0(m, IVY, k, j, i) = W*vu[1];
-          host_w0(m, IVZ, k, j, i) = W*vu[2];
-
-          idx++;
-        }
-      }
+  // Extract data at all points in parallel on the host.  Cells with superluminal
+  // velocities are counted, and reported once after the loop.
+  int nsuperluminal = 0;
+  Kokkos::parallel_reduce("pgen_elliptica",
+  Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, width),
+  KOKKOS_LAMBDA(const int idx, int &nfix) {
+    int m = (idx)/nkji;
+    int k = (idx - m*nkji)/nji;
+    int j = (idx - m*nkji - k*nji)/ncells1;
+    int i = (idx - m*nkji - k*nji - j*ncells1);
+    // Extract metric quantities
+    host_adm.alpha(m, k, j, i) = idr->field[i_alpha][idx];
+    host_adm.beta_u(m, 0, k, j, i) = idr->field[i_betax][idx];
+    host_adm.beta_u(m, 1, k, j, i) = idr->field[i_betay][idx];
+    host_adm.beta_u(m, 2, k, j, i) = idr->field[i_betaz][idx];
+
+    Real g3d[NSPMETRIC];
+    host_adm.g_dd(m, 0, 0, k, j, i) = g3d[S11] = idr->field[i_gxx][idx];
+    host_adm.g_dd(m, 0, 1, k, j, i) = g3d[S12] = idr->field[i_gxy][idx];
+    host_adm.g_dd(m, 0, 2, k, j, i) = g3d[S13] = idr->field[i_gxz][idx];
+    host_adm.g_dd(m, 1, 1, k, j, i) = g3d[S22] = idr->field[i_gyy][idx];
+    host_adm.g_dd(m, 1, 2, k, j, i) = g3d[S23] = idr->field[i_gyz][idx];
+    host_adm.g_dd(m, 2, 2, k, j, i) = g3d[S33] = idr->field[i_gzz][idx];
+
+    host_adm.vK_dd(m, 0, 0, k, j, i) = idr->field[i_Kxx][idx];
+    host_adm.vK_dd(m, 0, 1, k, j, i) = idr->field[i_Kxy][idx];
+    host_adm.vK_dd(m, 0, 2, k, j, i) = idr->field[i_Kxz][idx];
+    host_adm.vK_dd(m, 1, 1, k, j, i) = idr->field[i_Kyy][idx];
+    host_adm.vK_dd(m, 1, 2, k, j, i) = idr->field[i_Kyz][idx];
+    host_adm.vK_dd(m, 2, 2, k, j, i) = idr->field[i_Kzz][idx];
+
+    // Extract hydro quantities
+    host_w0(m, IDN, k, j, i) = idr->field[i_rho][idx];
+    host_w0(m, IPR, k, j, i) = idr->field[i_p][idx];
+    Real vu[3] = {idr->field[i_vx][idx],
+                  idr->field[i_vy][idx],
+                  idr->field[i_vz][idx]};
+
+    // Before we store the velocity, we need to make sure it's physical and
+    // calculate the Lorentz factor. If the velocity is superluminal, we make a
+    // last-ditch attempt to salvage the solution by rescaling it to
+    // vsq = 1.0 - 1e-15
+    Real vsq = Primitive::SquareVector(vu, g3d);
+    if (1.0 - vsq <= 0) {
+      nfix++;
+      Real fac = sqrt((1.0 - 1e-15)/vsq);
+      vu[0] *= fac;
+      vu[1] *= fac;
+      vu[2] *= fac;
+      vsq = 1.0 - 1.0e-15;
     }
+    Real W = sqrt(1.0 / (1.0 - vsq));
+
+    host_w0(m, IVX, k, j, i) = W*vu[0];
+    host_w0(m, IVY, k, j, i) = W*vu[1];
+    host_w0(m, IVZ, k, j, i) = W*vu[2];
+  }, Kokkos::Sum<int>(nsuperluminal));
+  if (nsuperluminal > 0) {
+    std::cout << "The velocity is superluminal in " << nsuperluminal << " cells!"
+              << std::endl << "Velocities were adjusted to vsq = 1 - 1e-15." << std::endl;
   }
 
   std::cout << "Host mirrors filled." << std::endl;
@@ -292,7 +275,7 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
   std::cout << "Cell-centered fields calculated." << std::endl;
 
   pmbp->pdyngr->PrimToConInit(0, (ncells1-1), 0, (ncells2-1), 0, (ncells3-1));
-  switch (indcs.ng) {
+  switch (pmbp->pz4c->fd_ng) {
     case 2: pmbp->pz4c->ADMToZ4c<2>(pmbp, pin);
             break;
     case 3: pmbp->pz4c->ADMToZ4c<3>(pmbp, pin);
@@ -344,11 +327,15 @@ void EllipticaHistory(HistoryData *pdata, Mesh *pm) {
   // and MPI_MIN operations instead. This is a cheap hack to make it work as intended.
 #if MPI_PARALLEL_ENABLED
   if (global_variable::my_rank == 0) {
-    MPI_Reduce(MPI_IN_PLACE, &rho_max, 1, MPI_ATHENA_REAL, MPI_MAX, 0, MPI_COMM_WORLD);
-    MPI_Reduce(MPI_IN_PLACE, &alpha_min, 1, MPI_ATHENA_REAL, MPI_MIN, 0, MPI_COMM_WORLD);
+    MPI_Reduce(MPI_IN_PLACE, &rho_max, 1, MPI_ATHENA_REAL, MPI_MAX, 0,
+               global_variable::mpi_comm);
+    MPI_Reduce(MPI_IN_PLACE, &alpha_min, 1, MPI_ATHENA_REAL, MPI_MIN, 0,
+               global_variable::mpi_comm);
   } else {
-    MPI_Reduce(&rho_max, &rho_max, 1, MPI_ATHENA_REAL, MPI_MAX, 0, MPI_COMM_WORLD);
-    MPI_Reduce(&alpha_min, &alpha_min, 1, MPI_ATHENA_REAL, MPI_MAX, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&rho_max, &rho_max, 1, MPI_ATHENA_REAL, MPI_MAX, 0,
+               global_variable::mpi_comm);
+    MPI_Reduce(&alpha_min, &alpha_min, 1, MPI_ATHENA_REAL, MPI_MAX, 0,
+               global_variable::mpi_comm);
     rho_max = 0.;
     alpha_min = 0.;
   }
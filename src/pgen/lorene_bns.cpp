@@ -95,40 +95,25 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
 
   std::cout << "Allocated coordinates of size " << width << std::endl;
 
-  // Populate coordinates for LORENE
-  // TODO(JMF): Replace with a Kokkos loop on Kokkos::DefaultHostExecutionSpace() to
-  // improve performance.
-  int idx = 0;
-  for (int m = 0; m < nmb; m++) {
-    Real &x1min = size.h_view(m).x1min;
-    Real &x1max = size.h_view(m).x1max;
-    int nx1 = indcs.nx1;
-
-    Real &x2min = size.h_view(m).x2min;
-    Real &x2max = size.h_view(m).x2max;
-    int nx2 = indcs.nx2;
-
-    Real &x3min = size.h_view(m).x3min;
-    Real &x3max = size.h_view(m).x3max;
-    int nx3 = indcs.nx3;
-
-    for (int k = 0; k < ncells3; k++) {
-      Real z = CellCenterX(k - ks, nx3, x3min, x3max);
-      for (int j = 0; j < ncells2; j++) {
-        Real y = CellCenterX(j - js, nx2, x2min, x2max);
-        for (int i = 0; i < ncells1; i++) {
-          Real x = CellCenterX(i - is, nx1, x1min, x1max);
-
-          x_coords[idx] = coord_unit*x;
-          y_coords[idx] = coord_unit*y;
-          z_coords[idx] = coord_unit*z;
-
-          // Increment flat index
-          idx++;
-        }
-      }
-    }
-  }
+  // Populate coordinates for LORENE, with the same flat index (m,k,j,i) used below to
+  // extract the data.  Loops over all points on the host are run in parallel.
+  const int nkji = ncells3*ncells2*ncells1;
+  const int nji  = ncells2*ncells1;
+  int nx1 = indcs.nx1, nx2 = indcs.nx2, nx3 = indcs.nx3;
+  Kokkos::parallel_for("pgen_lorene_coords",
+  Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, width),
+  KOKKOS_LAMBDA(const int idx) {
+    int m = (idx)/nkji;
+    int k = (idx - m*nkji)/nji;
+    int j = (idx - m*nkji - k*nji)/ncells1;
+    int i = (idx - m*nkji - k*nji - j*ncells1);
+    x_coords[idx] = coord_unit*CellCenterX(i-is, nx1, size.h_view(m).x1min,
+                                           size.h_view(m).x1max);
+    y_coords[idx] = coord_unit*CellCenterX(j-js, nx2, size.h_view(m).x2min,
+                                           size.h_view(m).x2max);
+    z_coords[idx] = coord_unit*CellCenterX(k-ks, nx3, size.h_view(m).x3min,
+                                           size.h_view(m).x3max);
+  });
 
   // Interpolate the data
   std::cout << "Coordinates assigned." << std::endl;
@@ -176,87 +161,73 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
 
   std::cout << "Host mirrors created." << std::endl;
 
-  // TODO(JMF): Replace with a Kokkos loop on Kokkos::DefaultHostExecutionSpace() to
-  // improve performance.
-  idx = 0;
-  for (int m = 0; m < nmb; m++) {
-    for (int k = 0; k < ncells3; k++) {
-      for (int j = 0; j < ncells2; j++) {
-        for (int i = 0; i < ncells1; i++) {
-  /*const int nn = nmb;
-  const int nk = ncells3;
-  const int nj = ncells2;
-  const int ni = ncells1;
-  const int nnkji = nn * nk * nj * ni;
-  const int nkji = nk * nj * ni;
-  const int nji = nj * ni;
-  Kokkos::parallel_for("pgen_lorene",
-  Kokkos::RangePolicy<>(HostExeSpace(), 0, nnkji),
-  KOKKOS_LAMBDA(const int &idx) {
-          int m = (idx)/nkji;
-          int k = (idx - m*nkji)/nji;
-          int j = (idx - m*nkji - k*nji)/ni;
-          int i = (idx - m*nkji - k*nji - j*ni);*/
-          // Extract metric quantities
-          host_adm.alpha(m, k, j, i) = bns->nnn[idx];
-          host_adm.beta_u(m, 0, k, j, i) = bns->beta_x[idx];
-          host_adm.beta_u(m, 1, k, j, i) = bns->beta_y[idx];
-          host_adm.beta_u(m, 2, k, j, i) = bns->beta_z[idx];
-
-          Real g3d[NSPMETRIC];
-          host_adm.g_dd(m, 0, 0, k, j, i) = g3d[S11] = bns->g_xx[idx];
-          host_adm.g_dd(m, 0, 1, k, j, i) = g3d[S12] = bns->g_xy[idx];
-          host_adm.g_dd(m, 0, 2, k, j, i) = g3d[S13] = bns->g_xz[idx];
-          host_adm.g_dd(m, 1, 1, k, j, i) = g3d[S22] = bns->g_yy[idx];
-          host_adm.g_dd(m, 1, 2, k, j, i) = g3d[S23] = bns->g_yz[idx];
-          host_adm.g_dd(m, 2, 2, k, j, i) = g3d[S33] = bns->g_zz[idx];
-
-          host_adm.vK_dd(m, 0, 0, k, j, i) = coord_unit * bns->k_xx[idx];
-          host_adm.vK_dd(m, 0, 1, k, j, i) = coord_unit * bns->k_xy[idx];
-          host_adm.vK_dd(m, 0, 2, k, j, i) = coord_unit * bns->k_xz[idx];
-          host_adm.vK_dd(m, 1, 1, k, j, i) = coord_unit * bns->k_yy[idx];
-          host_adm.vK_dd(m, 1, 2, k, j, i) = coord_unit * bns->k_yz[idx];
-          host_adm.vK_dd(m, 2, 2, k, j, i) = coord_unit * bns->k_zz[idx];
-
-          // Extract hydro quantities
-          host_w0(m, IDN, k, j, i) = bns->nbar[idx] / rho_unit;
-          // Lorene only gives the specific internal energy, but PrimitiveSolver needs
-          // pressure. Because PrimitiveSolver is templated, it's difficult to call it
-          // directly. Thus, the easiest way is to save the internal energy density, IEN,
-          // whose index overlaps the pressure, IPR, move the data to the GPU, then
-          // make a call to a virtual DynGRMHD EOS function that will call the appropriate
-          // template function.
-          Real egas = host_w0(m, IDN, k, j, i) * bns->ener_spec[idx] / ener_unit;
-          host_w0(m, IEN, k, j, i) = egas;
-          Real vu[3] = {bns->u_euler_x[idx] / vel_unit,
-                        bns->u_euler_y[idx] / vel_unit,
-                        bns->u_euler_z[idx] / vel_unit};
-
-          // Before we store the velocity, we need to make sure it's physical and
-          // calculate the Lorentz factor. If the velocity is superluminal, we make a
-          // last-ditch attempt to salvage the solution by rescaling it to
-          // vsq = 1.0 - 1e-15
-          Real vsq = Primitive::SquareVector(vu, g3d);
-          if (1.0 - vsq <= 0) {
-            std::cout << "The velocity is superluminal!" << std::endl
-                      << "Attempting to adjust..." << std::endl;
-            Real fac = sqrt((1.0 - 1e-15)/vsq);
-            vu[0] *= fac;
-            vu[1] *= fac;
-            vu[2] *= fac;
-            vsq = 1.0 - 1.0e-15;
-          }
-          Real W = sqrt(1.0 / (1.0 - vsq));
-
-          host_w0(m, IVX, k, j, i) = W*vu[0];
-          host_w0(m, IVY, k, j, i) = W*vu[1];
-          host_w0(m, IVZ, k, j, i) = W*vu[2];
-
-          idx++;
-  //});
-        }
-      }
+  // Extract data at all points in parallel on the host.  Cells with superluminal
+  // velocities are counted, and reported once after the loop.
+  int nsuperluminal = 0;
+  Kokkos::parallel_reduce("pgen_lorene",
+  Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, width),
+  KOKKOS_LAMBDA(const int idx, int &nfix) {
+    int m = (idx)/nkji;
+    int k = (idx - m*nkji)/nji;
+    int j = (idx - m*nkji - k*nji)/ncells1;
+    int i = (idx - m*nkji - k*nji - j*ncells1);
+    // Extract metric quantities
+    host_adm.alpha(m, k, j, i) = bns->nnn[idx];
+    host_adm.beta_u(m, 0, k, j, i) = bns->beta_x[idx];
+    host_adm.beta_u(m, 1, k, j, i) = bns->beta_y[idx];
+    host_adm.beta_u(m, 2, k, j, i) = bns->beta_z[idx];
+
+    Real g3d[NSPMETRIC];
+    host_adm.g_dd(m, 0, 0, k, j, i) = g3d[S11] = bns->g_xx[idx];
+    host_adm.g_dd(m, 0, 1, k, j, i) = g3d[S12] = bns->g_xy[idx];
+    host_adm.g_dd(m, 0, 2, k, j, i) = g3d[S13] = bns->g_xz[idx];
+    host_adm.g_dd(m, 1, 1, k, j, i) = g3d[S22] = bns->g_yy[idx];
+    host_adm.g_dd(m, 1, 2, k, j, i) = g3d[S23] = bns->g_yz[idx];
+    host_adm.g_dd(m, 2, 2, k, j, i) = g3d[S33] = bns->g_zz[idx];
+
+    host_adm.vK_dd(m, 0, 0, k, j, i) = coord_unit * bns->k_xx[idx];
+    host_adm.vK_dd(m, 0, 1, k, j, i) = coord_unit * bns->k_xy[idx];
+    host_adm.vK_dd(m, 0, 2, k, j, i) = coord_unit * bns->k_xz[idx];
+    host_adm.vK_dd(m, 1, 1, k, j, i) = coord_unit * bns->k_yy[idx];
+    host_adm.vK_dd(m, 1, 2, k, j, i) = coord_unit * bns->k_yz[idx];
+    host_adm.vK_dd(m, 2, 2, k, j, i) = coord_unit * bns->k_zz[idx];
+
+    // Extract hydro quantities
+    host_w0(m, IDN, k, j, i) = bns->nbar[idx] / rho_unit;
+    // Lorene only gives the specific internal energy, but PrimitiveSolver needs
+    // pressure. Because PrimitiveSolver is templated, it's difficult to call it
+    // directly. Thus, the easiest way is to save the internal energy density, IEN,
+    // whose index overlaps the pressure, IPR, move the data to the GPU, then
+    // make a call to a virtual DynGRMHD EOS function that will call the appropriate
+    // template function.
+    Real egas = host_w0(m, IDN, k, j, i) * bns->ener_spec[idx] / ener_unit;
+    host_w0(m, IEN, k, j, i) = egas;
+    Real vu[3] = {bns->u_euler_x[idx] / vel_unit,
+                  bns->u_euler_y[idx] / vel_unit,
+                  bns->u_euler_z[idx] / vel_unit};
+
+    // Before we store the velocity, we need to make sure it's physical and
+    // calculate the Lorentz factor. If the velocity is superluminal, we make a
+    // last-ditch attempt to salvage the solution by rescaling it to
+    // vsq = 1.0 - 1e-15
+    Real vsq = Primitive::SquareVector(vu, g3d);
+    if (1.0 - vsq <= 0) {
+      nfix++;
+      Real fac = sqrt((1.0 - 1e-15)/vsq);
+      vu[0] *= fac;
+      vu[1] *= fac;
+      vu[2] *= fac;
+      vsq = 1.0 - 1.0e-15;
     }
+    Real W = sqrt(1.0 / (1.0 - vsq));
+
+    host_w0(m, IVX, k, j, i) = W*vu[0];
+    host_w0(m, IVY, k, j, i) = W*vu[1];
+    host_w0(m, IVZ, k, j, i) = W*vu[2];
+  }, Kokkos::Sum<int>(nsuperluminal));
+  if (nsuperluminal > 0) {
+    std::cout << "The velocity is superluminal in " << nsuperluminal << " cells!"
+              << std::endl << "Velocities were adjusted to vsq = 1 - 1e-15." << std::endl;
   }
 
   std::cout << "Host mirrors filled." << std::endl;
@@ -315,7 +286,7 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
 
   pmbp->pdyngr->PrimToConInit(0, (ncells1-1), 0, (ncells2-1), 0, (ncells3-1));
   if (pmbp->pz4c != nullptr) {
-    switch (indcs.ng) {
+    switch (pmbp->pz4c->fd_ng) {
       case 2: pmbp->pz4c->ADMToZ4c<2>(pmbp, pin);
               break;
       case 3: pmbp->pz4c->ADMToZ4c<3>(pmbp, pin);
@@ -367,11 +338,15 @@ void BNSHistory(HistoryData *pdata, Mesh *pm) {
   // and MPI_MIN operations instead. This is a cheap hack to make it work as intended.
 #if MPI_PARALLEL_ENABLED
   if (global_variable::my_rank == 0) {
-    MPI_Reduce(MPI_IN_PLACE, &rho_max, 1, MPI_ATHENA_REAL, MPI_MAX, 0, MPI_COMM_WORLD);
-    MPI_Reduce(MPI_IN_PLACE, &alpha_min, 1, MPI_ATHENA_REAL, MPI_MIN, 0, MPI_COMM_WORLD);
+    MPI_Reduce(MPI_IN_PLACE, &rho_max, 1, MPI_ATHENA_REAL, MPI_MAX, 0,
+               global_variable::mpi_comm);
+    MPI_Reduce(MPI_IN_PLACE, &alpha_min, 1, MPI_ATHENA_REAL, MPI_MIN, 0,
+               global_variable::mpi_comm);
   } else {
-    MPI_Reduce(&rho_max, &rho_max, 1, MPI_ATHENA_REAL, MPI_MAX, 0, MPI_COMM_WORLD);
-    MPI_Reduce(&alpha_min, &alpha_min, 1, MPI_ATHENA_REAL, MPI_MIN, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&rho_max, &rho_max, 1, MPI_ATHENA_REAL, MPI_MAX, 0,
+               global_variable::mpi_comm);
+    MPI_Reduce(&alpha_min, &alpha_min, 1, MPI_ATHENA_REAL, MPI_MIN, 0,
+               global_variable::mpi_comm);
     rho_max = 0.;
     alpha_min = 0.;
   }
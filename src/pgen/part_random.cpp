@@ -15,8 +15,7 @@
 #include "athena.hpp"
 #include "mesh/mesh.hpp"
 #include "particles/particles.hpp"
-
-#include <Kokkos_Random.hpp>
+#include "utils/random.hpp"
 
 //----------------------------------------------------------------------------------------
 //! \fn ProblemGenerator::UserProblem_()
@@ -38,38 +37,44 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
   auto &pr = pmy_mesh_->pmb_pack->ppart->prtcl_rdata;
   auto &pi = pmy_mesh_->pmb_pack->ppart->prtcl_idata;
   auto &npart = pmy_mesh_->pmb_pack->ppart->nprtcl_thispack;
+  bool has_vel = pmy_mesh_->pmb_pack->ppart->has_velocity;
   auto gids = pmy_mesh_->pmb_pack->gids;
   auto gide = pmy_mesh_->pmb_pack->gide;
 
-  // initialize particles
-  Kokkos::Random_XorShift64_Pool<> rand_pool64(pmbp->gids);
+  // initialize particles.  Particles are distributed evenly over MeshBlocks, and random
+  // numbers of particle q in MeshBlock gid are drawn from the counter-based stream gid,
+  // so that positions do not depend on the number of ranks or threads
+  uint64_t seed = static_cast<uint64_t>(pin->GetOrAddInteger("problem", "rng_seed", 1));
+  int nmb = gide - gids + 1;
   par_for("part_update",DevExeSpace(),0,(npart-1),
   KOKKOS_LAMBDA(const int p) {
-    auto rand_gen = rand_pool64.get_state();  // get random number state this thread
-    // choose parent MeshBlock randomly
-    int m = static_cast<int>(rand_gen.frand()*(gide - gids + 1.0));
+    int m = p % nmb;
     pi(PGID,p) = gids + m;
+    uint64_t q = static_cast<uint64_t>(p/nmb);
+    uint64_t stream = static_cast<uint64_t>(gids + m);
+
+    double rand[6];
+    RanPhilox(seed, stream, 3*q, &rand[0]);
+    RanPhilox(seed, stream, 3*q + 1, &rand[2]);
+    RanPhilox(seed, stream, 3*q + 2, &rand[4]);
 
-    Real rand = rand_gen.frand();
-    pr(IPX,p) = (1. - rand)*mbsize.d_view(m).x1min + rand*mbsize.d_view(m).x1max;
+    pr(IPX,p) = (1. - rand[0])*mbsize.d_view(m).x1min + rand[0]*mbsize.d_view(m).x1max;
     pr(IPX,p) = fmin(pr(IPX,p),mbsize.d_view(m).x1max);
     pr(IPX,p) = fmax(pr(IPX,p),mbsize.d_view(m).x1min);
 
-    rand = rand_gen.frand();
-    pr(IPY,p) = (1. - rand)*mbsize.d_view(m).x2min + rand*mbsize.d_view(m).x2max;
+    pr(IPY,p) = (1. - rand[1])*mbsize.d_view(m).x2min + rand[1]*mbsize.d_view(m).x2max;
     pr(IPY,p) = fmin(pr(IPY,p),mbsize.d_view(m).x2max);
     pr(IPY,p) = fmax(pr(IPY,p),mbsize.d_view(m).x2min);
 
-    rand = rand_gen.frand();
-    pr(IPZ,p) = (1. - rand)*mbsize.d_view(m).x3min + rand*mbsize.d_view(m).x3max;
+    pr(IPZ,p) = (1. - rand[2])*mbsize.d_view(m).x3min + rand[2]*mbsize.d_view(m).x3max;
     pr(IPZ,p) = fmin(pr(IPZ,p),mbsize.d_view(m).x3max);
     pr(IPZ,p) = fmax(pr(IPZ,p),mbsize.d_view(m).x3min);
 
-    pr(IPVX,p) = 2.0*(rand_gen.frand() - 0.5);
-    pr(IPVY,p) = 2.0*(rand_gen.frand() - 0.5);
-    pr(IPVZ,p) = 2.0*(rand_gen.frand() - 0.5);
-
-    rand_pool64.free_state(rand_gen);  // free state for use by other threads
+    if (has_vel) {
+      pr(IPVX,p) = 2.0*(rand[3] - 0.5);
+      pr(IPVY,p) = 2.0*(rand[4] - 0.5);
+      pr(IPVZ,p) = 2.0*(rand[5] - 0.5);
+    }
   });
 
   // set timestep (which will remain constant for entire run
@@ -12,6 +12,8 @@
 #include <string>
 #include <utility>
 #include <algorithm>
+#include <cstring>
+#include <vector>
 
 #include "athena.hpp"
 #include "geodesic-grid/geodesic_grid.hpp"
@@ -25,6 +27,9 @@
 #include "z4c/z4c.hpp"
 #include "radiation/radiation.hpp"
 #include "srcterms/turb_driver.hpp"
+#include "outputs/outputs.hpp"
+#include "outputs/restart_delta.hpp"
+#include "outputs/restart_local.hpp"
 #include "pgen.hpp"
 
 //----------------------------------------------------------------------------------------
@@ -80,6 +85,10 @@ ProblemGenerator::ProblemGenerator(ParameterInput *pin, Mesh *pm) :
     SphericalCollapse(pin, false);
   } else if (pgen_fun_name.compare("diffusion") == 0) {
     Diffusion(pin, false);
+  } else if (pgen_fun_name.compare("kernel_bench") == 0) {
+    KernelBench(pin, false);
+  } else if (pgen_fun_name.compare("scaling") == 0) {
+    Scaling(pin, false);
   // else, name not set on command line or input file, print warning and quit
   } else {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
@@ -122,6 +131,51 @@ ProblemGenerator::ProblemGenerator(ParameterInput *pin, Mesh *pm) :
   }
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn int UnpackRestartData()
+//! \brief copies the data of MeshBlocks [m0,m0+nmb) of one array, stored at position pos
+//! (in Reals) within each MeshBlock record (of rsize Reals) in buf, into the array.
+//! Returns position of the next array within the records.
+
+static int UnpackRestartData(DvceArray1D<Real> buf, int rsize, int pos, int m0, int nmb,
+                             DvceArray5D<Real> a) {
+  int nvar = a.extent_int(1), n3 = a.extent_int(2), n2 = a.extent_int(3);
+  int n1 = a.extent_int(4);
+  par_for("rst-unpack5", DevExeSpace(), 0, nmb-1, 0, nvar-1, 0, n3-1, 0, n2-1, 0, n1-1,
+  KOKKOS_LAMBDA(int m, int n, int k, int j, int i) {
+    a(m0+m,n,k,j,i) = buf(m*rsize + pos + ((n*n3 + k)*n2 + j)*n1 + i);
+  });
+  return pos + nvar*n3*n2*n1;
+}
+
+static int UnpackRestartData(DvceArray1D<Real> buf, int rsize, int pos, int m0, int nmb,
+                             DvceArray4D<Real> a) {
+  int n3 = a.extent_int(1), n2 = a.extent_int(2), n1 = a.extent_int(3);
+  par_for("rst-unpack4", DevExeSpace(), 0, nmb-1, 0, n3-1, 0, n2-1, 0, n1-1,
+  KOKKOS_LAMBDA(int m, int k, int j, int i) {
+    a(m0+m,k,j,i) = buf(m*rsize + pos + (k*n2 + j)*n1 + i);
+  });
+  return pos + n3*n2*n1;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn int UnpackRestartFloat()
+//! \brief as UnpackRestartData(), for arrays stored in single precision (padded to a
+//! multiple of sizeof(Real) in each record)
+
+static int UnpackRestartFloat(DvceArray1D<Real> buf, int rsize, int pos, int m0, int nmb,
+                              DvceArray5D<Real> a) {
+  int nvar = a.extent_int(1), n3 = a.extent_int(2), n2 = a.extent_int(3);
+  int n1 = a.extent_int(4);
+  const int nf = sizeof(Real)/sizeof(float);
+  DvceArray1D<float> fbuf(reinterpret_cast<float*>(buf.data()), nf*buf.extent(0));
+  par_for("rst-unpackf", DevExeSpace(), 0, nmb-1, 0, nvar-1, 0, n3-1, 0, n2-1, 0, n1-1,
+  KOKKOS_LAMBDA(int m, int n, int k, int j, int i) {
+    a(m0+m,n,k,j,i) = fbuf((m*rsize + pos)*nf + ((n*n3 + k)*n2 + j)*n1 + i);
+  });
+  return pos + RestartOutput::ArrayBytes(nvar*n3*n2*n1, true)/sizeof(Real);
+}
+
 //----------------------------------------------------------------------------------------
 // constructor for restarts
 // When called, data needed to rebuild mesh has been read from restart file by
@@ -165,7 +219,7 @@ ProblemGenerator::ProblemGenerator(ParameterInput *pin, Mesh *pm, IOWrapper resf
     nmhd = pmhd->nmhd + pmhd->nscalars;
   }
   if (prad != nullptr) {
-    nrad = prad->prgeo->nangles;
+    nrad = prad->nrad;
   }
   if (pz4c != nullptr) {
     nz4c = pz4c->nz4c;
@@ -185,7 +239,7 @@ ProblemGenerator::ProblemGenerator(ParameterInput *pin, Mesh *pm, IOWrapper resf
       }
     }
 #if MPI_PARALLEL_ENABLED
-    MPI_Bcast(&last_output_time, sizeof(Real), MPI_CHAR, 0, MPI_COMM_WORLD);
+    MPI_Bcast(&last_output_time, sizeof(Real), MPI_CHAR, 0, global_variable::mpi_comm);
 #endif
     pz4c->last_output_time = last_output_time;
 
@@ -200,7 +254,7 @@ ProblemGenerator::ProblemGenerator(ParameterInput *pin, Mesh *pm, IOWrapper resf
         }
       }
 #if MPI_PARALLEL_ENABLED
-      MPI_Bcast(&pos[0], 3*sizeof(Real), MPI_CHAR, 0, MPI_COMM_WORLD);
+      MPI_Bcast(&pos[0], 3*sizeof(Real), MPI_CHAR, 0, global_variable::mpi_comm);
 #endif
       pt.SetPos(&pos[0]);
     }
@@ -221,7 +275,7 @@ ProblemGenerator::ProblemGenerator(ParameterInput *pin, Mesh *pm, IOWrapper resf
 
 #if MPI_PARALLEL_ENABLED
     // then broadcast the RNG information
-    MPI_Bcast(rng_data, sizeof(RNG_State), MPI_CHAR, 0, MPI_COMM_WORLD);
+    MPI_Bcast(rng_data, sizeof(RNG_State), MPI_CHAR, 0, global_variable::mpi_comm);
 #endif
     std::memcpy(&(pturb->rstate), &(rng_data[0]), sizeof(RNG_State));
   }
@@ -239,7 +293,7 @@ ProblemGenerator::ProblemGenerator(ParameterInput *pin, Mesh *pm, IOWrapper resf
   }
 #if MPI_PARALLEL_ENABLED
   // then broadcast the datasize information
-  MPI_Bcast(variabledata, variablesize, MPI_CHAR, 0, MPI_COMM_WORLD);
+  MPI_Bcast(variabledata, variablesize, MPI_CHAR, 0, global_variable::mpi_comm);
 #endif
   IOWrapperSizeT data_size;
   std::memcpy(&data_size, &(variabledata[0]), sizeof(IOWrapperSizeT));
@@ -252,9 +306,12 @@ ProblemGenerator::ProblemGenerator(ParameterInput *pin, Mesh *pm, IOWrapper resf
   }
 #if MPI_PARALLEL_ENABLED
   // then broadcasts it
-  MPI_Bcast(&headeroffset, sizeof(IOWrapperSizeT), MPI_CHAR, 0, MPI_COMM_WORLD);
+  MPI_Bcast(&headeroffset, sizeof(IOWrapperSizeT), MPI_CHAR, 0,
+            global_variable::mpi_comm);
 #endif
 
+  // arrays omitted or stored in single precision (see RestartOutput constructor)
+  RestartLayout layout = RestartOutput::ReadLayout(pin);
   IOWrapperSizeT data_size_ = 0;
   if (phydro != nullptr) {
     data_size_ += nout1*nout2*nout3*nhydro*sizeof(Real); // hydro u0
@@ -266,10 +323,12 @@ ProblemGenerator::ProblemGenerator(ParameterInput *pin, Mesh *pm, IOWrapper resf
     data_size_ += nout1*nout2*(nout3+1)*sizeof(Real);    // mhd b0.x3f
   }
   if (prad != nullptr) {
-    data_size_ += nout1*nout2*nout3*nrad*sizeof(Real);   // rad i0
+    data_size_ += RestartOutput::ArrayBytes(nout1*nout2*nout3*nrad,
+                                            layout.float_rad);      // rad i0
   }
-  if (pturb != nullptr) {
-    data_size_ += nout1*nout2*nout3*nforce*sizeof(Real); // forcing
+  if (pturb != nullptr && !(layout.skip_force)) {
+    data_size_ += RestartOutput::ArrayBytes(nout1*nout2*nout3*nforce,
+                                            layout.float_force);    // forcing
   }
   if (pz4c != nullptr) {
     data_size_ += nout1*nout2*nout3*nz4c*sizeof(Real);   // z4c u0
@@ -285,344 +344,91 @@ ProblemGenerator::ProblemGenerator(ParameterInput *pin, Mesh *pm, IOWrapper resf
     exit(EXIT_FAILURE);
   }
 
-  // read CC data into host array
+  // The data of each MeshBlock are stored contiguously (data_size bytes, in the order
+  // written in restart.cpp), and the MeshBlocks of each rank are contiguous in the file.
+  // They are read collectively in chunks of MeshBlocks into two pinned host buffers in
+  // turn.  Each chunk is copied to the device asynchronously (overlapping the read of the
+  // next chunk), and unpacked there into u0, b0, etc.  Chunks are limited to 256 MB, so
+  // only two chunks are held on the host, and reads stay below the 2^31 element limit.
   int mygids = pm->gids_eachrank[global_variable::my_rank];
-  IOWrapperSizeT offset_myrank = headeroffset + data_size_*mygids;
-  IOWrapperSizeT myoffset = offset_myrank;
 
-  HostArray5D<Real> ccin("rst-cc-in", 1, 1, 1, 1, 1);
-  HostFaceFld4D<Real> fcin("rst-fc-in", 1, 1, 1, 1);
+  // delta restart files store differences to an earlier (base) restart file, and local
+  // restart files keep the data in node-local storage.  The data of this rank are then
+  // collected in memory first, and copied from there below.
+  std::vector<char> rank_data;
+  bool in_memory = restart_delta::ReadData(pin, pm, resfile, headeroffset, data_size,
+                                           rank_data) ||
+                   restart_local::ReadData(pin, pm, data_size, rank_data);
 
-  // calculate max/min number of MeshBlocks across all ranks
+  // number of chunks is set by max number of MeshBlocks across all ranks, since every
+  // rank must take part in all collective reads
   int noutmbs_max = pm->nmb_eachrank[0];
-  int noutmbs_min = pm->nmb_eachrank[0];
   for (int i=0; i<(global_variable::nranks); ++i) {
     noutmbs_max = std::max(noutmbs_max,pm->nmb_eachrank[i]);
-    noutmbs_min = std::min(noutmbs_min,pm->nmb_eachrank[i]);
-  }
-
-  if (phydro != nullptr) {
-    Kokkos::realloc(ccin, nmb, nhydro, nout3, nout2, nout1);
-    for (int m=0;  m<noutmbs_max; ++m) {
-      // every rank has a MB to read, so read collectively
-      if (m < noutmbs_min) {
-        // get ptr to cell-centered MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at_all(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC hydro data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-
-      // some ranks are finished writing, so use non-collective write
-      } else if (m < pm->nmb_thisrank) {
-        // get ptr to MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC hydro data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-      }
-    }
-    Kokkos::deep_copy(Kokkos::subview(phydro->u0, std::make_pair(0,nmb), Kokkos::ALL,
-                      Kokkos::ALL, Kokkos::ALL, Kokkos::ALL), ccin);
-    offset_myrank += nout1*nout2*nout3*nhydro*sizeof(Real); // hydro u0
-    myoffset = offset_myrank;
   }
-
-  if (pmhd != nullptr) {
-    Kokkos::realloc(ccin, nmb, nmhd, nout3, nout2, nout1);
-    for (int m=0;  m<noutmbs_max; ++m) {
-      // every rank has a MB to read, so read collectively
-      if (m < noutmbs_min) {
-        // get ptr to cell-centered MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                   Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at_all(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC mhd data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-      // some ranks are finished writing, so use non-collective write
-      } else if (m < pm->nmb_thisrank) {
-        // get ptr to MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC mhd data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
+  int nmb_chunk = std::max(1, static_cast<int>(268435456/data_size));
+  int nchunk = (noutmbs_max + nmb_chunk - 1)/nmb_chunk;
+  int rsize = data_size/sizeof(Real);
+  int nbuf = std::min(nmb, nmb_chunk)*rsize;
+  HostPinnedArray1D<Real> hbuf[2] = {HostPinnedArray1D<Real>("rst-hbuf0", nbuf),
+                                     HostPinnedArray1D<Real>("rst-hbuf1", nbuf)};
+  DvceArray1D<Real> dbuf("rst-dbuf", nbuf);
+
+  for (int c=0; c<nchunk; ++c) {
+    auto &hb = hbuf[c%2];
+    int m0 = c*nmb_chunk;
+    int nmbc = std::max(0, std::min(nmb_chunk, nmb - m0));  // MeshBlocks in this chunk
+    IOWrapperSizeT nbytes = nmbc*data_size;
+    if (in_memory) {
+      if (nbytes > 0) {
+        std::memcpy(hb.data(), &(rank_data[m0*data_size]), nbytes);
       }
-    }
-    Kokkos::deep_copy(Kokkos::subview(pmhd->u0, std::make_pair(0,nmb), Kokkos::ALL,
-                      Kokkos::ALL, Kokkos::ALL, Kokkos::ALL), ccin);
-    offset_myrank += nout1*nout2*nout3*nmhd*sizeof(Real);   // mhd u0
-    myoffset = offset_myrank;
-
-    Kokkos::realloc(fcin.x1f, nmb, nout3, nout2, nout1+1);
-    Kokkos::realloc(fcin.x2f, nmb, nout3, nout2+1, nout1);
-    Kokkos::realloc(fcin.x3f, nmb, nout3+1, nout2, nout1);
-    // read FC data into host array, again one MeshBlock at a time
-    for (int m=0;  m<noutmbs_max; ++m) {
-      // every rank has a MB to write, so write collectively
-      if (m < noutmbs_min) {
-        // get ptr to x1-face field
-        auto x1fptr = Kokkos::subview(fcin.x1f, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
-        int fldcnt = x1fptr.size();
-
-        if (resfile.Read_Reals_at_all(x1fptr.data(), fldcnt, myoffset) != fldcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                << std::endl << "Input b0.x1f field not read correctly from rst file, "
-                << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += fldcnt*sizeof(Real);
-
-        // get ptr to x2-face field
-        auto x2fptr = Kokkos::subview(fcin.x2f, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
-        fldcnt = x2fptr.size();
-
-        if (resfile.Read_Reals_at_all(x2fptr.data(), fldcnt, myoffset) != fldcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                << std::endl << "Input b0.x2f field not read correctly from rst file, "
-                << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += fldcnt*sizeof(Real);
-
-        // get ptr to x3-face field
-        auto x3fptr = Kokkos::subview(fcin.x3f, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
-        fldcnt = x3fptr.size();
-
-        if (resfile.Read_Reals_at_all(x3fptr.data(), fldcnt, myoffset) != fldcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                << std::endl << "Input b0.x3f field not read correctly from rst file, "
-                << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += fldcnt*sizeof(Real);
-
-        myoffset += data_size-(x1fptr.size()+x2fptr.size()+x3fptr.size())*sizeof(Real);
-      } else if (m < pm->nmb_thisrank) {
-        // get ptr to x1-face field
-        auto x1fptr = Kokkos::subview(fcin.x1f, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
-        int fldcnt = x1fptr.size();
-
-        if (resfile.Read_Reals_at(x1fptr.data(), fldcnt, myoffset) != fldcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                << std::endl << "Input b0.x1f field not read correctly from rst file, "
-                << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += fldcnt*sizeof(Real);
-
-        // get ptr to x2-face field
-        auto x2fptr = Kokkos::subview(fcin.x2f, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
-        fldcnt = x2fptr.size();
-
-        if (resfile.Read_Reals_at(x2fptr.data(), fldcnt, myoffset) != fldcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                << std::endl << "Input b0.x2f field not read correctly from rst file, "
-                << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += fldcnt*sizeof(Real);
-
-        // get ptr to x3-face field
-        auto x3fptr = Kokkos::subview(fcin.x3f, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
-        fldcnt = x3fptr.size();
-
-        if (resfile.Read_Reals_at(x3fptr.data(), fldcnt, myoffset) != fldcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                << std::endl << "Input b0.x3f field not read correctly from rst file, "
+    } else if (resfile.Read_bytes_at_all(hb.data(), 1, nbytes,
+               headeroffset + data_size*(mygids + m0)) != nbytes) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "MeshBlock data not read correctly from rst file, "
                 << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += fldcnt*sizeof(Real);
-
-        myoffset += data_size-(x1fptr.size()+x2fptr.size()+x3fptr.size())*sizeof(Real);
-      }
+      exit(EXIT_FAILURE);
     }
-    Kokkos::deep_copy(Kokkos::subview(pmhd->b0.x1f, std::make_pair(0,nmb), Kokkos::ALL,
-                      Kokkos::ALL, Kokkos::ALL), fcin.x1f);
-    Kokkos::deep_copy(Kokkos::subview(pmhd->b0.x2f, std::make_pair(0,nmb), Kokkos::ALL,
-                      Kokkos::ALL, Kokkos::ALL), fcin.x2f);
-    Kokkos::deep_copy(Kokkos::subview(pmhd->b0.x3f, std::make_pair(0,nmb), Kokkos::ALL,
-                      Kokkos::ALL, Kokkos::ALL), fcin.x3f);
-    offset_myrank += (nout1+1)*nout2*nout3*sizeof(Real);    // mhd b0.x1f
-    offset_myrank += nout1*(nout2+1)*nout3*sizeof(Real);    // mhd b0.x2f
-    offset_myrank += nout1*nout2*(nout3+1)*sizeof(Real);    // mhd b0.x3f
-    myoffset = offset_myrank;
-  }
-
-  if (prad != nullptr) {
-    Kokkos::realloc(ccin, nmb, nrad, nout3, nout2, nout1);
-    for (int m=0;  m<noutmbs_max; ++m) {
-      // every rank has a MB to read, so read collectively
-      if (m < noutmbs_min) {
-        // get ptr to cell-centered MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at_all(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC rad data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-
-      // some ranks are finished writing, so use non-collective write
-      } else if (m < pm->nmb_thisrank) {
-        // get ptr to MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC rad data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-      }
+    // previous chunk must be on device before its buffer is reused for next chunk
+    Kokkos::fence();
+    if (nmbc == 0) continue;
+
+    auto range = std::make_pair(0, nmbc*rsize);
+    Kokkos::deep_copy(DevExeSpace(), Kokkos::subview(dbuf, range),
+                      Kokkos::subview(hb, range));
+    int pos = 0;
+    if (phydro != nullptr) {
+      pos = UnpackRestartData(dbuf, rsize, pos, m0, nmbc, phydro->u0);
     }
-    Kokkos::deep_copy(Kokkos::subview(prad->i0, std::make_pair(0,nmb), Kokkos::ALL,
-                      Kokkos::ALL, Kokkos::ALL, Kokkos::ALL), ccin);
-    offset_myrank += nout1*nout2*nout3*nrad*sizeof(Real);   // radiation i0
-    myoffset = offset_myrank;
-  }
-
-  if (pturb != nullptr) {
-    Kokkos::realloc(ccin, nmb, nforce, nout3, nout2, nout1);
-    for (int m=0;  m<noutmbs_max; ++m) {
-      // every rank has a MB to read, so read collectively
-      if (m < noutmbs_min) {
-        // get ptr to cell-centered MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at_all(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC turb data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-
-      // some ranks are finished writing, so use non-collective write
-      } else if (m < pm->nmb_thisrank) {
-        // get ptr to MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC turb data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-      }
+    if (pmhd != nullptr) {
+      pos = UnpackRestartData(dbuf, rsize, pos, m0, nmbc, pmhd->u0);
+      pos = UnpackRestartData(dbuf, rsize, pos, m0, nmbc, pmhd->b0.x1f);
+      pos = UnpackRestartData(dbuf, rsize, pos, m0, nmbc, pmhd->b0.x2f);
+      pos = UnpackRestartData(dbuf, rsize, pos, m0, nmbc, pmhd->b0.x3f);
     }
-    Kokkos::deep_copy(Kokkos::subview(pturb->force, std::make_pair(0,nmb), Kokkos::ALL,
-                      Kokkos::ALL, Kokkos::ALL, Kokkos::ALL), ccin);
-    offset_myrank += nout1*nout2*nout3*nforce*sizeof(Real); // forcing
-    myoffset = offset_myrank;
-  }
-
-  if (pz4c != nullptr) {
-    Kokkos::realloc(ccin, nmb, nz4c, nout3, nout2, nout1);
-    for (int m=0;  m<noutmbs_max; ++m) {
-      // every rank has a MB to read, so read collectively
-      if (m < noutmbs_min) {
-        // get ptr to cell-centered MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at_all(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC z4c data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-
-      // some ranks are finished writing, so use non-collective write
-      } else if (m < pm->nmb_thisrank) {
-        // get ptr to MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC z4c data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
+    if (prad != nullptr) {
+      if (layout.float_rad) {
+        pos = UnpackRestartFloat(dbuf, rsize, pos, m0, nmbc, prad->i0);
+      } else {
+        pos = UnpackRestartData(dbuf, rsize, pos, m0, nmbc, prad->i0);
       }
     }
-    Kokkos::deep_copy(Kokkos::subview(pz4c->u0, std::make_pair(0,nmb), Kokkos::ALL,
-                      Kokkos::ALL, Kokkos::ALL, Kokkos::ALL), ccin);
-    offset_myrank += nout1*nout2*nout3*nz4c*sizeof(Real);   // z4c u0
-    myoffset = offset_myrank;
-
-    // We also need to reinitialize the ADM data.
-    pz4c->Z4cToADM(pmy_mesh_->pmb_pack);
-  } else if (padm != nullptr) {
-    Kokkos::realloc(ccin, nmb, nadm, nout3, nout2, nout1);
-    for (int m=0;  m<noutmbs_max; ++m) {
-      // every rank has a MB to read, so read collectively
-      if (m < noutmbs_min) {
-        // get ptr to cell-centered MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at_all(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC adm data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
-
-      // some ranks are finished writing, so use non-collective write
-      } else if (m < pm->nmb_thisrank) {
-        // get ptr to MeshBlock data
-        auto mbptr = Kokkos::subview(ccin, m, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL,
-                                     Kokkos::ALL);
-        int mbcnt = mbptr.size();
-        if (resfile.Read_Reals_at(mbptr.data(), mbcnt, myoffset) != mbcnt) {
-          std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
-                    << std::endl << "CC adm data not read correctly from rst file, "
-                    << "restart file is broken." << std::endl;
-          exit(EXIT_FAILURE);
-        }
-        myoffset += data_size;
+    // with white-noise driving the omitted force is regenerated in the first cycle
+    if (pturb != nullptr && !(layout.skip_force)) {
+      if (layout.float_force) {
+        pos = UnpackRestartFloat(dbuf, rsize, pos, m0, nmbc, pturb->force);
+      } else {
+        pos = UnpackRestartData(dbuf, rsize, pos, m0, nmbc, pturb->force);
       }
     }
-    Kokkos::deep_copy(Kokkos::subview(padm->u_adm, std::make_pair(0,nmb), Kokkos::ALL,
-                      Kokkos::ALL, Kokkos::ALL, Kokkos::ALL), ccin);
-    offset_myrank += nout1*nout2*nout3*nadm*sizeof(Real);   // adm u_adm
-    myoffset = offset_myrank;
+    if (pz4c != nullptr) {
+      pos = UnpackRestartData(dbuf, rsize, pos, m0, nmbc, pz4c->u0);
+    } else if (padm != nullptr) {
+      pos = UnpackRestartData(dbuf, rsize, pos, m0, nmbc, padm->u_adm);
+    }
   }
+  Kokkos::fence();
 
   // call problem generator again to re-initialize data, fn ptrs, as needed
 #if USER_PROBLEM_ENABLED
@@ -658,6 +464,10 @@ ProblemGenerator::ProblemGenerator(ParameterInput *pin, Mesh *pm, IOWrapper resf
     SphericalCollapse(pin, true);
   } else if (pgen_fun_name.compare("diffusion") == 0) {
     Diffusion(pin, true);
+  } else if (pgen_fun_name.compare("kernel_bench") == 0) {
+    KernelBench(pin, true);
+  } else if (pgen_fun_name.compare("scaling") == 0) {
+    Scaling(pin, true);
   } else {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
         << "Problem generator name could not be found in <problem> block in input file"
@@ -20,6 +20,7 @@ using UserBoundaryFnPtr = void (*)(Mesh* pm);
 using UserSrctermFnPtr = void (*)(Mesh* pm, const Real bdt);
 using UserRefinementFnPtr = void (*)(MeshBlockPack* pmbp);
 using UserHistoryFnPtr = void (*)(HistoryData *pdata, Mesh *pm);
+using UserBeamMaskFnPtr = void (*)(MeshBlockPack* pmbp, DvceArray5D<bool> &mask);
 
 //----------------------------------------------------------------------------------------
 //! \class ProblemGenerator
@@ -52,6 +53,9 @@ class ProblemGenerator {
   UserSrctermFnPtr user_srcs_func=nullptr;
   UserRefinementFnPtr user_ref_func=nullptr;
   UserHistoryFnPtr user_hist_func=nullptr;
+  // function pointer for user-enrolled mask of (angle,cell) pairs of radiation beam
+  // source.  Called by Radiation::BuildBeamList() each time the mesh changes
+  UserBeamMaskFnPtr user_beam_func=nullptr;
 
   // predefined problem generator functions (default test suite)
   void Advection(ParameterInput *pin, const bool restart);
@@ -68,6 +72,8 @@ class ProblemGenerator {
   void Z4cLinearWave(ParameterInput *pin, const bool restart);
   void SphericalCollapse(ParameterInput *pin, const bool restart);
   void Diffusion(ParameterInput *pin, const bool restart);
+  void KernelBench(ParameterInput *pin, const bool restart);
+  void Scaling(ParameterInput *pin, const bool restart);
 
   // template for user-specified problem generator
   void UserProblem(ParameterInput *pin, const bool restart);
@@ -25,21 +25,48 @@
 #include "radiation/radiation_tetrad.hpp"
 #include "pgen.hpp"
 
-// Prototypes for user-defined BCs
+// Prototypes for user-defined BCs and beam source mask
 void ZeroIntensity(Mesh *pm);
+void BeamMask(MeshBlockPack *pmbp, DvceArray5D<bool> &beam_mask);
+
+namespace {
+// position, direction, width and angular spread (in degrees) of the beam
+struct BeamParams {
+  Real p1, p2, p3, d1, d2, d3, width, spread;
+};
+BeamParams beam;
+} // namespace
 
 //----------------------------------------------------------------------------------------
 //! \fn void MeshBlock::UserProblem(ParameterInput *pin)
 //! \brief Sets initial conditions for GR radiation beam test
 
 void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
-  MeshBlockPack *pmbp = pmy_mesh_->pmb_pack;
-
   // User boundary function
   user_bcs_func = ZeroIntensity;
+  // beam source mask, evaluated by Radiation each time the mesh changes
+  user_beam_func = BeamMask;
+
+  beam.p1 = pin->GetReal("problem", "pos_1");
+  beam.p2 = pin->GetReal("problem", "pos_2");
+  beam.p3 = pin->GetReal("problem", "pos_3");
+  beam.d1 = pin->GetReal("problem", "dir_1");
+  beam.d2 = pin->GetReal("problem", "dir_2");
+  beam.d3 = pin->GetReal("problem", "dir_3");
+  beam.width = pin->GetReal("problem", "width");
+  beam.spread = pin->GetReal("problem", "spread");
+
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BeamMask()
+//! \brief Sets beam_mask(m,n,k,j,i) true for angles n within spread/2 of the beam
+//! direction in cells within (proper) distance width/2 of the beam origin.
 
+void BeamMask(MeshBlockPack *pmbp, DvceArray5D<bool> &beam_mask) {
   // capture variables for kernel
-  auto &indcs = pmy_mesh_->mb_indcs;
+  auto &indcs = pmbp->pmesh->mb_indcs;
   int &is = indcs.is; int &ie = indcs.ie;
   int &js = indcs.js; int &je = indcs.je;
   int &ks = indcs.ks; int &ke = indcs.ke;
@@ -49,19 +76,13 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
   auto &flat = pmbp->pcoord->coord_data.is_minkowski;
   auto &spin = pmbp->pcoord->coord_data.bh_spin;
 
-  // set initial condition intensity and beam source mask
-  Real p1 = pin->GetReal("problem", "pos_1");
-  Real p2 = pin->GetReal("problem", "pos_2");
-  Real p3 = pin->GetReal("problem", "pos_3");
-  Real d1 = pin->GetReal("problem", "dir_1");
-  Real d2 = pin->GetReal("problem", "dir_2");
-  Real d3 = pin->GetReal("problem", "dir_3");
-  Real width_ = pin->GetReal("problem", "width");
-  Real spread_ = pin->GetReal("problem", "spread");
+  Real p1 = beam.p1, p2 = beam.p2, p3 = beam.p3;
+  Real d1 = beam.d1, d2 = beam.d2, d3 = beam.d3;
+  Real width_ = beam.width;
+  Real spread_ = beam.spread;
 
   auto &nh_c_ = pmbp->prad->nh_c;
   auto &tet_c_ = pmbp->prad->tet_c;
-  auto &beam_mask = pmbp->prad->beam_mask;
   par_for("rad_beam",DevExeSpace(),0,nmb1,ks,ke,js,je,is,ie,
   KOKKOS_LAMBDA(int m, int k, int j, int i) {
     Real &x1min = size.d_view(m).x1min;
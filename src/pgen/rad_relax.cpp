@@ -17,6 +17,7 @@
 #include "hydro/hydro.hpp"
 #include "driver/driver.hpp"
 #include "radiation/radiation.hpp"
+#include "radiation/radiation_m1.hpp"
 
 //----------------------------------------------------------------------------------------
 //! \fn void MeshBlock::UserProblem(ParameterInput *pin)
@@ -40,7 +41,8 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
   auto &size = pmbp->pmb->mb_size;
   auto &coord = pmbp->pcoord->coord_data;
   int nmb1 = (pmbp->nmb_thispack-1);
-  int nang1 = (pmbp->prad->prgeo->nangles-1);
+  bool m1 = pmbp->prad->m1_closure;
+  int nang1 = (m1)? -1 : (pmbp->prad->prgeo->nangles-1);
 
   // get problem parameters
   Real erad = pin->GetReal("problem", "erad");
@@ -87,6 +89,19 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
     u_tet_[3] = (norm_to_tet_(m,3,0,k,j,i)*uu0 + norm_to_tet_(m,3,1,k,j,i)*uu1 +
                  norm_to_tet_(m,3,2,k,j,i)*uu2 + norm_to_tet_(m,3,3,k,j,i)*uu3);
 
+    // With M1, boost isotropic radiation in fluid frame to tetrad frame
+    if (m1) {
+      Real lam[4][4];
+      M1Boost(u_tet_, true, lam);
+      Real rf[4] = {erad, erad/3.0, erad/3.0, erad/3.0};
+      for (int a=0; a<4; ++a) {
+        Real r0a = 0.0;
+        for (int c=0; c<4; ++c) {r0a += lam[0][c]*lam[a][c]*rf[c];}
+        i0(m,a,k,j,i) = r0a;
+      }
+      return;
+    }
+
     // Go through each angle
     for (int n=0; n<=nang1; ++n) {
       // Calculate direction in fluid frame
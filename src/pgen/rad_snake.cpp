@@ -8,6 +8,7 @@
 
 // C++ headers
 #include <algorithm>  // min, max
+#include <cstdlib>    // exit
 #include <iostream>   // endl
 #include <sstream>    // stringstream
 #include <stdexcept>  // runtime_error
@@ -28,6 +29,17 @@ void ComputeSnakeMetricAndTetrad(Real x, Real y, Real z,
                                  const Real mag, const Real kym, const bool snake_tet,
                                  Real g[][4], Real gi[][4],
                                  Real e[][4], Real ecov[][4], Real omega[][4][4]);
+void BeamMask(MeshBlockPack *pmbp, DvceArray5D<bool> &beam_mask);
+
+namespace {
+// snake parameters, and position, width and angular spread (in degrees) of the beam
+struct SnakeParams {
+  Real mag, kym;
+  bool snake_tet;
+  Real p1, p2, p3, width, spread;
+};
+SnakeParams snake;
+} // namespace
 
 //----------------------------------------------------------------------------------------
 //! \fn void MeshBlock::UserProblem(ParameterInput *pin)
@@ -35,6 +47,18 @@ void ComputeSnakeMetricAndTetrad(Real x, Real y, Real z,
 
 void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
   MeshBlockPack *pmbp = pmy_mesh_->pmb_pack;
+  if (pmbp->prad->recompute_tetrad) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Snake tetrad must be stored, set <radiation>/recompute_tetrad = false"
+              << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  if (pmbp->prad->coarsen > 1) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "Snake tetrad is set on the grid of the MeshBlocks, set "
+              << "<radiation>/coarsen = 1" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
 
   // capture variables for kernel
   auto &indcs = pmy_mesh_->mb_indcs;
@@ -186,13 +210,42 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
     for (int d=0; d<4; ++d) { tet_d3_x3f_   (m,d,k,j,i) = e[d][3]; }
   });
 
-  // set initial condition intensity and beam source mask
-  Real p1 = pin->GetReal("problem", "pos_1");
-  Real p2 = pin->GetReal("problem", "pos_2");
-  Real p3 = pin->GetReal("problem", "pos_3");
-  Real width_ = pin->GetReal("problem", "width");
-  Real spread_ = pin->GetReal("problem", "spread");
-  auto &beam_mask = pmbp->prad->beam_mask;
+  // beam source mask, evaluated by Radiation each time the mesh changes
+  snake.mag = mag;
+  snake.kym = kym;
+  snake.snake_tet = snake_tet;
+  snake.p1 = pin->GetReal("problem", "pos_1");
+  snake.p2 = pin->GetReal("problem", "pos_2");
+  snake.p3 = pin->GetReal("problem", "pos_3");
+  snake.width = pin->GetReal("problem", "width");
+  snake.spread = pin->GetReal("problem", "spread");
+  user_beam_func = BeamMask;
+
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void BeamMask()
+//! \brief Sets beam_mask(m,n,k,j,i) true for angles n within spread/2 of the direction
+//! of the snake in cells within (proper) distance width/2 of the beam origin.
+
+void BeamMask(MeshBlockPack *pmbp, DvceArray5D<bool> &beam_mask) {
+  // capture variables for kernel
+  auto &indcs = pmbp->pmesh->mb_indcs;
+  int &is = indcs.is; int &ie = indcs.ie;
+  int &js = indcs.js; int &je = indcs.je;
+  int &ks = indcs.ks; int &ke = indcs.ke;
+  int nmb1 = (pmbp->nmb_thispack-1);
+  int nang1 = (pmbp->prad->prgeo->nangles-1);
+  auto &size = pmbp->pmb->mb_size;
+  auto &nh_c_ = pmbp->prad->nh_c;
+  auto &tet_c_ = pmbp->prad->tet_c;
+  Real mag = snake.mag, kym = snake.kym;
+  bool snake_tet = snake.snake_tet;
+
+  Real p1 = snake.p1, p2 = snake.p2, p3 = snake.p3;
+  Real width_ = snake.width;
+  Real spread_ = snake.spread;
   par_for("rad_beam",DevExeSpace(),0,nmb1,ks,ke,js,je,is,ie,
   KOKKOS_LAMBDA(int m, int k, int j, int i) {
     Real &x1min = size.d_view(m).x1min;
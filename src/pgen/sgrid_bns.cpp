@@ -123,7 +123,7 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
     mkdir("SGRID", 0775);
   }
 #if MPI_PARALLEL_ENABLED
-  (void)MPI_Barrier(MPI_COMM_WORLD);
+  (void)MPI_Barrier(global_variable::mpi_comm);
 #endif
 
   MeshBlockPack *pmbp = pmy_mesh_->pmb_pack;
@@ -203,135 +203,153 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
   int ncells3 = indcs.nx3 + 2 * (indcs.ng);
   int nmb = pmbp->nmb_thispack;
 
-  // TODO(DR): Use a Kokkos loop to improve performance
-  for (int m = 0; m < nmb; m++)
-    for (int k = 0; k < ncells3; k++)
-      for (int j = 0; j < ncells2; j++)
-        for (int i = 0; i < ncells1; i++) {
-          Real &x1min = size.h_view(m).x1min;
-          // not to be confused by xmax1, which is used by SGRID
-          Real &x1max = size.h_view(m).x1max;
-          int nx1 = indcs.nx1;
-
-          Real &x2min = size.h_view(m).x2min;
-          // not to be confused by xmax2, which is used by SGRID
-          Real &x2max = size.h_view(m).x2max;
-          int nx2 = indcs.nx2;
-
-          Real &x3min = size.h_view(m).x3min;
-          Real &x3max = size.h_view(m).x3max;
-          int nx3 = indcs.nx3;
-
-          const Real z = CellCenterX(k - ks, nx3, x3min, x3max);
-          const Real y = CellCenterX(j - js, nx2, x2min, x2max);
-          const Real x = CellCenterX(i - is, nx1, x1min, x1max);
-
-          Real zb = z;
-          Real yb = y * s180; // multiply by -1 if 180 degree rotation
-          Real xb = x * s180;
-          Real xs = xb + sgrid_x_CM; // shift x-coord
-          Real xyz[3] = {xs, yb, zb};
-
-          // Initial data variables at one point
-          // 20 values for the fields at (x_i,y_j,z_k) ordered as:
-          //  alpha DNSdata_Bx DNSdata_By DNSdata_Bz
-          //  gxx gxy gxz gyy gyz gzz
-          //  Kxx Kxy Kxz Kyy Kyz Kzz
-          //  q VRx VRy VRz
-          Real IDvars[idvar_NDATAMAX];
-
-          // Interpolate
-          // This call is supposed to be threadsafe, it contains an OMP Critical
-          SGRID_DNSdata_Interpolate_ADMvars_to_xyz(xyz, IDvars, 0);
-
-          // transform some tensor components, if we have a 180 degree rotation
-          IDvars[idvar_Bx] *= s180;
-          IDvars[idvar_By] *= s180;
-          IDvars[idvar_gxz] *= s180;
-          IDvars[idvar_gyz] *= s180;
-          IDvars[idvar_Kxz] *= s180;
-          IDvars[idvar_Kyz] *= s180;
-          IDvars[idvar_VRx] *= s180;
-          IDvars[idvar_VRy] *= s180;
-
-          // Extract metric quantities
-          host_adm.alpha(m, k, j, i) = IDvars[idvar_alpha];
-          host_adm.beta_u(m, 0, k, j, i) = IDvars[idvar_Bx];
-          host_adm.beta_u(m, 1, k, j, i) = IDvars[idvar_By];
-          host_adm.beta_u(m, 2, k, j, i) = IDvars[idvar_Bz];
-
-          Real g3d[NSPMETRIC];
-          host_adm.g_dd(m, 0, 0, k, j, i) = g3d[S11] = IDvars[idvar_gxx];
-          host_adm.g_dd(m, 0, 1, k, j, i) = g3d[S12] = IDvars[idvar_gxy];
-          host_adm.g_dd(m, 0, 2, k, j, i) = g3d[S13] = IDvars[idvar_gxz];
-          host_adm.g_dd(m, 1, 1, k, j, i) = g3d[S22] = IDvars[idvar_gyy];
-          host_adm.g_dd(m, 1, 2, k, j, i) = g3d[S23] = IDvars[idvar_gyz];
-          host_adm.g_dd(m, 2, 2, k, j, i) = g3d[S33] = IDvars[idvar_gzz];
-
-          host_adm.vK_dd(m, 0, 0, k, j, i) = IDvars[idvar_Kxx];
-          host_adm.vK_dd(m, 0, 1, k, j, i) = IDvars[idvar_Kxy];
-          host_adm.vK_dd(m, 0, 2, k, j, i) = IDvars[idvar_Kxz];
-          host_adm.vK_dd(m, 1, 1, k, j, i) = IDvars[idvar_Kyy];
-          host_adm.vK_dd(m, 1, 2, k, j, i) = IDvars[idvar_Kyz];
-          host_adm.vK_dd(m, 2, 2, k, j, i) = IDvars[idvar_Kzz];
-
-          // Extract hydro quantities
-          Real rho = 0;
-          Real press = 0;
-          Real eps = 0;
-          Real v_u_x = 0, v_u_y = 0, v_u_z = 0;
-
-          // if we are in matter region, convert q, VR to rho, press, eps, v^i :
-          if (IDvars[idvar_q] > 0.0) {
-            SGRID_EoS_T0_rho0_P_rhoE_from_hm1(IDvars[idvar_q], &rho, &press,
-                                              &eps);
-
-            // 3-velocity  v^i
-            Real xmax = (xb > 0) ? xmax1 : xmax2;
-
-            // construct KV xi from Omega, ecc, rdot, xmax1-xmax2
-            Real xix = -Omega * yb + xb * rdotor; // CM is at (0,0,0) in bam
-            Real xiy = Omega * (xb - ecc * xmax) + yb * rdotor;
-            Real xiz = zb * rdotor;
-
-            // vI^i = VR^i + xi^i
-            Real vIx = IDvars[idvar_VRx] + xix;
-            Real vIy = IDvars[idvar_VRy] + xiy;
-            Real vIz = IDvars[idvar_VRz] + xiz;
-
-            // Note: vI^i = u^i/u^0 in DNSdata,
-            //       while matter_v^i = u^i/(alpha u^0) + beta^i / alpha
-            //   ==> matter_v^i = (vI^i + beta^i)/alpha
-            v_u_x = (vIx + IDvars[idvar_Bx]) / IDvars[idvar_alpha];
-            v_u_y = (vIy + IDvars[idvar_By]) / IDvars[idvar_alpha];
-            v_u_z = (vIz + IDvars[idvar_Bz]) / IDvars[idvar_alpha];
-          }
-
-          // Store fluid quantities
-          host_w0(m, IDN, k, j, i) = rho;
-          host_w0(m, IPR, k, j, i) = press;
-          Real vu[3] = {v_u_x, v_u_y, v_u_z};
-
-          // Before we store the velocity, we need to make sure it's physical
-          // and calculate the Lorentz factor. If the velocity is superluminal,
-          // we make a last-ditch attempt to salvage the solution by rescaling
-          // it to vsq = 1.0 - 1e-15
-          Real vsq = Primitive::SquareVector(vu, g3d);
-          if (1.0 - vsq <= 0) {
-            std::cout << "The velocity is superluminal!" << std::endl
-                      << "Attempting to adjust..." << std::endl;
-            Real fac = sqrt((1.0 - 1e-15) / vsq);
-            vu[0] *= fac;
-            vu[1] *= fac;
-            vu[2] *= fac;
-            vsq = 1.0 - 1.0e-15;
-          }
-          Real W = sqrt(1.0 / (1.0 - vsq));
-
-          host_w0(m, IVX, k, j, i) = W * vu[0];
-          host_w0(m, IVY, k, j, i) = W * vu[1];
-          host_w0(m, IVZ, k, j, i) = W * vu[2];
-        }
+  // Interpolation at each point is independent, so points can be filled in parallel on
+  // the host if SGRID was built with a thread-safe interpolator.  Otherwise points are
+  // filled serially.  Cells with superluminal velocities are counted, and reported once.
+  const bool parallel_interp = pin->GetOrAddBoolean("problem", "parallel_interp", false);
+  const int width = nmb*ncells3*ncells2*ncells1;
+  const int nkji = ncells3*ncells2*ncells1;
+  const int nji  = ncells2*ncells1;
+  auto fill_point = [&](const int idx, int &nfix) {
+    int m = (idx)/nkji;
+    int k = (idx - m*nkji)/nji;
+    int j = (idx - m*nkji - k*nji)/ncells1;
+    int i = (idx - m*nkji - k*nji - j*ncells1);
+    Real &x1min = size.h_view(m).x1min;
+    // not to be confused by xmax1, which is used by SGRID
+    Real &x1max = size.h_view(m).x1max;
+    int nx1 = indcs.nx1;
+
+    Real &x2min = size.h_view(m).x2min;
+    // not to be confused by xmax2, which is used by SGRID
+    Real &x2max = size.h_view(m).x2max;
+    int nx2 = indcs.nx2;
+
+    Real &x3min = size.h_view(m).x3min;
+    Real &x3max = size.h_view(m).x3max;
+    int nx3 = indcs.nx3;
+
+    const Real z = CellCenterX(k - ks, nx3, x3min, x3max);
+    const Real y = CellCenterX(j - js, nx2, x2min, x2max);
+    const Real x = CellCenterX(i - is, nx1, x1min, x1max);
+
+    Real zb = z;
+    Real yb = y * s180; // multiply by -1 if 180 degree rotation
+    Real xb = x * s180;
+    Real xs = xb + sgrid_x_CM; // shift x-coord
+    Real xyz[3] = {xs, yb, zb};
+
+    // Initial data variables at one point
+    // 20 values for the fields at (x_i,y_j,z_k) ordered as:
+    //  alpha DNSdata_Bx DNSdata_By DNSdata_Bz
+    //  gxx gxy gxz gyy gyz gzz
+    //  Kxx Kxy Kxz Kyy Kyz Kzz
+    //  q VRx VRy VRz
+    Real IDvars[idvar_NDATAMAX];
+
+    // Interpolate
+    // This call is supposed to be threadsafe, it contains an OMP Critical
+    SGRID_DNSdata_Interpolate_ADMvars_to_xyz(xyz, IDvars, 0);
+
+    // transform some tensor components, if we have a 180 degree rotation
+    IDvars[idvar_Bx] *= s180;
+    IDvars[idvar_By] *= s180;
+    IDvars[idvar_gxz] *= s180;
+    IDvars[idvar_gyz] *= s180;
+    IDvars[idvar_Kxz] *= s180;
+    IDvars[idvar_Kyz] *= s180;
+    IDvars[idvar_VRx] *= s180;
+    IDvars[idvar_VRy] *= s180;
+
+    // Extract metric quantities
+    host_adm.alpha(m, k, j, i) = IDvars[idvar_alpha];
+    host_adm.beta_u(m, 0, k, j, i) = IDvars[idvar_Bx];
+    host_adm.beta_u(m, 1, k, j, i) = IDvars[idvar_By];
+    host_adm.beta_u(m, 2, k, j, i) = IDvars[idvar_Bz];
+
+    Real g3d[NSPMETRIC];
+    host_adm.g_dd(m, 0, 0, k, j, i) = g3d[S11] = IDvars[idvar_gxx];
+    host_adm.g_dd(m, 0, 1, k, j, i) = g3d[S12] = IDvars[idvar_gxy];
+    host_adm.g_dd(m, 0, 2, k, j, i) = g3d[S13] = IDvars[idvar_gxz];
+    host_adm.g_dd(m, 1, 1, k, j, i) = g3d[S22] = IDvars[idvar_gyy];
+    host_adm.g_dd(m, 1, 2, k, j, i) = g3d[S23] = IDvars[idvar_gyz];
+    host_adm.g_dd(m, 2, 2, k, j, i) = g3d[S33] = IDvars[idvar_gzz];
+
+    host_adm.vK_dd(m, 0, 0, k, j, i) = IDvars[idvar_Kxx];
+    host_adm.vK_dd(m, 0, 1, k, j, i) = IDvars[idvar_Kxy];
+    host_adm.vK_dd(m, 0, 2, k, j, i) = IDvars[idvar_Kxz];
+    host_adm.vK_dd(m, 1, 1, k, j, i) = IDvars[idvar_Kyy];
+    host_adm.vK_dd(m, 1, 2, k, j, i) = IDvars[idvar_Kyz];
+    host_adm.vK_dd(m, 2, 2, k, j, i) = IDvars[idvar_Kzz];
+
+    // Extract hydro quantities
+    Real rho = 0;
+    Real press = 0;
+    Real eps = 0;
+    Real v_u_x = 0, v_u_y = 0, v_u_z = 0;
+
+    // if we are in matter region, convert q, VR to rho, press, eps, v^i :
+    if (IDvars[idvar_q] > 0.0) {
+      SGRID_EoS_T0_rho0_P_rhoE_from_hm1(IDvars[idvar_q], &rho, &press,
+                                        &eps);
+
+      // 3-velocity  v^i
+      Real xmax = (xb > 0) ? xmax1 : xmax2;
+
+      // construct KV xi from Omega, ecc, rdot, xmax1-xmax2
+      Real xix = -Omega * yb + xb * rdotor; // CM is at (0,0,0) in bam
+      Real xiy = Omega * (xb - ecc * xmax) + yb * rdotor;
+      Real xiz = zb * rdotor;
+
+      // vI^i = VR^i + xi^i
+      Real vIx = IDvars[idvar_VRx] + xix;
+      Real vIy = IDvars[idvar_VRy] + xiy;
+      Real vIz = IDvars[idvar_VRz] + xiz;
+
+      // Note: vI^i = u^i/u^0 in DNSdata,
+      //       while matter_v^i = u^i/(alpha u^0) + beta^i / alpha
+      //   ==> matter_v^i = (vI^i + beta^i)/alpha
+      v_u_x = (vIx + IDvars[idvar_Bx]) / IDvars[idvar_alpha];
+      v_u_y = (vIy + IDvars[idvar_By]) / IDvars[idvar_alpha];
+      v_u_z = (vIz + IDvars[idvar_Bz]) / IDvars[idvar_alpha];
+    }
+
+    // Store fluid quantities
+    host_w0(m, IDN, k, j, i) = rho;
+    host_w0(m, IPR, k, j, i) = press;
+    Real vu[3] = {v_u_x, v_u_y, v_u_z};
+
+    // Before we store the velocity, we need to make sure it's physical
+    // and calculate the Lorentz factor. If the velocity is superluminal,
+    // we make a last-ditch attempt to salvage the solution by rescaling
+    // it to vsq = 1.0 - 1e-15
+    Real vsq = Primitive::SquareVector(vu, g3d);
+    if (1.0 - vsq <= 0) {
+      nfix++;
+      Real fac = sqrt((1.0 - 1e-15) / vsq);
+      vu[0] *= fac;
+      vu[1] *= fac;
+      vu[2] *= fac;
+      vsq = 1.0 - 1.0e-15;
+    }
+    Real W = sqrt(1.0 / (1.0 - vsq));
+
+    host_w0(m, IVX, k, j, i) = W * vu[0];
+    host_w0(m, IVY, k, j, i) = W * vu[1];
+    host_w0(m, IVZ, k, j, i) = W * vu[2];
+  };
+  int nsuperluminal = 0;
+  if (parallel_interp) {
+    Kokkos::parallel_reduce("pgen_sgrid",
+    Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, width),
+    fill_point, Kokkos::Sum<int>(nsuperluminal));
+  } else {
+    for (int idx = 0; idx < width; idx++) {fill_point(idx, nsuperluminal);}
+  }
+  if (nsuperluminal > 0) {
+    std::cout << "The velocity is superluminal in " << nsuperluminal << " cells!"
+              << std::endl << "Velocities were adjusted to vsq = 1 - 1e-15." << std::endl;
+  }
 
   if (verbose)
     std::cout << "Host mirrors filled." << std::endl;
@@ -390,7 +408,7 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
 
   pmbp->pdyngr->PrimToConInit(0, (ncells1 - 1), 0, (ncells2 - 1), 0,
                               (ncells3 - 1));
-  switch (indcs.ng) {
+  switch (pmbp->pz4c->fd_ng) {
   case 2:
     pmbp->pz4c->ADMToZ4c<2>(pmbp, pin);
     break;
@@ -451,14 +469,14 @@ void SGRIDHistory(HistoryData *pdata, Mesh *pm) {
 #if MPI_PARALLEL_ENABLED
   if (global_variable::my_rank == 0) {
     MPI_Reduce(MPI_IN_PLACE, &rho_max, 1, MPI_ATHENA_REAL, MPI_MAX, 0,
-               MPI_COMM_WORLD);
+               global_variable::mpi_comm);
     MPI_Reduce(MPI_IN_PLACE, &alpha_min, 1, MPI_ATHENA_REAL, MPI_MIN, 0,
-               MPI_COMM_WORLD);
+               global_variable::mpi_comm);
   } else {
     MPI_Reduce(&rho_max, &rho_max, 1, MPI_ATHENA_REAL, MPI_MAX, 0,
-               MPI_COMM_WORLD);
+               global_variable::mpi_comm);
     MPI_Reduce(&alpha_min, &alpha_min, 1, MPI_ATHENA_REAL, MPI_MAX, 0,
-               MPI_COMM_WORLD);
+               global_variable::mpi_comm);
     rho_max = 0.;
     alpha_min = 0.;
   }
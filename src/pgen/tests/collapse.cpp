@@ -146,7 +146,7 @@ void ProblemGenerator::SphericalCollapse(ParameterInput *pin, const bool restart
 
   pmbp->pdyngr->PrimToConInit(is, ie, js, je, ks, ke);
   if (pmbp->pz4c != nullptr) {
-    switch (indcs.ng) {
+    switch (pmbp->pz4c->fd_ng) {
       case 2: pmbp->pz4c->ADMToZ4c<2>(pmbp, pin);
               break;
       case 3: pmbp->pz4c->ADMToZ4c<3>(pmbp, pin);
@@ -349,10 +349,10 @@ void BondiErrors(ParameterInput *pin, Mesh *pm) {
   // sum over all ranks
   if (global_variable::my_rank == 0) {
     MPI_Reduce(MPI_IN_PLACE, l1_err, 8, MPI_DOUBLE, MPI_SUM, 0,
-               MPI_COMM_WORLD);
+               global_variable::mpi_comm);
   } else {
     MPI_Reduce(l1_err, l1_err, 8, MPI_DOUBLE, MPI_SUM, 0,
-               MPI_COMM_WORLD);
+               global_variable::mpi_comm);
   }
 #endif
 
@@ -785,7 +785,7 @@ void MonopoleDiagnostic(ParameterInput *pin, Mesh *pm) {
 
 #if MPI_PARALLEL_ENABLED
   MPI_Allreduce(MPI_IN_PLACE, monopole_diag.data(), psph->nangles,
-                MPI_ATHENA_REAL, MPI_SUM, MPI_COMM_WORLD);
+                MPI_ATHENA_REAL, MPI_SUM, global_variable::mpi_comm);
 #endif
 
   // root process opens output file and writes out diagnostics
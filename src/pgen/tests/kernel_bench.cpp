@@ -0,0 +1,297 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file kernel_bench.cpp
+//! \brief Problem generator that runs microbenchmarks of the most expensive kernels on a
+//! synthetic (smooth, non-trivial) state, and reports the time per call, the number of
+//! (active) cells updated per second, and the achieved memory bandwidth.  The number and
+//! size of MeshBlocks are set as usual in the <mesh> and <meshblock> blocks, and the
+//! physics to be benchmarked by which of the <hydro>, <mhd>, <z4c>, and <radiation>
+//! blocks exist in the input file.  The following are timed:
+//!   - Hydro/MHD Fluxes() for every reconstruction method allowed by nghost, and every
+//!     (non-relativistic) Riemann solver allowed by the EOS.  With SR/GR, only the
+//!     Riemann solver in the input file is used.
+//!   - Hydro/MHD ConsToPrim() (with DynGRMHD, its ConToPrim())
+//!   - Z4c CalcRHS()
+//!   - Radiation CalculateFluxes()
+//!   - exchange (pack, send, receive, unpack) of ghost zones of Hydro/MHD/Z4c
+//! Bandwidth is computed from an estimate of the compulsory memory traffic of each
+//! kernel (each array read or written once per cell), so it is a lower bound.
+//!
+//! The benchmarks are run when the problem generator is called.  Use <time>/nlim = 0
+//! to exit immediately afterwards.  The number of calls of each kernel that are timed is
+//! set by <problem>/bench_niter.
+
+#include <iomanip>
+#include <iostream>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mesh/mesh.hpp"
+#include "driver/driver.hpp"
+#include "eos/eos.hpp"
+#include "hydro/hydro.hpp"
+#include "mhd/mhd.hpp"
+#include "dyn_grmhd/dyn_grmhd.hpp"
+#include "z4c/z4c.hpp"
+#include "radiation/radiation.hpp"
+#include "geodesic-grid/geodesic_grid.hpp"
+#include "bvals/bvals.hpp"
+#include "pgen/pgen.hpp"
+
+namespace {
+//----------------------------------------------------------------------------------------
+//! \fn void RunBench()
+//! \brief Times niter calls of func (after one untimed call), and prints the results.
+//! bytes_per_cell is the compulsory memory traffic per active cell of one call.
+
+void RunBench(const std::string &name, int niter, Real ncells, Real bytes_per_cell,
+              std::function<void()> func) {
+  func();
+  Kokkos::fence();
+  Kokkos::Timer timer;
+  for (int n=0; n<niter; ++n) {func();}
+  Kokkos::fence();
+  double t = timer.seconds()/static_cast<double>(niter);
+  if (global_variable::my_rank == 0) {
+    std::cout << std::left << std::setw(36) << name << std::right << std::scientific
+              << std::setprecision(3) << std::setw(12) << t << std::setw(12)
+              << ncells/t << std::setw(12) << 1.0e-9*ncells*bytes_per_cell/t
+              << std::endl;
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void ExchangeGhostZones()
+//! \brief Posts receives, packs and sends, then receives and unpacks ghost zones of the
+//! nvar cell-centered variables in array a, and clears buffers.  Spins until all
+//! receives are complete.
+
+void ExchangeGhostZones(MeshBoundaryValuesCC *pbval, DvceArray5D<Real> &a,
+                        DvceArray5D<Real> &ca, int nvar) {
+  pbval->InitRecv(nvar);
+  pbval->PackAndSendCC(a, ca);
+  while (pbval->RecvAndUnpackCC(a, ca) != TaskStatus::complete) {}
+  pbval->ClearSend();
+  pbval->ClearRecv();
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn void ProblemGenerator::KernelBench()
+//! \brief Sets synthetic initial conditions and runs kernel microbenchmarks
+
+void ProblemGenerator::KernelBench(ParameterInput *pin, const bool restart) {
+  if (restart) return;
+  MeshBlockPack *pmbp = pmy_mesh_->pmb_pack;
+  auto &indcs = pmy_mesh_->mb_indcs;
+  int ng = indcs.ng;
+  int nmb1 = pmbp->nmb_thispack - 1;
+  int n1 = indcs.nx1 + 2*ng;
+  int n2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng) : 1;
+  int n3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*ng) : 1;
+  int ndim = (pmy_mesh_->three_d)? 3 : ((pmy_mesh_->multi_d)? 2 : 1);
+  int niter = pin->GetOrAddInteger("problem", "bench_niter", 10);
+  Real ncells = static_cast<Real>(pmbp->nmb_thispack)*indcs.nx1*indcs.nx2*indcs.nx3;
+  Real nghost_cells = static_cast<Real>(pmbp->nmb_thispack)*n1*n2*n3 - ncells;
+  Real sreal = static_cast<Real>(sizeof(Real));
+
+  // temporary Driver, needed as argument to task functions
+  Kokkos::Timer drv_timer;
+  Driver drv(pin, pmy_mesh_, -1.0, &drv_timer);
+
+  // Set smooth state with O(10%) perturbations throughout MeshBlocks (including ghost
+  // zones), so that all branches of limiters and Riemann solvers are exercised.
+  if (pmbp->phydro != nullptr || pmbp->pmhd != nullptr) {
+    bool is_mhd = (pmbp->pmhd != nullptr);
+    EOS_Data &eos = (is_mhd)? pmbp->pmhd->peos->eos_data : pmbp->phydro->peos->eos_data;
+    auto &w0 = (is_mhd)? pmbp->pmhd->w0 : pmbp->phydro->w0;
+    par_for("bench_w0", DevExeSpace(), 0, nmb1, 0, (n3-1), 0, (n2-1), 0, (n1-1),
+    KOKKOS_LAMBDA(int m, int k, int j, int i) {
+      Real s = sin(0.3*i + 0.5*j + 0.7*k + m);
+      Real c = cos(0.4*i - 0.6*j + 0.2*k);
+      w0(m,IDN,k,j,i) = 1.0 + 0.1*s;
+      w0(m,IVX,k,j,i) = 0.1*c;
+      w0(m,IVY,k,j,i) = 0.1*s*c;
+      w0(m,IVZ,k,j,i) = -0.1*s;
+      if (eos.is_ideal) {w0(m,IEN,k,j,i) = (1.0 + 0.1*c)/(eos.gamma - 1.0);}
+    });
+    if (is_mhd) {
+      auto &b0 = pmbp->pmhd->b0;
+      auto &bcc0 = pmbp->pmhd->bcc0;
+      // uniform face-centered field (divergence free), with equal cell-centered field
+      par_for("bench_b0", DevExeSpace(), 0, nmb1, 0, (n3-1), 0, (n2-1), 0, (n1-1),
+      KOKKOS_LAMBDA(int m, int k, int j, int i) {
+        b0.x1f(m,k,j,i) = 0.5;
+        b0.x2f(m,k,j,i) = 0.3;
+        b0.x3f(m,k,j,i) = 0.2;
+        if (i == n1-1) {b0.x1f(m,k,j,i+1) = 0.5;}
+        if (j == n2-1) {b0.x2f(m,k,j+1,i) = 0.3;}
+        if (k == n3-1) {b0.x3f(m,k+1,j,i) = 0.2;}
+        bcc0(m,IBX,k,j,i) = 0.5;
+        bcc0(m,IBY,k,j,i) = 0.3;
+        bcc0(m,IBZ,k,j,i) = 0.2;
+      });
+      pmbp->pmhd->peos->PrimToCons(w0, bcc0, pmbp->pmhd->u0, 0, (n1-1), 0, (n2-1), 0,
+                                   (n3-1));
+    } else {
+      pmbp->phydro->peos->PrimToCons(w0, pmbp->phydro->u0, 0, (n1-1), 0, (n2-1), 0,
+                                     (n3-1));
+    }
+  }
+  if (pmbp->pz4c != nullptr) {
+    auto &u0 = pmbp->pz4c->u0;
+    using z4c::Z4c;
+    Kokkos::deep_copy(u0, 0.0);
+    // perturbed flat space
+    par_for("bench_z4c", DevExeSpace(), 0, nmb1, 0, (n3-1), 0, (n2-1), 0, (n1-1),
+    KOKKOS_LAMBDA(int m, int k, int j, int i) {
+      Real s = 1.0e-3*sin(0.3*i + 0.5*j + 0.7*k);
+      u0(m,Z4c::I_Z4C_CHI,k,j,i) = 1.0;
+      u0(m,Z4c::I_Z4C_GXX,k,j,i) = 1.0 + s;
+      u0(m,Z4c::I_Z4C_GYY,k,j,i) = 1.0 - s;
+      u0(m,Z4c::I_Z4C_GZZ,k,j,i) = 1.0;
+      u0(m,Z4c::I_Z4C_AXX,k,j,i) = s;
+      u0(m,Z4c::I_Z4C_AYY,k,j,i) = -s;
+      u0(m,Z4c::I_Z4C_ALPHA,k,j,i) = 1.0;
+    });
+  }
+  if (pmbp->prad != nullptr) {
+    auto &i0 = pmbp->prad->i0;
+    int nang1 = pmbp->prad->prgeo->nangles - 1;
+    par_for("bench_rad", DevExeSpace(), 0, nmb1, 0, nang1, 0, (n3-1), 0, (n2-1), 0,
+    (n1-1), KOKKOS_LAMBDA(int m, int n, int k, int j, int i) {
+      i0(m,n,k,j,i) = 1.0 + 0.1*sin(0.3*i + 0.5*j + 0.7*k + 0.1*n);
+    });
+  }
+
+  if (global_variable::my_rank == 0) {
+    std::cout << std::endl << "Kernel benchmarks on rank 0: " << pmbp->nmb_thispack
+              << " MeshBlocks of " << indcs.nx1 << "x" << indcs.nx2 << "x" << indcs.nx3
+              << " cells, " << niter << " calls each" << std::endl;
+    std::cout << std::left << std::setw(36) << "kernel" << std::right << std::setw(12)
+              << "time[s]" << std::setw(12) << "cells/s" << std::setw(12) << "GB/s"
+              << std::endl;
+  }
+
+  // reconstruction methods allowed by number of ghost zones
+  std::vector<std::pair<std::string, ReconstructionMethod>> recons;
+  recons.push_back(std::make_pair("dc", ReconstructionMethod::dc));
+  if (ng >= 2) {recons.push_back(std::make_pair("plm", ReconstructionMethod::plm));}
+  if (ng >= 3) {
+    recons.push_back(std::make_pair("ppm4", ReconstructionMethod::ppm4));
+    recons.push_back(std::make_pair("ppmx", ReconstructionMethod::ppmx));
+    recons.push_back(std::make_pair("wenoz", ReconstructionMethod::wenoz));
+  }
+  bool relativistic = (pmbp->pcoord->is_special_relativistic ||
+                       pmbp->pcoord->is_general_relativistic ||
+                       pmbp->pcoord->is_dynamical_relativistic);
+
+  // Hydro
+  if (pmbp->phydro != nullptr) {
+    hydro::Hydro *phyd = pmbp->phydro;
+    int nvar = phyd->nhydro + phyd->nscalars;
+    auto recon0 = phyd->recon_method;
+    auto rsolver0 = phyd->rsolver_method;
+    std::vector<std::pair<std::string, Hydro_RSolver>> rsolvers;
+    if (relativistic) {
+      rsolvers.push_back(std::make_pair(pin->GetString("hydro","rsolver"), rsolver0));
+    } else {
+      rsolvers.push_back(std::make_pair("llf", Hydro_RSolver::llf));
+      rsolvers.push_back(std::make_pair("hlle", Hydro_RSolver::hlle));
+      if (phyd->peos->eos_data.is_ideal) {
+        rsolvers.push_back(std::make_pair("hllc", Hydro_RSolver::hllc));
+      }
+      rsolvers.push_back(std::make_pair("roe", Hydro_RSolver::roe));
+    }
+    for (auto &rc : recons) {
+      for (auto &rs : rsolvers) {
+        phyd->SetFluxMethods(rc.second, rs.second);
+        RunBench("hydro_fluxes_" + rc.first + "_" + rs.first, niter, ncells,
+                 sreal*nvar*(1 + ndim), [&]() {phyd->Fluxes(&drv, 1);});
+      }
+    }
+    phyd->SetFluxMethods(recon0, rsolver0);
+    RunBench("hydro_cons2prim", niter, ncells, sreal*2*nvar, [&]() {
+      phyd->peos->ConsToPrim(phyd->u0, phyd->w0, false, 0, (n1-1), 0, (n2-1), 0, (n3-1));
+    });
+    RunBench("hydro_ghost_exchange", niter, ncells, sreal*2*nvar*nghost_cells/ncells,
+             [&]() {
+      ExchangeGhostZones(phyd->pbval_u, phyd->u0, phyd->coarse_u0, nvar);
+    });
+  }
+
+  // MHD
+  if (pmbp->pmhd != nullptr) {
+    mhd::MHD *pmhd = pmbp->pmhd;
+    int nvar = pmhd->nmhd + pmhd->nscalars;
+    auto recon0 = pmhd->recon_method;
+    auto rsolver0 = pmhd->rsolver_method;
+    std::vector<std::pair<std::string, MHD_RSolver>> rsolvers;
+    if (relativistic) {
+      rsolvers.push_back(std::make_pair(pin->GetString("mhd","rsolver"), rsolver0));
+    } else {
+      rsolvers.push_back(std::make_pair("llf", MHD_RSolver::llf));
+      rsolvers.push_back(std::make_pair("hlle", MHD_RSolver::hlle));
+      rsolvers.push_back(std::make_pair("hlld", MHD_RSolver::hlld));
+    }
+    if (pmbp->pdyngr == nullptr) {
+      for (auto &rc : recons) {
+        for (auto &rs : rsolvers) {
+          pmhd->SetFluxMethods(rc.second, rs.second);
+          RunBench("mhd_fluxes_" + rc.first + "_" + rs.first, niter, ncells,
+                   sreal*(nvar + 3)*(1 + ndim), [&]() {pmhd->Fluxes(&drv, 1);});
+        }
+      }
+      pmhd->SetFluxMethods(recon0, rsolver0);
+      RunBench("mhd_cons2prim", niter, ncells, sreal*2*(nvar + 3), [&]() {
+        pmhd->peos->ConsToPrim(pmhd->u0, pmhd->b0, pmhd->w0, pmhd->bcc0, false, 0,
+                               (n1-1), 0, (n2-1), 0, (n3-1));
+      });
+    } else {
+      RunBench("dyngr_cons2prim", niter, ncells, sreal*2*(nvar + 3), [&]() {
+        pmbp->pdyngr->ConToPrim(&drv, 1);
+      });
+    }
+    RunBench("mhd_ghost_exchange", niter, ncells, sreal*2*nvar*nghost_cells/ncells,
+             [&]() {
+      ExchangeGhostZones(pmhd->pbval_u, pmhd->u0, pmhd->coarse_u0, nvar);
+    });
+  }
+
+  // Z4c
+  if (pmbp->pz4c != nullptr) {
+    z4c::Z4c *pz4c = pmbp->pz4c;
+    int nvar = static_cast<int>(z4c::Z4c::nz4c);
+    RunBench("z4c_calcrhs", niter, ncells, sreal*2*nvar, [&]() {
+      switch (ng) {
+        case 2: pz4c->CalcRHS<2>(&drv, 1); break;
+        case 3: pz4c->CalcRHS<3>(&drv, 1); break;
+        case 4: pz4c->CalcRHS<4>(&drv, 1); break;
+      }
+    });
+    RunBench("z4c_ghost_exchange", niter, ncells, sreal*2*nvar*nghost_cells/ncells,
+             [&]() {
+      ExchangeGhostZones(pz4c->pbval_u, pz4c->u0, pz4c->coarse_u0, nvar);
+    });
+  }
+
+  // Radiation
+  if (pmbp->prad != nullptr) {
+    radiation::Radiation *prad = pmbp->prad;
+    int nang = prad->prgeo->nangles;
+    RunBench("rad_fluxes", niter, ncells, sreal*nang*(1 + ndim), [&]() {
+      prad->CalculateFluxes(&drv, 1);
+    });
+  }
+  if (global_variable::my_rank == 0) {std::cout << std::endl;}
+
+  return;
+}
@@ -0,0 +1,151 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file scaling.cpp
+//! \brief Problem generator for weak- and strong-scaling tests.  Sets a smooth, periodic
+//! state with O(amp) perturbations in every direction for whichever of Hydro, MHD (in
+//! Newtonian, SR, GR, or dynamical GR) and Z4c are enabled, so that the cost of every
+//! cycle is representative and nearly independent of the number of cycles run.
+//!
+//! Since the Mesh is constructed before the problem generator is called, the size of the
+//! Mesh for a given number of ranks must be set on the command line (which is done by the
+//! scaling harness tst/scaling.py).  If <problem>/nmb_per_rank is set, this problem
+//! generator checks the resulting load balance, and a warning is printed if
+//! the MeshBlocks cannot be evenly distributed over ranks.
+//! Timings are best collected with the built-in profiler, by setting
+//! <time>/profile_ncycles and <time>/profile_file.
+
+#include <iostream>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "coordinates/cell_locations.hpp"
+#include "coordinates/adm.hpp"
+#include "mesh/mesh.hpp"
+#include "eos/eos.hpp"
+#include "hydro/hydro.hpp"
+#include "mhd/mhd.hpp"
+#include "dyn_grmhd/dyn_grmhd.hpp"
+#include "z4c/z4c.hpp"
+#include "pgen/pgen.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \fn void ProblemGenerator::Scaling()
+//! \brief Sets initial conditions for scaling tests
+
+void ProblemGenerator::Scaling(ParameterInput *pin, const bool restart) {
+  if (restart) return;
+  MeshBlockPack *pmbp = pmy_mesh_->pmb_pack;
+  auto &indcs = pmy_mesh_->mb_indcs;
+  int &is = indcs.is; int &js = indcs.js; int &ks = indcs.ks;
+  int ng = indcs.ng;
+  int nmb1 = pmbp->nmb_thispack - 1;
+  int n1 = indcs.nx1 + 2*ng;
+  int n2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng) : 1;
+  int n3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*ng) : 1;
+  auto &size = pmbp->pmb->mb_size;
+  Real amp = pin->GetOrAddReal("problem", "amp", 0.1);
+
+  // check MeshBlocks are evenly distributed over ranks
+  int nranks = global_variable::nranks;
+  int nmb_per_rank = pin->GetOrAddInteger("problem", "nmb_per_rank", 0);
+  if (global_variable::my_rank == 0) {
+    std::cout << std::endl << "Scaling test: " << nranks << " ranks, "
+              << pmy_mesh_->nmb_total << " MeshBlocks of " << indcs.nx1 << "x"
+              << indcs.nx2 << "x" << indcs.nx3 << " cells" << std::endl;
+    if ((pmy_mesh_->nmb_total % nranks != 0) ||
+        (nmb_per_rank > 0 && pmy_mesh_->nmb_total != nmb_per_rank*nranks)) {
+      std::cout << "### WARNING in " << __FILE__ << " at line " << __LINE__ << std::endl
+                << "MeshBlocks are not distributed as " << nmb_per_rank
+                << " per rank, load will be imbalanced" << std::endl;
+    }
+  }
+
+  // wavenumbers of perturbations (one wavelength across Mesh in each direction)
+  auto &msize = pmy_mesh_->mesh_size;
+  Real k1 = 2.0*M_PI/(msize.x1max - msize.x1min);
+  Real k2 = 2.0*M_PI/(msize.x2max - msize.x2min);
+  Real k3 = 2.0*M_PI/(msize.x3max - msize.x3min);
+
+  // Hydro or MHD primitives, including ghost zones
+  if (pmbp->phydro != nullptr || pmbp->pmhd != nullptr) {
+    bool is_mhd = (pmbp->pmhd != nullptr);
+    EOS_Data &eos = (is_mhd)? pmbp->pmhd->peos->eos_data : pmbp->phydro->peos->eos_data;
+    auto &w0 = (is_mhd)? pmbp->pmhd->w0 : pmbp->phydro->w0;
+    bool dyngr = (pmbp->pdyngr != nullptr);
+    par_for("pgen_scaling", DevExeSpace(), 0, nmb1, 0, (n3-1), 0, (n2-1), 0, (n1-1),
+    KOKKOS_LAMBDA(int m, int k, int j, int i) {
+      Real x1 = CellCenterX(i-is, indcs.nx1, size.d_view(m).x1min, size.d_view(m).x1max);
+      Real x2 = CellCenterX(j-js, indcs.nx2, size.d_view(m).x2min, size.d_view(m).x2max);
+      Real x3 = CellCenterX(k-ks, indcs.nx3, size.d_view(m).x3min, size.d_view(m).x3max);
+      Real s1 = sin(k1*x1), s2 = sin(k2*x2), s3 = sin(k3*x3);
+      w0(m,IDN,k,j,i) = 1.0 + amp*s1*s2*s3;
+      w0(m,IVX,k,j,i) = amp*s2;
+      w0(m,IVY,k,j,i) = amp*s3;
+      w0(m,IVZ,k,j,i) = amp*s1;
+      if (dyngr) {
+        w0(m,IPR,k,j,i) = 1.0 + amp*s1;
+      } else if (eos.is_ideal) {
+        w0(m,IEN,k,j,i) = (1.0 + amp*s1)/(eos.gamma - 1.0);
+      }
+    });
+  }
+
+  // uniform (divergence-free) magnetic field
+  if (pmbp->pmhd != nullptr) {
+    auto &b0 = pmbp->pmhd->b0;
+    auto &bcc0 = pmbp->pmhd->bcc0;
+    par_for("pgen_scaling_b", DevExeSpace(), 0, nmb1, 0, (n3-1), 0, (n2-1), 0, (n1-1),
+    KOKKOS_LAMBDA(int m, int k, int j, int i) {
+      b0.x1f(m,k,j,i) = 0.3;
+      b0.x2f(m,k,j,i) = 0.2;
+      b0.x3f(m,k,j,i) = 0.1;
+      if (i == n1-1) {b0.x1f(m,k,j,i+1) = 0.3;}
+      if (j == n2-1) {b0.x2f(m,k,j+1,i) = 0.2;}
+      if (k == n3-1) {b0.x3f(m,k+1,j,i) = 0.1;}
+      bcc0(m,IBX,k,j,i) = 0.3;
+      bcc0(m,IBY,k,j,i) = 0.2;
+      bcc0(m,IBZ,k,j,i) = 0.1;
+    });
+  }
+
+  // flat ADM metric, converted to Z4c variables if evolved
+  if (pmbp->padm != nullptr) {
+    auto &adm = pmbp->padm->adm;
+    par_for("pgen_scaling_adm", DevExeSpace(), 0, nmb1, 0, (n3-1), 0, (n2-1), 0, (n1-1),
+    KOKKOS_LAMBDA(int m, int k, int j, int i) {
+      adm.alpha(m,k,j,i) = 1.0;
+      adm.psi4(m,k,j,i) = 1.0;
+      for (int a=0; a<3; ++a) {
+        adm.beta_u(m,a,k,j,i) = 0.0;
+        for (int b=a; b<3; ++b) {
+          adm.g_dd(m,a,b,k,j,i) = (a == b)? 1.0 : 0.0;
+          adm.vK_dd(m,a,b,k,j,i) = 0.0;
+        }
+      }
+    });
+    if (pmbp->pz4c != nullptr) {
+      switch (pmbp->pz4c->fd_ng) {
+        case 2: pmbp->pz4c->ADMToZ4c<2>(pmbp, pin); break;
+        case 3: pmbp->pz4c->ADMToZ4c<3>(pmbp, pin); break;
+        case 4: pmbp->pz4c->ADMToZ4c<4>(pmbp, pin); break;
+      }
+    }
+  }
+
+  // conserved variables
+  if (pmbp->pdyngr != nullptr) {
+    pmbp->pdyngr->PrimToConInit(0, (n1-1), 0, (n2-1), 0, (n3-1));
+  } else if (pmbp->pmhd != nullptr) {
+    pmbp->pmhd->peos->PrimToCons(pmbp->pmhd->w0, pmbp->pmhd->bcc0, pmbp->pmhd->u0,
+                                 0, (n1-1), 0, (n2-1), 0, (n3-1));
+  } else if (pmbp->phydro != nullptr) {
+    pmbp->phydro->peos->PrimToCons(pmbp->phydro->w0, pmbp->phydro->u0,
+                                   0, (n1-1), 0, (n2-1), 0, (n3-1));
+  }
+
+  return;
+}
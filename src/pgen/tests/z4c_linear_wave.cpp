@@ -155,6 +155,13 @@ void ProblemGenerator::Z4cLinearWave(ParameterInput *pin, const bool restart) {
 void Z4cLinearWaveErrors(ParameterInput *pin, Mesh *pm) {
   // calculate reference solution by calling pgen again.
   set_initial_conditions = false;
+  // u1 is not allocated with low-storage integrators
+  auto &u0 = pm->pmb_pack->pz4c->u0;
+  auto &u1 = pm->pmb_pack->pz4c->u1;
+  if (u1.size() != u0.size()) {
+    Kokkos::realloc(u1, u0.extent(0), u0.extent(1), u0.extent(2), u0.extent(3),
+                    u0.extent(4));
+  }
   pm->pgen->Z4cLinearWave(pin, false);
 
   Real l1_err[6];
@@ -232,8 +239,10 @@ void Z4cLinearWaveErrors(ParameterInput *pin, Mesh *pm) {
   }
 
 #if MPI_PARALLEL_ENABLED
-  MPI_Allreduce(MPI_IN_PLACE, &l1_err, nvars, MPI_ATHENA_REAL, MPI_SUM, MPI_COMM_WORLD);
-  MPI_Allreduce(MPI_IN_PLACE, &linfty_err, 1, MPI_ATHENA_REAL, MPI_MAX, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, &l1_err, nvars, MPI_ATHENA_REAL, MPI_SUM,
+                global_variable::mpi_comm);
+  MPI_Allreduce(MPI_IN_PLACE, &linfty_err, 1, MPI_ATHENA_REAL, MPI_MAX,
+                global_variable::mpi_comm);
 #endif
 
   // normalize errors by number of cells
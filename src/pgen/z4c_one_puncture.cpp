@@ -35,7 +35,6 @@ void RefinementCondition(MeshBlockPack* pmbp);
 void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
   user_ref_func  = RefinementCondition;
   MeshBlockPack *pmbp = pmy_mesh_->pmb_pack;
-  auto &indcs = pmy_mesh_->mb_indcs;
 
   if (pmbp->pz4c == nullptr) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
@@ -46,7 +45,7 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
 
   ADMOnePuncture(pmbp, pin);
   pmbp->pz4c->GaugePreCollapsedLapse(pmbp, pin);
-  switch (indcs.ng) {
+  switch (pmbp->pz4c->fd_ng) {
     case 2: pmbp->pz4c->ADMToZ4c<2>(pmbp, pin);
             break;
     case 3: pmbp->pz4c->ADMToZ4c<3>(pmbp, pin);
@@ -55,7 +54,7 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
             break;
   }
   pmbp->pz4c->Z4cToADM(pmbp);
-  switch (indcs.ng) {
+  switch (pmbp->pz4c->fd_ng) {
     case 2: pmbp->pz4c->ADMConstraints<2>(pmbp);
             break;
     case 3: pmbp->pz4c->ADMConstraints<3>(pmbp);
@@ -76,6 +75,7 @@ void ADMOnePuncture(MeshBlockPack *pmbp, ParameterInput *pin) {
   // capture variables for the kernel
   auto &indcs = pmbp->pmesh->mb_indcs;
   auto &size = pmbp->pmb->mb_size;
+  auto stretch = pmbp->pmesh->stretch;
   int &is = indcs.is; int &ie = indcs.ie;
   int &js = indcs.js; int &je = indcs.je;
   int &ks = indcs.ks; int &ke = indcs.ke;
@@ -97,17 +97,17 @@ void ADMOnePuncture(MeshBlockPack *pmbp, ParameterInput *pin) {
     Real &x1min = size.d_view(m).x1min;
     Real &x1max = size.d_view(m).x1max;
     int nx1 = indcs.nx1;
-    Real x1v = CellCenterX(i-is, nx1, x1min, x1max);
+    Real x1v = stretch.X(0, CellCenterX(i-is, nx1, x1min, x1max));
 
     Real &x2min = size.d_view(m).x2min;
     Real &x2max = size.d_view(m).x2max;
     int nx2 = indcs.nx2;
-    Real x2v = CellCenterX(j-js, nx2, x2min, x2max);
+    Real x2v = stretch.X(1, CellCenterX(j-js, nx2, x2min, x2max));
 
     Real &x3min = size.d_view(m).x3min;
     Real &x3max = size.d_view(m).x3max;
     int nx3 = indcs.nx3;
-    Real x3v = CellCenterX(k-ks, nx3, x3min, x3max);
+    Real x3v = stretch.X(2, CellCenterX(k-ks, nx3, x3min, x3max));
 
     x1v -= center_x1;
     x2v -= center_x2;
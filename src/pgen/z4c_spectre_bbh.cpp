@@ -51,7 +51,6 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
     return;
 
   MeshBlockPack *pmbp = pmy_mesh_->pmb_pack;
-  auto &indcs = pmy_mesh_->mb_indcs;
 
   // Load initial data specified by the user options
   const std::string options_block = "problem";
@@ -65,7 +64,7 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
   pmbp->pz4c->GaugePreCollapsedLapse(pmbp, pin);
 
   // Set Z4c variables from ADM variables
-  switch (indcs.ng) {
+  switch (pmbp->pz4c->fd_ng) {
   case 2:
     pmbp->pz4c->ADMToZ4c<2>(pmbp, pin);
     break;
@@ -78,7 +77,7 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
   }
 
   // Compute ADM constrains on initial data slice
-  switch (indcs.ng) {
+  switch (pmbp->pz4c->fd_ng) {
   case 2:
     pmbp->pz4c->ADMConstraints<2>(pmbp);
     break;
@@ -106,6 +105,7 @@ void LoadSpectreInitialData(MeshBlockPack *pmbp, const std::string &filename_glo
       host_u_adm, adm::ADM::I_ADM_KXX, adm::ADM::I_ADM_KZZ);
   auto &indcs = pmbp->pmesh->mb_indcs;
   auto &size = pmbp->pmb->mb_size;
+  auto &stretch = pmbp->pmesh->stretch;
   int &is = indcs.is;
   int &ie = indcs.ie;
   int &js = indcs.js;
@@ -148,9 +148,9 @@ void LoadSpectreInitialData(MeshBlockPack *pmbp, const std::string &filename_glo
       for (int ix_J = jsg; ix_J < jeg + 1; ix_J++) {
         for (int ix_K = ksg; ix_K < keg + 1; ix_K++) {
           int flat_ix = ix_I + n[0] * (ix_J + n[1] * ix_K);
-          x[0][flat_ix] = CellCenterX(ix_I - is, nx1, x1min, x1max);
-          x[1][flat_ix] = CellCenterX(ix_J - js, nx2, x2min, x2max);
-          x[2][flat_ix] = CellCenterX(ix_K - ks, nx3, x3min, x3max);
+          x[0][flat_ix] = stretch.X(0, CellCenterX(ix_I - is, nx1, x1min, x1max));
+          x[1][flat_ix] = stretch.X(1, CellCenterX(ix_J - js, nx2, x2min, x2max));
+          x[2][flat_ix] = stretch.X(2, CellCenterX(ix_K - ks, nx3, x3min, x3max));
         }
       }
     }
@@ -37,7 +37,6 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
     return;
 
   MeshBlockPack *pmbp = pmy_mesh_->pmb_pack;
-  auto &indcs         = pmy_mesh_->mb_indcs;
 
   TwoPunctures_params_set_default();
   std::string set_name = "problem";
@@ -168,7 +167,7 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
   data = TwoPunctures_make_initial_data();
   ADMTwoPunctures(pmbp, data);
   pmbp->pz4c->GaugePreCollapsedLapse(pmbp, pin);
-  switch (indcs.ng) {
+  switch (pmbp->pz4c->fd_ng) {
     case 2:
       pmbp->pz4c->ADMToZ4c<2>(pmbp, pin);
       break;
@@ -182,7 +181,7 @@ void ProblemGenerator::UserProblem(ParameterInput *pin, const bool restart) {
   TwoPunctures_finalise(data);
 
   pmbp->pz4c->Z4cToADM(pmbp);
-  switch (indcs.ng) {
+  switch (pmbp->pz4c->fd_ng) {
     case 2: pmbp->pz4c->ADMConstraints<2>(pmbp);
             break;
     case 3: pmbp->pz4c->ADMConstraints<3>(pmbp);
@@ -222,6 +221,7 @@ void ADMTwoPunctures(MeshBlockPack *pmbp, ini_data *data) {
     host_u_adm, adm::ADM::I_ADM_KXX, adm::ADM::I_ADM_KZZ);
   auto &indcs = pmbp->pmesh->mb_indcs;
   auto &size  = pmbp->pmb->mb_size;
+  auto stretch = pmbp->pmesh->stretch;
   int &is     = indcs.is;
   int &ie     = indcs.ie;
   int &js     = indcs.js;
@@ -274,15 +274,15 @@ void ADMTwoPunctures(MeshBlockPack *pmbp, ini_data *data) {
     int nx3     = indcs.nx3;
     // need to populate coordinates
     for (int ix_I = isg; ix_I < ieg + 1; ix_I++) {
-      x[ix_I] = CellCenterX(ix_I - is, nx1, x1min, x1max);
+      x[ix_I] = stretch.X(0, CellCenterX(ix_I - is, nx1, x1min, x1max));
     }
 
     for (int ix_J = jsg; ix_J < jeg + 1; ix_J++) {
-      y[ix_J] = CellCenterX(ix_J - js, nx2, x2min, x2max);
+      y[ix_J] = stretch.X(1, CellCenterX(ix_J - js, nx2, x2min, x2max));
     }
 
     for (int ix_K = ksg; ix_K < keg + 1; ix_K++) {
-      z[ix_K] = CellCenterX(ix_K - ks, nx3, x3min, x3max);
+      z[ix_K] = stretch.X(2, CellCenterX(ix_K - ks, nx3, x3min, x3max));
     }
     TwoPunctures_Cartesian_interpolation(
       data, // struct containing the previously calculated solution
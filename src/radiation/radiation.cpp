@@ -8,6 +8,7 @@
 
 #include <float.h>
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 
@@ -16,6 +17,7 @@
 #include "mesh/mesh.hpp"
 #include "eos/eos.hpp"
 #include "srcterms/srcterms.hpp"
+#include "pgen/pgen.hpp"
 #include "bvals/bvals.hpp"
 #include "coordinates/coordinates.hpp"
 #include "geodesic-grid/geodesic_grid.hpp"
@@ -29,6 +31,13 @@ namespace radiation {
 Radiation::Radiation(MeshBlockPack *ppack, ParameterInput *pin) :
     pmy_pack(ppack),
     i0("i0",1,1,1,1,1),
+    coarse_size("coarse_size",1),
+    i0_swap("i0_swap",1,1,1,1,1),
+    tet_c_swap("tet_c_swap",1,1,1,1,1,1),
+    tetcov_c_swap("tetcov_c_swap",1,1,1,1,1,1),
+    norm_to_tet_swap("norm_to_tet_swap",1,1,1,1,1,1),
+    cw0("cw0",1,1,1,1,1),
+    cdu0("cdu0",1,1,1,1,1),
     i1("i1",1,1,1,1,1),
     iflx("iflx",1,1,1,1,1),
     divfa("divfa",1,1,1,1,1),
@@ -41,7 +50,8 @@ Radiation::Radiation(MeshBlockPack *ppack, ParameterInput *pin) :
     tet_d3_x3f("tet_d3_x3f",1,1,1,1,1),
     na("na",1,1,1,1,1,1),
     norm_to_tet("norm_to_tet",1,1,1,1,1,1),
-    beam_mask("beam_mask",1,1,1,1,1) {
+    beam_offset("beam_offset",1),
+    beam_idx("beam_idx",1) {
   // Check for general relativity
   if (!(pmy_pack->pcoord->is_general_relativistic)) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
@@ -100,41 +110,200 @@ Radiation::Radiation(MeshBlockPack *ppack, ParameterInput *pin) :
       arad = pin->GetReal("radiation","arad");
     }
     affect_fluid = pin->GetOrAddBoolean("radiation","affect_fluid",true);
+
+    // Solver for the implicit temperature update in each cell: exact roots of the
+    // quartic, or a fixed number of Newton iterations (with exact roots as fallback)
+    std::string solver = pin->GetOrAddString("radiation","coupling_solver","exact");
+    if (solver.compare("newton") == 0) {
+      newton_coupling = true;
+      newton_iter = pin->GetOrAddInteger("radiation","newton_iter",20);
+      newton_tol = pin->GetOrAddReal("radiation","newton_tol",1.0e-12);
+      if (newton_iter < 1) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+          << std::endl << "newton_iter must be >= 1" << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+    } else if (solver.compare("exact") != 0) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+        << std::endl << "coupling_solver = '" << solver << "' not implemented, "
+        << "must be 'exact' or 'newton'" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
   }
 
   // Check for fluid evolution
   fixed_fluid = pin->GetOrAddBoolean("radiation","fixed_fluid",false);
 
+  // Number of radiation steps per fluid step
+  nsubcycle = pin->GetOrAddInteger("radiation","nsubcycle",1);
+  if (nsubcycle < 1 ||
+      (nsubcycle > 1 && (fixed_fluid || !(is_hydro_enabled || is_mhd_enabled)))) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+      << std::endl << "<radiation>/nsubcycle must be >= 1, and can only be > 1 when "
+      << "the fluid is evolved" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+
   // Other rad source terms (constructor parses input file to init only srcterms needed)
   beam_source = pin->GetOrAddBoolean("radiation","beam_source",false);
   psrc = new SourceTerms("radiation", ppack, pin);
 
-  // Setup angular mesh and radiation geometry data
-  int nlevel = pin->GetInteger("radiation", "nlevel");
+  // Transport method: discrete ordinates (default), or two moments with M1 closure
+  {std::string method = pin->GetOrAddString("radiation","method","discrete_ordinates");
+  if (method.compare("m1") == 0) {
+    m1_closure = true;
+  } else if (method.compare("discrete_ordinates") != 0) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+      << std::endl << "<radiation>/method = '" << method << "' not implemented, must "
+      << "be 'discrete_ordinates' or 'm1'" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  }
+  if (m1_closure) {
+    if (!(pmy_pack->pcoord->coord_data.is_minkowski)) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+        << std::endl << "<radiation>/method = m1 requires flat spacetime, set "
+        << "<coord>/minkowski = true" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    if (beam_source || (rad_source && is_compton_enabled) ||
+        pmy_pack->pmesh->multilevel) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+        << std::endl << "<radiation>/method = m1 does not support beam sources, Compton "
+        << "scattering, or SMR/AMR" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    m1_e_floor = pin->GetOrAddReal("radiation","m1_e_floor",1.0e-20);
+  }
+
+  // Setup angular mesh and radiation geometry data.  With M1 only the tetrad at cell
+  // centers (and the normal-to-tetrad frame transformation) is used.
   rotate_geo = pin->GetOrAddBoolean("radiation","rotate_geo",true);
-  angular_fluxes = pin->GetOrAddBoolean("radiation","angular_fluxes",true);
+  angular_fluxes = (m1_closure)? false :
+                   pin->GetOrAddBoolean("radiation","angular_fluxes",true);
   n_0_floor = pin->GetOrAddReal("radiation","n_0_floor",0.1);
-  prgeo = new GeodesicGrid(nlevel, rotate_geo, angular_fluxes);
+  if (m1_closure) {
+    nrad = 4;
+  } else {
+    int nlevel = pin->GetInteger("radiation", "nlevel");
+    // optional directory in which the geodesic grid geometry is cached between runs
+    std::string geo_cache_dir = pin->GetOrAddString("radiation","geo_cache_dir","");
+    std::string geo_cache_file;
+    if (!(geo_cache_dir.empty())) {
+      geo_cache_file = geo_cache_dir + "/geodesic_grid_" + std::to_string(nlevel)
+                       + ((rotate_geo)? "r" : "") + ((angular_fluxes)? "f" : "") + ".bin";
+    }
+    prgeo = new GeodesicGrid(nlevel, rotate_geo, angular_fluxes, geo_cache_file);
+    nrad = prgeo->nangles;
+  }
+  // Tetrad components at faces and n^a (6 values per angle per cell, the largest
+  // geometry array) can be recomputed from the analytic CKS metric in the kernels that
+  // need them, rather than stored, to save memory at the cost of extra computation.
+  // They are not used with M1.
+  recompute_tetrad = (m1_closure)? true :
+                     pin->GetOrAddBoolean("radiation","recompute_tetrad",false);
 
   int nmb = ppack->nmb_thispack;
   auto &indcs = pmy_pack->pmesh->mb_indcs;
+
+  // Radiation evolved on a coarser grid than the fluid.  Requires a uniform grid, so that
+  // the coarse arrays are not needed for SMR/AMR, and cell-centered geometry that is not
+  // tabulated on the grid of the MeshBlocks.
+  coarsen = pin->GetOrAddInteger("radiation","coarsen",1);
+  if (coarsen > 1) {
+    auto &coord = pmy_pack->pcoord->coord_data;
+    if (coarsen != 2) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+        << std::endl << "<radiation>/coarsen = " << coarsen << " not implemented, "
+        << "must be 1 or 2" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    if (pmy_pack->pmesh->multilevel || beam_source || coord.bh_excise ||
+        coord.cache_metric) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+        << std::endl << "<radiation>/coarsen cannot be used with SMR/AMR, beam sources, "
+        << "excision, or <coord>/cache_metric" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    if ((indcs.nx1 % 2 != 0) || (indcs.nx1/2 < indcs.ng) ||
+        (indcs.nx2 > 1 && ((indcs.nx2 % 2 != 0) || (indcs.nx2/2 < indcs.ng))) ||
+        (indcs.nx3 > 1 && ((indcs.nx3 % 2 != 0) || (indcs.nx3/2 < indcs.ng)))) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+        << std::endl << "<radiation>/coarsen requires MeshBlocks with an even number of "
+        << "cells, and at least 2*nghost cells, in each active dimension" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    // coarse grid uses the coarse cells of the MeshBlocks with the same ghost zones
+    coarse_indcs = indcs;
+    coarse_indcs.nx1 = indcs.cnx1;
+    coarse_indcs.nx2 = indcs.cnx2;
+    coarse_indcs.nx3 = indcs.cnx3;
+    coarse_indcs.is = indcs.cis;  coarse_indcs.ie = indcs.cie;
+    coarse_indcs.js = indcs.cjs;  coarse_indcs.je = indcs.cje;
+    coarse_indcs.ks = indcs.cks;  coarse_indcs.ke = indcs.cke;
+    coarse_indcs.cnx1 = std::max(1, indcs.cnx1/2);
+    coarse_indcs.cnx2 = std::max(1, indcs.cnx2/2);
+    coarse_indcs.cnx3 = std::max(1, indcs.cnx3/2);
+    coarse_indcs.cie = coarse_indcs.cis + coarse_indcs.cnx1 - 1;
+    if (indcs.nx2 > 1) {coarse_indcs.cje = coarse_indcs.cjs + coarse_indcs.cnx2 - 1;}
+    if (indcs.nx3 > 1) {coarse_indcs.cke = coarse_indcs.cks + coarse_indcs.cnx3 - 1;}
+    Kokkos::realloc(coarse_size, nmb);
+    auto &mb_size = pmy_pack->pmb->mb_size;
+    for (int m=0; m<nmb; ++m) {
+      coarse_size.h_view(m) = mb_size.h_view(m);
+      coarse_size.h_view(m).dx1 = 2.0*mb_size.h_view(m).dx1;
+      if (indcs.nx2 > 1) {coarse_size.h_view(m).dx2 = 2.0*mb_size.h_view(m).dx2;}
+      if (indcs.nx3 > 1) {coarse_size.h_view(m).dx3 = 2.0*mb_size.h_view(m).dx3;}
+      coarse_size.h_view(m).idx1 = 1.0/coarse_size.h_view(m).dx1;
+      coarse_size.h_view(m).idx2 = 1.0/coarse_size.h_view(m).dx2;
+      coarse_size.h_view(m).idx3 = 1.0/coarse_size.h_view(m).dx3;
+    }
+    coarse_size.template modify<HostMemSpace>();
+    coarse_size.template sync<DevExeSpace>();
+  }
+  // arrays used only in the time integration are allocated on the radiation grid
+  RegionIndcs &rindcs = (coarsen > 1)? coarse_indcs : indcs;
+
   {
   int ncells1 = indcs.nx1 + 2*(indcs.ng);
   int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
   int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
-  Kokkos::realloc(nh_c,prgeo->nangles,4);
-  Kokkos::realloc(nh_f,prgeo->nangles,6,4);
+  if (!(m1_closure)) {
+    Kokkos::realloc(nh_c,prgeo->nangles,4);
+    Kokkos::realloc(nh_f,prgeo->nangles,6,4);
+  }
   Kokkos::realloc(tet_c,nmb,4,4,ncells3,ncells2,ncells1);
   Kokkos::realloc(tetcov_c,nmb,4,4,ncells3,ncells2,ncells1);
-  Kokkos::realloc(tet_d1_x1f,nmb,4,ncells3,ncells2,ncells1+1);
-  Kokkos::realloc(tet_d2_x2f,nmb,4,ncells3,ncells2+1,ncells1);
-  Kokkos::realloc(tet_d3_x3f,nmb,4,ncells3+1,ncells2,ncells1);
-  if (angular_fluxes) {Kokkos::realloc(na,nmb,prgeo->nangles,ncells3,ncells2,ncells1,6);}
   if (is_hydro_enabled || is_mhd_enabled) {
     Kokkos::realloc(norm_to_tet,nmb,4,4,ncells3,ncells2,ncells1);
   }
+  if (coarsen > 1) {
+    int nccells1 = rindcs.nx1 + 2*(rindcs.ng);
+    int nccells2 = (rindcs.nx2 > 1)? (rindcs.nx2 + 2*(rindcs.ng)) : 1;
+    int nccells3 = (rindcs.nx3 > 1)? (rindcs.nx3 + 2*(rindcs.ng)) : 1;
+    Kokkos::realloc(tet_c_swap,nmb,4,4,nccells3,nccells2,nccells1);
+    Kokkos::realloc(tetcov_c_swap,nmb,4,4,nccells3,nccells2,nccells1);
+    if (is_hydro_enabled || is_mhd_enabled) {
+      Kokkos::realloc(norm_to_tet_swap,nmb,4,4,nccells3,nccells2,nccells1);
+      Kokkos::realloc(cw0,nmb,5,nccells3,nccells2,nccells1);
+      Kokkos::realloc(cdu0,nmb,5,nccells3,nccells2,nccells1);
+    }
+    ncells1 = nccells1;
+    ncells2 = nccells2;
+    ncells3 = nccells3;
+  }
+  if (!(recompute_tetrad)) {
+    Kokkos::realloc(tet_d1_x1f,nmb,4,ncells3,ncells2,ncells1+1);
+    Kokkos::realloc(tet_d2_x2f,nmb,4,ncells3,ncells2+1,ncells1);
+    Kokkos::realloc(tet_d3_x3f,nmb,4,ncells3+1,ncells2,ncells1);
+    if (angular_fluxes) {
+      Kokkos::realloc(na,nmb,prgeo->nangles,ncells3,ncells2,ncells1,6);
+    }
   }
-  SetOrthonormalTetrad();
+  }
+  // with coarsen > 1, tetrads at faces and n^a are only needed on the coarse grid (set
+  // below, once boundary buffers of both grids exist)
+  SetOrthonormalTetrad(coarsen == 1);
 
   // (3) read time-evolution option [already error checked in driver constructor]
   // Then initialize memory and algorithms for reconstruction and Riemann solvers
@@ -145,21 +314,41 @@ Radiation::Radiation(MeshBlockPack *ppack, ParameterInput *pin) :
   int ncells1 = indcs.nx1 + 2*(indcs.ng);
   int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
   int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
-  Kokkos::realloc(i0,nmb,prgeo->nangles,ncells3,ncells2,ncells1);
+  ReallocFirstTouch(i0,nmb,nrad,ncells3,ncells2,ncells1);
+  if (coarsen > 1) {
+    int nccells1 = rindcs.nx1 + 2*(rindcs.ng);
+    int nccells2 = (rindcs.nx2 > 1)? (rindcs.nx2 + 2*(rindcs.ng)) : 1;
+    int nccells3 = (rindcs.nx3 > 1)? (rindcs.nx3 + 2*(rindcs.ng)) : 1;
+    ReallocFirstTouch(i0_swap,nmb,nrad,nccells3,nccells2,nccells1);
+  }
   }
 
-  // allocate memory for conserved variables on coarse mesh
-  if (ppack->pmesh->multilevel) {
+  // allocate memory for conserved variables on coarse mesh (only if used on this rank)
+  if (ppack->pmesh->multilevel && ppack->pmb->need_coarse) {
     auto &indcs = pmy_pack->pmesh->mb_indcs;
     int nccells1 = indcs.cnx1 + 2*(indcs.ng);
     int nccells2 = (indcs.cnx2 > 1)? (indcs.cnx2 + 2*(indcs.ng)) : 1;
     int nccells3 = (indcs.cnx3 > 1)? (indcs.cnx3 + 2*(indcs.ng)) : 1;
-    Kokkos::realloc(coarse_i0,nmb,prgeo->nangles,nccells3,nccells2,nccells1);
+    ReallocFirstTouch(coarse_i0,nmb,nrad,nccells3,nccells2,nccells1);
   }
 
   // allocate boundary buffers for conserved (cell-centered) variables
   pbval_i = new MeshBoundaryValuesCC(ppack, pin, false);
-  pbval_i->InitializeBuffers(prgeo->nangles);
+  pbval_i->comm_module = comm_stats::Module::radiation;
+  pbval_i->SetHaloPrecision(pin, "radiation");
+  pbval_i->SetGhostDepth(pin, "radiation");
+  pbval_i->InitializeBuffers(nrad);
+  if (coarsen > 1) {
+    pbval_swap = new MeshBoundaryValuesCC(ppack, pin, false);
+    pbval_swap->comm_module = comm_stats::Module::radiation;
+    pbval_swap->pgrid_indcs = &coarse_indcs;
+    pbval_swap->SetHaloPrecision(pin, "radiation");
+    pbval_swap->SetGhostDepth(pin, "radiation");
+    pbval_swap->InitializeBuffers(nrad);
+    SwapGrids();
+    SetOrthonormalTetrad();
+    SwapGrids();
+  }
 
   // for time-evolving problems, continue to construct methods, allocate arrays
   if (evolution_t.compare("stationary") != 0) {
@@ -173,10 +362,10 @@ Radiation::Radiation(MeshBlockPack *ppack, ParameterInput *pin) :
                xorder.compare("ppmx") == 0 ||
                xorder.compare("wenoz") == 0) {
       // check that nghost > 2
-      if (indcs.ng < 3) {
+      if (pbval_i->nghost_same < 3) {
         std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
           << std::endl << xorder << " reconstruction requires at least 3 ghost zones, "
-          << "but <mesh>/nghost=" << indcs.ng << std::endl;
+          << "but <radiation>/nghost=" << pbval_i->nghost_same << std::endl;
         std::exit(EXIT_FAILURE);
       }
       if (xorder.compare("ppm4") == 0) {
@@ -194,20 +383,17 @@ Radiation::Radiation(MeshBlockPack *ppack, ParameterInput *pin) :
     }
     }
 
-    // allocate second registers, fluxes, masks
-    int ncells1 = indcs.nx1 + 2*(indcs.ng);
-    int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
-    int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
-    Kokkos::realloc(i1,      nmb,prgeo->nangles,ncells3,ncells2,ncells1);
-    Kokkos::realloc(iflx.x1f,nmb,prgeo->nangles,ncells3,ncells2,ncells1);
-    Kokkos::realloc(iflx.x2f,nmb,prgeo->nangles,ncells3,ncells2,ncells1);
-    Kokkos::realloc(iflx.x3f,nmb,prgeo->nangles,ncells3,ncells2,ncells1);
+    // allocate second registers, fluxes
+    int ncells1 = rindcs.nx1 + 2*(rindcs.ng);
+    int ncells2 = (rindcs.nx2 > 1)? (rindcs.nx2 + 2*(rindcs.ng)) : 1;
+    int ncells3 = (rindcs.nx3 > 1)? (rindcs.nx3 + 2*(rindcs.ng)) : 1;
+    ReallocFirstTouch(i1,      nmb,nrad,ncells3,ncells2,ncells1);
+    ReallocFirstTouch(iflx.x1f,nmb,nrad,ncells3,ncells2,ncells1);
+    ReallocFirstTouch(iflx.x2f,nmb,nrad,ncells3,ncells2,ncells1);
+    ReallocFirstTouch(iflx.x3f,nmb,nrad,ncells3,ncells2,ncells1);
     if (angular_fluxes) {
       Kokkos::realloc(divfa,nmb,prgeo->nangles,ncells3,ncells2,ncells1);
     }
-    if (beam_source) {
-      Kokkos::realloc(beam_mask,nmb,prgeo->nangles,ncells3,ncells2,ncells1);
-    }
   }
 }
 
@@ -216,8 +402,77 @@ Radiation::Radiation(MeshBlockPack *ppack, ParameterInput *pin) :
 
 Radiation::~Radiation() {
   delete pbval_i;
+  if (pbval_swap != nullptr) {delete pbval_swap;}
   delete prgeo;
   if (psrc != nullptr) {delete psrc;}
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void Radiation::BuildBeamList()
+//! \brief Builds the sparse list of (angle,cell) pairs in the beam source term from the
+//! mask over all angles and active cells set by the user_beam_func of the problem
+//! generator.  The mask is only allocated while the list is built, so that memory and
+//! the cost of BeamSource() scale with the size of the beam.
+
+void Radiation::BuildBeamList() {
+  auto pfunc = pmy_pack->pmesh->pgen->user_beam_func;
+  if (pfunc == nullptr) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "<radiation>/beam_source requires a beam mask function "
+              << "(user_beam_func) enrolled by the problem generator" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, js = indcs.js, ks = indcs.ks;
+  int nx1 = indcs.nx1, nx2 = indcs.nx2, nx3 = indcs.nx3;
+  int ncells1 = indcs.nx1 + 2*(indcs.ng);
+  int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
+  int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
+  int nmb = pmy_pack->nmb_thispack;
+  int nang = prgeo->nangles;
+
+  DvceArray5D<bool> mask("beam_mask",nmb,nang,ncells3,ncells2,ncells1);
+  (pfunc)(pmy_pack, mask);
+
+  // count entries, then store them with their offsets in order of (m,n,k,j,i)
+  const int nkji = nx3*nx2*nx1;
+  const int nji  = nx2*nx1;
+  const int nblk = nang*nkji;
+  int nbeam = 0;
+  Kokkos::parallel_reduce("beam_count", Kokkos::RangePolicy<>(DevExeSpace(),0,nmb*nblk),
+  KOKKOS_LAMBDA(const int idx, int &sum) {
+    int m = idx/nblk;
+    int n = (idx - m*nblk)/nkji;
+    int k = (idx - m*nblk - n*nkji)/nji;
+    int j = (idx - m*nblk - n*nkji - k*nji)/nx1;
+    int i = (idx - m*nblk - n*nkji - k*nji - j*nx1) + is;
+    j += js;
+    k += ks;
+    if (mask(m,n,k,j,i)) {sum += 1;}
+  }, Kokkos::Sum<int>(nbeam));
+
+  Kokkos::realloc(beam_offset, nmb+1);
+  Kokkos::realloc(beam_idx, std::max(nbeam,1));
+  auto &offset = beam_offset;
+  auto &bidx = beam_idx;
+  Kokkos::parallel_scan("beam_list", Kokkos::RangePolicy<>(DevExeSpace(),0,nmb*nblk),
+  KOKKOS_LAMBDA(const int idx, int &cnt, const bool last_pass) {
+    int m = idx/nblk;
+    int n = (idx - m*nblk)/nkji;
+    int k = (idx - m*nblk - n*nkji)/nji;
+    int j = (idx - m*nblk - n*nkji - k*nji)/nx1;
+    int i = (idx - m*nblk - n*nkji - k*nji - j*nx1) + is;
+    j += js;
+    k += ks;
+    if (last_pass && idx == m*nblk) {offset(m) = cnt;}
+    if (mask(m,n,k,j,i)) {
+      if (last_pass) {bidx(cnt) = ((n*ncells3 + k)*ncells2 + j)*ncells1 + i;}
+      cnt += 1;
+    }
+  });
+  Kokkos::deep_copy(Kokkos::subview(beam_offset, nmb), nbeam);
+  beam_version = pmy_pack->pmb->nghbr_version;
+  return;
+}
+
 } // namespace radiation
@@ -74,6 +74,8 @@ struct RadiationTaskIDs {
   TaskID rad_crecv;
   TaskID mhd_crecv;
   TaskID hyd_crecv;
+  TaskID rad_tocoarse;
+  TaskID rad_tofine;
 };
 
 namespace radiation {
@@ -94,6 +96,7 @@ class Radiation {
   // Radiation source term parameters
   bool rad_source;          // flag to enable/disable radiation source term
   bool fixed_fluid;         // flag to enable/disable fluid integration
+  int nsubcycle;            // number of radiation steps per fluid step
   bool affect_fluid;        // flag to enable/disable feedback of rad field on fluid
   Real arad;                // radiation constant
   Real kappa_a;             // constant Rosseland mean absoprtion coefficient
@@ -101,9 +104,28 @@ class Radiation {
   Real kappa_p;             // Planck - Rosseland mean coefficient
   bool power_opacity;       // flag to enable Kramer's law opacity for kappa_a
   bool is_compton_enabled;  // flag to enable/disable compton
+  bool newton_coupling=false;  // solve for new gas temperature with Newton iterations
+  int newton_iter=20;          // (fixed) number of Newton iterations
+  Real newton_tol=1.0e-12;     // relative tolerance of Newton iterations
+
+  // With m1_closure the radiation energy and momentum densities (E,F) in the tetrad
+  // frame are evolved with the M1 closure instead of the intensities at all angles, and
+  // i0 holds the nrad=4 variables IRE,IRF1,IRF2,IRF3 (see radiation_m1.hpp).  Only the
+  // tetrad at cell centers is used, and there is no angular mesh.
+  bool m1_closure=false;
+  int nrad;                 // number of variables in i0 (angles, or moments with M1)
+  Real m1_e_floor;          // floor on E with M1
 
   // Extra physics (i.e., other srcterms)
   bool beam_source;
+  // Sparse list of the (angle,cell) pairs of the beam source term sorted by MeshBlock.
+  // Entries beam_offset(m) to beam_offset(m+1)-1 of beam_idx belong to MeshBlock m, with
+  // each entry ((n*ncells3 + k)*ncells2 + j)*ncells1 + i.  Built from the mask set by
+  // the user_beam_func of the problem generator, each time the mesh changes.
+  DvceArray1D<int> beam_offset;
+  DvceArray1D<int> beam_idx;
+  int beam_version = -1;    // nghbr_version of MeshBlocks the list was built for
+  void BuildBeamList();
   SourceTerms *psrc = nullptr;
 
   // Angular mesh
@@ -122,7 +144,8 @@ class Radiation {
   DvceArray5D<Real> tet_d3_x3f;       // tetrad components (subset) at x3f
   DvceArray6D<Real> na;               // n^a
   DvceArray6D<Real> norm_to_tet;      // used in transform b/w normal frame and tet frame
-  void SetOrthonormalTetrad();
+  bool recompute_tetrad;              // face tetrads and n^a recomputed in kernels
+  void SetOrthonormalTetrad(bool faces=true);
 
   // intensity arrays
   DvceArray5D<Real> i0;         // intensities
@@ -131,11 +154,30 @@ class Radiation {
   // Boundary communication buffers and functions for i
   MeshBoundaryValuesCC *pbval_i;
 
+  // With <radiation>/coarsen = 2 the radiation is evolved on a grid with half as many
+  // cells in each direction as the MeshBlocks of the fluid (see radiation_coarse.cpp).
+  // i0, the cell-centered tetrads, and pbval_i are swapped with their coarse versions
+  // (stored below) during each cycle, so that between cycles (problem generator,
+  // outputs, restarts) i0 is always on the grid of the MeshBlocks.
+  int coarsen = 1;
+  bool on_coarse_grid = false;
+  RegionIndcs coarse_indcs;              // cell indices of coarse radiation grid
+  DualArray1D<RegionSize> coarse_size;   // cell sizes of coarse radiation grid
+  DvceArray5D<Real> i0_swap;             // intensities on grid not currently used
+  DvceArray6D<Real> tet_c_swap, tetcov_c_swap, norm_to_tet_swap;
+  MeshBoundaryValuesCC *pbval_swap = nullptr;
+  DvceArray5D<Real> cw0;                 // fluid primitives restricted to coarse grid
+  DvceArray5D<Real> cdu0;                // change of fluid by coupling on coarse grid
+  RegionIndcs &Indcs();                  // indices of grid currently used
+  DualArray1D<RegionSize> &Size();       // cell sizes of grid currently used
+  void SwapGrids();
+  void RestrictFluid(const DvceArray5D<Real> &w0);
+  void ProlongFluidChange(DvceArray5D<Real> &u0);
+
   // following only used for time-evolving flow
   DvceArray5D<Real> i1;         // intensity at intermediate step
   DvceFaceFld5D<Real> iflx;     // spatial fluxes on zone faces
   DvceArray5D<Real> divfa;      // angular flux divergence
-  DvceArray5D<bool> beam_mask;  // boolean mask used for beam source term
   Real dtnew;
 
   // reconstruction method
@@ -161,6 +203,14 @@ class Radiation {
   TaskStatus ApplyPhysicalBCs(Driver* pdrive, int stage);
   TaskStatus Prolongate(Driver* pdrive, int stage);
   TaskStatus NewTimeStep(Driver *d, int stage);
+  void ExchangeFluid(Driver *d);
+  // ...in "before_timeintegrator" and "after_timeintegrator" task lists (coarsen > 1)
+  TaskStatus ToCoarseGrid(Driver *d, int stage);
+  TaskStatus ToFineGrid(Driver *d, int stage);
+  // ...M1 versions of the fluxes, update, and coupling to the fluid
+  TaskStatus CalculateM1Fluxes(Driver *d, int stage);
+  TaskStatus M1Update(Driver *d, int stage);
+  TaskStatus AddM1SourceTerm(Driver *d, int stage);
   // ...in "after_stagen_tl" task list
   TaskStatus ClearSend(Driver *d, int stage);
   TaskStatus ClearRecv(Driver *d, int stage);
@@ -0,0 +1,227 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file radiation_coarse.cpp
+//! \brief Evolution of radiation on a grid coarser than that of the fluid (enabled with
+//! <radiation>/coarsen = 2), using the coarse cells of each MeshBlock.  At the start of
+//! each cycle the intensities are restricted to the coarse grid, on which transport and
+//! the source terms are computed, and at the end of the cycle they are prolongated back
+//! to the grid of the MeshBlocks.  The source terms use the fluid restricted to the
+//! coarse grid, and their change of the fluid is added to all fine cells in each coarse
+//! cell, so that energy and momentum are conserved.
+
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+
+#include "athena.hpp"
+#include "mesh/mesh.hpp"
+#include "mesh/prolongation.hpp"
+#include "driver/driver.hpp"
+#include "bvals/bvals.hpp"
+#include "pgen/pgen.hpp"
+#include "radiation.hpp"
+
+namespace radiation {
+//----------------------------------------------------------------------------------------
+//! \fn RegionIndcs &Radiation::Indcs()
+//! \brief Returns cell indices of the grid currently used by the radiation
+
+RegionIndcs &Radiation::Indcs() {
+  return (on_coarse_grid)? coarse_indcs : pmy_pack->pmesh->mb_indcs;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn DualArray1D<RegionSize> &Radiation::Size()
+//! \brief Returns cell sizes of the grid currently used by the radiation
+
+DualArray1D<RegionSize> &Radiation::Size() {
+  return (on_coarse_grid)? coarse_size : pmy_pack->pmb->mb_size;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Radiation::SwapGrids()
+//! \brief Swaps the intensities, cell-centered tetrads, and boundary buffers with those
+//! of the other grid.  Arrays only used in the time integration (i1, iflx, face tetrads,
+//! n^a) are only allocated on the coarse grid.
+
+void Radiation::SwapGrids() {
+  std::swap(i0, i0_swap);
+  std::swap(tet_c, tet_c_swap);
+  std::swap(tetcov_c, tetcov_c_swap);
+  if (is_hydro_enabled || is_mhd_enabled) {
+    std::swap(norm_to_tet, norm_to_tet_swap);
+  }
+  std::swap(pbval_i, pbval_swap);
+  on_coarse_grid = !(on_coarse_grid);
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Radiation::RestrictFluid()
+//! \brief Volume averages the fluid primitives w0 (density, velocities, and internal
+//! energy) onto the coarse grid (cw0), including the first layer of ghost cells
+
+void Radiation::RestrictFluid(const DvceArray5D<Real> &w0) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, js = indcs.js, ks = indcs.ks;
+  auto &cindcs = coarse_indcs;
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+  int cis = cindcs.is - 1, cie = cindcs.ie + 1;
+  int cjs = cindcs.js, cje = cindcs.je;
+  int cks = cindcs.ks, cke = cindcs.ke;
+  if (multi_d) {cjs--; cje++;}
+  if (three_d) {cks--; cke++;}
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  int ci0 = cindcs.is, cj0 = cindcs.js, ck0 = cindcs.ks;
+  auto cw0_ = cw0;
+  par_for("rad_restrict_w",DevExeSpace(),0,nmb1,0,(IEN),cks,cke,cjs,cje,cis,cie,
+  KOKKOS_LAMBDA(const int m, const int n, const int k, const int j, const int i) {
+    int fi = 2*(i - ci0) + is;
+    int fj = (multi_d)? (2*(j - cj0) + js) : j;
+    int fk = (three_d)? (2*(k - ck0) + ks) : k;
+    if (three_d) {
+      cw0_(m,n,k,j,i) = 0.125*(w0(m,n,fk  ,fj  ,fi) + w0(m,n,fk  ,fj  ,fi+1)
+                             + w0(m,n,fk  ,fj+1,fi) + w0(m,n,fk  ,fj+1,fi+1)
+                             + w0(m,n,fk+1,fj  ,fi) + w0(m,n,fk+1,fj  ,fi+1)
+                             + w0(m,n,fk+1,fj+1,fi) + w0(m,n,fk+1,fj+1,fi+1));
+    } else if (multi_d) {
+      cw0_(m,n,k,j,i) = 0.25*(w0(m,n,fk,fj  ,fi) + w0(m,n,fk,fj  ,fi+1)
+                            + w0(m,n,fk,fj+1,fi) + w0(m,n,fk,fj+1,fi+1));
+    } else {
+      cw0_(m,n,k,j,i) = 0.5*(w0(m,n,fk,fj,fi) + w0(m,n,fk,fj,fi+1));
+    }
+  });
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Radiation::ProlongFluidChange()
+//! \brief Adds the change of the conserved fluid variables by the source terms on the
+//! coarse grid (cdu0) to all fine cells within each coarse cell of u0
+
+void Radiation::ProlongFluidChange(DvceArray5D<Real> &u0) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, ie = indcs.ie;
+  int js = indcs.js, je = indcs.je;
+  int ks = indcs.ks, ke = indcs.ke;
+  int cis = coarse_indcs.is, cjs = coarse_indcs.js, cks = coarse_indcs.ks;
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  auto cdu0_ = cdu0;
+  par_for("rad_prolong_du",DevExeSpace(),0,nmb1,ks,ke,js,je,is,ie,
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    int ci = (i - is)/2 + cis;
+    int cj = (multi_d)? ((j - js)/2 + cjs) : j;
+    int ck = (three_d)? ((k - ks)/2 + cks) : k;
+    u0(m,IEN,k,j,i) += cdu0_(m,IEN,ck,cj,ci);
+    u0(m,IM1,k,j,i) += cdu0_(m,IM1,ck,cj,ci);
+    u0(m,IM2,k,j,i) += cdu0_(m,IM2,ck,cj,ci);
+    u0(m,IM3,k,j,i) += cdu0_(m,IM3,ck,cj,ci);
+  });
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus Radiation::ToCoarseGrid()
+//! \brief Task in "before_timeintegrator" list that moves the radiation to the coarse
+//! grid: intensities are volume averaged, and ghost cells set by a (blocking) boundary
+//! exchange.  Done every cycle, as i0 may have been changed between cycles (e.g. by a
+//! rollback of the cycle or a restart).
+
+TaskStatus Radiation::ToCoarseGrid(Driver *pdrive, int stage) {
+  if (coarsen == 1) {return TaskStatus::complete;}
+  SwapGrids();
+
+  // user BCs are applied to i0 on the grid of the MeshBlocks
+  if (pmy_pack->pmesh->pgen->user_bcs) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+      << std::endl << "<radiation>/coarsen cannot be used with user boundary conditions"
+      << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  // inflow intensities are set in the problem generator for the grid of the MeshBlocks
+  pbval_i->i_in = pbval_swap->i_in;
+
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, js = indcs.js, ks = indcs.ks;
+  auto &cindcs = coarse_indcs;
+  int cis = cindcs.is, cie = cindcs.ie;
+  int cjs = cindcs.js, cje = cindcs.je;
+  int cks = cindcs.ks, cke = cindcs.ke;
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  auto ci0 = i0;
+  auto fi0 = i0_swap;
+  par_for("rad_restrict_i",DevExeSpace(),0,nmb1,0,(nrad-1),cks,cke,cjs,cje,cis,cie,
+  KOKKOS_LAMBDA(const int m, const int n, const int k, const int j, const int i) {
+    int fi = 2*(i - cis) + is;
+    int fj = (multi_d)? (2*(j - cjs) + js) : j;
+    int fk = (three_d)? (2*(k - cks) + ks) : k;
+    if (three_d) {
+      ci0(m,n,k,j,i) = 0.125*(fi0(m,n,fk  ,fj  ,fi) + fi0(m,n,fk  ,fj  ,fi+1)
+                            + fi0(m,n,fk  ,fj+1,fi) + fi0(m,n,fk  ,fj+1,fi+1)
+                            + fi0(m,n,fk+1,fj  ,fi) + fi0(m,n,fk+1,fj  ,fi+1)
+                            + fi0(m,n,fk+1,fj+1,fi) + fi0(m,n,fk+1,fj+1,fi+1));
+    } else if (multi_d) {
+      ci0(m,n,k,j,i) = 0.25*(fi0(m,n,fk,fj  ,fi) + fi0(m,n,fk,fj  ,fi+1)
+                           + fi0(m,n,fk,fj+1,fi) + fi0(m,n,fk,fj+1,fi+1));
+    } else {
+      ci0(m,n,k,j,i) = 0.5*(fi0(m,n,fk,fj,fi) + fi0(m,n,fk,fj,fi+1));
+    }
+  });
+
+  // following functions return a TaskStatus, but it is ignored so cast to (void)
+  (void) InitRecv(pdrive, -1);  // stage < 0 suppresses InitFluxRecv
+  (void) SendI(pdrive, 0);
+  (void) ClearSend(pdrive, -1);
+  (void) ClearRecv(pdrive, -1);
+  (void) RecvI(pdrive, 0);
+  if (!(pmy_pack->pmesh->strictly_periodic)) {
+    pbval_i->RadiationBCs((pmy_pack), (pbval_i->i_in), i0, (pbval_i->pgrid_indcs));
+  }
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus Radiation::ToFineGrid()
+//! \brief Task in "after_timeintegrator" list that prolongates the intensities from the
+//! coarse grid (with the same limited linear operator used for SMR/AMR, which conserves
+//! the average over each coarse cell) back to the grid of the MeshBlocks, including the
+//! first two layers of ghost cells.
+
+TaskStatus Radiation::ToFineGrid(Driver *pdrive, int stage) {
+  if (coarsen == 1) {return TaskStatus::complete;}
+
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, js = indcs.js, ks = indcs.ks;
+  auto &cindcs = coarse_indcs;
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+  int cis = cindcs.is - 1, cie = cindcs.ie + 1;
+  int cjs = cindcs.js, cje = cindcs.je;
+  int cks = cindcs.ks, cke = cindcs.ke;
+  if (multi_d) {cjs--; cje++;}
+  if (three_d) {cks--; cke++;}
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  int ci0 = cindcs.is, cj0 = cindcs.js, ck0 = cindcs.ks;
+  auto ca = i0;
+  auto fa = i0_swap;
+  par_for("rad_prolong_i",DevExeSpace(),0,nmb1,0,(nrad-1),cks,cke,cjs,cje,cis,cie,
+  KOKKOS_LAMBDA(const int m, const int n, const int k, const int j, const int i) {
+    int fi = 2*(i - ci0) + is;
+    int fj = (multi_d)? (2*(j - cj0) + js) : j;
+    int fk = (three_d)? (2*(k - ck0) + ks) : k;
+    ProlongCC(m,n,k,j,i,fk,fj,fi,multi_d,three_d,ca,fa);
+  });
+
+  SwapGrids();
+  return TaskStatus::complete;
+}
+
+} // namespace radiation
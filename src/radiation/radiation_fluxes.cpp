@@ -11,9 +11,11 @@
 #include "athena.hpp"
 #include "mesh/mesh.hpp"
 #include "coordinates/coordinates.hpp"
+#include "coordinates/cell_locations.hpp"
 #include "eos/eos.hpp"
 #include "geodesic-grid/geodesic_grid.hpp"
 #include "radiation.hpp"
+#include "radiation_tetrad.hpp"
 #include "reconstruct/dc.hpp"
 #include "reconstruct/plm.hpp"
 #include "reconstruct/ppm.hpp"
@@ -25,10 +27,12 @@ namespace radiation {
 //! \brief Compute radiation fluxes
 
 TaskStatus Radiation::CalculateFluxes(Driver *pdriver, int stage) {
-  RegionIndcs &indcs = pmy_pack->pmesh->mb_indcs;
+  if (m1_closure) {return CalculateM1Fluxes(pdriver, stage);}
+  RegionIndcs &indcs = Indcs();
   int &is = indcs.is, &ie = indcs.ie;
   int &js = indcs.js, &je = indcs.je;
   int &ks = indcs.ks, &ke = indcs.ke;
+  int &nx1 = indcs.nx1, &nx2 = indcs.nx2, &nx3 = indcs.nx3;
   int nang1 = prgeo->nangles - 1;
   int nmb1 = pmy_pack->nmb_thispack - 1;
 
@@ -38,59 +42,102 @@ TaskStatus Radiation::CalculateFluxes(Driver *pdriver, int stage) {
   auto &nh_c_ = nh_c;
   auto &tet_c_ = tet_c;
 
+  // data needed to recompute tetrad at faces and n^a, if these are not stored
+  bool &recompute_tetrad_ = recompute_tetrad;
+  auto &size = Size();
+  auto &coord = pmy_pack->pcoord->coord_data;
+  bool &flat = coord.is_minkowski;
+  Real &spin = coord.bh_spin;
+
+  // Each team computes the fluxes through one row of faces for all angles.  Tetrad
+  // components at the faces and e_(0)^0 in the cells of the reconstruction stencil do
+  // not depend on angle, so they are staged in scratch once per row.  nl is the number
+  // of cells on each side of a face used by the reconstruction.
+  int ncells1 = indcs.nx1 + 2*(indcs.ng);
+  int scr_level = 0;
+  int nl = 1;
+  if (recon_method_ > 0) nl = 2;
+  if (recon_method_ > 1) nl = 3;
+
   //--------------------------------------------------------------------------------------
   // i-direction
 
   auto &t1d1 = tet_d1_x1f;
   auto &flx1 = iflx.x1f;
-  par_for("rflux_x1",DevExeSpace(),0,nmb1,0,nang1,ks,ke,js,je,is,ie+1,
-  KOKKOS_LAMBDA(int m, int n, int k, int j, int i) {
-    // calculate n^1 (hence determining upwinding direction)
-    Real n1 = t1d1(m,0,k,j,i)*nh_c_.d_view(n,0) + t1d1(m,1,k,j,i)*nh_c_.d_view(n,1)
-            + t1d1(m,2,k,j,i)*nh_c_.d_view(n,2) + t1d1(m,3,k,j,i)*nh_c_.d_view(n,3);
-
-    // convert to primitive n_0 I
-    Real iim1, iicc, iim2, iip1, iim3, iip2;
-    iim1 = i0_(m,n,k,j,i-1)/tet_c_(m,0,0,k,j,i-1);
-    iicc = i0_(m,n,k,j,i  )/tet_c_(m,0,0,k,j,i  );
-    if (recon_method_ > 0) {
-      iim2 = i0_(m,n,k,j,i-2)/tet_c_(m,0,0,k,j,i-2);
-      iip1 = i0_(m,n,k,j,i+1)/tet_c_(m,0,0,k,j,i+1);
-    }
-    if (recon_method_ > 1) {
-      iim3 = i0_(m,n,k,j,i-3)/tet_c_(m,0,0,k,j,i-3);
-      iip2 = i0_(m,n,k,j,i+2)/tet_c_(m,0,0,k,j,i+2);
-    }
+  size_t scr_size = ScrArray2D<Real>::shmem_size(4, ncells1) +
+                    ScrArray1D<Real>::shmem_size(ncells1);
+  par_for_outer("rflux_x1",DevExeSpace(),scr_size,scr_level,0,nmb1,ks,ke,js,je,
+  KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+    ScrArray2D<Real> tf(member.team_scratch(scr_level), 4, ncells1);
+    ScrArray1D<Real> tc(member.team_scratch(scr_level), ncells1);
+    par_for_inner(member, is, ie+1, [&](const int i) {
+      if (recompute_tetrad_) {
+        Real x1 = LeftEdgeX(i-is, nx1, size.d_view(m).x1min, size.d_view(m).x1max);
+        Real x2 = CellCenterX(j-js, nx2, size.d_view(m).x2min, size.d_view(m).x2max);
+        Real x3 = CellCenterX(k-ks, nx3, size.d_view(m).x3min, size.d_view(m).x3max);
+        Real e[4][4], e_cov[4][4], omega[4][4][4];
+        ComputeTetradAtPoint(x1,x2,x3,flat,spin,e,e_cov,omega);
+        for (int d=0; d<4; ++d) {tf(d,i) = e[d][1];}
+      } else {
+        for (int d=0; d<4; ++d) {tf(d,i) = t1d1(m,d,k,j,i);}
+      }
+    });
+    par_for_inner(member, is-nl, ie+nl, [&](const int i) {
+      tc(i) = tet_c_(m,0,0,k,j,i);
+    });
+    member.team_barrier();
 
-    // reconstruct primitive intensity
-    Real iiu, scr;
-    switch (recon_method_) {
-      case ReconstructionMethod::dc:
-        if (n1 > 0.0) iiu = iim1;
-        else          iiu = iicc;
-        break;
-      case ReconstructionMethod::plm:
-        if (n1 > 0.0) PLM(iim2, iim1, iicc, iiu, scr);
-        else          PLM(iim1, iicc, iip1, scr, iiu);
-        break;
-      case ReconstructionMethod::ppm4:
-        if (n1 > 0.0) PPM4(iim3, iim2, iim1, iicc, iip1, iiu, scr);
-        else          PPM4(iim2, iim1, iicc, iip1, iip2, scr, iiu);
-        break;
-      case ReconstructionMethod::ppmx:
-        if (n1 > 0.0) PPMX(iim3, iim2, iim1, iicc, iip1, iiu, scr);
-        else          PPMX(iim2, iim1, iicc, iip1, iip2, scr, iiu);
-        break;
-      case ReconstructionMethod::wenoz:
-        if (n1 > 0.0) WENOZ(iim3, iim2, iim1, iicc, iip1, iiu, scr);
-        else          WENOZ(iim2, iim1, iicc, iip1, iip2, scr, iiu);
-        break;
-      default:
-        break;
-    }
+    for (int n=0; n<=nang1; ++n) {
+      Real nh0 = nh_c_.d_view(n,0), nh1 = nh_c_.d_view(n,1);
+      Real nh2 = nh_c_.d_view(n,2), nh3 = nh_c_.d_view(n,3);
+      par_for_inner(member, is, ie+1, [&](const int i) {
+        // calculate n^1 (hence determining upwinding direction)
+        Real n1 = tf(0,i)*nh0 + tf(1,i)*nh1 + tf(2,i)*nh2 + tf(3,i)*nh3;
+
+        // convert to primitive n_0 I
+        Real iim1, iicc, iim2, iip1, iim3, iip2;
+        iim1 = i0_(m,n,k,j,i-1)/tc(i-1);
+        iicc = i0_(m,n,k,j,i)/tc(i);
+        if (recon_method_ > 0) {
+          iim2 = i0_(m,n,k,j,i-2)/tc(i-2);
+          iip1 = i0_(m,n,k,j,i+1)/tc(i+1);
+        }
+        if (recon_method_ > 1) {
+          iim3 = i0_(m,n,k,j,i-3)/tc(i-3);
+          iip2 = i0_(m,n,k,j,i+2)/tc(i+2);
+        }
+
+        // reconstruct primitive intensity
+        Real iiu, scr;
+        switch (recon_method_) {
+          case ReconstructionMethod::dc:
+            if (n1 > 0.0) iiu = iim1;
+            else          iiu = iicc;
+            break;
+          case ReconstructionMethod::plm:
+            if (n1 > 0.0) PLM(iim2, iim1, iicc, iiu, scr);
+            else          PLM(iim1, iicc, iip1, scr, iiu);
+            break;
+          case ReconstructionMethod::ppm4:
+            if (n1 > 0.0) PPM4(iim3, iim2, iim1, iicc, iip1, iiu, scr);
+            else          PPM4(iim2, iim1, iicc, iip1, iip2, scr, iiu);
+            break;
+          case ReconstructionMethod::ppmx:
+            if (n1 > 0.0) PPMX(iim3, iim2, iim1, iicc, iip1, iiu, scr);
+            else          PPMX(iim2, iim1, iicc, iip1, iip2, scr, iiu);
+            break;
+          case ReconstructionMethod::wenoz:
+            if (n1 > 0.0) WENOZ(iim3, iim2, iim1, iicc, iip1, iiu, scr);
+            else          WENOZ(iim2, iim1, iicc, iip1, iip2, scr, iiu);
+            break;
+          default:
+            break;
+        }
 
-    // compute x1flux
-    flx1(m,n,k,j,i) = n1*iiu;
+        // compute x1flux
+        flx1(m,n,k,j,i) = n1*iiu;
+      });
+    }
   });
 
   //--------------------------------------------------------------------------------------
@@ -99,111 +146,159 @@ TaskStatus Radiation::CalculateFluxes(Driver *pdriver, int stage) {
   if (pmy_pack->pmesh->multi_d) {
     auto &t2d2 = tet_d2_x2f;
     auto &flx2 = iflx.x2f;
-    par_for("rflux_x2",DevExeSpace(),0,nmb1,0,nang1,ks,ke,js,je+1,is,ie,
-    KOKKOS_LAMBDA(int m, int n, int k, int j, int i) {
-      // calculate n^2 (hence determining upwinding direction)
-      Real n2 = t2d2(m,0,k,j,i)*nh_c_.d_view(n,0) + t2d2(m,1,k,j,i)*nh_c_.d_view(n,1)
-              + t2d2(m,2,k,j,i)*nh_c_.d_view(n,2) + t2d2(m,3,k,j,i)*nh_c_.d_view(n,3);
-
-      // convert to primitive n_0 I
-      Real iim1, iicc, iim2, iip1, iim3, iip2;
-      iim1 = i0_(m,n,k,j-1,i)/tet_c_(m,0,0,k,j-1,i);
-      iicc = i0_(m,n,k,j  ,i)/tet_c_(m,0,0,k,j  ,i);
-      if (recon_method_ > 0) {
-        iim2 = i0_(m,n,k,j-2,i)/tet_c_(m,0,0,k,j-2,i);
-        iip1 = i0_(m,n,k,j+1,i)/tet_c_(m,0,0,k,j+1,i);
-      }
-      if (recon_method_ > 1) {
-        iim3 = i0_(m,n,k,j-3,i)/tet_c_(m,0,0,k,j-3,i);
-        iip2 = i0_(m,n,k,j+2,i)/tet_c_(m,0,0,k,j+2,i);
-      }
+    scr_size = ScrArray2D<Real>::shmem_size(4, ncells1) +
+               ScrArray2D<Real>::shmem_size(2*nl, ncells1);
+    par_for_outer("rflux_x2",DevExeSpace(),scr_size,scr_level,0,nmb1,ks,ke,js,je+1,
+    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+      ScrArray2D<Real> tf(member.team_scratch(scr_level), 4, ncells1);
+      ScrArray2D<Real> tc(member.team_scratch(scr_level), 2*nl, ncells1);
+      par_for_inner(member, is, ie, [&](const int i) {
+        if (recompute_tetrad_) {
+          Real x1 = CellCenterX(i-is, nx1, size.d_view(m).x1min, size.d_view(m).x1max);
+          Real x2 = LeftEdgeX(j-js, nx2, size.d_view(m).x2min, size.d_view(m).x2max);
+          Real x3 = CellCenterX(k-ks, nx3, size.d_view(m).x3min, size.d_view(m).x3max);
+          Real e[4][4], e_cov[4][4], omega[4][4][4];
+          ComputeTetradAtPoint(x1,x2,x3,flat,spin,e,e_cov,omega);
+          for (int d=0; d<4; ++d) {tf(d,i) = e[d][2];}
+        } else {
+          for (int d=0; d<4; ++d) {tf(d,i) = t2d2(m,d,k,j,i);}
+        }
+        for (int l=0; l<2*nl; ++l) {tc(l,i) = tet_c_(m,0,0,k,j-nl+l,i);}
+      });
+      member.team_barrier();
 
-      // reconstruct primitive intensity
-      Real iiu, scr;
-      switch (recon_method_) {
-        case ReconstructionMethod::dc:
-          if (n2 > 0.0) iiu = iim1;
-          else          iiu = iicc;
-          break;
-        case ReconstructionMethod::plm:
-          if (n2 > 0.0) PLM(iim2, iim1, iicc, iiu, scr);
-          else          PLM(iim1, iicc, iip1, scr, iiu);
-          break;
-        case ReconstructionMethod::ppm4:
-          if (n2 > 0.0) PPM4(iim3, iim2, iim1, iicc, iip1, iiu, scr);
-          else          PPM4(iim2, iim1, iicc, iip1, iip2, scr, iiu);
-          break;
-        case ReconstructionMethod::ppmx:
-          if (n2 > 0.0) PPMX(iim3, iim2, iim1, iicc, iip1, iiu, scr);
-          else          PPMX(iim2, iim1, iicc, iip1, iip2, scr, iiu);
-          break;
-        case ReconstructionMethod::wenoz:
-          if (n2 > 0.0) WENOZ(iim3, iim2, iim1, iicc, iip1, iiu, scr);
-          else          WENOZ(iim2, iim1, iicc, iip1, iip2, scr, iiu);
-          break;
-        default:
-          break;
-      }
+      for (int n=0; n<=nang1; ++n) {
+        Real nh0 = nh_c_.d_view(n,0), nh1 = nh_c_.d_view(n,1);
+        Real nh2 = nh_c_.d_view(n,2), nh3 = nh_c_.d_view(n,3);
+        par_for_inner(member, is, ie, [&](const int i) {
+          // calculate n^2 (hence determining upwinding direction)
+          Real n2 = tf(0,i)*nh0 + tf(1,i)*nh1 + tf(2,i)*nh2 + tf(3,i)*nh3;
+
+          // convert to primitive n_0 I
+          Real iim1, iicc, iim2, iip1, iim3, iip2;
+          iim1 = i0_(m,n,k,j-1,i)/tc(nl-1,i);
+          iicc = i0_(m,n,k,j,i)/tc(nl,i);
+          if (recon_method_ > 0) {
+            iim2 = i0_(m,n,k,j-2,i)/tc(nl-2,i);
+            iip1 = i0_(m,n,k,j+1,i)/tc(nl+1,i);
+          }
+          if (recon_method_ > 1) {
+            iim3 = i0_(m,n,k,j-3,i)/tc(nl-3,i);
+            iip2 = i0_(m,n,k,j+2,i)/tc(nl+2,i);
+          }
 
-      // compute x2flux
-      flx2(m,n,k,j,i) = n2*iiu;
+          // reconstruct primitive intensity
+          Real iiu, scr;
+          switch (recon_method_) {
+            case ReconstructionMethod::dc:
+              if (n2 > 0.0) iiu = iim1;
+              else          iiu = iicc;
+              break;
+            case ReconstructionMethod::plm:
+              if (n2 > 0.0) PLM(iim2, iim1, iicc, iiu, scr);
+              else          PLM(iim1, iicc, iip1, scr, iiu);
+              break;
+            case ReconstructionMethod::ppm4:
+              if (n2 > 0.0) PPM4(iim3, iim2, iim1, iicc, iip1, iiu, scr);
+              else          PPM4(iim2, iim1, iicc, iip1, iip2, scr, iiu);
+              break;
+            case ReconstructionMethod::ppmx:
+              if (n2 > 0.0) PPMX(iim3, iim2, iim1, iicc, iip1, iiu, scr);
+              else          PPMX(iim2, iim1, iicc, iip1, iip2, scr, iiu);
+              break;
+            case ReconstructionMethod::wenoz:
+              if (n2 > 0.0) WENOZ(iim3, iim2, iim1, iicc, iip1, iiu, scr);
+              else          WENOZ(iim2, iim1, iicc, iip1, iip2, scr, iiu);
+              break;
+            default:
+              break;
+          }
+
+          // compute x2flux
+          flx2(m,n,k,j,i) = n2*iiu;
+        });
+      }
     });
   }
 
   //--------------------------------------------------------------------------------------
-  // k-direction. Note order of k,j loops switched
+  // k-direction
 
   if (pmy_pack->pmesh->three_d) {
     auto &t3d3 = tet_d3_x3f;
     auto &flx3 = iflx.x3f;
-    par_for("rflux_x3",DevExeSpace(),0,nmb1,0,nang1,ks,ke+1,js,je,is,ie,
-    KOKKOS_LAMBDA(int m, int n, int k, int j, int i) {
-      // calculate n^3 (hence determining upwinding direction)
-      Real n3 = t3d3(m,0,k,j,i)*nh_c_.d_view(n,0) + t3d3(m,1,k,j,i)*nh_c_.d_view(n,1)
-              + t3d3(m,2,k,j,i)*nh_c_.d_view(n,2) + t3d3(m,3,k,j,i)*nh_c_.d_view(n,3);
-
-      // convert to primitive n_0 I
-      Real iim1, iicc, iim2, iip1, iim3, iip2;
-      iim1 = i0_(m,n,k-1,j,i)/tet_c_(m,0,0,k-1,j,i);
-      iicc = i0_(m,n,k  ,j,i)/tet_c_(m,0,0,k  ,j,i);
-      if (recon_method_ > 0) {
-        iim2 = i0_(m,n,k-2,j,i)/tet_c_(m,0,0,k-2,j,i);
-        iip1 = i0_(m,n,k+1,j,i)/tet_c_(m,0,0,k+1,j,i);
-      }
-      if (recon_method_ > 1) {
-        iim3 = i0_(m,n,k-3,j,i)/tet_c_(m,0,0,k-3,j,i);
-        iip2 = i0_(m,n,k+2,j,i)/tet_c_(m,0,0,k+2,j,i);
-      }
+    scr_size = ScrArray2D<Real>::shmem_size(4, ncells1) +
+               ScrArray2D<Real>::shmem_size(2*nl, ncells1);
+    par_for_outer("rflux_x3",DevExeSpace(),scr_size,scr_level,0,nmb1,ks,ke+1,js,je,
+    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+      ScrArray2D<Real> tf(member.team_scratch(scr_level), 4, ncells1);
+      ScrArray2D<Real> tc(member.team_scratch(scr_level), 2*nl, ncells1);
+      par_for_inner(member, is, ie, [&](const int i) {
+        if (recompute_tetrad_) {
+          Real x1 = CellCenterX(i-is, nx1, size.d_view(m).x1min, size.d_view(m).x1max);
+          Real x2 = CellCenterX(j-js, nx2, size.d_view(m).x2min, size.d_view(m).x2max);
+          Real x3 = LeftEdgeX(k-ks, nx3, size.d_view(m).x3min, size.d_view(m).x3max);
+          Real e[4][4], e_cov[4][4], omega[4][4][4];
+          ComputeTetradAtPoint(x1,x2,x3,flat,spin,e,e_cov,omega);
+          for (int d=0; d<4; ++d) {tf(d,i) = e[d][3];}
+        } else {
+          for (int d=0; d<4; ++d) {tf(d,i) = t3d3(m,d,k,j,i);}
+        }
+        for (int l=0; l<2*nl; ++l) {tc(l,i) = tet_c_(m,0,0,k-nl+l,j,i);}
+      });
+      member.team_barrier();
 
-      // reconstruct primitive intensity
-      Real iiu, scr;
-      switch (recon_method_) {
-        case ReconstructionMethod::dc:
-          if (n3 > 0.0) iiu = iim1;
-          else          iiu = iicc;
-          break;
-        case ReconstructionMethod::plm:
-          if (n3 > 0.0) PLM(iim2, iim1, iicc, iiu, scr);
-          else          PLM(iim1, iicc, iip1, scr, iiu);
-          break;
-        case ReconstructionMethod::ppm4:
-          if (n3 > 0.0) PPM4(iim3, iim2, iim1, iicc, iip1, iiu, scr);
-          else          PPM4(iim2, iim1, iicc, iip1, iip2, scr, iiu);
-          break;
-        case ReconstructionMethod::ppmx:
-          if (n3 > 0.0) PPMX(iim3, iim2, iim1, iicc, iip1, iiu, scr);
-          else          PPMX(iim2, iim1, iicc, iip1, iip2, scr, iiu);
-          break;
-        case ReconstructionMethod::wenoz:
-          if (n3 > 0.0) WENOZ(iim3, iim2, iim1, iicc, iip1, iiu, scr);
-          else          WENOZ(iim2, iim1, iicc, iip1, iip2, scr, iiu);
-          break;
-        default:
-          break;
-      }
+      for (int n=0; n<=nang1; ++n) {
+        Real nh0 = nh_c_.d_view(n,0), nh1 = nh_c_.d_view(n,1);
+        Real nh2 = nh_c_.d_view(n,2), nh3 = nh_c_.d_view(n,3);
+        par_for_inner(member, is, ie, [&](const int i) {
+          // calculate n^3 (hence determining upwinding direction)
+          Real n3 = tf(0,i)*nh0 + tf(1,i)*nh1 + tf(2,i)*nh2 + tf(3,i)*nh3;
 
-      // compute x3flux
-      flx3(m,n,k,j,i) = n3*iiu;
+          // convert to primitive n_0 I
+          Real iim1, iicc, iim2, iip1, iim3, iip2;
+          iim1 = i0_(m,n,k-1,j,i)/tc(nl-1,i);
+          iicc = i0_(m,n,k,j,i)/tc(nl,i);
+          if (recon_method_ > 0) {
+            iim2 = i0_(m,n,k-2,j,i)/tc(nl-2,i);
+            iip1 = i0_(m,n,k+1,j,i)/tc(nl+1,i);
+          }
+          if (recon_method_ > 1) {
+            iim3 = i0_(m,n,k-3,j,i)/tc(nl-3,i);
+            iip2 = i0_(m,n,k+2,j,i)/tc(nl+2,i);
+          }
+
+          // reconstruct primitive intensity
+          Real iiu, scr;
+          switch (recon_method_) {
+            case ReconstructionMethod::dc:
+              if (n3 > 0.0) iiu = iim1;
+              else          iiu = iicc;
+              break;
+            case ReconstructionMethod::plm:
+              if (n3 > 0.0) PLM(iim2, iim1, iicc, iiu, scr);
+              else          PLM(iim1, iicc, iip1, scr, iiu);
+              break;
+            case ReconstructionMethod::ppm4:
+              if (n3 > 0.0) PPM4(iim3, iim2, iim1, iicc, iip1, iiu, scr);
+              else          PPM4(iim2, iim1, iicc, iip1, iip2, scr, iiu);
+              break;
+            case ReconstructionMethod::ppmx:
+              if (n3 > 0.0) PPMX(iim3, iim2, iim1, iicc, iip1, iiu, scr);
+              else          PPMX(iim2, iim1, iicc, iip1, iip2, scr, iiu);
+              break;
+            case ReconstructionMethod::wenoz:
+              if (n3 > 0.0) WENOZ(iim3, iim2, iim1, iicc, iip1, iiu, scr);
+              else          WENOZ(iim2, iim1, iicc, iip1, iip2, scr, iiu);
+              break;
+            default:
+              break;
+          }
+
+          // compute x3flux
+          flx3(m,n,k,j,i) = n3*iiu;
+        });
+      }
     });
   }
 
@@ -219,17 +314,56 @@ TaskStatus Radiation::CalculateFluxes(Driver *pdriver, int stage) {
     auto &na_ = na;
     auto &divfa_ = divfa;
 
-    par_for("rflux_angular",DevExeSpace(),0,nmb1,0,nang1,ks,ke,js,je,is,ie,
-    KOKKOS_LAMBDA(int m, int n, int k, int j, int i) {
-      divfa_(m,n,k,j,i) = 0.0;
-      for (int nb=0; nb<numn.d_view(n); ++nb) {
-        Real flx_edge = na_(m,n,k,j,i,nb) *
-                        ((na_(m,n,k,j,i,nb) < 0.0) ?
-                         i0_(m,indn.d_view(n,nb),k,j,i)/tet_c_(m,0,0,k,j,i) :
-                         i0_(m,n,k,j,i)/tet_c_(m,0,0,k,j,i));
-        divfa_(m,n,k,j,i) += (arcl.d_view(n,nb)*flx_edge/solid_angles_.d_view(n));
+    if (recompute_tetrad_) {
+    // n^a is recomputed from the tetrad once per cell, so each thread loops over angles
+    auto &nh_f_ = nh_f;
+    auto &uflux = prgeo->unit_flux;
+    par_for_outer("rflux_angular",DevExeSpace(),0,scr_level,0,nmb1,ks,ke,js,je,
+    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+      par_for_inner(member, is, ie, [&](const int i) {
+        Real x1v = CellCenterX(i-is, nx1, size.d_view(m).x1min, size.d_view(m).x1max);
+        Real x2v = CellCenterX(j-js, nx2, size.d_view(m).x2min, size.d_view(m).x2max);
+        Real x3v = CellCenterX(k-ks, nx3, size.d_view(m).x3min, size.d_view(m).x3max);
+        Real e[4][4], e_cov[4][4], omega[4][4][4];
+        ComputeTetradAtPoint(x1v,x2v,x3v,flat,spin,e,e_cov,omega);
+        Real tc = tet_c_(m,0,0,k,j,i);
+        for (int n=0; n<=nang1; ++n) {
+          Real divfa = 0.0;
+          for (int nb=0; nb<numn.d_view(n); ++nb) {
+            Real na_nb = AngularFluxCoeff(nh_f_, uflux, n, nb, omega);
+            Real flx_edge = na_nb * ((na_nb < 0.0) ? i0_(m,indn.d_view(n,nb),k,j,i)/tc :
+                                                     i0_(m,n,k,j,i)/tc);
+            divfa += (arcl.d_view(n,nb)*flx_edge/solid_angles_.d_view(n));
+          }
+          divfa_(m,n,k,j,i) = divfa;
+        }
+      });
+    });
+    } else {
+    scr_size = ScrArray1D<Real>::shmem_size(ncells1);
+    par_for_outer("rflux_angular",DevExeSpace(),scr_size,scr_level,0,nmb1,ks,ke,js,je,
+    KOKKOS_LAMBDA(TeamMember_t member, const int m, const int k, const int j) {
+      ScrArray1D<Real> tc(member.team_scratch(scr_level), ncells1);
+      par_for_inner(member, is, ie, [&](const int i) {
+        tc(i) = tet_c_(m,0,0,k,j,i);
+      });
+      member.team_barrier();
+
+      for (int n=0; n<=nang1; ++n) {
+        par_for_inner(member, is, ie, [&](const int i) {
+          Real divfa = 0.0;
+          for (int nb=0; nb<numn.d_view(n); ++nb) {
+            Real flx_edge = na_(m,n,k,j,i,nb) *
+                            ((na_(m,n,k,j,i,nb) < 0.0) ?
+                             i0_(m,indn.d_view(n,nb),k,j,i)/tc(i) :
+                             i0_(m,n,k,j,i)/tc(i));
+            divfa += (arcl.d_view(n,nb)*flx_edge/solid_angles_.d_view(n));
+          }
+          divfa_(m,n,k,j,i) = divfa;
+        });
       }
     });
+    }
   }
 
   return TaskStatus::complete;
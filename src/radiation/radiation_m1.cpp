@@ -0,0 +1,275 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file radiation_m1.cpp
+//! \brief fluxes and update of the two-moment (M1) radiation transport selected with
+//! <radiation>/method = m1.  The radiation energy and momentum densities (E,F) in the
+//! tetrad frame (equal to the coordinate frame in flat spacetime) obey
+//!   dE/dt + d_i F^i = S^0,   dF^j/dt + d_i P^ij = S^j,
+//! with P^ij given by the M1 closure, and source terms S coupling radiation to the fluid
+//! added by AddM1SourceTerm().  Characteristic speeds are bounded by c=1, so fluxes are
+//! computed with the HLL (Lax-Friedrichs) solver with wave speeds -1 and 1, with the
+//! numerical dissipation reduced by 1/tau in optically thick cells (tau the optical
+//! depth of a cell) so that the scheme recovers the diffusion limit.
+
+#include <float.h>
+
+#include "athena.hpp"
+#include "mesh/mesh.hpp"
+#include "driver/driver.hpp"
+#include "eos/eos.hpp"
+#include "hydro/hydro.hpp"
+#include "mhd/mhd.hpp"
+#include "units/units.hpp"
+#include "radiation.hpp"
+#include "radiation_m1.hpp"
+#include "radiation_opacities.hpp"
+#include "reconstruct/plm.hpp"
+#include "reconstruct/ppm.hpp"
+#include "reconstruct/wenoz.hpp"
+
+namespace radiation {
+namespace {
+//----------------------------------------------------------------------------------------
+//! \struct M1Opacity
+//! \brief total (absorption plus scattering) opacity per unit length in each cell, used
+//! to reduce the numerical dissipation of the fluxes in optically thick cells
+
+struct M1Opacity {
+  bool enabled = false;
+  DvceArray5D<Real> w0;
+  Real density_scale = 1.0, temperature_scale = 1.0, length_scale = 1.0;
+  Real mean_mol_weight = 1.0, gm1 = 1.0;
+  bool power_opacity = false;
+  Real rosseland_coef = 1.0, planck_minus_rosseland_coef = 0.0;
+  Real kappa_a = 0.0, kappa_s = 0.0, kappa_p = 0.0;
+
+  KOKKOS_INLINE_FUNCTION
+  Real Total(const int m, const int k, const int j, const int i) const {
+    if (!(enabled)) {return 0.0;}
+    Real wdn = w0(m,IDN,k,j,i);
+    Real tgas = gm1*w0(m,IEN,k,j,i)/wdn;
+    Real sigma_a, sigma_s, sigma_p;
+    OpacityFunction(wdn, density_scale, tgas, temperature_scale, length_scale, gm1,
+                    mean_mol_weight, power_opacity, rosseland_coef,
+                    planck_minus_rosseland_coef, kappa_a, kappa_s, kappa_p,
+                    sigma_a, sigma_s, sigma_p);
+    return sigma_a + sigma_s;
+  }
+};
+
+M1Opacity SetM1Opacity(Radiation *prad, MeshBlockPack *pmbp) {
+  M1Opacity op;
+  if (!(prad->rad_source)) {return op;}
+  op.enabled = true;
+  if (prad->is_hydro_enabled) {
+    op.w0 = pmbp->phydro->w0;
+    op.gm1 = pmbp->phydro->peos->eos_data.gamma - 1.0;
+  } else {
+    op.w0 = pmbp->pmhd->w0;
+    op.gm1 = pmbp->pmhd->peos->eos_data.gamma - 1.0;
+  }
+  if (prad->are_units_enabled) {
+    op.density_scale = pmbp->punit->density_cgs();
+    op.temperature_scale = pmbp->punit->temperature_cgs();
+    op.length_scale = pmbp->punit->length_cgs();
+    op.mean_mol_weight = pmbp->punit->mu();
+    op.rosseland_coef = pmbp->punit->rosseland_coef_cgs;
+    op.planck_minus_rosseland_coef = pmbp->punit->planck_minus_rosseland_coef_cgs;
+  }
+  op.power_opacity = prad->power_opacity;
+  op.kappa_a = prad->kappa_a;
+  op.kappa_s = prad->kappa_s;
+  op.kappa_p = prad->kappa_p;
+  return op;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void M1Reconstruct
+//! \brief left and right states at the face between cells q[2] and q[3] of the stencil
+//! q[0..5] (cells i-3..i+2 along the direction of the face)
+
+KOKKOS_INLINE_FUNCTION
+void M1Reconstruct(const ReconstructionMethod method, const Real q[6],
+                   Real &ql, Real &qr) {
+  Real scr;
+  switch (method) {
+    case ReconstructionMethod::plm:
+      PLM(q[1], q[2], q[3], ql, scr);
+      PLM(q[2], q[3], q[4], scr, qr);
+      break;
+    case ReconstructionMethod::ppm4:
+      PPM4(q[0], q[1], q[2], q[3], q[4], ql, scr);
+      PPM4(q[1], q[2], q[3], q[4], q[5], scr, qr);
+      break;
+    case ReconstructionMethod::ppmx:
+      PPMX(q[0], q[1], q[2], q[3], q[4], ql, scr);
+      PPMX(q[1], q[2], q[3], q[4], q[5], scr, qr);
+      break;
+    case ReconstructionMethod::wenoz:
+      WENOZ(q[0], q[1], q[2], q[3], q[4], ql, scr);
+      WENOZ(q[1], q[2], q[3], q[4], q[5], scr, qr);
+      break;
+    default:
+      ql = q[2];
+      qr = q[3];
+      break;
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void M1FaceFlux
+//! \brief HLL flux in direction d (0,1,2) of (E,F) through the face between cell i-di
+//! and cell i of array i0, where di is the offset of cells along the direction.
+
+KOKKOS_INLINE_FUNCTION
+void M1FaceFlux(const DvceArray5D<Real> &i0, const ReconstructionMethod method,
+                const int nl, const int d, const int m, const int k, const int j,
+                const int i, const int dk, const int dj, const int di,
+                const Real e_floor, const Real eps, Real flx[4]) {
+  Real ul[4], ur[4];
+  for (int v=0; v<4; ++v) {
+    Real q[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    for (int s=3-nl; s<3+nl; ++s) {
+      q[s] = i0(m,v,k+(s-3)*dk,j+(s-3)*dj,i+(s-3)*di);
+    }
+    M1Reconstruct(method, q, ul[v], ur[v]);
+  }
+  Real fl[3] = {ul[IRF1], ul[IRF2], ul[IRF3]};
+  Real fr[3] = {ur[IRF1], ur[IRF2], ur[IRF3]};
+  M1Limit(e_floor, ul[IRE], fl);
+  M1Limit(e_floor, ur[IRE], fr);
+  Real pl[3][3], pr[3][3];
+  M1Closure(ul[IRE], fl, pl);
+  M1Closure(ur[IRE], fr, pr);
+
+  flx[IRE] = 0.5*(fl[d] + fr[d]) - 0.5*eps*(ur[IRE] - ul[IRE]);
+  for (int n=0; n<3; ++n) {
+    flx[IRF1+n] = 0.5*(pl[d][n] + pr[d][n]) - 0.5*eps*(fr[n] - fl[n]);
+  }
+  return;
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn  void Radiation::CalculateM1Fluxes
+//! \brief Compute fluxes of the radiation moments with M1
+
+TaskStatus Radiation::CalculateM1Fluxes(Driver *pdriver, int stage) {
+  RegionIndcs &indcs = Indcs();
+  int &is = indcs.is, &ie = indcs.ie;
+  int &js = indcs.js, &je = indcs.je;
+  int &ks = indcs.ks, &ke = indcs.ke;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  auto &size = Size();
+
+  const ReconstructionMethod recon_method_ = recon_method;
+  int nl = 1;
+  if (recon_method_ > 0) nl = 2;
+  if (recon_method_ > 1) nl = 3;
+  auto &i0_ = i0;
+  Real e_floor = m1_e_floor;
+  M1Opacity op = SetM1Opacity(this, pmy_pack);
+  if (on_coarse_grid && op.enabled) {
+    RestrictFluid(op.w0);
+    op.w0 = cw0;
+  }
+
+  //--------------------------------------------------------------------------------------
+  // i-direction
+
+  auto &flx1 = iflx.x1f;
+  par_for("m1flux_x1",DevExeSpace(),0,nmb1,ks,ke,js,je,is,ie+1,
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    Real tau = 0.5*(op.Total(m,k,j,i-1) + op.Total(m,k,j,i))*size.d_view(m).dx1;
+    Real eps = fmin(1.0, 1.0/fmax(tau, FLT_MIN));
+    Real flx[4];
+    M1FaceFlux(i0_, recon_method_, nl, 0, m, k, j, i, 0, 0, 1, e_floor, eps, flx);
+    for (int v=0; v<4; ++v) {flx1(m,v,k,j,i) = flx[v];}
+  });
+  if (pmy_pack->pmesh->one_d) {return TaskStatus::complete;}
+
+  //--------------------------------------------------------------------------------------
+  // j-direction
+
+  auto &flx2 = iflx.x2f;
+  par_for("m1flux_x2",DevExeSpace(),0,nmb1,ks,ke,js,je+1,is,ie,
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    Real tau = 0.5*(op.Total(m,k,j-1,i) + op.Total(m,k,j,i))*size.d_view(m).dx2;
+    Real eps = fmin(1.0, 1.0/fmax(tau, FLT_MIN));
+    Real flx[4];
+    M1FaceFlux(i0_, recon_method_, nl, 1, m, k, j, i, 0, 1, 0, e_floor, eps, flx);
+    for (int v=0; v<4; ++v) {flx2(m,v,k,j,i) = flx[v];}
+  });
+  if (pmy_pack->pmesh->two_d) {return TaskStatus::complete;}
+
+  //--------------------------------------------------------------------------------------
+  // k-direction
+
+  auto &flx3 = iflx.x3f;
+  par_for("m1flux_x3",DevExeSpace(),0,nmb1,ks,ke+1,js,je,is,ie,
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    Real tau = 0.5*(op.Total(m,k-1,j,i) + op.Total(m,k,j,i))*size.d_view(m).dx3;
+    Real eps = fmin(1.0, 1.0/fmax(tau, FLT_MIN));
+    Real flx[4];
+    M1FaceFlux(i0_, recon_method_, nl, 2, m, k, j, i, 1, 0, 0, e_floor, eps, flx);
+    for (int v=0; v<4; ++v) {flx3(m,v,k,j,i) = flx[v];}
+  });
+
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void Radiation::M1Update
+//! \brief Explicit RK update of the flux divergence of the radiation moments with M1,
+//! followed by the floor on E and the limit |F| <= E
+
+TaskStatus Radiation::M1Update(Driver *pdriver, int stage) {
+  auto &indcs = Indcs();
+  int &is = indcs.is, &ie = indcs.ie;
+  int &js = indcs.js, &je = indcs.je;
+  int &ks = indcs.ks, &ke = indcs.ke;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  auto &mbsize  = Size();
+  bool &multi_d = pmy_pack->pmesh->multi_d;
+  bool &three_d = pmy_pack->pmesh->three_d;
+
+  Real &gam0 = pdriver->gam0[stage-1];
+  Real &gam1 = pdriver->gam1[stage-1];
+  Real beta_dt = (pdriver->beta[stage-1])*(pmy_pack->pmesh->dt);
+
+  auto &i0_ = i0;
+  auto &i1_ = i1;
+  auto &flx1 = iflx.x1f;
+  auto &flx2 = iflx.x2f;
+  auto &flx3 = iflx.x3f;
+  Real e_floor = m1_e_floor;
+
+  par_for("m1_update",DevExeSpace(),0,nmb1,ks,ke,js,je,is,ie,
+  KOKKOS_LAMBDA(int m, int k, int j, int i) {
+    Real u[4];
+    for (int v=0; v<4; ++v) {
+      Real divf = (flx1(m,v,k,j,i+1) - flx1(m,v,k,j,i))/mbsize.d_view(m).dx1;
+      if (multi_d) {
+        divf += (flx2(m,v,k,j+1,i) - flx2(m,v,k,j,i))/mbsize.d_view(m).dx2;
+      }
+      if (three_d) {
+        divf += (flx3(m,v,k+1,j,i) - flx3(m,v,k,j,i))/mbsize.d_view(m).dx3;
+      }
+      u[v] = gam0*i0_(m,v,k,j,i) + gam1*i1_(m,v,k,j,i) - beta_dt*divf;
+    }
+    Real f[3] = {u[IRF1], u[IRF2], u[IRF3]};
+    M1Limit(e_floor, u[IRE], f);
+    i0_(m,IRE,k,j,i) = u[IRE];
+    i0_(m,IRF1,k,j,i) = f[0];
+    i0_(m,IRF2,k,j,i) = f[1];
+    i0_(m,IRF3,k,j,i) = f[2];
+  });
+
+  return TaskStatus::complete;
+}
+
+} // namespace radiation
@@ -0,0 +1,97 @@
+#ifndef RADIATION_RADIATION_M1_HPP_
+#define RADIATION_RADIATION_M1_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file radiation_m1.hpp
+//! \brief closure and frame transformations of the radiation moments evolved with
+//! <radiation>/method = m1.  The moments are the energy density E and momentum density
+//! (flux) F^i of radiation in the tetrad frame, with c=1.
+
+#include <math.h>
+
+#include "athena.hpp"
+
+// indices of the moments in i0 with M1
+enum M1Index {IRE=0, IRF1=1, IRF2=2, IRF3=3};
+
+//----------------------------------------------------------------------------------------
+//! \fn void M1Limit
+//! \brief applies the floor to E and limits the flux to |F| <= E
+
+KOKKOS_INLINE_FUNCTION
+void M1Limit(const Real e_floor, Real &e, Real f[3]) {
+  e = fmax(e, e_floor);
+  Real fmag = sqrt(SQR(f[0]) + SQR(f[1]) + SQR(f[2]));
+  if (fmag > e) {
+    Real fac = e/fmag;
+    f[0] *= fac;
+    f[1] *= fac;
+    f[2] *= fac;
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void M1Closure
+//! \brief computes the pressure tensor P^ij from E and F^i with the Levermore-Minerbo
+//! Eddington factor chi(f) = (3 + 4f^2)/(5 + 2 sqrt(4 - 3f^2)), f = |F|/E, which gives
+//! P = E/3 for isotropic radiation (f=0) and free streaming along F for f=1.
+
+KOKKOS_INLINE_FUNCTION
+void M1Closure(const Real e, const Real f[3], Real p[3][3]) {
+  Real fsq = SQR(f[0]) + SQR(f[1]) + SQR(f[2]);
+  Real ff = (e > 0.0)? fmin(sqrt(fsq)/e, 1.0) : 0.0;
+  Real chi = (3.0 + 4.0*SQR(ff))/(5.0 + 2.0*sqrt(4.0 - 3.0*SQR(ff)));
+  Real a = 0.5*(1.0 - chi)*e;
+  Real b = (fsq > 0.0)? 0.5*(3.0*chi - 1.0)*e/fsq : 0.0;
+  for (int d1=0; d1<3; ++d1) {
+    for (int d2=0; d2<3; ++d2) {
+      p[d1][d2] = b*f[d1]*f[d2] + ((d1 == d2)? a : 0.0);
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void M1Tensor
+//! \brief stores E, F^i, and P^ij from the closure in the tensor R^(ab) (tetrad frame)
+
+KOKKOS_INLINE_FUNCTION
+void M1Tensor(const Real e, const Real f[3], Real r[4][4]) {
+  Real p[3][3];
+  M1Closure(e, f, p);
+  r[0][0] = e;
+  for (int d1=0; d1<3; ++d1) {
+    r[0][d1+1] = f[d1];
+    r[d1+1][0] = f[d1];
+    for (int d2=0; d2<3; ++d2) {
+      r[d1+1][d2+1] = p[d1][d2];
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void M1Boost
+//! \brief Lorentz boost lam^a_b to the frame moving with four-velocity u^(a) (given in
+//! the tetrad frame), or from it if inverse = true.  Equal to tet_to_fluid in the
+//! radiation moment outputs.
+
+KOKKOS_INLINE_FUNCTION
+void M1Boost(const Real u[4], const bool inverse, Real lam[4][4]) {
+  Real sgn = (inverse)? 1.0 : -1.0;
+  lam[0][0] = u[0];
+  for (int d1=1; d1<4; ++d1) {
+    lam[0][d1] = sgn*u[d1];
+    lam[d1][0] = sgn*u[d1];
+    for (int d2=1; d2<4; ++d2) {
+      lam[d1][d2] = u[d1]*u[d2]/(1.0 + u[0]) + ((d1 == d2)? 1.0 : 0.0);
+    }
+  }
+  return;
+}
+
+#endif // RADIATION_RADIATION_M1_HPP_
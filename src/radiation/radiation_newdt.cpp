@@ -31,7 +31,7 @@ namespace radiation {
 //        Only computed once at beginning of calculation.
 
 TaskStatus Radiation::NewTimeStep(Driver *pdriver, int stage) {
-  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  auto &indcs = Indcs();
   int &is = indcs.is, &nx1 = indcs.nx1;
   int &js = indcs.js, &nx2 = indcs.nx2;
   int &ks = indcs.ks, &nx3 = indcs.nx3;
@@ -42,21 +42,33 @@ TaskStatus Radiation::NewTimeStep(Driver *pdriver, int stage) {
   Real dta = std::numeric_limits<float>::max();
 
   // setup indicies for Kokkos parallel reduce
-  auto &size = pmy_pack->pmb->mb_size;
+  auto &size = Size();
   const int nmkji = (pmy_pack->nmb_thispack)*nx3*nx2*nx1;
   const int nkji = nx3*nx2*nx1;
   const int nji  = nx2*nx1;
-  int nang1 = prgeo->nangles - 1;
+  int nang1 = nrad - 1;
 
   // data needed to compute angular dt
   bool &angular_fluxes_ = angular_fluxes;
   auto &nh_c_ = nh_c;
   auto &na_ = na;
   auto &tet_c_ = tet_c;
+  bool &recompute_tetrad_ = recompute_tetrad;
+  auto &nh_f_ = nh_f;
+  auto &coord = pmy_pack->pcoord->coord_data;
+  bool &flat = coord.is_minkowski;
+  Real &spin = coord.bh_spin;
   auto &excise = pmy_pack->pcoord->coord_data.bh_excise;
   auto &rad_mask_ = pmy_pack->pcoord->excision_floor;
-  auto &numn = prgeo->num_neighbors;
-  auto &indn = prgeo->ind_neighbors;
+  // angular mesh data (there is no angular mesh, and thus no angular fluxes, with M1)
+  DualArray3D<Real> uflux;
+  DualArray1D<int> numn;
+  DualArray2D<int> indn;
+  if (angular_fluxes_) {
+    uflux = prgeo->unit_flux;
+    numn = prgeo->num_neighbors;
+    indn = prgeo->ind_neighbors;
+  }
 
   // find smallest (dx/c) and (dangle/na) in each direction for radiation problems
   Kokkos::parallel_reduce("RadiationNudt",Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
@@ -71,6 +83,15 @@ TaskStatus Radiation::NewTimeStep(Driver *pdriver, int stage) {
 
     Real tmp_min_dta = (FLT_MAX);
     if (angular_fluxes_) {
+      // Ricci rotation coefficients needed to recompute n^a in this cell
+      Real omega[4][4][4];
+      if (recompute_tetrad_) {
+        Real x1v = CellCenterX(i-is, nx1, size.d_view(m).x1min, size.d_view(m).x1max);
+        Real x2v = CellCenterX(j-js, nx2, size.d_view(m).x2min, size.d_view(m).x2max);
+        Real x3v = CellCenterX(k-ks, nx3, size.d_view(m).x3min, size.d_view(m).x3max);
+        Real e[4][4], e_cov[4][4];
+        ComputeTetradAtPoint(x1v,x2v,x3v,flat,spin,e,e_cov,omega);
+      }
       for (int n=0; n<=nang1; ++n) {
         // find position at angle center
         Real x = nh_c_.d_view(n,1);
@@ -83,7 +104,9 @@ TaskStatus Radiation::NewTimeStep(Driver *pdriver, int stage) {
           Real zn = nh_c_.d_view(indn.d_view(n,nb),3);
           // compute timestep limitation
           Real n0 = tet_c_(m,0,0,k,j,i);
-          Real adt = fmin(tmp_min_dta,(acos(x*xn+y*yn+z*zn)/fabs(na_(m,n,k,j,i,nb)/n0)));
+          Real na_nb = (recompute_tetrad_)? AngularFluxCoeff(nh_f_, uflux, n, nb, omega)
+                                          : na_(m,n,k,j,i,nb);
+          Real adt = fmin(tmp_min_dta,(acos(x*xn+y*yn+z*zn)/fabs(na_nb/n0)));
           // set timestep limitation if not excising this cell
           if (excise) {
             if (!(rad_mask_(m,k,j,i))) { tmp_min_dta = adt; }
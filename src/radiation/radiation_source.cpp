@@ -5,6 +5,8 @@
 //========================================================================================
 //! \file radiation_source.cpp
 
+#include <algorithm>
+
 #include "athena.hpp"
 #include "mesh/mesh.hpp"
 #include "driver/driver.hpp"
@@ -18,6 +20,7 @@
 #include "units/units.hpp"
 #include "radiation.hpp"
 
+#include "radiation/radiation_m1.hpp"
 #include "radiation/radiation_tetrad.hpp"
 #include "radiation/radiation_opacities.hpp"
 
@@ -25,6 +28,9 @@ namespace radiation {
 
 KOKKOS_INLINE_FUNCTION
 bool FourthPolyRoot(const Real coef4, const Real tconst, Real &root);
+KOKKOS_INLINE_FUNCTION
+bool NewtonPolyRoot(const Real coef4, const Real tconst, const int nit, const Real tol,
+                    Real &root, int &iter_used);
 
 //----------------------------------------------------------------------------------------
 //! \fn TaskStatus Radiation::AddRadiationSourceTerm(Driver *pdriver, int stage)
@@ -36,26 +42,32 @@ TaskStatus Radiation::AddRadiationSourceTerm(Driver *pdriver, int stage) {
   if (!(rad_source)) {
     return TaskStatus::complete;
   }
+  if (m1_closure) {return AddM1SourceTerm(pdriver, stage);}
 
   // Extract indices, size data, hydro/mhd/units flags, and coupling flags
-  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  auto &indcs = Indcs();
   int &is = indcs.is, &ie = indcs.ie;
   int &js = indcs.js, &je = indcs.je;
   int &ks = indcs.ks, &ke = indcs.ke;
   int nmb1 = pmy_pack->nmb_thispack - 1;
   int nang1 = prgeo->nangles - 1;
-  auto &size = pmy_pack->pmb->mb_size;
+  auto &size = Size();
   bool &is_hydro_enabled_ = is_hydro_enabled;
   bool &is_mhd_enabled_ = is_mhd_enabled;
   bool &are_units_enabled_ = are_units_enabled;
   bool &is_compton_enabled_ = is_compton_enabled;
   bool &fixed_fluid_ = fixed_fluid;
   bool &affect_fluid_ = affect_fluid;
+  bool &newton_ = newton_coupling;
+  int &newton_iter_ = newton_iter;
+  Real &newton_tol_ = newton_tol;
 
   // Extract coordinate/excision data
   auto &coord = pmy_pack->pcoord->coord_data;
   bool &flat = coord.is_minkowski;
   Real &spin = coord.bh_spin;
+  bool &cache_metric = coord.cache_metric;
+  auto &gcc = coord.gcc;
   bool &excise = pmy_pack->pcoord->coord_data.bh_excise;
   auto &rad_mask_ = pmy_pack->pcoord->excision_floor;
   Real &n_0_floor_ = n_0_floor;
@@ -109,20 +121,47 @@ TaskStatus Radiation::AddRadiationSourceTerm(Driver *pdriver, int stage) {
   // Extract timestep
   Real dt_ = (pdriver->beta[stage-1])*(pmy_pack->pmesh->dt);
 
-  // Call ConsToPrim over active zones prior to source term application
+  // Call ConsToPrim over active zones (of the fluid) prior to source term application
   if (!(fixed_fluid_)) {
+    auto &fi = pmy_pack->pmesh->mb_indcs;
     if (is_hydro_enabled_) {
-      pmy_pack->phydro->peos->ConsToPrim(u0_,w0_,false,is,ie,js,je,ks,ke);
+      pmy_pack->phydro->peos->ConsToPrim(u0_,w0_,false,fi.is,fi.ie,fi.js,fi.je,
+                                         fi.ks,fi.ke);
     } else if (is_mhd_enabled_) {
       auto &b0_ = pmy_pack->pmhd->b0;
       auto &bcc0_ = pmy_pack->pmhd->bcc0;
-      pmy_pack->pmhd->peos->ConsToPrim(u0_,b0_,w0_,bcc0_,false,is,ie,js,je,ks,ke);
+      pmy_pack->pmhd->peos->ConsToPrim(u0_,b0_,w0_,bcc0_,false,fi.is,fi.ie,fi.js,fi.je,
+                                       fi.ks,fi.ke);
     }
   }
 
-  // compute implicit source term
-  par_for("radiation_source",DevExeSpace(),0,nmb1,ks,ke,js,je,is,ie,
-  KOKKOS_LAMBDA(int m, int k, int j, int i) {
+  // On the coarse radiation grid the fluid is coupled through its state restricted to
+  // that grid, and the change of the fluid is prolongated to its own grid afterwards
+  DvceArray5D<Real> fine_u0_ = u0_;
+  bool coarse_coupling = on_coarse_grid && (is_hydro_enabled_ || is_mhd_enabled_);
+  if (coarse_coupling) {
+    RestrictFluid(w0_);
+    Kokkos::deep_copy(DevExeSpace(), cdu0, 0.0);
+    u0_ = cdu0;
+    w0_ = cw0;
+  }
+
+  // compute implicit source term.  With Newton iterations, count the cells in which they
+  // did not converge (and exact roots are used instead) and the maximum iterations used
+  const int ni   = (ie - is + 1);
+  const int nji  = (je - js + 1)*ni;
+  const int nkji = (ke - ks + 1)*nji;
+  const int nmkji = (nmb1 + 1)*nkji;
+  int nfallback_ = 0, maxit_ = 0;
+  Kokkos::parallel_reduce("radiation_source",Kokkos::RangePolicy<>(DevExeSpace(),0,nmkji),
+  KOKKOS_LAMBDA(const int &idx, int &sumf, int &max_it) {
+    int m = (idx)/nkji;
+    int k = (idx - m*nkji)/nji;
+    int j = (idx - m*nkji - k*nji)/ni;
+    int i = (idx - m*nkji - k*nji - j*ni) + is;
+    j += js;
+    k += ks;
+
     Real &x1min = size.d_view(m).x1min;
     Real &x1max = size.d_view(m).x1max;
     Real x1v = CellCenterX(i-is, indcs.nx1, x1min, x1max);
@@ -137,7 +176,11 @@ TaskStatus Radiation::AddRadiationSourceTerm(Driver *pdriver, int stage) {
 
     // compute metric and inverse
     Real glower[4][4], gupper[4][4];
-    ComputeMetricAndInverse(x1v,x2v,x3v,flat,spin,glower,gupper);
+    if (cache_metric) {
+      LoadMetricAndInverse(gcc,m,k,j,i,glower,gupper);
+    } else {
+      ComputeMetricAndInverse(x1v,x2v,x3v,flat,spin,glower,gupper);
+    }
     Real alpha = sqrt(-1.0/gupper[0][0]);
 
     // fluid state
@@ -217,7 +260,15 @@ TaskStatus Radiation::AddRadiationSourceTerm(Driver *pdriver, int stage) {
     Real tgasnew = tgas;
     bool badcell = false;
     if (fabs(coef[1]) > 1.0e-20) {
-      bool flag = FourthPolyRoot(coef[1], coef[0], tgasnew);
+      bool flag = false;
+      if (newton_) {
+        int iter_used = 0;
+        flag = NewtonPolyRoot(coef[1], coef[0], newton_iter_, newton_tol_, tgasnew,
+                              iter_used);
+        max_it = (iter_used > max_it) ? iter_used : max_it;
+        if (!(flag)) {sumf++;}
+      }
+      if (!(flag)) {flag = FourthPolyRoot(coef[1], coef[0], tgasnew);}
       if (!(flag) || !(isfinite(tgasnew))) {
         badcell = true;
         tgasnew = tgas;
@@ -318,7 +369,15 @@ TaskStatus Radiation::AddRadiationSourceTerm(Driver *pdriver, int stage) {
       if (!(temp_equil)) {
         coef[1] = (1.0 + suma2*jr_cm)/(suma1*jr_cm)*arad_;
         coef[0] = -(1.0 + suma2*jr_cm)/suma1 - tgas;
-        bool flag = FourthPolyRoot(coef[1], coef[0], tradnew);
+        bool flag = false;
+        if (newton_) {
+          int iter_used = 0;
+          flag = NewtonPolyRoot(coef[1], coef[0], newton_iter_, newton_tol_, tradnew,
+                                iter_used);
+          max_it = (iter_used > max_it) ? iter_used : max_it;
+          if (!(flag)) {sumf++;}
+        }
+        if (!(flag)) {flag = FourthPolyRoot(coef[1], coef[0], tradnew);}
         if (!(flag) || !(isfinite(tradnew))) {
           badcell = true;
         }
@@ -387,7 +446,240 @@ TaskStatus Radiation::AddRadiationSourceTerm(Driver *pdriver, int stage) {
         }
       }
     }
-  });
+  }, Kokkos::Sum<int>(nfallback_), Kokkos::Max<int>(maxit_));
+  if (coarse_coupling && affect_fluid) {ProlongFluidChange(fine_u0_);}
+
+  // store event counters
+  if (newton_coupling) {
+    pmy_pack->pmesh->ecounter.nrad_fallback += nfallback_;
+    pmy_pack->pmesh->ecounter.maxit_rad = std::max(pmy_pack->pmesh->ecounter.maxit_rad,
+                                                   maxit_);
+  }
+
+  return TaskStatus::complete;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus Radiation::AddM1SourceTerm(Driver *pdriver, int stage)
+//! \brief Add implicit radiation source term with M1.  In each cell the moments are
+//! boosted to the comoving frame of the fluid, where emission and absorption exchange
+//! energy with the gas (solving the same quartic for the new gas temperature as the
+//! discrete ordinates update), and absorption plus scattering damp the flux.  The change
+//! of the comoving moments (with isotropic change of the pressure) is boosted back to
+//! the tetrad frame, and its negative applied to the fluid.
+
+TaskStatus Radiation::AddM1SourceTerm(Driver *pdriver, int stage) {
+  // Extract indices, hydro/mhd/units flags, and coupling flags
+  auto &indcs = Indcs();
+  int &is = indcs.is, &ie = indcs.ie;
+  int &js = indcs.js, &je = indcs.je;
+  int &ks = indcs.ks, &ke = indcs.ke;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  bool &is_hydro_enabled_ = is_hydro_enabled;
+  bool &is_mhd_enabled_ = is_mhd_enabled;
+  bool &are_units_enabled_ = are_units_enabled;
+  bool &fixed_fluid_ = fixed_fluid;
+  bool &affect_fluid_ = affect_fluid;
+  bool &newton_ = newton_coupling;
+  int &newton_iter_ = newton_iter;
+  Real &newton_tol_ = newton_tol;
+  Real e_floor = m1_e_floor;
+
+  // Extract radiation constant and units
+  Real &arad_ = arad;
+  Real density_scale_ = 1.0, temperature_scale_ = 1.0, length_scale_ = 1.0;
+  Real mean_mol_weight_ = 1.0;
+  Real rosseland_coef_ = 1.0, planck_minus_rosseland_coef_ = 0.0;
+  if (are_units_enabled_) {
+    density_scale_ = pmy_pack->punit->density_cgs();
+    temperature_scale_ = pmy_pack->punit->temperature_cgs();
+    length_scale_ = pmy_pack->punit->length_cgs();
+    mean_mol_weight_ = pmy_pack->punit->mu();
+    rosseland_coef_ = pmy_pack->punit->rosseland_coef_cgs;
+    planck_minus_rosseland_coef_ = pmy_pack->punit->planck_minus_rosseland_coef_cgs;
+  }
+
+  // Extract adiabatic index
+  Real gm1;
+  if (is_hydro_enabled_) {
+    gm1 = pmy_pack->phydro->peos->eos_data.gamma - 1.0;
+  } else if (is_mhd_enabled_) {
+    gm1 = pmy_pack->pmhd->peos->eos_data.gamma - 1.0;
+  }
+
+  // Extract radiation and radiation frame data
+  auto &i0_ = i0;
+  Real &kappa_a_ = kappa_a;
+  Real &kappa_s_ = kappa_s;
+  Real &kappa_p_ = kappa_p;
+  bool &power_opacity_ = power_opacity;
+  auto &norm_to_tet_ = norm_to_tet;
+
+  // Extract hydro/mhd quantities
+  DvceArray5D<Real> u0_, w0_;
+  if (is_hydro_enabled_) {
+    u0_ = pmy_pack->phydro->u0;
+    w0_ = pmy_pack->phydro->w0;
+  } else if (is_mhd_enabled_) {
+    u0_ = pmy_pack->pmhd->u0;
+    w0_ = pmy_pack->pmhd->w0;
+  }
+
+  // Extract timestep
+  Real dt_ = (pdriver->beta[stage-1])*(pmy_pack->pmesh->dt);
+
+  // Call ConsToPrim over active zones (of the fluid) prior to source term application
+  if (!(fixed_fluid_)) {
+    auto &fi = pmy_pack->pmesh->mb_indcs;
+    if (is_hydro_enabled_) {
+      pmy_pack->phydro->peos->ConsToPrim(u0_,w0_,false,fi.is,fi.ie,fi.js,fi.je,
+                                         fi.ks,fi.ke);
+    } else if (is_mhd_enabled_) {
+      auto &b0_ = pmy_pack->pmhd->b0;
+      auto &bcc0_ = pmy_pack->pmhd->bcc0;
+      pmy_pack->pmhd->peos->ConsToPrim(u0_,b0_,w0_,bcc0_,false,fi.is,fi.ie,fi.js,fi.je,
+                                       fi.ks,fi.ke);
+    }
+  }
+
+  // On the coarse radiation grid the fluid is coupled through its state restricted to
+  // that grid, and the change of the fluid is prolongated to its own grid afterwards
+  DvceArray5D<Real> fine_u0_ = u0_;
+  bool coarse_coupling = on_coarse_grid && (is_hydro_enabled_ || is_mhd_enabled_);
+  if (coarse_coupling) {
+    RestrictFluid(w0_);
+    Kokkos::deep_copy(DevExeSpace(), cdu0, 0.0);
+    u0_ = cdu0;
+    w0_ = cw0;
+  }
+
+  // compute implicit source term (spacetime is flat with M1)
+  const int ni   = (ie - is + 1);
+  const int nji  = (je - js + 1)*ni;
+  const int nkji = (ke - ks + 1)*nji;
+  const int nmkji = (nmb1 + 1)*nkji;
+  int nfallback_ = 0, maxit_ = 0;
+  Kokkos::parallel_reduce("m1_source",Kokkos::RangePolicy<>(DevExeSpace(),0,nmkji),
+  KOKKOS_LAMBDA(const int &idx, int &sumf, int &max_it) {
+    int m = (idx)/nkji;
+    int k = (idx - m*nkji)/nji;
+    int j = (idx - m*nkji - k*nji)/ni;
+    int i = (idx - m*nkji - k*nji - j*ni) + is;
+    j += js;
+    k += ks;
+
+    // fluid state
+    Real &wdn = w0_(m,IDN,k,j,i);
+    Real &wvx = w0_(m,IVX,k,j,i);
+    Real &wvy = w0_(m,IVY,k,j,i);
+    Real &wvz = w0_(m,IVZ,k,j,i);
+    Real &wen = w0_(m,IEN,k,j,i);
+    Real tgas = gm1*wen/wdn;
+    Real gamma = sqrt(1.0 + SQR(wvx) + SQR(wvy) + SQR(wvz));
+
+    // compute fluid velocity in tetrad frame
+    Real u_tet[4];
+    for (int d=0; d<4; ++d) {
+      u_tet[d] = (norm_to_tet_(m,d,0,k,j,i)*gamma + norm_to_tet_(m,d,1,k,j,i)*wvx +
+                  norm_to_tet_(m,d,2,k,j,i)*wvy   + norm_to_tet_(m,d,3,k,j,i)*wvz);
+    }
+
+    // set opacities
+    Real sigma_a, sigma_s, sigma_p;
+    OpacityFunction(wdn, density_scale_,
+                    tgas, temperature_scale_,
+                    length_scale_, gm1, mean_mol_weight_,
+                    power_opacity_, rosseland_coef_, planck_minus_rosseland_coef_,
+                    kappa_a_, kappa_s_, kappa_p_,
+                    sigma_a, sigma_s, sigma_p);
+    Real dtau = dt_/u_tet[0];
+    Real dtaue = dtau*(sigma_a + sigma_p);
+    Real dtauf = dtau*(sigma_a + sigma_s);
+
+    // boost radiation stress tensor to comoving frame
+    Real e_old = i0_(m,IRE,k,j,i);
+    Real f_old[3] = {i0_(m,IRF1,k,j,i), i0_(m,IRF2,k,j,i), i0_(m,IRF3,k,j,i)};
+    Real r[4][4], lam[4][4];
+    M1Tensor(e_old, f_old, r);
+    M1Boost(u_tet, false, lam);
+    Real rc0[4] = {0.0};
+    for (int a=0; a<4; ++a) {
+      for (int c=0; c<4; ++c) {
+        for (int d=0; d<4; ++d) {
+          rc0[a] += lam[0][c]*lam[a][d]*r[c][d];
+        }
+      }
+    }
+
+    // Calculate new gas temperature
+    Real coef4 = gm1*dtaue*arad_/(wdn*(1.0 + dtaue));
+    Real tconst = -tgas - gm1*dtaue*rc0[0]/(wdn*(1.0 + dtaue));
+    Real tgasnew = tgas;
+    bool badcell = false;
+    if (fabs(coef4) > 1.0e-20) {
+      bool flag = false;
+      if (newton_) {
+        int iter_used = 0;
+        flag = NewtonPolyRoot(coef4, tconst, newton_iter_, newton_tol_, tgasnew,
+                              iter_used);
+        max_it = (iter_used > max_it) ? iter_used : max_it;
+        if (!(flag)) {sumf++;}
+      }
+      if (!(flag)) {flag = FourthPolyRoot(coef4, tconst, tgasnew);}
+      if (!(flag) || !(isfinite(tgasnew))) {
+        badcell = true;
+      }
+    } else {
+      tgasnew = -tconst;
+    }
+    if (badcell) {return;}
+
+    // change of comoving moments, with isotropic change of comoving pressure
+    Real drc[4][4];
+    for (int a=0; a<4; ++a) {
+      for (int b=0; b<4; ++b) {drc[a][b] = 0.0;}
+    }
+    drc[0][0] = (rc0[0] + dtaue*arad_*SQR(SQR(tgasnew)))/(1.0 + dtaue) - rc0[0];
+    for (int d=1; d<4; ++d) {
+      drc[0][d] = -dtauf*rc0[d]/(1.0 + dtauf);
+      drc[d][0] = drc[0][d];
+      drc[d][d] = drc[0][0]/3.0;
+    }
+
+    // boost change back to tetrad frame and update moments
+    M1Boost(u_tet, true, lam);
+    Real dr0[4] = {0.0};
+    for (int a=0; a<4; ++a) {
+      for (int c=0; c<4; ++c) {
+        for (int d=0; d<4; ++d) {
+          dr0[a] += lam[0][c]*lam[a][d]*drc[c][d];
+        }
+      }
+    }
+    Real e_new = e_old + dr0[0];
+    Real f_new[3] = {f_old[0] + dr0[1], f_old[1] + dr0[2], f_old[2] + dr0[3]};
+    M1Limit(e_floor, e_new, f_new);
+    i0_(m,IRE,k,j,i) = e_new;
+    i0_(m,IRF1,k,j,i) = f_new[0];
+    i0_(m,IRF2,k,j,i) = f_new[1];
+    i0_(m,IRF3,k,j,i) = f_new[2];
+
+    // update conserved fluid variables (R^0_0 = -E and R^0_i = F^i in flat spacetime)
+    if (affect_fluid_) {
+      u0_(m,IEN,k,j,i) += (e_new - e_old);
+      u0_(m,IM1,k,j,i) += (f_old[0] - f_new[0]);
+      u0_(m,IM2,k,j,i) += (f_old[1] - f_new[1]);
+      u0_(m,IM3,k,j,i) += (f_old[2] - f_new[2]);
+    }
+  }, Kokkos::Sum<int>(nfallback_), Kokkos::Max<int>(maxit_));
+  if (coarse_coupling && affect_fluid) {ProlongFluidChange(fine_u0_);}
+
+  // store event counters
+  if (newton_coupling) {
+    pmy_pack->pmesh->ecounter.nrad_fallback += nfallback_;
+    pmy_pack->pmesh->ecounter.maxit_rad = std::max(pmy_pack->pmesh->ecounter.maxit_rad,
+                                                   maxit_);
+  }
 
   return TaskStatus::complete;
 }
@@ -434,4 +726,39 @@ bool FourthPolyRoot(const Real coef4, const Real tconst, Real &root) {
   return true;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn  bool NewtonPolyRoot
+//  \brief Solution for fourth order polynomial of the form coef4 * x^4 + x + tconst = 0
+//  (with coef4 > 0 and tconst < 0) by a fixed number nit of Newton iterations, so that
+//  neighboring threads execute the same instructions.  The initial guess lies above the
+//  unique positive root, where the polynomial is convex, so iterates decrease
+//  monotonically towards it.  Iterations after convergence (to relative tolerance tol)
+//  leave the root unchanged.  Returns false if not converged, iter_used is the number of
+//  iterations needed for convergence.
+
+KOKKOS_INLINE_FUNCTION
+bool NewtonPolyRoot(const Real coef4, const Real tconst, const int nit, const Real tol,
+                    Real &root, int &iter_used) {
+  iter_used = nit;
+  if (!(coef4 > 0.0) || !(tconst < 0.0)) {
+    return false;
+  }
+  Real x = fmin(-tconst, sqrt(sqrt(-tconst/coef4)));
+  bool converged = false;
+  for (int n=0; n<nit; ++n) {
+    Real x3 = x*x*x;
+    Real dx = (coef4*x3*x + x + tconst)/(4.0*coef4*x3 + 1.0);
+    x -= (converged) ? 0.0 : dx;
+    if (!(converged) && fabs(dx) <= tol*x) {
+      converged = true;
+      iter_used = n + 1;
+    }
+  }
+  if (!(converged) || !(isfinite(x)) || x <= 0.0) {
+    return false;
+  }
+  root = x;
+  return true;
+}
+
 } // namespace radiation
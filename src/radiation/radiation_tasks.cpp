@@ -28,6 +28,11 @@ namespace radiation {
 //! \fn  void Radiation::AssembleRadiationTasks
 //! \brief Adds radiation tasks to appropriate task lists used by time integrators.
 //! Called by MeshBlockPack::AddPhysics() function directly after Radiation constructor
+//! With <radiation>/nsubcycle > 1, the fluid is instead advanced over the full timestep
+//! by its own task lists, and radiation transport (including the source terms coupling
+//! it to the fluid, which update the conserved fluid variables in every radiation step)
+//! by nsubcycle steps of the "rad_before_stagen", "rad_stagen", and "rad_after_stagen"
+//! task lists, executed by Driver::ExecuteRadiationSubcycles() after the fluid stages.
 
 void Radiation::AssembleRadTasks(std::map<std::string, std::shared_ptr<TaskList>> tl) {
   TaskID none(0);
@@ -35,7 +40,8 @@ void Radiation::AssembleRadTasks(std::map<std::string, std::shared_ptr<TaskList>
   mhd::MHD *pmhd = pmy_pack->pmhd;
 
   // construct task list depending on enabled physics modules and radiation parameters
-  if (pmhd != nullptr && !(fixed_fluid)) {  // radiation magnetohydrodynamics
+  bool subcycle = (nsubcycle > 1);
+  if (pmhd != nullptr && !(fixed_fluid) && !(subcycle)) {  // radiation MHD
     // assemble "before_stagen" task list
     id.rad_irecv = tl["before_stagen"]->AddTask(&Radiation::InitRecv, this, none);
     id.mhd_irecv = tl["before_stagen"]->AddTask(&mhd::MHD::InitRecv, pmhd, none);
@@ -80,7 +86,7 @@ void Radiation::AssembleRadTasks(std::map<std::string, std::shared_ptr<TaskList>
     id.mhd_crecv = tl["after_stagen"]->AddTask(
                                           &mhd::MHD::ClearRecv, pmhd, id.mhd_csend);
 
-  } else if (phyd != nullptr && !(fixed_fluid)) {  // radiation hydrodynamics
+  } else if (phyd != nullptr && !(fixed_fluid) && !(subcycle)) {  // radiation hydro
     // assemble "before_stagen" task list
     id.rad_irecv = tl["before_stagen"]->AddTask(&Radiation::InitRecv, this, none);
     id.hyd_irecv = tl["before_stagen"]->AddTask(&hydro::Hydro::InitRecv, phyd, none);
@@ -119,30 +125,50 @@ void Radiation::AssembleRadTasks(std::map<std::string, std::shared_ptr<TaskList>
     id.hyd_crecv = tl["after_stagen"]->AddTask(
                                        &hydro::Hydro::ClearRecv, phyd, id.hyd_csend);
 
-  } else {  // radiation transport
+  } else {  // radiation transport, or subcycled radiation (M)HD
+    std::string before = "before_stagen", stagen = "stagen", after = "after_stagen";
+    if (subcycle) {
+      before = "rad_" + before;
+      stagen = "rad_" + stagen;
+      after = "rad_" + after;
+      if (pmhd != nullptr) {
+        pmhd->AssembleMHDTasks(tl);
+      } else {
+        phyd->AssembleHydroTasks(tl);
+      }
+    }
+
     // assemble "before_stagen" task list
-    id.rad_irecv = tl["before_stagen"]->AddTask(&Radiation::InitRecv, this, none);
+    id.rad_irecv = tl[before]->AddTask(&Radiation::InitRecv, this, none);
 
     // assemble "stagen" task list
-    id.copyu     = tl["stagen"]->AddTask(&Radiation::CopyCons, this, none);
-    id.rad_flux  = tl["stagen"]->AddTask(&Radiation::CalculateFluxes, this, id.copyu);
-    id.rad_sendf = tl["stagen"]->AddTask(&Radiation::SendFlux, this, id.rad_flux);
-    id.rad_recvf = tl["stagen"]->AddTask(&Radiation::RecvFlux, this, id.rad_sendf);
-    id.rad_rkupdt= tl["stagen"]->AddTask(&Radiation::RKUpdate, this, id.rad_recvf);
-    id.rad_src   = tl["stagen"]->AddTask(
+    id.copyu     = tl[stagen]->AddTask(&Radiation::CopyCons, this, none);
+    id.rad_flux  = tl[stagen]->AddTask(&Radiation::CalculateFluxes, this, id.copyu);
+    id.rad_sendf = tl[stagen]->AddTask(&Radiation::SendFlux, this, id.rad_flux);
+    id.rad_recvf = tl[stagen]->AddTask(&Radiation::RecvFlux, this, id.rad_sendf);
+    id.rad_rkupdt= tl[stagen]->AddTask(&Radiation::RKUpdate, this, id.rad_recvf);
+    id.rad_src   = tl[stagen]->AddTask(
                                    &Radiation::AddRadiationSourceTerm,this,id.rad_rkupdt);
-    id.rad_resti = tl["stagen"]->AddTask(&Radiation::RestrictI, this, id.rad_src);
-    id.rad_sendi = tl["stagen"]->AddTask(&Radiation::SendI, this, id.rad_resti);
-    id.rad_recvi = tl["stagen"]->AddTask(&Radiation::RecvI, this, id.rad_sendi);
-    id.bcs       = tl["stagen"]->AddTask(
+    id.rad_resti = tl[stagen]->AddTask(&Radiation::RestrictI, this, id.rad_src);
+    id.rad_sendi = tl[stagen]->AddTask(&Radiation::SendI, this, id.rad_resti);
+    id.rad_recvi = tl[stagen]->AddTask(&Radiation::RecvI, this, id.rad_sendi);
+    id.bcs       = tl[stagen]->AddTask(
                                     &Radiation::ApplyPhysicalBCs, this, id.rad_recvi);
-    id.rad_prol  = tl["stagen"]->AddTask(&Radiation::Prolongate, this, id.bcs);
+    id.rad_prol  = tl[stagen]->AddTask(&Radiation::Prolongate, this, id.bcs);
 
     // assemble "after_stagen" task list
-    id.rad_csend = tl["after_stagen"]->AddTask(&Radiation::ClearSend, this, none);
+    id.rad_csend = tl[after]->AddTask(&Radiation::ClearSend, this, none);
     // although RecvFlux/U/E/B functions check that all recvs complete, add ClearRecv to
     // task list anyways to catch potential bugs in MPI communication logic
-    id.rad_crecv = tl["after_stagen"]->AddTask(&Radiation::ClearRecv, this, id.rad_csend);
+    id.rad_crecv = tl[after]->AddTask(&Radiation::ClearRecv, this, id.rad_csend);
+  }
+
+  // with <radiation>/coarsen > 1, move radiation to its coarse grid for each cycle
+  if (coarsen > 1) {
+    id.rad_tocoarse = tl["before_timeintegrator"]->AddTask(
+                                             &Radiation::ToCoarseGrid, this, none);
+    id.rad_tofine   = tl["after_timeintegrator"]->AddTask(
+                                             &Radiation::ToFineGrid, this, none);
   }
 
   return;
@@ -155,14 +181,14 @@ void Radiation::AssembleRadTasks(std::map<std::string, std::shared_ptr<TaskList>
 
 TaskStatus Radiation::InitRecv(Driver *pdrive, int stage) {
   // post receives for I
-  TaskStatus tstat = pbval_i->InitRecv(prgeo->nangles);
+  TaskStatus tstat = pbval_i->InitRecv(nrad);
   if (tstat != TaskStatus::complete) return tstat;
 
   // do not post receives for fluxes when stage < 0 (i.e. ICs)
   if (stage >= 0) {
     // with SMR/AMR, post receives for fluxes of I
     if (pmy_pack->pmesh->multilevel) {
-      tstat = pbval_i->InitFluxRecv(prgeo->nangles);
+      tstat = pbval_i->InitFluxRecv(nrad);
       if (tstat != TaskStatus::complete) return tstat;
     }
   }
@@ -179,7 +205,8 @@ TaskStatus Radiation::CopyCons(Driver *pdrive, int stage) {
     // radiation
     Kokkos::deep_copy(DevExeSpace(), i1, i0);
 
-    // hydro and MHD (if enabled)
+    // hydro and MHD (if enabled, and not advanced by their own task lists)
+    if (nsubcycle > 1) return TaskStatus::complete;
     hydro::Hydro *phyd = pmy_pack->phydro;
     mhd::MHD *pmhd = pmy_pack->pmhd;
     if (pmhd != nullptr) {
@@ -227,8 +254,8 @@ TaskStatus Radiation::RecvFlux(Driver *pdrive, int stage) {
 //! \brief Wrapper task list function to restrict conserved vars
 
 TaskStatus Radiation::RestrictI(Driver *pdrive, int stage) {
-  // Only execute Mesh function with SMR/AMR
-  if (pmy_pack->pmesh->multilevel) {
+  // Only execute Mesh function with SMR/AMR, on ranks with coarse arrays
+  if (pmy_pack->pmesh->multilevel && pmy_pack->pmb->need_coarse) {
     pmy_pack->pmesh->pmr->RestrictCC(i0, coarse_i0);
   }
   return TaskStatus::complete;
@@ -261,16 +288,18 @@ TaskStatus Radiation::ApplyPhysicalBCs(Driver *pdrive, int stage) {
   if (pmy_pack->pmesh->strictly_periodic) return TaskStatus::complete;
 
   // physical BCs on radiation
-  pbval_i->RadiationBCs((pmy_pack), (pbval_i->i_in), i0);
+  pbval_i->RadiationBCs((pmy_pack), (pbval_i->i_in), i0, (pbval_i->pgrid_indcs));
 
-  // physical BCs on (M)HD
+  // physical BCs on (M)HD (applied by ExchangeFluid() when subcycling)
   hydro::Hydro *phyd = pmy_pack->phydro;
   mhd::MHD *pmhd = pmy_pack->pmhd;
-  if (pmhd != nullptr) {
-    pmhd->pbval_u->HydroBCs((pmy_pack), (pmhd->pbval_u->u_in), pmhd->u0);
-    pmhd->pbval_b->BFieldBCs((pmy_pack), (pmhd->pbval_b->b_in), pmhd->b0);
-  } else if (phyd != nullptr) {
-    phyd->pbval_u->HydroBCs((pmy_pack), (phyd->pbval_u->u_in), phyd->u0);
+  if (nsubcycle == 1) {
+    if (pmhd != nullptr) {
+      pmhd->pbval_u->HydroBCs((pmy_pack), (pmhd->pbval_u->u_in), pmhd->u0);
+      pmhd->pbval_b->BFieldBCs((pmy_pack), (pmhd->pbval_b->b_in), pmhd->b0);
+    } else if (phyd != nullptr) {
+      phyd->pbval_u->HydroBCs((pmy_pack), (phyd->pbval_u->u_in), phyd->u0);
+    }
   }
 
   // user BCs
@@ -287,7 +316,8 @@ TaskStatus Radiation::ApplyPhysicalBCs(Driver *pdrive, int stage) {
 //! at fine/coarse bundaries with SMR/AMR
 
 TaskStatus Radiation::Prolongate(Driver *pdrive, int stage) {
-  if (pmy_pack->pmesh->multilevel) {  // only prolongate with SMR/AMR
+  // only prolongate with SMR/AMR, on ranks with coarse arrays
+  if (pmy_pack->pmesh->multilevel && pmy_pack->pmb->need_coarse) {
     // prolongate specific intensity
     pbval_i->FillCoarseInBndryCC(i0, coarse_i0);
     pbval_i->ProlongateCC(i0, coarse_i0);
@@ -338,4 +368,40 @@ TaskStatus Radiation::ClearRecv(Driver *pdrive, int stage) {
   return TaskStatus::complete;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void Radiation::ExchangeFluid
+//! \brief With subcycling, sets ghost zones and primitives of the fluid after the
+//! radiation steps, since the source terms update the conserved fluid variables (in
+//! active zones only).  Called by Driver::ExecuteRadiationSubcycles().
+
+void Radiation::ExchangeFluid(Driver *pdrive) {
+  // following functions return a TaskStatus, but it is ignored so cast to (void)
+  hydro::Hydro *phyd = pmy_pack->phydro;
+  mhd::MHD *pmhd = pmy_pack->pmhd;
+  if (pmhd != nullptr) {
+    (void) pmhd->RestrictU(pdrive, 0);
+    (void) pmhd->InitRecv(pdrive, -1);  // stage < 0 suppresses InitFluxRecv
+    (void) pmhd->SendU(pdrive, 0);
+    (void) pmhd->SendB(pdrive, 0);
+    (void) pmhd->ClearSend(pdrive, -1); // stage = -1 only clear SendU, SendB
+    (void) pmhd->ClearRecv(pdrive, -1); // stage = -1 only clear RecvU, RecvB
+    (void) pmhd->RecvU(pdrive, 0);
+    (void) pmhd->RecvB(pdrive, 0);
+    (void) pmhd->ApplyPhysicalBCs(pdrive, 0);
+    (void) pmhd->Prolongate(pdrive, 0);
+    (void) pmhd->ConToPrim(pdrive, 0);
+  } else if (phyd != nullptr) {
+    (void) phyd->RestrictU(pdrive, 0);
+    (void) phyd->InitRecv(pdrive, -1);  // stage < 0 suppresses InitFluxRecv
+    (void) phyd->SendU(pdrive, 0);
+    (void) phyd->ClearSend(pdrive, -1); // stage = -1 only clear SendU
+    (void) phyd->ClearRecv(pdrive, -1); // stage = -1 only clear RecvU
+    (void) phyd->RecvU(pdrive, 0);
+    (void) phyd->ApplyPhysicalBCs(pdrive, 0);
+    (void) phyd->Prolongate(pdrive, 0);
+    (void) phyd->ConToPrim(pdrive, 0);
+  }
+  return;
+}
+
 } // namespace radiation
@@ -21,11 +21,12 @@
 namespace radiation {
 //----------------------------------------------------------------------------------------
 //! \fn  void Radiation::SetOrthonormalTetrad()
-//! \brief Set orthonormal tetrad data
+//! \brief Set orthonormal tetrad data on the grid currently used by the radiation.  The
+//! tetrad at faces and n^a are only set if faces = true.
 
-void Radiation::SetOrthonormalTetrad() {
-  auto &size = pmy_pack->pmb->mb_size;
-  auto &indcs = pmy_pack->pmesh->mb_indcs;
+void Radiation::SetOrthonormalTetrad(bool faces) {
+  auto &size = Size();
+  auto &indcs = Indcs();
   int &ng = indcs.ng;
   int n1 = indcs.nx1 + 2*ng;
   int n2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*ng) : 1;
@@ -35,8 +36,10 @@ void Radiation::SetOrthonormalTetrad() {
   int &ks = indcs.ks;
   int &nmb = pmy_pack->nmb_thispack;
 
-  int nang1 = prgeo->nangles - 1;
-  auto &num_neighbors_ = prgeo->num_neighbors;
+  // there are no angles with M1
+  int nang1 = (m1_closure)? -1 : (prgeo->nangles - 1);
+  DualArray1D<int> num_neighbors_;
+  if (!(m1_closure)) {num_neighbors_ = prgeo->num_neighbors;}
   auto nh_c_ = nh_c;
 
   auto &coord = pmy_pack->pcoord->coord_data;
@@ -64,10 +67,12 @@ void Radiation::SetOrthonormalTetrad() {
       }
     }
   }
-  nh_c.template modify<HostMemSpace>();
-  nh_c.template sync<DevExeSpace>();
-  nh_f.template modify<HostMemSpace>();
-  nh_f.template sync<DevExeSpace>();
+  if (!(m1_closure)) {
+    nh_c.template modify<HostMemSpace>();
+    nh_c.template sync<DevExeSpace>();
+    nh_f.template modify<HostMemSpace>();
+    nh_f.template sync<DevExeSpace>();
+  }
 
   // set tetrad components
   auto tet_c_ = tet_c;
@@ -100,6 +105,8 @@ void Radiation::SetOrthonormalTetrad() {
     }
   });
 
+  // tetrad components at faces and n^a are recomputed in kernels if recompute_tetrad
+  if (faces && !(recompute_tetrad)) {
   // set tetrad components (subset) at x1f
   auto tet_d1_x1f_ = tet_d1_x1f;
   par_for("tet_d1_x1f",DevExeSpace(),0,(nmb-1),0,(n3-1),0,(n2-1),0,n1,
@@ -202,23 +209,14 @@ void Radiation::SetOrthonormalTetrad() {
       ComputeTetrad(x1v,x2v,x3v,flat,spin,glower,gupper,dgx,dgy,dgz,e,e_cov,omega);
       for (int n=0; n<=nang1; ++n) {
         for (int nb=0; nb<num_neighbors_.d_view(n); ++nb) {
-          Real iszetaf = 1.0/sqrt(1.0 - SQR(nh_f_.d_view(n,nb,3)));
-          Real na1 = 0.0; Real na2 = 0.0;
-          for (int q=0; q<4; ++q) {
-            for (int p=0; p<4; ++p) {
-              Real nhfqp = nh_f_.d_view(n,nb,q)*nh_f_.d_view(n,nb,p);
-              na1 += (nhfqp*(nh_f_.d_view(n,nb,0)*omega[3][q][p] -
-                             nh_f_.d_view(n,nb,3)*omega[0][q][p]));
-              na2 += (nhfqp*(nh_f_.d_view(n,nb,2)*omega[1][q][p] -
-                             nh_f_.d_view(n,nb,1)*omega[2][q][p]));
-            }
-          }
-          na_(m,n,k,j,i,nb) = iszetaf*na1*uflux.d_view(n,nb,0)+na2*uflux.d_view(n,nb,1);
+          na_(m,n,k,j,i,nb) = AngularFluxCoeff(nh_f_, uflux, n, nb, omega);
         }
       }
     });
   }
 
+  }
+
   // set transformation between normal and tetrad frame
   if (is_hydro_enabled || is_mhd_enabled) {
     auto norm_to_tet_ = norm_to_tet;
@@ -11,6 +11,7 @@
 #include <math.h>
 
 #include "athena.hpp"
+#include "coordinates/cartesian_ks.hpp"
 
 // computes covariant and contravariant components of Cartesian tetrad for CKS
 KOKKOS_INLINE_FUNCTION
@@ -180,4 +181,34 @@ void ComputeTetrad(Real x, Real y, Real z, const bool minkowski, const Real a,
   return;
 }
 
+// computes tetrad and Ricci rotation coefficients at a point from the CKS metric, used
+// when tetrad components are recomputed in kernels rather than stored
+KOKKOS_INLINE_FUNCTION
+void ComputeTetradAtPoint(Real x, Real y, Real z, const bool minkowski, const Real a,
+                          Real e[][4], Real ecov[][4], Real omega[][4][4]) {
+  Real g[4][4], gi[4][4];
+  ComputeMetricAndInverse(x, y, z, minkowski, a, g, gi);
+  Real dgx[4][4], dgy[4][4], dgz[4][4];
+  ComputeMetricDerivatives(x, y, z, minkowski, a, dgx, dgy, dgz);
+  ComputeTetrad(x, y, z, minkowski, a, g, gi, dgx, dgy, dgz, e, ecov, omega);
+}
+
+// computes n^a through edge nb of angle n from Ricci rotation coefficients of tetrad
+KOKKOS_INLINE_FUNCTION
+Real AngularFluxCoeff(const DualArray3D<Real> &nh_f, const DualArray3D<Real> &uflux,
+                      const int n, const int nb, const Real omega[][4][4]) {
+  Real iszetaf = 1.0/sqrt(1.0 - SQR(nh_f.d_view(n,nb,3)));
+  Real na1 = 0.0; Real na2 = 0.0;
+  for (int q=0; q<4; ++q) {
+    for (int p=0; p<4; ++p) {
+      Real nhfqp = nh_f.d_view(n,nb,q)*nh_f.d_view(n,nb,p);
+      na1 += (nhfqp*(nh_f.d_view(n,nb,0)*omega[3][q][p] -
+                     nh_f.d_view(n,nb,3)*omega[0][q][p]));
+      na2 += (nhfqp*(nh_f.d_view(n,nb,2)*omega[1][q][p] -
+                     nh_f.d_view(n,nb,1)*omega[2][q][p]));
+    }
+  }
+  return iszetaf*na1*uflux.d_view(n,nb,0) + na2*uflux.d_view(n,nb,1);
+}
+
 #endif // RADIATION_RADIATION_TETRAD_HPP_
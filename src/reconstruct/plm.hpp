@@ -41,9 +41,10 @@ void PLM(const Real &q_im1, const Real &q_i, const Real &q_ip1,
 //! \brief Wrapper function for PLM reconstruction in x1-direction.
 //! This function should be called over [is-1,ie+1] to get BOTH L/R states over [is,ie]
 
+template <typename QArray>
 KOKKOS_INLINE_FUNCTION
 void PiecewiseLinearX1(TeamMember_t const &member, const int m, const int k, const int j,
-     const int il, const int iu, const DvceArray5D<Real> &q,
+     const int il, const int iu, const QArray &q,
      ScrArray2D<Real> &ql, ScrArray2D<Real> &qr) {
   int nvar = q.extent_int(1);
   for (int n=0; n<nvar; ++n) {
@@ -59,9 +60,10 @@ void PiecewiseLinearX1(TeamMember_t const &member, const int m, const int k, con
 //! \brief Wrapper function for PLM reconstruction in x2-direction.
 //! This function should be called over [js-1,je+1] to get BOTH L/R states over [js,je]
 
+template <typename QArray>
 KOKKOS_INLINE_FUNCTION
 void PiecewiseLinearX2(TeamMember_t const &member, const int m, const int k, const int j,
-     const int il, const int iu, const DvceArray5D<Real> &q,
+     const int il, const int iu, const QArray &q,
      ScrArray2D<Real> &ql_jp1, ScrArray2D<Real> &qr_j) {
   int nvar = q.extent_int(1);
   for (int n=0; n<nvar; ++n) {
@@ -77,9 +79,10 @@ void PiecewiseLinearX2(TeamMember_t const &member, const int m, const int k, con
 //! \brief Wrapper function for PLM reconstruction in x3-direction.
 //! This function should be called over [ks-1,ke+1] to get BOTH L/R states over [ks,ke]
 
+template <typename QArray>
 KOKKOS_INLINE_FUNCTION
 void PiecewiseLinearX3(TeamMember_t const &member, const int m, const int k, const int j,
-     const int il, const int iu, const DvceArray5D<Real> &q,
+     const int il, const int iu, const QArray &q,
      ScrArray2D<Real> &ql_kp1, ScrArray2D<Real> &qr_k) {
   int nvar = q.extent_int(1);
   for (int n=0; n<nvar; ++n) {
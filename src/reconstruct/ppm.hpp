@@ -46,8 +46,11 @@ void PPM4(const Real &q_im2, const Real &q_im1, const Real &q_i, const Real &q_i
   //---- Interpolate L/R values (CS eqn 16, PH 3.26 and 3.27) ----
   // qlv = q at left  side of cell-center = q[i-1/2] = a_{j,-} in CS
   // qrv = q at right side of cell-center = q[i+1/2] = a_{j,+} in CS
-  Real qlv = (7.*(q_i + q_im1) - (q_im2 + q_ip1))/12.0;
-  Real qrv = (7.*(q_i + q_ip1) - (q_im1 + q_ip2))/12.0;
+  // division by constants written as multiplication, since compilers only do this for
+  // exact reciprocals (without fast-math) and divisions are expensive on GPUs
+  constexpr Real one_12th = 1.0/12.0;
+  Real qlv = (7.*(q_i + q_im1) - (q_im2 + q_ip1))*one_12th;
+  Real qrv = (7.*(q_i + q_ip1) - (q_im1 + q_ip2))*one_12th;
 
   //---- limit qrv and qlv to neighboring cell-centered values (CS eqn 13) ----
   qlv = fmax(qlv, fmin(q_i, q_im1));
@@ -89,12 +92,15 @@ void PPMX(const Real &q_im2, const Real &q_im1, const Real &q_i, const Real &q_i
   //---- Compute L/R values (CS eqns 12-15, PH 3.26 and 3.27) ----
   // qlv = q at left  side of cell-center = q[i-1/2] = a_{j,-} in CS
   // qrv = q at right side of cell-center = q[i+1/2] = a_{j,+} in CS
-  Real qlv = (7.*(q_i + q_im1) - (q_im2 + q_ip1))/12.0;
-  Real qrv = (7.*(q_i + q_ip1) - (q_im1 + q_ip2))/12.0;
+  // divisions by constants written as multiplications (see PPM4)
+  constexpr Real one_12th = 1.0/12.0;
+  Real qlv = (7.*(q_i + q_im1) - (q_im2 + q_ip1))*one_12th;
+  Real qrv = (7.*(q_i + q_ip1) - (q_im1 + q_ip2))*one_12th;
 
   //---- Apply CS monotonicity limiters to qrv and qlv ----
   // approximate second derivatives at i-1/2 (PH 3.35)
   // KGF: add the off-center quantities first to preserve FP symmetry
+  constexpr Real one_6th = 1.0/6.0;
   Real d2qc = 3.0*((q_im1 + q_i) - 2.0*qlv);
   Real d2ql = (q_im2 + q_i  ) - 2.0*q_im1;
   Real d2qr = (q_im1 + q_ip1) - 2.0*q_i;
@@ -110,7 +116,7 @@ void PPMX(const Real &q_im2, const Real &q_im1, const Real &q_i, const Real &q_i
   }
   // compute limited value for qlv (PH 3.33 and 3.34)
   if (((q_im1 - qlv)*(q_i - qlv)) > 0.0) {
-    qlv = 0.5*(q_i + q_im1) - d2qlim/6.0;
+    qlv = 0.5*(q_i + q_im1) - d2qlim*one_6th;
   }
 
   // approximate second derivatives at i+1/2 (PH 3.35)
@@ -130,7 +136,7 @@ void PPMX(const Real &q_im2, const Real &q_im1, const Real &q_i, const Real &q_i
   }
   // compute limited value for qrv (PH 3.33 and 3.34)
   if (((q_i - qrv)*(q_ip1 - qrv)) > 0.0) {
-    qrv = 0.5*(q_i + q_ip1) - d2qlim/6.0;
+    qrv = 0.5*(q_i + q_ip1) - d2qlim*one_6th;
   }
 
   //---- identify extrema, use smooth extremum limiter ----
@@ -187,11 +193,12 @@ void PPMX(const Real &q_im2, const Real &q_im1, const Real &q_i, const Real &q_i
 //! \brief Wrapper function for PPM reconstruction in x1-direction.
 //! This function should be called over [is-1,ie+1] to get BOTH L/R states over [is,ie]
 
+template <typename QArray>
 KOKKOS_INLINE_FUNCTION
 void PiecewiseParabolicX1(TeamMember_t const &member,
      const EOS_Data &eos, const bool extremum_preserving, const bool apply_floors,
      const int m, const int k, const int j, const int il, const int iu,
-     const DvceArray5D<Real> &q, ScrArray2D<Real> &ql, ScrArray2D<Real> &qr) {
+     const QArray &q, ScrArray2D<Real> &ql, ScrArray2D<Real> &qr) {
   int nvar = q.extent_int(1);
   const Real &dfloor_ = eos.dfloor;
   // TODO(jmstone): ideal gas only for now
@@ -235,11 +242,12 @@ void PiecewiseParabolicX1(TeamMember_t const &member,
 //! \brief Wrapper function for PPM reconstruction in x2-direction.
 //! This function should be called over [js-1,je+1] to get BOTH L/R states over [js,je]
 
+template <typename QArray>
 KOKKOS_INLINE_FUNCTION
 void PiecewiseParabolicX2(TeamMember_t const &member,
      const EOS_Data &eos, const bool extremum_preserving, const bool apply_floors,
      const int m, const int k, const int j, const int il, const int iu,
-     const DvceArray5D<Real> &q, ScrArray2D<Real> &ql_jp1, ScrArray2D<Real> &qr_j) {
+     const QArray &q, ScrArray2D<Real> &ql_jp1, ScrArray2D<Real> &qr_j) {
   int nvar = q.extent_int(1);
   const Real &dfloor_ = eos.dfloor;
   // TODO(jmstone): ideal gas only for now
@@ -283,11 +291,12 @@ void PiecewiseParabolicX2(TeamMember_t const &member,
 //! \brief Wrapper function for PPM reconstruction in x3-direction.
 //! This function should be called over [ks-1,ke+1] to get BOTH L/R states over [ks,ke]
 
+template <typename QArray>
 KOKKOS_INLINE_FUNCTION
 void PiecewiseParabolicX3(TeamMember_t const &member,
      const EOS_Data &eos, const bool extremum_preserving, const bool apply_floors,
      const int m, const int k, const int j, const int il, const int iu,
-     const DvceArray5D<Real> &q, ScrArray2D<Real> &ql_kp1, ScrArray2D<Real> &qr_k) {
+     const QArray &q, ScrArray2D<Real> &ql_kp1, ScrArray2D<Real> &qr_k) {
   int nvar = q.extent_int(1);
   const Real &dfloor_ = eos.dfloor;
   // TODO(jmstone): ideal gas only for now
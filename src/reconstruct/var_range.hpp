@@ -0,0 +1,35 @@
+#ifndef RECONSTRUCT_VAR_RANGE_HPP_
+#define RECONSTRUCT_VAR_RANGE_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file var_range.hpp
+//! \brief view of a contiguous range of variables [n0,n0+nvar) of a 5D array, which can
+//! be passed as QArray to the reconstruction functions so that only those variables are
+//! reconstructed (into rows [0,nvar) of the scratch arrays).
+
+#include "athena.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \struct VarRange
+//! \brief Wraps array q(m,n,k,j,i) so that variable n of the range is q(m,n0+n,k,j,i)
+
+template <typename QArray>
+struct VarRange {
+  QArray q;
+  int n0, nvar;
+  VarRange(const QArray &q_in, const int n0_in, const int nvar_in) :
+    q(q_in), n0(n0_in), nvar(nvar_in) {}
+
+  KOKKOS_INLINE_FUNCTION
+  int extent_int(const int d) const {return (d == 1)? nvar : q.extent_int(d);}
+  KOKKOS_INLINE_FUNCTION
+  typename QArray::reference_type operator()(const int m, const int n, const int k,
+                                             const int j, const int i) const {
+    return q(m,n0+n,k,j,i);
+  }
+};
+
+#endif // RECONSTRUCT_VAR_RANGE_HPP_
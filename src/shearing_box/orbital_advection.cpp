@@ -44,7 +44,7 @@ OrbitalAdvection::OrbitalAdvection(MeshBlockPack *ppack, ParameterInput *pin) :
     }
   }
   // create unique communicators for shearing box
-  MPI_Comm_dup(MPI_COMM_WORLD, &comm_orb_advect);
+  MPI_Comm_dup(global_variable::mpi_comm, &comm_orb_advect);
 #endif
 }
 
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "athena.hpp"
+#include "globals.hpp"
 #include "parameter_input.hpp"
 #include "mesh/mesh.hpp"
 #include "shearing_box.hpp"
@@ -22,6 +23,7 @@
 ShearingBoxBoundary::ShearingBoxBoundary(MeshBlockPack *ppack, ParameterInput *pin) :
     nmb_x1bndry("nmbx1",2),
     x1bndry_mbgid("x1gid",1,1),
+    x2column_gid("x2colgid",1,1),
     pmy_pack(ppack) {
   // Create vector with GID of every MBs on this rank at ix1/ox1 shearing-box boundaries
   std::vector<int> tmp_ix1bndry_gid, tmp_ox1bndry_gid;
@@ -57,6 +59,28 @@ ShearingBoxBoundary::ShearingBoxBoundary(MeshBlockPack *ppack, ParameterInput *p
   x1bndry_mbgid.template modify<HostMemSpace>();
   x1bndry_mbgid.template sync<DevExeSpace>();
 
+  // Store GIDs of all MBs in the x2-column of each MB at x1 boundaries (indexed by lx2),
+  // so that targets offset by the shear are found without searching the MeshBlockTree
+  // every stage
+  Mesh *pm = ppack->pmesh;
+  int nmbx2 = 1;
+  for (int m=0; m<(ppack->nmb_thispack); ++m) {
+    int level = pm->lloc_eachmb[m + ppack->gids].level;
+    nmbx2 = std::max(nmbx2, pm->nmb_rootx2 << (level - pm->root_level));
+  }
+  Kokkos::realloc(x2column_gid, std::max(1,ppack->nmb_thispack), nmbx2);
+  for (int n=0; n<2; ++n) {
+    for (int m=0; m<nmb_x1bndry(n); ++m) {
+      int gid = x1bndry_mbgid.h_view(n,m);
+      LogicalLocation lloc = pm->lloc_eachmb[gid];
+      std::int32_t ncol = pm->nmb_rootx2 << (lloc.level - pm->root_level);
+      for (lloc.lx2=0; lloc.lx2<ncol; ++lloc.lx2) {
+        x2column_gid(gid - ppack->gids, lloc.lx2) = (pm->ptree->FindMeshBlock(lloc))
+                                                    ->GetGID();
+      }
+    }
+  }
+
 
 #if MPI_PARALLEL_ENABLED
   // initialize vectors of MPI requests for ix1/ox1 boundaries in fixed length arrays
@@ -65,7 +89,7 @@ ShearingBoxBoundary::ShearingBoxBoundary(MeshBlockPack *ppack, ParameterInput *p
     if (nmb_x1bndry(n) > 0) {
       sendbuf[n].vars_req = new MPI_Request[3*nmb_x1bndry(n)];
       recvbuf[n].vars_req = new MPI_Request[3*nmb_x1bndry(n)];
-      for (int m=0; m<nmb_x1bndry(0); ++m) {
+      for (int m=0; m<nmb_x1bndry(n); ++m) {
         for (int l=0; l<3; ++l) {
           sendbuf[n].vars_req[3*m + l] = MPI_REQUEST_NULL;
           recvbuf[n].vars_req[3*m + l] = MPI_REQUEST_NULL;
@@ -74,7 +98,7 @@ ShearingBoxBoundary::ShearingBoxBoundary(MeshBlockPack *ppack, ParameterInput *p
     }
   }
   // create unique communicators for shearing box
-  MPI_Comm_dup(MPI_COMM_WORLD, &comm_sbox);
+  MPI_Comm_dup(global_variable::mpi_comm, &comm_sbox);
 #endif
 }
 
@@ -94,19 +118,20 @@ ShearingBoxBoundary::~ShearingBoxBoundary() {
 
 //----------------------------------------------------------------------------------------
 //! \fn void ShearingBoxBoundary::FindTargetMB()
-//! \brief  function to find target MB offset by shear.  Returns GID and rank
+//! \brief  function to find target MB offset by shear.  Returns GID and rank.  Input MB
+//! must be on this rank and touch an x1 boundary, target is looked up in x2column_gid.
 
 void ShearingBoxBoundary::FindTargetMB(const int igid, const int jshift, int &gid,
                                        int &rank) {
   Mesh *pm = pmy_pack->pmesh;
   // find lloc of input MB
-  LogicalLocation lloc = pm->lloc_eachmb[igid];
+  const LogicalLocation &lloc = pm->lloc_eachmb[igid];
   // find number of MBs in x2 direction at this level
   std::int32_t nmbx2 = pm->nmb_rootx2 << (lloc.level - pm->root_level);
-  // apply shift by input number of blocks
-  lloc.lx2 = static_cast<std::int32_t>((lloc.lx2 + jshift) % nmbx2);
+  // apply (periodic) shift by input number of blocks
+  int lx2 = static_cast<int>(((lloc.lx2 + jshift) % nmbx2 + nmbx2) % nmbx2);
   // find target GID and rank
-  gid = (pm->ptree->FindMeshBlock(lloc))->GetGID();
+  gid = x2column_gid(igid - pmy_pack->gids, lx2);
   rank = pm->rank_eachmb[gid];
   return;
 }
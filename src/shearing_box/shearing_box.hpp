@@ -10,6 +10,8 @@
 //! Both OrbitalAdvection and ShearingBox are abstract base classes that are used to
 //! define derived classes for CC and FC variables.
 
+#include <vector>
+
 #include "athena.hpp"
 #include "parameter_input.hpp"
 #include "tasklist/task_list.hpp"
@@ -69,6 +71,10 @@ class OrbitalAdvection {
   TaskStatus InitRecv();
   TaskStatus ClearRecv();
   TaskStatus ClearSend();
+#if MPI_PARALLEL_ENABLED
+  // collect pointers to all outstanding receives (used by event-driven task scheduler)
+  void GetPendingRecvs(std::vector<MPI_Request*> &reqs);
+#endif
 
  protected:
   // must use pointer to MBPack and not parent physics module since parent can be one of
@@ -112,6 +118,7 @@ class ShearingBoxBoundary {
   // data
   HostArray1D<int> nmb_x1bndry;    // number of MBs that touch x1 boundaries
   DualArray2D<int> x1bndry_mbgid;  // GIDs of MBs at x1 boundaries
+  HostArray2D<int> x2column_gid;   // GIDs of MBs in x2-column of each MB at x1 bndry
   Real yshear;                     // x2-distance x1-boundaries have sheared
 
   // data buffers for shearing box BCs.  Only two x1-faces get sheared
@@ -127,6 +134,10 @@ class ShearingBoxBoundary {
   TaskStatus InitRecv(Real qom, Real time);
   TaskStatus ClearRecv();
   TaskStatus ClearSend();
+#if MPI_PARALLEL_ENABLED
+  // collect pointers to all outstanding receives (used by event-driven task scheduler)
+  void GetPendingRecvs(std::vector<MPI_Request*> &reqs);
+#endif
   // function to find target MB offset by shear.  Returns GID and rank
   void FindTargetMB(const int igid, const int jshift, int &gid, int &rank);
   // function to find index in x1bndry array of MB with input GID
@@ -11,6 +11,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <utility>
+#include <vector>
 
 #include "athena.hpp"
 #include "globals.hpp"
@@ -418,3 +419,38 @@ TaskStatus ShearingBoxBoundary::ClearSend() {
 #endif
   return TaskStatus::complete;
 }
+
+#if MPI_PARALLEL_ENABLED
+//----------------------------------------------------------------------------------------
+//! \fn  void OrbitalAdvection::GetPendingRecvs
+//! \brief Appends pointers to all outstanding non-blocking receives to input vector.
+//! Used by the event-driven task scheduler.
+
+void OrbitalAdvection::GetPendingRecvs(std::vector<MPI_Request*> &reqs) {
+  int &nmb = pmy_pack->nmb_thispack;
+  for (int n=0; n<2; ++n) {
+    for (int m=0; m<nmb; ++m) {
+      if (recvbuf[n].vars_req[m] != MPI_REQUEST_NULL) {
+        reqs.push_back(&(recvbuf[n].vars_req[m]));
+      }
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  void ShearingBoxBoundary::GetPendingRecvs
+//! \brief Appends pointers to all outstanding non-blocking receives to input vector.
+//! Used by the event-driven task scheduler.
+
+void ShearingBoxBoundary::GetPendingRecvs(std::vector<MPI_Request*> &reqs) {
+  for (int n=0; n<2; ++n) {
+    for (int m=0; m<3*nmb_x1bndry(n); ++m) {
+      if (recvbuf[n].vars_req[m] != MPI_REQUEST_NULL) {
+        reqs.push_back(&(recvbuf[n].vars_req[m]));
+      }
+    }
+  }
+  return;
+}
+#endif
@@ -10,6 +10,7 @@
 
 #include "srcterms.hpp"
 
+#include <cfloat>
 #include <iostream>
 #include <string> // string
 
@@ -50,6 +51,18 @@ SourceTerms::SourceTerms(std::string block, MeshBlockPack *pp, ParameterInput *p
   ism_cooling = pin->GetOrAddBoolean(block, "ism_cooling", false);
   if (ism_cooling) {
     hrate = pin->GetReal(block, "hrate");
+    // optionally sub-cycle cooling in each cell, so cooling does not limit timestep
+    ism_cooling_subcycle = pin->GetOrAddBoolean(block, "ism_cooling_subcycle", false);
+    if (ism_cooling_subcycle) {
+      cfl_cool = pin->GetOrAddReal(block, "cfl_cool", 0.1);
+      nsub_cool_max = pin->GetOrAddInteger(block, "nsub_cool_max", 1000);
+      if (cfl_cool <= 0.0 || cfl_cool >= 1.0 || nsub_cool_max < 1) {
+        std::cout << "### FATAL ERROR in "<< __FILE__ <<" at line " << __LINE__
+                  << std::endl << "cfl_cool must be in (0,1) and nsub_cool_max > 0"
+                  << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+    }
   }
 
   // (3) beam source (radiation)
@@ -73,6 +86,39 @@ SourceTerms::SourceTerms(std::string block, MeshBlockPack *pp, ParameterInput *p
   } else {
     shearing_box = false;
   }
+
+  // (6) optionally add terms above (except beam, and sub-cycled ISM cooling) in RK update
+  // kernel, avoiding a separate read-modify-write of u0 for each
+  if (pin->GetOrAddBoolean(block, "fused_srcterms", false)) {
+    fsrc.const_accel = const_accel;
+    if (const_accel) {
+      fsrc.accel_dir = const_accel_dir;
+      fsrc.accel_g = const_accel_val;
+    }
+    fsrc.ism_cooling = ism_cooling && !(ism_cooling_subcycle);
+    if (fsrc.ism_cooling) {
+      Real n_unit = pp->punit->density_cgs()/pp->punit->mu()
+                    /pp->punit->atomic_mass_unit_cgs;
+      fsrc.temp_unit = pp->punit->temperature_cgs();
+      fsrc.cooling_unit = pp->punit->pressure_cgs()/pp->punit->time_cgs()/n_unit/n_unit;
+      fsrc.gamma_heating = hrate/(pp->punit->pressure_cgs()/pp->punit->time_cgs()/n_unit);
+    }
+    fsrc.rel_cooling = rel_cooling;
+    if (rel_cooling) {
+      fsrc.crate = crate_rel;
+      fsrc.cpower = cpower_rel;
+    }
+    fsrc.sbox = shearing_box;
+    if (shearing_box) {
+      fsrc.omega0 = omega0;
+      fsrc.qshear = qshear;
+      bool r_phi = (shearing_box_r_phi || pp->pmesh->three_d);
+      fsrc.sbox_iv = (r_phi)? IVY : IVZ;
+      fsrc.sbox_ib = (r_phi)? IBY : IBZ;
+    }
+    fsrc.enabled = (fsrc.const_accel || fsrc.ism_cooling || fsrc.rel_cooling ||
+                    fsrc.sbox);
+  }
 }
 
 //----------------------------------------------------------------------------------------
@@ -110,6 +156,10 @@ void SourceTerms::ConstantAccel(const DvceArray5D<Real> &w0, const EOS_Data &eos
 //----------------------------------------------------------------------------------------
 //! \fn void SourceTerms::ISMCooling()
 //! \brief Add explict ISM cooling and heating source terms in the energy equations.
+//! With ism_cooling_subcycle, the internal energy in each cell is instead integrated
+//! over bdt with its own substeps of at most cfl_cool times the local cooling time, at
+//! fixed density.  At most nsub_cool_max substeps are taken; if that limit forces longer
+//! substeps, the energy lost in each is limited to a fraction cfl_cool.
 // NOTE source terms must be computed using primitive (w0) and NOT conserved (u0) vars
 
 void SourceTerms::ISMCooling(const DvceArray5D<Real> &w0, const EOS_Data &eos_data,
@@ -130,6 +180,37 @@ void SourceTerms::ISMCooling(const DvceArray5D<Real> &w0, const EOS_Data &eos_da
                       /n_unit/n_unit;
   Real heating_unit = pmy_pack->punit->pressure_cgs()/pmy_pack->punit->time_cgs()/n_unit;
 
+  if (ism_cooling_subcycle) {
+    Real cfl = cfl_cool;
+    int nsub_max = nsub_cool_max;
+    par_for("cooling_sub", DevExeSpace(), 0, nmb1, ks, ke, js, je, is, ie,
+    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+      Real dens = w0(m,IDN,k,j,i);
+      Real eint;
+      if (use_e) {
+        eint = w0(m,IEN,k,j,i);
+      } else {
+        eint = w0(m,ITM,k,j,i)*dens/gm1;
+      }
+      Real eint0 = eint;
+      Real gamma_heating = heating_rate/heating_unit;
+
+      Real t = 0.0;
+      for (int n=0; n<nsub_max && t<bdt; ++n) {
+        Real temp = temp_unit*gm1*eint/dens;
+        Real edot = -dens*(dens*ISMCoolFn(temp)/cooling_unit - gamma_heating);
+        // substep limited by cooling time, and by number of substeps remaining
+        Real h = cfl*eint/(fabs(edot) + FLT_MIN);
+        h = fmax(h, (bdt - t)/static_cast<Real>(nsub_max - n));
+        h = fmin(h, bdt - t);
+        eint = fmax(eint + h*edot, (1.0 - cfl)*eint);
+        t += h;
+      }
+      u0(m,IEN,k,j,i) += eint - eint0;
+    });
+    return;
+  }
+
   par_for("cooling", DevExeSpace(), 0, nmb1, ks, ke, js, je, is, ie,
   KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
     // temperature in cgs unit
@@ -199,12 +280,13 @@ void SourceTerms::RelCooling(const DvceArray5D<Real> &w0, const EOS_Data &eos_da
 // \brief Add beam of radiation
 
 void SourceTerms::BeamSource(DvceArray5D<Real> &i0, const Real bdt) {
+  auto prad = pmy_pack->prad;
+  if (prad->beam_version != pmy_pack->pmb->nghbr_version) {prad->BuildBeamList();}
   auto &indcs = pmy_pack->pmesh->mb_indcs;
-  int is = indcs.is, ie = indcs.ie;
-  int js = indcs.js, je = indcs.je;
-  int ks = indcs.ks, ke = indcs.ke;
+  int ncells1 = indcs.nx1 + 2*(indcs.ng);
+  int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
+  int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
   int nmb1 = (pmy_pack->nmb_thispack-1);
-  int nang1 = (pmy_pack->prad->prgeo->nangles-1);
 
   auto &nh_c_ = pmy_pack->prad->nh_c;
   auto &tt = pmy_pack->prad->tet_c;
@@ -214,11 +296,18 @@ void SourceTerms::BeamSource(DvceArray5D<Real> &i0, const Real bdt) {
   auto &rad_mask_ = pmy_pack->pcoord->excision_floor;
   Real &n_0_floor_ = pmy_pack->prad->n_0_floor;
 
-  auto &beam_mask_ = pmy_pack->prad->beam_mask;
+  auto &offset = prad->beam_offset;
+  auto &bidx = prad->beam_idx;
   Real &dii_dt_ = dii_dt;
-  par_for("beam_source",DevExeSpace(),0,nmb1,0,nang1,ks,ke,js,je,is,ie,
-  KOKKOS_LAMBDA(int m, int n, int k, int j, int i) {
-    if (beam_mask_(m,n,k,j,i)) {
+  par_for_outer("beam_source",DevExeSpace(),0,0,0,nmb1,
+  KOKKOS_LAMBDA(TeamMember_t member, const int m) {
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(member, offset(m), offset(m+1)),
+    [&](const int l) {
+      int idx = bidx(l);
+      int n = idx/(ncells3*ncells2*ncells1);
+      int k = (idx - n*ncells3*ncells2*ncells1)/(ncells2*ncells1);
+      int j = (idx - (n*ncells3 + k)*ncells2*ncells1)/ncells1;
+      int i = idx - ((n*ncells3 + k)*ncells2 + j)*ncells1;
       Real n0 = tt(m,0,0,k,j,i);
       Real n_0 = tc(m,0,0,k,j,i)*nh_c_.d_view(n,0) + tc(m,1,0,k,j,i)*nh_c_.d_view(n,1)
                + tc(m,2,0,k,j,i)*nh_c_.d_view(n,2) + tc(m,3,0,k,j,i)*nh_c_.d_view(n,3);
@@ -230,7 +319,7 @@ void SourceTerms::BeamSource(DvceArray5D<Real> &i0, const Real bdt) {
       if (excise) {
         if (rad_mask_(m,k,j,i) || fabs(n_0) < n_0_floor_) { i0(m,n,k,j,i) = 0.0; }
       }
-    }
+    });
   });
 
   return;
@@ -11,6 +11,10 @@
 //!  (1) constant (gravitational) acceleration - for RTI
 //!  (2) shearing box in 2D (x-z), for both hydro and MHD
 //!  (3) random forcing to drive turbulence - implemented in TurbulenceDriver class
+//!
+//! With <hydro|mhd>/fused_srcterms = true, constant acceleration, (non-subcycled) ISM
+//! cooling, relativistic cooling and shearing box terms are instead added to u0 inside
+//! the RK update kernel, using the FusedSrcTerms struct, rather than in separate passes.
 
 #include <map>
 #include <string>
@@ -18,11 +22,68 @@
 #include "athena.hpp"
 #include "mesh/mesh.hpp"
 #include "parameter_input.hpp"
+#include "eos/eos.hpp"
+#include "ismcooling.hpp"
 
 // forward declarations
 class TurbulenceDriver;
 class Driver;
 
+//----------------------------------------------------------------------------------------
+//! \struct FusedSrcTerms
+//! \brief flags and coefficients of the source terms which are added in the RK update
+//! kernel, assembled once by the SourceTerms constructor.  Increment() returns the change
+//! in conserved variable n over bdt, computed from the primitives (and cell-centered
+//! fields in MHD) exactly as in the separate source term functions.
+
+struct FusedSrcTerms {
+  bool enabled = false;      // any term is fused
+  bool const_accel = false, ism_cooling = false, rel_cooling = false, sbox = false;
+  int accel_dir = 1;
+  Real accel_g = 0.0;
+  Real temp_unit = 1.0, cooling_unit = 1.0, gamma_heating = 0.0;
+  Real crate = 0.0, cpower = 1.0;
+  Real omega0 = 0.0, qshear = 0.0;
+  int sbox_iv = IVY, sbox_ib = IBY;   // azimuthal velocity and field (y or z)
+
+  KOKKOS_INLINE_FUNCTION
+  Real Increment(const DvceArray5D<Real> &w0, const DvceArray5D<Real> &bcc0,
+                 const bool mhd, const EOS_Data &eos, const Real bdt,
+                 const int m, const int n, const int k, const int j, const int i) const {
+    if (n == IDN || n > IEN || (n == IEN && !(eos.is_ideal))) return 0.0;
+    const Real den = w0(m,IDN,k,j,i);
+    Real src = 0.0;
+    if (const_accel) {
+      if (n == accel_dir) {src += bdt*accel_g*den;}
+      if (n == IEN) {src += bdt*accel_g*den*w0(m,accel_dir,k,j,i);}
+    }
+    if (ism_cooling && n == IEN) {
+      Real temp = (eos.use_e)? temp_unit*w0(m,IEN,k,j,i)/den*(eos.gamma - 1.0) :
+                               temp_unit*w0(m,ITM,k,j,i);
+      src -= bdt*den*(den*ISMCoolFn(temp)/cooling_unit - gamma_heating);
+    }
+    if (rel_cooling) {
+      Real temp = (eos.use_e)? w0(m,IEN,k,j,i)/den*(eos.gamma - 1.0) : w0(m,ITM,k,j,i);
+      Real ux = w0(m,IVX,k,j,i), uy = w0(m,IVY,k,j,i), uz = w0(m,IVZ,k,j,i);
+      Real u = (n == IEN)? sqrt(1.0 + ux*ux + uy*uy + uz*uz) : w0(m,n,k,j,i);
+      src -= bdt*den*u*pow((temp*crate), cpower);
+    }
+    if (sbox) {
+      Real mom1 = den*w0(m,IVX,k,j,i);
+      Real momp = den*w0(m,sbox_iv,k,j,i);
+      if (n == IM1) {
+        src += 2.0*bdt*omega0*momp;
+      } else if (n == sbox_iv) {
+        src -= (2.0 - qshear)*bdt*omega0*mom1;
+      } else if (n == IEN) {
+        Real bb = (mhd)? bcc0(m,IBX,k,j,i)*bcc0(m,sbox_ib,k,j,i) : 0.0;
+        src += bdt*(mom1*momp/den - bb)*qshear*omega0;
+      }
+    }
+    return src;
+  }
+};
+
 //----------------------------------------------------------------------------------------
 //! \class SourceTerms
 //! \brief data and functions for physical source terms
@@ -49,6 +110,10 @@ class SourceTerms {
 
   // heating rate used with ISM cooling
   Real hrate;
+  // sub-cycling of ISM cooling: max substep in units of cooling time, max # of substeps
+  bool ism_cooling_subcycle = false;
+  Real cfl_cool;
+  int nsub_cool_max;
 
   // cooling rate used with relativistic cooling
   Real crate_rel;
@@ -60,6 +125,9 @@ class SourceTerms {
   // shearing box
   Real qshear, omega0;
 
+  // terms added in RK update kernel when <block>/fused_srcterms = true
+  FusedSrcTerms fsrc;
+
   // functions
   void ConstantAccel(const DvceArray5D<Real> &w0, const EOS_Data &eos,
                      const Real dt, DvceArray5D<Real> &u0);
@@ -10,8 +10,10 @@
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <string>
 
 #include "athena.hpp"
+#include "globals.hpp"
 #include "parameter_input.hpp"
 #include "coordinates/cell_locations.hpp"
 #include "mesh/mesh.hpp"
@@ -39,8 +41,9 @@ TurbulenceDriver::TurbulenceDriver(MeshBlockPack *pp, ParameterInput *pin) :
   zccc("zccc",1),zccs("zccs",1),zcsc("zcsc",1),zcss("zcss",1),
   zscc("zscc",1),zscs("zscs",1),zssc("zssc",1),zsss("zsss",1),
   kx_mode("kx_mode",1),ky_mode("ky_mode",1),kz_mode("kz_mode",1),
-  xcos("xcos",1,1,1),xsin("xsin",1,1,1),ycos("ycos",1,1,1),
-  ysin("ysin",1,1,1),zcos("zcos",1,1,1),zsin("zsin",1,1,1) {
+  xbasis("xbasis",1,1,1),ybasis("ybasis",1,1,1),zbasis("zbasis",1,1,1),
+  amp("amp",1,1),
+  fx_sum("fx_sum",1,1,1,1,1),fxy_sum("fxy_sum",1,1,1,1,1) {
   // allocate memory for force registers
   int nmb = pmy_pack->nmb_thispack;
   auto &indcs = pmy_pack->pmesh->mb_indcs;
@@ -64,6 +67,18 @@ TurbulenceDriver::TurbulenceDriver(MeshBlockPack *pp, ParameterInput *pin) :
   dedt = pin->GetOrAddReal("turb_driving", "dedt", 0.0);
   // correlation time
   tcorr = pin->GetOrAddReal("turb_driving", "tcorr", 0.0);
+  // random numbers from Ran2 (sequential) or Philox (counter-based) generator
+  std::string rng = pin->GetOrAddString("turb_driving", "rng", "ran2");
+  if (rng.compare("philox") == 0) {
+    use_philox = true;
+  } else if (rng.compare("ran2") == 0) {
+    use_philox = false;
+  } else {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__ << std::endl
+              << "<turb_driving> rng = '" << rng << "' not implemented" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  rng_seed = static_cast<uint64_t>(pin->GetOrAddInteger("turb_driving", "rng_seed", 1));
 
   Real nlow_sqr = nlow*nlow;
   Real nhigh_sqr = nhigh*nhigh;
@@ -127,12 +142,13 @@ TurbulenceDriver::TurbulenceDriver(MeshBlockPack *pp, ParameterInput *pin) :
   Kokkos::realloc(ky_mode, mode_count);
   Kokkos::realloc(kz_mode, mode_count);
 
-  Kokkos::realloc(xcos, nmb, mode_count, ncells1);
-  Kokkos::realloc(xsin, nmb, mode_count, ncells1);
-  Kokkos::realloc(ycos, nmb, mode_count, ncells2);
-  Kokkos::realloc(ysin, nmb, mode_count, ncells2);
-  Kokkos::realloc(zcos, nmb, mode_count, ncells3);
-  Kokkos::realloc(zsin, nmb, mode_count, ncells3);
+  nbasis = 2*(nhigh + 1);
+  Kokkos::realloc(xbasis, nmb, nbasis, ncells1);
+  Kokkos::realloc(ybasis, nmb, nbasis, ncells2);
+  Kokkos::realloc(zbasis, nmb, nbasis, ncells3);
+  Kokkos::realloc(amp, 3, nbasis*nbasis*nbasis);
+  Kokkos::realloc(fx_sum, nmb, 3, nbasis, nbasis, ncells1);
+  Kokkos::realloc(fxy_sum, nmb, 3, nbasis, ncells2, ncells1);
 
   Initialize();
 }
@@ -174,12 +190,9 @@ void TurbulenceDriver::Initialize() {
   auto ky_mode_ = ky_mode;
   auto kz_mode_ = kz_mode;
 
-  auto xcos_ = xcos;
-  auto xsin_ = xsin;
-  auto ycos_ = ycos;
-  auto ysin_ = ysin;
-  auto zcos_ = zcos;
-  auto zsin_ = zsin;
+  auto xbasis_ = xbasis;
+  auto ybasis_ = ybasis;
+  auto zbasis_ = zbasis;
 
   Real dkx, dky, dkz, kx, ky, kz;
   Real lx = pm->mesh_size.x1max - pm->mesh_size.x1min;
@@ -233,41 +246,41 @@ void TurbulenceDriver::Initialize() {
 
   auto &size = pmy_pack->pmb->mb_size;
 
-  par_for("xsin/xcos", DevExeSpace(),0,nmb-1,0,mode_count-1,is,ie,
+  par_for("xbasis", DevExeSpace(),0,nmb-1,0,nhigh,is,ie,
   KOKKOS_LAMBDA(int m, int n, int i) {
     Real &x1min = size.d_view(m).x1min;
     Real &x1max = size.d_view(m).x1max;
     Real x1v = CellCenterX(i-is, nx1, x1min, x1max);
-    Real k1v = kx_mode_.d_view(n);
-    xsin_(m,n,i) = sin(k1v*x1v);
-    xcos_(m,n,i) = cos(k1v*x1v);
+    Real k1v = dkx*n;
+    xbasis_(m,2*n  ,i) = cos(k1v*x1v);
+    xbasis_(m,2*n+1,i) = sin(k1v*x1v);
   });
 
-  par_for("ysin/ycos", DevExeSpace(),0,nmb-1,0,mode_count-1,js,je,
+  par_for("ybasis", DevExeSpace(),0,nmb-1,0,nhigh,js,je,
   KOKKOS_LAMBDA(int m, int n, int j) {
     Real &x2min = size.d_view(m).x2min;
     Real &x2max = size.d_view(m).x2max;
     Real x2v = CellCenterX(j-js, nx2, x2min, x2max);
-    Real k2v = ky_mode_.d_view(n);
-    ysin_(m,n,j) = sin(k2v*x2v);
-    ycos_(m,n,j) = cos(k2v*x2v);
+    Real k2v = dky*n;
+    ybasis_(m,2*n  ,j) = cos(k2v*x2v);
+    ybasis_(m,2*n+1,j) = sin(k2v*x2v);
     if (ncells2-1 == 0) {
-      ysin_(m,n,j) = 0.0;
-      ycos_(m,n,j) = 1.0;
+      ybasis_(m,2*n  ,j) = 1.0;
+      ybasis_(m,2*n+1,j) = 0.0;
     }
   });
 
-  par_for("zsin/zcos", DevExeSpace(),0,nmb-1,0,mode_count-1,ks,ke,
+  par_for("zbasis", DevExeSpace(),0,nmb-1,0,nhigh,ks,ke,
   KOKKOS_LAMBDA(int m, int n, int k) {
     Real &x3min = size.d_view(m).x3min;
     Real &x3max = size.d_view(m).x3max;
     Real x3v = CellCenterX(k-ks, nx3, x3min, x3max);
-    Real k3v = kz_mode_.d_view(n);
-    zsin_(m,n,k) = sin(k3v*x3v);
-    zcos_(m,n,k) = cos(k3v*x3v);
+    Real k3v = dkz*n;
+    zbasis_(m,2*n  ,k) = cos(k3v*x3v);
+    zbasis_(m,2*n+1,k) = sin(k3v*x3v);
     if (ncells3-1 == 0) {
-      zsin_(m,n,k) = 0.0;
-      zcos_(m,n,k) = 1.0;
+      zbasis_(m,2*n  ,k) = 1.0;
+      zbasis_(m,2*n+1,k) = 0.0;
     }
   });
 
@@ -333,17 +346,11 @@ TaskStatus TurbulenceDriver::InitializeModes(Driver *pdrive, int stage) {
 
   // Now compute new force using new random amplitudes and phases
 
-  // Zero out new force array
   auto force_tmp_ = force_tmp;
   int &nmb = pmy_pack->nmb_thispack;
-  par_for("force_init", DevExeSpace(),0,nmb-1,0,2,ks,ke,js,je,is,ie,
-  KOKKOS_LAMBDA(int m, int n, int k, int j, int i) {
-    force_tmp_(m,n,k,j,i) = 0.0;
-  });
 
   int nlow_sqr = SQR(nlow);
   int nhigh_sqr = SQR(nhigh);
-  auto mode_count_ = mode_count;
 
   auto xccc_ = xccc;
   auto xccs_ = xccs;
@@ -386,6 +393,27 @@ TaskStatus TurbulenceDriver::InitializeModes(Driver *pdrive, int stage) {
   Real &ex_prl = exp_prl;
   Real norm, kprl, kprp, kiso;
 
+  // amplitudes of products of 1D basis functions, zero for wavenumbers not driven
+  int nb = nbasis;
+  auto amp_ = amp;
+  Kokkos::deep_copy(amp_.h_view, 0.0);
+  auto set_amp = [&](int n, int sx, int sy, int sz, int nkx, int nky, int nkz, Real a) {
+    amp_.h_view(n,((2*nkz + sz)*nb + (2*nky + sy))*nb + (2*nkx + sx)) = a;
+  };
+
+  // Gaussian deviates, drawn in sequence from rstate, or (with Philox) from a stream per
+  // wavenumber with counter given by the cycle and draw, so that they do not depend on
+  // the order or number of modes and need no state in restart files
+  int ndraw = 0;
+  uint64_t mode_stream = 0;
+  uint64_t cycle_ctr = static_cast<uint64_t>(pm->ncycle) << 5;
+  auto gauss = [&]() -> Real {
+    if (use_philox) {
+      return RanGaussianPhilox(rng_seed, mode_stream, cycle_ctr + ndraw++);
+    }
+    return RanGaussianSt(&(rstate));
+  };
+
   int nmode = 0;
   int nkx, nky, nkz, nsqr;
   for (nkx = 0; nkx <= nhigh; nkx++) {
@@ -408,6 +436,9 @@ TaskStatus TurbulenceDriver::InitializeModes(Driver *pdrive, int stage) {
         }
         if (nsqr >= nlow_sqr && nsqr <= nhigh_sqr && flag_prl) {
           kx = dkx*nkx;
+          mode_stream = (static_cast<uint64_t>(nkx) << 42) |
+                        (static_cast<uint64_t>(nky) << 21) | static_cast<uint64_t>(nkz);
+          ndraw = 0;
           ky = dky*nky;
           kz = dkz*nkz;
 
@@ -422,23 +453,23 @@ TaskStatus TurbulenceDriver::InitializeModes(Driver *pdrive, int stage) {
             if (nkz != 0) {
               ikz = 1.0/(dkz*((Real) nkz));
 
-              xccc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              xccs_.h_view(nmode) = RanGaussianSt(&(rstate));
-              xcsc_.h_view(nmode) = (nky==0)           ? 0.0 : RanGaussianSt(&(rstate));
-              xcss_.h_view(nmode) = (nky==0)           ? 0.0 : RanGaussianSt(&(rstate));
-              xscc_.h_view(nmode) = (nkx==0)           ? 0.0 : RanGaussianSt(&(rstate));
-              xscs_.h_view(nmode) = (nkx==0)           ? 0.0 : RanGaussianSt(&(rstate));
-              xssc_.h_view(nmode) = (nkx==0 || nky==0) ? 0.0 : RanGaussianSt(&(rstate));
-              xsss_.h_view(nmode) = (nkx==0 || nky==0) ? 0.0 : RanGaussianSt(&(rstate));
-
-              yccc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              yccs_.h_view(nmode) = RanGaussianSt(&(rstate));
-              ycsc_.h_view(nmode) = (nky==0)           ? 0.0 : RanGaussianSt(&(rstate));
-              ycss_.h_view(nmode) = (nky==0)           ? 0.0 : RanGaussianSt(&(rstate));
-              yscc_.h_view(nmode) = (nkx==0)           ? 0.0 : RanGaussianSt(&(rstate));
-              yscs_.h_view(nmode) = (nkx==0)           ? 0.0 : RanGaussianSt(&(rstate));
-              yssc_.h_view(nmode) = (nkx==0 || nky==0) ? 0.0 : RanGaussianSt(&(rstate));
-              ysss_.h_view(nmode) = (nkx==0 || nky==0) ? 0.0 : RanGaussianSt(&(rstate));
+              xccc_.h_view(nmode) = gauss();
+              xccs_.h_view(nmode) = gauss();
+              xcsc_.h_view(nmode) = (nky==0)           ? 0.0 : gauss();
+              xcss_.h_view(nmode) = (nky==0)           ? 0.0 : gauss();
+              xscc_.h_view(nmode) = (nkx==0)           ? 0.0 : gauss();
+              xscs_.h_view(nmode) = (nkx==0)           ? 0.0 : gauss();
+              xssc_.h_view(nmode) = (nkx==0 || nky==0) ? 0.0 : gauss();
+              xsss_.h_view(nmode) = (nkx==0 || nky==0) ? 0.0 : gauss();
+
+              yccc_.h_view(nmode) = gauss();
+              yccs_.h_view(nmode) = gauss();
+              ycsc_.h_view(nmode) = (nky==0)           ? 0.0 : gauss();
+              ycss_.h_view(nmode) = (nky==0)           ? 0.0 : gauss();
+              yscc_.h_view(nmode) = (nkx==0)           ? 0.0 : gauss();
+              yscs_.h_view(nmode) = (nkx==0)           ? 0.0 : gauss();
+              yssc_.h_view(nmode) = (nkx==0 || nky==0) ? 0.0 : gauss();
+              ysss_.h_view(nmode) = (nkx==0 || nky==0) ? 0.0 : gauss();
 
               // imcompressibility
               zccc_.h_view(nmode) =  ikz*( kx*xscs_.h_view(nmode)+ky*ycss_.h_view(nmode));
@@ -452,19 +483,19 @@ TaskStatus TurbulenceDriver::InitializeModes(Driver *pdrive, int stage) {
             } else if (nky != 0) {  // kz == 0
               iky = 1.0/(dky*((Real) nky));
 
-              xccc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              xcsc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              xscc_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
-              xssc_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
+              xccc_.h_view(nmode) = gauss();
+              xcsc_.h_view(nmode) = gauss();
+              xscc_.h_view(nmode) = (nkx==0) ? 0.0 : gauss();
+              xssc_.h_view(nmode) = (nkx==0) ? 0.0 : gauss();
               xccs_.h_view(nmode) = 0.0;
               xscs_.h_view(nmode) = 0.0;
               xcss_.h_view(nmode) = 0.0;
               xsss_.h_view(nmode) = 0.0;
 
-              zccc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              zcsc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              zscc_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
-              zssc_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
+              zccc_.h_view(nmode) = gauss();
+              zcsc_.h_view(nmode) = gauss();
+              zscc_.h_view(nmode) = (nkx==0) ? 0.0 : gauss();
+              zssc_.h_view(nmode) = (nkx==0) ? 0.0 : gauss();
               zccs_.h_view(nmode) = 0.0;
               zcss_.h_view(nmode) = 0.0;
               zscs_.h_view(nmode) = 0.0;
@@ -480,8 +511,8 @@ TaskStatus TurbulenceDriver::InitializeModes(Driver *pdrive, int stage) {
               yscs_.h_view(nmode) = 0.0;
               ysss_.h_view(nmode) = 0.0;
             } else {  // kz == ky == 0, kx != 0 by initial if statement
-              zccc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              zscc_.h_view(nmode) = RanGaussianSt(&(rstate));
+              zccc_.h_view(nmode) = gauss();
+              zscc_.h_view(nmode) = gauss();
               zcsc_.h_view(nmode) = 0.0;
               zssc_.h_view(nmode) = 0.0;
               zccs_.h_view(nmode) = 0.0;
@@ -489,8 +520,8 @@ TaskStatus TurbulenceDriver::InitializeModes(Driver *pdrive, int stage) {
               zscs_.h_view(nmode) = 0.0;
               zsss_.h_view(nmode) = 0.0;
 
-              yccc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              yscc_.h_view(nmode) = RanGaussianSt(&(rstate));
+              yccc_.h_view(nmode) = gauss();
+              yscc_.h_view(nmode) = gauss();
               ycsc_.h_view(nmode) = 0.0;
               yssc_.h_view(nmode) = 0.0;
               yccs_.h_view(nmode) = 0.0;
@@ -520,14 +551,14 @@ TaskStatus TurbulenceDriver::InitializeModes(Driver *pdrive, int stage) {
             if (nky != 0) {
               iky = 1.0/(dky*((Real) nky));
 
-              xccc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              xccs_.h_view(nmode) = RanGaussianSt(&(rstate));
-              xcsc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              xcss_.h_view(nmode) = RanGaussianSt(&(rstate));
-              xscc_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
-              xscs_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
-              xssc_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
-              xsss_.h_view(nmode) = (nkx==0) ? 0.0 : RanGaussianSt(&(rstate));
+              xccc_.h_view(nmode) = gauss();
+              xccs_.h_view(nmode) = gauss();
+              xcsc_.h_view(nmode) = gauss();
+              xcss_.h_view(nmode) = gauss();
+              xscc_.h_view(nmode) = (nkx==0) ? 0.0 : gauss();
+              xscs_.h_view(nmode) = (nkx==0) ? 0.0 : gauss();
+              xssc_.h_view(nmode) = (nkx==0) ? 0.0 : gauss();
+              xsss_.h_view(nmode) = (nkx==0) ? 0.0 : gauss();
 
               // incompressibility
               yccc_.h_view(nmode) =  iky*(kx*xssc_.h_view(nmode));
@@ -548,8 +579,8 @@ TaskStatus TurbulenceDriver::InitializeModes(Driver *pdrive, int stage) {
               zssc_.h_view(nmode) = 0.0;
               zsss_.h_view(nmode) = 0.0;
             } else {  // ky == 0
-              yccc_.h_view(nmode) = RanGaussianSt(&(rstate));
-              yscc_.h_view(nmode) = RanGaussianSt(&(rstate));
+              yccc_.h_view(nmode) = gauss();
+              yscc_.h_view(nmode) = gauss();
               ycsc_.h_view(nmode) = 0.0;
               yssc_.h_view(nmode) = 0.0;
               yccs_.h_view(nmode) = 0.0;
@@ -603,6 +634,32 @@ TaskStatus TurbulenceDriver::InitializeModes(Driver *pdrive, int stage) {
           zcss_.h_view(nmode) *= norm;
           zsss_.h_view(nmode) *= norm;
 
+          // store amplitudes of products (c=cos, s=sin) of 1D basis functions
+          set_amp(0,0,0,0,nkx,nky,nkz,xccc_.h_view(nmode));
+          set_amp(0,0,0,1,nkx,nky,nkz,xccs_.h_view(nmode));
+          set_amp(0,0,1,0,nkx,nky,nkz,xcsc_.h_view(nmode));
+          set_amp(0,0,1,1,nkx,nky,nkz,xcss_.h_view(nmode));
+          set_amp(0,1,0,0,nkx,nky,nkz,xscc_.h_view(nmode));
+          set_amp(0,1,0,1,nkx,nky,nkz,xscs_.h_view(nmode));
+          set_amp(0,1,1,0,nkx,nky,nkz,xssc_.h_view(nmode));
+          set_amp(0,1,1,1,nkx,nky,nkz,xsss_.h_view(nmode));
+          set_amp(1,0,0,0,nkx,nky,nkz,yccc_.h_view(nmode));
+          set_amp(1,0,0,1,nkx,nky,nkz,yccs_.h_view(nmode));
+          set_amp(1,0,1,0,nkx,nky,nkz,ycsc_.h_view(nmode));
+          set_amp(1,0,1,1,nkx,nky,nkz,ycss_.h_view(nmode));
+          set_amp(1,1,0,0,nkx,nky,nkz,yscc_.h_view(nmode));
+          set_amp(1,1,0,1,nkx,nky,nkz,yscs_.h_view(nmode));
+          set_amp(1,1,1,0,nkx,nky,nkz,yssc_.h_view(nmode));
+          set_amp(1,1,1,1,nkx,nky,nkz,ysss_.h_view(nmode));
+          set_amp(2,0,0,0,nkx,nky,nkz,zccc_.h_view(nmode));
+          set_amp(2,0,0,1,nkx,nky,nkz,zccs_.h_view(nmode));
+          set_amp(2,0,1,0,nkx,nky,nkz,zcsc_.h_view(nmode));
+          set_amp(2,0,1,1,nkx,nky,nkz,zcss_.h_view(nmode));
+          set_amp(2,1,0,0,nkx,nky,nkz,zscc_.h_view(nmode));
+          set_amp(2,1,0,1,nkx,nky,nkz,zscs_.h_view(nmode));
+          set_amp(2,1,1,0,nkx,nky,nkz,zssc_.h_view(nmode));
+          set_amp(2,1,1,1,nkx,nky,nkz,zsss_.h_view(nmode));
+
           nmode++;
         }
       }
@@ -660,44 +717,44 @@ TaskStatus TurbulenceDriver::InitializeModes(Driver *pdrive, int stage) {
   zsss_.template modify<HostMemSpace>();
   zsss_.template sync<DevExeSpace>();
 
-  auto xcos_ = xcos;
-  auto xsin_ = xsin;
-  auto ycos_ = ycos;
-  auto ysin_ = ysin;
-  auto zcos_ = zcos;
-  auto zsin_ = zsin;
+  amp_.template modify<HostMemSpace>();
+  amp_.template sync<DevExeSpace>();
+
+  // Sum force over all modes separably: first over x basis functions for each pair of
+  // y and z basis functions, then over y, then over z.  This costs O(nbasis) operations
+  // per cell, instead of O(mode_count) for a sum over modes in every cell.
+  auto xbasis_ = xbasis;
+  auto ybasis_ = ybasis;
+  auto zbasis_ = zbasis;
+  auto fx_ = fx_sum;
+  auto fxy_ = fxy_sum;
+
+  par_for("force_sum_x", DevExeSpace(),0,nmb-1,0,2,0,nb-1,0,nb-1,is,ie,
+  KOKKOS_LAMBDA(int m, int n, int pz, int py, int i) {
+    Real sum = 0.0;
+    for (int px=0; px<nb; ++px) {
+      sum += amp_.d_view(n,(pz*nb + py)*nb + px)*xbasis_(m,px,i);
+    }
+    fx_(m,n,pz,py,i) = sum;
+  });
 
-  for (int n=0; n<mode_count_; n++) {
-    par_for("force_compute", DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
-    KOKKOS_LAMBDA(int m, int k, int j, int i) {
-      force_tmp_(m,0,k,j,i) += xccc_.d_view(n)*xcos_(m,n,i)*ycos_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,0,k,j,i) += xccs_.d_view(n)*xcos_(m,n,i)*ycos_(m,n,j)*zsin_(m,n,k);
-      force_tmp_(m,0,k,j,i) += xcsc_.d_view(n)*xcos_(m,n,i)*ysin_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,0,k,j,i) += xcss_.d_view(n)*xcos_(m,n,i)*ysin_(m,n,j)*zsin_(m,n,k);
-      force_tmp_(m,0,k,j,i) += xscc_.d_view(n)*xsin_(m,n,i)*ycos_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,0,k,j,i) += xscs_.d_view(n)*xsin_(m,n,i)*ycos_(m,n,j)*zsin_(m,n,k);
-      force_tmp_(m,0,k,j,i) += xssc_.d_view(n)*xsin_(m,n,i)*ysin_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,0,k,j,i) += xsss_.d_view(n)*xsin_(m,n,i)*ysin_(m,n,j)*zsin_(m,n,k);
-
-      force_tmp_(m,1,k,j,i) += yccc_.d_view(n)*xcos_(m,n,i)*ycos_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,1,k,j,i) += yccs_.d_view(n)*xcos_(m,n,i)*ycos_(m,n,j)*zsin_(m,n,k);
-      force_tmp_(m,1,k,j,i) += ycsc_.d_view(n)*xcos_(m,n,i)*ysin_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,1,k,j,i) += ycss_.d_view(n)*xcos_(m,n,i)*ysin_(m,n,j)*zsin_(m,n,k);
-      force_tmp_(m,1,k,j,i) += yscc_.d_view(n)*xsin_(m,n,i)*ycos_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,1,k,j,i) += yscs_.d_view(n)*xsin_(m,n,i)*ycos_(m,n,j)*zsin_(m,n,k);
-      force_tmp_(m,1,k,j,i) += yssc_.d_view(n)*xsin_(m,n,i)*ysin_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,1,k,j,i) += ysss_.d_view(n)*xsin_(m,n,i)*ysin_(m,n,j)*zsin_(m,n,k);
-
-      force_tmp_(m,2,k,j,i) += zccc_.d_view(n)*xcos_(m,n,i)*ycos_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,2,k,j,i) += zccs_.d_view(n)*xcos_(m,n,i)*ycos_(m,n,j)*zsin_(m,n,k);
-      force_tmp_(m,2,k,j,i) += zcsc_.d_view(n)*xcos_(m,n,i)*ysin_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,2,k,j,i) += zcss_.d_view(n)*xcos_(m,n,i)*ysin_(m,n,j)*zsin_(m,n,k);
-      force_tmp_(m,2,k,j,i) += zscc_.d_view(n)*xsin_(m,n,i)*ycos_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,2,k,j,i) += zscs_.d_view(n)*xsin_(m,n,i)*ycos_(m,n,j)*zsin_(m,n,k);
-      force_tmp_(m,2,k,j,i) += zssc_.d_view(n)*xsin_(m,n,i)*ysin_(m,n,j)*zcos_(m,n,k);
-      force_tmp_(m,2,k,j,i) += zsss_.d_view(n)*xsin_(m,n,i)*ysin_(m,n,j)*zsin_(m,n,k);
-    });
-  }
+  par_for("force_sum_y", DevExeSpace(),0,nmb-1,0,2,0,nb-1,js,je,is,ie,
+  KOKKOS_LAMBDA(int m, int n, int pz, int j, int i) {
+    Real sum = 0.0;
+    for (int py=0; py<nb; ++py) {
+      sum += fx_(m,n,pz,py,i)*ybasis_(m,py,j);
+    }
+    fxy_(m,n,pz,j,i) = sum;
+  });
+
+  par_for("force_sum_z", DevExeSpace(),0,nmb-1,0,2,ks,ke,js,je,is,ie,
+  KOKKOS_LAMBDA(int m, int n, int k, int j, int i) {
+    Real sum = 0.0;
+    for (int pz=0; pz<nb; ++pz) {
+      sum += fxy_(m,n,pz,j,i)*zbasis_(m,pz,k);
+    }
+    force_tmp_(m,n,k,j,i) = sum;
+  });
 
   DvceArray5D<Real> u0, u0_;
   if (pmy_pack->phydro != nullptr) u0 = (pmy_pack->phydro->u0);
@@ -712,48 +769,15 @@ TaskStatus TurbulenceDriver::InitializeModes(Driver *pdrive, int stage) {
   const int nmkji = nmb*nx3*nx2*nx1;
   const int nkji = nx3*nx2*nx1;
   const int nji  = nx2*nx1;
-  Real t0 = 0.0, t1 = 0.0, t2 = 0.0, t3 = 0.0;
 
-  Kokkos::parallel_reduce("net_mom_1", Kokkos::RangePolicy<>(DevExeSpace(),0,nmkji),
-  KOKKOS_LAMBDA(const int &idx, Real &sum_t0, Real &sum_t1,
-                                Real &sum_t2, Real &sum_t3) {
-    // compute n,k,j,i indices of thread
-    int m = (idx)/nkji;
-    int k = (idx - m*nkji)/nji;
-    int j = (idx - m*nkji - k*nji)/nx1;
-    int i = (idx - m*nkji - k*nji - j*nx1) + is;
-    k += ks;
-    j += js;
-    Real den = u0(m,IDN,k,j,i);
-    if (flag_twofl) {
-      den += u0_(m,IDN,k,j,i);
-    }
-    sum_t0 += den;
-    sum_t1 += den*force_tmp_(m,0,k,j,i);
-    sum_t2 += den*force_tmp_(m,1,k,j,i);
-    sum_t3 += den*force_tmp_(m,2,k,j,i);
-  }, Kokkos::Sum<Real>(t0), Kokkos::Sum<Real>(t1),
-     Kokkos::Sum<Real>(t2), Kokkos::Sum<Real>(t3));
-
-
-#if MPI_PARALLEL_ENABLED
-  Real m[4], gm[4];
-  m[0] = t0; m[1] = t1; m[2] = t2; m[3] = t3;
-  MPI_Allreduce(m, gm, 4, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  t0 = gm[0]; t1 = gm[1]; t2 = gm[2]; t3 = gm[3];
-#endif
-
-  par_for("force_remove_net_mom", DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
-  KOKKOS_LAMBDA(int m, int k, int j, int i) {
-    force_tmp_(m,0,k,j,i) -= t1/t0;
-    force_tmp_(m,1,k,j,i) -= t2/t0;
-    force_tmp_(m,2,k,j,i) -= t3/t0;
-  });
-
-  t0 = 0.0;
-  t1 = 0.0;
-  Kokkos::parallel_reduce("net_mom_2", Kokkos::RangePolicy<>(DevExeSpace(),0,nmkji),
-  KOKKOS_LAMBDA(const int &idx, Real &sum_t0, Real &sum_t1) {
+  // Compute all sums needed to remove the net momentum of the force and to normalize it
+  // in a single reduction (and a single MPI_Allreduce).  With D = sum(den),
+  // P = sum(den*f), Q = sum(den*f.f), M = sum(mom), and R = sum(mom.f), the force after
+  // removing the net momentum, f' = f - P/D, satisfies sum(den*f'.f') = Q - P.P/D and
+  // sum(mom.f') = R - M.P/D.
+  array_sum::GlobalSum sum_this_mb;
+  Kokkos::parallel_reduce("net_mom", Kokkos::RangePolicy<>(DevExeSpace(),0,nmkji),
+  KOKKOS_LAMBDA(const int &idx, array_sum::GlobalSum &mb_sum) {
     // compute n,k,j,i indices of thread
     int m = (idx)/nkji;
     int k = (idx - m*nkji)/nji;
@@ -776,20 +800,33 @@ TaskStatus TurbulenceDriver::InitializeModes(Driver *pdrive, int stage) {
     Real v2 = force_tmp_(m,1,k,j,i);
     Real v3 = force_tmp_(m,2,k,j,i);
 
-    sum_t0 += den*(v1*v1+v2*v2+v3*v3);
-    sum_t1 += mom1*v1+mom2*v2+mom3*v3;
-  }, Kokkos::Sum<Real>(t0), Kokkos::Sum<Real>(t1));
-
+    array_sum::GlobalSum sum;
+    sum.the_array[0] = den;
+    sum.the_array[1] = den*v1;
+    sum.the_array[2] = den*v2;
+    sum.the_array[3] = den*v3;
+    sum.the_array[4] = den*(v1*v1 + v2*v2 + v3*v3);
+    sum.the_array[5] = mom1;
+    sum.the_array[6] = mom2;
+    sum.the_array[7] = mom3;
+    sum.the_array[8] = mom1*v1 + mom2*v2 + mom3*v3;
+    mb_sum += sum;
+  }, Kokkos::Sum<array_sum::GlobalSum>(sum_this_mb));
+
+  Real gsum[9];
+  for (int n=0; n<9; ++n) {gsum[n] = sum_this_mb.the_array[n];}
 #if MPI_PARALLEL_ENABLED
-  m[0] = t0; m[1] = t1;
-  MPI_Allreduce(m, gm, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-  t0 = gm[0]; t1 = gm[1];
+  MPI_Allreduce(MPI_IN_PLACE, gsum, 9, MPI_ATHENA_REAL, MPI_SUM,
+                global_variable::mpi_comm);
 #endif
 
-  t0 = std::max(t0, 1.0e-20);
-  t1 = std::max(t1, 1.0e-20);
+  Real t0 = gsum[0];
+  Real f1 = gsum[1]/t0, f2 = gsum[2]/t0, f3 = gsum[3]/t0;
+  Real m0 = gsum[4] - (gsum[1]*f1 + gsum[2]*f2 + gsum[3]*f3);
+  Real m1 = gsum[8] - (gsum[5]*f1 + gsum[6]*f2 + gsum[7]*f3);
+  m0 = std::max(m0, 1.0e-20);
+  m1 = std::max(m1, 1.0e-20);
 
-  Real m0 = t0, m1 = t1;
   Real dt = pm->dt;
   Real dvol = 1.0/(gnx1*gnx2*gnx3);
   m0 = 0.5*m0*dvol*dt;
@@ -803,11 +840,12 @@ TaskStatus TurbulenceDriver::InitializeModes(Driver *pdrive, int stage) {
   }
   if (m0 == 0.0) s = 0.0;
 
+  // remove net momentum and normalize force in one pass
   par_for("force_norm", DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
   KOKKOS_LAMBDA(int m, int k, int j, int i) {
-    force_tmp_(m,0,k,j,i) *= s;
-    force_tmp_(m,1,k,j,i) *= s;
-    force_tmp_(m,2,k,j,i) *= s;
+    force_tmp_(m,0,k,j,i) = s*(force_tmp_(m,0,k,j,i) - f1);
+    force_tmp_(m,1,k,j,i) = s*(force_tmp_(m,1,k,j,i) - f2);
+    force_tmp_(m,2,k,j,i) = s*(force_tmp_(m,2,k,j,i) - f3);
   });
 
   return TaskStatus::complete;
@@ -1033,7 +1071,7 @@ TaskStatus TurbulenceDriver::AddForcing(Driver *pdrive, int stage) {
 #if MPI_PARALLEL_ENABLED
     Real m[4], gm[4];
     m[0] = t0; m[1] = t1; m[2] = t2; m[3] = t3;
-    MPI_Allreduce(m, gm, 4, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Allreduce(m, gm, 4, MPI_DOUBLE, MPI_SUM, global_variable::mpi_comm);
     t0 = gm[0]; t1 = gm[1]; t2 = gm[2]; t3 = gm[3];
 #endif
 
@@ -1179,7 +1217,7 @@ TaskStatus TurbulenceDriver::AddForcing(Driver *pdrive, int stage) {
 #if MPI_PARALLEL_ENABLED
     Real m[4], gm[4];
     m[0] = t0; m[1] = t1; m[2] = t2; m[3] = t3;
-    MPI_Allreduce(m, gm, 4, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Allreduce(m, gm, 4, MPI_DOUBLE, MPI_SUM, global_variable::mpi_comm);
     t0 = gm[0]; t1 = gm[1]; t2 = gm[2]; t3 = gm[3];
 #endif
 
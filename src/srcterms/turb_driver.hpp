@@ -26,12 +26,21 @@ class TurbulenceDriver {
 
   DvceArray5D<Real> force, force_tmp;  // arrays used for turb forcing
   RNG_State rstate;                    // random state
+  bool use_philox;                     // use counter-based Philox generator
+  uint64_t rng_seed;                   // seed (key) of Philox generator
 
   DualArray1D<Real> xccc, xccs, xcsc, xcss, xscc, xscs, xssc, xsss;
   DualArray1D<Real> yccc, yccs, ycsc, ycss, yscc, yscs, yssc, ysss;
   DualArray1D<Real> zccc, zccs, zcsc, zcss, zscc, zscs, zssc, zsss;
   DualArray1D<Real> kx_mode, ky_mode, kz_mode;
-  DvceArray3D<Real> xcos, xsin, ycos, ysin, zcos, zsin;
+  // cos(nk*dk*x) (index 2*nk) and sin(nk*dk*x) (index 2*nk+1) in each direction, and
+  // amplitude of each product of these 1D functions in every component of the force,
+  // stored as amp(n,(pz*nbasis + py)*nbasis + px).  The force is summed separably over
+  // x, y, and then z using the partial sums fx_sum(m,n,pz,py,i) and fxy_sum(m,n,pz,j,i)
+  int nbasis;
+  DvceArray3D<Real> xbasis, ybasis, zbasis;
+  DualArray2D<Real> amp;
+  DvceArray5D<Real> fx_sum, fxy_sum;
 
   // parameters of driving
   int nlow, nhigh;
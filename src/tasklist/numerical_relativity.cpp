@@ -5,10 +5,12 @@
 //========================================================================================
 //! \file numerical_relativity.cpp
 //  \brief implementation of functions for NumericalRelativity
+#include <algorithm>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "numerical_relativity.hpp"
@@ -120,6 +122,10 @@ bool NumericalRelativity::AssembleNumericalRelativityTasks(
       if (DependenciesMet(task, queue, dep) && !task.added) {
         task.added = true;
         task.id = list->AddTask(task.func_, dep);
+        // start communications as early as possible with <time>/task_priority
+        if (task.name_string.find("_Send") != std::string::npos) {
+          list->SetPriority(task.id, 1);
+        }
         cycle_added++;
         added++;
         /*std::cout << "Successfully added " << task.name_string << " to task list!\n"
@@ -152,6 +158,31 @@ void NumericalRelativity::PrintMissingTasks(std::vector<QueuedTask> &queue) {
   }
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn void NumericalRelativity::SplitSpacetimeTasks()
+//! \brief Moves Z4c tasks (except Z4c_InterpADM, which prepares the metric for the
+//! matter) from queue to z4c_queue, and removes dependencies between the two queues.
+
+void NumericalRelativity::SplitSpacetimeTasks(std::vector<QueuedTask> &queue,
+                                              std::vector<QueuedTask> &z4c_queue) {
+  auto spacetime = [this](TaskName name) {
+    return (NeedsPhysics(name) == Phys_Z4c && name != Z4c_InterpADM);
+  };
+  std::vector<QueuedTask> matter_queue;
+  for (auto &task : queue) {
+    bool z4c = spacetime(task.name);
+    auto &deps = task.dependencies;
+    deps.erase(std::remove_if(deps.begin(), deps.end(),
+               [&](TaskName dep) {return (spacetime(dep) != z4c);}), deps.end());
+    if (z4c) {
+      z4c_queue.push_back(task);
+    } else {
+      matter_queue.push_back(task);
+    }
+  }
+  queue.swap(matter_queue);
+}
+
 void NumericalRelativity::AssembleNumericalRelativityTasks(
        std::map<std::string, std::shared_ptr<TaskList>>& tl) {
   // Assemble the task lists for all physics modules
@@ -162,6 +193,15 @@ void NumericalRelativity::AssembleNumericalRelativityTasks(
     pmy_pack->pz4c->QueueZ4cTasks();
   }
 
+  // With multirate integration the Z4c tasks form separate task lists, executed over the
+  // spacetime step before the matter tasks of the first cycle within it.
+  bool multirate = (pmy_pack->pz4c != nullptr && pmy_pack->pz4c->multirate_ratio > 1);
+  if (multirate) {
+    SplitSpacetimeTasks(start_queue, z4c_start_queue);
+    SplitSpacetimeTasks(run_queue, z4c_run_queue);
+    SplitSpacetimeTasks(end_queue, z4c_end_queue);
+  }
+
   bool success = AssembleNumericalRelativityTasks(tl["before_stagen"], start_queue);
   if (!success) {
     std::cout << "NumericalRelativity: Failed to construct start TaskList!\n"
@@ -185,6 +225,22 @@ void NumericalRelativity::AssembleNumericalRelativityTasks(
     PrintMissingTasks(end_queue);
     abort();
   }
+
+  if (multirate) {
+    std::vector<std::pair<std::string, std::vector<QueuedTask>*>> z4c_lists;
+    z4c_lists.emplace_back("z4c_before_stagen", &z4c_start_queue);
+    z4c_lists.emplace_back("z4c_stagen", &z4c_run_queue);
+    z4c_lists.emplace_back("z4c_after_stagen", &z4c_end_queue);
+    for (auto &list : z4c_lists) {
+      if (!AssembleNumericalRelativityTasks(tl[list.first], *(list.second))) {
+        std::cout << "NumericalRelativity: Failed to construct " << list.first
+                  << " TaskList!\n  Check that there are no cyclical dependencies or "
+                  << "missing tasks.\n";
+        PrintMissingTasks(*(list.second));
+        abort();
+      }
+    }
+  }
 }
 
 } // namespace numrel
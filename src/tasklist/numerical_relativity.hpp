@@ -32,7 +32,6 @@ enum TaskName {
   MHD_Recv,
   MHD_CopyU,
   MHD_Flux,
-  MHD_SetTmunu,
   MHD_SendFlux,
   MHD_RecvFlux,
   MHD_ExplRK,
@@ -82,6 +81,8 @@ enum TaskName {
   Z4c_ClearRW,
   Z4c_Wave,
   Z4c_PT,
+  Z4c_AHF,
+  Z4c_InterpADM,
   Z4c_NTASKS
 };
 
@@ -163,6 +164,10 @@ class NumericalRelativity {
   std::vector<QueuedTask> start_queue;
   std::vector<QueuedTask> run_queue;
   std::vector<QueuedTask> end_queue;
+  // Z4c tasks, kept separate from matter tasks with multirate integration
+  std::vector<QueuedTask> z4c_start_queue;
+  std::vector<QueuedTask> z4c_run_queue;
+  std::vector<QueuedTask> z4c_end_queue;
 
   std::vector<QueuedTask>& SelectQueue(TaskLocation loc);
   PhysicsDependency NeedsPhysics(TaskName task);
@@ -176,6 +181,8 @@ class NumericalRelativity {
                             std::vector<TaskName>& optional);
 
   void PrintMissingTasks(std::vector<QueuedTask> &queue);
+  void SplitSpacetimeTasks(std::vector<QueuedTask> &queue,
+                           std::vector<QueuedTask> &z4c_queue);
 
   bool AssembleNumericalRelativityTasks(std::shared_ptr<TaskList>& list,
          std::vector<QueuedTask> &queue);
@@ -13,9 +13,13 @@
 // This version includes improvements due to Josh Dolence and the Parthenon dev team, and
 // extensions by J.M.Stone.
 
+#include <algorithm>
 #include <iostream>
 #include <bitset>
+#include <chrono>
 #include <functional>
+#include <future>
+#include <utility>
 #include <vector>
 #include <list>
 #include <iterator>
@@ -83,13 +87,30 @@ class TaskID {
 //! \class Task
 //  \brief data and function pointer for an individual Task
 //  NOTE: Task function must take arguments (Driver*, int)
+//
+//  Tasks created with on_host=true run asynchronously on a separate host thread: the
+//  first call launches the function and returns 'incomplete', later calls return its
+//  result once it has finished.  Such functions run concurrently with the tasks (and
+//  device kernels) launched by the main thread, so they must only access data on the
+//  host (e.g. h_view of a DualArray synced before the task), and must neither launch
+//  Kokkos kernels nor call MPI.
 
 class Task {
  public:
-  Task(TaskID id, TaskID dep, std::function<TaskStatus(Driver*, int)> func) :
-  myid_(id), dep_(dep), func_(func) {}
+  Task(TaskID id, TaskID dep, std::function<TaskStatus(Driver*, int)> func,
+       bool on_host=false) :
+  myid_(id), dep_(dep), on_host_(on_host), func_(func) {}
   // overloaded operator() calls task function
-  TaskStatus operator()(Driver *d, int s) {return func_(d,s);}
+  TaskStatus operator()(Driver *d, int s) {
+    if (!(on_host_)) {return func_(d,s);}
+    if (!(pending_.valid())) {pending_ = std::async(std::launch::async, func_, d, s);}
+    if (pending_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      return TaskStatus::incomplete;
+    }
+    return pending_.get();
+  }
+  // true while function of a host Task is running on its thread
+  bool IsRunningOnHost() {return pending_.valid();}
   TaskID GetID() {return myid_;}
   TaskID GetDependency() {return dep_;}
   void SetComplete() {complete_ = true;}
@@ -99,13 +120,22 @@ class Task {
   void ChangeDependency(TaskID id, TaskID newdep) {
     if ((dep_ & id) == id) {dep_ = ((dep_ ^ id) | newdep);}
   }
+  // declared priority, and length of longest chain of dependent tasks (see TaskList)
+  void SetPriority(int p) {priority_ = p;}
+  int GetPriority() {return priority_;}
+  void SetLevel(int l) {level_ = l;}
+  int GetLevel() {return level_;}
 
  private:
   TaskID myid_;    // encodes task ID in bitfld_
   TaskID dep_;     // encodes dependencies to other tasks in bitfld_
   // bool lb_time_;   // flag to include this task in timing for automatic load balancing
   bool complete_ = false;
+  bool on_host_;   // if true, function runs asynchronously on a host thread
+  int priority_ = 0;
+  int level_ = 0;
   std::function<TaskStatus(Driver*, int)> func_;  // ptr to Task function
+  std::future<TaskStatus> pending_;               // result of running host Task
 };
 
 //----------------------------------------------------------------------------------------
@@ -117,6 +147,11 @@ class TaskList {
   TaskList() = default;
   ~TaskList() = default;
 
+  // optional function through which each Task is called (see DoAvailable())
+  std::function<TaskStatus(int, Task&, Driver*, int)> task_wrapper;
+  // when true, DoAvailable() runs available tasks in order of priority (see BuildOrder())
+  bool prioritize = false;
+
   // functions (all implemented here)
   bool IsComplete() {
     // cycle through task list and check if each task completed
@@ -141,22 +176,94 @@ class TaskList {
     for (auto &it : task_list_) { it.SetIncomplete(); }
   }
 
-  // cycle through task list once, do any tasks whose dependencies are clear
+  // cycle through task list once, do any tasks whose dependencies are clear.
+  // Returns 'stuck' if no task could be completed during this pass, which (since the
+  // only tasks that return 'incomplete' are those testing MPI receives) means the list
+  // is waiting on communications.  Event-driven scheduler in Driver uses this flag.
+  // Passes while a host Task is still running return 'running' instead, so that the
+  // main thread keeps polling rather than blocking on MPI receives.
+  // If set, Tasks are called through task_wrapper (with the position of the task in the
+  // list), e.g. so they can be timed by the Profiler.
+  // With prioritize=true tasks are visited in the order set by BuildOrder() instead of
+  // the order in which they were added.
   TaskListStatus DoAvailable(Driver *d, int s) {
-    for (auto &task : task_list_) {
+    bool progress = false;
+    auto do_task = [&](int n, Task &task) {
+      if (task.IsComplete()) return;
       auto dep = task.GetDependency();
-      if ( tasks_completed_.CheckDependencies(dep) && !(task.IsComplete()) ) {
-        TaskStatus status = task(d,s);  // calls Task function using overloaded operator()
+      if (tasks_completed_.CheckDependencies(dep)) {
+        TaskStatus status;
+        if (task_wrapper) {
+          status = task_wrapper(n, task, d, s);
+        } else {
+          status = task(d,s);  // calls Task function using overloaded operator()
+        }
         if (status == TaskStatus::complete) {
           task.SetComplete();              // set bool flag in task
           MarkTaskComplete(task.GetID());  // add TaskID to tasks_completed_
+          progress = true;
         }
       }
+    };
+    if (prioritize) {
+      if (order_.size() != task_list_.size()) {BuildOrder();}
+      for (auto &it : order_) {do_task(it.first, *(it.second));}
+    } else {
+      int n = 0;
+      for (auto &task : task_list_) {do_task(++n, task);}
     }
     if (IsComplete()) return TaskListStatus::complete;
+    if (!(progress)) {
+      for (auto &task : task_list_) {
+        if (task.IsRunningOnHost()) return TaskListStatus::running;
+      }
+      return TaskListStatus::stuck;
+    }
     return TaskListStatus::running;
   }
 
+  // Declares priority of Task with ID 'id' (default 0), e.g. to start communications as
+  // early as possible.  Usage:
+  //     tl.SetPriority(taskid, 1);
+  void SetPriority(TaskID id, int p) {
+    for (auto &it : task_list_) {
+      if (it.GetID() == id) {it.SetPriority(p);}
+    }
+    order_.clear();
+  }
+
+  // Sets order in which DoAvailable() visits tasks with prioritize=true: by declared
+  // priority, then by level (the length of the longest chain of tasks that depend on
+  // each task, i.e. its distance to the end of the critical path), then in the order
+  // tasks were added.  Among tasks of equal priority, each task is visited before the
+  // tasks that depend on it, so chains of tasks still complete in a single pass.
+  void BuildOrder() {
+    for (auto &it : task_list_) {it.SetLevel(0);}
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (auto &t : task_list_) {
+        for (auto &u : task_list_) {
+          if (u.GetDependency().CheckDependencies(t.GetID()) &&
+              t.GetLevel() < u.GetLevel() + 1) {
+            t.SetLevel(u.GetLevel() + 1);
+            changed = true;
+          }
+        }
+      }
+    }
+    order_.clear();
+    int n = 0;
+    for (auto &it : task_list_) {order_.push_back(std::make_pair(++n, &it));}
+    std::stable_sort(order_.begin(), order_.end(),
+                     [](const std::pair<int, Task*> &a, const std::pair<int, Task*> &b) {
+      if (a.second->GetPriority() != b.second->GetPriority()) {
+        return (a.second->GetPriority() > b.second->GetPriority());
+      }
+      return (a.second->GetLevel() > b.second->GetLevel());
+    });
+  }
+
   // ADD new Task with ID, given dependency, and a pointer to a static or non-member
   // function to the end of task list.  Returns ID of new task. Task function must have
   // arguments (Driver*, int). Usage:
@@ -183,6 +290,19 @@ class TaskList {
     return id;
   }
 
+  // ADD new Task with ID, given dependency, and a pointer to a member function of
+  // class T to the end of task list, which runs asynchronously on a host thread (see
+  // class Task for restrictions on such functions).  Returns ID of new task.  Usage:
+  //     taskid = tl.AddHostTask(&T::DoSomething, T, dependency);
+  template <class F, class T>
+  TaskID AddHostTask(F func, T *obj, TaskID &dep) {
+    auto size = task_list_.size();
+    TaskID id(size+1);
+    task_list_.push_back( Task(id, dep,
+       [=](Driver *d, int s) mutable -> TaskStatus {return (obj->*func)(d,s);}, true) );
+    return id;
+  }
+
   // ADD new Task with ID, given dependency, and a std::function to the end of task
   // list. Returns ID of new task. Task function must have arguments (Driver*, int).
   // Usage:
@@ -223,6 +343,9 @@ class TaskList {
  protected:
   std::list<Task> task_list_;
   TaskID tasks_completed_;
+  // (position in task_list_, Task) in order visited with prioritize=true, rebuilt
+  // whenever tasks are added or priorities change
+  std::vector<std::pair<int, Task*>> order_;
 };
 
 #endif  // TASKLIST_TASK_LIST_HPP_
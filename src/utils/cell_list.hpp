@@ -0,0 +1,71 @@
+#ifndef UTILS_CELL_LIST_HPP_
+#define UTILS_CELL_LIST_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file cell_list.hpp
+//  \brief Functions to compact the indices of cells flagged by masks into a list using a
+//  parallel scan, so that kernels which only act on the (usually few) flagged cells, e.g.
+//  FOFC, can be launched over exactly that many work items.
+
+#include "athena.hpp"
+
+//----------------------------------------------------------------------------------------
+//! \struct CellRange
+//  \brief Index range [kl,ku]x[jl,ju]x[il,iu] of cells in each of nmb MeshBlocks, with
+//  functions to convert between (m,k,j,i) and a single packed integer index.
+
+struct CellRange {
+  int nmb, kl, ku, jl, ju, il, iu;
+
+  KOKKOS_INLINE_FUNCTION
+  int NCells() const {return nmb*(ku - kl + 1)*(ju - jl + 1)*(iu - il + 1);}
+
+  KOKKOS_INLINE_FUNCTION
+  void Unpack(const int idx, int &m, int &k, int &j, int &i) const {
+    const int ni = iu - il + 1;
+    const int nji = (ju - jl + 1)*ni;
+    const int nkji = (ku - kl + 1)*nji;
+    m = idx/nkji;
+    k = (idx - m*nkji)/nji;
+    j = (idx - m*nkji - k*nji)/ni;
+    i = (idx - m*nkji - k*nji - j*ni) + il;
+    j += jl;
+    k += kl;
+  }
+};
+
+//----------------------------------------------------------------------------------------
+//! \fn int FlaggedCellList()
+//  \brief Stores packed indices of all cells in range for which flag1 (if use_flag1) or
+//  flag2 (if use_flag2) is set into list, in order, using a parallel scan.  The list is
+//  grown if required.  Returns the number of flagged cells.
+
+inline int FlaggedCellList(const CellRange &range,
+                           const bool use_flag1, const DvceArray4D<bool> &flag1,
+                           const bool use_flag2, const DvceArray4D<bool> &flag2,
+                           DvceArray1D<int> &list) {
+  const int ncells = range.NCells();
+  if (static_cast<int>(list.extent(0)) < ncells) {
+    Kokkos::realloc(list, ncells);
+  }
+  auto list_ = list;
+  int nflag = 0;
+  Kokkos::parallel_scan("FlagList", Kokkos::RangePolicy<>(DevExeSpace(), 0, ncells),
+  KOKKOS_LAMBDA(const int idx, int &offset, const bool final) {
+    int m, k, j, i;
+    range.Unpack(idx, m, k, j, i);
+    bool flagged = false;
+    if (use_flag1) {flagged = flag1(m,k,j,i);}
+    if (use_flag2) {flagged = flagged || flag2(m,k,j,i);}
+    if (flagged) {
+      if (final) {list_(offset) = idx;}
+      offset += 1;
+    }
+  }, nflag);
+  return nflag;
+}
+
+#endif // UTILS_CELL_LIST_HPP_
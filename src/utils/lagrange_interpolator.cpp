@@ -24,66 +24,97 @@ LagrangeInterpolator::LagrangeInterpolator(
   Real rcoords[3]):
               pmy_pack(pmy_pack),
               rcoord("rccord", 1), interp_indcs("interp_indcs", 1),
-              interp_wghts("interp_wghts", 1, 1), point_exist(false) {
+              interp_wghts("interp_wghts", 1, 1), dvce_wghts("dvce_wghts", 1, 1),
+              batch_vars("batch_vars", 1), batch_vals("batch_vals", 1),
+              point_exist(false) {
   auto &indcs = pmy_pack->pmesh->mb_indcs;
   // int &is = indcs.is; int &js = indcs.js; int &ks = indcs.ks;
   int &ng = indcs.ng;
   Kokkos::realloc(rcoord, 3);
   Kokkos::realloc(interp_wghts, 2 * ng, 3);
+  Kokkos::realloc(dvce_wghts, 2 * ng, 3);
   Kokkos::realloc(interp_indcs, 4);
 
+  // interpolation is in the logical coordinates of the mesh (see CoordinateStretch)
+  auto &stretch = pmy_pack->pmesh->stretch;
   for (int i = 0; i < 3; ++i) {
-    rcoord(i) = rcoords[i];
+    rcoord(i) = stretch.Xi(i, rcoords[i]);
   }
   SetInterpolationIndices();
   CalculateWeight();
 }
 
 Real LagrangeInterpolator::Interpolate(DvceArray5D<Real> &val, int nvars) {
-  Real ivals    = 0.;
-  int &ng       = pmy_pack->pmesh->mb_indcs.ng;
-  int &ii0      = interp_indcs(0);
-  int &ii1      = interp_indcs(1);
-  int &ii2      = interp_indcs(2);
-  int &ii3      = interp_indcs(3);
-  auto &weights = interp_wghts;
-  auto &indcs   = pmy_pack->pmesh->mb_indcs;
-
-  int &is = indcs.is;
-  int &js = indcs.js;
-  int &ks = indcs.ks;
+  Real ivals = 0.;
+  InterpolateVars(val, 1, &nvars, &ivals);
+  return ivals;
+}
 
+// interpolate the nvar variables with indices vars[] of val to the point in a single
+// kernel, returning the results in ivals[] with one device-to-host copy.  Results are
+// zero if the point is not on this rank.
+
+void LagrangeInterpolator::InterpolateVars(DvceArray5D<Real> &val, int nvar,
+                                           const int vars[], Real ivals[]) {
   if (interp_indcs(0) == -1) { // point not on this rank
-    ivals = 0.0;
-  } else {
+    for (int v = 0; v < nvar; ++v) {
+      ivals[v] = 0.0;
+    }
+    return;
+  }
+
+  if (static_cast<int>(batch_vars.extent(0)) < nvar) {
+    Kokkos::realloc(batch_vars, nvar);
+    Kokkos::realloc(batch_vals, nvar);
+  }
+  for (int v = 0; v < nvar; ++v) {
+    batch_vars.h_view(v) = vars[v];
+  }
+  batch_vars.template modify<HostMemSpace>();
+  batch_vars.template sync<DevExeSpace>();
+
+  // capturing variables for kernel
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int is = indcs.is, js = indcs.js, ks = indcs.ks;
+  int ng  = indcs.ng;
+  int ii0 = interp_indcs(0);
+  int ii1 = interp_indcs(1);
+  int ii2 = interp_indcs(2);
+  int ii3 = interp_indcs(3);
+  auto &weights = dvce_wghts;
+  auto &bvars = batch_vars;
+  auto &bvals = batch_vals;
+  par_for("lagrange_interp", DevExeSpace(), 0, nvar-1,
+  KOKKOS_LAMBDA(int v) {
+    int n = bvars.d_view(v);
+    Real int_value = 0.0;
     for (int i = 0; i < 2 * ng; i++) {
       for (int j = 0; j < 2 * ng; j++) {
         for (int k = 0; k < 2 * ng; k++) {
-          Real iwght  = weights(i, 0) * weights(j, 1) * weights(k, 2);
-          auto buffer = Kokkos::subview(
-            val,
-            ii0,
-            nvars,
-            ii3 - (ng - k - ks) + 1,
-            ii2 - (ng - j - js) + 1,
-            ii1 - (ng - i - is) + 1);
-          Real scalar;
-          // Deep Copy Scalar View into a scalar
-          Kokkos::deep_copy(scalar, buffer);
-          ivals += iwght * scalar;
+          Real iwght = weights(i, 0) * weights(j, 1) * weights(k, 2);
+          int_value += iwght * val(ii0, n, ii3 - (ng - k - ks) + 1,
+                                   ii2 - (ng - j - js) + 1, ii1 - (ng - i - is) + 1);
         }
       }
     }
+    bvals.d_view(v) = int_value;
+  });
+
+  // sync dual arrays
+  batch_vals.template modify<DevExeSpace>();
+  batch_vals.template sync<HostMemSpace>();
+  for (int v = 0; v < nvar; ++v) {
+    ivals[v] = batch_vals.h_view(v);
   }
-  return ivals;
 }
 
 Real LagrangeInterpolator::ResetPointAndInterpolate(
   DvceArray5D<Real> &val,
   int nvars,
   Real rcoords2[3]) {
+  auto &stretch = pmy_pack->pmesh->stretch;
   for (int i = 0; i < 3; ++i) {
-    rcoord(i) = rcoords2[i];
+    rcoord(i) = stretch.Xi(i, rcoords2[i]);
   }
   SetInterpolationIndices();
   CalculateWeight();
@@ -100,37 +131,29 @@ void LagrangeInterpolator::SetInterpolationIndices() {
     interp_indcs(i) = -1;
   }
 
-  for (int m = 0; m <= nmb1; ++m) {
+  // locate MeshBlock containing the point with a MeshBlockTree descent
+  int m = pmy_pack->pmesh->FindMeshBlockGID(rcoord(0), rcoord(1), rcoord(2))
+          - pmy_pack->gids;
+  if (m >= 0 && m <= nmb1) {
     // extract MeshBlock bounds
     Real &x1min = size.h_view(m).x1min;
-    Real &x1max = size.h_view(m).x1max;
     Real &x2min = size.h_view(m).x2min;
-    Real &x2max = size.h_view(m).x2max;
     Real &x3min = size.h_view(m).x3min;
-    Real &x3max = size.h_view(m).x3max;
 
     // extract MeshBlock grid cell spacings
     Real &dx1 = size.h_view(m).dx1;
     Real &dx2 = size.h_view(m).dx2;
     Real &dx3 = size.h_view(m).dx3;
 
-    // save MeshBlock and zone indicies for nearest position to spherical patch
-    // center if this angle position resides in this MeshBlock
-    if (
-      (rcoord(0) >= x1min && rcoord(0) < x1max)
-      && (rcoord(1) >= x2min && rcoord(1) < x2max)
-      && (rcoord(2) >= x3min && rcoord(2) < x3max)) {
-      point_exist     = true;
-      interp_indcs(0) = m;
-      interp_indcs(1) =
-        static_cast<int>(std::floor((rcoord(0) - (x1min + dx1 / 2.0)) / dx1));
-      interp_indcs(2) =
-        static_cast<int>(std::floor((rcoord(1) - (x2min + dx2 / 2.0)) / dx2));
-      interp_indcs(3) =
-        static_cast<int>(std::floor((rcoord(2) - (x3min + dx3 / 2.0)) / dx3));
-
-      break;
-    }
+    // save MeshBlock and zone indicies for nearest position to the point
+    point_exist     = true;
+    interp_indcs(0) = m;
+    interp_indcs(1) =
+      static_cast<int>(std::floor((rcoord(0) - (x1min + dx1 / 2.0)) / dx1));
+    interp_indcs(2) =
+      static_cast<int>(std::floor((rcoord(1) - (x2min + dx2 / 2.0)) / dx2));
+    interp_indcs(3) =
+      static_cast<int>(std::floor((rcoord(2) - (x3min + dx3 / 2.0)) / dx3));
   }
 }
 
@@ -183,4 +206,5 @@ void LagrangeInterpolator::CalculateWeight() {
       }
     }
   }
+  Kokkos::deep_copy(dvce_wghts, interp_wghts);
 }
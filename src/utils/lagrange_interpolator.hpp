@@ -24,13 +24,14 @@ class LagrangeInterpolator {
   void SetInterpolationIndices();
   void CalculateWeight();
   Real Interpolate(DvceArray5D<Real> &val, int nvars);
+  void InterpolateVars(DvceArray5D<Real> &val, int nvar, const int vars[], Real ivals[]);
   Real InterpolateTensor(
     AthenaTensor<Real, TensorSymm::NONE, 3, 1> &val, int nvars);
   Real ResetPointAndInterpolate(
     DvceArray5D<Real> &val, int nvars, Real rcoords2[3]);
   bool point_exist; // point exist on this rank (meshblock pack)
  private:
-  HostArray1D<Real> rcoord; // xyz coordinate for interpolated value
+  HostArray1D<Real> rcoord; // logical xyz coordinate for interpolated value
 
   int nvars;               // index of the variable for interpolation
   MeshBlockPack *pmy_pack; // ptr to MeshBlockPack containing this Hydro
@@ -39,6 +40,9 @@ class LagrangeInterpolator {
   HostArray1D<int>
     interp_indcs; // indices of MeshBlock and zones therein for interp
   HostArray2D<Real> interp_wghts; // weights for interpolation
+  DvceArray2D<Real> dvce_wghts;   // device copy of weights
+  DualArray1D<int> batch_vars;    // variable indices for batched interpolation
+  DualArray1D<Real> batch_vals;   // results of batched interpolation
 };
 
 #endif // UTILS_LAGRANGE_INTERPOLATOR_HPP_
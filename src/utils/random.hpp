@@ -8,6 +8,8 @@
 //! \file random.cpp
 //  \brief Random number generators (that can be included in Kokkos parallel for regions)
 
+#include <cstdint>
+
 #include "athena.hpp"
 
 //----------------------------------------------------------------------------------------
@@ -189,4 +191,61 @@ static Real RanGaussian(int64_t *idum) {
   }
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn Philox4x32
+//! \brief  Counter-based Philox4x32-10 generator of Salmon et al. (2011).  Maps the
+//! 128-bit counter ctr (in place) to 128 random bits for the 64-bit key.  Deviates
+//! depend only on (key, counter), so they can be generated in any order on the host or
+//! device, e.g. with the counter given by the index of a mode or particle, and the same
+//! numbers are obtained independently of the number of ranks or threads.
+
+KOKKOS_INLINE_FUNCTION
+void Philox4x32(const uint32_t key_in[2], uint32_t ctr[4]) {
+  uint32_t key[2] = {key_in[0], key_in[1]};
+  for (int r=0; r<10; ++r) {
+    uint64_t p0 = static_cast<uint64_t>(0xD2511F53u)*ctr[0];
+    uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u)*ctr[2];
+    uint32_t hi0 = static_cast<uint32_t>(p0 >> 32), lo0 = static_cast<uint32_t>(p0);
+    uint32_t hi1 = static_cast<uint32_t>(p1 >> 32), lo1 = static_cast<uint32_t>(p1);
+    ctr[0] = hi1 ^ ctr[1] ^ key[0];
+    ctr[1] = lo1;
+    ctr[2] = hi0 ^ ctr[3] ^ key[1];
+    ctr[3] = lo0;
+    key[0] += 0x9E3779B9u;
+    key[1] += 0xBB67AE85u;
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn RanPhilox
+//! \brief  Returns two uniform deviates between 0.0 and 1.0 (exclusive of the endpoint
+//! values) for given seed, stream (e.g. MeshBlock or mode) and counter within the stream
+
+KOKKOS_INLINE_FUNCTION
+void RanPhilox(const uint64_t seed, const uint64_t stream, const uint64_t counter,
+               double u[2]) {
+  uint32_t key[2] = {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+  uint32_t ctr[4] = {static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32),
+                     static_cast<uint32_t>(stream),
+                     static_cast<uint32_t>(stream >> 32)};
+  Philox4x32(key, ctr);
+  for (int n=0; n<2; ++n) {
+    uint64_t x = (static_cast<uint64_t>(ctr[2*n]) << 32) | ctr[2*n+1];
+    u[n] = (static_cast<double>(x >> 11) + 0.5)*(1.0/9007199254740992.0);
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn RanGaussianPhilox
+//! \brief  Returns a deviate with zero mean and unit variance from RanPhilox() with the
+//! Box-Muller transform
+
+KOKKOS_INLINE_FUNCTION
+Real RanGaussianPhilox(const uint64_t seed, const uint64_t stream,
+                       const uint64_t counter) {
+  double u[2];
+  RanPhilox(seed, stream, counter, u);
+  return sqrt(-2.0*log(u[0]))*cos(2.0*M_PI*u[1]);
+}
+
 #endif // UTILS_RANDOM_HPP_
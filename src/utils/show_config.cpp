@@ -19,6 +19,8 @@ void ShowConfig() {
   std::cout<<"  Problem generator:          " << PROBLEM_GENERATOR << std::endl;
   if (SINGLE_PRECISION_ENABLED) {
     std::cout<<"  Floating-point precision:   single" << std::endl;
+  } else if (MIXED_PRECISION_ENABLED) {
+    std::cout<<"  Floating-point precision:   mixed (single storage)" << std::endl;
   } else {
     std::cout<<"  Floating-point precision:   double" << std::endl;
   }
@@ -32,6 +34,16 @@ void ShowConfig() {
 #else
   std::cout<<"  OpenMP parallelism:         OFF" << std::endl;
 #endif
+#if HDF5_OUTPUT_ENABLED
+  std::cout<<"  HDF5 output:                ON" << std::endl;
+#else
+  std::cout<<"  HDF5 output:                OFF" << std::endl;
+#endif
+#if ASCENT_OUTPUT_ENABLED
+  std::cout<<"  Ascent in-situ output:      ON" << std::endl;
+#else
+  std::cout<<"  Ascent in-situ output:      OFF" << std::endl;
+#endif
 
   // std::cout<<"  Compiler:                   " << COMPILED_WITH << std::endl;
   // std::cout<<"  Compilation command:        " << COMPILER_COMMAND
@@ -4,13 +4,16 @@
 // Licensed under the 3-clause BSD License (the "LICENSE")
 //========================================================================================
 //! \file tr_table.cpp
-//! \brief Implementation of Table class
+//! \brief Implementation of Table class.  Tables consist of an ASCII header followed by
+//! the binary data (see ReadTable).
+#include <algorithm>
 #include <string>
 #include <fstream>
 #include <sstream>
 #include <map>
 #include <vector>
 
+#include "globals.hpp"
 #include "tr_table.hpp"
 #include "tr_utils.hpp"
 
@@ -25,39 +28,130 @@ Table::~Table() {
   }
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn ReadResult Table::ReadTable()
+//! \brief Reads table from file.  With MPI only rank 0 reads the file, and the header
+//! text and data are broadcast to the other ranks, so that the file system is not
+//! accessed by every rank at startup.  Must be called by all ranks.
+
 ReadResult Table::ReadTable(const std::string fname) {
   ReadResult result;
+  result.error = ReadResult::SUCCESS;
 
+  // rank 0 parses header (to find where data start) and keeps its text for other ranks
   std::ifstream file;
-  try {
-    file.open(fname.c_str(), std::ifstream::in);
-  } catch (std::ifstream::failure& e) {
-    result.error = ReadResult::BAD_FILENAME;
-    std::stringstream ss;
-    ss << "Could not read '" << fname << "'\n"
-       << "open() returned the following error:\n"
-       << e.what();
-    result.message = ss.str();
-    return result;
+  std::string header_text;
+  size_t header_size = 0;
+  if (global_variable::my_rank == 0) {
+    file.open(fname.c_str(), std::ifstream::in | std::ifstream::binary);
+    if (!file.is_open()) {
+      result.error = ReadResult::BAD_FILENAME;
+      std::stringstream ss;
+      ss << "ReadTable() failed to open '" << fname << "'\n";
+      result.message = ss.str();
+    } else {
+      result = ReadHeader(file);
+      if (result.error == ReadResult::SUCCESS) {
+        header_size = file.tellg();
+        header_text.resize(header_size);
+        file.seekg(0);
+        file.read(&header_text[0], header_size);
+      } else {
+        file.close();
+      }
+    }
   }
 
-  // Something bizarre happened while reading the file.
-  if (!file.is_open()) {
-    result.error = ReadResult::BAD_FILENAME;
-    std::stringstream ss;
-    ss << "No exception occurred, but ReadTable() failed to open '" << fname << "'\n";
-    result.message = ss.str();
+#if MPI_PARALLEL_ENABLED
+  // all ranks return the error of rank 0, or parse the header it read
+  int error = static_cast<int>(result.error);
+  MPI_Bcast(&error, 1, MPI_INT, 0, global_variable::mpi_comm);
+  result.error = static_cast<ReadResult::ErrorCode>(error);
+  BroadcastString(result.message);
+  if (result.error != ReadResult::SUCCESS) {
     return result;
   }
+  BroadcastString(header_text);
+  if (global_variable::my_rank != 0) {
+    std::istringstream header_stream(header_text);
+    result = ReadHeader(header_stream);
+    if (result.error != ReadResult::SUCCESS) {
+      return result;
+    }
+  }
+#else
+  if (result.error != ReadResult::SUCCESS) {
+    return result;
+  }
+#endif
+
+  // Allocate memory for the fields.
+  npoints = 1;
+  mem_size = 0;
+  for (auto& p : point_info) {
+    npoints *= p.second;
+    mem_size += p.second;
+  }
+  mem_size += npoints*field_names.size();
+  data = new double[mem_size];
+
+  // Set the memory offsets for all the fields.
+  size_t offset = 0;
+  for (auto &p : point_info) {
+    fields[p.first] = &data[offset];
+    offset += p.second;
+  }
+  for (auto &s : field_names) {
+    fields[s] = &data[offset];
+    offset += npoints;
+  }
+
+  initialized = true;
+
+  // Dump all the memory after the header into the data.
+  // FIXME(JMF): This doesn't handle single precision data correctly!
+  if (global_variable::my_rank == 0) {
+    char *memblock = reinterpret_cast<char*>(data);
+    file.seekg(header_size);
+    file.read(memblock, mem_size*sizeof(double));
+    file.close();
+  }
+#if MPI_PARALLEL_ENABLED
+  // broadcast in chunks, since MPI counts are int
+  const size_t chunk = static_cast<size_t>(1) << 27;
+  for (size_t n = 0; n < mem_size; n += chunk) {
+    int count = static_cast<int>(std::min(chunk, mem_size - n));
+    MPI_Bcast(&data[n], count, MPI_DOUBLE, 0, global_variable::mpi_comm);
+  }
+#endif
+
+  // Now we need to check for endianness.
+  if ((!metadata["endianness"].compare("little") && !IsLittleEndian()) ||
+      (!metadata["endianness"].compare("big") && IsLittleEndian())) {
+    for (size_t i = 0; i < mem_size; i++) {
+      data[i] = SwapEndianness(data[i]);
+    }
+    result.message = "Swapped endianness of data.\n";
+  }
+
+  result.error = ReadResult::SUCCESS;
+
+  return result;
+}
 
-  // HEADER PARSING
+//----------------------------------------------------------------------------------------
+//! \fn ReadResult Table::ReadHeader()
+//! \brief Parses the metadata, scalars, points, and fields blocks of the header, leaving
+//! the stream at the start of the data.
+
+ReadResult Table::ReadHeader(std::istream& file) {
+  ReadResult result;
 
   // Read in the metadata
   std::vector<std::string> block_lines;
 
   result = ExtractBlock(file, "metadata", block_lines);
   if (result.error != ReadResult::SUCCESS) {
-    file.close();
     return result;
   }
   result = ParseBlock("metadata", block_lines,
@@ -65,7 +159,6 @@ ReadResult Table::ReadTable(const std::string fname) {
     metadata[k] = v;
   });
   if (result.error != ReadResult::SUCCESS) {
-    file.close();
     return result;
   }
   block_lines.clear();
@@ -73,7 +166,6 @@ ReadResult Table::ReadTable(const std::string fname) {
   // Read in the scalars
   result = ExtractBlock(file, "scalars", block_lines);
   if (result.error != ReadResult::SUCCESS) {
-    file.close();
     return result;
   }
   result = ParseBlock("scalars", block_lines,
@@ -81,7 +173,6 @@ ReadResult Table::ReadTable(const std::string fname) {
     scalars[k] = std::stod(v);
   });
   if (result.error != ReadResult::SUCCESS) {
-    file.close();
     return result;
   }
   block_lines.clear();
@@ -89,7 +180,6 @@ ReadResult Table::ReadTable(const std::string fname) {
   // Read in the points
   result = ExtractBlock(file, "points", block_lines);
   if (result.error != ReadResult::SUCCESS) {
-    file.close();
     return result;
   }
   result = ParseBlock("points", block_lines,
@@ -97,7 +187,6 @@ ReadResult Table::ReadTable(const std::string fname) {
     point_info.push_back({k, std::stoi(v)});
   });
   if (result.error != ReadResult::SUCCESS) {
-    file.close();
     return result;
   }
   block_lines.clear();
@@ -106,85 +195,31 @@ ReadResult Table::ReadTable(const std::string fname) {
   // Read in the fields
   result = ExtractBlock(file, "fields", block_lines);
   if (result.error != ReadResult::SUCCESS) {
-    file.close();
     return result;
   }
   for (auto line : block_lines) {
     TrimWhiteSpace(line);
     field_names.push_back(line);
   }
+  return result;
+}
 
-  size_t header_size = file.tellg();
-  file.close();
-
-  // Allocate memory for the fields.
-  npoints = 1;
-  mem_size = 0;
-  for (auto& p : point_info) {
-    npoints *= p.second;
-    mem_size += p.second;
-  }
-  mem_size += npoints*field_names.size();
-  data = new double[mem_size];
-
-  // Set the memory offsets for all the fields.
-  size_t offset = 0;
-  for (auto &p : point_info) {
-    fields[p.first] = &data[offset];
-    offset += p.second;
-  }
-  for (auto &s : field_names) {
-    fields[s] = &data[offset];
-    offset += npoints;
-  }
-
-  initialized = true;
-
-  // Now we need to load the table memory itself. We reopen the file as a binary.
-  try {
-    file.open(fname.c_str(), std::ifstream::in | std::ifstream::binary);
-  } catch (std::ifstream::failure& e) {
-    result.error = ReadResult::BAD_FILENAME;
-    std::stringstream ss;
-    ss << "Could not read '" << fname << "' as a binary file\n"
-       << "open() returned the following error:\n"
-       << e.what();
-    result.message = ss.str();
-    return result;
-  }
-  if (!file.is_open()) {
-    result.error = ReadResult::BAD_FILENAME;
-    std::stringstream ss;
-    ss << "No exception occurred, but ReadTable() failed to open '" << fname << "'\n"
-       << "as a binary file\n";
-    result.message = ss.str();
-    return result;
-  }
-
-  // Because we've already read the header, we skip ahead to the binary section.
-  file.seekg(header_size);
-  // Dump all the memory into the data.
-  // FIXME(JMF): This doesn't handle single precision data correctly!
-  char *memblock = reinterpret_cast<char*>(data);
-  file.read(memblock, mem_size*sizeof(double));
-
-  // Now we need to check for endianness.
-  if ((!metadata["endianness"].compare("little") && !IsLittleEndian()) ||
-      (!metadata["endianness"].compare("big") && IsLittleEndian())) {
-    for (size_t i = 0; i < mem_size; i++) {
-      data[i] = SwapEndianness(data[i]);
-    }
-    result.message = "Swapped endianness of data.\n";
+#if MPI_PARALLEL_ENABLED
+//----------------------------------------------------------------------------------------
+//! \fn void Table::BroadcastString()
+//! \brief Broadcasts string from rank 0 to all ranks
+
+void Table::BroadcastString(std::string& str) {
+  int len = static_cast<int>(str.size());
+  MPI_Bcast(&len, 1, MPI_INT, 0, global_variable::mpi_comm);
+  str.resize(len);
+  if (len > 0) {
+    MPI_Bcast(&str[0], len, MPI_CHAR, 0, global_variable::mpi_comm);
   }
-
-  file.close();
-
-  result.error = ReadResult::SUCCESS;
-
-  return result;
 }
+#endif
 
-ReadResult Table::ExtractBlock(std::ifstream& file, const std::string name,
+ReadResult Table::ExtractBlock(std::istream& file, const std::string name,
                                std::vector<std::string>& lines) {
   ReadResult result;
   // Read the first block
@@ -12,9 +12,12 @@
 #include <map>
 #include <vector>
 #include <fstream>
+#include <istream>
 #include <sstream>
 #include <utility>
 
+#include "config.hpp"
+
 namespace TableReader {
 
 struct ReadResult {
@@ -99,9 +102,15 @@ class Table {
     return result;
   }
 
-  ReadResult ExtractBlock(std::ifstream& file, const std::string name,
+  ReadResult ReadHeader(std::istream& file);
+
+  ReadResult ExtractBlock(std::istream& file, const std::string name,
                           std::vector<std::string>& lines);
 
+#if MPI_PARALLEL_ENABLED
+  void BroadcastString(std::string& str);
+#endif
+
   bool SplitToken(const std::string& in, std::string& key, std::string& value);
 
   void TrimWhiteSpace(std::string& str);
@@ -88,25 +88,35 @@ void CompactObjectTracker::InterpolateVelocity(MeshBlockPack *pmbp) {
   if (S->point_exist) {
     owns_compact_object = true;
 
-    Real betax = S->Interpolate(pz4c->u0, pz4c->I_Z4C_BETAX);
-    Real betay = S->Interpolate(pz4c->u0, pz4c->I_Z4C_BETAY);
-    Real betaz = S->Interpolate(pz4c->u0, pz4c->I_Z4C_BETAZ);
-    vel[0] = - betax;
-    vel[1] = - betay;
-    vel[2] = - betaz;
-    if (type == NeutronStar) {
-      Real alp = S->Interpolate(pz4c->u0, pz4c->I_Z4C_ALPHA);
-
-      Real zx = S->Interpolate(pmhd->w0, IVX);
-      Real zy = S->Interpolate(pmhd->w0, IVY);
-      Real zz = S->Interpolate(pmhd->w0, IVZ);
-
-      Real gxx = S->Interpolate(padm->u_adm, padm->I_ADM_GXX);
-      Real gxy = S->Interpolate(padm->u_adm, padm->I_ADM_GXY);
-      Real gxz = S->Interpolate(padm->u_adm, padm->I_ADM_GXZ);
-      Real gyy = S->Interpolate(padm->u_adm, padm->I_ADM_GYY);
-      Real gyz = S->Interpolate(padm->u_adm, padm->I_ADM_GYZ);
-      Real gzz = S->Interpolate(padm->u_adm, padm->I_ADM_GZZ);
+    // interpolate all required variables of each array in a single kernel
+    bool is_ns = (type == NeutronStar);
+    int z4c_vars[4] = {pz4c->I_Z4C_BETAX, pz4c->I_Z4C_BETAY, pz4c->I_Z4C_BETAZ,
+                       pz4c->I_Z4C_ALPHA};
+    Real z4c_vals[4];
+    S->InterpolateVars(pz4c->u0, (is_ns ? 4 : 3), z4c_vars, z4c_vals);
+    vel[0] = - z4c_vals[0];
+    vel[1] = - z4c_vals[1];
+    vel[2] = - z4c_vals[2];
+    if (is_ns) {
+      Real alp = z4c_vals[3];
+
+      int mhd_vars[3] = {IVX, IVY, IVZ};
+      Real mhd_vals[3];
+      S->InterpolateVars(pmhd->w0, 3, mhd_vars, mhd_vals);
+      Real zx = mhd_vals[0];
+      Real zy = mhd_vals[1];
+      Real zz = mhd_vals[2];
+
+      int adm_vars[6] = {padm->I_ADM_GXX, padm->I_ADM_GXY, padm->I_ADM_GXZ,
+                         padm->I_ADM_GYY, padm->I_ADM_GYZ, padm->I_ADM_GZZ};
+      Real adm_vals[6];
+      S->InterpolateVars(padm->u_adm, 6, adm_vars, adm_vals);
+      Real gxx = adm_vals[0];
+      Real gxy = adm_vals[1];
+      Real gxz = adm_vals[2];
+      Real gyy = adm_vals[3];
+      Real gyz = adm_vals[4];
+      Real gzz = adm_vals[5];
 
       Real z_x = gxx*zx + gxy*zy + gxz*zz;
       Real z_y = gxy*zx + gyy*zy + gyz*zz;
@@ -150,7 +160,7 @@ void CompactObjectTracker::EvolveTracker() {
     buf[6] = 1.0;
   }
   MPI_Allreduce(
-    MPI_IN_PLACE, buf, 2 * NDIM + 1, MPI_ATHENA_REAL, MPI_SUM, MPI_COMM_WORLD);
+    MPI_IN_PLACE, buf, 2 * NDIM + 1, MPI_ATHENA_REAL, MPI_SUM, global_variable::mpi_comm);
   if (buf[6] < 0.5) {
     std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
               << std::endl;
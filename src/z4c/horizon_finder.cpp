@@ -0,0 +1,529 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file horizon_finder.cpp
+//! \brief implementation of the in-situ apparent horizon finder
+//!
+//! The surface r = h(theta,phi) = sum_lm a_lm Y_lm(theta,phi) is evolved with the fast
+//! flow of Gundlach (1998)
+//!
+//!    a_lm <- a_lm - A/(1 + B l(l+1)) (rho Theta)_lm,
+//!
+//! with A = alpha/(lmax(lmax+1)) + beta and B = beta/alpha, until the mean radius changes
+//! by less than hmean_tol in one iteration.  Theta is the expansion of outgoing null
+//! normals and rho = 2 h^2 |dF| / ((g^ij - s^i s^j) delta_ij) with F = r - h, which makes
+//! the flow converge in a few iterations in flat space (Alcubierre et al. 2000, CQG 17,
+//! 2159).  At every iteration the points on the surface are located with a MeshBlockTree
+//! descent, and a single kernel interpolates g_ij, its derivatives and K_ij to every
+//! point and evaluates Theta, rho and the area element there.
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <string>
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "parameter_input.hpp"
+#include "mesh/mesh.hpp"
+#include "coordinates/adm.hpp"
+#include "coordinates/cell_locations.hpp"
+#include "z4c/compact_object_tracker.hpp"
+#include "z4c/horizon_finder.hpp"
+
+// maximum width of the interpolation stencils (2*nghost)
+#define AHF_MAX_STENCIL 8
+
+namespace {
+//----------------------------------------------------------------------------------------
+//! \fn void GaussLegendre
+//! \brief nodes x (in [-1,1], decreasing) and weights w of n-point Gauss-Legendre rule
+
+void GaussLegendre(int n, Real *x, Real *w) {
+  for (int i=0; i<n; ++i) {
+    Real z = std::cos(M_PI*(i + 0.75)/(n + 0.5));
+    Real dp = 1.0;
+    for (int it=0; it<100; ++it) {
+      Real p0 = 1.0, p1 = z;
+      for (int l=2; l<=n; ++l) {
+        Real p2 = ((2.0*l - 1.0)*z*p1 - (l - 1.0)*p0)/l;
+        p0 = p1;
+        p1 = p2;
+      }
+      Real p = (n == 1)? z : p1;
+      Real pm1 = (n == 1)? 1.0 : p0;
+      dp = n*(z*p - pm1)/(z*z - 1.0);
+      Real dz = p/dp;
+      z -= dz;
+      if (std::abs(dz) < 1.0e-15) break;
+    }
+    x[i] = z;
+    w[i] = 2.0/((1.0 - z*z)*dp*dp);
+  }
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+HorizonFinder::HorizonFinder(MeshBlockPack *pmbp, ParameterInput *pin, int n):
+    found{false}, area{0.0}, mass{0.0}, rmin{0.0}, rmean{0.0}, rmax{0.0},
+    pmy_pack{pmbp},
+    a_lm("ahf_a_lm",1), quad_wght("ahf_wght",1), ylm("ahf_ylm",1,1,1),
+    angles("ahf_angles",1,1), surf("ahf_surf",1,1), pt_mb("ahf_pt_mb",1),
+    pt_vals("ahf_pt_vals",1,1) {
+  std::string nstr = std::to_string(n);
+  every = pin->GetOrAddInteger("z4c", "ahf_every", 10);
+  lmax = pin->GetOrAddInteger("z4c", "ahf_lmax", 8);
+  ntheta = pin->GetOrAddInteger("z4c", "ahf_ntheta", 24);
+  nphi = pin->GetOrAddInteger("z4c", "ahf_nphi", 48);
+  max_iter = pin->GetOrAddInteger("z4c", "ahf_max_iter", 100);
+  flow_alpha = pin->GetOrAddReal("z4c", "ahf_flow_alpha", 1.0);
+  flow_beta = pin->GetOrAddReal("z4c", "ahf_flow_beta", 0.5);
+  hmean_tol = pin->GetOrAddReal("z4c", "ahf_hmean_tol", 1.0e-6);
+  center[0] = pin->GetOrAddReal("z4c", "ahf_" + nstr + "_x", 0.0);
+  center[1] = pin->GetOrAddReal("z4c", "ahf_" + nstr + "_y", 0.0);
+  center[2] = pin->GetOrAddReal("z4c", "ahf_" + nstr + "_z", 0.0);
+  tracker = pin->GetOrAddInteger("z4c", "ahf_" + nstr + "_tracker", -1);
+  initial_radius = pin->GetOrAddReal("z4c", "ahf_" + nstr + "_initial_radius", 1.0);
+
+  if (every < 1 || lmax < 0 || ntheta <= lmax || nphi <= 2*lmax || max_iter < 1) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "<z4c>/ahf parameters require ahf_every >= 1, "
+              << "ahf_ntheta > ahf_lmax, ahf_nphi > 2*ahf_lmax and ahf_max_iter >= 1"
+              << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  if (2*(pmy_pack->pmesh->mb_indcs.ng) > AHF_MAX_STENCIL) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "horizon finder supports at most nghost = "
+              << AHF_MAX_STENCIL/2 << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+
+  nlm = (lmax + 1)*(lmax + 1);
+  npts = ntheta*nphi;
+  Kokkos::realloc(a_lm, nlm);
+  Kokkos::realloc(quad_wght, npts);
+  Kokkos::realloc(ylm, 6, nlm, npts);
+  Kokkos::realloc(angles, npts, 2);
+  Kokkos::realloc(surf, npts, 6);
+  Kokkos::realloc(pt_mb, npts);
+  Kokkos::realloc(pt_vals, npts, 4);
+
+  // points, quadrature weights, and real spherical harmonics Y_lm (with l(l+1)+m as the
+  // spectral index) and their derivatives d_th, d_ph, d_th^2, d_th d_ph, d_ph^2 there
+  Real *xgl = new Real[ntheta];
+  Real *wgl = new Real[ntheta];
+  GaussLegendre(ntheta, xgl, wgl);
+  Real *plm = new Real[nlm];
+  Real *dplm = new Real[nlm];
+  for (int it=0; it<ntheta; ++it) {
+    Real cost = xgl[it];
+    Real th = std::acos(cost);
+    Real sint = std::sin(th);
+    // normalized associated Legendre functions (without Condon-Shortley phase)
+    for (int m=0; m<=lmax; ++m) {
+      Real pmm = std::sqrt(1.0/(4.0*M_PI));
+      for (int k=1; k<=m; ++k) {
+        pmm *= std::sqrt((2.0*k + 1.0)/(2.0*k))*sint;
+      }
+      Real pl2 = 0.0, pl1 = pmm;
+      plm[m*(lmax+1) + m] = pmm;
+      for (int l=m+1; l<=lmax; ++l) {
+        Real a = std::sqrt((4.0*l*l - 1.0)/(l*l - m*m));
+        Real b = std::sqrt(((l - 1.0)*(l - 1.0) - m*m)/(4.0*(l - 1.0)*(l - 1.0) - 1.0));
+        Real pl = a*(cost*pl1 - b*pl2);
+        plm[m*(lmax+1) + l] = pl;
+        pl2 = pl1;
+        pl1 = pl;
+      }
+      for (int l=m; l<=lmax; ++l) {
+        Real plm1 = (l > m)? plm[m*(lmax+1) + l-1] : 0.0;
+        dplm[m*(lmax+1) + l] = (l*cost*plm[m*(lmax+1) + l] - std::sqrt((2.0*l + 1.0)/
+                               (2.0*l - 1.0)*(l*l - m*m))*plm1)/sint;
+      }
+    }
+    for (int ip=0; ip<nphi; ++ip) {
+      int p = it*nphi + ip;
+      Real ph = 2.0*M_PI*ip/nphi;
+      angles.h_view(p,0) = th;
+      angles.h_view(p,1) = ph;
+      quad_wght(p) = wgl[it]*2.0*M_PI/nphi;
+      for (int l=0; l<=lmax; ++l) {
+        for (int m=-l; m<=l; ++m) {
+          int am = std::abs(m);
+          int lm = l*(l+1) + m;
+          Real p0 = plm[am*(lmax+1) + l];
+          Real p1 = dplm[am*(lmax+1) + l];
+          // Legendre equation gives the second theta derivative
+          Real p2 = -cost/sint*p1 - (l*(l+1.0) - am*am/(sint*sint))*p0;
+          Real f, df, ddf;  // azimuthal part and its derivatives
+          if (m > 0) {
+            f = std::sqrt(2.0)*std::cos(am*ph);
+            df = -std::sqrt(2.0)*am*std::sin(am*ph);
+          } else if (m < 0) {
+            f = std::sqrt(2.0)*std::sin(am*ph);
+            df = std::sqrt(2.0)*am*std::cos(am*ph);
+          } else {
+            f = 1.0;
+            df = 0.0;
+          }
+          ddf = -am*am*f;
+          ylm(0,lm,p) = p0*f;
+          ylm(1,lm,p) = p1*f;
+          ylm(2,lm,p) = p0*df;
+          ylm(3,lm,p) = p2*f;
+          ylm(4,lm,p) = p1*df;
+          ylm(5,lm,p) = p0*ddf;
+        }
+      }
+    }
+  }
+  delete[] xgl;
+  delete[] wgl;
+  delete[] plm;
+  delete[] dplm;
+  angles.template modify<HostMemSpace>();
+  angles.template sync<DevExeSpace>();
+  ResetSurface();
+
+  if (0 == global_variable::my_rank) {
+    std::string ofname = pin->GetString("job", "basename") + ".";
+    ofname += pin->GetOrAddString("z4c", "ahf_filename", "ahf_");
+    ofname += nstr + ".txt";
+    ofile.open(ofname.c_str());
+    ofile << "# Apparent horizon " << nstr << std::endl;
+    ofile << "# 1:iter 2:time 3:found 4:mass 5:area 6:rmean 7:rmin 8:rmax 9:x 10:y "
+          << "11:z 12:flow_iterations" << std::endl;
+    ofile << std::flush;
+    ofile << std::setprecision(19);
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void HorizonFinder::ResetSurface
+//! \brief set the surface to the initial guess, a coordinate sphere
+
+void HorizonFinder::ResetSurface() {
+  for (int lm=0; lm<nlm; ++lm) {
+    a_lm(lm) = 0.0;
+  }
+  a_lm(0) = initial_radius*std::sqrt(4.0*M_PI);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void HorizonFinder::SetSurface
+//! \brief evaluate h and its angular derivatives at the points from the spectral
+//! coefficients, and locate the MeshBlock in this pack containing each point
+
+void HorizonFinder::SetSurface() {
+  int nmb = pmy_pack->nmb_thispack;
+  for (int p=0; p<npts; ++p) {
+    for (int d=0; d<6; ++d) {
+      Real val = 0.0;
+      for (int lm=0; lm<nlm; ++lm) {
+        val += a_lm(lm)*ylm(d,lm,p);
+      }
+      surf.h_view(p,d) = val;
+    }
+    Real &th = angles.h_view(p,0);
+    Real &ph = angles.h_view(p,1);
+    Real h = surf.h_view(p,0);
+    int m = pmy_pack->pmesh->FindMeshBlockGID(center[0] + h*std::sin(th)*std::cos(ph),
+                                              center[1] + h*std::sin(th)*std::sin(ph),
+                                              center[2] + h*std::cos(th));
+    m -= pmy_pack->gids;
+    pt_mb.h_view(p) = (m >= 0 && m < nmb)? m : -1;
+  }
+  surf.template modify<HostMemSpace>();
+  surf.template sync<DevExeSpace>();
+  pt_mb.template modify<HostMemSpace>();
+  pt_mb.template sync<DevExeSpace>();
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void HorizonFinder::Expansion
+//! \brief compute the expansion, flow weight rho and area element at every point on the
+//! device, then sum the results over ranks (each point is owned by one rank)
+
+void HorizonFinder::Expansion() {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  auto &size = pmy_pack->pmb->mb_size;
+  auto &u_adm = pmy_pack->padm->u_adm;
+  int ng = indcs.ng;
+  int nst = 2*ng;
+  Real cx = center[0], cy = center[1], cz = center[2];
+  auto &angles_ = angles;
+  auto &surf_ = surf;
+  auto &pt_mb_ = pt_mb;
+  auto &vals = pt_vals;
+  const int igxx = adm::ADM::I_ADM_GXX, ikxx = adm::ADM::I_ADM_KXX;
+
+  par_for("ahf_expansion",DevExeSpace(),0,npts-1,
+  KOKKOS_LAMBDA(const int p) {
+    const int m = pt_mb_.d_view(p);
+    if (m < 0) {
+      for (int v=0; v<4; ++v) {vals.d_view(p,v) = 0.0;}
+      return;
+    }
+    const Real sint = sin(angles_.d_view(p,0)), cost = cos(angles_.d_view(p,0));
+    const Real sinp = sin(angles_.d_view(p,1)), cosp = cos(angles_.d_view(p,1));
+    const Real nr[3] = {sint*cosp, sint*sinp, cost};
+    const Real et[3] = {cost*cosp, cost*sinp, -sint};
+    const Real ep[3] = {-sinp, cosp, 0.0};
+    const Real h = surf_.d_view(p,0);
+    const Real h_t = surf_.d_view(p,1), h_p = surf_.d_view(p,2);
+    const Real h_tt = surf_.d_view(p,3), h_tp = surf_.d_view(p,4);
+    const Real h_pp = surf_.d_view(p,5);
+    const Real x[3] = {cx + h*nr[0], cy + h*nr[1], cz + h*nr[2]};
+
+    // Lagrange interpolation weights (and their derivatives) in each direction
+    Real xmin[3] = {size.d_view(m).x1min, size.d_view(m).x2min, size.d_view(m).x3min};
+    Real xmax[3] = {size.d_view(m).x1max, size.d_view(m).x2max, size.d_view(m).x3max};
+    Real dx[3] = {size.d_view(m).dx1, size.d_view(m).dx2, size.d_view(m).dx3};
+    int nx[3] = {indcs.nx1, indcs.nx2, indcs.nx3};
+    int is[3] = {indcs.is, indcs.js, indcs.ks};
+    Real w[3][AHF_MAX_STENCIL], dw[3][AHF_MAX_STENCIL];
+    int i0[3];
+    for (int d=0; d<3; ++d) {
+      int ii = static_cast<int>(floor((x[d] - (xmin[d] + 0.5*dx[d]))/dx[d]));
+      Real xs[AHF_MAX_STENCIL];
+      for (int a=0; a<nst; ++a) {
+        xs[a] = CellCenterX(ii - ng + 1 + a, nx[d], xmin[d], xmax[d]);
+      }
+      for (int a=0; a<nst; ++a) {
+        w[d][a] = 1.0;
+        dw[d][a] = 0.0;
+        for (int b=0; b<nst; ++b) {
+          if (b == a) continue;
+          w[d][a] *= (x[d] - xs[b])/(xs[a] - xs[b]);
+          Real t = 1.0/(xs[a] - xs[b]);
+          for (int c=0; c<nst; ++c) {
+            if (c == a || c == b) continue;
+            t *= (x[d] - xs[c])/(xs[a] - xs[c]);
+          }
+          dw[d][a] += t;
+        }
+      }
+      i0[d] = ii - ng + 1 + is[d];
+    }
+
+    // interpolate g_ij, d_k g_ij and K_ij (symmetric index order xx,xy,xz,yy,yz,zz)
+    Real g[6], dg[3][6], kk[6];
+    for (int v=0; v<6; ++v) {
+      g[v] = 0.0;
+      kk[v] = 0.0;
+      dg[0][v] = 0.0;
+      dg[1][v] = 0.0;
+      dg[2][v] = 0.0;
+    }
+    for (int c=0; c<nst; ++c) {
+      for (int b=0; b<nst; ++b) {
+        for (int a=0; a<nst; ++a) {
+          const int k = i0[2] + c, j = i0[1] + b, i = i0[0] + a;
+          const Real w000 = w[0][a]*w[1][b]*w[2][c];
+          const Real w100 = dw[0][a]*w[1][b]*w[2][c];
+          const Real w010 = w[0][a]*dw[1][b]*w[2][c];
+          const Real w001 = w[0][a]*w[1][b]*dw[2][c];
+          for (int v=0; v<6; ++v) {
+            const Real q = u_adm(m,igxx+v,k,j,i);
+            g[v] += w000*q;
+            dg[0][v] += w100*q;
+            dg[1][v] += w010*q;
+            dg[2][v] += w001*q;
+            kk[v] += w000*u_adm(m,ikxx+v,k,j,i);
+          }
+        }
+      }
+    }
+    // map (a,b) to symmetric index
+    const int sidx[9] = {0, 1, 2, 1, 3, 4, 2, 4, 5};
+    Real gdd[3][3], kdd[3][3], dgddd[3][3][3];
+    for (int a=0; a<3; ++a) {
+      for (int b=0; b<3; ++b) {
+        gdd[a][b] = g[sidx[3*a+b]];
+        kdd[a][b] = kk[sidx[3*a+b]];
+        for (int c=0; c<3; ++c) {
+          dgddd[c][a][b] = dg[c][sidx[3*a+b]];
+        }
+      }
+    }
+    // inverse metric
+    Real det = gdd[0][0]*(gdd[1][1]*gdd[2][2] - gdd[1][2]*gdd[2][1])
+             - gdd[0][1]*(gdd[1][0]*gdd[2][2] - gdd[1][2]*gdd[2][0])
+             + gdd[0][2]*(gdd[1][0]*gdd[2][1] - gdd[1][1]*gdd[2][0]);
+    Real guu[3][3];
+    guu[0][0] = (gdd[1][1]*gdd[2][2] - gdd[1][2]*gdd[2][1])/det;
+    guu[0][1] = (gdd[0][2]*gdd[2][1] - gdd[0][1]*gdd[2][2])/det;
+    guu[0][2] = (gdd[0][1]*gdd[1][2] - gdd[0][2]*gdd[1][1])/det;
+    guu[1][1] = (gdd[0][0]*gdd[2][2] - gdd[0][2]*gdd[2][0])/det;
+    guu[1][2] = (gdd[0][2]*gdd[1][0] - gdd[0][0]*gdd[1][2])/det;
+    guu[2][2] = (gdd[0][0]*gdd[1][1] - gdd[0][1]*gdd[1][0])/det;
+    guu[1][0] = guu[0][1];
+    guu[2][0] = guu[0][2];
+    guu[2][1] = guu[1][2];
+
+    // first and second Cartesian derivatives of F = r - h(theta,phi) on the surface
+    const Real r = h;
+    Real dth[3], dph[3], dF[3], ddF[3][3];
+    for (int a=0; a<3; ++a) {
+      dth[a] = et[a]/r;
+      dph[a] = ep[a]/(r*sint);
+      dF[a] = nr[a] - h_t*dth[a] - h_p*dph[a];
+    }
+    for (int a=0; a<3; ++a) {
+      for (int b=0; b<3; ++b) {
+        Real ddr = ((a == b)? 1.0 : 0.0)/r - nr[a]*nr[b]/r;
+        Real ddth = (-nr[a]*et[b] - et[a]*nr[b] + cost/sint*ep[a]*ep[b])/(r*r);
+        Real ddph = -((sint*nr[a] + cost*et[a])*ep[b] + ep[a]*(sint*nr[b] + cost*et[b]))
+                    /(r*r*sint*sint);
+        ddF[a][b] = ddr - (h_t*ddth + h_p*ddph + h_tt*dth[a]*dth[b]
+                           + h_tp*(dth[a]*dph[b] + dph[a]*dth[b]) + h_pp*dph[a]*dph[b]);
+      }
+    }
+
+    // unit normal s^i and projector g^ij - s^i s^j
+    Real dFu[3], norm2 = 0.0;
+    for (int a=0; a<3; ++a) {
+      dFu[a] = guu[a][0]*dF[0] + guu[a][1]*dF[1] + guu[a][2]*dF[2];
+      norm2 += dFu[a]*dF[a];
+    }
+    const Real norm = sqrt(norm2);
+    Real proj[3][3];
+    for (int a=0; a<3; ++a) {
+      for (int b=0; b<3; ++b) {
+        proj[a][b] = guu[a][b] - dFu[a]*dFu[b]/norm2;
+      }
+    }
+
+    // expansion Theta = (g^ij - s^i s^j)(D_i D_j F/|dF| - K_ij)
+    Real theta = 0.0, trproj = 0.0;
+    for (int a=0; a<3; ++a) {
+      trproj += proj[a][a];
+      for (int b=0; b<3; ++b) {
+        // Gamma^k_ab dF_k = Gamma_cab g^ck dF_k
+        Real gam = 0.0;
+        for (int c=0; c<3; ++c) {
+          gam += 0.5*(dgddd[a][c][b] + dgddd[b][c][a] - dgddd[c][a][b])*dFu[c];
+        }
+        theta += proj[a][b]*((ddF[a][b] - gam)/norm - kdd[a][b]);
+      }
+    }
+
+    // area element per unit solid angle, from the induced metric on (theta,phi)
+    Real xt[3], xp[3];
+    for (int a=0; a<3; ++a) {
+      xt[a] = h_t*nr[a] + h*et[a];
+      xp[a] = h_p*nr[a] + h*sint*ep[a];
+    }
+    Real qtt = 0.0, qtp = 0.0, qpp = 0.0;
+    for (int a=0; a<3; ++a) {
+      for (int b=0; b<3; ++b) {
+        qtt += gdd[a][b]*xt[a]*xt[b];
+        qtp += gdd[a][b]*xt[a]*xp[b];
+        qpp += gdd[a][b]*xp[a]*xp[b];
+      }
+    }
+
+    vals.d_view(p,0) = theta;
+    vals.d_view(p,1) = 2.0*h*h*norm/trproj;
+    vals.d_view(p,2) = sqrt(fmax(qtt*qpp - qtp*qtp, 0.0))/sint;
+    vals.d_view(p,3) = 1.0;
+  });
+  pt_vals.template modify<DevExeSpace>();
+  pt_vals.template sync<HostMemSpace>();
+#if MPI_PARALLEL_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE, pt_vals.h_view.data(), 4*npts, MPI_ATHENA_REAL, MPI_SUM,
+                global_variable::mpi_comm);
+#endif
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void HorizonFinder::Find
+//! \brief run the fast flow from the last horizon found (or the initial guess), and
+//! write the result.  Must be called on all ranks.
+
+void HorizonFinder::Find(int ncycle, Real time,
+                         std::list<CompactObjectTracker> &trackers) {
+  if (!(SearchDue(ncycle))) return;
+
+  // follow a compact object tracker, if requested
+  if (tracker >= 0) {
+    int n = 0;
+    for (auto &pt : trackers) {
+      if (n == tracker) {
+        center[0] = pt.GetPos(0);
+        center[1] = pt.GetPos(1);
+        center[2] = pt.GetPos(2);
+      }
+      n++;
+    }
+  }
+
+  const Real flow_a = flow_alpha/(lmax*(lmax + 1.0)+1.0e-300) + flow_beta;
+  const Real flow_b = flow_beta/flow_alpha;
+  bool converged = false, failed = false;
+  int iter = 0;
+  for (iter=1; iter<=max_iter && !(converged) && !(failed); ++iter) {
+    SetSurface();
+    for (int p=0; p<npts; ++p) {
+      if (!(surf.h_view(p,0) > 0.0)) {failed = true;}
+    }
+    if (failed) break;
+    Expansion();
+
+    // spectral coefficients of rho*Theta, and fast-flow update
+    for (int p=0; p<npts; ++p) {
+      if (pt_vals.h_view(p,3) < 0.5 || !std::isfinite(pt_vals.h_view(p,0))) {
+        failed = true;
+      }
+    }
+    if (failed) break;
+    Real da00 = 0.0;
+    for (int l=0; l<=lmax; ++l) {
+      for (int m=-l; m<=l; ++m) {
+        int lm = l*(l+1) + m;
+        Real f_lm = 0.0;
+        for (int p=0; p<npts; ++p) {
+          f_lm += quad_wght(p)*pt_vals.h_view(p,0)*pt_vals.h_view(p,1)*ylm(0,lm,p);
+        }
+        Real da = flow_a/(1.0 + flow_b*l*(l + 1.0))*f_lm;
+        a_lm(lm) -= da;
+        if (lm == 0) {da00 = da;}
+      }
+    }
+    if (std::abs(da00)/std::sqrt(4.0*M_PI) < hmean_tol) {converged = true;}
+  }
+
+  found = converged && !(failed);
+  if (found) {
+    // properties from the last surface on which the expansion was evaluated
+    area = 0.0;
+    rmin = surf.h_view(0,0);
+    rmax = surf.h_view(0,0);
+    rmean = a_lm(0)/std::sqrt(4.0*M_PI);
+    for (int p=0; p<npts; ++p) {
+      area += quad_wght(p)*pt_vals.h_view(p,2);
+      rmin = std::min(rmin, surf.h_view(p,0));
+      rmax = std::max(rmax, surf.h_view(p,0));
+    }
+    mass = std::sqrt(area/(16.0*M_PI));
+  } else {
+    ResetSurface();
+  }
+
+  if (0 == global_variable::my_rank) {
+    ofile << ncycle << " " << time << " " << static_cast<int>(found) << " "
+          << ((found)? mass : 0.0) << " " << ((found)? area : 0.0) << " "
+          << ((found)? rmean : 0.0) << " " << ((found)? rmin : 0.0) << " "
+          << ((found)? rmax : 0.0) << " " << center[0] << " " << center[1] << " "
+          << center[2] << " " << iter - 1 << std::endl << std::flush;
+  }
+}
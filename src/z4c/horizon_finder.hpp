@@ -0,0 +1,71 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file horizon_finder.hpp
+//! \brief in-situ apparent horizon finder using the fast-flow algorithm of Gundlach
+//! (1998, PRD 57, 863)
+
+#ifndef Z4C_HORIZON_FINDER_HPP_
+#define Z4C_HORIZON_FINDER_HPP_
+
+#include <fstream>
+#include <list>
+#include <string>
+
+#include "athena.hpp"
+
+// Forward declarations
+class MeshBlockPack;
+class ParameterInput;
+class CompactObjectTracker;
+
+//! \class HorizonFinder
+//! \brief Finds a single apparent horizon, parametrized as r = h(theta,phi) about a
+//! center and expanded in real spherical harmonics up to lmax.  The expansion of the
+//! surface is computed on the device at ntheta x nphi (Gauss-Legendre x uniform) points
+//! from the ADM variables, which are interpolated (with their derivatives) directly from
+//! the MeshBlocks containing each point.
+class HorizonFinder {
+ public:
+  //! Initialize horizon finder n
+  HorizonFinder(MeshBlockPack *pmbp, ParameterInput *pin, int n);
+  //! Destructor (will close output file)
+  ~HorizonFinder() = default;
+  //! Search for the horizon (if due on this cycle), and write the result to file
+  void Find(int ncycle, Real time, std::list<CompactObjectTracker> &trackers);
+  //! True if a search is made on this cycle
+  bool SearchDue(int ncycle) const {return (ncycle % every == 0);}
+
+  // properties of the horizon found in the last search
+  bool found;
+  Real area, mass;               // area and irreducible mass
+  Real rmin, rmean, rmax;        // minimum, mean and maximum coordinate radius
+  Real center[3];                // center of the surface
+
+ private:
+  MeshBlockPack *pmy_pack;
+  int every;                     // cycles between searches
+  int tracker;                   // compact object tracker used as center (-1 for none)
+  int lmax, nlm;                 // max multipole, and number of spectral coefficients
+  int ntheta, nphi, npts;        // number of points on surface
+  int max_iter;                  // maximum number of fast-flow iterations
+  Real flow_alpha, flow_beta;    // fast-flow parameters
+  Real hmean_tol;                // tolerance on change of mean radius per iteration
+  Real initial_radius;           // radius of sphere used as initial guess
+  HostArray1D<Real> a_lm;        // spectral coefficients of h
+  HostArray1D<Real> quad_wght;   // quadrature weights of points
+  HostArray3D<Real> ylm;         // Y_lm and angular derivatives at points
+  DualArray2D<Real> angles;      // (theta,phi) of points
+  DualArray2D<Real> surf;        // h and its angular derivatives at points
+  DualArray1D<int> pt_mb;        // MeshBlock containing point (-1 if not on this rank)
+  DualArray2D<Real> pt_vals;     // expansion, flow weight, area element, owner flag
+  std::ofstream ofile;
+
+  void SetSurface();
+  void Expansion();
+  void ResetSurface();
+};
+
+#endif // Z4C_HORIZON_FINDER_HPP_
@@ -13,6 +13,7 @@
 #include <string>
 #include <algorithm>
 #include <memory>    // make_unique, unique_ptr
+#include <utility>   // swap
 #include <vector>    // vector
 #include <Kokkos_Core.hpp>
 
@@ -21,8 +22,10 @@
 #include "mesh/mesh.hpp"
 #include "bvals/bvals.hpp"
 #include "z4c/compact_object_tracker.hpp"
+#include "z4c/horizon_finder.hpp"
 #include "z4c/z4c.hpp"
 #include "z4c/z4c_amr.hpp"
+#include "z4c/z4c_algconstr.hpp"
 #include "coordinates/adm.hpp"
 
 namespace z4c {
@@ -78,42 +81,33 @@ Z4c::Z4c(MeshBlockPack *ppack, ParameterInput *pin) :
   int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
   int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
   Kokkos::Profiling::pushRegion("Tensor fields");
-  Kokkos::realloc(u_con, nmb, (ncon), ncells3, ncells2, ncells1);
+  // with con_norms_only the constraint fields are only allocated (and computed) when an
+  // output needs them, and the norms in the history file are reduced without them
+  con_norms_only = pin->GetOrAddBoolean("z4c", "con_norms_only", false);
+  con_allocated = false;
+  if (!(con_norms_only)) {
+    AllocateConstraints();
+  }
   // Matter commented out
   // kokkos::realloc(u_mat, nmb, (N_MAT), ncells3, ncells2, ncells1);
   Kokkos::realloc(u0,    nmb, (nz4c), ncells3, ncells2, ncells1);
-  Kokkos::realloc(u1,    nmb, (nz4c), ncells3, ncells2, ncells1);
+  // 2N low-storage integrators accumulate stages in u_rhs and do not need u1
+  std::string integrator = "rk2";
+  if (evolution_t.compare("static") != 0) {
+    integrator = pin->GetOrAddString("time", "integrator", "rk2");
+  }
+  if (integrator.compare("lsrk3") != 0 && integrator.compare("lsrk4") != 0) {
+    Kokkos::realloc(u1,    nmb, (nz4c), ncells3, ncells2, ncells1);
+  }
   Kokkos::realloc(u_rhs, nmb, (nz4c), ncells3, ncells2, ncells1);
   Kokkos::realloc(u_weyl,    nmb, (2), ncells3, ncells2, ncells1);
 
-  con.C.InitWithShallowSlice(u_con, I_CON_C);
-  con.H.InitWithShallowSlice(u_con, I_CON_H);
-  con.M.InitWithShallowSlice(u_con, I_CON_M);
-  con.Z.InitWithShallowSlice(u_con, I_CON_Z);
-  con.M_d.InitWithShallowSlice(u_con, I_CON_MX, I_CON_MZ);
-
   // Matter commented out
   //mat.rho.InitWithShallowSlice(u_mat, I_MAT_rho);
   //mat.S_d.InitWithShallowSlice(u_mat, I_MAT_Sx, I_MAT_Sz);
   //mat.S_dd.InitWithShallowSlice(u_mat, I_MAT_Sxx, I_MAT_Szz);
 
-  z4c.alpha.InitWithShallowSlice (u0, I_Z4C_ALPHA);
-  z4c.beta_u.InitWithShallowSlice(u0, I_Z4C_BETAX, I_Z4C_BETAZ);
-  z4c.chi.InitWithShallowSlice   (u0, I_Z4C_CHI);
-  z4c.vKhat.InitWithShallowSlice  (u0, I_Z4C_KHAT);
-  z4c.vTheta.InitWithShallowSlice (u0, I_Z4C_THETA);
-  z4c.vGam_u.InitWithShallowSlice (u0, I_Z4C_GAMX, I_Z4C_GAMZ);
-  z4c.g_dd.InitWithShallowSlice  (u0, I_Z4C_GXX, I_Z4C_GZZ);
-  z4c.vA_dd.InitWithShallowSlice  (u0, I_Z4C_AXX, I_Z4C_AZZ);
-
-  rhs.alpha.InitWithShallowSlice (u_rhs, I_Z4C_ALPHA);
-  rhs.beta_u.InitWithShallowSlice(u_rhs, I_Z4C_BETAX, I_Z4C_BETAZ);
-  rhs.chi.InitWithShallowSlice   (u_rhs, I_Z4C_CHI);
-  rhs.vKhat.InitWithShallowSlice  (u_rhs, I_Z4C_KHAT);
-  rhs.vTheta.InitWithShallowSlice (u_rhs, I_Z4C_THETA);
-  rhs.vGam_u.InitWithShallowSlice (u_rhs, I_Z4C_GAMX, I_Z4C_GAMZ);
-  rhs.g_dd.InitWithShallowSlice  (u_rhs, I_Z4C_GXX, I_Z4C_GZZ);
-  rhs.vA_dd.InitWithShallowSlice  (u_rhs, I_Z4C_AXX, I_Z4C_AZZ);
+  SetShallowSlices();
 
   weyl.rpsi4.InitWithShallowSlice (u_weyl, 0);
   weyl.ipsi4.InitWithShallowSlice (u_weyl, 1);
@@ -144,11 +138,102 @@ Z4c::Z4c(MeshBlockPack *ppack, ParameterInput *pin) :
   opt.extrap_order = fmax(2,fmin(indcs.ng,fmin(4,
       pin->GetOrAddInteger("z4c", "extrap_order", 2))));
 
-  diss = opt.diss*pow(2., -2.*indcs.ng)*(indcs.ng % 2 == 0 ? -1. : 1.);
+  // Multirate integration: the spacetime takes steps of up to multirate_ratio matter
+  // timesteps, limited by multirate_cfl (default: <time>/cfl_number) instead
+  multirate_ratio = pin->GetOrAddInteger("z4c", "multirate_ratio", 1);
+  multirate_cfl = pin->GetOrAddReal("z4c", "multirate_cfl", -1.0);
+  if (multirate_ratio < 1) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "<z4c>/multirate_ratio must be >= 1" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  spacetime_step = false;
+  st_time = 0.0;
+  st_dt = 0.0;
+  st_nghbr_version = -1;
+  sbc_nfaces = 0;
+  sbc_version = -1;
+
+  // Communication-avoiding (wide-halo) mode: ghost zones are exchanged only every
+  // halo_interval stages, and the RHS is computed redundantly in the ghost zones in
+  // between.  The finite-difference stencils then use only nghost/halo_interval zones.
+  halo_interval = pin->GetOrAddInteger("z4c", "halo_exchange_interval", 1);
+  fd_ng = indcs.ng;
+  if (halo_interval < 1) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "<z4c>/halo_exchange_interval must be >= 1" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  if (halo_interval > 1) {
+    fd_ng = indcs.ng/halo_interval;
+    if (fd_ng < 2) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<z4c>/halo_exchange_interval=" << halo_interval
+                << " requires nghost >= " << 2*halo_interval << ", but nghost="
+                << indcs.ng << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    bool all_periodic = true;
+    for (int f=0; f<6; ++f) {
+      if (pmy_pack->pmesh->mesh_bcs[f] != BoundaryFlag::periodic) {all_periodic = false;}
+    }
+    if (pmy_pack->pmesh->multilevel || !(all_periodic)) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<z4c>/halo_exchange_interval > 1 is only supported on "
+                << "uniform meshes with periodic boundaries" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+  }
+
+  diss = opt.diss*pow(2., -2.*fd_ng)*(fd_ng % 2 == 0 ? -1. : 1.);
+
+  // RHS computed from tiles of u0 staged one field at a time in team scratch memory
+  tiled_rhs = pin->GetOrAddBoolean("z4c", "tiled_rhs", false);
+  if (tiled_rhs) {
+    rhs_tile_nx1 = pin->GetOrAddInteger("z4c", "rhs_tile_nx1", 4);
+    rhs_tile_nx2 = pin->GetOrAddInteger("z4c", "rhs_tile_nx2", 4);
+    rhs_tile_nx3 = pin->GetOrAddInteger("z4c", "rhs_tile_nx3", 4);
+    rhs_scr_level = pin->GetOrAddInteger("z4c", "rhs_scratch_level", 1);
+    if (rhs_tile_nx1 < 1 || rhs_tile_nx2 < 1 || rhs_tile_nx3 < 1) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<z4c>/rhs_tile_nx1, rhs_tile_nx2 and rhs_tile_nx3 "
+                << "must be positive" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    if (rhs_scr_level < 0 || rhs_scr_level > 1) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<z4c>/rhs_scratch_level must be 0 or 1" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    if (!(pmy_pack->pmesh->three_d)) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<z4c>/tiled_rhs requires a 3D mesh" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
   }
 
-  // allocate memory for conserved variables on coarse mesh
-  if (ppack->pmesh->multilevel) {
+  // RK update (and algebraic constraints) applied in the RHS kernel, which writes the
+  // new state into u_rhs.  u0 and u_rhs are then swapped (see SwapURHS).
+  fused_update = pin->GetOrAddBoolean("z4c", "fused_update", false);
+  if (fused_update) {
+    if (integrator.compare("lsrk3") == 0 || integrator.compare("lsrk4") == 0 ||
+        evolution_t.compare("static") == 0) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<z4c>/fused_update requires an SSP RK integrator, "
+                << "but integrator=" << integrator << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    if (tiled_rhs || halo_interval > 1) {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<z4c>/fused_update cannot be combined with tiled_rhs "
+                << "or halo_exchange_interval > 1" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+  }
+  }
+
+  // allocate memory for conserved variables on coarse mesh (only if used on this rank)
+  if (ppack->pmesh->multilevel && ppack->pmb->need_coarse) {
     auto &indcs = pmy_pack->pmesh->mb_indcs;
     int nccells1 = indcs.cnx1 + 2*(indcs.ng);
     int nccells2 = (indcs.cnx2 > 1)? (indcs.cnx2 + 2*(indcs.ng)) : 1;
@@ -161,8 +246,12 @@ Z4c::Z4c(MeshBlockPack *ppack, ParameterInput *pin) :
   // allocate boundary buffers for conserved (cell-centered) variables
   Kokkos::Profiling::pushRegion("Buffers");
   pbval_u = new MeshBoundaryValuesCC(ppack, pin, true);
+  pbval_u->comm_module = comm_stats::Module::z4c;
+  pbval_u->SetHaloPrecision(pin, "z4c");
   pbval_u->InitializeBuffers((nz4c));
   pbval_weyl = new MeshBoundaryValuesCC(ppack, pin, true);
+  pbval_weyl->comm_module = comm_stats::Module::z4c;
+  pbval_weyl->SetHaloPrecision(pin, "z4c");
   pbval_weyl->InitializeBuffers((2));
   Kokkos::Profiling::popRegion();
 
@@ -178,9 +267,21 @@ Z4c::Z4c(MeshBlockPack *ppack, ParameterInput *pin) :
   }
   // TODO(@dur566): Why is the size of psi_out hardcoded?
   psi_out = new Real[nrad*77*2];
+  psi_sum = new Real[nrad*77*2];
+  psi_pending = false;
+  SetWaveExtrBasis();
   mkdir("waveforms",0775);
   waveform_dt = pin->GetOrAddReal("z4c", "waveform_dt", 1);
   last_output_time = 0;
+  // compute psi4 only on MeshBlocks near the extraction spheres; set false to output
+  // the Weyl scalars over the whole mesh
+  weyl_spheres_only = pin->GetOrAddBoolean("z4c", "weyl_spheres_only", true);
+
+  // In vacuum the ADM variables and constraints are computed only when a consumer
+  // (output, tracker, horizon finder, wave extraction) requires them
+  lazy_adm = pin->GetOrAddBoolean("z4c", "lazy_adm", true);
+  adm_current = false;
+  con_current = false;
 
   // Construct the compact object trackers
   int n = 0;
@@ -192,14 +293,87 @@ Z4c::Z4c(MeshBlockPack *ppack, ParameterInput *pin) :
       break;
     }
   }
+
+  // Construct the apparent horizon finders
+  int nhorizons = pin->GetOrAddInteger("z4c", "nhorizons", 0);
+  for (int nh=0; nh<nhorizons; ++nh) {
+    phorizons.emplace_back(pmy_pack, pin, nh);
+  }
+
+  // register chi/dchi refinement criteria (if used) with mesh refinement
+  if (pmy_pack->pmesh->adaptive) {
+    pamr->AddRefinementCriteria(pmy_pack->pmesh, &u0);
+  }
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Z4c::AllocateConstraints()
+//! \brief Allocates u_con and sets the constraint tensors as slices of it
+
+void Z4c::AllocateConstraints() {
+  int nmb = std::max((pmy_pack->nmb_thispack), (pmy_pack->pmesh->nmb_maxperrank));
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  int ncells1 = indcs.nx1 + 2*(indcs.ng);
+  int ncells2 = (indcs.nx2 > 1)? (indcs.nx2 + 2*(indcs.ng)) : 1;
+  int ncells3 = (indcs.nx3 > 1)? (indcs.nx3 + 2*(indcs.ng)) : 1;
+  Kokkos::realloc(u_con, nmb, (ncon), ncells3, ncells2, ncells1);
+
+  con.C.InitWithShallowSlice(u_con, I_CON_C);
+  con.H.InitWithShallowSlice(u_con, I_CON_H);
+  con.M.InitWithShallowSlice(u_con, I_CON_M);
+  con.Z.InitWithShallowSlice(u_con, I_CON_Z);
+  con.M_d.InitWithShallowSlice(u_con, I_CON_MX, I_CON_MZ);
+  con_allocated = true;
+  con_current = false;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Z4c::SetShallowSlices()
+//! \brief points the tensor fields in z4c and rhs to the current u0 and u_rhs
+
+void Z4c::SetShallowSlices() {
+  z4c.alpha.InitWithShallowSlice (u0, I_Z4C_ALPHA);
+  z4c.beta_u.InitWithShallowSlice(u0, I_Z4C_BETAX, I_Z4C_BETAZ);
+  z4c.chi.InitWithShallowSlice   (u0, I_Z4C_CHI);
+  z4c.vKhat.InitWithShallowSlice  (u0, I_Z4C_KHAT);
+  z4c.vTheta.InitWithShallowSlice (u0, I_Z4C_THETA);
+  z4c.vGam_u.InitWithShallowSlice (u0, I_Z4C_GAMX, I_Z4C_GAMZ);
+  z4c.g_dd.InitWithShallowSlice  (u0, I_Z4C_GXX, I_Z4C_GZZ);
+  z4c.vA_dd.InitWithShallowSlice  (u0, I_Z4C_AXX, I_Z4C_AZZ);
+
+  rhs.alpha.InitWithShallowSlice (u_rhs, I_Z4C_ALPHA);
+  rhs.beta_u.InitWithShallowSlice(u_rhs, I_Z4C_BETAX, I_Z4C_BETAZ);
+  rhs.chi.InitWithShallowSlice   (u_rhs, I_Z4C_CHI);
+  rhs.vKhat.InitWithShallowSlice  (u_rhs, I_Z4C_KHAT);
+  rhs.vTheta.InitWithShallowSlice (u_rhs, I_Z4C_THETA);
+  rhs.vGam_u.InitWithShallowSlice (u_rhs, I_Z4C_GAMX, I_Z4C_GAMZ);
+  rhs.g_dd.InitWithShallowSlice  (u_rhs, I_Z4C_GXX, I_Z4C_GZZ);
+  rhs.vA_dd.InitWithShallowSlice  (u_rhs, I_Z4C_AXX, I_Z4C_AZZ);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Z4c::SwapURHS()
+//! \brief exchanges u0 and u_rhs after the fused RHS/update kernel has written the new
+//! state into u_rhs, and updates all shallow slices of u0 (including the lapse and shift
+//! in the ADM variables).  Ghost zones of the new u0 are undefined until exchanged.
+
+void Z4c::SwapURHS() {
+  std::swap(u0, u_rhs);
+  SetShallowSlices();
+  if (pmy_pack->padm != nullptr) {
+    auto &adm = pmy_pack->padm->adm;
+    adm.alpha.InitWithShallowSlice(u0, I_Z4C_ALPHA);
+    adm.beta_u.InitWithShallowSlice(u0, I_Z4C_BETAX, I_Z4C_BETAZ);
+  }
 }
 
 //----------------------------------------------------------------------------------------
 //! \fn void Z4c::AlgConstr(AthenaArray<Real> & u)
 //! \brief algebraic constraints projection
 //
-// This function operates on all grid points of the MeshBlock
-void Z4c::AlgConstr(MeshBlockPack *pmbp) {
+// This function operates on all grid points of the MeshBlock, or only on the ghost
+// zones if ghosts_only=true (the active zones were projected by the fused RHS kernel)
+void Z4c::AlgConstr(MeshBlockPack *pmbp, bool ghosts_only) {
   // capture variables for the kernel
   auto &indcs = pmbp->pmesh->mb_indcs;
   int &is = indcs.is; int &ie = indcs.ie;
@@ -216,39 +390,18 @@ void Z4c::AlgConstr(MeshBlockPack *pmbp) {
   par_for("Alg constr loop",DevExeSpace(),
   0,nmb-1,ksg,keg,jsg,jeg,isg,ieg,
   KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
-    Real detg = adm::SpatialDet(z4c.g_dd(m,0,0,k,j,i), z4c.g_dd(m,0,1,k,j,i),
-                              z4c.g_dd(m,0,2,k,j,i),z4c.g_dd(m,1,1,k,j,i),
-                              z4c.g_dd(m,1,2,k,j,i), z4c.g_dd(m,2,2,k,j,i));
-    detg = detg > 0. ? detg : 1.;
-    // Real eps = detg - 1.;
-    // Real oopsi4 = (eps < opt.eps_floor) ? (1. - opt.eps_floor/3.) :
-    //             (std::pow(1./detg, 1./3.));
-    Real oopsi4 = std::cbrt(1./detg);
-
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b) {
-      z4c.g_dd(m,a,b,k,j,i) *= oopsi4;
-    }
-
-    // compute trace of A
-    // note: here we are assuming that det g = 1, which we enforced above
-    Real A = adm::Trace(1.0,
-              z4c.g_dd(m,0,0,k,j,i), z4c.g_dd(m,0,1,k,j,i), z4c.g_dd(m,0,2,k,j,i),
-              z4c.g_dd(m,1,1,k,j,i), z4c.g_dd(m,1,2,k,j,i), z4c.g_dd(m,2,2,k,j,i),
-              z4c.vA_dd(m,0,0,k,j,i), z4c.vA_dd(m,0,1,k,j,i), z4c.vA_dd(m,0,2,k,j,i),
-              z4c.vA_dd(m,1,1,k,j,i), z4c.vA_dd(m,1,2,k,j,i), z4c.vA_dd(m,2,2,k,j,i));
-
-    // enforce trace of A to be zero
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b) {
-      z4c.vA_dd(m,a,b,k,j,i) -= (1.0/3.0) * A * z4c.g_dd(m,a,b,k,j,i);
+    if (ghosts_only && i >= is && i <= ie && j >= js && j <= je && k >= ks && k <= ke) {
+      return;
     }
+    Z4cAlgConstrCell(z4c, m, k, j, i);
   });
 }
 //----------------------------------------------------------------------------------------
 // destructor
 Z4c::~Z4c() {
+  FinishWaveExtr();
   delete[] psi_out;
+  delete[] psi_sum;
   delete pbval_u;
   delete pbval_weyl;
   delete pamr;
@@ -26,6 +26,7 @@
 class Coordinates;
 class Driver;
 class CompactObjectTracker;
+class HorizonFinder;
 
 //----------------------------------------------------------------------------------------
 //! \struct Z4cTaskIDs
@@ -198,6 +199,32 @@ class Z4c {
   };
   Options opt;
   Real diss;              // Dissipation parameter
+  int halo_interval;      // number of RK stages between ghost-zone exchanges
+  int fd_ng;              // ghost zones used by finite-difference stencils
+  // following used for multirate integration, in which the spacetime is advanced over
+  // a step spanning up to multirate_ratio matter timesteps (see z4c_multirate.cpp)
+  int multirate_ratio;      // max number of matter timesteps per spacetime step
+  Real multirate_cfl;       // CFL number of spacetime steps
+  bool spacetime_step;      // true if a new spacetime step starts in this cycle
+  Real st_time, st_dt;      // start time and length of current spacetime step
+  int st_nghbr_version;     // mesh version when current spacetime step started
+  DvceArray5D<Real> adm_old, adm_new;   // ADM variables at start and end of that step
+  // following used to compute the RHS from tiles of u0 held in team scratch memory
+  bool tiled_rhs = false;   // flag to enable tiled RHS kernel
+  int rhs_tile_nx1, rhs_tile_nx2, rhs_tile_nx3;  // number of active cells in each tile
+  int rhs_scr_level;        // scratch memory level used by tiled RHS kernel
+  // following used to apply the RK update and algebraic constraints in the RHS kernel
+  bool fused_update;        // flag to enable fused RHS/update kernel
+  // following used to compute the ADM variables and constraints only when needed
+  bool lazy_adm;            // flag to defer ADM variables/constraints until used
+  bool adm_current;         // true if u_adm holds the ADM variables of u0
+  bool con_current;         // true if u_con holds the constraints of u0
+  bool con_norms_only;      // flag to reduce history norms without storing u_con
+  bool con_allocated;       // true once u_con is allocated with full size
+  // MeshBlock faces (6*m + face) at which the Sommerfeld condition is applied
+  DualArray1D<int> sbc_faces;
+  int sbc_nfaces;           // number of entries of sbc_faces in use
+  int sbc_version;          // MeshBlock neighbor version when sbc_faces was set
 
   // Boundary communication buffers and functions for u
   MeshBoundaryValuesCC *pbval_u;
@@ -214,9 +241,19 @@ class Z4c {
   std::vector<std::unique_ptr<SphericalGrid>> spherical_grids;
   // array storing waveform at each radii
   Real * psi_out;
+  Real * psi_sum;     // waveform reduced to rank 0
+  Real psi_time;      // time at which waveform in flight was extracted
+  bool psi_pending;   // true while the (non-blocking) waveform reduction is in flight
+  DvceArray3D<Real> wave_ylm;  // (lm,re/im,angle): solid angle * spin -2 harmonic
+  DualArray3D<Real> wave_psi;  // (radius,lm,re/im): modes of psi4 on this rank
+#if MPI_PARALLEL_ENABLED
+  MPI_Request psi_req;
+#endif
   Real waveform_dt;
   Real last_output_time;
   int nrad; // number of radii to perform wave extraction
+  bool weyl_spheres_only;     // if true, psi4 is only computed near extraction spheres
+  DualArray1D<int> weyl_mask; // flags MeshBlocks on which psi4 is computed
 
   // functions
   void QueueZ4cTasks();
@@ -242,27 +279,52 @@ class Z4c {
   TaskStatus UpdateExcisionMasks(Driver *d, int stage);
   TaskStatus ADMConstraints_(Driver *d, int stage);
   TaskStatus Z4cBoundaryRHS(Driver *d, int stage);
+  void SetSommerfeldFaces();
   TaskStatus RestrictU(Driver *d, int stage);
   TaskStatus RestrictWeyl(Driver *d, int stage);
   TaskStatus TrackCompactObjects(Driver *d, int stage);
+  TaskStatus FindHorizons(Driver *d, int stage);
   TaskStatus CalcWeylScalar(Driver *d, int stage);
   TaskStatus CalcWaveForm(Driver *d, int stage);
 
+  TaskStatus InterpolateADM(Driver *d, int stage);
+  void SpacetimeTimeStep(Real time, Real &dt, Real tlim);
+  void BeginSpacetimeStep();
+  void EndSpacetimeStep();
+
+  bool HaloExchangeStage(Driver *d, int stage);
+  int HaloUpdateWidth(Driver *d, int stage);
+
   template <int NGHOST>
   TaskStatus CalcRHS(Driver *d, int stage);
   template <int NGHOST>
+  void CalcRHSTiled(Driver *d, int stage, int is, int ie, int js, int je, int ks, int ke);
+  template <int NGHOST>
   void ADMToZ4c(MeshBlockPack *pmbp, ParameterInput *pin);
   void GaugePreCollapsedLapse(MeshBlockPack *pmbp, ParameterInput *pin);
   void Z4cToADM(MeshBlockPack *pmbp);
+  void UpdateADM();
+  void UpdateConstraints();
+  void ConstraintNorms(Real norms[]);
+  void AllocateConstraints();
   template <int NGHOST>
   void ADMConstraints(MeshBlockPack *pmbp);
   template <int NGHOST>
+  void ADMConstraintNorms(MeshBlockPack *pmbp, Real norms[]);
+  template <int NGHOST>
   void Z4cWeyl(MeshBlockPack *pmbp);
+  void SetWeylMask();
   void WaveExtr(MeshBlockPack *pmbp);
-  void AlgConstr(MeshBlockPack *pmbp);
+  void SetWaveExtrBasis();
+  void FinishWaveExtr();
+  void WriteWaveForm(Real time, Real *psi);
+  void AlgConstr(MeshBlockPack *pmbp, bool ghosts_only=false);
+  void SetShallowSlices();
+  void SwapURHS();
 
   Z4c_AMR *pamr;
   std::list<CompactObjectTracker> ptracker;
+  std::list<HorizonFinder> phorizons;
 
  private:
   MeshBlockPack* pmy_pack;  // ptr to MeshBlockPack containing this Z4c
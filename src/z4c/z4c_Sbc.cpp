@@ -4,7 +4,7 @@
 // Licensed under the 3-clause BSD License (the "LICENSE")
 //========================================================================================
 //! \file z4c_Sbc.cpp
-//! \brief placeholder for Sommerfeld boundary condition
+//! \brief Sommerfeld boundary condition
 
 #include <algorithm>
 #include <cinttypes>
@@ -13,251 +13,96 @@
 
 #include "athena.hpp"
 #include "mesh/mesh.hpp"
+#include "driver/driver.hpp"
 #include "z4c/z4c.hpp"
-#include "coordinates/cell_locations.hpp"
+#include "z4c/z4c_Sbc.hpp"
 
 namespace z4c {
 
 //----------------------------------------------------------------------------------------
-//! \fn void Z4c::Z4cSommerfeld
-//! \brief apply Sommerfeld BCs to the given set of points
-KOKKOS_INLINE_FUNCTION
-static void Z4cSommerfeld(const Z4c::Z4c_vars& z4c, const Z4c::Z4c_vars& rhs,
-    const RegionIndcs &indcs, const DualArray1D<RegionSize> &size,
-    const int m, const int k, const int j, const int i) {
-  // -------------------------------------------------------------------------------------
-  // Scratch data
-  //
+//! \fn void Z4c::SetSommerfeldFaces
+//! \brief Stores the list of MeshBlock faces (encoded as 6*m + face) at which the
+//! Sommerfeld condition is applied.  Rebuilt when MeshBlocks change (e.g. with AMR).
 
-  // First derivatives
-  // Scalars
-  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dKhat_d;
-  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dTheta_d;
-
-  // Vectors
-  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 2> dGam_du;
-
-  // Tensors
-  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> dA_ddd;
-
-
-  // Psuedoradial vector
-  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> s_u;
-
-  Real idx[] = {1./size.d_view(m).dx1, 1./size.d_view(m).dx2, 1./size.d_view(m).dx3};
-
-  // -------------------------------------------------------------------------------------
-  // First derivatives
-  // We force all derivatives to be calculated at second-order, as this was found to
-  // be necessary for stability in Athena++.
-  //
-  for (int a = 0; a < 3; a++) {
-    dKhat_d(a) = Dx<2>(a, idx, z4c.vKhat, m, k, j, i);
-    dTheta_d(a) = Dx<2>(a, idx, z4c.vTheta, m, k, j, i);
-  }
-  for (int a = 0; a < 3; a++) {
-    for (int b = 0; b < 3; b++) {
-      dGam_du(b,a) = Dx<2>(b, idx, z4c.vGam_u, m, a, k, j, i);
-    }
+void Z4c::SetSommerfeldFaces() {
+  auto &mb_bcs = pmy_pack->pmb->mb_bcs;
+  int nmb = pmy_pack->nmb_thispack;
+  if (static_cast<int>(sbc_faces.extent(0)) < 6*nmb) {
+    Kokkos::realloc(sbc_faces, 6*nmb);
   }
-  for (int a = 0; a < 3; a++) {
-    for (int b = a; b < 3; b++) {
-      for (int c = 0; c < 3; c++) {
-        dA_ddd(c, a, b) = Dx<2>(c, idx, z4c.vA_dd, m, a, b, k, j, i);
+  sbc_nfaces = 0;
+  for (int m=0; m<nmb; ++m) {
+    for (int f=0; f<6; ++f) {
+      if (Z4cSommerfeldFace(mb_bcs.h_view(m,f), opt.user_Sbc)) {
+        sbc_faces.h_view(sbc_nfaces++) = 6*m + f;
       }
     }
   }
+  sbc_faces.template modify<HostMemSpace>();
+  sbc_faces.template sync<DevExeSpace>();
+  sbc_version = pmy_pack->pmb->nghbr_version;
+}
 
-  // -------------------------------------------------------------------------------------
-  // Compute psuedo-radial vector
-  //
-  Real &x1min = size.d_view(m).x1min;
-  Real &x1max = size.d_view(m).x1max;
-  Real &x2min = size.d_view(m).x2min;
-  Real &x2max = size.d_view(m).x2max;
-  Real &x3min = size.d_view(m).x3min;
-  Real &x3max = size.d_view(m).x3max;
-
-  Real x1v = CellCenterX(i-indcs.is, indcs.nx1, x1min, x1max);
-  Real x2v = CellCenterX(j-indcs.js, indcs.nx2, x2min, x2max);
-  Real x3v = CellCenterX(k-indcs.ks, indcs.nx3, x3min, x3max);
-
-  Real r = sqrt(SQR(x1v) + SQR(x2v) + SQR(x3v));
-  s_u(0) = x1v/r;
-  s_u(1) = x2v/r;
-  s_u(2) = x3v/r;
-
-  // -------------------------------------------------------------------------------------
-  // Boundary RHS for scalars
-  //
-  rhs.vTheta(m,k,j,i) = - z4c.vTheta(m,k,j,i)/r;
-  rhs.vKhat(m,k,j,i) = - sqrt(2.) * z4c.vKhat(m,k,j,i)/r;
-  for (int a = 0; a < 3; a++) {
-    rhs.vTheta(m,k,j,i) -= s_u(a) * dTheta_d(a);
-    rhs.vKhat(m,k,j,i) -= sqrt(2.) * s_u(a) * dKhat_d(a);
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus Z4c::Z4cBoundaryRHS
+//! \brief Sommerfeld boundary conditions for z4c.  A single kernel loops over the faces
+//! in sbc_faces only, so MeshBlocks without outer physical boundaries cost nothing.
+//! Cells on edges/corners shared by two such faces are updated only by the face normal
+//! to the lowest direction.
+TaskStatus Z4c::Z4cBoundaryRHS(Driver *pdriver, int stage) {
+  // with low-storage integrators (or <z4c>/fused_update) the condition is applied
+  // inside the RHS kernel, before the RHS is accumulated into u_rhs (or u0 is updated)
+  if ((pdriver->low_storage || fused_update) && stage > 0) {
+    return TaskStatus::complete;
   }
 
-  // -------------------------------------------------------------------------------------
-  // Boundary RHS for Gamma
-  //
-  for (int a = 0; a < 3; a++) {
-    rhs.vGam_u(m,a,k,j,i) = - z4c.vGam_u(m, a, k, j, i)/r;
-    for (int b = 0; b < 3; b++) {
-      rhs.vGam_u(m,a,k,j,i) -= s_u(b) * dGam_du(b,a);
-    }
+  if (sbc_version != pmy_pack->pmb->nghbr_version) {
+    SetSommerfeldFaces();
   }
-
-  // -------------------------------------------------------------------------------------
-  // Boundary RHS for A_ab
-  //
-  for (int a = 0; a < 3; a++) {
-    for (int b = a; b < 3; b++) {
-      rhs.vA_dd(m,a,b,k,j,i) = - z4c.vA_dd(m,a,b,k,j,i)/r;
-      for (int c = 0; c < 3; c++) {
-        rhs.vA_dd(m,a,b,k,j,i) -= s_u(c) * dA_ddd(c,a,b);
-      }
-    }
+  // We only need to apply this condition for outflow boundaries
+  if (sbc_nfaces == 0) {
+    return TaskStatus::complete;
   }
-}
-
 
-//---------------------------------------------------------------------------------------
-//! \fn TaskStatus Z4c::Z4cBoundaryRHS
-//! \brief placeholder for the Sommerfield Boundary conditions for z4c
-TaskStatus Z4c::Z4cBoundaryRHS(Driver *pdriver, int stage) {
-  auto &pm = pmy_pack->pmesh;
   auto &mb_bcs = pmy_pack->pmb->mb_bcs;
   auto &indcs = pmy_pack->pmesh->mb_indcs;
   auto &size = pmy_pack->pmb->mb_size;
-
-  int nmb = pmy_pack->nmb_thispack;
-  int is = indcs.is;
-  int ie = indcs.ie;
-  int js = indcs.js;
-  int je = indcs.je;
-  int ks = indcs.ks;
-  int ke = indcs.ke;
+  auto stretch = pmy_pack->pmesh->stretch;
+  int is = indcs.is, ie = indcs.ie;
+  int js = indcs.js, je = indcs.je;
+  int ks = indcs.ks, ke = indcs.ke;
+  // each face is an (na x nb) array of cells: (k,j) for x1-faces, (k,i) for x2-faces,
+  // and (j,i) for x3-faces
+  int na = std::max(indcs.nx3, indcs.nx2);
+  int nb = std::max(indcs.nx2, indcs.nx1);
 
   auto &z4c_ = z4c;
   auto &rhs_ = rhs;
-  bool &user_Sbc = opt.user_Sbc;
-
-  // We only need to apply this condition for outflow boundaries
-  if (pm->mesh_bcs[BoundaryFace::inner_x1] == BoundaryFlag::outflow
-      || pm->mesh_bcs[BoundaryFace::inner_x1] == BoundaryFlag::diode
-      || pm->mesh_bcs[BoundaryFace::inner_x1] == BoundaryFlag::user
-      || pm->mesh_bcs[BoundaryFace::outer_x1] == BoundaryFlag::outflow
-      || pm->mesh_bcs[BoundaryFace::outer_x1] == BoundaryFlag::diode
-      || pm->mesh_bcs[BoundaryFace::outer_x1] == BoundaryFlag::user) {
-    par_for("z4crhs_bc_x1", DevExeSpace(), 0, (nmb-1), ks, ke, js, je,
-    KOKKOS_LAMBDA(int m, int k, int j) {
-      // Inner boundary
-      switch(mb_bcs.d_view(m,BoundaryFace::inner_x1)) {
-        case BoundaryFlag::diode:
-        case BoundaryFlag::outflow:
-            Z4cSommerfeld(z4c_, rhs_, indcs, size, m, k, j, is);
-          break;
-        case BoundaryFlag::user:
-            if (user_Sbc) {
-              Z4cSommerfeld(z4c_, rhs_, indcs, size, m, k, j, is);
-            }
-          break;
-        default:
-          break;
-      }
-      // Outer boundary
-      switch (mb_bcs.d_view(m,BoundaryFace::outer_x1)) {
-        case BoundaryFlag::diode:
-        case BoundaryFlag::outflow:
-            Z4cSommerfeld(z4c_, rhs_, indcs, size, m, k, j, ie);
-          break;
-        case BoundaryFlag::user:
-            if (user_Sbc) {
-              Z4cSommerfeld(z4c_, rhs_, indcs, size, m, k, j, ie);
-            }
-          break;
-        default:
-          break;
-      }
-    });
-  }
-  if (pm->mesh_bcs[BoundaryFace::inner_x2] == BoundaryFlag::outflow
-      || pm->mesh_bcs[BoundaryFace::inner_x2] == BoundaryFlag::diode
-      || pm->mesh_bcs[BoundaryFace::inner_x2] == BoundaryFlag::user
-      || pm->mesh_bcs[BoundaryFace::outer_x2] == BoundaryFlag::outflow
-      || pm->mesh_bcs[BoundaryFace::outer_x2] == BoundaryFlag::diode
-      || pm->mesh_bcs[BoundaryFace::outer_x2] == BoundaryFlag::user) {
-    par_for("z4crhs_bc_x2", DevExeSpace(), 0, (nmb-1), ks, ke, is, ie,
-    KOKKOS_LAMBDA(int m, int k, int i) {
-      // Inner boundary
-      switch(mb_bcs.d_view(m,BoundaryFace::inner_x2)) {
-        case BoundaryFlag::diode:
-        case BoundaryFlag::outflow:
-            Z4cSommerfeld(z4c_, rhs_, indcs, size, m, k, js, i);
-          break;
-        case BoundaryFlag::user:
-            if (user_Sbc) {
-              Z4cSommerfeld(z4c_, rhs_, indcs, size, m, k, js, i);
-            }
-          break;
-        default:
-          break;
-      }
-      // Outer boundary
-      switch (mb_bcs.d_view(m,BoundaryFace::outer_x2)) {
-        case BoundaryFlag::diode:
-        case BoundaryFlag::outflow:
-            Z4cSommerfeld(z4c_, rhs_, indcs, size, m, k, je, i);
-          break;
-        case BoundaryFlag::user:
-            if (user_Sbc) {
-              Z4cSommerfeld(z4c_, rhs_, indcs, size, m, k, je, i);
-            }
-          break;
-        default:
-          break;
-      }
-    });
-  }
-  if (pm->mesh_bcs[BoundaryFace::inner_x3] == BoundaryFlag::outflow
-      || pm->mesh_bcs[BoundaryFace::inner_x3] == BoundaryFlag::diode
-      || pm->mesh_bcs[BoundaryFace::inner_x3] == BoundaryFlag::user
-      || pm->mesh_bcs[BoundaryFace::outer_x3] == BoundaryFlag::outflow
-      || pm->mesh_bcs[BoundaryFace::outer_x3] == BoundaryFlag::diode
-      || pm->mesh_bcs[BoundaryFace::outer_x3] == BoundaryFlag::user) {
-    par_for("z4crhs_bc_x3", DevExeSpace(), 0, (nmb-1), js, je, is, ie,
-    KOKKOS_LAMBDA(int m, int j, int i) {
-      // Inner boundary
-      switch(mb_bcs.d_view(m,BoundaryFace::inner_x3)) {
-        case BoundaryFlag::diode:
-        case BoundaryFlag::outflow:
-            Z4cSommerfeld(z4c_, rhs_, indcs, size, m, ks, j, i);
-          break;
-        case BoundaryFlag::user:
-            if (user_Sbc) {
-              Z4cSommerfeld(z4c_, rhs_, indcs, size, m, ks, j, i);
-            }
-          break;
-        default:
-          break;
-      }
-      // Outer boundary
-      switch (mb_bcs.d_view(m,BoundaryFace::outer_x3)) {
-        case BoundaryFlag::diode:
-        case BoundaryFlag::outflow:
-            Z4cSommerfeld(z4c_, rhs_, indcs, size, m, ke, j, i);
-          break;
-        case BoundaryFlag::user:
-            if (user_Sbc) {
-              Z4cSommerfeld(z4c_, rhs_, indcs, size, m, ke, j, i);
-            }
-          break;
-        default:
-          break;
-      }
-    });
-  }
-
+  auto &faces_ = sbc_faces;
+  bool usbc = opt.user_Sbc;
+
+  par_for("z4crhs_bc", DevExeSpace(), 0, (sbc_nfaces-1), 0, (na-1), 0, (nb-1),
+  KOKKOS_LAMBDA(int n, int a, int b) {
+    int m = faces_.d_view(n)/6;
+    int f = faces_.d_view(n) - 6*m;
+    int k, j, i;
+    if (f < 2) {
+      k = ks + a; j = js + b; i = (f == 0)? is : ie;
+    } else if (f < 4) {
+      k = ks + a; j = (f == 2)? js : je; i = is + b;
+    } else {
+      k = (f == 4)? ks : ke; j = js + a; i = is + b;
+    }
+    if (k > ke || j > je || i > ie) return;
+    // skip cells owned by a face normal to a lower direction
+    auto &bc = mb_bcs.d_view;
+    bool on_x1 = ((i == is && Z4cSommerfeldFace(bc(m,BoundaryFace::inner_x1), usbc)) ||
+                  (i == ie && Z4cSommerfeldFace(bc(m,BoundaryFace::outer_x1), usbc)));
+    bool on_x2 = ((j == js && Z4cSommerfeldFace(bc(m,BoundaryFace::inner_x2), usbc)) ||
+                  (j == je && Z4cSommerfeldFace(bc(m,BoundaryFace::outer_x2), usbc)));
+    if ((f >= 2 && on_x1) || (f >= 4 && on_x2)) return;
+    Z4cSommerfeld(z4c_, rhs_, indcs, size, stretch, m, k, j, i);
+  });
 
   return TaskStatus::complete;
 }
@@ -0,0 +1,159 @@
+#ifndef Z4C_Z4C_SBC_HPP_
+#define Z4C_Z4C_SBC_HPP_
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file z4c_Sbc.hpp
+//! \brief inline functions for the Sommerfeld boundary condition, shared by the boundary
+//! task and the fused RHS kernels used with low-storage integrators
+
+#include "athena.hpp"
+#include "mesh/mesh.hpp"
+#include "z4c/z4c.hpp"
+#include "coordinates/cell_locations.hpp"
+
+namespace z4c {
+
+//----------------------------------------------------------------------------------------
+//! \fn void Z4c::Z4cSommerfeld
+//! \brief apply Sommerfeld BCs to the given set of points
+KOKKOS_INLINE_FUNCTION
+void Z4cSommerfeld(const Z4c::Z4c_vars& z4c, const Z4c::Z4c_vars& rhs,
+    const RegionIndcs &indcs, const DualArray1D<RegionSize> &size,
+    const CoordinateStretch &stretch,
+    const int m, const int k, const int j, const int i) {
+  // -------------------------------------------------------------------------------------
+  // Scratch data
+  //
+
+  // First derivatives
+  // Scalars
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dKhat_d;
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dTheta_d;
+
+  // Vectors
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 2> dGam_du;
+
+  // Tensors
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> dA_ddd;
+
+
+  // Psuedoradial vector
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> s_u;
+
+  Real idx[] = {1./size.d_view(m).dx1, 1./size.d_view(m).dx2, 1./size.d_view(m).dx3};
+  Real cdd[3];
+  stretch.CellFDFactors(size.d_view(m), indcs, k, j, i, idx, cdd);
+
+  // -------------------------------------------------------------------------------------
+  // First derivatives
+  // We force all derivatives to be calculated at second-order, as this was found to
+  // be necessary for stability in Athena++.
+  //
+  for (int a = 0; a < 3; a++) {
+    dKhat_d(a) = Dx<2>(a, idx, z4c.vKhat, m, k, j, i);
+    dTheta_d(a) = Dx<2>(a, idx, z4c.vTheta, m, k, j, i);
+  }
+  for (int a = 0; a < 3; a++) {
+    for (int b = 0; b < 3; b++) {
+      dGam_du(b,a) = Dx<2>(b, idx, z4c.vGam_u, m, a, k, j, i);
+    }
+  }
+  for (int a = 0; a < 3; a++) {
+    for (int b = a; b < 3; b++) {
+      for (int c = 0; c < 3; c++) {
+        dA_ddd(c, a, b) = Dx<2>(c, idx, z4c.vA_dd, m, a, b, k, j, i);
+      }
+    }
+  }
+
+  // -------------------------------------------------------------------------------------
+  // Compute psuedo-radial vector
+  //
+  Real &x1min = size.d_view(m).x1min;
+  Real &x1max = size.d_view(m).x1max;
+  Real &x2min = size.d_view(m).x2min;
+  Real &x2max = size.d_view(m).x2max;
+  Real &x3min = size.d_view(m).x3min;
+  Real &x3max = size.d_view(m).x3max;
+
+  Real x1v = stretch.X(0, CellCenterX(i-indcs.is, indcs.nx1, x1min, x1max));
+  Real x2v = stretch.X(1, CellCenterX(j-indcs.js, indcs.nx2, x2min, x2max));
+  Real x3v = stretch.X(2, CellCenterX(k-indcs.ks, indcs.nx3, x3min, x3max));
+
+  Real r = sqrt(SQR(x1v) + SQR(x2v) + SQR(x3v));
+  s_u(0) = x1v/r;
+  s_u(1) = x2v/r;
+  s_u(2) = x3v/r;
+
+  // -------------------------------------------------------------------------------------
+  // Boundary RHS for scalars
+  //
+  rhs.vTheta(m,k,j,i) = - z4c.vTheta(m,k,j,i)/r;
+  rhs.vKhat(m,k,j,i) = - sqrt(2.) * z4c.vKhat(m,k,j,i)/r;
+  for (int a = 0; a < 3; a++) {
+    rhs.vTheta(m,k,j,i) -= s_u(a) * dTheta_d(a);
+    rhs.vKhat(m,k,j,i) -= sqrt(2.) * s_u(a) * dKhat_d(a);
+  }
+
+  // -------------------------------------------------------------------------------------
+  // Boundary RHS for Gamma
+  //
+  for (int a = 0; a < 3; a++) {
+    rhs.vGam_u(m,a,k,j,i) = - z4c.vGam_u(m, a, k, j, i)/r;
+    for (int b = 0; b < 3; b++) {
+      rhs.vGam_u(m,a,k,j,i) -= s_u(b) * dGam_du(b,a);
+    }
+  }
+
+  // -------------------------------------------------------------------------------------
+  // Boundary RHS for A_ab
+  //
+  for (int a = 0; a < 3; a++) {
+    for (int b = a; b < 3; b++) {
+      rhs.vA_dd(m,a,b,k,j,i) = - z4c.vA_dd(m,a,b,k,j,i)/r;
+      for (int c = 0; c < 3; c++) {
+        rhs.vA_dd(m,a,b,k,j,i) -= s_u(c) * dA_ddd(c,a,b);
+      }
+    }
+  }
+}
+
+
+//----------------------------------------------------------------------------------------
+//! \fn bool Z4cSommerfeldFace
+//! \brief true if the Sommerfeld condition is applied at a face with boundary flag bc
+
+KOKKOS_INLINE_FUNCTION
+bool Z4cSommerfeldFace(const BoundaryFlag bc, const bool user_Sbc) {
+  return (bc == BoundaryFlag::outflow || bc == BoundaryFlag::diode ||
+          (bc == BoundaryFlag::user && user_Sbc));
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn bool Z4cSommerfeldCell
+//! \brief true if active cell (m,k,j,i) lies on a MeshBlock face at which the Sommerfeld
+//! condition is applied, i.e. if Z4cBoundaryRHS would overwrite its RHS
+
+KOKKOS_INLINE_FUNCTION
+bool Z4cSommerfeldCell(const DualArray2D<BoundaryFlag> &mb_bcs, const RegionIndcs &indcs,
+                       const bool user_Sbc,
+                       const int m, const int k, const int j, const int i) {
+  return ((i == indcs.is &&
+           Z4cSommerfeldFace(mb_bcs.d_view(m,BoundaryFace::inner_x1), user_Sbc)) ||
+          (i == indcs.ie &&
+           Z4cSommerfeldFace(mb_bcs.d_view(m,BoundaryFace::outer_x1), user_Sbc)) ||
+          (j == indcs.js &&
+           Z4cSommerfeldFace(mb_bcs.d_view(m,BoundaryFace::inner_x2), user_Sbc)) ||
+          (j == indcs.je &&
+           Z4cSommerfeldFace(mb_bcs.d_view(m,BoundaryFace::outer_x2), user_Sbc)) ||
+          (k == indcs.ks &&
+           Z4cSommerfeldFace(mb_bcs.d_view(m,BoundaryFace::inner_x3), user_Sbc)) ||
+          (k == indcs.ke &&
+           Z4cSommerfeldFace(mb_bcs.d_view(m,BoundaryFace::outer_x3), user_Sbc)));
+}
+
+} // namespace z4c
+#endif // Z4C_Z4C_SBC_HPP_
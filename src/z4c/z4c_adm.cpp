@@ -50,6 +50,7 @@ void Z4c::ADMToZ4c(MeshBlockPack *pmbp, ParameterInput *pin) {
   // capture variables for the kernel
   auto &indcs = pmbp->pmesh->mb_indcs;
   auto &size = pmbp->pmb->mb_size;
+  auto stretch = pmbp->pmesh->stretch;
   int &is = indcs.is; int &ie = indcs.ie;
   int &js = indcs.js; int &je = indcs.je;
   int &ks = indcs.ks; int &ke = indcs.ke;
@@ -141,6 +142,8 @@ void Z4c::ADMToZ4c(MeshBlockPack *pmbp, ParameterInput *pin) {
   KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
     // Usage of Dx: pmbp->pz4c->Dx(blockn, posvar, k,j,i, dir, nghost, dx, quantity);
     Real idx[] = {1/size.d_view(m).dx1, 1/size.d_view(m).dx2, 1/size.d_view(m).dx3};
+    Real cdd[3];
+    stretch.CellFDFactors(size.d_view(m), indcs, k, j, i, idx, cdd);
     /*AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> g_uu;
     AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_udd;
     AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> dg_ddd;
@@ -234,6 +237,260 @@ void Z4c::Z4cToADM(MeshBlockPack *pmbp) {
   });
   return;
 }
+//----------------------------------------------------------------------------------------
+//! \fn void ADMConstraintsCell()
+//! \brief Computes the Hamiltonian constraint H, the covariant momentum constraint M_d,
+//! its norm squared M, and the norm squared Z of the Z4c constraint vector in one cell.
+//! Used both to store the constraints in u_con and to reduce their norms directly.
+
+template <int NGHOST>
+KOKKOS_INLINE_FUNCTION
+void ADMConstraintsCell(const Z4c::Z4c_vars &z4c, const adm::ADM::ADM_vars &adm,
+                        const Tmunu::Tmunu_vars &tmunu, const bool is_vacuum,
+                        const Real idx[], const Real cdd[], const int m, const int k,
+                        const int j, const int i, Real &H, Real M_d[3], Real &M,
+                        Real &Z) {
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> Gamma_u;
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> Gamma_u_z4c;
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> M_u;
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dpsi4_d;
+
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> g_uu;
+  //AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> g_uu_z4c;
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> R_dd;
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> K_ud;
+
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> dg_ddd;
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> dg_ddd_z4c;
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> dK_ddd;
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_ddd;
+  //AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_ddd_z4c;
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_udd;
+  //AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_udd_z4c;
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> DK_ddd;
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> DK_udd;
+
+  AthenaScratchTensor<Real, TensorSymm::SYM22, 3, 4> ddg_dddd;
+
+  // -----------------------------------------------------------------------------------
+  // derivatives
+  //
+  // first derivatives of g and K
+  for(int c = 0; c < 3; ++c)
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b) {
+    dg_ddd(c,a,b) = Dx<NGHOST>(c, idx, adm.g_dd, m,a,b,k,j,i);
+    dg_ddd_z4c(c,a,b) = Dx<NGHOST>(c, idx, z4c.g_dd, m,a,b,k,j,i);
+    dK_ddd(c,a,b) = Dx<NGHOST>(c, idx, adm.vK_dd, m,a,b,k,j,i);
+  }
+
+  // first derivative of psi4
+  for (int a =0; a < 3; ++a) {
+    dpsi4_d(a) = Dx<NGHOST>(a, idx, adm.psi4, m, k, j, i);
+  }
+
+  // second derivatives of g
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b)
+  for(int c = 0; c < 3; ++c)
+  for(int d = c; d < 3; ++d) {
+    if(a == b) {
+      ddg_dddd(a,a,c,d) = Dxx<NGHOST>(a, idx, adm.g_dd, m,c,d,k,j,i)
+                          - cdd[a]*dg_ddd(a,c,d);
+    } else {
+      ddg_dddd(a,b,c,d) = Dxy<NGHOST>(a, b, idx, adm.g_dd, m,c,d,k,j,i);
+    }
+  }
+
+  // -----------------------------------------------------------------------------------
+  // inverse metric
+  //
+  Real detg = adm::SpatialDet(adm.g_dd(m,0,0,k,j,i), adm.g_dd(m,0,1,k,j,i),
+                              adm.g_dd(m,0,2,k,j,i), adm.g_dd(m,1,1,k,j,i),
+                              adm.g_dd(m,1,2,k,j,i), adm.g_dd(m,2,2,k,j,i));
+  adm::SpatialInv(1./detg,
+             adm.g_dd(m,0,0,k,j,i), adm.g_dd(m,0,1,k,j,i), adm.g_dd(m,0,2,k,j,i),
+             adm.g_dd(m,1,1,k,j,i), adm.g_dd(m,1,2,k,j,i), adm.g_dd(m,2,2,k,j,i),
+             &g_uu(0,0), &g_uu(0,1), &g_uu(0,2),
+             &g_uu(1,1), &g_uu(1,2), &g_uu(2,2));
+
+  /*Real detg_z4c = adm::SpatialDet(z4c.g_dd(m,0,0,k,j,i), z4c.g_dd(m,0,1,k,j,i),
+                              z4c.g_dd(m,0,2,k,j,i), z4c.g_dd(m,1,1,k,j,i),
+                              z4c.g_dd(m,1,2,k,j,i), z4c.g_dd(m,2,2,k,j,i));
+  adm::SpatialInv(1./detg_z4c,
+             z4c.g_dd(m,0,0,k,j,i), z4c.g_dd(m,0,1,k,j,i), z4c.g_dd(m,0,2,k,j,i),
+             z4c.g_dd(m,1,1,k,j,i), z4c.g_dd(m,1,2,k,j,i), z4c.g_dd(m,2,2,k,j,i),
+             &g_uu_z4c(0,0), &g_uu_z4c(0,1), &g_uu_z4c(0,2),
+             &g_uu_z4c(1,1), &g_uu_z4c(1,2), &g_uu_z4c(2,2));*/
+
+  // -----------------------------------------------------------------------------------
+  // Christoffel symbols
+  //
+  for(int c = 0; c < 3; ++c)
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b) {
+    Gamma_ddd(c,a,b) = 0.5*(dg_ddd(a,b,c) + dg_ddd(b,a,c) - dg_ddd(c,a,b));
+    Gamma_udd(c,a,b) = 0.0;
+  }
+
+  for(int c = 0; c < 3; ++c)
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b)
+  for(int d = 0; d < 3; ++d) {
+    Gamma_udd(c,a,b) += g_uu(c,d)*Gamma_ddd(d,a,b);
+  }
+
+  for(int a = 0; a < 3; ++a) {
+    Gamma_u(a) = 0.0;
+    for(int b = 0; b < 3; ++b)
+    for(int c = 0; c < 3; ++c) {
+      Gamma_u(a) += g_uu(b,c)*Gamma_udd(a,b,c);
+    }
+  }
+
+  // same but for z4c metric
+  /*for(int c = 0; c < 3; ++c)
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b) {
+    Gamma_ddd_z4c(c,a,b) = 0.5*(dg_ddd_z4c(a,b,c)
+                        + dg_ddd_z4c(b,a,c) - dg_ddd_z4c(c,a,b));
+    Gamma_udd_z4c(c,a,b) = 0.0;
+  }
+
+  for(int c = 0; c < 3; ++c)
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b)
+  for(int d = 0; d < 3; ++d) {
+    Gamma_udd_z4c(c,a,b) += g_uu_z4c(c,d)*Gamma_ddd_z4c(d,a,b);
+  }
+
+  for(int a = 0; a < 3; ++a) {
+    Gamma_u_z4c(a) = 0.0;
+    for(int b = 0; b < 3; ++b)
+    for(int c = 0; c < 3; ++c) {
+      Gamma_u_z4c(a) += g_uu_z4c(b,c)*Gamma_udd_z4c(a,b,c);
+    }
+  }*/
+  // Find the contracted conformal Christoffel symbol
+  for (int a = 0; a < 3; ++a) {
+    Gamma_u_z4c(a) = adm.psi4(m,k,j,i)*Gamma_u(a);
+    for (int b = 0; b < 3; ++b) {
+      Gamma_u_z4c(a) += 0.5*g_uu(a,b)*dpsi4_d(b);
+    }
+  }
+
+  // -----------------------------------------------------------------------------------
+  // Ricci tensor and Ricci scalar
+  //
+  Real R = 0.0;
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b) {
+    R_dd(a,b) = 0.0;
+    for(int c = 0; c < 3; ++c)
+    for(int d = 0; d < 3; ++d) {
+      // Part with the Christoffel symbols
+      for(int e = 0; e < 3; ++e) {
+        R_dd(a,b) += g_uu(c,d) * Gamma_udd(e,a,c) * Gamma_ddd(e,b,d);
+        R_dd(a,b) -= g_uu(c,d) * Gamma_udd(e,a,b) * Gamma_ddd(e,c,d);
+      }
+      // Wave operator part of the Ricci
+      R_dd(a,b) += 0.5*g_uu(c,d)*(
+          - ddg_dddd(c,d,a,b) - ddg_dddd(a,b,c,d) +
+            ddg_dddd(a,c,b,d) + ddg_dddd(b,c,a,d));
+    }
+    R += g_uu(a,b) * R_dd(a,b);
+  }
+
+  // -----------------------------------------------------------------------------------
+  // Extrinsic curvature: traces and derivatives
+  //
+  Real K = 0.0;
+  for(int a = 0; a < 3; ++a) {
+    for(int b = a; b < 3; ++b) {
+      K_ud(a,b) = 0.0;
+      for(int c = 0; c < 3; ++c) {
+        K_ud(a,b) += g_uu(a,c) * adm.vK_dd(m,c,b,k,j,i);
+      }
+    }
+    K += K_ud(a,a);
+  }
+
+  // K^a_b K^b_a
+  Real KK = 0.0;
+  for(int a = 0; a < 3; ++a)
+  for(int b = 0; b < 3; ++b) {
+    KK += K_ud(a,b) * K_ud(b,a);
+  }
+
+  // Covariant derivative of K
+  for(int a = 0; a < 3; ++a)
+  for(int b = 0; b < 3; ++b)
+  for(int c = b; c < 3; ++c) {
+    DK_ddd(a,b,c) = dK_ddd(a,b,c);
+    for(int d = 0; d < 3; ++d) {
+      DK_ddd(a,b,c) -= Gamma_udd(d,a,b) * adm.vK_dd(m,d,c,k,j,i);
+      DK_ddd(a,b,c) -= Gamma_udd(d,a,c) * adm.vK_dd(m,b,d,k,j,i);
+    }
+  }
+
+  for(int a = 0; a < 3; ++a)
+  for(int b = 0; b < 3; ++b)
+  for(int c = b; c < 3; ++c) {
+    DK_udd(a,b,c) = 0.0;
+    for(int d = 0; d < 3; ++d) {
+      DK_udd(a,b,c) += g_uu(a,d) * DK_ddd(d,b,c);
+    }
+  }
+
+  // ---------------------------------------------------------------------------------
+  // Actual constraints
+  //
+  // Hamiltonian constraint
+  //
+  H = R + SQR(K) - KK;
+  if(!is_vacuum) {
+    H -= 16*M_PI * tmunu.E(m,k,j,i);
+  }
+  // Momentum constraint (contravariant)
+  //
+  for(int a = 0; a < 3; ++a) {
+    M_u(a) = 0.0;
+    for(int b = 0; b < 3; ++b) {
+      if(!is_vacuum) {
+        M_u(a) -= 8*M_PI * g_uu(a,b) * tmunu.S_d(m,b,k,j,i);
+      }
+      for(int c = 0; c < 3; ++c) {
+        M_u(a) += g_uu(a,b) * DK_udd(c,b,c);
+        M_u(a) -= g_uu(b,c) * DK_udd(a,b,c);
+      }
+    }
+  }
+
+  // Momentum constraint (covariant)
+  for(int a = 0; a < 3; ++a) {
+    M_d[a] = 0.0;
+    for(int b = 0; b < 3; ++b) {
+      M_d[a] += adm.g_dd(m,a,b,k,j,i) * M_u(b);
+    }
+  }
+
+  // Momentum constraint (norm squared)
+  M = 0.0;
+  for(int a = 0; a < 3; ++a)
+  for(int b = 0; b < 3; ++b) {
+    M += adm.g_dd(m,a,b,k,j,i) * M_u(a) * M_u(b);
+  }
+
+  // Constraint violation Z (norm squared)
+  Z = 0.0;
+  for(int a = 0; a < 3; ++a)
+  for(int b = 0; b < 3; ++b) {
+    Z += 0.25*z4c.g_dd(m,a,b,k,j,i)
+         *(z4c.vGam_u(m,a,k,j,i) - Gamma_u_z4c(a))
+         *(z4c.vGam_u(m,b,k,j,i) - Gamma_u_z4c(b));
+  }
+}
+
 //----------------------------------------------------------------------------------------
 //! \fn void Z4c::ADMConstraints(AthenaArray<Real> & u_adm, AthenaArray<Real> & u_mat)
 //! \brief compute constraints ADM vars
@@ -252,6 +509,7 @@ void Z4c::ADMConstraints(MeshBlockPack *pmbp) {
   // capture variables for the kernel
   auto &indcs = pmbp->pmesh->mb_indcs;
   auto &size = pmbp->pmb->mb_size;
+  auto stretch = pmbp->pmesh->stretch;
   int &is = indcs.is; int &ie = indcs.ie;
   int &js = indcs.js; int &je = indcs.je;
   int &ks = indcs.ks; int &ke = indcs.ke;
@@ -273,250 +531,142 @@ void Z4c::ADMConstraints(MeshBlockPack *pmbp) {
   par_for("ADM constraints loop",DevExeSpace(),
   0,nmb-1,ks,ke,js,je,is,ie,
   KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> Gamma_u;
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> Gamma_u_z4c;
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> M_u;
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dpsi4_d;
-
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> g_uu;
-    //AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> g_uu_z4c;
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> R_dd;
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> K_ud;
-
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> dg_ddd;
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> dg_ddd_z4c;
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> dK_ddd;
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_ddd;
-    //AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_ddd_z4c;
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_udd;
-    //AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_udd_z4c;
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> DK_ddd;
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> DK_udd;
-
-    AthenaScratchTensor<Real, TensorSymm::SYM22, 3, 4> ddg_dddd;
-
     Real idx[] = {1/size.d_view(m).dx1, 1/size.d_view(m).dx2, 1/size.d_view(m).dx3};
-
-    // -----------------------------------------------------------------------------------
-    // derivatives
-    //
-    // first derivatives of g and K
-    for(int c = 0; c < 3; ++c)
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b) {
-      dg_ddd(c,a,b) = Dx<NGHOST>(c, idx, adm.g_dd, m,a,b,k,j,i);
-      dg_ddd_z4c(c,a,b) = Dx<NGHOST>(c, idx, z4c.g_dd, m,a,b,k,j,i);
-      dK_ddd(c,a,b) = Dx<NGHOST>(c, idx, adm.vK_dd, m,a,b,k,j,i);
-    }
-
-    // first derivative of psi4
-    for (int a =0; a < 3; ++a) {
-      dpsi4_d(a) = Dx<NGHOST>(a, idx, adm.psi4, m, k, j, i);
-    }
-
-    // second derivatives of g
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b)
-    for(int c = 0; c < 3; ++c)
-    for(int d = c; d < 3; ++d) {
-      if(a == b) {
-        ddg_dddd(a,a,c,d) = Dxx<NGHOST>(a, idx, adm.g_dd, m,c,d,k,j,i);
-      } else {
-        ddg_dddd(a,b,c,d) = Dxy<NGHOST>(a, b, idx, adm.g_dd, m,c,d,k,j,i);
-      }
-    }
-
-    // -----------------------------------------------------------------------------------
-    // inverse metric
-    //
-    Real detg = adm::SpatialDet(adm.g_dd(m,0,0,k,j,i), adm.g_dd(m,0,1,k,j,i),
-                                adm.g_dd(m,0,2,k,j,i), adm.g_dd(m,1,1,k,j,i),
-                                adm.g_dd(m,1,2,k,j,i), adm.g_dd(m,2,2,k,j,i));
-    adm::SpatialInv(1./detg,
-               adm.g_dd(m,0,0,k,j,i), adm.g_dd(m,0,1,k,j,i), adm.g_dd(m,0,2,k,j,i),
-               adm.g_dd(m,1,1,k,j,i), adm.g_dd(m,1,2,k,j,i), adm.g_dd(m,2,2,k,j,i),
-               &g_uu(0,0), &g_uu(0,1), &g_uu(0,2),
-               &g_uu(1,1), &g_uu(1,2), &g_uu(2,2));
-
-    /*Real detg_z4c = adm::SpatialDet(z4c.g_dd(m,0,0,k,j,i), z4c.g_dd(m,0,1,k,j,i),
-                                z4c.g_dd(m,0,2,k,j,i), z4c.g_dd(m,1,1,k,j,i),
-                                z4c.g_dd(m,1,2,k,j,i), z4c.g_dd(m,2,2,k,j,i));
-    adm::SpatialInv(1./detg_z4c,
-               z4c.g_dd(m,0,0,k,j,i), z4c.g_dd(m,0,1,k,j,i), z4c.g_dd(m,0,2,k,j,i),
-               z4c.g_dd(m,1,1,k,j,i), z4c.g_dd(m,1,2,k,j,i), z4c.g_dd(m,2,2,k,j,i),
-               &g_uu_z4c(0,0), &g_uu_z4c(0,1), &g_uu_z4c(0,2),
-               &g_uu_z4c(1,1), &g_uu_z4c(1,2), &g_uu_z4c(2,2));*/
-
-    // -----------------------------------------------------------------------------------
-    // Christoffel symbols
-    //
-    for(int c = 0; c < 3; ++c)
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b) {
-      Gamma_ddd(c,a,b) = 0.5*(dg_ddd(a,b,c) + dg_ddd(b,a,c) - dg_ddd(c,a,b));
-      Gamma_udd(c,a,b) = 0.0;
-    }
-
-    for(int c = 0; c < 3; ++c)
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b)
-    for(int d = 0; d < 3; ++d) {
-      Gamma_udd(c,a,b) += g_uu(c,d)*Gamma_ddd(d,a,b);
-    }
-
+    Real cdd[3];
+    stretch.CellFDFactors(size.d_view(m), indcs, k, j, i, idx, cdd);
+    Real H, M_d[3], M, Z;
+    ADMConstraintsCell<NGHOST>(z4c, adm, tmunu, is_vacuum, idx, cdd, m, k, j, i,
+                               H, M_d, M, Z);
+    con.H(m,k,j,i) = H;
     for(int a = 0; a < 3; ++a) {
-      Gamma_u(a) = 0.0;
-      for(int b = 0; b < 3; ++b)
-      for(int c = 0; c < 3; ++c) {
-        Gamma_u(a) += g_uu(b,c)*Gamma_udd(a,b,c);
-      }
+      con.M_d(m,a,k,j,i) = M_d[a];
     }
+    con.M(m,k,j,i) = M;
+    con.Z(m,k,j,i) = Z;
 
-    // same but for z4c metric
-    /*for(int c = 0; c < 3; ++c)
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b) {
-      Gamma_ddd_z4c(c,a,b) = 0.5*(dg_ddd_z4c(a,b,c)
-                          + dg_ddd_z4c(b,a,c) - dg_ddd_z4c(c,a,b));
-      Gamma_udd_z4c(c,a,b) = 0.0;
-    }
-
-    for(int c = 0; c < 3; ++c)
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b)
-    for(int d = 0; d < 3; ++d) {
-      Gamma_udd_z4c(c,a,b) += g_uu_z4c(c,d)*Gamma_ddd_z4c(d,a,b);
-    }
-
-    for(int a = 0; a < 3; ++a) {
-      Gamma_u_z4c(a) = 0.0;
-      for(int b = 0; b < 3; ++b)
-      for(int c = 0; c < 3; ++c) {
-        Gamma_u_z4c(a) += g_uu_z4c(b,c)*Gamma_udd_z4c(a,b,c);
-      }
-    }*/
-    // Find the contracted conformal Christoffel symbol
-    for (int a = 0; a < 3; ++a) {
-      Gamma_u_z4c(a) = adm.psi4(m,k,j,i)*Gamma_u(a);
-      for (int b = 0; b < 3; ++b) {
-        Gamma_u_z4c(a) += 0.5*g_uu(a,b)*dpsi4_d(b);
-      }
-    }
-
-    // -----------------------------------------------------------------------------------
-    // Ricci tensor and Ricci scalar
-    //
-    Real R = 0.0;
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b) {
-      R_dd(a,b) = 0.0;
-      for(int c = 0; c < 3; ++c)
-      for(int d = 0; d < 3; ++d) {
-        // Part with the Christoffel symbols
-        for(int e = 0; e < 3; ++e) {
-          R_dd(a,b) += g_uu(c,d) * Gamma_udd(e,a,c) * Gamma_ddd(e,b,d);
-          R_dd(a,b) -= g_uu(c,d) * Gamma_udd(e,a,b) * Gamma_ddd(e,c,d);
-        }
-        // Wave operator part of the Ricci
-        R_dd(a,b) += 0.5*g_uu(c,d)*(
-            - ddg_dddd(c,d,a,b) - ddg_dddd(a,b,c,d) +
-              ddg_dddd(a,c,b,d) + ddg_dddd(b,c,a,d));
-      }
-      R += g_uu(a,b) * R_dd(a,b);
-    }
-
-    // -----------------------------------------------------------------------------------
-    // Extrinsic curvature: traces and derivatives
-    //
-    Real K = 0.0;
-    for(int a = 0; a < 3; ++a) {
-      for(int b = a; b < 3; ++b) {
-        K_ud(a,b) = 0.0;
-        for(int c = 0; c < 3; ++c) {
-          K_ud(a,b) += g_uu(a,c) * adm.vK_dd(m,c,b,k,j,i);
-        }
-      }
-      K += K_ud(a,a);
-    }
+    // Constraint violation monitor C^2
+    con.C(m,k,j,i) = SQR(H) + M + SQR(z4c.vTheta(m,k,j,i)) + 4.0*Z;
+  });
+}
+template void Z4c::ADMConstraints<2>(MeshBlockPack *pmbp);
+template void Z4c::ADMConstraints<3>(MeshBlockPack *pmbp);
+template void Z4c::ADMConstraints<4>(MeshBlockPack *pmbp);
 
-    // K^a_b K^b_a
-    Real KK = 0.0;
-    for(int a = 0; a < 3; ++a)
-    for(int b = 0; b < 3; ++b) {
-      KK += K_ud(a,b) * K_ud(b,a);
-    }
+//----------------------------------------------------------------------------------------
+//! \fn void Z4c::ADMConstraintNorms(MeshBlockPack *pmbp, Real norms[])
+//! \brief Volume integrals over this rank of the norms of the constraints reported in
+//! the history file, ordered as (H^2, M, Mx^2, My^2, Mz^2, Z, Theta^2, C).  Computed as a
+//! single reduction, so the constraint fields are never stored in u_con.
 
-    // Covariant derivative of K
-    for(int a = 0; a < 3; ++a)
-    for(int b = 0; b < 3; ++b)
-    for(int c = b; c < 3; ++c) {
-      DK_ddd(a,b,c) = dK_ddd(a,b,c);
-      for(int d = 0; d < 3; ++d) {
-        DK_ddd(a,b,c) -= Gamma_udd(d,a,b) * adm.vK_dd(m,d,c,k,j,i);
-        DK_ddd(a,b,c) -= Gamma_udd(d,a,c) * adm.vK_dd(m,b,d,k,j,i);
-      }
-    }
+template <int NGHOST>
+void Z4c::ADMConstraintNorms(MeshBlockPack *pmbp, Real norms[]) {
+  auto &indcs = pmbp->pmesh->mb_indcs;
+  auto &size = pmbp->pmb->mb_size;
+  auto stretch = pmbp->pmesh->stretch;
+  int is = indcs.is, nx1 = indcs.nx1;
+  int js = indcs.js, nx2 = indcs.nx2;
+  int ks = indcs.ks, nx3 = indcs.nx3;
+  const int nmkji = (pmbp->nmb_thispack)*nx3*nx2*nx1;
+  const int nkji = nx3*nx2*nx1;
+  const int nji  = nx2*nx1;
 
-    for(int a = 0; a < 3; ++a)
-    for(int b = 0; b < 3; ++b)
-    for(int c = b; c < 3; ++c) {
-      DK_udd(a,b,c) = 0.0;
-      for(int d = 0; d < 3; ++d) {
-        DK_udd(a,b,c) += g_uu(a,d) * DK_ddd(d,b,c);
-      }
-    }
+  auto &z4c = pmbp->pz4c->z4c;
+  auto &adm = pmbp->padm->adm;
 
-    // -----------------------------------------------------------------------------------
-    // Actual constraints
-    //
-    // Hamiltonian constraint
-    //
-    con.H(m,k,j,i) = R + SQR(K) - KK;
-    if(!is_vacuum) {
-      con.H(m,k,j,i) -= 16*M_PI * tmunu.E(m,k,j,i);
-    }
-    // Momentum constraint (contravariant)
-    //
-    for(int a = 0; a < 3; ++a) {
-      M_u(a) = 0.0;
-      for(int b = 0; b < 3; ++b) {
-        if(!is_vacuum) {
-          M_u(a) -= 8*M_PI * g_uu(a,b) * tmunu.S_d(m,b,k,j,i);
-        }
-        for(int c = 0; c < 3; ++c) {
-          M_u(a) += g_uu(a,b) * DK_udd(c,b,c);
-          M_u(a) -= g_uu(b,c) * DK_udd(a,b,c);
-        }
-      }
-    }
+  // vacuum or with matter?
+  bool is_vacuum = (pmy_pack->ptmunu == nullptr) ? true : false;
+  Tmunu::Tmunu_vars tmunu;
+  if (!is_vacuum) tmunu = pmy_pack->ptmunu->tmunu;
 
-    // Momentum constraint (covariant)
-    for(int a = 0; a < 3; ++a) {
-      for(int b = 0; b < 3; ++b) {
-        con.M_d(m,a,k,j,i) += adm.g_dd(m,a,b,k,j,i) * M_u(b);
-      }
-    }
+  array_sum::GlobalSum sum_this_pack;
+  Kokkos::parallel_reduce("ADMConNorms",Kokkos::RangePolicy<>(DevExeSpace(), 0, nmkji),
+  KOKKOS_LAMBDA(const int &idx, array_sum::GlobalSum &mb_sum) {
+    int m = (idx)/nkji;
+    int k = (idx - m*nkji)/nji;
+    int j = (idx - m*nkji - k*nji)/nx1;
+    int i = (idx - m*nkji - k*nji - j*nx1) + is;
+    k += ks;
+    j += js;
+
+    Real idxs[] = {1/size.d_view(m).dx1, 1/size.d_view(m).dx2, 1/size.d_view(m).dx3};
+    Real cdd[3];
+    stretch.CellFDFactors(size.d_view(m), indcs, k, j, i, idxs, cdd);
+    Real H, M_d[3], M, Z;
+    ADMConstraintsCell<NGHOST>(z4c, adm, tmunu, is_vacuum, idxs, cdd, m, k, j, i,
+                               H, M_d, M, Z);
+    Real theta2 = SQR(z4c.vTheta(m,k,j,i));
+    Real vol = size.d_view(m).dx1*size.d_view(m).dx2*size.d_view(m).dx3;
+    if (stretch.stretched) {vol = 1.0/(idxs[0]*idxs[1]*idxs[2]);}
+
+    array_sum::GlobalSum cvars;
+    cvars.the_array[0] = vol*SQR(H);
+    cvars.the_array[1] = vol*M;
+    cvars.the_array[2] = vol*SQR(M_d[0]);
+    cvars.the_array[3] = vol*SQR(M_d[1]);
+    cvars.the_array[4] = vol*SQR(M_d[2]);
+    cvars.the_array[5] = vol*Z;
+    cvars.the_array[6] = vol*theta2;
+    cvars.the_array[7] = vol*(SQR(H) + M + theta2 + 4.0*Z);
+    mb_sum += cvars;
+  }, Kokkos::Sum<array_sum::GlobalSum>(sum_this_pack));
+
+  for (int n=0; n<8; ++n) {
+    norms[n] = sum_this_pack.the_array[n];
+  }
+}
+template void Z4c::ADMConstraintNorms<2>(MeshBlockPack *pmbp, Real norms[]);
+template void Z4c::ADMConstraintNorms<3>(MeshBlockPack *pmbp, Real norms[]);
+template void Z4c::ADMConstraintNorms<4>(MeshBlockPack *pmbp, Real norms[]);
 
-    // Momentum constraint (norm squared)
-    for(int a = 0; a < 3; ++a)
-    for(int b = 0; b < 3; ++b) {
-      con.M(m,k,j,i) += adm.g_dd(m,a,b,k,j,i) * M_u(a) * M_u(b);
-    }
+//----------------------------------------------------------------------------------------
+//! \fn void Z4c::UpdateADM()
+//! \brief Compute the ADM variables from u0, if not already done since u0 was updated
+
+void Z4c::UpdateADM() {
+  if (!(adm_current)) {
+    Z4cToADM(pmy_pack);
+    adm_current = true;
+  }
+}
 
-    // Constraint violation Z (norm squared)
-    for(int a = 0; a < 3; ++a)
-    for(int b = 0; b < 3; ++b) {
-      con.Z(m,k,j,i) += 0.25*z4c.g_dd(m,a,b,k,j,i)
-                        *(z4c.vGam_u(m,a,k,j,i) - Gamma_u_z4c(a))
-                        *(z4c.vGam_u(m,b,k,j,i) - Gamma_u_z4c(b));
+//----------------------------------------------------------------------------------------
+//! \fn void Z4c::UpdateConstraints()
+//! \brief Compute the constraints from u0 (and the ADM variables), if not already done
+//! since u0 was updated
+
+void Z4c::UpdateConstraints() {
+  UpdateADM();
+  // with con_norms_only, u_con is only allocated once an output needs the fields
+  if (!(con_allocated)) {
+    AllocateConstraints();
+  }
+  if (!(con_current)) {
+    switch (fd_ng) {
+      case 2: ADMConstraints<2>(pmy_pack);
+              break;
+      case 3: ADMConstraints<3>(pmy_pack);
+              break;
+      case 4: ADMConstraints<4>(pmy_pack);
+              break;
     }
+    con_current = true;
+  }
+}
 
-    // Constraint violation monitor C^2
-    con.C(m,k,j,i) = SQR(con.H(m,k,j,i)) + con.M(m,k,j,i) +
-                     SQR(z4c.vTheta(m,k,j,i)) + 4.0*con.Z(m,k,j,i);
-});
+//----------------------------------------------------------------------------------------
+//! \fn void Z4c::ConstraintNorms()
+//! \brief Volume integrals over this rank of the constraint norms in the history file
+//! (see ADMConstraintNorms), reduced directly from the ADM variables without using u_con.
+
+void Z4c::ConstraintNorms(Real norms[]) {
+  UpdateADM();
+  switch (fd_ng) {
+    case 2: ADMConstraintNorms<2>(pmy_pack, norms);
+            break;
+    case 3: ADMConstraintNorms<3>(pmy_pack, norms);
+            break;
+    case 4: ADMConstraintNorms<4>(pmy_pack, norms);
+            break;
+  }
 }
-template void Z4c::ADMConstraints<2>(MeshBlockPack *pmbp);
-template void Z4c::ADMConstraints<3>(MeshBlockPack *pmbp);
-template void Z4c::ADMConstraints<4>(MeshBlockPack *pmbp);
 } // namespace z4c
@@ -5,6 +5,7 @@
 //========================================================================================
 
 #include <algorithm>
+#include <cmath>
 #include <cstdio>
 #include <iostream>
 #include <limits>
@@ -24,12 +25,49 @@
 namespace z4c {
 
 // set some parameters
-Z4c_AMR::Z4c_AMR(ParameterInput *pin) {
+Z4c_AMR::Z4c_AMR(ParameterInput *pin) :
+  field_method(Trivial),
+  nested_box(false) {
   std::string ref_method = pin->GetOrAddString("z4c_amr", "method", "trivial");
   if (ref_method == "trivial") {
     method = Trivial;
   } else if (ref_method == "tracker") {
     method = Tracker;
+  } else if (ref_method == "nested") {
+    method = Nested;
+    for (int l = 1; l < 32; ++l) {
+      std::string name = "nested_radius_" + std::to_string(l);
+      if (!pin->DoesParameterExist("z4c_amr", name)) break;
+      nested_radius.push_back(pin->GetReal("z4c_amr", name));
+      if (l > 1 && nested_radius[l-1] > nested_radius[l-2]) {
+        std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                  << std::endl << "<z4c_amr>/nested_radius_<l> must not increase with "
+                  << "level l" << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+    }
+    std::string shape = pin->GetOrAddString("z4c_amr", "nested_shape", "sphere");
+    if (shape != "sphere" && shape != "box") {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "<z4c_amr>/nested_shape = '" << shape
+                << "' must be sphere or box" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+    nested_box = (shape == "box");
+    // optional field criterion, which may refine MBs beyond the nested regions
+    std::string field = pin->GetOrAddString("z4c_amr", "field_criterion", "none");
+    if (field == "chi") {
+      field_method = Chi;
+      chi_thresh = pin->GetOrAddReal("z4c_amr", "chi_min", 0.2);
+    } else if (field == "dchi") {
+      field_method = dChi;
+      dchi_thresh = pin->GetOrAddReal("z4c_amr", "dchi_max", 0.1);
+    } else if (field != "none") {
+      std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+                << std::endl << "Unknown <z4c_amr>/field_criterion: " << field
+                << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
   } else if (ref_method == "chi") {
     method = Chi;
     chi_thresh = pin->GetOrAddReal("z4c_amr", "chi_min", 0.2);
@@ -55,15 +93,26 @@ Z4c_AMR::Z4c_AMR(ParameterInput *pin) {
   }
 }
 
+// The chi and dchi methods are evaluated with any other refinement criteria in the
+// fused kernel in MeshRefinement::CheckForRefinement, before the user function is called
+void Z4c_AMR::AddRefinementCriteria(Mesh *pm, DvceArray5D<Real> *pu0) {
+  if (method == Chi || field_method == Chi) {
+    pm->pmr->AddRefinementCriterion(RefinementCriterionType::min_value, pu0,
+                                    Z4c::I_Z4C_CHI, chi_thresh, 1.25*chi_thresh);
+  } else if (method == dChi || field_method == dChi) {
+    pm->pmr->AddRefinementCriterion(RefinementCriterionType::max_gradient, pu0,
+                                    Z4c::I_Z4C_CHI, dchi_thresh, 0.5*dchi_thresh);
+  }
+}
+
 // 1: refines, -1: de-refines, 0: does nothing
 void Z4c_AMR::Refine(MeshBlockPack *pmy_pack) {
   if (method == Tracker) {
     RefineTracker(pmy_pack);
-  } else if (method == Chi) {
-    RefineChiMin(pmy_pack);
-  } else if (method == dChi) {
-    RefineDchiMax(pmy_pack);
+  } else if (method == Nested) {
+    RefineNested(pmy_pack);
   }
+  // chi and dchi methods already applied through AddRefinementCriteria()
   RefineRadii(pmy_pack);
 }
 
@@ -82,13 +131,14 @@ void Z4c_AMR::RefineTracker(MeshBlockPack *pmbp) {
     // current refinement level
     int level = pmesh->lloc_eachmb[m + mbs].level - pmesh->root_level;
 
-    // extract MeshBlock bounds
-    Real &x1min = size.h_view(m).x1min;
-    Real &x1max = size.h_view(m).x1max;
-    Real &x2min = size.h_view(m).x2min;
-    Real &x2max = size.h_view(m).x2max;
-    Real &x3min = size.h_view(m).x3min;
-    Real &x3max = size.h_view(m).x3max;
+    // extract MeshBlock bounds (in physical coordinates)
+    auto &stretch = pmesh->stretch;
+    Real x1min = stretch.X(0, size.h_view(m).x1min);
+    Real x1max = stretch.X(0, size.h_view(m).x1max);
+    Real x2min = stretch.X(1, size.h_view(m).x2min);
+    Real x2max = stretch.X(1, size.h_view(m).x2max);
+    Real x3min = stretch.X(2, size.h_view(m).x3min);
+    Real x3max = stretch.X(2, size.h_view(m).x3max);
 
     flag.clear();
     for (auto & pt : pmbp->pz4c->ptracker) {
@@ -128,6 +178,62 @@ void Z4c_AMR::RefineTracker(MeshBlockPack *pmbp) {
   refine_flag.template sync<DevExeSpace>();
 }
 
+// refine MBs to the level of the innermost nested region around any tracker that they
+// intersect, using only the MB bounds and tracker positions.  With a field criterion,
+// whose flags are already set, MBs are refined further where it requires, but are not
+// derefined below the level of the nested regions.
+void Z4c_AMR::RefineNested(MeshBlockPack *pmbp) {
+  Mesh *pmesh       = pmbp->pmesh;
+  auto &refine_flag = pmesh->pmr->refine_flag;
+  auto &size        = pmbp->pmb->mb_size;
+  int nmb           = pmbp->nmb_thispack;
+  int mbs           = pmesh->gids_eachrank[global_variable::my_rank];
+  int nlev          = static_cast<int>(nested_radius.size());
+
+  for (int m = 0; m < nmb; ++m) {
+    // current refinement level
+    int level = pmesh->lloc_eachmb[m + mbs].level - pmesh->root_level;
+
+    // extract MeshBlock bounds (in physical coordinates)
+    auto &stretch = pmesh->stretch;
+    Real xmin[3] = {stretch.X(0, size.h_view(m).x1min),
+                    stretch.X(1, size.h_view(m).x2min),
+                    stretch.X(2, size.h_view(m).x3min)};
+    Real xmax[3] = {stretch.X(0, size.h_view(m).x1max),
+                    stretch.X(1, size.h_view(m).x2max),
+                    stretch.X(2, size.h_view(m).x3max)};
+
+    // level required by the nested regions around all trackers
+    int target = 0;
+    for (auto & pt : pmbp->pz4c->ptracker) {
+      // distance (Euclidean, or max-norm for boxes) from tracker to closest point of MB
+      Real dist = 0.0;
+      for (int a = 0; a < 3; ++a) {
+        Real da = std::max(std::max(xmin[a] - pt.GetPos(a), pt.GetPos(a) - xmax[a]),
+                           static_cast<Real>(0.0));
+        dist = (nested_box)? std::max(dist, da) : dist + SQ(da);
+      }
+      if (!(nested_box)) dist = std::sqrt(dist);
+      while (target < nlev && dist <= nested_radius[target]) {
+        ++target;
+      }
+    }
+
+    int &flag = refine_flag.h_view(m + mbs);
+    if (level < target) {
+      flag = 1;
+    } else if (field_method == Trivial) {
+      flag = (level == target)? 0 : -1;
+    } else if (level == target && flag < 0) {
+      flag = 0;
+    }
+  }
+
+  // sync host and device
+  refine_flag.template modify<HostMemSpace>();
+  refine_flag.template sync<DevExeSpace>();
+}
+
 // refine based on min{chi}
 void Z4c_AMR::RefineChiMin(MeshBlockPack *pmbp) {
   Mesh *pmesh       = pmbp->pmesh;
@@ -235,13 +341,14 @@ void Z4c_AMR::RefineRadii(MeshBlockPack *pmbp) {
     // current refinement level
     int level = pmesh->lloc_eachmb[m + mbs].level - pmesh->root_level;
 
-    // extract MeshBlock bounds
-    Real &x1min = size.h_view(m).x1min;
-    Real &x1max = size.h_view(m).x1max;
-    Real &x2min = size.h_view(m).x2min;
-    Real &x2max = size.h_view(m).x2max;
-    Real &x3min = size.h_view(m).x3min;
-    Real &x3max = size.h_view(m).x3max;
+    // extract MeshBlock bounds (in physical coordinates)
+    auto &stretch = pmesh->stretch;
+    Real x1min = stretch.X(0, size.h_view(m).x1min);
+    Real x1max = stretch.X(0, size.h_view(m).x1max);
+    Real x2min = stretch.X(1, size.h_view(m).x2min);
+    Real x2max = stretch.X(1, size.h_view(m).x2max);
+    Real x3min = stretch.X(2, size.h_view(m).x3min);
+    Real x3max = stretch.X(2, size.h_view(m).x3max);
 
     Real r2[8] = {
       SQ(x1min) + SQ(x2min) + SQ(x3min),
@@ -14,6 +14,7 @@
 
 class ParameterInput;
 class MeshBlockPack;
+class Mesh;
 
 namespace z4c {
 class Z4c;
@@ -21,19 +22,27 @@ class Z4c;
 //! \class Z4c_AMR
 //  \brief managing AMR for Z4c simulations
 class Z4c_AMR {
-  enum RefinementMethod { Trivial, Tracker, Chi, dChi };
+  enum RefinementMethod { Trivial, Tracker, Nested, Chi, dChi };
 
  public:
   explicit Z4c_AMR(ParameterInput *pin);
   ~Z4c_AMR() noexcept = default;
 
+  void AddRefinementCriteria(Mesh *pm, DvceArray5D<Real> *pu0);  // chi/dchi criteria
   void Refine(MeshBlockPack *pmbp);             // call the AMR method
   void RefineTracker(MeshBlockPack *pmbp);      // Refine based on the trackers
+  void RefineNested(MeshBlockPack *pmbp);       // Nested regions around the trackers
   void RefineChiMin(MeshBlockPack *pmbp);       // Refine based on min{chi}
   void RefineDchiMax(MeshBlockPack *pmbp);      // Refine based on max{dchi}
   void RefineRadii(MeshBlockPack *pmbp);        // Refine based on the radii
 
   RefinementMethod method;
+  RefinementMethod field_method;  // chi/dchi criterion layered on top of Nested method
+
+  // With the Nested method, MBs intersecting the sphere (or cube) of radius
+  // nested_radius[l-1] around any tracker are refined to at least level l
+  std::vector<Real> nested_radius;
+  bool nested_box;
 
   // Optinally set the minimum refinement level inside different radial shells
   std::vector<Real> radius;
@@ -16,559 +16,768 @@
 #include "athena.hpp"
 #include "mesh/mesh.hpp"
 #include "coordinates/adm.hpp"
+#include "driver/driver.hpp"
+#include "driver/profiler.hpp"
 #include "z4c/z4c.hpp"
+#include "z4c/z4c_Sbc.hpp"
+#include "z4c/z4c_algconstr.hpp"
 #include "z4c/tmunu.hpp"
 #include "coordinates/cell_locations.hpp"
 
 namespace z4c {
 
-template <int NGHOST>
-//! \fn void Z4c::CalcRHS(Driver *pdriver, int stage)
-//! \brief compute rhs of the z4c equations
-TaskStatus Z4c::CalcRHS(Driver *pdriver, int stage) {
-  auto &indcs = pmy_pack->pmesh->mb_indcs;
-  auto &size = pmy_pack->pmb->mb_size;
-  int &is = indcs.is; int &ie = indcs.ie;
-  int &js = indcs.js; int &je = indcs.je;
-  int &ks = indcs.ks; int &ke = indcs.ke;
-
-  int nmb = pmy_pack->nmb_thispack;
+//----------------------------------------------------------------------------------------
+//! \struct Z4cRHSDerivs
+//! \brief finite-difference derivatives of the Z4c variables at one cell used by the RHS.
+//! These are computed either directly from global memory (Z4cRHSDerivatives) or from
+//! tiles in team scratch memory (CalcRHSTiled), and then passed to Z4cRHSAlgebra.
+
+struct Z4cRHSDerivs {
+  // lapse, chi, Khat and Theta 1st drvts
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dalpha_d, dchi_d, dKhat_d, dTheta_d;
+  // lapse and chi 2nd drvts
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> ddalpha_dd, ddchi_dd;
+  // shift and Gamma 1st drvts
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 2> dbeta_du, dGam_du;
+  // metric 1st drvts
+  AthenaScratchTensor<Real, TensorSymm::SYM2,  3, 3> dg_ddd;
+  // shift 2nd drvts
+  AthenaScratchTensor<Real, TensorSymm::ISYM2, 3, 3> ddbeta_ddu;
+  // metric 2nd drvts
+  AthenaScratchTensor<Real, TensorSymm::SYM22, 3, 4> ddg_dddd;
+  // Lie derivatives of lapse, chi, Khat and Theta along the shift vector
+  Real Lalpha, Lchi, LKhat, LTheta;
+  // Lie derivatives of Gamma and the shift
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> LGam_u, Lbeta_u;
+  // Lie derivatives of conf. 3-metric and A
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> Lg_dd, LA_dd;
+};
+
+//----------------------------------------------------------------------------------------
+//! \fn void Z4cRHSDerivatives
+//! \brief computes all derivatives in Z4cRHSDerivs at cell (m,k,j,i) from global memory.
+//! idx and cdd are set by CoordinateStretch::CellFDFactors() (cdd is zero if uniform).
 
-  auto &z4c = pmy_pack->pz4c->z4c;
-  auto &rhs = pmy_pack->pz4c->rhs;
-  auto &opt = pmy_pack->pz4c->opt;
-
-  bool is_vacuum = (pmy_pack->ptmunu == nullptr) ? true : false;
-  Tmunu::Tmunu_vars tmunu;
-  if (!is_vacuum) tmunu = pmy_pack->ptmunu->tmunu;
-
-  // ===================================================================================
-  // Main RHS calculation
+template <int NGHOST>
+KOKKOS_INLINE_FUNCTION
+void Z4cRHSDerivatives(const Z4c::Z4c_vars &z4c, const Real idx[], const Real cdd[],
+                       const int m, const int k, const int j, const int i,
+                       Z4cRHSDerivs &d) {
+  auto &dalpha_d = d.dalpha_d;
+  auto &dchi_d = d.dchi_d;
+  auto &dKhat_d = d.dKhat_d;
+  auto &dTheta_d = d.dTheta_d;
+  auto &ddalpha_dd = d.ddalpha_dd;
+  auto &dbeta_du = d.dbeta_du;
+  auto &ddchi_dd = d.ddchi_dd;
+  auto &dGam_du = d.dGam_du;
+  auto &dg_ddd = d.dg_ddd;
+  auto &ddbeta_ddu = d.ddbeta_ddu;
+  auto &ddg_dddd = d.ddg_dddd;
+  auto &Lalpha = d.Lalpha;
+  auto &Lchi = d.Lchi;
+  auto &LKhat = d.LKhat;
+  auto &LTheta = d.LTheta;
+  auto &LGam_u = d.LGam_u;
+  auto &Lbeta_u = d.Lbeta_u;
+  auto &Lg_dd = d.Lg_dd;
+  auto &LA_dd = d.LA_dd;
+
+  Lalpha = 0.0;
+  Lchi = 0.0;
+  LKhat = 0.0;
+  LTheta = 0.0;
+  for (int a = 0; a < 3; ++a) {
+    Lbeta_u(a) = 0.0;
+    LGam_u(a) = 0.0;
+  }
+  for (int a = 0; a < 3; ++a)
+  for (int b = a; b < 3; ++b) {
+    Lg_dd(a,b) = 0.0;
+    LA_dd(a,b) = 0.0;
+  }
+
+  // -----------------------------------------------------------------------------------
+  // 1st derivatives
+  //
+  // Scalars
+  for(int a = 0; a < 3; ++a) {
+    dalpha_d(a) = Dx<NGHOST>(a, idx, z4c.alpha, m,k,j,i);
+    dchi_d  (a) = Dx<NGHOST>(a, idx, z4c.chi,   m,k,j,i);
+    dKhat_d (a) = Dx<NGHOST>(a, idx, z4c.vKhat,  m,k,j,i);
+    dTheta_d(a) = Dx<NGHOST>(a, idx, z4c.vTheta, m,k,j,i);
+  }
+
+  // Vectors
+  for(int a = 0; a < 3; ++a)
+  for(int b = 0; b < 3; ++b) {
+    dbeta_du(b,a) = Dx<NGHOST>(b, idx, z4c.beta_u, m,a,k,j,i);
+    dGam_du(b,a) = Dx<NGHOST>(b, idx, z4c.vGam_u,  m,a,k,j,i);
+  }
+
+  // Tensors
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b)
+  for(int c = 0; c < 3; ++c) {
+    dg_ddd(c,a,b) = Dx<NGHOST>(c, idx, z4c.g_dd, m,a,b,k,j,i);
+  }
+
+  // -----------------------------------------------------------------------------------
+  // 2nd derivatives
+  //
+  // Scalars
+  for(int a = 0; a < 3; ++a) {
+    ddalpha_dd(a,a) = Dxx<NGHOST>(a, idx, z4c.alpha, m,k,j,i) - cdd[a]*dalpha_d(a);
+    ddchi_dd(a,a) = Dxx<NGHOST>(a, idx, z4c.chi,   m,k,j,i) - cdd[a]*dchi_d(a);
+
+    for(int b = a + 1; b < 3; ++b) {
+      ddalpha_dd(a,b) = Dxy<NGHOST>(a, b, idx, z4c.alpha, m,k,j,i);
+      ddchi_dd(a,b) = Dxy<NGHOST>(a, b, idx, z4c.chi,   m,k,j,i);
+    }
+  }
+
+  // Vectors
+  for(int c = 0; c < 3; ++c)
+  for(int a = 0; a < 3; ++a) {
+    ddbeta_ddu(a,a,c) = Dxx<NGHOST>(a, idx, z4c.beta_u, m,c,k,j,i)
+                        - cdd[a]*dbeta_du(a,c);
+    for(int b = a + 1; b < 3; ++b) {
+      ddbeta_ddu(a,b,c) = Dxy<NGHOST>(a, b, idx, z4c.beta_u, m,c,k,j,i);
+    }
+  }
+
+  // Tensors
+  for(int c = 0; c < 3; ++c)
+  for(int d = c; d < 3; ++d)
+  for(int a = 0; a < 3; ++a) {
+    ddg_dddd(a,a,c,d) = Dxx<NGHOST>(a, idx, z4c.g_dd, m,c,d,k,j,i)
+                        - cdd[a]*dg_ddd(a,c,d);
+    for(int b = a + 1; b < 3; ++b) {
+      ddg_dddd(a,b,c,d) = Dxy<NGHOST>(a, b, idx, z4c.g_dd, m,c,d,k,j,i);
+    }
+  }
+
+  // -----------------------------------------------------------------------------------
+  // Advective derivatives
   //
-  par_for("z4c rhs loop",DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
-  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
-    // Define scratch arrays to be used in the following calculations
-
-    // Gamma computed from the metric
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> Gamma_u;
-    // Covariant derivative of A
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> DA_u;
-
-    // inverse of conf. metric
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> g_uu;
-    // inverse of A
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> A_uu;
-    // g^cd A_ac A_db
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> AA_dd;
-    // Ricci tensor
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> R_dd;
-    // Ricci tensor, conformal contribution
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> Rphi_dd;
-    // 2nd differential of the lapse
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> Ddalpha_dd;
-    // 2nd differential of phi
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> Ddphi_dd;
-
-    // Christoffel symbols of 1st kind
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_ddd;
-    // Christoffel symbols of 2nd kind
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_udd;
-
-    // auxiliary derivatives
-
-    // lapse 1st drvts
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dalpha_d;
-    // 2nd "divergence" of beta
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> ddbeta_d;
-    // chi 1st drvts
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dchi_d;
-    // phi 1st drvts
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dphi_d;
-    // Khat 1st drvts
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dKhat_d;
-    // Theta 1st drvts
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dTheta_d;
-
-    // lapse 2nd drvts
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> ddalpha_dd;
-    // shift 1st drvts
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 2> dbeta_du;
-    // chi 2nd drvts
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> ddchi_dd;
-    // Gamma 1st drvts
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 2> dGam_du;
-
-    // metric 1st drvts
-    AthenaScratchTensor<Real, TensorSymm::SYM2,  3, 3> dg_ddd;
-    // shift 2nd drvts
-    AthenaScratchTensor<Real, TensorSymm::ISYM2, 3, 3> ddbeta_ddu;
-
-    // metric 2nd drvts
-    AthenaScratchTensor<Real, TensorSymm::SYM22, 3, 4> ddg_dddd;
-
-    // Lie derivative of Gamma
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> LGam_u;
-    // Lie derivative of the shift
-    AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> Lbeta_u;
-
-    // Lie derivative of conf. 3-metric
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> Lg_dd;
-    // Lie derivative of A
-    AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> LA_dd;
-
-    Real idx[] = {1/size.d_view(m).dx1, 1/size.d_view(m).dx2, 1/size.d_view(m).dx3};
-
-    // -----------------------------------------------------------------------------------
-    // Initialize everything to zero
-    //
-    // Scalars
-
-    // auxiliary Lie derivatives along the shift vector
-    // Lie derivative of the lapse
-    Real Lalpha = 0.0;
-    // Lie derivative of chi
-    Real Lchi = 0.0;
-    // Lie derivative of Khat
-    Real LKhat = 0.0;
-    // Lie derivative of Theta
-    Real LTheta = 0.0;
-
-    // determinant of three metric
-    Real detg = 0.0;
-    // bounded version of chi
-    Real chi_guarded = 0.0;
-    // 1/psi4
-    Real oopsi4 = 0.0;
-    // trace of A
-    Real AA = 0.0;
-    // Ricci scalar
-    Real R = 0.0;
-    // tilde H
-    Real Ht = 0.0;
-    // trace of extrinsic curvature
-    Real K = 0.0;
-    // Trace of S_ik
-    Real S = 0.0;
-    // Trace of Ddalpha_dd
-    Real Ddalpha = 0.0;
-
-    // d_a beta^a
-    Real dbeta = 0.0;
-
-    //
-    // Vectors
-    for (int a = 0; a < 3; ++a) {
-      Lbeta_u(a) = 0.0;
-      LGam_u(a) = 0.0;
-      Gamma_u(a) = 0.0;
-      DA_u(a) = 0.0;
-      ddbeta_d(a) = 0.0;
-    }
 
-    //
-    // Symmetric tensors
-    for (int a = 0; a < 3; ++a)
-    for (int b = a; b < 3; ++b) {
-      Lg_dd(a,b) = 0.0;
-      LA_dd(a,b) = 0.0;
-      AA_dd(a,b) = 0.0;
-      R_dd(a,b) = 0.0;
-      A_uu(a,b) = 0.0;
-      for (int c = 0; c < 3; ++c) {
-          Gamma_udd(c,a,b) = 0.0;
-      }
-    }
+  //
+  // Scalars
+  for(int a = 0; a < 3; ++a) {
+    Lalpha += Lx<NGHOST>(a, idx, z4c.beta_u, z4c.alpha, m,a,k,j,i);
+    Lchi   += Lx<NGHOST>(a, idx, z4c.beta_u, z4c.chi,   m,a,k,j,i);
+    LKhat  += Lx<NGHOST>(a, idx, z4c.beta_u, z4c.vKhat,  m,a,k,j,i);
+    LTheta += Lx<NGHOST>(a, idx, z4c.beta_u, z4c.vTheta, m,a,k,j,i);
+  }
 
-    // -----------------------------------------------------------------------------------
-    // 1st derivatives
-    //
-    // Scalars
-    for(int a = 0; a < 3; ++a) {
-      dalpha_d(a) = Dx<NGHOST>(a, idx, z4c.alpha, m,k,j,i);
-      dchi_d  (a) = Dx<NGHOST>(a, idx, z4c.chi,   m,k,j,i);
-      dKhat_d (a) = Dx<NGHOST>(a, idx, z4c.vKhat,  m,k,j,i);
-      dTheta_d(a) = Dx<NGHOST>(a, idx, z4c.vTheta, m,k,j,i);
-    }
+  //
+  // Vectors
+  for(int a = 0; a < 3; ++a)
+  for(int b = 0; b < 3; ++b) {
+    Lbeta_u(b) += Lx<NGHOST>(a, idx, z4c.beta_u, z4c.beta_u, m,a,b,k,j,i);
+    LGam_u(b)  += Lx<NGHOST>(a, idx, z4c.beta_u, z4c.vGam_u,  m,a,b,k,j,i);
+  }
 
-    // Vectors
-    for(int a = 0; a < 3; ++a)
-    for(int b = 0; b < 3; ++b) {
-      dbeta_du(b,a) = Dx<NGHOST>(b, idx, z4c.beta_u, m,a,k,j,i);
-      dGam_du(b,a) = Dx<NGHOST>(b, idx, z4c.vGam_u,  m,a,k,j,i);
-    }
+  //
+  // Tensors
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b)
+  for(int c = 0; c < 3; ++c) {
+    Lg_dd(a,b) += Lx<NGHOST>(c, idx, z4c.beta_u, z4c.g_dd, m,c,a,b,k,j,i);
+    LA_dd(a,b) += Lx<NGHOST>(c, idx, z4c.beta_u, z4c.vA_dd, m,c,a,b,k,j,i);
+  }
+}
 
-    // Tensors
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b)
+//----------------------------------------------------------------------------------------
+//! \fn void Z4cRHSAlgebra
+//! \brief computes the RHS of the Z4c equations at cell (m,k,j,i) from the derivatives d
+//! (which are modified) and the variables at the cell itself
+
+KOKKOS_INLINE_FUNCTION
+void Z4cRHSAlgebra(const Z4c::Z4c_vars &z4c, const Z4c::Z4c_vars &rhs,
+                   const Z4c::Options &opt, const bool is_vacuum,
+                   const Tmunu::Tmunu_vars &tmunu,
+                   const int m, const int k, const int j, const int i,
+                   Z4cRHSDerivs &d) {
+  auto &dalpha_d = d.dalpha_d;
+  auto &dchi_d = d.dchi_d;
+  auto &dKhat_d = d.dKhat_d;
+  auto &dTheta_d = d.dTheta_d;
+  auto &ddalpha_dd = d.ddalpha_dd;
+  auto &dbeta_du = d.dbeta_du;
+  auto &ddchi_dd = d.ddchi_dd;
+  auto &dGam_du = d.dGam_du;
+  auto &dg_ddd = d.dg_ddd;
+  auto &ddbeta_ddu = d.ddbeta_ddu;
+  auto &ddg_dddd = d.ddg_dddd;
+  auto &Lalpha = d.Lalpha;
+  auto &Lchi = d.Lchi;
+  auto &LKhat = d.LKhat;
+  auto &LTheta = d.LTheta;
+  auto &LGam_u = d.LGam_u;
+  auto &Lbeta_u = d.Lbeta_u;
+  auto &Lg_dd = d.Lg_dd;
+  auto &LA_dd = d.LA_dd;
+
+  // Gamma computed from the metric
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> Gamma_u;
+  // Covariant derivative of A
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> DA_u;
+
+  // inverse of conf. metric
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> g_uu;
+  // inverse of A
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> A_uu;
+  // g^cd A_ac A_db
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> AA_dd;
+  // Ricci tensor
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> R_dd;
+  // Ricci tensor, conformal contribution
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> Rphi_dd;
+  // 2nd differential of the lapse
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> Ddalpha_dd;
+  // 2nd differential of phi
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 2> Ddphi_dd;
+
+  // Christoffel symbols of 1st kind
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_ddd;
+  // Christoffel symbols of 2nd kind
+  AthenaScratchTensor<Real, TensorSymm::SYM2, 3, 3> Gamma_udd;
+
+  // 2nd "divergence" of beta
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> ddbeta_d;
+  // phi 1st drvts
+  AthenaScratchTensor<Real, TensorSymm::NONE, 3, 1> dphi_d;
+
+  // determinant of three metric
+  Real detg = 0.0;
+  // bounded version of chi
+  Real chi_guarded = 0.0;
+  // 1/psi4
+  Real oopsi4 = 0.0;
+  // trace of A
+  Real AA = 0.0;
+  // Ricci scalar
+  Real R = 0.0;
+  // tilde H
+  Real Ht = 0.0;
+  // trace of extrinsic curvature
+  Real K = 0.0;
+  // Trace of S_ik
+  Real S = 0.0;
+  // Trace of Ddalpha_dd
+  Real Ddalpha = 0.0;
+
+  // d_a beta^a
+  Real dbeta = 0.0;
+
+  for (int a = 0; a < 3; ++a) {
+    Gamma_u(a) = 0.0;
+    DA_u(a) = 0.0;
+    ddbeta_d(a) = 0.0;
+  }
+  for (int a = 0; a < 3; ++a)
+  for (int b = a; b < 3; ++b) {
+    AA_dd(a,b) = 0.0;
+    R_dd(a,b) = 0.0;
+    A_uu(a,b) = 0.0;
+    for (int c = 0; c < 3; ++c) {
+        Gamma_udd(c,a,b) = 0.0;
+    }
+  }
+
+  // -----------------------------------------------------------------------------------
+  // Get K from Khat
+  //
+  K = z4c.vKhat(m,k,j,i) + 2.*z4c.vTheta(m,k,j,i);
+
+  // -----------------------------------------------------------------------------------
+  // Inverse metric
+
+  detg = adm::SpatialDet(z4c.g_dd(m,0,0,k,j,i), z4c.g_dd(m,0,1,k,j,i),
+                            z4c.g_dd(m,0,2,k,j,i), z4c.g_dd(m,1,1,k,j,i),
+                            z4c.g_dd(m,1,2,k,j,i), z4c.g_dd(m,2,2,k,j,i));
+  adm::SpatialInv(1.0/detg,
+             z4c.g_dd(m,0,0,k,j,i), z4c.g_dd(m,0,1,k,j,i), z4c.g_dd(m,0,2,k,j,i),
+             z4c.g_dd(m,1,1,k,j,i), z4c.g_dd(m,1,2,k,j,i), z4c.g_dd(m,2,2,k,j,i),
+             &g_uu(0,0), &g_uu(0,1), &g_uu(0,2),
+             &g_uu(1,1), &g_uu(1,2), &g_uu(2,2));
+
+  // -----------------------------------------------------------------------------------
+  // Christoffel symbols
+
+  for(int c = 0; c < 3; ++c)
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b) {
+    Gamma_ddd(c,a,b) = 0.5*(dg_ddd(a,b,c) + dg_ddd(b,a,c) - dg_ddd(c,a,b));
+  }
+  for(int c = 0; c < 3; ++c)
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b)
+  for(int d = 0; d < 3; ++d) {
+    Gamma_udd(c,a,b) += g_uu(c,d)*Gamma_ddd(d,a,b);
+  }
+  // Gamma's computed from the conformal metric (not evolved)
+  for(int a = 0; a < 3; ++a)
+  for(int b = 0; b < 3; ++b)
+  for(int c = 0; c < 3; ++c) {
+    Gamma_u(a) += g_uu(b,c)*Gamma_udd(a,b,c);
+  }
+
+  // -----------------------------------------------------------------------------------
+  // Curvature of conformal metric
+  //
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b) {
     for(int c = 0; c < 3; ++c) {
-      dg_ddd(c,a,b) = Dx<NGHOST>(c, idx, z4c.g_dd, m,a,b,k,j,i);
+      R_dd(a,b) += 0.5*(z4c.g_dd(m,c,a,k,j,i)*dGam_du(b,c) +
+                        z4c.g_dd(m,c,b,k,j,i)*dGam_du(a,c) +
+                        Gamma_u(c)*(Gamma_ddd(a,b,c) + Gamma_ddd(b,a,c)));
     }
-
-    // -----------------------------------------------------------------------------------
-    // 2nd derivatives
-    //
-    // Scalars
-    for(int a = 0; a < 3; ++a) {
-      ddalpha_dd(a,a) = Dxx<NGHOST>(a, idx, z4c.alpha, m,k,j,i);
-      ddchi_dd(a,a) = Dxx<NGHOST>(a, idx, z4c.chi,   m,k,j,i);
-
-      for(int b = a + 1; b < 3; ++b) {
-        ddalpha_dd(a,b) = Dxy<NGHOST>(a, b, idx, z4c.alpha, m,k,j,i);
-        ddchi_dd(a,b) = Dxy<NGHOST>(a, b, idx, z4c.chi,   m,k,j,i);
-      }
-    }
-
-    // Vectors
     for(int c = 0; c < 3; ++c)
-    for(int a = 0; a < 3; ++a) {
-      ddbeta_ddu(a,a,c) = Dxx<NGHOST>(a, idx, z4c.beta_u, m,c,k,j,i);
-      for(int b = a + 1; b < 3; ++b) {
-        ddbeta_ddu(a,b,c) = Dxy<NGHOST>(a, b, idx, z4c.beta_u, m,c,k,j,i);
-      }
+    for(int d = 0; d < 3; ++d) {
+      R_dd(a,b) -= 0.5*g_uu(c,d)*ddg_dddd(c,d,a,b);
     }
-
-    // Tensors
     for(int c = 0; c < 3; ++c)
-    for(int d = c; d < 3; ++d)
-    for(int a = 0; a < 3; ++a) {
-      ddg_dddd(a,a,c,d) = Dxx<NGHOST>(a, idx, z4c.g_dd, m,c,d,k,j,i);
-      for(int b = a + 1; b < 3; ++b) {
-        ddg_dddd(a,b,c,d) = Dxy<NGHOST>(a, b, idx, z4c.g_dd, m,c,d,k,j,i);
-      }
+    for(int d = 0; d < 3; ++d)
+    for(int e = 0; e < 3; ++e) {
+      R_dd(a,b) += g_uu(c,d)*(
+          Gamma_udd(e,c,a)*Gamma_ddd(b,e,d) +
+          Gamma_udd(e,c,b)*Gamma_ddd(a,e,d) +
+          Gamma_udd(e,a,d)*Gamma_ddd(e,c,b));
     }
+  }
 
-    // -----------------------------------------------------------------------------------
-    // Advective derivatives
-    //
-
-    //
-    // Scalars
-    for(int a = 0; a < 3; ++a) {
-      Lalpha += Lx<NGHOST>(a, idx, z4c.beta_u, z4c.alpha, m,a,k,j,i);
-      Lchi   += Lx<NGHOST>(a, idx, z4c.beta_u, z4c.chi,   m,a,k,j,i);
-      LKhat  += Lx<NGHOST>(a, idx, z4c.beta_u, z4c.vKhat,  m,a,k,j,i);
-      LTheta += Lx<NGHOST>(a, idx, z4c.beta_u, z4c.vTheta, m,a,k,j,i);
-    }
-
-    //
-    // Vectors
-    for(int a = 0; a < 3; ++a)
-    for(int b = 0; b < 3; ++b) {
-      Lbeta_u(b) += Lx<NGHOST>(a, idx, z4c.beta_u, z4c.beta_u, m,a,b,k,j,i);
-      LGam_u(b)  += Lx<NGHOST>(a, idx, z4c.beta_u, z4c.vGam_u,  m,a,b,k,j,i);
-    }
-
-    //
-    // Tensors
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b)
+  // -----------------------------------------------------------------------------------
+  // Derivatives of conformal factor phi
+  //
+  chi_guarded = (z4c.chi(m,k,j,i)>opt.chi_div_floor)
+                  ? z4c.chi(m,k,j,i) : opt.chi_div_floor;
+  oopsi4 = pow(chi_guarded, -4./opt.chi_psi_power);
+  for(int a = 0; a < 3; ++a) {
+    dphi_d(a) = dchi_d(a)/(chi_guarded * opt.chi_psi_power);
+  }
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b) {
+    Ddphi_dd(a,b) = ddchi_dd(a,b)/(chi_guarded * opt.chi_psi_power) -
+      opt.chi_psi_power * dphi_d(a) * dphi_d(b);
     for(int c = 0; c < 3; ++c) {
-      Lg_dd(a,b) += Lx<NGHOST>(c, idx, z4c.beta_u, z4c.g_dd, m,c,a,b,k,j,i);
-      LA_dd(a,b) += Lx<NGHOST>(c, idx, z4c.beta_u, z4c.vA_dd, m,c,a,b,k,j,i);
+      Ddphi_dd(a,b) -= Gamma_udd(c,a,b)*dphi_d(c);
     }
+  }
 
-    // -----------------------------------------------------------------------------------
-    // Get K from Khat
-    //
-    K = z4c.vKhat(m,k,j,i) + 2.*z4c.vTheta(m,k,j,i);
-
-    // -----------------------------------------------------------------------------------
-    // Inverse metric
-
-    detg = adm::SpatialDet(z4c.g_dd(m,0,0,k,j,i), z4c.g_dd(m,0,1,k,j,i),
-                              z4c.g_dd(m,0,2,k,j,i), z4c.g_dd(m,1,1,k,j,i),
-                              z4c.g_dd(m,1,2,k,j,i), z4c.g_dd(m,2,2,k,j,i));
-    adm::SpatialInv(1.0/detg,
-               z4c.g_dd(m,0,0,k,j,i), z4c.g_dd(m,0,1,k,j,i), z4c.g_dd(m,0,2,k,j,i),
-               z4c.g_dd(m,1,1,k,j,i), z4c.g_dd(m,1,2,k,j,i), z4c.g_dd(m,2,2,k,j,i),
-               &g_uu(0,0), &g_uu(0,1), &g_uu(0,2),
-               &g_uu(1,1), &g_uu(1,2), &g_uu(2,2));
-
-    // -----------------------------------------------------------------------------------
-    // Christoffel symbols
-
-    for(int c = 0; c < 3; ++c)
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b) {
-      Gamma_ddd(c,a,b) = 0.5*(dg_ddd(a,b,c) + dg_ddd(b,a,c) - dg_ddd(c,a,b));
-    }
+  // -----------------------------------------------------------------------------------
+  // Curvature contribution from conformal factor
+  //
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b) {
+    Rphi_dd(a,b) = 4.*dphi_d(a)*dphi_d(b) - 2.*Ddphi_dd(a,b);
     for(int c = 0; c < 3; ++c)
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b)
     for(int d = 0; d < 3; ++d) {
-      Gamma_udd(c,a,b) += g_uu(c,d)*Gamma_ddd(d,a,b);
-    }
-    // Gamma's computed from the conformal metric (not evolved)
-    for(int a = 0; a < 3; ++a)
-    for(int b = 0; b < 3; ++b)
-    for(int c = 0; c < 3; ++c) {
-      Gamma_u(a) += g_uu(b,c)*Gamma_udd(a,b,c);
+      Rphi_dd(a,b) -= 2.*z4c.g_dd(m,a,b,k,j,i) * g_uu(c,d)*(Ddphi_dd(c,d) +
+          2.*dphi_d(c)*dphi_d(d));
     }
+  }
 
-    // -----------------------------------------------------------------------------------
-    // Curvature of conformal metric
-    //
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b) {
-      for(int c = 0; c < 3; ++c) {
-        R_dd(a,b) += 0.5*(z4c.g_dd(m,c,a,k,j,i)*dGam_du(b,c) +
-                          z4c.g_dd(m,c,b,k,j,i)*dGam_du(a,c) +
-                          Gamma_u(c)*(Gamma_ddd(a,b,c) + Gamma_ddd(b,a,c)));
-      }
-      for(int c = 0; c < 3; ++c)
+  // TODO(JMF): Update with Tmunu terms.
+  // -----------------------------------------------------------------------------------
+  // Trace of the matter stress tensor
+  //
+  // Matter commented out
+  //S.ZeroClear();
+  //member.team_barrier();
+  //for(int a = 0; a < 3; ++a)
+  //for(int b = 0; b < 3; ++b) {
+  //  ILOOP1(1) {
+  //    S(1) += oopsi4(1) * g_uu(a,b,i) * mat.S_dd(m,a,b,k,j,i);
+  //  }
+  //}
+  if(!is_vacuum) {
+    for (int a = 0; a < 3; ++a)
+    for (int b = 0; b < 3; ++b) {
+      S += oopsi4 * g_uu(a,b) * tmunu.S_dd(m,a,b,k,j,i);
+    }
+  }
+
+  // -----------------------------------------------------------------------------------
+  // 2nd covariant derivative of the lapse
+  // TODO(JMF): This could potentially be sped up by calculating d_i phi d^i alpha
+  // beforehand.
+  for(int a = 0; a < 3; ++a)
+  for(int b = 0; b < 3; ++b) {
+    Ddalpha_dd(a,b) = ddalpha_dd(a,b)
+                     - 2.*(dphi_d(a)*dalpha_d(b) + dphi_d(b)*dalpha_d(a));
+    for(int c = 0; c < 3; ++c) {
+      Ddalpha_dd(a,b) -= Gamma_udd(c,a,b)*dalpha_d(c);
       for(int d = 0; d < 3; ++d) {
-        R_dd(a,b) -= 0.5*g_uu(c,d)*ddg_dddd(c,d,a,b);
-      }
-      for(int c = 0; c < 3; ++c)
-      for(int d = 0; d < 3; ++d)
-      for(int e = 0; e < 3; ++e) {
-        R_dd(a,b) += g_uu(c,d)*(
-            Gamma_udd(e,c,a)*Gamma_ddd(b,e,d) +
-            Gamma_udd(e,c,b)*Gamma_ddd(a,e,d) +
-            Gamma_udd(e,a,d)*Gamma_ddd(e,c,b));
+          Ddalpha_dd(a,b) += 2.*z4c.g_dd(m,a,b,k,j,i) * g_uu(c,d)
+          * dphi_d(c) * dalpha_d(d);
       }
     }
+  }
 
-    // -----------------------------------------------------------------------------------
-    // Derivatives of conformal factor phi
-    //
-    chi_guarded = (z4c.chi(m,k,j,i)>opt.chi_div_floor)
-                    ? z4c.chi(m,k,j,i) : opt.chi_div_floor;
-    oopsi4 = pow(chi_guarded, -4./opt.chi_psi_power);
-    for(int a = 0; a < 3; ++a) {
-      dphi_d(a) = dchi_d(a)/(chi_guarded * opt.chi_psi_power);
+  for(int a = 0; a < 3; ++a)
+  for(int b = 0; b < 3; ++b) {
+    Ddalpha += oopsi4 * g_uu(a,b) * Ddalpha_dd(a,b);
+  }
+
+  // -----------------------------------------------------------------------------------
+  // Contractions of A_ab, inverse, and derivatives
+  //
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b)
+  for(int c = 0; c < 3; ++c)
+  for(int d = 0; d < 3; ++d) {
+    AA_dd(a,b) += g_uu(c,d) * z4c.vA_dd(m,a,c,k,j,i) * z4c.vA_dd(m,d,b,k,j,i);
+  }
+  for(int a = 0; a < 3; ++a)
+  for(int b = 0; b < 3; ++b) {
+    AA += g_uu(a,b) * AA_dd(a,b);
+  }
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b)
+  for(int c = 0; c < 3; ++c)
+  for(int d = 0; d < 3; ++d) {
+    A_uu(a,b) += g_uu(a,c) * g_uu(b,d) * z4c.vA_dd(m,c,d,k,j,i);
+  }
+  // TODO(JMF): dchi_d/chi_guarded is opt.chi_psi_power * dphi_d.
+  for(int a = 0; a < 3; ++a) {
+    for(int b = 0; b < 3; ++b) {
+        DA_u(a) -= (3./2.) * A_uu(a,b) * dchi_d(b) / chi_guarded;
+        DA_u(a) -= (1./3.) * g_uu(a,b) * (2.*dKhat_d(b) + dTheta_d(b));
     }
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b) {
-      Ddphi_dd(a,b) = ddchi_dd(a,b)/(chi_guarded * opt.chi_psi_power) -
-        opt.chi_psi_power * dphi_d(a) * dphi_d(b);
-      for(int c = 0; c < 3; ++c) {
-        Ddphi_dd(a,b) -= Gamma_udd(c,a,b)*dphi_d(c);
-      }
+    for(int b = 0; b < 3; ++b)
+    for(int c = 0; c < 3; ++c) {
+      DA_u(a) += Gamma_udd(a,b,c) * A_uu(b,c);
     }
+  }
 
-    // -----------------------------------------------------------------------------------
-    // Curvature contribution from conformal factor
-    //
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b) {
-      Rphi_dd(a,b) = 4.*dphi_d(a)*dphi_d(b) - 2.*Ddphi_dd(a,b);
-      for(int c = 0; c < 3; ++c)
-      for(int d = 0; d < 3; ++d) {
-        Rphi_dd(a,b) -= 2.*z4c.g_dd(m,a,b,k,j,i) * g_uu(c,d)*(Ddphi_dd(c,d) +
-            2.*dphi_d(c)*dphi_d(d));
-      }
-    }
+  // -----------------------------------------------------------------------------------
+  // Ricci scalar
+  //
+  for(int a = 0; a < 3; ++a)
+  for(int b = 0; b < 3; ++b) {
+    R += oopsi4 * g_uu(a,b) * (R_dd(a,b) + Rphi_dd(a,b));
+  }
 
-    // TODO(JMF): Update with Tmunu terms.
-    // -----------------------------------------------------------------------------------
-    // Trace of the matter stress tensor
-    //
-    // Matter commented out
-    //S.ZeroClear();
-    //member.team_barrier();
-    //for(int a = 0; a < 3; ++a)
-    //for(int b = 0; b < 3; ++b) {
-    //  ILOOP1(1) {
-    //    S(1) += oopsi4(1) * g_uu(a,b,i) * mat.S_dd(m,a,b,k,j,i);
-    //  }
-    //}
-    if(!is_vacuum) {
-      for (int a = 0; a < 3; ++a)
-      for (int b = 0; b < 3; ++b) {
-        S += oopsi4 * g_uu(a,b) * tmunu.S_dd(m,a,b,k,j,i);
-      }
-    }
+  // -----------------------------------------------------------------------------------
+  // Hamiltonian constraint
+  //
+  Ht = R + (2./3.)*SQR(K) - AA;// - 16.*M_PI*tmunu.E(m,k,j,i);
 
-    // -----------------------------------------------------------------------------------
-    // 2nd covariant derivative of the lapse
-    // TODO(JMF): This could potentially be sped up by calculating d_i phi d^i alpha
-    // beforehand.
-    for(int a = 0; a < 3; ++a)
+  // -----------------------------------------------------------------------------------
+  // Finalize advective (Lie) derivatives
+  //
+  // Shift vector contractions
+  for(int a = 0; a < 3; ++a) {
+    dbeta += dbeta_du(a,a);
+  }
+  for(int a = 0; a < 3; ++a)
+  for(int b = 0; b < 3; ++b) {
+    ddbeta_d(a) += (1./3.) * ddbeta_ddu(a,b,b);
+  }
+
+  // Finalize Lchi
+  Lchi += (1./6.) * opt.chi_psi_power * chi_guarded * dbeta;
+
+  // Finalize LGam_u (note that this is not a real Lie derivative)
+  for(int a = 0; a < 3; ++a) {
+    LGam_u(a) += (2./3.) * Gamma_u(a) * dbeta;
     for(int b = 0; b < 3; ++b) {
-      Ddalpha_dd(a,b) = ddalpha_dd(a,b)
-                       - 2.*(dphi_d(a)*dalpha_d(b) + dphi_d(b)*dalpha_d(a));
+      LGam_u(a) += g_uu(a,b) * ddbeta_d(b) - Gamma_u(b) * dbeta_du(b,a);
       for(int c = 0; c < 3; ++c) {
-        Ddalpha_dd(a,b) -= Gamma_udd(c,a,b)*dalpha_d(c);
-        for(int d = 0; d < 3; ++d) {
-            Ddalpha_dd(a,b) += 2.*z4c.g_dd(m,a,b,k,j,i) * g_uu(c,d)
-            * dphi_d(c) * dalpha_d(d);
-        }
+        LGam_u(a) += g_uu(b,c) * ddbeta_ddu(b,c,a);
       }
     }
+  }
 
-    for(int a = 0; a < 3; ++a)
-    for(int b = 0; b < 3; ++b) {
-      Ddalpha += oopsi4 * g_uu(a,b) * Ddalpha_dd(a,b);
+  // Finalize Lg_dd and LA_dd
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b) {
+    Lg_dd(a,b) -= (2./3.) * z4c.g_dd(m,a,b,k,j,i) * dbeta;
+    for(int c = 0; c < 3; ++c) {
+      Lg_dd(a,b) += dbeta_du(a,c) * z4c.g_dd(m,b,c,k,j,i);
+      Lg_dd(a,b) += dbeta_du(b,c) * z4c.g_dd(m,a,c,k,j,i);
     }
-
-    // -----------------------------------------------------------------------------------
-    // Contractions of A_ab, inverse, and derivatives
-    //
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b)
-    for(int c = 0; c < 3; ++c)
-    for(int d = 0; d < 3; ++d) {
-      AA_dd(a,b) += g_uu(c,d) * z4c.vA_dd(m,a,c,k,j,i) * z4c.vA_dd(m,d,b,k,j,i);
+  }
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b) {
+    LA_dd(a,b) -= (2./3.) * z4c.vA_dd(m,a,b,k,j,i) * dbeta;
+    for(int c = 0; c < 3; ++c) {
+      LA_dd(a,b) += dbeta_du(b,c) * z4c.vA_dd(m,a,c,k,j,i);
+      LA_dd(a,b) += dbeta_du(a,c) * z4c.vA_dd(m,b,c,k,j,i);
     }
-    for(int a = 0; a < 3; ++a)
+  }
+
+  // -----------------------------------------------------------------------------------
+  // Assemble RHS
+  //
+  // Khat, chi, and Theta
+  rhs.vKhat(m,k,j,i) = - Ddalpha + z4c.alpha(m,k,j,i)
+    * (AA + (1./3.)*SQR(K)) +
+    LKhat + opt.damp_kappa1*(1 - opt.damp_kappa2)
+    * z4c.alpha(m,k,j,i) * z4c.vTheta(m,k,j,i);
+  // Matter term
+  if(!is_vacuum) {
+    rhs.vKhat(m,k,j,i) += 4.*M_PI * z4c.alpha(m,k,j,i) * (S + tmunu.E(m,k,j,i));
+  }
+  rhs.chi(m,k,j,i) = Lchi - (1./6.) * opt.chi_psi_power *
+    chi_guarded * z4c.alpha(m,k,j,i) * K;
+  rhs.vTheta(m,k,j,i) = LTheta + z4c.alpha(m,k,j,i) * (
+      0.5*Ht - (2. + opt.damp_kappa2) * opt.damp_kappa1 * z4c.vTheta(m,k,j,i));
+  // Matter term
+  if(!is_vacuum) {
+    rhs.vTheta(m,k,j,i) -= 8.*M_PI * z4c.alpha(m,k,j,i) * tmunu.E(m,k,j,i);
+  }
+  // If BSSN is enabled, theta is disabled.
+  rhs.vTheta(m,k,j,i) *= opt.use_z4c;
+  // Gamma's
+  for(int a = 0; a < 3; ++a) {
+    rhs.vGam_u(m,a,k,j,i) = 2.*z4c.alpha(m,k,j,i)*DA_u(a) + LGam_u(a);
+    rhs.vGam_u(m,a,k,j,i) -= 2.*z4c.alpha(m,k,j,i) * opt.damp_kappa1 *
+        (z4c.vGam_u(m,a,k,j,i) - Gamma_u(a));
     for(int b = 0; b < 3; ++b) {
-      AA += g_uu(a,b) * AA_dd(a,b);
-    }
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b)
-    for(int c = 0; c < 3; ++c)
-    for(int d = 0; d < 3; ++d) {
-      A_uu(a,b) += g_uu(a,c) * g_uu(b,d) * z4c.vA_dd(m,c,d,k,j,i);
-    }
-    // TODO(JMF): dchi_d/chi_guarded is opt.chi_psi_power * dphi_d.
-    for(int a = 0; a < 3; ++a) {
-      for(int b = 0; b < 3; ++b) {
-          DA_u(a) -= (3./2.) * A_uu(a,b) * dchi_d(b) / chi_guarded;
-          DA_u(a) -= (1./3.) * g_uu(a,b) * (2.*dKhat_d(b) + dTheta_d(b));
-      }
-      for(int b = 0; b < 3; ++b)
-      for(int c = 0; c < 3; ++c) {
-        DA_u(a) += Gamma_udd(a,b,c) * A_uu(b,c);
+      rhs.vGam_u(m,a,k,j,i) -= 2. * A_uu(a,b) * dalpha_d(b);
+      // Matter term
+      if(!is_vacuum) {
+        rhs.vGam_u(m,a,k,j,i) -= 16.*M_PI * z4c.alpha(m,k,j,i)
+                            * g_uu(a,b) * tmunu.S_d(m,b,k,j,i);
       }
     }
-
-    // -----------------------------------------------------------------------------------
-    // Ricci scalar
-    //
-    for(int a = 0; a < 3; ++a)
+  }
+
+  // g and A
+  for(int a = 0; a < 3; ++a)
+  for(int b = a; b < 3; ++b) {
+    rhs.g_dd(m,a,b,k,j,i) = - 2. * z4c.alpha(m,k,j,i) * z4c.vA_dd(m,a,b,k,j,i)
+                    + Lg_dd(a,b);
+    rhs.vA_dd(m,a,b,k,j,i) = oopsi4 *
+        (-Ddalpha_dd(a,b) + z4c.alpha(m,k,j,i) * (R_dd(a,b) + Rphi_dd(a,b)));
+    rhs.vA_dd(m,a,b,k,j,i) -= (1./3.) * z4c.g_dd(m,a,b,k,j,i)
+                           * (-Ddalpha + z4c.alpha(m,k,j,i)*R);
+    rhs.vA_dd(m,a,b,k,j,i) += z4c.alpha(m,k,j,i) * (K*z4c.vA_dd(m,a,b,k,j,i)
+                           - 2.*AA_dd(a,b));
+    rhs.vA_dd(m,a,b,k,j,i) += LA_dd(a,b);
+    // Matter term
+    if(!is_vacuum) {
+      rhs.vA_dd(m,a,b,k,j,i) -= 8.*M_PI * z4c.alpha(m,k,j,i) *
+              (oopsi4*tmunu.S_dd(m,a,b,k,j,i) - (1./3.)*S*z4c.g_dd(m,a,b,k,j,i));
+    }
+  }
+  // lapse function
+  Real const f = opt.lapse_oplog * opt.lapse_harmonicf
+               + opt.lapse_harmonic * z4c.alpha(m,k,j,i);
+  rhs.alpha(m,k,j,i) = opt.lapse_advect * Lalpha
+                     - f * z4c.alpha(m,k,j,i) * z4c.vKhat(m,k,j,i);
+
+  // shift vector
+  for(int a = 0; a < 3; ++a) {
+    rhs.beta_u(m,a,k,j,i) = opt.shift_ggamma * z4c.vGam_u(m,a,k,j,i)
+                          + opt.shift_advect * Lbeta_u(a);
+    rhs.beta_u(m,a,k,j,i) -= opt.shift_eta * z4c.beta_u(m,a,k,j,i);
+    // FORCE beta = 0
+    //rhs.beta_u(m,a,k,j,i) = 0;
+  }
+
+  // harmonic gauge terms
+  for(int a = 0; a < 3; ++a) {
+    rhs.beta_u(m,a,k,j,i) += opt.shift_alpha2ggamma *
+                        SQR(z4c.alpha(m,k,j,i)) * z4c.vGam_u(m,a,k,j,i);
     for(int b = 0; b < 3; ++b) {
-      R += oopsi4 * g_uu(a,b) * (R_dd(a,b) + Rphi_dd(a,b));
+      rhs.beta_u(m,a,k,j,i) += opt.shift_hh * z4c.alpha(m,k,j,i) *
+        chi_guarded * (0.5 * z4c.alpha(m,k,j,i) * dchi_d(b) - dalpha_d(b)) * g_uu(a,b);
     }
+  }
+}
 
-    // -----------------------------------------------------------------------------------
-    // Hamiltonian constraint
-    //
-    Ht = R + (2./3.)*SQR(K) - AA;// - 16.*M_PI*tmunu.E(m,k,j,i);
+//----------------------------------------------------------------------------------------
+//! \struct Z4cScrTile
+//! \brief Wraps a 3D tile of a single Z4c variable stored in team scratch memory, with
+//! first cell at (ks,js,is), so it can be passed to the finite-difference functions in
+//! place of a scalar, vector or tensor component of u0.
+
+struct Z4cScrTile {
+  ScrArray4D<Real> q;
+  int ks, js, is;
+  KOKKOS_INLINE_FUNCTION
+  Real &operator()(const int, const int k, const int j, const int i) const {
+    return q(0,k-ks,j-js,i-is);
+  }
+  KOKKOS_INLINE_FUNCTION
+  Real &operator()(const int, const int, const int k, const int j, const int i) const {
+    return q(0,k-ks,j-js,i-is);
+  }
+};
+
+// Layout of the derivatives stored in scratch memory by the tiled RHS kernel: 1st
+// derivatives (3 per variable) of all variables except A_dd, 2nd derivatives (6 per
+// variable, symmetric index pairs ordered 00,01,02,11,12,22) of chi, g_dd, alpha and
+// beta_u, then the advective derivative and the K-O dissipation of every variable.
+constexpr int kZ4cD1Slot = 0;
+constexpr int kZ4cD2Slot = 48;
+constexpr int kZ4cAdvSlot = kZ4cD2Slot + 66;
+constexpr int kZ4cDissSlot = kZ4cAdvSlot + Z4c::nz4c;
+constexpr int kZ4cNSlots = kZ4cDissSlot + Z4c::nz4c;
+
+KOKKOS_INLINE_FUNCTION
+bool Z4cHasD1(const int n) {
+  return (n <= Z4c::I_Z4C_KHAT || n >= Z4c::I_Z4C_GAMX);
+}
+KOKKOS_INLINE_FUNCTION
+bool Z4cHasD2(const int n) {
+  return (n <= Z4c::I_Z4C_GZZ || n >= Z4c::I_Z4C_ALPHA);
+}
+// index of symmetric pair (a,b) in the order 00,01,02,11,12,22
+KOKKOS_INLINE_FUNCTION
+int Z4cSymIdx(const int a, const int b) {
+  const int l = (a < b)? a : b, h = (a < b)? b : a;
+  return (l == 0)? h : ((l == 1)? h + 2 : 5);
+}
+// slot of 1st derivative in direction a of variable n
+KOKKOS_INLINE_FUNCTION
+int Z4cD1Slot(const int n, const int a) {
+  return kZ4cD1Slot + 3*((n <= Z4c::I_Z4C_KHAT)? n : n - 6) + a;
+}
+// slot of 2nd derivative in directions (a,b) of variable n
+KOKKOS_INLINE_FUNCTION
+int Z4cD2Slot(const int n, const int a, const int b) {
+  return kZ4cD2Slot + 6*((n <= Z4c::I_Z4C_GZZ)? n : n - 11) + Z4cSymIdx(a,b);
+}
 
-    // -----------------------------------------------------------------------------------
-    // Finalize advective (Lie) derivatives
-    //
-    // Shift vector contractions
-    for(int a = 0; a < 3; ++a) {
-      dbeta += dbeta_du(a,a);
-    }
-    for(int a = 0; a < 3; ++a)
-    for(int b = 0; b < 3; ++b) {
-      ddbeta_d(a) += (1./3.) * ddbeta_ddu(a,b,b);
-    }
+template <int NGHOST>
+//! \fn void Z4c::CalcRHS(Driver *pdriver, int stage)
+//! \brief compute rhs of the z4c equations
+TaskStatus Z4c::CalcRHS(Driver *pdriver, int stage) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  auto &size = pmy_pack->pmb->mb_size;
+  auto stretch = pmy_pack->pmesh->stretch;
+  // in wide-halo mode, also compute RHS in ghost zones needed before the next exchange
+  int w = HaloUpdateWidth(pdriver, stage);
+  int is = indcs.is - w, ie = indcs.ie + w;
+  int js = indcs.js, je = indcs.je;
+  int ks = indcs.ks, ke = indcs.ke;
+  if (indcs.nx2 > 1) {js -= w; je += w;}
+  if (indcs.nx3 > 1) {ks -= w; ke += w;}
+
+  if (tiled_rhs) {
+    CalcRHSTiled<NGHOST>(pdriver, stage, is, ie, js, je, ks, ke);
+    return TaskStatus::complete;
+  }
 
-    // Finalize Lchi
-    Lchi += (1./6.) * opt.chi_psi_power * chi_guarded * dbeta;
+  int nmb = pmy_pack->nmb_thispack;
 
-    // Finalize LGam_u (note that this is not a real Lie derivative)
-    for(int a = 0; a < 3; ++a) {
-      LGam_u(a) += (2./3.) * Gamma_u(a) * dbeta;
-      for(int b = 0; b < 3; ++b) {
-        LGam_u(a) += g_uu(a,b) * ddbeta_d(b) - Gamma_u(b) * dbeta_du(b,a);
-        for(int c = 0; c < 3; ++c) {
-          LGam_u(a) += g_uu(b,c) * ddbeta_ddu(b,c,a);
+  auto &z4c = pmy_pack->pz4c->z4c;
+  auto &rhs = pmy_pack->pz4c->rhs;
+  auto &opt = pmy_pack->pz4c->opt;
+
+  bool is_vacuum = (pmy_pack->ptmunu == nullptr) ? true : false;
+  Tmunu::Tmunu_vars tmunu;
+  if (!is_vacuum) tmunu = pmy_pack->ptmunu->tmunu;
+
+  // ===================================================================================
+  // With 2N low-storage integrators, the RHS (including dissipation and the Sommerfeld
+  // condition) is accumulated into u_rhs = lsrk_a*u_rhs + RHS in a single kernel
+  //
+  if (pdriver->low_storage) {
+    Real lsrk_a = pdriver->lsrk_a[stage-1];
+    Real &diss = pmy_pack->pz4c->diss;
+    auto &u0 = pmy_pack->pz4c->u0;
+    auto &u_rhs = pmy_pack->pz4c->u_rhs;
+    auto &mb_bcs = pmy_pack->pmb->mb_bcs;
+    bool user_Sbc = opt.user_Sbc;
+    par_for("z4c rhs loop lsrk",DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
+    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+      Real idx[] = {1/size.d_view(m).dx1, 1/size.d_view(m).dx2, 1/size.d_view(m).dx3};
+      Real cdd[3];
+      stretch.CellFDFactors(size.d_view(m), indcs, k, j, i, idx, cdd);
+      // previous increment (never read in first stage, where it is undefined)
+      Real du[nz4c];
+      for (int n = 0; n < nz4c; ++n) {
+        du[n] = (lsrk_a != 0.0)? lsrk_a*u_rhs(m,n,k,j,i) : 0.0;
+      }
+      Z4cRHSDerivs d;
+      Z4cRHSDerivatives<NGHOST>(z4c, idx, cdd, m, k, j, i, d);
+      Z4cRHSAlgebra(z4c, rhs, opt, is_vacuum, tmunu, m, k, j, i, d);
+      for (int n = 0; n < nz4c; ++n) {
+        for(int a = 0; a < 3; ++a) {
+          u_rhs(m,n,k,j,i) += Diss<NGHOST>(a, idx, u0, m, n, k, j, i)*diss;
         }
       }
-    }
-
-    // Finalize Lg_dd and LA_dd
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b) {
-      Lg_dd(a,b) -= (2./3.) * z4c.g_dd(m,a,b,k,j,i) * dbeta;
-      for(int c = 0; c < 3; ++c) {
-        Lg_dd(a,b) += dbeta_du(a,c) * z4c.g_dd(m,b,c,k,j,i);
-        Lg_dd(a,b) += dbeta_du(b,c) * z4c.g_dd(m,a,c,k,j,i);
+      if (Z4cSommerfeldCell(mb_bcs, indcs, user_Sbc, m, k, j, i)) {
+        Z4cSommerfeld(z4c, rhs, indcs, size, stretch, m, k, j, i);
       }
-    }
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b) {
-      LA_dd(a,b) -= (2./3.) * z4c.vA_dd(m,a,b,k,j,i) * dbeta;
-      for(int c = 0; c < 3; ++c) {
-        LA_dd(a,b) += dbeta_du(b,c) * z4c.vA_dd(m,a,c,k,j,i);
-        LA_dd(a,b) += dbeta_du(a,c) * z4c.vA_dd(m,b,c,k,j,i);
+      for (int n = 0; n < nz4c; ++n) {
+        u_rhs(m,n,k,j,i) += du[n];
       }
-    }
+    });
+    return TaskStatus::complete;
+  }
 
-    // -----------------------------------------------------------------------------------
-    // Assemble RHS
-    //
-    // Khat, chi, and Theta
-    rhs.vKhat(m,k,j,i) = - Ddalpha + z4c.alpha(m,k,j,i)
-      * (AA + (1./3.)*SQR(K)) +
-      LKhat + opt.damp_kappa1*(1 - opt.damp_kappa2)
-      * z4c.alpha(m,k,j,i) * z4c.vTheta(m,k,j,i);
-    // Matter term
-    if(!is_vacuum) {
-      rhs.vKhat(m,k,j,i) += 4.*M_PI * z4c.alpha(m,k,j,i) * (S + tmunu.E(m,k,j,i));
-    }
-    rhs.chi(m,k,j,i) = Lchi - (1./6.) * opt.chi_psi_power *
-      chi_guarded * z4c.alpha(m,k,j,i) * K;
-    rhs.vTheta(m,k,j,i) = LTheta + z4c.alpha(m,k,j,i) * (
-        0.5*Ht - (2. + opt.damp_kappa2) * opt.damp_kappa1 * z4c.vTheta(m,k,j,i));
-    // Matter term
-    if(!is_vacuum) {
-      rhs.vTheta(m,k,j,i) -= 8.*M_PI * z4c.alpha(m,k,j,i) * tmunu.E(m,k,j,i);
-    }
-    // If BSSN is enabled, theta is disabled.
-    rhs.vTheta(m,k,j,i) *= opt.use_z4c;
-    // Gamma's
-    for(int a = 0; a < 3; ++a) {
-      rhs.vGam_u(m,a,k,j,i) = 2.*z4c.alpha(m,k,j,i)*DA_u(a) + LGam_u(a);
-      rhs.vGam_u(m,a,k,j,i) -= 2.*z4c.alpha(m,k,j,i) * opt.damp_kappa1 *
-          (z4c.vGam_u(m,a,k,j,i) - Gamma_u(a));
-      for(int b = 0; b < 3; ++b) {
-        rhs.vGam_u(m,a,k,j,i) -= 2. * A_uu(a,b) * dalpha_d(b);
-        // Matter term
-        if(!is_vacuum) {
-          rhs.vGam_u(m,a,k,j,i) -= 16.*M_PI * z4c.alpha(m,k,j,i)
-                              * g_uu(a,b) * tmunu.S_d(m,b,k,j,i);
+  // ===================================================================================
+  // With <z4c>/fused_update, the RHS (including dissipation and the Sommerfeld
+  // condition), the SSP RK update and the algebraic constraints are applied in a single
+  // kernel.  Neighboring cells still read u0, so the new state is written into u_rhs
+  // (overwriting the RHS of the same cell), and u0 and u_rhs are swapped afterwards.
+  //
+  if (fused_update) {
+    Real &diss = pmy_pack->pz4c->diss;
+    auto &u0 = pmy_pack->pz4c->u0;
+    auto &u1 = pmy_pack->pz4c->u1;
+    auto &u_rhs = pmy_pack->pz4c->u_rhs;
+    auto &mb_bcs = pmy_pack->pmb->mb_bcs;
+    bool user_Sbc = opt.user_Sbc;
+    Real gam0 = pdriver->gam0[stage-1];
+    Real gam1 = pdriver->gam1[stage-1];
+    Real beta_dt = (pdriver->beta[stage-1])*(pmy_pack->pmesh->dt);
+    // same stages as EnforceAlgConstr
+    bool alg_constr = (pmy_pack->pdyngr != nullptr || stage == pdriver->nexp_stages);
+    double ncell = static_cast<double>(nmb)*(ie - is + 1)*(je - js + 1)*(ke - ks + 1);
+    AddKernelWork("z4c rhs loop fused",
+                  ncell*(3*nz4c + ((is_vacuum)? 0 : 10))*sizeof(Real), ncell*3200.0);
+    par_for("z4c rhs loop fused",DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
+    KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+      Real idx[] = {1/size.d_view(m).dx1, 1/size.d_view(m).dx2, 1/size.d_view(m).dx3};
+      Real cdd[3];
+      stretch.CellFDFactors(size.d_view(m), indcs, k, j, i, idx, cdd);
+      Z4cRHSDerivs d;
+      Z4cRHSDerivatives<NGHOST>(z4c, idx, cdd, m, k, j, i, d);
+      Z4cRHSAlgebra(z4c, rhs, opt, is_vacuum, tmunu, m, k, j, i, d);
+      for (int n = 0; n < nz4c; ++n) {
+        for(int a = 0; a < 3; ++a) {
+          u_rhs(m,n,k,j,i) += Diss<NGHOST>(a, idx, u0, m, n, k, j, i)*diss;
         }
       }
-    }
-
-    // g and A
-    for(int a = 0; a < 3; ++a)
-    for(int b = a; b < 3; ++b) {
-      rhs.g_dd(m,a,b,k,j,i) = - 2. * z4c.alpha(m,k,j,i) * z4c.vA_dd(m,a,b,k,j,i)
-                      + Lg_dd(a,b);
-      rhs.vA_dd(m,a,b,k,j,i) = oopsi4 *
-          (-Ddalpha_dd(a,b) + z4c.alpha(m,k,j,i) * (R_dd(a,b) + Rphi_dd(a,b)));
-      rhs.vA_dd(m,a,b,k,j,i) -= (1./3.) * z4c.g_dd(m,a,b,k,j,i)
-                             * (-Ddalpha + z4c.alpha(m,k,j,i)*R);
-      rhs.vA_dd(m,a,b,k,j,i) += z4c.alpha(m,k,j,i) * (K*z4c.vA_dd(m,a,b,k,j,i)
-                             - 2.*AA_dd(a,b));
-      rhs.vA_dd(m,a,b,k,j,i) += LA_dd(a,b);
-      // Matter term
-      if(!is_vacuum) {
-        rhs.vA_dd(m,a,b,k,j,i) -= 8.*M_PI * z4c.alpha(m,k,j,i) *
-                (oopsi4*tmunu.S_dd(m,a,b,k,j,i) - (1./3.)*S*z4c.g_dd(m,a,b,k,j,i));
+      if (Z4cSommerfeldCell(mb_bcs, indcs, user_Sbc, m, k, j, i)) {
+        Z4cSommerfeld(z4c, rhs, indcs, size, stretch, m, k, j, i);
       }
-    }
-    // lapse function
-    Real const f = opt.lapse_oplog * opt.lapse_harmonicf
-                 + opt.lapse_harmonic * z4c.alpha(m,k,j,i);
-    rhs.alpha(m,k,j,i) = opt.lapse_advect * Lalpha
-                       - f * z4c.alpha(m,k,j,i) * z4c.vKhat(m,k,j,i);
-
-    // shift vector
-    for(int a = 0; a < 3; ++a) {
-      rhs.beta_u(m,a,k,j,i) = opt.shift_ggamma * z4c.vGam_u(m,a,k,j,i)
-                            + opt.shift_advect * Lbeta_u(a);
-      rhs.beta_u(m,a,k,j,i) -= opt.shift_eta * z4c.beta_u(m,a,k,j,i);
-      // FORCE beta = 0
-      //rhs.beta_u(m,a,k,j,i) = 0;
-    }
-
-    // harmonic gauge terms
-    for(int a = 0; a < 3; ++a) {
-      rhs.beta_u(m,a,k,j,i) += opt.shift_alpha2ggamma *
-                          SQR(z4c.alpha(m,k,j,i)) * z4c.vGam_u(m,a,k,j,i);
-      for(int b = 0; b < 3; ++b) {
-        rhs.beta_u(m,a,k,j,i) += opt.shift_hh * z4c.alpha(m,k,j,i) *
-          chi_guarded * (0.5 * z4c.alpha(m,k,j,i) * dchi_d(b) - dalpha_d(b)) * g_uu(a,b);
+      for (int n = 0; n < nz4c; ++n) {
+        u_rhs(m,n,k,j,i) = gam0*u0(m,n,k,j,i) + gam1*u1(m,n,k,j,i)
+                           + beta_dt*u_rhs(m,n,k,j,i);
       }
-    }
+      if (alg_constr) {
+        Z4cAlgConstrCell(rhs, m, k, j, i);
+      }
+    });
+    SwapURHS();
+    return TaskStatus::complete;
+  }
+
+  // ===================================================================================
+  // Main RHS calculation
+  //
+  // estimated work for profiler: Z4c variables (and stress-energy tensor) read and RHS
+  // written once, and roughly 3000 flops per cell (derivatives and algebra)
+  double ncell = static_cast<double>(nmb)*(ie - is + 1)*(je - js + 1)*(ke - ks + 1);
+  AddKernelWork("z4c rhs loop", ncell*(2*nz4c + ((is_vacuum)? 0 : 10))*sizeof(Real),
+                ncell*3000.0);
+  par_for("z4c rhs loop",DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
+  KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    Real idx[] = {1/size.d_view(m).dx1, 1/size.d_view(m).dx2, 1/size.d_view(m).dx3};
+    Real cdd[3];
+    stretch.CellFDFactors(size.d_view(m), indcs, k, j, i, idx, cdd);
+    Z4cRHSDerivs d;
+    Z4cRHSDerivatives<NGHOST>(z4c, idx, cdd, m, k, j, i, d);
+    Z4cRHSAlgebra(z4c, rhs, opt, is_vacuum, tmunu, m, k, j, i, d);
   });
 
   // ===================================================================================
@@ -581,6 +790,8 @@ TaskStatus Z4c::CalcRHS(Driver *pdriver, int stage) {
   DevExeSpace(),0,nmb-1,0,nz4c-1,ks,ke,js,je,is,ie,
   KOKKOS_LAMBDA(const int m, const int n, const int k, const int j, const int i) {
     Real idx[] = {1/size.d_view(m).dx1, 1/size.d_view(m).dx2, 1/size.d_view(m).dx3};
+    Real cdd[3];
+    stretch.CellFDFactors(size.d_view(m), indcs, k, j, i, idx, cdd);
     for(int a = 0; a < 3; ++a) {
       u_rhs(m,n,k,j,i) += Diss<NGHOST>(a, idx, u0, m, n, k, j, i)*diss;
     }
@@ -592,4 +803,195 @@ TaskStatus Z4c::CalcRHS(Driver *pdriver, int stage) {
 template TaskStatus Z4c::CalcRHS<2>(Driver *pdriver, int stage);
 template TaskStatus Z4c::CalcRHS<3>(Driver *pdriver, int stage);
 template TaskStatus Z4c::CalcRHS<4>(Driver *pdriver, int stage);
+
+//----------------------------------------------------------------------------------------
+//! \fn void Z4c::CalcRHSTiled
+//! \brief compute rhs of the z4c equations (including K-O dissipation) over [is,ie] x
+//! [js,je] x [ks,ke] using tiles of u0 in team scratch memory.  Enabled with
+//! <z4c>/tiled_rhs = true.
+//!
+//! Each team loops over the variables, staging a tile of one variable (active cells plus
+//! NGHOST ghost cells) in scratch and computing all of its derivatives needed by the RHS
+//! into a second scratch array.  The algebraic part of the RHS is then evaluated for the
+//! cells of the tile from those derivatives by the same Z4cRHSAlgebra() used by the
+//! untiled kernel.  This replaces the many overlapping stencil reads of u0 from global
+//! memory with a single read of each tile.  The derivative array holds kZ4cNSlots values
+//! per cell, so tiles should be small and the default is level 1 scratch.
+
+template <int NGHOST>
+void Z4c::CalcRHSTiled(Driver *pdriver, int stage,
+                       int is, int ie, int js, int je, int ks, int ke) {
+  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  auto &size = pmy_pack->pmb->mb_size;
+  auto stretch = pmy_pack->pmesh->stretch;
+  int nmb = pmy_pack->nmb_thispack;
+
+  auto &z4c = pmy_pack->pz4c->z4c;
+  auto &rhs = pmy_pack->pz4c->rhs;
+  auto &opt = pmy_pack->pz4c->opt;
+  auto &u0 = pmy_pack->pz4c->u0;
+  auto &u_rhs = pmy_pack->pz4c->u_rhs;
+  Real &diss = pmy_pack->pz4c->diss;
+
+  bool is_vacuum = (pmy_pack->ptmunu == nullptr) ? true : false;
+  Tmunu::Tmunu_vars tmunu;
+  if (!is_vacuum) tmunu = pmy_pack->ptmunu->tmunu;
+
+  // with 2N low-storage integrators, accumulate u_rhs = lsrk_a*u_rhs + RHS, and apply
+  // the Sommerfeld condition here (see CalcRHS)
+  bool low_storage = pdriver->low_storage;
+  Real lsrk_a = (low_storage)? pdriver->lsrk_a[stage-1] : 0.0;
+  auto &mb_bcs = pmy_pack->pmb->mb_bcs;
+  bool user_Sbc = opt.user_Sbc;
+
+  // number of active cells in each tile, and number of tiles in each direction
+  int nti = rhs_tile_nx1, ntj = rhs_tile_nx2, ntk = rhs_tile_nx3;
+  int nt1 = (ie - is + 1 + nti - 1)/nti;
+  int nt2 = (je - js + 1 + ntj - 1)/ntj;
+  int nt3 = (ke - ks + 1 + ntk - 1)/ntk;
+
+  size_t scr_size = ScrArray4D<Real>::shmem_size(1, ntk+2*NGHOST, ntj+2*NGHOST,
+                                                 nti+2*NGHOST) +
+                    ScrArray4D<Real>::shmem_size(kZ4cNSlots, ntk, ntj, nti);
+  int scr_level = rhs_scr_level;
+  par_for_outer("z4c rhs tiled",DevExeSpace(),scr_size,scr_level,0,nmb-1,0,nt3-1,
+                0,nt2-1,0,nt1-1,
+  KOKKOS_LAMBDA(TeamMember_t member, const int m, const int tk, const int tj,
+                const int ti) {
+    Real idx[] = {1/size.d_view(m).dx1, 1/size.d_view(m).dx2, 1/size.d_view(m).dx3};
+    // active cells in this tile
+    const int k0 = ks + tk*ntk, k1 = (k0 + ntk - 1 < ke)? k0 + ntk - 1 : ke;
+    const int j0 = js + tj*ntj, j1 = (j0 + ntj - 1 < je)? j0 + ntj - 1 : je;
+    const int i0 = is + ti*nti, i1 = (i0 + nti - 1 < ie)? i0 + nti - 1 : ie;
+    const int nk = k1 - k0 + 1, nj = j1 - j0 + 1, ni = i1 - i0 + 1;
+    const int nkji = nk*nj*ni;
+
+    Z4cScrTile q{ScrArray4D<Real>(member.team_scratch(scr_level), 1, ntk+2*NGHOST,
+                                  ntj+2*NGHOST, nti+2*NGHOST),
+                 k0-NGHOST, j0-NGHOST, i0-NGHOST};
+    ScrArray4D<Real> dscr(member.team_scratch(scr_level), kZ4cNSlots, ntk, ntj, nti);
+
+    // -----------------------------------------------------------------------------------
+    // Derivatives, one variable at a time
+    //
+    const int nqk = nk + 2*NGHOST, nqj = nj + 2*NGHOST, nqi = ni + 2*NGHOST;
+    const int nqkji = nqk*nqj*nqi;
+    for (int n = 0; n < nz4c; ++n) {
+      par_for_inner(member, 0, nqkji-1, [&](const int c) {
+        int kk = c/(nqj*nqi);
+        int jj = (c - kk*nqj*nqi)/nqi;
+        int ii = c - kk*nqj*nqi - jj*nqi;
+        q.q(0,kk,jj,ii) = u0(m,n,q.ks+kk,q.js+jj,q.is+ii);
+      });
+      member.team_barrier();
+
+      const bool has_d1 = Z4cHasD1(n);
+      const bool has_d2 = Z4cHasD2(n);
+      par_for_inner(member, 0, nkji-1, [&](const int c) {
+        int kk = c/(nj*ni);
+        int jj = (c - kk*nj*ni)/ni;
+        int ii = c - kk*nj*ni - jj*ni;
+        int k = k0 + kk, j = j0 + jj, i = i0 + ii;
+        Real idxc[3] = {idx[0], idx[1], idx[2]}, cdd[3];
+        stretch.CellFDFactors(size.d_view(m), indcs, k, j, i, idxc, cdd);
+        if (has_d1) {
+          for (int a = 0; a < 3; ++a) {
+            dscr(Z4cD1Slot(n,a),kk,jj,ii) = Dx<NGHOST>(a, idxc, q, m,k,j,i);
+          }
+        }
+        // (all variables with 2nd derivatives also have 1st derivatives)
+        if (has_d2) {
+          for (int a = 0; a < 3; ++a) {
+            dscr(Z4cD2Slot(n,a,a),kk,jj,ii) = Dxx<NGHOST>(a, idxc, q, m,k,j,i)
+                                            - cdd[a]*dscr(Z4cD1Slot(n,a),kk,jj,ii);
+            for (int b = a + 1; b < 3; ++b) {
+              dscr(Z4cD2Slot(n,a,b),kk,jj,ii) = Dxy<NGHOST>(a, b, idxc, q, m,k,j,i);
+            }
+          }
+        }
+        Real adv = 0.0, dis = 0.0;
+        for (int a = 0; a < 3; ++a) {
+          adv += Lx<NGHOST>(a, idxc, z4c.beta_u, q, m,a,k,j,i);
+          dis += Diss<NGHOST>(a, idxc, q, m, n, k, j, i);
+        }
+        dscr(kZ4cAdvSlot+n,kk,jj,ii) = adv;
+        dscr(kZ4cDissSlot+n,kk,jj,ii) = dis;
+      });
+      member.team_barrier();
+    }
+
+    // -----------------------------------------------------------------------------------
+    // Algebraic part of the RHS, and dissipation
+    //
+    par_for_inner(member, 0, nkji-1, [&](const int c) {
+      int kk = c/(nj*ni);
+      int jj = (c - kk*nj*ni)/ni;
+      int ii = c - kk*nj*ni - jj*ni;
+      int k = k0 + kk, j = j0 + jj, i = i0 + ii;
+
+      Z4cRHSDerivs d;
+      d.Lalpha = dscr(kZ4cAdvSlot+I_Z4C_ALPHA,kk,jj,ii);
+      d.Lchi   = dscr(kZ4cAdvSlot+I_Z4C_CHI,kk,jj,ii);
+      d.LKhat  = dscr(kZ4cAdvSlot+I_Z4C_KHAT,kk,jj,ii);
+      d.LTheta = dscr(kZ4cAdvSlot+I_Z4C_THETA,kk,jj,ii);
+      for (int a = 0; a < 3; ++a) {
+        d.dalpha_d(a) = dscr(Z4cD1Slot(I_Z4C_ALPHA,a),kk,jj,ii);
+        d.dchi_d(a)   = dscr(Z4cD1Slot(I_Z4C_CHI,a),kk,jj,ii);
+        d.dKhat_d(a)  = dscr(Z4cD1Slot(I_Z4C_KHAT,a),kk,jj,ii);
+        d.dTheta_d(a) = dscr(Z4cD1Slot(I_Z4C_THETA,a),kk,jj,ii);
+        d.Lbeta_u(a)  = dscr(kZ4cAdvSlot+I_Z4C_BETAX+a,kk,jj,ii);
+        d.LGam_u(a)   = dscr(kZ4cAdvSlot+I_Z4C_GAMX+a,kk,jj,ii);
+        for (int b = 0; b < 3; ++b) {
+          d.dbeta_du(b,a) = dscr(Z4cD1Slot(I_Z4C_BETAX+a,b),kk,jj,ii);
+          d.dGam_du(b,a)  = dscr(Z4cD1Slot(I_Z4C_GAMX+a,b),kk,jj,ii);
+        }
+      }
+      for (int a = 0; a < 3; ++a)
+      for (int b = a; b < 3; ++b) {
+        const int ab = Z4cSymIdx(a,b);
+        d.ddalpha_dd(a,b) = dscr(Z4cD2Slot(I_Z4C_ALPHA,a,b),kk,jj,ii);
+        d.ddchi_dd(a,b)   = dscr(Z4cD2Slot(I_Z4C_CHI,a,b),kk,jj,ii);
+        d.Lg_dd(a,b) = dscr(kZ4cAdvSlot+I_Z4C_GXX+ab,kk,jj,ii);
+        d.LA_dd(a,b) = dscr(kZ4cAdvSlot+I_Z4C_AXX+ab,kk,jj,ii);
+        for (int c = 0; c < 3; ++c) {
+          d.dg_ddd(c,a,b) = dscr(Z4cD1Slot(I_Z4C_GXX+ab,c),kk,jj,ii);
+          d.ddbeta_ddu(a,b,c) = dscr(Z4cD2Slot(I_Z4C_BETAX+c,a,b),kk,jj,ii);
+        }
+        for (int c = 0; c < 3; ++c)
+        for (int e = c; e < 3; ++e) {
+          d.ddg_dddd(a,b,c,e) =
+              dscr(Z4cD2Slot(I_Z4C_GXX+Z4cSymIdx(c,e),a,b),kk,jj,ii);
+        }
+      }
+
+      // previous increment (never read in first stage, where it is undefined)
+      Real du[nz4c];
+      for (int n = 0; n < nz4c; ++n) {
+        du[n] = (lsrk_a != 0.0)? lsrk_a*u_rhs(m,n,k,j,i) : 0.0;
+      }
+
+      Z4cRHSAlgebra(z4c, rhs, opt, is_vacuum, tmunu, m, k, j, i, d);
+
+      for (int n = 0; n < nz4c; ++n) {
+        u_rhs(m,n,k,j,i) += dscr(kZ4cDissSlot+n,kk,jj,ii)*diss;
+      }
+      if (low_storage) {
+        if (Z4cSommerfeldCell(mb_bcs, indcs, user_Sbc, m, k, j, i)) {
+          Z4cSommerfeld(z4c, rhs, indcs, size, stretch, m, k, j, i);
+        }
+        for (int n = 0; n < nz4c; ++n) {
+          u_rhs(m,n,k,j,i) += du[n];
+        }
+      }
+    });
+  });
+  return;
+}
+
+template void Z4c::CalcRHSTiled<2>(Driver *pdriver, int stage,
+                                   int is, int ie, int js, int je, int ks, int ke);
+template void Z4c::CalcRHSTiled<3>(Driver *pdriver, int stage,
+                                   int is, int ie, int js, int je, int ks, int ke);
+template void Z4c::CalcRHSTiled<4>(Driver *pdriver, int stage,
+                                   int is, int ie, int js, int je, int ks, int ke);
 } // namespace z4c
@@ -41,25 +41,30 @@ void Z4c::Z4cWeyl(MeshBlockPack *pmbp) {
   auto &weyl = pmbp->pz4c->weyl;
   auto &u_weyl = pmbp->pz4c->u_weyl;
   Kokkos::deep_copy(u_weyl, 0.);
+  SetWeylMask();
+  auto &weyl_mask_ = weyl_mask;
+  auto stretch = pmbp->pmesh->stretch;
 
   par_for("z4c_weyl_scalar",DevExeSpace(),0,nmb-1,ks,ke,js,je,is,ie,
   KOKKOS_LAMBDA(const int m, const int k, const int j, const int i) {
+    // skip MeshBlocks away from the extraction spheres
+    if (weyl_mask_.d_view(m) == 0) return;
     // Simplify constants (2 & sqrt 2 factors) featured in re/im[psi4]
     const Real FR4 = 0.25;
     Real &x1min = size.d_view(m).x1min;
     Real &x1max = size.d_view(m).x1max;
     int nx1 = indcs.nx1;
-    Real x1v = CellCenterX(i-is, nx1, x1min, x1max);
+    Real x1v = stretch.X(0, CellCenterX(i-is, nx1, x1min, x1max));
 
     Real &x2min = size.d_view(m).x2min;
     Real &x2max = size.d_view(m).x2max;
     int nx2 = indcs.nx2;
-    Real x2v = CellCenterX(j-js, nx2, x2min, x2max);
+    Real x2v = stretch.X(1, CellCenterX(j-js, nx2, x2min, x2max));
 
     Real &x3min = size.d_view(m).x3min;
     Real &x3max = size.d_view(m).x3max;
     int nx3 = indcs.nx3;
-    Real x3v = CellCenterX(k-ks, nx3, x3min, x3max);
+    Real x3v = stretch.X(2, CellCenterX(k-ks, nx3, x3min, x3max));
 
     // Scalars
     Real detg = 0.0;         // det(g)
@@ -136,6 +141,8 @@ void Z4c::Z4cWeyl(MeshBlockPack *pmbp) {
     }
 
     Real idx[] = {1/size.d_view(m).dx1, 1/size.d_view(m).dx2, 1/size.d_view(m).dx3};
+    Real cdd[3];
+    stretch.CellFDFactors(size.d_view(m), indcs, k, j, i, idx, cdd);
     // -----------------------------------------------------------------------------------
     // derivatives
     //
@@ -152,7 +159,8 @@ void Z4c::Z4cWeyl(MeshBlockPack *pmbp) {
     for(int c = 0; c < 3; ++c)
     for(int d = c; d < 3; ++d) {
       if(a == b) {
-        ddg_dddd(a,b,c,d) = Dxx<NGHOST>(a, idx, adm.g_dd, m,c,d,k,j,i);
+        ddg_dddd(a,b,c,d) = Dxx<NGHOST>(a, idx, adm.g_dd, m,c,d,k,j,i)
+                            - cdd[a]*dg_ddd(a,c,d);
       } else {
         ddg_dddd(a,b,c,d) = Dxy<NGHOST>(a, b, idx, adm.g_dd, m,c,d,k,j,i);
       }
@@ -407,6 +415,58 @@ void Z4c::Z4cWeyl(MeshBlockPack *pmbp) {
   });
 }
 
+//----------------------------------------------------------------------------------------
+// \!fn void Z4c::SetWeylMask()
+// \brief flag the MeshBlocks on which the Weyl scalars are needed for wave extraction
+//
+// A MeshBlock is flagged if any extraction sphere (centered on the origin) intersects it
+// when padded by 2*ng cells, so that psi4 is also computed in the neighbors which fill
+// the ghost zones used by the interpolation stencils.  All MeshBlocks are flagged if
+// weyl_spheres_only = false.
+void Z4c::SetWeylMask() {
+  int nmb = pmy_pack->nmb_thispack;
+  if (static_cast<int>(weyl_mask.extent(0)) < nmb) {
+    Kokkos::realloc(weyl_mask, nmb);
+  }
+  auto &size = pmy_pack->pmb->mb_size;
+  int ng = pmy_pack->pmesh->mb_indcs.ng;
+  for (int m=0; m<nmb; ++m) {
+    if (!(weyl_spheres_only)) {
+      weyl_mask.h_view(m) = 1;
+      continue;
+    }
+    Real dx = std::max(size.h_view(m).dx1, std::max(size.h_view(m).dx2,
+                                                    size.h_view(m).dx3));
+    Real pad = 2.0*ng*dx;
+    Real xmin[3] = {size.h_view(m).x1min - pad, size.h_view(m).x2min - pad,
+                    size.h_view(m).x3min - pad};
+    Real xmax[3] = {size.h_view(m).x1max + pad, size.h_view(m).x2max + pad,
+                    size.h_view(m).x3max + pad};
+    auto &stretch = pmy_pack->pmesh->stretch;
+    for (int d=0; d<3; ++d) {
+      xmin[d] = stretch.X(d, xmin[d]);
+      xmax[d] = stretch.X(d, xmax[d]);
+    }
+    // squared distances from origin to nearest and farthest points of padded block
+    Real rmin2 = 0.0, rmax2 = 0.0;
+    for (int d=0; d<3; ++d) {
+      Real near = (xmin[d] > 0.0)? xmin[d] : ((xmax[d] < 0.0)? -xmax[d] : 0.0);
+      Real far = std::max(std::abs(xmin[d]), std::abs(xmax[d]));
+      rmin2 += near*near;
+      rmax2 += far*far;
+    }
+    weyl_mask.h_view(m) = 0;
+    for (auto &grid : spherical_grids) {
+      Real r2 = SQR(grid->radius);
+      if (r2 >= rmin2 && r2 <= rmax2) {
+        weyl_mask.h_view(m) = 1;
+      }
+    }
+  }
+  weyl_mask.template modify<HostMemSpace>();
+  weyl_mask.template sync<DevExeSpace>();
+}
+
 template void Z4c::Z4cWeyl<2>(MeshBlockPack *pmbp);
 template void Z4c::Z4cWeyl<3>(MeshBlockPack *pmbp);
 template void Z4c::Z4cWeyl<4>(MeshBlockPack *pmbp);
@@ -0,0 +1,160 @@
+//========================================================================================
+// AthenaXXX astrophysical plasma code
+// Copyright(C) 2020 James M. Stone <jmstone@ias.edu> and the Athena code team
+// Licensed under the 3-clause BSD License (the "LICENSE")
+//========================================================================================
+//! \file z4c_multirate.cpp
+//! \brief multirate integration of the spacetime (Z4c) and the matter (DynGRMHD).
+//!
+//! With <z4c>/multirate_ratio = N > 1, the spacetime is advanced over a step of up to N
+//! matter timesteps (limited by the Z4c CFL condition with <z4c>/multirate_cfl), at the
+//! start of the first matter step within it.  The Z4c tasks then run in their own task
+//! lists (z4c_before_stagen, z4c_stagen, z4c_after_stagen) with the matter sources
+//! frozen at the start of the step.  The matter timesteps are adjusted to end exactly at
+//! the end of the spacetime step, and during each matter stage the ADM variables (u_adm,
+//! from which all metric interpolants are computed) are interpolated linearly in time
+//! between their values at the start and end of the spacetime step.
+//!
+//! Z4c variables in outputs are those at the end of the current spacetime step.  If the
+//! mesh changes within a spacetime step, the ADM variables at its end are used for the
+//! rest of it.
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "athena.hpp"
+#include "globals.hpp"
+#include "mesh/mesh.hpp"
+#include "driver/driver.hpp"
+#include "coordinates/adm.hpp"
+#include "z4c/z4c.hpp"
+
+#if MPI_PARALLEL_ENABLED
+#include <mpi.h>
+#endif
+
+namespace z4c {
+namespace {
+// fraction of the timestep at which stage evaluates the RHS, found by applying the
+// integrator to du/dt = 1 with u = 0 at the start of the timestep
+Real StageTime(Driver *pdrive, int stage) {
+  Real c = 0.0, c1 = 0.0, dq = 0.0;
+  for (int s=1; s<stage; ++s) {
+    if (pdrive->low_storage) {
+      dq = pdrive->lsrk_a[s-1]*dq + 1.0;
+      c += pdrive->lsrk_b[s-1]*dq;
+    } else {
+      if (s == 1) {
+        c1 = c;
+      } else if (pdrive->integrator == "rk4") {
+        c1 += pdrive->delta[s-1]*c;
+      }
+      c = pdrive->gam0[s-1]*c + pdrive->gam1[s-1]*c1 + pdrive->beta[s-1];
+    }
+  }
+  return c;
+}
+} // namespace
+
+//----------------------------------------------------------------------------------------
+//! \fn void Z4c::SpacetimeTimeStep()
+//! \brief Called by Mesh::NewTimeStep() with the matter timestep dt of the next cycle
+//! starting at time.  Starts a new spacetime step if the current one is complete, and
+//! reduces dt so that matter steps end exactly at the end of the spacetime step.
+
+void Z4c::SpacetimeTimeStep(Real time, Real &dt, Real tlim) {
+  Real remain = st_time + st_dt - time;
+  if (remain > 1.0e-6*st_dt) {
+    // avoid leaving a very short last matter step
+    spacetime_step = false;
+    if (remain <= dt) {
+      dt = remain;
+    } else if (remain < 2.0*dt) {
+      dt = 0.5*remain;
+    }
+    return;
+  }
+
+  Real cfl = (multirate_cfl > 0.0)? multirate_cfl : pmy_pack->pmesh->cfl_no;
+  Real dt_z4c = cfl*dtnew;
+#if MPI_PARALLEL_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE, &dt_z4c, 1, MPI_ATHENA_REAL, MPI_MIN,
+                global_variable::mpi_comm);
+#endif
+  st_time = time;
+  st_dt = std::min(multirate_ratio*dt, dt_z4c);
+  if ((time < tlim) && ((time + st_dt) > tlim)) {st_dt = tlim - time;}
+  dt = std::min(dt, st_dt);
+  spacetime_step = true;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Z4c::BeginSpacetimeStep()
+//! \brief Stores the ADM variables at the start of the spacetime step, which are those
+//! at the end of the previous step (or, at the start or after the mesh changed, those
+//! computed from u0)
+
+void Z4c::BeginSpacetimeStep() {
+  auto &u_adm = pmy_pack->padm->u_adm;
+  if (st_nghbr_version == pmy_pack->pmb->nghbr_version &&
+      adm_new.extent(0) == u_adm.extent(0)) {
+    std::swap(adm_old, adm_new);
+  } else {
+    UpdateADM();
+    Kokkos::realloc(adm_old, u_adm.extent(0), u_adm.extent(1), u_adm.extent(2),
+                    u_adm.extent(3), u_adm.extent(4));
+    Kokkos::deep_copy(DevExeSpace(), adm_old, u_adm);
+  }
+  st_nghbr_version = pmy_pack->pmb->nghbr_version;
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn void Z4c::EndSpacetimeStep()
+//! \brief Stores the ADM variables at the end of the spacetime step
+
+void Z4c::EndSpacetimeStep() {
+  UpdateADM();
+  auto &u_adm = pmy_pack->padm->u_adm;
+  if (adm_new.extent(0) != u_adm.extent(0)) {
+    Kokkos::realloc(adm_new, u_adm.extent(0), u_adm.extent(1), u_adm.extent(2),
+                    u_adm.extent(3), u_adm.extent(4));
+  }
+  Kokkos::deep_copy(DevExeSpace(), adm_new, u_adm);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn TaskStatus Z4c::InterpolateADM()
+//! \brief Sets the ADM variables used by the matter in this stage by linear
+//! interpolation in time between the start and end of the spacetime step
+
+TaskStatus Z4c::InterpolateADM(Driver *pdrive, int stage) {
+  if (multirate_ratio == 1) {
+    return TaskStatus::complete;
+  }
+  // u_adm no longer holds the ADM variables of u0
+  adm_current = false;
+  if (st_nghbr_version != pmy_pack->pmb->nghbr_version) {
+    UpdateADM();
+    return TaskStatus::complete;
+  }
+
+  Mesh *pm = pmy_pack->pmesh;
+  Real w = (pm->time + StageTime(pdrive, stage)*(pm->dt) - st_time)/st_dt;
+  w = std::min(std::max(w, static_cast<Real>(0.0)), static_cast<Real>(1.0));
+  auto &u_adm = pmy_pack->padm->u_adm;
+  auto &u_old = adm_old;
+  auto &u_new = adm_new;
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  int nvar = static_cast<int>(u_adm.extent(1));
+  int n3m1 = static_cast<int>(u_adm.extent(2)) - 1;
+  int n2m1 = static_cast<int>(u_adm.extent(3)) - 1;
+  int n1m1 = static_cast<int>(u_adm.extent(4)) - 1;
+  par_for("adm_interp", DevExeSpace(), 0, nmb1, 0, nvar-1, 0, n3m1, 0, n2m1, 0, n1m1,
+  KOKKOS_LAMBDA(const int m, const int n, const int k, const int j, const int i) {
+    u_adm(m,n,k,j,i) = (1.0 - w)*u_old(m,n,k,j,i) + w*u_new(m,n,k,j,i);
+  });
+  return TaskStatus::complete;
+}
+
+} // namespace z4c
@@ -30,6 +30,7 @@ void Z4c::ADMOnePuncture(MeshBlockPack *pmbp, ParameterInput *pin) {
   // capture variables for the kernel
   auto &indcs = pmbp->pmesh->mb_indcs;
   auto &size = pmbp->pmb->mb_size;
+  auto stretch = pmbp->pmesh->stretch;
   int &is = indcs.is; int &ie = indcs.ie;
   int &js = indcs.js; int &je = indcs.je;
   int &ks = indcs.ks; int &ke = indcs.ke;
@@ -55,17 +56,17 @@ void Z4c::ADMOnePuncture(MeshBlockPack *pmbp, ParameterInput *pin) {
     Real &x2min = size.d_view(m).x2min;
     Real &x2max = size.d_view(m).x2max;
     int nx2 = indcs.nx2;
-    Real x2v = CellCenterX(j-js, nx2, x2min, x2max);
+    Real x2v = stretch.X(1, CellCenterX(j-js, nx2, x2min, x2max));
 
     Real &x3min = size.d_view(m).x3min;
     Real &x3max = size.d_view(m).x3max;
     int nx3 = indcs.nx3;
-    Real x3v = CellCenterX(k-ks, nx3, x3min, x3max);
+    Real x3v = stretch.X(2, CellCenterX(k-ks, nx3, x3min, x3max));
     AthenaScratchTensor<Real, TensorSymm::NONE, 3, 0> r;
     r.NewAthenaScratchTensor(member, scr_level, nx1);
 
     par_for_inner(member, isg, ieg, [&](const int i) {
-      Real x1v = CellCenterX(i-is, nx1, x1min, x1max);
+      Real x1v = stretch.X(0, CellCenterX(i-is, nx1, x1min, x1max));
       r(i) = std::sqrt(std::pow(x3v,2) + std::pow(x2v,2) + std::pow(x1v,2));
     });
 
@@ -118,6 +119,7 @@ void Z4c::ADMTwoPunctures(MeshBlockPack *pmbp, ini_data *data) {
   host_adm.K_dd.InitWithShallowSlice(host_u_adm, ADM::I_ADM_Kxx, ADM::I_ADM_Kzz);
   auto &indcs = pmbp->pmesh->mb_indcs;
   auto &size = pmbp->pmb->mb_size;
+  auto stretch = pmbp->pmesh->stretch;
   int &is = indcs.is; int &ie = indcs.ie;
   int &js = indcs.js; int &je = indcs.je;
   int &ks = indcs.ks; int &ke = indcs.ke;
@@ -167,15 +169,15 @@ void Z4c::ADMTwoPunctures(MeshBlockPack *pmbp, ini_data *data) {
 
     // need to populate coordinates
     for(int ix_I = isg; ix_I < ieg+1; ix_I++) {
-      x[ix_I] = CellCenterX(ix_I-is, nx1, x1min, x1max);
+      x[ix_I] = stretch.X(0, CellCenterX(ix_I-is, nx1, x1min, x1max));
     }
 
     for(int ix_J = jsg; ix_J < jeg+1; ix_J++) {
-      y[ix_J] = CellCenterX(ix_J-js, nx2, x2min, x2max);
+      y[ix_J] = stretch.X(1, CellCenterX(ix_J-js, nx2, x2min, x2max));
     }
 
     for(int ix_K = ksg; ix_K < keg+1; ix_K++) {
-      z[ix_K] = CellCenterX(ix_K-ks, nx3, x3min, x3max);
+      z[ix_K] = stretch.X(2, CellCenterX(ix_K-ks, nx3, x3min, x3max));
     }
     TwoPunctures_Cartesian_interpolation
       (data, // struct containing the previously calculated solution
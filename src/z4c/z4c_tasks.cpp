@@ -9,6 +9,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 #include <iostream>
 #include <cstdio>
 
@@ -19,6 +20,7 @@
 #include "mesh/mesh.hpp"
 #include "bvals/bvals.hpp"
 #include "z4c/compact_object_tracker.hpp"
+#include "z4c/horizon_finder.hpp"
 #include "z4c/z4c.hpp"
 #include "tasklist/numerical_relativity.hpp"
 
@@ -32,7 +34,19 @@ void Z4c::QueueZ4cTasks() {
   using namespace mhd;     // NOLINT(build/namespaces)
   using namespace numrel;  // NOLINT(build/namespaces)
   NumericalRelativity *pnr = pmy_pack->pnr;
-  auto &indcs = pmy_pack->pmesh->mb_indcs;
+  if ((halo_interval > 1) &&
+      (pmy_pack->ptmunu != nullptr || pmy_pack->pdyngr != nullptr)) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "<z4c>/halo_exchange_interval > 1 is not supported "
+              << "with matter coupling" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  if ((multirate_ratio > 1) && (pmy_pack->pdyngr == nullptr)) {
+    std::cout << "### FATAL ERROR in " << __FILE__ << " at line " << __LINE__
+              << std::endl << "<z4c>/multirate_ratio > 1 requires matter evolution "
+              << "(DynGRMHD)" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
 
   // Start task list
   pnr->QueueTask(&Z4c::InitRecv, this, Z4c_Recv, "Z4c_Recv", Task_Start);
@@ -40,18 +54,22 @@ void Z4c::QueueZ4cTasks() {
 
   // Run task list
   pnr->QueueTask(&Z4c::CopyU, this, Z4c_CopyU, "Z4c_CopyU", Task_Run);
-  switch (indcs.ng) {
+  // with <z4c>/fused_update the RHS kernel also updates u0, so (like the RK update) it
+  // must wait until the matter no longer needs the lapse and shift of this stage
+  std::vector<TaskName> rhs_opt;
+  if (fused_update) {rhs_opt.push_back(MHD_EField);}
+  switch (fd_ng) {
     case 2:
       pnr->QueueTask(&Z4c::CalcRHS<2>, this, Z4c_CalcRHS, "Z4c_CalcRHS",
-                     Task_Run, {Z4c_CopyU}, {MHD_SetTmunu});
+                     Task_Run, {Z4c_CopyU}, rhs_opt);
       break;
     case 3:
       pnr->QueueTask(&Z4c::CalcRHS<3>, this, Z4c_CalcRHS, "Z4c_CalcRHS",
-                     Task_Run, {Z4c_CopyU}, {MHD_SetTmunu});
+                     Task_Run, {Z4c_CopyU}, rhs_opt);
       break;
     case 4:
       pnr->QueueTask(&Z4c::CalcRHS<4>, this, Z4c_CalcRHS, "Z4c_CalcRHS",
-                     Task_Run, {Z4c_CopyU}, {MHD_SetTmunu});
+                     Task_Run, {Z4c_CopyU}, rhs_opt);
       break;
   }
   pnr->QueueTask(&Z4c::Z4cBoundaryRHS, this, Z4c_SomBC, "Z4c_SomBC", Task_Run,
@@ -73,6 +91,9 @@ void Z4c::QueueZ4cTasks() {
   }
   pnr->QueueTask(&Z4c::NewTimeStep, this, Z4c_Newdt, "Z4c_Newdt", Task_Run,
                  {Z4c_Z4c2ADM});
+  // with multirate integration sets the metric seen by the matter at each stage; this
+  // task is part of the matter task list (see NumericalRelativity)
+  pnr->QueueTask(&Z4c::InterpolateADM, this, Z4c_InterpADM, "Z4c_InterpADM", Task_Run);
 
   // End task list
   pnr->QueueTask(&Z4c::ClearSend, this, Z4c_ClearS, "Z4c_ClearS", Task_End);
@@ -82,7 +103,10 @@ void Z4c::QueueZ4cTasks() {
   pnr->QueueTask(&Z4c::ADMConstraints_, this, Z4c_ADMC, "Z4c_ADMC", Task_End,
   //               {Z4c_Z4c2ADM});
                  {Z4c_ClearR});
-  pnr->QueueTask(&Z4c::CalcWeylScalar, this, Z4c_Weyl, "Z4c_Weyl", Task_End, {Z4c_ADMC});
+  // The Weyl scalar branch only depends on the ghost zones of u0, so that its boundary
+  // communication overlaps with the constraint calculation
+  pnr->QueueTask(&Z4c::CalcWeylScalar, this, Z4c_Weyl, "Z4c_Weyl", Task_End,
+                 {Z4c_ClearR});
   pnr->QueueTask(&Z4c::RestrictWeyl, this, Z4c_RestW, "Z4c_RestW", Task_End, {Z4c_Weyl});
   pnr->QueueTask(&Z4c::SendWeyl, this, Z4c_SendW, "Z4c_SendW", Task_End, {Z4c_RestW});
   pnr->QueueTask(&Z4c::RecvWeyl, this, Z4c_RecvW, "Z4c_RecvW", Task_End, {Z4c_SendW});
@@ -95,6 +119,28 @@ void Z4c::QueueZ4cTasks() {
   pnr->QueueTask(&Z4c::CalcWaveForm, this, Z4c_Wave, "Z4c_Wave", Task_End,
                  {Z4c_ClearRW});
   pnr->QueueTask(&Z4c::TrackCompactObjects, this, Z4c_PT, "Z4c_PT", Task_End, {Z4c_Wave});
+  pnr->QueueTask(&Z4c::FindHorizons, this, Z4c_AHF, "Z4c_AHF", Task_End, {Z4c_PT});
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  bool Z4c::HaloExchangeStage
+//! \brief Returns true if ghost zones are exchanged at the end of this stage.  With
+//! halo_interval=k > 1 this is every k-th stage, and always the last stage of a cycle.
+
+bool Z4c::HaloExchangeStage(Driver *pdrive, int stage) {
+  return (halo_interval == 1 || stage == pdrive->nexp_stages ||
+          stage % halo_interval == 0);
+}
+
+//----------------------------------------------------------------------------------------
+//! \fn  int Z4c::HaloUpdateWidth
+//! \brief Number of ghost zones beyond the active region in which the RHS and update
+//! must be computed in this stage, so that enough valid ghost zones remain for all
+//! stages until the next exchange.  Each stage consumes fd_ng ghost zones.
+
+int Z4c::HaloUpdateWidth(Driver *pdrive, int stage) {
+  if (HaloExchangeStage(pdrive, stage)) {return 0;}
+  return (halo_interval - 1 - (stage - 1) % halo_interval)*fd_ng;
 }
 
 //----------------------------------------------------------------------------------------
@@ -103,6 +149,7 @@ void Z4c::QueueZ4cTasks() {
 //  receive status flags to waiting (with or without MPI) for Wave variables.
 
 TaskStatus Z4c::InitRecv(Driver *pdrive, int stage) {
+  if (!(HaloExchangeStage(pdrive, stage))) {return TaskStatus::complete;}
   TaskStatus tstat = pbval_u->InitRecv(nz4c);
   if (tstat != TaskStatus::complete) return tstat;
   return tstat;
@@ -113,6 +160,7 @@ TaskStatus Z4c::InitRecv(Driver *pdrive, int stage) {
 //! \brief Waits for all MPI receives to complete before allowing execution to continue
 
 TaskStatus Z4c::ClearRecv(Driver *pdrive, int stage) {
+  if (!(HaloExchangeStage(pdrive, stage))) {return TaskStatus::complete;}
   TaskStatus tstat = pbval_u->ClearRecv();
   if (tstat != TaskStatus::complete) return tstat;
   return tstat;
@@ -123,6 +171,7 @@ TaskStatus Z4c::ClearRecv(Driver *pdrive, int stage) {
 //! \brief Waits for all MPI sends to complete before allowing execution to continue
 
 TaskStatus Z4c::ClearSend(Driver *pdrive, int stage) {
+  if (!(HaloExchangeStage(pdrive, stage))) {return TaskStatus::complete;}
   TaskStatus tstat = pbval_u->ClearSend();
   if (tstat != TaskStatus::complete) return tstat;
   return tstat;
@@ -133,12 +182,21 @@ TaskStatus Z4c::ClearSend(Driver *pdrive, int stage) {
 //! \brief  copy u0 --> u1 in first stage
 
 TaskStatus Z4c::CopyU(Driver *pdrive, int stage) {
+  // low-storage integrators keep no copy of u0
+  if (pdrive->low_storage) {
+    return TaskStatus::complete;
+  }
   auto integrator = pdrive->integrator;
 
+  // in wide-halo mode later stages update u0 in ghost zones from u1, so accumulate
+  // over the ghost zones as well
+  int ng = (halo_interval > 1)? pmy_pack->pmesh->mb_indcs.ng : 0;
   auto &indcs = pmy_pack->pmesh->mb_indcs;
-  int is = indcs.is, ie = indcs.ie;
+  int is = indcs.is - ng, ie = indcs.ie + ng;
   int js = indcs.js, je = indcs.je;
   int ks = indcs.ks, ke = indcs.ke;
+  if (indcs.nx2 > 1) {js -= ng; je += ng;}
+  if (indcs.nx3 > 1) {ks -= ng; ke += ng;}
   int nmb1 = pmy_pack->nmb_thispack - 1;
   int nvar = nz4c;
   auto &u0 = pmy_pack->pz4c->u0;
@@ -170,6 +228,7 @@ TaskStatus Z4c::CopyU(Driver *pdrive, int stage) {
 //! \brief sends cell-centered conserved variables
 
 TaskStatus Z4c::SendU(Driver *pdrive, int stage) {
+  if (!(HaloExchangeStage(pdrive, stage))) {return TaskStatus::complete;}
   TaskStatus tstat = pbval_u->PackAndSendCC(u0, coarse_u0);
   return tstat;
 }
@@ -179,6 +238,7 @@ TaskStatus Z4c::SendU(Driver *pdrive, int stage) {
 //! \brief receives cell-centered conserved variables
 
 TaskStatus Z4c::RecvU(Driver *pdrive, int stage) {
+  if (!(HaloExchangeStage(pdrive, stage))) {return TaskStatus::complete;}
   TaskStatus tstat = pbval_u->RecvAndUnpackCC(u0, coarse_u0);
   return tstat;
 }
@@ -189,7 +249,8 @@ TaskStatus Z4c::RecvU(Driver *pdrive, int stage) {
 
 TaskStatus Z4c::EnforceAlgConstr(Driver *pdrive, int stage) {
   if (pmy_pack->pdyngr != nullptr || stage == pdrive->nexp_stages) {
-    AlgConstr(pmy_pack);
+    // with <z4c>/fused_update the active zones were projected by the RHS kernel
+    AlgConstr(pmy_pack, fused_update);
   }
   return TaskStatus::complete;
 }
@@ -199,8 +260,16 @@ TaskStatus Z4c::EnforceAlgConstr(Driver *pdrive, int stage) {
 //! \brief
 
 TaskStatus Z4c::ConvertZ4cToADM(Driver *pdrive, int stage) {
-  if (pmy_pack->pdyngr != nullptr || stage == pdrive->nexp_stages) {
-    Z4cToADM(pmy_pack);
+  // u0 has been updated, so ADM variables and constraints are out of date
+  adm_current = false;
+  con_current = false;
+  // matter evolution needs the ADM variables every stage (or only at the end of the
+  // spacetime step with multirate integration), otherwise they are computed at the end
+  // of the step, or only when used if lazy_adm=true
+  bool last_stage = (stage == pdrive->nexp_stages);
+  if ((pmy_pack->pdyngr != nullptr && (multirate_ratio == 1 || last_stage)) ||
+      (last_stage && !(lazy_adm))) {
+    UpdateADM();
   }
   return TaskStatus::complete;
 }
@@ -221,16 +290,10 @@ TaskStatus Z4c::UpdateExcisionMasks(Driver *pdrive, int stage) {
 //! \brief
 
 TaskStatus Z4c::ADMConstraints_(Driver *pdrive, int stage) {
-  auto &indcs = pmy_pack->pmesh->mb_indcs;
-  if (stage == pdrive->nexp_stages) {
-    switch (indcs.ng) {
-      case 2: ADMConstraints<2>(pmy_pack);
-              break;
-      case 3: ADMConstraints<3>(pmy_pack);
-              break;
-      case 4: ADMConstraints<4>(pmy_pack);
-              break;
-    }
+  // with lazy_adm=true constraints are only computed by outputs that use them, and with
+  // con_norms_only the history output reduces their norms itself
+  if (stage == pdrive->nexp_stages && !(lazy_adm) && !(con_norms_only)) {
+    UpdateConstraints();
   }
   return TaskStatus::complete;
 }
@@ -240,8 +303,8 @@ TaskStatus Z4c::ADMConstraints_(Driver *pdrive, int stage) {
 //! \brief
 
 TaskStatus Z4c::RestrictU(Driver *pdrive, int stage) {
-  // Only execute Mesh function with SMR/SMR
-  if (pmy_pack->pmesh->multilevel) {
+  // Only execute Mesh function with SMR/SMR, on ranks with coarse arrays
+  if (pmy_pack->pmesh->multilevel && pmy_pack->pmb->need_coarse) {
     pmy_pack->pmesh->pmr->RestrictCC(u0, coarse_u0, true);
   }
   return TaskStatus::complete;
@@ -253,7 +316,8 @@ TaskStatus Z4c::RestrictU(Driver *pdrive, int stage) {
 //! at fine/coarse boundaries with SMR/AMR
 
 TaskStatus Z4c::Prolongate(Driver *pdrive, int stage) {
-  if (pmy_pack->pmesh->multilevel) {  // only prolongate with SMR/AMR
+  // only prolongate with SMR/AMR, on ranks with coarse arrays
+  if (pmy_pack->pmesh->multilevel && pmy_pack->pmb->need_coarse) {
 //    pbval_u->FillCoarseInBndryCC(u0, coarse_u0);
     pbval_u->ProlongateCC(u0, coarse_u0, true);
   }
@@ -280,6 +344,7 @@ TaskStatus Z4c::ApplyPhysicalBCs(Driver *pdrive, int stage) {
 
 TaskStatus Z4c::TrackCompactObjects(Driver *pdrive, int stage) {
   if (stage == pdrive->nexp_stages) {
+    if (!(ptracker.empty())) {UpdateADM();}
     for (auto & pt : ptracker) {
       pt.InterpolateVelocity(pmy_pack);
       pt.EvolveTracker();
@@ -289,6 +354,22 @@ TaskStatus Z4c::TrackCompactObjects(Driver *pdrive, int stage) {
   return TaskStatus::complete;
 }
 
+//----------------------------------------------------------------------------------------
+//! \fn  void Z4c::FindHorizons
+//! \brief search for apparent horizons at the end of the last stage; the ADM variables
+//! then hold the solution at the end of the step
+
+TaskStatus Z4c::FindHorizons(Driver *pdrive, int stage) {
+  if (stage == pdrive->nexp_stages) {
+    Mesh *pm = pmy_pack->pmesh;
+    for (auto & ph : phorizons) {
+      if (ph.SearchDue(pm->ncycle + 1)) {UpdateADM();}
+      ph.Find(pm->ncycle + 1, pm->time + pm->dt, ptracker);
+    }
+  }
+  return TaskStatus::complete;
+}
+
 
 //----------------------------------------------------------------------------------------
 //! \fn  void Z4c::CalcWeylScalar_
@@ -300,8 +381,8 @@ TaskStatus Z4c::CalcWeylScalar(Driver *pdrive, int stage) {
   } else {
     float time_32 = static_cast<float>(pmy_pack->pmesh->time);
     if (last_output_time==time_32 && stage == pdrive->nexp_stages) {
-      auto &indcs = pmy_pack->pmesh->mb_indcs;
-      switch (indcs.ng) {
+      UpdateADM();
+      switch (fd_ng) {
         case 2: Z4cWeyl<2>(pmy_pack);
                 break;
         case 3: Z4cWeyl<3>(pmy_pack);
@@ -372,7 +453,7 @@ TaskStatus Z4c::RestrictWeyl(Driver *pdrive, int stage) {
   } else {
     float time_32 = static_cast<float>(pmy_pack->pmesh->time);
     if ((last_output_time==time_32) && (stage == pdrive->nexp_stages)) {
-      if (pmy_pack->pmesh->multilevel) {
+      if (pmy_pack->pmesh->multilevel && pmy_pack->pmb->need_coarse) {
         pmy_pack->pmesh->pmr->RestrictCC(u_weyl, coarse_u_weyl, true);
       }
     }
@@ -391,7 +472,7 @@ TaskStatus Z4c::ProlongateWeyl(Driver *pdrive, int stage) {
   } else {
     float time_32 = static_cast<float>(pmy_pack->pmesh->time);
     if ((last_output_time==time_32) && (stage == pdrive->nexp_stages)) {
-      if (pmy_pack->pmesh->multilevel) {
+      if (pmy_pack->pmesh->multilevel && pmy_pack->pmb->need_coarse) {
         pbval_weyl->ProlongateCC(u_weyl, coarse_u_weyl);
       }
     }
@@ -19,20 +19,40 @@ namespace z4c {
 //! \fn  void Z4c::Update
 //! \brief Explicit RK update
 TaskStatus Z4c::ExpRKUpdate(Driver *pdriver, int stage) {
+  // in wide-halo mode, also update ghost zones needed before the next exchange
+  int w = HaloUpdateWidth(pdriver, stage);
   auto &indcs = pmy_pack->pmesh->mb_indcs;
-  int is = indcs.is, ie = indcs.ie;
+  int is = indcs.is - w, ie = indcs.ie + w;
   int js = indcs.js, je = indcs.je;
   int ks = indcs.ks, ke = indcs.ke;
+  if (indcs.nx2 > 1) {js -= w; je += w;}
+  if (indcs.nx3 > 1) {ks -= w; ke += w;}
 
+  // with <z4c>/fused_update the update was applied by the RHS kernel
+  if (fused_update) {
+    return TaskStatus::complete;
+  }
+
+  int nmb1 = pmy_pack->nmb_thispack - 1;
+  int nvar = nz4c;
+  auto &u0 = pmy_pack->pz4c->u0;
+  auto &u_rhs = pmy_pack->pz4c->u_rhs;
+
+  // 2N low-storage integrators: u_rhs holds the accumulated stage increment
+  if (pdriver->low_storage) {
+    Real b_dt = (pdriver->lsrk_b[stage-1])*(pmy_pack->pmesh->dt);
+    par_for("z4c LSRK update",DevExeSpace(),
+        0,nmb1,0,nvar-1,ks,ke,js,je,is,ie,
+    KOKKOS_LAMBDA(const int m, const int n, const int k, const int j, const int i) {
+      u0(m,n,k,j,i) += b_dt*u_rhs(m,n,k,j,i);
+    });
+    return TaskStatus::complete;
+  }
 
   Real &gam0 = pdriver->gam0[stage-1];
   Real &gam1 = pdriver->gam1[stage-1];
   Real beta_dt = (pdriver->beta[stage-1])*(pmy_pack->pmesh->dt);
-  auto &u0 = pmy_pack->pz4c->u0;
   auto &u1 = pmy_pack->pz4c->u1;
-  auto &u_rhs = pmy_pack->pz4c->u_rhs;
-  int nmb1 = pmy_pack->nmb_thispack - 1;
-  int nvar = nz4c;
 
   par_for("z4c RK update",DevExeSpace(),
       0,nmb1,0,nvar-1,ks,ke,js,je,is,ie,
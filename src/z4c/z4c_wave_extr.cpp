@@ -78,47 +78,115 @@ void Z4c::WaveExtr(MeshBlockPack *pmbp) {
   int lmax = 8;
   // bool bitant = false;
 
-  Real ylmR,ylmI;
+  // complete reduction and output of waveform from the previous extraction, so that
+  // psi_out can be reused
+  FinishWaveExtr();
+
+  // Interpolate Weyl scalars to all surfaces, which stay on the device for projection
+  for (int g=0; g<nradii; ++g) {
+    grids[g]->InterpolateToSphere(2, u_weyl, false);
+  }
+
+  // Project psi4 onto the harmonics on the device: for each mode, the real (p=0) and
+  // imaginary (p=1) parts are a sum over angles of the tabulated basis times the data
+  int nlm = LmIndex(lmax,lmax) + 1;
+  auto &ylm = wave_ylm;
+  auto &psi = wave_psi;
+  auto psi_d = wave_psi.d_view;
+  for (int g=0; g<nradii; ++g) {
+    auto vals = grids[g]->interp_vals.d_view;
+    int nang = grids[g]->nangles;
+    par_for_outer("wave_proj",DevExeSpace(),0,0,0,(nlm-1),0,1,
+    KOKKOS_LAMBDA(TeamMember_t tmember, const int lm, const int p) {
+      Real sum = 0.0;
+      Kokkos::parallel_reduce(Kokkos::TeamThreadRange(tmember, nang),
+      [=](const int ip, Real &s) {
+        Real yr = ylm(lm,0,ip), yi = ylm(lm,1,ip);
+        s += (p == 0)? (vals(ip,0)*yr + vals(ip,1)*yi) : (vals(ip,1)*yr - vals(ip,0)*yi);
+      }, Kokkos::Sum<Real>(sum));
+      Kokkos::single(Kokkos::PerTeam(tmember), [&]() {psi_d(g,lm,p) = sum;});
+    });
+  }
+  psi.template modify<DevExeSpace>();
+  psi.template sync<HostMemSpace>();
   int count = 0;
   for (int g=0; g<nradii; ++g) {
-    // Interpolate Weyl scalars to the surface
-    grids[g]->InterpolateToSphere(2, u_weyl);
-    for (int l = 2; l < lmax+1; ++l) {
-      for (int m = -l; m < l+1 ; ++m) {
-        Real psilmR = 0.0;
-        Real psilmI = 0.0;
-          for (int ip = 0; ip < grids[g]->nangles; ++ip) {
-            Real theta = grids[g]->polar_pos.h_view(ip,0);
-            Real phi = grids[g]->polar_pos.h_view(ip,1);
-            Real datareal = grids[g]->interp_vals.h_view(ip,0);
-            Real dataim = grids[g]->interp_vals.h_view(ip,1);
-            Real weight = grids[g]->solid_angles.h_view(ip);
-            swsh(&ylmR,&ylmI,l,m,theta,phi);
-            // The spherical harmonics transform as
-            // Y^s_{l m}( Pi-th, ph ) = (-1)^{l+s} Y^s_{l -m}(th, ph)
-            // but the PoisitionPolar function returns theta \in [0,\pi],
-            // so these are correct for bitant.
-            // With bitant, under reflection the imaginary part of
-            // the weyl scalar should pick a - sign,
-            // which is accounted for here.
-            // Real bitant_z_fac = (bitant && theta > M_PI/2) ? -1 : 1;
-            psilmR += weight*(datareal*ylmR + dataim*ylmI);
-            psilmI += weight*(dataim*ylmR - datareal*ylmI);
-          }
-        psi_out[count++] = psilmR;
-        psi_out[count++] = psilmI;
-      }
+    for (int lm=0; lm<nlm; ++lm) {
+      psi_out[count++] = psi.h_view(g,lm,0);
+      psi_out[count++] = psi.h_view(g,lm,1);
     }
   }
 
-  // write output
+  // reduce waveform to rank 0; with MPI the reduction is non-blocking and is completed
+  // (and output written) at the next extraction, or when Z4c is destroyed
   #if MPI_PARALLEL_ENABLED
-  if (0 == global_variable::my_rank) {
-    MPI_Reduce(MPI_IN_PLACE, psi_out, count, MPI_ATHENA_REAL, MPI_SUM, 0, MPI_COMM_WORLD);
-  } else {
-    MPI_Reduce(psi_out, psi_out, count, MPI_ATHENA_REAL, MPI_SUM, 0, MPI_COMM_WORLD);
+  MPI_Ireduce(psi_out, psi_sum, count, MPI_ATHENA_REAL, MPI_SUM, 0,
+              global_variable::mpi_comm, &psi_req);
+  psi_time = pmbp->pmesh->time;
+  psi_pending = true;
+  #else
+  WriteWaveForm(pmbp->pmesh->time, psi_out);
+  #endif
+}
+
+//----------------------------------------------------------------------------------------
+// \!fn void Z4c::SetWaveExtrBasis()
+// \brief tabulate the spin weighted spherical harmonics times the solid angle at the
+// (fixed) angles of the extraction spheres, which all have the same geodesic grid
+//
+// The spherical harmonics transform as Y^s_{l m}( Pi-th, ph ) = (-1)^{l+s} Y^s_{l -m}(th,
+// ph), but the PositionPolar function returns theta \in [0,\pi], so these are correct
+// for bitant.  With bitant, under reflection the imaginary part of the weyl scalar
+// should pick a - sign (not implemented).
+
+void Z4c::SetWaveExtrBasis() {
+  auto &grids = spherical_grids;
+  int nradii = grids.size();
+  int lmax = 8;
+  int nlm = LmIndex(lmax,lmax) + 1;
+  int nang = (nradii > 0)? grids[0]->nangles : 1;
+  Kokkos::realloc(wave_ylm, nlm, 2, nang);
+  Kokkos::realloc(wave_psi, std::max(nradii,1), nlm, 2);
+  if (nradii == 0) return;
+
+  auto ylm_h = Kokkos::create_mirror_view(wave_ylm);
+  Real ylmR,ylmI;
+  for (int l = 2; l < lmax+1; ++l) {
+    for (int m = -l; m < l+1 ; ++m) {
+      for (int ip = 0; ip < nang; ++ip) {
+        Real theta = grids[0]->polar_pos.h_view(ip,0);
+        Real phi = grids[0]->polar_pos.h_view(ip,1);
+        Real weight = grids[0]->solid_angles.h_view(ip);
+        swsh(&ylmR,&ylmI,l,m,theta,phi);
+        ylm_h(LmIndex(l,m),0,ip) = weight*ylmR;
+        ylm_h(LmIndex(l,m),1,ip) = weight*ylmI;
+      }
+    }
   }
+  Kokkos::deep_copy(wave_ylm, ylm_h);
+}
+
+//----------------------------------------------------------------------------------------
+// \!fn void Z4c::FinishWaveExtr()
+// \brief wait for the pending reduction of the waveform (if any) and write it out
+
+void Z4c::FinishWaveExtr() {
+  if (!(psi_pending)) return;
+  #if MPI_PARALLEL_ENABLED
+  MPI_Wait(&psi_req, MPI_STATUS_IGNORE);
   #endif
+  psi_pending = false;
+  WriteWaveForm(psi_time, psi_sum);
+}
+
+//----------------------------------------------------------------------------------------
+// \!fn void Z4c::WriteWaveForm(Real time, Real *psi)
+// \brief append waveform psi extracted at time to output files (on rank 0 only)
+
+void Z4c::WriteWaveForm(Real time, Real *psi) {
+  auto &grids = spherical_grids;
+  int nradii = grids.size();
+  int lmax = 8;
 
   if (0 == global_variable::my_rank) {
     int idx = 0;
@@ -198,14 +266,14 @@ void Z4c::WaveExtr(MeshBlockPack *pmbp) {
       outFile2.open(filename2, std::ios::out | std::ios::app);
 
       // first append time
-      outFile << pmbp->pmesh->time << "\t";
-      outFile2 << pmbp->pmesh->time << "\t";
+      outFile << time << "\t";
+      outFile2 << time << "\t";
 
       // append waveform
       for (int l = 2; l < lmax+1; ++l) {
         for (int m = -l; m < l+1 ; ++m) {
-          outFile << std::setprecision(15) << psi_out[idx++] << '\t';
-          outFile2 << std::setprecision(15) << psi_out[idx++] << '\t';
+          outFile << std::setprecision(15) << psi[idx++] << '\t';
+          outFile2 << std::setprecision(15) << psi[idx++] << '\t';
         }
       }
       outFile << '\n';
@@ -0,0 +1,158 @@
+#!/usr/bin/env python
+
+# Weak- and strong-scaling harness.
+
+# Usage: From this directory, after building AthenaK (with MPI) in ../build, e.g.:
+#        python scaling.py --ranks 1 2 4 8 --block 32 64 --nmb_per_rank 1 8 \
+#            --physics hydro mhd --output scaling.json
+#
+# Notes:
+#   - Requires Python 3+.
+#   - Runs the 'scaling' problem generator with inputs/tests/scaling_<physics>.athinput
+#     for every combination of number of ranks, MeshBlock size, MeshBlocks per rank (weak
+#     scaling) and physics.  For strong scaling (--mode strong) the size of the Mesh is
+#     fixed by --strong_nx instead, and the number of MeshBlocks per rank follows.
+#   - Timings are read from the JSON summaries written by the built-in profiler
+#     (<time>/profile_file), so no parsing of stdout is needed.  The summary of the first
+#     profile_ncycles cycles is discarded as warm-up.
+#   - This is not a regression test, so it lives outside scripts/ and is not run by
+#     run_tests.py.
+
+# Modules
+import argparse
+import json
+import os
+import shlex
+import subprocess
+import sys
+import tempfile
+
+physics_choices = ['hydro', 'mhd', 'grmhd', 'z4c_dyngr']
+
+
+# Split n MeshBlocks into a 3D array of nb[0] x nb[1] x nb[2] MeshBlocks that is as
+# close to cubic as possible
+def block_decomposition(n):
+    nb = [1, 1, 1]
+    factors = []
+    p = 2
+    while n > 1:
+        while n % p == 0:
+            factors.append(p)
+            n //= p
+        p += 1
+    for f in sorted(factors, reverse=True):
+        nb[nb.index(min(nb))] *= f
+    return sorted(nb, reverse=True)
+
+
+# Run one case, and return dict of its parameters and profiler summaries
+def run_case(args, physics, nranks, block, nx):
+    with tempfile.TemporaryDirectory() as run_dir:
+        profile_file = os.path.join(run_dir, 'profile.json')
+        input_file = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..',
+                                  'inputs', 'tests', 'scaling_' + physics + '.athinput')
+        nmb = (nx[0]//block)*(nx[1]//block)*(nx[2]//block)
+        cmd = shlex.split(args.mpiexec) + [str(nranks), os.path.abspath(args.exe), '-i',
+                                              input_file, '-d', run_dir]
+        cmd += ['mesh/nx{0}={1}'.format(d+1, nx[d]) for d in range(3)]
+        cmd += ['meshblock/nx{0}={1}'.format(d+1, block) for d in range(3)]
+        cmd += ['time/nlim={0}'.format(args.ncycles*(args.nreports + 1)),
+                'time/profile_ncycles={0}'.format(args.ncycles),
+                'time/profile_file={0}'.format(profile_file),
+                'problem/nmb_per_rank={0}'.format(nmb//nranks)]
+        print(' '.join(cmd), file=sys.stderr, flush=True)
+        result = {'physics': physics, 'nranks': nranks, 'block': block, 'mesh': nx,
+                  'nmb_total': nmb, 'nmb_per_rank': nmb/nranks}
+        try:
+            subprocess.run(cmd, check=True, timeout=args.timeout,
+                           stdout=subprocess.DEVNULL if args.quiet else sys.stderr)
+        except (subprocess.CalledProcessError, subprocess.TimeoutExpired) as err:
+            result['error'] = str(err)
+            return result
+        with open(profile_file) as f:
+            reports = [json.loads(line) for line in f if line.strip()]
+        # discard warm-up cycles
+        reports = reports[1:]
+        result['reports'] = reports
+        if len(reports) > 0:
+            zcs = [r['zone_cycles_per_sec'] for r in reports]
+            result['zone_cycles_per_sec'] = sum(zcs)/len(zcs)
+            result['zone_cycles_per_sec_per_rank'] = result['zone_cycles_per_sec']/nranks
+    return result
+
+
+# Main function
+def main(**kwargs):
+    args = argparse.Namespace(**kwargs)
+    cases = []
+    for physics in args.physics:
+        for nranks in args.ranks:
+            for block in args.block:
+                if args.mode == 'weak':
+                    for nmb_per_rank in args.nmb_per_rank:
+                        nb = block_decomposition(nranks*nmb_per_rank)
+                        cases.append((physics, nranks, block, [block*n for n in nb]))
+                else:
+                    nx = args.strong_nx
+                    if any(n % block != 0 for n in nx):
+                        print('skipping block size {0}, does not divide Mesh {1}'
+                              .format(block, nx), file=sys.stderr)
+                        continue
+                    cases.append((physics, nranks, block, list(nx)))
+
+    results = []
+    for case in cases:
+        results.append(run_case(args, *case))
+        # efficiency (per rank) relative to first case with fewest ranks and the same
+        # physics and MeshBlock size (and MeshBlocks per rank for weak scaling)
+        r = results[-1]
+        base = next(b for b in results if b['physics'] == r['physics']
+                    and b['block'] == r['block'] and (args.mode == 'strong'
+                    or b['nmb_per_rank'] == r['nmb_per_rank']))
+        if 'zone_cycles_per_sec' in r and 'zone_cycles_per_sec' in base:
+            r['efficiency'] = (r['zone_cycles_per_sec_per_rank']
+                               / base['zone_cycles_per_sec_per_rank'])
+
+    output = {'mode': args.mode, 'exe': args.exe, 'mpiexec': args.mpiexec,
+              'ncycles': args.ncycles, 'cases': results}
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(output, f, indent=1)
+    else:
+        json.dump(output, sys.stdout, indent=1)
+        print()
+    return 0 if all('error' not in r for r in results) else 1
+
+
+# Execute main function
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--exe', type=str,
+                        default=os.path.join('..', 'build', 'src', 'athena'),
+                        help='AthenaK executable')
+    parser.add_argument('--mpiexec', type=str, default='mpiexec -n',
+                        help='MPI launcher, followed by number of ranks')
+    parser.add_argument('--mode', choices=['weak', 'strong'], default='weak',
+                        help='weak or strong scaling')
+    parser.add_argument('--ranks', type=int, nargs='+', default=[1],
+                        help='numbers of MPI ranks')
+    parser.add_argument('--block', type=int, nargs='+', default=[32],
+                        help='MeshBlock sizes (cells in each direction)')
+    parser.add_argument('--nmb_per_rank', type=int, nargs='+', default=[1],
+                        help='MeshBlocks per rank (weak scaling)')
+    parser.add_argument('--strong_nx', type=int, nargs=3, default=[128, 128, 128],
+                        help='size of Mesh (strong scaling)')
+    parser.add_argument('--physics', choices=physics_choices, nargs='+',
+                        default=['hydro'], help='physics to be run')
+    parser.add_argument('--ncycles', type=int, default=10,
+                        help='cycles per profiler summary')
+    parser.add_argument('--nreports', type=int, default=2,
+                        help='profiler summaries recorded after warm-up')
+    parser.add_argument('--timeout', type=float, default=None,
+                        help='time limit for each run [s]')
+    parser.add_argument('--quiet', action='store_true',
+                        help='discard stdout of AthenaK')
+    parser.add_argument('--output', type=str, default=None,
+                        help='file for JSON results [stdout]')
+    sys.exit(main(**vars(parser.parse_args())))
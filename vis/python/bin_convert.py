@@ -89,6 +89,39 @@ import h5py
 import os
 
 
+def decode_compressed(payload, n_vars, ncells, abs_err):
+    """
+    Decodes the data of one MeshBlock written with <output>/compress_error > 0.
+
+    Each value x was quantized to the integer s = round(x / (2*abs_err)), and the
+    differences of consecutive s within each variable were written as zigzag-encoded
+    LEB128 variable-length integers.
+
+    args:
+      payload - bytes
+          compressed data of all variables of the MeshBlock
+      n_vars, ncells - int
+          number of variables, and number of cells per variable
+      abs_err - float
+          absolute error bound used by the encoder
+
+    returns:
+      data - array with shape [n_vars, ncells]
+    """
+    b = np.frombuffer(payload, dtype=np.uint8).astype(np.uint64)
+    ends = np.flatnonzero(b < 128)
+    if len(ends) != n_vars * ncells:
+        raise ValueError("compressed MeshBlock data is corrupt")
+    starts = np.concatenate(([0], ends[:-1] + 1))
+    group = np.repeat(np.arange(len(ends)), ends - starts + 1)
+    shift = ((np.arange(len(b)) - starts[group]) * 7).astype(np.uint64)
+    z = np.zeros(len(ends), dtype=np.uint64)
+    np.add.at(z, group, (b & np.uint64(0x7F)) << shift)
+    diff = (z >> np.uint64(1)).astype(np.int64) ^ -((z & np.uint64(1)).astype(np.int64))
+    s = np.cumsum(diff.reshape(n_vars, ncells), axis=1)
+    return (s * (2.0 * abs_err)).astype(np.float32)
+
+
 def read_binary(filename):
     """
     Reads a bin file from filename to dictionary.
@@ -123,7 +156,7 @@ def read_binary(filename):
             + '(should be "Athena")'
         )
     version = code_header[-1].split(b"=")[-1]
-    if version != b"1.1":
+    if version not in [b"1.1", b"1.2"]:
         raise TypeError(f"unsupported file format version {version.decode('utf-8')}")
 
     pheader_count = int(fp.readline().split(b"=")[-1])
@@ -135,6 +168,7 @@ def read_binary(filename):
     cycle = int(pheader["cycle"])
     locsizebytes = int(pheader["size of location"])
     varsizebytes = int(pheader["size of variable"])
+    abs_err = float(pheader.get("compression error", 0.0))
 
     nvars = int(fp.readline().split(b"=")[-1])
     var_list = [v.decode("utf-8") for v in fp.readline().split()[1:]]
@@ -210,12 +244,18 @@ def read_binary(filename):
             np.array(struct.unpack("=6" + locfmt, fp.read(6 * locsizebytes)))
         )
 
-        data = np.array(
-            struct.unpack(
-                f"={nx1_out*nx2_out*nx3_out*n_vars}" + varfmt,
-                fp.read(varsizebytes * nx1_out * nx2_out * nx3_out * n_vars),
+        if abs_err > 0.0:
+            nbytes = struct.unpack("@Q", fp.read(8))[0]
+            data = decode_compressed(
+                fp.read(nbytes), n_vars, nx1_out * nx2_out * nx3_out, abs_err
+            )
+        else:
+            data = np.array(
+                struct.unpack(
+                    f"={nx1_out*nx2_out*nx3_out*n_vars}" + varfmt,
+                    fp.read(varsizebytes * nx1_out * nx2_out * nx3_out * n_vars),
+                )
             )
-        )
         data = data.reshape(nvars, nx3_out, nx2_out, nx1_out)
         for vari, var in enumerate(var_list):
             mb_data[var].append(data[vari])
@@ -290,7 +330,7 @@ def read_coarsened_binary(filename):
             + '(should be "Athena")'
         )
     version = code_header[-1].split(b"=")[-1]
-    if version != b"1.1":
+    if version not in [b"1.1", b"1.2"]:
         raise TypeError(f"unsupported file format version {version.decode('utf-8')}")
 
     pheader_count = int(fp.readline().split(b"=")[-1])
@@ -302,6 +342,7 @@ def read_coarsened_binary(filename):
     cycle = int(pheader["cycle"])
     locsizebytes = int(pheader["size of location"])
     varsizebytes = int(pheader["size of variable"])
+    abs_err = float(pheader.get("compression error", 0.0))
     coarsen_factor = int(pheader["coarsening factor"])
 
     nvars = int(fp.readline().split(b"=")[-1])
@@ -378,12 +419,18 @@ def read_coarsened_binary(filename):
             np.array(struct.unpack("=6" + locfmt, fp.read(6 * locsizebytes)))
         )
 
-        data = np.array(
-            struct.unpack(
-                f"={nx1_out*nx2_out*nx3_out*n_vars}" + varfmt,
-                fp.read(varsizebytes * nx1_out * nx2_out * nx3_out * n_vars),
+        if abs_err > 0.0:
+            nbytes = struct.unpack("@Q", fp.read(8))[0]
+            data = decode_compressed(
+                fp.read(nbytes), n_vars, nx1_out * nx2_out * nx3_out, abs_err
+            )
+        else:
+            data = np.array(
+                struct.unpack(
+                    f"={nx1_out*nx2_out*nx3_out*n_vars}" + varfmt,
+                    fp.read(varsizebytes * nx1_out * nx2_out * nx3_out * n_vars),
+                )
             )
-        )
         data = data.reshape(nvars, nx3_out, nx2_out, nx1_out)
         for vari, var in enumerate(var_list):
             mb_data[var].append(data[vari])
@@ -444,23 +491,76 @@ def write_athdf(filename, fdata, varsize_bytes=4, locsize_bytes=8):
         raise ValueError(f"varsizebytes must be 4 or 8, not {varsize_bytes}")
     if locsize_bytes not in [4, 8]:
         raise ValueError(f"locsizebytes must be 4 or 8, not {locsize_bytes}")
-    locfmt = "<f4" if locsize_bytes == 4 else "<f8"
     varfmt = "<f4" if varsize_bytes == 4 else "<f8"
 
     # extract Mesh/MeshBlock parameters
     nmb = fdata["n_mbs"]
-    Nx1 = fdata["Nx1"]  # noqa: F841
-    Nx2 = fdata["Nx2"]
-    Nx3 = fdata["Nx3"]
-    nx1 = fdata["nx1_mb"]
-    nx2 = fdata["nx2_mb"]
-    nx3 = fdata["nx3_mb"]
     nx1_out = fdata["nx1_out_mb"]
     nx2_out = fdata["nx2_out_mb"]
     nx3_out = fdata["nx3_out_mb"]
 
     number_of_moments = fdata.get("number_of_moments", 1)
 
+    # keep variable order but separate out magnetic field
+    vars_without_b, vars_only_b = athdf_variables(fdata)
+
+    if len(vars_only_b) > 0:
+        B = np.zeros((3*number_of_moments, nmb, nx3_out, nx2_out, nx1_out))
+    uov = np.zeros((len(vars_without_b), nmb, nx3_out, nx2_out, nx1_out))
+    for ivar, var in enumerate(vars_without_b):
+        uov[ivar] = fdata["mb_data"][var]
+    for ibvar, bvar in enumerate(vars_only_b):
+        B[ibvar] = fdata["mb_data"][bvar]
+
+    # Set Attributes and create Datasets
+    hfp = h5py.File(filename, "w")
+    write_athdf_metadata(hfp, fdata, locsize_bytes)
+    if len(vars_only_b) > 0:
+        hfp.create_dataset("B", data=B, dtype=varfmt)
+    hfp.create_dataset("uov", data=uov, dtype=varfmt)
+    hfp.close()
+
+
+def athdf_variables(fdata):
+    """
+    Returns names of variables stored in the "uov" and "B" datasets of athdf files.
+
+    args:
+      fdata - dict
+          dictionary of fluid file data, e.g., as loaded from read_binary(...)
+
+    returns:
+      vars_without_b, vars_only_b - lists of strings
+          variables in file order, without and only with magnetic field ("bcc")
+    """
+    vars_without_b = [v for v in fdata["var_names"] if "bcc" not in v]
+    vars_only_b = [v for v in fdata["var_names"] if v not in vars_without_b]
+    return vars_without_b, vars_only_b
+
+
+def write_athdf_metadata(hfp, fdata, locsize_bytes=8):
+    """
+    Writes attributes, levels, logical locations, and coordinates of all MeshBlocks
+    to an open athdf (hdf5) file, i.e. everything except the variable datasets.
+
+    args:
+      hfp           - h5py.File
+          athdf file open for writing
+      fdata         - dict
+          dictionary of file data, e.g., as loaded from read_binary(...); only
+          "mb_data" is not used
+      locsize_bytes - int (default=8, options=4,8)
+          number of bytes to use for output location data
+    """
+    locfmt = "<f4" if locsize_bytes == 4 else "<f8"
+
+    nmb = fdata["n_mbs"]
+    Nx2 = fdata["Nx2"]
+    Nx3 = fdata["Nx3"]
+    nx1 = fdata["nx1_mb"]
+    nx2 = fdata["nx2_mb"]
+    nx3 = fdata["nx3_mb"]
+
     # check dimensionality/slicing
     nx1_out = fdata["nx1_out_mb"]
     nx2_out = fdata["nx2_out_mb"]
@@ -471,15 +571,10 @@ def write_athdf(filename, fdata, varsize_bytes=4, locsize_bytes=8):
     x2slice = nx2_out == 1 and (two_d or three_d)
     x3slice = nx3_out == 1 and three_d
 
-    # keep variable order but separate out magnetic field
-    vars_without_b = [v for v in fdata["var_names"] if "bcc" not in v]
-    vars_only_b = [v for v in fdata["var_names"] if v not in vars_without_b]
+    vars_without_b, vars_only_b = athdf_variables(fdata)
 
-    if len(vars_only_b) > 0:
-        B = np.zeros((3*number_of_moments, nmb, nx3_out, nx2_out, nx1_out))
     Levels = np.zeros(nmb)
     LogicalLocations = np.zeros((nmb, 3))
-    uov = np.zeros((len(vars_without_b), nmb, nx3_out, nx2_out, nx1_out))
     x1f = np.zeros((nmb, nx1_out + 1))
     x1v = np.zeros((nmb, nx1_out))
     x2f = np.zeros((nmb, nx2_out + 1))
@@ -487,11 +582,6 @@ def write_athdf(filename, fdata, varsize_bytes=4, locsize_bytes=8):
     x3f = np.zeros((nmb, nx3_out + 1))
     x3v = np.zeros((nmb, nx3_out))
 
-    for ivar, var in enumerate(vars_without_b):
-        uov[ivar] = fdata["mb_data"][var]
-    for ibvar, bvar in enumerate(vars_only_b):
-        B[ibvar] = fdata["mb_data"][bvar]
-
     for mb in range(nmb):
         logical = fdata["mb_logical"][mb]
         LogicalLocations[mb] = logical[:3]
@@ -536,7 +626,6 @@ def write_athdf(filename, fdata, varsize_bytes=4, locsize_bytes=8):
         dataset_nvars.append(len(vars_only_b))
 
     # Set Attributes
-    hfp = h5py.File(filename, "w")
     hfp.attrs["Header"] = fdata["header"]
     hfp.attrs["Time"] = fdata["time"]
     hfp.attrs["NumCycles"] = fdata["cycle"]
@@ -559,18 +648,14 @@ def write_athdf(filename, fdata, varsize_bytes=4, locsize_bytes=8):
     ]
 
     # Create Datasets
-    if len(vars_only_b) > 0:
-        hfp.create_dataset("B", data=B, dtype=varfmt)
     hfp.create_dataset("Levels", data=Levels, dtype=">i4")
     hfp.create_dataset("LogicalLocations", data=LogicalLocations, dtype=">i8")
-    hfp.create_dataset("uov", data=uov, dtype=varfmt)
     hfp.create_dataset("x1f", data=x1f, dtype=locfmt)
     hfp.create_dataset("x1v", data=x1v, dtype=locfmt)
     hfp.create_dataset("x2f", data=x2f, dtype=locfmt)
     hfp.create_dataset("x2v", data=x2v, dtype=locfmt)
     hfp.create_dataset("x3f", data=x3f, dtype=locfmt)
     hfp.create_dataset("x3v", data=x3v, dtype=locfmt)
-    hfp.close()
 
 
 def write_xdmf_for(xdmfname, dumpname, fdata, mode="auto"):
@@ -0,0 +1,326 @@
+"""
+Lazy reader of bin files, and parallel converter of bin files to athdf(xdmf).
+
+Unlike bin_convert.read_binary(...), which reads the whole file and copies the data
+of every MeshBlock into memory, BinaryFile only parses the header and the index of
+the MeshBlocks in the file, and memory-maps the file with numpy.memmap.  Data of
+variables, MeshBlocks, or regions are then returned as views into the file, and only
+the pages that are accessed are read from disk.
+
+----
+
+Example of interactive analysis of a large file:
+
+  import bin_mmap
+
+  bf = bin_mmap.BinaryFile("path/to/file.bin")
+  dens = bf.var("dens")                # view with shape [n_mbs, nx3, nx2, nx1]
+  rho_max = dens[bf.n_mbs // 2].max()  # reads a single MeshBlock
+  mbs = bf.blocks_in_region(x1min=-1.0, x1max=1.0, level=bf.max_level)
+  rho = bf.var("dens", mbs)            # data of MeshBlocks around origin
+
+  filedata = bf.filedata()             # same dictionary as read_binary(...)
+
+Files written with <output>/compress_error > 0 have MeshBlocks of varying size, so
+they are indexed by reading only the MeshBlock headers, and the data of a MeshBlock
+is decoded when it is accessed.
+
+To convert a file to athdf with 8 processes reading ranges of MeshBlocks:
+
+  bin_mmap.convert_parallel("path/to/file.bin", nproc=8)
+
+or use make_athdf.py with -n 8.  Only the data of blocks_per_task MeshBlocks per
+process are held in memory at any time.
+"""
+
+import multiprocessing
+import os
+import struct
+
+import h5py
+import numpy as np
+
+import bin_convert
+
+
+def get_from_header(header, blockname, keyname):
+    """
+    Returns value of parameter blockname/keyname (as string) in the input file header.
+    """
+    blockname = blockname.strip()
+    keyname = keyname.strip()
+    if not blockname.startswith("<"):
+        blockname = "<" + blockname
+    if blockname[-1] != ">":
+        blockname += ">"
+    block = "<none>"
+    for line in header:
+        if line.startswith("<"):
+            block = line
+            continue
+        key, value = line.split("=")
+        if block == blockname and key.strip() == keyname:
+            return value
+    raise KeyError(f"no parameter called {blockname}/{keyname}")
+
+
+class BinaryFile:
+    """
+    Memory-mapped bin file.
+
+    Attributes have the same names and meaning as the keys of the filedata dictionary
+    returned by bin_convert.read_binary(...) (header, time, cycle, var_names, n_mbs,
+    nx1_mb, nx1_out_mb, Nx1, x1min, x1max, nvars, mb_index, mb_logical, mb_geometry,
+    ...), and in addition
+
+      compressed - bool
+          True if data were written with <output>/compress_error > 0
+      max_level - int
+          maximum level of the MeshBlocks in file
+    """
+
+    def __init__(self, filename):
+        self.filename = filename
+        with open(filename, "rb") as fp:
+            fp.seek(0, 2)
+            filesize = fp.tell()
+            fp.seek(0, 0)
+            self._read_header(fp)
+            data_offset = fp.tell()
+
+            # number of output cells is the same in all MeshBlocks
+            fp.seek(data_offset)
+            index = np.array(struct.unpack("@6i", fp.read(24))) - self._nghost
+            self.nx1_out_mb = index[1] - index[0] + 1
+            self.nx2_out_mb = index[3] - index[2] + 1
+            self.nx3_out_mb = index[5] - index[4] + 1
+            self._ncells = self.nx1_out_mb * self.nx2_out_mb * self.nx3_out_mb
+
+            if self.compressed:
+                self._index_compressed(fp, data_offset, filesize)
+            else:
+                self._index_uncompressed(data_offset, filesize)
+        self.max_level = int(self.mb_logical[:, 3].max()) if self.n_mbs > 0 else 0
+
+    def _read_header(self, fp):
+        """
+        Parses header of file, leaving fp at start of MeshBlock data.
+        """
+        code_header = fp.readline().split()
+        if len(code_header) < 1:
+            raise TypeError("unknown file format")
+        if code_header[0] != b"Athena":
+            raise TypeError(
+                f"bad file format \"{code_header[0].decode('utf-8')}\" "
+                + '(should be "Athena")'
+            )
+        version = code_header[-1].split(b"=")[-1]
+        if version not in [b"1.1", b"1.2"]:
+            raise TypeError(f"unsupported file format version {version.decode('utf-8')}")
+
+        pheader_count = int(fp.readline().split(b"=")[-1])
+        pheader = {}
+        for _ in range(pheader_count - 1):
+            key, val = [x.strip() for x in fp.readline().decode("utf-8").split("=")]
+            pheader[key] = val
+        self.time = float(pheader["time"])
+        self.cycle = int(pheader["cycle"])
+        self._locsize = int(pheader["size of location"])
+        self._varsize = int(pheader["size of variable"])
+        self.abs_err = float(pheader.get("compression error", 0.0))
+        self.compressed = self.abs_err > 0.0
+        if self._locsize not in [4, 8]:
+            raise ValueError(f"unsupported location size (in bytes) {self._locsize}")
+        if self._varsize not in [4, 8]:
+            raise ValueError(f"unsupported variable size (in bytes) {self._varsize}")
+
+        self.nvars = int(fp.readline().split(b"=")[-1])
+        self.var_names = [v.decode("utf-8") for v in fp.readline().split()[1:]]
+        header_size = int(fp.readline().split(b"=")[-1])
+        header = [
+            line.decode("utf-8").split("#")[0].strip()
+            for line in fp.read(header_size).split(b"\n")
+        ]
+        self.header = [line for line in header if len(line) > 0]
+
+        for d in ["1", "2", "3"]:
+            setattr(self, "Nx" + d, int(get_from_header(self.header, "<mesh>", "nx" + d)))
+            setattr(self, "nx" + d + "_mb",
+                    int(get_from_header(self.header, "<meshblock>", "nx" + d)))
+            for m in ["min", "max"]:
+                setattr(self, "x" + d + m,
+                        float(get_from_header(self.header, "<mesh>", "x" + d + m)))
+        self._nghost = int(get_from_header(self.header, "<mesh>", "nghost"))
+
+    def _index_uncompressed(self, data_offset, filesize):
+        """
+        MeshBlocks are records of equal size, so the file is mapped as array of records.
+        """
+        locdt = np.float64 if self._locsize == 8 else np.float32
+        vardt = np.float64 if self._varsize == 8 else np.float32
+        self._dtype = np.dtype([
+            ("index", np.intc, (6,)),
+            ("logical", np.intc, (4,)),
+            ("geometry", locdt, (6,)),
+            ("data", vardt,
+             (self.nvars, self.nx3_out_mb, self.nx2_out_mb, self.nx1_out_mb)),
+        ])
+        nbytes = filesize - data_offset
+        if nbytes % self._dtype.itemsize != 0:
+            raise ValueError(f"size of {self.filename} does not match MeshBlock size")
+        self.n_mbs = nbytes // self._dtype.itemsize
+        self._mm = np.memmap(self.filename, dtype=self._dtype, mode="r",
+                             offset=data_offset, shape=(self.n_mbs,))
+        self.mb_index = np.array(self._mm["index"]) - self._nghost
+        self.mb_logical = np.array(self._mm["logical"])
+        self.mb_geometry = np.array(self._mm["geometry"], dtype=np.float64)
+
+    def _index_compressed(self, fp, data_offset, filesize):
+        """
+        Size of MeshBlocks varies, so only MeshBlock headers are read to locate data.
+        """
+        locfmt = "d" if self._locsize == 8 else "f"
+        mbhdr = 24 + 16 + 6 * self._locsize + 8
+        index, logical, geometry, self._payload = [], [], [], []
+        pos = data_offset
+        fp.seek(pos)
+        while pos < filesize:
+            buf = fp.read(mbhdr)
+            index.append(struct.unpack("@6i", buf[0:24]))
+            logical.append(struct.unpack("@4i", buf[24:40]))
+            geometry.append(struct.unpack("=6" + locfmt, buf[40:mbhdr - 8]))
+            nbytes = struct.unpack("@Q", buf[mbhdr - 8:mbhdr])[0]
+            self._payload.append((pos + mbhdr, nbytes))
+            pos += mbhdr + nbytes
+            fp.seek(pos)
+        self.n_mbs = len(index)
+        self.mb_index = np.array(index) - self._nghost
+        self.mb_logical = np.array(logical)
+        self.mb_geometry = np.array(geometry, dtype=np.float64)
+        self._mm = np.memmap(self.filename, dtype=np.uint8, mode="r")
+
+    def block(self, mb):
+        """
+        Returns data of all variables of MeshBlock mb, with shape [nvars, nx3, nx2, nx1].
+        """
+        if not self.compressed:
+            return self._mm["data"][mb]
+        off, nbytes = self._payload[mb]
+        data = bin_convert.decode_compressed(
+            self._mm[off:off + nbytes], self.nvars, self._ncells, self.abs_err
+        )
+        return data.reshape(self.nvars, self.nx3_out_mb, self.nx2_out_mb,
+                            self.nx1_out_mb)
+
+    def blocks(self, start, stop):
+        """
+        Returns data of MeshBlocks start...stop-1, with shape [nmb, nvars, nx3, nx2, nx1].
+        """
+        if not self.compressed:
+            return self._mm["data"][start:stop]
+        return np.stack([self.block(mb) for mb in range(start, stop)])
+
+    def var(self, name, mbs=None):
+        """
+        Returns data of variable name in MeshBlocks mbs (default: all), with shape
+        [len(mbs), nx3, nx2, nx1].  Without compression this is a view into the file.
+        """
+        ivar = self.var_names.index(name)
+        if not self.compressed:
+            data = self._mm["data"][:, ivar]
+            return data if mbs is None else data[mbs]
+        if mbs is None:
+            mbs = range(self.n_mbs)
+        return np.stack([self.block(mb)[ivar] for mb in mbs])
+
+    def blocks_in_region(self, x1min=-np.inf, x1max=np.inf, x2min=-np.inf,
+                         x2max=np.inf, x3min=-np.inf, x3max=np.inf, level=None):
+        """
+        Returns indices of MeshBlocks that intersect the box x1min..x3max, optionally
+        only those at the given level.
+        """
+        g = self.mb_geometry
+        sel = ((g[:, 1] > x1min) & (g[:, 0] < x1max) & (g[:, 3] > x2min)
+               & (g[:, 2] < x2max) & (g[:, 5] > x3min) & (g[:, 4] < x3max))
+        if level is not None:
+            sel &= self.mb_logical[:, 3] == level
+        return np.flatnonzero(sel)
+
+    def filedata(self, data=True):
+        """
+        Returns dictionary with the same keys as bin_convert.read_binary(...), in which
+        mb_data contains views into the file (or is omitted if data=False, e.g. to write
+        the metadata of athdf files).
+        """
+        keys = ["header", "time", "cycle", "var_names", "nvars", "n_mbs",
+                "mb_index", "mb_logical", "mb_geometry"]
+        for d in ["1", "2", "3"]:
+            keys += ["Nx" + d, "nx" + d + "_mb", "nx" + d + "_out_mb",
+                     "x" + d + "min", "x" + d + "max"]
+        fdata = {key: getattr(self, key) for key in keys}
+        if data:
+            fdata["mb_data"] = {name: self.var(name) for name in self.var_names}
+        return fdata
+
+
+# files opened by each process of convert_parallel(...)
+_worker_files = {}
+
+
+def _read_blocks(task):
+    """
+    Returns (start, stop, data) of MeshBlocks start...stop-1 of file.
+    """
+    filename, start, stop = task
+    if filename not in _worker_files:
+        _worker_files[filename] = BinaryFile(filename)
+    return start, stop, np.array(_worker_files[filename].blocks(start, stop))
+
+
+def convert_parallel(binary_fname, athdf_fname=None, nproc=None, blocks_per_task=64,
+                     varsize_bytes=4, locsize_bytes=8, write_xdmf=True):
+    """
+    Converts a bin file to athdf (and xdmf) files, with nproc processes reading (and
+    decoding) ranges of blocks_per_task MeshBlocks concurrently, while the data are
+    written to the athdf file by this process.  The output is identical to that of
+    bin_convert.write_athdf(...).
+
+    args:
+      binary_fname    - string
+          filename of bin file to convert
+      athdf_fname     - string (default: binary_fname with .bin replaced by .athdf)
+          filename of athdf file
+      nproc           - int (default: number of CPUs)
+          number of processes reading the bin file
+      blocks_per_task - int
+          number of MeshBlocks read by a process at once
+    """
+    if varsize_bytes not in [4, 8]:
+        raise ValueError(f"varsizebytes must be 4 or 8, not {varsize_bytes}")
+    varfmt = "<f4" if varsize_bytes == 4 else "<f8"
+    if athdf_fname is None:
+        athdf_fname = binary_fname.replace(".bin", "") + ".athdf"
+
+    bf = BinaryFile(binary_fname)
+    fdata = bf.filedata(data=False)
+    vars_without_b, vars_only_b = bin_convert.athdf_variables(fdata)
+    iuov = [bf.var_names.index(v) for v in vars_without_b]
+    ib = [bf.var_names.index(v) for v in vars_only_b]
+    shape = (bf.n_mbs, bf.nx3_out_mb, bf.nx2_out_mb, bf.nx1_out_mb)
+
+    tasks = [(binary_fname, start, min(start + blocks_per_task, bf.n_mbs))
+             for start in range(0, bf.n_mbs, blocks_per_task)]
+    with h5py.File(athdf_fname, "w") as hfp:
+        bin_convert.write_athdf_metadata(hfp, fdata, locsize_bytes)
+        if len(ib) > 0:
+            B = hfp.create_dataset("B", (len(ib),) + shape, dtype=varfmt)
+        uov = hfp.create_dataset("uov", (len(iuov),) + shape, dtype=varfmt)
+        with multiprocessing.Pool(nproc) as pool:
+            for start, stop, data in pool.imap_unordered(_read_blocks, tasks):
+                uov[:, start:stop] = data[:, iuov].swapaxes(0, 1)
+                if len(ib) > 0:
+                    B[:, start:stop] = data[:, ib].swapaxes(0, 1)
+
+    if write_xdmf:
+        bin_convert.write_xdmf_for(athdf_fname + ".xdmf", os.path.basename(athdf_fname),
+                                   fdata)
@@ -1,5 +1,5 @@
 # A simple script for converting a collection of .bin files to .athdf/.xdmf files using
-# bin_convert
+# bin_convert, or with -n > 1 using bin_mmap with n processes reading each file
 
 # Python modules
 import os
@@ -8,6 +8,7 @@ import glob
 
 # AthenaK modules
 import bin_convert
+import bin_mmap
 
 
 # Main function
@@ -24,9 +25,13 @@ def main(**kwargs):
     for fname in files:
         athdf_name = fname.replace(".bin", ".athdf")
         xdmf_name = athdf_name + ".xdmf"
-        filedata = bin_convert.read_binary(fname)
-        bin_convert.write_athdf(athdf_name, filedata)
-        bin_convert.write_xdmf_for(xdmf_name, os.path.basename(athdf_name), filedata)
+        if kwargs['nproc'] > 1:
+            bin_mmap.convert_parallel(fname, athdf_name, nproc=kwargs['nproc'])
+        else:
+            filedata = bin_convert.read_binary(fname)
+            bin_convert.write_athdf(athdf_name, filedata)
+            bin_convert.write_xdmf_for(xdmf_name, os.path.basename(athdf_name),
+                                       filedata)
         if kwargs['verbose']:
             print(f'Converting {count}/{total}: {fname}')
         count = count+1
@@ -37,5 +42,7 @@ if __name__ == '__main__':
     parser.add_argument('file_stem', help='path to files, excluding .#.bin')
     parser.add_argument('-v', '--verbose', action='store_true',
                         help='print file conversion progress')
+    parser.add_argument('-n', '--nproc', type=int, default=1,
+                        help='number of processes reading each file')
     args = parser.parse_args()
     main(**vars(args))